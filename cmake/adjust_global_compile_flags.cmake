@@ -42,6 +42,11 @@ if (CMAKE_SYSTEM_NAME STREQUAL "Emscripten")
   if (onnxruntime_ENABLE_WEBASSEMBLY_SIMD)
     string(APPEND CMAKE_C_FLAGS " -msimd128")
     string(APPEND CMAKE_CXX_FLAGS " -msimd128")
+
+    if (onnxruntime_ENABLE_WEBASSEMBLY_RELAXED_SIMD)
+      string(APPEND CMAKE_C_FLAGS " -mrelaxed-simd")
+      string(APPEND CMAKE_CXX_FLAGS " -mrelaxed-simd")
+    endif()
   endif()
 
   if (onnxruntime_ENABLE_WEBASSEMBLY_EXCEPTION_CATCHING)
@@ -8,6 +8,9 @@ set(triton_kernel_scripts
     "onnxruntime/core/providers/rocm/math/softmax.py"
 )
 
+# absolute paths of additional kernel scripts, e.g. the kernels of TritonOp nodes, that are compiled into the build
+set(onnxruntime_TRITON_KERNEL_SCRIPTS "" CACHE STRING "Semicolon separated list of additional triton kernel scripts")
+
 function(compile_triton_kernel out_triton_kernel_obj_file out_triton_kernel_header_dir)
   # compile triton kernel, generate .a and .h files
   set(triton_kernel_compiler "${REPO_ROOT}/tools/ci_build/compile_triton.py")
@@ -16,6 +19,7 @@ function(compile_triton_kernel out_triton_kernel_obj_file out_triton_kernel_head
   set(header_file "${out_dir}/triton_kernel_infos.h")
 
   list(TRANSFORM triton_kernel_scripts PREPEND "${REPO_ROOT}/")
+  list(APPEND triton_kernel_scripts ${onnxruntime_TRITON_KERNEL_SCRIPTS})
 
   add_custom_command(
     OUTPUT ${out_obj_file} ${header_file}
@@ -41,6 +41,10 @@ set(contrib_ops_excluded_files
   "diffusion/group_norm_impl.cu"
   "diffusion/group_norm_impl.h"
   "diffusion/nhwc_conv.cc"
+  "math/batched_lora.cc"
+  "math/batched_lora.h"
+  "math/batched_lora_impl.cu"
+  "math/batched_lora_impl.h"
   "math/complex_mul.cc"
   "math/complex_mul.h"
   "math/complex_mul_impl.cu"
@@ -50,10 +54,16 @@ set(contrib_ops_excluded_files
   "math/fft_ops.h"
   "math/fft_ops_impl.cu"
   "math/fft_ops_impl.h"
+  "math/gemm_float8.cc"
+  "math/gemm_float8.h"
   "quantization/attention_quantization.cc"
   "quantization/attention_quantization.h"
   "quantization/attention_quantization_impl.cu"
   "quantization/attention_quantization_impl.cuh"
+  "quantization/matmul_nbits.cc"
+  "quantization/matmul_nbits.h"
+  "quantization/matmul_nbits_impl.cu"
+  "quantization/matmul_nbits_impl.h"
   "quantization/quantize_dequantize_linear.cc"
   "quantization/qordered_ops/qordered_attention_impl.cu"
   "quantization/qordered_ops/qordered_attention_impl.h"
@@ -84,6 +94,14 @@ set(contrib_ops_excluded_files
   "tensor/crop_impl.cu"
   "tensor/crop_impl.h"
   "tensor/dynamicslice.cc"
+  "tensor/embedding_bag.cc"
+  "tensor/embedding_bag.h"
+  "tensor/embedding_bag_impl.cu"
+  "tensor/embedding_bag_impl.h"
+  "tensor/image_preprocess.cc"
+  "tensor/image_preprocess.h"
+  "tensor/image_preprocess_impl.cu"
+  "tensor/image_preprocess_impl.h"
   "tensor/image_scaler.cc"
   "tensor/image_scaler.h"
   "tensor/image_scaler_impl.cu"
@@ -96,6 +114,7 @@ set(contrib_ops_excluded_files
   "cuda_contrib_kernels.h"
   "inverse.cc"
   "fused_conv.cc"
+  "triton_op.cc"
 )
 
 if (NOT onnxruntime_ENABLE_ATEN)
@@ -158,9 +177,13 @@ set(provider_excluded_files
   "cuda_execution_provider.h"
   "cuda_memory_check.cc"
   "cuda_memory_check.h"
+  "cuda_nhwc_kernels.cc"
+  "cuda_nhwc_kernels.h"
   "cuda_fence.cc"
   "cuda_fence.h"
   "cuda_fwd.h"
+  "cuda_graph.cc"
+  "cuda_graph.h"
   "cuda_kernel.h"
   "cuda_pch.cc"
   "cuda_pch.h"
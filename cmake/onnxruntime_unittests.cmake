@@ -1068,6 +1068,7 @@ if (NOT onnxruntime_ENABLE_TRAINING_TORCH_INTEROP)
     onnxruntime_add_executable(onnxruntime_benchmark
       ${BENCHMARK_DIR}/main.cc
       ${BENCHMARK_DIR}/modeltest.cc
+      ${BENCHMARK_DIR}/model_ops.cc
       ${BENCHMARK_DIR}/pooling.cc
       ${BENCHMARK_DIR}/resize.cc
       ${BENCHMARK_DIR}/batchnorm.cc
@@ -1225,6 +1226,32 @@ if (NOT onnxruntime_ENABLE_TRAINING_TORCH_INTEROP)
     endif()
   endif()
 
+  if (onnxruntime_BUILD_BENCHMARKS)
+    # runs the reference models of tools/python/reference_benchmark_models.json with onnxruntime_perf_test and writes
+    # the results with the build info to reference_benchmarks.json, to track performance across releases
+    find_package(Python3 COMPONENTS Interpreter)
+    if (Python3_Interpreter_FOUND)
+      set(onnxruntime_REFERENCE_MODELS_DIR "${CMAKE_CURRENT_BINARY_DIR}/reference_models" CACHE PATH
+          "Directory of the models run by the onnxruntime_reference_benchmarks target")
+      set(onnxruntime_reference_benchmark_providers cpu)
+      if (onnxruntime_USE_CUDA)
+        list(APPEND onnxruntime_reference_benchmark_providers cuda)
+      endif()
+      add_custom_target(onnxruntime_reference_benchmarks
+        COMMAND ${Python3_EXECUTABLE} ${REPO_ROOT}/tools/python/run_reference_benchmarks.py
+                --perf_test $<TARGET_FILE:onnxruntime_perf_test>
+                --models_dir ${onnxruntime_REFERENCE_MODELS_DIR}
+                --providers ${onnxruntime_reference_benchmark_providers}
+                --version ${ORT_VERSION}
+                --build_info "${ORT_BUILD_INFO}"
+                --output ${CMAKE_CURRENT_BINARY_DIR}/reference_benchmarks.json
+        DEPENDS onnxruntime_perf_test
+        USES_TERMINAL
+        VERBATIM)
+      set_target_properties(onnxruntime_reference_benchmarks PROPERTIES FOLDER "ONNXRuntimeTest")
+    endif()
+  endif()
+
   # shared lib
   if (onnxruntime_BUILD_SHARED_LIB)
     onnxruntime_add_static_library(onnxruntime_mocked_allocator ${TEST_SRC_DIR}/util/test_allocator.cc)
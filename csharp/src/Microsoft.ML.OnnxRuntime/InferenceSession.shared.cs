@@ -730,6 +730,41 @@ namespace Microsoft.ML.OnnxRuntime
                                                 ));
         }
 
+        /// <summary>
+        /// Resolves the inputs and outputs of repeated runs once. See OrtPreparedRun.
+        /// </summary>
+        /// <param name="inputNames">Names of the inputs the runs take. To supply all names, use InputNames property</param>
+        /// <param name="outputNames">Names of the outputs the runs produce. To supply all names, use OutputNames property</param>
+        /// <returns>A new instance of OrtPreparedRun, to be disposed of before this session</returns>
+        public OrtPreparedRun CreatePreparedRun(IReadOnlyCollection<string> inputNames, IReadOnlyCollection<string> outputNames)
+        {
+            var inputNamesArray = LookupUtf8Names(inputNames, n => n, LookupInputMetadata);
+            var outputNamesArray = LookupUtf8Names(outputNames, n => n, LookupOutputMetadata);
+            return new OrtPreparedRun(this, inputNamesArray, outputNamesArray);
+        }
+
+        /// <summary>
+        /// Runs the model with inputs and outputs resolved by CreatePreparedRun(). This method does not allocate
+        /// managed memory when all of the output values are supplied.
+        /// </summary>
+        /// <param name="runOptions">runOptions, if null the defaults are used</param>
+        /// <param name="preparedRun">Must not be used by another thread during the run</param>
+        /// <param name="inputValues">Input OrtValues in the order of the input names of the prepared run</param>
+        /// <param name="outputValues">Output OrtValues in the order of the output names of the prepared run.
+        /// Values that are not null are pre-allocated outputs, which can be reused from run to run. Null values are
+        /// replaced with new OrtValues allocated by the run, which the caller must dispose of.</param>
+        /// <exception cref="ArgumentException"></exception>
+        public void Run(RunOptions runOptions, OrtPreparedRun preparedRun, ReadOnlySpan<OrtValue> inputValues,
+            Span<OrtValue> outputValues)
+        {
+            if (runOptions is null)
+            {
+                runOptions = _builtInRunOptions;
+            }
+
+            preparedRun.Run(_nativeHandle, runOptions.Handle, inputValues, outputValues);
+        }
+
         /// <summary>
         /// Create OrtIoBinding instance to bind pre-allocated buffers
         /// to input/output
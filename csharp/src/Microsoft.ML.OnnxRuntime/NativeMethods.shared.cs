@@ -292,6 +292,11 @@ namespace Microsoft.ML.OnnxRuntime
         public IntPtr UpdateROCMProviderOptions;
         public IntPtr GetROCMProviderOptionsAsString;
         public IntPtr ReleaseROCMProviderOptions;
+        public IntPtr CreateAndRegisterAllocatorV2;
+        public IntPtr RunAsync;
+        public IntPtr CreatePreparedRun;
+        public IntPtr ReleasePreparedRun;
+        public IntPtr RunPrepared;
     }
 
     internal static class NativeMethods
@@ -510,6 +515,9 @@ namespace Microsoft.ML.OnnxRuntime
             OrtUpdateROCMProviderOptions = (DOrtUpdateROCMProviderOptions)Marshal.GetDelegateForFunctionPointer(api_.UpdateROCMProviderOptions, typeof(DOrtUpdateROCMProviderOptions));
             OrtGetROCMProviderOptionsAsString = (DOrtGetROCMProviderOptionsAsString)Marshal.GetDelegateForFunctionPointer(api_.GetROCMProviderOptionsAsString, typeof(DOrtGetROCMProviderOptionsAsString));
             OrtReleaseROCMProviderOptions = (DOrtReleaseROCMProviderOptions)Marshal.GetDelegateForFunctionPointer(api_.ReleaseROCMProviderOptions, typeof(DOrtReleaseROCMProviderOptions));
+            OrtCreatePreparedRun = (DOrtCreatePreparedRun)Marshal.GetDelegateForFunctionPointer(api_.CreatePreparedRun, typeof(DOrtCreatePreparedRun));
+            OrtReleasePreparedRun = (DOrtReleasePreparedRun)Marshal.GetDelegateForFunctionPointer(api_.ReleasePreparedRun, typeof(DOrtReleasePreparedRun));
+            OrtRunPrepared = (DOrtRunPrepared)Marshal.GetDelegateForFunctionPointer(api_.RunPrepared, typeof(DOrtRunPrepared));
         }
 
         internal class NativeLib
@@ -821,6 +829,37 @@ namespace Microsoft.ML.OnnxRuntime
 
         public static DOrtRunWithBinding OrtRunWithBinding;
 
+        /// <summary>
+        /// Resolves the names of the inputs and outputs of repeated runs once
+        /// </summary>
+        [UnmanagedFunctionPointer(CallingConvention.Winapi)]
+        public delegate IntPtr /*(OrtStatus*)*/ DOrtCreatePreparedRun(
+                                                IntPtr /*(const OrtSession*)*/ session,
+                                                IntPtr[] inputNames,
+                                                UIntPtr inputCount,
+                                                IntPtr[] outputNames,
+                                                UIntPtr outputCount,
+                                                out IntPtr /*(OrtPreparedRun**)*/ preparedRun);
+
+        public static DOrtCreatePreparedRun OrtCreatePreparedRun;
+
+        [UnmanagedFunctionPointer(CallingConvention.Winapi)]
+        public delegate void DOrtReleasePreparedRun(IntPtr /*(OrtPreparedRun*)*/ preparedRun);
+
+        public static DOrtReleasePreparedRun OrtReleasePreparedRun;
+
+        [UnmanagedFunctionPointer(CallingConvention.Winapi)]
+        public delegate IntPtr /*(OrtStatus*)*/ DOrtRunPrepared(
+                                                IntPtr /*(OrtSession*)*/ session,
+                                                IntPtr /*(OrtSessionRunOptions*)*/ runOptions, // can be null to use the default options
+                                                IntPtr /*(OrtPreparedRun*)*/ preparedRun,
+                                                IntPtr[] /* (OrtValue*[])*/ inputValues,
+                                                UIntPtr inputCount,
+                                                IntPtr[] outputValues, /* null entries are filled with new OrtValues */
+                                                UIntPtr outputCount);
+
+        public static DOrtRunPrepared OrtRunPrepared;
+
         [UnmanagedFunctionPointer(CallingConvention.Winapi)]
         public delegate IntPtr /*(OrtStatus*)*/ DOrtSessionGetInputCount(
                                                 IntPtr /*(OrtSession*)*/ session,
@@ -0,0 +1,133 @@
+﻿// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+using System;
+using System.Runtime.InteropServices;
+
+namespace Microsoft.ML.OnnxRuntime
+{
+    /// <summary>
+    /// The inputs and outputs of repeated runs, resolved once by InferenceSession.CreatePreparedRun().
+    ///
+    /// Runs made with it take the input and output OrtValues by position, so that names are not looked up
+    /// and no managed memory is allocated per run. Combined with OrtValues created once on top of pinned
+    /// memory with OrtValue.CreateTensorValueFromMemory() for the inputs and for the outputs, whose data is
+    /// updated in place between runs, the steady state inference does not allocate managed memory.
+    ///
+    /// An instance keeps state updated by each of its runs, so it must not be used by several threads
+    /// at the same time. Create one per thread to run concurrently. Dispose of it before the session.
+    /// </summary>
+    public class OrtPreparedRun : SafeHandle
+    {
+        // OrtValue handles passed to the native run, reused by every run
+        private readonly IntPtr[] _inputHandles;
+        private readonly IntPtr[] _outputHandles;
+
+        /// <summary>
+        /// Use InferenceSession.CreatePreparedRun()
+        /// </summary>
+        internal OrtPreparedRun(InferenceSession session, IntPtr[] inputNames, IntPtr[] outputNames)
+            : base(IntPtr.Zero, true)
+        {
+            NativeApiStatus.VerifySuccess(NativeMethods.OrtCreatePreparedRun(session.Handle,
+                inputNames, (UIntPtr)inputNames.Length, outputNames, (UIntPtr)outputNames.Length, out handle));
+            _inputHandles = new IntPtr[inputNames.Length];
+            _outputHandles = new IntPtr[outputNames.Length];
+        }
+
+        internal IntPtr Handle
+        {
+            get
+            {
+                return handle;
+            }
+        }
+
+        /// <summary>
+        /// Overrides SafeHandle.IsInvalid
+        /// </summary>
+        /// <value>returns true if handle is equal to Zero</value>
+        public override bool IsInvalid { get { return handle == IntPtr.Zero; } }
+
+        /// <summary>
+        /// Number of inputs the runs take
+        /// </summary>
+        public int InputCount => _inputHandles.Length;
+
+        /// <summary>
+        /// Number of outputs the runs produce
+        /// </summary>
+        public int OutputCount => _outputHandles.Length;
+
+        internal void Run(IntPtr session, IntPtr runOptions, ReadOnlySpan<OrtValue> inputValues,
+            Span<OrtValue> outputValues)
+        {
+            if (inputValues.Length != _inputHandles.Length)
+            {
+                throw new ArgumentException(
+                    $"Expected {_inputHandles.Length} input values, got {inputValues.Length}.", nameof(inputValues));
+            }
+
+            if (outputValues.Length != _outputHandles.Length)
+            {
+                throw new ArgumentException(
+                    $"Expected {_outputHandles.Length} output values, got {outputValues.Length}.", nameof(outputValues));
+            }
+
+            try
+            {
+                for (int i = 0; i < inputValues.Length; ++i)
+                {
+                    _inputHandles[i] = inputValues[i].Handle;
+                }
+
+                for (int i = 0; i < outputValues.Length; ++i)
+                {
+                    _outputHandles[i] = (outputValues[i] is null) ? IntPtr.Zero : outputValues[i].Handle;
+                }
+
+                NativeApiStatus.VerifySuccess(NativeMethods.OrtRunPrepared(session, runOptions, handle,
+                    _inputHandles, (UIntPtr)_inputHandles.Length, _outputHandles, (UIntPtr)_outputHandles.Length));
+
+                // Outputs that were not supplied were allocated by the run and are now owned by the caller
+                for (int i = 0; i < outputValues.Length; ++i)
+                {
+                    if (outputValues[i] is null)
+                    {
+                        outputValues[i] = new OrtValue(_outputHandles[i]);
+                        _outputHandles[i] = IntPtr.Zero;
+                    }
+                }
+            }
+            finally
+            {
+                // release the native values that could not be handed to the caller
+                for (int i = 0; i < outputValues.Length; ++i)
+                {
+                    if (outputValues[i] is null && _outputHandles[i] != IntPtr.Zero)
+                    {
+                        NativeMethods.OrtReleaseValue(_outputHandles[i]);
+                    }
+                }
+                Array.Clear(_inputHandles, 0, _inputHandles.Length);
+                Array.Clear(_outputHandles, 0, _outputHandles.Length);
+            }
+        }
+
+        #region SafeHandle
+
+        /// <summary>
+        /// Overrides SafeHandle.ReleaseHandle() to properly dispose of
+        /// the native instance of OrtPreparedRun
+        /// </summary>
+        /// <returns>always returns true</returns>
+        protected override bool ReleaseHandle()
+        {
+            NativeMethods.OrtReleasePreparedRun(handle);
+            handle = IntPtr.Zero;
+            return true;
+        }
+
+        #endregion
+    }
+}
@@ -328,7 +328,9 @@ namespace Microsoft.ML.OnnxRuntime
         COREML_FLAG_USE_CPU_ONLY = 0x001,
         COREML_FLAG_ENABLE_ON_SUBGRAPH = 0x002,
         COREML_FLAG_ONLY_ENABLE_DEVICE_WITH_ANE = 0x004,
-        COREML_FLAG_LAST = COREML_FLAG_ONLY_ENABLE_DEVICE_WITH_ANE,
+        COREML_FLAG_ENABLE_COMPILED_MODEL_CACHE = 0x008,
+        COREML_FLAG_ALLOW_LOW_PRECISION_ACCUMULATION_ON_GPU = 0x010,
+        COREML_FLAG_LAST = COREML_FLAG_ALLOW_LOW_PRECISION_ACCUMULATION_ON_GPU,
     }
 
     /// <summary>
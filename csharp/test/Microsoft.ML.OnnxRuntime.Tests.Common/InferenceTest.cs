@@ -495,6 +495,55 @@ namespace Microsoft.ML.OnnxRuntime.Tests
             }
         }
 
+        [Fact(DisplayName = "RunInferenceUsingPreparedRun")]
+        public void RunInferenceUsingPreparedRun()
+        {
+            var model = TestDataLoader.LoadModelFromEmbeddedResource("squeezenet.onnx");
+            using (var cleanUp = new DisposableListTest<IDisposable>())
+            {
+                var session = new InferenceSession(model);
+                cleanUp.Add(session);
+
+                var inputMeta = session.InputMetadata;
+                var inputNames = inputMeta.Keys.ToList().AsReadOnly();
+                var inputShape = Array.ConvertAll<int, long>(inputMeta[inputNames[0]].Dimensions, Convert.ToInt64);
+                var outputNames = new List<string> { "softmaxout_1" }.AsReadOnly();
+                long[] expectedShape = { 1, 1000, 1, 1 };  // hardcoded for the test data
+
+                float[] inputData = TestDataLoader.LoadTensorFromEmbeddedResource("bench.in");
+                float[] expectedOutput = TestDataLoader.LoadTensorFromEmbeddedResource("bench.expected_out");
+
+                var preparedRun = session.CreatePreparedRun(inputNames, outputNames);
+                cleanUp.Add(preparedRun);
+                Assert.Equal(1, preparedRun.InputCount);
+                Assert.Equal(1, preparedRun.OutputCount);
+
+                var inputValues = new OrtValue[] { OrtValue.CreateTensorValueFromMemory(inputData, inputShape) };
+                cleanUp.Add(inputValues[0]);
+
+                // output allocated by the run
+                var outputValues = new OrtValue[1];
+                session.Run(null, preparedRun, inputValues, outputValues);
+                Assert.NotNull(outputValues[0]);
+                cleanUp.Add(outputValues[0]);
+                ValidateRunResult(outputValues[0], expectedOutput, expectedShape);
+
+                // pre-allocated output reused by the following runs
+                var outputData = new float[expectedOutput.Length];
+                var reusedOutputValues = new OrtValue[] { OrtValue.CreateTensorValueFromMemory(outputData, expectedShape) };
+                cleanUp.Add(reusedOutputValues[0]);
+                for (int i = 0; i < 2; ++i)
+                {
+                    Array.Clear(outputData, 0, outputData.Length);
+                    session.Run(null, preparedRun, inputValues, reusedOutputValues);
+                    ValidateRunResult(reusedOutputValues[0], expectedOutput, expectedShape);
+                }
+
+                Assert.Throws<ArgumentException>(() => session.Run(null, preparedRun, new OrtValue[0], reusedOutputValues));
+                Assert.Throws<OnnxRuntimeException>(() => session.CreatePreparedRun(inputNames, inputNames));
+            }
+        }
+
         [Fact(DisplayName = "InferenceSessionDisposed")]
         public void InferenceSessionDisposed()
         {
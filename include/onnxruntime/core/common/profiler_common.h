@@ -16,6 +16,8 @@ enum EventCategory {
   NODE_EVENT,
   KERNEL_EVENT,
   API_EVENT,
+  MEMORY_EVENT,  // counter samples, written as "counter events (C)" in chrome tracing
+  THREADPOOL_EVENT,
   EVENT_CATEGORY_MAX
 };
 
@@ -24,7 +26,9 @@ static constexpr const char* event_category_names_[EVENT_CATEGORY_MAX] = {
     "Session",
     "Node",
     "Kernel",
-    "Api"};
+    "Api",
+    "Memory",
+    "ThreadPool"};
 
 // Timing record for all events.
 struct EventRecord {
@@ -18,7 +18,9 @@ struct OrtArenaCfg {
                   initial_chunk_size_bytes(-1),
                   max_dead_bytes_per_chunk(-1),
                   initial_growth_chunk_size_bytes(-1),
-                  max_power_of_two_extend_bytes(-1) {}
+                  max_power_of_two_extend_bytes(-1),
+                  max_thread_cache_bytes(-1),
+                  trim_window_ms(-1) {}
   OrtArenaCfg(size_t max_mem, int arena_extend_strategy, int initial_chunk_size_bytes,
               int max_dead_bytes_per_chunk, int initial_growth_chunk_size_bytes,
               int64_t max_power_of_two_extend_bytes)
@@ -27,7 +29,9 @@ struct OrtArenaCfg {
         initial_chunk_size_bytes(initial_chunk_size_bytes),
         max_dead_bytes_per_chunk(max_dead_bytes_per_chunk),
         initial_growth_chunk_size_bytes(initial_growth_chunk_size_bytes),
-        max_power_of_two_extend_bytes(max_power_of_two_extend_bytes) {}
+        max_power_of_two_extend_bytes(max_power_of_two_extend_bytes),
+        max_thread_cache_bytes(-1),
+        trim_window_ms(-1) {}
 
   size_t max_mem;                         // use 0 to allow ORT to choose the default
   int arena_extend_strategy;              // use -1 to allow ORT to choose the default, 0 = kNextPowerOfTwo, 1 = kSameAsRequested
@@ -35,6 +39,8 @@ struct OrtArenaCfg {
   int max_dead_bytes_per_chunk;           // use -1 to allow ORT to choose the default
   int initial_growth_chunk_size_bytes;    // use -1 to allow ORT to choose the default
   int64_t max_power_of_two_extend_bytes;  // use -1 to allow ORT to choose the default
+  int64_t max_thread_cache_bytes;         // use -1 to allow ORT to choose the default, 0 = no thread caches
+  int64_t trim_window_ms;                 // use -1 to allow ORT to choose the default, 0 = no trimming
 };
 
 namespace onnxruntime {
@@ -82,6 +88,15 @@ class IAllocator {
   // By default, the base implementation  just calls Alloc().
   virtual void* Reserve(size_t size) { return Alloc(size); }
 
+  // Whether the allocator orders its allocations and frees on streams, like cudaMallocAsync/cudaFreeAsync.
+  // Memory used on a stream should then be allocated with StreamOrderedAlloc().
+  // Arenas are stream aware through StreamAwareArena instead.
+  virtual bool IsStreamOrdered() const { return false; }
+
+  // Allocate memory for the work enqueued on the stream after this call. The memory is released in the order of
+  // that stream when it is freed. By default, the base implementation just calls Alloc().
+  virtual void* StreamOrderedAlloc(size_t size, Stream* /*stream*/) { return Alloc(size); }
+
   const OrtMemoryInfo& Info() const { return memory_info_; };
 
   // Each implementation of IAllocator can override and provide their own implementation
@@ -202,12 +217,17 @@ bool IAllocator::CalcMemSizeForArrayWithAlignment(size_t nmemb, size_t size, siz
 
 class CPUAllocator : public IAllocator {
  public:
-  explicit CPUAllocator(const OrtMemoryInfo& memory_info) : IAllocator(memory_info) {}
+  // If use_huge_pages is true, the allocations of at least a huge page are made with AllocatorHugePageAlloc.
+  explicit CPUAllocator(const OrtMemoryInfo& memory_info, bool use_huge_pages = false)
+      : IAllocator(memory_info), use_huge_pages_(use_huge_pages) {}
 
   CPUAllocator() : IAllocator(OrtMemoryInfo(CPU, OrtAllocatorType::OrtDeviceAllocator)) {}
 
   void* Alloc(size_t size) override;
   void Free(void* p) override;
+
+ private:
+  bool use_huge_pages_ = false;
 };
 
 using AllocatorPtr = std::shared_ptr<IAllocator>;
@@ -215,4 +235,8 @@ using AllocatorMap = std::map<OrtDevice, AllocatorPtr>;
 
 void* AllocatorDefaultAlloc(size_t size);
 void AllocatorDefaultFree(void* p);
+
+// Allocates a buffer that is aligned to and backed by transparent huge pages where the OS supports it,
+// or falls back to AllocatorDefaultAlloc. The buffer is released with AllocatorDefaultFree.
+void* AllocatorHugePageAlloc(size_t size);
 }  // namespace onnxruntime
@@ -215,6 +215,14 @@ class IExecutionProvider {
    */
   virtual common::Status ReplayGraph() { return Status::OK(); }
 
+  /**
+     Select the graph to capture or replay in the next Run by a key made of the
+     shapes of its inputs, so that a graph can be kept per input shape. Called
+     before IsGraphCaptured() and ReplayGraph() in every Run when the graph
+     capturing mode is enabled. Currently only CUDA execution provider supports it.
+   */
+  virtual void SetGraphCaptureKey(gsl::span<const int64_t> /*key*/) {}
+
   /**
      Called when session creation is complete
      This provides an opportunity for execution providers to optionally synchronize and
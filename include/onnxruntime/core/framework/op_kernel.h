@@ -134,6 +134,27 @@ class OpKernel {
     return Status::OK();
   }
 
+  // Override this function to use pre-packed buffers that PrePack() produced for the same tensor in an earlier
+  // session and that were persisted to disk (see kOrtSessionOptionsConfigPrepackedWeightsCacheDir).
+  // Unlike UseSharedPrePackedBuffers(), PrePack() is NOT called beforehand, so the kernel has to restore any other
+  // state PrePack() would have set up (e.g. the shape of the packed weight) from the tensor.
+  // @param tensor: The initialized constant tensor the buffers were packed from
+  // @param input_idx: The input index of the tensor in this kernel
+  // @param prepacked_buffers: The pre-packed buffers in the order PrePack() stored them in PrePackedWeights.
+  //                           As in UseSharedPrePackedBuffers(), the kernel does not own them.
+  // @param prepacked_buffer_sizes: The sizes of the pre-packed buffers in bytes. The kernel should check them, and
+  //                                anything else that tells the layout of the buffers, as the kernel packs
+  //                                differently on other machines or with other session options.
+  // @param used_prepacked_buffers: Boolean flag set by the kernel implementation indicating
+  // that the provided buffers have been used by the kernel. If it is not set, PrePack() is called instead.
+  virtual Status UsePersistedPrePackedBuffers(const Tensor& /*tensor*/, int /*input_idx*/,
+                                              std::vector<BufferUniquePtr>& /*prepacked_buffers*/,
+                                              const std::vector<size_t>& /*prepacked_buffer_sizes*/,
+                                              /*out*/ bool& used_prepacked_buffers) {
+    used_prepacked_buffers = false;
+    return Status::OK();
+  }
+
   const OrtDevice GetDevice(OrtMemType mem_type) const;
   const OpKernelInfo& Info() const {
     return *op_kernel_info_;
@@ -16,6 +16,7 @@ class DataTransferManager;
 class FuncManager;
 class OrtValueNameIdxMap;
 struct AllocPlanPerValue;
+struct ConfigOptions;
 
 // A very light-weight class, which works as an aggregated
 // view of all data needed for constructing a Kernel instance.
@@ -28,7 +29,8 @@ class OpKernelInfo : public OpNodeProtoHelper<ProtoHelperNodeContext> {
                         const std::unordered_map<int, OrtValue>& constant_initialized_tensors,
                         const OrtValueNameIdxMap& mlvalue_name_idx_map,
                         const DataTransferManager& data_transfer_mgr,
-                        const AllocatorMap& allocators = {});
+                        const AllocatorMap& allocators = {},
+                        const ConfigOptions* config_options = nullptr);
 
   OpKernelInfo(const OpKernelInfo& other);
 
@@ -50,6 +52,9 @@ class OpKernelInfo : public OpNodeProtoHelper<ProtoHelperNodeContext> {
 
   const AllocatorMap& GetAllocators() const { return allocators_; }
 
+  // The config options of the session creating the kernel. Empty if the kernel is not created by a session.
+  const ConfigOptions& GetConfigOptions() const;
+
  private:
   ORT_DISALLOW_MOVE(OpKernelInfo);
   ORT_DISALLOW_ASSIGNMENT(OpKernelInfo);
@@ -64,6 +69,7 @@ class OpKernelInfo : public OpNodeProtoHelper<ProtoHelperNodeContext> {
   const DataTransferManager& data_transfer_mgr_;
   ProtoHelperNodeContext proto_helper_context_;
   const AllocatorMap& allocators_;
+  const ConfigOptions* config_options_;
 };
 
 }  // namespace onnxruntime
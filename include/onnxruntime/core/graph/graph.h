@@ -47,6 +47,7 @@
 #include "core/graph/graph_nodes.h"
 #include "core/graph/node_arg.h"
 #include "core/graph/ort_format_load_options.h"
+#include "core/graph/ort_format_save_options.h"
 
 namespace flatbuffers {
 class FlatBufferBuilder;
@@ -485,6 +486,7 @@ class Node {
   void ToProto(ONNX_NAMESPACE::NodeProto& proto, bool update_subgraphs = false) const;
 
   Status SaveToOrtFormat(flatbuffers::FlatBufferBuilder& builder,
+                         const OrtFormatSaveOptions& save_options,
                          flatbuffers::Offset<onnxruntime::fbs::Node>& fbs_node) const;
 
   flatbuffers::Offset<onnxruntime::fbs::NodeEdge>
@@ -1288,6 +1290,7 @@ class Graph {
   }
 
   common::Status SaveToOrtFormat(flatbuffers::FlatBufferBuilder& builder,
+                                 const OrtFormatSaveOptions& save_options,
                                  flatbuffers::Offset<onnxruntime::fbs::Graph>& fbs_graph) const;
 
 #endif  // !defined(ORT_MINIMAL_BUILD)
@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <optional>
+
 #include "onnx/onnx_pb.h"
 
 #include "core/graph/basic_types.h"
@@ -102,6 +104,12 @@ class NodeArg {
   @returns Success unless there is existing type or shape info that can't be successfully updated. */
   common::Status UpdateTypeAndShape(const NodeArg& node_arg, bool strict, bool override_types, const logging::Logger& logger);
 
+  /** Gets the values of this NodeArg if graph shape inferencing derived them from the shapes of other values.
+  Each dimension holds one element of a small integer tensor, such as the output of Shape -> Gather -> Concat,
+  as a value, as a symbolic expression such as "batch*seq", or as unknown.
+  @returns The values if known. nullptr otherwise. */
+  const ONNX_NAMESPACE::TensorShapeProto* InferredShapeValues() const noexcept;
+
 #endif  // !defined(ORT_MINIMAL_BUILD)
 
   /** Gets this NodeArg as a NodeArgInfo, AKA ValueInfoProto. */
@@ -130,5 +138,10 @@ class NodeArg {
 
   // Flag indicates whether <*this> node arg exists or not.
   bool exists_;
+
+#if !defined(ORT_MINIMAL_BUILD)
+  // Values derived by graph shape inferencing. See InferredShapeValues.
+  std::optional<ONNX_NAMESPACE::TensorShapeProto> inferred_shape_values_;
+#endif  // !defined(ORT_MINIMAL_BUILD)
 };
 }  // namespace onnxruntime
@@ -32,6 +32,7 @@
 #pragma warning(disable : 4127)
 #pragma warning(disable : 4805)
 #endif
+#include <chrono>
 #include <memory>
 #include "unsupported/Eigen/CXX11/ThreadPool"
 
@@ -46,6 +47,7 @@
 #include "core/platform/ort_mutex.h"
 #include "core/platform/ort_spin_lock.h"
 #include "core/platform/Barrier.h"
+#include "core/platform/threadpool.h"
 
 // ORT thread pool overview
 // ------------------------
@@ -225,6 +227,15 @@ class ThreadPoolProfiler {
   void LogThreadId(int){};
   void LogRun(int){};
   std::string DumpChildThreadStat() { return {}; }
+  struct LoopTimeline {};
+  void StartTimeline(){};
+  std::vector<ThreadPoolTimelineEvent> StopTimeline() { return {}; }
+  bool IsTimelineEnabled() const { return false; }
+  std::unique_ptr<LoopTimeline> StartLoopTimeline(unsigned, std::ptrdiff_t) { return nullptr; }
+  std::function<void(unsigned)> TimeShards(LoopTimeline&, std::function<void(unsigned)> fn) { return fn; }
+  void EndLoopTimeline(std::unique_ptr<LoopTimeline>){};
+  void LogSpin(int, const onnxruntime::TimePoint&){};
+  void LogPark(int, const onnxruntime::TimePoint&){};
 };
 #else
 class ThreadPoolProfiler {
@@ -252,6 +263,32 @@ class ThreadPoolProfiler {
   void LogRun(int thread_idx);                      // called in child thread to log num of run
   std::string DumpChildThreadStat();                // return all child statitics collected so far
 
+  // Timeline mode, see ThreadPool::StartTimelineProfiling
+  struct LoopTimeline {
+    struct Shard {
+      unsigned thread_id = 0;
+      onnxruntime::TimePoint start;
+      onnxruntime::TimePoint end;
+      bool ran = false;
+    };
+    onnxruntime::TimePoint start;
+    unsigned degree_of_parallelism;
+    std::ptrdiff_t block_size;
+    std::vector<Shard> shards;  // written by the thread running each shard
+  };
+  void StartTimeline();
+  std::vector<ThreadPoolTimelineEvent> StopTimeline();
+  bool IsTimelineEnabled() const { return timeline_enabled_.load(std::memory_order_relaxed); }
+  // called in main thread when a loop starts, returns nullptr unless the timeline is enabled
+  std::unique_ptr<LoopTimeline> StartLoopTimeline(unsigned degree_of_parallelism, std::ptrdiff_t block_size);
+  // wraps the function of a loop to record the thread and the duration of each of its shards
+  std::function<void(unsigned)> TimeShards(LoopTimeline& timeline, std::function<void(unsigned)> fn);
+  // called in main thread once all the shards of the loop ended
+  void EndLoopTimeline(std::unique_ptr<LoopTimeline> timeline);
+  // called in child thread at the end of an idle period that started at `start`
+  void LogSpin(int thread_idx, const onnxruntime::TimePoint& start);
+  void LogPark(int thread_idx, const onnxruntime::TimePoint& start);
+
  private:
   static const char* GetEventName(ThreadPoolEvent);
   struct MainThreadStat {
@@ -285,6 +322,16 @@ class ThreadPoolProfiler {
 #endif  // _MSC_VER
   std::vector<ChildThreadStat> child_thread_stats_;
   std::string thread_pool_name_;
+
+  struct Timeline {
+    OrtMutex mutex;
+    unsigned thread_id = 0;
+    std::vector<ThreadPoolTimelineEvent> events;
+  };
+  void LogIdle(int thread_idx, ThreadPoolTimelineEvent::Kind kind, const onnxruntime::TimePoint& start);
+  std::atomic<bool> timeline_enabled_{false};
+  // one per child thread, and a last one for the loops run by the threads outside the pool
+  std::vector<std::unique_ptr<Timeline>> timelines_;
 };
 #endif
 
@@ -330,8 +377,18 @@ class ExtendedThreadPoolInterface : public Eigen::ThreadPoolInterface {
   // two loops execute in series in a parallel section. ]
   virtual void RunInParallel(std::function<void(unsigned idx)> fn,
                              unsigned n, std::ptrdiff_t block_size) = 0;
+
+  // Schedule fn on the work queue of the calling worker thread rather than on
+  // a random one.  The caller picks it up once it is done with its current
+  // task unless an idle worker steals it first.  Threads that are not part of
+  // the pool use Schedule().
+  virtual void ScheduleLocal(std::function<void()> fn) = 0;
+
   virtual void StartProfiling() = 0;
   virtual std::string StopProfiling() = 0;
+
+  virtual void StartTimelineProfiling() = 0;
+  virtual std::vector<ThreadPoolTimelineEvent> StopTimelineProfiling() = 0;
 };
 
 class ThreadPoolParallelSection {
@@ -723,6 +780,14 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
     return profiler_.Stop();
   }
 
+  void StartTimelineProfiling() override {
+    profiler_.StartTimeline();
+  }
+
+  std::vector<ThreadPoolTimelineEvent> StopTimelineProfiling() override {
+    return profiler_.StopTimeline();
+  }
+
   struct Tag {
     constexpr Tag() : v_(0) {
     }
@@ -766,6 +831,7 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
         env_(env),
         num_threads_(num_threads),
         allow_spinning_(allow_spinning),
+        adaptive_spinning_(thread_options.adaptive_spinning),
         set_denormal_as_zero_(thread_options.set_denormal_as_zero),
         worker_data_(num_threads),
         all_coprimes_(num_threads),
@@ -783,6 +849,32 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
       ComputeCoprimes(i, &all_coprimes_.back());
     }
 
+    // Record the NUMA node of each worker, when the workers are bound to
+    // nodes.  Parallel sections start on the workers of the caller's node,
+    // and workers steal from their own node first.
+    if (thread_options.numa_nodes.size() >= num_threads_) {
+      worker_numa_node_.assign(thread_options.numa_nodes.begin(),
+                               thread_options.numa_nodes.begin() + num_threads_);
+      for (auto i = 0u; i < num_threads_; i++) {
+        int node = worker_numa_node_[i];
+        if (node >= 0) {
+          if (static_cast<size_t>(node) >= numa_node_workers_.size()) {
+            numa_node_workers_.resize(static_cast<size_t>(node) + 1);
+          }
+          numa_node_workers_[node].push_back(i);
+        }
+      }
+    }
+
+    // Workers bound to efficiency cores block instead of spinning, leaving
+    // the spinning to the workers on the faster cores.
+    if (thread_options.efficiency_cores.size() >= num_threads_) {
+      worker_spins_.resize(num_threads_);
+      for (auto i = 0u; i < num_threads_; i++) {
+        worker_spins_[i] = !thread_options.efficiency_cores[i];
+      }
+    }
+
     // Eigen::MaxSizeVector has neither essential exception safety features
     // such as swap, nor it is movable. So we have to join threads right here
     // on exception
@@ -824,6 +916,24 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
     }
   }
 
+  void ScheduleLocal(std::function<void()> fn) override {
+    PerThread* pt = GetPerThread();
+    if (pt->pool != this) {
+      Schedule(std::move(fn));
+      return;
+    }
+    Queue& q = worker_data_[pt->thread_id].queue;
+    fn = q.PushBack(std::move(fn));
+    if (!fn) {
+      // This thread is busy, so make sure some other worker is around to
+      // steal the work if it becomes idle before we do.
+      worker_data_[Rand(&pt->rand) % num_threads_].EnsureAwake();
+    } else {
+      // Run the work directly if the queue rejected the work
+      fn();
+    }
+  }
+
   //......................................................................
   //
   // Parallel sections
@@ -852,6 +962,9 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
     ps.tasks_revoked = 0;
     ps.current_dop = 1;
     ps.active = true;
+    if (adaptive_spinning_) {
+      RecordParallelSectionStart();
+    }
   }
 
   void StartParallelSection(ThreadPoolParallelSection& ps) override {
@@ -1054,6 +1167,17 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
     // b) avoid wasting next_worker value
     if (preferred_workers.empty()) {
       preferred_workers.push_back(-1);
+
+      // With NUMA-bound workers, hand out the workers of the caller's node
+      // first so that the first tasks of a loop run next to the caller's
+      // data.  The remaining slots fall back to the round robin below.
+      const InlinedVector<unsigned>* local_workers = CurrentNumaNodeWorkers();
+      if (local_workers != nullptr) {
+        unsigned start = next_worker++;
+        for (size_t i = 0; i < local_workers->size(); i++) {
+          preferred_workers.push_back((*local_workers)[(start + i) % local_workers->size()]);
+        }
+      }
     }
 
     // preferred_workers maps from a par_idx to a q_idx, hence we
@@ -1063,6 +1187,22 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
     }
   }
 
+  // Return the workers on the NUMA node of the calling thread, or nullptr if
+  // the workers are not bound to NUMA nodes or the node is unknown.
+
+  const InlinedVector<unsigned>* CurrentNumaNodeWorkers() {
+    if (numa_node_workers_.empty()) {
+      return nullptr;
+    }
+    PerThread* pt = GetPerThread();
+    int node = pt->pool == this ? worker_numa_node_[pt->thread_id] : env_.GetCurrentNumaNode();
+    if (node < 0 || static_cast<size_t>(node) >= numa_node_workers_.size() ||
+        numa_node_workers_[node].empty()) {
+      return nullptr;
+    }
+    return &numa_node_workers_[node];
+  }
+
   // Update the preferred worker for par_idx to be the calling thread
 
   void UpdatePreferredWorker(InlinedVector<int>& preferred_workers,
@@ -1236,6 +1376,10 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
                             std::ptrdiff_t block_size) override {
     ORT_ENFORCE(n <= num_threads_ + 1, "More work items than threads");
     profiler_.LogStartAndCoreAndBlock(block_size);
+    auto loop_timeline = profiler_.StartLoopTimeline(n, block_size);
+    if (loop_timeline) {
+      fn = profiler_.TimeShards(*loop_timeline, std::move(fn));
+    }
     PerThread* pt = GetPerThread();
     assert(pt->leading_par_section && "RunInParallel, but not in parallel section");
     assert((n > 1) && "Trivial parallel section; should be avoided by caller");
@@ -1277,6 +1421,9 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
       onnxruntime::concurrency::SpinPause();
     }
     profiler_.LogEnd(ThreadPoolProfiler::WAIT);
+    if (loop_timeline) {
+      profiler_.EndLoopTimeline(std::move(loop_timeline));
+    }
   }
 
   // Run a single parallel loop _without_ a parallel section.  This is a
@@ -1294,6 +1441,10 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
   void RunInParallel(std::function<void(unsigned idx)> fn, unsigned n, std::ptrdiff_t block_size) override {
     ORT_ENFORCE(n <= num_threads_ + 1, "More work items than threads");
     profiler_.LogStartAndCoreAndBlock(block_size);
+    auto loop_timeline = profiler_.StartLoopTimeline(n, block_size);
+    if (loop_timeline) {
+      fn = profiler_.TimeShards(*loop_timeline, std::move(fn));
+    }
     PerThread* pt = GetPerThread();
     ThreadPoolParallelSection ps;
     StartParallelSectionInternal(*pt, ps);
@@ -1303,6 +1454,9 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
     profiler_.LogEndAndStart(ThreadPoolProfiler::RUN);
     EndParallelSectionInternal(*pt, ps);  // wait for all
     profiler_.LogEnd(ThreadPoolProfiler::WAIT);
+    if (loop_timeline) {
+      profiler_.EndLoopTimeline(std::move(loop_timeline));
+    }
   }
 
   int NumThreads() const final {
@@ -1325,6 +1479,20 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
     spin_loop_status_ = SpinLoopStatus::kIdle;
   }
 
+  ThreadPoolSpinStatistics GetSpinStatistics() const {
+    ThreadPoolSpinStatistics stats;
+    stats.spin_hits = spin_hits_.load(std::memory_order_relaxed);
+    stats.spin_misses = spin_misses_.load(std::memory_order_relaxed);
+    stats.parks_without_spinning = parks_without_spinning_.load(std::memory_order_relaxed);
+    stats.spin_time_ns = spin_time_ns_.load(std::memory_order_relaxed);
+    stats.steals = steals_.load(std::memory_order_relaxed);
+    if (adaptive_spinning_) {
+      stats.section_interarrival_ns = section_interarrival_ns_.load(std::memory_order_relaxed);
+      stats.spin_window_ns = SpinWindowNs();
+    }
+    return stats;
+  }
+
  private:
   void ComputeCoprimes(int N, Eigen::MaxSizeVector<unsigned>* coprimes) {
     for (int i = 1; i <= N; i++) {
@@ -1485,12 +1653,21 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
   Environment& env_;
   const unsigned num_threads_;
   const bool allow_spinning_;
+  const bool adaptive_spinning_;
   const bool set_denormal_as_zero_;
   Eigen::MaxSizeVector<WorkerData> worker_data_;
   Eigen::MaxSizeVector<Eigen::MaxSizeVector<unsigned>> all_coprimes_;
   std::atomic<unsigned> blocked_;  // Count of blocked workers, used as a termination condition
   std::atomic<bool> done_;
 
+  // NUMA node of each worker (-1 if unknown), and the workers of each node.
+  // Both are empty unless the workers are bound to NUMA nodes.
+  std::vector<int> worker_numa_node_;
+  std::vector<InlinedVector<unsigned>> numa_node_workers_;
+
+  // Whether each worker may spin waiting for work, empty if all may.
+  std::vector<bool> worker_spins_;
+
   // SpinLoopStatus indicates whether the main worker spinning (inner) loop should exit immediately when there is
   // no work available (kIdle) or whether it should follow the configured spin-then-block policy (kBusy).
   // This lets the ORT session layer hint to the thread pool that it should stop spinning in between
@@ -1503,6 +1680,54 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
   // Default is no control over spinning
   std::atomic<SpinLoopStatus> spin_loop_status_{SpinLoopStatus::kBusy};
 
+  // Adaptive spinning
+  // -----------------
+  //
+  // With ThreadOptions::adaptive_spinning, idle workers spin for a window
+  // that follows the average time between the starts of parallel sections
+  // (including single parallel loops): twice that time, so that the next
+  // section usually arrives while the workers are still spinning, or not at
+  // all if the sections arrive further apart than kMaxSpinWindowNs, when
+  // waking up a blocked worker costs little compared to the gap.  The
+  // average is updated without synchronization; a lost update only delays
+  // the adaptation.
+  static constexpr uint64_t kMaxSpinWindowNs = 1000 * 1000;
+
+  static uint64_t NowNs() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                     std::chrono::steady_clock::now().time_since_epoch())
+                                     .count());
+  }
+
+  void RecordParallelSectionStart() {
+    const uint64_t now = NowNs();
+    const uint64_t last = last_section_start_ns_.exchange(now, std::memory_order_relaxed);
+    if (last == 0 || now <= last) {
+      return;
+    }
+    const uint64_t gap = now - last;
+    const uint64_t average = section_interarrival_ns_.load(std::memory_order_relaxed);
+    section_interarrival_ns_.store(average == 0 ? gap : average - average / 8 + gap / 8, std::memory_order_relaxed);
+  }
+
+  uint64_t SpinWindowNs() const {
+    const uint64_t average = section_interarrival_ns_.load(std::memory_order_relaxed);
+    if (average == 0) {
+      return kMaxSpinWindowNs;  // nothing measured yet
+    }
+    return average > kMaxSpinWindowNs ? 0 : std::min(2 * average, kMaxSpinWindowNs);
+  }
+
+  std::atomic<uint64_t> last_section_start_ns_{0};
+  std::atomic<uint64_t> section_interarrival_ns_{0};
+
+  // Counters of ThreadPoolSpinStatistics
+  std::atomic<uint64_t> spin_hits_{0};
+  std::atomic<uint64_t> spin_misses_{0};
+  std::atomic<uint64_t> parks_without_spinning_{0};
+  std::atomic<uint64_t> spin_time_ns_{0};
+  std::atomic<uint64_t> steals_{0};
+
   // Wake any blocked workers so that they can cleanly exit WorkerLoop().  For
   // a clean exit, each thread will observe (1) done_ set, indicating that the
   // destructor has been called, (2) all threads blocked, and (3) no
@@ -1526,7 +1751,8 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
     assert(td.GetStatus() == WorkerData::ThreadStatus::Spinning);
 
     constexpr int log2_spin = 20;
-    const int spin_count = allow_spinning_ ? (1ull << log2_spin) : 0;
+    const bool spins = allow_spinning_ && (worker_spins_.empty() || worker_spins_[thread_id]);
+    const int spin_count = spins ? (1ull << log2_spin) : 0;
     const int steal_count = spin_count / 100;
 
     SetDenormalAsZero(set_denormal_as_zero_);
@@ -1536,6 +1762,14 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
       Task t = q.PopFront();
       if (!t) {
         // Spin waiting for work.
+        const bool log_timeline = profiler_.IsTimelineEnabled();
+        onnxruntime::TimePoint idle_start;
+        if (log_timeline) {
+          idle_start = std::chrono::high_resolution_clock::now();
+        }
+        const uint64_t spin_start = NowNs();
+        const uint64_t spin_end = adaptive_spinning_ ? spin_start + SpinWindowNs() : 0;
+        bool spun = false;
         for (int i = 0; i < spin_count && !done_; i++) {
           if (((i + 1) % steal_count == 0)) {
             t = Steal(StealAttemptKind::TRY_ONE);
@@ -1547,8 +1781,22 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
           if (spin_loop_status_.load(std::memory_order_relaxed) == SpinLoopStatus::kIdle) {
             break;
           }
+          if (adaptive_spinning_ && (i % 64) == 0 && NowNs() >= spin_end) {
+            break;
+          }
+          spun = true;
           onnxruntime::concurrency::SpinPause();
         }
+        if (spun) {
+          spin_time_ns_.fetch_add(NowNs() - spin_start, std::memory_order_relaxed);
+          (t ? spin_hits_ : spin_misses_).fetch_add(1, std::memory_order_relaxed);
+          if (log_timeline) {
+            profiler_.LogSpin(thread_id, idle_start);
+            idle_start = std::chrono::high_resolution_clock::now();
+          }
+        } else if (!t) {
+          parks_without_spinning_.fetch_add(1, std::memory_order_relaxed);
+        }
 
         // Attempt to block
         if (!t) {
@@ -1607,6 +1855,9 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
               // Post-block update (executed only if we blocked)
               [&]() {
                 blocked_--;
+                if (log_timeline) {
+                  profiler_.LogPark(thread_id, idle_start);
+                }
               });
           // Thread just unblocked.  Unless we picked up work while
           // blocking, or are exiting, then either work was pushed to
@@ -1640,6 +1891,28 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
 
   Task Steal(StealAttemptKind steal_kind) {
     PerThread* pt = GetPerThread();
+
+    // Try the workers on our own NUMA node before going remote.
+    const InlinedVector<unsigned>* local_workers = CurrentNumaNodeWorkers();
+    if (local_workers != nullptr) {
+      unsigned local_size = static_cast<unsigned>(local_workers->size());
+      unsigned local_attempts = (steal_kind == StealAttemptKind::TRY_ALL) ? local_size : 1;
+      unsigned start = Rand(&pt->rand) % local_size;
+      for (unsigned i = 0; i < local_attempts; i++) {
+        unsigned victim = (*local_workers)[(start + i) % local_size];
+        if (worker_data_[victim].GetStatus() == WorkerData::ThreadStatus::Active) {
+          Task t = worker_data_[victim].queue.PopBack();
+          if (t) {
+            steals_.fetch_add(1, std::memory_order_relaxed);
+            return t;
+          }
+        }
+      }
+      if (steal_kind != StealAttemptKind::TRY_ALL) {
+        return Task();
+      }
+    }
+
     unsigned size = num_threads_;
     unsigned num_attempts = (steal_kind == StealAttemptKind::TRY_ALL) ? size : 1;
     unsigned r = Rand(&pt->rand);
@@ -1651,6 +1924,7 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
       if (worker_data_[victim].GetStatus() == WorkerData::ThreadStatus::Active) {
         Task t = worker_data_[victim].queue.PopBack();
         if (t) {
+          steals_.fetch_add(1, std::memory_order_relaxed);
           return t;
         }
       }
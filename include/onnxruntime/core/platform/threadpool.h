@@ -16,6 +16,7 @@ limitations under the License.
 /* Modifications Copyright (c) Microsoft. */
 
 #pragma once
+#include <atomic>
 #include <string>
 #include <vector>
 #include <functional>
@@ -134,8 +135,42 @@ class ThreadPoolTempl;
 
 class ExtendedThreadPoolInterface;
 class LoopCounter;
+class ParallelForCalibration;
 class ThreadPoolParallelSection;
 
+// Counters of the idle periods of the workers of a pool, see ThreadPool::GetSpinStatistics.
+struct ThreadPoolSpinStatistics {
+  uint64_t spin_hits = 0;               // idle periods that ended with work found while spinning
+  uint64_t spin_misses = 0;             // idle periods that spun without finding work, then blocked
+  uint64_t parks_without_spinning = 0;  // idle periods that blocked without spinning
+  uint64_t spin_time_ns = 0;            // total time spent spinning by all workers
+  uint64_t steals = 0;                  // tasks taken from the queue of another worker
+  // With adaptive spinning: average time between the starts of parallel sections, and the resulting spin window.
+  uint64_t section_interarrival_ns = 0;
+  uint64_t spin_window_ns = 0;
+};
+
+// Event of the timeline of a pool recorded between ThreadPool::StartTimelineProfiling and StopTimelineProfiling.
+struct ThreadPoolTimelineEvent {
+  enum class Kind {
+    kParallelLoop,  // a loop run with the help of the pool, on the thread that started it
+    kShard,         // the part of a loop run by one thread
+    kSpin,          // a worker spinning for work
+    kPark,          // a worker blocked waiting for work
+  };
+  Kind kind;
+  unsigned thread_id;  // as logging::GetThreadId()
+  TimePoint start;
+  TimePoint end;
+  // kParallelLoop: the degree of parallelism and block size of the loop, and the duration of its longest shard over
+  // the average duration of its shards, 1 when the work is evenly balanced
+  unsigned degree_of_parallelism = 0;
+  std::ptrdiff_t block_size = 0;
+  double imbalance = 0.0;
+  // kShard: index of the shard in its loop
+  unsigned shard_index = 0;
+};
+
 class ThreadPool {
  public:
 #ifdef _WIN32
@@ -213,6 +248,41 @@ class ThreadPool {
     ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(ParallelSection);
   };
 
+  // Work classes let several sessions share one pool (see OrtThreadingOptions) without one of them starving
+  // the others.  The work class is a property of the calling thread: it applies to the parallel loops that
+  // the thread starts, and it is passed on to the tasks that the thread schedules with Schedule().
+  //
+  // - max_degree_of_parallelism caps the number of threads, including the caller, that a parallel loop or
+  //   section of the class may use.  0 means no cap.
+  //
+  // - Loops of kInteractive priority have precedence over loops of kBatch priority: while interactive
+  //   loops are running, batch loops only get the threads that the interactive loops do not use.  Running
+  //   loops and parallel sections keep their threads, so batch work yields at the start of its next loop or
+  //   section.  kNormal loops are neither counted nor limited.
+  enum class WorkPriority {
+    kInteractive,
+    kNormal,
+    kBatch,
+  };
+
+  struct WorkClass {
+    WorkPriority priority = WorkPriority::kNormal;
+    int max_degree_of_parallelism = 0;
+  };
+
+  // Sets the work class of the calling thread for the lifetime of the scope.
+  class WorkClassScope {
+   public:
+    explicit WorkClassScope(const WorkClass& work_class);
+    ~WorkClassScope();
+
+   private:
+    WorkClass previous_;
+    ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(WorkClassScope);
+  };
+
+  static WorkClass CurrentWorkClass();
+
   // The below API allows to disable spinning
   // This is used to support real-time scenarios where
   // spinning between relatively infrequent requests
@@ -221,6 +291,9 @@ class ThreadPool {
 
   void DisableSpinning();
 
+  // Returns the spin statistics of the workers since the pool was created.
+  ThreadPoolSpinStatistics GetSpinStatistics() const;
+
   // Schedules fn() for execution in the pool of threads.  The function may run
   // synchronously if it cannot be enqueued.  This will occur if the thread pool's
   // degree-of-parallelism is 1, but it may also occur for implementation-dependent
@@ -234,6 +307,17 @@ class ThreadPool {
     }
   }
 
+  // Like Schedule(), but when called from a worker of the pool, fn() is queued on that worker's own queue,
+  // from where idle workers can steal it. Used to keep chains of dependent tasks on the same thread.
+  static void ScheduleLocal(ThreadPool* tp,
+                            std::function<void()> fn) {
+    if (tp) {
+      tp->ScheduleLocal(fn);
+    } else {
+      fn();
+    }
+  }
+
   // ParallelFor shards the "total" units of work assuming each unit of work
   // having roughly "cost_per_unit" cost, in cycles. Each unit of work is
   // indexed 0, 1, ..., total - 1. Each shard contains 1 or more units of work
@@ -366,6 +450,11 @@ class ThreadPool {
   static void StartProfiling(concurrency::ThreadPool* tp);
   static std::string StopProfiling(concurrency::ThreadPool* tp);
 
+  // Records the parallel loops, their shards and the idle periods of the workers until StopTimelineProfiling.
+  // Not to be consumed as public-facing API either.
+  static void StartTimelineProfiling(concurrency::ThreadPool* tp);
+  static std::vector<ThreadPoolTimelineEvent> StopTimelineProfiling(concurrency::ThreadPool* tp);
+
  private:
   friend class LoopCounter;
 
@@ -382,7 +471,9 @@ class ThreadPool {
   // then the function will run directly in the caller.  The fork-join
   // synchronization is handled in the thread pool, and so any state captured
   // by fn() is safe from concurrent access once RunWithHelp returns.
+  // n is reduced according to the work class of the calling thread.
   void RunInParallel(std::function<void(unsigned idx)> fn, unsigned n, std::ptrdiff_t block_size);
+  void RunInParallelImpl(std::function<void(unsigned idx)> fn, unsigned n, std::ptrdiff_t block_size);
 
   // Divides the work represented by the range [0, total) into k shards.
   // Calls fn(i*block_size, (i+1)*block_size) from the ith shard (0 <= i < k).
@@ -411,10 +502,16 @@ class ThreadPool {
 
   void Schedule(std::function<void()> fn);
 
+  void ScheduleLocal(std::function<void()> fn);
+
   void StartProfiling();
 
   std::string StopProfiling();
 
+  void StartTimelineProfiling();
+
+  std::vector<ThreadPoolTimelineEvent> StopTimelineProfiling();
+
   ThreadOptions thread_options_;
 
   // If a thread pool is created with degree_of_parallelism != 1 then an underlying
@@ -428,6 +525,13 @@ class ThreadPool {
 
   // Force the thread pool to run in hybrid mode on a normal cpu.
   bool force_hybrid_ = false;
+
+  // Set if ThreadOptions::parallel_for_calibration is enabled.
+  std::unique_ptr<ParallelForCalibration> calibration_;
+
+  // Number of threads, including the callers, used by the running loops and sections of
+  // WorkPriority::kInteractive.
+  std::atomic<int> interactive_dop_{0};
 };
 
 }  // namespace concurrency
@@ -24,9 +24,18 @@ enum COREMLFlags {
   // Please note, enable this option does not guarantee the entire model to be executed using ANE only
   COREML_FLAG_ONLY_ENABLE_DEVICE_WITH_ANE = 0x004,
 
+  // Keep the compiled CoreML model (.mlmodelc) in the caches directory of the app, keyed by a hash of the
+  // converted model and the OS version, and reuse it in later sessions instead of compiling the model again.
+  // Compiling a large model may take seconds, which would otherwise be paid on every session creation.
+  COREML_FLAG_ENABLE_COMPILED_MODEL_CACHE = 0x008,
+
+  // Allow the GPU to accumulate in float16 instead of float32. This is faster but may reduce the precision of
+  // the results. The Neural Engine always computes in float16.
+  COREML_FLAG_ALLOW_LOW_PRECISION_ACCUMULATION_ON_GPU = 0x010,
+
   // Keep COREML_FLAG_MAX at the end of the enum definition
   // And assign the last COREMLFlag to it
-  COREML_FLAG_LAST = COREML_FLAG_ONLY_ENABLE_DEVICE_WITH_ANE,
+  COREML_FLAG_LAST = COREML_FLAG_ALLOW_LOW_PRECISION_ACCUMULATION_ON_GPU,
 };
 
 #ifdef __cplusplus
@@ -32,4 +32,10 @@ struct OrtCUDAProviderOptionsV2 {
   int tunable_op_max_tuning_duration_ms = 0;                                                                   // Max tuning duration time limit for TunableOp.
   int enable_skip_layer_norm_strict_mode = 0;                                                                  // flag specifying if SkipLayerNorm is in strict mode. If true, use LayerNormalization kernel.
                                                                                                                // The strict mode has better accuracy but lower performance.
+  int use_pinned_staging_buffers = 1;                                                                          // flag specifying if copies from and to pageable host memory are staged in pinned buffers.
+  int use_stream_ordered_allocator = 0;                                                                        // flag specifying if the stream ordered memory pool of CUDA (cudaMallocAsync) is used instead of the BFC Arena.
+  size_t mem_pool_release_threshold = std::numeric_limits<size_t>::max();                                      // bytes of freed memory the stream ordered memory pool keeps when a stream synchronizes.
+  int prefer_nhwc = 0;                                                                                         // flag specifying if the layout sensitive ops with NHWC kernels run in NHWC layout.
+  int cuda_graph_max_graphs = 8;                                                                               // maximum number of CUDA graphs, one per shape of the inputs, kept captured at the same time.
+  size_t embedding_cache_size_in_mb = 0;                                                                       // GPU memory of the cache of hot rows of each EmbeddingBag table kept in host memory. 0 caches whole tables.
 };
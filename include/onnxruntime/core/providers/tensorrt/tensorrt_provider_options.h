@@ -45,4 +45,6 @@ struct OrtTensorRTProviderOptionsV2 {
   const char* trt_profile_max_shapes;           // Specify the range of the input shapes to build the engine with
   const char* trt_profile_opt_shapes;           // Specify the range of the input shapes to build the engine with
   int trt_cuda_graph_enable;                    // Enable CUDA graph in ORT TRT
+  int trt_async_engine_build_enable;            // Build the engines of new input shapes in the background and run the subgraph on the CUDA EP meanwhile. Default 0 = false, nonzero = true
+  int trt_profile_warmup_runs;                  // Number of runs whose input shapes are clustered into optimization profiles, when no explicit profiles are given. Default 0 = disabled
 };
@@ -10,6 +10,7 @@
 #include "core/platform/threadpool.h"
 #include "core/common/logging/logging.h"
 #include "core/framework/allocator.h"
+#include "core/framework/shared_initializer_store.h"
 
 struct OrtThreadingOptions;
 namespace onnxruntime {
@@ -88,6 +89,14 @@ class Environment {
    */
   Status CreateAndRegisterAllocatorV2(const std::string& provider_type, const OrtMemoryInfo& mem_info, const std::unordered_map<std::string, std::string>& options, const OrtArenaCfg* arena_cfg = nullptr);
 
+  /**
+   * Returns the store of the initializers shared by content between the sessions that enable
+   * session.share_initializers_by_content.
+   */
+  SharedInitializerStore& GetSharedInitializerStore() const {
+    return shared_initializer_store_;
+  }
+
  private:
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(Environment);
   Status Initialize(std::unique_ptr<logging::LoggingManager> logging_manager,
@@ -99,5 +108,6 @@ class Environment {
   std::unique_ptr<onnxruntime::concurrency::ThreadPool> inter_op_thread_pool_;
   bool create_global_thread_pools_{false};
   std::vector<AllocatorPtr> shared_allocators_;
+  mutable SharedInitializerStore shared_initializer_store_;
 };
 }  // namespace onnxruntime
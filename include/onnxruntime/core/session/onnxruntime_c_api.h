@@ -299,6 +299,8 @@ ORT_RUNTIME_CLASS(DnnlProviderOptions);
 ORT_RUNTIME_CLASS(Op);
 ORT_RUNTIME_CLASS(OpAttr);
 ORT_RUNTIME_CLASS(Logger);
+ORT_RUNTIME_CLASS(PreparedRun);
+ORT_RUNTIME_CLASS(SessionPipeline);
 
 #ifdef _WIN32
 typedef _Return_type_success_(return == 0) OrtStatus* OrtStatusPtr;
@@ -409,7 +411,8 @@ typedef struct OrtCUDAProviderOptions {
         default_memory_arena_cfg{},
         tunable_op_enable{false},
         tunable_op_tuning_enable{false},
-        tunable_op_max_tuning_duration_ms{} {}
+        tunable_op_max_tuning_duration_ms{},
+        enable_hip_graph{false} {}
 #endif
 
   /** \brief CUDA device Id
@@ -563,6 +566,13 @@ typedef struct OrtROCMProviderOptions {
    */
   int tunable_op_max_tuning_duration_ms;
 
+  /** \brief Flag indicating if the run is captured as a hipGraph and replayed in later runs.
+   *   A graph is captured per shape of the inputs, after two regular runs with the shape.
+   *   Requires all the compute nodes of the model to be assigned to the ROCM EP.
+   *   Defaults to 0 (false).
+   */
+  int enable_hip_graph;
+
 } OrtROCMProviderOptions;
 
 /** \brief TensorRT Provider Options
@@ -696,6 +706,16 @@ typedef void (*OrtCustomJoinThreadFn)(OrtCustomThreadHandle ort_custom_thread_ha
 
 typedef OrtStatus*(ORT_API_CALL* RegisterCustomOpsFn)(OrtSessionOptions* options, const OrtApiBase* api);
 
+/** \brief Callback function for RunAsync
+ *
+ * \param[in] user_data User specific data that passed back to the callback
+ * \param[out] outputs On succeed, outputs host inference results, on error, the value will be nullptr
+ * \param[out] num_outputs Number of outputs, on error, the value will be zero
+ * \param[out] status On error, status will provide details. Ownership moves to the callback,
+ *                    which must release it with OrtApi::ReleaseStatus when it is not nullptr.
+ */
+typedef void (*RunAsyncCallbackFn)(void* user_data, OrtValue** outputs, size_t num_outputs, OrtStatusPtr status);
+
 /** \brief The C API
  *
  * All C API functions are defined inside this structure as pointers to functions.
@@ -2753,6 +2773,13 @@ struct OrtApi {
    *  Use -1 to allow ORT to choose the default 1GB for max_power_of_two_extend_bytes.
    *  Ultimately, the allocation size is determined by the allocation memory request.
    *  Further allocation sizes are governed by the arena extend strategy.
+   * "max_thread_cache_bytes": Maximum number of bytes of freed small chunks (up to 64KB) that every thread keeps
+   *  to serve its next allocations of the same size without locking the arena. Reduces the contention of
+   *  concurrent Run() calls on a shared arena. Not used by stream aware arenas. Default is 0 (disabled).
+   * "trim_window_ms": Length of the window over which the arena tracks the peak of the bytes in use. At the end of
+   *  every window, the allocation regions that are not needed to hold that peak and have no chunk in use are
+   *  released to the device allocator. Long running sessions give back the memory of a single large request once
+   *  the following requests are smaller. Default is 0 (disabled).
    *
    * \param[in] arena_config_keys Keys to configure the arena
    * \param[in] arena_config_values Values to configure the arena
@@ -3577,7 +3604,8 @@ struct OrtApi {
    * QNN supported keys:
    *   "backend_path": file path to QNN backend library.
    *   "qnn_context_cache_enable": 1 to enable QNN graph creation from cached QNN context file. If it's enabled: QNN EP will
-   *    load from cached QNN context binary if it exist. It will generate a context binary file if it's not exist
+   *    load from cached QNN context binary if it exist. It will generate a context binary file if it's not exist.
+   *    All the QNN partitions of the session are in the one context binary and share its weights.
    *   "qnn_context_cache_path": explicitly provide the QNN context cache file. Default to model_file.onnx.bin if not provided.
    *   "profiling_level": QNN profiling level, options: "off", "basic", "detailed". Default to off.
    *   "rpc_control_latency": QNN RPC control latency.
@@ -4316,6 +4344,216 @@ struct OrtApi {
    */
   ORT_API2_STATUS(CreateAndRegisterAllocatorV2, _Inout_ OrtEnv* env, _In_ const char* provider_type, _In_ const OrtMemoryInfo* mem_info, _In_ const OrtArenaCfg* arena_cfg,
                   _In_reads_(num_keys) const char* const* provider_options_keys, _In_reads_(num_keys) const char* const* provider_options_values, _In_ size_t num_keys);
+
+  /** \brief Run the model asynchronously in a thread owned by the session
+   *
+   * The run is queued on the session's inter-op thread pool, or on its intra-op thread pool when the session
+   * was not created with ::ExecutionMode::ORT_PARALLEL. The pool must own at least one worker thread, i.e.
+   * its thread count must be zero (default) or greater than one. The callback is invoked on that worker
+   * thread once the run completes.
+   *
+   * \param[in] session
+   * \param[in] run_options If nullptr, will use a default ::OrtRunOptions. If not nullptr, it must stay valid
+   *                        until the callback is invoked.
+   * \param[in] input_names Array of null terminated UTF8 encoded strings of the input names
+   * \param[in] input Array of ::OrtValue%s of the input values
+   * \param[in] input_len Number of elements in the input_names and inputs arrays
+   * \param[in] output_names Array of null terminated UTF8 encoded strings of the output names
+   * \param[in] output_names_len Number of elements in the output_names and outputs array
+   * \param[out] output Array of OrtValue* owned by customers. It must stay valid until the callback is invoked,
+   *                    which receives it back through its outputs argument. Entries that are nullptr are
+   *                    filled with newly allocated ::OrtValue%s that the caller must release.
+   * \param[in] run_async_callback Callback function on model run completion
+   * \param[in] user_data User data that pass back to run_async_callback
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.16.
+   */
+  ORT_API2_STATUS(RunAsync, _Inout_ OrtSession* session, _In_opt_ const OrtRunOptions* run_options,
+                  _In_reads_(input_len) const char* const* input_names,
+                  _In_reads_(input_len) const OrtValue* const* input, size_t input_len,
+                  _In_reads_(output_names_len) const char* const* output_names, size_t output_names_len,
+                  _Inout_updates_all_(output_names_len) OrtValue** output,
+                  _In_ RunAsyncCallbackFn run_async_callback, _In_opt_ void* user_data);
+
+  /** \brief Resolve the inputs and outputs of repeated runs once
+   *
+   * The names are looked up and validated once, so that OrtApi::RunPrepared takes the inputs and outputs by
+   * position without hashing names or allocating per run, which matters for models that run in microseconds.
+   *
+   * A prepared run keeps state updated by each of its runs, so it must not be used by several threads at the same
+   * time. Create one per thread to run concurrently. It must be released before the session.
+   *
+   * \param[in] session
+   * \param[in] input_names Array of null terminated UTF8 encoded strings of the input names
+   * \param[in] input_len Number of elements in the input_names array
+   * \param[in] output_names Array of null terminated UTF8 encoded strings of the output names
+   * \param[in] output_names_len Number of elements in the output_names array
+   * \param[out] out Newly created ::OrtPreparedRun. Must be freed with OrtApi::ReleasePreparedRun
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.16.
+   */
+  ORT_API2_STATUS(CreatePreparedRun, _In_ const OrtSession* session,
+                  _In_reads_(input_len) const char* const* input_names, size_t input_len,
+                  _In_reads_(output_names_len) const char* const* output_names, size_t output_names_len,
+                  _Outptr_ OrtPreparedRun** out);
+
+  /** \brief Release an ::OrtPreparedRun obtained from OrtApi::CreatePreparedRun
+   *
+   * \since Version 1.16.
+   */
+  ORT_CLASS_RELEASE(PreparedRun);
+
+  /** \brief Run the model with inputs and outputs resolved by OrtApi::CreatePreparedRun
+   *
+   * \param[in] session The session the run was prepared for
+   * \param[in] run_options If nullptr, will use a default ::OrtRunOptions
+   * \param[in] prepared_run
+   * \param[in] input Array of ::OrtValue%s in the order of the input names of the prepared run
+   * \param[in] input_len Number of elements in the input array, which must be the number of input names
+   * \param[out] output Array of ::OrtValue%s in the order of the output names of the prepared run.
+   *                    Entries that are nullptr are filled with newly allocated ::OrtValue%s that the caller must
+   *                    release, the others are used as preallocated outputs.
+   * \param[in] output_len Number of elements in the output array, which must be the number of output names
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.16.
+   */
+  ORT_API2_STATUS(RunPrepared, _Inout_ OrtSession* session, _In_opt_ const OrtRunOptions* run_options,
+                  _Inout_ OrtPreparedRun* prepared_run,
+                  _In_reads_(input_len) const OrtValue* const* input, size_t input_len,
+                  _Inout_updates_all_(output_len) OrtValue** output, size_t output_len);
+
+  /** \brief Update the values of constant initializers of a session in place
+   *
+   * Applies new weights, e.g. of a fine-tuned variant of the model, without creating a new session. Only the kernels
+   * of the nodes consuming the initializers are created again, the other kernels and their pre-packed weights are kept.
+   * The update waits for the runs in progress to complete and the runs started meanwhile wait for the update, so each
+   * run uses either the previous or the new values of all the initializers. Nothing is changed if an error is returned.
+   *
+   * Initializers removed by graph optimizations, used by subgraphs or compiled into the nodes of an execution provider
+   * can not be updated, nor can initializers released once pre-packed by all of their consumers. Disable
+   * pre-packing with "session.disable_prepacking" to update those.
+   *
+   * \param[in] session
+   * \param[in] initializer_names Names of the initializers to update
+   * \param[in] initializers Array of ::OrtValue%s with the new values, which must have the type and shape of the
+   *                         initializers. The data is copied, so they can be released once the function returns.
+   * \param[in] initializers_len Number of elements in the initializer_names and initializers arrays
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.16.
+   */
+  ORT_API2_STATUS(UpdateSessionInitializers, _Inout_ OrtSession* session,
+                  _In_reads_(initializers_len) const char* const* initializer_names,
+                  _In_reads_(initializers_len) const OrtValue* const* initializers, size_t initializers_len);
+
+  /** \brief Get the node timings of the latest runs sampled by the sampling profiler of a session
+   *
+   * The sampling profiler times the nodes of one in every N runs, N being set with the
+   * "session.sampling_profiler_interval" session config entry, and keeps the latest
+   * "session.sampling_profiler_max_runs" sampled runs. It can be read while runs are in progress.
+   *
+   * \param[in] session
+   * \param[in] allocator Allocator used to allocate the returned string
+   * \param[out] out The sampled runs in chrome tracing format, one process per run, the oldest first.
+   *                 Must be freed with the allocator.
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.16.
+   */
+  ORT_API2_STATUS(SessionGetSampledRuns, _In_ const OrtSession* session, _Inout_ OrtAllocator* allocator,
+                  _Outptr_ char** out);
+
+  /** \brief Get the runtime metrics of the process in the Prometheus text exposition format
+   *
+   * The metrics include the durations of the runs and the waits of the asynchronous runs for a worker thread,
+   * the failed runs, the bytes in use and reserved by the allocators of each session, the statistics of the
+   * intra-op thread pool of each session, the CUDA graph replays and the TensorRT engine builds.
+   * Exporters can serve the string as is to a Prometheus server, or convert it for OpenTelemetry.
+   *
+   * \param[in] allocator Allocator used to allocate the returned string
+   * \param[out] out The metrics. Must be freed with the allocator.
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.16.
+   */
+  ORT_API2_STATUS(GetMetrics, _Inout_ OrtAllocator* allocator, _Outptr_ char** out);
+
+  /** \brief Create a pipeline that runs several sessions in sequence, feeding outputs of earlier stages to later ones
+   *
+   * Link i feeds output link_src_outputs[i] of stage link_src_stages[i] to input link_dst_inputs[i] of the later stage
+   * link_dst_stages[i]. A linked output is fetched on the device where its consumer needs it, so that e.g. a tensor
+   * passed between two CUDA sessions stays in device memory instead of being copied to CPU memory and back.
+   * It is released as soon as its last consumer has run.
+   *
+   * The inputs of the stages that are not linked are the inputs of the pipeline. Inputs with the same name in
+   * several stages are fed the same value.
+   *
+   * To also share memory between the stages, create the sessions with the
+   * "session.use_env_allocators" session config entry and allocators registered with
+   * OrtApi::CreateAndRegisterAllocator.
+   *
+   * \param[in] sessions Initialized sessions of the stages, in the order they run. They must outlive the pipeline.
+   * \param[in] num_sessions Number of elements in the sessions array
+   * \param[in] link_src_stages Array of the stages that produce the linked outputs
+   * \param[in] link_src_outputs Array of null terminated UTF8 encoded strings of the linked output names
+   * \param[in] link_dst_stages Array of the stages that consume the linked outputs
+   * \param[in] link_dst_inputs Array of null terminated UTF8 encoded strings of the input names fed by the links.
+   *                            An input can only be linked once.
+   * \param[in] num_links Number of elements in the link arrays
+   * \param[out] out Newly created ::OrtSessionPipeline. Must be freed with OrtApi::ReleaseSessionPipeline
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.16.
+   */
+  ORT_API2_STATUS(CreateSessionPipeline, _In_reads_(num_sessions) OrtSession* const* sessions, size_t num_sessions,
+                  _In_reads_(num_links) const size_t* link_src_stages,
+                  _In_reads_(num_links) const char* const* link_src_outputs,
+                  _In_reads_(num_links) const size_t* link_dst_stages,
+                  _In_reads_(num_links) const char* const* link_dst_inputs, size_t num_links,
+                  _Outptr_ OrtSessionPipeline** out);
+
+  /** \brief Release an ::OrtSessionPipeline obtained from OrtApi::CreateSessionPipeline
+   *
+   * \since Version 1.16.
+   */
+  ORT_CLASS_RELEASE(SessionPipeline);
+
+  /** \brief Run the sessions of a pipeline
+   *
+   * Concurrent runs of a pipeline are allowed, and run different stages at the same time.
+   *
+   * \param[in] pipeline
+   * \param[in] run_options If nullptr, will use a default ::OrtRunOptions. Used by the runs of all the stages.
+   * \param[in] input_names Array of null terminated UTF8 encoded strings of the input names of the pipeline
+   * \param[in] input Array of ::OrtValue%s of the input values
+   * \param[in] input_len Number of elements in the input_names and inputs arrays
+   * \param[in] output_names Array of null terminated UTF8 encoded strings of the output names. A name refers to the
+   *                         output of the last stage that has an output with that name.
+   * \param[in] output_names_len Number of elements in the output_names and outputs array
+   * \param[out] output Array of ::OrtValue%s that the outputs are stored in. Entries that are nullptr are filled with
+   *                    newly allocated ::OrtValue%s that the caller must release. Outputs that are not linked are
+   *                    returned in CPU memory, and linked outputs on the device of their first consumer.
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.16.
+   */
+  ORT_API2_STATUS(RunSessionPipeline, _In_ const OrtSessionPipeline* pipeline,
+                  _In_opt_ const OrtRunOptions* run_options,
+                  _In_reads_(input_len) const char* const* input_names,
+                  _In_reads_(input_len) const OrtValue* const* input, size_t input_len,
+                  _In_reads_(output_names_len) const char* const* output_names, size_t output_names_len,
+                  _Inout_updates_all_(output_names_len) OrtValue** output);
 };
 
 /*
@@ -141,6 +141,13 @@ std::string GetBuildInfoString();
 /// <returns>vector of strings</returns>
 std::vector<std::string> GetAvailableProviders();
 
+/// <summary>
+/// This is a C++ wrapper for OrtApi::GetMetrics() and
+/// returns the runtime metrics of the process in the Prometheus text exposition format.
+/// </summary>
+/// <returns>string</returns>
+std::string GetMetrics();
+
 /** \brief IEEE 754 half-precision floating point data type
  * \details It is necessary for type dispatching to make use of C++ API
  * The type is implicitly convertible to/from uint16_t.
@@ -231,6 +238,8 @@ ORT_DEFINE_RELEASE(TypeInfo);
 ORT_DEFINE_RELEASE(Value);
 ORT_DEFINE_RELEASE(ModelMetadata);
 ORT_DEFINE_RELEASE(IoBinding);
+ORT_DEFINE_RELEASE(PreparedRun);
+ORT_DEFINE_RELEASE(SessionPipeline);
 ORT_DEFINE_RELEASE(ArenaCfg);
 ORT_DEFINE_RELEASE(Status);
 ORT_DEFINE_RELEASE(OpAttr);
@@ -699,6 +708,7 @@ struct ModelMetadata : detail::Base<OrtModelMetadata> {
 };
 
 struct IoBinding;
+struct PreparedRun;
 
 namespace detail {
 
@@ -741,6 +751,15 @@ struct ConstSessionImpl : Base<T> {
   AllocatedStringPtr GetOverridableInitializerNameAllocated(size_t index, OrtAllocator* allocator) const;  ///< Wraps OrtApi::SessionGetOverridableInitializerName
 
   uint64_t GetProfilingStartTimeNs() const;  ///< Wraps OrtApi::SessionGetProfilingStartTimeNs
+
+  /** \brief Returns the node timings of the latest runs sampled by the sampling profiler, in chrome tracing format
+   *
+   * \param allocator to allocate memory for the string returned
+   * \return a instance of smart pointer that would deallocate the buffer when out of scope.
+   *  The OrtAllocator instances must be valid at the point of memory release.
+   */
+  AllocatedStringPtr GetSampledRunsAllocated(OrtAllocator* allocator) const;  ///< Wraps OrtApi::SessionGetSampledRuns
+
   ModelMetadata GetModelMetadata() const;    ///< Wraps OrtApi::SessionGetModelMetadata
 
   TypeInfo GetInputTypeInfo(size_t index) const;                   ///< Wraps OrtApi::SessionGetInputTypeInfo
@@ -781,6 +800,52 @@ struct SessionImpl : ConstSessionImpl<T> {
 
   void Run(const RunOptions& run_options, const IoBinding&);  ///< Wraps OrtApi::RunWithBinding
 
+  /** \brief Run the model with inputs and outputs resolved by a PreparedRun
+   *
+   * Wraps OrtApi::RunPrepared
+   *
+   * \param[in] run_options
+   * \param[in] prepared_run Must not be used by another thread during the run
+   * \param[in] input_values Array of Value objects in the order of the input names of the prepared run
+   * \param[in] input_count Number of elements in the input_values array
+   * \param[out] output_values Array of Values in the order of the output names of the prepared run. Null values
+   *             are filled with outputs allocated by onnxruntime, the others are used as preallocated outputs.
+   * \param[in] output_count Number of elements in the output_values array
+   */
+  void Run(const RunOptions& run_options, PreparedRun& prepared_run, const Value* input_values, size_t input_count,
+           Value* output_values, size_t output_count);
+
+  /** \brief Run the model asynchronously in a thread owned by the session
+   *
+   * Wraps OrtApi::RunAsync
+   *
+   * \param[in] run_options Must stay valid until the callback is invoked
+   * \param[in] input_names Array of null terminated UTF8 encoded strings of the input names
+   * \param[in] input_values Array of Value objects of length input_count
+   * \param[in] input_count Number of elements in the input_names and inputs arrays
+   * \param[in] output_names Array of null terminated UTF8 encoded strings of the output names
+   * \param[out] output_values Array of provided Values to be filled with outputs.
+   *             On calling RunAsync, output_values[i] could either be initialized by a null pointer or a preallocated OrtValue*.
+   *             Later, output_values will be passed to the callback through its outputs argument,
+   *             nulls will be replaced by OrtValue* allocated by onnxruntime. The array must stay valid until then.
+   * \param[in] output_count Number of elements in the output_names and outputs array
+   * \param[in] callback Callback function on model run completion
+   * \param[in] user_data User data that pass back to the callback
+   */
+  void RunAsync(const RunOptions& run_options, const char* const* input_names, const Value* input_values, size_t input_count,
+                const char* const* output_names, Value* output_values, size_t output_count, RunAsyncCallbackFn callback, void* user_data);
+
+  /** \brief Update the values of constant initializers of the session in place
+   *
+   * Wraps OrtApi::UpdateSessionInitializers
+   *
+   * \param[in] initializer_names Array of null terminated UTF8 encoded strings of the initializer names
+   * \param[in] initializer_values Array of Value objects with the new values, of length initializer_count
+   * \param[in] initializer_count Number of elements in the initializer_names and initializer_values arrays
+   */
+  void UpdateInitializers(const char* const* initializer_names, const Value* initializer_values,
+                          size_t initializer_count);
+
   /** \brief End profiling and return a copy of the profiling file name.
    *
    * \param allocator to allocate memory for the copy of the string returned
@@ -1551,6 +1616,48 @@ struct IoBinding : detail::IoBindingImpl<OrtIoBinding> {
   UnownedIoBinding GetUnowned() const { return UnownedIoBinding{this->p_}; }
 };
 
+/** \brief Wrapper around ::OrtPreparedRun
+ *
+ */
+struct PreparedRun : detail::Base<OrtPreparedRun> {
+  explicit PreparedRun(std::nullptr_t) {}  ///< Create an empty object for convenience. Sometimes, we want to initialize members later.
+  /// Wraps OrtApi::CreatePreparedRun
+  PreparedRun(const Session& session, const char* const* input_names, size_t input_count,
+              const char* const* output_names, size_t output_count);
+};
+
+/** \brief Wrapper around ::OrtSessionPipeline
+ *
+ */
+struct SessionPipeline : detail::Base<OrtSessionPipeline> {
+  /// Links an output of a stage to an input of a later stage
+  struct Link {
+    size_t src_stage;
+    const char* src_output;
+    size_t dst_stage;
+    const char* dst_input;
+  };
+
+  explicit SessionPipeline(std::nullptr_t) {}  ///< Create an empty object for convenience. Sometimes, we want to initialize members later.
+  /// Wraps OrtApi::CreateSessionPipeline
+  SessionPipeline(Session* const* sessions, size_t num_sessions, const Link* links, size_t num_links);
+
+  /** \brief Run the sessions of the pipeline
+   *
+   * Wraps OrtApi::RunSessionPipeline
+   *
+   * \param[in] run_options
+   * \param[in] input_names Array of null terminated strings of length input_count that is the list of input names
+   * \param[in] input_values Array of Value objects of length input_count that is the list of input values
+   * \param[in] input_count Number of inputs (the size of the input_names & input_values arrays)
+   * \param[in] output_names Array of C style strings of length output_count that is the list of output names
+   * \param[in] output_count Number of outputs (the size of the output_names array)
+   * \return A std::vector of Value objects that directly maps to the output_names array (eg. output_name[0] is the first entry of the returned vector)
+   */
+  std::vector<Value> Run(const RunOptions& run_options, const char* const* input_names, const Value* input_values,
+                         size_t input_count, const char* const* output_names, size_t output_count) const;
+};
+
 /*! \struct Ort::ArenaCfg
  * \brief it is a structure that represents the configuration of an arena based allocator
  * \details Please see docs/C_API.md for details
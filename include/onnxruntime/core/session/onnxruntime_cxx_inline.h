@@ -372,6 +372,47 @@ inline IoBinding::IoBinding(Session& session) {
   ThrowOnError(GetApi().CreateIoBinding(session, &this->p_));
 }
 
+inline PreparedRun::PreparedRun(const Session& session, const char* const* input_names, size_t input_count,
+                                const char* const* output_names, size_t output_count) {
+  ThrowOnError(GetApi().CreatePreparedRun(session, input_names, input_count, output_names, output_count, &this->p_));
+}
+
+inline SessionPipeline::SessionPipeline(Session* const* sessions, size_t num_sessions, const Link* links,
+                                        size_t num_links) {
+  std::vector<OrtSession*> ort_sessions;
+  ort_sessions.reserve(num_sessions);
+  for (size_t i = 0; i < num_sessions; i++) {
+    ort_sessions.push_back(*sessions[i]);
+  }
+
+  std::vector<size_t> src_stages, dst_stages;
+  std::vector<const char*> src_outputs, dst_inputs;
+  for (size_t i = 0; i < num_links; i++) {
+    src_stages.push_back(links[i].src_stage);
+    src_outputs.push_back(links[i].src_output);
+    dst_stages.push_back(links[i].dst_stage);
+    dst_inputs.push_back(links[i].dst_input);
+  }
+
+  ThrowOnError(GetApi().CreateSessionPipeline(ort_sessions.data(), num_sessions, src_stages.data(), src_outputs.data(),
+                                              dst_stages.data(), dst_inputs.data(), num_links, &this->p_));
+}
+
+inline std::vector<Value> SessionPipeline::Run(const RunOptions& run_options, const char* const* input_names,
+                                               const Value* input_values, size_t input_count,
+                                               const char* const* output_names, size_t output_count) const {
+  static_assert(sizeof(Value) == sizeof(OrtValue*), "Value is really just an array of OrtValue* in memory, so we can reinterpret_cast safely");
+  std::vector<Value> output_values;
+  output_values.reserve(output_count);
+  for (size_t i = 0; i < output_count; i++)
+    output_values.emplace_back(nullptr);
+  auto ort_input_values = reinterpret_cast<const OrtValue* const*>(input_values);
+  auto ort_output_values = reinterpret_cast<OrtValue**>(output_values.data());
+  ThrowOnError(GetApi().RunSessionPipeline(this->p_, run_options, input_names, ort_input_values, input_count,
+                                           output_names, output_count, ort_output_values));
+  return output_values;
+}
+
 inline ArenaCfg::ArenaCfg(size_t max_mem, int arena_extend_strategy, int initial_chunk_size_bytes, int max_dead_bytes_per_chunk) {
   ThrowOnError(GetApi().CreateArenaCfg(max_mem, arena_extend_strategy, initial_chunk_size_bytes, max_dead_bytes_per_chunk, &p_));
 }
@@ -876,6 +917,13 @@ inline uint64_t ConstSessionImpl<T>::GetProfilingStartTimeNs() const {
   return out;
 }
 
+template <typename T>
+inline AllocatedStringPtr ConstSessionImpl<T>::GetSampledRunsAllocated(OrtAllocator* allocator) const {
+  char* out = nullptr;
+  ThrowOnError(GetApi().SessionGetSampledRuns(this->p_, allocator, &out));
+  return AllocatedStringPtr(out, detail::AllocatedFree(allocator));
+}
+
 template <typename T>
 inline ModelMetadata ConstSessionImpl<T>::GetModelMetadata() const {
   OrtModelMetadata* out;
@@ -929,6 +977,34 @@ inline void SessionImpl<T>::Run(const RunOptions& run_options, const IoBinding&
   ThrowOnError(GetApi().RunWithBinding(this->p_, run_options, io_binding));
 }
 
+template <typename T>
+inline void SessionImpl<T>::Run(const RunOptions& run_options, PreparedRun& prepared_run, const Value* input_values,
+                                size_t input_count, Value* output_values, size_t output_count) {
+  static_assert(sizeof(Value) == sizeof(OrtValue*), "Value is really just an array of OrtValue* in memory, so we can reinterpret_cast safely");
+  auto ort_input_values = reinterpret_cast<const OrtValue* const*>(input_values);
+  auto ort_output_values = reinterpret_cast<OrtValue**>(output_values);
+  ThrowOnError(GetApi().RunPrepared(this->p_, run_options, prepared_run, ort_input_values, input_count,
+                                    ort_output_values, output_count));
+}
+
+template <typename T>
+inline void SessionImpl<T>::RunAsync(const RunOptions& run_options, const char* const* input_names, const Value* input_values, size_t input_count,
+                                     const char* const* output_names, Value* output_values, size_t output_count, RunAsyncCallbackFn callback, void* user_data) {
+  auto ort_input_values = reinterpret_cast<const OrtValue* const*>(input_values);
+  auto ort_output_values = reinterpret_cast<OrtValue**>(output_values);
+  ThrowOnError(GetApi().RunAsync(this->p_, run_options, input_names,
+                                 ort_input_values, input_count, output_names, output_count,
+                                 ort_output_values, callback, user_data));
+}
+
+template <typename T>
+inline void SessionImpl<T>::UpdateInitializers(const char* const* initializer_names, const Value* initializer_values,
+                                               size_t initializer_count) {
+  auto ort_initializer_values = reinterpret_cast<const OrtValue* const*>(initializer_values);
+  ThrowOnError(GetApi().UpdateSessionInitializers(this->p_, initializer_names, ort_initializer_values,
+                                                  initializer_count));
+}
+
 template <typename T>
 inline AllocatedStringPtr SessionImpl<T>::EndProfilingAllocated(OrtAllocator* allocator) {
   char* out = nullptr;
@@ -1812,6 +1888,14 @@ inline std::vector<std::string> GetAvailableProviders() {
   return available_providers;
 }
 
+inline std::string GetMetrics() {
+  AllocatorWithDefaultOptions allocator;
+  char* out = nullptr;
+  ThrowOnError(GetApi().GetMetrics(allocator, &out));
+  AllocatedStringPtr metrics(out, detail::AllocatedFree(allocator));
+  return metrics.get();
+}
+
 template <typename TOp, typename TKernel, bool WithStatus>
 void CustomOpBase<TOp, TKernel, WithStatus>::GetSessionConfigs(std::unordered_map<std::string, std::string>& out,
                                                                ConstSessionOptions options) const {
@@ -16,6 +16,9 @@
 
 #pragma once
 #include "onnxruntime_cxx_api.h"
+#include <algorithm>
+#include <array>
+#include <new>
 #include <optional>
 #include <numeric>
 #include <unordered_set>
@@ -28,12 +31,60 @@ class TensorBase {
   TensorBase(OrtKernelContext* ctx) : ctx_(ctx) {}
   virtual ~TensorBase() {}
   operator bool() const {
-    return shape_.has_value();
+    return has_shape_;
   }
 
  protected:
+  // Dims of a rank up to kInlineRank are kept inline, so binding an argument does not allocate;
+  // the vector returned by Shape() is only materialized when asked for.
+  static constexpr size_t kInlineRank = 8;
+
+  void SetShape(const int64_t* dims, size_t num_dims) {
+    has_shape_ = true;
+    num_dims_ = num_dims;
+    shape_.reset();
+    if (num_dims <= kInlineRank) {
+      std::copy_n(dims, num_dims, inline_dims_.begin());
+    } else {
+      shape_.emplace(dims, dims + num_dims);
+    }
+  }
+  void SetShape(const ConstValue& value) {
+    auto type_shape_info = value.GetTensorTypeAndShapeInfo();
+    const size_t num_dims = type_shape_info.GetDimensionsCount();
+    has_shape_ = true;
+    num_dims_ = num_dims;
+    shape_.reset();
+    if (num_dims <= kInlineRank) {
+      Ort::ThrowOnError(GetApi().GetDimensions(type_shape_info, inline_dims_.data(), num_dims));
+    } else {
+      shape_ = type_shape_info.GetShape();
+    }
+  }
+  const int64_t* Dims() const {
+    return num_dims_ <= kInlineRank ? inline_dims_.data() : shape_->data();
+  }
+  const std::vector<int64_t>& GetShapeVector() const {
+    if (!has_shape_) {
+      ORT_CXX_API_THROW("tensor shape is not yet initialized", OrtErrorCode::ORT_RUNTIME_EXCEPTION);
+    }
+    if (!shape_.has_value()) {
+      shape_.emplace(Dims(), Dims() + num_dims_);
+    }
+    return shape_.value();
+  }
+  int64_t GetNumberOfElement() const {
+    if (!has_shape_) {
+      return 0;
+    }
+    return std::accumulate(Dims(), Dims() + num_dims_, 1LL, std::multiplies<int64_t>());
+  }
+
   struct KernelContext ctx_;
-  std::optional<std::vector<int64_t>> shape_;
+  bool has_shape_ = false;
+  size_t num_dims_ = 0;
+  std::array<int64_t, kInlineRank> inline_dims_{};
+  mutable std::optional<std::vector<int64_t>> shape_;
 };
 
 template <typename T>
@@ -60,45 +111,37 @@ class Tensor : public TensorBase {
         ORT_CXX_API_THROW("invalid indice for Ort::Custom::Tensor", OrtErrorCode::ORT_INVALID_ARGUMENT);
       }
       const_value_ = ctx_.GetInput(indice);
-      auto type_shape_info = const_value_.GetTensorTypeAndShapeInfo();
-      shape_ = type_shape_info.GetShape();
+      SetShape(const_value_);
+      const_data_ = reinterpret_cast<const TT*>(const_value_.GetTensorRawData());
     }
   }
   const std::vector<int64_t>& Shape() const {
-    if (!shape_.has_value()) {
-      ORT_CXX_API_THROW("tensor shape is not yet initialized", OrtErrorCode::ORT_RUNTIME_EXCEPTION);
-    }
-    return shape_.value();
+    return GetShapeVector();
   }
   int64_t NumberOfElement() const {
-    if (shape_.has_value()) {
-      return std::accumulate(shape_->begin(), shape_->end(), 1LL, std::multiplies<int64_t>());
-    } else {
-      return 0;
-    }
+    return GetNumberOfElement();
   }
   const TT* Data() const {
-    return reinterpret_cast<const TT*>(const_value_.GetTensorRawData());
+    return const_data_;
   }
   TT* Allocate(const std::vector<int64_t>& shape) {
-    shape_ = shape;
+    SetShape(shape.data(), shape.size());
     if (!data_) {
-      shape_ = shape;
-      data_ = ctx_.GetOutput(indice_, shape).template GetTensorMutableData<TT>();
+      data_ = ctx_.GetOutput(indice_, shape.data(), shape.size()).template GetTensorMutableData<TT>();
     }
     return data_;
   }
   static TT GetT() { return (TT)0; }
   const Span<T>& AsSpan() {
-    if (!shape_.has_value() || shape_->size() != 1) {
+    if (!has_shape_ || num_dims_ != 1) {
       ORT_CXX_API_THROW("invalid shape while trying to get a span out of Ort::Custom::Tensor",
                         OrtErrorCode::ORT_RUNTIME_EXCEPTION);
     }
-    span_.Assign(Data(), static_cast<size_t>((*shape_)[0]));
+    span_.Assign(Data(), static_cast<size_t>(Dims()[0]));
     return span_;
   }
   const T& AsScalar() {
-    if (!shape_.has_value() || shape_->size() != 1 || (*shape_)[0] != 1) {
+    if (!has_shape_ || num_dims_ != 1 || Dims()[0] != 1) {
       ORT_CXX_API_THROW("invalid shape while trying to get a scalar from Ort::Custom::Tensor",
                         OrtErrorCode::ORT_RUNTIME_EXCEPTION);
     }
@@ -108,8 +151,9 @@ class Tensor : public TensorBase {
  private:
   size_t indice_;
   bool is_input_;
-  ConstValue const_value_;  // for input
-  TT* data_{};              // for output
+  ConstValue const_value_;     // for input
+  const TT* const_data_{};     // for input
+  TT* data_{};                 // for output
   Span<T> span_;
 };
 
@@ -124,8 +168,7 @@ class Tensor<std::string> : public TensorBase {
         ORT_CXX_API_THROW("invalid indice for Ort::Custom::Tensor", OrtErrorCode::ORT_INVALID_ARGUMENT);
       }
       auto const_value = ctx_.GetInput(indice);
-      auto type_shape_info = const_value.GetTensorTypeAndShapeInfo();
-      shape_ = type_shape_info.GetShape();
+      SetShape(const_value);
       auto num_chars = const_value.GetStringTensorDataLength();
       // note - there will be copy ...
       auto num_strings = static_cast<size_t>(NumberOfElement());
@@ -148,17 +191,13 @@ class Tensor<std::string> : public TensorBase {
     }
   }
   int64_t NumberOfElement() const {
-    if (shape_.has_value()) {
-      return std::accumulate(shape_->begin(), shape_->end(), 1ULL, std::multiplies<int64_t>());
-    } else {
-      return 0;
-    }
+    return GetNumberOfElement();
   }
   const strings& Data() const {
     return input_strings_;
   }
   void SetStringOutput(const strings& ss, const std::vector<int64_t>& dims) {
-    shape_ = dims;
+    SetShape(dims.data(), dims.size());
     std::vector<const char*> raw;
     for (const auto& s : ss) {
       raw.push_back(s.data());
@@ -196,8 +235,7 @@ class Tensor<std::string_view> : public TensorBase {
         ORT_CXX_API_THROW("invalid indice for Ort::Custom::Tensor", OrtErrorCode::ORT_INVALID_ARGUMENT);
       }
       auto const_value = ctx_.GetInput(indice);
-      auto type_shape_info = const_value.GetTensorTypeAndShapeInfo();
-      shape_ = type_shape_info.GetShape();
+      SetShape(const_value);
       auto num_chars = const_value.GetStringTensorDataLength();
       chars_.resize(num_chars + 1, '\0');
       auto num_strings = static_cast<size_t>(NumberOfElement());
@@ -212,17 +250,13 @@ class Tensor<std::string_view> : public TensorBase {
     }
   }
   int64_t NumberOfElement() const {
-    if (shape_.has_value()) {
-      return std::accumulate(shape_->begin(), shape_->end(), 1ULL, std::multiplies<int64_t>());
-    } else {
-      return 0;
-    }
+    return GetNumberOfElement();
   }
   const string_views& Data() const {
     return input_string_views_;
   }
   void SetStringOutput(const strings& ss, const std::vector<int64_t>& dims) {
-    shape_ = dims;
+    SetShape(dims.data(), dims.size());
     std::vector<const char*> raw;
     for (const auto& s : ss) {
       raw.push_back(s.data());
@@ -251,6 +285,48 @@ class Tensor<std::string_view> : public TensorBase {
 
 using TensorPtr = std::unique_ptr<Custom::TensorBase>;
 
+// Owns the tensors bound to the arguments of a call. Tensors that fit a slot, which covers all numeric types,
+// are constructed in place in an inline buffer so that marshalling the arguments does not allocate;
+// larger tensors and arguments beyond kInlineCapacity fall back to the heap.
+class TensorArena {
+ public:
+  TensorArena() = default;
+  TensorArena(const TensorArena&) = delete;
+  TensorArena& operator=(const TensorArena&) = delete;
+  ~TensorArena() {
+    for (size_t i = num_inline_; i > 0; --i) {
+      inline_tensors_[i - 1]->~TensorBase();
+    }
+  }
+
+  template <typename TensorT, typename... CtorArgs>
+  TensorT* Emplace(CtorArgs&&... args) {
+    if constexpr (sizeof(TensorT) <= kSlotSize && alignof(TensorT) <= kSlotAlignment) {
+      if (num_inline_ < kInlineCapacity) {
+        auto tensor = new (&slots_[num_inline_]) TensorT(std::forward<CtorArgs>(args)...);
+        inline_tensors_[num_inline_++] = tensor;
+        return tensor;
+      }
+    }
+    heap_tensors_.push_back(std::make_unique<TensorT>(std::forward<CtorArgs>(args)...));
+    return static_cast<TensorT*>(heap_tensors_.back().get());
+  }
+
+ private:
+  static constexpr size_t kInlineCapacity = 8;
+  static constexpr size_t kSlotSize = sizeof(Tensor<float>);
+  static constexpr size_t kSlotAlignment = alignof(Tensor<float>);
+
+  struct alignas(kSlotAlignment) Slot {
+    unsigned char bytes[kSlotSize];
+  };
+
+  Slot slots_[kInlineCapacity];
+  TensorBase* inline_tensors_[kInlineCapacity]{};
+  size_t num_inline_ = 0;
+  std::vector<TensorPtr> heap_tensors_;
+};
+
 //////////////////////////// OrtLiteCustomOp ////////////////////////////////
 
 struct OrtLiteCustomOp : public OrtCustomOp {
@@ -260,146 +336,146 @@ struct OrtLiteCustomOp : public OrtCustomOp {
   // CreateTuple
   template <size_t ith_input, size_t ith_output, typename... Ts>
   static typename std::enable_if<sizeof...(Ts) == 0, std::tuple<>>::type
-  CreateTuple(OrtKernelContext*, std::vector<TensorPtr>&, size_t, size_t, const std::string&) {
+  CreateTuple(OrtKernelContext*, TensorArena&, size_t, size_t, const std::string&) {
     return std::make_tuple();
   }
 
   template <size_t ith_input, size_t ith_output, typename T, typename... Ts>
   static typename std::enable_if<std::is_same<T, OrtKernelContext*>::value, std::tuple<T, Ts...>>::type
-  CreateTuple(OrtKernelContext* context, std::vector<TensorPtr>& tensors, size_t num_input, size_t num_output, const std::string& ep) {
+  CreateTuple(OrtKernelContext* context, TensorArena& tensors, size_t num_input, size_t num_output, const std::string& ep) {
     std::tuple<T> current = std::tuple<OrtKernelContext*>{context};
     auto next = CreateTuple<ith_input, ith_output, Ts...>(context, tensors, num_input, num_output, ep);
     return std::tuple_cat(current, next);
   }
 
-#define CREATE_TUPLE_INPUT(data_type)                                                                                                   \
-  template <size_t ith_input, size_t ith_output, typename T, typename... Ts>                                                            \
-  static typename std::enable_if<std::is_same<T, const Custom::Tensor<data_type>*>::value, std::tuple<T, Ts...>>::type                  \
-  CreateTuple(OrtKernelContext* context, std::vector<TensorPtr>& tensors, size_t num_input, size_t num_output, const std::string& ep) { \
-    tensors.push_back(std::make_unique<Custom::Tensor<data_type>>(context, ith_input, true));                                           \
-    std::tuple<T> current = std::tuple<T>{reinterpret_cast<T>(tensors.back().get())};                                                   \
-    auto next = CreateTuple<ith_input + 1, ith_output, Ts...>(context, tensors, num_input, num_output, ep);                             \
-    return std::tuple_cat(current, next);                                                                                               \
-  }                                                                                                                                     \
-  template <size_t ith_input, size_t ith_output, typename T, typename... Ts>                                                            \
-  static typename std::enable_if<std::is_same<T, const Custom::Tensor<data_type>&>::value, std::tuple<T, Ts...>>::type                  \
-  CreateTuple(OrtKernelContext* context, std::vector<TensorPtr>& tensors, size_t num_input, size_t num_output, const std::string& ep) { \
-    tensors.push_back(std::make_unique<Custom::Tensor<data_type>>(context, ith_input, true));                                           \
-    std::tuple<T> current = std::tuple<T>{reinterpret_cast<T>(*tensors.back().get())};                                                  \
-    auto next = CreateTuple<ith_input + 1, ith_output, Ts...>(context, tensors, num_input, num_output, ep);                             \
-    return std::tuple_cat(current, next);                                                                                               \
-  }                                                                                                                                     \
-  template <size_t ith_input, size_t ith_output, typename T, typename... Ts>                                                            \
-  static typename std::enable_if<std::is_same<T, std::optional<const Custom::Tensor<data_type>*>>::value, std::tuple<T, Ts...>>::type   \
-  CreateTuple(OrtKernelContext* context, std::vector<TensorPtr>& tensors, size_t num_input, size_t num_output, const std::string& ep) { \
-    if (ith_input < num_input) {                                                                                                        \
-      tensors.push_back(std::make_unique<Custom::Tensor<data_type>>(context, ith_input, true));                                         \
-      std::tuple<T> current = std::tuple<T>{reinterpret_cast<Custom::Tensor<data_type>*>(tensors.back().get())};                        \
-      auto next = CreateTuple<ith_input + 1, ith_output, Ts...>(context, tensors, num_input, num_output, ep);                           \
-      return std::tuple_cat(current, next);                                                                                             \
-    } else {                                                                                                                            \
-      std::tuple<T> current = std::tuple<T>{};                                                                                          \
-      auto next = CreateTuple<ith_input + 1, ith_output, Ts...>(context, tensors, num_input, num_output, ep);                           \
-      return std::tuple_cat(current, next);                                                                                             \
-    }                                                                                                                                   \
-  }                                                                                                                                     \
-  template <size_t ith_input, size_t ith_output, typename T, typename... Ts>                                                            \
-  static typename std::enable_if<std::is_same<T, const Custom::Span<data_type>*>::value, std::tuple<T, Ts...>>::type                    \
-  CreateTuple(OrtKernelContext* context, std::vector<TensorPtr>& tensors, size_t num_input, size_t num_output, const std::string& ep) { \
-    if ("CPUExecutionProvider" != ep) {                                                                                                 \
-      ORT_CXX_API_THROW("span input could only be applied to CPU EP", OrtErrorCode::ORT_RUNTIME_EXCEPTION);                             \
-    }                                                                                                                                   \
-    tensors.push_back(std::make_unique<Custom::Tensor<data_type>>(context, ith_input, true));                                           \
-    std::tuple<T> current = std::tuple<T>{&reinterpret_cast<Custom::Tensor<data_type>*>(tensors.back().get())->AsSpan()};               \
-    auto next = CreateTuple<ith_input + 1, ith_output, Ts...>(context, tensors, num_input, num_output, ep);                             \
-    return std::tuple_cat(current, next);                                                                                               \
-  }                                                                                                                                     \
-  template <size_t ith_input, size_t ith_output, typename T, typename... Ts>                                                            \
-  static typename std::enable_if<std::is_same<T, const Custom::Span<data_type>&>::value, std::tuple<T, Ts...>>::type                    \
-  CreateTuple(OrtKernelContext* context, std::vector<TensorPtr>& tensors, size_t num_input, size_t num_output, const std::string& ep) { \
-    if ("CPUExecutionProvider" != ep) {                                                                                                 \
-      ORT_CXX_API_THROW("span input could only be applied to CPU EP", OrtErrorCode::ORT_RUNTIME_EXCEPTION);                             \
-    }                                                                                                                                   \
-    tensors.push_back(std::make_unique<Custom::Tensor<data_type>>(context, ith_input, true));                                           \
-    std::tuple<T> current = std::tuple<T>{reinterpret_cast<Custom::Tensor<data_type>*>(tensors.back().get())->AsSpan()};                \
-    auto next = CreateTuple<ith_input + 1, ith_output, Ts...>(context, tensors, num_input, num_output, ep);                             \
-    return std::tuple_cat(current, next);                                                                                               \
-  }                                                                                                                                     \
-  template <size_t ith_input, size_t ith_output, typename T, typename... Ts>                                                            \
-  static typename std::enable_if<std::is_same<T, std::optional<const Custom::Span<data_type>*>>::value, std::tuple<T, Ts...>>::type     \
-  CreateTuple(OrtKernelContext* context, std::vector<TensorPtr>& tensors, size_t num_input, size_t num_output, const std::string& ep) { \
-    if (ith_input < num_input) {                                                                                                        \
-      if ("CPUExecutionProvider" != ep) {                                                                                               \
-        ORT_CXX_API_THROW("span input could only be applied to CPU EP", OrtErrorCode::ORT_RUNTIME_EXCEPTION);                           \
-      }                                                                                                                                 \
-      tensors.push_back(std::make_unique<Custom::Tensor<data_type>>(context, ith_input, true));                                         \
-      std::tuple<T> current = std::tuple<T>{&reinterpret_cast<Custom::Tensor<data_type>*>(tensors.back().get())->AsSpan()};             \
-      auto next = CreateTuple<ith_input + 1, ith_output, Ts...>(context, tensors, num_input, num_output, ep);                           \
-      return std::tuple_cat(current, next);                                                                                             \
-    } else {                                                                                                                            \
-      std::tuple<T> current = std::tuple<T>{};                                                                                          \
-      auto next = CreateTuple<ith_input + 1, ith_output, Ts...>(context, tensors, num_input, num_output, ep);                           \
-      return std::tuple_cat(current, next);                                                                                             \
-    }                                                                                                                                   \
-  }                                                                                                                                     \
-  template <size_t ith_input, size_t ith_output, typename T, typename... Ts>                                                            \
-  static typename std::enable_if<std::is_same<T, data_type>::value, std::tuple<T, Ts...>>::type                                         \
-  CreateTuple(OrtKernelContext* context, std::vector<TensorPtr>& tensors, size_t num_input, size_t num_output, const std::string& ep) { \
-    if ("CPUExecutionProvider" != ep) {                                                                                                 \
-      ORT_CXX_API_THROW("scalar input could only be applied to CPU EP", OrtErrorCode::ORT_RUNTIME_EXCEPTION);                           \
-    }                                                                                                                                   \
-    tensors.push_back(std::make_unique<Custom::Tensor<data_type>>(context, ith_input, true));                                           \
-    std::tuple<T> current = std::tuple<T>{reinterpret_cast<Custom::Tensor<data_type>*>(tensors.back().get())->AsScalar()};              \
-    auto next = CreateTuple<ith_input + 1, ith_output, Ts...>(context, tensors, num_input, num_output, ep);                             \
-    return std::tuple_cat(current, next);                                                                                               \
-  }                                                                                                                                     \
-  template <size_t ith_input, size_t ith_output, typename T, typename... Ts>                                                            \
-  static typename std::enable_if<std::is_same<T, std::optional<data_type>>::value, std::tuple<T, Ts...>>::type                          \
-  CreateTuple(OrtKernelContext* context, std::vector<TensorPtr>& tensors, size_t num_input, size_t num_output, const std::string& ep) { \
-    if (ith_input < num_input) {                                                                                                        \
-      if ("CPUExecutionProvider" != ep) {                                                                                               \
-        ORT_CXX_API_THROW("scalar input could only be applied to CPU EP", OrtErrorCode::ORT_RUNTIME_EXCEPTION);                         \
-      }                                                                                                                                 \
-      tensors.push_back(std::make_unique<Custom::Tensor<data_type>>(context, ith_input, true));                                         \
-      std::tuple<T> current = std::tuple<T>{reinterpret_cast<Custom::Tensor<data_type>*>(tensors.back().get())->AsScalar()};            \
-      auto next = CreateTuple<ith_input + 1, ith_output, Ts...>(context, tensors, num_input, num_output, ep);                           \
-      return std::tuple_cat(current, next);                                                                                             \
-    } else {                                                                                                                            \
-      std::tuple<T> current = std::tuple<T>{};                                                                                          \
-      auto next = CreateTuple<ith_input + 1, ith_output, Ts...>(context, tensors, num_input, num_output, ep);                           \
-      return std::tuple_cat(current, next);                                                                                             \
-    }                                                                                                                                   \
-  }
-#define CREATE_TUPLE_OUTPUT(data_type)                                                                                                  \
-  template <size_t ith_input, size_t ith_output, typename T, typename... Ts>                                                            \
-  static typename std::enable_if<std::is_same<T, Custom::Tensor<data_type>*>::value, std::tuple<T, Ts...>>::type                        \
-  CreateTuple(OrtKernelContext* context, std::vector<TensorPtr>& tensors, size_t num_input, size_t num_output, const std::string& ep) { \
-    tensors.push_back(std::make_unique<Custom::Tensor<data_type>>(context, ith_output, false));                                         \
-    std::tuple<T> current = std::tuple<T>{reinterpret_cast<T>(tensors.back().get())};                                                   \
-    auto next = CreateTuple<ith_input, ith_output + 1, Ts...>(context, tensors, num_input, num_output, ep);                             \
-    return std::tuple_cat(current, next);                                                                                               \
-  }                                                                                                                                     \
-  template <size_t ith_input, size_t ith_output, typename T, typename... Ts>                                                            \
-  static typename std::enable_if<std::is_same<T, Custom::Tensor<data_type>&>::value, std::tuple<T, Ts...>>::type                        \
-  CreateTuple(OrtKernelContext* context, std::vector<TensorPtr>& tensors, size_t num_input, size_t num_output, const std::string& ep) { \
-    tensors.push_back(std::make_unique<Custom::Tensor<data_type>>(context, ith_output, false));                                         \
-    std::tuple<T> current = std::tuple<T>{reinterpret_cast<T>(*tensors.back().get())};                                                  \
-    auto next = CreateTuple<ith_input, ith_output + 1, Ts...>(context, tensors, num_input, num_output, ep);                             \
-    return std::tuple_cat(current, next);                                                                                               \
-  }                                                                                                                                     \
-  template <size_t ith_input, size_t ith_output, typename T, typename... Ts>                                                            \
-  static typename std::enable_if<std::is_same<T, std::optional<Custom::Tensor<data_type>*>>::value, std::tuple<T, Ts...>>::type         \
-  CreateTuple(OrtKernelContext* context, std::vector<TensorPtr>& tensors, size_t num_input, size_t num_output, const std::string& ep) { \
-    if (ith_output < num_output) {                                                                                                      \
-      tensors.push_back(std::make_unique<Custom::Tensor<data_type>>(context, ith_output, false));                                       \
-      std::tuple<T> current = std::tuple<T>{reinterpret_cast<Custom::Tensor<data_type>*>(tensors.back().get())};                        \
-      auto next = CreateTuple<ith_input, ith_output + 1, Ts...>(context, tensors, num_input, num_output, ep);                           \
-      return std::tuple_cat(current, next);                                                                                             \
-    } else {                                                                                                                            \
-      std::tuple<T> current = std::tuple<T>{};                                                                                          \
-      auto next = CreateTuple<ith_input, ith_output + 1, Ts...>(context, tensors, num_input, num_output, ep);                           \
-      return std::tuple_cat(current, next);                                                                                             \
-    }                                                                                                                                   \
+#define CREATE_TUPLE_INPUT(data_type)                                                                                                 \
+  template <size_t ith_input, size_t ith_output, typename T, typename... Ts>                                                          \
+  static typename std::enable_if<std::is_same<T, const Custom::Tensor<data_type>*>::value, std::tuple<T, Ts...>>::type                \
+  CreateTuple(OrtKernelContext* context, TensorArena& tensors, size_t num_input, size_t num_output, const std::string& ep) {          \
+    auto tensor = tensors.Emplace<Custom::Tensor<data_type>>(context, ith_input, true);                                               \
+    std::tuple<T> current = std::tuple<T>{tensor};                                                                                    \
+    auto next = CreateTuple<ith_input + 1, ith_output, Ts...>(context, tensors, num_input, num_output, ep);                           \
+    return std::tuple_cat(current, next);                                                                                             \
+  }                                                                                                                                   \
+  template <size_t ith_input, size_t ith_output, typename T, typename... Ts>                                                          \
+  static typename std::enable_if<std::is_same<T, const Custom::Tensor<data_type>&>::value, std::tuple<T, Ts...>>::type                \
+  CreateTuple(OrtKernelContext* context, TensorArena& tensors, size_t num_input, size_t num_output, const std::string& ep) {          \
+    auto tensor = tensors.Emplace<Custom::Tensor<data_type>>(context, ith_input, true);                                               \
+    std::tuple<T> current = std::tuple<T>{*tensor};                                                                                   \
+    auto next = CreateTuple<ith_input + 1, ith_output, Ts...>(context, tensors, num_input, num_output, ep);                           \
+    return std::tuple_cat(current, next);                                                                                             \
+  }                                                                                                                                   \
+  template <size_t ith_input, size_t ith_output, typename T, typename... Ts>                                                          \
+  static typename std::enable_if<std::is_same<T, std::optional<const Custom::Tensor<data_type>*>>::value, std::tuple<T, Ts...>>::type \
+  CreateTuple(OrtKernelContext* context, TensorArena& tensors, size_t num_input, size_t num_output, const std::string& ep) {          \
+    if (ith_input < num_input) {                                                                                                      \
+      auto tensor = tensors.Emplace<Custom::Tensor<data_type>>(context, ith_input, true);                                             \
+      std::tuple<T> current = std::tuple<T>{tensor};                                                                                  \
+      auto next = CreateTuple<ith_input + 1, ith_output, Ts...>(context, tensors, num_input, num_output, ep);                         \
+      return std::tuple_cat(current, next);                                                                                           \
+    } else {                                                                                                                          \
+      std::tuple<T> current = std::tuple<T>{};                                                                                        \
+      auto next = CreateTuple<ith_input + 1, ith_output, Ts...>(context, tensors, num_input, num_output, ep);                         \
+      return std::tuple_cat(current, next);                                                                                           \
+    }                                                                                                                                 \
+  }                                                                                                                                   \
+  template <size_t ith_input, size_t ith_output, typename T, typename... Ts>                                                          \
+  static typename std::enable_if<std::is_same<T, const Custom::Span<data_type>*>::value, std::tuple<T, Ts...>>::type                  \
+  CreateTuple(OrtKernelContext* context, TensorArena& tensors, size_t num_input, size_t num_output, const std::string& ep) {          \
+    if ("CPUExecutionProvider" != ep) {                                                                                               \
+      ORT_CXX_API_THROW("span input could only be applied to CPU EP", OrtErrorCode::ORT_RUNTIME_EXCEPTION);                           \
+    }                                                                                                                                 \
+    auto tensor = tensors.Emplace<Custom::Tensor<data_type>>(context, ith_input, true);                                               \
+    std::tuple<T> current = std::tuple<T>{&tensor->AsSpan()};                                                                         \
+    auto next = CreateTuple<ith_input + 1, ith_output, Ts...>(context, tensors, num_input, num_output, ep);                           \
+    return std::tuple_cat(current, next);                                                                                             \
+  }                                                                                                                                   \
+  template <size_t ith_input, size_t ith_output, typename T, typename... Ts>                                                          \
+  static typename std::enable_if<std::is_same<T, const Custom::Span<data_type>&>::value, std::tuple<T, Ts...>>::type                  \
+  CreateTuple(OrtKernelContext* context, TensorArena& tensors, size_t num_input, size_t num_output, const std::string& ep) {          \
+    if ("CPUExecutionProvider" != ep) {                                                                                               \
+      ORT_CXX_API_THROW("span input could only be applied to CPU EP", OrtErrorCode::ORT_RUNTIME_EXCEPTION);                           \
+    }                                                                                                                                 \
+    auto tensor = tensors.Emplace<Custom::Tensor<data_type>>(context, ith_input, true);                                               \
+    std::tuple<T> current = std::tuple<T>{tensor->AsSpan()};                                                                          \
+    auto next = CreateTuple<ith_input + 1, ith_output, Ts...>(context, tensors, num_input, num_output, ep);                           \
+    return std::tuple_cat(current, next);                                                                                             \
+  }                                                                                                                                   \
+  template <size_t ith_input, size_t ith_output, typename T, typename... Ts>                                                          \
+  static typename std::enable_if<std::is_same<T, std::optional<const Custom::Span<data_type>*>>::value, std::tuple<T, Ts...>>::type   \
+  CreateTuple(OrtKernelContext* context, TensorArena& tensors, size_t num_input, size_t num_output, const std::string& ep) {          \
+    if (ith_input < num_input) {                                                                                                      \
+      if ("CPUExecutionProvider" != ep) {                                                                                             \
+        ORT_CXX_API_THROW("span input could only be applied to CPU EP", OrtErrorCode::ORT_RUNTIME_EXCEPTION);                         \
+      }                                                                                                                               \
+      auto tensor = tensors.Emplace<Custom::Tensor<data_type>>(context, ith_input, true);                                             \
+      std::tuple<T> current = std::tuple<T>{&tensor->AsSpan()};                                                                       \
+      auto next = CreateTuple<ith_input + 1, ith_output, Ts...>(context, tensors, num_input, num_output, ep);                         \
+      return std::tuple_cat(current, next);                                                                                           \
+    } else {                                                                                                                          \
+      std::tuple<T> current = std::tuple<T>{};                                                                                        \
+      auto next = CreateTuple<ith_input + 1, ith_output, Ts...>(context, tensors, num_input, num_output, ep);                         \
+      return std::tuple_cat(current, next);                                                                                           \
+    }                                                                                                                                 \
+  }                                                                                                                                   \
+  template <size_t ith_input, size_t ith_output, typename T, typename... Ts>                                                          \
+  static typename std::enable_if<std::is_same<T, data_type>::value, std::tuple<T, Ts...>>::type                                       \
+  CreateTuple(OrtKernelContext* context, TensorArena& tensors, size_t num_input, size_t num_output, const std::string& ep) {          \
+    if ("CPUExecutionProvider" != ep) {                                                                                               \
+      ORT_CXX_API_THROW("scalar input could only be applied to CPU EP", OrtErrorCode::ORT_RUNTIME_EXCEPTION);                         \
+    }                                                                                                                                 \
+    auto tensor = tensors.Emplace<Custom::Tensor<data_type>>(context, ith_input, true);                                               \
+    std::tuple<T> current = std::tuple<T>{tensor->AsScalar()};                                                                        \
+    auto next = CreateTuple<ith_input + 1, ith_output, Ts...>(context, tensors, num_input, num_output, ep);                           \
+    return std::tuple_cat(current, next);                                                                                             \
+  }                                                                                                                                   \
+  template <size_t ith_input, size_t ith_output, typename T, typename... Ts>                                                          \
+  static typename std::enable_if<std::is_same<T, std::optional<data_type>>::value, std::tuple<T, Ts...>>::type                        \
+  CreateTuple(OrtKernelContext* context, TensorArena& tensors, size_t num_input, size_t num_output, const std::string& ep) {          \
+    if (ith_input < num_input) {                                                                                                      \
+      if ("CPUExecutionProvider" != ep) {                                                                                             \
+        ORT_CXX_API_THROW("scalar input could only be applied to CPU EP", OrtErrorCode::ORT_RUNTIME_EXCEPTION);                       \
+      }                                                                                                                               \
+      auto tensor = tensors.Emplace<Custom::Tensor<data_type>>(context, ith_input, true);                                             \
+      std::tuple<T> current = std::tuple<T>{tensor->AsScalar()};                                                                      \
+      auto next = CreateTuple<ith_input + 1, ith_output, Ts...>(context, tensors, num_input, num_output, ep);                         \
+      return std::tuple_cat(current, next);                                                                                           \
+    } else {                                                                                                                          \
+      std::tuple<T> current = std::tuple<T>{};                                                                                        \
+      auto next = CreateTuple<ith_input + 1, ith_output, Ts...>(context, tensors, num_input, num_output, ep);                         \
+      return std::tuple_cat(current, next);                                                                                           \
+    }                                                                                                                                 \
+  }
+#define CREATE_TUPLE_OUTPUT(data_type)                                                                                          \
+  template <size_t ith_input, size_t ith_output, typename T, typename... Ts>                                                    \
+  static typename std::enable_if<std::is_same<T, Custom::Tensor<data_type>*>::value, std::tuple<T, Ts...>>::type                \
+  CreateTuple(OrtKernelContext* context, TensorArena& tensors, size_t num_input, size_t num_output, const std::string& ep) {    \
+    auto tensor = tensors.Emplace<Custom::Tensor<data_type>>(context, ith_output, false);                                       \
+    std::tuple<T> current = std::tuple<T>{tensor};                                                                              \
+    auto next = CreateTuple<ith_input, ith_output + 1, Ts...>(context, tensors, num_input, num_output, ep);                     \
+    return std::tuple_cat(current, next);                                                                                       \
+  }                                                                                                                             \
+  template <size_t ith_input, size_t ith_output, typename T, typename... Ts>                                                    \
+  static typename std::enable_if<std::is_same<T, Custom::Tensor<data_type>&>::value, std::tuple<T, Ts...>>::type                \
+  CreateTuple(OrtKernelContext* context, TensorArena& tensors, size_t num_input, size_t num_output, const std::string& ep) {    \
+    auto tensor = tensors.Emplace<Custom::Tensor<data_type>>(context, ith_output, false);                                       \
+    std::tuple<T> current = std::tuple<T>{*tensor};                                                                             \
+    auto next = CreateTuple<ith_input, ith_output + 1, Ts...>(context, tensors, num_input, num_output, ep);                     \
+    return std::tuple_cat(current, next);                                                                                       \
+  }                                                                                                                             \
+  template <size_t ith_input, size_t ith_output, typename T, typename... Ts>                                                    \
+  static typename std::enable_if<std::is_same<T, std::optional<Custom::Tensor<data_type>*>>::value, std::tuple<T, Ts...>>::type \
+  CreateTuple(OrtKernelContext* context, TensorArena& tensors, size_t num_input, size_t num_output, const std::string& ep) {    \
+    if (ith_output < num_output) {                                                                                              \
+      auto tensor = tensors.Emplace<Custom::Tensor<data_type>>(context, ith_output, false);                                     \
+      std::tuple<T> current = std::tuple<T>{tensor};                                                                            \
+      auto next = CreateTuple<ith_input, ith_output + 1, Ts...>(context, tensors, num_input, num_output, ep);                   \
+      return std::tuple_cat(current, next);                                                                                     \
+    } else {                                                                                                                    \
+      std::tuple<T> current = std::tuple<T>{};                                                                                  \
+      auto next = CreateTuple<ith_input, ith_output + 1, Ts...>(context, tensors, num_input, num_output, ep);                   \
+      return std::tuple_cat(current, next);                                                                                     \
+    }                                                                                                                           \
   }
 #define CREATE_TUPLE(data_type) \
   CREATE_TUPLE_INPUT(data_type) \
@@ -574,7 +650,7 @@ struct OrtLiteCustomFunc : public OrtLiteCustomOp {
 
     OrtCustomOp::KernelCompute = [](void* op_kernel, OrtKernelContext* context) {
       auto kernel = reinterpret_cast<Kernel*>(op_kernel);
-      std::vector<TensorPtr> tensors;
+      TensorArena tensors;
       auto t = CreateTuple<0, 0, Args...>(context, tensors, kernel->num_input_, kernel->num_output_, kernel->ep_);
       std::apply([kernel](Args const&... t_args) { kernel->compute_fn_(t_args...); }, t);
     };
@@ -638,7 +714,7 @@ struct OrtLiteCustomStruct : public OrtLiteCustomOp {
 
     OrtCustomOp::KernelCompute = [](void* op_kernel, OrtKernelContext* context) {
       auto kernel = reinterpret_cast<Kernel*>(op_kernel);
-      std::vector<TensorPtr> tensors;
+      TensorArena tensors;
       auto t = CreateTuple<0, 0, Args...>(context, tensors, kernel->num_input_, kernel->num_output_, kernel->ep_);
       std::apply([kernel](Args const&... t_args) { kernel->custom_op_->Compute(t_args...); }, t);
     };
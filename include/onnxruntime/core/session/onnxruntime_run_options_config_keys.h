@@ -30,3 +30,14 @@ static const char* const kOrtRunOptionsConfigEnableMemoryArenaShrinkage = "memor
 // Per default it will be set to '0'
 // Taking CUDA EP as an example, it omit triggering cudaStreamSynchronize on the compute stream.
 static const char* const kOrtRunOptionsConfigDisableSynchronizeExecutionProviders = "disable_synchronize_execution_providers";
+
+// Name of a value of the model, e.g. the thresholded confidence of an early exit head, evaluated as a predicate to
+// stop the run early. As soon as the node producing it has run and the value is true (non-zero), the nodes that have
+// not started yet are skipped and the run returns. The requested outputs that were not computed are returned as
+// values that are not allocated, or keep their contents if they were pre-allocated. Fetch the predicate too to tell
+// whether the run exited early. The outputs of the early exit head should be inputs of the predicate so that they
+// are computed before it.
+// The value must be a tensor with a single bool, float, int32, int64 or uint8 element produced by a node assigned
+// to the CPU execution provider.
+// By default, the value for this key is empty (i.e.) the run never exits early.
+static const char* const kOrtRunOptionsConfigEarlyExitValue = "run.early_exit_value";
@@ -81,6 +81,13 @@ static const char* const kOrtSessionOptionsMemoryOptimizerEnabler = "optimizatio
 // Specifies the level for detecting subgraphs for memory footprint reduction.
 // The value should be an integer. The default value is 0.
 static const char* const kOrtSessionOptionsMemoryOptimizerProbeLevel = "optimization.enable_memory_probe_recompute_level";
+
+// Specifies a memory budget for choosing the subgraphs to recompute automatically, instead of naming them in
+// optimization.enable_memory_optimizer. The value is the fraction of the memory of the activations stashed for the
+// backward pass that may stay stashed, for example "0.5". Among the subgraphs found at the probe level, the ones
+// saving the most memory per recomputed FLOP are recomputed until the stashed activations fit in the budget.
+// Symbolic dimensions count as 1 in the estimates. The default is "" (disabled).
+static const char* const kOrtSessionOptionsMemoryOptimizerBudget = "optimization.memory_optimizer_budget";
 #endif
 
 // Enable or disable using device allocator for allocating initialized tensor memory. "1": enable; "0": disable. The default is "0".
@@ -93,6 +100,14 @@ static const char* const kOrtSessionOptionsUseDeviceAllocatorForInitializers = "
 static const char* const kOrtSessionOptionsConfigAllowInterOpSpinning = "session.inter_op.allow_spinning";
 static const char* const kOrtSessionOptionsConfigAllowIntraOpSpinning = "session.intra_op.allow_spinning";
 
+// Configure whether the inter_op/intra_op threads that are allowed to spin adapt the time they spin before blocking
+// to the recent time between parallel sections: they spin for about twice that time, and block right away when the
+// sections are too far apart for spinning to pay off. See InferenceSession::GetIntraOpThreadPoolSpinStatistics.
+// "0": default, threads spin a fixed number of times before blocking
+// "1": threads use an adaptive spin window
+static const char* const kOrtSessionOptionsConfigAdaptiveInterOpSpinning = "session.inter_op.adaptive_spinning";
+static const char* const kOrtSessionOptionsConfigAdaptiveIntraOpSpinning = "session.intra_op.adaptive_spinning";
+
 // Key for using model bytes directly for ORT format
 // If a session is created using an input byte array contains the ORT format model data,
 // By default we will copy the model bytes at the time of session creation to ensure the model bytes
@@ -111,6 +126,14 @@ static const char* const kOrtSessionOptionsConfigUseORTModelBytesDirectly = "ses
 static const char* const kOrtSessionOptionsConfigUseORTModelBytesForInitializers =
     "session.use_ort_model_bytes_for_initializers";
 
+// Set to "1" to compress the initializers of an ORT format model when saving it, which reduces the size of the model
+// at the cost of decompressing the initializers when it is loaded. The decompression runs on the intra-op thread pool.
+// Compressed initializers cannot use the ORT format model bytes directly (see
+// `session.use_ort_model_bytes_for_initializers`), although initializers smaller than 1KB are never compressed.
+// The default is "0".
+static const char* const kOrtSessionOptionsConfigCompressOrtFormatInitializers =
+    "session.ort_format_compress_initializers";
+
 // This should only be specified when exporting an ORT format model for use on a different platform.
 // If the ORT format model will be used on ARM platforms set to "1". For other platforms set to "0"
 // Available since version 1.11.
@@ -190,6 +213,52 @@ static const char* const kNodePartitionConfigFile = "session.node_partition_conf
 //    Hence 64-65 is an invalid configuration, because a windows thread cannot be attached to processors across group boundary.
 static const char* const kOrtSessionOptionsConfigIntraOpThreadAffinities = "session.intra_op_thread_affinities";
 
+// Bind the threads of the intra-op thread pool to the NUMA nodes of the system, in contiguous blocks of threads per
+// node. Each thread may run on any logical processor of its node, or on the processors of its physical core when
+// ORT sets the affinities by default. The tasks of a parallel loop are then dispatched to the threads on the node of
+// the thread that runs the loop first, and idle threads steal work from their own node before other nodes.
+// Pages that a thread touches first are allocated by the OS on its node, so the intermediate results computed by the
+// threads of a node stay local to it.
+// Ignored when session.intra_op_thread_affinities is set, or if the system has a single NUMA node.
+// "1": enable; "0": disable. The default is "0".
+static const char* const kOrtSessionOptionsConfigIntraOpNumaAware = "session.intra_op_numa_aware";
+
+// Calibrate the partitioning of the parallel loops of the intra-op thread pool online. The thread pool measures the
+// time per iteration of every loop, by loop body, loop size and number of threads, for 1, 2, 4, ... shards, and runs
+// each loop with the number of shards that was fastest instead of the one derived from the cost estimate of the
+// kernel. Useful when the cost estimates are far off for a model, at the price of some slower runs while measuring.
+// "1": enable; "0": disable. The default is "0".
+static const char* const kOrtSessionOptionsConfigIntraOpParallelForCalibration =
+    "session.intra_op_parallel_for_calibration";
+
+// Path of a file to load the measurements of session.intra_op_parallel_for_calibration from, and to save them to
+// when the session is destroyed, so that the next runs start calibrated. The loops are identified by the type names of
+// their bodies, so the measurements only apply to the build that wrote them.
+static const char* const kOrtSessionOptionsConfigIntraOpParallelForCalibrationFile =
+    "session.intra_op_parallel_for_calibration_file";
+
+// Adapt the intra-op thread pool to CPUs with cores of different performance, such as x86 hybrid CPUs with P-cores
+// and E-cores or ARM big.LITTLE. The blocks of iterations a parallel loop hands to a thread are scaled by the
+// relative capacity of the core the thread runs on, so that slower cores do not hold up the end of the loop, and the
+// threads bound to efficiency cores block instead of spinning while waiting for work. Unless
+// session.intra_op_thread_affinities is set, the threads are bound to one physical core each.
+// Has no effect if the cores of the CPU are all the same.
+// "1": enable; "0": disable. The default is "0".
+static const char* const kOrtSessionOptionsConfigIntraOpHeterogeneousScheduling =
+    "session.intra_op_heterogeneous_scheduling";
+
+// Priority of the work of the session in the global thread pools, used when the session is created with
+// DisablePerSessionThreads. While parallel loops of "interactive" sessions are running, the loops of "batch" sessions
+// only get the threads the interactive loops do not use. Batch work yields at the start of its next parallel loop
+// or parallel section, running ones keep their threads.
+// "interactive", "normal" or "batch". The default is "normal", which neither takes precedence nor yields.
+static const char* const kOrtSessionOptionsConfigSharedThreadPoolPriority = "session.shared_thread_pool_priority";
+
+// Maximum number of threads, including the thread that calls Run(), that a parallel loop of the session may use in
+// the global thread pools, used when the session is created with DisablePerSessionThreads.
+// The default is "0", which means no limit.
+static const char* const kOrtSessionOptionsConfigSharedThreadPoolMaxThreads = "session.shared_thread_pool_max_threads";
+
 // This option will dump out the model to assist debugging any issues with layout transformation,
 // and is primarily intended for developer usage. It is only relevant if an execution provider that requests
 // NHWC layout is enabled such as NNAPI, XNNPACK or QNN.
@@ -225,3 +294,336 @@ static const char* const kOrtSessionOptionsOptimizedModelExternalInitializersFil
 // Use this config to control the minimum size of the initializer when externalizing it during serialization
 static const char* const kOrtSessionOptionsOptimizedModelExternalInitializersMinSizeInBytes =
     "session.optimized_model_external_initializers_min_size_in_bytes";
+
+// Enables dynamic batching of concurrent Run() calls on the session.
+// Requests whose inputs have the same names, types and shapes except for the leading (batch) dimension are
+// merged along that dimension into a single Run(), and the outputs are split back along their leading dimension.
+// All model inputs and outputs must therefore have the batch as their first dimension.
+// The value is the maximum number of rows (sum of the leading dimensions) in a merged Run(), e.g. "32".
+// Default is "0" which disables dynamic batching.
+static const char* const kOrtSessionOptionsConfigDynamicBatchingMaxBatchSize = "session.dynamic_batching_max_batch_size";
+
+// The maximum time, in microseconds, the first request of a batch waits for compatible requests to join it
+// before the merged Run() starts. Only used when dynamic batching is enabled. Default is "1000".
+static const char* const kOrtSessionOptionsConfigDynamicBatchingMaxDelayUs = "session.dynamic_batching_max_delay_us";
+
+// Keep CPU initializers whose data is in an external data file as read-only views over the memory mapped file.
+// Such initializers are never copied into session owned buffers, and they are not pre-packed, since pre-packing
+// makes a private copy per session and releases the mapping. The pages of the mapped file come from the page cache
+// and are shared by all processes that load the same model file.
+// "1": enable; "0": disable. The default is "0".
+static const char* const kOrtSessionOptionsConfigKeepExternalInitializersMapped =
+    "session.keep_external_initializers_mapped";
+
+// Share the constant initializers of the session by content with the other sessions of the same environment that
+// enable this option, so that sessions of models with identical initializers (e.g. fine-tuned variants of one base
+// model) hold a single copy of each of them per device. The initializers are identified by their type, shape and a
+// 128-bit hash of their data computed when the session is initialized, and are released with the last session using
+// them. Initializers supplied with AddInitializer(), sparse initializers and CPU initializers kept as views over
+// mapped external data are not shared this way.
+// "1": enable; "0": disable. The default is "0".
+static const char* const kOrtSessionOptionsConfigShareInitializersByContent = "session.share_initializers_by_content";
+
+// Profile one in every N runs of the session with a sampling profiler cheap enough to be left enabled in production.
+// The kernel timings of the latest sampled runs are kept in memory allocated once, and can be read at any time with
+// SessionGetSampledRuns() without stopping the runs, e.g. to investigate latency spikes live. Only the nodes of the
+// main graph are timed. The value is N. The default is "0", which disables the sampling profiler.
+static const char* const kOrtSessionOptionsConfigSamplingProfilerInterval = "session.sampling_profiler_interval";
+
+// Number of the latest sampled runs kept by the sampling profiler. The default is "16".
+static const char* const kOrtSessionOptionsConfigSamplingProfilerMaxRuns = "session.sampling_profiler_max_runs";
+
+// Directory where pre-packed weights of CPU kernels are persisted between sessions, so that a session loading the
+// same model again maps the pre-packed weights from disk instead of calling OpKernel::PrePack() for them.
+// A pre-packed weight is keyed by the onnxruntime version, the CPU features, the node's op and attributes and the
+// contents of the initializer, so the directory can be shared by several models. The directory must exist.
+// Only constant initializers that are not shared between sessions via AddInitializer() use the cache.
+// The default is "" which disables the cache.
+static const char* const kOrtSessionOptionsConfigPrepackedWeightsCacheDir = "session.prepacked_weights_cache_dir";
+
+// Schedule the nodes of the main graph dynamically when the session runs with ExecutionMode::ORT_PARALLEL.
+// Instead of running each stream of the execution plan as one task, a node is scheduled on the inter-op thread pool
+// as soon as all of its producers completed. Ready nodes are pushed to the queue of the thread that made them ready,
+// and idle threads steal them from there, so independent branches are balanced across the inter-op threads.
+// Only used when no stream of the plan has a device stream (i.e. all nodes run on host streams).
+// "1": enable; "0": disable. The default is "0".
+static const char* const kOrtSessionOptionsConfigDynamicInterOpScheduling = "session.dynamic_inter_op_scheduling";
+
+// Use the intra-op thread pool of the session to speed up session initialization: the kernels of nodes assigned to
+// the CPU execution provider are created and pre-packed in parallel, and initializers placed on CPU are deserialized
+// in parallel. All kernels (including custom op kernels) on the CPU execution provider must then support being
+// constructed and pre-packed concurrently with other kernels.
+// Parallel pre-packing is not used when pre-packed weights are shared between sessions or cached on disk.
+// "1": enable; "0": disable. The default is "0".
+static const char* const kOrtSessionOptionsConfigParallelInitialization = "session.parallel_initialization";
+
+// Read the external data of CPU initializers from their memory mapped files while the session is initialized,
+// instead of when each page is first accessed by a kernel. The data is read in chunks by the intra-op thread pool,
+// so that many reads are in flight at once, which is much faster on NVMe drives than the page faults of a single
+// thread. Only used when session.parallel_initialization is enabled.
+// "1": enable; "0": disable. The default is "0".
+static const char* const kOrtSessionOptionsConfigPrefetchExternalInitializers =
+    "session.prefetch_external_initializers";
+
+// File to persist the memory patterns of the session in. The memory patterns generated for the input shapes the
+// session was run with are saved to the file when the session is released, and loaded from it when a session for the
+// same model and execution providers is initialized, so its first Run() for those shapes allocates all intermediate
+// buffers at once instead of tracing the allocations first. The file is ignored if it was written for a different
+// execution plan. Only used if memory patterns are enabled.
+// The default is "" which disables the cache.
+static const char* const kOrtSessionOptionsConfigMemoryPatternCacheFile = "session.memory_pattern_cache_file";
+
+// Defer the finalization of the branches of If nodes until a branch runs for the first time. Finalizing a branch
+// creates its kernels, loads and pre-packs its initializers and plans its memory, so branches that never run cost
+// neither load time nor memory. The first Run() that takes a branch pays for its finalization; concurrent runs wait
+// for it to complete.
+// "1": enable; "0": disable. The default is "0".
+static const char* const kOrtSessionOptionsConfigLazySubgraphInitialization = "session.lazy_subgraph_initialization";
+
+// Maximum number of distinct input shapes the session keeps memory patterns for. When a Run() with new input shapes
+// generates a memory pattern and the cache is full, the memory pattern of the least recently used input shapes is
+// dropped. Only used if memory patterns are enabled.
+// The default is "0" which keeps the memory patterns of all input shapes.
+static const char* const kOrtSessionOptionsConfigMemoryPatternCacheCapacity = "session.memory_pattern_cache_capacity";
+
+// Plan the memory of the intermediate tensors symbolically. When the execution plan has a single stream, the
+// allocation planner expresses the size of every intermediate tensor whose shape is known up to the symbolic
+// dimensions of the graph inputs (e.g. "batch", "sequence") as a function of those dimensions. The first Run() with
+// new input shapes then evaluates these sizes and places the tensors in one buffer allocated at the start of the
+// Run(), instead of allocating them individually to trace a memory pattern. Tensors with data dependent shapes are
+// still allocated individually. Only used if memory patterns are enabled.
+// "1": enable; "0": disable. The default is "0".
+static const char* const kOrtSessionOptionsConfigSymbolicMemoryPlanning = "session.symbolic_memory_planning";
+
+// Run the independent branches of the subgraphs of control flow nodes (If, Loop, Scan) on separate device streams.
+// The nodes of a subgraph on a device with streams (e.g. CUDA) are split into the sets of nodes connected by data
+// dependencies, and each set gets a logic stream of its own (up to 4 per device). When the subgraph runs, its first
+// stream is the stream of the control flow node, the others wait for that stream before the subgraph starts, and the
+// stream of the control flow node waits for them once the subgraph completes. The host waits for the other streams
+// at the end of the subgraph, before their memory can be reused by any stream. Only useful for subgraphs with
+// independent branches, each enough work to overlap.
+// "1": enable; "0": disable. The default is "0".
+static const char* const kOrtSessionOptionsConfigConcurrentSubgraphStreams = "session.concurrent_subgraph_streams";
+
+// Maximum number of logic streams the nodes of the main graph on a device with streams (e.g. CUDA) are assigned to,
+// when no node partition config file (see kNodePartitionConfigFile) gives the streams. Each node is put on the stream
+// of one of its producers if it is the first consumer placed after that producer, so chains of nodes stay on one
+// stream, and independent branches (e.g. the towers of a multi-head model) start streams of their own until the
+// maximum is reached. The streams wait for each other through the notifications of the execution plan, and the
+// memory reuse plan only shares buffers between streams where a notification orders their uses.
+// The default is "1", i.e. one stream per device.
+static const char* const kOrtSessionOptionsConfigMaxStreamsPerDevice = "session.max_streams_per_device";
+
+// Run the MemcpyFromHost/MemcpyToHost nodes of the main graph on a copy stream per device with streams (e.g. CUDA),
+// instead of the compute stream, when no node partition config file gives the streams. The copies are also issued as
+// soon as their inputs are ready rather than right before their consumers, so that the transfers between the CPU and
+// GPU partitions of a graph overlap with the kernels that do not depend on them.
+// "1": enable; "0": disable. The default is "0".
+static const char* const kOrtSessionOptionsConfigMemcpyStreams = "session.memcpy_streams";
+
+// Let the producers of the inputs of CPU Concat nodes write their outputs directly into the output of the Concat, so
+// that the Concat has nothing left to copy. An input qualifies if the Concat is its only consumer and it is not a
+// graph output. When its producer allocates it, the input is placed at its offset in the output of the Concat if the
+// other inputs of the Concat are already computed and all dimensions before the concat axis are 1, e.g. the feature
+// maps of a DenseNet block concatenated on the channel axis with batch size 1, or the new keys and values appended
+// to a KV cache with a batch size and number of heads of 1. Otherwise it is allocated as usual and copied. Only used
+// if the execution plan has a single stream, without dynamic inter-op scheduling or symbolic memory planning.
+// "1": enable; "0": disable. The default is "0".
+static const char* const kOrtSessionOptionsConfigConcatInPlace = "session.concat_in_place";
+
+// Run the nodes of an execution plan with a single CPU stream from a flat list of instructions, each with the kernel
+// of a node and the values to release after it ran, in a loop on the thread calling Run(). This skips the execution
+// steps, the task scheduling, the reference counts of the release plan and the per node checks of the profiler,
+// the tracing and the logging, which dominate the run time of graphs of thousands of tiny nodes such as shape
+// computations and scalar math. Runs with the profiler, the sampling profiler or NVTX ranges enabled, and plans
+// with several streams, use the regular execution.
+// "1": enable; "0": disable. The default is "0".
+static const char* const kOrtSessionOptionsConfigLeanExecution = "session.lean_execution";
+
+// Evaluate the shape computations of the main graph on the host when a Run() starts, instead of running their kernels
+// in the middle of the streams. The CPU nodes computing int64 values only from the shapes of the graph inputs and
+// constant initializers (Shape, Gather, Unsqueeze, Squeeze, Concat, Add, Sub, Mul, Div, Identity), e.g. the
+// Shape -> Gather -> Unsqueeze -> Concat chains feeding Reshape and Expand, are evaluated from the shapes of the
+// feeds before any kernel runs, so that the device streams never wait on them. A node whose inputs the evaluation
+// does not support runs its kernel as usual. Not used with symbolic memory planning.
+// "1": enable; "0": disable. The default is "0".
+static const char* const kOrtSessionOptionsConfigHostShapeEvaluation = "session.host_shape_evaluation";
+
+// Back the large buffers of the CPU allocator of the session, i.e. the regions of the CPU arena and the buffers of
+// large initializers, with transparent huge pages where the OS supports them (Linux), to reduce the TLB misses of
+// kernels working on large tensors. Buffers of at least 2MB are aligned to 2MB and advised with MADV_HUGEPAGE. If the
+// OS does not support transparent huge pages the buffers are backed by normal pages. Only used for the CPU execution
+// provider the session adds when none is registered, not for allocators shared from the environment.
+// "1": enable; "0": disable. The default is "0".
+static const char* const kOrtSessionOptionsConfigUseHugePages = "session.use_huge_pages";
+
+// Memory budget in bytes for the intermediate values of the graph. If the peak memory of the values, as estimated
+// from their static shapes per execution provider, exceeds the budget, graph optimization recomputes values with a
+// cheap producer (Cast, Expand, elementwise ops, ...) right before their later consumers, and offloads values on
+// CUDA or ROCm devices to host memory in between, until the estimate fits or nothing is left to move. Values with
+// dynamic shapes are not accounted for. The session then uses the priority based execution order, which schedules
+// the added nodes where the values are needed. Requires the graph optimization level ORT_ENABLE_EXTENDED or higher.
+// The default is "0" which does not limit the memory.
+static const char* const kOrtSessionOptionsMemoryBudgetBytes = "optimization.memory_budget_bytes";
+
+// Profile the memory of the intermediate values together with the nodes when profiling is enabled. For every node
+// the profile has a "<node name>_memory" event with the bytes the node allocated for its outputs and the bytes
+// released after it, and the samples of the live bytes after the node computed and after its inputs were released
+// form the "live_memory" counter track, which shows which node causes the peak.
+// "1": enable; "0": disable. The default is "0".
+static const char* const kOrtSessionOptionsConfigProfileMemory = "session.profile_memory";
+
+// Profile the parallel loops the nodes run on the intra-op thread pool together with the nodes when profiling is
+// enabled. The profile gets a "ThreadPool" event for every loop on the thread that ran the node, with its degree of
+// parallelism, block size and load imbalance (duration of the longest shard over the average one), an event for
+// every shard on the thread that ran it, and the spinning and parked periods of the workers, which show why a loop
+// scales badly. "1": enable; "0": disable. The default is "0".
+static const char* const kOrtSessionOptionsConfigProfileThreadPoolTimeline = "session.profile_threadpool_timeline";
+
+// Read the hardware performance counters of the thread running each node over its compute when profiling is enabled,
+// to tell memory bound kernels from compute bound ones. For every node the profile gets a
+// "<node name>_hardware_counters" event with the cycles, instructions, instructions per cycle, last level cache misses,
+// and the memory bandwidth estimated from the cache misses. The work the node runs on the workers of the intra-op
+// thread pool is not counted. Linux only, where perf events must be allowed (perf_event_paranoid <= 2).
+// CUDA kernels get their register and shared memory usage in the profile when CUDA profiling is enabled.
+// "1": enable; "0": disable. The default is "0".
+static const char* const kOrtSessionOptionsConfigProfileHardwareCounters = "session.profile_hardware_counters";
+
+// Emit NVTX ranges for the phases of the session initialization, the runs, the compute of every node, the copies
+// across devices, CUDA graph replays and arena extensions, so that they show in Nsight Systems. The ranges are emitted
+// by every session of the process while at least one session enabling them exists. Unlike the ENABLE_NVTX_PROFILE
+// build option, this does not need a dedicated build: the ranges are available in every build with CUDA, and NVTX
+// does nothing unless a tool like Nsight Systems is attached to the process.
+// "1": enable; "0": disable. The default is "0".
+static const char* const kOrtSessionOptionsConfigNvtxRanges = "session.nvtx_ranges";
+
+// Estimate the operations and bytes moved by each node of the common operators (MatMul, Gemm, Conv, Attention,
+// element-wise operators, reductions and normalizations) when profiling is enabled, for a roofline analysis.
+// For every such node the profile gets a "<node name>_roofline" event with the flops, the bytes of its inputs and
+// outputs and the arithmetic intensity. Nodes of the CPU execution provider also get the achieved GFLOP/s and GB/s and
+// their ratio to the peaks of the machine.
+// "1": enable; "0": disable. The default is "0".
+static const char* const kOrtSessionOptionsConfigProfileRoofline = "session.profile_roofline";
+
+// Peak throughput of the machine in GFLOP/s, for the roofline profiling. The default is estimated from the vector
+// instructions and the maximum frequency of the processor, for the number of threads of the intra-op thread pool.
+static const char* const kOrtSessionOptionsConfigProfilePeakGflops = "session.profile_peak_gflops";
+
+// Peak memory bandwidth of the machine in GB/s, for the roofline profiling. It is not reported by default, as it can
+// not be detected.
+static const char* const kOrtSessionOptionsConfigProfilePeakMemoryBandwidth = "session.profile_peak_memory_bandwidth";
+
+// Compute the fp32 MatMul, Gemm and Conv kernels of the CPU execution provider (including their fused variants)
+// with bfloat16 inputs and fp32 accumulation, on processors that support AVX512_BF16 or AMX-BF16. The inputs are
+// rounded to bfloat16, which keeps 8 bits of mantissa, so this is only suitable for models that tolerate the loss of
+// precision. On other processors the option is ignored.
+// "1": enable; "0": disable. The default is "0".
+static const char* const kOrtSessionOptionsMlasGemmFastMathBf16 = "mlas.enable_gemm_fastmath_bf16";
+
+// Fuse chains of float elementwise ops (Add, Mul, Relu, Sigmoid, ...) on the CPU into FusedElementwise nodes that
+// make one pass over memory per chain instead of one per op. The chains are fused after the layout transformers, so
+// the NCHWc convolutions keep their Add/Relu fusions. Requires the graph optimization level ORT_ENABLE_ALL.
+// "1": enable; "0": disable. The default is "0".
+static const char* const kOrtSessionOptionsEnableElementwiseChainFusion = "optimization.enable_elementwise_chain_fusion";
+
+// Profiles written by the session profiler, separated by ';', from which the graph partitioner builds a cost model.
+// They should include a run with only the CPU execution provider and runs with the other execution providers.
+// A group of nodes that an execution provider on another device than the CPU can run is then only assigned to it if
+// the average kernel times of the nodes (or else of their op types) on that provider, plus the estimated time of
+// copying the values that cross between the devices, are lower than the kernel times on the CPU execution provider.
+// This avoids small islands of device nodes with expensive copies around them. Groups with nodes that were not
+// profiled on both providers are assigned as usual. Profiles of models optimized with ORT_ENABLE_BASIC match the
+// nodes at partitioning time best.
+// The default is "" which assigns the nodes greedily in the order of the execution providers.
+static const char* const kOrtSessionOptionsPartitioningCostProfiles = "session.partitioning_cost_profiles";
+
+// Profiles written by the session profiler, separated by ';', to optimize the session with (profile-guided
+// optimization). Profiling runs of the model with different optimization settings and passing the profiles to later
+// sessions lets them make the choices that performed best for the model on this machine:
+// - The NchwcTransformer is disabled if runs with the NCHWc layout were not faster on average than runs without it,
+//   e.g. when profiling with ORT_ENABLE_ALL and ORT_ENABLE_EXTENDED. The first run of each profile is ignored.
+// - The kernel times are used for the placement of nodes like the ones in session.partitioning_cost_profiles.
+// The thread counts of the parallel loops are tuned by session.intra_op_parallel_for_calibration_file. Saving the
+// optimized model with SessionOptions::optimized_model_filepath, e.g. in the ORT format, keeps the result of these
+// choices so that later sessions do not need the profiles.
+// The default is "" which does not use any profiles.
+static const char* const kOrtSessionOptionsProfileGuidedOptimizationProfiles =
+    "session.profile_guided_optimization_profiles";
+
+// Limits the growth of the model by constant folding. A node is not folded if its outputs are larger than 64KB and
+// more than this many times the size of its constant inputs, e.g. an Expand or Tile of a small initializer, which is
+// cheaper to compute at run time than to store. The value is a floating point ratio.
+// The default is "0" which folds all constant nodes.
+static const char* const kOrtSessionOptionsConstantFoldingMaxGrowthRatio = "optimization.constant_folding_max_growth_ratio";
+
+// Converts the float computation of the model to a lower precision when the session is created (auto mixed
+// precision), without an offline conversion of the model. MatMul, Gemm, Conv, ConvTranspose and Einsum nodes are
+// converted, and the conversion is propagated to the element-wise, pooling and data movement nodes that consume
+// their outputs. The other nodes, e.g. Softmax and the reductions, stay in float, with Casts at the boundaries of the
+// converted regions. The converted ops should have kernels of the target type on the execution providers used.
+// "fp16": convert to float16; "bf16": convert to bfloat16; "": no conversion. The default is "".
+static const char* const kOrtSessionOptionsAutoMixedPrecision = "optimization.auto_mixed_precision";
+
+// Op types, separated by ',', that are converted by the auto mixed precision in addition to the default ones.
+// The default is "".
+static const char* const kOrtSessionOptionsAutoMixedPrecisionAllowOps = "optimization.auto_mixed_precision_allow_ops";
+
+// Op types, separated by ',', that are never converted by the auto mixed precision, e.g. to keep an Add that needs
+// the range of float in float. The default is "".
+static const char* const kOrtSessionOptionsAutoMixedPrecisionDenyOps = "optimization.auto_mixed_precision_deny_ops";
+
+// Tensor parallel inference: the number of ranks, one per GPU, that the weights of the model are sharded between.
+// Each rank runs its own session of the same model with the CUDA execution provider on its own device, and with
+// kOrtSessionOptionsTensorParallelRank set, e.g. in one process per GPU started with mpirun. The weights of the MLP
+// (MatMul -> activation -> MatMul) and Attention blocks are split Megatron style, and the partial results are summed
+// with AllReduce, which requires a build with MPI and NCCL. The default is "1", which does not shard the model.
+static const char* const kOrtSessionOptionsTensorParallelWorldSize = "session.tensor_parallel_world_size";
+
+// Tensor parallel inference: the rank of the session, in [0, world size). It must match the MPI rank of the process,
+// which the collective ops use. The default is "0".
+static const char* const kOrtSessionOptionsTensorParallelRank = "session.tensor_parallel_rank";
+
+// Compile the trees of TreeEnsembleRegressor and TreeEnsembleClassifier nodes of the CPU execution provider when the
+// session is created. Every tree is expanded to a complete tree of the depth of the deepest tree, which is evaluated
+// with a fixed number of branch-free steps per tree instead of interpreting the nodes. This speeds up the scoring of
+// small batches. Ensembles that mix comparison rules, track missing values, or have trees deeper than 8 levels are
+// not compiled. The memory of the compiled trees grows with 2^depth per tree.
+// "1": enable; "0": disable. The default is "0".
+static const char* const kOrtSessionOptionsCompileTreeEnsembles = "session.compile_tree_ensembles";
+
+// Quantize the activations of DynamicQuantizeMatMul nodes of the CPU execution provider with a scale per row (per
+// token) instead of a scale for the whole tensor. Each row is quantized symmetrically, which keeps the accuracy of rows
+// with small values next to rows with large values, and the scan of the whole tensor for its range is skipped. The
+// results differ from the DynamicQuantizeLinear + MatMulInteger subgraph the op is fused from.
+// "1": enable; "0": disable. The default is "0".
+static const char* const kOrtSessionOptionsDynamicQuantizeMatMulPerRow = "mlas.dynamic_quantize_matmul_per_row";
+
+// Quantize the constant B inputs of the fp32 MatMul, FusedMatMul and Gemm nodes of the CPU execution provider when
+// the session is created, without an offline quantization of the model. The weights are quantized by the pre-packing
+// and the fp32 initializers are released, which reduces the memory of the weights by up to 4x (int8) or 7x (int4).
+// - "int8": a symmetric scale per column of B. The rows of A are quantized dynamically with a scale per row, and
+//   multiplied with MlasDynamicQuantizeGemmBatch.
+// - "int4": blocks of 32 values of a column of B with a scale and a zero point (BlkQ4Zp8), multiplied with the fp32
+//   A by MlasQ4GemmBatch (weight only quantization).
+// Nodes that transpose A, and weights that are not 2D, are not quantized. The results differ from the fp32 model by
+// the quantization error, so the accuracy of the model should be validated.
+// The default is "" which does not quantize the weights.
+static const char* const kOrtSessionOptionsMatMulWeightQuantization = "mlas.matmul_weight_quantization";
+
+// Multiply the columns (channels) of the activations of DynamicQuantizeMatMul nodes of the CPU execution provider
+// that have values of a larger magnitude than this threshold in float instead of int8, with the dequantized rows of
+// the weights (mixed precision decomposition of activation outliers, e.g. 6.0 for LLM.int8()). The outliers are then
+// left out of the per-row scales, which stay fine for the other channels. Requires
+// kOrtSessionOptionsDynamicQuantizeMatMulPerRow. The weights are not pre-packed, as their rows are read for the
+// outliers. The value is a floating point number.
+// The default is "0" which quantizes all the channels.
+static const char* const kOrtSessionOptionsDynamicQuantizeMatMulOutlierThreshold =
+    "mlas.dynamic_quantize_matmul_outlier_threshold";
+
+// Shard the optimizer states of the training APIs across the data parallel ranks (ZeRO stage 1). Each rank keeps the
+// first and second order moments of its share of the trainable parameters only, and saves only those in its
+// checkpoints. Every optimizer step reduce-scatters the gradients, updates the parameters of the rank and all-gathers
+// the updated parameters. The gradients are summed over the ranks, not averaged. Requires a training build with NCCL
+// and MPI, and trainable parameters of one element type. Applies to the session options of the optimizer.
+// "1": enable; "0": disable. The default is "0".
+static const char* const kOrtSessionOptionsShardOptimizerState = "training.shard_optimizer_state";
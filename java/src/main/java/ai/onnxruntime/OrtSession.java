@@ -259,17 +259,64 @@ public class OrtSession implements AutoCloseable {
       Set<String> requestedOutputs,
       RunOptions runOptions)
       throws OrtException {
+    return run(inputs, requestedOutputs, Collections.emptyMap(), runOptions);
+  }
+
+  /**
+   * Scores an input feed dict, writing the pinned outputs into the supplied values.
+   *
+   * <p>The pinned outputs are preallocated tensors of the output's type and shape, for example
+   * created with {@link OnnxTensor#createTensor(OrtEnvironment, java.nio.ByteBuffer, long[])} over a
+   * direct buffer. The run writes into their memory without allocating or copying, so the same
+   * values can be reused across calls.
+   *
+   * @param inputs The inputs to score.
+   * @param pinnedOutputs The preallocated outputs to write into.
+   * @return The pinned outputs, which are not closed when the result is closed.
+   * @throws OrtException If there was an error in native code, the input or output names are
+   *     invalid, or if there are zero or too many inputs or outputs.
+   */
+  public Result run(
+      Map<String, ? extends OnnxTensorLike> inputs,
+      Map<String, ? extends OnnxTensorLike> pinnedOutputs)
+      throws OrtException {
+    return run(inputs, Collections.emptySet(), pinnedOutputs, null);
+  }
+
+  /**
+   * Scores an input feed dict, writing the pinned outputs into the supplied values and returning
+   * the requested outputs as newly allocated values.
+   *
+   * <p>The result lists the pinned outputs first in their map traversal order, followed by the
+   * requested outputs in the supplied set traversal order. Closing the result closes the requested
+   * outputs but not the pinned ones, which are owned by the caller.
+   *
+   * @param inputs The inputs to score.
+   * @param requestedOutputs The requested outputs, which must not be pinned.
+   * @param pinnedOutputs The preallocated outputs to write into.
+   * @param runOptions The RunOptions to control this run.
+   * @return The inferred outputs.
+   * @throws OrtException If there was an error in native code, the input or output names are
+   *     invalid, or if there are zero or too many inputs or outputs.
+   */
+  public Result run(
+      Map<String, ? extends OnnxTensorLike> inputs,
+      Set<String> requestedOutputs,
+      Map<String, ? extends OnnxTensorLike> pinnedOutputs,
+      RunOptions runOptions)
+      throws OrtException {
     if (!closed) {
       if ((inputs.isEmpty() && (numInputs != 0)) || (inputs.size() > numInputs)) {
         throw new OrtException(
             "Unexpected number of inputs, expected [1," + numInputs + ") found " + inputs.size());
       }
-      if (requestedOutputs.isEmpty() || (requestedOutputs.size() > numOutputs)) {
+      int totalOutputs = requestedOutputs.size() + pinnedOutputs.size();
+      if ((totalOutputs == 0) || (totalOutputs > numOutputs)) {
         throw new OrtException(
-            "Unexpected number of requestedOutputs, expected [1,"
+            "Unexpected number of requestedOutputs and pinnedOutputs, expected [1,"
                 + numOutputs
                 + ") found "
-                + requestedOutputs.size());
+                + totalOutputs);
       }
       String[] inputNamesArray = new String[inputs.size()];
       long[] inputHandles = new long[inputs.size()];
@@ -284,11 +331,26 @@ public class OrtSession implements AutoCloseable {
               "Unknown input name " + t.getKey() + ", expected one of " + inputNames.toString());
         }
       }
-      String[] outputNamesArray = new String[requestedOutputs.size()];
+      String[] outputNamesArray = new String[totalOutputs];
+      long[] pinnedOutputHandles = new long[totalOutputs];
+      boolean[] ownedByResult = new boolean[totalOutputs];
       i = 0;
+      for (Map.Entry<String, ? extends OnnxTensorLike> t : pinnedOutputs.entrySet()) {
+        if (outputNames.contains(t.getKey())) {
+          outputNamesArray[i] = t.getKey();
+          pinnedOutputHandles[i] = t.getValue().getNativeHandle();
+          i++;
+        } else {
+          throw new OrtException(
+              "Unknown output name " + t.getKey() + ", expected one of " + outputNames.toString());
+        }
+      }
       for (String s : requestedOutputs) {
-        if (outputNames.contains(s)) {
+        if (pinnedOutputs.containsKey(s)) {
+          throw new OrtException("Output " + s + " is both requested and pinned");
+        } else if (outputNames.contains(s)) {
           outputNamesArray[i] = s;
+          ownedByResult[i] = true;
           i++;
         } else {
           throw new OrtException(
@@ -307,8 +369,14 @@ public class OrtSession implements AutoCloseable {
               inputNamesArray.length,
               outputNamesArray,
               outputNamesArray.length,
+              pinnedOutputHandles,
               runOptionsHandle);
-      return new Result(outputNamesArray, outputValues);
+      i = 0;
+      for (OnnxTensorLike t : pinnedOutputs.values()) {
+        outputValues[i] = t;
+        i++;
+      }
+      return new Result(outputNamesArray, outputValues, ownedByResult);
     } else {
       throw new IllegalStateException("Trying to score a closed OrtSession.");
     }
@@ -420,6 +488,8 @@ public class OrtSession implements AutoCloseable {
    * @param numInputs The number of inputs.
    * @param outputNamesArray The requested output names.
    * @param numOutputs The number of requested outputs.
+   * @param pinnedOutputs The pointers to the preallocated output values, or zero for the outputs
+   *     the run allocates. The returned array is null at the pinned positions.
    * @param runOptionsHandle The (possibly null) pointer to the run options.
    * @return The OnnxValues produced by this run.
    * @throws OrtException If the native call failed in some way.
@@ -433,6 +503,7 @@ public class OrtSession implements AutoCloseable {
       long numInputs,
       String[] outputNamesArray,
       long numOutputs,
+      long[] pinnedOutputs,
       long runOptionsHandle)
       throws OrtException;
 
@@ -1337,6 +1408,9 @@ public class OrtSession implements AutoCloseable {
 
     private final List<OnnxValue> list;
 
+    /** The values closed by this result, which excludes the pinned outputs. */
+    private final List<OnnxValue> owned;
+
     private boolean closed;
 
     /**
@@ -1346,6 +1420,18 @@ public class OrtSession implements AutoCloseable {
      * @param values The output values.
      */
     Result(String[] names, OnnxValue[] values) {
+      this(names, values, null);
+    }
+
+    /**
+     * Creates a Result from the names and values produced by {@link OrtSession#run(Map, Set, Map,
+     * RunOptions)}.
+     *
+     * @param names The output names.
+     * @param values The output values.
+     * @param ownedByResult Whether each value is closed by this result, all of them if null.
+     */
+    Result(String[] names, OnnxValue[] values, boolean[] ownedByResult) {
       if (names.length != values.length) {
         throw new IllegalArgumentException(
             "Expected same number of names and values, found names.length = "
@@ -1357,9 +1443,14 @@ public class OrtSession implements AutoCloseable {
       map = new LinkedHashMap<>(OrtUtil.capacityFromSize(names.length));
       list = new ArrayList<>(names.length);
 
+      owned = new ArrayList<>(names.length);
+
       for (int i = 0; i < names.length; i++) {
         map.put(names[i], values[i]);
         list.add(values[i]);
+        if (ownedByResult == null || ownedByResult[i]) {
+          owned.add(values[i]);
+        }
       }
       this.closed = false;
     }
@@ -1368,7 +1459,7 @@ public class OrtSession implements AutoCloseable {
     public void close() {
       if (!closed) {
         closed = true;
-        for (OnnxValue t : map.values()) {
+        for (OnnxValue t : owned) {
           t.close();
         }
       } else {
@@ -316,14 +316,15 @@ JNIEXPORT jobjectArray JNICALL Java_ai_onnxruntime_OrtSession_getOutputInfo(JNIE
 /*
  * Class:     ai_onnxruntime_OrtSession
  * Method:    run
- * Signature: (JJJ[Ljava/lang/String;[JJ[Ljava/lang/String;JJ)[Lai/onnxruntime/OnnxValue;
- * private native OnnxValue[] run(long apiHandle, long nativeHandle, long allocatorHandle, String[] inputNamesArray, long[] inputs, long numInputs, String[] outputNamesArray, long numOutputs)
+ * Signature: (JJJ[Ljava/lang/String;[JJ[Ljava/lang/String;J[JJ)[Lai/onnxruntime/OnnxValue;
+ * private native OnnxValue[] run(long apiHandle, long nativeHandle, long allocatorHandle, String[] inputNamesArray, long[] inputs, long numInputs, String[] outputNamesArray, long numOutputs, long[] pinnedOutputs, long runOptionsHandle)
  */
 JNIEXPORT jobjectArray JNICALL Java_ai_onnxruntime_OrtSession_run(JNIEnv* jniEnv, jobject jobj, jlong apiHandle,
                                                                   jlong sessionHandle, jlong allocatorHandle,
                                                                   jobjectArray inputNamesArr, jlongArray tensorArr,
                                                                   jlong numInputs, jobjectArray outputNamesArr,
-                                                                  jlong numOutputs, jlong runOptionsHandle) {
+                                                                  jlong numOutputs, jlongArray pinnedOutputArr,
+                                                                  jlong runOptionsHandle) {
 
   (void)jobj;  // Required JNI parameter not needed by functions which don't need to access their host object.
   const OrtApi* api = (const OrtApi*)apiHandle;
@@ -376,12 +377,15 @@ JNIEXPORT jobjectArray JNICALL Java_ai_onnxruntime_OrtSession_run(JNIEnv* jniEnv
   // Release the java array copy of pointers to the tensors.
   (*jniEnv)->ReleaseLongArrayElements(jniEnv, tensorArr, inputValueLongs, JNI_ABORT);
 
-  // Extract the names of the output values.
+  // Extract the names of the output values, and the pinned output values the run writes into.
+  // Outputs which are not pinned are zero, and are allocated by the run.
+  jlong* pinnedOutputLongs = (*jniEnv)->GetLongArrayElements(jniEnv, pinnedOutputArr, NULL);
   for (int i = 0; i < numOutputs; i++) {
     javaOutputStrings[i] = (*jniEnv)->GetObjectArrayElement(jniEnv, outputNamesArr, i);
     outputNames[i] = (*jniEnv)->GetStringUTFChars(jniEnv, javaOutputStrings[i], NULL);
-    outputValues[i] = NULL;
+    outputValues[i] = (OrtValue*)pinnedOutputLongs[i];
   }
+  (*jniEnv)->ReleaseLongArrayElements(jniEnv, pinnedOutputArr, pinnedOutputLongs, JNI_ABORT);
 
   // Actually score the inputs.
   // ORT_API_STATUS(OrtRun, _Inout_ OrtSession* sess, _In_ OrtRunOptions* run_options,
@@ -398,9 +402,11 @@ JNIEXPORT jobjectArray JNICALL Java_ai_onnxruntime_OrtSession_run(JNIEnv* jniEnv
   jclass onnxValueClass = (*jniEnv)->FindClass(jniEnv, ORTJNI_OnnxValueClassName);
   outputArray = (*jniEnv)->NewObjectArray(jniEnv, safecast_int64_to_jsize(numOutputs), onnxValueClass, NULL);
 
-  // Convert the output tensors into ONNXValues
+  // Convert the output tensors into ONNXValues. The pinned outputs are already owned by Java objects,
+  // so their elements are left null.
+  pinnedOutputLongs = (*jniEnv)->GetLongArrayElements(jniEnv, pinnedOutputArr, NULL);
   for (int i = 0; i < numOutputs; i++) {
-    if (outputValues[i] != NULL) {
+    if (outputValues[i] != NULL && pinnedOutputLongs[i] == 0) {
       jobject onnxValue = convertOrtValueToONNXValue(jniEnv, api, allocator, outputValues[i]);
       if (onnxValue == NULL) {
         break;  // go to cleanup, exception thrown
@@ -408,6 +414,7 @@ JNIEXPORT jobjectArray JNICALL Java_ai_onnxruntime_OrtSession_run(JNIEnv* jniEnv
       (*jniEnv)->SetObjectArrayElement(jniEnv, outputArray, i, onnxValue);
     }
   }
+  (*jniEnv)->ReleaseLongArrayElements(jniEnv, pinnedOutputArr, pinnedOutputLongs, JNI_ABORT);
 
   // Note these gotos are in a specific order so they mirror the allocation pattern above.
   // They must be changed if the allocation code is rearranged.
@@ -935,6 +935,52 @@ public class InferenceTest {
     }
   }
 
+  @Test
+  public void testPinnedOutputs() throws OrtException {
+    // model takes 1x5 input of fixed type, echoes back
+    String modelPath = TestHelpers.getResourcePath("/test_types_FLOAT.pb").toString();
+
+    try (SessionOptions options = new SessionOptions();
+        OrtSession session = env.createSession(modelPath, options)) {
+      String inputName = session.getInputNames().iterator().next();
+      String outputName = session.getOutputNames().iterator().next();
+      long[] shape = new long[] {1, 5};
+      FloatBuffer input =
+          ByteBuffer.allocateDirect(5 * 4).order(ByteOrder.nativeOrder()).asFloatBuffer();
+      FloatBuffer output =
+          ByteBuffer.allocateDirect(5 * 4).order(ByteOrder.nativeOrder()).asFloatBuffer();
+
+      try (OnnxTensor inputTensor = OnnxTensor.createTensor(env, input, shape);
+          OnnxTensor outputTensor = OnnxTensor.createTensor(env, output, shape)) {
+        Map<String, OnnxTensor> inputs = Collections.singletonMap(inputName, inputTensor);
+        Map<String, OnnxTensor> pinnedOutputs = Collections.singletonMap(outputName, outputTensor);
+
+        // the same tensors are reused by every run, which writes into the direct output buffer
+        for (int i = 0; i < 3; i++) {
+          float[] inputArr = new float[] {i, -i, 2.0f * i, 0.5f, -1.0f};
+          input.put(inputArr).rewind();
+          try (OrtSession.Result res = session.run(inputs, pinnedOutputs)) {
+            assertSame(outputTensor, res.get(0));
+          }
+          float[] outputArr = new float[5];
+          output.get(outputArr).rewind();
+          assertArrayEquals(inputArr, outputArr, 1e-6f);
+        }
+
+        // the pinned output is not closed with the result
+        assertArrayEquals(
+            new float[] {0.5f, -1.0f},
+            Arrays.copyOfRange(TestHelpers.flattenFloat(outputTensor.getValue()), 3, 5),
+            1e-6f);
+
+        // an output cannot be both requested and pinned
+        Assertions.assertThrows(
+            OrtException.class,
+            () -> session.run(inputs, Collections.singleton(outputName), pinnedOutputs, null));
+      }
+    }
+  }
+
   @Test
   public void testRunOptions() throws OrtException {
     // model takes 1x5 input of fixed type, echoes back
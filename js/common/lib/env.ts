@@ -23,6 +23,17 @@ export declare namespace Env {
      */
     numThreads?: number;
 
+    /**
+     * set or get a boolean value indicating whether the worker threads spin for a short while before they wait for more
+     * work. Spinning reduces the latency of parallel operators, at the cost of keeping the worker threads busy when the
+     * session is idle.
+     *
+     * This setting is available only when WebAssembly multithread feature is available in current context.
+     *
+     * @defaultValue `true`
+     */
+    allowSpinning?: boolean;
+
     /**
      * set or get a boolean value indicating whether to enable SIMD. If set to false, SIMD will be forcely disabled.
      *
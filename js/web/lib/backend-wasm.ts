@@ -22,6 +22,10 @@ export const initializeFlags = (): void => {
     env.wasm.simd = true;
   }
 
+  if (typeof env.wasm.allowSpinning !== 'boolean') {
+    env.wasm.allowSpinning = true;
+  }
+
   if (typeof env.wasm.proxy !== 'boolean') {
     env.wasm.proxy = false;
   }
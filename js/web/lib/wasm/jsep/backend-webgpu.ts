@@ -148,10 +148,11 @@ export class WebGpuBackend {
   }
 
   dispose(): void {
-    // currently, we do not do anything in this function. In all known use cases, we don't have the requirement to
-    // actually dispose the WebGpuBackend instance, because it's always used as a singleton.
+    // In all known use cases, we don't have the requirement to actually dispose the WebGpuBackend instance, because
+    // it's always used as a singleton. Only the GPU buffers kept for reuse are released here.
     //
     // revisit this place if we get real requirement to dispose the instance.
+    this.gpuDataManager.dispose();
   }
 
   getCommandEncoder(): GPUCommandEncoder {
@@ -33,6 +33,13 @@ class TensorViewImpl implements TensorView {
     return new BigInt64Array(this.module.HEAP8.buffer, this.data, ShapeUtil.size(this.dims));
   }
 
+  getInt32Array(): Int32Array {
+    if (this.dataType !== DataType.int32) {
+      throw new Error('Invalid data type');
+    }
+    return new Int32Array(this.module.HEAP8.buffer, this.data, ShapeUtil.size(this.dims));
+  }
+
   reshape(newDims: readonly number[]): TensorView {
     if (ShapeUtil.size(newDims) !== ShapeUtil.size(this.dims)) {
       throw new Error('Invalid new shape');
@@ -103,6 +103,11 @@ export interface TensorView {
    */
   getBigInt64Array(): BigInt64Array;
 
+  /**
+   * get a Int32Array data view of the tensor data. tensor data must be on CPU.
+   */
+  getInt32Array(): Int32Array;
+
   /**
    * create a new tensor view with the same data but different dimensions.
    */
@@ -43,8 +43,17 @@ export interface GpuDataManager {
    * when release() is called, the buffer is not released immediately. this is because we need to wait for the commands
    * to be submitted to the GPU. this function is called after the commands are submitted so that the buffers can be
    * actually released.
+   *
+   * released storage buffers are kept in a free list keyed by their size, so that the next create() of the same size
+   * reuses them instead of allocating a new GPU buffer. The tensors of a session keep the same sizes from one run to
+   * the next, so after the first run the buffers stay resident on the GPU.
    */
   refreshPendingBuffers(): void;
+
+  /**
+   * destroy all the GPU buffers kept in the free list.
+   */
+  dispose(): void;
 }
 
 interface StorageCacheValue {
@@ -61,6 +70,9 @@ interface DownloadCacheValue {
  */
 const calcNormalizedBufferSize = (size: number) => Math.ceil(size / 16) * 16;
 
+// eslint-disable-next-line no-bitwise
+const defaultStorageBufferUsage = () => GPUBufferUsage.STORAGE | GPUBufferUsage.COPY_SRC | GPUBufferUsage.COPY_DST;
+
 let guid = 0;
 const createNewGpuDataId = () => guid++;
 
@@ -76,11 +88,15 @@ class GpuDataManagerImpl implements GpuDataManager {
   // pending buffers for computing
   private buffersPending: GPUBuffer[];
 
-  constructor(private backend: WebGpuBackend /* , private reuseBuffer: boolean */) {
+  // normalized buffer size => released storage buffers that can be reused
+  private freeBuffers: Map<number, GPUBuffer[]>;
+
+  constructor(private backend: WebGpuBackend) {
     this.storageCache = new Map();
     this.downloadCache = new Map();
     this.buffersForUploadingPending = [];
     this.buffersPending = [];
+    this.freeBuffers = new Map();
   }
 
   upload(id: GpuDataId, data: Uint8Array): void {
@@ -142,17 +158,12 @@ class GpuDataManagerImpl implements GpuDataManager {
         sourceGpuDataCache.gpuData.buffer, 0, destinationGpuDataCache.gpuData.buffer, 0, size);
   }
 
-  // eslint-disable-next-line no-bitwise
-  create(size: number, usage = GPUBufferUsage.STORAGE | GPUBufferUsage.COPY_SRC | GPUBufferUsage.COPY_DST): GpuData {
-    // !!!
-    // !!! IMPORTANT: TODO: whether we should keep the storage buffer every time, or always create new ones.
-    // !!!                  This need to be figured out by performance test results.
-    // !!!
-
+  create(size: number, usage = defaultStorageBufferUsage()): GpuData {
     const bufferSize = calcNormalizedBufferSize(size);
 
-    // create gpu buffer
-    const gpuBuffer = this.backend.device.createBuffer({size: bufferSize, usage});
+    // reuse a released storage buffer of the same size if there is one, otherwise create a new gpu buffer
+    const freeBuffers = usage === defaultStorageBufferUsage() ? this.freeBuffers.get(bufferSize) : undefined;
+    const gpuBuffer = freeBuffers?.pop() ?? this.backend.device.createBuffer({size: bufferSize, usage});
 
     const gpuData = {id: createNewGpuDataId(), type: GpuDataType.default, buffer: gpuBuffer};
     this.storageCache.set(gpuData.id, {gpuData, originalSize: size});
@@ -175,7 +186,6 @@ class GpuDataManagerImpl implements GpuDataManager {
 
     this.storageCache.delete(id);
     this.buffersPending.push(cachedData.gpuData.buffer);
-    // cachedData.gpuData.buffer.destroy();
 
     const downloadingData = this.downloadCache.get(id);
     if (downloadingData) {
@@ -225,9 +235,30 @@ class GpuDataManagerImpl implements GpuDataManager {
     for (const buffer of this.buffersForUploadingPending) {
       buffer.destroy();
     }
+    this.buffersForUploadingPending = [];
+
     for (const buffer of this.buffersPending) {
-      buffer.destroy();
+      if (buffer.usage !== defaultStorageBufferUsage()) {
+        buffer.destroy();
+        continue;
+      }
+      const freeBuffers = this.freeBuffers.get(buffer.size);
+      if (freeBuffers) {
+        freeBuffers.push(buffer);
+      } else {
+        this.freeBuffers.set(buffer.size, [buffer]);
+      }
+    }
+    this.buffersPending = [];
+  }
+
+  dispose(): void {
+    for (const freeBuffers of this.freeBuffers.values()) {
+      for (const buffer of freeBuffers) {
+        buffer.destroy();
+      }
     }
+    this.freeBuffers.clear();
   }
 }
 
@@ -2,11 +2,18 @@
 // Licensed under the MIT License.
 
 import * as binaryOps from './ops/binary-op';
+import {concat, parseConcatAttributes} from './ops/concat';
 import {conv, parseConvAttributes} from './ops/conv';
+import {expand} from './ops/expand';
+import {gather, parseGatherAttributes} from './ops/gather';
 import {gemm, parseGemmAttributes} from './ops/gemm';
+import {layerNorm, parseLayerNormAttributes} from './ops/layer-norm';
 import {matMul} from './ops/matmul';
 import * as pool from './ops/pool';
 import {parseReduceAttributes, reduceL1, reduceL2, reduceLogSum, reduceLogSumExp, reduceMax, reduceMean, reduceMin, reduceProd, reduceSum, reduceSumSquare} from './ops/reduce';
+import {parseResizeAttributes, resize} from './ops/resize';
+import {parseSliceAttributes, slice} from './ops/slice';
+import {parseSoftmaxAttributes, softmax} from './ops/softmax';
 import {parseTransposeAttributes, transpose} from './ops/transpose';
 import * as unaryOps from './ops/unary-op';
 import {ComputeContext} from './types';
@@ -29,6 +36,7 @@ export const WEBGPU_OP_RESOLVE_RULES: Map<string, OperatorImplementation> = new
   ['Ceil', [unaryOps.ceil]],
   ['ClipV10', [unaryOps.clipV10]],
   ['Clip', [unaryOps.clip]],
+  ['Concat', [concat, parseConcatAttributes]],
   ['Conv', [conv, parseConvAttributes]],
   ['Cos', [unaryOps.cos]],
   ['Cosh', [unaryOps.cosh]],
@@ -36,10 +44,13 @@ export const WEBGPU_OP_RESOLVE_RULES: Map<string, OperatorImplementation> = new
   ['Elu', [unaryOps.elu, unaryOps.parseAlphaAttributes]],
   ['Erf', [unaryOps.erf]],
   ['Exp', [unaryOps.exp]],
+  ['Expand', [expand]],
   ['Floor', [unaryOps.floor]],
+  ['Gather', [gather, parseGatherAttributes]],
   ['Gemm', [gemm, parseGemmAttributes]],
   ['GlobalAveragePool', [pool.globalAveragePool, pool.parseGlobalAveragePoolAttributes]],
   ['GlobalMaxPool', [pool.globalMaxPool, pool.parseGlobalMaxPoolAttributes]],
+  ['LayerNormalization', [layerNorm, parseLayerNormAttributes]],
   ['LeakyRelu', [unaryOps.leakyRelu, unaryOps.parseAlphaAttributes]],
   ['MatMul', [matMul]],
   // TODO: support new attributes for MaxPool-8 and MaxPool-10
@@ -59,9 +70,12 @@ export const WEBGPU_OP_RESOLVE_RULES: Map<string, OperatorImplementation> = new
   ['ReduceLogSumExp', [reduceLogSumExp, parseReduceAttributes]],
   ['ReduceSumSquare', [reduceSumSquare, parseReduceAttributes]],
   ['Relu', [unaryOps.relu]],
+  ['Resize', [resize, parseResizeAttributes]],
   ['Sigmoid', [unaryOps.sigmoid]],
   ['Sin', [unaryOps.sin]],
   ['Sinh', [unaryOps.sinh]],
+  ['Slice', [slice, parseSliceAttributes]],
+  ['Softmax', [softmax, parseSoftmaxAttributes]],
   ['Sqrt', [unaryOps.sqrt]],
   ['Sub', [binaryOps.sub]],
   ['Tan', [unaryOps.tan]],
@@ -0,0 +1,77 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+import {DataType} from '../../../wasm-common';
+import {TensorView} from '../../tensor';
+import {BroadcastUtil, ShapeUtil} from '../../util';
+import {ComputeContext, GpuDataType, ProgramInfo, ProgramMetadata} from '../types';
+
+import {createIndicesHelper, ShaderHelper} from './common';
+
+const validateInputs = (inputs: readonly TensorView[]): void => {
+  if (!inputs || inputs.length !== 2) {
+    throw new Error('Expand requires 2 inputs.');
+  }
+
+  if (inputs[0].dataType !== DataType.float) {
+    throw new Error('input should be float tensor');
+  }
+
+  if (inputs[1].dataType !== DataType.int64) {
+    throw new Error('shape should be int64 tensor');
+  }
+};
+
+const createExpandProgramInfo =
+    (metadata: ProgramMetadata, input: TensorView, shape: readonly number[]): ProgramInfo => {
+      const dataType = 'f32';
+      const inputShape = input.dims;
+      const outputShape = BroadcastUtil.calcShape(inputShape, shape, false);
+      if (!outputShape) {
+        throw new Error('Expand requires the input shape to be broadcastable to the given shape.');
+      }
+
+      const outputSize = ShapeUtil.size(outputShape);
+      const outputIndicesHelper = createIndicesHelper('output', outputShape);
+      const inputIndicesHelper = createIndicesHelper('input', inputShape);
+
+      // the input is aligned to the trailing dimensions of the output. a dimension of size 1 is broadcast.
+      const rankOffset = outputShape.length - inputShape.length;
+      const outputIndex = (i: number) => outputShape.length < 2 ? 'outputIndices' : `outputIndices[${i}]`;
+      const calculateInputIndices = inputShape.length < 2 ?
+          `inputIndices = ${inputShape.length === 0 || inputShape[0] === 1 ? '0u' : outputIndex(rankOffset)};` :
+          inputShape.map((dim, i) => `inputIndices[${i}] = ${dim === 1 ? '0u' : outputIndex(i + rankOffset)};`)
+              .join('\n    ');
+
+      const getShaderSource = (shaderHelper: ShaderHelper) => `
+  @group(0) @binding(0) var<storage, read> input : array<${dataType}>;
+  @group(0) @binding(1) var<storage, read_write> output : array<${dataType}>;
+
+  ${outputIndicesHelper.o2iImpl}
+  ${inputIndicesHelper.i2oImpl}
+
+  ${shaderHelper.mainStart()}
+    ${shaderHelper.guardAgainstOutOfBoundsWorkgroupSizes(outputSize)}
+
+    ${outputIndicesHelper.indicesVariableDeclaration('outputIndices')}
+    ${outputIndicesHelper.o2iCall('global_idx', 'outputIndices')}
+    ${inputIndicesHelper.indicesVariableDeclaration('inputIndices')}
+    ${calculateInputIndices}
+
+    output[global_idx] = input[${inputIndicesHelper.i2oExpression('inputIndices')}];
+  }`;
+      return {
+        ...metadata,
+        outputs: [{dims: outputShape, dataType: input.dataType, gpuDataType: GpuDataType.default}],
+        getShaderSource,
+        dispatchGroup: () => ({x: Math.ceil(outputSize / 64 /* workgroup size */)})
+      };
+    };
+
+export const expand = (context: ComputeContext): void => {
+  validateInputs(context.inputs);
+  // the target shape is kept on CPU
+  const shape = Array.from(context.inputs[1].getBigInt64Array(), Number);
+  const metadata = {name: 'Expand', inputTypes: [GpuDataType.default], cacheHint: shape.join(',')};
+  context.compute({...metadata, get: () => createExpandProgramInfo(metadata, context.inputs[0], shape)}, {inputs: [0]});
+};
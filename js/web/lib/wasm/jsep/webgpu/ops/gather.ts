@@ -0,0 +1,85 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+import {DataType} from '../../../wasm-common';
+import {TensorView} from '../../tensor';
+import {ShapeUtil} from '../../util';
+import {AttributeWithCacheKey, createAttributeWithCacheKey} from '../attribute-with-cache-key';
+import {ComputeContext, GpuDataType, ProgramInfo, ProgramMetadata} from '../types';
+
+import {ShaderHelper} from './common';
+
+export interface GatherAttributes extends AttributeWithCacheKey {
+  readonly axis: number;
+}
+
+const validateInputs = (inputs: readonly TensorView[]): void => {
+  if (!inputs || inputs.length !== 2) {
+    throw new Error('Gather requires 2 inputs.');
+  }
+
+  if (inputs[0].dataType !== DataType.float) {
+    throw new Error('input should be float tensor');
+  }
+
+  if (inputs[1].dataType !== DataType.int32 && inputs[1].dataType !== DataType.int64) {
+    throw new Error('indices should be int32 or int64 tensor');
+  }
+};
+
+const createGatherProgramInfo =
+    (metadata: ProgramMetadata, inputs: readonly TensorView[], attributes: GatherAttributes): ProgramInfo => {
+      const dataType = 'f32';
+      const inputShape = inputs[0].dims;
+      const indicesShape = inputs[1].dims;
+      const axis = ShapeUtil.normalizeAxis(attributes.axis, inputShape.length);
+
+      const outputShape = [...inputShape.slice(0, axis), ...indicesShape, ...inputShape.slice(axis + 1)];
+      const outputSize = ShapeUtil.size(outputShape);
+      const axisDim = inputShape[axis];
+      const indicesSize = ShapeUtil.size(indicesShape);
+      const inner = ShapeUtil.sizeFromDimension(inputShape, axis + 1);
+
+      // the indices stay on GPU. int64 indices are read through their low 32 bits, which holds any valid index.
+      const isInt64 = inputs[1].dataType === DataType.int64;
+
+      const getShaderSource = (shaderHelper: ShaderHelper) => `
+  @group(0) @binding(0) var<storage, read> x : array<${dataType}>;
+  @group(0) @binding(1) var<storage, read> indices : array<i32>;
+  @group(0) @binding(2) var<storage, read_write> output : array<${dataType}>;
+
+  ${shaderHelper.mainStart()}
+    ${shaderHelper.guardAgainstOutOfBoundsWorkgroupSizes(outputSize)}
+
+    let innerIndex = global_idx % ${inner}u;
+    let rest = global_idx / ${inner}u;
+    let indicesIndex = rest % ${indicesSize}u;
+    let outerIndex = rest / ${indicesSize}u;
+
+    var index = indices[${isInt64 ? 'indicesIndex * 2u' : 'indicesIndex'}];
+    if (index < 0) {
+      index += ${axisDim};
+    }
+
+    output[global_idx] = x[(outerIndex * ${axisDim}u + u32(index)) * ${inner}u + innerIndex];
+  }`;
+      return {
+        ...metadata,
+        outputs: [{dims: outputShape, dataType: inputs[0].dataType, gpuDataType: GpuDataType.default}],
+        getShaderSource,
+        dispatchGroup: () => ({x: Math.ceil(outputSize / 64 /* workgroup size */)})
+      };
+    };
+
+export const gather = (context: ComputeContext, attributes: GatherAttributes): void => {
+  validateInputs(context.inputs);
+  const metadata = {
+    name: 'Gather',
+    inputTypes: [GpuDataType.default, GpuDataType.default],
+    cacheHint: `${attributes.cacheKey};${context.inputs[1].dataType}`
+  };
+  context.compute({...metadata, get: () => createGatherProgramInfo(metadata, context.inputs, attributes)});
+};
+
+export const parseGatherAttributes = (attributes: Record<string, unknown>): GatherAttributes =>
+    createAttributeWithCacheKey({axis: attributes.axis as number});
@@ -0,0 +1,91 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+import {DataType} from '../../../wasm-common';
+import {TensorView} from '../../tensor';
+import {ShapeUtil} from '../../util';
+import {AttributeWithCacheKey, createAttributeWithCacheKey} from '../attribute-with-cache-key';
+import {ComputeContext, GpuDataType, ProgramInfo, ProgramMetadata} from '../types';
+
+import {ShaderHelper} from './common';
+
+export interface LayerNormAttributes extends AttributeWithCacheKey {
+  readonly axis: number;
+  readonly epsilon: number;
+}
+
+const validateInputs = (inputs: readonly TensorView[]): void => {
+  if (!inputs || inputs.length < 2 || inputs.length > 3) {
+    throw new Error('LayerNormalization requires 2 or 3 inputs.');
+  }
+
+  if (inputs.some(input => input.dataType !== DataType.float)) {
+    throw new Error('inputs should be float tensors');
+  }
+};
+
+const createLayerNormProgramInfo =
+    (metadata: ProgramMetadata, inputs: readonly TensorView[], attributes: LayerNormAttributes): ProgramInfo => {
+      const dataType = 'f32';
+      const inputShape = inputs[0].dims;
+      const axis = ShapeUtil.normalizeAxis(attributes.axis, inputShape.length);
+      const normCount = ShapeUtil.sizeToDimension(inputShape, axis);
+      const normSize = ShapeUtil.sizeFromDimension(inputShape, axis);
+
+      // scale and bias are broadcast to the normalized shape [normSize]
+      if (ShapeUtil.size(inputs[1].dims) !== normSize ||
+          (inputs.length === 3 && ShapeUtil.size(inputs[2].dims) !== normSize)) {
+        throw new Error('Size of scale and bias must match the size of the normalized dimensions.');
+      }
+      const hasBias = inputs.length === 3;
+
+      const getShaderSource = (shaderHelper: ShaderHelper) => `
+  @group(0) @binding(0) var<storage, read> x : array<${dataType}>;
+  @group(0) @binding(1) var<storage, read> scale : array<${dataType}>;
+  ${hasBias ? `@group(0) @binding(2) var<storage, read> bias : array<${dataType}>;` : ''}
+  @group(0) @binding(${inputs.length}) var<storage, read_write> output : array<${dataType}>;
+
+  ${shaderHelper.mainStart()}
+    ${shaderHelper.guardAgainstOutOfBoundsWorkgroupSizes(normCount)}
+
+    let offset = global_idx * ${normSize}u;
+
+    var mean = ${dataType}(0);
+    for (var i = 0u; i < ${normSize}u; i++) {
+      mean += x[offset + i];
+    }
+    mean = mean / ${normSize}.0;
+
+    var variance = ${dataType}(0);
+    for (var i = 0u; i < ${normSize}u; i++) {
+      let diff = x[offset + i] - mean;
+      variance += diff * diff;
+    }
+    let invStdDev = inverseSqrt(variance / ${normSize}.0 + ${dataType}(${attributes.epsilon}));
+
+    for (var i = 0u; i < ${normSize}u; i++) {
+      output[offset + i] = (x[offset + i] - mean) * invStdDev * scale[i] ${hasBias ? '+ bias[i]' : ''};
+    }
+  }`;
+      return {
+        ...metadata,
+        outputs: [{dims: inputShape, dataType: inputs[0].dataType, gpuDataType: GpuDataType.default}],
+        getShaderSource,
+        dispatchGroup: () => ({x: Math.ceil(normCount / 64 /* workgroup size */)})
+      };
+    };
+
+// only the normalized output is computed. the kernel is not assigned to nodes that consume Mean or InvStdDev.
+export const layerNorm = (context: ComputeContext, attributes: LayerNormAttributes): void => {
+  validateInputs(context.inputs);
+  const metadata = {
+    name: 'LayerNormalization',
+    inputTypes: context.inputs.length === 3 ? [GpuDataType.default, GpuDataType.default, GpuDataType.default] :
+                                              [GpuDataType.default, GpuDataType.default],
+    cacheHint: attributes.cacheKey
+  };
+  context.compute({...metadata, get: () => createLayerNormProgramInfo(metadata, context.inputs, attributes)});
+};
+
+export const parseLayerNormAttributes = (attributes: Record<string, unknown>): LayerNormAttributes =>
+    createAttributeWithCacheKey({axis: attributes.axis as number, epsilon: attributes.epsilon as number});
@@ -0,0 +1,219 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+import {DataType} from '../../../wasm-common';
+import {TensorView} from '../../tensor';
+import {ShapeUtil} from '../../util';
+import {AttributeWithCacheKey, createAttributeWithCacheKey} from '../attribute-with-cache-key';
+import {ComputeContext, GpuDataType, ProgramInfo, ProgramMetadata} from '../types';
+
+import {createIndicesHelper, ShaderHelper} from './common';
+
+// the values below match the enums of core/providers/cpu/tensor/upsamplebase.h
+const enum ResizeMode {
+  nearest = 0,
+  linear = 1,
+  cubic = 2,
+}
+
+const enum CoordinateTransformMode {
+  halfPixel = 0,
+  asymmetric = 1,
+  pytorchHalfPixel = 2,
+  tfHalfPixelForNN = 3,
+  alignCorners = 4,
+  tfCropAndResize = 5,
+}
+
+const enum NearestMode {
+  simple = 0,
+  roundPreferFloor = 1,
+  roundPreferCeil = 2,
+  floor = 3,
+  ceil = 4,
+}
+
+export interface ResizeAttributes extends AttributeWithCacheKey {
+  readonly opset: number;
+  readonly mode: ResizeMode;
+  readonly coordinateTransformMode: CoordinateTransformMode;
+  readonly nearestMode: NearestMode;
+  // the scales of Upsample-style attributes. empty when the scales or sizes come from the inputs
+  readonly scales: number[];
+}
+
+const validateInputs = (inputs: readonly TensorView[], attributes: ResizeAttributes): void => {
+  if (!inputs || inputs.length < 1 || inputs.length > 4) {
+    throw new Error('Resize requires 1 to 4 inputs.');
+  }
+
+  if (inputs[0].dataType !== DataType.float) {
+    throw new Error('input should be float tensor');
+  }
+
+  if (attributes.mode === ResizeMode.cubic) {
+    throw new Error('Resize does not support cubic mode.');
+  }
+
+  if (attributes.coordinateTransformMode === CoordinateTransformMode.tfCropAndResize) {
+    throw new Error('Resize does not support tf_crop_and_resize coordinate transformation mode.');
+  }
+};
+
+// scales and sizes are kept on CPU. Resize-10 has [X, scales], Resize-11 and later have [X, roi, scales, sizes].
+const getScalesAndOutputShape =
+    (inputs: readonly TensorView[], attributes: ResizeAttributes): [number[], number[]] => {
+      const inputShape = inputs[0].dims;
+      const scalesInput = attributes.opset > 10 ? inputs[2] : inputs[1];
+      const sizesInput = attributes.opset > 10 ? inputs[3] : undefined;
+
+      if (sizesInput && ShapeUtil.size(sizesInput.dims) > 0) {
+        const sizes = Array.from(sizesInput.getBigInt64Array(), Number);
+        if (sizes.length !== inputShape.length) {
+          throw new Error('The size of sizes must match the rank of the input.');
+        }
+        return [sizes.map((size, i) => size / inputShape[i]), sizes];
+      }
+
+      const scales = attributes.scales.length > 0 ? attributes.scales : Array.from(scalesInput.getFloat32Array());
+      if (scales.length !== inputShape.length) {
+        throw new Error('The size of scales must match the rank of the input.');
+      }
+      return [scales, inputShape.map((dim, i) => Math.floor(dim * scales[i]))];
+    };
+
+// WGSL expression of the original coordinate of `x` in a dimension resized from `inputDim` to `outputDim`
+const originalCoordinate =
+    (mode: CoordinateTransformMode, x: string, scale: number, inputDim: number, outputDim: number): string => {
+      switch (mode) {
+        case CoordinateTransformMode.asymmetric:
+          return `f32(${x}) / ${scale}`;
+        case CoordinateTransformMode.pytorchHalfPixel:
+          return outputDim > 1 ? `(f32(${x}) + 0.5) / ${scale} - 0.5` : '0.0';
+        case CoordinateTransformMode.tfHalfPixelForNN:
+          return `(f32(${x}) + 0.5) / ${scale}`;
+        case CoordinateTransformMode.alignCorners:
+          return outputDim === 1 ? '0.0' : `f32(${x}) * ${inputDim - 1} / ${outputDim - 1}`;
+        case CoordinateTransformMode.halfPixel:
+        default:
+          return `(f32(${x}) + 0.5) / ${scale} - 0.5`;
+      }
+    };
+
+// WGSL expression of the nearest input index of the original coordinate `x`
+const nearestIndex = (mode: NearestMode, x: string, scale: number): string => {
+  switch (mode) {
+    case NearestMode.simple:
+      return scale < 1 ? `ceil(${x})` : `trunc(${x})`;
+    case NearestMode.roundPreferCeil:
+      return `floor(${x} + 0.5)`;
+    case NearestMode.floor:
+      return `floor(${x})`;
+    case NearestMode.ceil:
+      return `ceil(${x})`;
+    case NearestMode.roundPreferFloor:
+    default:
+      return `ceil(${x} - 0.5)`;
+  }
+};
+
+const createResizeProgramInfo =
+    (metadata: ProgramMetadata, input: TensorView, attributes: ResizeAttributes, scales: readonly number[],
+     outputShape: readonly number[]): ProgramInfo => {
+      const dataType = 'f32';
+      const inputShape = input.dims;
+      const rank = inputShape.length;
+      const outputSize = ShapeUtil.size(outputShape);
+      const outputIndicesHelper = createIndicesHelper('output', outputShape);
+      const inputIndicesHelper = createIndicesHelper('input', inputShape);
+      const outputIndex = (i: number) => rank < 2 ? 'outputIndices' : `outputIndices[${i}]`;
+      const inputIndex = (i: number) => rank < 2 ? 'inputIndices' : `inputIndices[${i}]`;
+
+      // the dimensions that are not resized map to the same index
+      const resizedAxes = [...Array(rank).keys()].filter(i => inputShape[i] !== outputShape[i] || scales[i] !== 1);
+      const coordinates = resizedAxes.map(
+          i => `let x${i} = ${
+              originalCoordinate(
+                  attributes.coordinateTransformMode, outputIndex(i), scales[i], inputShape[i], outputShape[i])};`);
+      const copyIndices = [...Array(rank).keys()]
+                              .filter(i => resizedAxes.indexOf(i) < 0)
+                              .map(i => `${inputIndex(i)} = ${outputIndex(i)};`);
+
+      let calculateValue: string;
+      if (attributes.mode === ResizeMode.nearest) {
+        calculateValue = `
+    ${resizedAxes.map(i => `${inputIndex(i)} = u32(clamp(${
+                               nearestIndex(attributes.nearestMode, `x${i}`, scales[i])}, 0.0, ${
+                               inputShape[i] - 1}.0));`)
+                .join('\n    ')}
+    let value = input[${inputIndicesHelper.i2oExpression('inputIndices')}];`;
+      } else {
+        // n-linear interpolation over the resized dimensions: each of the 2^n corners is weighted by the product of
+        // its per-dimension weights.
+        const corners: string[] = [];
+        for (let corner = 0; corner < 2 ** resizedAxes.length; corner++) {
+          const selected = resizedAxes.map((_, j) => Math.floor(corner / 2 ** j) % 2 === 1);
+          corners.push(`
+    ${resizedAxes.map((axis, j) => `${inputIndex(axis)} = ${selected[j] ? `high${axis}` : `low${axis}`};`).join(' ')}
+    value += input[${inputIndicesHelper.i2oExpression('inputIndices')}] * ${
+              resizedAxes.map((axis, j) => selected[j] ? `weight${axis}` : `(1.0 - weight${axis})`).join(' * ') ||
+              '1.0'};`);
+        }
+        calculateValue = `
+    ${resizedAxes.map(i => `
+    let clamped${i} = clamp(x${i}, 0.0, ${inputShape[i] - 1}.0);
+    let low${i} = u32(floor(clamped${i}));
+    let high${i} = min(low${i} + 1u, ${inputShape[i] - 1}u);
+    let weight${i} = clamped${i} - floor(clamped${i});`).join('')}
+    var value = ${dataType}(0);
+    ${corners.join('')}`;
+      }
+
+      const getShaderSource = (shaderHelper: ShaderHelper) => `
+  @group(0) @binding(0) var<storage, read> input : array<${dataType}>;
+  @group(0) @binding(1) var<storage, read_write> output : array<${dataType}>;
+
+  ${outputIndicesHelper.o2iImpl}
+  ${inputIndicesHelper.i2oImpl}
+
+  ${shaderHelper.mainStart()}
+    ${shaderHelper.guardAgainstOutOfBoundsWorkgroupSizes(outputSize)}
+
+    ${outputIndicesHelper.indicesVariableDeclaration('outputIndices')}
+    ${outputIndicesHelper.o2iCall('global_idx', 'outputIndices')}
+    ${inputIndicesHelper.indicesVariableDeclaration('inputIndices')}
+    ${copyIndices.join('\n    ')}
+    ${coordinates.join('\n    ')}
+    ${calculateValue}
+
+    output[global_idx] = value;
+  }`;
+      return {
+        ...metadata,
+        outputs: [{dims: outputShape, dataType: input.dataType, gpuDataType: GpuDataType.default}],
+        getShaderSource,
+        dispatchGroup: () => ({x: Math.ceil(outputSize / 64 /* workgroup size */)})
+      };
+    };
+
+export const resize = (context: ComputeContext, attributes: ResizeAttributes): void => {
+  validateInputs(context.inputs, attributes);
+  const [scales, outputShape] = getScalesAndOutputShape(context.inputs, attributes);
+  const metadata = {
+    name: 'Resize',
+    inputTypes: [GpuDataType.default],
+    cacheHint: `${attributes.cacheKey};${scales.join(',')};${outputShape.join(',')}`
+  };
+  context.compute(
+      {...metadata, get: () => createResizeProgramInfo(metadata, context.inputs[0], attributes, scales, outputShape)},
+      {inputs: [0]});
+};
+
+export const parseResizeAttributes = (attributes: Record<string, unknown>): ResizeAttributes =>
+    createAttributeWithCacheKey({
+      opset: attributes.opset as number,
+      mode: attributes.mode as ResizeMode,
+      coordinateTransformMode: attributes.coordinateTransformMode as CoordinateTransformMode,
+      nearestMode: attributes.nearestMode as NearestMode,
+      scales: attributes.scales as number[],
+    });
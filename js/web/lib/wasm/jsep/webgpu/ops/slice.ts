@@ -0,0 +1,130 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+import {DataType} from '../../../wasm-common';
+import {TensorView} from '../../tensor';
+import {ShapeUtil} from '../../util';
+import {AttributeWithCacheKey, createAttributeWithCacheKey} from '../attribute-with-cache-key';
+import {ComputeContext, GpuDataType, ProgramInfo, ProgramMetadata} from '../types';
+
+import {createIndicesHelper, ShaderHelper} from './common';
+
+export interface SliceAttributes extends AttributeWithCacheKey {
+  readonly starts: number[];
+  readonly ends: number[];
+  readonly axes: number[];
+  readonly steps: number[];
+}
+
+const validateInputs = (inputs: readonly TensorView[]): void => {
+  if (!inputs || inputs.length < 1 || inputs.length > 5) {
+    throw new Error('Slice requires 1 to 5 inputs.');
+  }
+
+  if (inputs[0].dataType !== DataType.float) {
+    throw new Error('input should be float tensor');
+  }
+
+  for (let i = 1; i < inputs.length; i++) {
+    if (inputs[i].dataType !== DataType.int32 && inputs[i].dataType !== DataType.int64) {
+      throw new Error('starts, ends, axes and steps should be int32 or int64 tensors');
+    }
+  }
+};
+
+// starts, ends, axes and steps of Slice-10 and later are kept on CPU
+const readIntegers = (input: TensorView): number[] => input.dataType === DataType.int64 ?
+    Array.from(input.getBigInt64Array(), Number) :
+    Array.from(input.getInt32Array());
+
+const createSliceAttributesFromInputs = (inputs: readonly TensorView[]): SliceAttributes => {
+  const starts = readIntegers(inputs[1]);
+  const ends = readIntegers(inputs[2]);
+  const axes = inputs.length > 3 ? readIntegers(inputs[3]) : [];
+  const steps = inputs.length > 4 ? readIntegers(inputs[4]) : [];
+  return createAttributeWithCacheKey({starts, ends, axes, steps});
+};
+
+const createSliceProgramInfo =
+    (metadata: ProgramMetadata, input: TensorView, attributes: SliceAttributes): ProgramInfo => {
+      const dataType = 'f32';
+      const inputShape = input.dims;
+      const rank = inputShape.length;
+      const axes = attributes.axes.length > 0 ? ShapeUtil.normalizeAxes(attributes.axes, rank) :
+                                                [...Array(attributes.starts.length).keys()];
+
+      // the axes that are not sliced start at 0 with step 1
+      const starts = new Array<number>(rank).fill(0);
+      const steps = new Array<number>(rank).fill(1);
+      const outputShape = inputShape.slice();
+      axes.forEach((axis, i) => {
+        const dim = inputShape[axis];
+        const step = attributes.steps.length > 0 ? attributes.steps[i] : 1;
+        if (step === 0) {
+          throw new Error('step cannot be 0');
+        }
+        let start = attributes.starts[i] < 0 ? attributes.starts[i] + dim : attributes.starts[i];
+        let end = attributes.ends[i] < 0 ? attributes.ends[i] + dim : attributes.ends[i];
+        if (step > 0) {
+          start = Math.min(Math.max(start, 0), dim);
+          end = Math.min(Math.max(end, 0), dim);
+          outputShape[axis] = Math.max(0, Math.ceil((end - start) / step));
+        } else {
+          start = Math.min(Math.max(start, 0), dim - 1);
+          end = Math.min(Math.max(end, -1), dim - 1);
+          outputShape[axis] = Math.max(0, Math.ceil((start - end) / -step));
+        }
+        starts[axis] = start;
+        steps[axis] = step;
+      });
+
+      const outputSize = ShapeUtil.size(outputShape);
+      const outputIndicesHelper = createIndicesHelper('output', outputShape);
+      const inputIndicesHelper = createIndicesHelper('input', inputShape);
+
+      const calculateInputIndices = rank < 2 ?
+          `inputIndices = u32(${starts[0]} + i32(outputIndices) * ${steps[0]});` :
+          starts.map((start, i) => `inputIndices[${i}] = u32(${start} + i32(outputIndices[${i}]) * ${steps[i]});`)
+              .join('\n    ');
+
+      const getShaderSource = (shaderHelper: ShaderHelper) => `
+  @group(0) @binding(0) var<storage, read> input : array<${dataType}>;
+  @group(0) @binding(1) var<storage, read_write> output : array<${dataType}>;
+
+  ${outputIndicesHelper.o2iImpl}
+  ${inputIndicesHelper.i2oImpl}
+
+  ${shaderHelper.mainStart()}
+    ${shaderHelper.guardAgainstOutOfBoundsWorkgroupSizes(outputSize)}
+
+    ${outputIndicesHelper.indicesVariableDeclaration('outputIndices')}
+    ${outputIndicesHelper.o2iCall('global_idx', 'outputIndices')}
+    ${inputIndicesHelper.indicesVariableDeclaration('inputIndices')}
+    ${calculateInputIndices}
+
+    output[global_idx] = input[${inputIndicesHelper.i2oExpression('inputIndices')}];
+  }`;
+      return {
+        ...metadata,
+        outputs: [{dims: outputShape, dataType: input.dataType, gpuDataType: GpuDataType.default}],
+        getShaderSource,
+        dispatchGroup: () => ({x: Math.ceil(outputSize / 64 /* workgroup size */)})
+      };
+    };
+
+export const slice = (context: ComputeContext, attributes: SliceAttributes): void => {
+  validateInputs(context.inputs);
+  const updatedAttributes = context.inputs.length === 1 ? attributes : createSliceAttributesFromInputs(context.inputs);
+  const metadata = {name: 'Slice', inputTypes: [GpuDataType.default], cacheHint: updatedAttributes.cacheKey};
+  context.compute(
+      {...metadata, get: () => createSliceProgramInfo(metadata, context.inputs[0], updatedAttributes)},
+      {inputs: [0]});
+};
+
+export const parseSliceAttributes = (attributes: Record<string, unknown>): SliceAttributes =>
+    createAttributeWithCacheKey({
+      starts: attributes.starts as number[],
+      ends: attributes.ends as number[],
+      axes: attributes.axes as number[],
+      steps: [],
+    });
@@ -0,0 +1,81 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+import {DataType} from '../../../wasm-common';
+import {TensorView} from '../../tensor';
+import {ShapeUtil} from '../../util';
+import {AttributeWithCacheKey, createAttributeWithCacheKey} from '../attribute-with-cache-key';
+import {ComputeContext, GpuDataType, ProgramInfo, ProgramMetadata} from '../types';
+
+import {ShaderHelper} from './common';
+
+export interface SoftmaxAttributes extends AttributeWithCacheKey {
+  readonly axis: number;
+  // Softmax-1 and Softmax-11 coerce the input into 2D [N, D] at the axis, instead of normalizing along the axis only
+  readonly coerceTo2D: boolean;
+}
+
+const validateInputs = (inputs: readonly TensorView[]): void => {
+  if (!inputs || inputs.length !== 1) {
+    throw new Error('Softmax requires 1 input.');
+  }
+
+  if (inputs[0].dataType !== DataType.float) {
+    throw new Error('input should be float tensor');
+  }
+};
+
+const createSoftmaxProgramInfo =
+    (metadata: ProgramMetadata, input: TensorView, attributes: SoftmaxAttributes): ProgramInfo => {
+      const dataType = 'f32';
+      const inputShape = input.dims;
+      const axis = ShapeUtil.normalizeAxis(attributes.axis, inputShape.length);
+
+      // the input is viewed as [outer, cols, inner]. each invocation works on the `cols` elements of one row, which
+      // are `inner` elements apart.
+      const outer = ShapeUtil.sizeToDimension(inputShape, axis);
+      const cols = attributes.coerceTo2D ? ShapeUtil.sizeFromDimension(inputShape, axis) : inputShape[axis];
+      const inner = attributes.coerceTo2D ? 1 : ShapeUtil.sizeFromDimension(inputShape, axis + 1);
+      const rows = outer * inner;
+
+      const getShaderSource = (shaderHelper: ShaderHelper) => `
+  @group(0) @binding(0) var<storage, read> x : array<${dataType}>;
+  @group(0) @binding(1) var<storage, read_write> output : array<${dataType}>;
+
+  ${shaderHelper.mainStart()}
+    ${shaderHelper.guardAgainstOutOfBoundsWorkgroupSizes(rows)}
+
+    let offset = (global_idx / ${inner}u) * ${cols * inner}u + global_idx % ${inner}u;
+
+    var maxValue = x[offset];
+    for (var i = 1u; i < ${cols}u; i++) {
+      maxValue = max(maxValue, x[offset + i * ${inner}u]);
+    }
+
+    var sum = ${dataType}(0);
+    for (var i = 0u; i < ${cols}u; i++) {
+      let value = exp(x[offset + i * ${inner}u] - maxValue);
+      output[offset + i * ${inner}u] = value;
+      sum += value;
+    }
+
+    for (var i = 0u; i < ${cols}u; i++) {
+      output[offset + i * ${inner}u] /= sum;
+    }
+  }`;
+      return {
+        ...metadata,
+        outputs: [{dims: inputShape, dataType: input.dataType, gpuDataType: GpuDataType.default}],
+        getShaderSource,
+        dispatchGroup: () => ({x: Math.ceil(rows / 64 /* workgroup size */)})
+      };
+    };
+
+export const softmax = (context: ComputeContext, attributes: SoftmaxAttributes): void => {
+  validateInputs(context.inputs);
+  const metadata = {name: 'Softmax', inputTypes: [GpuDataType.default], cacheHint: attributes.cacheKey};
+  context.compute({...metadata, get: () => createSoftmaxProgramInfo(metadata, context.inputs[0], attributes)});
+};
+
+export const parseSoftmaxAttributes = (attributes: Record<string, unknown>): SoftmaxAttributes =>
+    createAttributeWithCacheKey({axis: attributes.axis as number, coerceTo2D: attributes.coerceTo2D as boolean});
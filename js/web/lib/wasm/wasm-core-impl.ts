@@ -34,10 +34,11 @@ const getSessionInputOutputCount = (sessionHandle: number): [number, number] =>
 /**
  * initialize ORT environment.
  * @param numThreads SetGlobalIntraOpNumThreads(numThreads)
+ * @param allowSpinning SetGlobalSpinControl(allowSpinning)
  * @param loggingLevel CreateEnv(static_cast<OrtLoggingLevel>(logging_level))
  */
-const initOrt = (numThreads: number, loggingLevel: number): void => {
-  const errorCode = getInstance()._OrtInit(numThreads, loggingLevel);
+const initOrt = (numThreads: number, allowSpinning: boolean, loggingLevel: number): void => {
+  const errorCode = getInstance()._OrtInit(numThreads, allowSpinning, loggingLevel);
   if (errorCode !== 0) {
     checkLastError('Can\'t initialize onnxruntime.');
   }
@@ -49,7 +50,7 @@ const initOrt = (numThreads: number, loggingLevel: number): void => {
  */
 export const initRuntime = async(env: Env): Promise<void> => {
   // init ORT
-  initOrt(env.wasm.numThreads!, logLevelStringToEnum(env.logLevel));
+  initOrt(env.wasm.numThreads!, env.wasm.allowSpinning!, logLevelStringToEnum(env.logLevel));
 
   // init JSEP if available
   await initJsep(getInstance(), env);
@@ -41,6 +41,17 @@ NS_ASSUME_NONNULL_BEGIN
  */
 @property BOOL onlyEnableForDevicesWithANE;
 
+/**
+ * Whether the compiled CoreML model is cached in the caches directory of the
+ * app and reused by later sessions of the same model.
+ */
+@property BOOL enableCompiledModelCache;
+
+/**
+ * Whether the GPU is allowed to accumulate in float16 instead of float32.
+ */
+@property BOOL allowLowPrecisionAccumulationOnGPU;
+
 @end
 
 @interface ORTSessionOptions (ORTSessionOptionsCoreMLEP)
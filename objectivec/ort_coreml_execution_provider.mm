@@ -26,7 +26,9 @@ BOOL ORTIsCoreMLExecutionProviderAvailable() {
     const uint32_t flags =
         (options.useCPUOnly ? COREML_FLAG_USE_CPU_ONLY : 0) |
         (options.enableOnSubgraphs ? COREML_FLAG_ENABLE_ON_SUBGRAPH : 0) |
-        (options.onlyEnableForDevicesWithANE ? COREML_FLAG_ONLY_ENABLE_DEVICE_WITH_ANE : 0);
+        (options.onlyEnableForDevicesWithANE ? COREML_FLAG_ONLY_ENABLE_DEVICE_WITH_ANE : 0) |
+        (options.enableCompiledModelCache ? COREML_FLAG_ENABLE_COMPILED_MODEL_CACHE : 0) |
+        (options.allowLowPrecisionAccumulationOnGPU ? COREML_FLAG_ALLOW_LOW_PRECISION_ACCUMULATION_ON_GPU : 0);
     Ort::ThrowOnError(OrtSessionOptionsAppendExecutionProvider_CoreML(
         [self CXXAPIOrtSessionOptions], flags));
     return YES;
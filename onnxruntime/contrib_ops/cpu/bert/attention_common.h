@@ -80,6 +80,21 @@ struct PackedAttentionParameters {
   bool broadcast_res_pos_bias;
 };
 
+// Parameters deduced from node attributes and inputs/outputs.
+struct GroupQueryAttentionParameters {
+  int batch_size;
+  int sequence_length;      // sequence length of the new query, key and value tokens
+  int max_sequence_length;  // capacity of the key/value cache
+  int hidden_size;          // hidden size of Q
+  int kv_hidden_size;       // hidden size of K or V
+  int head_size;            // hidden size per head of Q, K or V
+  int num_heads;
+  int kv_num_heads;
+  bool has_past;
+  float scale;
+  bool do_rotary;
+};
+
 namespace attention {
 // Environment variable to enable or disable TRT fused self attention kernel. Default is 0 (enabled).
 constexpr const char* kDisableFusedSelfAttention = "ORT_DISABLE_FUSED_ATTENTION";
@@ -97,6 +112,9 @@ constexpr const char* kDisableTrtFlashAttention = "ORT_DISABLE_TRT_FLASH_ATTENTI
 // Environment variable to enable or disable cutlass memory efficient attention. Default is 0 (enabled).
 constexpr const char* kDisableMemoryEfficientAttention = "ORT_DISABLE_MEMORY_EFFICIENT_ATTENTION";
 
+// Environment variable to enable or disable the fused (flash) attention kernel of the CPU EP. Default is 0 (enabled).
+constexpr const char* kDisableCpuFlashAttention = "ORT_DISABLE_CPU_FLASH_ATTENTION";
+
 // Minimum sequence length to enable memory efficient attention in FP32.
 constexpr int kMinSequenceLengthForMemoryEfficientAttentionFp32 = 256;
 
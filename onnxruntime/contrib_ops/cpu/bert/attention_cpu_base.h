@@ -4,11 +4,14 @@
 #pragma once
 
 #include "attention_base.h"
+#include "attention_common.h"
 #include "attention_helper.h"
 
 #include "core/common/common.h"
 #include "core/common/safeint.h"
 #include "core/framework/op_kernel.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/env_var_utils.h"
 
 namespace onnxruntime {
 namespace contrib {
@@ -16,7 +19,9 @@ namespace contrib {
 class AttentionCPUBase : public AttentionBase {
  protected:
   AttentionCPUBase(const OpKernelInfo& info, bool require_same_hidden_size)
-      : AttentionBase(info, require_same_hidden_size) {}
+      : AttentionBase(info, require_same_hidden_size) {
+    disable_flash_ = ParseEnvironmentVariableWithDefault<bool>(attention::kDisableCpuFlashAttention, false);
+  }
 
   template <typename T>
   Status ApplyAttention(const T* Q,                            // Q data with shape BxNxSxH
@@ -53,6 +58,33 @@ class AttentionCPUBase : public AttentionBase {
     // Total sequence length including that of past state: T = P + L
     const int total_sequence_length = past_sequence_length + kv_sequence_length;
 
+    // Without a mask, bias or past/present state, compute softmax(Q x K') x V with the fused MLAS kernel,
+    // which walks K and V in blocks and never materializes the BxNxSxT attention probabilities.
+    if constexpr (std::is_same<T, float>::value) {
+      if (!disable_flash_ && mask_index == nullptr && relative_position_bias == nullptr &&
+          past == nullptr && past_key == nullptr && past_value == nullptr &&
+          present == nullptr && present_key == nullptr && present_value == nullptr) {
+        const int head_size = qk_head_size == 0 ? v_head_size : qk_head_size;
+
+        MLAS_FLASH_ATTENTION_PARAMS params;
+        params.BatchSize = static_cast<size_t>(batch_size);
+        params.NumHeads = static_cast<size_t>(num_heads_);
+        params.SequenceLength = static_cast<size_t>(sequence_length);
+        params.KvSequenceLength = static_cast<size_t>(kv_sequence_length);
+        params.QkHeadSize = static_cast<size_t>(head_size);
+        params.VHeadSize = static_cast<size_t>(v_head_size);
+        params.Scale = scale_ == 0.0f ? 1.0f / sqrt(static_cast<float>(head_size)) : scale_;
+        params.Causal = is_unidirectional_ && sequence_length > 1;
+        params.Query = Q;
+        params.Key = K;
+        params.Value = V;
+        params.Output = output->MutableData<T>();
+        MlasFlashAttention(&params, tp);
+
+        return Status::OK();
+      }
+    }
+
     // Compute the attention score.
     size_t bytes = SafeInt<size_t>(batch_size) * num_heads_ * sequence_length * total_sequence_length * sizeof(T);
     auto attention_probs = allocator->Alloc(bytes);
@@ -272,6 +304,8 @@ class AttentionCPUBase : public AttentionBase {
       }
     });
   }
+
+  bool disable_flash_;  // whether the fused attention kernel is disabled by the environment
 };
 
 }  // namespace contrib
@@ -0,0 +1,411 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "group_query_attention.h"
+#include "group_query_attention_helper.h"
+
+#include "core/common/common.h"
+#include "core/common/safeint.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
+#include "core/util/math.h"
+
+#include <cmath>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+using onnxruntime::concurrency::ThreadPool;
+
+namespace onnxruntime {
+namespace contrib {
+
+// These ops are internal-only, so register outside of onnx
+ONNX_OPERATOR_TYPED_KERNEL_EX(
+    GroupQueryAttention,
+    kMSDomain,
+    1,
+    float,
+    kCpuExecutionProvider,
+    KernelDefBuilder()
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>())
+#if !defined(DISABLE_FLOAT8_TYPES)
+        .TypeConstraint("T_CACHE", BuildKernelDefConstraints<float, int8_t, Float8E4M3FN>())
+#else
+        .TypeConstraint("T_CACHE", BuildKernelDefConstraints<float, int8_t>())
+#endif
+        .TypeConstraint("M", DataTypeImpl::GetTensorType<int32_t>())
+        .MayInplace(3, 1)
+        .MayInplace(4, 2),
+    GroupQueryAttention<float>);
+
+namespace {
+
+// A cache of the input type is used as is; 8-bit caches hold value / scale of each key/value head.
+template <typename TCache>
+void StoreCacheRow(const float* src, TCache* dst, size_t count, float scale);
+
+template <>
+void StoreCacheRow<float>(const float* src, float* dst, size_t count, float /*scale*/) {
+  if (src != dst) {
+    memcpy(dst, src, count * sizeof(float));
+  }
+}
+
+template <>
+void StoreCacheRow<int8_t>(const float* src, int8_t* dst, size_t count, float scale) {
+  MlasQuantizeLinear<int8_t>(src, dst, count, scale, 0);
+}
+
+#if !defined(DISABLE_FLOAT8_TYPES)
+template <>
+void StoreCacheRow<Float8E4M3FN>(const float* src, Float8E4M3FN* dst, size_t count, float scale) {
+  for (size_t i = 0; i < count; i++) {
+    dst[i] = Float8E4M3FN(src[i] / scale, true);
+  }
+}
+#endif
+
+// Returns the float values of the first count elements of a cache chunk, dequantized into buffer if needed.
+template <typename TCache>
+const float* LoadCacheRows(const TCache* src, size_t count, float scale, float* buffer);
+
+template <>
+const float* LoadCacheRows<float>(const float* src, size_t /*count*/, float /*scale*/, float* /*buffer*/) {
+  return src;
+}
+
+template <>
+const float* LoadCacheRows<int8_t>(const int8_t* src, size_t count, float scale, float* buffer) {
+  for (size_t i = 0; i < count; i++) {
+    buffer[i] = static_cast<float>(src[i]) * scale;
+  }
+  return buffer;
+}
+
+#if !defined(DISABLE_FLOAT8_TYPES)
+template <>
+const float* LoadCacheRows<Float8E4M3FN>(const Float8E4M3FN* src, size_t count, float scale, float* buffer) {
+  // There are only 256 float8 values, so a table of the scaled values replaces the conversion of each element.
+  float table[256];
+  for (int i = 0; i < 256; i++) {
+    table[i] = Float8E4M3FN(static_cast<uint8_t>(i), Float8E4M3FN::FromBits()).ToFloat() * scale;
+  }
+  for (size_t i = 0; i < count; i++) {
+    buffer[i] = table[src[i].val];
+  }
+  return buffer;
+}
+#endif
+
+}  // namespace
+
+template <typename T>
+GroupQueryAttention<T>::GroupQueryAttention(const OpKernelInfo& info) : OpKernel(info) {
+  int64_t num_heads = 0;
+  int64_t kv_num_heads = 0;
+  ORT_ENFORCE(info.GetAttr("num_heads", &num_heads).IsOK() && num_heads > 0);
+  ORT_ENFORCE(info.GetAttr("kv_num_heads", &kv_num_heads).IsOK() && kv_num_heads > 0 &&
+              num_heads % kv_num_heads == 0);
+  num_heads_ = static_cast<int>(num_heads);
+  kv_num_heads_ = static_cast<int>(kv_num_heads);
+
+  scale_ = info.GetAttrOrDefault<float>("scale", 0.0f);
+  do_rotary_ = info.GetAttrOrDefault<int64_t>("do_rotary", 0) == 1;
+  rotary_interleaved_ = info.GetAttrOrDefault<int64_t>("rotary_interleaved", 0) == 1;
+}
+
+template <typename T>
+Status GroupQueryAttention<T>::Compute(OpKernelContext* context) const {
+  const Tensor* query = context->Input<Tensor>(0);
+  const Tensor* key = context->Input<Tensor>(1);
+  const Tensor* value = context->Input<Tensor>(2);
+  const Tensor* past_key = context->Input<Tensor>(3);
+  const Tensor* past_value = context->Input<Tensor>(4);
+  const Tensor* past_seqlens = context->Input<Tensor>(5);
+  const Tensor* cos_cache = context->Input<Tensor>(6);
+  const Tensor* sin_cache = context->Input<Tensor>(7);
+  const Tensor* key_cache_scale = context->Input<Tensor>(8);
+  const Tensor* value_cache_scale = context->Input<Tensor>(9);
+
+  GroupQueryAttentionParameters parameters = {};
+  ORT_RETURN_IF_ERROR(group_query_attention_helper::CheckInputs<Tensor>(query,
+                                                                        key,
+                                                                        value,
+                                                                        past_key,
+                                                                        past_value,
+                                                                        past_seqlens,
+                                                                        cos_cache,
+                                                                        sin_cache,
+                                                                        &parameters,
+                                                                        num_heads_,
+                                                                        kv_num_heads_,
+                                                                        scale_,
+                                                                        do_rotary_));
+
+  const int batch_size = parameters.batch_size;
+  const int sequence_length = parameters.sequence_length;
+  const int max_sequence_length = parameters.max_sequence_length;
+  const int head_size = parameters.head_size;
+  const int hidden_size = parameters.hidden_size;
+
+  std::vector<int> past_lengths(batch_size, 0);
+  if (past_seqlens != nullptr) {
+    const int32_t* past_seqlens_data = past_seqlens->Data<int32_t>();
+    for (int b = 0; b < batch_size; b++) {
+      past_lengths[b] = past_seqlens_data[b];
+    }
+  }
+
+  // The new tokens are written to the present cache after the past ones, so they must fit whether or not the
+  // past lengths are given.
+  for (int b = 0; b < batch_size; b++) {
+    const int past_length = past_lengths[b];
+    if (past_length < 0 || past_length + sequence_length > max_sequence_length) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                             "past length ", past_length, " of batch ", b, " plus sequence_length ", sequence_length,
+                             " exceeds the cache capacity ", max_sequence_length);
+    }
+  }
+
+  const int half_head_size = head_size / 2;
+  const T* cos_cache_data = nullptr;
+  const T* sin_cache_data = nullptr;
+  if (do_rotary_) {
+    const int rotary_positions = static_cast<int>(cos_cache->Shape()[0]);
+    for (int b = 0; b < batch_size; b++) {
+      if (past_lengths[b] + sequence_length > rotary_positions) {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                               "Position ", past_lengths[b] + sequence_length - 1,
+                               " is out of range of the cos/sin cache with ", rotary_positions, " positions");
+      }
+    }
+    cos_cache_data = cos_cache->Data<T>();
+    sin_cache_data = sin_cache->Data<T>();
+  }
+
+  Tensor* output = context->Output(0, query->Shape());
+
+  std::vector<int64_t> present_dims{batch_size, kv_num_heads_, max_sequence_length, head_size};
+  TensorShape present_shape(present_dims);
+  Tensor* present_key = context->Output(1, present_shape);
+  Tensor* present_value = context->Output(2, present_shape);
+
+  // The cache type is the type of the present outputs, which the past inputs must share.
+  const auto cache_type = present_key->DataType();
+  if (present_value->DataType() != cache_type ||
+      (past_key != nullptr && (past_key->DataType() != cache_type || past_value->DataType() != cache_type))) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "The past and present key/value caches shall have the same type");
+  }
+
+  const float* key_cache_scale_data = nullptr;
+  const float* value_cache_scale_data = nullptr;
+  if (!present_key->IsDataType<T>()) {
+    for (const Tensor* scale : {key_cache_scale, value_cache_scale}) {
+      if (scale == nullptr || scale->Shape().NumDimensions() != 1 || scale->Shape()[0] != kv_num_heads_) {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                               "Input 'key_cache_scale' and 'value_cache_scale' with shape (", kv_num_heads_,
+                               ") are required by an 8-bit key/value cache");
+      }
+    }
+    key_cache_scale_data = key_cache_scale->Data<float>();
+    value_cache_scale_data = value_cache_scale->Data<float>();
+  }
+
+  const T* query_data = query->Data<T>();
+
+  // Rotate the query into a scratch buffer; the key is rotated when it is written to the cache.
+  AllocatorPtr allocator;
+  ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&allocator));
+  IAllocatorUniquePtr<T> rotary_query_buffer;
+  if (do_rotary_) {
+    rotary_query_buffer = IAllocator::MakeUniquePtr<T>(allocator, SafeInt<size_t>(query->Shape().Size()));
+    T* rotary_query = rotary_query_buffer.get();
+    const ptrdiff_t rows = SafeInt<ptrdiff_t>(batch_size) * sequence_length;
+    ThreadPool::TryParallelFor(context->GetOperatorThreadPool(), rows, static_cast<double>(hidden_size) * 4,
+                               [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+      for (std::ptrdiff_t i = begin; i != end; ++i) {
+        const int batch_index = static_cast<int>(i) / sequence_length;
+        const int s = static_cast<int>(i) % sequence_length;
+        const size_t rotary_offset = static_cast<size_t>(past_lengths[batch_index] + s) * half_head_size;
+        for (int n = 0; n < num_heads_; n++) {
+          const size_t offset = static_cast<size_t>(i) * hidden_size + static_cast<size_t>(n) * head_size;
+          MlasRotaryEmbedOneRow(query_data + offset, sin_cache_data + rotary_offset, cos_cache_data + rotary_offset,
+                                head_size, rotary_interleaved_, rotary_query + offset);
+        }
+      }
+    });
+    query_data = rotary_query;
+  }
+
+  if (present_key->IsDataType<T>()) {
+    return ApplyAttention<T>(context, parameters, past_lengths, query_data, key, value, past_key, past_value,
+                             present_key, present_value, nullptr, nullptr, cos_cache_data, sin_cache_data, output);
+  }
+  if (present_key->IsDataType<int8_t>()) {
+    return ApplyAttention<int8_t>(context, parameters, past_lengths, query_data, key, value, past_key, past_value,
+                                  present_key, present_value, key_cache_scale_data, value_cache_scale_data,
+                                  cos_cache_data, sin_cache_data, output);
+  }
+#if !defined(DISABLE_FLOAT8_TYPES)
+  if (present_key->IsDataType<Float8E4M3FN>()) {
+    return ApplyAttention<Float8E4M3FN>(context, parameters, past_lengths, query_data, key, value, past_key,
+                                        past_value, present_key, present_value, key_cache_scale_data,
+                                        value_cache_scale_data, cos_cache_data, sin_cache_data, output);
+  }
+#endif
+  return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                         "Unsupported key/value cache type ", DataTypeImpl::ToString(cache_type));
+}
+
+template <typename T>
+template <typename TCache>
+Status GroupQueryAttention<T>::ApplyAttention(OpKernelContext* context,
+                                              const GroupQueryAttentionParameters& parameters,
+                                              const std::vector<int>& past_lengths,
+                                              const T* query_data,
+                                              const Tensor* key,
+                                              const Tensor* value,
+                                              const Tensor* past_key,
+                                              const Tensor* past_value,
+                                              Tensor* present_key,
+                                              Tensor* present_value,
+                                              const float* key_cache_scale,
+                                              const float* value_cache_scale,
+                                              const T* cos_cache_data,
+                                              const T* sin_cache_data,
+                                              Tensor* output) const {
+  constexpr bool is_quantized_cache = !std::is_same<TCache, T>::value;
+
+  const int batch_size = parameters.batch_size;
+  const int sequence_length = parameters.sequence_length;
+  const int max_sequence_length = parameters.max_sequence_length;
+  const int head_size = parameters.head_size;
+  const int hidden_size = parameters.hidden_size;
+  const int kv_hidden_size = parameters.kv_hidden_size;
+  const int half_head_size = head_size / 2;
+
+  // Cache layout is (B, N_kv, S*, H); each (batch, kv head) pair owns one chunk of S* x H values.
+  const size_t cache_chunk_length = SafeInt<size_t>(max_sequence_length) * head_size;
+  const int kv_chunks = batch_size * kv_num_heads_;
+  TCache* present_key_data = present_key->MutableData<TCache>();
+  TCache* present_value_data = present_value->MutableData<TCache>();
+
+  const TCache* past_key_data = past_key != nullptr ? past_key->Data<TCache>() : nullptr;
+  const TCache* past_value_data = past_value != nullptr ? past_value->Data<TCache>() : nullptr;
+  const T* key_data = key->Data<T>();
+  const T* value_data = value->Data<T>();
+
+  ThreadPool* tp = context->GetOperatorThreadPool();
+
+  // Update the cache. When the present buffer shares memory with the past buffer (in-place update), only the new
+  // tokens are written. Otherwise the past buffer is copied first.
+  const double copy_cost = static_cast<double>(max_sequence_length) * head_size * 2;
+  ThreadPool::TryParallelFor(tp, kv_chunks, copy_cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+    // The rotated key before it is quantized.
+    std::vector<float> key_row(is_quantized_cache && do_rotary_ ? head_size : 0);
+
+    for (std::ptrdiff_t i = begin; i != end; ++i) {
+      const int batch_index = static_cast<int>(i) / kv_num_heads_;
+      const int head_index = static_cast<int>(i) % kv_num_heads_;
+      const int past_length = past_lengths[batch_index];
+      const float k_scale = is_quantized_cache ? key_cache_scale[head_index] : 1.0f;
+      const float v_scale = is_quantized_cache ? value_cache_scale[head_index] : 1.0f;
+
+      TCache* k_cache = present_key_data + cache_chunk_length * i;
+      TCache* v_cache = present_value_data + cache_chunk_length * i;
+      if (past_key_data != nullptr && past_key_data != present_key_data) {
+        memcpy(k_cache, past_key_data + cache_chunk_length * i, cache_chunk_length * sizeof(TCache));
+      }
+      if (past_value_data != nullptr && past_value_data != present_value_data) {
+        memcpy(v_cache, past_value_data + cache_chunk_length * i, cache_chunk_length * sizeof(TCache));
+      }
+
+      // New key and value are BxSxN_kvxH; append them to the cache after the valid past tokens.
+      for (int s = 0; s < sequence_length; s++) {
+        const size_t input_offset = (SafeInt<size_t>(batch_index) * sequence_length + s) * kv_hidden_size +
+                                    static_cast<size_t>(head_index) * head_size;
+        const size_t cache_offset = SafeInt<size_t>(past_length + s) * head_size;
+        const T* k_row = key_data + input_offset;
+        if (do_rotary_) {
+          const size_t rotary_offset = static_cast<size_t>(past_length + s) * half_head_size;
+          // A float cache is rotated in place.
+          T* rotated_k_row = is_quantized_cache ? key_row.data() : reinterpret_cast<T*>(k_cache + cache_offset);
+          MlasRotaryEmbedOneRow(k_row, sin_cache_data + rotary_offset, cos_cache_data + rotary_offset, head_size,
+                                rotary_interleaved_, rotated_k_row);
+          k_row = rotated_k_row;
+        }
+        StoreCacheRow<TCache>(k_row, k_cache + cache_offset, head_size, k_scale);
+        StoreCacheRow<TCache>(value_data + input_offset, v_cache + cache_offset, head_size, v_scale);
+      }
+    }
+  });
+
+  // Scratch for attention scores: (B, N, S, S*) so each head works on its own rows.
+  AllocatorPtr allocator;
+  ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&allocator));
+  const size_t probs_chunk_length = SafeInt<size_t>(sequence_length) * max_sequence_length;
+  auto probs_buffer = IAllocator::MakeUniquePtr<T>(allocator,
+                                                   SafeInt<size_t>(batch_size) * num_heads_ * probs_chunk_length);
+  T* probs_data = probs_buffer.get();
+
+  T* output_data = output->MutableData<T>();
+  const int heads_per_kv_head = num_heads_ / kv_num_heads_;
+  const float alpha = parameters.scale == 0.0f ? 1.0f / std::sqrt(static_cast<float>(head_size)) : parameters.scale;
+
+  const double cost = static_cast<double>(sequence_length) * max_sequence_length * head_size * 2;
+  ThreadPool::TryParallelFor(tp, SafeInt<ptrdiff_t>(batch_size) * num_heads_, cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+    // An 8-bit cache is dequantized one head at a time, so only the valid tokens of a chunk take float storage.
+    std::vector<float> k_buffer(is_quantized_cache ? cache_chunk_length : 0);
+    std::vector<float> v_buffer(is_quantized_cache ? cache_chunk_length : 0);
+
+    for (std::ptrdiff_t i = begin; i != end; ++i) {
+      const int batch_index = static_cast<int>(i) / num_heads_;
+      const int head_index = static_cast<int>(i) % num_heads_;
+      const int kv_head_index = head_index / heads_per_kv_head;
+      const int past_length = past_lengths[batch_index];
+      const int total_sequence_length = past_length + sequence_length;
+      const size_t total_length = SafeInt<size_t>(total_sequence_length) * head_size;
+
+      const size_t kv_offset = (SafeInt<size_t>(batch_index) * kv_num_heads_ + kv_head_index) * cache_chunk_length;
+      const T* k = LoadCacheRows<TCache>(present_key_data + kv_offset, total_length,
+                                         is_quantized_cache ? key_cache_scale[kv_head_index] : 1.0f, k_buffer.data());
+      const T* v = LoadCacheRows<TCache>(present_value_data + kv_offset, total_length,
+                                         is_quantized_cache ? value_cache_scale[kv_head_index] : 1.0f,
+                                         v_buffer.data());
+      const size_t q_offset = SafeInt<size_t>(batch_index) * sequence_length * hidden_size +
+                              static_cast<size_t>(head_index) * head_size;
+      T* probs = probs_data + probs_chunk_length * i;
+
+      // Q: S x H with row stride N x H, K: T x H -> probs: S x T with row stride S*
+      math::GemmEx<T, ThreadPool>(CblasNoTrans, CblasTrans,
+                                  sequence_length, total_sequence_length, head_size, alpha,
+                                  query_data + q_offset, hidden_size,
+                                  k, head_size, 0.0f,
+                                  probs, max_sequence_length, nullptr);
+
+      // Causal softmax: token s attends to the past and to new tokens up to s.
+      for (int s = 0; s < sequence_length; s++) {
+        T* row = probs + static_cast<size_t>(s) * max_sequence_length;
+        const int valid_length = past_length + s + 1;
+        MlasComputeSoftmax(row, row, 1, valid_length, false, nullptr);
+        for (int t = valid_length; t < total_sequence_length; t++) {
+          row[t] = 0.0f;
+        }
+      }
+
+      // probs: S x T, V: T x H -> output: S x H with row stride N x H
+      math::GemmEx<T, ThreadPool>(CblasNoTrans, CblasNoTrans,
+                                  sequence_length, head_size, total_sequence_length, 1.0f,
+                                  probs, max_sequence_length,
+                                  v, head_size, 0.0f,
+                                  output_data + q_offset, hidden_size, nullptr);
+    }
+  });
+
+  return Status::OK();
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
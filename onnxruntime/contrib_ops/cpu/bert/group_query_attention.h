@@ -0,0 +1,47 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/common.h"
+#include "core/framework/op_kernel.h"
+#include "contrib_ops/cpu/bert/attention_common.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+template <typename T>
+class GroupQueryAttention final : public OpKernel {
+ public:
+  GroupQueryAttention(const OpKernelInfo& info);
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  // Updates the key/value cache of element type TCache and computes the attention output.
+  template <typename TCache>
+  Status ApplyAttention(OpKernelContext* context,
+                        const GroupQueryAttentionParameters& parameters,
+                        const std::vector<int>& past_lengths,
+                        const T* query_data,
+                        const Tensor* key,
+                        const Tensor* value,
+                        const Tensor* past_key,
+                        const Tensor* past_value,
+                        Tensor* present_key,
+                        Tensor* present_value,
+                        const float* key_cache_scale,
+                        const float* value_cache_scale,
+                        const T* cos_cache_data,
+                        const T* sin_cache_data,
+                        Tensor* output) const;
+
+ protected:
+  int num_heads_;     // number of attention heads of Q
+  int kv_num_heads_;  // number of attention heads of K or V
+  float scale_;       // the scaling factor applied before softmax
+  bool do_rotary_;    // apply rotary embeddings to query and key
+  bool rotary_interleaved_;
+};
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,148 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/common.h"
+#include "core/providers/common.h"
+#include "contrib_ops/cpu/bert/attention_common.h"
+
+namespace onnxruntime {
+namespace contrib {
+namespace group_query_attention_helper {
+
+template <typename T>
+Status CheckInputs(const T* query,
+                   const T* key,
+                   const T* value,
+                   const T* past_key,
+                   const T* past_value,
+                   const T* past_seqlens,
+                   const T* cos_cache,
+                   const T* sin_cache,
+                   void* parameters,
+                   int num_heads,
+                   int kv_num_heads,
+                   float scale,
+                   bool do_rotary) {
+  //     query            (Q)       : (B, S, D)
+  //     key              (K)       : (B, S, D_kv)
+  //     value            (V)       : (B, S, D_kv)
+  //     past_key                   : (B, N_kv, S*, H)
+  //     past_value                 : (B, N_kv, S*, H)
+  //     past_seqlens               : (B)
+  //     cos_cache                  : (S_r, H / 2)
+  //     sin_cache                  : (S_r, H / 2)
+  if (num_heads <= 0 || kv_num_heads <= 0 || num_heads % kv_num_heads != 0) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "num_heads must be a positive multiple of kv_num_heads. Got num_heads: ", num_heads,
+                           " kv_num_heads: ", kv_num_heads);
+  }
+
+  const auto& query_dims = query->Shape().GetDims();
+  const auto& key_dims = key->Shape().GetDims();
+  const auto& value_dims = value->Shape().GetDims();
+
+  if (query_dims.size() != 3) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input 'query' is expected to have 3 dimensions, got ",
+                           query_dims.size());
+  }
+
+  int batch_size = static_cast<int>(query_dims[0]);
+  int sequence_length = static_cast<int>(query_dims[1]);
+  int hidden_size = static_cast<int>(query_dims[2]);
+
+  if (hidden_size % num_heads != 0) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "query hidden size ", hidden_size, " is not divisible by num_heads ", num_heads);
+  }
+  int head_size = hidden_size / num_heads;
+  int kv_hidden_size = head_size * kv_num_heads;
+
+  if (key_dims.size() != 3 || value_dims.size() != 3) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "Input 'key' and 'value' are expected to have 3 dimensions");
+  }
+  for (const auto& dims : {key_dims, value_dims}) {
+    if (dims[0] != batch_size || dims[1] != sequence_length || dims[2] != kv_hidden_size) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                             "Input 'key' and 'value' are expected to have shape (", batch_size, ", ",
+                             sequence_length, ", ", kv_hidden_size, ")");
+    }
+  }
+
+  int max_sequence_length = sequence_length;
+  if ((past_key != nullptr) != (past_value != nullptr)) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "Input 'past_key' and 'past_value' shall be both present or both absent");
+  }
+
+  if (past_key != nullptr) {
+    const auto& past_key_dims = past_key->Shape().GetDims();
+    const auto& past_value_dims = past_value->Shape().GetDims();
+    if (past_key_dims.size() != 4 || past_key_dims != past_value_dims) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                             "Input 'past_key' and 'past_value' are expected to have the same 4D shape");
+    }
+    if (past_key_dims[0] != batch_size || past_key_dims[1] != kv_num_heads || past_key_dims[3] != head_size) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                             "Input 'past_key' is expected to have shape (", batch_size, ", ", kv_num_heads,
+                             ", max_sequence_length, ", head_size, ")");
+    }
+    max_sequence_length = static_cast<int>(past_key_dims[2]);
+  }
+
+  // The present cache has the capacity of the past one and receives at least the new tokens.
+  if (max_sequence_length < sequence_length) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "Input 'past_key' with capacity ", max_sequence_length,
+                           " is too small for sequence_length ", sequence_length);
+  }
+
+  if (past_seqlens != nullptr) {
+    const auto& past_seqlens_dims = past_seqlens->Shape().GetDims();
+    if (past_seqlens_dims.size() != 1 || past_seqlens_dims[0] != batch_size) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                             "Input 'past_seqlens' is expected to have shape (", batch_size, ")");
+    }
+    if (past_key == nullptr) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                             "Input 'past_seqlens' requires 'past_key' and 'past_value'");
+    }
+  }
+
+  if (do_rotary) {
+    if (cos_cache == nullptr || sin_cache == nullptr) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                             "Input 'cos_cache' and 'sin_cache' are required when do_rotary is 1");
+    }
+    const auto& cos_cache_dims = cos_cache->Shape().GetDims();
+    if (cos_cache_dims.size() != 2 || cos_cache->Shape() != sin_cache->Shape() ||
+        cos_cache_dims[1] * 2 != head_size) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                             "Input 'cos_cache' and 'sin_cache' are expected to have shape (max_sequence_length, ",
+                             head_size / 2, ")");
+    }
+  }
+
+  if (parameters != nullptr) {
+    GroupQueryAttentionParameters* output_parameters = reinterpret_cast<GroupQueryAttentionParameters*>(parameters);
+    output_parameters->batch_size = batch_size;
+    output_parameters->sequence_length = sequence_length;
+    output_parameters->max_sequence_length = max_sequence_length;
+    output_parameters->hidden_size = hidden_size;
+    output_parameters->kv_hidden_size = kv_hidden_size;
+    output_parameters->head_size = head_size;
+    output_parameters->num_heads = num_heads;
+    output_parameters->kv_num_heads = kv_num_heads;
+    output_parameters->has_past = (past_key != nullptr);
+    output_parameters->scale = scale;
+    output_parameters->do_rotary = do_rotary;
+  }
+
+  return Status::OK();
+}
+
+}  // namespace group_query_attention_helper
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,325 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cpu/bert/longformer_attention.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "core/common/safeint.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
+
+using onnxruntime::concurrency::ThreadPool;
+
+namespace onnxruntime {
+namespace contrib {
+
+ONNX_OPERATOR_TYPED_KERNEL_EX(
+    LongformerAttention,
+    kMSDomain,
+    1,
+    float,
+    kCpuExecutionProvider,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    LongformerAttention<float>);
+
+template <typename T>
+LongformerAttention<T>::LongformerAttention(const OpKernelInfo& info)
+    : OpKernel(info), LongformerAttentionBase(info) {
+}
+
+// Computes [Q | K | V] = input * weights + bias as a (row_count, 3 * hidden_size) matrix. The weights are merged with
+// shape (hidden_size, 3 * hidden_size) in format 1, or separated with shape (3, hidden_size, hidden_size) in format 0.
+static void ComputeQKV(const float* input,
+                       const float* weights,
+                       const float* bias,
+                       bool use_merged_qkv_weights,
+                       size_t row_count,
+                       size_t hidden_size,
+                       float* qkv,
+                       ThreadPool* thread_pool) {
+  const size_t qkv_size = 3 * hidden_size;
+  for (size_t i = 0; i < row_count; ++i) {
+    std::copy_n(bias, qkv_size, qkv + i * qkv_size);
+  }
+
+  if (use_merged_qkv_weights) {
+    MlasGemm(CblasNoTrans, CblasNoTrans, row_count, qkv_size, hidden_size, 1.0f,
+             input, hidden_size, weights, qkv_size, 1.0f, qkv, qkv_size, thread_pool);
+  } else {
+    for (size_t m = 0; m < 3; ++m) {
+      MlasGemm(CblasNoTrans, CblasNoTrans, row_count, hidden_size, hidden_size, 1.0f,
+               input, hidden_size, weights + m * hidden_size * hidden_size, hidden_size, 1.0f,
+               qkv + m * hidden_size, qkv_size, thread_pool);
+    }
+  }
+}
+
+template <typename T>
+Status LongformerAttention<T>::Compute(OpKernelContext* context) const {
+  const Tensor* input = context->Input<Tensor>(0);
+  const Tensor* weights = context->Input<Tensor>(1);
+  const Tensor* bias = context->Input<Tensor>(2);
+  const Tensor* attention_mask = context->Input<Tensor>(3);
+  const Tensor* global_weights = context->Input<Tensor>(4);
+  const Tensor* global_bias = context->Input<Tensor>(5);
+  const Tensor* global_attention_mask = context->Input<Tensor>(6);
+  ORT_RETURN_IF_ERROR(CheckInputs(input->Shape(), weights->Shape(), bias->Shape(), attention_mask->Shape(),
+                                  global_weights->Shape(), global_bias->Shape(), global_attention_mask->Shape()));
+
+  const auto& shape = input->Shape();
+  const int64_t batch_size = shape[0];
+  const int64_t sequence_length = shape[1];
+  const int64_t hidden_size = shape[2];
+  const int64_t head_size = hidden_size / num_heads_;
+  const int64_t qkv_size = 3 * hidden_size;
+  const int64_t window = window_;
+
+  Tensor* output = context->Output(0, shape);
+  if (shape.Size() == 0) {
+    return Status::OK();
+  }
+
+  const bool use_merged_qkv_weights = (weights->Shape().NumDimensions() == 2);
+  const T* input_data = input->Data<T>();
+  const T* bias_data = bias->Data<T>();
+  const T* mask_data = attention_mask->Data<T>();
+  const int32_t* global_data = global_attention_mask->Data<int32_t>();
+  T* output_data = output->MutableData<T>();
+
+  ThreadPool* thread_pool = context->GetOperatorThreadPool();
+  AllocatorPtr allocator;
+  ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&allocator));
+
+  const size_t row_count = SafeInt<size_t>(batch_size) * sequence_length;
+  auto qkv_buffer = IAllocator::MakeUniquePtr<T>(allocator, row_count * qkv_size);
+  T* qkv = qkv_buffer.get();
+  ComputeQKV(input_data, weights->Data<T>(), bias_data, use_merged_qkv_weights,
+             row_count, static_cast<size_t>(hidden_size), qkv, thread_pool);
+
+  // Positions of the global tokens of each batch, in increasing order.
+  std::vector<int64_t> global_index(row_count);
+  std::vector<int64_t> global_count(static_cast<size_t>(batch_size), 0);
+  int64_t max_num_global = 0;
+  for (int64_t b = 0; b < batch_size; ++b) {
+    for (int64_t s = 0; s < sequence_length; ++s) {
+      if (global_data[b * sequence_length + s] != 0) {
+        global_index[b * sequence_length + global_count[b]++] = s;
+      }
+    }
+    max_num_global = std::max(max_num_global, global_count[b]);
+  }
+
+  IAllocatorUniquePtr<T> global_qkv_buffer;
+  IAllocatorUniquePtr<T> global_kv_buffer;
+  T* global_qkv = nullptr;
+  T* global_kv = nullptr;
+  if (max_num_global > 0) {
+    // Format 1 has the biases of global Q, K and V in global_bias. Format 0 has the bias of global Q in global_bias,
+    // and the biases of global K and V after those of Q, K and V in bias.
+    std::vector<T> global_qkv_bias(static_cast<size_t>(qkv_size));
+    if (use_merged_qkv_weights) {
+      std::copy_n(global_bias->Data<T>(), qkv_size, global_qkv_bias.data());
+    } else {
+      std::copy_n(global_bias->Data<T>(), hidden_size, global_qkv_bias.data());
+      std::copy_n(bias_data + qkv_size, 2 * hidden_size, global_qkv_bias.data() + hidden_size);
+    }
+
+    global_qkv_buffer = IAllocator::MakeUniquePtr<T>(allocator, row_count * qkv_size);
+    global_qkv = global_qkv_buffer.get();
+    ComputeQKV(input_data, global_weights->Data<T>(), global_qkv_bias.data(), use_merged_qkv_weights,
+               row_count, static_cast<size_t>(hidden_size), global_qkv, thread_pool);
+
+    // Local tokens attend to the global tokens with local K and V, which are gathered so that one GEMM covers them.
+    global_kv_buffer = IAllocator::MakeUniquePtr<T>(allocator,
+                                                    SafeInt<size_t>(batch_size) * max_num_global * 2 * hidden_size);
+    global_kv = global_kv_buffer.get();
+    for (int64_t b = 0; b < batch_size; ++b) {
+      for (int64_t g = 0; g < global_count[b]; ++g) {
+        const int64_t row = b * sequence_length + global_index[b * sequence_length + g];
+        std::copy_n(qkv + row * qkv_size + hidden_size, 2 * hidden_size,
+                    global_kv + (b * max_num_global + g) * 2 * hidden_size);
+      }
+    }
+  }
+
+  const float scale = 1.0f / std::sqrt(static_cast<float>(head_size));
+  const T lowest = std::numeric_limits<T>::lowest();
+
+  // The local attention is block banded: a block of W rows attends to the keys of its own block and of the two
+  // neighboring blocks, and to the global tokens, so each task computes the scores of one block of one head with
+  // dense GEMMs of at most W x (3W + G). Scores outside of the sliding window are masked out before softmax.
+  const int64_t block_count = (sequence_length + window - 1) / window;
+  const int64_t max_score_columns = 3 * window + max_num_global;
+  ThreadPool::TryParallelFor(
+      thread_pool, static_cast<std::ptrdiff_t>(batch_size * num_heads_ * block_count),
+      static_cast<double>(window * max_score_columns * head_size) * 4.0,
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        std::vector<T> scores(static_cast<size_t>(window * max_score_columns));
+
+        for (std::ptrdiff_t i = first; i != last; ++i) {
+          const int64_t block = i % block_count;
+          const int64_t head = (i / block_count) % num_heads_;
+          const int64_t b = i / (block_count * num_heads_);
+
+          const int64_t row_start = block * window;
+          const int64_t row_end = std::min(sequence_length, row_start + window);
+          const int64_t key_start = std::max<int64_t>(0, row_start - window);
+          const int64_t key_end = std::min(sequence_length, row_end + window);
+          const int64_t rows = row_end - row_start;
+          const int64_t local_count = key_end - key_start;
+          const int64_t num_global = global_count[b];
+          const int64_t score_stride = local_count + num_global;
+
+          const T* batch_qkv = qkv + b * sequence_length * qkv_size + head * head_size;
+          const T* batch_global_kv = global_kv + b * max_num_global * 2 * hidden_size + head * head_size;
+          const int64_t* batch_global_index = global_index.data() + b * sequence_length;
+          const T* batch_mask = mask_data + b * sequence_length;
+          T* out = output_data + (b * sequence_length + row_start) * hidden_size + head * head_size;
+
+          MlasGemm(CblasNoTrans, CblasTrans,
+                   static_cast<size_t>(rows), static_cast<size_t>(local_count), static_cast<size_t>(head_size),
+                   scale,
+                   batch_qkv + row_start * qkv_size, static_cast<size_t>(qkv_size),
+                   batch_qkv + key_start * qkv_size + hidden_size, static_cast<size_t>(qkv_size),
+                   0.0f,
+                   scores.data(), static_cast<size_t>(score_stride),
+                   nullptr);
+          if (num_global > 0) {
+            MlasGemm(CblasNoTrans, CblasTrans,
+                     static_cast<size_t>(rows), static_cast<size_t>(num_global), static_cast<size_t>(head_size),
+                     scale,
+                     batch_qkv + row_start * qkv_size, static_cast<size_t>(qkv_size),
+                     batch_global_kv, static_cast<size_t>(2 * hidden_size),
+                     0.0f,
+                     scores.data() + local_count, static_cast<size_t>(score_stride),
+                     nullptr);
+          }
+
+          for (int64_t r = 0; r < rows; ++r) {
+            const int64_t row = row_start + r;
+            T* row_scores = scores.data() + r * score_stride;
+            for (int64_t j = 0; j < local_count; ++j) {
+              const int64_t column = key_start + j;
+              row_scores[j] = std::abs(column - row) <= window ? row_scores[j] + batch_mask[column] : lowest;
+            }
+
+            // A global token within the window is already counted in the local scores.
+            for (int64_t g = 0; g < num_global; ++g) {
+              const int64_t column = batch_global_index[g];
+              T& score = row_scores[local_count + g];
+              score = std::abs(column - row) <= window ? lowest : score + batch_mask[column];
+            }
+          }
+
+          MlasComputeSoftmax(scores.data(), scores.data(), static_cast<size_t>(rows), static_cast<size_t>(score_stride),
+                             false, nullptr);
+
+          MlasGemm(CblasNoTrans, CblasNoTrans,
+                   static_cast<size_t>(rows), static_cast<size_t>(head_size), static_cast<size_t>(local_count),
+                   1.0f,
+                   scores.data(), static_cast<size_t>(score_stride),
+                   batch_qkv + key_start * qkv_size + 2 * hidden_size, static_cast<size_t>(qkv_size),
+                   0.0f,
+                   out, static_cast<size_t>(hidden_size),
+                   nullptr);
+          if (num_global > 0) {
+            MlasGemm(CblasNoTrans, CblasNoTrans,
+                     static_cast<size_t>(rows), static_cast<size_t>(head_size), static_cast<size_t>(num_global),
+                     1.0f,
+                     scores.data() + local_count, static_cast<size_t>(score_stride),
+                     batch_global_kv + hidden_size, static_cast<size_t>(2 * hidden_size),
+                     1.0f,
+                     out, static_cast<size_t>(hidden_size),
+                     nullptr);
+          }
+
+          // To be consistent with Huggingface Longformer, the rows of masked tokens are set to zero.
+          for (int64_t r = 0; r < rows; ++r) {
+            if (batch_mask[row_start + r] < 0) {
+              std::fill_n(out + r * hidden_size, head_size, T{0});
+            }
+          }
+        }
+      });
+
+  if (max_num_global == 0) {
+    return Status::OK();
+  }
+
+  // Global tokens attend to all the tokens with global Q, K and V. Their rows replace those of the local attention.
+  ThreadPool::TryParallelFor(
+      thread_pool, static_cast<std::ptrdiff_t>(batch_size * num_heads_),
+      static_cast<double>(max_num_global * sequence_length * head_size) * 4.0,
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        std::vector<T> query(static_cast<size_t>(max_num_global * head_size));
+        std::vector<T> scores(static_cast<size_t>(max_num_global * sequence_length));
+        std::vector<T> attention(static_cast<size_t>(max_num_global * head_size));
+
+        for (std::ptrdiff_t i = first; i != last; ++i) {
+          const int64_t head = i % num_heads_;
+          const int64_t b = i / num_heads_;
+          const int64_t num_global = global_count[b];
+          if (num_global == 0) {
+            continue;
+          }
+
+          const T* batch_global_qkv = global_qkv + b * sequence_length * qkv_size + head * head_size;
+          const int64_t* batch_global_index = global_index.data() + b * sequence_length;
+          const T* batch_mask = mask_data + b * sequence_length;
+
+          for (int64_t g = 0; g < num_global; ++g) {
+            std::copy_n(batch_global_qkv + batch_global_index[g] * qkv_size, head_size,
+                        query.data() + g * head_size);
+          }
+
+          MlasGemm(CblasNoTrans, CblasTrans,
+                   static_cast<size_t>(num_global), static_cast<size_t>(sequence_length),
+                   static_cast<size_t>(head_size),
+                   scale,
+                   query.data(), static_cast<size_t>(head_size),
+                   batch_global_qkv + hidden_size, static_cast<size_t>(qkv_size),
+                   0.0f,
+                   scores.data(), static_cast<size_t>(sequence_length),
+                   nullptr);
+
+          for (int64_t g = 0; g < num_global; ++g) {
+            T* row_scores = scores.data() + g * sequence_length;
+            for (int64_t j = 0; j < sequence_length; ++j) {
+              row_scores[j] += batch_mask[j];
+            }
+          }
+
+          MlasComputeSoftmax(scores.data(), scores.data(), static_cast<size_t>(num_global),
+                             static_cast<size_t>(sequence_length), false, nullptr);
+
+          MlasGemm(CblasNoTrans, CblasNoTrans,
+                   static_cast<size_t>(num_global), static_cast<size_t>(head_size),
+                   static_cast<size_t>(sequence_length),
+                   1.0f,
+                   scores.data(), static_cast<size_t>(sequence_length),
+                   batch_global_qkv + 2 * hidden_size, static_cast<size_t>(qkv_size),
+                   0.0f,
+                   attention.data(), static_cast<size_t>(head_size),
+                   nullptr);
+
+          for (int64_t g = 0; g < num_global; ++g) {
+            const int64_t row = batch_global_index[g];
+            T* out = output_data + (b * sequence_length + row) * hidden_size + head * head_size;
+            if (batch_mask[row] < 0) {
+              std::fill_n(out, head_size, T{0});
+            } else {
+              std::copy_n(attention.data() + g * head_size, head_size, out);
+            }
+          }
+        }
+      });
+
+  return Status::OK();
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
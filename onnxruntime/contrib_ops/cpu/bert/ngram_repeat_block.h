@@ -3,6 +3,9 @@
 
 #pragma once
 
+#include <algorithm>
+#include <limits>
+
 #include "core/common/common.h"
 #include "core/common/narrow.h"
 #include "core/common/safeint.h"
@@ -44,24 +47,15 @@ class NGramRepeatBlock : public OpKernel {
 
     const auto* input_ids_data = static_cast<const int64_t*>(input_ids->DataRaw(input_ids->DataType()));
 
+    // The last ngram_size - 1 tokens of a sequence are compared with each earlier run of as many tokens, and the
+    // token that followed a matching run is banned. std::equal compares the token ids of a run with memcmp.
+    const int64_t prefix_len = ngram_size_ - 1;
     auto lambda = [&](int64_t b) {
-      for (int64_t i = 0; i < cur_len; ++i) {
-        if (i + ngram_size_ > cur_len) {
-          break;
-        }
-
-        bool is_banned = true;
-        for (int64_t j = 0; j < ngram_size_ - 1; ++j) {
-          auto token_at_tail = input_ids_data[b * cur_len + i + j];
-          auto token_to_cmp = input_ids_data[b * cur_len + cur_len + 1 - ngram_size_ + j];
-          if (token_at_tail != token_to_cmp) {
-            is_banned = false;
-            break;
-          }
-        }
-
-        if (is_banned) {
-          auto token_id = static_cast<int64_t>(input_ids_data[b * cur_len + i + ngram_size_ - 1]);
+      const int64_t* ids = input_ids_data + b * cur_len;
+      const int64_t* tail = ids + cur_len - prefix_len;
+      for (int64_t i = 0; i + ngram_size_ <= cur_len; ++i) {
+        if (std::equal(tail, tail + prefix_len, ids + i)) {
+          auto token_id = ids[i + prefix_len];
           ORT_ENFORCE(token_id < vocab_size);
           scores_target[b * vocab_size + token_id] = -std::numeric_limits<float>::infinity();
         }
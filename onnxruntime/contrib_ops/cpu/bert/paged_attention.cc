@@ -0,0 +1,223 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "paged_attention.h"
+
+#include "core/common/common.h"
+#include "core/common/safeint.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
+#include "core/util/math.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+using onnxruntime::concurrency::ThreadPool;
+
+namespace onnxruntime {
+namespace contrib {
+
+// These ops are internal-only, so register outside of onnx
+ONNX_OPERATOR_TYPED_KERNEL_EX(
+    PagedAttention,
+    kMSDomain,
+    1,
+    float,
+    kCpuExecutionProvider,
+    KernelDefBuilder()
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>())
+        .TypeConstraint("M", DataTypeImpl::GetTensorType<int32_t>())
+        .MayInplace(3, 1)
+        .MayInplace(4, 2),
+    PagedAttention<float>);
+
+template <typename T>
+PagedAttention<T>::PagedAttention(const OpKernelInfo& info) : OpKernel(info) {
+  int64_t num_heads = 0;
+  int64_t kv_num_heads = 0;
+  ORT_ENFORCE(info.GetAttr("num_heads", &num_heads).IsOK() && num_heads > 0);
+  ORT_ENFORCE(info.GetAttr("kv_num_heads", &kv_num_heads).IsOK() && kv_num_heads > 0 &&
+              num_heads % kv_num_heads == 0);
+  num_heads_ = static_cast<int>(num_heads);
+  kv_num_heads_ = static_cast<int>(kv_num_heads);
+
+  scale_ = info.GetAttrOrDefault<float>("scale", 0.0f);
+}
+
+template <typename T>
+Status PagedAttention<T>::Compute(OpKernelContext* context) const {
+  const Tensor* query = context->Input<Tensor>(0);
+  const Tensor* key = context->Input<Tensor>(1);
+  const Tensor* value = context->Input<Tensor>(2);
+  const Tensor* key_cache = context->Input<Tensor>(3);
+  const Tensor* value_cache = context->Input<Tensor>(4);
+  const Tensor* block_tables = context->Input<Tensor>(5);
+  const Tensor* past_seqlens = context->Input<Tensor>(6);
+
+  //     query            (Q)       : (B, S, D)
+  //     key              (K)       : (B, S, D_kv)
+  //     value            (V)       : (B, S, D_kv)
+  //     key_cache                  : (num_blocks, N_kv, block_size, H)
+  //     value_cache                : (num_blocks, N_kv, block_size, H)
+  //     block_tables               : (B, max_blocks_per_sequence)
+  //     past_seqlens               : (B)
+  const auto& query_dims = query->Shape().GetDims();
+  const auto& cache_dims = key_cache->Shape().GetDims();
+  ORT_RETURN_IF_NOT(query_dims.size() == 3, "Input 'query' is expected to have 3 dimensions");
+  ORT_RETURN_IF_NOT(cache_dims.size() == 4 && key_cache->Shape() == value_cache->Shape(),
+                    "Input 'key_cache' and 'value_cache' are expected to have the same 4D shape");
+
+  const int batch_size = static_cast<int>(query_dims[0]);
+  const int sequence_length = static_cast<int>(query_dims[1]);
+  const int hidden_size = static_cast<int>(query_dims[2]);
+  ORT_RETURN_IF_NOT(hidden_size % num_heads_ == 0, "query hidden size is not divisible by num_heads");
+  const int head_size = hidden_size / num_heads_;
+  const int kv_hidden_size = head_size * kv_num_heads_;
+
+  const TensorShape kv_shape({batch_size, sequence_length, kv_hidden_size});
+  ORT_RETURN_IF_NOT(key->Shape() == kv_shape && value->Shape() == kv_shape,
+                    "Input 'key' and 'value' are expected to have shape ", kv_shape);
+
+  const int num_blocks = static_cast<int>(cache_dims[0]);
+  const int block_size = static_cast<int>(cache_dims[2]);
+  ORT_RETURN_IF_NOT(cache_dims[1] == kv_num_heads_ && cache_dims[3] == head_size && block_size > 0,
+                    "Input 'key_cache' is expected to have shape (num_blocks, ", kv_num_heads_,
+                    ", block_size, ", head_size, ")");
+
+  const auto& block_tables_dims = block_tables->Shape().GetDims();
+  ORT_RETURN_IF_NOT(block_tables_dims.size() == 2 && block_tables_dims[0] == batch_size,
+                    "Input 'block_tables' is expected to have shape (", batch_size, ", max_blocks_per_sequence)");
+  ORT_RETURN_IF_NOT(past_seqlens->Shape() == TensorShape({batch_size}),
+                    "Input 'past_seqlens' is expected to have shape (", batch_size, ")");
+  const int max_blocks_per_sequence = static_cast<int>(block_tables_dims[1]);
+
+  // Every block that is read or written has to be listed in the page table.
+  const int32_t* block_tables_data = block_tables->Data<int32_t>();
+  const int32_t* past_seqlens_data = past_seqlens->Data<int32_t>();
+  int max_total_sequence_length = 0;
+  for (int b = 0; b < batch_size; b++) {
+    const int past_length = past_seqlens_data[b];
+    const int total_length = past_length + sequence_length;
+    ORT_RETURN_IF_NOT(past_length >= 0 && total_length <= max_blocks_per_sequence * block_size,
+                      "past_seqlens[", b, "] = ", past_length, " plus sequence_length ", sequence_length,
+                      " exceeds the capacity of block_tables");
+    const int used_blocks = (total_length + block_size - 1) / block_size;
+    for (int j = 0; j < used_blocks; j++) {
+      const int32_t block = block_tables_data[b * max_blocks_per_sequence + j];
+      ORT_RETURN_IF_NOT(block >= 0 && block < num_blocks,
+                        "block_tables[", b, "][", j, "] = ", block, " is not a valid block");
+    }
+    max_total_sequence_length = std::max(max_total_sequence_length, total_length);
+  }
+
+  Tensor* output = context->Output(0, query->Shape());
+  Tensor* key_cache_out = context->Output(1, key_cache->Shape());
+  Tensor* value_cache_out = context->Output(2, value_cache->Shape());
+
+  T* key_cache_data = key_cache_out->MutableData<T>();
+  T* value_cache_data = value_cache_out->MutableData<T>();
+  if (key_cache_data != key_cache->Data<T>()) {
+    memcpy(key_cache_data, key_cache->Data<T>(), key_cache->SizeInBytes());
+  }
+  if (value_cache_data != value_cache->Data<T>()) {
+    memcpy(value_cache_data, value_cache->Data<T>(), value_cache->SizeInBytes());
+  }
+
+  // Offset of the first element of (block, kv head) in the cache. Each block holds block_size x H per kv head.
+  const size_t block_head_length = SafeInt<size_t>(block_size) * head_size;
+  auto block_offset = [&](int32_t block, int kv_head) {
+    return (static_cast<size_t>(block) * kv_num_heads_ + kv_head) * block_head_length;
+  };
+
+  ThreadPool* tp = context->GetOperatorThreadPool();
+  const T* key_data = key->Data<T>();
+  const T* value_data = value->Data<T>();
+
+  // Write the new key and value tokens to their slots.
+  const double copy_cost = static_cast<double>(sequence_length) * head_size * 2;
+  const ptrdiff_t kv_chunks = SafeInt<ptrdiff_t>(batch_size) * kv_num_heads_;
+  ThreadPool::TryParallelFor(tp, kv_chunks, copy_cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+    for (std::ptrdiff_t i = begin; i != end; ++i) {
+      const int batch_index = static_cast<int>(i) / kv_num_heads_;
+      const int kv_head_index = static_cast<int>(i) % kv_num_heads_;
+      const int32_t* block_table = block_tables_data + batch_index * max_blocks_per_sequence;
+      for (int s = 0; s < sequence_length; s++) {
+        const int position = past_seqlens_data[batch_index] + s;
+        const size_t cache_offset = block_offset(block_table[position / block_size], kv_head_index) +
+                                    static_cast<size_t>(position % block_size) * head_size;
+        const size_t input_offset = (SafeInt<size_t>(batch_index) * sequence_length + s) * kv_hidden_size +
+                                    static_cast<size_t>(kv_head_index) * head_size;
+        memcpy(key_cache_data + cache_offset, key_data + input_offset, head_size * sizeof(T));
+        memcpy(value_cache_data + cache_offset, value_data + input_offset, head_size * sizeof(T));
+      }
+    }
+  });
+
+  // Scratch for attention scores of each (batch, head): S x T_max.
+  AllocatorPtr allocator;
+  ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&allocator));
+  const size_t probs_chunk_length = SafeInt<size_t>(sequence_length) * max_total_sequence_length;
+  auto probs_buffer = IAllocator::MakeUniquePtr<T>(allocator,
+                                                   SafeInt<size_t>(batch_size) * num_heads_ * probs_chunk_length);
+  T* probs_data = probs_buffer.get();
+
+  const T* query_data = query->Data<T>();
+  T* output_data = output->MutableData<T>();
+  const int heads_per_kv_head = num_heads_ / kv_num_heads_;
+  const float alpha = scale_ == 0.0f ? 1.0f / std::sqrt(static_cast<float>(head_size)) : scale_;
+
+  const double cost = static_cast<double>(sequence_length) * max_total_sequence_length * head_size * 2;
+  const ptrdiff_t loop_len = SafeInt<ptrdiff_t>(batch_size) * num_heads_;
+  ThreadPool::TryParallelFor(tp, loop_len, cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+    for (std::ptrdiff_t i = begin; i != end; ++i) {
+      const int batch_index = static_cast<int>(i) / num_heads_;
+      const int head_index = static_cast<int>(i) % num_heads_;
+      const int kv_head_index = head_index / heads_per_kv_head;
+      const int past_length = past_seqlens_data[batch_index];
+      const int total_sequence_length = past_length + sequence_length;
+      const int used_blocks = (total_sequence_length + block_size - 1) / block_size;
+      const int32_t* block_table = block_tables_data + batch_index * max_blocks_per_sequence;
+
+      const size_t q_offset = SafeInt<size_t>(batch_index) * sequence_length * hidden_size +
+                              static_cast<size_t>(head_index) * head_size;
+      T* probs = probs_data + probs_chunk_length * i;
+
+      // Q: S x H with row stride N x H, K block: block_size x H -> probs columns of the block
+      for (int j = 0; j < used_blocks; j++) {
+        const int block_tokens = std::min(block_size, total_sequence_length - j * block_size);
+        math::GemmEx<T, ThreadPool>(CblasNoTrans, CblasTrans,
+                                    sequence_length, block_tokens, head_size, alpha,
+                                    query_data + q_offset, hidden_size,
+                                    key_cache_data + block_offset(block_table[j], kv_head_index), head_size, 0.0f,
+                                    probs + static_cast<size_t>(j) * block_size, max_total_sequence_length, nullptr);
+      }
+
+      // Causal softmax: token s attends to the past and to new tokens up to s.
+      for (int s = 0; s < sequence_length; s++) {
+        T* row = probs + static_cast<size_t>(s) * max_total_sequence_length;
+        const int valid_length = past_length + s + 1;
+        MlasComputeSoftmax(row, row, 1, valid_length, false, nullptr);
+        for (int t = valid_length; t < total_sequence_length; t++) {
+          row[t] = 0.0f;
+        }
+      }
+
+      // probs block: S x block_size, V block: block_size x H -> output: S x H with row stride N x H
+      for (int j = 0; j < used_blocks; j++) {
+        const int block_tokens = std::min(block_size, total_sequence_length - j * block_size);
+        math::GemmEx<T, ThreadPool>(CblasNoTrans, CblasNoTrans,
+                                    sequence_length, head_size, block_tokens, 1.0f,
+                                    probs + static_cast<size_t>(j) * block_size, max_total_sequence_length,
+                                    value_cache_data + block_offset(block_table[j], kv_head_index), head_size,
+                                    j == 0 ? 0.0f : 1.0f,
+                                    output_data + q_offset, hidden_size, nullptr);
+      }
+    }
+  });
+
+  return Status::OK();
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
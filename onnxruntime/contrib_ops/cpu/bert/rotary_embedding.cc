@@ -0,0 +1,104 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cpu/bert/rotary_embedding.h"
+#include "contrib_ops/cpu/bert/rotary_embedding_helper.h"
+
+#include "core/common/safeint.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
+
+using onnxruntime::concurrency::ThreadPool;
+using namespace onnxruntime::contrib::rotary_embedding_helper;
+
+namespace onnxruntime {
+namespace contrib {
+
+// These ops are internal-only, so register outside of onnx
+ONNX_OPERATOR_TYPED_KERNEL_EX(
+    RotaryEmbedding,
+    kMSDomain,
+    1,
+    float,
+    kCpuExecutionProvider,
+    KernelDefBuilder()
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>())
+        .TypeConstraint("M", DataTypeImpl::GetTensorType<int64_t>()),
+    RotaryEmbedding<float>);
+
+template <typename T>
+RotaryEmbedding<T>::RotaryEmbedding(const OpKernelInfo& info) : OpKernel(info) {
+  interleaved_ = (info.GetAttrOrDefault<int64_t>("interleaved", 0) == 1);
+}
+
+template <typename T>
+Status RotaryEmbedding<T>::Compute(OpKernelContext* context) const {
+  const Tensor* input = context->Input<Tensor>(0);
+  const Tensor* position_ids = context->Input<Tensor>(1);
+  const Tensor* cos_cache = context->Input<Tensor>(2);
+  const Tensor* sin_cache = context->Input<Tensor>(3);
+
+  RotaryParameters parameters = {};
+  ORT_RETURN_IF_ERROR(rotary_embedding_helper::CheckInputs<Tensor>(input,
+                                                                   position_ids,
+                                                                   cos_cache,
+                                                                   sin_cache,
+                                                                   &parameters));
+
+  Tensor* output = context->Output(0, input->Shape());
+
+  const int batch_size = parameters.batch_size;
+  const int sequence_length = parameters.sequence_length;
+  const int num_heads = parameters.num_heads;
+  const int head_size = parameters.head_size;
+  const int half_head_size = head_size / 2;
+  const int max_sequence_length = parameters.max_sequence_length;
+
+  // Resolve the position of every token up front so that invalid ids are reported instead of read out of bounds.
+  const int64_t* position_ids_data = position_ids->Data<int64_t>();
+  std::vector<int64_t> positions(SafeInt<size_t>(batch_size) * sequence_length);
+  for (int b = 0; b < batch_size; b++) {
+    for (int s = 0; s < sequence_length; s++) {
+      const size_t token = static_cast<size_t>(b) * sequence_length + s;
+      const int64_t position = parameters.position_ids_format == 0 ? position_ids_data[0] + s
+                                                                   : position_ids_data[token];
+      if (position < 0 || position >= max_sequence_length) {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "position id ", position,
+                               " is out of range of the cos/sin cache with ", max_sequence_length, " positions");
+      }
+      positions[token] = position;
+    }
+  }
+
+  const T* input_data = input->Data<T>();
+  const T* cos_cache_data = cos_cache->Data<T>();
+  const T* sin_cache_data = sin_cache->Data<T>();
+  T* output_data = output->MutableData<T>();
+
+  // Each unit of work is one head of one token.
+  const ptrdiff_t loop_len = SafeInt<ptrdiff_t>(batch_size) * sequence_length * num_heads;
+  const double cost = static_cast<double>(head_size) * 4;
+  ThreadPool::TryParallelFor(context->GetOperatorThreadPool(), loop_len, cost,
+                             [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+    for (std::ptrdiff_t i = begin; i != end; ++i) {
+      const int b = static_cast<int>(i / (static_cast<ptrdiff_t>(sequence_length) * num_heads));
+      const int s = static_cast<int>((i / num_heads) % sequence_length);
+      const int n = static_cast<int>(i % num_heads);
+
+      // BxSxNxH for 3D input, BxNxSxH for 4D input.
+      const size_t offset = parameters.transposed
+                                ? ((static_cast<size_t>(b) * num_heads + n) * sequence_length + s) * head_size
+                                : ((static_cast<size_t>(b) * sequence_length + s) * num_heads + n) * head_size;
+
+      const size_t cache_offset = static_cast<size_t>(positions[static_cast<size_t>(b) * sequence_length + s]) *
+                                  half_head_size;
+      MlasRotaryEmbedOneRow(input_data + offset, sin_cache_data + cache_offset, cos_cache_data + cache_offset,
+                            head_size, interleaved_, output_data + offset);
+    }
+  });
+
+  return Status::OK();
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,92 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/common.h"
+#include "core/providers/common.h"
+
+namespace onnxruntime {
+namespace contrib {
+namespace rotary_embedding_helper {
+
+// Parameters deduced from node attributes and inputs/outputs.
+struct RotaryParameters {
+  int batch_size;            // Batch size used by input
+  int sequence_length;       // Sequence length used by input
+  int hidden_size;           // Hidden size used by input
+  int head_size;             // Head size used by cos/sin cache * 2
+  int num_heads;             // num_heads = hidden_size / head_size
+  int max_sequence_length;   // Sequence length used by cos/sin cache
+  int position_ids_format;   // Format of position ids - 0 is (1), 1 is (batch_size, sequence_length)
+  bool transposed;           // Whether the input tensor has been transposed into (batch, num_heads, seq_len, hidden)
+};
+
+template <typename T>
+Status CheckInputs(const T* input,
+                   const T* position_ids,
+                   const T* cos_cache,
+                   const T* sin_cache,
+                   void* parameters) {
+  //    input        : (batch_size, sequence_length, hidden_size) or (batch_size, num_heads, sequence_length, head_size)
+  //    position ids : (1) or (batch_size, sequence_length)
+  //    cos cache    : (max_sequence_length, head_size / 2)
+  //    sin cache    : (max_sequence_length, head_size / 2)
+
+  const auto& input_dims = input->Shape().GetDims();
+  if (input_dims.size() != 3 && input_dims.size() != 4) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input 'input' is expected to have 3 or 4 dimensions, got ",
+                           input_dims.size());
+  }
+
+  const auto& cos_cache_dims = cos_cache->Shape().GetDims();
+  if (cos_cache_dims.size() != 2 || cos_cache->Shape() != sin_cache->Shape()) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "Input 'cos_cache' and 'sin_cache' are expected to have the same 2D shape");
+  }
+
+  const bool transposed = input_dims.size() == 4;
+  int batch_size = static_cast<int>(input_dims[0]);
+  int sequence_length = static_cast<int>(transposed ? input_dims[2] : input_dims[1]);
+  int max_sequence_length = static_cast<int>(cos_cache_dims[0]);
+  int head_size = static_cast<int>(cos_cache_dims[1]) * 2;
+  int hidden_size = static_cast<int>(transposed ? input_dims[1] * input_dims[3] : input_dims[2]);
+
+  if (head_size == 0 || hidden_size % head_size != 0 || (transposed && input_dims[3] != head_size)) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "Input 'input' head size does not match twice the last dimension of 'cos_cache', which is ",
+                           cos_cache_dims[1]);
+  }
+  int num_heads = hidden_size / head_size;
+
+  const auto& position_ids_dims = position_ids->Shape().GetDims();
+  int position_ids_format = -1;
+  if (position_ids_dims.size() == 1 && position_ids_dims[0] == 1) {
+    position_ids_format = 0;
+  } else if (position_ids_dims.size() == 2 && position_ids_dims[0] == batch_size &&
+             position_ids_dims[1] == sequence_length) {
+    position_ids_format = 1;
+  } else {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "Input 'position_ids' is expected to have shape (1) or (", batch_size, ", ",
+                           sequence_length, ")");
+  }
+
+  if (parameters != nullptr) {
+    RotaryParameters* output_parameters = reinterpret_cast<RotaryParameters*>(parameters);
+    output_parameters->batch_size = batch_size;
+    output_parameters->sequence_length = sequence_length;
+    output_parameters->hidden_size = hidden_size;
+    output_parameters->head_size = head_size;
+    output_parameters->num_heads = num_heads;
+    output_parameters->max_sequence_length = max_sequence_length;
+    output_parameters->position_ids_format = position_ids_format;
+    output_parameters->transposed = transposed;
+  }
+
+  return Status::OK();
+}
+
+}  // namespace rotary_embedding_helper
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -19,7 +19,8 @@ DEFINE_KERNEL(float);
 DEFINE_KERNEL(double);
 
 template <typename T>
-static void CalculateSqeuclidean(const Tensor& a, const Tensor& b, Tensor& c, concurrency::ThreadPool* threadpool) {
+static void CalculateSqeuclidean(const Tensor& a, const Tensor& b, Tensor& c, bool euclidean,
+                                 concurrency::ThreadPool* threadpool) {
   // input shapes have already been validated
   const auto& shape_a = a.Shape().GetDims();  // {m, k}
   const auto& shape_b = b.Shape().GetDims();  // {n, k}
@@ -34,60 +35,53 @@ static void CalculateSqeuclidean(const Tensor& a, const Tensor& b, Tensor& c, co
   const auto* b_data = b.Data<T>();
   auto* c_data = c.MutableData<T>();
 
-  // ReduceSumSquare for A
-  std::vector<T> a_ss;
-  a_ss.resize(narrow<size_t>(m));
-  const auto* cur_a = a_data;
-  for (int64_t i = 0; i < m; ++i) {
-    a_ss[narrow<size_t>(i)] = ConstEigenVectorMap<T>(cur_a, narrow<size_t>(k)).squaredNorm();
-    cur_a += k;
-  }
-
-  // ReduceSumSquare for B
-  std::vector<T> b_ss;
-  b_ss.resize(narrow<size_t>(n));
-  const auto* cur_b = b_data;
-  for (int64_t i = 0; i < n; ++i) {
-    b_ss[narrow<size_t>(i)] = ConstEigenVectorMap<T>(cur_b, narrow<size_t>(k)).squaredNorm();
-    cur_b += k;
-  }
+  // ReduceSumSquare for A and B, one row of either per unit of work
+  std::vector<T> a_ss(narrow<size_t>(m));
+  std::vector<T> b_ss(narrow<size_t>(n));
+  const double row_bytes = static_cast<double>(k * sizeof(T));
+  concurrency::ThreadPool::TryParallelFor(
+      threadpool, narrow<std::ptrdiff_t>(m + n), TensorOpCost{row_bytes, static_cast<double>(sizeof(T)), 2.0 * k},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (auto i = static_cast<int64_t>(first), end = static_cast<int64_t>(last); i < end; ++i) {
+          if (i < m) {
+            a_ss[narrow<size_t>(i)] = ConstEigenVectorMap<T>(a_data + i * k, narrow<size_t>(k)).squaredNorm();
+          } else {
+            b_ss[narrow<size_t>(i - m)] = ConstEigenVectorMap<T>(b_data + (i - m) * k, narrow<size_t>(k)).squaredNorm();
+          }
+        }
+      });
 
   // NOTE: We want to avoid subtracting two numbers that are very close to each other as that can lead to
   // 'catastrophic cancellation'. (sum_k(Xik**2) + sum_k(Yjk**2)) would be close to 2*sum_k(Xik*Yjk) if the values
   // in Xij and Yjk are very similar, so subtracting can be problematic.
   // Due to that we calculate -2*sum_k(Xik*Yjk) using GEMM, add sum_k(Xik**2) next, and add sum_k(Yjk**2) last.
 
-// use MLAS on 64-bit (no 32-bit dgemm)
-#if defined(_M_AMD64) || defined(__x86_64__)
-  // Use GEMM of A and B^T with -2 as alpha to calculate -2*sum_k(Xik*Yjk)
+  // Use GEMM of A and B^T with -2 as alpha to calculate -2*sum_k(Xik*Yjk).
+  // This uses MLAS, other than for double on platforms where MLAS has no dgemm and Eigen is used instead.
   math::Gemm<T>(CBLAS_TRANSPOSE::CblasNoTrans, CBLAS_TRANSPOSE::CblasTrans,
                 m, n, k,
                 static_cast<T>(-2.), a_data, b_data, static_cast<T>(0.),
                 c_data,
                 threadpool);
-#else
-  // the performance of this isn't great as the eigen matmul is single threaded by default
-  // if you're on x86 and care about performance try MKL first. if there's a good enough argument for optimising this
-  // we can look into it in the future.
-  ORT_UNUSED_PARAMETER(threadpool);
-
-  // https://eigen.tuxfamily.org/dox/TopicWritingEfficientProductExpression.html
-  auto out_map = EigenMatrixMapRowMajor<T>(c_data, SafeInt<size_t>(m), SafeInt<size_t>(n));
-  out_map.noalias() = static_cast<T>(-2.) *
-                      (ConstEigenMatrixMapRowMajor<T>(a_data, SafeInt<size_t>(m), SafeInt<size_t>(k)) *
-                       ConstEigenMatrixMapRowMajor<T>(b_data, SafeInt<size_t>(n), SafeInt<size_t>(k)).transpose());
-#endif
 
-  // add a_ss and b_ss, with broadcast
+  // add a_ss and b_ss, with broadcast, in the same pass as the final abs and sqrt
   // output shape is {m, n}
-  auto* cur_out = c_data;
-  for (int64_t i = 0; i < m; ++i) {
-    T a_val = a_ss[narrow<size_t>(i)];
-    for (int64_t j = 0; j < n; ++j) {
-      *cur_out = (*cur_out + a_val) + b_ss[narrow<size_t>(j)];
-      ++cur_out;
-    }
-  }
+  // because we use GEMM there's a slight chance a number extremely close to zero could be negative, so we need to
+  // run abs() to avoid NaN's in the results.
+  const auto b_ss_map = ConstEigenVectorArrayMap<T>(b_ss.data(), narrow<size_t>(n));
+  concurrency::ThreadPool::TryParallelFor(
+      threadpool, narrow<std::ptrdiff_t>(m),
+      TensorOpCost{static_cast<double>(n * sizeof(T)) * 2, static_cast<double>(n * sizeof(T)), 4.0 * n},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (auto i = static_cast<int64_t>(first), end = static_cast<int64_t>(last); i < end; ++i) {
+          auto out_row = EigenVectorArrayMap<T>(c_data + i * n, narrow<size_t>(n));
+          if (euclidean) {
+            out_row = ((out_row + a_ss[narrow<size_t>(i)]) + b_ss_map).abs().sqrt();
+          } else {
+            out_row = ((out_row + a_ss[narrow<size_t>(i)]) + b_ss_map).abs();
+          }
+        }
+      });
 }
 
 template <typename T>
@@ -112,18 +106,8 @@ common::Status CDist<T>::Compute(OpKernelContext* context) const {
 
   TensorShape output_shape = {shape_a[0], shape_b[0]};
   Tensor* C = context->Output(0, output_shape);
-  T* output = C->MutableData<T>();
-
-  CalculateSqeuclidean<T>(*A, *B, *C, tp);
-  auto map_out = EigenVectorArrayMap<T>(output, narrow<size_t>(output_shape.Size()));
 
-  // because we use GEMM in CalculateSqeuclidean there's a slight chance a number extremely close to zero
-  // could be negative, so we need to run abs() to avoid NaN's in the results.
-  if (mode_ == Mode::EUCLIDEAN) {
-    map_out = map_out.abs().sqrt();  // do both abs and sqrt in one call so Eigen has a chance to combine
-  } else if (mode_ == Mode::SQEUCLIDEAN) {
-    map_out = map_out.abs();
-  }
+  CalculateSqeuclidean<T>(*A, *B, *C, mode_ == Mode::EUCLIDEAN, tp);
 
   return Status::OK();
 }
@@ -0,0 +1,80 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cpu/diffusion/bias_add.h"
+
+#include "core/platform/threadpool.h"
+
+using onnxruntime::concurrency::ThreadPool;
+
+namespace onnxruntime {
+namespace contrib {
+
+ONNX_OPERATOR_TYPED_KERNEL_EX(
+    BiasAdd,
+    kMSDomain,
+    1,
+    float,
+    kCpuExecutionProvider,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    BiasAdd);
+
+Status BiasAdd::Compute(OpKernelContext* context) const {
+  // Input:  [batch_size, height*width, channels]
+  // Bias:   [channels]
+  // Skip:   [batch_size, height*width, channels]
+  // Output: [batch_size, height*width, channels]
+
+  const Tensor* input = context->Input<Tensor>(0);
+
+  const auto& input_dims = input->Shape().GetDims();
+  if (input_dims.size() != 3) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "The input is expected to have 3 dimensions, got ", input_dims.size());
+  }
+
+  const Tensor* bias = context->Input<Tensor>(1);
+  const auto& bias_dims = bias->Shape().GetDims();
+  if (bias_dims.size() != 1) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "The bias is expected to have 1 dimensions, got ", bias_dims.size());
+  }
+  if (bias_dims[0] != input_dims[2]) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "Number of channels in the last dimension of input and bias are not the same");
+  }
+
+  const Tensor* skip = context->Input<Tensor>(2);
+  if (skip->Shape() != input->Shape()) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "Shape of input and skip (residual) shall be the same");
+  }
+
+  Tensor* output = context->Output(0, input->Shape());
+
+  const int64_t row_count = input_dims[0] * input_dims[1];
+  const int64_t num_channels = input_dims[2];
+  const float* input_data = input->Data<float>();
+  const float* bias_data = bias->Data<float>();
+  const float* skip_data = skip->Data<float>();
+  float* output_data = output->MutableData<float>();
+
+  ThreadPool::TryParallelFor(
+      context->GetOperatorThreadPool(), static_cast<std::ptrdiff_t>(row_count),
+      static_cast<double>(num_channels) * 2.0,
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t i = first; i != last; ++i) {
+          const float* x = input_data + i * num_channels;
+          const float* s = skip_data + i * num_channels;
+          float* y = output_data + i * num_channels;
+          for (int64_t c = 0; c < num_channels; ++c) {
+            y[c] = x[c] + bias_data[c] + s[c];
+          }
+        }
+      });
+
+  return Status::OK();
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
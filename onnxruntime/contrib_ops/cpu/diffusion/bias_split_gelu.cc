@@ -0,0 +1,92 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cpu/diffusion/bias_split_gelu.h"
+
+#include <vector>
+
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
+
+using onnxruntime::concurrency::ThreadPool;
+
+namespace onnxruntime {
+namespace contrib {
+
+ONNX_OPERATOR_TYPED_KERNEL_EX(
+    BiasSplitGelu,
+    kMSDomain,
+    1,
+    float,
+    kCpuExecutionProvider,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    BiasSplitGelu);
+
+static constexpr float kSqrtHalf = 0.7071067811865476f;  // sqrt(0.5)
+
+Status BiasSplitGelu::Compute(OpKernelContext* context) const {
+  const Tensor* input = context->Input<Tensor>(0);
+
+  const auto& input_dims = input->Shape().GetDims();
+  if (input_dims.size() != 3) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "input is expected to have 3 dimensions, got ", input_dims.size());
+  }
+
+  if (input_dims[2] % 2 != 0) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "hidden size should be even, got ", input_dims[2]);
+  }
+
+  const Tensor* bias = context->Input<Tensor>(1);
+  const auto& bias_dims = bias->Shape().GetDims();
+  if (bias_dims.size() != 1) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "bias is expected to have 1 dimensions, got ", bias_dims.size());
+  }
+  if (bias_dims[0] != input_dims[2]) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "last dimension of input and bias are not the same");
+  }
+
+  TensorShapeVector output_shape = input->Shape().AsShapeVector();
+  output_shape[2] = input_dims[2] / 2;
+  Tensor* output = context->Output(0, output_shape);
+
+  const int64_t row_count = input_dims[0] * input_dims[1];
+  const int64_t half_hidden_size = input_dims[2] / 2;
+  const float* input_data = input->Data<float>();
+  const float* bias_data = bias->Data<float>();
+  float* output_data = output->MutableData<float>();
+
+  ThreadPool::TryParallelFor(
+      context->GetOperatorThreadPool(), static_cast<std::ptrdiff_t>(row_count),
+      static_cast<double>(half_hidden_size) * 16.0,
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        std::vector<float> gelu(static_cast<size_t>(half_hidden_size));
+
+        for (std::ptrdiff_t i = first; i != last; ++i) {
+          const float* left = input_data + i * 2 * half_hidden_size;
+          const float* right = left + half_hidden_size;
+          const float* right_bias = bias_data + half_hidden_size;
+          float* y = output_data + i * half_hidden_size;
+
+          // y = (left + bias) * gelu(right + bias), where gelu(x) = 0.5 * x * (1 + erf(x / sqrt(2)))
+          for (int64_t j = 0; j < half_hidden_size; ++j) {
+            gelu[j] = (right[j] + right_bias[j]) * kSqrtHalf;
+          }
+
+          MlasComputeErf(gelu.data(), y, static_cast<size_t>(half_hidden_size));
+
+          for (int64_t j = 0; j < half_hidden_size; ++j) {
+            const float value = right[j] + right_bias[j];
+            y[j] = (left[j] + bias_data[j]) * (0.5f * value * (y[j] + 1.0f));
+          }
+        }
+      });
+
+  return Status::OK();
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
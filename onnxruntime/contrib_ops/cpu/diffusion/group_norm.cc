@@ -0,0 +1,164 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cpu/diffusion/group_norm.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "core/common/safeint.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
+
+using onnxruntime::concurrency::ThreadPool;
+
+namespace onnxruntime {
+namespace contrib {
+
+ONNX_OPERATOR_KERNEL_EX(
+    GroupNorm,
+    kMSDomain,
+    1,
+    kCpuExecutionProvider,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    GroupNorm);
+
+GroupNorm::GroupNorm(const OpKernelInfo& op_info) : OpKernel(op_info) {
+  epsilon_ = op_info.GetAttrOrDefault<float>("epsilon", 1e-5f);
+  ORT_ENFORCE(epsilon_ >= 0);
+
+  ORT_ENFORCE(op_info.GetAttr("groups", &num_groups_).IsOK());
+  ORT_ENFORCE(num_groups_ > 0);
+
+  int64_t activation;
+  ORT_ENFORCE(op_info.GetAttr("activation", &activation).IsOK());
+  ORT_ENFORCE(activation == 0 || activation == 1);  // 0 is None, 1 is Swish
+  use_swish_activation_ = (activation == 1);
+}
+
+Status GroupNorm::Compute(OpKernelContext* context) const {
+  const Tensor* input = context->Input<Tensor>(0);
+  const Tensor* gamma = context->Input<Tensor>(1);
+  const Tensor* beta = context->Input<Tensor>(2);
+
+  const auto& input_dims = input->Shape().GetDims();
+  if (input_dims.size() != 4) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "input is expected to have 4 dimensions, got ", input_dims.size());
+  }
+
+  const auto& gamma_dims = gamma->Shape().GetDims();
+  if (gamma_dims.size() != 1 || gamma_dims[0] != input_dims[3]) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "gamma is expected to have shape (C), got ", gamma->Shape());
+  }
+
+  const auto& beta_dims = beta->Shape().GetDims();
+  if (beta_dims.size() != 1 || beta_dims[0] != input_dims[3]) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "beta is expected to have shape (C), got ", beta->Shape());
+  }
+
+  // Input and output format is NHWC
+  const int64_t batch_size = input_dims[0];
+  const int64_t image_size = input_dims[1] * input_dims[2];
+  const int64_t num_channels = input_dims[3];
+  if (num_channels % num_groups_ != 0) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "number of channels should be divisible by num_groups");
+  }
+
+  Tensor* output = context->Output(0, input->Shape());
+  if (input->Shape().Size() == 0) {
+    return Status::OK();
+  }
+
+  const int64_t channels_per_group = num_channels / num_groups_;
+  const float* input_data = input->Data<float>();
+  const float* gamma_data = gamma->Data<float>();
+  const float* beta_data = beta->Data<float>();
+  float* output_data = output->MutableData<float>();
+
+  // The statistics of each group are folded with gamma and beta into a scale and a bias per image and channel, so
+  // that normalizing is a single multiply-add over each contiguous row of C channels.
+  AllocatorPtr alloc;
+  ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&alloc));
+  const size_t coefficient_count = SafeInt<size_t>(batch_size) * num_channels;
+  auto coefficients = IAllocator::MakeUniquePtr<float>(alloc, coefficient_count * 2);
+  float* channel_scale = coefficients.get();
+  float* channel_bias = channel_scale + coefficient_count;
+
+  concurrency::ThreadPool* thread_pool = context->GetOperatorThreadPool();
+
+  ThreadPool::TryParallelFor(
+      thread_pool, static_cast<std::ptrdiff_t>(batch_size * num_groups_),
+      static_cast<double>(image_size * channels_per_group) * 3.0,
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        // The sums are kept per channel so that the inner loop runs over contiguous channels and vectorizes.
+        std::vector<float> sum(static_cast<size_t>(channels_per_group));
+        std::vector<float> sum_square(static_cast<size_t>(channels_per_group));
+
+        for (std::ptrdiff_t i = first; i != last; ++i) {
+          const int64_t n = i / num_groups_;
+          const int64_t channel_start = (i % num_groups_) * channels_per_group;
+
+          std::fill(sum.begin(), sum.end(), 0.0f);
+          std::fill(sum_square.begin(), sum_square.end(), 0.0f);
+          const float* x = input_data + n * image_size * num_channels + channel_start;
+          for (int64_t s = 0; s < image_size; ++s, x += num_channels) {
+            for (int64_t c = 0; c < channels_per_group; ++c) {
+              sum[c] += x[c];
+              sum_square[c] += x[c] * x[c];
+            }
+          }
+
+          double total = 0.0;
+          double total_square = 0.0;
+          for (int64_t c = 0; c < channels_per_group; ++c) {
+            total += sum[c];
+            total_square += sum_square[c];
+          }
+          const double count = static_cast<double>(image_size * channels_per_group);
+          const double mean = total / count;
+          const double variance = std::max(total_square / count - mean * mean, 0.0);
+          const float inv_std_dev = static_cast<float>(1.0 / std::sqrt(variance + epsilon_));
+
+          for (int64_t c = channel_start; c < channel_start + channels_per_group; ++c) {
+            const float scale = gamma_data[c] * inv_std_dev;
+            channel_scale[n * num_channels + c] = scale;
+            channel_bias[n * num_channels + c] = beta_data[c] - static_cast<float>(mean) * scale;
+          }
+        }
+      });
+
+  ThreadPool::TryParallelFor(
+      thread_pool, static_cast<std::ptrdiff_t>(batch_size * image_size),
+      static_cast<double>(num_channels) * (use_swish_activation_ ? 8.0 : 2.0),
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        std::vector<float> sigmoid(use_swish_activation_ ? static_cast<size_t>(num_channels) : 0);
+
+        for (std::ptrdiff_t i = first; i != last; ++i) {
+          const int64_t n = i / image_size;
+          const float* scale = channel_scale + n * num_channels;
+          const float* bias = channel_bias + n * num_channels;
+          const float* x = input_data + i * num_channels;
+          float* y = output_data + i * num_channels;
+          for (int64_t c = 0; c < num_channels; ++c) {
+            y[c] = x[c] * scale[c] + bias[c];
+          }
+
+          if (use_swish_activation_) {
+            MlasComputeLogistic(y, sigmoid.data(), static_cast<size_t>(num_channels));
+            for (int64_t c = 0; c < num_channels; ++c) {
+              y[c] *= sigmoid[c];
+            }
+          }
+        }
+      });
+
+  return Status::OK();
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,24 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/common.h"
+#include "core/framework/op_kernel.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+class GroupNorm final : public OpKernel {
+ public:
+  GroupNorm(const OpKernelInfo& op_kernel_info);
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  bool use_swish_activation_;
+  float epsilon_;
+  int64_t num_groups_;
+};
+
+}  // namespace contrib
+}  // namespace onnxruntime
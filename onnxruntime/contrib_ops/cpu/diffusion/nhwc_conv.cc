@@ -0,0 +1,176 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cpu/diffusion/nhwc_conv.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
+#include "core/util/math.h"
+
+using onnxruntime::concurrency::ThreadPool;
+
+namespace onnxruntime {
+namespace contrib {
+
+ONNX_OPERATOR_TYPED_KERNEL_EX(
+    NhwcConv,
+    kMSDomain,
+    1,
+    float,
+    kCpuExecutionProvider,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    NhwcConv);
+
+// Number of output pixels computed by each task. The im2col buffer of a tile stays small enough to remain in cache
+// while the filter of a group is streamed through the GEMM.
+static constexpr int64_t kOutputTileSize = 64;
+
+Status NhwcConv::Compute(OpKernelContext* context) const {
+  const Tensor* X = context->Input<Tensor>(0);
+  const Tensor* W = context->Input<Tensor>(1);
+  const Tensor* B = context->Input<Tensor>(2);  // optional. nullptr if not provided
+  const auto& X_shape = X->Shape();
+  const auto& W_shape = W->Shape();
+
+  if (X_shape.NumDimensions() != 4 || W_shape.NumDimensions() != 4) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "Number of dimensions of X and W should be 4 for channels_last format (NHWC)");
+  }
+  ORT_RETURN_IF_ERROR(conv_attrs_.ValidateInputShape(X_shape, W_shape, true, true));
+
+  TensorShapeVector kernel_shape;
+  ORT_RETURN_IF_ERROR(conv_attrs_.ComputeKernelShape(W_shape, kernel_shape, true));
+
+  ConvAttributes::ConvPadVector pads(conv_attrs_.pads);
+  if (pads.empty()) {
+    pads.resize(kernel_shape.size() * 2, 0);
+  }
+  TensorShapeVector dilations(conv_attrs_.dilations);
+  if (dilations.empty()) {
+    dilations.resize(kernel_shape.size(), 1);
+  }
+  TensorShapeVector strides(conv_attrs_.strides);
+  if (strides.empty()) {
+    strides.resize(kernel_shape.size(), 1);
+  }
+
+  const int64_t N = X_shape[0];
+  const int64_t input_h = X_shape[1];
+  const int64_t input_w = X_shape[2];
+  const int64_t C = X_shape[3];
+  const int64_t M = W_shape[0];
+
+  TensorShapeVector Y_dims({N});
+  ORT_RETURN_IF_ERROR(conv_attrs_.InferPadsAndOutputShape(X_shape.Slice(1, 3), kernel_shape, strides, dilations,
+                                                          pads, Y_dims));
+  Y_dims.push_back(M);
+  Tensor* Y = context->Output(0, Y_dims);
+  if (Y->Shape().Size() == 0) {
+    return Status::OK();
+  }
+
+  if (B != nullptr && (B->Shape().NumDimensions() != 1 || B->Shape()[0] != M)) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "B is expected to have shape (M), got ", B->Shape());
+  }
+
+  const int64_t group_count = conv_attrs_.group;
+  const int64_t group_input_channels = C / group_count;
+  const int64_t group_output_channels = M / group_count;
+  const int64_t output_w = Y_dims[2];
+  const int64_t input_image_size = input_h * input_w;
+  const int64_t output_image_size = Y_dims[1] * output_w;
+  const int64_t kernel_dim = kernel_shape[0] * kernel_shape[1] * group_input_channels;
+
+  // A 1x1 filter with unit strides and no padding reads the input pixels in place, as the rows of the GEMM.
+  const bool is_pointwise = kernel_shape[0] == 1 && kernel_shape[1] == 1 &&
+                            strides[0] == 1 && strides[1] == 1 &&
+                            std::all_of(pads.begin(), pads.end(), [](int64_t v) { return v == 0; });
+
+  const float* Xdata = X->Data<float>();
+  const float* Wdata = W->Data<float>();
+  const float* Bdata = B != nullptr ? B->Data<float>() : nullptr;
+  float* Ydata = Y->MutableData<float>();
+
+  // The filter is (M x kH x kW x C/group), so each group is a (group_output_channels x kernel_dim) matrix whose rows
+  // are in the order of the NHWC im2col columns, and the output of a tile of pixels is col * filter^T.
+  const int64_t tiles_per_image = (output_image_size + kOutputTileSize - 1) / kOutputTileSize;
+  ThreadPool::TryParallelFor(
+      context->GetOperatorThreadPool(), static_cast<std::ptrdiff_t>(N * tiles_per_image),
+      static_cast<double>(kOutputTileSize) * M * kernel_dim * 2.0,
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        std::vector<float> col_buffer;
+        if (!is_pointwise) {
+          col_buffer.resize(static_cast<size_t>(kOutputTileSize * kernel_dim));
+        }
+
+        for (std::ptrdiff_t i = first; i != last; ++i) {
+          const int64_t image_id = i / tiles_per_image;
+          const int64_t output_start = (i % tiles_per_image) * kOutputTileSize;
+          const int64_t output_count = std::min(kOutputTileSize, output_image_size - output_start);
+          const float* input_image = Xdata + image_id * input_image_size * C;
+          float* output_tile = Ydata + (image_id * output_image_size + output_start) * M;
+
+          // The bias is broadcast to the output rows and accumulated into by the GEMMs.
+          float beta = 0.0f;
+          if (Bdata != nullptr) {
+            for (int64_t p = 0; p < output_count; ++p) {
+              std::copy_n(Bdata, M, output_tile + p * M);
+            }
+            beta = 1.0f;
+          }
+
+          for (int64_t group_id = 0; group_id < group_count; ++group_id) {
+            const float* col_data;
+            size_t lda;
+            if (is_pointwise) {
+              col_data = input_image + output_start * C + group_id * group_input_channels;
+              lda = static_cast<size_t>(C);
+            } else {
+              math::Im2col<float, StorageOrder::NHWC>()(
+                  input_image + group_id * group_input_channels,
+                  group_input_channels,
+                  C,
+                  input_h,
+                  input_w,
+                  kernel_shape[0],
+                  kernel_shape[1],
+                  dilations[0],
+                  dilations[1],
+                  pads[0],
+                  pads[1],
+                  strides[0],
+                  strides[1],
+                  output_w,
+                  output_start,
+                  output_count,
+                  col_buffer.data());
+              col_data = col_buffer.data();
+              lda = static_cast<size_t>(kernel_dim);
+            }
+
+            MlasGemm(CblasNoTrans,
+                     CblasTrans,
+                     static_cast<size_t>(output_count),
+                     static_cast<size_t>(group_output_channels),
+                     static_cast<size_t>(kernel_dim),
+                     1.0f,
+                     col_data,
+                     lda,
+                     Wdata + group_id * group_output_channels * kernel_dim,
+                     static_cast<size_t>(kernel_dim),
+                     beta,
+                     output_tile + group_id * group_output_channels,
+                     static_cast<size_t>(M),
+                     nullptr);
+          }
+        }
+      });
+
+  return Status::OK();
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
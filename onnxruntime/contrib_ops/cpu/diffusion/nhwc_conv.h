@@ -0,0 +1,25 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/common.h"
+#include "core/framework/op_kernel.h"
+#include "core/providers/cpu/nn/conv_attributes.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+// Convolution of a (N x H x W x C) input with a (M x kH x kW x C/group) filter, producing a (N x oH x oW x M) output.
+// This is the filter layout that the transformers optimizer writes when it converts Conv to NhwcConv.
+class NhwcConv final : public OpKernel {
+ public:
+  NhwcConv(const OpKernelInfo& info) : OpKernel(info), conv_attrs_(info) {}
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  ConvAttributes conv_attrs_;
+};
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,175 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cpu/embedding_bag.h"
+
+#include <algorithm>
+
+#include "core/common/safeint.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
+
+using onnxruntime::concurrency::ThreadPool;
+using namespace onnxruntime::contrib::embedding_bag_helper;
+
+namespace onnxruntime {
+namespace contrib {
+
+ONNX_OPERATOR_KERNEL_EX(
+    EmbeddingBag,
+    kMSDomain,
+    1,
+    kCpuExecutionProvider,
+    KernelDefBuilder()
+        .TypeConstraint("T1", {DataTypeImpl::GetTensorType<float>(),
+                               DataTypeImpl::GetTensorType<MLFloat16>(),
+                               DataTypeImpl::GetTensorType<int8_t>()})
+        .TypeConstraint("Tind", {DataTypeImpl::GetTensorType<int32_t>(),
+                                 DataTypeImpl::GetTensorType<int64_t>()}),
+    EmbeddingBag);
+
+namespace {
+
+// Number of lookups ahead of the current one whose table rows are prefetched. The rows of a bag are
+// scattered over the table, so without a prefetch every row is a cache miss the hardware cannot predict.
+constexpr int64_t kPrefetchDistance = 8;
+
+inline void PrefetchRow(const void* row, size_t row_bytes) {
+#if defined(__GNUC__)
+  const char* p = static_cast<const char*>(row);
+  for (size_t offset = 0; offset < row_bytes; offset += 64) {
+    __builtin_prefetch(p + offset);
+  }
+#else
+  ORT_UNUSED_PARAMETER(row);
+  ORT_UNUSED_PARAMETER(row_bytes);
+#endif
+}
+
+}  // namespace
+
+EmbeddingBag::EmbeddingBag(const OpKernelInfo& info) : OpKernel(info) {
+  mode_ = ParseMode(info.GetAttrOrDefault<std::string>("mode", "sum"));
+}
+
+Status EmbeddingBag::Compute(OpKernelContext* context) const {
+  const Tensor* indices = context->Input<Tensor>(1);
+  if (indices->IsDataType<int32_t>()) {
+    return ComputeImpl<int32_t>(context);
+  }
+  return ComputeImpl<int64_t>(context);
+}
+
+template <typename TIndex>
+Status EmbeddingBag::ComputeImpl(OpKernelContext* context) const {
+  const Tensor* weight = context->Input<Tensor>(0);
+  const Tensor* indices = context->Input<Tensor>(1);
+  const Tensor* offsets = context->Input<Tensor>(2);
+  const Tensor* per_sample_weights = context->Input<Tensor>(3);
+  const Tensor* scales = context->Input<Tensor>(4);
+
+  EmbeddingBagParameters parameters = {};
+  ORT_RETURN_IF_ERROR(CheckInputs<TIndex>(weight, indices, offsets, per_sample_weights, scales, mode_ == Mode::kSum,
+                                          parameters));
+  const int64_t num_embeddings = parameters.num_embeddings;
+  const int64_t dim = parameters.dim;
+  const int64_t num_indices = parameters.num_indices;
+  const int64_t num_bags = parameters.num_bags;
+  const auto& bag_starts = parameters.bag_starts;
+  const TIndex* indices_data = indices->Data<TIndex>();
+
+  Tensor* output = context->Output(0, {num_bags, dim});
+  float* output_data = output->MutableData<float>();
+  if (output->Shape().Size() == 0) {
+    return Status::OK();
+  }
+
+  const float* per_sample_weights_data = per_sample_weights ? per_sample_weights->Data<float>() : nullptr;
+  const float* scales_data = scales ? scales->Data<float>() : nullptr;
+  const auto* weight_bytes = static_cast<const uint8_t*>(weight->DataRaw());
+  const size_t row_bytes = SafeInt<size_t>(dim) * weight->DataType()->Size();
+  const bool is_float = weight->IsDataType<float>();
+  const bool is_half = weight->IsDataType<MLFloat16>();
+  const Mode mode = mode_;
+
+  auto row_index = [&](int64_t i) {
+    return RowOfIndex(static_cast<int64_t>(indices_data[i]), num_embeddings);
+  };
+
+  const double cost = static_cast<double>(num_indices) / static_cast<double>(std::max<int64_t>(num_bags, 1)) *
+                      static_cast<double>(dim) * 2.0;
+  ThreadPool::TryParallelFor(
+      context->GetOperatorThreadPool(), static_cast<std::ptrdiff_t>(num_bags), cost,
+      [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+        // Rows of a float16 or int8 table are converted to float here before they are reduced
+        std::vector<float> row_buffer(is_float ? 0 : static_cast<size_t>(dim));
+
+        for (std::ptrdiff_t b = begin; b != end; ++b) {
+          float* out = output_data + b * dim;
+          const int64_t bag_begin = bag_starts[b];
+          const int64_t bag_end = bag_starts[b + 1];
+
+          for (int64_t i = bag_begin; i < std::min(bag_begin + kPrefetchDistance, bag_end); ++i) {
+            PrefetchRow(weight_bytes + row_index(i) * row_bytes, row_bytes);
+          }
+
+          for (int64_t i = bag_begin; i < bag_end; ++i) {
+            if (i + kPrefetchDistance < bag_end) {
+              PrefetchRow(weight_bytes + row_index(i + kPrefetchDistance) * row_bytes, row_bytes);
+            }
+
+            const int64_t row = row_index(i);
+            const float* row_data;
+            if (is_float) {
+              row_data = reinterpret_cast<const float*>(weight_bytes) + row * dim;
+            } else if (is_half) {
+              MlasConvertHalfToFloatBuffer(reinterpret_cast<const unsigned short*>(weight_bytes) + row * dim,
+                                           row_buffer.data(), static_cast<size_t>(dim));
+              row_data = row_buffer.data();
+            } else {
+              const int8_t* quantized = reinterpret_cast<const int8_t*>(weight_bytes) + row * dim;
+              const float scale = scales_data[row];
+              for (int64_t j = 0; j < dim; ++j) {
+                row_buffer[j] = scale * static_cast<float>(quantized[j]);
+              }
+              row_data = row_buffer.data();
+            }
+
+            if (i == bag_begin) {
+              const float w = per_sample_weights_data ? per_sample_weights_data[i] : 1.0f;
+              for (int64_t j = 0; j < dim; ++j) {
+                out[j] = w * row_data[j];
+              }
+            } else if (mode == Mode::kMax) {
+              for (int64_t j = 0; j < dim; ++j) {
+                out[j] = std::max(out[j], row_data[j]);
+              }
+            } else if (per_sample_weights_data != nullptr) {
+              const float w = per_sample_weights_data[i];
+              for (int64_t j = 0; j < dim; ++j) {
+                out[j] += w * row_data[j];
+              }
+            } else {
+              for (int64_t j = 0; j < dim; ++j) {
+                out[j] += row_data[j];
+              }
+            }
+          }
+
+          // An empty bag produces zeros in every mode
+          if (bag_begin == bag_end) {
+            std::fill_n(out, dim, 0.0f);
+          } else if (mode == Mode::kMean) {
+            const float inv_count = 1.0f / static_cast<float>(bag_end - bag_begin);
+            for (int64_t j = 0; j < dim; ++j) {
+              out[j] *= inv_count;
+            }
+          }
+        }
+      });
+
+  return Status::OK();
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
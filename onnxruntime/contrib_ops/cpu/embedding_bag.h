@@ -0,0 +1,26 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/common.h"
+#include "core/framework/op_kernel.h"
+#include "contrib_ops/cpu/embedding_bag_helper.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+class EmbeddingBag final : public OpKernel {
+ public:
+  EmbeddingBag(const OpKernelInfo& info);
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  template <typename TIndex>
+  Status ComputeImpl(OpKernelContext* context) const;
+
+  embedding_bag_helper::Mode mode_;
+};
+
+}  // namespace contrib
+}  // namespace onnxruntime
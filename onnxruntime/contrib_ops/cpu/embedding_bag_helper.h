@@ -0,0 +1,117 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/safeint.h"
+#include "core/framework/tensor.h"
+
+namespace onnxruntime {
+namespace contrib {
+namespace embedding_bag_helper {
+
+// Reduction of each bag, in the order the device kernels number them.
+enum class Mode {
+  kSum = 0,
+  kMean = 1,
+  kMax = 2,
+};
+
+inline Mode ParseMode(const std::string& mode) {
+  if (mode == "sum") {
+    return Mode::kSum;
+  }
+  if (mode == "mean") {
+    return Mode::kMean;
+  }
+  if (mode == "max") {
+    return Mode::kMax;
+  }
+  ORT_THROW("Unsupported EmbeddingBag mode: ", mode);
+}
+
+struct EmbeddingBagParameters {
+  int64_t num_embeddings;
+  int64_t dim;
+  int64_t num_indices;
+  int64_t num_bags;
+  // Bag b reduces the lookups in [bag_starts[b], bag_starts[b + 1]).
+  std::vector<int64_t> bag_starts;
+};
+
+// Validate the inputs of EmbeddingBag, which are all expected to be readable on the host except
+// per_sample_weights, whose shape only is checked.
+template <typename TIndex>
+Status CheckInputs(const Tensor* weight, const Tensor* indices, const Tensor* offsets, const Tensor* per_sample_weights,
+                   const Tensor* scales, bool is_sum_mode, EmbeddingBagParameters& parameters) {
+  const auto& weight_dims = weight->Shape().GetDims();
+  ORT_RETURN_IF_NOT(weight_dims.size() == 2, "weight must be 2-D, got ", weight_dims.size(), " dimensions");
+  const int64_t num_embeddings = weight_dims[0];
+
+  const auto& indices_dims = indices->Shape().GetDims();
+  const int64_t num_indices = indices->Shape().Size();
+  int64_t num_bags = 0;
+  if (offsets != nullptr) {
+    ORT_RETURN_IF_NOT(indices_dims.size() == 1, "indices must be 1-D when offsets are given");
+    ORT_RETURN_IF_NOT(offsets->Shape().NumDimensions() == 1, "offsets must be 1-D");
+    num_bags = offsets->Shape()[0];
+  } else {
+    ORT_RETURN_IF_NOT(indices_dims.size() == 2, "indices must be 2-D (num_bags, bag_size) without offsets");
+    num_bags = indices_dims[0];
+  }
+
+  if (per_sample_weights != nullptr) {
+    ORT_RETURN_IF_NOT(is_sum_mode, "per_sample_weights are only supported in sum mode");
+    ORT_RETURN_IF_NOT(per_sample_weights->Shape().Size() == num_indices,
+                      "per_sample_weights must have one weight per index");
+  }
+
+  ORT_RETURN_IF_NOT(!weight->IsDataType<int8_t>() || (scales != nullptr && scales->Shape().Size() == num_embeddings),
+                    "An int8 weight requires scales with one scale per row");
+
+  auto& bag_starts = parameters.bag_starts;
+  bag_starts.resize(SafeInt<size_t>(num_bags) + 1);
+  if (offsets != nullptr) {
+    const TIndex* offsets_data = offsets->Data<TIndex>();
+    for (int64_t b = 0; b < num_bags; ++b) {
+      bag_starts[b] = static_cast<int64_t>(offsets_data[b]);
+    }
+    bag_starts[num_bags] = num_indices;
+    for (int64_t b = 0; b < num_bags; ++b) {
+      ORT_RETURN_IF_NOT(bag_starts[b] >= 0 && bag_starts[b] <= bag_starts[b + 1],
+                        "offsets must be non-decreasing and within the indices, got ", bag_starts[b],
+                        " for bag ", b);
+    }
+  } else {
+    const int64_t bag_size = indices_dims[1];
+    for (int64_t b = 0; b <= num_bags; ++b) {
+      bag_starts[b] = b * bag_size;
+    }
+  }
+
+  const TIndex* indices_data = indices->Data<TIndex>();
+  for (int64_t i = 0; i < num_indices; ++i) {
+    const int64_t index = static_cast<int64_t>(indices_data[i]);
+    ORT_RETURN_IF_NOT(index >= -num_embeddings && index < num_embeddings,
+                      "index ", index, " is out of bounds of the weight with ", num_embeddings, " rows");
+  }
+
+  parameters.num_embeddings = num_embeddings;
+  parameters.dim = weight_dims[1];
+  parameters.num_indices = num_indices;
+  parameters.num_bags = num_bags;
+  return Status::OK();
+}
+
+// Table row of a validated index, which may count from the end of the table.
+inline int64_t RowOfIndex(int64_t index, int64_t num_embeddings) {
+  return index < 0 ? index + num_embeddings : index;
+}
+
+}  // namespace embedding_bag_helper
+}  // namespace contrib
+}  // namespace onnxruntime
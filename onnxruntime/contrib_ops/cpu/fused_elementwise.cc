@@ -0,0 +1,357 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cpu/fused_elementwise.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "core/common/inlined_containers.h"
+#include "core/common/safeint.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
+
+using onnxruntime::concurrency::ThreadPool;
+
+namespace onnxruntime {
+namespace contrib {
+
+ONNX_OPERATOR_KERNEL_EX(
+    FusedElementwise,
+    kMSDomain,
+    1,
+    kCpuExecutionProvider,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    FusedElementwise);
+
+namespace {
+
+// Number of output elements evaluated at a time. The tile buffers of a thread stay within the L1/L2 cache for the
+// chains the fusion produces.
+constexpr size_t kTileSize = 1024;
+
+enum class InputKind : uint8_t {
+  Full,       // same shape as the output
+  Scalar,     // a single element
+  Broadcast,  // any other broadcastable shape, gathered per tile
+};
+
+struct InputView {
+  const float* data;
+  InputKind kind;
+  // Element strides of the input over the output dimensions, 0 for broadcast dimensions.
+  TensorShapeVector strides;
+};
+
+// Copies count elements of a broadcast input, starting at output element start, to buffer.
+void GatherBroadcastTile(const InputView& input, gsl::span<const int64_t> output_dims, size_t start, size_t count,
+                         float* buffer) {
+  const size_t rank = output_dims.size();
+  TensorShapeVector index(rank);
+  int64_t offset = 0;
+  size_t remainder = start;
+  for (size_t d = rank; d-- > 0;) {
+    const size_t dim = static_cast<size_t>(output_dims[d]);
+    index[d] = static_cast<int64_t>(remainder % dim);
+    remainder /= dim;
+    offset += index[d] * input.strides[d];
+  }
+
+  for (size_t i = 0; i < count; i++) {
+    buffer[i] = input.data[offset];
+    for (size_t d = rank; d-- > 0;) {
+      offset += input.strides[d];
+      if (++index[d] < output_dims[d]) {
+        break;
+      }
+      offset -= input.strides[d] * output_dims[d];
+      index[d] = 0;
+    }
+  }
+}
+
+template <typename Op>
+void Binary(const float* a, const float* b, float* y, size_t count, Op op) {
+  for (size_t i = 0; i < count; i++) {
+    y[i] = op(a[i], b[i]);
+  }
+}
+
+template <typename Op>
+void Unary(const float* a, float* y, size_t count, Op op) {
+  for (size_t i = 0; i < count; i++) {
+    y[i] = op(a[i]);
+  }
+}
+
+}  // namespace
+
+bool FusedElementwise::GetOpCode(const std::string& op_type, OpCode& op_code, bool& is_binary) {
+  static const InlinedHashMap<std::string, std::pair<OpCode, bool>> op_codes = {
+      {"Add", {OpCode::Add, true}},
+      {"Sub", {OpCode::Sub, true}},
+      {"Mul", {OpCode::Mul, true}},
+      {"Div", {OpCode::Div, true}},
+      {"Max", {OpCode::Max, true}},
+      {"Min", {OpCode::Min, true}},
+      {"PRelu", {OpCode::PRelu, true}},
+      {"Neg", {OpCode::Neg, false}},
+      {"Abs", {OpCode::Abs, false}},
+      {"Relu", {OpCode::Relu, false}},
+      {"Sigmoid", {OpCode::Sigmoid, false}},
+      {"Tanh", {OpCode::Tanh, false}},
+      {"Exp", {OpCode::Exp, false}},
+      {"Sqrt", {OpCode::Sqrt, false}},
+      {"Reciprocal", {OpCode::Reciprocal, false}},
+      {"Erf", {OpCode::Erf, false}},
+      {"LeakyRelu", {OpCode::LeakyRelu, false}},
+      {"Gelu", {OpCode::Gelu, false}},
+      {"QuickGelu", {OpCode::QuickGelu, false}},
+  };
+
+  auto it = op_codes.find(op_type);
+  if (it == op_codes.end()) {
+    return false;
+  }
+  op_code = it->second.first;
+  is_binary = it->second.second;
+  return true;
+}
+
+FusedElementwise::FusedElementwise(const OpKernelInfo& info) : OpKernel(info) {
+  std::vector<std::string> ops;
+  ORT_ENFORCE(info.GetAttrs("ops", ops).IsOK() && !ops.empty(), "FusedElementwise requires at least one step.");
+  std::vector<int64_t> operands;
+  ORT_ENFORCE(info.GetAttrs("operands", operands).IsOK() && operands.size() == 2 * ops.size(),
+              "FusedElementwise requires two operands per step.");
+  std::vector<float> alphas;
+  if (!info.GetAttrs("alphas", alphas).IsOK()) {
+    alphas.clear();
+  }
+  ORT_ENFORCE(alphas.empty() || alphas.size() == ops.size(), "FusedElementwise requires one alpha per step.");
+
+  const int64_t num_inputs = static_cast<int64_t>(info.GetInputCount());
+  const int64_t num_steps = static_cast<int64_t>(ops.size());
+  steps_.resize(ops.size());
+
+  // The step that reads the result of each step last, which frees its tile buffer for the following steps.
+  std::vector<int64_t> last_use(ops.size(), -1);
+
+  for (int64_t s = 0; s < num_steps; s++) {
+    Step& step = steps_[s];
+    ORT_ENFORCE(GetOpCode(ops[s], step.op, step.is_binary), "FusedElementwise does not support ", ops[s]);
+    step.operands[0] = operands[2 * s];
+    step.operands[1] = operands[2 * s + 1];
+    step.alpha = alphas.empty() ? 0.0f : alphas[s];
+
+    for (int i = 0; i < (step.is_binary ? 2 : 1); i++) {
+      const int64_t operand = step.operands[i];
+      ORT_ENFORCE(operand >= 0 && operand < num_inputs + s, "FusedElementwise step ", s,
+                  " refers to an operand that is not available: ", operand);
+      if (operand >= num_inputs) {
+        last_use[operand - num_inputs] = s;
+      }
+    }
+  }
+
+  // Assign the tile buffers. The buffer of a step is taken before the buffers of its operands are released, so a
+  // step never writes to the buffer it reads from.
+  std::vector<size_t> free_buffers;
+  for (int64_t s = 0; s + 1 < num_steps; s++) {
+    Step& step = steps_[s];
+    if (free_buffers.empty()) {
+      step.buffer = buffer_count_++;
+    } else {
+      step.buffer = free_buffers.back();
+      free_buffers.pop_back();
+    }
+
+    for (int i = 0; i < (step.is_binary ? 2 : 1); i++) {
+      const int64_t operand = step.operands[i];
+      if (operand >= num_inputs && last_use[operand - num_inputs] == s &&
+          (i == 0 || operand != step.operands[0])) {
+        free_buffers.push_back(steps_[operand - num_inputs].buffer);
+      }
+    }
+  }
+}
+
+Status FusedElementwise::Compute(OpKernelContext* context) const {
+  const int num_inputs = context->InputCount();
+
+  // Broadcast the shapes of all the inputs to the output shape.
+  TensorShapeVector output_dims;
+  for (int i = 0; i < num_inputs; i++) {
+    const auto input_dims = context->Input<Tensor>(i)->Shape().GetDims();
+    if (input_dims.size() > output_dims.size()) {
+      output_dims.insert(output_dims.begin(), input_dims.size() - output_dims.size(), 1);
+    }
+    const size_t offset = output_dims.size() - input_dims.size();
+    for (size_t d = 0; d < input_dims.size(); d++) {
+      int64_t& output_dim = output_dims[offset + d];
+      if (output_dim == 1) {
+        output_dim = input_dims[d];
+      } else if (input_dims[d] != 1 && input_dims[d] != output_dim) {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "FusedElementwise: input ", i,
+                               " cannot be broadcast to the shape of the other inputs.");
+      }
+    }
+  }
+
+  Tensor* output = context->Output(0, TensorShape(output_dims));
+  const size_t output_size = static_cast<size_t>(output->Shape().Size());
+  if (output_size == 0) {
+    return Status::OK();
+  }
+  float* output_data = output->MutableData<float>();
+
+  const size_t rank = output_dims.size();
+  InlinedVector<InputView> inputs(num_inputs);
+  size_t broadcast_count = 0;
+  for (int i = 0; i < num_inputs; i++) {
+    const Tensor* input = context->Input<Tensor>(i);
+    const auto input_dims = input->Shape().GetDims();
+    InputView& view = inputs[i];
+    view.data = input->Data<float>();
+
+    const size_t input_size = static_cast<size_t>(input->Shape().Size());
+    if (input_size == output_size) {
+      view.kind = InputKind::Full;
+    } else if (input_size == 1) {
+      view.kind = InputKind::Scalar;
+    } else {
+      view.kind = InputKind::Broadcast;
+      view.strides.assign(rank, 0);
+      int64_t stride = 1;
+      for (size_t d = input_dims.size(); d-- > 0;) {
+        if (input_dims[d] != 1) {
+          view.strides[rank - input_dims.size() + d] = stride;
+        }
+        stride *= input_dims[d];
+      }
+      broadcast_count++;
+    }
+  }
+
+  // Scalar inputs read from one tile filled with the value, which is shared by all the threads.
+  InlinedVector<std::vector<float>> scalar_tiles;
+  InlinedVector<const float*> scalar_data(num_inputs, nullptr);
+  for (int i = 0; i < num_inputs; i++) {
+    if (inputs[i].kind == InputKind::Scalar) {
+      scalar_tiles.emplace_back(kTileSize, *inputs[i].data);
+      scalar_data[i] = scalar_tiles.back().data();
+    }
+  }
+
+  const size_t tile_count = (output_size + kTileSize - 1) / kTileSize;
+  const double tile_cost = static_cast<double>(kTileSize * steps_.size()) * 4.0;
+
+  ThreadPool::TryParallelFor(
+      context->GetOperatorThreadPool(), static_cast<std::ptrdiff_t>(tile_count),
+      TensorOpCost{static_cast<double>(kTileSize * sizeof(float) * num_inputs),
+                   static_cast<double>(kTileSize * sizeof(float)), tile_cost},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        std::vector<float> buffers(SafeInt<size_t>(buffer_count_ + broadcast_count) * kTileSize);
+        float* broadcast_buffers = buffers.data() + buffer_count_ * kTileSize;
+        InlinedVector<const float*> operands(num_inputs + steps_.size());
+
+        for (std::ptrdiff_t tile = first; tile < last; tile++) {
+          const size_t start = static_cast<size_t>(tile) * kTileSize;
+          const size_t count = std::min(kTileSize, output_size - start);
+
+          size_t broadcast_index = 0;
+          for (int i = 0; i < num_inputs; i++) {
+            const InputView& view = inputs[i];
+            if (view.kind == InputKind::Full) {
+              operands[i] = view.data + start;
+            } else if (view.kind == InputKind::Scalar) {
+              operands[i] = scalar_data[i];
+            } else {
+              float* buffer = broadcast_buffers + broadcast_index++ * kTileSize;
+              GatherBroadcastTile(view, output_dims, start, count, buffer);
+              operands[i] = buffer;
+            }
+          }
+
+          for (size_t s = 0; s < steps_.size(); s++) {
+            const Step& step = steps_[s];
+            const float* a = operands[step.operands[0]];
+            const float* b = step.is_binary ? operands[step.operands[1]] : nullptr;
+            float* y = (s + 1 == steps_.size()) ? output_data + start : buffers.data() + step.buffer * kTileSize;
+            const float alpha = step.alpha;
+
+            switch (step.op) {
+              case OpCode::Add:
+                Binary(a, b, y, count, [](float x0, float x1) { return x0 + x1; });
+                break;
+              case OpCode::Sub:
+                Binary(a, b, y, count, [](float x0, float x1) { return x0 - x1; });
+                break;
+              case OpCode::Mul:
+                Binary(a, b, y, count, [](float x0, float x1) { return x0 * x1; });
+                break;
+              case OpCode::Div:
+                Binary(a, b, y, count, [](float x0, float x1) { return x0 / x1; });
+                break;
+              case OpCode::Max:
+                Binary(a, b, y, count, [](float x0, float x1) { return std::max(x0, x1); });
+                break;
+              case OpCode::Min:
+                Binary(a, b, y, count, [](float x0, float x1) { return std::min(x0, x1); });
+                break;
+              case OpCode::PRelu:
+                Binary(a, b, y, count, [](float x, float slope) { return x > 0.0f ? x : x * slope; });
+                break;
+              case OpCode::Neg:
+                Unary(a, y, count, [](float x) { return -x; });
+                break;
+              case OpCode::Abs:
+                Unary(a, y, count, [](float x) { return std::fabs(x); });
+                break;
+              case OpCode::Relu:
+                Unary(a, y, count, [](float x) { return std::max(x, 0.0f); });
+                break;
+              case OpCode::Sigmoid:
+                MlasComputeLogistic(a, y, count);
+                break;
+              case OpCode::Tanh:
+                MlasComputeTanh(a, y, count);
+                break;
+              case OpCode::Exp:
+                MlasComputeExp(a, y, count);
+                break;
+              case OpCode::Sqrt:
+                Unary(a, y, count, [](float x) { return std::sqrt(x); });
+                break;
+              case OpCode::Reciprocal:
+                Unary(a, y, count, [](float x) { return 1.0f / x; });
+                break;
+              case OpCode::Erf:
+                MlasComputeErf(a, y, count);
+                break;
+              case OpCode::LeakyRelu:
+                Unary(a, y, count, [alpha](float x) { return x >= 0.0f ? x : x * alpha; });
+                break;
+              case OpCode::Gelu:
+                // y never aliases a, see the buffer assignment in the constructor.
+                Unary(a, y, count, [](float x) { return x * 0.70710678118654752f; });
+                MlasComputeErf(y, y, count);
+                Binary(a, y, y, count, [](float x, float e) { return 0.5f * x * (e + 1.0f); });
+                break;
+              case OpCode::QuickGelu:
+                Unary(a, y, count, [alpha](float x) { return x * alpha; });
+                MlasComputeLogistic(y, y, count);
+                Binary(a, y, y, count, [](float x, float s) { return x * s; });
+                break;
+            }
+
+            operands[num_inputs + s] = y;
+          }
+        }
+      });
+
+  return Status::OK();
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,60 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/common.h"
+#include "core/framework/op_kernel.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+// Evaluates a chain of elementwise operators tile by tile, so that every output element is written once and
+// the intermediate results stay in small per-thread buffers.
+class FusedElementwise final : public OpKernel {
+ public:
+  FusedElementwise(const OpKernelInfo& info);
+
+  Status Compute(OpKernelContext* context) const override;
+
+  enum class OpCode : uint8_t {
+    Add,
+    Sub,
+    Mul,
+    Div,
+    Max,
+    Min,
+    PRelu,
+    Neg,
+    Abs,
+    Relu,
+    Sigmoid,
+    Tanh,
+    Exp,
+    Sqrt,
+    Reciprocal,
+    Erf,
+    LeakyRelu,
+    Gelu,
+    QuickGelu,
+  };
+
+  // Returns false if op_type cannot be evaluated by this kernel.
+  static bool GetOpCode(const std::string& op_type, OpCode& op_code, bool& is_binary);
+
+ private:
+  struct Step {
+    OpCode op;
+    bool is_binary;
+    int64_t operands[2];
+    float alpha;
+    // Index of the tile buffer holding the result. The result of the last step goes to the output instead.
+    size_t buffer;
+  };
+
+  std::vector<Step> steps_;
+  size_t buffer_count_{0};
+};
+
+}  // namespace contrib
+}  // namespace onnxruntime
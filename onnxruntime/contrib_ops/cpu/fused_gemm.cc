@@ -21,6 +21,29 @@ class FusedGemm final : public Gemm<T> {
       }
     }
     ORT_THROW_IF_ERROR(functors::ElementWiseRangedTransform<T>::Create(activation, attrs, this->activation_));
+
+    // Let the MLAS SGEMM epilogue apply the activations that it supports.
+    if constexpr (std::is_same_v<T, float>) {
+      MLAS_ACTIVATION mlas_activation;
+      mlas_activation.ActivationKind = MlasActivationKindCount;
+      if (activation == "Relu") {
+        mlas_activation.ActivationKind = MlasReluActivation;
+      } else if (activation == "Tanh") {
+        mlas_activation.ActivationKind = MlasTanhActivation;
+      } else if (activation == "Sigmoid") {
+        mlas_activation.ActivationKind = MlasLogisticActivation;
+      } else if (activation == "LeakyRelu") {
+        mlas_activation.ActivationKind = MlasLeakyReluActivation;
+        mlas_activation.Parameters.LeakyRelu.alpha = info.GetAttrOrDefault<float>("activation_alpha", 0.01f);
+      } else if (activation == "HardSigmoid") {
+        mlas_activation.ActivationKind = MlasHardSigmoidActivation;
+        mlas_activation.Parameters.HardSigmoid.alpha = info.GetAttrOrDefault<float>("activation_alpha", 0.2f);
+        mlas_activation.Parameters.HardSigmoid.beta = info.GetAttrOrDefault<float>("activation_beta", 0.5f);
+      }
+      if (mlas_activation.ActivationKind != MlasActivationKindCount) {
+        this->mlas_activation_ = mlas_activation;
+      }
+    }
   }
 };
 
@@ -0,0 +1,103 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cpu/image_preprocess.h"
+
+#include "contrib_ops/cpu/image_preprocess_helper.h"
+#include "core/common/narrow.h"
+#include "core/platform/threadpool.h"
+#include "core/providers/cpu/tensor/upsample.h"
+
+using onnxruntime::concurrency::ThreadPool;
+using namespace onnxruntime::contrib::image_preprocess_helper;
+
+namespace onnxruntime {
+namespace contrib {
+
+ONNX_OPERATOR_KERNEL_EX(
+    ImagePreprocess,
+    kMSDomain,
+    1,
+    kCpuExecutionProvider,
+    KernelDefBuilder(),
+    ImagePreprocess);
+
+ImagePreprocess::ImagePreprocess(const OpKernelInfo& info) : OpKernel(info) {
+  ORT_ENFORCE(info.GetAttrs("size", size_).IsOK() && size_.size() == 2 && size_[0] > 0 && size_[1] > 0,
+              "attribute size must be two positive values");
+  const auto scale = info.GetAttrOrDefault<float>("scale", 1.0f);
+  const auto mean = info.GetAttrsOrDefault<float>("mean");
+  const auto std_dev = info.GetAttrsOrDefault<float>("std");
+  ComputeChannelCoefficients(scale, mean, std_dev, channel_scale_, channel_bias_);
+}
+
+Status ImagePreprocess::Compute(OpKernelContext* context) const {
+  const Tensor* X = context->Input<Tensor>(0);
+  const auto& input_shape = X->Shape();
+  TensorShapeVector output_dims;
+  ORT_RETURN_IF_ERROR(ComputeOutputShape(input_shape, size_, channel_scale_.size(), output_dims));
+  Tensor* Y = context->Output(0, output_dims);
+  if (Y->Shape().Size() == 0) {
+    return Status::OK();
+  }
+
+  const int32_t batch_size = narrow<int32_t>(input_shape[0]);
+  const int32_t input_height = narrow<int32_t>(input_shape[1]);
+  const int32_t input_width = narrow<int32_t>(input_shape[2]);
+  const int32_t num_channels = narrow<int32_t>(input_shape[3]);
+  const int32_t output_height = narrow<int32_t>(size_[0]);
+  const int32_t output_width = narrow<int32_t>(size_[1]);
+
+  // The bilinear taps of Resize with the half_pixel coordinate transformation, which only uses the roi with
+  // tf_crop_and_resize
+  AllocatorPtr alloc;
+  ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&alloc));
+  const std::vector<float> roi(8, 0.0f);
+  const GetOriginalCoordinateFunc half_pixel = [](float x_resized, float x_scale, float, float, float, float) {
+    return (x_resized + 0.5f) / x_scale - 0.5f;
+  };
+  const float height_scale = static_cast<float>(output_height) / static_cast<float>(input_height);
+  const float width_scale = static_cast<float>(output_width) / static_cast<float>(input_width);
+  const BilinearParams p = SetupUpsampleBilinear(input_height, input_width, output_height, output_width,
+                                                 height_scale, width_scale, roi, alloc, half_pixel, false);
+
+  const uint8_t* X_data = X->Data<uint8_t>();
+  float* Y_data = Y->MutableData<float>();
+  const bool per_channel = channel_scale_.size() > 1;
+
+  // Each output row of each image is interpolated, normalized and written to the planes of its channels in one
+  // pass over the two input rows it reads. The resized values are not rounded to uint8 as Resize of X would do.
+  ThreadPool::TryParallelFor(
+      context->GetOperatorThreadPool(), static_cast<std::ptrdiff_t>(batch_size) * output_height,
+      static_cast<double>(output_width) * num_channels * 8.0,
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t i = first; i != last; ++i) {
+          const int32_t n = static_cast<int32_t>(i / output_height);
+          const int32_t y = static_cast<int32_t>(i % output_height);
+          const uint8_t* image = X_data + static_cast<ptrdiff_t>(n) * input_height * input_width * num_channels;
+          const uint8_t* row1 = image + static_cast<ptrdiff_t>(p.input_width_mul_y1[y]) * num_channels;
+          const uint8_t* row2 = image + static_cast<ptrdiff_t>(p.input_width_mul_y2[y]) * num_channels;
+          const float dy1 = p.dy1[y];
+          const float dy2 = p.dy2[y];
+
+          for (int32_t c = 0; c < num_channels; ++c) {
+            const float scale = channel_scale_[per_channel ? c : 0];
+            const float bias = channel_bias_[per_channel ? c : 0];
+            float* output_row = Y_data + ((static_cast<ptrdiff_t>(n) * num_channels + c) * output_height + y) *
+                                             output_width;
+            for (int32_t x = 0; x < output_width; ++x) {
+              const int32_t x1 = p.in_x1[x] * num_channels + c;
+              const int32_t x2 = p.in_x2[x] * num_channels + c;
+              const float top = p.dx2[x] * row1[x1] + p.dx1[x] * row1[x2];
+              const float bottom = p.dx2[x] * row2[x1] + p.dx1[x] * row2[x2];
+              output_row[x] = (dy2 * top + dy1 * bottom) * scale + bias;
+            }
+          }
+        }
+      });
+
+  return Status::OK();
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,24 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/common.h"
+#include "core/framework/op_kernel.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+class ImagePreprocess final : public OpKernel {
+ public:
+  ImagePreprocess(const OpKernelInfo& info);
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  std::vector<int64_t> size_;
+  std::vector<float> channel_scale_;
+  std::vector<float> channel_bias_;
+};
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,57 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/framework/tensor.h"
+
+namespace onnxruntime {
+namespace contrib {
+namespace image_preprocess_helper {
+
+// Turns (x * scale - mean[c]) / std[c] into x * channel_scale[c] + channel_bias[c]. Either both vectors have one
+// value per channel, or a single value applied to all the channels.
+inline void ComputeChannelCoefficients(float scale, const std::vector<float>& mean, const std::vector<float>& std_dev,
+                                       std::vector<float>& channel_scale, std::vector<float>& channel_bias) {
+  ORT_ENFORCE(mean.empty() || std_dev.empty() || mean.size() == std_dev.size() ||
+                  mean.size() == 1 || std_dev.size() == 1,
+              "mean and std must have the same number of values, or one of them a single value");
+  const size_t num_channels = std::max<size_t>({mean.size(), std_dev.size(), 1});
+
+  channel_scale.resize(num_channels);
+  channel_bias.resize(num_channels);
+  for (size_t c = 0; c < num_channels; ++c) {
+    const float m = mean.empty() ? 0.0f : mean[mean.size() == 1 ? 0 : c];
+    const float s = std_dev.empty() ? 1.0f : std_dev[std_dev.size() == 1 ? 0 : c];
+    ORT_ENFORCE(s != 0.0f, "std must not contain zeros");
+    channel_scale[c] = scale / s;
+    channel_bias[c] = -m / s;
+  }
+}
+
+// Validates the (N, H, W, C) input and the size attribute and returns the (N, C, size[0], size[1]) output dims.
+inline Status ComputeOutputShape(const TensorShape& input_shape, const std::vector<int64_t>& size,
+                                 size_t num_coefficients, TensorShapeVector& output_dims) {
+  if (input_shape.NumDimensions() != 4) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "X must be 4-D (N, H, W, C), got shape ", input_shape);
+  }
+  const int64_t num_channels = input_shape[3];
+  if (num_coefficients != 1 && static_cast<int64_t>(num_coefficients) != num_channels) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "mean and std have ", num_coefficients,
+                           " values but X has ", num_channels, " channels");
+  }
+  if (input_shape[0] * num_channels != 0 && (input_shape[1] == 0 || input_shape[2] == 0)) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "X has empty images, shape ", input_shape);
+  }
+
+  output_dims = {input_shape[0], num_channels, size[0], size[1]};
+  return Status::OK();
+}
+
+}  // namespace image_preprocess_helper
+}  // namespace contrib
+}  // namespace onnxruntime
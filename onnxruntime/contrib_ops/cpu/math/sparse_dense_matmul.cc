@@ -3,10 +3,15 @@
 
 #if !defined(DISABLE_SPARSE_TENSORS)
 
+#include <algorithm>
+#include <numeric>
+
 #include "core/framework/sparse_tensor.h"
 #include "core/common/narrow.h"
 #include "core/providers/cpu/math/gemm_matmul_common.h"
 #include "core/providers/cpu/math/matmul_helper.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
 #include "core/util/math.h"
 #include "core/util/math_cpuonly.h"
 
@@ -149,6 +154,108 @@ struct SparseToDenseCoo {
   }
 };
 
+// Adds op(block) * op(B)[k_start: k_start + block_size, :] to the block_size rows of the output
+template <typename T>
+inline void AddBlockProduct(const ComputeCtx& ctx, const T* block, int64_t block_size,
+                            const T* b_data, int64_t ldb, int64_t k_start,
+                            T* output, int64_t n_cols) {
+  for (int64_t i = 0; i < block_size; ++i) {
+    for (int64_t k = 0; k < block_size; ++k) {
+      const T a_value = (ctx.trans_A) ? block[k * block_size + i] : block[i * block_size + k];
+      const int64_t b_row = k_start + k;
+      for (int64_t n = 0; n < n_cols; ++n) {
+        const T b_value = (ctx.trans_B) ? b_data[n * ldb + b_row] : b_data[b_row * ldb + n];
+        output[i * n_cols + n] += Mul(a_value, ctx.alpha, b_value);
+      }
+    }
+  }
+}
+
+template <>
+inline void AddBlockProduct<float>(const ComputeCtx& ctx, const float* block, int64_t block_size,
+                                   const float* b_data, int64_t ldb, int64_t k_start,
+                                   float* output, int64_t n_cols) {
+  const float* b_start = (ctx.trans_B) ? b_data + k_start : b_data + k_start * ldb;
+  MlasGemm(ctx.trans_A ? CblasTrans : CblasNoTrans, ctx.trans_B ? CblasTrans : CblasNoTrans,
+           narrow<size_t>(block_size), narrow<size_t>(n_cols), narrow<size_t>(block_size),
+           ctx.alpha, block, narrow<size_t>(block_size), b_start, narrow<size_t>(ldb),
+           1.f, output, narrow<size_t>(n_cols), nullptr);
+}
+
+// Handle BlockSparse format. The values are (num_blocks, block_size, block_size) dense blocks and the indices
+// are (2, num_blocks), the block row coordinates followed by the block column coordinates.
+// The blocks are grouped by the block row of the output they update, and the block rows of the output
+// are computed in parallel with one dense product per block.
+template <typename T>
+struct SparseToDenseBlockSparse {
+  Status operator()(const ComputeCtx& ctx, const SparseTensor& A, const Tensor& B, Tensor& output,
+                    concurrency::ThreadPool* thread_pool) const {
+    const auto& a_dims = A.DenseShape().GetDims();
+    const auto& b_dims = B.Shape().GetDims();
+    const auto& out_dims = output.Shape().GetDims();
+    T* output_data = output.MutableData<T>();
+    std::fill_n(output_data, narrow<size_t>(output.Shape().Size()), T{});
+
+    if (A.NumValues() == 0) {
+      return Status::OK();
+    }
+
+    const auto& values_dims = A.Values().Shape().GetDims();
+    ORT_RETURN_IF_NOT(values_dims.size() == 3 && values_dims[1] == values_dims[2],
+                      "BlockSparse values must have (num_blocks, block_size, block_size) shape");
+    const int64_t num_blocks = values_dims[0];
+    const int64_t block_size = values_dims[1];
+    ORT_RETURN_IF_NOT(a_dims[0] % block_size == 0 && a_dims[1] % block_size == 0,
+                      "Dense shape of A must be a multiple of the block size: ", block_size);
+
+    const auto& indices = A.AsBlockSparse().Indices();
+    ORT_RETURN_IF_NOT(indices.Shape().Size() == 2 * num_blocks, "Expecting 2 indices per block");
+    const int32_t* block_rows = indices.Data<int32_t>();
+    const int32_t* block_cols = block_rows + num_blocks;
+
+    const int64_t a_block_rows = a_dims[0] / block_size;
+    const int64_t a_block_cols = a_dims[1] / block_size;
+    const int64_t out_block_rows = out_dims[0] / block_size;
+    const int64_t n_cols = out_dims[1];
+    const int64_t ldb = b_dims[1];
+
+    // counting sort of the blocks by output block row
+    std::vector<int64_t> offsets(narrow<size_t>(out_block_rows + 1), 0);
+    for (int64_t b = 0; b < num_blocks; ++b) {
+      ORT_RETURN_IF_NOT(block_rows[b] >= 0 && block_rows[b] < a_block_rows &&
+                            block_cols[b] >= 0 && block_cols[b] < a_block_cols,
+                        "BlockSparse index of block ", b, " is out of bounds");
+      ++offsets[narrow<size_t>((ctx.trans_A ? block_cols[b] : block_rows[b]) + 1)];
+    }
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+    std::vector<int64_t> order(narrow<size_t>(num_blocks));
+    {
+      std::vector<int64_t> next(offsets.begin(), offsets.end() - 1);
+      for (int64_t b = 0; b < num_blocks; ++b) {
+        order[narrow<size_t>(next[narrow<size_t>(ctx.trans_A ? block_cols[b] : block_rows[b])]++)] = b;
+      }
+    }
+
+    const T* values = A.Values().Data<T>();
+    const T* b_data = B.Data<T>();
+    const int64_t block_elements = block_size * block_size;
+    concurrency::ThreadPool::TrySimpleParallelFor(
+        thread_pool, narrow<std::ptrdiff_t>(out_block_rows),
+        [&](std::ptrdiff_t out_block_row) {
+          T* out_rows = output_data + out_block_row * block_size * n_cols;
+          const auto row = narrow<size_t>(out_block_row);
+          for (int64_t i = offsets[row], end = offsets[row + 1]; i < end; ++i) {
+            const int64_t b = order[narrow<size_t>(i)];
+            const int64_t k_block = ctx.trans_A ? block_rows[b] : block_cols[b];
+            AddBlockProduct(ctx, values + b * block_elements, block_size, b_data, ldb, k_block * block_size,
+                            out_rows, n_cols);
+          }
+        });
+
+    return Status::OK();
+  }
+};
+
 }  // namespace
 
 Status SparseToDenseMatMul::Compute(OpKernelContext* ctx) const {
@@ -187,6 +294,10 @@ Status SparseToDenseMatMul::Compute(OpKernelContext* ctx) const {
     ORT_RETURN_IF_NOT(A->Values().Shape().Size() * 2 == coo_view.Indices().Shape().Size(), "Expecting 2xValues == indices");
     auto status = t_disp.InvokeRet<Status, SparseToDenseCoo>(compute_ctx, *A, *B, *output);
     ORT_RETURN_IF_ERROR(status);
+  } else if (A->Format() == SparseFormat::kBlockSparse) {
+    auto status = t_disp.InvokeRet<Status, SparseToDenseBlockSparse>(compute_ctx, *A, *B, *output,
+                                                                     ctx->GetOperatorThreadPool());
+    ORT_RETURN_IF_ERROR(status);
 // Eigen has a bug in x86 where it calculates reallocation size as -1
 // and throws bad_alloc
 #if !defined(__i386__) && !defined(_M_IX86) && !defined(__wasm__) && !defined(__ANDROID__)
@@ -197,11 +308,11 @@ Status SparseToDenseMatMul::Compute(OpKernelContext* ctx) const {
     ORT_RETURN_IF_NOT((A_shape.GetDims()[0] + 1) == csr_view.Outer().Shape().Size(), "Outer size must be M + 1");
     t_disp.Invoke<SparseToDenseCsr>(compute_ctx, *A, *B, *output);
   } else {
-    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Currently support only COO and CSR(x64) formats");
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Currently support only COO, BlockSparse and CSR(x64) formats");
   }
 #else
   } else {
-    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "WASM and 32-bit builds support only COO format");
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "WASM and 32-bit builds support only COO and BlockSparse formats");
   }
 #endif  //! defined(__i386__) && !defined(_M_IX86) && !defined(__wasm__) && !defined(__ANDROID__)
 
@@ -2,8 +2,9 @@
 // Licensed under the MIT License.
 
 #include "core/common/narrow.h"
-#include "core/common/safeint.h"
+#include "core/common/parse_string.h"
 #include "core/mlas/inc/mlas.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 #include "core/providers/cpu/math/element_wise_ops.h"
 #include "core/providers/cpu/math/matmul_helper.h"
 #include "core/providers/cpu/quantization/matmul_integer_base.h"
@@ -157,7 +158,25 @@ Status MatMulIntegerToFloatBase::ComputeCommon(OpKernelContext* ctx,
 
 class DynamicQuantizeMatMul final : public MatMulIntegerToFloatBase {
  public:
-  DynamicQuantizeMatMul(const OpKernelInfo& info) : MatMulIntegerToFloatBase(info) {}
+  DynamicQuantizeMatMul(const OpKernelInfo& info) : MatMulIntegerToFloatBase(info) {
+    per_row_scale_a_ =
+        info.GetConfigOptions().GetConfigOrDefault(kOrtSessionOptionsDynamicQuantizeMatMulPerRow, "0") == "1";
+    outlier_threshold_ = ParseStringWithClassicLocale<float>(
+        info.GetConfigOptions().GetConfigOrDefault(kOrtSessionOptionsDynamicQuantizeMatMulOutlierThreshold, "0"));
+    ORT_ENFORCE(outlier_threshold_ <= 0.0f || per_row_scale_a_, kOrtSessionOptionsDynamicQuantizeMatMulOutlierThreshold,
+                " requires ", kOrtSessionOptionsDynamicQuantizeMatMulPerRow);
+  }
+
+  Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                 /*out*/ bool& is_packed,
+                 /*out*/ PrePackedWeights* prepacked_weights) override {
+    // the rows of b are read for the outlier columns of a, so b stays unpacked
+    if (outlier_threshold_ > 0.0f) {
+      is_packed = false;
+      return Status::OK();
+    }
+    return MatMulIntegerToFloatBase::PrePack(tensor, input_idx, alloc, is_packed, prepacked_weights);
+  }
 
   Status Compute(OpKernelContext* context) const override;
 
@@ -171,6 +190,12 @@ class DynamicQuantizeMatMul final : public MatMulIntegerToFloatBase {
 
  protected:
   int GetBIdx() const override { return IN_B; }
+
+ private:
+  // quantize A with a scale per row instead of a scale for the whole tensor
+  bool per_row_scale_a_{false};
+  // columns of A with values of a larger magnitude are multiplied in float, if positive
+  float outlier_threshold_{0.0f};
 };
 
 class MatMulIntegerToFloat final : public MatMulIntegerToFloatBase {
@@ -204,37 +229,81 @@ Status DynamicQuantizeMatMul::Compute(OpKernelContext* ctx) const {
 
   const Tensor* b_scale_tensor = ctx->Input<Tensor>(IN_B_SCALE);
   const Tensor* b_zp_tensor = ctx->Input<Tensor>(IN_B_ZERO_POINT);
+  const Tensor* bias_tensor = ctx->Input<Tensor>(IN_BIAS);
+
+  // the scale of b is applied to the output afterwards if it can not be applied per column
+  const bool is_b_scale_supported = IsBQuantParamSupported(b_scale_tensor->Shape(), b ? b->Shape() : b_shape_);
 
-  // calculate quantization parameter of a
+  MatMulComputeHelper helper;
+  ORT_RETURN_IF_ERROR(helper.Compute(a->Shape(),
+                                     b ? b->Shape() : b_shape_,
+                                     is_b_scale_supported ? &b_scale_tensor->Shape() : nullptr,
+                                     b_zp_tensor ? &b_zp_tensor->Shape() : nullptr));
+  Tensor* y = ctx->Output(OUT_Y, helper.OutputShape());
+
+  // Bail out early if the output is going to be empty
+  if (y->Shape().Size() == 0)
+    return Status::OK();
+
+  // calculate quantization parameter of a, unless each row is quantized with its own scale
   const float* a_data = a->Data<float>();
-  int64_t num_of_elements = a->Shape().Size();
+  float a_scale = 1.0f;
+  uint8_t a_zero_point = 0;
+  if (!per_row_scale_a_) {
+    GetQuantizationParameter(a_data, a->Shape().Size(), a_scale, a_zero_point, ctx->GetOperatorThreadPool());
+  }
 
-  float a_scale;
-  uint8_t a_zero_point;
-  GetQuantizationParameter(a_data, num_of_elements, a_scale, a_zero_point, ctx->GetOperatorThreadPool());
+  // process zero point of b
+  bool is_b_zp_per_column = false;
+  uint8_t b_zp_default = 0;
+  const uint8_t* b_zp_ptr = &b_zp_default;
+  if (nullptr != b_zp_tensor) {
+    ORT_ENFORCE(IsBQuantParamSupported(b_zp_tensor->Shape(), b ? b->Shape() : b_shape_),
+                "DynamicQuantizeMatMul : b zero point is not valid");
 
-  AllocatorPtr allocator;
-  ORT_RETURN_IF_ERROR(ctx->GetTempSpaceAllocator(&allocator));
-  uint8_t* a_data_quant = static_cast<uint8_t*>(allocator->Alloc(SafeInt<size_t>(num_of_elements) * sizeof(uint8_t)));
-  BufferUniquePtr a_buffer_quant_holder(a_data_quant, BufferDeleter(std::move(allocator)));
+    is_b_zp_per_column = !IsScalarOr1ElementVector(b_zp_tensor);
+    b_zp_ptr = static_cast<const uint8_t*>(b_zp_tensor->DataRaw());
+  }
 
-  ParQuantizeLinearStd(a_data, a_data_quant, narrow<size_t>(num_of_elements), a_scale, a_zero_point, ctx->GetOperatorThreadPool());
+  // process scale of b
+  const bool is_b_scale_per_column = is_b_scale_supported && !IsScalarOr1ElementVector(b_scale_tensor);
+  const float* b_scale_data = is_b_scale_supported ? b_scale_tensor->Data<float>() : nullptr;
 
-  bool is_b_scale_supported = IsBQuantParamSupported(b_scale_tensor->Shape(), b ? b->Shape() : b_shape_);
-  ORT_RETURN_IF_ERROR(ComputeCommon(
-      ctx,
-      a_data_quant,
-      a->Shape(),
-      a_scale,
-      a_zero_point,
-      false /*a_is_signed*/,
-      b,
-      is_b_scale_supported ? b_scale_tensor : nullptr,
-      b_zp_tensor,
-      ctx->Input<Tensor>(IN_BIAS)));
+  // batch gemm, which quantizes the rows of a block by block right before multiplying them
+  MLAS_GEMM_QUANT_SHAPE_PARAMS gemm_shape;
+  gemm_shape.M = static_cast<size_t>(helper.M());
+  gemm_shape.N = static_cast<size_t>(helper.N());
+  gemm_shape.K = static_cast<size_t>(helper.K());
+  gemm_shape.BIsSigned = b ? b->IsDataType<int8_t>() : b_is_signed_;
+
+  auto* y_data = y->MutableData<float>();
+  const size_t num_gemms = helper.OutputOffsets().size();
+  std::vector<MLAS_GEMM_DYNAMIC_QUANT_DATA_PARAMS> gemm_data_vec(num_gemms);
+
+  for (size_t gemm_idx = 0; gemm_idx < num_gemms; gemm_idx++) {
+    auto& params = gemm_data_vec[gemm_idx];
+    params.A = a_data + helper.LeftOffsets()[gemm_idx];
+    params.lda = gemm_shape.K;
+    params.ScaleA = a_scale;
+    params.ZeroPointA = a_zero_point;
+    params.BIsPacked = bool(packed_b_);
+    params.B = b ? static_cast<const uint8_t*>(b->DataRaw()) + helper.RightOffsets()[gemm_idx] : packed_b_.get();
+    params.ldb = gemm_shape.N;
+    params.ZeroPointB = b_zp_ptr + helper.RightZeroPointOffsets()[gemm_idx];
+    params.PerColumnZeroPoints = is_b_zp_per_column;
+    params.ScaleB = b_scale_data != nullptr ? b_scale_data + helper.RightScaleOffsets()[gemm_idx] : nullptr;
+    params.PerColumnScaleB = is_b_scale_per_column;
+    params.Bias = bias_tensor != nullptr ? bias_tensor->Data<float>() : nullptr;
+    params.C = y_data + helper.OutputOffsets()[gemm_idx];
+    params.ldc = gemm_shape.N;
+    params.OutlierThreshold = outlier_threshold_;
+  }
+
+  MlasDynamicQuantizeGemmBatch(gemm_shape, gemm_data_vec.data(), num_gemms, per_row_scale_a_,
+                               ctx->GetOperatorThreadPool());
 
   if (!is_b_scale_supported) {
-    ScaleOutput(*b_scale_tensor, *ctx->Output<Tensor>(0));
+    ScaleOutput(*b_scale_tensor, *y);
   }
 
   return Status::OK();
@@ -0,0 +1,87 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/common/safeint.h"
+#include "core/framework/op_kernel.h"
+#include "core/mlas/inc/mlas_q4.h"
+#include "core/providers/cpu/math/matmul_helper.h"
+#include "core/providers/common.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+class MatMulFpQ4 final : public OpKernel {
+ public:
+  MatMulFpQ4(const OpKernelInfo& info) : OpKernel(info) {
+    const auto t = info.GetAttrOrDefault<int64_t>("blk_quant_type", static_cast<int64_t>(1));
+    ORT_ENFORCE(t >= BlkQ4Sym && t <= BlkQ4Sym128, "Unsupported blk_quant_type: ", t);
+    blk_quant_type_ = static_cast<MLAS_BLK_QUANT_TYPE>(t);
+  }
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  MLAS_BLK_QUANT_TYPE blk_quant_type_{BlkQ4Zp8};
+};
+
+Status MatMulFpQ4::Compute(OpKernelContext* ctx) const {
+  concurrency::ThreadPool* thread_pool = ctx->GetOperatorThreadPool();
+
+  const Tensor* a = ctx->Input<Tensor>(0);
+  const Tensor* b = ctx->Input<Tensor>(1);
+  const Tensor* b_shape = ctx->Input<Tensor>(2);
+
+  ORT_RETURN_IF_NOT(b_shape->Shape().Size() == 2, "B_shape must describe a 2D matrix [K, N]");
+  const auto* b_shape_data = b_shape->Data<int64_t>();
+  const TensorShape b_dims({b_shape_data[0], b_shape_data[1]});
+
+  MatMulComputeHelper helper;
+  ORT_RETURN_IF_ERROR(helper.Compute(a->Shape(), b_dims));
+
+  const size_t max_len = helper.OutputOffsets().size();
+  const size_t M = static_cast<size_t>(helper.M());
+  const size_t N = static_cast<size_t>(helper.N());
+  const size_t K = static_cast<size_t>(helper.K());
+
+  const size_t packed_size = MlasQ4GemmPackBSize(blk_quant_type_, N, K);
+  ORT_RETURN_IF_NOT(packed_size != 0 && b->SizeInBytes() >= packed_size,
+                    "Packed weight blob is too small for B_shape ", b_dims, ": expected ", packed_size,
+                    " bytes, got ", b->SizeInBytes());
+
+  Tensor* y = ctx->Output(0, helper.OutputShape());
+
+  // Bail out early if the output is going to be empty
+  if (y->Shape().Size() == 0)
+    return Status::OK();
+
+  const auto* a_data = a->Data<float>();
+  const auto* b_data = b->Data<uint8_t>();
+  auto* y_data = y->MutableData<float>();
+
+  std::vector<MLAS_Q4_GEMM_DATA_PARAMS> gemm_params(max_len);
+  for (size_t i = 0; i < max_len; i++) {
+    gemm_params[i].A = a_data + helper.LeftOffsets()[i];
+    gemm_params[i].lda = K;
+    gemm_params[i].B = b_data;
+    gemm_params[i].Bias = nullptr;
+    gemm_params[i].C = y_data + helper.OutputOffsets()[i];
+    gemm_params[i].ldc = N;
+  }
+  MlasQ4GemmBatch(blk_quant_type_, M, N, K, max_len, gemm_params.data(), thread_pool);
+
+  return Status::OK();
+}
+
+ONNX_OPERATOR_KERNEL_EX(
+    MatMulFpQ4,
+    kMSDomain,
+    1,
+    kCpuExecutionProvider,
+    KernelDefBuilder()
+        .TypeConstraint("T1", DataTypeImpl::GetTensorType<float>())
+        .TypeConstraint("T2", DataTypeImpl::GetTensorType<uint8_t>())
+        .TypeConstraint("T3", DataTypeImpl::GetTensorType<int64_t>()),
+    MatMulFpQ4);
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "matmul_integer16.h"
+#include "core/mlas/inc/mlas.h"
 #include "core/providers/cpu/math/matmul_helper.h"
 
 namespace onnxruntime {
@@ -32,14 +33,17 @@ Status MatMulInteger16<int16_t, int16_t, int32_t>::Compute(OpKernelContext* ctx)
   if (Y->Shape().Size() == 0)
     return Status::OK();
 
-  for (int i = 0; i < static_cast<int>(helper.OutputOffsets().size()); i++) {
-    EigenCastGEMM<int16_t, int16_t, int32_t>(
-        A->Data<int16_t>() + helper.LeftOffsets()[i],
-        B->Data<int16_t>() + helper.RightOffsets()[i],
-        Y->MutableData<int32_t>() + helper.OutputOffsets()[i],
-        static_cast<int>(helper.M()),
-        static_cast<int>(helper.N()),
-        static_cast<int>(helper.K()));
+  const size_t M = static_cast<size_t>(helper.M());
+  const size_t N = static_cast<size_t>(helper.N());
+  const size_t K = static_cast<size_t>(helper.K());
+  concurrency::ThreadPool* thread_pool = ctx->GetOperatorThreadPool();
+
+  for (size_t i = 0; i < helper.OutputOffsets().size(); i++) {
+    MlasGemmS16(M, N, K,
+                A->Data<int16_t>() + helper.LeftOffsets()[i], K,
+                B->Data<int16_t>() + helper.RightOffsets()[i], N,
+                Y->MutableData<int32_t>() + helper.OutputOffsets()[i], N,
+                thread_pool);
   }
 
   return Status::OK();
@@ -79,17 +79,44 @@ void QLinearImpl(OpKernelContext& context, double unit_cost, const ProcessBroadc
   const T C_zero_point = (nullptr == tensor_c_zero_point) ? T{} : *(tensor_c_zero_point->Data<T>());
 
   InputBroadcaster input_broadcaster{*context.Input<Tensor>(0), *context.Input<Tensor>(3)};
-  OutputBroadcaster output_broadcaster{input_broadcaster.GetSpanSize(),
-                                       *context.Output(0, input_broadcaster.GetOutputShape())};
-
-  QLinearBroadcastHelper broadcast_helper(input_broadcaster, output_broadcaster,
-                                          context.GetOperatorThreadPool(), unit_cost,
-                                          A_scale, B_scale, C_scale,
-                                          static_cast<uint8_t>(A_zero_point),
-                                          static_cast<uint8_t>(B_zero_point),
-                                          static_cast<uint8_t>(C_zero_point));
+  Tensor& output_tensor = *context.Output(0, input_broadcaster.GetOutputShape());
+  const size_t span_size = input_broadcaster.GetSpanSize();
+  const size_t output_size = static_cast<size_t>(output_tensor.Shape().Size());
+  ThreadPool* tp = context.GetOperatorThreadPool();
+
+  if (output_size <= span_size || !ThreadPool::ShouldParallelize(tp)) {
+    OutputBroadcaster output_broadcaster{span_size, output_tensor};
+    QLinearBroadcastHelper broadcast_helper(input_broadcaster, output_broadcaster, tp, unit_cost,
+                                            A_scale, B_scale, C_scale,
+                                            static_cast<uint8_t>(A_zero_point),
+                                            static_cast<uint8_t>(B_zero_point),
+                                            static_cast<uint8_t>(C_zero_point));
+
+    BroadcastLooper(broadcast_helper, functors);
+    return;
+  }
 
-  BroadcastLooper(broadcast_helper, functors);
+  // Multiple spans: the output elements are partitioned evenly across threads, whatever the span size.
+  const InputBroadcaster& const_input_broadcaster = input_broadcaster;
+  ThreadPool::TryParallelFor(
+      tp, static_cast<std::ptrdiff_t>(output_size),
+      TensorOpCost{static_cast<double>(sizeof(T)), static_cast<double>(sizeof(T)), unit_cost},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        const size_t first_span_start = static_cast<size_t>(first) / span_size * span_size;
+        const size_t last_span_end = (static_cast<size_t>(last) + span_size - 1) / span_size * span_size;
+
+        InputBroadcaster segment_input_broadcaster(const_input_broadcaster);
+        segment_input_broadcaster.AdvanceBy(first_span_start);
+        OutputBroadcaster segment_output_broadcaster(span_size, output_tensor,
+                                                     static_cast<std::ptrdiff_t>(first_span_start),
+                                                     static_cast<std::ptrdiff_t>(last_span_end));
+        QLinearBroadcastHelper segment_helper(segment_input_broadcaster, segment_output_broadcaster, nullptr, unit_cost,
+                                              A_scale, B_scale, C_scale,
+                                              static_cast<uint8_t>(A_zero_point),
+                                              static_cast<uint8_t>(B_zero_point),
+                                              static_cast<uint8_t>(C_zero_point));
+        BroadcastRangeLooper(segment_helper, static_cast<size_t>(first), static_cast<size_t>(last), functors);
+      });
 }
 }  // namespace
 
@@ -0,0 +1,120 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cpu/quantization/qlinear_layer_norm.h"
+
+#include <array>
+#include <type_traits>
+#include <vector>
+
+#include "core/common/narrow.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
+#include "core/providers/common.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+template <typename T>
+QLinearLayerNormalization<T>::QLinearLayerNormalization(const OpKernelInfo& info) : OpKernel(info) {
+  axis_ = info.GetAttrOrDefault<int64_t>("axis", -1);
+  epsilon_ = info.GetAttrOrDefault<float>("epsilon", 1e-5f);
+}
+
+template <typename T>
+Status QLinearLayerNormalization<T>::Compute(OpKernelContext* context) const {
+  const Tensor* X = context->Input<Tensor>(0);
+  const Tensor* x_scale_tensor = context->Input<Tensor>(1);
+  const Tensor* x_zero_point_tensor = context->Input<Tensor>(2);
+  const Tensor* scale = context->Input<Tensor>(3);
+  const Tensor* y_scale_tensor = context->Input<Tensor>(4);
+  const Tensor* y_zero_point_tensor = context->Input<Tensor>(5);
+  const Tensor* bias = context->Input<Tensor>(6);
+
+  ORT_RETURN_IF_NOT(IsScalarOr1ElementVector(x_scale_tensor),
+                    "QLinearLayerNormalization : input X_scale must be a scalar or 1D tensor of size 1");
+  ORT_RETURN_IF_NOT(x_zero_point_tensor == nullptr || IsScalarOr1ElementVector(x_zero_point_tensor),
+                    "QLinearLayerNormalization : input X_zero_point must be a scalar or 1D tensor of size 1");
+  ORT_RETURN_IF_NOT(IsScalarOr1ElementVector(y_scale_tensor),
+                    "QLinearLayerNormalization : input Y_scale must be a scalar or 1D tensor of size 1");
+  ORT_RETURN_IF_NOT(y_zero_point_tensor == nullptr || IsScalarOr1ElementVector(y_zero_point_tensor),
+                    "QLinearLayerNormalization : input Y_zero_point must be a scalar or 1D tensor of size 1");
+
+  const float x_scale = *x_scale_tensor->Data<float>();
+  const T x_zero_point = x_zero_point_tensor ? *x_zero_point_tensor->Data<T>() : T(0);
+  const float y_scale = *y_scale_tensor->Data<float>();
+  const T y_zero_point = y_zero_point_tensor ? *y_zero_point_tensor->Data<T>() : T(0);
+
+  const TensorShape& x_shape = X->Shape();
+  const int64_t axis = HandleNegativeAxis(axis_, x_shape.NumDimensions());
+  const int64_t norm_count = x_shape.SizeToDimension(onnxruntime::narrow<size_t>(axis));
+  const int64_t norm_size = x_shape.SizeFromDimension(onnxruntime::narrow<size_t>(axis));
+
+  if (scale->Shape().Size() != norm_size || (bias != nullptr && bias->Shape().Size() != norm_size)) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "Size of X.shape()[axis:] == ", norm_size,
+                           ". Size of scale and bias (if provided) must match this. Got scale size of ",
+                           scale->Shape().Size(), " and bias size of ", bias ? bias->Shape().Size() : 0);
+  }
+
+  Tensor* Y = context->Output(0, x_shape);
+  if (norm_count == 0) {
+    return Status::OK();
+  }
+
+  // an 8 bit input has 256 values, so dequantize with a table
+  std::array<float, 256> dequantize_table;
+  for (int i = 0; i < 256; i++) {
+    const T value = static_cast<T>(std::is_signed_v<T> ? i - 128 : i);
+    dequantize_table[static_cast<uint8_t>(value)] =
+        (static_cast<int32_t>(value) - static_cast<int32_t>(x_zero_point)) * x_scale;
+  }
+
+  const T* x_data = X->Data<T>();
+  const float* scale_data = scale->Data<float>();
+  const float* bias_data = bias ? bias->Data<float>() : nullptr;
+  T* y_data = Y->MutableData<T>();
+  const size_t row_size = onnxruntime::narrow<size_t>(norm_size);
+
+  // cost per row: read and write the row in 8 bits, and a few operations per element
+  const TensorOpCost cost{static_cast<double>(norm_size), static_cast<double>(norm_size),
+                          static_cast<double>(norm_size) * 8.0};
+  concurrency::ThreadPool::TryParallelFor(
+      context->GetOperatorThreadPool(), static_cast<std::ptrdiff_t>(norm_count), cost,
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        const size_t row_count = static_cast<size_t>(last - first);
+        const size_t offset = static_cast<size_t>(first) * row_size;
+        const size_t element_count = row_count * row_size;
+
+        std::vector<float> buffer(element_count);
+        const uint8_t* x_bytes = reinterpret_cast<const uint8_t*>(x_data + offset);
+        for (size_t i = 0; i < element_count; i++) {
+          buffer[i] = dequantize_table[x_bytes[i]];
+        }
+
+        MLAS_LAYER_NORM_PARAMS params;
+        params.Input = buffer.data();
+        params.Scale = scale_data;
+        params.NormBias = bias_data;
+        params.Output = buffer.data();
+        params.Epsilon = epsilon_;
+        MlasComputeLayerNorm(&params, row_count, row_size, nullptr);
+
+        MlasQuantizeLinear(buffer.data(), y_data + offset, element_count, y_scale, y_zero_point);
+      });
+
+  return Status::OK();
+}
+
+#define REGISTER_QLINEAR_LAYER_NORM_TYPED_KERNEL(data_type)                   \
+  ONNX_CPU_OPERATOR_TYPED_MS_KERNEL(                                          \
+      QLinearLayerNormalization, 1, data_type,                                \
+      KernelDefBuilder()                                                      \
+          .TypeConstraint("T", DataTypeImpl::GetTensorType<data_type>()),     \
+      QLinearLayerNormalization<data_type>);
+
+REGISTER_QLINEAR_LAYER_NORM_TYPED_KERNEL(int8_t);
+REGISTER_QLINEAR_LAYER_NORM_TYPED_KERNEL(uint8_t);
+
+}  // namespace contrib
+}  // namespace onnxruntime
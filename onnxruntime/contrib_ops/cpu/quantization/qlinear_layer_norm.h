@@ -0,0 +1,26 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/framework/op_kernel.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+// LayerNormalization of an 8 bit tensor. Rows are dequantized into a float buffer, normalized with MLAS and quantized
+// again, so that only a block of rows is ever held in float.
+template <typename T>
+class QLinearLayerNormalization final : public OpKernel {
+ public:
+  QLinearLayerNormalization(const OpKernelInfo& info);
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  int64_t axis_;
+  float epsilon_;
+};
+
+}  // namespace contrib
+}  // namespace onnxruntime
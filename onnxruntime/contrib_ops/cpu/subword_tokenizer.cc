@@ -0,0 +1,397 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cpu/subword_tokenizer.h"
+
+#include <algorithm>
+#include <array>
+#include <deque>
+
+#include "core/common/narrow.h"
+#include "core/common/utf8_util.h"
+#include "core/platform/threadpool.h"
+
+using onnxruntime::concurrency::ThreadPool;
+
+namespace onnxruntime {
+namespace contrib {
+
+ONNX_OPERATOR_KERNEL_EX(
+    WordPieceTokenizer,
+    kMSDomain,
+    1,
+    kCpuExecutionProvider,
+    KernelDefBuilder(),
+    WordPieceTokenizer);
+
+ONNX_OPERATOR_KERNEL_EX(
+    BpeTokenizer,
+    kMSDomain,
+    1,
+    kCpuExecutionProvider,
+    KernelDefBuilder(),
+    BpeTokenizer);
+
+namespace subword_tokenizer {
+
+namespace {
+
+enum CharClass : uint8_t {
+  kWordChar = 0,
+  kSpace = 1,
+  kPunctuation = 2,
+};
+
+constexpr std::array<uint8_t, 256> MakeCharClasses() {
+  std::array<uint8_t, 256> classes{};
+  for (int c : {' ', '\t', '\n', '\v', '\f', '\r'}) {
+    classes[c] = kSpace;
+  }
+  for (int c = '!'; c <= '~'; ++c) {
+    const bool is_alnum = (c >= '0' && c <= '9') || (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z');
+    if (!is_alnum) {
+      classes[c] = kPunctuation;
+    }
+  }
+  return classes;
+}
+
+// The splitting looks up one table per byte, bytes of multi-byte UTF-8 characters are word characters
+constexpr std::array<uint8_t, 256> kCharClasses = MakeCharClasses();
+
+}  // namespace
+
+void VocabTrie::Build(std::vector<std::pair<std::string_view, int64_t>> entries) {
+  // a key sorts before the keys it is a prefix of, so the nodes can be built breadth first from ranges of entries
+  // sharing a prefix
+  std::stable_sort(entries.begin(), entries.end(),
+                   [](const auto& a, const auto& b) { return a.first < b.first; });
+
+  nodes_.assign(1, Node{-1, 0, 0});
+  child_labels_.clear();
+  child_nodes_.clear();
+
+  struct Range {
+    uint32_t node;
+    size_t begin;
+    size_t end;
+    size_t depth;
+  };
+  std::deque<Range> ranges{{0, 0, entries.size(), 0}};
+  while (!ranges.empty()) {
+    const Range range = ranges.front();
+    ranges.pop_front();
+
+    size_t i = range.begin;
+    if (i < range.end && entries[i].first.size() == range.depth) {
+      nodes_[range.node].id = entries[i].second;
+      while (i < range.end && entries[i].first.size() == range.depth) {
+        ++i;
+      }
+    }
+
+    nodes_[range.node].first_child = narrow<uint32_t>(child_labels_.size());
+    while (i < range.end) {
+      const auto label = static_cast<uint8_t>(entries[i].first[range.depth]);
+      size_t next = i;
+      while (next < range.end && static_cast<uint8_t>(entries[next].first[range.depth]) == label) {
+        ++next;
+      }
+
+      const auto child = narrow<uint32_t>(nodes_.size());
+      nodes_.push_back(Node{-1, 0, 0});
+      child_labels_.push_back(label);
+      child_nodes_.push_back(child);
+      ++nodes_[range.node].num_children;
+      ranges.push_back(Range{child, i, next, range.depth + 1});
+      i = next;
+    }
+  }
+}
+
+uint32_t VocabTrie::Child(uint32_t node, uint8_t label) const {
+  const Node& parent = nodes_[node];
+  const uint8_t* begin = child_labels_.data() + parent.first_child;
+  const uint8_t* end = begin + parent.num_children;
+  const uint8_t* it = std::lower_bound(begin, end, label);
+  return it != end && *it == label ? child_nodes_[it - child_labels_.data()] : kNoNode;
+}
+
+uint32_t VocabTrie::Walk(uint32_t node, std::string_view key) const {
+  for (size_t i = 0; i < key.size() && node != kNoNode; ++i) {
+    node = Child(node, static_cast<uint8_t>(key[i]));
+  }
+  return node;
+}
+
+size_t VocabTrie::LongestPrefix(std::string_view text, int64_t& id) const {
+  size_t length = 0;
+  uint32_t node = 0;
+  for (size_t i = 0; i < text.size(); ++i) {
+    node = Child(node, static_cast<uint8_t>(text[i]));
+    if (node == kNoNode) {
+      break;
+    }
+    if (nodes_[node].id >= 0) {
+      length = i + 1;
+      id = nodes_[node].id;
+    }
+  }
+  return length;
+}
+
+void SplitWords(std::string_view text, std::vector<std::string_view>& words) {
+  words.clear();
+  size_t begin = 0;
+  for (size_t i = 0; i < text.size(); ++i) {
+    const uint8_t char_class = kCharClasses[static_cast<uint8_t>(text[i])];
+    if (char_class == kWordChar) {
+      continue;
+    }
+    if (i > begin) {
+      words.push_back(text.substr(begin, i - begin));
+    }
+    if (char_class == kPunctuation) {
+      words.push_back(text.substr(i, 1));
+    }
+    begin = i + 1;
+  }
+  if (begin < text.size()) {
+    words.push_back(text.substr(begin));
+  }
+}
+
+}  // namespace subword_tokenizer
+
+using namespace subword_tokenizer;
+
+namespace {
+
+// Returns the number of bytes of the UTF-8 character at `pos`, an invalid byte counts as a character
+size_t CharLength(std::string_view text, size_t pos) {
+  size_t length = 1;
+  if (!utf8_util::utf8_bytes(static_cast<unsigned char>(text[pos]), length) || pos + length > text.size()) {
+    length = 1;
+  }
+  return length;
+}
+
+}  // namespace
+
+SubwordTokenizerBase::SubwordTokenizerBase(const OpKernelInfo& info) : OpKernel(info) {
+  pad_id_ = info.GetAttrOrDefault<int64_t>("pad_id", 0);
+}
+
+std::vector<std::pair<std::string_view, int64_t>> SubwordTokenizerBase::VocabEntries(
+    const std::vector<std::string>& vocab) {
+  ORT_ENFORCE(!vocab.empty(), "attribute vocab is not set");
+  ORT_ENFORCE(vocab.size() <= static_cast<size_t>(std::numeric_limits<int32_t>::max()), "vocab is too large");
+
+  std::vector<std::pair<std::string_view, int64_t>> entries;
+  entries.reserve(vocab.size());
+  for (size_t i = 0; i < vocab.size(); ++i) {
+    entries.emplace_back(vocab[i], static_cast<int64_t>(i));
+  }
+  return entries;
+}
+
+Status SubwordTokenizerBase::Compute(OpKernelContext* context) const {
+  const Tensor* X = context->Input<Tensor>(0);
+  const auto& input_shape = X->Shape();
+  if (input_shape.NumDimensions() != 1) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "X must be 1-D, got shape ", input_shape);
+  }
+
+  const auto texts = X->DataAsSpan<std::string>();
+  const auto batch_size = static_cast<std::ptrdiff_t>(texts.size());
+  size_t total_bytes = 0;
+  for (const auto& text : texts) {
+    total_bytes += text.size();
+  }
+
+  // Rows are tokenized in parallel, each one costs a few trie steps per byte
+  std::vector<std::vector<int64_t>> rows(texts.size());
+  const double cost = batch_size == 0 ? 0.0 : 8.0 * static_cast<double>(total_bytes) / static_cast<double>(batch_size);
+  ThreadPool::TryParallelFor(
+      context->GetOperatorThreadPool(), batch_size, cost,
+      [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+        std::vector<std::string_view> words;
+        for (std::ptrdiff_t i = begin; i != end; ++i) {
+          Tokenize(texts[i], words, rows[i]);
+        }
+      });
+
+  size_t max_length = 0;
+  for (const auto& row : rows) {
+    max_length = std::max(max_length, row.size());
+  }
+
+  const TensorShape output_shape({static_cast<int64_t>(batch_size), narrow<int64_t>(max_length)});
+  int64_t* output = context->Output(0, output_shape)->MutableData<int64_t>();
+  Tensor* mask_tensor = context->Output(1, output_shape);
+  int64_t* mask = mask_tensor != nullptr ? mask_tensor->MutableData<int64_t>() : nullptr;
+
+  for (size_t i = 0; i < rows.size(); ++i) {
+    const auto& row = rows[i];
+    int64_t* output_row = output + i * max_length;
+    std::copy(row.begin(), row.end(), output_row);
+    std::fill(output_row + row.size(), output_row + max_length, pad_id_);
+    if (mask != nullptr) {
+      int64_t* mask_row = mask + i * max_length;
+      std::fill(mask_row, mask_row + row.size(), int64_t{1});
+      std::fill(mask_row + row.size(), mask_row + max_length, int64_t{0});
+    }
+  }
+
+  return Status::OK();
+}
+
+WordPieceTokenizer::WordPieceTokenizer(const OpKernelInfo& info) : SubwordTokenizerBase(info) {
+  std::vector<std::string> vocab;
+  ORT_ENFORCE(info.GetAttrs("vocab", vocab).IsOK(), "attribute vocab is not set");
+  const auto unk_token = info.GetAttrOrDefault<std::string>("unk_token", "[UNK]");
+  const auto suffix_indicator = info.GetAttrOrDefault<std::string>("suffix_indicator", "##");
+  const auto max_input_chars_per_word = info.GetAttrOrDefault<int64_t>("max_input_chars_per_word", 100);
+  ORT_ENFORCE(max_input_chars_per_word > 0, "attribute max_input_chars_per_word must have a positive value");
+  max_input_chars_per_word_ = narrow<size_t>(max_input_chars_per_word);
+
+  auto entries = VocabEntries(vocab);
+  std::vector<std::pair<std::string_view, int64_t>> continuations;
+  if (suffix_indicator.empty()) {
+    continuations = entries;
+  } else {
+    for (const auto& entry : entries) {
+      if (entry.first.size() > suffix_indicator.size() &&
+          entry.first.compare(0, suffix_indicator.size(), suffix_indicator) == 0) {
+        continuations.emplace_back(entry.first.substr(suffix_indicator.size()), entry.second);
+      }
+    }
+  }
+  word_trie_.Build(std::move(entries));
+  continuation_trie_.Build(std::move(continuations));
+
+  unk_id_ = word_trie_.Find(unk_token);
+  ORT_ENFORCE(unk_id_ >= 0, "unk_token '", unk_token, "' is not in the vocab");
+}
+
+void WordPieceTokenizer::Tokenize(std::string_view text, std::vector<std::string_view>& words,
+                                  std::vector<int64_t>& ids) const {
+  SplitWords(text, words);
+  for (const std::string_view word : words) {
+    size_t num_chars = 0;
+    for (size_t pos = 0; pos < word.size() && num_chars <= max_input_chars_per_word_; pos += CharLength(word, pos)) {
+      ++num_chars;
+    }
+    if (num_chars > max_input_chars_per_word_) {
+      ids.push_back(unk_id_);
+      continue;
+    }
+
+    // Greedy longest match first, a word with a part matching no piece is unknown as a whole
+    const size_t word_begin = ids.size();
+    for (size_t pos = 0; pos < word.size();) {
+      int64_t id = -1;
+      const VocabTrie& trie = pos == 0 ? word_trie_ : continuation_trie_;
+      const size_t length = trie.LongestPrefix(word.substr(pos), id);
+      if (length == 0) {
+        ids.resize(word_begin);
+        ids.push_back(unk_id_);
+        break;
+      }
+      ids.push_back(id);
+      pos += length;
+    }
+  }
+}
+
+BpeTokenizer::BpeTokenizer(const OpKernelInfo& info) : SubwordTokenizerBase(info) {
+  std::vector<std::string> vocab;
+  ORT_ENFORCE(info.GetAttrs("vocab", vocab).IsOK(), "attribute vocab is not set");
+  std::vector<std::string> merges;
+  if (!info.GetAttrs("merges", merges).IsOK()) {
+    merges.clear();
+  }
+  const auto unk_token = info.GetAttrOrDefault<std::string>("unk_token", "");
+  end_of_word_suffix_ = info.GetAttrOrDefault<std::string>("end_of_word_suffix", "");
+
+  vocab_trie_.Build(VocabEntries(vocab));
+
+  unk_id_ = -1;
+  if (!unk_token.empty()) {
+    unk_id_ = vocab_trie_.Find(unk_token);
+    ORT_ENFORCE(unk_id_ >= 0, "unk_token '", unk_token, "' is not in the vocab");
+  }
+
+  // A merge is "left right", its rank is its position
+  merges_.reserve(merges.size());
+  std::string merged;
+  for (size_t rank = 0; rank < merges.size(); ++rank) {
+    const std::string_view merge = merges[rank];
+    const size_t space = merge.find(' ');
+    ORT_ENFORCE(space != std::string_view::npos && space > 0 && space + 1 < merge.size() &&
+                    merge.find(' ', space + 1) == std::string_view::npos,
+                "merge '", merge, "' is not two tokens separated by a space");
+    const std::string_view left = merge.substr(0, space);
+    const std::string_view right = merge.substr(space + 1);
+    merged.assign(left).append(right);
+
+    const int64_t left_id = vocab_trie_.Find(left);
+    const int64_t right_id = vocab_trie_.Find(right);
+    const int64_t merged_id = vocab_trie_.Find(merged);
+    ORT_ENFORCE(left_id >= 0 && right_id >= 0 && merged_id >= 0,
+                "the tokens of merge '", merge, "' are not in the vocab");
+    merges_.emplace(PairKey(left_id, right_id), Merge{static_cast<int64_t>(rank), merged_id});
+  }
+}
+
+void BpeTokenizer::Tokenize(std::string_view text, std::vector<std::string_view>& words,
+                            std::vector<int64_t>& ids) const {
+  SplitWords(text, words);
+  InlinedVector<int64_t> symbols;
+  for (const std::string_view word : words) {
+    // The word starts as its characters, the last one with the end of word suffix. -1 is a character which is not
+    // in the vocab.
+    symbols.clear();
+    for (size_t pos = 0; pos < word.size();) {
+      const size_t length = CharLength(word, pos);
+      uint32_t node = vocab_trie_.Walk(0, word.substr(pos, length));
+      pos += length;
+      if (pos == word.size()) {
+        node = vocab_trie_.Walk(node, end_of_word_suffix_);
+      }
+      symbols.push_back(vocab_trie_.IdOf(node));
+    }
+
+    // Merge the pair of the lowest rank until no pair can be merged
+    while (symbols.size() > 1) {
+      const Merge* best = nullptr;
+      size_t best_index = 0;
+      for (size_t i = 0; i + 1 < symbols.size(); ++i) {
+        if (symbols[i] < 0 || symbols[i + 1] < 0) {
+          continue;
+        }
+        const auto it = merges_.find(PairKey(symbols[i], symbols[i + 1]));
+        if (it != merges_.end() && (best == nullptr || it->second.rank < best->rank)) {
+          best = &it->second;
+          best_index = i;
+        }
+      }
+      if (best == nullptr) {
+        break;
+      }
+      symbols[best_index] = best->id;
+      symbols.erase(symbols.begin() + best_index + 1);
+    }
+
+    for (const int64_t symbol : symbols) {
+      if (symbol >= 0) {
+        ids.push_back(symbol);
+      } else if (unk_id_ >= 0) {
+        ids.push_back(unk_id_);
+      }
+    }
+  }
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
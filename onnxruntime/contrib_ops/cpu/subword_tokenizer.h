@@ -0,0 +1,122 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <limits>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/inlined_containers.h"
+#include "core/framework/op_kernel.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+namespace subword_tokenizer {
+
+// Byte trie of a vocabulary. The children of each node are stored contiguously and sorted by byte, so a lookup
+// walks flat arrays instead of chasing a pointer per node.
+class VocabTrie {
+ public:
+  static constexpr uint32_t kNoNode = std::numeric_limits<uint32_t>::max();
+
+  // Builds the trie of (key, id) entries. Of duplicate keys, the first one is kept.
+  void Build(std::vector<std::pair<std::string_view, int64_t>> entries);
+
+  // Returns the node reached from `node` by the bytes of `key`, or kNoNode.
+  uint32_t Walk(uint32_t node, std::string_view key) const;
+
+  // Returns the id of the key ending at `node`, or -1.
+  int64_t IdOf(uint32_t node) const { return node == kNoNode ? -1 : nodes_[node].id; }
+
+  // Returns the id of `key`, or -1.
+  int64_t Find(std::string_view key) const { return IdOf(Walk(0, key)); }
+
+  // Returns the length of the longest key which is a prefix of `text` and sets `id` to its id, or returns 0.
+  size_t LongestPrefix(std::string_view text, int64_t& id) const;
+
+ private:
+  uint32_t Child(uint32_t node, uint8_t label) const;
+
+  struct Node {
+    int64_t id;
+    uint32_t first_child;
+    uint32_t num_children;
+  };
+
+  std::vector<Node> nodes_;
+  // label and node of the children of all the nodes, indexed by Node::first_child
+  std::vector<uint8_t> child_labels_;
+  std::vector<uint32_t> child_nodes_;
+};
+
+// Splits `text` into words at ASCII whitespace, and makes every ASCII punctuation character a word of its own.
+void SplitWords(std::string_view text, std::vector<std::string_view>& words);
+
+}  // namespace subword_tokenizer
+
+// Base of the subword tokenizers, which map each string of a 1-D batch to token ids and pad the rows to the same
+// length.
+class SubwordTokenizerBase : public OpKernel {
+ public:
+  explicit SubwordTokenizerBase(const OpKernelInfo& info);
+
+  Status Compute(OpKernelContext* context) const override;
+
+ protected:
+  // Appends the ids of the tokens of `text` to `ids`. `words` is scratch space.
+  virtual void Tokenize(std::string_view text, std::vector<std::string_view>& words,
+                        std::vector<int64_t>& ids) const = 0;
+
+  // Returns the ids of the vocab attribute, see VocabTrie::Build.
+  static std::vector<std::pair<std::string_view, int64_t>> VocabEntries(const std::vector<std::string>& vocab);
+
+ private:
+  int64_t pad_id_;
+};
+
+class WordPieceTokenizer final : public SubwordTokenizerBase {
+ public:
+  explicit WordPieceTokenizer(const OpKernelInfo& info);
+
+ private:
+  void Tokenize(std::string_view text, std::vector<std::string_view>& words,
+                std::vector<int64_t>& ids) const override;
+
+  subword_tokenizer::VocabTrie word_trie_;
+  // the pieces continuing a word, without the suffix indicator
+  subword_tokenizer::VocabTrie continuation_trie_;
+  int64_t unk_id_;
+  size_t max_input_chars_per_word_;
+};
+
+class BpeTokenizer final : public SubwordTokenizerBase {
+ public:
+  explicit BpeTokenizer(const OpKernelInfo& info);
+
+ private:
+  void Tokenize(std::string_view text, std::vector<std::string_view>& words,
+                std::vector<int64_t>& ids) const override;
+
+  struct Merge {
+    int64_t rank;
+    int64_t id;
+  };
+
+  static uint64_t PairKey(int64_t left, int64_t right) {
+    return (static_cast<uint64_t>(left) << 32) | static_cast<uint64_t>(right);
+  }
+
+  subword_tokenizer::VocabTrie vocab_trie_;
+  // rank and merged token of the pairs of tokens which are merged, keyed by PairKey
+  InlinedHashMap<uint64_t, Merge> merges_;
+  int64_t unk_id_;
+  std::string end_of_word_suffix_;
+};
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -358,18 +358,19 @@ Status BeamSearchGpt<T>::Execute(const FeedsFetchesManager* init_run_feeds_fetch
     // Prepare inputs for next round of subgraph call.
     if (current_length < parameters->max_length) {
       gsl::span<const int32_t> place_holder;
+      // The CUDA beam scorer keeps the beam indices on the device, where the past state is reordered with them.
+      gsl::span<const int32_t> beam_indices_gpu = ReinterpretAsSpan<const int32_t>(
+          this->beam_scorer_->GetNextIndicesGPU());
       // For the first iteration, position_ids is initialized as sequence lengths. We can add it to feeds directly.
       // For the remaining iterations, we need increase position_ids first, then add it to feeds.
       bool increase_position = (iteration_counter > 1);
       ORT_RETURN_IF_ERROR(UpdateFeeds(fetches, feeds, current_length,
                                       position_ids, increase_position,
                                       ReinterpretAsSpan<const int32_t>(beam_next_tokens),
-                                      gpt_subgraph_.has_decoder_masked_attention_
-                                          ? place_holder
-                                          : ReinterpretAsSpan<const int32_t>(this->beam_scorer_->GetNextIndicesCPU()),
-                                      gpt_subgraph_.has_decoder_masked_attention_
-                                          ? ReinterpretAsSpan<const int32_t>(this->beam_scorer_->GetNextIndicesGPU())
+                                      beam_indices_gpu.empty()
+                                          ? ReinterpretAsSpan<const int32_t>(this->beam_scorer_->GetNextIndicesCPU())
                                           : place_holder,
+                                      beam_indices_gpu,
                                       current_length - 1,
                                       parameters->sequence_length,
                                       gpt_subgraph_.has_decoder_masked_attention_));
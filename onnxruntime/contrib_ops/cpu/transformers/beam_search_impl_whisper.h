@@ -262,6 +262,10 @@ Status BeamSearchWhisper<T>::Execute(const FeedsFetchesManager& encoder_feeds_fe
                              past_tensor->Location(), present_tensor_value);
         decoder_fetches.push_back(present_tensor_value);
       }
+      // the cross attention outputs are allocated by the first run, then their buffers are reused
+      if (decoder_subgraph_.HasCrossPresentOutputs()) {
+        decoder_fetches.resize(decoder_fetches.size() + 2 * static_cast<size_t>(decoder_subgraph_.num_layers));
+      }
     }
 
     if (decoder_subgraph_.has_decoder_masked_attention_) {
@@ -346,6 +350,9 @@ Status BeamSearchWhisper<T>::Execute(const FeedsFetchesManager& encoder_feeds_fe
     // Prepare inputs for next round of subgraph call.
     if (current_length < parameters->max_length) {
       gsl::span<const int32_t> place_holder;
+      // The CUDA beam scorer keeps the beam indices on the device, where the past state is reordered with them.
+      gsl::span<const int32_t> beam_indices_gpu = ReinterpretAsSpan<const int32_t>(
+          this->beam_scorer_->GetNextIndicesGPU());
       const int num_present_outputs = 2 * parameters->num_layers;  // number of outputs with name like present_*
       ORT_RETURN_IF_ERROR(this->update_decoder_feeds_func_(
           this->temp_space_allocator_,
@@ -354,12 +361,10 @@ Status BeamSearchWhisper<T>::Execute(const FeedsFetchesManager& encoder_feeds_fe
           decoder_feeds,
           num_present_outputs,
           ReinterpretAsSpan<const int32_t>(beam_next_tokens),
-          decoder_subgraph_.has_decoder_masked_attention_
-              ? place_holder
-              : ReinterpretAsSpan<const int32_t>(this->beam_scorer_->GetNextIndicesCPU()),
-          decoder_subgraph_.has_decoder_masked_attention_
-              ? ReinterpretAsSpan<const int32_t>(this->beam_scorer_->GetNextIndicesGPU())
+          beam_indices_gpu.empty()
+              ? ReinterpretAsSpan<const int32_t>(this->beam_scorer_->GetNextIndicesCPU())
               : place_holder,
+          beam_indices_gpu,
           parameters->num_beams,
           decoder_subgraph_.GetFirstPastInputIndex(),
           decoder_subgraph_.GetFirstPresentOutputIndex(),
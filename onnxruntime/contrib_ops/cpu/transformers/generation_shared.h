@@ -88,7 +88,6 @@ struct ISamplingState {
   size_t temp_storage_bytes;
   std::default_random_engine generator;
 
-  gsl::span<T> sorted_scores;
   gsl::span<T> cumulative_probs;
 };
 
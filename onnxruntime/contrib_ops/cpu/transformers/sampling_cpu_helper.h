@@ -2,58 +2,148 @@
 // Licensed under the MIT License.
 #pragma once
 
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <numeric>
+#include <type_traits>
+#include <vector>
+
 namespace onnxruntime {
 namespace contrib {
 namespace SamplingCpuHelper {
 
-template <typename T>
-void filter_scores(std::vector<size_t>& sorted_indice,
-                   gsl::span<T>& next_token_score,
-                   const transformers::IGenerationParameters* parameters,
-                   size_t chunk_offset,
-                   size_t offset) {
-  size_t real_index = sorted_indice[chunk_offset + offset];
-  next_token_score[chunk_offset + real_index] = (T)parameters->filter_value;
+// The probabilities are not negative, so the order of their bit patterns is the order of their values. A bucket
+// holds the probabilities with the same exponent and 3 high bits of mantissa.
+constexpr int kTopPRadixShift = 20;
+constexpr size_t kTopPRadixBuckets = size_t{1} << (31 - kTopPRadixShift);
+
+inline size_t top_p_bucket(float prob) {
+  uint32_t bits;
+  memcpy(&bits, &prob, sizeof(bits));
+  return static_cast<size_t>(bits >> kTopPRadixShift);
 }
 
+// Sets the scores of the tokens outside of the top-p nucleus of one row to filter_value. A token is in the nucleus
+// when the probabilities of the tokens above it sum to less than top_p (at most top_p for custom sampling), and the
+// min_tokens_to_keep most likely tokens always are.
+// Instead of sorting the vocabulary, a radix pass sums the probabilities per bucket, so that only the bucket where
+// the cumulative probability crosses top_p is sorted.
 template <typename T>
-void cumulate_and_filter_custom(gsl::span<T>& next_token_scores,
-                                gsl::span<T>& cumulative_probs,
-                                const transformers::IGenerationParameters* parameters,
-                                std::vector<size_t>& sorted_indices) {
-  for (size_t i = 0; i < static_cast<size_t>(parameters->batch_size); i++) {
-    size_t offset = i * parameters->vocab_size;
-    if (cumulative_probs[offset] > parameters->top_p) {
-      filter_scores(sorted_indices, next_token_scores, parameters, offset, 1);
-    }
-    for (size_t j = 1; j < static_cast<size_t>(parameters->vocab_size) - 1; j++) {
-      cumulative_probs[j + offset] += cumulative_probs[j + offset - 1];
-      if (cumulative_probs[j + offset] > parameters->top_p) {
-        filter_scores(sorted_indices, next_token_scores, parameters, offset, j + 1);
-      }
+void top_p_filter_row(gsl::span<T> next_token_scores,
+                      gsl::span<const float> probs,
+                      float top_p,
+                      float filter_value,
+                      size_t min_tokens_to_keep,
+                      bool custom_sampling) {
+  auto in_nucleus = [top_p, custom_sampling](float mass_above) {
+    return custom_sampling ? mass_above <= top_p : mass_above < top_p;
+  };
+
+  std::vector<float> bucket_mass(kTopPRadixBuckets, 0.0f);
+  for (float prob : probs) {
+    bucket_mass[top_p_bucket(prob)] += prob;
+  }
+
+  // The tokens of the buckets above the boundary are in the nucleus, and the ones below it are not.
+  float mass_above = 0.0f;
+  size_t boundary = kTopPRadixBuckets;
+  for (size_t bucket = kTopPRadixBuckets; bucket-- > 0;) {
+    if (!in_nucleus(mass_above + bucket_mass[bucket])) {
+      boundary = bucket;
+      break;
     }
+    mass_above += bucket_mass[bucket];
+  }
+  if (boundary == kTopPRadixBuckets) {
+    return;
   }
-}
 
-template <typename T>
-void cumulate_and_filter(gsl::span<T>& next_token_scores,
-                         gsl::span<T>& cumulative_probs,
-                         const transformers::IGenerationParameters* parameters,
-                         std::vector<size_t>& sorted_indices) {
-  for (size_t i = 0; i < static_cast<size_t>(parameters->batch_size); i++) {
-    size_t offset = i * parameters->vocab_size;
-    if (cumulative_probs[offset] <= 1 - parameters->top_p) {
-      filter_scores(sorted_indices, next_token_scores, parameters, offset, 0);
+  size_t num_kept = 0;
+  std::vector<size_t> boundary_indices;
+  for (size_t i = 0; i < probs.size(); i++) {
+    const size_t bucket = top_p_bucket(probs[i]);
+    if (bucket > boundary) {
+      num_kept++;
+    } else if (bucket == boundary) {
+      boundary_indices.push_back(i);
     }
-    for (size_t j = 1; j < static_cast<size_t>(parameters->vocab_size) - static_cast<size_t>(parameters->min_tokens_to_keep); j++) {
-      cumulative_probs[j + offset] += cumulative_probs[j + offset - 1];
-      if (cumulative_probs[j + offset] <= 1 - parameters->top_p) {
-        filter_scores(sorted_indices, next_token_scores, parameters, offset, j);
-      }
+  }
+  std::sort(boundary_indices.begin(), boundary_indices.end(),
+            [&probs](size_t i1, size_t i2) { return probs[i1] > probs[i2]; });
+  size_t num_kept_in_boundary = 0;
+  for (size_t i : boundary_indices) {
+    if (!in_nucleus(mass_above)) {
+      break;
     }
+    mass_above += probs[i];
+    num_kept_in_boundary++;
+  }
+  num_kept += num_kept_in_boundary;
+
+  if (num_kept < min_tokens_to_keep) {
+    // The nucleus is the head of the most likely tokens, so keeping more tokens keeps the nucleus.
+    std::vector<size_t> indices(probs.size());
+    std::iota(indices.begin(), indices.end(), 0);
+    std::nth_element(indices.begin(), indices.begin() + (min_tokens_to_keep - 1), indices.end(),
+                     [&probs](size_t i1, size_t i2) { return probs[i1] > probs[i2]; });
+    std::vector<T> kept_scores(min_tokens_to_keep);
+    for (size_t i = 0; i < min_tokens_to_keep; i++) {
+      kept_scores[i] = next_token_scores[indices[i]];
+    }
+    std::fill(next_token_scores.begin(), next_token_scores.end(), static_cast<T>(filter_value));
+    for (size_t i = 0; i < min_tokens_to_keep; i++) {
+      next_token_scores[indices[i]] = kept_scores[i];
+    }
+    return;
+  }
+
+  for (size_t i = 0; i < probs.size(); i++) {
+    if (top_p_bucket(probs[i]) < boundary) {
+      next_token_scores[i] = static_cast<T>(filter_value);
+    }
+  }
+  for (size_t i = num_kept_in_boundary; i < boundary_indices.size(); i++) {
+    next_token_scores[boundary_indices[i]] = static_cast<T>(filter_value);
   }
 }
 
+// Applies top_p_filter_row to each row of next_token_scores, in parallel over the batch. probs is a buffer of the
+// size of next_token_scores for the softmax of the scores.
+template <typename T>
+Status top_p_filter(onnxruntime::concurrency::ThreadPool* thread_pool,
+                    gsl::span<T>& next_token_scores,
+                    gsl::span<T>& probs,
+                    const transformers::IGenerationParameters* parameters) {
+  static_assert(std::is_same<T, float>::value, "the radix buckets expect float probabilities");
+
+  const size_t vocab_size = static_cast<size_t>(parameters->vocab_size);
+  ORT_RETURN_IF_ERROR(SoftmaxCPU<T>(parameters->batch_size,
+                                    vocab_size,
+                                    next_token_scores.data(),
+                                    probs.data(),
+                                    false,
+                                    thread_pool));
+
+  // custom sampling always keeps the most likely token
+  const size_t min_tokens_to_keep = std::min(
+      vocab_size,
+      parameters->custom_sampling ? size_t{1} : static_cast<size_t>(std::max(parameters->min_tokens_to_keep, 0)));
+  concurrency::ThreadPool::TrySimpleParallelFor(
+      thread_pool, parameters->batch_size,
+      [&](std::ptrdiff_t batch) {
+        const size_t offset = static_cast<size_t>(batch) * vocab_size;
+        top_p_filter_row<T>(next_token_scores.subspan(offset, vocab_size),
+                            probs.subspan(offset, vocab_size),
+                            parameters->top_p,
+                            parameters->filter_value,
+                            min_tokens_to_keep,
+                            parameters->custom_sampling);
+      });
+
+  return Status::OK();
+}
+
 template <typename T>
 Status Sample(AllocatorPtr& allocator,
               onnxruntime::concurrency::ThreadPool* thread_pool,
@@ -64,55 +154,9 @@ Status Sample(AllocatorPtr& allocator,
               const transformers::IConsoleDumper* dumper) {
   ORT_UNUSED_PARAMETER(dumper);
 
-  gsl::span<T>& sorted_scores = sampling_state->sorted_scores;
-  memcpy(sorted_scores.data(), next_token_scores.data(), next_token_scores.size_bytes());
-  std::vector<size_t> sorted_indices(static_cast<size_t>(parameters->batch_size) * static_cast<size_t>(parameters->vocab_size));
-
-  std::function<bool(T, T)> predicator;
-  if (parameters->custom_sampling) {
-    predicator = std::greater<T>();
-  } else {
-    predicator = std::less<T>();
-  }
-
-  // TODO: This could be optimized with allocated buffer and handwritten sort algorithm
-  for (size_t i = 0; i < static_cast<size_t>(parameters->batch_size); i++) {
-    auto indices_begin = sorted_indices.begin() + i * parameters->vocab_size;
-    auto indices_end = sorted_indices.begin() + (i + 1) * parameters->vocab_size;
-    gsl::span<T> next_token_score = next_token_scores.subspan(i * parameters->vocab_size, parameters->vocab_size);
-    std::iota(indices_begin, indices_end, 0);
-    std::sort(indices_begin, indices_end,
-              [&next_token_score, &predicator](size_t i1, size_t i2) {
-                return predicator(next_token_score[i1], next_token_score[i2]);
-              });
-
-    std::sort(sorted_scores.begin() + i * parameters->vocab_size,
-              sorted_scores.begin() + (i + 1) * parameters->vocab_size,
-              predicator);
-  }
-
-#ifdef DEBUG_GENERATION
-  dumper->Print("sorted_scores", sorted_scores.data(), parameters->batch_size, parameters->vocab_size);
-  dumper->Print("sorted_indices", sorted_indices.data(), parameters->batch_size, parameters->vocab_size);
-#endif
-
-  gsl::span<T>& cumulative_probs = sampling_state->cumulative_probs;
-
-  ORT_RETURN_IF_ERROR(SoftmaxCPU<T>(parameters->batch_size,
-                                    parameters->vocab_size,
-                                    sorted_scores.data(),
-                                    cumulative_probs.data(),
-                                    false,
-                                    thread_pool));
-
-  if (parameters->custom_sampling) {
-    cumulate_and_filter_custom(next_token_scores, cumulative_probs, parameters, sorted_indices);
-  } else {
-    cumulate_and_filter(next_token_scores, cumulative_probs, parameters, sorted_indices);
-  }
+  ORT_RETURN_IF_ERROR(top_p_filter(thread_pool, next_token_scores, sampling_state->cumulative_probs, parameters));
 
 #ifdef DEBUG_GENERATION
-  dumper->Print("cumulative_probs after filtering", cumulative_probs.data(), parameters->batch_size, parameters->vocab_size);
   dumper->Print("next_token_scores after filtering", next_token_scores.data(), parameters->batch_size, parameters->vocab_size);
 #endif
 
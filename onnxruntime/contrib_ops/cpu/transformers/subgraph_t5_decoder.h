@@ -18,7 +18,8 @@ class T5DecoderSubgraph : public Subgraph {
       const std::string& attribute_name,
       const GraphViewer& subgraph_in) : Subgraph(node_in, attribute_name, subgraph_in),
                                         has_hidden_state_(false),
-                                        use_sequence_as_input_ids_(true) {
+                                        use_sequence_as_input_ids_(true),
+                                        has_cross_present_outputs_(false) {
     first_present_output_index_ = 1;
   }
 
@@ -66,11 +67,21 @@ class T5DecoderSubgraph : public Subgraph {
     return use_sequence_as_input_ids_;
   }
 
+  // Whether the decoder also outputs present_key_cross_* and present_value_cross_*. The cross attention keys and
+  // values are computed once by the encoder subgraph and stay in the decoder feeds, so these outputs are not used.
+  bool HasCrossPresentOutputs() const {
+    return has_cross_present_outputs_;
+  }
+
  protected:
+  // Sets num_layers from the present outputs, which may include the cross attention ones.
+  Status SetNumLayers(const std::vector<const NodeArg*>& subgraph_outputs);
+
   int first_past_input_index_;
   int first_present_output_index_;
   bool has_hidden_state_;
   bool use_sequence_as_input_ids_;
+  bool has_cross_present_outputs_;
 };
 
 }  // namespace transformers
@@ -42,6 +42,10 @@ namespace transformers {
       present_value_self_0: (B, num_heads, past_decode_sequence_length + 1, head_size)
       ... (for each self attention layer)
 
+      present_key_cross_0: (B, num_heads, encode_sequence_length, head_size) (optional, not used)
+      present_value_cross_0: (B, num_heads, encode_sequence_length, head_size) (optional, not used)
+      ... (for each cross attention layer)
+
     Note:
       B = batch_size * num_beams
       Data type of input or output is float or float16 if not specified.
@@ -70,8 +74,7 @@ Status WhisperDecoderSubgraph::Validate(const std::vector<const NodeArg*>& subgr
                   "number of inputs expected to be kFirstPastInputIndex + 4 * layers + 1, got:", num_subgraph_inputs);
   }
 
-  ORT_RETURN_IF(num_subgraph_outputs < 3 || (num_subgraph_outputs - first_present_output_index_) % 2 != 0,
-                "number of outputs expected to be 1 + 2 * layers, got:", num_subgraph_outputs);
+  ORT_RETURN_IF_ERROR(SetNumLayers(subgraph_outputs));
 
   ORT_RETURN_IF(subgraph_inputs[0]->Name() != "input_ids",
                 "decoder subgraph input 0 shall be named as input_ids, got: ", subgraph_inputs[0]->Name());
@@ -90,7 +93,6 @@ Status WhisperDecoderSubgraph::Validate(const std::vector<const NodeArg*>& subgr
 
   // Save parameters related to the subgraph.
   ORT_RETURN_IF_ERROR(GetParameters(past_shape, logits_shape, false));
-  num_layers = (static_cast<int>(subgraph_outputs.size()) - first_present_output_index_) / 2;
 
   // If input_ids's shape is ['batch_size', 1] then use next token as input_ids.
   // Otherwise in the case of shape ['batch_size', 'sequence'], use sequence as input_ids.
@@ -23,6 +23,14 @@ static constexpr int kCacheIndirectionInputIndex = 9;
 static constexpr int kPastInputIndex = 5;
 static constexpr int kPresentOutputIndex = 1;
 static constexpr int kBiasIndex = 10;
+static constexpr int kKeyCacheScaleIndex = 11;
+static constexpr int kValueCacheScaleIndex = 12;
+
+#if !defined(DISABLE_FLOAT8_TYPES)
+#define KV_CACHE_TYPES(T1) BuildKernelDefConstraints<T1, int8_t, Float8E4M3FN>()
+#else
+#define KV_CACHE_TYPES(T1) BuildKernelDefConstraints<T1, int8_t>()
+#endif
 
 #define REGISTER_KERNEL_TYPED(T1, T2)                                         \
   ONNX_OPERATOR_TYPED_KERNEL_EX(                                              \
@@ -35,6 +43,7 @@ static constexpr int kBiasIndex = 10;
           .MayInplace(kPastInputIndex, kPresentOutputIndex)                   \
           .MayInplace(kPastInputIndex + 1, kPresentOutputIndex + 1)           \
           .TypeConstraint("T", DataTypeImpl::GetTensorType<T1>())             \
+          .TypeConstraint("T_CACHE", KV_CACHE_TYPES(T1))                      \
           .InputMemoryType(OrtMemTypeCPUInput, kPastSequenceLengthInputIndex) \
           .InputMemoryType(OrtMemTypeCPUInput, kBeamWidthInputIndex),         \
       DecoderMaskedMultiHeadAttention<T1, T2>);
@@ -42,6 +51,45 @@ static constexpr int kBiasIndex = 10;
 REGISTER_KERNEL_TYPED(float, float)
 REGISTER_KERNEL_TYPED(MLFloat16, uint16_t)
 
+// The self attention cache has the type of the inputs, or holds int8 or float8 values quantized with a scale per head.
+template <typename T1>
+static Status SetKVCacheType(DecoderMaskedMultiHeadAttentionParams& parameters,
+                             const Tensor* past_key,
+                             const Tensor* past_value,
+                             const Tensor* key_cache_scale,
+                             const Tensor* value_cache_scale) {
+  if (past_key->DataType() != past_value->DataType()) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input 'past_key' and 'past_value' shall have the same type");
+  }
+
+  if (past_key->IsDataType<T1>()) {
+    parameters.kv_cache_type = KVCacheType::kDefault;
+    return Status::OK();
+  }
+
+  if (past_key->IsDataType<int8_t>()) {
+    parameters.kv_cache_type = KVCacheType::kInt8;
+#if !defined(DISABLE_FLOAT8_TYPES)
+  } else if (past_key->IsDataType<Float8E4M3FN>()) {
+    parameters.kv_cache_type = KVCacheType::kFloat8E4M3FN;
+#endif
+  } else {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "Input 'past_key' shall have the type of the query, int8 or float8e4m3fn");
+  }
+
+  for (const Tensor* scale : {key_cache_scale, value_cache_scale}) {
+    if (scale == nullptr || scale->Shape().NumDimensions() != 1 || scale->Shape()[0] != parameters.num_heads) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                             "Input 'key_cache_scale' and 'value_cache_scale' with shape (", parameters.num_heads,
+                             ") are required by an 8-bit key/value cache");
+    }
+  }
+  parameters.k_cache_scale = key_cache_scale->Data<float>();
+  parameters.v_cache_scale = value_cache_scale->Data<float>();
+  return Status::OK();
+}
+
 template <typename T1, typename T2>
 DecoderMaskedMultiHeadAttention<T1, T2>::DecoderMaskedMultiHeadAttention(const OpKernelInfo& info) : CudaKernel(info) {
   int64_t num_heads = 0;
@@ -65,6 +113,8 @@ Status DecoderMaskedMultiHeadAttention<T1, T2>::ComputeInternal(OpKernelContext*
   const Tensor* beam_width = context->Input<Tensor>(kBeamWidthInputIndex);
   const Tensor* cache_indir = context->Input<Tensor>(kCacheIndirectionInputIndex);
   const Tensor* bias = context->Input<Tensor>(kBiasIndex);
+  const Tensor* key_cache_scale = context->Input<Tensor>(kKeyCacheScaleIndex);
+  const Tensor* value_cache_scale = context->Input<Tensor>(kValueCacheScaleIndex);
 
   auto& device_prop = GetDeviceProp();
   DecoderMaskedMultiHeadAttentionParams parameters;
@@ -159,10 +209,12 @@ Status DecoderMaskedMultiHeadAttention<T1, T2>::ComputeInternal(OpKernelContext*
     ORT_ENFORCE(past_present_share_buffer_);
     ORT_ENFORCE(past_key != nullptr && past_value != nullptr);
 
-    auto* present_key_data = present_key->MutableData<T1>();
-    auto* present_value_data = present_value->MutableData<T1>();
-    auto* past_key_data = past_key->Data<T1>();
-    auto* past_value_data = past_value->Data<T1>();
+    ORT_RETURN_IF_ERROR(SetKVCacheType<T1>(parameters, past_key, past_value, key_cache_scale, value_cache_scale));
+
+    auto* present_key_data = present_key->MutableDataRaw();
+    auto* present_value_data = present_value->MutableDataRaw();
+    auto* past_key_data = past_key->DataRaw();
+    auto* past_value_data = past_value->DataRaw();
 
     // No production use-case will incur this copy cost as the implementation of
     // GreedySearch/BeamSearch is written in such a way that the past and present buffers
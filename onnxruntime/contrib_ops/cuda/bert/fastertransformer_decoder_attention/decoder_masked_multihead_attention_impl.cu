@@ -24,6 +24,8 @@
 //  corresponding ORT kernel - for example- CrossAttention support, FP8, INT8, supports, etc.
 // (2) When dealing with masked tokens, this kernel implementation deviates from FasterTransformer by applying
 // mask filter values. Appropriate commentary exists in the code below.
+// (3) The self attention key/value cache may hold int8 or float8 values with a scale per head. The keys and values
+// of the current timestep are quantized when written to the cache, and the cached ones are dequantized when loaded.
 
 #include "decoder_masked_multihead_attention_impl.h"
 #include "decoder_masked_multihead_attention_impl_utils.h"
@@ -174,7 +176,10 @@ __global__ void masked_multihead_attention_kernel(DecoderMaskedMultiHeadAttentio
   }
 
 
-  T* params_k_cache = reinterpret_cast<T*>(params.k_cache);
+  // The scales of the key and value cache of this head when the cache holds 8-bit values.
+  const bool is_quantized_cache = params.kv_cache_type != KVCacheType::kDefault;
+  const float k_cache_scale = is_quantized_cache ? params.k_cache_scale[hi] : 1.f;
+  const float v_cache_scale = is_quantized_cache ? params.v_cache_scale[hi] : 1.f;
 
   const float inv_sqrt_dh = params.scale;
 
@@ -218,7 +223,7 @@ __global__ void masked_multihead_attention_kernel(DecoderMaskedMultiHeadAttentio
                    tlength * QK_ELTS_IN_16B + ci;
 
       // Trigger the stores to global memory.
-      *reinterpret_cast<Qk_vec_m*>(&params_k_cache[offset]) = vec_conversion<Qk_vec_m, Qk_vec_k>(k);
+      store_kv_cache<T>(params, params.k_cache, offset, vec_conversion<Qk_vec_m, Qk_vec_k>(k), k_cache_scale);
 
       // Compute \sum_i Q[i] * K^T[i] for the current timestep.
       using Qk_vec_acum = Qk_vec_k;
@@ -290,8 +295,8 @@ __global__ void masked_multihead_attention_kernel(DecoderMaskedMultiHeadAttentio
   // The number of keys per warp.
   constexpr int K_PER_WARP = WARP_SIZE / THREADS_PER_KEY;
 
-  // Base pointer for the beam's batch, before offsetting with indirection buffer
-  T* k_cache_batch = &params_k_cache[bbhi * params.max_sequence_length * head_size + ki];
+  // Base offset for the beam's batch, before offsetting with indirection buffer
+  const size_t k_cache_batch_offset = bbhi * params.max_sequence_length * head_size + ki;
 
   // Pick a number of keys to make sure all the threads of a warp enter (due to shfl_sync).
   int ti_end = ((tlength + K_PER_WARP - 1) / K_PER_WARP) * K_PER_WARP;
@@ -313,8 +318,8 @@ __global__ void masked_multihead_attention_kernel(DecoderMaskedMultiHeadAttentio
 
         if (ti < tlength) {
           const int beam_offset = beam_indices[ti] * params.num_heads * params.max_sequence_length * head_size;
-          k_vec[ii] = vec_conversion<K_vec_k, K_vec_m>(
-              (*reinterpret_cast<const K_vec_m*>(&k_cache_batch[beam_offset + jj * QK_ELTS_IN_16B])));
+          k_vec[ii] = vec_conversion<K_vec_k, K_vec_m>(load_kv_cache<T, K_vec_m>(
+              params, params.k_cache, k_cache_batch_offset + beam_offset + jj * QK_ELTS_IN_16B, k_cache_scale));
         }
       }
     } else {
@@ -323,8 +328,8 @@ __global__ void masked_multihead_attention_kernel(DecoderMaskedMultiHeadAttentio
         int jj = ii * params.max_sequence_length + ti;
 
         if (ti < tlength) {
-          k_vec[ii] = vec_conversion<K_vec_k, K_vec_m>(
-              (*reinterpret_cast<const K_vec_m*>(&k_cache_batch[jj * QK_ELTS_IN_16B])));
+          k_vec[ii] = vec_conversion<K_vec_k, K_vec_m>(load_kv_cache<T, K_vec_m>(
+              params, params.k_cache, k_cache_batch_offset + jj * QK_ELTS_IN_16B, k_cache_scale));
         }
       }
     }
@@ -420,13 +425,11 @@ __global__ void masked_multihead_attention_kernel(DecoderMaskedMultiHeadAttentio
   // The hidden dimensions computed by this particular thread.
   int vi = tidx % THREADS_PER_VALUE * V_VEC_SIZE;
 
-  // The base pointer for the value in the cache buffer.
-  T* params_v_cache = reinterpret_cast<T*>(params.v_cache);
+  // The base offset for the value in the cache buffer.
+  const size_t v_cache_offset = bhi * params.max_sequence_length * head_size + vi;
 
-  T* v_cache = &params_v_cache[bhi * params.max_sequence_length * head_size + vi];
-
-  // Base pointer for the beam's batch, before offsetting with indirection buffer
-  T* v_cache_batch = &params_v_cache[bbhi * params.max_sequence_length * head_size + vi];
+  // Base offset for the beam's batch, before offsetting with indirection buffer
+  const size_t v_cache_batch_offset = bbhi * params.max_sequence_length * head_size + vi;
 
   // The number of values processed per iteration of the loop.
   constexpr int V_PER_ITER = THREADS_PER_BLOCK / THREADS_PER_VALUE;
@@ -460,7 +463,8 @@ __global__ void masked_multihead_attention_kernel(DecoderMaskedMultiHeadAttentio
     const int beam_offset = has_beams ? beam_src * params.num_heads * params.max_sequence_length * head_size : 0;
 
     // Load the values from the cache.
-    V_vec_k v = vec_conversion<V_vec_k, V_vec_m>(*reinterpret_cast<const V_vec_m*>(&v_cache_batch[beam_offset + ti * head_size]));
+    V_vec_k v = vec_conversion<V_vec_k, V_vec_m>(load_kv_cache<T, V_vec_m>(
+        params, params.v_cache, v_cache_batch_offset + beam_offset + ti * head_size, v_cache_scale));
 
     // Load the logits from shared memory.
     T logit = logits_smem[ti];
@@ -478,7 +482,8 @@ __global__ void masked_multihead_attention_kernel(DecoderMaskedMultiHeadAttentio
     }
 
     // Store the values with bias back to global memory in the cache for V.
-    *reinterpret_cast<V_vec_m*>(&v_cache[tlength * head_size]) = vec_conversion<V_vec_m, V_vec_k>(v);
+    store_kv_cache<T>(params, params.v_cache, v_cache_offset + tlength * head_size,
+                      vec_conversion<V_vec_m, V_vec_k>(v), v_cache_scale);
 
     // Initialize the output value with the current timestep.
     out = fma(logits_smem[tlength], v, out);
@@ -10,6 +10,13 @@ namespace onnxruntime {
 namespace contrib {
 namespace cuda {
 
+// The element type of the key/value cache of self attention. The 8-bit caches hold value / scale of each head.
+enum class KVCacheType {
+  kDefault = 0,  // same type as the inputs
+  kInt8 = 1,
+  kFloat8E4M3FN = 2,
+};
+
 struct DecoderMaskedMultiHeadAttentionParams : AttentionParameters {
   int beam_width = 1;
 
@@ -32,6 +39,10 @@ struct DecoderMaskedMultiHeadAttentionParams : AttentionParameters {
   void* k_cache = nullptr;
   void* v_cache = nullptr;
 
+  KVCacheType kv_cache_type = KVCacheType::kDefault;
+  const float* k_cache_scale = nullptr;  // [num_heads]
+  const float* v_cache_scale = nullptr;  // [num_heads]
+
   void* out = nullptr;
 
   const int32_t* cache_indir = nullptr;
@@ -21,9 +21,11 @@
 
 // Modifications:
 // (1) Minor routine name changes for integration into the ORT code-base
+// (2) Loads and stores of an int8 or float8 key/value cache
 
 #pragma once
 
+#include "core/framework/float8.h"
 #include "contrib_ops/cuda/bert/utils.cuh"
 
 using namespace onnxruntime::cuda;
@@ -135,6 +137,101 @@ struct ThreadsPerValue {
   static const int value = head_size * sizeof(T) / 16;
 };
 
+//------------------------------------------------------------
+// Quantized key/value cache
+//------------------------------------------------------------
+
+inline __device__ float CacheValueToFloat(float v) {
+  return v;
+}
+
+inline __device__ float CacheValueToFloat(uint16_t v) {
+  return HalfToFloat(v);
+}
+
+inline __device__ float DequantizeCacheValue(int8_t v, float scale) {
+  return static_cast<float>(v) * scale;
+}
+
+inline __device__ void QuantizeCacheValue(int8_t& dst, float v, float scale) {
+  dst = static_cast<int8_t>(max(-128, min(127, __float2int_rn(v / scale))));
+}
+
+#if !defined(DISABLE_FLOAT8_TYPES)
+inline __device__ float DequantizeCacheValue(Float8E4M3FN v, float scale) {
+  return v.ToFloat() * scale;
+}
+
+inline __device__ void QuantizeCacheValue(Float8E4M3FN& dst, float v, float scale) {
+  dst = Float8E4M3FN(v / scale, true);
+}
+#endif
+
+// Loads a vector of Vec_m (with elements of type T) from a cache of 8-bit values TQ.
+template <typename T, typename Vec_m, typename TQ>
+inline __device__ Vec_m load_quantized_vec(const TQ* src, float scale) {
+  constexpr int N = sizeof(Vec_m) / sizeof(T);
+  struct alignas(N * sizeof(TQ)) Packed {
+    TQ v[N];
+  };
+  const Packed packed = *reinterpret_cast<const Packed*>(src);
+
+  Vec_m dst;
+  T* dst_elts = reinterpret_cast<T*>(&dst);
+#pragma unroll
+  for (int i = 0; i < N; ++i) {
+    ConvertFromFloat(dst_elts[i], DequantizeCacheValue(packed.v[i], scale));
+  }
+  return dst;
+}
+
+template <typename T, typename Vec_m, typename TQ>
+inline __device__ void store_quantized_vec(TQ* dst, const Vec_m& src, float scale) {
+  constexpr int N = sizeof(Vec_m) / sizeof(T);
+  struct alignas(N * sizeof(TQ)) Packed {
+    TQ v[N];
+  };
+
+  Packed packed;
+  const T* src_elts = reinterpret_cast<const T*>(&src);
+#pragma unroll
+  for (int i = 0; i < N; ++i) {
+    QuantizeCacheValue(packed.v[i], CacheValueToFloat(src_elts[i]), scale);
+  }
+  *reinterpret_cast<Packed*>(dst) = packed;
+}
+
+// Loads the vector at element offset `offset` of a key or value cache of any type of params.kv_cache_type.
+template <typename T, typename Vec_m>
+inline __device__ Vec_m load_kv_cache(const DecoderMaskedMultiHeadAttentionParams& params,
+                                      const void* cache, size_t offset, float scale) {
+  if (params.kv_cache_type == KVCacheType::kInt8) {
+    return load_quantized_vec<T, Vec_m>(reinterpret_cast<const int8_t*>(cache) + offset, scale);
+  }
+#if !defined(DISABLE_FLOAT8_TYPES)
+  if (params.kv_cache_type == KVCacheType::kFloat8E4M3FN) {
+    return load_quantized_vec<T, Vec_m>(reinterpret_cast<const Float8E4M3FN*>(cache) + offset, scale);
+  }
+#endif
+  return *reinterpret_cast<const Vec_m*>(reinterpret_cast<const T*>(cache) + offset);
+}
+
+template <typename T, typename Vec_m>
+inline __device__ void store_kv_cache(const DecoderMaskedMultiHeadAttentionParams& params,
+                                      void* cache, size_t offset, const Vec_m& v, float scale) {
+  if (params.kv_cache_type == KVCacheType::kInt8) {
+    store_quantized_vec<T>(reinterpret_cast<int8_t*>(cache) + offset, v, scale);
+    return;
+  }
+#if !defined(DISABLE_FLOAT8_TYPES)
+  if (params.kv_cache_type == KVCacheType::kFloat8E4M3FN) {
+    store_quantized_vec<T>(reinterpret_cast<Float8E4M3FN*>(cache) + offset, v, scale);
+    return;
+  }
+#endif
+  *reinterpret_cast<Vec_m*>(reinterpret_cast<T*>(cache) + offset) = v;
+}
+
 //------------------------------------------------------------
 // CalcDynamicBlockMemory
 //------------------------------------------------------------
@@ -0,0 +1,92 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cuda/math/batched_lora.h"
+#include "contrib_ops/cuda/math/batched_lora_impl.h"
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+using namespace onnxruntime::cuda;
+
+#define REGISTER_KERNEL_TYPED(T)                                        \
+  ONNX_OPERATOR_TYPED_KERNEL_EX(                                        \
+      BatchedLoRA,                                                      \
+      kMSDomain,                                                        \
+      1,                                                                \
+      T,                                                                \
+      kCudaExecutionProvider,                                           \
+      (*KernelDefBuilder::Create())                                     \
+          .TypeConstraint("T", DataTypeImpl::GetTensorType<T>())        \
+          .TypeConstraint("I", DataTypeImpl::GetTensorType<int32_t>()), \
+      BatchedLoRA<T>);
+
+REGISTER_KERNEL_TYPED(float)
+REGISTER_KERNEL_TYPED(MLFloat16)
+
+template <typename T>
+Status BatchedLoRA<T>::ComputeInternal(OpKernelContext* ctx) const {
+  typedef typename ToCudaType<T>::MappedType CudaT;
+
+  const Tensor* input = ctx->Input<Tensor>(0);
+  const Tensor* base_output = ctx->Input<Tensor>(1);
+  const Tensor* lora_a = ctx->Input<Tensor>(2);
+  const Tensor* lora_b = ctx->Input<Tensor>(3);
+  const Tensor* adapter_indices = ctx->Input<Tensor>(4);
+
+  const auto& input_dims = input->Shape().GetDims();
+  const auto& output_dims = base_output->Shape().GetDims();
+  const auto& a_dims = lora_a->Shape().GetDims();
+  const auto& b_dims = lora_b->Shape().GetDims();
+  ORT_RETURN_IF(input_dims.size() != 3, "Input 'input' is expected to have 3 dimensions, got ", input_dims.size());
+  ORT_RETURN_IF(output_dims.size() != 3 || output_dims[0] != input_dims[0] || output_dims[1] != input_dims[1],
+                "Input 'base_output' is expected to have shape [batch_size, sequence_length, output_size], got ",
+                base_output->Shape());
+  ORT_RETURN_IF(a_dims.size() != 3 || a_dims[2] != input_dims[2],
+                "Input 'lora_a' is expected to have shape [num_adapters, rank, input_size], got ", lora_a->Shape());
+  ORT_RETURN_IF(b_dims.size() != 3 || b_dims[0] != a_dims[0] || b_dims[1] != output_dims[2] || b_dims[2] != a_dims[1],
+                "Input 'lora_b' is expected to have shape [num_adapters, output_size, rank], got ", lora_b->Shape());
+  ORT_RETURN_IF(adapter_indices->Shape().Size() != input_dims[0],
+                "Input 'adapter_indices' is expected to have batch_size elements, got ", adapter_indices->Shape());
+
+  Tensor* output = ctx->Output(0, base_output->Shape());
+  if (output->Shape().Size() == 0) {
+    return Status::OK();
+  }
+
+  const int batch_size = static_cast<int>(input_dims[0]);
+  const int sequence_length = static_cast<int>(input_dims[1]);
+  const int input_size = static_cast<int>(input_dims[2]);
+  const int output_size = static_cast<int>(output_dims[2]);
+  const int rank = static_cast<int>(a_dims[1]);
+  const int num_adapters = static_cast<int>(a_dims[0]);
+
+  if (rank == 0 || num_adapters == 0) {
+    CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(output->MutableDataRaw(), base_output->DataRaw(), base_output->SizeInBytes(),
+                                         cudaMemcpyDeviceToDevice, Stream(ctx)));
+    return Status::OK();
+  }
+
+  ORT_RETURN_IF(GetBatchedLoRASharedMemorySize(rank) > GetDeviceProp().sharedMemPerBlock,
+                "The rank ", rank, " of the adapters exceeds the shared memory of the device.");
+
+  // the indices stay on the device, so that the runs do not synchronize. The kernels leave a sequence whose index
+  // is out of [0, num_adapters) on the base weight.
+  auto shrunk = GetScratchBuffer<float>(static_cast<size_t>(batch_size) * sequence_length * rank,
+                                        ctx->GetComputeStream());
+  return LaunchBatchedLoRAKernel<CudaT>(Stream(ctx),
+                                        reinterpret_cast<CudaT*>(output->MutableData<T>()),
+                                        reinterpret_cast<const CudaT*>(input->Data<T>()),
+                                        reinterpret_cast<const CudaT*>(base_output->Data<T>()),
+                                        reinterpret_cast<const CudaT*>(lora_a->Data<T>()),
+                                        reinterpret_cast<const CudaT*>(lora_b->Data<T>()),
+                                        adapter_indices->Data<int32_t>(),
+                                        num_adapters,
+                                        shrunk.get(),
+                                        batch_size, sequence_length, input_size, output_size, rank);
+}
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,25 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/providers/cuda/cuda_kernel.h"
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+// BatchedLoRA adds the low-rank update of a different LoRA adapter to each sequence of the batch, on top of the
+// output of the shared base weight. The adapters are inputs rather than initializers, so that the application can
+// bind a pool of adapters with IOBinding and load an adapter into a free slot of the pool between runs.
+template <typename T>
+class BatchedLoRA final : public onnxruntime::cuda::CudaKernel {
+ public:
+  BatchedLoRA(const OpKernelInfo& info) : CudaKernel(info) {}
+
+  Status ComputeInternal(OpKernelContext* context) const override;
+};
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,157 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/providers/cuda/cu_inc/common.cuh"
+#include "contrib_ops/cuda/math/batched_lora_impl.h"
+
+using namespace onnxruntime::cuda;
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+namespace {
+
+// a block works on a tile of tokens of one sequence, so that each row of the adapter it reads is used for all the
+// tokens of the tile. Decoding has one token per sequence, and the prompt fills the tiles.
+constexpr int kTokensPerTile = kBatchedLoRATokensPerTile;
+constexpr int kWarpsPerBlock = 4;
+
+// the indices are read on the device, so an index out of [0, num_adapters) cannot fail the run. Its sequence is left
+// on the base weight, like the -1 of no adapter, instead of reading out of the pools.
+__device__ __forceinline__ bool IsValidAdapter(int adapter, int num_adapters) {
+  return adapter >= 0 && adapter < num_adapters;
+}
+
+// shrunk[b, s, j] = input[b, s, :] . lora_a[i, j, :], with a warp per row j of the adapter.
+template <typename T>
+__global__ void LoRAShrinkKernel(float* shrunk, const T* input, const T* lora_a, const int32_t* adapter_indices,
+                                 int num_adapters, int sequence_length, int input_size, int rank) {
+  const int batch_index = blockIdx.z;
+  const int adapter = adapter_indices[batch_index];
+  const int j = blockIdx.x * kWarpsPerBlock + threadIdx.y;
+  if (!IsValidAdapter(adapter, num_adapters) || j >= rank) {
+    return;
+  }
+
+  const int token_start = blockIdx.y * kTokensPerTile;
+  const int tokens = min(kTokensPerTile, sequence_length - token_start);
+  const T* a_row = lora_a + (static_cast<int64_t>(adapter) * rank + j) * input_size;
+  const T* x = input + (static_cast<int64_t>(batch_index) * sequence_length + token_start) * input_size;
+
+  float sums[kTokensPerTile];
+#pragma unroll
+  for (int t = 0; t < kTokensPerTile; ++t) {
+    sums[t] = 0.0f;
+  }
+
+  for (int k = threadIdx.x; k < input_size; k += GPU_WARP_SIZE) {
+    const float weight = static_cast<float>(a_row[k]);
+#pragma unroll
+    for (int t = 0; t < kTokensPerTile; ++t) {
+      if (t < tokens) {
+        sums[t] += static_cast<float>(x[static_cast<int64_t>(t) * input_size + k]) * weight;
+      }
+    }
+  }
+
+#pragma unroll
+  for (int t = 0; t < kTokensPerTile; ++t) {
+#pragma unroll
+    for (int offset = GPU_WARP_SIZE / 2; offset > 0; offset /= 2) {
+      sums[t] += WARP_SHFL_DOWN(sums[t], offset);
+    }
+  }
+
+  if (threadIdx.x == 0) {
+    float* shrunk_tile = shrunk + (static_cast<int64_t>(batch_index) * sequence_length + token_start) * rank;
+    for (int t = 0; t < tokens; ++t) {
+      shrunk_tile[t * rank + j] = sums[t];
+    }
+  }
+}
+
+// output[b, s, n] = base_output[b, s, n] + shrunk[b, s, :] . lora_b[i, n, :], with a thread per column n. The
+// shrunk values of the tile are staged in shared memory.
+template <typename T>
+__global__ void LoRAExpandKernel(T* output, const T* base_output, const float* shrunk, const T* lora_b,
+                                 const int32_t* adapter_indices, int num_adapters, int sequence_length,
+                                 int output_size, int rank) {
+  extern __shared__ float shrunk_tile[];
+
+  const int batch_index = blockIdx.z;
+  const int adapter = adapter_indices[batch_index];
+  const bool has_adapter = IsValidAdapter(adapter, num_adapters);
+  const int token_start = blockIdx.y * kTokensPerTile;
+  const int tokens = min(kTokensPerTile, sequence_length - token_start);
+  const int64_t token_offset = static_cast<int64_t>(batch_index) * sequence_length + token_start;
+
+  if (has_adapter) {
+    for (int i = threadIdx.x; i < tokens * rank; i += blockDim.x) {
+      shrunk_tile[i] = shrunk[token_offset * rank + i];
+    }
+    __syncthreads();
+  }
+
+  const int n = blockIdx.x * blockDim.x + threadIdx.x;
+  if (n >= output_size) {
+    return;
+  }
+
+  float sums[kTokensPerTile];
+#pragma unroll
+  for (int t = 0; t < kTokensPerTile; ++t) {
+    sums[t] = 0.0f;
+  }
+
+  if (has_adapter) {
+    const T* b_row = lora_b + (static_cast<int64_t>(adapter) * output_size + n) * rank;
+    for (int j = 0; j < rank; ++j) {
+      const float weight = static_cast<float>(b_row[j]);
+#pragma unroll
+      for (int t = 0; t < kTokensPerTile; ++t) {
+        sums[t] += shrunk_tile[t * rank + j] * weight;
+      }
+    }
+  }
+
+  for (int t = 0; t < tokens; ++t) {
+    const int64_t index = (token_offset + t) * output_size + n;
+    output[index] = T(static_cast<float>(base_output[index]) + sums[t]);
+  }
+}
+
+}  // namespace
+
+template <typename T>
+Status LaunchBatchedLoRAKernel(cudaStream_t stream, T* output, const T* input, const T* base_output,
+                               const T* lora_a, const T* lora_b, const int32_t* adapter_indices, int num_adapters,
+                               float* shrunk, int batch_size, int sequence_length, int input_size, int output_size, int rank) {
+  const int tiles = (sequence_length + kTokensPerTile - 1) / kTokensPerTile;
+
+  const dim3 shrink_grid((rank + kWarpsPerBlock - 1) / kWarpsPerBlock, tiles, batch_size);
+  const dim3 shrink_block(GPU_WARP_SIZE, kWarpsPerBlock);
+  LoRAShrinkKernel<T><<<shrink_grid, shrink_block, 0, stream>>>(shrunk, input, lora_a, adapter_indices,
+                                                                 num_adapters, sequence_length, input_size, rank);
+
+  const int expand_threads = GridDim::maxThreadsPerBlock;
+  const dim3 expand_grid((output_size + expand_threads - 1) / expand_threads, tiles, batch_size);
+  const size_t shared_memory_size = GetBatchedLoRASharedMemorySize(rank);
+  LoRAExpandKernel<T><<<expand_grid, expand_threads, shared_memory_size, stream>>>(
+      output, base_output, shrunk, lora_b, adapter_indices, num_adapters, sequence_length, output_size, rank);
+
+  return CUDA_CALL(cudaGetLastError());
+}
+
+#define SPECIALIZED_IMPL(T)                                                                                         \
+  template Status LaunchBatchedLoRAKernel<T>(cudaStream_t stream, T * output, const T* input, const T* base_output, \
+                                             const T* lora_a, const T* lora_b, const int32_t* adapter_indices,      \
+                                             int num_adapters, float* shrunk, int batch_size, int sequence_length,  \
+                                             int input_size, int output_size, int rank);
+
+SPECIALIZED_IMPL(float)
+SPECIALIZED_IMPL(half)
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
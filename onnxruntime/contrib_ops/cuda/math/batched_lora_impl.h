@@ -0,0 +1,32 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/providers/cuda/cuda_common.h"
+#include "core/providers/cuda/shared_inc/cuda_utils.h"
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+// the kernels work on tiles of this many tokens of a sequence.
+constexpr int kBatchedLoRATokensPerTile = 8;
+
+// the dynamic shared memory of the expand kernel, which stages the shrunk values of a tile.
+constexpr size_t GetBatchedLoRASharedMemorySize(int rank) {
+  return static_cast<size_t>(kBatchedLoRATokensPerTile) * rank * sizeof(float);
+}
+
+// output[b, s, :] = base_output[b, s, :] + (input[b, s, :] * lora_a[i]') * lora_b[i]' with i = adapter_indices[b],
+// or base_output[b, s, :] when i is -1 or otherwise out of [0, num_adapters). Each sequence is a segment that shares one adapter, so the kernels
+// read the rows of the adapter once for a tile of tokens of the segment. shrunk is a scratch buffer of
+// batch_size * sequence_length * rank floats.
+template <typename T>
+Status LaunchBatchedLoRAKernel(cudaStream_t stream, T* output, const T* input, const T* base_output,
+                               const T* lora_a, const T* lora_b, const int32_t* adapter_indices, int num_adapters,
+                               float* shrunk, int batch_size, int sequence_length, int input_size, int output_size, int rank);
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,190 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#if !defined(DISABLE_FLOAT8_TYPES)
+
+#include "contrib_ops/cuda/math/gemm_float8.h"
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+ONNX_OPERATOR_KERNEL_EX(
+    GemmFloat8,
+    kMSDomain,
+    1,
+    kCudaExecutionProvider,
+    (*KernelDefBuilder::Create())
+        .TypeConstraint("TA", BuildKernelDefConstraints<Float8E4M3FN, Float8E5M2>())
+        .TypeConstraint("TB", BuildKernelDefConstraints<Float8E4M3FN, Float8E5M2>())
+        .TypeConstraint("TR", BuildKernelDefConstraints<float, MLFloat16, BFloat16>())
+        .TypeConstraint("TS", DataTypeImpl::GetTensorType<float>()),
+    GemmFloat8);
+
+#if defined(CUDA_VERSION) && CUDA_VERSION >= 11080
+
+namespace {
+
+// the workspace lets cuBLASLt pick the split-K algorithms of small M and N
+constexpr size_t kWorkspaceSize = 32 * 1024 * 1024;
+
+Status GetCudaDataType(int32_t element_type, cudaDataType_t& data_type) {
+  switch (element_type) {
+    case ONNX_NAMESPACE::TensorProto_DataType_FLOAT8E4M3FN:
+      data_type = CUDA_R_8F_E4M3;
+      break;
+    case ONNX_NAMESPACE::TensorProto_DataType_FLOAT8E5M2:
+      data_type = CUDA_R_8F_E5M2;
+      break;
+    case ONNX_NAMESPACE::TensorProto_DataType_FLOAT:
+      data_type = CUDA_R_32F;
+      break;
+    case ONNX_NAMESPACE::TensorProto_DataType_FLOAT16:
+      data_type = CUDA_R_16F;
+      break;
+    case ONNX_NAMESPACE::TensorProto_DataType_BFLOAT16:
+      data_type = CUDA_R_16BF;
+      break;
+    default:
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "GemmFloat8 does not support the element type ",
+                             element_type);
+  }
+  return Status::OK();
+}
+
+}  // namespace
+
+Status GemmFloat8::ComputeInternal(OpKernelContext* ctx) const {
+  const Tensor* A = ctx->Input<Tensor>(0);
+  const Tensor* B = ctx->Input<Tensor>(1);
+  const Tensor* C = ctx->Input<Tensor>(2);
+  const Tensor* scale_A = ctx->Input<Tensor>(3);
+  const Tensor* scale_B = ctx->Input<Tensor>(4);
+
+  const auto& device_prop = GetDeviceProp();
+  ORT_RETURN_IF(device_prop.major * 10 + device_prop.minor < 89,
+                "GemmFloat8 requires a GPU with float 8 tensor cores (sm89 or later), got sm",
+                device_prop.major, device_prop.minor);
+
+  // cuBLASLt only supports float 8 matrices with the reduction dimension contiguous in memory, i.e. the "TN" layout
+  ORT_RETURN_IF(trans_A_ || !trans_B_, "GemmFloat8 requires transA=0 and transB=1.");
+  ORT_RETURN_IF(A->GetElementType() == ONNX_NAMESPACE::TensorProto_DataType_FLOAT8E5M2 &&
+                    B->GetElementType() == ONNX_NAMESPACE::TensorProto_DataType_FLOAT8E5M2,
+                "GemmFloat8 does not support A and B both of type float8e5m2.");
+
+  const auto& a_shape = A->Shape();
+  const auto& b_shape = B->Shape();
+  ORT_RETURN_IF(a_shape.NumDimensions() != 2 || b_shape.NumDimensions() != 2, "GemmFloat8 expects 2D A and B.");
+  const int64_t M = a_shape[0];
+  const int64_t K = a_shape[1];
+  const int64_t N = b_shape[0];
+  ORT_RETURN_IF(b_shape[1] != K, "GemmFloat8: the inner dimensions of A ", a_shape, " and B ", b_shape,
+                " do not match.");
+  // float 8 matrices need 16 bytes aligned columns
+  ORT_RETURN_IF(K % 16 != 0, "GemmFloat8 requires K to be a multiple of 16, got ", K);
+
+  Tensor* Y = ctx->Output(0, {M, N});
+  if (Y->Shape().Size() == 0) {
+    return Status::OK();
+  }
+
+  if (C != nullptr) {
+    ORT_RETURN_IF(C->Shape() != Y->Shape(), "GemmFloat8 expects C of shape ", Y->Shape(), ", got ", C->Shape());
+    ORT_RETURN_IF(C->GetElementType() != Y->GetElementType(), "GemmFloat8 expects C of the type of Y.");
+  }
+  for (const Tensor* scale : {scale_A, scale_B}) {
+    ORT_RETURN_IF(scale != nullptr && scale->Shape().Size() != 1, "GemmFloat8 expects the scales to be scalars.");
+  }
+
+  cudaDataType_t a_type, b_type, y_type;
+  ORT_RETURN_IF_ERROR(GetCudaDataType(A->GetElementType(), a_type));
+  ORT_RETURN_IF_ERROR(GetCudaDataType(B->GetElementType(), b_type));
+  ORT_RETURN_IF_ERROR(GetCudaDataType(Y->GetElementType(), y_type));
+
+  // the row major Y = A * B' is computed as the column major Y' = B * A', so that cuBLASLt gets B as its first
+  // matrix, transposed, and A as its second matrix, not transposed
+  cublasLtMatmulDesc_t matmul_desc = nullptr;
+  auto clean_matmul_desc = gsl::finally([&matmul_desc]() { if (matmul_desc) cublasLtMatmulDescDestroy(matmul_desc); });
+  cublasLtMatrixLayout_t desc_B = nullptr;
+  auto clean_desc_B = gsl::finally([&desc_B]() { if (desc_B) cublasLtMatrixLayoutDestroy(desc_B); });
+  cublasLtMatrixLayout_t desc_A = nullptr;
+  auto clean_desc_A = gsl::finally([&desc_A]() { if (desc_A) cublasLtMatrixLayoutDestroy(desc_A); });
+  cublasLtMatrixLayout_t desc_Y = nullptr;
+  auto clean_desc_Y = gsl::finally([&desc_Y]() { if (desc_Y) cublasLtMatrixLayoutDestroy(desc_Y); });
+  cublasLtMatmulPreference_t preference = nullptr;
+  auto clean_preference = gsl::finally([&preference]() {
+    if (preference) cublasLtMatmulPreferenceDestroy(preference);
+  });
+
+  CUBLAS_RETURN_IF_ERROR(cublasLtMatmulDescCreate(&matmul_desc, CUBLAS_COMPUTE_32F, CUDA_R_32F));
+  const cublasOperation_t transpose_op = CUBLAS_OP_T;
+  const cublasOperation_t no_transpose_op = CUBLAS_OP_N;
+  CUBLAS_RETURN_IF_ERROR(cublasLtMatmulDescSetAttribute(matmul_desc, CUBLASLT_MATMUL_DESC_TRANSA,
+                                                        &transpose_op, sizeof(transpose_op)));
+  CUBLAS_RETURN_IF_ERROR(cublasLtMatmulDescSetAttribute(matmul_desc, CUBLASLT_MATMUL_DESC_TRANSB,
+                                                        &no_transpose_op, sizeof(no_transpose_op)));
+  // accumulate in the precision of the tensor cores, as the inference of float 8 models does
+  const int8_t fast_accumulation = 1;
+  CUBLAS_RETURN_IF_ERROR(cublasLtMatmulDescSetAttribute(matmul_desc, CUBLASLT_MATMUL_DESC_FAST_ACCUM,
+                                                        &fast_accumulation, sizeof(fast_accumulation)));
+
+  if (scale_B != nullptr) {
+    const float* scale = scale_B->Data<float>();
+    CUBLAS_RETURN_IF_ERROR(cublasLtMatmulDescSetAttribute(matmul_desc, CUBLASLT_MATMUL_DESC_A_SCALE_POINTER,
+                                                          &scale, sizeof(scale)));
+  }
+  if (scale_A != nullptr) {
+    const float* scale = scale_A->Data<float>();
+    CUBLAS_RETURN_IF_ERROR(cublasLtMatmulDescSetAttribute(matmul_desc, CUBLASLT_MATMUL_DESC_B_SCALE_POINTER,
+                                                          &scale, sizeof(scale)));
+  }
+
+  if (activation_ != "NONE") {
+    const cublasLtEpilogue_t epilogue = activation_ == "RELU" ? CUBLASLT_EPILOGUE_RELU : CUBLASLT_EPILOGUE_GELU;
+    CUBLAS_RETURN_IF_ERROR(cublasLtMatmulDescSetAttribute(matmul_desc, CUBLASLT_MATMUL_DESC_EPILOGUE,
+                                                          &epilogue, sizeof(epilogue)));
+  }
+
+  CUBLAS_RETURN_IF_ERROR(cublasLtMatrixLayoutCreate(&desc_B, b_type, K, N, K));
+  CUBLAS_RETURN_IF_ERROR(cublasLtMatrixLayoutCreate(&desc_A, a_type, K, M, K));
+  // C has the type and layout of Y
+  CUBLAS_RETURN_IF_ERROR(cublasLtMatrixLayoutCreate(&desc_Y, y_type, N, M, N));
+
+  CUBLAS_RETURN_IF_ERROR(cublasLtMatmulPreferenceCreate(&preference));
+  size_t workspace_size = kWorkspaceSize;
+  CUBLAS_RETURN_IF_ERROR(cublasLtMatmulPreferenceSetAttribute(preference, CUBLASLT_MATMUL_PREF_MAX_WORKSPACE_BYTES,
+                                                              &workspace_size, sizeof(workspace_size)));
+
+  cublasLtHandle_t lt_handle = CublasLtHandle();
+  cublasLtMatmulHeuristicResult_t heuristic = {};
+  int returned_results = 0;
+  CUBLAS_RETURN_IF_ERROR(cublasLtMatmulAlgoGetHeuristic(lt_handle, matmul_desc, desc_B, desc_A, desc_Y, desc_Y,
+                                                        preference, 1, &heuristic, &returned_results));
+  ORT_RETURN_IF(returned_results == 0, "cuBLASLt has no algorithm for GemmFloat8 with M=", M, ", N=", N, ", K=", K);
+
+  auto workspace = GetScratchBuffer<void>(heuristic.workspaceSize, ctx->GetComputeStream());
+  const float beta = C != nullptr ? beta_ : 0.0f;
+  CUBLAS_RETURN_IF_ERROR(cublasLtMatmul(lt_handle, matmul_desc, &alpha_,
+                                        B->DataRaw(), desc_B,
+                                        A->DataRaw(), desc_A,
+                                        &beta,
+                                        C != nullptr ? C->DataRaw() : Y->MutableDataRaw(), desc_Y,
+                                        Y->MutableDataRaw(), desc_Y,
+                                        &heuristic.algo, workspace.get(), heuristic.workspaceSize,
+                                        Stream(ctx)));
+  return Status::OK();
+}
+
+#else
+
+Status GemmFloat8::ComputeInternal(OpKernelContext* /*ctx*/) const {
+  return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED, "GemmFloat8 requires CUDA 11.8 or later.");
+}
+
+#endif
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
+
+#endif  // !defined(DISABLE_FLOAT8_TYPES)
@@ -0,0 +1,40 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <string>
+
+#include "core/providers/cuda/cuda_kernel.h"
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+// GemmFloat8 computes Y = alpha * (scale_a * A) * (scale_b * B)' + beta * C with the float 8 tensor cores of
+// sm89 (Ada) and sm90 (Hopper) GPUs, through cuBLASLt. The scales are per tensor.
+class GemmFloat8 final : public onnxruntime::cuda::CudaKernel {
+ public:
+  GemmFloat8(const OpKernelInfo& info) : CudaKernel{info} {
+    trans_A_ = info.GetAttrOrDefault<int64_t>("transA", 0) != 0;
+    trans_B_ = info.GetAttrOrDefault<int64_t>("transB", 1) != 0;
+    alpha_ = info.GetAttrOrDefault<float>("alpha", 1.0f);
+    beta_ = info.GetAttrOrDefault<float>("beta", 0.0f);
+    activation_ = info.GetAttrOrDefault<std::string>("activation", "NONE");
+    ORT_ENFORCE(activation_ == "NONE" || activation_ == "RELU" || activation_ == "GELU",
+                "Unsupported activation: ", activation_);
+  }
+
+  Status ComputeInternal(OpKernelContext* context) const override;
+
+ private:
+  bool trans_A_;
+  bool trans_B_;
+  float alpha_;
+  float beta_;
+  std::string activation_;
+};
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,95 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cuda/quantization/matmul_nbits.h"
+#include "contrib_ops/cuda/quantization/matmul_nbits_impl.h"
+#include "core/providers/cuda/tunable/gemm.h"
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+using namespace onnxruntime::cuda;
+
+#define REGISTER_KERNEL_TYPED(T)                                         \
+  ONNX_OPERATOR_TYPED_KERNEL_EX(                                         \
+      MatMulNBits,                                                       \
+      kMSDomain,                                                         \
+      1,                                                                 \
+      T,                                                                 \
+      kCudaExecutionProvider,                                            \
+      (*KernelDefBuilder::Create())                                      \
+          .TypeConstraint("T1", DataTypeImpl::GetTensorType<T>())        \
+          .TypeConstraint("T2", DataTypeImpl::GetTensorType<uint8_t>()), \
+      MatMulNBits<T>);
+
+REGISTER_KERNEL_TYPED(float)
+REGISTER_KERNEL_TYPED(MLFloat16)
+
+template <typename T>
+Status MatMulNBits<T>::ComputeInternal(OpKernelContext* ctx) const {
+  typedef typename ToCudaType<T>::MappedType CudaT;
+
+  const Tensor* A = ctx->Input<Tensor>(0);
+  const Tensor* B = ctx->Input<Tensor>(1);
+  const Tensor* scales = ctx->Input<Tensor>(2);
+  const Tensor* zero_points = ctx->Input<Tensor>(3);
+
+  const auto& a_shape = A->Shape();
+  ORT_RETURN_IF(a_shape.NumDimensions() < 1 || a_shape[a_shape.NumDimensions() - 1] != K_,
+                "MatMulNBits expects A of shape [..., ", K_, "], got ", a_shape);
+
+  const int64_t blocks_per_col = (K_ + block_size_ - 1) / block_size_;
+  const int64_t blob_size = block_size_ * bits_ / 8;
+  ORT_RETURN_IF(B->Shape().Size() != N_ * blocks_per_col * blob_size,
+                "MatMulNBits expects B of shape [", N_, ", ", blocks_per_col, ", ", blob_size, "], got ", B->Shape());
+  ORT_RETURN_IF(scales->Shape().Size() != N_ * blocks_per_col,
+                "MatMulNBits expects ", N_ * blocks_per_col, " scales, got ", scales->Shape().Size());
+  if (zero_points != nullptr) {
+    const int64_t zero_points_per_col = bits_ == 4 ? (blocks_per_col + 1) / 2 : blocks_per_col;
+    ORT_RETURN_IF(zero_points->Shape().Size() != N_ * zero_points_per_col,
+                  "MatMulNBits expects ", N_ * zero_points_per_col, " zero points, got ",
+                  zero_points->Shape().Size());
+  }
+
+  TensorShape y_shape(a_shape);
+  y_shape[y_shape.NumDimensions() - 1] = N_;
+  Tensor* Y = ctx->Output(0, y_shape);
+  if (Y->Shape().Size() == 0) {
+    return Status::OK();
+  }
+
+  const int64_t M = a_shape.SizeToDimension(a_shape.NumDimensions() - 1);
+  const auto* a_data = reinterpret_cast<const CudaT*>(A->Data<T>());
+  const auto* scales_data = reinterpret_cast<const CudaT*>(scales->Data<T>());
+  const uint8_t* zero_points_data = zero_points != nullptr ? zero_points->Data<uint8_t>() : nullptr;
+  auto* y_data = reinterpret_cast<CudaT*>(Y->MutableData<T>());
+
+  if (M <= kGemvMaxRows) {
+    return MatMulNBitsGemv<CudaT>(Stream(ctx), y_data, a_data, B->Data<uint8_t>(), scales_data, zero_points_data,
+                                  static_cast<int>(M), static_cast<int>(N_), static_cast<int>(K_),
+                                  static_cast<int>(bits_), static_cast<int>(block_size_));
+  }
+
+  auto b_dequantized = GetScratchBuffer<CudaT>(N_ * K_, ctx->GetComputeStream());
+  ORT_RETURN_IF_ERROR(DequantizeNBits<CudaT>(Stream(ctx), b_dequantized.get(), B->Data<uint8_t>(), scales_data,
+                                             zero_points_data, static_cast<int>(N_), static_cast<int>(K_),
+                                             static_cast<int>(bits_), static_cast<int>(block_size_)));
+
+  using tunable::blas::BlasOp;
+  const CudaT alpha = ToCudaType<T>::FromFloat(1.0f);
+  const CudaT zero = ToCudaType<T>::FromFloat(0.0f);
+  return tunable::blas::row_major::Gemm(
+      GetTuningContext(), Stream(ctx), GetCublasHandle(ctx), CublasLtHandle(), GetDeviceProp(),
+      BlasOp::N, BlasOp::T,
+      M, N_, K_,
+      alpha,
+      a_data, K_,
+      b_dequantized.get(), K_,
+      zero,
+      y_data, N_);
+}
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,41 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/providers/cuda/cuda_kernel.h"
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+// MatMulNBits multiplies A by the transpose of a weight quantized to 4 or 8 bits in blocks along K. Up to
+// kGemvMaxRows rows of A, the weight is dequantized in registers by a GEMV kernel. Above, it is dequantized to a
+// scratch buffer that is multiplied by a GEMM.
+template <typename T>
+class MatMulNBits final : public onnxruntime::cuda::CudaKernel {
+ public:
+  MatMulNBits(const OpKernelInfo& info) : CudaKernel(info) {
+    ORT_ENFORCE(Status::OK() == info.GetAttr<int64_t>("K", &K_));
+    ORT_ENFORCE(Status::OK() == info.GetAttr<int64_t>("N", &N_));
+    ORT_ENFORCE(Status::OK() == info.GetAttr<int64_t>("bits", &bits_));
+    ORT_ENFORCE(Status::OK() == info.GetAttr<int64_t>("block_size", &block_size_));
+    ORT_ENFORCE(bits_ == 4 || bits_ == 8, "MatMulNBits only supports 4 and 8 bits, got ", bits_);
+    ORT_ENFORCE(block_size_ >= 16 && block_size_ % 16 == 0,
+                "MatMulNBits requires a block_size that is a multiple of 16, got ", block_size_);
+  }
+
+  Status ComputeInternal(OpKernelContext* context) const override;
+
+ private:
+  static constexpr int64_t kGemvMaxRows = 4;
+
+  int64_t K_;
+  int64_t N_;
+  int64_t bits_;
+  int64_t block_size_;
+};
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
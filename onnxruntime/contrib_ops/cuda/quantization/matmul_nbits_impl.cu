@@ -0,0 +1,157 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/providers/cuda/cu_inc/common.cuh"
+#include "contrib_ops/cuda/quantization/matmul_nbits_impl.h"
+
+using namespace onnxruntime::cuda;
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+namespace {
+
+// each warp computes one element of Y, and each lane reads 8 quantized weights at a time: 4 bytes for 4 bits and
+// 8 bytes for 8 bits. The blocks hold a multiple of 16 weights, so that the 8 weights share a scale and the loads
+// are aligned.
+constexpr int kWeightsPerLane = 8;
+constexpr int kWarpsPerBlock = 4;
+
+template <int bits>
+__device__ __forceinline__ float GetZeroPoint(const uint8_t* zero_points, int col, int block, int blocks_per_col) {
+  if (zero_points == nullptr) {
+    return static_cast<float>(1 << (bits - 1));
+  }
+  if (bits == 8) {
+    return static_cast<float>(zero_points[col * blocks_per_col + block]);
+  }
+  const uint8_t packed = zero_points[col * ((blocks_per_col + 1) / 2) + block / 2];
+  return static_cast<float>((block & 1) ? (packed >> 4) : (packed & 0x0F));
+}
+
+template <int bits>
+__device__ __forceinline__ void LoadWeights(const uint8_t* b, int k, float (&weights)[kWeightsPerLane]) {
+  if (bits == 4) {
+    // the even k is in the low nibble, so the weight i is in the bits [4i, 4i + 4) of the little endian word
+    const uint32_t packed = *reinterpret_cast<const uint32_t*>(b + k / 2);
+#pragma unroll
+    for (int i = 0; i < kWeightsPerLane; ++i) {
+      weights[i] = static_cast<float>((packed >> (4 * i)) & 0x0F);
+    }
+  } else {
+    const uint2 packed = *reinterpret_cast<const uint2*>(b + k);
+#pragma unroll
+    for (int i = 0; i < 4; ++i) {
+      weights[i] = static_cast<float>((packed.x >> (8 * i)) & 0xFF);
+      weights[i + 4] = static_cast<float>((packed.y >> (8 * i)) & 0xFF);
+    }
+  }
+}
+
+template <typename T, int bits>
+__global__ void MatMulNBitsGemvKernel(T* output, const T* a, const uint8_t* b, const T* scales,
+                                      const uint8_t* zero_points, int n, int k, int block_size) {
+  const int col = blockIdx.x * kWarpsPerBlock + threadIdx.y;
+  const int row = blockIdx.y;
+  if (col >= n) {
+    return;
+  }
+
+  const int blocks_per_col = (k + block_size - 1) / block_size;
+  const uint8_t* b_col = b + static_cast<int64_t>(col) * blocks_per_col * block_size * bits / 8;
+  const T* a_row = a + static_cast<int64_t>(row) * k;
+  const T* col_scales = scales + static_cast<int64_t>(col) * blocks_per_col;
+
+  float sum = 0.0f;
+  for (int k_start = threadIdx.x * kWeightsPerLane; k_start < k; k_start += GPU_WARP_SIZE * kWeightsPerLane) {
+    const int block = k_start / block_size;
+    const float scale = static_cast<float>(col_scales[block]);
+    const float zero_point = GetZeroPoint<bits>(zero_points, col, block, blocks_per_col);
+
+    float weights[kWeightsPerLane];
+    LoadWeights<bits>(b_col, k_start, weights);
+
+    float partial = 0.0f;
+#pragma unroll
+    for (int i = 0; i < kWeightsPerLane; ++i) {
+      if (k_start + i < k) {
+        partial += static_cast<float>(a_row[k_start + i]) * (weights[i] - zero_point);
+      }
+    }
+    sum += partial * scale;
+  }
+
+#pragma unroll
+  for (int offset = GPU_WARP_SIZE / 2; offset > 0; offset /= 2) {
+    sum += WARP_SHFL_DOWN(sum, offset);
+  }
+  if (threadIdx.x == 0) {
+    output[static_cast<int64_t>(row) * n + col] = T(sum);
+  }
+}
+
+template <typename T, int bits>
+__global__ void DequantizeNBitsKernel(T* output, const uint8_t* b, const T* scales, const uint8_t* zero_points,
+                                      int k, int block_size, CUDA_LONG count) {
+  CALCULATE_ELEMENTWISE_INDEX_OR_EXIT(id, count);
+  const int col = id / k;
+  const int k_index = id % k;
+  const int blocks_per_col = (k + block_size - 1) / block_size;
+  const int block = k_index / block_size;
+
+  const int64_t padded_index = static_cast<int64_t>(col) * blocks_per_col * block_size + k_index;
+  float weight;
+  if (bits == 4) {
+    const uint8_t packed = b[padded_index / 2];
+    weight = static_cast<float>((padded_index & 1) ? (packed >> 4) : (packed & 0x0F));
+  } else {
+    weight = static_cast<float>(b[padded_index]);
+  }
+  const float scale = static_cast<float>(scales[col * blocks_per_col + block]);
+  output[id] = T((weight - GetZeroPoint<bits>(zero_points, col, block, blocks_per_col)) * scale);
+}
+
+}  // namespace
+
+template <typename T>
+Status MatMulNBitsGemv(cudaStream_t stream, T* output, const T* a, const uint8_t* b, const T* scales,
+                       const uint8_t* zero_points, int m, int n, int k, int bits, int block_size) {
+  const dim3 block(GPU_WARP_SIZE, kWarpsPerBlock);
+  const dim3 grid((n + kWarpsPerBlock - 1) / kWarpsPerBlock, m);
+  if (bits == 4) {
+    MatMulNBitsGemvKernel<T, 4><<<grid, block, 0, stream>>>(output, a, b, scales, zero_points, n, k, block_size);
+  } else {
+    MatMulNBitsGemvKernel<T, 8><<<grid, block, 0, stream>>>(output, a, b, scales, zero_points, n, k, block_size);
+  }
+  return CUDA_CALL(cudaGetLastError());
+}
+
+template <typename T>
+Status DequantizeNBits(cudaStream_t stream, T* output, const uint8_t* b, const T* scales,
+                       const uint8_t* zero_points, int n, int k, int bits, int block_size) {
+  const CUDA_LONG count = static_cast<CUDA_LONG>(n) * k;
+  const int blocks = static_cast<int>(CeilDiv(count, GridDim::maxThreadsPerBlock));
+  if (bits == 4) {
+    DequantizeNBitsKernel<T, 4><<<blocks, GridDim::maxThreadsPerBlock, 0, stream>>>(
+        output, b, scales, zero_points, k, block_size, count);
+  } else {
+    DequantizeNBitsKernel<T, 8><<<blocks, GridDim::maxThreadsPerBlock, 0, stream>>>(
+        output, b, scales, zero_points, k, block_size, count);
+  }
+  return CUDA_CALL(cudaGetLastError());
+}
+
+#define SPECIALIZED_IMPL(T)                                                                                         \
+  template Status MatMulNBitsGemv<T>(cudaStream_t stream, T * output, const T* a, const uint8_t* b,                 \
+                                     const T* scales, const uint8_t* zero_points, int m, int n, int k, int bits,    \
+                                     int block_size);                                                               \
+  template Status DequantizeNBits<T>(cudaStream_t stream, T * output, const uint8_t* b, const T* scales,            \
+                                     const uint8_t* zero_points, int n, int k, int bits, int block_size);
+
+SPECIALIZED_IMPL(float)
+SPECIALIZED_IMPL(half)
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
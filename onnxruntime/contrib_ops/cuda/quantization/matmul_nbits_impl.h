@@ -0,0 +1,26 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/providers/cuda/cuda_common.h"
+#include "core/providers/cuda/shared_inc/cuda_utils.h"
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+// Y[m, n] = sum_k A[m, k] * dequant(B)[n, k], reading each quantized weight once and dequantizing it in registers.
+// Meant for the few rows of A of token generation, where the GEMM is bound by the bandwidth of reading B.
+template <typename T>
+Status MatMulNBitsGemv(cudaStream_t stream, T* output, const T* a, const uint8_t* b, const T* scales,
+                       const uint8_t* zero_points, int m, int n, int k, int bits, int block_size);
+
+// Writes dequant(B) as a row-major [N, K] matrix, for the GEMM of the prompt.
+template <typename T>
+Status DequantizeNBits(cudaStream_t stream, T* output, const uint8_t* b, const T* scales,
+                       const uint8_t* zero_points, int n, int k, int bits, int block_size);
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
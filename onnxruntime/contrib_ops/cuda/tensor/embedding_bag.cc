@@ -0,0 +1,270 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cuda/tensor/embedding_bag.h"
+#include "contrib_ops/cuda/tensor/embedding_bag_impl.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "core/providers/cuda/cuda_execution_provider.h"
+
+using namespace onnxruntime::cuda;
+using namespace onnxruntime::contrib::embedding_bag_helper;
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+// The table, indices, offsets and scales are read on the host, which stages the missing rows of the cache.
+ONNX_OPERATOR_KERNEL_EX(
+    EmbeddingBag,
+    kMSDomain,
+    1,
+    kCudaExecutionProvider,
+    (*KernelDefBuilder::Create())
+        .InputMemoryType(OrtMemTypeCPUInput, 0)
+        .InputMemoryType(OrtMemTypeCPUInput, 1)
+        .InputMemoryType(OrtMemTypeCPUInput, 2)
+        .InputMemoryType(OrtMemTypeCPUInput, 4)
+        .TypeConstraint("T1", {DataTypeImpl::GetTensorType<float>(),
+                               DataTypeImpl::GetTensorType<MLFloat16>(),
+                               DataTypeImpl::GetTensorType<int8_t>()})
+        .TypeConstraint("Tind", {DataTypeImpl::GetTensorType<int32_t>(),
+                                 DataTypeImpl::GetTensorType<int64_t>()}),
+    EmbeddingBag);
+
+namespace {
+
+// Frequencies are halved when one of them reaches this count, so that rows that were hot long ago can be evicted.
+constexpr uint32_t kMaxFrequency = 1u << 30;
+
+// Writes row of the host table as float.
+void StageRow(const Tensor& weight, const Tensor* scales, int64_t row, int64_t dim, float* dst) {
+  if (weight.IsDataType<float>()) {
+    const float* src = weight.Data<float>() + row * dim;
+    std::copy(src, src + dim, dst);
+  } else if (weight.IsDataType<MLFloat16>()) {
+    const MLFloat16* src = weight.Data<MLFloat16>() + row * dim;
+    for (int64_t j = 0; j < dim; ++j) {
+      dst[j] = src[j].ToFloat();
+    }
+  } else {
+    const int8_t* src = weight.Data<int8_t>() + row * dim;
+    const float scale = scales->Data<float>()[row];
+    for (int64_t j = 0; j < dim; ++j) {
+      dst[j] = scale * static_cast<float>(src[j]);
+    }
+  }
+}
+
+}  // namespace
+
+bool EmbeddingRowCache::AssignSlots(gsl::span<const int64_t> rows, gsl::span<int32_t> row_slots,
+                                    std::vector<size_t>& fill_rows, std::vector<int32_t>& fill_slots) {
+  if (static_cast<int64_t>(rows.size()) > capacity) {
+    return false;
+  }
+
+  ++batch;
+  std::vector<size_t> misses;
+  bool age = false;
+  for (size_t r = 0; r < rows.size(); ++r) {
+    auto it = slot_of_row.find(rows[r]);
+    if (it == slot_of_row.end()) {
+      misses.push_back(r);
+      continue;
+    }
+    const int32_t slot = it->second;
+    row_slots[r] = slot;
+    last_batch[slot] = batch;
+    age |= ++frequency[slot] >= kMaxFrequency;
+  }
+
+  if (age) {
+    for (auto& f : frequency) {
+      f >>= 1;
+    }
+  }
+
+  if (misses.empty()) {
+    return true;
+  }
+
+  // Free slots first, then the least frequently used slots outside of the batch. The batch fits in the cache, so
+  // there are enough slots outside of it.
+  std::vector<int32_t> victims;
+  while (victims.size() < misses.size() && num_used_slots < capacity) {
+    victims.push_back(static_cast<int32_t>(num_used_slots++));
+  }
+  if (victims.size() < misses.size()) {
+    std::vector<int32_t> candidates;
+    for (int32_t slot = 0; slot < static_cast<int32_t>(capacity); ++slot) {
+      if (last_batch[slot] != batch) {
+        candidates.push_back(slot);
+      }
+    }
+    const size_t needed = misses.size() - victims.size();
+    std::nth_element(candidates.begin(), candidates.begin() + (needed - 1), candidates.end(),
+                     [this](int32_t a, int32_t b) { return frequency[a] < frequency[b]; });
+    for (size_t k = 0; k < needed; ++k) {
+      slot_of_row.erase(row_of_slot[candidates[k]]);
+      victims.push_back(candidates[k]);
+    }
+  }
+
+  for (size_t k = 0; k < misses.size(); ++k) {
+    const size_t r = misses[k];
+    const int32_t slot = victims[k];
+    slot_of_row[rows[r]] = slot;
+    row_of_slot[slot] = rows[r];
+    frequency[slot] = 1;
+    last_batch[slot] = batch;
+    row_slots[r] = slot;
+    fill_rows.push_back(r);
+    fill_slots.push_back(slot);
+  }
+  return true;
+}
+
+EmbeddingBag::EmbeddingBag(const OpKernelInfo& info) : CudaKernel(info) {
+  mode_ = ParseMode(info.GetAttrOrDefault<std::string>("mode", "sum"));
+  const auto* cuda_ep = static_cast<const CUDAExecutionProvider*>(info.GetExecutionProvider());
+  cache_size_in_bytes_ = cuda_ep->GetEmbeddingCacheSizeInMB() * 1024 * 1024;
+  CUDA_CALL_THROW(cudaEventCreateWithFlags(&cache_.read_done, cudaEventDisableTiming));
+}
+
+EmbeddingBag::~EmbeddingBag() {
+  if (cache_.read_done != nullptr) {
+    cudaEventDestroy(cache_.read_done);
+  }
+}
+
+Status EmbeddingBag::ComputeInternal(OpKernelContext* context) const {
+  const Tensor* indices = context->Input<Tensor>(1);
+  if (indices->IsDataType<int32_t>()) {
+    return ComputeImpl<int32_t>(context);
+  }
+  return ComputeImpl<int64_t>(context);
+}
+
+template <typename TIndex>
+Status EmbeddingBag::ComputeImpl(OpKernelContext* context) const {
+  const Tensor* weight = context->Input<Tensor>(0);
+  const Tensor* indices = context->Input<Tensor>(1);
+  const Tensor* offsets = context->Input<Tensor>(2);
+  const Tensor* per_sample_weights = context->Input<Tensor>(3);
+  const Tensor* scales = context->Input<Tensor>(4);
+
+  EmbeddingBagParameters parameters = {};
+  ORT_RETURN_IF_ERROR(CheckInputs<TIndex>(weight, indices, offsets, per_sample_weights, scales, mode_ == Mode::kSum,
+                                          parameters));
+  const int64_t num_embeddings = parameters.num_embeddings;
+  const int64_t dim = parameters.dim;
+  const int64_t num_indices = parameters.num_indices;
+  const int64_t num_bags = parameters.num_bags;
+  ORT_RETURN_IF(num_indices > std::numeric_limits<int32_t>::max() || dim > std::numeric_limits<int32_t>::max(),
+                "EmbeddingBag supports up to 2^31 - 1 indices and embedding dimensions");
+
+  Tensor* output = context->Output(0, {num_bags, dim});
+  if (output->Shape().Size() == 0) {
+    return Status::OK();
+  }
+
+  auto* ort_stream = context->GetComputeStream();
+  cudaStream_t stream = Stream(context);
+
+  // Distinct rows of the batch in order of first use, and the distinct row of each lookup
+  const TIndex* indices_data = indices->Data<TIndex>();
+  InlinedHashMap<int64_t, int32_t> distinct_of_row;
+  std::vector<int64_t> rows;
+  std::vector<int32_t> lookup_distinct(static_cast<size_t>(num_indices));
+  for (int64_t i = 0; i < num_indices; ++i) {
+    const int64_t row = RowOfIndex(static_cast<int64_t>(indices_data[i]), num_embeddings);
+    auto result = distinct_of_row.emplace(row, static_cast<int32_t>(rows.size()));
+    if (result.second) {
+      rows.push_back(row);
+    }
+    lookup_distinct[i] = result.first->second;
+  }
+
+  CudaAsyncBuffer<int32_t> bag_starts(this, static_cast<size_t>(num_bags) + 1);
+  for (size_t b = 0; b < parameters.bag_starts.size(); ++b) {
+    bag_starts.CpuPtr()[b] = static_cast<int32_t>(parameters.bag_starts[b]);
+  }
+  ORT_RETURN_IF_ERROR(bag_starts.CopyToGpu(ort_stream));
+
+  std::lock_guard<std::mutex> lock(cache_.mutex);
+  if (cache_.table == nullptr) {
+    const int64_t row_bytes = dim * static_cast<int64_t>(sizeof(float));
+    cache_.capacity = cache_size_in_bytes_ == 0
+                          ? num_embeddings
+                          : std::min<int64_t>(num_embeddings, static_cast<int64_t>(cache_size_in_bytes_) / row_bytes);
+    cache_.capacity = std::min<int64_t>(cache_.capacity, std::numeric_limits<int32_t>::max());
+    if (cache_.capacity > 0) {
+      cache_.table = IAllocator::MakeUniquePtr<float>(Info().GetAllocator(OrtMemType::OrtMemTypeDefault),
+                                                      static_cast<size_t>(cache_.capacity * dim));
+      cache_.row_of_slot.resize(static_cast<size_t>(cache_.capacity));
+      cache_.frequency.resize(static_cast<size_t>(cache_.capacity));
+      cache_.last_batch.resize(static_cast<size_t>(cache_.capacity));
+    }
+  }
+
+  std::vector<int32_t> row_slots(rows.size());
+  std::vector<size_t> fill_rows;
+  std::vector<int32_t> fill_slots;
+  const bool cached = cache_.AssignSlots(rows, row_slots, fill_rows, fill_slots);
+
+  const float* table = nullptr;
+  CudaAsyncBuffer<float> staged_rows(this);
+  CudaAsyncBuffer<int32_t> slots(this, static_cast<size_t>(num_indices));
+  if (cached) {
+    if (!fill_rows.empty()) {
+      staged_rows.AllocCpuPtr(fill_rows.size() * static_cast<size_t>(dim));
+      for (size_t k = 0; k < fill_rows.size(); ++k) {
+        StageRow(*weight, scales, rows[fill_rows[k]], dim, staged_rows.CpuPtr() + k * dim);
+      }
+      CudaAsyncBuffer<int32_t> staged_slots(this, gsl::make_span(fill_slots));
+      ORT_RETURN_IF_ERROR(staged_rows.CopyToGpu(ort_stream));
+      ORT_RETURN_IF_ERROR(staged_slots.CopyToGpu(ort_stream));
+
+      // the evicted rows may still be read by a run on another stream
+      if (cache_.has_read) {
+        CUDA_RETURN_IF_ERROR(cudaStreamWaitEvent(stream, cache_.read_done, 0));
+      }
+      ORT_RETURN_IF_ERROR(ScatterEmbeddingRows(stream, cache_.table.get(), staged_rows.GpuPtr(),
+                                               staged_slots.GpuPtr(), static_cast<int>(fill_rows.size()),
+                                               static_cast<int>(dim)));
+    }
+    table = cache_.table.get();
+    for (int64_t i = 0; i < num_indices; ++i) {
+      slots.CpuPtr()[i] = row_slots[lookup_distinct[i]];
+    }
+  } else {
+    // The batch needs more rows than the cache holds, so its rows are staged for this run only
+    staged_rows.AllocCpuPtr(rows.size() * static_cast<size_t>(dim));
+    for (size_t r = 0; r < rows.size(); ++r) {
+      StageRow(*weight, scales, rows[r], dim, staged_rows.CpuPtr() + r * dim);
+    }
+    ORT_RETURN_IF_ERROR(staged_rows.CopyToGpu(ort_stream));
+    table = staged_rows.GpuPtr();
+    std::copy(lookup_distinct.begin(), lookup_distinct.end(), slots.CpuPtr());
+  }
+  ORT_RETURN_IF_ERROR(slots.CopyToGpu(ort_stream));
+
+  ORT_RETURN_IF_ERROR(EmbeddingBagReduce(stream, output->MutableData<float>(), table, slots.GpuPtr(),
+                                         bag_starts.GpuPtr(),
+                                         per_sample_weights ? per_sample_weights->Data<float>() : nullptr,
+                                         static_cast<int>(num_bags), static_cast<int>(dim), static_cast<int>(mode_)));
+
+  if (cached) {
+    CUDA_RETURN_IF_ERROR(cudaEventRecord(cache_.read_done, stream));
+    cache_.has_read = true;
+  }
+
+  return Status::OK();
+}
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,62 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <mutex>
+#include <vector>
+
+#include "core/providers/cuda/cuda_kernel.h"
+#include "contrib_ops/cpu/embedding_bag_helper.h"
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+// Cache of rows of an embedding table in GPU memory. Each slot holds one row as float, and when the cache is full
+// the least frequently used rows are evicted.
+struct EmbeddingRowCache {
+  // Assigns a slot to each of the distinct rows of a batch, keeping the rows already cached and evicting rows
+  // outside of the batch for the others. The rows whose slot must be filled are appended to fill_rows, as indices
+  // into rows, along with their slots to fill_slots. Returns false if the rows do not fit in the cache.
+  bool AssignSlots(gsl::span<const int64_t> rows, gsl::span<int32_t> row_slots, std::vector<size_t>& fill_rows,
+                   std::vector<int32_t>& fill_slots);
+
+  std::mutex mutex;
+  IAllocatorUniquePtr<float> table;  // [capacity, dim]
+  int64_t capacity = 0;
+  int64_t num_used_slots = 0;
+  InlinedHashMap<int64_t, int32_t> slot_of_row;
+  std::vector<int64_t> row_of_slot;
+  std::vector<uint32_t> frequency;
+  // Number of the last batch that used each slot, which must not be evicted while the batch is assigned
+  std::vector<uint64_t> last_batch;
+  uint64_t batch = 0;
+  // Recorded after the last kernel reading the cache, so that the rows it reads are not overwritten
+  // by a later run on another stream before it completes.
+  cudaEvent_t read_done = nullptr;
+  bool has_read = false;
+};
+
+// EmbeddingBag keeps the table in host memory and caches the rows it looks up on the GPU, so that tables larger
+// than the GPU memory can be used. The lookups of a batch are reduced from the cache after the missing rows are
+// staged in pinned memory and copied to their slots in one transfer.
+class EmbeddingBag final : public onnxruntime::cuda::CudaKernel {
+ public:
+  EmbeddingBag(const OpKernelInfo& info);
+  ~EmbeddingBag();
+
+  Status ComputeInternal(OpKernelContext* context) const override;
+
+ private:
+  template <typename TIndex>
+  Status ComputeImpl(OpKernelContext* context) const;
+
+  embedding_bag_helper::Mode mode_;
+  size_t cache_size_in_bytes_;
+  mutable EmbeddingRowCache cache_;
+};
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
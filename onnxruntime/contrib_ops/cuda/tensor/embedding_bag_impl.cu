@@ -0,0 +1,81 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/providers/cuda/cu_inc/common.cuh"
+#include "contrib_ops/cuda/tensor/embedding_bag_impl.h"
+
+using namespace onnxruntime::cuda;
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+namespace {
+
+constexpr int kThreadsPerBlock = 128;
+
+__global__ void ScatterEmbeddingRowsKernel(float* table, const float* rows, const int32_t* slots, int dim,
+                                           CUDA_LONG count) {
+  CALCULATE_ELEMENTWISE_INDEX_OR_EXIT(id, count);
+  const int r = static_cast<int>(id / dim);
+  const int j = static_cast<int>(id % dim);
+  table[static_cast<int64_t>(slots[r]) * dim + j] = rows[id];
+}
+
+// blockIdx.x is the bag and each thread reduces one element of the embedding dimension, so that the threads of a
+// warp read consecutive elements of the same row.
+__global__ void EmbeddingBagReduceKernel(float* output, const float* table, const int32_t* slots,
+                                         const int32_t* bag_starts, const float* per_sample_weights, int dim,
+                                         int mode) {
+  const int b = blockIdx.x;
+  const int j = blockIdx.y * kThreadsPerBlock + threadIdx.x;
+  if (j >= dim) {
+    return;
+  }
+
+  const int begin = bag_starts[b];
+  const int end = bag_starts[b + 1];
+  float result = 0.0f;
+  for (int i = begin; i < end; ++i) {
+    float value = table[static_cast<int64_t>(slots[i]) * dim + j];
+    if (per_sample_weights != nullptr) {
+      value *= per_sample_weights[i];
+    }
+    if (i == begin) {
+      result = value;
+    } else {
+      result = (mode == 2) ? fmaxf(result, value) : result + value;
+    }
+  }
+
+  if (mode == 1 && end > begin) {
+    result /= static_cast<float>(end - begin);
+  }
+  output[static_cast<int64_t>(b) * dim + j] = result;
+}
+
+}  // namespace
+
+Status ScatterEmbeddingRows(cudaStream_t stream, float* table, const float* rows, const int32_t* slots, int num_rows,
+                            int dim) {
+  const CUDA_LONG count = static_cast<CUDA_LONG>(num_rows) * dim;
+  if (count == 0) {
+    return Status::OK();
+  }
+  const int blocks = static_cast<int>(CeilDiv(count, GridDim::maxThreadsPerBlock));
+  ScatterEmbeddingRowsKernel<<<blocks, GridDim::maxThreadsPerBlock, 0, stream>>>(table, rows, slots, dim, count);
+  return CUDA_CALL(cudaGetLastError());
+}
+
+Status EmbeddingBagReduce(cudaStream_t stream, float* output, const float* table, const int32_t* slots,
+                          const int32_t* bag_starts, const float* per_sample_weights, int num_bags, int dim,
+                          int mode) {
+  const dim3 grid(static_cast<unsigned>(num_bags), static_cast<unsigned>(CeilDiv(dim, kThreadsPerBlock)));
+  EmbeddingBagReduceKernel<<<grid, kThreadsPerBlock, 0, stream>>>(output, table, slots, bag_starts,
+                                                                   per_sample_weights, dim, mode);
+  return CUDA_CALL(cudaGetLastError());
+}
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,24 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/providers/cuda/cuda_common.h"
+#include "core/providers/cuda/shared_inc/cuda_utils.h"
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+// table[slots[r], :] = rows[r, :] for the num_rows rows staged in rows.
+Status ScatterEmbeddingRows(cudaStream_t stream, float* table, const float* rows, const int32_t* slots, int num_rows,
+                            int dim);
+
+// output[b, :] reduces the rows table[slots[i], :] of the lookups i in [bag_starts[b], bag_starts[b + 1]) with the
+// sum (each row scaled by per_sample_weights[i] when given), the mean or the max. mode is embedding_bag_helper::Mode.
+Status EmbeddingBagReduce(cudaStream_t stream, float* output, const float* table, const int32_t* slots,
+                          const int32_t* bag_starts, const float* per_sample_weights, int num_bags, int dim, int mode);
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,67 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "image_preprocess.h"
+#include "image_preprocess_impl.h"
+#include "contrib_ops/cpu/image_preprocess_helper.h"
+
+using namespace onnxruntime::cuda;
+using namespace onnxruntime::contrib::image_preprocess_helper;
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+ONNX_OPERATOR_KERNEL_EX(
+    ImagePreprocess,
+    kMSDomain,
+    1,
+    kCudaExecutionProvider,
+    (*KernelDefBuilder::Create()),
+    ImagePreprocess);
+
+ImagePreprocess::ImagePreprocess(const OpKernelInfo& info) : CudaKernel(info) {
+  ORT_ENFORCE(info.GetAttrs("size", size_).IsOK() && size_.size() == 2 && size_[0] > 0 && size_[1] > 0,
+              "attribute size must be two positive values");
+  const auto scale = info.GetAttrOrDefault<float>("scale", 1.0f);
+  const auto mean = info.GetAttrsOrDefault<float>("mean");
+  const auto std_dev = info.GetAttrsOrDefault<float>("std");
+  std::vector<float> coefficients;
+  std::vector<float> channel_bias;
+  ComputeChannelCoefficients(scale, mean, std_dev, coefficients, channel_bias);
+  num_coefficients_ = coefficients.size();
+  coefficients.insert(coefficients.end(), channel_bias.begin(), channel_bias.end());
+
+  coefficients_ = GetScratchBuffer<float>(coefficients.size(), nullptr);
+  // the transfer in kernel construction need to be sync on default stream.
+  CUDA_CALL_THROW(cudaMemcpyAsync(coefficients_.get(), coefficients.data(), sizeof(float) * coefficients.size(),
+                                  cudaMemcpyHostToDevice, nullptr));
+  CUDA_CALL_THROW(cudaStreamSynchronize(nullptr));
+}
+
+Status ImagePreprocess::ComputeInternal(OpKernelContext* context) const {
+  const Tensor* X = context->Input<Tensor>(0);
+  TensorShapeVector output_dims;
+  ORT_RETURN_IF_ERROR(ComputeOutputShape(X->Shape(), size_, num_coefficients_, output_dims));
+  Tensor* Y = context->Output(0, output_dims);
+  if (Y->Shape().Size() == 0) {
+    return Status::OK();
+  }
+
+  ImagePreprocessImpl(
+      Stream(context),
+      X->Data<uint8_t>(),
+      coefficients_.get(),
+      coefficients_.get() + num_coefficients_,
+      num_coefficients_ > 1,
+      X->Shape().GetDims().data(),
+      size_[0],
+      size_[1],
+      Y->MutableData<float>());
+
+  return Status::OK();
+}
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,30 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/providers/cuda/cuda_kernel.h"
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+using namespace onnxruntime::cuda;
+
+class ImagePreprocess final : public CudaKernel {
+ public:
+  ImagePreprocess(const OpKernelInfo& info);
+  Status ComputeInternal(OpKernelContext* context) const override;
+
+ private:
+  std::vector<int64_t> size_;
+  size_t num_coefficients_;
+  IAllocatorUniquePtr<float> coefficients_;  // gpu copy of the channel scales followed by the channel biases
+};
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
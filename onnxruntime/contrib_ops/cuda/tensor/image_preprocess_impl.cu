@@ -0,0 +1,89 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/providers/cuda/cu_inc/common.cuh"
+#include "image_preprocess_impl.h"
+
+using namespace onnxruntime::cuda;
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+// Finds the two input pixels around the center of output pixel `out` and the weight of the second one, as the CPU
+// kernel does with the half_pixel coordinate transformation of Resize.
+__device__ __forceinline__ void _BilinearTaps(int out, float scale, int input_length, int& in1, int& in2,
+                                              float& weight2) {
+  float in = scale == 1.0f ? static_cast<float>(out) : (static_cast<float>(out) + 0.5f) / scale - 0.5f;
+  in = fmaxf(0.0f, fminf(in, static_cast<float>(input_length - 1)));
+  in1 = min(static_cast<int>(in), input_length - 1);
+  in2 = min(in1 + 1, input_length - 1);
+  weight2 = in - static_cast<float>(in1);
+}
+
+__global__ void _ImagePreprocessKernel(
+    const uint8_t* input_data,
+    const float* channel_scale,
+    const float* channel_bias,
+    const bool per_channel,
+    const int input_height,
+    const int input_width,
+    const int num_channels,
+    const float height_scale,
+    const float width_scale,
+    const fast_divmod fdm_C,
+    const fast_divmod fdm_HW,
+    const fast_divmod fdm_W,
+    float* output_data,
+    const CUDA_LONG N) {
+  CALCULATE_ELEMENTWISE_INDEX_OR_EXIT(id, N);
+
+  // one thread per output value, consecutive threads write consecutive x of an output plane
+  int nc, yx, n, c, y, x;
+  fdm_HW.divmod(id, nc, yx);
+  fdm_C.divmod(nc, n, c);
+  fdm_W.divmod(yx, y, x);
+
+  int y1, y2, x1, x2;
+  float dy1, dx1;
+  _BilinearTaps(y, height_scale, input_height, y1, y2, dy1);
+  _BilinearTaps(x, width_scale, input_width, x1, x2, dx1);
+
+  const uint8_t* image = input_data + static_cast<int64_t>(n) * input_height * input_width * num_channels + c;
+  const uint8_t* row1 = image + static_cast<int64_t>(y1) * input_width * num_channels;
+  const uint8_t* row2 = image + static_cast<int64_t>(y2) * input_width * num_channels;
+  const float top = (1.0f - dx1) * row1[x1 * num_channels] + dx1 * row1[x2 * num_channels];
+  const float bottom = (1.0f - dx1) * row2[x1 * num_channels] + dx1 * row2[x2 * num_channels];
+  const float value = (1.0f - dy1) * top + dy1 * bottom;
+
+  const int coefficient = per_channel ? c : 0;
+  output_data[id] = value * channel_scale[coefficient] + channel_bias[coefficient];
+}
+
+void ImagePreprocessImpl(
+    cudaStream_t stream,
+    const uint8_t* input_data,
+    const float* channel_scale,
+    const float* channel_bias,
+    bool per_channel,
+    const int64_t input_dims[4],  // NHWC
+    int64_t output_height,
+    int64_t output_width,
+    float* output_data) {
+  const int input_height = static_cast<int>(input_dims[1]);
+  const int input_width = static_cast<int>(input_dims[2]);
+  const int num_channels = static_cast<int>(input_dims[3]);
+  const CUDA_LONG N = static_cast<CUDA_LONG>(input_dims[0] * num_channels * output_height * output_width);
+  const int blocksPerGrid = static_cast<int>(CeilDiv(N, GridDim::maxThreadsPerBlock));
+
+  _ImagePreprocessKernel<<<blocksPerGrid, GridDim::maxThreadsPerBlock, 0, stream>>>(
+      input_data, channel_scale, channel_bias, per_channel, input_height, input_width, num_channels,
+      static_cast<float>(output_height) / static_cast<float>(input_height),
+      static_cast<float>(output_width) / static_cast<float>(input_width),
+      fast_divmod(num_channels), fast_divmod(static_cast<int>(output_height * output_width)),
+      fast_divmod(static_cast<int>(output_width)), output_data, N);
+}
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,27 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+#include "core/providers/cuda/shared_inc/cuda_utils.h"
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+// Resizes the (N, H, W, C) uint8 images to (N, C, output_height, output_width) float ones, bilinearly with half pixel
+// centers, and normalizes them with x * channel_scale[c] + channel_bias[c]. There are num_channels coefficients
+// of each kind, or one applied to all the channels.
+void ImagePreprocessImpl(
+    cudaStream_t stream,
+    const uint8_t* input_data,
+    const float* channel_scale,
+    const float* channel_bias,
+    bool per_channel,
+    const int64_t input_dims[4],
+    int64_t output_height,
+    int64_t output_width,
+    float* output_data);
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -1315,6 +1315,71 @@ template void BufferExpansionKernelLauncher(const int32_t* input,
                                             int chunk_size,
                                             cudaStream_t stream);
 
+template <typename T>
+__global__ void BeamGatherKernel(const T* input,
+                                 T* output,
+                                 const int32_t* beam_indices,
+                                 int chunk_size) {
+  const int beam_id = blockIdx.x;
+  const int idx = blockIdx.y * blockDim.x + threadIdx.x;
+
+  if (idx < chunk_size) {
+    const int64_t input_offset = static_cast<int64_t>(beam_indices[beam_id]) * chunk_size + idx;
+    const int64_t output_offset = static_cast<int64_t>(beam_id) * chunk_size + idx;
+    output[output_offset] = input[input_offset];
+  }
+}
+
+template <typename T>
+void BeamGatherKernelLauncher(const T* input,
+                              T* output,
+                              const int32_t* beam_indices,
+                              int batch_beam_size,
+                              int chunk_size,
+                              cudaStream_t stream) {
+  const dim3 block(128);
+
+#ifndef USE_ROCM
+  if ((chunk_size % 4) == 0) {
+    using vec_type = typename TypeMapper<T, 4>::Type;
+    const dim3 grid(batch_beam_size, (chunk_size / 4 + block.x - 1) / block.x);
+    BeamGatherKernel<<<grid, block, 0, stream>>>(reinterpret_cast<const vec_type*>(input),
+                                                 reinterpret_cast<vec_type*>(output),
+                                                 beam_indices,
+                                                 chunk_size / 4);
+  } else if ((chunk_size & 1) == 0) {
+    using vec_type = typename TypeMapper<T, 2>::Type;
+    const dim3 grid(batch_beam_size, (chunk_size / 2 + block.x - 1) / block.x);
+    BeamGatherKernel<<<grid, block, 0, stream>>>(reinterpret_cast<const vec_type*>(input),
+                                                 reinterpret_cast<vec_type*>(output),
+                                                 beam_indices,
+                                                 chunk_size / 2);
+  } else {
+#endif
+    const dim3 grid(batch_beam_size, (chunk_size + block.x - 1) / block.x);
+    BeamGatherKernel<<<grid, block, 0, stream>>>(input,
+                                                 output,
+                                                 beam_indices,
+                                                 chunk_size);
+#ifndef USE_ROCM
+  }
+#endif
+}
+
+template void BeamGatherKernelLauncher(const float* input,
+                                       float* output,
+                                       const int32_t* beam_indices,
+                                       int batch_beam_size,
+                                       int chunk_size,
+                                       cudaStream_t stream);
+
+template void BeamGatherKernelLauncher(const half* input,
+                                       half* output,
+                                       const int32_t* beam_indices,
+                                       int batch_beam_size,
+                                       int chunk_size,
+                                       cudaStream_t stream);
+
 }  // namespace cuda
 }  // namespace contrib
 }  // namespace onnxruntime
@@ -213,6 +213,15 @@ void BufferExpansionKernelLauncher(const T* input,
                                    int chunk_size,
                                    cudaStream_t stream);
 
+// Reorders the beams of a past state: output[i] = input[beam_indices[i]], where each beam is chunk_size elements.
+template <typename T>
+void BeamGatherKernelLauncher(const T* input,
+                              T* output,
+                              const int32_t* beam_indices,
+                              int batch_beam_size,
+                              int chunk_size,
+                              cudaStream_t stream);
+
 }  // namespace cuda
 }  // namespace contrib
 }  // namespace onnxruntime
@@ -925,14 +925,18 @@ Status DeviceCopy(gsl::span<T> target, gsl::span<const T> source, Stream* ort_st
   return Status::OK();
 }
 
+// Copy present state to past state for GPT model. The beams are reordered by a gather on the device indices of the
+// beam scorer, with one kernel for the keys and one for the values of each layer.
 template <typename T>
 Status PickGptPastState(const std::vector<OrtValue>& last_outputs,
                         std::vector<OrtValue>& next_inputs,
-                        gsl::span<const int32_t>& beam_indices,
+                        gsl::span<const int32_t>& beam_indices_gpu,
                         AllocatorPtr allocator,
                         ptrdiff_t gpt_subgraph_first_past_input_idx,
                         ptrdiff_t gpt_subgraph_first_present_output_idx,
                         Stream* ort_stream) {
+  using CudaT = typename ToCudaTypeWrapper<T>::MappedType;
+  cudaStream_t cuda_stream = ort_stream ? static_cast<cudaStream_t>(ort_stream->GetHandle()) : nullptr;
   ptrdiff_t num_present_tensors = static_cast<ptrdiff_t>(last_outputs.size()) - gpt_subgraph_first_present_output_idx;
   for (int i = 0; i < num_present_tensors; ++i) {
     const OrtValue& present = last_outputs[gpt_subgraph_first_present_output_idx + i];
@@ -943,28 +947,22 @@ Status PickGptPastState(const std::vector<OrtValue>& last_outputs,
     auto past_key_size = past_shape[1] * past_shape[2] * past_shape[3] * past_shape[4];
 
     // Create a tensor with same shape.
-    // TODO(tianleiwu): allocate one buffer for all layers, and use a CUDA kernel to copy key/value cache data.
+    // TODO(tianleiwu): allocate one buffer for all layers
     OrtValue past;
     auto past_type = DataTypeImpl::GetType<T>();
     Tensor::InitOrtValue(past_type, past_shape, allocator, past);
-    cudaStream_t cuda_stream = ort_stream ? static_cast<cudaStream_t>(ort_stream->GetHandle()) : nullptr;
-
-    gsl::span<T> past_span = gsl::make_span<T>(past.GetMutable<Tensor>()->MutableData<T>(), past_shape.Size());
-    gsl::span<const T> present_span = gsl::make_span<const T>(present.Get<Tensor>().Data<T>(), past_shape.Size());
 
-    for (size_t j = 0; j < beam_indices.size(); j++) {
-      int32_t beam_index = beam_indices[j];
-      gsl::span<const T> present_key = present_span.subspan(beam_index * block_size_per_beam, block_size_per_beam);
-      gsl::span<const T> present_value = present_span.subspan(past_key_size + beam_index * block_size_per_beam,
-                                                              block_size_per_beam);
-
-      gsl::span<T> past_key = past_span.subspan(j * block_size_per_beam, block_size_per_beam);
-      gsl::span<T> past_value = past_span.subspan(past_key_size + j * block_size_per_beam, block_size_per_beam);
-      CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(past_key.data(), present_key.data(), present_key.size_bytes(),
-                                           cudaMemcpyDeviceToDevice, cuda_stream));
-      CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(past_value.data(), present_value.data(), present_value.size_bytes(),
-                                           cudaMemcpyDeviceToDevice, cuda_stream));
+    const CudaT* present_data = reinterpret_cast<const CudaT*>(present.Get<Tensor>().Data<T>());
+    CudaT* past_data = reinterpret_cast<CudaT*>(past.GetMutable<Tensor>()->MutableData<T>());
+    for (int64_t offset : {static_cast<int64_t>(0), past_key_size}) {
+      cuda::BeamGatherKernelLauncher<CudaT>(present_data + offset,
+                                            past_data + offset,
+                                            beam_indices_gpu.data(),
+                                            gsl::narrow<int>(beam_indices_gpu.size()),
+                                            gsl::narrow<int>(block_size_per_beam),
+                                            cuda_stream);
     }
+    CUDA_RETURN_IF_ERROR(cudaGetLastError());
 
     next_inputs[gpt_subgraph_first_past_input_idx + i] = past;
   }
@@ -972,16 +970,18 @@ Status PickGptPastState(const std::vector<OrtValue>& last_outputs,
   return Status::OK();
 }
 
-// Copy present state to past state for T5 model
+// Copy present state to past state for T5 model. The beams are reordered by a gather on the device indices of the
+// beam scorer, with one kernel per tensor.
 template <typename T>
 Status PickT5PastState(const std::vector<OrtValue>& last_outputs,
                        std::vector<OrtValue>& next_inputs,
                        int num_present_tensors,
-                       gsl::span<const int32_t>& beam_indices,
+                       gsl::span<const int32_t>& beam_indices_gpu,
                        AllocatorPtr allocator,
                        ptrdiff_t t5_decoder_first_past_input_idx,
                        ptrdiff_t t5_decoder_first_present_output_idx,
                        Stream* ort_stream) {
+  using CudaT = typename ToCudaTypeWrapper<T>::MappedType;
   cudaStream_t cuda_stream = ort_stream ? static_cast<cudaStream_t>(ort_stream->GetHandle()) : nullptr;
   for (int i = 0; i < num_present_tensors; ++i) {
     const OrtValue& present = last_outputs[t5_decoder_first_present_output_idx + i];
@@ -991,19 +991,17 @@ Status PickT5PastState(const std::vector<OrtValue>& last_outputs,
     auto block_size_per_beam = past_shape[1] * past_shape[2] * past_shape[3];
 
     // Create a tensor with same shape.
-    // TODO(tianleiwu): allocate one buffer for all layers, and use a CUDA kernel to copy key/value cache data.
+    // TODO(tianleiwu): allocate one buffer for all layers
     OrtValue past;
     Tensor::InitOrtValue(DataTypeImpl::GetType<T>(), past_shape, allocator, past);
 
-    gsl::span<T> past_span = gsl::make_span<T>(past.GetMutable<Tensor>()->MutableData<T>(), past_shape.Size());
-    gsl::span<const T> present_span = gsl::make_span<const T>(present.Get<Tensor>().Data<T>(), past_shape.Size());
-    for (size_t j = 0; j < beam_indices.size(); j++) {
-      int32_t beam_index = beam_indices[j];
-      gsl::span<const T> present_beam = present_span.subspan(beam_index * block_size_per_beam, block_size_per_beam);
-      gsl::span<T> past_beam = past_span.subspan(j * block_size_per_beam, block_size_per_beam);
-      CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(past_beam.data(), present_beam.data(), present_beam.size_bytes(),
-                                           cudaMemcpyDeviceToDevice, cuda_stream));
-    }
+    cuda::BeamGatherKernelLauncher<CudaT>(reinterpret_cast<const CudaT*>(present.Get<Tensor>().Data<T>()),
+                                          reinterpret_cast<CudaT*>(past.GetMutable<Tensor>()->MutableData<T>()),
+                                          beam_indices_gpu.data(),
+                                          gsl::narrow<int>(beam_indices_gpu.size()),
+                                          gsl::narrow<int>(block_size_per_beam),
+                                          cuda_stream);
+    CUDA_RETURN_IF_ERROR(cudaGetLastError());
 
     next_inputs[t5_decoder_first_past_input_idx + i] = past;
   }
@@ -1030,6 +1028,8 @@ Status UpdateGptFeeds(
     int past_sequence_len,
     int input_sequence_len,
     bool need_cache_indir) {
+  // The beams are reordered with beam_indices_gpu, so that the indices do not need to be copied to the host.
+  ORT_UNUSED_PARAMETER(beam_indices_cpu);
 #ifdef ENABLE_NVTX_PROFILE
   profile::NvtxNestedRangeCreator updateFeedsRange("UpdateGptFeeds", profile::Color::Yellow);
   updateFeedsRange.Begin();
@@ -1113,11 +1113,11 @@ Status UpdateGptFeeds(
         next_inputs[i + k] = last_outputs[i];
       }
     } else {
-      ORT_RETURN_IF_ERROR(PickGptPastState<T>(last_outputs, next_inputs, beam_indices_cpu, allocator,
+      ORT_ENFORCE(!beam_indices_gpu.empty(), "Beam indices must be present on CUDA to reorder the past state");
+      // The subgraph runs on the same stream, so it sees the reordered past state without a synchronization.
+      ORT_RETURN_IF_ERROR(PickGptPastState<T>(last_outputs, next_inputs, beam_indices_gpu, allocator,
                                               gpt_subgraph_first_past_input_idx,
                                               gpt_subgraph_first_present_output_idx, ort_stream));
-      // Make sure data is ready before next subgraph execution.
-      CUDA_RETURN_IF_ERROR(cudaStreamSynchronize(cuda_stream));
     }
   }
 
@@ -1149,6 +1149,8 @@ Status UpdateDecoderFeeds(
     bool need_cache_indir,
     transformers::Sequences& sequences,
     const transformers::IConsoleDumper* dumper) {
+  // The beams are reordered with beam_indices_gpu, so that the indices do not need to be copied to the host.
+  ORT_UNUSED_PARAMETER(beam_indices);
   // last_outputs: logits, present_key_self_0, present_value_self_0, ...
   // next_inputs: input_ids,
   //              encoder_attention_mask, encoder_hidden_states,
@@ -1194,7 +1196,9 @@ Status UpdateDecoderFeeds(
 
   if (past_present_share_buffer) {
     // Update past sequence length input
-    const ptrdiff_t past_sequence_length_idx = 2 * (static_cast<ptrdiff_t>(last_outputs.size()) - t5_decoder_first_present_output_idx) + t5_decoder_first_past_input_idx;
+    // The decoder may also return the cross attention keys and values, so count the past inputs from the self
+    // attention ones: num_present_tensors self attention past inputs followed by as many cross attention ones.
+    const ptrdiff_t past_sequence_length_idx = 2 * static_cast<ptrdiff_t>(num_present_tensors) + t5_decoder_first_past_input_idx;
     *(next_inputs[past_sequence_length_idx].GetMutable<Tensor>()->MutableData<int32_t>()) = current_length - 1;
 
     // Update beam search specific input for DecoderMaskedSelfAttention (cache indirection) if present
@@ -1240,7 +1244,8 @@ Status UpdateDecoderFeeds(
       return Status::OK();
     }
 
-    return PickT5PastState<T>(last_outputs, next_inputs, num_present_tensors, beam_indices, allocator,
+    ORT_ENFORCE(!beam_indices_gpu.empty(), "Beam indices must be present on CUDA to reorder the past state");
+    return PickT5PastState<T>(last_outputs, next_inputs, num_present_tensors, beam_indices_gpu, allocator,
                               t5_decoder_first_past_input_idx, t5_decoder_first_present_output_idx, ort_stream);
   }
 
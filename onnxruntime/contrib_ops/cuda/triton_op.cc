@@ -0,0 +1,168 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#ifdef USE_TRITON_KERNEL
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/providers/cuda/cuda_kernel.h"
+#include "core/providers/cuda/triton_kernel.h"
+#include "core/providers/cuda/tunable/cuda_tunable.h"
+
+using namespace onnxruntime::cuda;
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+struct TritonOpParams : OpParams {
+  TritonOpParams(CudaTuningContext* tuning_ctx, cudaStream_t stream, const std::string& group_name, void* output,
+                 std::vector<const void*>&& inputs, int n_rows, int n_cols)
+      : OpParams(tuning_ctx, stream), group_name(group_name), output(output), inputs(std::move(inputs)),
+        n_rows(n_rows), n_cols(n_cols) {}
+
+  std::string Signature() const override {
+    return group_name + "_" + std::to_string(n_rows) + "_" + std::to_string(n_cols);
+  }
+
+  const std::string& group_name;
+  void* output;
+  std::vector<const void*> inputs;
+  int n_rows;
+  int n_cols;
+};
+
+// A kernel of a group, with the compile-time constants that specialize it to the shape of the inputs:
+// a program covers ROW_BLOCK_SIZE rows of at most BLOCK_SIZE columns.
+struct TritonOpKernel {
+  size_t id;
+  int block_size;
+  int row_block_size;
+
+  Status operator()(const TritonOpParams* params) const {
+    TUNABLE_OP_RETURN_UNSUPPORTED_ARGUMENT_IF(block_size < params->n_cols,
+                                              "BLOCK_SIZE ", block_size, " is less than n_cols ", params->n_cols);
+
+    // The parameters are packed in the order of the kernel signature: Y, inputs..., n_rows, n_cols.
+    std::vector<char> args(sizeof(void*) * (params->inputs.size() + 1) + sizeof(int) * 2);
+    char* arg = args.data();
+    auto append = [&arg](const void* value, size_t size) {
+      std::memcpy(arg, value, size);
+      arg += size;
+    };
+    append(&params->output, sizeof(void*));
+    for (const void* input : params->inputs) {
+      append(&input, sizeof(void*));
+    }
+    append(&params->n_rows, sizeof(int));
+    append(&params->n_cols, sizeof(int));
+
+    const int grid = (params->n_rows + row_block_size - 1) / row_block_size;
+    return LaunchTritonKernel(params->stream, id, grid, 1, 1, args.data(), args.size());
+  }
+};
+
+class TritonOpTunableOp : public TunableOp<TritonOpParams> {
+ public:
+  explicit TritonOpTunableOp(const std::string& group_name) {
+    const std::vector<int>* ids = GetOrtTritonKernelByGroup(group_name);
+    ORT_ENFORCE(ids != nullptr && !ids->empty(), "No triton kernel is registered in group ", group_name);
+
+    std::vector<TritonOpKernel> kernels;
+    for (int id : *ids) {
+      const auto& constants = GetOrtTritonKernelMetadata(id)->constants;
+      auto block_size = constants.find("BLOCK_SIZE");
+      auto row_block_size = constants.find("ROW_BLOCK_SIZE");
+      kernels.push_back({static_cast<size_t>(id),
+                         block_size != constants.end() ? block_size->second : std::numeric_limits<int>::max(),
+                         row_block_size != constants.end() ? std::max(row_block_size->second, 1) : 1});
+    }
+    std::stable_sort(kernels.begin(), kernels.end(), [](const TritonOpKernel& a, const TritonOpKernel& b) {
+      return a.block_size < b.block_size;
+    });
+
+    // The default op, used when tuning is disabled, is the kernel with the smallest block that covers a row.
+    this->RegisterOp([kernels](const TritonOpParams* params) -> Status {
+      for (const auto& kernel : kernels) {
+        if (kernel.block_size >= params->n_cols) {
+          return kernel(params);
+        }
+      }
+      return ORT_MAKE_STATUS(NONE, INVALID_ARGUMENT, "No kernel in group ", params->group_name,
+                             " supports n_cols ", params->n_cols);
+    });
+    for (const auto& kernel : kernels) {
+      this->RegisterOp(TritonOpKernel{kernel});
+    }
+  }
+};
+
+template <typename T>
+class TritonOp final : public CudaKernel {
+ public:
+  TritonOp(const OpKernelInfo& info) : CudaKernel(info) {
+    typedef typename ToCudaType<T>::MappedType CudaT;
+    group_name_ = info.GetAttr<std::string>("func_name") + "_" + GetDataTypeName<CudaT>();
+    tunable_op_ = std::make_unique<TritonOpTunableOp>(group_name_);
+  }
+
+  Status ComputeInternal(OpKernelContext* context) const override;
+
+ private:
+  std::string group_name_;
+  std::unique_ptr<TritonOpTunableOp> tunable_op_;
+};
+
+#define REGISTER_KERNEL_TYPED(T)                                  \
+  ONNX_OPERATOR_TYPED_KERNEL_EX(                                  \
+      TritonOp,                                                   \
+      kMSDomain,                                                  \
+      1,                                                          \
+      T,                                                          \
+      kCudaExecutionProvider,                                     \
+      (*KernelDefBuilder::Create())                               \
+          .TypeConstraint("T", DataTypeImpl::GetTensorType<T>()), \
+      TritonOp<T>);
+
+REGISTER_KERNEL_TYPED(float)
+REGISTER_KERNEL_TYPED(MLFloat16)
+
+template <typename T>
+Status TritonOp<T>::ComputeInternal(OpKernelContext* context) const {
+  const Tensor* X = context->Input<Tensor>(0);
+  const TensorShape& shape = X->Shape();
+  Tensor* Y = context->Output(0, shape);
+  if (shape.Size() == 0) {
+    return Status::OK();
+  }
+
+  // The inputs are viewed as (n_rows, n_cols) matrices, or as one row broadcast to all of them.
+  const int64_t n_cols = shape.NumDimensions() > 0 ? shape[shape.NumDimensions() - 1] : 1;
+  const int64_t n_rows = shape.Size() / n_cols;
+  ORT_RETURN_IF(n_rows > std::numeric_limits<int>::max() || n_cols > std::numeric_limits<int>::max(),
+                "TritonOp supports up to INT_MAX rows and columns, got ", n_rows, " x ", n_cols);
+
+  std::vector<const void*> inputs;
+  for (int i = 0; i < context->InputCount(); ++i) {
+    const Tensor* input = context->Input<Tensor>(i);
+    ORT_RETURN_IF_NOT(input->Shape() == shape || input->Shape().Size() == n_cols,
+                      "Input ", i, " of TritonOp is expected to have the shape of the first input ", shape,
+                      " or ", n_cols, " elements, got ", input->Shape());
+    inputs.push_back(input->DataRaw());
+  }
+
+  TritonOpParams params(GetTuningContext(), Stream(context), group_name_, Y->MutableDataRaw(), std::move(inputs),
+                        static_cast<int>(n_rows), static_cast<int>(n_cols));
+  return (*tunable_op_)(&params);
+}
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
+
+#endif  // USE_TRITON_KERNEL
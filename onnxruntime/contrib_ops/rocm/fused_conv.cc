@@ -200,19 +200,7 @@ class FusedConv : public onnxruntime::rocm::Conv<T, false> {
                                               fusion_args_);
     }
     if (miopenStatusSuccess != fusion_status) {
-      MIOPEN_RETURN_IF_ERROR(miopenConvolutionForward(this->GetMiopenHandle(context),
-                                                      &alpha,
-                                                      Base::s_.x_tensor,
-                                                      Base::s_.x_data,
-                                                      Base::s_.w_desc,
-                                                      Base::s_.w_data,
-                                                      Base::s_.conv_desc,
-                                                      Base::s_.fwd_algo,
-                                                      &beta,
-                                                      Base::s_.y_tensor,
-                                                      Base::s_.y_data,
-                                                      workspace.get(),
-                                                      Base::s_.workspace_bytes));
+      ORT_RETURN_IF_ERROR(Base::ConvolutionForward(this->GetMiopenHandle(context), workspace.get()));
       if (has_b) {
         MIOPEN_RETURN_IF_ERROR(_miopenAddTensor(this->GetMiopenHandle(context),
                                                 &alpha, Base::s_.b_tensor, Base::s_.b_data,
@@ -4,14 +4,20 @@
 #include "core/common/logging/logging.h"
 #include "core/common/logging/severity.h"
 
+#include <algorithm>
+
 #ifdef __linux__
 
+#include <cstdio>
+#include <string>
 #include <unistd.h>
 #include <sys/syscall.h>
 #if !defined(__NR_getcpu)
 #include <asm-generic/unistd.h>
 #endif
 
+#include "core/platform/posix/sysfs_utils.h"
+
 #if defined(CPUIDINFO_ARCH_ARM)
 
 #include <sys/auxv.h>
@@ -265,6 +271,84 @@ void CPUIDInfo::ArmWindowsInit() {
 #endif /* (arm or arm64) and windows */
 #endif /* arm or arm64*/
 
+namespace {
+
+// Capacity given to efficiency cores when the system only tells the core types apart, roughly the throughput of an
+// E-core relative to a P-core on recent x86 hybrid CPUs.
+constexpr uint32_t kEfficiencyCoreCapacity = CPUIDInfo::kMaxCoreCapacity / 2;
+
+}  // namespace
+
+void CPUIDInfo::InitCoreCapacities() {
+  std::vector<uint32_t> capacities;
+#ifdef __linux__
+  std::string line;
+  if (sysfs_utils::ReadLine("/sys/devices/cpu_core/cpus", line)) {
+    // x86 hybrid CPUs register a PMU per core type
+    for (int cpu : sysfs_utils::ParseIdList(line)) {
+      capacities.resize(std::max<size_t>(capacities.size(), cpu + 1), kMaxCoreCapacity);
+    }
+    if (sysfs_utils::ReadLine("/sys/devices/cpu_atom/cpus", line)) {
+      for (int cpu : sysfs_utils::ParseIdList(line)) {
+        capacities.resize(std::max<size_t>(capacities.size(), cpu + 1), kMaxCoreCapacity);
+        capacities[cpu] = kEfficiencyCoreCapacity;
+      }
+    }
+  } else {
+    // ARM exposes the capacity of each core, scaled to 1024 for the fastest ones
+    const long num_cpus = sysconf(_SC_NPROCESSORS_CONF);
+    for (long cpu = 0; cpu < num_cpus; ++cpu) {
+      uint32_t capacity = 0;
+      if (!sysfs_utils::ReadLine("/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/cpu_capacity", line) ||
+          sscanf(line.c_str(), "%u", &capacity) != 1 || capacity == 0) {
+        capacities.clear();
+        break;
+      }
+      capacities.push_back(capacity);
+    }
+  }
+#elif defined(_WIN32) && WINAPI_FAMILY_PARTITION(WINAPI_PARTITION_DESKTOP)
+  // Only processor group 0 is covered, like GetCurrentCoreIdx().
+  DWORD length = 0;
+  GetLogicalProcessorInformationEx(RelationProcessorCore, nullptr, &length);
+  std::vector<char> buffer(length);
+  if (length > 0 && GetLogicalProcessorInformationEx(
+                        RelationProcessorCore,
+                        reinterpret_cast<PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX>(buffer.data()), &length)) {
+    BYTE max_efficiency_class = 0;
+    std::vector<BYTE> efficiency_classes;
+    for (DWORD offset = 0; offset < length;) {
+      const auto* info = reinterpret_cast<const SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*>(buffer.data() + offset);
+      const auto& core = info->Processor;
+      if (core.GroupCount > 0 && core.GroupMask[0].Group == 0) {
+        for (uint32_t cpu = 0; cpu < sizeof(KAFFINITY) * 8; ++cpu) {
+          if (core.GroupMask[0].Mask & (KAFFINITY{1} << cpu)) {
+            efficiency_classes.resize(std::max<size_t>(efficiency_classes.size(), cpu + 1), 0);
+            efficiency_classes[cpu] = core.EfficiencyClass;
+          }
+        }
+      }
+      max_efficiency_class = std::max(max_efficiency_class, core.EfficiencyClass);
+      offset += info->Size;
+    }
+    // a higher efficiency class means a faster core
+    for (BYTE efficiency_class : efficiency_classes) {
+      capacities.push_back(efficiency_class == max_efficiency_class ? kMaxCoreCapacity : kEfficiencyCoreCapacity);
+    }
+  }
+#endif
+
+  const auto [min_capacity, max_capacity] = std::minmax_element(capacities.begin(), capacities.end());
+  if (capacities.empty() || *min_capacity == *max_capacity) {
+    return;
+  }
+  const uint32_t max_value = *max_capacity;
+  for (auto& capacity : capacities) {
+    capacity = std::max<uint32_t>(1, capacity * kMaxCoreCapacity / max_value);
+  }
+  core_capacities_ = std::move(capacities);
+}
+
 uint32_t CPUIDInfo::GetCurrentCoreIdx() const {
 #ifdef _WIN32
   return GetCurrentProcessorNumber();
@@ -89,6 +89,34 @@ class CPUIDInfo {
     return has_fp16_;
   }
 
+  static constexpr uint32_t kMaxCoreCapacity = 1024;
+
+  /**
+   * @brief Relative performance of the cores of hybrid CPUs, e.g. P-cores and E-cores on x86 or
+   *        big and LITTLE cores on ARM. The fastest cores have kMaxCoreCapacity.
+   * @return whether core capacities were detected, which is only the case if the cores differ
+   */
+  bool HasCoreCapacities() const {
+    return !core_capacities_.empty();
+  }
+
+  /**
+   * @return capacity of the indicated logical processor, kMaxCoreCapacity if unknown
+   */
+  uint32_t GetCoreCapacity(uint32_t coreId) const {
+    if (coreId >= core_capacities_.size()) {
+      return kMaxCoreCapacity;
+    }
+    return core_capacities_[coreId];
+  }
+
+  /**
+   * @return whether the indicated logical processor is slower than the fastest cores of the system
+   */
+  bool IsEfficiencyCore(uint32_t coreId) const {
+    return GetCoreCapacity(coreId) < kMaxCoreCapacity;
+  }
+
  private:
   CPUIDInfo() {
 #ifdef CPUIDINFO_ARCH_X86
@@ -100,7 +128,11 @@ class CPUIDInfo {
     ArmWindowsInit();
 #endif /* (arm or arm64) and windows */
 #endif
+    InitCoreCapacities();
   }
+
+  void InitCoreCapacities();
+
   bool has_amx_bf16_{false};
   bool has_avx_{false};
   bool has_avx2_{false};
@@ -119,6 +151,9 @@ class CPUIDInfo {
   // 128b vectore registers.
   std::vector<bool> is_armv8_narrow_ld_;
 
+  // capacity of each logical processor, empty if all are the same
+  std::vector<uint32_t> core_capacities_;
+
   bool has_arm_neon_dot_{false};
   bool has_fp16_{false};
 
@@ -0,0 +1,114 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/common/hardware_counters.h"
+
+#ifdef __linux__
+
+#include <cstring>
+#include <initializer_list>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#endif  // Linux
+
+namespace onnxruntime {
+
+namespace profiling {
+
+#ifdef __linux__
+
+namespace {
+
+// The counters of a thread, in a group so that they are enabled and read together
+class ThreadCounters {
+ public:
+  ThreadCounters() {
+    group_fd_ = Open(PERF_COUNT_HW_CPU_CYCLES, -1);
+    if (group_fd_ < 0) {
+      return;
+    }
+    instructions_fd_ = Open(PERF_COUNT_HW_INSTRUCTIONS, group_fd_);
+    llc_misses_fd_ = Open(PERF_COUNT_HW_CACHE_MISSES, group_fd_);
+    if (instructions_fd_ < 0 || llc_misses_fd_ < 0) {
+      Close();
+      return;
+    }
+    ioctl(group_fd_, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(group_fd_, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+  }
+
+  ~ThreadCounters() { Close(); }
+
+  bool Read(HardwareCounterValues& values) const {
+    if (group_fd_ < 0) {
+      return false;
+    }
+    // layout of PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING
+    struct {
+      uint64_t nr;
+      uint64_t time_enabled;
+      uint64_t time_running;
+      uint64_t values[3];
+    } data;
+    if (read(group_fd_, &data, sizeof(data)) != static_cast<ssize_t>(sizeof(data)) || data.nr != 3) {
+      return false;
+    }
+    // the counters are multiplexed when more events are requested than the processor has counters
+    const double scale = data.time_running > 0 && data.time_running < data.time_enabled
+                             ? static_cast<double>(data.time_enabled) / static_cast<double>(data.time_running)
+                             : 1.0;
+    values.cycles = static_cast<uint64_t>(static_cast<double>(data.values[0]) * scale);
+    values.instructions = static_cast<uint64_t>(static_cast<double>(data.values[1]) * scale);
+    values.llc_misses = static_cast<uint64_t>(static_cast<double>(data.values[2]) * scale);
+    return true;
+  }
+
+ private:
+  static int Open(uint64_t config, int group_fd) {
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = config;
+    attr.disabled = group_fd < 0 ? 1 : 0;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    // the calling thread, on any cpu
+    return static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, group_fd, 0));
+  }
+
+  void Close() {
+    for (int* fd : {&llc_misses_fd_, &instructions_fd_, &group_fd_}) {
+      if (*fd >= 0) {
+        close(*fd);
+        *fd = -1;
+      }
+    }
+  }
+
+  int group_fd_ = -1;
+  int instructions_fd_ = -1;
+  int llc_misses_fd_ = -1;
+};
+
+}  // namespace
+
+bool ReadThreadHardwareCounters(HardwareCounterValues& values) {
+  thread_local ThreadCounters counters;
+  return counters.Read(values);
+}
+
+#else
+
+bool ReadThreadHardwareCounters(HardwareCounterValues& /*values*/) {
+  return false;
+}
+
+#endif  // Linux
+
+}  // namespace profiling
+}  // namespace onnxruntime
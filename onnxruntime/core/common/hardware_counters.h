@@ -0,0 +1,30 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstdint>
+
+namespace onnxruntime {
+
+namespace profiling {
+
+// Values of the hardware performance counters of a thread, counted in user mode since the counters were opened
+struct HardwareCounterValues {
+  uint64_t cycles = 0;
+  uint64_t instructions = 0;
+  uint64_t llc_misses = 0;  // last level cache misses
+};
+
+/**
+ * Reads the hardware performance counters of the calling thread, which are opened on the first read of the thread.
+ * Returns false if they can not be read: the platform is not Linux, the processor or hypervisor does not expose them,
+ * or perf events are not allowed, see /proc/sys/kernel/perf_event_paranoid.
+ */
+bool ReadThreadHardwareCounters(HardwareCounterValues& values);
+
+// The size of the cache lines, used to estimate the memory bandwidth from the last level cache misses
+constexpr uint64_t kCacheLineBytes = 64;
+
+}  // namespace profiling
+}  // namespace onnxruntime
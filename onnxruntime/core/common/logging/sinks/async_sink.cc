@@ -0,0 +1,182 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/common/logging/sinks/async_sink.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+
+namespace onnxruntime {
+namespace logging {
+
+namespace {
+size_t RoundUpToPowerOf2(size_t value) {
+  size_t result = 1;
+  while (result < value) {
+    result <<= 1;
+  }
+  return result;
+}
+}  // namespace
+
+// The ring buffer is a bounded queue where each record carries a sequence number (D. Vyukov's bounded MPMC queue).
+// Producers claim a position with a CAS on enqueue_pos_ and publish the record by setting its sequence to
+// position + 1. The single consumer frees the record by setting its sequence to position + capacity.
+AsyncSink::AsyncSink(std::unique_ptr<ISink> sink, size_t capacity, size_t max_messages_per_call_site,
+                     std::chrono::milliseconds rate_limit_interval)
+    : sink_{std::move(sink)},
+      records_{std::make_unique<Record[]>(RoundUpToPowerOf2(std::max<size_t>(capacity, 2)))},
+      mask_{RoundUpToPowerOf2(std::max<size_t>(capacity, 2)) - 1},
+      max_messages_per_call_site_{max_messages_per_call_site},
+      rate_limit_interval_{std::max(rate_limit_interval, std::chrono::milliseconds(1))},
+      call_sites_{std::make_unique<CallSite[]>(kNumCallSites)} {
+  for (size_t i = 0; i <= mask_; ++i) {
+    records_[i].sequence.store(i, std::memory_order_relaxed);
+  }
+
+  thread_ = std::thread(&AsyncSink::Run, this);
+}
+
+AsyncSink::~AsyncSink() {
+  {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    stop_ = true;
+  }
+  cv_.notify_one();
+  thread_.join();
+}
+
+void AsyncSink::SendImpl(const Timestamp& timestamp, const std::string& logger_id, const Capture& message) {
+  if (message.Severity() == Severity::kFATAL) {
+    sink_->Send(timestamp, logger_id, message);
+    return;
+  }
+
+  if (ExceedsRateLimit(timestamp, message.Location())) {
+    num_suppressed_.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+
+  size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+  Record* record;
+  for (;;) {
+    record = &records_[pos & mask_];
+    const size_t sequence = record->sequence.load(std::memory_order_acquire);
+    const auto diff = static_cast<std::ptrdiff_t>(sequence - pos);
+    if (diff == 0) {
+      if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+        break;
+      }
+    } else if (diff < 0) {
+      // the consumer has not freed the record yet, so the buffer is full
+      num_dropped_.fetch_add(1, std::memory_order_relaxed);
+      return;
+    } else {
+      pos = enqueue_pos_.load(std::memory_order_relaxed);
+    }
+  }
+
+  // assigning to the strings of the record reuses their buffers
+  const CodeLocation& location = message.Location();
+  record->timestamp = timestamp;
+  record->logger_id = logger_id;
+  record->severity = message.Severity();
+  record->category = message.Category();
+  record->data_type = message.DataType();
+  record->file = location.file_and_path;
+  record->line = location.line_num;
+  record->function = location.function;
+  record->message = message.Message();
+  record->sequence.store(pos + 1, std::memory_order_release);
+
+  // pairs with the fence in Run, so either the consumer sees the record before it waits or we see it waiting
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (waiting_.load(std::memory_order_relaxed)) {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    cv_.notify_one();
+  }
+}
+
+bool AsyncSink::ExceedsRateLimit(const Timestamp& timestamp, const CodeLocation& location) {
+  if (max_messages_per_call_site_ == 0) {
+    return false;
+  }
+
+  // Call sites that hash to the same bucket share their limit.
+  const size_t hash = std::hash<std::string>{}(location.file_and_path) * 31 + static_cast<size_t>(location.line_num);
+  CallSite& call_site = call_sites_[hash % kNumCallSites];
+
+  const int64_t interval = static_cast<int64_t>(timestamp.time_since_epoch() / rate_limit_interval_);
+  int64_t call_site_interval = call_site.interval.load(std::memory_order_relaxed);
+  if (call_site_interval != interval &&
+      call_site.interval.compare_exchange_strong(call_site_interval, interval, std::memory_order_relaxed)) {
+    call_site.count.store(0, std::memory_order_relaxed);
+  }
+
+  return call_site.count.fetch_add(1, std::memory_order_relaxed) >= max_messages_per_call_site_;
+}
+
+bool AsyncSink::IsEmpty() const {
+  return records_[dequeue_pos_ & mask_].sequence.load(std::memory_order_acquire) != dequeue_pos_ + 1;
+}
+
+bool AsyncSink::WriteNext() {
+  if (IsEmpty()) {
+    return false;
+  }
+
+  // the message is formatted by the wrapped sink, here rather than on the thread that logged it
+  Record& record = records_[dequeue_pos_ & mask_];
+  {
+    Capture capture(record.severity, record.category.c_str(), record.data_type,
+                    CodeLocation(record.file.c_str(), record.line, record.function.c_str()));
+    capture.Stream() << record.message;
+    sink_->Send(record.timestamp, record.logger_id, capture);
+  }
+
+  record.sequence.store(dequeue_pos_ + mask_ + 1, std::memory_order_release);
+  ++dequeue_pos_;
+  return true;
+}
+
+void AsyncSink::WriteDiscardedCount() {
+  const size_t num_dropped = num_dropped_.exchange(0, std::memory_order_relaxed);
+  const size_t num_suppressed = num_suppressed_.exchange(0, std::memory_order_relaxed);
+  if (num_dropped == 0 && num_suppressed == 0) {
+    return;
+  }
+
+  Capture capture(Severity::kWARNING, Category::onnxruntime, DataType::SYSTEM, ORT_WHERE);
+  capture.Stream() << "Discarded " << num_dropped << " log messages as the log buffer was full and "
+                   << num_suppressed << " log messages that exceeded the rate limit of their call site.";
+  sink_->Send(std::chrono::system_clock::now(), "AsyncSink", capture);
+}
+
+void AsyncSink::Run() {
+  for (;;) {
+    while (WriteNext()) {
+    }
+    WriteDiscardedCount();
+
+    std::unique_lock<OrtMutex> lock(mutex_);
+    if (stop_) {
+      break;
+    }
+
+    waiting_.store(true, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (IsEmpty()) {
+      cv_.wait(lock);
+    }
+    waiting_.store(false, std::memory_order_relaxed);
+  }
+
+  // the sink is destroyed once nothing logs to it anymore, so this writes everything that is left
+  while (WriteNext()) {
+  }
+  WriteDiscardedCount();
+}
+
+}  // namespace logging
+}  // namespace onnxruntime
@@ -0,0 +1,104 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include "core/common/logging/capture.h"
+#include "core/common/logging/isink.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+namespace logging {
+/// <summary>
+/// ISink that hands messages over to a background thread, which sends them to another sink.
+/// </summary>
+/// <remarks>
+/// Messages are copied into a bounded ring buffer without taking a lock, so the thread that logs does not wait for
+/// the message to be formatted and written by the wrapped sink. Messages that do not fit in the buffer are dropped,
+/// and messages of a call site that exceed its rate limit are suppressed. The number of discarded messages is
+/// reported by a warning once the buffer drains.
+/// Fatal messages are sent to the wrapped sink directly, as the process may not survive them.
+/// The wrapped sink is called from the background thread, and messages still in the buffer are written when this
+/// sink is destroyed.
+/// </remarks>
+/// <seealso cref="ISink" />
+class AsyncSink : public ISink {
+ public:
+  /// <summary>
+  /// Initializes a new instance of the <see cref="AsyncSink"/> class.
+  /// </summary>
+  /// <param name="sink">The sink to write to.</param>
+  /// <param name="capacity">Number of messages the buffer holds. Rounded up to a power of 2.</param>
+  /// <param name="max_messages_per_call_site">Number of messages a call site can log per rate limit interval.
+  /// 0 for no limit.</param>
+  /// <param name="rate_limit_interval">Interval of the rate limit.</param>
+  AsyncSink(std::unique_ptr<ISink> sink, size_t capacity = 4096, size_t max_messages_per_call_site = 0,
+            std::chrono::milliseconds rate_limit_interval = std::chrono::seconds(1));
+
+  ~AsyncSink() override;
+
+  void SendProfileEvent(profiling::EventRecord& event_record) const override {
+    sink_->SendProfileEvent(event_record);
+  }
+
+ private:
+  // A message in the ring buffer. The sequence number tells whether the record is free for the producer with the
+  // matching position or holds a message for the consumer.
+  struct Record {
+    std::atomic<size_t> sequence;
+    Timestamp timestamp;
+    std::string logger_id;
+    Severity severity;
+    std::string category;
+    DataType data_type;
+    std::string file;
+    int line;
+    std::string function;
+    std::string message;
+  };
+
+  // Number of messages logged by the call sites that hash to the bucket in the current rate limit interval.
+  struct CallSite {
+    std::atomic<int64_t> interval{-1};
+    std::atomic<size_t> count{0};
+  };
+
+  static constexpr size_t kNumCallSites = 1024;
+
+  void SendImpl(const Timestamp& timestamp, const std::string& logger_id, const Capture& message) override;
+
+  bool ExceedsRateLimit(const Timestamp& timestamp, const CodeLocation& location);
+
+  // Background thread
+  void Run();
+  bool WriteNext();
+  bool IsEmpty() const;
+  void WriteDiscardedCount();
+
+  std::unique_ptr<ISink> sink_;
+  std::unique_ptr<Record[]> records_;
+  const size_t mask_;
+  std::atomic<size_t> enqueue_pos_{0};
+  size_t dequeue_pos_{0};
+
+  const size_t max_messages_per_call_site_;
+  const std::chrono::milliseconds rate_limit_interval_;
+  std::unique_ptr<CallSite[]> call_sites_;
+
+  std::atomic<size_t> num_dropped_{0};
+  std::atomic<size_t> num_suppressed_{0};
+
+  OrtMutex mutex_;
+  OrtCondVar cv_;
+  std::atomic<bool> waiting_{false};
+  bool stop_{false};
+  std::thread thread_;
+};
+}  // namespace logging
+}  // namespace onnxruntime
@@ -0,0 +1,162 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/common/metrics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <locale>
+#include <sstream>
+
+namespace onnxruntime {
+
+namespace metrics {
+
+namespace {
+
+constexpr double kNanoUnitsPerUnit = 1e9;
+
+const char* TypeName(SampleType type) {
+  return type == SampleType::kCounter ? "counter" : "gauge";
+}
+
+void WriteHeader(std::ostream& os, const std::string& name, const std::string& help, const char* type) {
+  os << "# HELP " << name << " " << help << "\n";
+  os << "# TYPE " << name << " " << type << "\n";
+}
+
+}  // namespace
+
+Histogram::Histogram(std::vector<double> bucket_bounds)
+    : bucket_bounds_(std::move(bucket_bounds)),
+      bucket_counts_(std::make_unique<std::atomic<uint64_t>[]>(bucket_bounds_.size() + 1)) {
+  ORT_ENFORCE(std::is_sorted(bucket_bounds_.begin(), bucket_bounds_.end()), "The bucket bounds must be increasing");
+  for (size_t i = 0; i <= bucket_bounds_.size(); ++i) {
+    bucket_counts_[i].store(0, std::memory_order_relaxed);
+  }
+}
+
+void Histogram::Observe(double value) {
+  const size_t bucket = static_cast<size_t>(
+      std::lower_bound(bucket_bounds_.begin(), bucket_bounds_.end(), value) - bucket_bounds_.begin());
+  bucket_counts_[bucket].fetch_add(1, std::memory_order_relaxed);
+  count_.fetch_add(1, std::memory_order_relaxed);
+  if (value > 0) {
+    sum_nano_.fetch_add(static_cast<uint64_t>(std::llround(value * kNanoUnitsPerUnit)), std::memory_order_relaxed);
+  }
+}
+
+std::vector<uint64_t> Histogram::BucketCounts() const {
+  std::vector<uint64_t> counts(bucket_bounds_.size() + 1);
+  for (size_t i = 0; i < counts.size(); ++i) {
+    counts[i] = bucket_counts_[i].load(std::memory_order_relaxed);
+  }
+  return counts;
+}
+
+double Histogram::Sum() const {
+  return static_cast<double>(sum_nano_.load(std::memory_order_relaxed)) / kNanoUnitsPerUnit;
+}
+
+const std::vector<double>& DurationBucketBounds() {
+  static const std::vector<double> bounds{0.0005, 0.001, 0.0025, 0.005, 0.01, 0.025, 0.05,
+                                          0.1, 0.25, 0.5, 1.0, 2.5, 5.0, 10.0};
+  return bounds;
+}
+
+MetricsRegistry& MetricsRegistry::Instance() {
+  // never destroyed, so that objects destroyed at exit can still remove their callbacks
+  static MetricsRegistry* registry = new MetricsRegistry();
+  return *registry;
+}
+
+Counter& MetricsRegistry::GetCounter(const std::string& name, const std::string& help) {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  auto& entry = counters_[name];
+  if (entry.counter == nullptr) {
+    entry.help = help;
+    entry.counter = std::make_unique<Counter>();
+  }
+  return *entry.counter;
+}
+
+Histogram& MetricsRegistry::GetHistogram(const std::string& name, const std::string& help,
+                                         const std::vector<double>& bucket_bounds) {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  auto& entry = histograms_[name];
+  if (entry.histogram == nullptr) {
+    entry.help = help;
+    entry.histogram = std::make_unique<Histogram>(bucket_bounds);
+  }
+  return *entry.histogram;
+}
+
+uint64_t MetricsRegistry::AddSampleCallback(SampleCallback callback) {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  const uint64_t id = next_callback_id_++;
+  callbacks_.emplace(id, std::move(callback));
+  return id;
+}
+
+void MetricsRegistry::RemoveSampleCallback(uint64_t id) {
+  // the callbacks are called with the mutex held
+  std::lock_guard<OrtMutex> lock(mutex_);
+  callbacks_.erase(id);
+}
+
+std::string MetricsRegistry::ToPrometheusText() const {
+  std::ostringstream os;
+  os.imbue(std::locale::classic());
+  os.precision(15);
+
+  std::lock_guard<OrtMutex> lock(mutex_);
+  for (const auto& entry : counters_) {
+    WriteHeader(os, entry.first, entry.second.help, "counter");
+    os << entry.first << " " << entry.second.counter->Value() << "\n";
+  }
+
+  for (const auto& entry : histograms_) {
+    const auto& name = entry.first;
+    const Histogram& histogram = *entry.second.histogram;
+    WriteHeader(os, name, entry.second.help, "histogram");
+    // the counts are read one by one while values are observed, so the total is made consistent with them
+    const auto counts = histogram.BucketCounts();
+    uint64_t cumulative_count = 0;
+    for (size_t i = 0; i < histogram.BucketBounds().size(); ++i) {
+      cumulative_count += counts[i];
+      os << name << "_bucket{le=\"" << histogram.BucketBounds()[i] << "\"} " << cumulative_count << "\n";
+    }
+    cumulative_count += counts.back();
+    os << name << "_bucket{le=\"+Inf\"} " << cumulative_count << "\n";
+    os << name << "_sum " << histogram.Sum() << "\n";
+    os << name << "_count " << cumulative_count << "\n";
+  }
+
+  std::vector<Sample> samples;
+  for (const auto& callback : callbacks_) {
+    callback.second(samples);
+  }
+  // the samples of a metric are written together, after a single header
+  std::stable_sort(samples.begin(), samples.end(),
+                   [](const Sample& a, const Sample& b) { return a.name < b.name; });
+  for (size_t i = 0; i < samples.size(); ++i) {
+    const Sample& sample = samples[i];
+    if (i == 0 || samples[i - 1].name != sample.name) {
+      WriteHeader(os, sample.name, sample.help, TypeName(sample.type));
+    }
+    os << sample.name;
+    if (!sample.labels.empty()) {
+      os << "{" << sample.labels << "}";
+    }
+    os << " " << sample.value << "\n";
+  }
+
+  return os.str();
+}
+
+void AddToCounter(const std::string& name, const std::string& help, uint64_t value) {
+  MetricsRegistry::Instance().GetCounter(name, help).Add(value);
+}
+
+}  // namespace metrics
+}  // namespace onnxruntime
@@ -0,0 +1,124 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+
+namespace metrics {
+
+// Monotonically increasing count of events
+class Counter {
+ public:
+  void Add(uint64_t value = 1) { value_.fetch_add(value, std::memory_order_relaxed); }
+  uint64_t Value() const { return value_.load(std::memory_order_relaxed); }
+
+ private:
+  std::atomic<uint64_t> value_{0};
+};
+
+// Distribution of observed values over fixed buckets, given by their increasing upper bounds
+class Histogram {
+ public:
+  explicit Histogram(std::vector<double> bucket_bounds);
+
+  void Observe(double value);
+
+  const std::vector<double>& BucketBounds() const { return bucket_bounds_; }
+
+  // Count of the observed values in each bucket, not cumulative. The last one counts the values above the last bound.
+  std::vector<uint64_t> BucketCounts() const;
+  uint64_t Count() const { return count_.load(std::memory_order_relaxed); }
+  double Sum() const;
+
+ private:
+  const std::vector<double> bucket_bounds_;
+  std::unique_ptr<std::atomic<uint64_t>[]> bucket_counts_;
+  std::atomic<uint64_t> count_{0};
+  // sum of the observed values in nanounits, so that it can be accumulated atomically
+  std::atomic<uint64_t> sum_nano_{0};
+};
+
+// Bounds in seconds suited to the durations of runs, from half a millisecond to ten seconds
+const std::vector<double>& DurationBucketBounds();
+
+enum class SampleType {
+  kGauge,
+  kCounter,
+};
+
+// Value read from a component when the metrics are exported, e.g. the bytes in use of an arena
+struct Sample {
+  std::string name;
+  std::string help;
+  SampleType type;
+  // Prometheus labels, e.g. session_id="1",device="Cpu"
+  std::string labels;
+  double value;
+};
+
+/**
+ * Process wide registry of the runtime metrics, exported in the Prometheus text exposition format.
+ *
+ * Counters and histograms are created on first use and live until the process exits, so that the hot paths can keep
+ * a reference to them and update them with atomic operations only. Values owned by objects with a shorter lifetime,
+ * e.g. the statistics of the allocators of a session, are read when exporting through callbacks the objects add and
+ * remove.
+ */
+class MetricsRegistry {
+ public:
+  using SampleCallback = std::function<void(std::vector<Sample>& samples)>;
+
+  static MetricsRegistry& Instance();
+
+  // Returns the counter named `name`, creating it the first time
+  Counter& GetCounter(const std::string& name, const std::string& help);
+
+  // Returns the histogram named `name`, creating it with `bucket_bounds` the first time
+  Histogram& GetHistogram(const std::string& name, const std::string& help, const std::vector<double>& bucket_bounds);
+
+  // The callback must not use the registry. Returns the id to remove it with.
+  uint64_t AddSampleCallback(SampleCallback callback);
+
+  // Once this returns, the callback is not running and will not be called again
+  void RemoveSampleCallback(uint64_t id);
+
+  std::string ToPrometheusText() const;
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(MetricsRegistry);
+
+ private:
+  MetricsRegistry() = default;
+
+  struct CounterEntry {
+    std::string help;
+    std::unique_ptr<Counter> counter;
+  };
+
+  struct HistogramEntry {
+    std::string help;
+    std::unique_ptr<Histogram> histogram;
+  };
+
+  mutable OrtMutex mutex_;
+  std::map<std::string, CounterEntry> counters_;
+  std::map<std::string, HistogramEntry> histograms_;
+  uint64_t next_callback_id_ = 1;
+  std::map<uint64_t, SampleCallback> callbacks_;
+};
+
+// Adds `value` to the counter named `name` of the process wide registry
+void AddToCounter(const std::string& name, const std::string& help, uint64_t value = 1);
+
+}  // namespace metrics
+}  // namespace onnxruntime
@@ -0,0 +1,193 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/common/parallel_for_calibration.h"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+#include "core/common/logging/logging.h"
+
+namespace onnxruntime {
+namespace concurrency {
+
+namespace {
+
+// Every candidate is measured this many times before the fastest one is used.
+constexpr uint32_t kMinSamples = 3;
+// One call out of this many tries the next candidate, to follow changes of the load.
+constexpr uint32_t kRetryInterval = 64;
+// Weight of a new measurement in the moving average.
+constexpr double kSmoothing = 0.125;
+
+constexpr const char* kFileHeader = "onnxruntime_parallel_for_calibration 1";
+
+int SizeBucket(std::ptrdiff_t total) {
+  int bucket = 0;
+  while (total > 1) {
+    total >>= 1;
+    ++bucket;
+  }
+  return bucket;
+}
+
+uint64_t MakeKey(int bucket, int degree_of_parallelism) {
+  return (static_cast<uint64_t>(bucket) << 32) | static_cast<uint32_t>(degree_of_parallelism);
+}
+
+template <typename Candidate>
+void InitializeCandidates(std::vector<Candidate>& candidates, int degree_of_parallelism) {
+  if (candidates.empty()) {
+    for (int shards = 1; shards < degree_of_parallelism; shards *= 2) {
+      candidates.push_back({shards, 0, 0.0});
+    }
+    candidates.push_back({degree_of_parallelism, 0, 0.0});
+  }
+}
+
+}  // namespace
+
+ParallelForCalibration::ParallelForCalibration(PathString file) : file_(std::move(file)) {
+  if (!file_.empty()) {
+    Load();
+  }
+}
+
+ParallelForCalibration::~ParallelForCalibration() {
+  if (!file_.empty()) {
+    auto status = Save();
+    if (!status.IsOK()) {
+      LOGS_DEFAULT(WARNING) << "Failed to save parallel for calibration: " << status.ErrorMessage();
+    }
+  }
+}
+
+ParallelForCalibration::LoopStats& ParallelForCalibration::GetLoopStats(const std::type_info& site,
+                                                                        std::ptrdiff_t total,
+                                                                        int degree_of_parallelism) {
+  auto site_it = sites_.find(std::type_index(site));
+  if (site_it == sites_.end()) {
+    SiteStats site_stats;
+    auto loaded_it = loaded_sites_.find(site.name());
+    if (loaded_it != loaded_sites_.end()) {
+      site_stats = std::move(loaded_it->second);
+      loaded_sites_.erase(loaded_it);
+    }
+    site_it = sites_.emplace(std::type_index(site), std::move(site_stats)).first;
+  }
+
+  LoopStats& stats = site_it->second[MakeKey(SizeBucket(total), degree_of_parallelism)];
+  InitializeCandidates(stats.candidates, degree_of_parallelism);
+  return stats;
+}
+
+int ParallelForCalibration::ChooseShards(const std::type_info& site, std::ptrdiff_t total,
+                                         int degree_of_parallelism) {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  LoopStats& stats = GetLoopStats(site, total, degree_of_parallelism);
+  const uint32_t call = stats.calls++;
+
+  for (const auto& candidate : stats.candidates) {
+    if (candidate.samples < kMinSamples) {
+      return candidate.shards;
+    }
+  }
+  if (call % kRetryInterval == 0) {
+    return stats.candidates[(call / kRetryInterval) % stats.candidates.size()].shards;
+  }
+  return std::min_element(stats.candidates.begin(), stats.candidates.end(),
+                          [](const Candidate& a, const Candidate& b) {
+                            return a.ns_per_iteration < b.ns_per_iteration;
+                          })
+      ->shards;
+}
+
+void ParallelForCalibration::Record(const std::type_info& site, std::ptrdiff_t total, int degree_of_parallelism,
+                                    int shards, std::chrono::nanoseconds elapsed) {
+  const double ns_per_iteration = static_cast<double>(elapsed.count()) / static_cast<double>(total);
+  std::lock_guard<OrtMutex> lock(mutex_);
+  LoopStats& stats = GetLoopStats(site, total, degree_of_parallelism);
+  for (auto& candidate : stats.candidates) {
+    if (candidate.shards == shards) {
+      if (candidate.samples == 0) {
+        candidate.ns_per_iteration = ns_per_iteration;
+      } else {
+        candidate.ns_per_iteration += kSmoothing * (ns_per_iteration - candidate.ns_per_iteration);
+      }
+      if (candidate.samples < kMinSamples) {
+        ++candidate.samples;
+      }
+      return;
+    }
+  }
+}
+
+// File format: a header line, then one line per measured candidate:
+// <size bucket> <degree of parallelism> <shards> <samples> <ns per iteration> <type name of the loop body>
+void ParallelForCalibration::Load() {
+  std::ifstream file(file_);
+  std::string line;
+  if (!file || !std::getline(file, line) || line != kFileHeader) {
+    return;
+  }
+
+  while (std::getline(file, line)) {
+    std::istringstream ss(line);
+    int bucket = 0;
+    int degree_of_parallelism = 0;
+    int shards = 0;
+    uint32_t samples = 0;
+    double ns_per_iteration = 0.0;
+    std::string site;
+    if (!(ss >> bucket >> degree_of_parallelism >> shards >> samples >> ns_per_iteration) ||
+        !std::getline(ss >> std::ws, site) || site.empty() || degree_of_parallelism <= 0) {
+      LOGS_DEFAULT(WARNING) << "Ignoring malformed parallel for calibration entry: " << line;
+      continue;
+    }
+
+    LoopStats& stats = loaded_sites_[site][MakeKey(bucket, degree_of_parallelism)];
+    InitializeCandidates(stats.candidates, degree_of_parallelism);
+    for (auto& candidate : stats.candidates) {
+      if (candidate.shards == shards) {
+        candidate.samples = std::min(samples, kMinSamples);
+        candidate.ns_per_iteration = ns_per_iteration;
+      }
+    }
+  }
+}
+
+Status ParallelForCalibration::Save() const {
+  std::ostringstream ss;
+  ss << kFileHeader << "\n";
+  auto write_site = [&ss](const std::string& site, const SiteStats& site_stats) {
+    for (const auto& [key, stats] : site_stats) {
+      for (const auto& candidate : stats.candidates) {
+        if (candidate.samples > 0) {
+          ss << (key >> 32) << " " << (key & 0xFFFFFFFF) << " " << candidate.shards << " " << candidate.samples
+             << " " << candidate.ns_per_iteration << " " << site << "\n";
+        }
+      }
+    }
+  };
+
+  {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    for (const auto& [site, site_stats] : sites_) {
+      write_site(site.name(), site_stats);
+    }
+    for (const auto& [site, site_stats] : loaded_sites_) {
+      write_site(site, site_stats);
+    }
+  }
+
+  std::ofstream file(file_, std::ios::trunc);
+  ORT_RETURN_IF_NOT(file.good(), "Failed to open parallel for calibration file");
+  file << ss.str();
+  file.close();
+  ORT_RETURN_IF_NOT(file.good(), "Failed to write parallel for calibration file");
+  return Status::OK();
+}
+
+}  // namespace concurrency
+}  // namespace onnxruntime
@@ -0,0 +1,75 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <typeindex>
+#include <typeinfo>
+#include <unordered_map>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/path_string.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+namespace concurrency {
+
+// Online calibration of the partitioning of ThreadPool::ParallelFor loops.
+//
+// The static cost model derives the number of threads of a loop from the TensorOpCost that the kernel passes, and
+// those estimates are often off, so small loops get split across threads and pay the wake-up latency. In calibration
+// mode every loop is timed, per call site (the type of the loop body), loop size bucket (powers of 2) and degree of
+// parallelism, for each candidate number of shards: 1, 2, 4, ... up to the degree of parallelism. Each candidate is
+// tried a few times, then the loop runs with the fastest one. The candidates are tried again every now and then so
+// that the choice follows the load of the machine.
+class ParallelForCalibration {
+ public:
+  // If `file` is not empty, the measurements are loaded from it if it exists, and saved to it on destruction.
+  explicit ParallelForCalibration(PathString file);
+  ~ParallelForCalibration();
+
+  // Returns the number of shards to run a loop of `total` iterations with body `site` with.
+  int ChooseShards(const std::type_info& site, std::ptrdiff_t total, int degree_of_parallelism);
+
+  // Records that a loop of `total` iterations with body `site` took `elapsed` when run with `shards` shards.
+  void Record(const std::type_info& site, std::ptrdiff_t total, int degree_of_parallelism, int shards,
+              std::chrono::nanoseconds elapsed);
+
+  // Saves the measurements to the file passed to the constructor.
+  Status Save() const;
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(ParallelForCalibration);
+
+ private:
+  struct Candidate {
+    int shards;
+    uint32_t samples;
+    double ns_per_iteration;  // exponential moving average
+  };
+
+  struct LoopStats {
+    uint32_t calls{0};
+    std::vector<Candidate> candidates;
+  };
+
+  // loop size bucket and degree of parallelism
+  using SiteStats = std::unordered_map<uint64_t, LoopStats>;
+
+  LoopStats& GetLoopStats(const std::type_info& site, std::ptrdiff_t total, int degree_of_parallelism);
+  void Load();
+
+  const PathString file_;
+
+  mutable OrtMutex mutex_;
+  std::unordered_map<std::type_index, SiteStats> sites_;
+  // measurements loaded from the file for call sites that did not run yet, by type name
+  std::unordered_map<std::string, SiteStats> loaded_sites_;
+};
+
+}  // namespace concurrency
+}  // namespace onnxruntime
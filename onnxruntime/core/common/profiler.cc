@@ -79,12 +79,42 @@ void Profiler::EndTimeAndRecordEvent(EventCategory category,
   long long dur = TimeDiffMicroSeconds(start_time);
   long long ts = TimeDiffMicroSeconds(profiling_start_time_, start_time);
 
-  EventRecord event(category, logging::GetProcessId(),
-                    logging::GetThreadId(), event_name, ts, dur, {event_args.begin(), event_args.end()});
+  // TODO: sync_gpu if needed.
+  AddEvent(EventRecord(category, logging::GetProcessId(),
+                       logging::GetThreadId(), event_name, ts, dur, {event_args.begin(), event_args.end()}));
+
+  for (const auto& ep_profiler : ep_profilers_) {
+    ep_profiler->Stop(ts);
+  }
+}
+
+void Profiler::RecordCounterEvent(const std::string& event_name,
+                                  const std::initializer_list<std::pair<std::string, int64_t>>& counters) {
+  long long ts = TimeDiffMicroSeconds(profiling_start_time_);
+
+  std::unordered_map<std::string, std::string> event_args;
+  for (const auto& counter : counters) {
+    event_args.emplace(counter.first, std::to_string(counter.second));
+  }
+  AddEvent(EventRecord(MEMORY_EVENT, logging::GetProcessId(), logging::GetThreadId(), event_name, ts, 0,
+                       std::move(event_args)));
+}
+
+void Profiler::RecordEvent(EventCategory category,
+                           const std::string& event_name,
+                           unsigned thread_id,
+                           const TimePoint& start_time,
+                           const TimePoint& end_time,
+                           std::unordered_map<std::string, std::string>&& event_args) {
+  AddEvent(EventRecord(category, logging::GetProcessId(), static_cast<int>(thread_id), event_name,
+                       TimeDiffMicroSeconds(profiling_start_time_, start_time),
+                       TimeDiffMicroSeconds(start_time, end_time), std::move(event_args)));
+}
+
+void Profiler::AddEvent(EventRecord&& event) {
   if (profile_with_logger_) {
     custom_logger_->SendProfileEvent(event);
   } else {
-    // TODO: sync_gpu if needed.
     std::lock_guard<OrtMutex> lock(mutex_);
     if (events_.size() < max_num_events_) {
       events_.emplace_back(std::move(event));
@@ -96,10 +126,6 @@ void Profiler::EndTimeAndRecordEvent(EventCategory category,
       }
     }
   }
-
-  for (const auto& ep_profiler : ep_profilers_) {
-    ep_profiler->Stop(ts);
-  }
 }
 
 std::string Profiler::EndProfiling() {
@@ -124,18 +150,21 @@ std::string Profiler::EndProfiling() {
 
   for (size_t i = 0; i < events_.size(); ++i) {
     auto& rec = events_[i];
+    // counter samples have numeric values
+    const bool is_counter = rec.cat == MEMORY_EVENT;
     profile_stream_ << R"({"cat" : ")" << event_category_names_[rec.cat] << "\",";
     profile_stream_ << "\"pid\" :" << rec.pid << ",";
     profile_stream_ << "\"tid\" :" << rec.tid << ",";
     profile_stream_ << "\"dur\" :" << rec.dur << ",";
     profile_stream_ << "\"ts\" :" << rec.ts << ",";
-    profile_stream_ << R"("ph" : "X",)";
+    profile_stream_ << (is_counter ? R"("ph" : "C",)" : R"("ph" : "X",)");
     profile_stream_ << R"("name" :")" << rec.name << "\",";
     profile_stream_ << "\"args\" : {";
     bool is_first_arg = true;
     for (std::pair<std::string, std::string> event_arg : rec.args) {
       if (!is_first_arg) profile_stream_ << ",";
-      if (!event_arg.second.empty() && (event_arg.second[0] == '{' || event_arg.second[0] == '[')) {
+      if (is_counter ||
+          (!event_arg.second.empty() && (event_arg.second[0] == '{' || event_arg.second[0] == '['))) {
         profile_stream_ << "\"" << event_arg.first << "\" : " << event_arg.second << "";
       } else {
         profile_stream_ << "\"" << event_arg.first << "\" : \"" << event_arg.second << "\"";
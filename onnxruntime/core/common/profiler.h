@@ -60,6 +60,71 @@ class Profiler {
   bool IsEnabled() const {
     return enabled_;
   }
+
+  /*
+  Record the memory the execution frames allocate and release per node, in addition to the timing of the nodes.
+  Only used while profiling is enabled.
+  */
+  void SetMemoryProfiling(bool enable) {
+    profile_memory_ = enable;
+  }
+
+  /*
+  Whether memory profiling is set and data collection is enabled.
+  */
+  bool IsMemoryProfilingEnabled() const {
+    return enabled_ && profile_memory_;
+  }
+
+  /*
+  Record the timeline of the parallel loops of the nodes on the intra-op thread pool, in addition to the timing of the
+  nodes. Only used while profiling is enabled.
+  */
+  void SetThreadPoolTimelineProfiling(bool enable) {
+    profile_threadpool_timeline_ = enable;
+  }
+
+  /*
+  Whether thread pool timeline profiling is set and data collection is enabled.
+  */
+  bool IsThreadPoolTimelineProfilingEnabled() const {
+    return enabled_ && profile_threadpool_timeline_;
+  }
+
+  /*
+  Record the hardware performance counters of the thread running each node over its compute, in addition to the
+  timing of the nodes. Only used while profiling is enabled.
+  */
+  void SetHardwareCounterProfiling(bool enable) {
+    profile_hardware_counters_ = enable;
+  }
+
+  /*
+  Whether hardware counter profiling is set and data collection is enabled.
+  */
+  bool IsHardwareCounterProfilingEnabled() const {
+    return enabled_ && profile_hardware_counters_;
+  }
+
+  /*
+  Record the estimated operations and bytes moved by each node with the throughput it achieved, compared to the
+  peak throughput of the machine. A peak of 0 is unknown and not reported. Only used while profiling is enabled.
+  */
+  void SetRooflineProfiling(bool enable, double peak_gflops, double peak_gbytes_per_second) {
+    profile_roofline_ = enable;
+    peak_gflops_ = peak_gflops;
+    peak_gbytes_per_second_ = peak_gbytes_per_second;
+  }
+
+  /*
+  Whether roofline profiling is set and data collection is enabled.
+  */
+  bool IsRooflineProfilingEnabled() const {
+    return enabled_ && profile_roofline_;
+  }
+
+  double GetPeakGflops() const { return peak_gflops_; }
+  double GetPeakGbytesPerSecond() const { return peak_gbytes_per_second_; }
   /*
   Return the stored start time of profiler.
   On some platforms, this timer may not be as precise as nanoseconds
@@ -80,6 +145,23 @@ class Profiler {
                              const std::initializer_list<std::pair<std::string, std::string>>& event_args = {},
                              bool sync_gpu = false);
 
+  /*
+  Record the values of counters at the call of this function. The samples of the counters with the same event_name
+  form a counter track in chrome tracing, e.g. the live memory of a session over time.
+  */
+  void RecordCounterEvent(const std::string& event_name,
+                          const std::initializer_list<std::pair<std::string, int64_t>>& counters);
+
+  /*
+  Record an event that happened on another thread, e.g. on a worker of a thread pool.
+  */
+  void RecordEvent(EventCategory category,
+                   const std::string& event_name,
+                   unsigned thread_id,
+                   const TimePoint& start_time,
+                   const TimePoint& end_time,
+                   std::unordered_map<std::string, std::string>&& event_args = {});
+
   /*
   Write profile data to the given stream in chrome format defined below.
   https://docs.google.com/document/d/1CvAClvFfyA5R-PhYUmn5OOQtYMH4h6I0nSsKchNAySU/preview#
@@ -122,6 +204,8 @@ class Profiler {
  private:
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(Profiler);
 
+  void AddEvent(EventRecord&& event);
+
   /**
    * The maximum number of profiler records to collect.
    * This value is used to initialize the per-profiler maximum.
@@ -149,6 +233,12 @@ class Profiler {
   Events events_;
   bool max_events_reached{false};
   bool profile_with_logger_{false};
+  bool profile_memory_{false};
+  bool profile_threadpool_timeline_{false};
+  bool profile_hardware_counters_{false};
+  bool profile_roofline_{false};
+  double peak_gflops_{0};
+  double peak_gbytes_per_second_{0};
   const size_t max_num_events_{global_max_num_events_.load()};
 
 #ifdef ENABLE_STATIC_PROFILER_INSTANCE
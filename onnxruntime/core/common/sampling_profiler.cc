@@ -0,0 +1,130 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/common/sampling_profiler.h"
+
+#include <algorithm>
+
+namespace onnxruntime {
+
+namespace profiling {
+
+namespace {
+
+int64_t ToNanoseconds(const TimePoint& time) {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+}
+
+}  // namespace
+
+// The fields are atomics so that a slot can be read while it is rewritten. The sequence number is odd while the slot
+// is written, and a reader keeps what it read only if the sequence number is even and did not change meanwhile.
+class SamplingProfiler::RunSlot {
+ public:
+  struct NodeTiming {
+    std::atomic<size_t> node_index{0};
+    std::atomic<int64_t> start_ns{0};
+    std::atomic<int64_t> duration_ns{0};
+  };
+
+  explicit RunSlot(size_t max_nodes) : max_nodes_(max_nodes), nodes_(std::make_unique<NodeTiming[]>(max_nodes)) {}
+
+  const size_t max_nodes_;
+  std::atomic<uint64_t> sequence_{0};
+  std::atomic<uint64_t> sample_id_{0};
+  std::atomic<int64_t> start_ns_{0};
+  std::atomic<int64_t> duration_ns_{0};
+  std::atomic<size_t> num_nodes_{0};
+  std::unique_ptr<NodeTiming[]> nodes_;
+};
+
+SamplingProfiler::SamplingProfiler(size_t sampling_interval, size_t max_runs, size_t max_nodes_per_run)
+    : sampling_interval_(std::max<size_t>(sampling_interval, 1)),
+      max_nodes_per_run_(max_nodes_per_run) {
+  slots_.reserve(std::max<size_t>(max_runs, 1));
+  for (size_t i = 0; i < std::max<size_t>(max_runs, 1); ++i) {
+    slots_.push_back(std::make_unique<RunSlot>(max_nodes_per_run_));
+  }
+}
+
+SamplingProfiler::~SamplingProfiler() = default;
+
+SamplingProfiler::RunSlot* SamplingProfiler::BeginRun() {
+  if (num_runs_.fetch_add(1, std::memory_order_relaxed) % sampling_interval_ != 0) {
+    return nullptr;
+  }
+
+  const uint64_t sample_id = num_samples_.fetch_add(1, std::memory_order_relaxed) + 1;
+  RunSlot& slot = *slots_[sample_id % slots_.size()];
+  uint64_t sequence = slot.sequence_.load(std::memory_order_relaxed);
+  if ((sequence & 1) != 0 ||
+      !slot.sequence_.compare_exchange_strong(sequence, sequence + 1, std::memory_order_acquire)) {
+    return nullptr;
+  }
+  // the fields must not be written before the sequence number is seen as odd by the readers
+  std::atomic_thread_fence(std::memory_order_release);
+
+  slot.sample_id_.store(sample_id, std::memory_order_relaxed);
+  slot.start_ns_.store(ToNanoseconds(std::chrono::high_resolution_clock::now()), std::memory_order_relaxed);
+  slot.duration_ns_.store(0, std::memory_order_relaxed);
+  slot.num_nodes_.store(0, std::memory_order_relaxed);
+  return &slot;
+}
+
+void SamplingProfiler::RecordNode(RunSlot& slot, size_t node_index, const TimePoint& start_time,
+                                  const TimePoint& end_time) {
+  // nodes may complete concurrently with the parallel executor or multiple streams
+  const size_t i = slot.num_nodes_.fetch_add(1, std::memory_order_relaxed);
+  if (i >= slot.max_nodes_) {
+    return;
+  }
+  auto& node = slot.nodes_[i];
+  node.node_index.store(node_index, std::memory_order_relaxed);
+  node.start_ns.store(ToNanoseconds(start_time) - slot.start_ns_.load(std::memory_order_relaxed),
+                      std::memory_order_relaxed);
+  node.duration_ns.store(std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - start_time).count(),
+                         std::memory_order_relaxed);
+}
+
+void SamplingProfiler::EndRun(RunSlot& slot) {
+  slot.duration_ns_.store(ToNanoseconds(std::chrono::high_resolution_clock::now()) -
+                              slot.start_ns_.load(std::memory_order_relaxed),
+                          std::memory_order_relaxed);
+  slot.sequence_.fetch_add(1, std::memory_order_release);
+}
+
+std::vector<SampledRun> SamplingProfiler::GetLatestRuns() const {
+  std::vector<SampledRun> runs;
+  runs.reserve(slots_.size());
+  for (const auto& slot : slots_) {
+    const uint64_t sequence = slot->sequence_.load(std::memory_order_acquire);
+    if (sequence == 0 || (sequence & 1) != 0) {
+      continue;
+    }
+
+    SampledRun run;
+    run.sample_id = slot->sample_id_.load(std::memory_order_relaxed);
+    run.start_ns = slot->start_ns_.load(std::memory_order_relaxed);
+    run.duration_ns = slot->duration_ns_.load(std::memory_order_relaxed);
+    const size_t num_nodes = std::min(slot->num_nodes_.load(std::memory_order_relaxed), slot->max_nodes_);
+    run.nodes.reserve(num_nodes);
+    for (size_t i = 0; i < num_nodes; ++i) {
+      const auto& node = slot->nodes_[i];
+      run.nodes.push_back({node.node_index.load(std::memory_order_relaxed),
+                           node.start_ns.load(std::memory_order_relaxed),
+                           node.duration_ns.load(std::memory_order_relaxed)});
+    }
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot->sequence_.load(std::memory_order_relaxed) == sequence) {
+      runs.push_back(std::move(run));
+    }
+  }
+
+  std::sort(runs.begin(), runs.end(),
+            [](const SampledRun& a, const SampledRun& b) { return a.sample_id < b.sample_id; });
+  return runs;
+}
+
+}  // namespace profiling
+}  // namespace onnxruntime
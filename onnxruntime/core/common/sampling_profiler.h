@@ -0,0 +1,69 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "core/common/common.h"
+
+namespace onnxruntime {
+
+namespace profiling {
+
+struct SampledNodeTiming {
+  size_t node_index;
+  // relative to the start of the run
+  int64_t start_ns;
+  int64_t duration_ns;
+};
+
+struct SampledRun {
+  // 1 for the first sampled run of the session, incremented for each of the following ones
+  uint64_t sample_id;
+  // time since the epoch of the high resolution clock
+  int64_t start_ns;
+  int64_t duration_ns;
+  std::vector<SampledNodeTiming> nodes;
+};
+
+/**
+ * Profiler cheap enough to be left enabled in production. It records the node timings of one in every
+ * `sampling_interval` runs into a ring of the latest `max_runs` sampled runs, which can be read at any time
+ * without stopping the runs, e.g. to investigate latency spikes live.
+ *
+ * The memory is allocated once: up to `max_nodes_per_run` node timings per run are kept. Recording and reading are
+ * lock-free. A run is not sampled if the slot of the ring it should use is still being written by a run that started
+ * `max_runs` samples earlier, and a slot being written while it is read is left out of the result.
+ */
+class SamplingProfiler {
+ public:
+  class RunSlot;
+
+  SamplingProfiler(size_t sampling_interval, size_t max_runs, size_t max_nodes_per_run);
+  ~SamplingProfiler();
+
+  // Returns the slot recording the run that starts if it is sampled, nullptr otherwise
+  RunSlot* BeginRun();
+
+  void RecordNode(RunSlot& slot, size_t node_index, const TimePoint& start_time, const TimePoint& end_time);
+
+  void EndRun(RunSlot& slot);
+
+  // Returns the complete sampled runs in the ring, the oldest first
+  std::vector<SampledRun> GetLatestRuns() const;
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(SamplingProfiler);
+
+ private:
+  const size_t sampling_interval_;
+  const size_t max_nodes_per_run_;
+  std::atomic<uint64_t> num_runs_{0};
+  std::atomic<uint64_t> num_samples_{0};
+  std::vector<std::unique_ptr<RunSlot>> slots_;
+};
+
+}  // namespace profiling
+}  // namespace onnxruntime
@@ -13,6 +13,8 @@ See the License for the specific language governing permissions and
 limitations under the License.
 ==============================================================================*/
 
+#include <algorithm>
+#include <chrono>
 #include <memory>
 #include <optional>
 
@@ -20,6 +22,8 @@ limitations under the License.
 #include "core/common/common.h"
 #include "core/common/cpuid_info.h"
 #include "core/common/eigen_common_wrapper.h"
+#include "core/common/logging/logging.h"
+#include "core/common/parallel_for_calibration.h"
 #include "core/platform/EigenNonBlockingThreadPool.h"
 #include "core/platform/ort_mutex.h"
 #if !defined(ORT_MINIMAL_BUILD)
@@ -48,6 +52,9 @@ namespace concurrency {
 #if !defined(ORT_MINIMAL_BUILD)
 ThreadPoolProfiler::ThreadPoolProfiler(int num_threads, const CHAR_TYPE* thread_pool_name) : num_threads_(num_threads) {
   child_thread_stats_.assign(num_threads, {});
+  for (int i = 0; i <= num_threads; ++i) {
+    timelines_.push_back(std::make_unique<Timeline>());
+  }
   if (thread_pool_name) {
 #ifdef _WIN32
     thread_pool_name_ = ToUTF8String(thread_pool_name);
@@ -200,6 +207,7 @@ const char* ThreadPoolProfiler::GetEventName(ThreadPoolEvent event) {
 
 void ThreadPoolProfiler::LogThreadId(int thread_idx) {
   child_thread_stats_[thread_idx].thread_id_ = std::this_thread::get_id();
+  timelines_[thread_idx]->thread_id = logging::GetThreadId();
 }
 
 void ThreadPoolProfiler::LogRun(int thread_idx) {
@@ -240,6 +248,113 @@ std::string ThreadPoolProfiler::DumpChildThreadStat() {
   }
   return ss.str();
 }
+
+void ThreadPoolProfiler::StartTimeline() {
+  for (auto& timeline : timelines_) {
+    std::lock_guard<OrtMutex> lock(timeline->mutex);
+    timeline->events.clear();
+  }
+  timeline_enabled_ = true;
+}
+
+std::vector<ThreadPoolTimelineEvent> ThreadPoolProfiler::StopTimeline() {
+  timeline_enabled_ = false;
+  std::vector<ThreadPoolTimelineEvent> events;
+  for (auto& timeline : timelines_) {
+    std::lock_guard<OrtMutex> lock(timeline->mutex);
+    events.insert(events.end(), timeline->events.begin(), timeline->events.end());
+    timeline->events.clear();
+  }
+  return events;
+}
+
+std::unique_ptr<ThreadPoolProfiler::LoopTimeline> ThreadPoolProfiler::StartLoopTimeline(
+    unsigned degree_of_parallelism, std::ptrdiff_t block_size) {
+  if (!IsTimelineEnabled()) {
+    return nullptr;
+  }
+  auto timeline = std::make_unique<LoopTimeline>();
+  timeline->degree_of_parallelism = degree_of_parallelism;
+  timeline->block_size = block_size;
+  timeline->shards.resize(degree_of_parallelism);
+  timeline->start = Clock::now();
+  return timeline;
+}
+
+std::function<void(unsigned)> ThreadPoolProfiler::TimeShards(LoopTimeline& timeline,
+                                                             std::function<void(unsigned)> fn) {
+  return [&timeline, fn = std::move(fn)](unsigned idx) {
+    // each index is run by a single thread
+    auto& shard = timeline.shards[idx];
+    shard.start = Clock::now();
+    fn(idx);
+    shard.end = Clock::now();
+    shard.thread_id = logging::GetThreadId();
+    shard.ran = true;
+  };
+}
+
+void ThreadPoolProfiler::EndLoopTimeline(std::unique_ptr<LoopTimeline> timeline) {
+  ThreadPoolTimelineEvent loop_event{};
+  loop_event.kind = ThreadPoolTimelineEvent::Kind::kParallelLoop;
+  loop_event.thread_id = logging::GetThreadId();
+  loop_event.start = timeline->start;
+  loop_event.end = Clock::now();
+  loop_event.degree_of_parallelism = timeline->degree_of_parallelism;
+  loop_event.block_size = timeline->block_size;
+
+  std::vector<ThreadPoolTimelineEvent> events;
+  double total_duration = 0.0;
+  double max_duration = 0.0;
+  for (unsigned i = 0; i < timeline->shards.size(); ++i) {
+    const auto& shard = timeline->shards[i];
+    if (!shard.ran) {
+      continue;  // revoked before any worker picked it up
+    }
+    const double duration = std::chrono::duration<double>(shard.end - shard.start).count();
+    total_duration += duration;
+    max_duration = std::max(max_duration, duration);
+
+    ThreadPoolTimelineEvent shard_event{};
+    shard_event.kind = ThreadPoolTimelineEvent::Kind::kShard;
+    shard_event.thread_id = shard.thread_id;
+    shard_event.start = shard.start;
+    shard_event.end = shard.end;
+    shard_event.shard_index = i;
+    events.push_back(shard_event);
+  }
+  if (total_duration > 0.0) {
+    loop_event.imbalance = max_duration * static_cast<double>(events.size()) / total_duration;
+  }
+  events.push_back(loop_event);
+
+  auto& timeline_of_callers = *timelines_.back();
+  std::lock_guard<OrtMutex> lock(timeline_of_callers.mutex);
+  timeline_of_callers.events.insert(timeline_of_callers.events.end(), events.begin(), events.end());
+}
+
+void ThreadPoolProfiler::LogSpin(int thread_idx, const onnxruntime::TimePoint& start) {
+  LogIdle(thread_idx, ThreadPoolTimelineEvent::Kind::kSpin, start);
+}
+
+void ThreadPoolProfiler::LogPark(int thread_idx, const onnxruntime::TimePoint& start) {
+  LogIdle(thread_idx, ThreadPoolTimelineEvent::Kind::kPark, start);
+}
+
+void ThreadPoolProfiler::LogIdle(int thread_idx, ThreadPoolTimelineEvent::Kind kind,
+                                 const onnxruntime::TimePoint& start) {
+  if (!IsTimelineEnabled()) {
+    return;
+  }
+  auto& timeline = *timelines_[thread_idx];
+  ThreadPoolTimelineEvent event{};
+  event.kind = kind;
+  event.thread_id = timeline.thread_id;
+  event.start = start;
+  event.end = Clock::now();
+  std::lock_guard<OrtMutex> lock(timeline.mutex);
+  timeline.events.push_back(event);
+}
 #endif
 
 // A sharded loop counter distributes loop iterations between a set of worker threads.  The iteration space of
@@ -383,12 +498,34 @@ ThreadPool::ThreadPool(Env* env,
   if (degree_of_parallelism >= 2) {
     int threads_to_create = degree_of_parallelism - 1;
 
+    const auto& cpu_info = CPUIDInfo::GetCPUIDInfo();
+    if (!cpu_info.HasCoreCapacities()) {
+      thread_options_.heterogeneous_scheduling = false;
+    }
+    if (thread_options_.heterogeneous_scheduling) {
+      thread_options_.efficiency_cores.clear();
+      for (const auto& affinity : thread_options_.affinities) {
+        thread_options_.efficiency_cores.push_back(
+            !affinity.empty() && std::all_of(affinity.begin(), affinity.end(), [&cpu_info](int processor) {
+              return cpu_info.IsEfficiencyCore(static_cast<uint32_t>(processor));
+            }));
+      }
+    }
+
     if (!thread_options_.affinities.empty()) {
       // Remove first affinity element as designated for the caller thread
       thread_options_.affinities.erase(thread_options_.affinities.begin());
       assert(thread_options_.affinities.size() >= size_t(threads_to_create));
     }
 
+    if (!thread_options_.numa_nodes.empty()) {
+      thread_options_.numa_nodes.erase(thread_options_.numa_nodes.begin());
+    }
+
+    if (!thread_options_.efficiency_cores.empty()) {
+      thread_options_.efficiency_cores.erase(thread_options_.efficiency_cores.begin());
+    }
+
     extended_eigen_threadpool_ =
         std::make_unique<ThreadPoolTempl<Env> >(name,
                                                 threads_to_create,
@@ -396,11 +533,24 @@ ThreadPool::ThreadPool(Env* env,
                                                 *env,
                                                 thread_options_);
     underlying_threadpool_ = extended_eigen_threadpool_.get();
+
+#ifndef ORT_NO_RTTI
+    // loops are told apart by the type of their body
+    if (thread_options_.parallel_for_calibration) {
+      calibration_ = std::make_unique<ParallelForCalibration>(thread_options_.parallel_for_calibration_file);
+    }
+#endif
   }
 }
 
 ThreadPool::~ThreadPool() = default;
 
+static uint64_t ScaleBlockSizeToCurrentCore(std::ptrdiff_t block_size) {
+  const auto& cpu_info = CPUIDInfo::GetCPUIDInfo();
+  const uint64_t capacity = cpu_info.GetCoreCapacity(cpu_info.GetCurrentCoreIdx());
+  return std::max<uint64_t>(1, static_cast<uint64_t>(block_size) * capacity / CPUIDInfo::kMaxCoreCapacity);
+}
+
 // Base case for parallel loops, running iterations 0..total, divided into blocks
 // of block_size iterations, and calling into a function that takes a start..end
 // range of indices to run.
@@ -425,11 +575,14 @@ void ThreadPool::ParallelForFixedBlockSizeScheduling(const std::ptrdiff_t total,
     assert(num_work_items > 0);
 
     LoopCounter lc(total, d_of_p, block_size);
+    const bool heterogeneous = thread_options_.heterogeneous_scheduling;
     std::function<void(unsigned)> run_work = [&](unsigned idx) {
       unsigned my_home_shard = lc.GetHomeShard(idx);
       unsigned my_shard = my_home_shard;
       uint64_t my_iter_start, my_iter_end;
-      while (lc.ClaimIterations(my_home_shard, my_shard, my_iter_start, my_iter_end, block_size)) {
+      // Slower cores claim proportionally smaller blocks, so that they do not hold up the end of the loop.
+      const uint64_t my_block_size = heterogeneous ? ScaleBlockSizeToCurrentCore(block_size) : block_size;
+      while (lc.ClaimIterations(my_home_shard, my_shard, my_iter_start, my_iter_end, my_block_size)) {
         fn(static_cast<std::ptrdiff_t>(my_iter_start),
            static_cast<std::ptrdiff_t>(my_iter_end));
       }
@@ -471,9 +624,48 @@ void ThreadPool::SimpleParallelFor(std::ptrdiff_t total, const std::function<voi
   });
 }
 
+namespace {
+thread_local ThreadPool::WorkClass current_work_class;
+
+bool IsDefaultWorkClass(const ThreadPool::WorkClass& work_class) {
+  return work_class.priority == ThreadPool::WorkPriority::kNormal && work_class.max_degree_of_parallelism <= 0;
+}
+
+// Runs the task with the work class of the thread that scheduled it.
+std::function<void()> WithCurrentWorkClass(std::function<void()> fn) {
+  if (IsDefaultWorkClass(current_work_class)) {
+    return fn;
+  }
+  return [work_class = current_work_class, fn = std::move(fn)]() {
+    ThreadPool::WorkClassScope scope(work_class);
+    fn();
+  };
+}
+}  // namespace
+
+ThreadPool::WorkClassScope::WorkClassScope(const WorkClass& work_class) : previous_(current_work_class) {
+  current_work_class = work_class;
+}
+
+ThreadPool::WorkClassScope::~WorkClassScope() {
+  current_work_class = previous_;
+}
+
+ThreadPool::WorkClass ThreadPool::CurrentWorkClass() {
+  return current_work_class;
+}
+
 void ThreadPool::Schedule(std::function<void()> fn) {
   if (underlying_threadpool_) {
-    underlying_threadpool_->Schedule(std::move(fn));
+    underlying_threadpool_->Schedule(WithCurrentWorkClass(std::move(fn)));
+  } else {
+    fn();
+  }
+}
+
+void ThreadPool::ScheduleLocal(std::function<void()> fn) {
+  if (underlying_threadpool_) {
+    underlying_threadpool_->ScheduleLocal(WithCurrentWorkClass(std::move(fn)));
   } else {
     fn();
   }
@@ -493,8 +685,24 @@ std::string ThreadPool::StopProfiling() {
   }
 }
 
+void ThreadPool::StartTimelineProfiling() {
+  if (underlying_threadpool_) {
+    underlying_threadpool_->StartTimelineProfiling();
+  }
+}
+
+std::vector<ThreadPoolTimelineEvent> ThreadPool::StopTimelineProfiling() {
+  if (underlying_threadpool_) {
+    return underlying_threadpool_->StopTimelineProfiling();
+  } else {
+    return {};
+  }
+}
+
 namespace {
 thread_local std::optional<ThreadPoolParallelSection> current_parallel_section;
+// Threads that the current parallel section counts in ThreadPool::interactive_dop_.
+thread_local int current_parallel_section_interactive_dop = 0;
 }
 
 ThreadPool::ParallelSection::ParallelSection(ThreadPool* tp) {
@@ -512,10 +720,44 @@ ThreadPool::ParallelSection::~ParallelSection() {
   if (current_parallel_section) {
     tp_->underlying_threadpool_->EndParallelSection(*ps_);
     current_parallel_section.reset();
+    tp_->interactive_dop_ -= current_parallel_section_interactive_dop;
+    current_parallel_section_interactive_dop = 0;
   }
 }
 
 void ThreadPool::RunInParallel(std::function<void(unsigned idx)> fn, unsigned n, std::ptrdiff_t block_size) {
+  const WorkClass& work_class = current_work_class;
+  if (work_class.max_degree_of_parallelism > 0) {
+    n = std::min(n, static_cast<unsigned>(work_class.max_degree_of_parallelism));
+  }
+  if (work_class.priority == WorkPriority::kBatch) {
+    // leave the threads of the running interactive loops to them
+    const int available = NumThreads() + 1 - interactive_dop_.load(std::memory_order_relaxed);
+    n = std::min(n, static_cast<unsigned>(std::max(available, 1)));
+  }
+  if (n <= 1) {
+    fn(0);
+    return;
+  }
+
+  if (work_class.priority == WorkPriority::kInteractive) {
+    if (current_parallel_section.has_value()) {
+      // the section keeps its threads until it ends
+      if (static_cast<int>(n) > current_parallel_section_interactive_dop) {
+        interactive_dop_ += static_cast<int>(n) - current_parallel_section_interactive_dop;
+        current_parallel_section_interactive_dop = static_cast<int>(n);
+      }
+    } else {
+      interactive_dop_ += static_cast<int>(n);
+      auto release = gsl::finally([this, n]() { interactive_dop_ -= static_cast<int>(n); });
+      RunInParallelImpl(std::move(fn), n, block_size);
+      return;
+    }
+  }
+  RunInParallelImpl(std::move(fn), n, block_size);
+}
+
+void ThreadPool::RunInParallelImpl(std::function<void(unsigned idx)> fn, unsigned n, std::ptrdiff_t block_size) {
   if (underlying_threadpool_) {
     if (current_parallel_section.has_value()) {
       underlying_threadpool_->RunInParallelSection(*current_parallel_section,
@@ -615,6 +857,24 @@ void ThreadPool::ParallelFor(std::ptrdiff_t n, const TensorOpCost& c,
   ORT_ENFORCE(n >= 0);
   Eigen::TensorOpCost cost{c.bytes_loaded, c.bytes_stored, c.compute_cycles};
   auto d_of_p = DegreeOfParallelism(this);
+#ifndef ORT_NO_RTTI
+  if (calibration_ && ShouldParallelizeLoop(n)) {
+    // The number of shards comes from the measurements of earlier runs of the same loop body.
+    const std::type_info& site = f.target_type();
+    const int shards = calibration_->ChooseShards(site, n, d_of_p);
+    const auto start = std::chrono::steady_clock::now();
+    if (shards == 1) {
+      f(0, n);
+    } else {
+      ptrdiff_t block = shards == d_of_p ? CalculateParallelForBlock(n, cost, nullptr, d_of_p)
+                                         : Eigen::divup<ptrdiff_t>(n, shards);
+      ParallelForFixedBlockSizeScheduling(n, block, f);
+    }
+    calibration_->Record(site, n, d_of_p, shards, std::chrono::steady_clock::now() - start);
+    return;
+  }
+#endif
+
   // Compute small problems directly in the caller thread.
   if ((!ShouldParallelizeLoop(n)) ||
       CostModel::numThreads(static_cast<double>(n), cost, d_of_p) == 1) {
@@ -663,6 +923,20 @@ std::string ThreadPool::StopProfiling(concurrency::ThreadPool* tp) {
   }
 }
 
+void ThreadPool::StartTimelineProfiling(concurrency::ThreadPool* tp) {
+  if (tp) {
+    tp->StartTimelineProfiling();
+  }
+}
+
+std::vector<ThreadPoolTimelineEvent> ThreadPool::StopTimelineProfiling(concurrency::ThreadPool* tp) {
+  if (tp) {
+    return tp->StopTimelineProfiling();
+  } else {
+    return {};
+  }
+}
+
 void ThreadPool::EnableSpinning() {
   if (extended_eigen_threadpool_) {
     extended_eigen_threadpool_->EnableSpinning();
@@ -675,6 +949,13 @@ void ThreadPool::DisableSpinning() {
   }
 }
 
+ThreadPoolSpinStatistics ThreadPool::GetSpinStatistics() const {
+  if (extended_eigen_threadpool_) {
+    return extended_eigen_threadpool_->GetSpinStatistics();
+  }
+  return {};
+}
+
 // Return the number of threads created by the pool.
 int ThreadPool::NumThreads() const {
   if (underlying_threadpool_) {
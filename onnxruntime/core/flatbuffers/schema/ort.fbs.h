@@ -369,6 +369,39 @@ template<> struct TypeInfoValueTraits<onnxruntime::fbs::MapType> {
 bool VerifyTypeInfoValue(flatbuffers::Verifier &verifier, const void *obj, TypeInfoValue type);
 bool VerifyTypeInfoValueVector(flatbuffers::Verifier &verifier, const flatbuffers::Vector<flatbuffers::Offset<void>> *values, const flatbuffers::Vector<uint8_t> *types);
 
+enum class CompressionType : int8_t {
+  NONE = 0,
+  LZ4 = 1,
+  BYTE_SHUFFLE_LZ4 = 2,
+  MIN = NONE,
+  MAX = BYTE_SHUFFLE_LZ4
+};
+
+inline const CompressionType (&EnumValuesCompressionType())[3] {
+  static const CompressionType values[] = {
+    CompressionType::NONE,
+    CompressionType::LZ4,
+    CompressionType::BYTE_SHUFFLE_LZ4
+  };
+  return values;
+}
+
+inline const char * const *EnumNamesCompressionType() {
+  static const char * const names[4] = {
+    "NONE",
+    "LZ4",
+    "BYTE_SHUFFLE_LZ4",
+    nullptr
+  };
+  return names;
+}
+
+inline const char *EnumNameCompressionType(CompressionType e) {
+  if (flatbuffers::IsOutRange(e, CompressionType::NONE, CompressionType::BYTE_SHUFFLE_LZ4)) return "";
+  const size_t index = static_cast<size_t>(e);
+  return EnumNamesCompressionType()[index];
+}
+
 enum class ArgType : int8_t {
   INPUT = 0,
   OUTPUT = 1,
@@ -1315,7 +1348,8 @@ struct Tensor FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
     VT_DIMS = 8,
     VT_DATA_TYPE = 10,
     VT_RAW_DATA = 12,
-    VT_STRING_DATA = 14
+    VT_STRING_DATA = 14,
+    VT_RAW_DATA_COMPRESSION = 16
   };
   const flatbuffers::String *name() const {
     return GetPointer<const flatbuffers::String *>(VT_NAME);
@@ -1335,6 +1369,9 @@ struct Tensor FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
   const flatbuffers::Vector<flatbuffers::Offset<flatbuffers::String>> *string_data() const {
     return GetPointer<const flatbuffers::Vector<flatbuffers::Offset<flatbuffers::String>> *>(VT_STRING_DATA);
   }
+  onnxruntime::fbs::CompressionType raw_data_compression() const {
+    return static_cast<onnxruntime::fbs::CompressionType>(GetField<int8_t>(VT_RAW_DATA_COMPRESSION, 0));
+  }
   bool Verify(flatbuffers::Verifier &verifier) const {
     return VerifyTableStart(verifier) &&
            VerifyOffset(verifier, VT_NAME) &&
@@ -1349,6 +1386,7 @@ struct Tensor FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
            VerifyOffset(verifier, VT_STRING_DATA) &&
            verifier.VerifyVector(string_data()) &&
            verifier.VerifyVectorOfStrings(string_data()) &&
+           VerifyField<int8_t>(verifier, VT_RAW_DATA_COMPRESSION) &&
            verifier.EndTable();
   }
 };
@@ -1375,6 +1413,9 @@ struct TensorBuilder {
   void add_string_data(flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<flatbuffers::String>>> string_data) {
     fbb_.AddOffset(Tensor::VT_STRING_DATA, string_data);
   }
+  void add_raw_data_compression(onnxruntime::fbs::CompressionType raw_data_compression) {
+    fbb_.AddElement<int8_t>(Tensor::VT_RAW_DATA_COMPRESSION, static_cast<int8_t>(raw_data_compression), 0);
+  }
   explicit TensorBuilder(flatbuffers::FlatBufferBuilder &_fbb)
         : fbb_(_fbb) {
     start_ = fbb_.StartTable();
@@ -1394,7 +1435,8 @@ inline flatbuffers::Offset<Tensor> CreateTensor(
     flatbuffers::Offset<flatbuffers::Vector<int64_t>> dims = 0,
     onnxruntime::fbs::TensorDataType data_type = onnxruntime::fbs::TensorDataType::UNDEFINED,
     flatbuffers::Offset<flatbuffers::Vector<uint8_t>> raw_data = 0,
-    flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<flatbuffers::String>>> string_data = 0) {
+    flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<flatbuffers::String>>> string_data = 0,
+    onnxruntime::fbs::CompressionType raw_data_compression = onnxruntime::fbs::CompressionType::NONE) {
   TensorBuilder builder_(_fbb);
   builder_.add_string_data(string_data);
   builder_.add_raw_data(raw_data);
@@ -1402,6 +1444,7 @@ inline flatbuffers::Offset<Tensor> CreateTensor(
   builder_.add_dims(dims);
   builder_.add_doc_string(doc_string);
   builder_.add_name(name);
+  builder_.add_raw_data_compression(raw_data_compression);
   return builder_.Finish();
 }
 
@@ -1412,7 +1455,8 @@ inline flatbuffers::Offset<Tensor> CreateTensorDirect(
     const std::vector<int64_t> *dims = nullptr,
     onnxruntime::fbs::TensorDataType data_type = onnxruntime::fbs::TensorDataType::UNDEFINED,
     const std::vector<uint8_t> *raw_data = nullptr,
-    const std::vector<flatbuffers::Offset<flatbuffers::String>> *string_data = nullptr) {
+    const std::vector<flatbuffers::Offset<flatbuffers::String>> *string_data = nullptr,
+    onnxruntime::fbs::CompressionType raw_data_compression = onnxruntime::fbs::CompressionType::NONE) {
   auto name__ = name ? _fbb.CreateString(name) : 0;
   auto doc_string__ = doc_string ? _fbb.CreateString(doc_string) : 0;
   auto dims__ = dims ? _fbb.CreateVector<int64_t>(*dims) : 0;
@@ -1425,7 +1469,8 @@ inline flatbuffers::Offset<Tensor> CreateTensorDirect(
       dims__,
       data_type,
       raw_data__,
-      string_data__);
+      string_data__,
+      raw_data_compression);
 }
 
 struct SparseTensor FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
@@ -0,0 +1,249 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/flatbuffers/tensor_compression.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "core/common/common.h"
+#include "core/flatbuffers/schema/ort.fbs.h"
+
+namespace onnxruntime::fbs::utils {
+
+// The compressed data uses the LZ4 block format (https://github.com/lz4/lz4/blob/dev/doc/lz4_Block_format.md), so
+// it can be produced or inspected by other tools. A block is a series of sequences, each made of a token, literals
+// copied as-is and a match copied from earlier in the output. The last sequence only has literals.
+namespace {
+
+constexpr size_t kMinMatch = 4;
+// The last 5 bytes are always literals, and the last match must start at least 12 bytes before the end of the block.
+constexpr size_t kLastLiterals = 5;
+constexpr size_t kMatchStartLimit = 12;
+constexpr size_t kMaxOffset = 65535;
+constexpr int kHashLog = 16;
+
+constexpr auto kInvalidCompressedDataMessage = "Invalid compressed initializer data. Invalid ORT format model.";
+
+#if !defined(ORT_MINIMAL_BUILD)
+
+inline uint32_t Read32(const uint8_t* p) {
+  uint32_t value;
+  std::memcpy(&value, p, sizeof(value));
+  return value;
+}
+
+inline uint32_t Hash(uint32_t sequence) {
+  return (sequence * 2654435761U) >> (32 - kHashLog);
+}
+
+// Lengths of 15 or more are continued in the following bytes, each adding up to 255.
+void WriteLengthContinuation(size_t length, std::vector<uint8_t>& dst) {
+  length -= 15;
+  while (length >= 255) {
+    dst.push_back(255);
+    length -= 255;
+  }
+  dst.push_back(static_cast<uint8_t>(length));
+}
+
+void WriteSequence(const uint8_t* literals, size_t literal_length, size_t offset, size_t match_length,
+                   std::vector<uint8_t>& dst) {
+  const size_t match_code = match_length > 0 ? match_length - kMinMatch : 0;
+  dst.push_back(static_cast<uint8_t>((std::min<size_t>(literal_length, 15) << 4) | std::min<size_t>(match_code, 15)));
+  if (literal_length >= 15) {
+    WriteLengthContinuation(literal_length, dst);
+  }
+  dst.insert(dst.end(), literals, literals + literal_length);
+
+  if (match_length > 0) {
+    dst.push_back(static_cast<uint8_t>(offset & 0xff));
+    dst.push_back(static_cast<uint8_t>(offset >> 8));
+    if (match_code >= 15) {
+      WriteLengthContinuation(match_code, dst);
+    }
+  }
+}
+
+// Greedy compression with a single-entry hash table of the positions of 4-byte sequences.
+void Lz4Compress(gsl::span<const uint8_t> src, std::vector<uint8_t>& dst) {
+  const uint8_t* base = src.data();
+  const size_t size = src.size();
+  dst.clear();
+  dst.reserve(size + size / 255 + 16);
+
+  size_t anchor = 0;
+  if (size > kMatchStartLimit) {
+    std::vector<uint32_t> table(size_t{1} << kHashLog, 0);
+    const size_t match_start_limit = size - kMatchStartLimit;
+    const size_t match_end_limit = size - kLastLiterals;
+
+    size_t pos = 1;
+    while (pos <= match_start_limit) {
+      const uint32_t sequence = Read32(base + pos);
+      uint32_t& entry = table[Hash(sequence)];
+      size_t candidate = entry;
+      entry = static_cast<uint32_t>(pos);
+
+      if (pos - candidate > kMaxOffset || Read32(base + candidate) != sequence) {
+        // skip ahead faster through data that does not compress
+        pos += 1 + ((pos - anchor) >> 6);
+        continue;
+      }
+
+      size_t match_length = kMinMatch;
+      while (pos + match_length < match_end_limit && base[candidate + match_length] == base[pos + match_length]) {
+        ++match_length;
+      }
+      while (pos > anchor && candidate > 0 && base[pos - 1] == base[candidate - 1]) {
+        --pos;
+        --candidate;
+        ++match_length;
+      }
+
+      WriteSequence(base + anchor, pos - anchor, pos - candidate, match_length, dst);
+      pos += match_length;
+      anchor = pos;
+    }
+  }
+
+  WriteSequence(base + anchor, size - anchor, 0, 0, dst);
+}
+
+// Byte shuffling transposes the (num_elements x element_size) bytes of the data, grouping the n-th byte of all the
+// elements. The high-order bytes of numeric data vary less than the low-order ones, which makes for longer matches.
+// Trailing bytes that do not make up an element are left in place.
+void ByteShuffle(gsl::span<const uint8_t> src, size_t element_size, gsl::span<uint8_t> dst) {
+  const size_t num_elements = src.size() / element_size;
+  for (size_t i = 0; i < num_elements; ++i) {
+    for (size_t b = 0; b < element_size; ++b) {
+      dst[b * num_elements + i] = src[i * element_size + b];
+    }
+  }
+  const size_t shuffled_size = num_elements * element_size;
+  std::memcpy(dst.data() + shuffled_size, src.data() + shuffled_size, src.size() - shuffled_size);
+}
+
+#endif  // !defined(ORT_MINIMAL_BUILD)
+
+bool ReadLengthContinuation(const uint8_t*& ip, const uint8_t* iend, size_t& length) {
+  uint8_t value;
+  do {
+    if (ip == iend) {
+      return false;
+    }
+    value = *ip++;
+    length += value;
+  } while (value == 255);
+  return true;
+}
+
+Status Lz4Decompress(gsl::span<const uint8_t> src, gsl::span<uint8_t> dst) {
+  const uint8_t* ip = src.data();
+  const uint8_t* const iend = ip + src.size();
+  uint8_t* op = dst.data();
+  uint8_t* const oend = op + dst.size();
+
+  for (;;) {
+    ORT_RETURN_IF(ip == iend, kInvalidCompressedDataMessage);
+    const uint8_t token = *ip++;
+
+    size_t literal_length = token >> 4;
+    if (literal_length == 15) {
+      ORT_RETURN_IF_NOT(ReadLengthContinuation(ip, iend, literal_length), kInvalidCompressedDataMessage);
+    }
+    ORT_RETURN_IF(literal_length > static_cast<size_t>(iend - ip) || literal_length > static_cast<size_t>(oend - op),
+                  kInvalidCompressedDataMessage);
+    std::memcpy(op, ip, literal_length);
+    ip += literal_length;
+    op += literal_length;
+
+    if (ip == iend) {
+      break;
+    }
+
+    ORT_RETURN_IF(iend - ip < 2, kInvalidCompressedDataMessage);
+    const size_t offset = static_cast<size_t>(ip[0]) | (static_cast<size_t>(ip[1]) << 8);
+    ip += 2;
+    ORT_RETURN_IF(offset == 0 || offset > static_cast<size_t>(op - dst.data()), kInvalidCompressedDataMessage);
+
+    size_t match_length = token & 15;
+    if (match_length == 15) {
+      ORT_RETURN_IF_NOT(ReadLengthContinuation(ip, iend, match_length), kInvalidCompressedDataMessage);
+    }
+    match_length += kMinMatch;
+    ORT_RETURN_IF(match_length > static_cast<size_t>(oend - op), kInvalidCompressedDataMessage);
+
+    // an overlapping match repeats the last `offset` bytes of the output
+    const uint8_t* match = op - offset;
+    if (offset >= match_length) {
+      std::memcpy(op, match, match_length);
+      op += match_length;
+    } else {
+      for (size_t i = 0; i < match_length; ++i) {
+        *op++ = *match++;
+      }
+    }
+  }
+
+  ORT_RETURN_IF(op != oend, "Decompressed initializer data has ", op - dst.data(), " bytes, expected ", dst.size(),
+                ". Invalid ORT format model.");
+  return Status::OK();
+}
+
+// Reverts ByteShuffle.
+void ByteUnshuffle(gsl::span<const uint8_t> src, size_t element_size, gsl::span<uint8_t> dst) {
+  const size_t num_elements = src.size() / element_size;
+  for (size_t b = 0; b < element_size; ++b) {
+    for (size_t i = 0; i < num_elements; ++i) {
+      dst[i * element_size + b] = src[b * num_elements + i];
+    }
+  }
+  const size_t shuffled_size = num_elements * element_size;
+  std::memcpy(dst.data() + shuffled_size, src.data() + shuffled_size, src.size() - shuffled_size);
+}
+
+}  // namespace
+
+#if !defined(ORT_MINIMAL_BUILD)
+
+bool CompressTensorRawData(gsl::span<const uint8_t> raw_data, size_t element_size,
+                           fbs::CompressionType compression, std::vector<uint8_t>& compressed) {
+  switch (compression) {
+    case fbs::CompressionType::LZ4:
+      Lz4Compress(raw_data, compressed);
+      break;
+    case fbs::CompressionType::BYTE_SHUFFLE_LZ4: {
+      ORT_ENFORCE(element_size > 0, "Byte shuffling requires the size of the elements.");
+      std::vector<uint8_t> shuffled(raw_data.size());
+      ByteShuffle(raw_data, element_size, shuffled);
+      Lz4Compress(shuffled, compressed);
+    } break;
+    default:
+      ORT_THROW("Unsupported initializer compression: ", fbs::EnumNameCompressionType(compression));
+  }
+
+  return compressed.size() < raw_data.size();
+}
+
+#endif  // !defined(ORT_MINIMAL_BUILD)
+
+Status DecompressTensorRawData(fbs::CompressionType compression, gsl::span<const uint8_t> compressed,
+                               size_t element_size, gsl::span<uint8_t> raw_data) {
+  switch (compression) {
+    case fbs::CompressionType::LZ4:
+      return Lz4Decompress(compressed, raw_data);
+    case fbs::CompressionType::BYTE_SHUFFLE_LZ4: {
+      ORT_RETURN_IF(element_size == 0, "Byte shuffled initializer data requires an element size.");
+      std::vector<uint8_t> shuffled(raw_data.size());
+      ORT_RETURN_IF_ERROR(Lz4Decompress(compressed, shuffled));
+      ByteUnshuffle(shuffled, element_size, raw_data);
+      return Status::OK();
+    }
+    default:
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Unsupported initializer compression: ",
+                             static_cast<int>(compression), ". Invalid ORT format model.");
+  }
+}
+
+}  // namespace onnxruntime::fbs::utils
@@ -0,0 +1,51 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "core/common/gsl.h"
+#include "core/common/status.h"
+
+namespace onnxruntime {
+
+namespace fbs {
+enum class CompressionType : int8_t;
+
+namespace utils {
+
+// The raw data of smaller initializers is not worth compressing, and is left in place in the flatbuffer so that it
+// can still be used directly when the ORT format model bytes are used for initializers.
+constexpr size_t kMinCompressedRawDataSize = 1024;
+
+#if !defined(ORT_MINIMAL_BUILD)
+
+/// <summary>
+/// Compresses the raw data of a tensor.
+/// </summary>
+/// <param name="raw_data">Raw data of the tensor.</param>
+/// <param name="element_size">Size in bytes of an element, which byte shuffling groups the bytes of.</param>
+/// <param name="compression">Compression to apply. Must not be CompressionType::NONE.</param>
+/// <param name="compressed">Compressed data.</param>
+/// <returns>True if the compressed data is smaller than the raw data.</returns>
+bool CompressTensorRawData(gsl::span<const uint8_t> raw_data, size_t element_size,
+                           fbs::CompressionType compression, std::vector<uint8_t>& compressed);
+
+#endif  // !defined(ORT_MINIMAL_BUILD)
+
+/// <summary>
+/// Decompresses the raw data of a tensor.
+/// </summary>
+/// <param name="compression">Compression that was applied to the raw data.</param>
+/// <param name="compressed">Compressed data.</param>
+/// <param name="element_size">Size in bytes of an element of the tensor.</param>
+/// <param name="raw_data">Buffer to decompress into. Its size must be the size of the raw data of the tensor.</param>
+/// <returns>Status. The compressed data is validated, so an invalid model results in an error.</returns>
+Status DecompressTensorRawData(fbs::CompressionType compression, gsl::span<const uint8_t> compressed,
+                               size_t element_size, gsl::span<uint8_t> raw_data);
+
+}  // namespace utils
+}  // namespace fbs
+}  // namespace onnxruntime
@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "core/framework/allocation_planner.h"
+#include <limits>
 #include <list>
 #include <algorithm>
 #include <deque>
@@ -219,6 +220,12 @@ class PlannerImpl {
   // they became free (more recently freed earlier in the list).
   std::list<FreeBufferInfo> freelist_;
 
+  // the values of SequentialExecutionPlan::concats_in_place, inputs and outputs
+  InlinedHashSet<OrtValueIndex> concat_in_place_values_;
+
+  // the outputs of the nodes of SequentialExecutionPlan::host_shape_program
+  InlinedHashSet<OrtValueIndex> host_shape_values_;
+
   OrtValueIndex Index(const OrtValueName& name) {
     OrtValueIndex result;
     auto status = ort_value_name_idx_map_.GetIdx(name, result);
@@ -380,8 +387,12 @@ class PlannerImpl {
           input_args[pair.first]->Exists()) {
         bool can_strided = true;
         for (auto it = node.OutputNodesBegin(); it != node.OutputNodesEnd(); ++it) {
+          // a consumer with subgraphs passes its implicit inputs to kernels of the subgraphs, which are not
+          // checked here, so they are never given a strided tensor
           const KernelCreateInfo& output_node_ci = GetKernelCreateInfo(kernel_create_info_map_, it->Index());
-          if (!output_node_ci.kernel_def) {
+          if (!output_node_ci.kernel_def || it->ContainsSubgraph() ||
+              std::find(it->ImplicitInputDefs().begin(), it->ImplicitInputDefs().end(), p_output_arg) !=
+                  it->ImplicitInputDefs().end()) {
             can_strided = false;
             break;
           }
@@ -1069,7 +1080,8 @@ class PlannerImpl {
         OrtValueIndex output_idx_global{};
 
         if (!value_map.GetIdx(p_output_arg->Name(), output_idx_global).IsOK() ||
-            allocation_plan[output_idx_global].alloc_kind != AllocKind::kAllocate) {
+            allocation_plan[output_idx_global].alloc_kind != AllocKind::kAllocate ||
+            host_shape_values_.count(output_idx_global) != 0) {
           continue;
         }
 
@@ -1187,6 +1199,10 @@ class PlannerImpl {
               allocation_plan[output_idx_global].alloc_kind != AllocKind::kAllocate) {
             continue;  // skip when it is already reused
           }
+          // the host shape values are written before any node runs, their buffers are shared with no other value
+          if (host_shape_values_.count(output_idx_global) != 0) {
+            continue;
+          }
 
           const auto* shape = context_->GetShape(*node_output);
           if (!shape) continue;
@@ -1298,7 +1314,79 @@ class PlannerImpl {
   }
 #endif
 
+  // Finds the inputs of CPU Concat nodes that may be placed in the output of the Concat, see
+  // SequentialExecutionPlan::ConcatInPlace. Must be called after ComputeReuseCount(), an input qualifies if the
+  // Concat is its only use. ComputeSingleStreamReusePlan() then plans the inputs and the outputs of these Concat
+  // nodes as allocations, and keeps the buffers of the inputs out of the freelist.
+  void PlanConcatInPlace(size_t stream_index) {
+    const auto& graph_outputs = graph_viewer_.GetOutputs();
+    for (NodeIndex node_index : stream_nodes_[stream_index]) {
+      const auto* pnode = graph_viewer_.GetNode(node_index);
+      if (pnode->OpType() != "Concat" || pnode->Domain() != kOnnxDomain ||
+          pnode->GetExecutionProviderType() != kCpuExecutionProvider) {
+        continue;
+      }
+      const auto* output = pnode->OutputDefs()[0];
+      const auto& attributes = pnode->GetAttributes();
+      const auto axis_attr = attributes.find("axis");
+      if (axis_attr == attributes.end() || !output->Exists() || IsNonTensor(*output) || HasExternalOutputs(*pnode)) {
+        continue;
+      }
+
+      SequentialExecutionPlan::ConcatInPlace concat{Index(output->Name()), axis_attr->second.i(), {}};
+      InlinedVector<OrtValueIndex> placeable_inputs;
+      for (const auto* input : pnode->InputDefs()) {
+        const auto input_index = Index(input->Name());
+        concat.inputs.push_back(input_index);
+        const auto* producer = graph_viewer_.GetProducerNode(input->Name());
+        if (producer == nullptr || UseCount(input_index) != 1 ||
+            node_stream_map_[producer->Index()] != stream_index ||
+            AllocPlan(input_index).location != AllocPlan(concat.output).location ||
+            std::find(graph_outputs.begin(), graph_outputs.end(), input) != graph_outputs.end() ||
+            IsNonTensor(*input) ||
+            input->TypeAsProto()->tensor_type().elem_type() == ONNX_NAMESPACE::TensorProto_DataType_STRING ||
+            !CanAllocateOutput(*producer, *input)) {
+          continue;
+        }
+        placeable_inputs.push_back(input_index);
+      }
+      if (placeable_inputs.empty()) {
+        continue;
+      }
+
+      for (OrtValueIndex input_index : placeable_inputs) {
+        plan_.concat_in_place_inputs[input_index] = plan_.concats_in_place.size();
+        concat_in_place_values_.insert(input_index);
+      }
+      concat_in_place_values_.insert(concat.output);
+      plan_.concats_in_place.push_back(std::move(concat));
+    }
+  }
+
+  // Whether the kernel of the node may get a buffer of its own for the output, i.e. the output does not have to
+  // alias one of its inputs.
+  bool CanAllocateOutput(const Node& node, const NodeArg& output) const {
+    const KernelCreateInfo& ci = GetKernelCreateInfo(kernel_create_info_map_, node.Index());
+    if (ci.kernel_def == nullptr || ci.kernel_def->HasExternalOutputs()) {
+      return false;
+    }
+    const auto output_defs = node.OutputDefs();
+    const int output_arg_num = static_cast<int>(
+        std::find(output_defs.begin(), output_defs.end(), &output) - output_defs.begin());
+    const auto& alias_map = ci.kernel_def->Alias();
+    if (std::any_of(alias_map.begin(), alias_map.end(),
+                    [output_arg_num](const auto& pair) { return pair.second == output_arg_num; })) {
+      return false;
+    }
+    const auto& variadic_alias_offsets = ci.kernel_def->VariadicAlias();
+    return !variadic_alias_offsets.has_value() || output_arg_num < variadic_alias_offsets->second;
+  }
+
   Status ComputeReusePlan() {
+    // the placement in the output of a Concat relies on the order of the allocations of a single stream
+    const bool plan_concat_in_place = context_->IsConcatInPlaceEnabled() && !plan_.dynamic_scheduling &&
+                                      !context_->IsSymbolicMemoryPlanningEnabled() &&
+                                      plan_.NumberOfValidStreams() == 1;
     gsl::not_null<const ISequentialPlannerContext*> backup_context = context_;
     SequentialPlannerContext no_mem_reuse_context(ExecutionMode::ORT_PARALLEL, ExecutionOrder::DEFAULT, false);
     if (!IsSingleStream()) {
@@ -1313,6 +1401,9 @@ class PlannerImpl {
     for (size_t i = 0; i < stream_nodes_.size(); ++i) {
       // compute use count first
       ORT_RETURN_IF_ERROR(ComputeReuseCount());
+      if (plan_concat_in_place && !stream_nodes_[i].empty()) {
+        PlanConcatInPlace(i);
+      }
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
       if (i == 0) {
         for (auto ort_value_info : ort_value_info_) {
@@ -1334,7 +1425,10 @@ class PlannerImpl {
     context_ = backup_context;
 
 #ifdef ORT_ENABLE_STREAM
-    ORT_RETURN_IF_ERROR(OptimizeReusePlanForMultiStream());
+    // the multi-stream reuse plan relies on the order of the nodes within each stream
+    if (!plan_.dynamic_scheduling) {
+      ORT_RETURN_IF_ERROR(OptimizeReusePlanForMultiStream());
+    }
 #endif
 
     return Status::OK();
@@ -1406,6 +1500,12 @@ class PlannerImpl {
               }
             }
           }
+        } else if (concat_in_place_values_.count(current) != 0) {
+          // the inputs of a Concat placed in its output and that output must have buffers of their own
+          AllocPlan(current).alloc_kind = AllocKind::kAllocate;
+        } else if (host_shape_values_.count(current) != 0) {
+          // written when the execution starts, before the values whose buffers it could reuse are released
+          AllocPlan(current).alloc_kind = AllocKind::kAllocate;
         } else if (!context_->IsParallelExecutionEnabled() &&
                    FindReusableInput(*pnode, static_cast<int>(output_arg_def_index), &reused, &is_strided_tensor)) {
           // Re-using inputs is applicable for tensors, sequence tensors,
@@ -1440,7 +1540,9 @@ class PlannerImpl {
           auto original = Buffer(Index(sym));
           // The index will be -1 if it's an initializer that was removed as part of a temporary workaround.
           // See comments in the OrtValueInfo definition.
-          if ((original != -1) && (0 == DecrementUseCount(original))) {
+          // the buffer of an input placed in the output of a Concat is part of the buffer of that output
+          if ((original != -1) && (0 == DecrementUseCount(original)) &&
+              plan_.concat_in_place_inputs.count(original) == 0) {
             freelist_.push_front(FreeBufferInfo(original, program_counter));
           }
         }
@@ -1697,7 +1799,8 @@ class PlannerImpl {
             break;
           }
         }
-        if (is_all_consumer_same_stream) {
+        // with dynamic scheduling, the consumers on a stream do not run in stream order
+        if (is_all_consumer_same_stream && !plan_.dynamic_scheduling) {
           // all the consumers are on the same stream, so the first element is the last consumer int the stream.
           process_consumer(release_action_idx, value_consumers[i][0]);
         } else {
@@ -1711,6 +1814,273 @@ class PlannerImpl {
     return Status::OK();
   }
 
+  // Counts the values by the kind of buffer they are planned to use, see SequentialExecutionPlan::BufferReuseStats.
+  void ComputeBufferReuseStats() {
+    auto& stats = plan_.buffer_reuse_stats;
+    stats = {};
+    for (size_t i = 0; i < ort_value_info_.size(); ++i) {
+      const auto& alloc_plan = plan_.allocation_plan[i];
+      const auto* def_site = ort_value_info_[i].p_def_site;
+      size_t* bytes = nullptr;
+      if (alloc_plan.alloc_kind == AllocKind::kAllocate) {
+        ++stats.num_allocated;
+        bytes = &stats.allocated_bytes;
+      } else if (alloc_plan.alloc_kind == AllocKind::kReuse && ort_value_info_[i].is_inplace_reuse) {
+        ++stats.num_inplace_reused;
+        bytes = &stats.inplace_reused_bytes;
+      } else if (alloc_plan.alloc_kind == AllocKind::kReuse) {
+        ++stats.num_reused;
+        bytes = &stats.reused_bytes;
+      } else {
+        continue;
+      }
+
+      if (def_site == nullptr || alloc_plan.value_type == nullptr || !alloc_plan.value_type->IsTensorType()) {
+        continue;
+      }
+      const auto* shape = context_->GetShape(*def_site);
+      if (shape == nullptr) {
+        continue;
+      }
+      SafeInt<size_t> size = static_cast<const TensorTypeBase*>(alloc_plan.value_type)->GetElementType()->Size();
+      bool is_static = true;
+      for (const auto& dim : shape->dim()) {
+        if (!dim.has_dim_value() || dim.dim_value() < 0) {
+          is_static = false;
+          break;
+        }
+        size *= dim.dim_value();
+      }
+      if (is_static) {
+        *bytes += size;
+      }
+    }
+  }
+
+  // Computes the number of elements of the tensor 'arg' as a function of the symbolic dimensions of the
+  // graph inputs. Returns false if the tensor is not planned in memory patterns or its shape is unknown.
+  bool TryGetSymbolicSize(const NodeArg& arg, OrtValueIndex value_idx,
+                          const InlinedHashMap<std::string, size_t>& dimension_indices,
+                          SequentialExecutionPlan::SymbolicMemoryPlan::Step& step) {
+    const auto& alloc_plan = AllocPlan(value_idx);
+    if (alloc_plan.alloc_kind != AllocKind::kAllocate ||
+        alloc_plan.location.MemType() != OrtDevice::MemType::DEFAULT ||
+        alloc_plan.value_type == nullptr || !alloc_plan.value_type->IsTensorType()) {
+      return false;
+    }
+    const auto* element_type = static_cast<const TensorTypeBase*>(alloc_plan.value_type)->GetElementType();
+    if (utils::IsDataTypeString(element_type)) {
+      return false;
+    }
+    const auto* shape = context_->GetShape(arg);
+    if (shape == nullptr) {
+      return false;
+    }
+
+    SafeInt<size_t> num_fixed_elements = 1;
+    for (const auto& dim : shape->dim()) {
+      if (dim.has_dim_value() && dim.dim_value() >= 0) {
+        num_fixed_elements *= dim.dim_value();
+      } else if (dim.has_dim_param()) {
+        auto it = dimension_indices.find(dim.dim_param());
+        if (it == dimension_indices.end()) {
+          // e.g. a dimension named by shape inference for a data dependent shape
+          return false;
+        }
+        step.dimensions.push_back(it->second);
+      } else {
+        return false;
+      }
+    }
+    step.value = value_idx;
+    step.element_size = element_type->Size();
+    step.num_fixed_elements = num_fixed_elements;
+    return true;
+  }
+
+  // Collects the nodes of SequentialExecutionPlan::host_shape_program: the CPU nodes of the main graph whose inputs are
+  // graph inputs (Shape only), constant int64 initializers or outputs of the nodes collected before them, and whose
+  // single output is an int64 tensor. Must be called before ComputeReusePlan(), which gives their outputs buffers of
+  // their own.
+  void BuildHostShapeProgram() {
+    using HostShapeOp = SequentialExecutionPlan::HostShapeProgram::Op;
+    static const InlinedHashMap<std::string, HostShapeOp> kHostShapeOps = {
+        {"Shape", HostShapeOp::kShape},
+        {"Gather", HostShapeOp::kGather},
+        {"Unsqueeze", HostShapeOp::kUnsqueeze},
+        {"Squeeze", HostShapeOp::kSqueeze},
+        {"Concat", HostShapeOp::kConcat},
+        {"Add", HostShapeOp::kAdd},
+        {"Sub", HostShapeOp::kSub},
+        {"Mul", HostShapeOp::kMul},
+        {"Div", HostShapeOp::kDiv},
+        {"Identity", HostShapeOp::kIdentity},
+    };
+    const auto is_int64_tensor = [this](const NodeArg& arg) {
+      return !IsNonTensor(arg) &&
+             arg.TypeAsProto()->tensor_type().elem_type() == ONNX_NAMESPACE::TensorProto_DataType_INT64;
+    };
+
+    const auto& graph_inputs = graph_viewer_.GetInputs();
+    const auto& graph_outputs = graph_viewer_.GetOutputs();
+    SequentialExecutionPlan::HostShapeProgram program;
+    InlinedHashSet<const NodeArg*> shape_values;
+    for (NodeIndex node_index : graph_viewer_.GetNodesInTopologicalOrder(context_->GetExecutionOrder())) {
+      const auto* pnode = graph_viewer_.GetNode(node_index);
+      const auto op = kHostShapeOps.find(pnode->OpType());
+      if (op == kHostShapeOps.end() || pnode->Domain() != kOnnxDomain ||
+          pnode->GetExecutionProviderType() != kCpuExecutionProvider || !pnode->ImplicitInputDefs().empty() ||
+          pnode->OutputDefs().size() != 1) {
+        continue;
+      }
+      const auto* output = pnode->OutputDefs()[0];
+      if (!output->Exists() || !is_int64_tensor(*output) ||
+          std::find(graph_outputs.begin(), graph_outputs.end(), output) != graph_outputs.end()) {
+        continue;
+      }
+
+      SequentialExecutionPlan::HostShapeProgram::Instruction instruction{node_index, op->second};
+      const auto& attributes = pnode->GetAttributes();
+      bool supported = true;
+      if (op->second == HostShapeOp::kShape) {
+        supported = std::find(graph_inputs.begin(), graph_inputs.end(), pnode->InputDefs()[0]) != graph_inputs.end();
+        if (const auto start = attributes.find("start"); start != attributes.end()) {
+          instruction.start = start->second.i();
+        }
+        if (const auto end = attributes.find("end"); end != attributes.end()) {
+          instruction.end = end->second.i();
+        }
+      } else {
+        for (const auto* input : pnode->InputDefs()) {
+          if (input->Exists() &&
+              (!is_int64_tensor(*input) ||
+               (shape_values.count(input) == 0 && !graph_viewer_.IsConstantInitializer(input->Name(), false)))) {
+            supported = false;
+            break;
+          }
+        }
+        if (const auto axis = attributes.find("axis"); axis != attributes.end()) {
+          // the values are 1-D, only Gather and Concat along the first axis are evaluated
+          const int64_t axis_value = axis->second.i();
+          supported = supported && (axis_value == 0 || (op->second == HostShapeOp::kConcat && axis_value == -1));
+        }
+        if (const auto axes = attributes.find("axes"); axes != attributes.end()) {
+          instruction.axes.emplace(axes->second.ints().begin(), axes->second.ints().end());
+        }
+      }
+      if (!supported) {
+        continue;
+      }
+
+      shape_values.insert(output);
+      host_shape_values_.insert(Index(output->Name()));
+      program.instructions.push_back(std::move(instruction));
+    }
+    if (!program.instructions.empty()) {
+      plan_.host_shape_program = std::move(program);
+    }
+  }
+
+  // Flattens the plan into SequentialExecutionPlan::lean_program if it has a single CPU stream of kernel launches.
+  // Must be called after GenerateDeallocationPlan().
+  void BuildLeanProgram() {
+    if (plan_.dynamic_scheduling || plan_.NumberOfValidStreams() != 1) {
+      return;
+    }
+    const auto stream = std::find_if(plan_.execution_plan.begin(), plan_.execution_plan.end(),
+                                     [](const auto& logic_stream) { return !logic_stream->steps_.empty(); });
+    if ((*stream)->device_.Type() != OrtDevice::CPU) {
+      return;
+    }
+
+    SequentialExecutionPlan::LeanProgram program;
+    program.stream_index = static_cast<size_t>(stream - plan_.execution_plan.begin());
+    program.instructions.reserve((*stream)->steps_.size());
+    for (const auto& step : (*stream)->steps_) {
+      if (dynamic_cast<const LaunchKernelStep*>(step.get()) == nullptr) {
+        return;
+      }
+      const NodeIndex node_index = step->GetNodeIndex();
+      const auto* node = graph_viewer_.GetNode(node_index);
+      // YieldOp is not run but releases its inputs, see ExecuteKernel
+      if (node->OpType() == "YieldOp") {
+        return;
+      }
+#ifdef ENABLE_TRAINING
+      const KernelCreateInfo& ci = GetKernelCreateInfo(kernel_create_info_map_, node_index);
+      if (ci.kernel_def == nullptr || ci.kernel_def->AllocateInputsContiguously()) {
+        return;
+      }
+#endif
+      SequentialExecutionPlan::LeanProgram::Instruction instruction{node_index, program.released_values.size(), 0};
+      for (size_t release_action_idx : plan_.node_release_list[node_index]) {
+        const auto& release_action = plan_.release_actions[release_action_idx];
+        // with a single stream, each value is released by its last consumer
+        if (release_action.ref_count != 1) {
+          return;
+        }
+        program.released_values.push_back(static_cast<OrtValueIndex>(release_action.value_index));
+      }
+      instruction.release_end = program.released_values.size();
+      program.instructions.push_back(instruction);
+    }
+    plan_.lean_program = std::move(program);
+  }
+
+  // Replays the allocations and frees of a sequential execution of the plan, see
+  // SequentialExecutionPlan::SymbolicMemoryPlan. Must be called after GenerateDeallocationPlan().
+  void ComputeSymbolicMemoryPlan() {
+    // the order of the allocations is only known if all the nodes run in one stream, in stream order
+    if (plan_.dynamic_scheduling || plan_.NumberOfValidStreams() != 1) {
+      return;
+    }
+
+    SequentialExecutionPlan::SymbolicMemoryPlan symbolic_plan;
+    InlinedHashMap<std::string, size_t> dimension_indices;
+    for (const auto* input : graph_viewer_.GetInputs()) {
+      const auto* shape = context_->GetShape(*input);
+      if (shape == nullptr) {
+        continue;
+      }
+      for (int axis = 0, end = shape->dim_size(); axis < end; ++axis) {
+        const auto& dim = shape->dim(axis);
+        if (dim.has_dim_param() && dimension_indices.find(dim.dim_param()) == dimension_indices.end()) {
+          dimension_indices.emplace(dim.dim_param(), symbolic_plan.dimensions.size());
+          symbolic_plan.dimensions.push_back({Index(input->Name()), static_cast<size_t>(axis)});
+        }
+      }
+    }
+
+    bool has_allocations = false;
+    for (const auto& stream : stream_nodes_) {
+      for (NodeIndex node_index : stream) {
+        const auto* node = graph_viewer_.GetNode(node_index);
+        // a node allocates its outputs while it runs, and the values it was the last consumer of are released
+        // after it ran
+        for (const auto* output : node->OutputDefs()) {
+          if (!output->Exists()) {
+            continue;
+          }
+          SequentialExecutionPlan::SymbolicMemoryPlan::Step step;
+          if (TryGetSymbolicSize(*output, Index(output->Name()), dimension_indices, step)) {
+            symbolic_plan.steps.push_back(std::move(step));
+            has_allocations = true;
+          }
+        }
+        for (size_t release_action_idx : plan_.node_release_list[node_index]) {
+          SequentialExecutionPlan::SymbolicMemoryPlan::Step step;
+          step.value = static_cast<OrtValueIndex>(plan_.release_actions[release_action_idx].value_index);
+          step.is_free = true;
+          symbolic_plan.steps.push_back(std::move(step));
+        }
+      }
+    }
+
+    if (has_allocations) {
+      plan_.symbolic_memory_plan = std::move(symbolic_plan);
+    }
+  }
+
 #ifndef ORT_ENABLE_STREAM
   void PartitionIntoStreams(const logging::Logger& /*logger*/,
                             const ExecutionProviders& /*execution_providers*/,
@@ -1748,9 +2118,15 @@ class PlannerImpl {
   void
   PartitionIntoStreams(const logging::Logger& logger, const ExecutionProviders& execution_providers,
                        const PathString& partition_config_file) {
-    auto partitioner = IGraphPartitioner::CreateGraphPartitioner(logger, partition_config_file);
+    // subgraphs run their streams on the stream of the control flow node, unless split into branches below
+    auto partitioner = IGraphPartitioner::CreateGraphPartitioner(logger, partition_config_file,
+                                                                 parent_node_ ? 1 : context_->GetMaxStreamsPerDevice(),
+                                                                 !parent_node_ && context_->IsMemcpyStreamsEnabled());
     auto status = partitioner->PartitionGraph(graph_viewer_, execution_providers, stream_nodes_, context_->GetExecutionOrder());
     ORT_ENFORCE(status.IsOK(), status.ErrorMessage());
+    if (parent_node_ && context_->IsConcurrentSubgraphStreamsEnabled()) {
+      SplitSubgraphStreamsIntoBranches(execution_providers);
+    }
     node_stream_map_.resize(SafeInt<size_t>(graph_viewer_.MaxNodeIndex()) + 1);
     for (size_t i = 0; i < stream_nodes_.size(); ++i) {
       for (auto node_index : stream_nodes_[i]) {
@@ -1760,6 +2136,61 @@ class PlannerImpl {
     num_logic_streams_ = stream_nodes_.size();
   }
 
+  // Splits each stream of a subgraph on a device with streams into the sets of its nodes connected by data
+  // dependencies (its independent branches), so that the branches run on separate device streams. The branches
+  // beyond kMaxBranchStreams share the streams round robin. The order of the nodes in each stream is kept.
+  void SplitSubgraphStreamsIntoBranches(const ExecutionProviders& execution_providers) {
+    constexpr size_t kMaxBranchStreams = 4;
+    std::vector<InlinedVector<NodeIndex>> branch_stream_nodes;
+    bool has_branches = false;
+    for (auto& nodes : stream_nodes_) {
+      const auto get_device_type = [&](NodeIndex node_index) {
+        const auto* ep = execution_providers.Get(*graph_viewer_.GetNode(node_index));
+        return ep->GetOrtDeviceByMemType(OrtMemType::OrtMemTypeDefault).Type();
+      };
+      if (nodes.size() <= 1 || get_device_type(nodes[0]) == OrtDevice::CPU) {
+        branch_stream_nodes.push_back(std::move(nodes));
+        continue;
+      }
+
+      // union-find of the nodes of the stream over the edges between them
+      InlinedHashMap<NodeIndex, NodeIndex> branch_roots;
+      branch_roots.reserve(nodes.size());
+      for (auto node_index : nodes) {
+        branch_roots[node_index] = node_index;
+      }
+      const auto find_root = [&branch_roots](NodeIndex node_index) {
+        while (branch_roots[node_index] != node_index) {
+          node_index = branch_roots[node_index] = branch_roots[branch_roots[node_index]];
+        }
+        return node_index;
+      };
+      for (auto node_index : nodes) {
+        const auto* node = graph_viewer_.GetNode(node_index);
+        for (auto it = node->OutputNodesBegin(); it != node->OutputNodesEnd(); ++it) {
+          if (branch_roots.count(it->Index()) > 0) {
+            branch_roots[find_root(it->Index())] = find_root(node_index);
+          }
+        }
+      }
+
+      const size_t first_stream = branch_stream_nodes.size();
+      InlinedHashMap<NodeIndex, size_t> root_to_branch;
+      for (auto node_index : nodes) {
+        const auto it = root_to_branch.try_emplace(find_root(node_index), root_to_branch.size()).first;
+        const size_t stream = first_stream + it->second % kMaxBranchStreams;
+        if (stream == branch_stream_nodes.size()) {
+          branch_stream_nodes.push_back({});
+        }
+        branch_stream_nodes[stream].push_back(node_index);
+      }
+      has_branches = has_branches || root_to_branch.size() > 1;
+    }
+
+    plan_.concurrent_subgraph_streams = has_branches;
+    stream_nodes_ = std::move(branch_stream_nodes);
+  }
+
   // build each logic streams
   Status BuildExecutionPlan(const ExecutionProviders& execution_providers,
                             const IStreamCommandHandleRegistry& stream_handle_registry) {
@@ -2064,6 +2495,41 @@ class PlannerImpl {
   }
 #endif
 
+  // Record the data dependencies between nodes, so that the executor can run each node as soon as its producers
+  // completed, on any inter-op thread. This skips the notification and barrier steps of the logic streams, which is
+  // only correct when they order nothing beyond the data dependencies, i.e. when no stream has a device stream.
+  // The reuse and release plans are made to not depend on the order of the nodes within a stream either.
+  void BuildDynamicSchedule() {
+    const size_t num_nodes = graph_viewer_.MaxNodeIndex();
+    plan_.node_dependency_counts.assign(num_nodes, 0);
+    plan_.node_downstreams.assign(num_nodes, {});
+    plan_.node_stream_map.assign(num_nodes, 0);
+    plan_.dynamic_schedule_roots.clear();
+
+    InlinedHashSet<NodeIndex> producers;
+    for (size_t i = 0; i < stream_nodes_.size(); ++i) {
+      for (NodeIndex node_index : stream_nodes_[i]) {
+        plan_.node_stream_map[node_index] = i;
+        const auto* node = graph_viewer_.GetNode(node_index);
+        producers.clear();
+        for (auto it = node->InputNodesBegin(); it != node->InputNodesEnd(); ++it) {
+          // nodes filtered out of the graph viewer are not executed
+          if (graph_viewer_.GetNode(it->Index()) != nullptr) {
+            producers.insert(it->Index());
+          }
+        }
+        plan_.node_dependency_counts[node_index] = static_cast<int>(producers.size());
+        for (NodeIndex producer : producers) {
+          plan_.node_downstreams[producer].push_back(node_index);
+        }
+        if (producers.empty()) {
+          plan_.dynamic_schedule_roots.push_back(node_index);
+        }
+      }
+    }
+    plan_.dynamic_scheduling = true;
+  }
+
   static bool IsNonTensor(const onnxruntime::NodeArg& nodearg) {
     // TODO: unclear why we should go through a string-representation of type
     auto ptype = nodearg.Type();
@@ -2125,9 +2591,23 @@ Status PlannerImpl::CreatePlan(
   // build execution plan
 #ifdef ORT_ENABLE_STREAM
   ORT_RETURN_IF_ERROR(BuildExecutionPlan(execution_providers_, stream_handle_registry));
+  const bool has_device_stream = std::any_of(
+      plan_.execution_plan.begin(), plan_.execution_plan.end(), [&stream_handle_registry](const auto& logic_stream) {
+        return logic_stream && static_cast<bool>(stream_handle_registry.GetCreateStreamFn(logic_stream->device_.Type()));
+      });
 #else
   ORT_RETURN_IF_ERROR(BuildExecutionPlan(execution_providers_));
+  const bool has_device_stream = false;
 #endif
+  if (context_->IsDynamicSchedulingEnabled() && !has_device_stream) {
+    BuildDynamicSchedule();
+  }
+
+  // the buffers of the host shape values are only placed by the frame, not by the symbolic memory plan
+  if (context_->IsHostShapeEvaluationEnabled() && parent_node_ == nullptr &&
+      !context_->IsSymbolicMemoryPlanningEnabled()) {
+    BuildHostShapeProgram();
+  }
 
   // determine sharing/reuse among ml-values
   ORT_RETURN_IF_ERROR(ComputeReusePlan());
@@ -2145,6 +2625,16 @@ Status PlannerImpl::CreatePlan(
   // convert information in the freelist_ into a deallocation plan in required format
   ORT_RETURN_IF_ERROR(GenerateDeallocationPlan());
 
+  ComputeBufferReuseStats();
+
+  if (context_->IsSymbolicMemoryPlanningEnabled()) {
+    ComputeSymbolicMemoryPlan();
+  }
+
+  if (context_->IsLeanExecutionEnabled()) {
+    BuildLeanProgram();
+  }
+
   // generate program counter
 #ifdef ENABLE_TRAINING
   ORT_RETURN_IF_ERROR(CalculateProgramCounter());
@@ -2211,7 +2701,10 @@ Pls check definition of OrtDevice for more detail on device type.
 class DeviceBasedPartitioner : public IGraphPartitioner {
  public:
   DeviceBasedPartitioner(const logging::Logger& logger,
-                         const PathString& config_file) : IGraphPartitioner(logger, config_file) {
+                         const PathString& config_file,
+                         size_t max_streams_per_device,
+                         bool use_memcpy_streams) : IGraphPartitioner(logger, config_file,
+                                                                      max_streams_per_device, use_memcpy_streams) {
     Initialize();
   }
 
@@ -2238,6 +2731,69 @@ class DeviceBasedPartitioner : public IGraphPartitioner {
   bool need_save_ = false;
 };
 
+// Returns whether the node is a collective communication of data parallel training.
+static bool IsCollectiveCommunicationNode(const Node& node) {
+  static const InlinedHashSet<std::string_view> collective_op_types{"NcclAllReduce", "NcclAllGather",
+                                                                    "NcclReduceScatter"};
+  return node.Domain() == kMSDomain && collective_op_types.count(node.OpType()) > 0;
+}
+
+// Returns whether the node copies data between the host and a device with streams.
+static bool IsDeviceMemcpyNode(const Node& node, const ExecutionProviders& execution_providers) {
+  if (node.OpType() != "MemcpyFromHost" && node.OpType() != "MemcpyToHost") {
+    return false;
+  }
+  const auto* ep = execution_providers.Get(node);
+  return ep->GetOrtDeviceByMemType(OrtMemType::OrtMemTypeDefault).Type() != OrtDevice::CPU;
+}
+
+// Returns the topological order with each device memcpy node moved to right after the last of its producers,
+// or to the front if it has none, so that the copies are issued as early as their inputs allow. The relative order
+// of the other nodes is kept. As all the streams follow this order, which is still topological, they cannot deadlock.
+static std::vector<NodeIndex> HoistMemcpyNodes(const onnxruntime::GraphViewer& graph_viewer,
+                                               const std::vector<NodeIndex>& topological_order,
+                                               const ExecutionProviders& execution_providers) {
+  InlinedHashSet<NodeIndex> in_graph(topological_order.begin(), topological_order.end());
+  // number of the input edges from producers that are not in the order yet, for each memcpy node
+  InlinedHashMap<NodeIndex, size_t> pending_inputs;
+  InlinedVector<NodeIndex> memcpy_nodes_without_producers;
+  for (auto node_index : topological_order) {
+    const auto* node = graph_viewer.GetNode(node_index);
+    if (IsDeviceMemcpyNode(*node, execution_providers)) {
+      const auto num_inputs = static_cast<size_t>(
+          std::count_if(node->InputNodesBegin(), node->InputNodesEnd(), [&in_graph](const Node& input) {
+            return in_graph.count(input.Index()) > 0;
+          }));
+      pending_inputs[node_index] = num_inputs;
+      if (num_inputs == 0) {
+        memcpy_nodes_without_producers.push_back(node_index);
+      }
+    }
+  }
+
+  std::vector<NodeIndex> order;
+  order.reserve(topological_order.size());
+  std::function<void(NodeIndex)> append = [&](NodeIndex node_index) {
+    order.push_back(node_index);
+    const auto* node = graph_viewer.GetNode(node_index);
+    for (auto it = node->OutputNodesBegin(); it != node->OutputNodesEnd(); ++it) {
+      auto pending_it = pending_inputs.find(it->Index());
+      if (pending_it != pending_inputs.end() && --pending_it->second == 0) {
+        append(it->Index());
+      }
+    }
+  };
+  for (auto node_index : memcpy_nodes_without_producers) {
+    append(node_index);
+  }
+  for (auto node_index : topological_order) {
+    if (pending_inputs.count(node_index) == 0) {
+      append(node_index);
+    }
+  }
+  return order;
+}
+
 #define EXIT_ON_ERR(warning)         \
   LOGS(logger_, WARNING) << warning; \
   node_names_by_stream_.clear();     \
@@ -2249,11 +2805,68 @@ Status DeviceBasedPartitioner::PartitionGraph(const onnxruntime::GraphViewer& gr
                                               std::vector<InlinedVector<NodeIndex>>& stream_nodes,
                                               ExecutionOrder execution_order) {
   InlinedHashMap<std::string, int> op_type_counter;
-  auto& p_graph_nodes = graph_viewer.GetNodesInTopologicalOrder(execution_order);
+  const auto& topological_order = graph_viewer.GetNodesInTopologicalOrder(execution_order);
+  std::vector<NodeIndex> hoisted_order;
+  if (use_memcpy_streams_) {
+    hoisted_order = HoistMemcpyNodes(graph_viewer, topological_order, execution_providers);
+  }
+  const auto& p_graph_nodes = use_memcpy_streams_ ? hoisted_order : topological_order;
 
   if (node_names_by_stream_.empty()) {  // input configure empty, do it from scratch
 
     InlinedHashMap<OrtDevice::DeviceType, int> device_to_stream;
+    // The collective communication nodes of a device get a stream of their own, so that the all-reduce
+    // of gradients overlaps with the backward computation that does not depend on it. This only pays off
+    // if the gradients are all-reduced in several buckets, as a single all-reduce waits for all of them.
+    InlinedHashMap<OrtDevice::DeviceType, int> device_to_communication_stream;
+    // the memcpy nodes of a device get a copy stream of their own if use_memcpy_streams_ is set
+    InlinedHashMap<OrtDevice::DeviceType, int> device_to_memcpy_stream;
+    const bool separate_communication_streams =
+        std::count_if(p_graph_nodes.begin(), p_graph_nodes.end(), [&graph_viewer](NodeIndex node_index) {
+          return IsCollectiveCommunicationNode(*graph_viewer.GetNode(node_index));
+        }) > 1;
+
+    // With more than one stream per device, the compute nodes of a device with streams are assigned to
+    // chains: a node continues the stream of a producer on the same device if the producer is the last node of
+    // that stream so far, otherwise it starts a new stream while there are fewer than max_streams_per_device_.
+    // Once the maximum is reached, it joins the stream of one of its producers or else the shortest stream.
+    // Any such assignment keeps the topological order within each stream, so the streams cannot deadlock.
+    InlinedHashMap<OrtDevice::DeviceType, InlinedVector<int>> device_to_branch_streams;
+    InlinedHashMap<NodeIndex, int> node_to_stream;
+    InlinedVector<NodeIndex> last_node_of_stream;
+    const auto new_stream = [this, &last_node_of_stream](OrtDevice::DeviceType device_type) {
+      node_names_by_stream_.push_back({});
+      device_types_.push_back(device_type);
+      last_node_of_stream.push_back(std::numeric_limits<NodeIndex>::max());
+      return static_cast<int>(node_names_by_stream_.size()) - 1;
+    };
+    const auto get_branch_stream = [&](const Node& node, OrtDevice::DeviceType device_type) {
+      auto& streams = device_to_branch_streams[device_type];
+      int producer_stream = -1;
+      for (auto it = node.InputNodesBegin(); it != node.InputNodesEnd(); ++it) {
+        const auto stream_it = node_to_stream.find(it->Index());
+        if (stream_it == node_to_stream.end() ||
+            std::find(streams.begin(), streams.end(), stream_it->second) == streams.end()) {
+          continue;
+        }
+        if (last_node_of_stream[stream_it->second] == it->Index()) {
+          return stream_it->second;
+        }
+        if (producer_stream < 0) {
+          producer_stream = stream_it->second;
+        }
+      }
+      if (streams.size() < max_streams_per_device_) {
+        streams.push_back(new_stream(device_type));
+        return streams.back();
+      }
+      if (producer_stream >= 0) {
+        return producer_stream;
+      }
+      return *std::min_element(streams.begin(), streams.end(), [this](int lhs, int rhs) {
+        return node_names_by_stream_[lhs].size() < node_names_by_stream_[rhs].size();
+      });
+    };
 
     for (auto node_index : p_graph_nodes) {
       // get device info of the node
@@ -2264,18 +2877,29 @@ Status DeviceBasedPartitioner::PartitionGraph(const onnxruntime::GraphViewer& gr
       auto device_type = ep->GetOrtDeviceByMemType(OrtMemType::OrtMemTypeDefault).Type();
 
       // log the device
-      auto it = device_to_stream.find(device_type);
-      if (it == device_to_stream.end()) {
-        device_to_stream[device_type] = static_cast<int>(node_names_by_stream_.size());
-        node_names_by_stream_.push_back({});
-        device_types_.push_back(device_type);
-        it = device_to_stream.find(device_type);
+      const bool is_communication_node = separate_communication_streams && device_type != OrtDevice::CPU &&
+                                         IsCollectiveCommunicationNode(*node);
+      const bool is_memcpy_node = use_memcpy_streams_ && IsDeviceMemcpyNode(*node, execution_providers);
+      int stream = -1;
+      if (max_streams_per_device_ > 1 && device_type != OrtDevice::CPU && !is_communication_node && !is_memcpy_node) {
+        stream = get_branch_stream(*node, device_type);
+      } else {
+        auto& stream_map = is_communication_node ? device_to_communication_stream
+                           : is_memcpy_node      ? device_to_memcpy_stream
+                                                 : device_to_stream;
+        auto it = stream_map.find(device_type);
+        if (it == stream_map.end()) {
+          it = stream_map.emplace(device_type, new_stream(device_type)).first;
+        }
+        stream = it->second;
       }
+      node_to_stream[node_index] = stream;
+      last_node_of_stream[stream] = node_index;
       // put the node into the belonging stream
       if (node_name.empty()) {
-        node_names_by_stream_[it->second].push_back(op_type + std::to_string(op_type_counter[op_type]++));
+        node_names_by_stream_[stream].push_back(op_type + std::to_string(op_type_counter[op_type]++));
       } else {
-        node_names_by_stream_[it->second].push_back(node_name);
+        node_names_by_stream_[stream].push_back(node_name);
       }
     }
   }
@@ -2368,7 +2992,9 @@ void DeviceBasedPartitioner::SaveConfig() const {
 }
 
 std::unique_ptr<IGraphPartitioner> IGraphPartitioner::CreateGraphPartitioner(const logging::Logger& logger,
-                                                                             const PathString& config_file) {
+                                                                             const PathString& config_file,
+                                                                             size_t max_streams_per_device,
+                                                                             bool use_memcpy_streams) {
   // use device based partitioner by default
   IGraphPartitioner::GraphPartitioningStrategy partitioner_type =
       IGraphPartitioner::GraphPartitioningStrategy::DeviceBasedPartition;
@@ -2391,7 +3017,7 @@ std::unique_ptr<IGraphPartitioner> IGraphPartitioner::CreateGraphPartitioner(con
   }
   if (partitioner_type == IGraphPartitioner::GraphPartitioningStrategy::DeviceBasedPartition) {
     LOGS(logger, INFO) << "Use DeviceBasedPartition as default";
-    return std::make_unique<DeviceBasedPartitioner>(logger, config_file);
+    return std::make_unique<DeviceBasedPartitioner>(logger, config_file, max_streams_per_device, use_memcpy_streams);
   }  // else if other partitioner types ...
   ORT_THROW("Failed to create partitioner");
 }
@@ -46,15 +46,59 @@ class ISequentialPlannerContext {
   virtual ExecutionOrder GetExecutionOrder() const { return ExecutionOrder::DEFAULT; }
 
   virtual bool GetEnableMemoryReuse() const { return true; }
+
+  // If it returns true, the plan is made so that nodes can run in any order that respects data dependencies
+  // see PlannerImpl::BuildDynamicSchedule
+  virtual bool IsDynamicSchedulingEnabled() const { return false; }
+
+  // If it returns true, the planner computes SequentialExecutionPlan::symbolic_memory_plan
+  // see PlannerImpl::ComputeSymbolicMemoryPlan
+  virtual bool IsSymbolicMemoryPlanningEnabled() const { return false; }
+
+  // If it returns true, the streams of a subgraph are split into its independent branches
+  // see PlannerImpl::SplitSubgraphStreamsIntoBranches
+  virtual bool IsConcurrentSubgraphStreamsEnabled() const { return false; }
+
+  // Maximum number of logic streams per device the nodes of the main graph are assigned to
+  // see DeviceBasedPartitioner::PartitionGraph
+  virtual size_t GetMaxStreamsPerDevice() const { return 1; }
+
+  // If it returns true, the memcpy nodes of the main graph run on copy streams of their own
+  // see DeviceBasedPartitioner::PartitionGraph
+  virtual bool IsMemcpyStreamsEnabled() const { return false; }
+
+  // If it returns true, the inputs of CPU Concat nodes may be placed in the output of the Concat
+  // see PlannerImpl::PlanConcatInPlace
+  virtual bool IsConcatInPlaceEnabled() const { return false; }
+
+  // If it returns true, the planner computes SequentialExecutionPlan::lean_program
+  // see PlannerImpl::BuildLeanProgram
+  virtual bool IsLeanExecutionEnabled() const { return false; }
+
+  // If it returns true, the planner computes SequentialExecutionPlan::host_shape_program
+  // see PlannerImpl::BuildHostShapeProgram
+  virtual bool IsHostShapeEvaluationEnabled() const { return false; }
   virtual ~ISequentialPlannerContext() = default;
 };
 
 class SequentialPlannerContext : public ISequentialPlannerContext {
  public:
-  SequentialPlannerContext(ExecutionMode execution_mode, ExecutionOrder execution_order, bool enable_memory_reuse)
+  SequentialPlannerContext(ExecutionMode execution_mode, ExecutionOrder execution_order, bool enable_memory_reuse,
+                           bool enable_dynamic_scheduling = false, bool enable_symbolic_memory_planning = false,
+                           bool enable_concurrent_subgraph_streams = false, size_t max_streams_per_device = 1,
+                           bool enable_memcpy_streams = false, bool enable_concat_in_place = false,
+                           bool enable_lean_execution = false, bool enable_host_shape_evaluation = false)
       : execution_mode_(execution_mode),
         exection_order_(execution_order),
-        enable_memory_reuse_(enable_memory_reuse) {
+        enable_memory_reuse_(enable_memory_reuse),
+        enable_dynamic_scheduling_(enable_dynamic_scheduling),
+        enable_symbolic_memory_planning_(enable_symbolic_memory_planning),
+        enable_concurrent_subgraph_streams_(enable_concurrent_subgraph_streams),
+        max_streams_per_device_(max_streams_per_device),
+        enable_memcpy_streams_(enable_memcpy_streams),
+        enable_concat_in_place_(enable_concat_in_place),
+        enable_lean_execution_(enable_lean_execution),
+        enable_host_shape_evaluation_(enable_host_shape_evaluation) {
   }
 
   const ONNX_NAMESPACE::TensorShapeProto* GetShape(const onnxruntime::NodeArg& arg) const override {
@@ -67,10 +111,34 @@ class SequentialPlannerContext : public ISequentialPlannerContext {
 
   bool GetEnableMemoryReuse() const override { return enable_memory_reuse_; }
 
+  bool IsDynamicSchedulingEnabled() const override { return enable_dynamic_scheduling_; }
+
+  bool IsSymbolicMemoryPlanningEnabled() const override { return enable_symbolic_memory_planning_; }
+
+  bool IsConcurrentSubgraphStreamsEnabled() const override { return enable_concurrent_subgraph_streams_; }
+
+  size_t GetMaxStreamsPerDevice() const override { return max_streams_per_device_; }
+
+  bool IsMemcpyStreamsEnabled() const override { return enable_memcpy_streams_; }
+
+  bool IsConcatInPlaceEnabled() const override { return enable_concat_in_place_; }
+
+  bool IsLeanExecutionEnabled() const override { return enable_lean_execution_; }
+
+  bool IsHostShapeEvaluationEnabled() const override { return enable_host_shape_evaluation_; }
+
  private:
   ExecutionMode execution_mode_ = ExecutionMode::ORT_SEQUENTIAL;
   ExecutionOrder exection_order_ = ExecutionOrder::DEFAULT;
   bool enable_memory_reuse_ = true;
+  bool enable_dynamic_scheduling_ = false;
+  bool enable_symbolic_memory_planning_ = false;
+  bool enable_concurrent_subgraph_streams_ = false;
+  size_t max_streams_per_device_ = 1;
+  bool enable_memcpy_streams_ = false;
+  bool enable_concat_in_place_ = false;
+  bool enable_lean_execution_ = false;
+  bool enable_host_shape_evaluation_ = false;
 };
 
 #ifdef ORT_ENABLE_STREAM
@@ -90,8 +158,13 @@ class IGraphPartitioner {
   virtual ~IGraphPartitioner() = default;
   // create the partition based on the partition type.
   // perform partition based on the user input when provided.
+  // max_streams_per_device > 1 splits the nodes of each device with streams into up to that many streams,
+  // and use_memcpy_streams puts the memcpy nodes of each such device on a stream of their own,
+  // if the config file does not give the streams.
   static std::unique_ptr<IGraphPartitioner> CreateGraphPartitioner(const logging::Logger& logger,
-                                                                   const PathString& config_file);
+                                                                   const PathString& config_file,
+                                                                   size_t max_streams_per_device = 1,
+                                                                   bool use_memcpy_streams = false);
   virtual Status PartitionGraph(const onnxruntime::GraphViewer& graph_viewer,
                                 const ExecutionProviders& execution_providers,
                                 std::vector<InlinedVector<NodeIndex>>& stream_nodes,
@@ -102,10 +175,16 @@ class IGraphPartitioner {
 
  protected:
   IGraphPartitioner(const logging::Logger& logger,
-                    const PathString& config_file) : logger_(logger),
-                                                     config_file_(config_file) {}
+                    const PathString& config_file,
+                    size_t max_streams_per_device = 1,
+                    bool use_memcpy_streams = false) : logger_(logger),
+                                                       config_file_(config_file),
+                                                       max_streams_per_device_(max_streams_per_device),
+                                                       use_memcpy_streams_(use_memcpy_streams) {}
   const logging::Logger& logger_;
   PathString config_file_;
+  size_t max_streams_per_device_;
+  bool use_memcpy_streams_;
 };
 #endif
 
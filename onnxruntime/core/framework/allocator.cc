@@ -6,6 +6,7 @@
 #include "core/mlas/inc/mlas.h"
 #include "core/framework/utils.h"
 #include "core/session/ort_apis.h"
+#include <cerrno>
 #include <cstdlib>
 #include <sstream>
 
@@ -13,6 +14,10 @@
 #include <mimalloc.h>
 #endif
 
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
 #include "core/framework/bfc_arena.h"
 
 namespace onnxruntime {
@@ -103,7 +108,33 @@ void AllocatorDefaultFree(void* p) {
 
 #endif  // USE_MIMALLOC
 
+void* AllocatorHugePageAlloc(size_t size) {
+#if defined(__linux__) && !defined(USE_MIMALLOC) && !defined(_LIBCPP_SGX_CONFIG)
+  constexpr size_t kHugePageSize = 2 * 1024 * 1024;
+  if (size < kHugePageSize) {
+    return AllocatorDefaultAlloc(size);
+  }
+  // the kernel only backs whole, aligned huge pages with huge pages
+  const size_t alloc_size = (SafeInt<size_t>(size) + MLAS_SYMM_QGEMM_BUF_OVERRUN + (kHugePageSize - 1)) /
+                            kHugePageSize * kHugePageSize;
+  void* p;
+  int ret = posix_memalign(&p, kHugePageSize, alloc_size);
+  if (ret != 0)
+    ORT_THROW_EX(std::bad_alloc);
+  // best effort, without transparent huge pages the buffer stays backed by normal pages
+  if (madvise(p, alloc_size, MADV_HUGEPAGE) != 0) {
+    LOGS_DEFAULT(VERBOSE) << "madvise(MADV_HUGEPAGE) failed with errno " << errno;
+  }
+  return p;
+#else
+  return AllocatorDefaultAlloc(size);
+#endif
+}
+
 void* CPUAllocator::Alloc(size_t size) {
+  if (use_huge_pages_) {
+    return AllocatorHugePageAlloc(size);
+  }
   return AllocatorDefaultAlloc(size);
 }
 
@@ -124,6 +155,9 @@ void* AllocateBufferWithOptions(IAllocator& alloc, size_t size, bool use_reserve
     ORT_UNUSED_PARAMETER(wait_fn);
 #endif  // ORT_ENABLE_STREAM
   }
+  if (stream && alloc.IsStreamOrdered()) {
+    return alloc.StreamOrderedAlloc(size, stream);
+  }
   return alloc.Alloc(size);
 }
 }  // namespace onnxruntime
@@ -32,6 +32,12 @@ AllocatorPtr CreateAllocator(const AllocatorCreationInfo& info) {
     int64_t max_power_of_two_extend_bytes = info.arena_cfg.max_power_of_two_extend_bytes == -1
                                                 ? BFCArena::DEFAULT_MAX_POWER_OF_TWO_EXTEND_BYTES
                                                 : info.arena_cfg.max_power_of_two_extend_bytes;
+    size_t max_thread_cache_bytes = info.arena_cfg.max_thread_cache_bytes == -1
+                                        ? BFCArena::DEFAULT_MAX_THREAD_CACHE_BYTES
+                                        : narrow<size_t>(info.arena_cfg.max_thread_cache_bytes);
+    int64_t trim_window_ms = info.arena_cfg.trim_window_ms == -1
+                                 ? BFCArena::DEFAULT_TRIM_WINDOW_MS
+                                 : info.arena_cfg.trim_window_ms;
     ArenaExtendStrategy arena_extend_str;
     switch (info.arena_cfg.arena_extend_strategy) {
       case static_cast<int>(ArenaExtendStrategy::kSameAsRequested):
@@ -56,7 +62,9 @@ AllocatorPtr CreateAllocator(const AllocatorCreationInfo& info) {
                                              arena_extend_str,
                                              initial_chunk_size_bytes,
                                              max_dead_bytes_per_chunk,
-                                             initial_growth_chunk_size_bytes));
+                                             initial_growth_chunk_size_bytes,
+                                             max_power_of_two_extend_bytes,
+                                             trim_window_ms));
 #else
       ORT_THROW("StreamAwareArena should be transparent to minimal build.");
 #endif
@@ -68,7 +76,9 @@ AllocatorPtr CreateAllocator(const AllocatorCreationInfo& info) {
                                      initial_chunk_size_bytes,
                                      max_dead_bytes_per_chunk,
                                      initial_growth_chunk_size_bytes,
-                                     max_power_of_two_extend_bytes));
+                                     max_power_of_two_extend_bytes,
+                                     max_thread_cache_bytes,
+                                     trim_window_ms));
     }
   } else {
     return device_allocator;
@@ -3,16 +3,25 @@
 
 #include "core/framework/allocator.h"
 #include "core/framework/bfc_arena.h"
+#include "core/framework/nvtx_ranges.h"
+#include <algorithm>
 #include <type_traits>
+#include <unordered_map>
 
 namespace onnxruntime {
+namespace {
+std::atomic<uint64_t> next_thread_cache_id{0};
+}  // namespace
+
 BFCArena::BFCArena(std::unique_ptr<IAllocator> resource_allocator,
                    size_t total_memory,
                    ArenaExtendStrategy arena_extend_strategy,
                    int initial_chunk_size_bytes,
                    int max_dead_bytes_per_chunk,
                    int initial_growth_chunk_size_bytes,
-                   int64_t max_power_of_two_extend_bytes)
+                   int64_t max_power_of_two_extend_bytes,
+                   size_t max_thread_cache_bytes,
+                   int64_t trim_window_ms)
     : IAllocator(OrtMemoryInfo(resource_allocator->Info().name,
                                OrtAllocatorType::OrtArenaAllocator,
                                resource_allocator->Info().device,
@@ -25,14 +34,20 @@ BFCArena::BFCArena(std::unique_ptr<IAllocator> resource_allocator,
       initial_chunk_size_bytes_(initial_chunk_size_bytes),
       max_dead_bytes_per_chunk_(max_dead_bytes_per_chunk),
       initial_growth_chunk_size_bytes_(initial_growth_chunk_size_bytes),
-      max_power_of_two_extend_bytes_(max_power_of_two_extend_bytes) {
+      max_power_of_two_extend_bytes_(max_power_of_two_extend_bytes),
+      max_thread_cache_bytes_(max_thread_cache_bytes),
+      thread_cache_id_(next_thread_cache_id++),
+      trim_window_(trim_window_ms),
+      trim_window_start_(std::chrono::steady_clock::now()) {
   LOGS_DEFAULT(INFO) << "Creating BFCArena for " << device_allocator_->Info().name
                      << " with following configs: initial_chunk_size_bytes: " << initial_chunk_size_bytes_
                      << " max_dead_bytes_per_chunk: " << max_dead_bytes_per_chunk_
                      << " initial_growth_chunk_size_bytes: " << initial_growth_chunk_size_bytes_
                      << " max_power_of_two_extend_bytes: " << max_power_of_two_extend_bytes_
                      << " memory limit: " << total_memory
-                     << " arena_extend_strategy: " << static_cast<int32_t>(arena_extend_strategy);
+                     << " arena_extend_strategy: " << static_cast<int32_t>(arena_extend_strategy)
+                     << " max_thread_cache_bytes: " << max_thread_cache_bytes_
+                     << " trim_window_ms: " << trim_window_ms;
 
   // static_cast<std::underlying_type_t<ArenaExtendStrategy>>(arena_extend_strategy); doesn't work on this compiler
 
@@ -97,6 +112,7 @@ BFCArena::Chunk* BFCArena::ChunkFromHandle(ChunkHandle h) {
 }
 
 Status BFCArena::Extend(size_t rounded_bytes) {
+  profiling::NvtxRange nvtx_range("BFCArena::Extend", profiling::NvtxColor::kAllocation);
   size_t available_bytes = memory_limit_ - static_cast<size_t>(stats_.total_allocated_bytes);
   // Rounds available_bytes down to the nearest multiple of kMinAllocationSize.
   available_bytes = (available_bytes / kMinAllocationSize) * kMinAllocationSize;
@@ -211,7 +227,10 @@ Status BFCArena::Extend(size_t rounded_bytes) {
 
   LOGS_DEFAULT(INFO) << "Allocated memory at " << mem_addr << " to "
                      << static_cast<void*>(static_cast<char*>(mem_addr) + bytes);
-  region_manager_.AddAllocationRegion(mem_addr, bytes, stats_.num_arena_extensions);
+  {
+    std::lock_guard<std::shared_mutex> lookup_lock(chunk_lookup_lock_);
+    region_manager_.AddAllocationRegion(mem_addr, bytes, stats_.num_arena_extensions);
+  }
   stats_.num_arena_extensions += 1;
 
   // Create one large chunk for the whole memory space that will
@@ -246,6 +265,7 @@ BFCArena::ChunkHandle BFCArena::AllocateChunk() {
     return h;
   }
   ChunkHandle h = chunks_.size();
+  std::lock_guard<std::shared_mutex> lookup_lock(chunk_lookup_lock_);
   chunks_.resize(h + 1);
   return h;
 }
@@ -288,6 +308,7 @@ void* BFCArena::Reserve(size_t size) {
   stats_.num_allocs += 1;
   stats_.max_alloc_size = std::max<size_t>(static_cast<size_t>(stats_.max_alloc_size), size);
   stats_.max_bytes_in_use = std::max<int64_t>(static_cast<int64_t>(stats_.max_bytes_in_use), stats_.bytes_in_use);
+  trim_window_peak_bytes_in_use_ = std::max(trim_window_peak_bytes_in_use_, stats_.bytes_in_use);
   stats_.total_allocated_bytes += size;
   return ptr;
 }
@@ -322,6 +343,13 @@ void* BFCArena::AllocateRawInternal(size_t num_bytes,
   // so all memory addresses are nicely byte aligned.
   size_t rounded_bytes = RoundedBytes(num_bytes);
 
+  if (max_thread_cache_bytes_ > 0 && stream == nullptr && rounded_bytes <= kMaxThreadCacheChunkSize) {
+    void* cached = AllocateFromThreadCache(rounded_bytes);
+    if (cached != nullptr) {
+      return cached;
+    }
+  }
+
   // The BFC allocator tries to find the best fit first.
   BinNum bin_num = BinNumForSize(rounded_bytes);
 
@@ -379,6 +407,103 @@ void* BFCArena::AllocateRawInternal(size_t num_bytes,
 void BFCArena::GetStats(AllocatorStats* stats) {
   std::lock_guard<OrtMutex> lock(lock_);
   *stats = stats_;
+  stats->bytes_in_use -= thread_cached_bytes_;
+  stats->num_allocs += num_thread_cache_allocs_;
+}
+
+BFCArena::ThreadCache& BFCArena::GetThreadCache() {
+  // arena ids are never reused, so the entries of destroyed arenas are never looked up again
+  thread_local std::unordered_map<uint64_t, ThreadCache*> thread_caches;
+  ThreadCache*& cache = thread_caches[thread_cache_id_];
+  if (cache == nullptr) {
+    // the arena owns the caches, the chunks of a thread that exited are returned by Shrink()
+    std::lock_guard<OrtMutex> lock(thread_caches_lock_);
+    cache = thread_caches_.emplace_back(std::make_unique<ThreadCache>()).get();
+  }
+  return *cache;
+}
+
+void* BFCArena::AllocateFromThreadCache(size_t rounded_bytes) {
+  ThreadCache& cache = GetThreadCache();
+  std::lock_guard<OrtMutex> lock(cache.mutex);
+  auto& chunks = cache.chunks[rounded_bytes / kMinAllocationSize - 1];
+  if (chunks.empty()) {
+    return nullptr;
+  }
+  void* ptr = chunks.back();
+  chunks.pop_back();
+  cache.bytes -= rounded_bytes;
+  thread_cached_bytes_ -= static_cast<int64_t>(rounded_bytes);
+  ++num_thread_cache_allocs_;
+  return ptr;
+}
+
+bool BFCArena::FreeToThreadCache(void* p) {
+  size_t size = 0;
+  {
+    std::shared_lock<std::shared_mutex> lookup_lock(chunk_lookup_lock_);
+    // reserved chunks are not in the regions
+    ChunkHandle h = region_manager_.find_handle(p);
+    if (h == kInvalidChunkHandle) {
+      return false;
+    }
+    // the size of a chunk in use does not change, only the chunks in the bins are split and merged
+    const Chunk& c = chunks_[h];
+    if (!c.in_use() || c.ptr != p) {
+      return false;
+    }
+    size = c.size;
+  }
+  if (size > kMaxThreadCacheChunkSize) {
+    return false;
+  }
+
+  std::vector<void*> to_return;
+  {
+    ThreadCache& cache = GetThreadCache();
+    std::lock_guard<OrtMutex> lock(cache.mutex);
+    cache.chunks[size / kMinAllocationSize - 1].push_back(p);
+    cache.bytes += size;
+    int64_t cached_bytes_delta = static_cast<int64_t>(size);
+    if (cache.bytes > max_thread_cache_bytes_) {
+      // return the largest chunks first, the small ones are the most likely to be reused
+      const size_t low_watermark = max_thread_cache_bytes_ / 2;
+      for (size_t i = kNumThreadCacheSizeClasses; i-- > 0 && cache.bytes > low_watermark;) {
+        auto& chunks = cache.chunks[i];
+        const size_t chunk_size = (i + 1) * kMinAllocationSize;
+        while (!chunks.empty() && cache.bytes > low_watermark) {
+          to_return.push_back(chunks.back());
+          chunks.pop_back();
+          cache.bytes -= chunk_size;
+          cached_bytes_delta -= static_cast<int64_t>(chunk_size);
+        }
+      }
+    }
+    thread_cached_bytes_ += cached_bytes_delta;
+  }
+
+  if (!to_return.empty()) {
+    std::lock_guard<OrtMutex> lock(lock_);
+    for (void* ptr : to_return) {
+      DeallocateRawInternal(ptr);
+    }
+  }
+  return true;
+}
+
+std::vector<void*> BFCArena::TakeThreadCachedChunks() {
+  std::vector<void*> chunks;
+  std::lock_guard<OrtMutex> caches_lock(thread_caches_lock_);
+  for (auto& cache : thread_caches_) {
+    std::lock_guard<OrtMutex> lock(cache->mutex);
+    for (auto& size_class : cache->chunks) {
+      chunks.insert(chunks.end(), size_class.begin(), size_class.end());
+      size_class.clear();
+    }
+    thread_cached_bytes_ -= static_cast<int64_t>(cache->bytes);
+    cache->bytes = 0;
+  }
+  return chunks;
 }
 
 BFCArena::Chunk* BFCArena::SplitFreeChunkFromBin(BFCArena::Bin::FreeChunkSet* free_chunks,
@@ -408,6 +533,7 @@ BFCArena::Chunk* BFCArena::SplitFreeChunkFromBin(BFCArena::Bin::FreeChunkSet* fr
   stats_.bytes_in_use += chunk->size;
   stats_.max_bytes_in_use =
       std::max(stats_.max_bytes_in_use, stats_.bytes_in_use);
+  trim_window_peak_bytes_in_use_ = std::max(trim_window_peak_bytes_in_use_, stats_.bytes_in_use);
   stats_.max_alloc_size =
       std::max<int64_t>(stats_.max_alloc_size, static_cast<int64_t>(chunk->size));
   return chunk;
@@ -496,6 +622,9 @@ void BFCArena::Free(void* p) {
   if (p == nullptr) {
     return;
   }
+  if (max_thread_cache_bytes_ > 0 && FreeToThreadCache(p)) {
+    return;
+  }
   std::lock_guard<OrtMutex> lock(lock_);
   auto it = reserved_chunks_.find(p);
   if (it != reserved_chunks_.end()) {
@@ -506,25 +635,58 @@ void BFCArena::Free(void* p) {
   } else {
     DeallocateRawInternal(p);
   }
+  if (trim_window_.count() > 0) {
+    MaybeTrim();
+  }
 }
 
 Status BFCArena::Shrink() {
+  std::vector<void*> thread_cached_chunks = TakeThreadCachedChunks();
   std::lock_guard<OrtMutex> lock(lock_);
-  auto num_regions = region_manager_.regions().size();
-  std::vector<void*> region_ptrs;
-  std::vector<size_t> region_sizes;
-  region_ptrs.reserve(num_regions);
-  region_sizes.reserve(num_regions);
+  for (void* ptr : thread_cached_chunks) {
+    DeallocateRawInternal(ptr);
+  }
+  FreeUnusedRegions(0);
+
+  // Will affect how the arena grows if the arena extend strategy is kNextPowerOfTwo
+  // In case the extend strategy is kSameAsRequested, the arena growth is exactly the size of the memory request itself
+  curr_region_allocation_bytes_ = initial_growth_chunk_size_bytes_;
+
+  return Status::OK();
+}
+
+void BFCArena::MaybeTrim() {
+  const auto now = std::chrono::steady_clock::now();
+  if (now - trim_window_start_ < trim_window_) {
+    return;
+  }
+
+  const size_t freed_bytes = FreeUnusedRegions(static_cast<size_t>(trim_window_peak_bytes_in_use_));
+  if (freed_bytes > 0) {
+    LOGS_DEFAULT(VERBOSE) << device_allocator_->Info().name << " BFC Arena trimmed by " << freed_bytes
+                          << " bytes for a peak of " << trim_window_peak_bytes_in_use_ << " bytes in use";
+    curr_region_allocation_bytes_ = initial_growth_chunk_size_bytes_;
+  }
+
+  trim_window_start_ = now;
+  trim_window_peak_bytes_in_use_ = stats_.bytes_in_use;
+}
+
+size_t BFCArena::FreeUnusedRegions(size_t bytes_to_keep) {
+  size_t freed_bytes = 0;
+  std::vector<std::pair<void*, size_t>> regions;
+  regions.reserve(region_manager_.regions().size());
 
   for (const auto& region : region_manager_.regions()) {
     if (consider_first_allocation_region_for_shrinkage_ || region.id() != 0) {
-      region_ptrs.push_back(region.ptr());
-      region_sizes.push_back(region.memory_size());
+      regions.emplace_back(region.ptr(), region.memory_size());
     }
   }
+  // largest first, to free as much as possible within bytes_to_keep
+  std::stable_sort(regions.begin(), regions.end(),
+                   [](const auto& a, const auto& b) { return a.second > b.second; });
 
-  size_t i = 0;
-  for (void* region_ptr : region_ptrs) {
+  for (const auto& [region_ptr, shrink_size] : regions) {
     bool deallocate_region = true;
     ChunkHandle region_begin_chunk = region_manager_.get_handle(region_ptr);
     ChunkHandle h = region_begin_chunk;
@@ -539,8 +701,8 @@ Status BFCArena::Shrink() {
       h = c->next;
     }
 
-    if (deallocate_region) {
-      auto shrink_size = region_sizes[i];
+    if (deallocate_region && static_cast<size_t>(stats_.total_allocated_bytes) >= bytes_to_keep + shrink_size) {
+      freed_bytes += shrink_size;
       stats_.num_arena_shrinkages += 1;
       stats_.total_allocated_bytes -= shrink_size;
 
@@ -559,18 +721,13 @@ Status BFCArena::Shrink() {
       }
 
       device_allocator_->Free(region_ptr);
+      std::lock_guard<std::shared_mutex> lookup_lock(chunk_lookup_lock_);
       region_manager_.RemoveAllocationRegion(region_ptr);
       stats_.num_arena_extensions--;
     }
-
-    ++i;
   }
 
-  // Will affect how the arena grows if the arena extend strategy is kNextPowerOfTwo
-  // In case the extend strategy is kSameAsRequested, the arena growth is exactly the size of the memory request itself
-  curr_region_allocation_bytes_ = initial_growth_chunk_size_bytes_;
-
-  return Status::OK();
+  return freed_bytes;
 }
 
 void BFCArena::DeallocateRawInternal(void* ptr) {
@@ -856,13 +1013,16 @@ StreamAwareArena::StreamAwareArena(std::unique_ptr<IAllocator> resource_allocato
                                    int initial_chunk_size_bytes,
                                    int max_dead_bytes_per_chunk,
                                    int initial_growth_chunk_size_bytes,
-                                   int64_t max_power_of_two_extend_bytes) : BFCArena(std::move(resource_allocator),
-                                                                                     total_memory,
-                                                                                     arena_extend_strategy,
-                                                                                     initial_chunk_size_bytes,
-                                                                                     max_dead_bytes_per_chunk,
-                                                                                     initial_growth_chunk_size_bytes,
-                                                                                     max_power_of_two_extend_bytes),
+                                   int64_t max_power_of_two_extend_bytes,
+                                   int64_t trim_window_ms) : BFCArena(std::move(resource_allocator),
+                                                                      total_memory,
+                                                                      arena_extend_strategy,
+                                                                      initial_chunk_size_bytes,
+                                                                      max_dead_bytes_per_chunk,
+                                                                      initial_growth_chunk_size_bytes,
+                                                                      max_power_of_two_extend_bytes,
+                                                                      DEFAULT_MAX_THREAD_CACHE_BYTES,
+                                                                      trim_window_ms),
                                                                             enable_cross_stream_reusing_(enable_cross_stream_sharing) {
   arena_type_ = ArenaType::StreamAwareArena;
 }
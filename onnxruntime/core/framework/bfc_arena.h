@@ -16,9 +16,13 @@ limitations under the License.
 
 #pragma once
 #include <array>
+#include <atomic>
+#include <chrono>
 #include <memory>
 #include <mutex>
+#include <shared_mutex>
 #include <sstream>
+#include <vector>
 
 #include "onnxruntime_config.h"
 
@@ -53,6 +57,17 @@ class StreamAwareArena;
 // coalescing.  One assumption we make is that the process using this
 // allocator owns pretty much all of the memory, and that nearly
 // all requests to allocate memory go through this interface.
+//
+// If max_thread_cache_bytes is not 0, every thread keeps the small chunks that it
+// frees (up to kMaxThreadCacheChunkSize bytes each) in a cache of its own, and
+// takes allocations of the same size from it without locking the arena.
+// When a thread caches more than max_thread_cache_bytes, the chunks are returned
+// to the bins in a batch until half of that is left. Shrink() empties all the caches.
+//
+// If trim_window_ms is not 0, the arena tracks the peak of the bytes in use over
+// windows of that length. When a chunk is freed after the end of a window, the
+// allocation regions without chunks in use are released, as long as the rest of
+// the arena can still hold the peak of the window that ended.
 class BFCArena : public IAllocator {
  public:
   static const ArenaExtendStrategy DEFAULT_ARENA_EXTEND_STRATEGY = ArenaExtendStrategy::kNextPowerOfTwo;
@@ -60,6 +75,8 @@ class BFCArena : public IAllocator {
   static const int DEFAULT_MAX_DEAD_BYTES_PER_CHUNK = 128 * 1024 * 1024;
   static const int DEFAULT_INITIAL_GROWTH_CHUNK_SIZE_BYTES = 2 * 1024 * 1024;
   static const int64_t DEFAULT_MAX_POWER_OF_TWO_EXTEND_BYTES = 1024 * 1024 * 1024;  // 1GB
+  static const size_t DEFAULT_MAX_THREAD_CACHE_BYTES = 0;                           // disabled
+  static const int64_t DEFAULT_TRIM_WINDOW_MS = 0;                                  // disabled
   static const size_t DEFAULT_MAX_MEM = std::numeric_limits<size_t>::max();
 
   enum ArenaType {
@@ -73,7 +90,9 @@ class BFCArena : public IAllocator {
            int initial_chunk_size_bytes = DEFAULT_INITIAL_CHUNK_SIZE_BYTES,
            int max_dead_bytes_per_chunk = DEFAULT_MAX_DEAD_BYTES_PER_CHUNK,
            int initial_growth_chunk_size_bytes = DEFAULT_INITIAL_GROWTH_CHUNK_SIZE_BYTES,
-           int64_t max_power_of_two_extend_bytes = DEFAULT_MAX_POWER_OF_TWO_EXTEND_BYTES);
+           int64_t max_power_of_two_extend_bytes = DEFAULT_MAX_POWER_OF_TWO_EXTEND_BYTES,
+           size_t max_thread_cache_bytes = DEFAULT_MAX_THREAD_CACHE_BYTES,
+           int64_t trim_window_ms = DEFAULT_TRIM_WINDOW_MS);
 
   ~BFCArena() override;
 
@@ -97,6 +116,8 @@ class BFCArena : public IAllocator {
 
   void GetStats(AllocatorStats* stats) override;
 
+  // A chunk that is reused from a thread cache keeps the requested size of the
+  // allocation that took it from the bins.
   size_t RequestedSize(const void* ptr);
 
   size_t AllocatedSize(const void* ptr);
@@ -328,6 +349,16 @@ class BFCArena : public IAllocator {
       return RegionFor(p)->get_handle(p);
     }
 
+    // Returns kInvalidChunkHandle if p is not in one of the regions.
+    ChunkHandle find_handle(const void* p) const {
+      auto entry =
+          std::upper_bound(regions_.begin(), regions_.end(), p, &Comparator);
+      if (entry == regions_.end() || p < entry->ptr()) {
+        return kInvalidChunkHandle;
+      }
+      return entry->get_handle(p);
+    }
+
     void set_handle(const void* p, ChunkHandle h) {
       return MutableRegionFor(p)->set_handle(p, h);
     }
@@ -362,6 +393,38 @@ class BFCArena : public IAllocator {
     std::vector<AllocationRegion> regions_;
   };
 
+  static const size_t kMaxThreadCacheChunkSize = 64 * 1024;
+  static const size_t kNumThreadCacheSizeClasses = kMaxThreadCacheChunkSize / kMinAllocationSize;
+
+  // The small chunks freed by one thread. Only that thread uses it, except for
+  // Shrink() emptying it, so the mutex is practically never contended.
+  struct ThreadCache {
+    OrtMutex mutex;
+    // pointers of the cached chunks, by chunk size / kMinAllocationSize - 1
+    std::array<std::vector<void*>, kNumThreadCacheSizeClasses> chunks;
+    size_t bytes = 0;
+  };
+
+  ThreadCache& GetThreadCache();
+
+  // Returns a chunk of 'rounded_bytes' from the cache of the calling thread, or nullptr.
+  void* AllocateFromThreadCache(size_t rounded_bytes);
+
+  // Adds the chunk of 'p' to the cache of the calling thread, and returns the chunks
+  // over the budget of the cache to the bins. Returns false if 'p' is not cacheable.
+  bool FreeToThreadCache(void* p);
+
+  // Empties the caches of all the threads and returns their chunks.
+  std::vector<void*> TakeThreadCachedChunks();
+
+  // Frees the allocation regions in which no chunk is in use, as long as at least
+  // 'bytes_to_keep' bytes stay allocated. Returns the number of bytes freed.
+  size_t FreeUnusedRegions(size_t bytes_to_keep);
+
+  // Starts a new trim window if the current one ended, after freeing the regions
+  // that are not needed for the peak of the bytes in use of the window that ended.
+  void MaybeTrim();
+
   // Returns 'bytes' rounded up to the next highest kMinAllocationSize.
   size_t RoundedBytes(size_t bytes);
 
@@ -514,6 +577,25 @@ class BFCArena : public IAllocator {
   // is to be considered for shrinkage or not.
   bool consider_first_allocation_region_for_shrinkage_;
 
+  const size_t max_thread_cache_bytes_;
+  // Unique among the arenas of the process, identifies the thread caches of this arena.
+  const uint64_t thread_cache_id_;
+
+  OrtMutex thread_caches_lock_;
+  std::vector<std::unique_ptr<ThreadCache>> thread_caches_;
+  // The cached chunks are in use for the bins, GetStats() reports them as free.
+  std::atomic<int64_t> thread_cached_bytes_{0};
+  std::atomic<int64_t> num_thread_cache_allocs_{0};
+
+  const std::chrono::milliseconds trim_window_;
+  std::chrono::steady_clock::time_point trim_window_start_;
+  // peak of stats_.bytes_in_use since trim_window_start_
+  int64_t trim_window_peak_bytes_in_use_ = 0;
+
+  // Held exclusively while region_manager_ or chunks_ is resized, so that
+  // FreeToThreadCache() can find the size of a chunk without taking lock_.
+  std::shared_mutex chunk_lookup_lock_;
+
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(BFCArena);
 };
 #ifdef ORT_ENABLE_STREAM
@@ -526,7 +608,8 @@ class StreamAwareArena : public BFCArena {
                    int initial_chunk_size_bytes = DEFAULT_INITIAL_CHUNK_SIZE_BYTES,
                    int max_dead_bytes_per_chunk = DEFAULT_MAX_DEAD_BYTES_PER_CHUNK,
                    int initial_growth_chunk_size_bytes = DEFAULT_INITIAL_GROWTH_CHUNK_SIZE_BYTES,
-                   int64_t max_power_of_two_extend_bytes = DEFAULT_MAX_POWER_OF_TWO_EXTEND_BYTES);
+                   int64_t max_power_of_two_extend_bytes = DEFAULT_MAX_POWER_OF_TWO_EXTEND_BYTES,
+                   int64_t trim_window_ms = DEFAULT_TRIM_WINDOW_MS);
 
   // If size is 0, then this function returns either NULL,
   // or a unique pointer value that can later be successfully
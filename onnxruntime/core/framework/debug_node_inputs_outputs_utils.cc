@@ -7,6 +7,8 @@
 #include "core/framework/print_tensor_utils.h"
 #include <iomanip>
 #include <cctype>
+#include <cmath>
+#include <fstream>
 #include <string>
 
 #ifdef DEBUG_NODE_INPUTS_OUTPUTS_ENABLE_DUMP_TO_SQLDB
@@ -17,6 +19,9 @@
 #include "core/framework/tensorprotoutils.h"
 #include "core/platform/env.h"
 #include "core/platform/env_var_utils.h"
+#include "nlohmann/json.hpp"
+
+using json = nlohmann::json;
 
 namespace onnxruntime {
 namespace utils {
@@ -88,6 +93,43 @@ void DumpTensorToFile(const Tensor& tensor, const std::string& tensor_name, cons
   ORT_THROW_IF_ERROR(Env::Default().FileClose(output_fd));
 }
 
+// Adds the values within the range to the histogram over [-threshold, threshold], binned as numpy.histogram does.
+void AddToHistogram(gsl::span<const float> values, double threshold, gsl::span<int64_t> histogram) {
+  // numpy.histogram widens an empty range to [-0.5, 0.5]
+  const double range_max = threshold == 0.0 ? 0.5 : threshold;
+  const double bin_scale = static_cast<double>(histogram.size()) / (2.0 * range_max);
+  const size_t last_bin = histogram.size() - 1;
+
+  for (const float value : values) {
+    // this also skips NaN
+    if (!(value >= -range_max && value <= range_max)) {
+      continue;
+    }
+    const auto bin = static_cast<size_t>((value + range_max) * bin_scale);
+    ++histogram[std::min(bin, last_bin)];
+  }
+}
+
+// The collector of the calibration destination, which writes the table when the process exits.
+struct CalibrationTableWriter {
+  CalibrationCollector collector;
+  Path output_dir;
+  std::string file_suffix;
+
+  ~CalibrationTableWriter() {
+    const auto status = collector.Write(output_dir, file_suffix);
+    if (!status.IsOK()) {
+      std::cerr << "Failed to write the calibration table: " << status.ErrorMessage() << "\n";
+    }
+  }
+};
+
+CalibrationCollector& GetCalibrationCollector(const NodeDumpOptions& dump_options) {
+  static CalibrationTableWriter writer{
+      CalibrationCollector{dump_options.calibration_num_bins}, dump_options.output_dir, dump_options.file_suffix};
+  return writer.collector;
+}
+
 #ifdef DEBUG_NODE_INPUTS_OUTPUTS_ENABLE_DUMP_TO_SQLDB
 sqlite3* SqliteConnection() {
   static thread_local std::unique_ptr<sqlite3, decltype(&sqlite3_close)> sqlite_db(
@@ -310,6 +352,10 @@ void DumpCpuTensor(
 #endif
       break;
     }
+    case NodeDumpOptions::DataDestination::CalibrationTable: {
+      GetCalibrationCollector(dump_options).Collect(tensor_metadata.name, tensor, tensor_metadata.step);
+      break;
+    }
     default:
       ORT_THROW("Unsupported data destination type: ", static_cast<int>(dump_options.data_destination));
   }
@@ -354,6 +400,111 @@ void DumpTensor(
 
 }  // namespace
 
+void CalibrationCollector::Collect(const std::string& name, const Tensor& tensor, size_t step) {
+  if (tensor.IsDataType<float>()) {
+    Collect(name, tensor.DataAsSpan<float>(), step);
+  } else if (tensor.IsDataType<MLFloat16>()) {
+    const auto data = tensor.DataAsSpan<MLFloat16>();
+    std::vector<float> values(data.size());
+    std::transform(data.begin(), data.end(), values.begin(), [](MLFloat16 value) { return value.ToFloat(); });
+    Collect(name, values, step);
+  }
+}
+
+void CalibrationCollector::Collect(const std::string& name, gsl::span<const float> values, size_t step) {
+  float min = 0.0f;
+  float max = 0.0f;
+  bool is_first = true;
+  for (const float value : values) {
+    if (std::isfinite(value)) {
+      min = is_first ? value : std::min(min, value);
+      max = is_first ? value : std::max(max, value);
+      is_first = false;
+    }
+  }
+  const double threshold = std::max(std::abs(min), std::abs(max));
+
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  auto it = statistics_.find(name);
+  if (it == statistics_.end()) {
+    TensorStatistics statistics{min, max, threshold, std::vector<int64_t>(num_bins_, 0), step};
+    if (num_bins_ > 0) {
+      AddToHistogram(values, threshold, statistics.histogram);
+    }
+    statistics_.emplace(name, std::move(statistics));
+    return;
+  }
+
+  auto& statistics = it->second;
+  if (statistics.step == step) {
+    return;
+  }
+  statistics.step = step;
+  statistics.min = std::min(statistics.min, min);
+  statistics.max = std::max(statistics.max, max);
+
+  if (statistics.histogram.empty() || threshold <= statistics.threshold) {
+    if (!statistics.histogram.empty()) {
+      AddToHistogram(values, statistics.threshold, statistics.histogram);
+    }
+    statistics.threshold = std::max(statistics.threshold, threshold);
+  } else if (statistics.threshold == 0.0) {
+    AddToHistogram(values, threshold, statistics.histogram);
+    statistics.threshold = threshold;
+  } else {
+    // widen the histogram by whole bins on both sides, so the collected bins keep their edges
+    const size_t bin_count = statistics.histogram.size();
+    const double bin_width = 2.0 * statistics.threshold / static_cast<double>(bin_count);
+    const auto half_increased_bins =
+        static_cast<size_t>(std::floor((threshold - statistics.threshold) / bin_width)) + 1;
+    const double new_threshold = static_cast<double>(half_increased_bins) * bin_width + statistics.threshold;
+
+    std::vector<int64_t> histogram(bin_count + 2 * half_increased_bins, 0);
+    AddToHistogram(values, new_threshold, histogram);
+    for (size_t i = 0; i < bin_count; ++i) {
+      histogram[half_increased_bins + i] += statistics.histogram[i];
+    }
+
+    statistics.histogram = std::move(histogram);
+    statistics.threshold = new_threshold;
+  }
+}
+
+Status CalibrationCollector::Write(const Path& output_dir, const std::string& file_suffix) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  if (statistics_.empty()) {
+    return Status::OK();
+  }
+
+  json table = json::object();
+  json histograms = json::object();
+  for (const auto& [name, statistics] : statistics_) {
+    table[name] = {statistics.min, statistics.max};
+    if (!statistics.histogram.empty()) {
+      histograms[name] = {{"min", statistics.min},
+                          {"max", statistics.max},
+                          {"threshold", statistics.threshold},
+                          {"histogram", statistics.histogram}};
+    }
+  }
+
+  auto write_file = [&output_dir, &file_suffix](const char* file_name, const json& content) -> Status {
+    const Path file_path = output_dir / Path::Parse(path_utils::MakePathString(file_name, file_suffix, ".json"));
+    std::ofstream stream{file_path.ToPathString()};
+    stream << content.dump();
+    ORT_RETURN_IF_NOT(stream.good(), "Failed to write file: ", ToUTF8String(file_path.ToPathString()));
+    return Status::OK();
+  };
+
+  ORT_RETURN_IF_ERROR(write_file("calibration", table));
+  if (!histograms.empty()) {
+    ORT_RETURN_IF_ERROR(write_file("calibration_histogram", histograms));
+  }
+  return Status::OK();
+}
+
 const NodeDumpOptions& NodeDumpOptionsFromEnvironmentVariables() {
   static const NodeDumpOptions node_dump_options = []() {
     namespace env_vars = debug_node_inputs_outputs_env_vars;
@@ -387,6 +538,8 @@ const NodeDumpOptions& NodeDumpOptionsFromEnvironmentVariables() {
       opts.data_destination = NodeDumpOptions::DataDestination::TensorProtoFiles;
     } else if (destination == "sqlite") {
       opts.data_destination = NodeDumpOptions::DataDestination::SqliteDb;
+    } else if (destination == "calibration") {
+      opts.data_destination = NodeDumpOptions::DataDestination::CalibrationTable;
     } else if (destination != "stdout") {
       ORT_THROW("Unsupported data destination type: ", destination);
     }
@@ -395,6 +548,8 @@ const NodeDumpOptions& NodeDumpOptionsFromEnvironmentVariables() {
     opts.snippet_threshold = ParseEnvironmentVariableWithDefault<int>(env_vars::kSnippetThreshold, kDefaultSnippetThreshold);
     opts.snippet_edge_items = ParseEnvironmentVariableWithDefault<int>(env_vars::kSnippetEdgeItems, kDefaultSnippetEdgeItems);
 
+    opts.calibration_num_bins = ParseEnvironmentVariableWithDefault<size_t>(env_vars::kCalibrationNumBins, 2048);
+
     if (ParseEnvironmentVariableWithDefault<bool>(env_vars::kAppendRankToFileName, false)) {
       std::string rank = Env::Default().GetEnvironmentVar("OMPI_COMM_WORLD_RANK");
       if (rank.empty()) {
@@ -456,6 +611,32 @@ void DumpNodeInputs(
   if (context.GetComputeStream())
     context.GetComputeStream()->Flush();
 
+  if (dump_options.data_destination == NodeDumpOptions::DataDestination::CalibrationTable) {
+    // the other node inputs are node outputs or initializers, so only the graph inputs are collected here
+    if ((dump_options.dump_flags & NodeDumpOptions::DumpFlags::InputData) == 0) {
+      return;
+    }
+
+    const auto& graph_inputs = session_state.GetGraphViewer().GetInputs();
+    const auto& input_defs = node.InputDefs();
+    TensorMetadata tensor_metadata;
+
+    for (auto i = 0, end = context.InputCount(); i < end; ++i) {
+      const auto* type = context.InputType(i);
+      if (type == nullptr || !type->IsTensorType() ||
+          std::find(graph_inputs.begin(), graph_inputs.end(), input_defs[i]) == graph_inputs.end()) {
+        continue;
+      }
+
+      if (const auto* tensor = context.Input<Tensor>(i); tensor != nullptr) {
+        tensor_metadata.name = input_defs[i]->Name();
+        tensor_metadata.step = dump_context.iteration;
+        DumpTensor(dump_options, *tensor, tensor_metadata, session_state);
+      }
+    }
+    return;
+  }
+
   bool should_dump_node_placement = (dump_options.dump_flags & NodeDumpOptions::DumpFlags::NodePlacement) != 0;
   if (dump_context.iteration == 1 && should_dump_node_placement) {
     PrintIf(should_dump_node_placement, MakeString(" Placement: ", node.GetExecutionProviderType(), "\n"));
@@ -530,6 +711,29 @@ void DumpNodeOutputs(
   if (context.GetComputeStream())
     context.GetComputeStream()->Flush();
 
+  if (dump_options.data_destination == NodeDumpOptions::DataDestination::CalibrationTable) {
+    if ((dump_options.dump_flags & NodeDumpOptions::DumpFlags::OutputData) == 0) {
+      return;
+    }
+
+    const auto& output_defs = node.OutputDefs();
+    TensorMetadata tensor_metadata;
+
+    for (auto i = 0, end = context.OutputCount(); i < end; ++i) {
+      const auto* type = context.OutputType(i);
+      if (!output_defs[i]->Exists() || type == nullptr || !type->IsTensorType()) {
+        continue;
+      }
+
+      if (const auto* tensor = context.Output<Tensor>(i); tensor != nullptr) {
+        tensor_metadata.name = output_defs[i]->Name();
+        tensor_metadata.step = dump_context.iteration;
+        DumpTensor(dump_options, *tensor, tensor_metadata, session_state);
+      }
+    }
+    return;
+  }
+
   bool should_dump_node_placement = (dump_options.dump_flags & NodeDumpOptions::DumpFlags::NodePlacement) != 0;
   if (dump_context.iteration == 1 && should_dump_node_placement) {
     PrintIf(should_dump_node_placement, MakeString(" Placement: ", node.GetExecutionProviderType(), "\n"));
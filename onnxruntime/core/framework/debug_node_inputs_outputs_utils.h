@@ -10,12 +10,20 @@
 // see orttraining/tools/scripts/sqldb_to_tensors.py for retrieval
 //
 // select data dump destination using
-//   ORT_DEBUG_NODE_IO_DUMP_DATA_DESTINATION= one of {stdout, files, sqlite}
+//   ORT_DEBUG_NODE_IO_DUMP_DATA_DESTINATION= one of {stdout, files, sqlite, calibration}
+//
+// the calibration destination collects the min, max and histogram of the float node outputs (and of the graph
+// inputs with input data dumping) across runs, and writes them to calibration.json and calibration_histogram.json
+// in the output directory when the process exits. calibration.json has the {name: [min, max]} layout of the
+// python quantization tools' calibration table.
 
 #ifdef DEBUG_NODE_INPUTS_OUTPUTS
 
 #pragma once
 
+#include <map>
+#include <mutex>
+
 #include "core/common/path.h"
 #include "core/framework/op_kernel.h"
 #include "core/framework/session_state.h"
@@ -59,6 +67,10 @@ constexpr const char* kSnippetThreshold = "ORT_DEBUG_NODE_IO_SNIPPET_THRESHOLD";
 // Number of array items in snippet at beginning and end of each dimension (default 3)
 constexpr const char* kSnippetEdgeItems = "ORT_DEBUG_NODE_IO_SNIPPET_EDGE_ITEMS";
 
+// Number of histogram bins collected per tensor by the calibration destination (default 2048). Value 0 collects
+// only the min and max.
+constexpr const char* kCalibrationNumBins = "ORT_DEBUG_NODE_IO_CALIBRATION_NUM_BINS";
+
 }  // namespace debug_node_inputs_outputs_env_vars
 
 constexpr char kFilterPatternDelimiter = ';';
@@ -100,7 +112,9 @@ struct NodeDumpOptions {
     // write to one file per tensor input/output as a TensorProto
     TensorProtoFiles,
     // write to one row per tensor input/output in Sqlite table
-    SqliteDb
+    SqliteDb,
+    // collect calibration statistics of the tensors and write them when the process exits
+    CalibrationTable
   } data_destination{DataDestination::StdOut};
 
   std::string file_suffix;
@@ -114,6 +128,9 @@ struct NodeDumpOptions {
 
   // Number of array items in snippet at beginning and end of each dimension for Stdout.
   int snippet_edge_items;
+
+  // Number of histogram bins per tensor for CalibrationTable. Value 0 collects only the min and max.
+  size_t calibration_num_bins;
 };
 
 struct NodeDumpContext {
@@ -123,6 +140,36 @@ struct NodeDumpContext {
   size_t program_counter;
 };
 
+// Accumulates the calibration statistics of float tensors over runs, the way the HistogramCollector of the
+// python quantization tools does: the histogram covers [-threshold, threshold] with threshold the largest
+// absolute value seen, and is widened by whole bins of the current width when a larger value arrives.
+class CalibrationCollector {
+ public:
+  explicit CalibrationCollector(size_t num_bins) : num_bins_{num_bins} {}
+
+  // adds the values of a float or float16 tensor. A tensor already collected in the same step is skipped, so a
+  // graph input read by several nodes is counted once per run.
+  void Collect(const std::string& name, const Tensor& tensor, size_t step);
+
+  // writes calibration.json, and calibration_histogram.json if histograms are collected, to output_dir
+  Status Write(const Path& output_dir, const std::string& file_suffix) const;
+
+ private:
+  struct TensorStatistics {
+    float min;
+    float max;
+    double threshold;
+    std::vector<int64_t> histogram;
+    size_t step;
+  };
+
+  void Collect(const std::string& name, gsl::span<const float> values, size_t step);
+
+  const size_t num_bins_;
+  mutable std::mutex mutex_;
+  std::map<std::string, TensorStatistics> statistics_;
+};
+
 // gets NodeDumpOptions instance configured from environment variable values
 const NodeDumpOptions& NodeDumpOptionsFromEnvironmentVariables();
 
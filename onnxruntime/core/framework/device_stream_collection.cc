@@ -23,6 +23,7 @@ class DeviceStreamCollectionImpl {
  public:
   DeviceStreamCollectionImpl(size_t num_streams, const AllocatorMap& allocators, bool is_main_graph) : num_streams_(num_streams), allocators_(allocators), is_main_graph_(is_main_graph) {
     device_streams_.resize(num_streams, nullptr);
+    owned_stream_by_index_.resize(num_streams, nullptr);
     owned_streams_.reserve(num_streams);
     root_stream_ = std::make_unique<DummyStream>(nullptr, root_stream_device_);
   }
@@ -56,6 +57,14 @@ class DeviceStreamCollectionImpl {
       }
     }
 
+    // the buffers of the streams forked from a parent stream are released to any stream below,
+    // so the work of those streams must be completed first.
+    for (auto* stream : forked_streams_) {
+      stream->Flush();
+    }
+    forked_streams_.clear();
+    notifications_.clear();
+
     // only clean the streams that is owned by current context
     for (auto& stream : owned_streams_) {
       ReleaseSingleStreamBuffers(stream.get());
@@ -67,9 +76,45 @@ class DeviceStreamCollectionImpl {
   void AddDeviceStream(size_t idx, std::unique_ptr<Stream> stream) {
     ORT_ENFORCE(idx < num_streams_);
     device_streams_[idx] = stream.get();
+    owned_stream_by_index_[idx] = stream.get();
     owned_streams_.emplace_back(std::move(stream));
   }
 
+  Status UseParentStream(Stream& parent_stream, const IStreamCommandHandleRegistry& stream_handle_registry,
+                         bool fork_streams) {
+    bool uses_parent_stream = false;
+    for (size_t i = 0; i < num_streams_; ++i) {
+      // the streams set from the parent stream in a previous run are replaced again.
+      Stream* stream = owned_stream_by_index_[i];
+      if (!stream) {
+        continue;
+      }
+      // if current logic stream is not on the same EP instance as parent stream
+      // and the EP instance does have async streams (not EP like CPU)
+      // return error as we don't have the code to setup the dependency at this moment.
+      ORT_RETURN_IF(stream->GetDevice() != parent_stream.GetDevice(),
+                    "Subgraph has nodes running on device: ", stream->GetDevice().Type(),
+                    " while parent graph node running on device: ", parent_stream.GetDevice().Type(),
+                    ", this is not supported yet.");
+      if (fork_streams && uses_parent_stream) {
+        ORT_RETURN_IF_ERROR(WaitOnStream(*stream, parent_stream, stream_handle_registry));
+        device_streams_[i] = stream;
+        forked_streams_.push_back(stream);
+      } else {
+        device_streams_[i] = &parent_stream;
+        uses_parent_stream = true;
+      }
+    }
+    return Status::OK();
+  }
+
+  Status JoinParentStream(Stream& parent_stream, const IStreamCommandHandleRegistry& stream_handle_registry) {
+    for (Stream* stream : forked_streams_) {
+      ORT_RETURN_IF_ERROR(WaitOnStream(parent_stream, *stream, stream_handle_registry));
+    }
+    return Status::OK();
+  }
+
   void SetDeviceStream(size_t idx, Stream* stream) {
     ORT_ENFORCE(idx < num_streams_);
     device_streams_[idx] = stream;
@@ -87,8 +132,28 @@ class DeviceStreamCollectionImpl {
   }
 
  private:
+  // Make the waiting stream wait for the work already enqueued on the notifying stream.
+  Status WaitOnStream(Stream& waiting_stream, Stream& notifying_stream,
+                      const IStreamCommandHandleRegistry& stream_handle_registry) {
+    auto wait_fn = stream_handle_registry.GetWaitHandle(notifying_stream.GetDevice().Type(),
+                                                        waiting_stream.GetDevice().Type());
+    auto notification = notifying_stream.CreateNotification(/*num_consumers*/ 1);
+    ORT_RETURN_IF_NOT(wait_fn && notification, "Cannot synchronize the streams of device: ",
+                      notifying_stream.GetDevice().Type(), " and device: ", waiting_stream.GetDevice().Type());
+    notification->ActivateAndUpdate();
+    wait_fn(waiting_stream, *notification);
+    waiting_stream.UpdateStreamClock(notification->GetStreamSyncTable());
+    notifications_.push_back(std::move(notification));
+    return Status::OK();
+  }
+
   size_t num_streams_;
   std::vector<Stream*> device_streams_;
+  // the device stream added at each index, which device_streams_ keeps unless a parent stream replaces it.
+  std::vector<Stream*> owned_stream_by_index_;
+  // the device streams forked from the parent stream, and the notifications used to synchronize them.
+  InlinedVector<Stream*> forked_streams_;
+  InlinedVector<std::unique_ptr<synchronize::Notification>> notifications_;
   InlinedVector<std::unique_ptr<Stream>> owned_streams_;
   // TODO(leca): review
   const AllocatorMap& allocators_;
@@ -129,6 +194,17 @@ Stream* DeviceStreamCollection::GetRootStream() const {
   return impl_->GetRootStream();
 }
 
+Status DeviceStreamCollection::UseParentStream(Stream& parent_stream,
+                                               const IStreamCommandHandleRegistry& stream_handle_registry,
+                                               bool fork_streams) {
+  return impl_->UseParentStream(parent_stream, stream_handle_registry, fork_streams);
+}
+
+Status DeviceStreamCollection::JoinParentStream(Stream& parent_stream,
+                                                const IStreamCommandHandleRegistry& stream_handle_registry) {
+  return impl_->JoinParentStream(parent_stream, stream_handle_registry);
+}
+
 DeviceStreamCollectionHolder::DeviceStreamCollectionHolder(const SessionState* session_state)
     : session_state_(session_state),
       p_(session_state->AcquireDeviceStreamCollection()) {
@@ -42,6 +42,18 @@ class DeviceStreamCollection {
 
   Stream* GetRootStream() const;
 
+  // Run the subgraph this collection belongs to on the stream of its parent node.
+  // Without fork_streams, every device stream of the collection is replaced by the parent stream.
+  // With fork_streams, only the first one is: the others keep their own device stream, which waits here
+  // for the work already on the parent stream, so that they run concurrently with it.
+  // JoinParentStream must then be called once the subgraph is executed.
+  Status UseParentStream(Stream& parent_stream, const IStreamCommandHandleRegistry& stream_handle_registry,
+                         bool fork_streams);
+
+  // Make the parent stream wait for the device streams forked from it by UseParentStream.
+  // CleanUp waits for the forked streams to complete before their buffers are released.
+  Status JoinParentStream(Stream& parent_stream, const IStreamCommandHandleRegistry& stream_handle_registry);
+
  private:
   std::unique_ptr<DeviceStreamCollectionImpl> impl_;
 };
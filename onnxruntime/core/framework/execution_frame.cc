@@ -4,6 +4,7 @@
 #include "core/framework/execution_frame.h"
 
 #include <sstream>
+#include <utility>
 
 #include "core/framework/mem_pattern_planner.h"
 #include "core/framework/execution_plan_base.h"
@@ -348,7 +349,12 @@ ExecutionFrame::ExecutionFrame(gsl::span<const int> feed_mlvalue_idxs, gsl::span
       device_streams_(device_streams),
 #endif
       session_state_(session_state),
-      mem_patterns_(nullptr) {
+      mem_patterns_(nullptr),
+      profile_memory_(session_state.Profiler().IsMemoryProfilingEnabled()) {
+  if (profile_memory_) {
+    allocated_sizes_.resize(static_cast<size_t>(session_state.GetOrtValueNameIdxMap().MaxIdx()) + 1, 0);
+  }
+
   Init(
       feed_mlvalue_idxs, feeds, session_state.GetInitializedTensors(),
 #if !defined(DISABLE_SPARSE_TENSORS)
@@ -554,6 +560,9 @@ Status ExecutionFrame::AllocateMLValueTensorSelfOwnBufferHelper(OrtValue& ort_va
             auto status = AllocateTensorWithPreAllocateBufferHelper(
                 ort_value, static_cast<void*>(static_cast<char*>(buffer) + block->offset_), element_type, location,
                 shape);
+            if (status.IsOK()) {
+              TrackMemoryAllocation(ort_value_index, size);
+            }
             return status;
           } else {
             // the block size may vary especially if the model has NonZero ops, or different sequence lengths are
@@ -586,6 +595,10 @@ Status ExecutionFrame::AllocateMLValueTensorSelfOwnBufferHelper(OrtValue& ort_va
           current_stream->GetDevice().Type(), current_stream->GetDevice().Type());
       void* p_data = stream_aware_alloc->AllocOnStream(buffer_size, current_stream, wait_handle);
       Tensor::InitOrtValue(element_type, shape, p_data, std::move(alloc), ort_value);
+    } else if (alloc->IsStreamOrdered()) {
+      size_t buffer_size = Tensor::CalculateTensorStorageSize(element_type, shape);
+      void* p_data = alloc->StreamOrderedAlloc(buffer_size, current_stream);
+      Tensor::InitOrtValue(element_type, shape, p_data, std::move(alloc), ort_value);
     } else {
       Tensor::InitOrtValue(element_type, shape, std::move(alloc), ort_value);
     }
@@ -602,6 +615,7 @@ Status ExecutionFrame::AllocateMLValueTensorSelfOwnBufferHelper(OrtValue& ort_va
   if (!utils::IsDataTypeString(element_type)) {
     TraceAllocate(ort_value_index, size);
   }
+  TrackMemoryAllocation(ort_value_index, size);
 
   {
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
@@ -669,6 +683,75 @@ Status ExecutionFrame::AllocateTensorWithPreAllocateBufferHelper(OrtValue& ort_v
   return Status::OK();
 }
 
+Status ExecutionFrame::TryAllocateInConcatOutput(OrtValue& ort_value, int ort_value_index, MLDataType element_type,
+                                                 const OrtDevice& location, const TensorShape& shape, bool& placed) {
+  placed = false;
+  const SequentialExecutionPlan& plan = *session_state_.GetExecutionPlan();
+  auto entry = plan.concat_in_place_inputs.find(ort_value_index);
+  if (entry == plan.concat_in_place_inputs.end()) {
+    return Status::OK();
+  }
+  const auto& concat = plan.concats_in_place[entry->second];
+
+  const auto rank = static_cast<int64_t>(shape.NumDimensions());
+  const int64_t axis = concat.axis < 0 ? concat.axis + rank : concat.axis;
+  // the tensor is a contiguous block of the output only if all the dimensions before the axis are 1
+  if (axis < 0 || axis >= rank || shape.SizeToDimension(static_cast<size_t>(axis)) != 1) {
+    return Status::OK();
+  }
+  const auto axis_index = static_cast<size_t>(axis);
+
+  // the shape of the output and the offset of the tensor in it are only known once all the other inputs are computed
+  TensorShapeVector output_dims = shape.AsShapeVector();
+  output_dims[axis_index] = 0;
+  int64_t offset = 0;
+  bool is_before = true;
+  for (OrtValueIndex input_index : concat.inputs) {
+    const TensorShape* input_shape = &shape;
+    if (input_index == ort_value_index) {
+      is_before = false;
+    } else {
+      const OrtValue& input = GetMutableMLValue(input_index);
+      if (!input.IsAllocated() || !input.IsTensor() || input.Get<Tensor>().DataType() != element_type) {
+        return Status::OK();
+      }
+      input_shape = &input.Get<Tensor>().Shape();
+    }
+    if (input_shape->NumDimensions() != shape.NumDimensions()) {
+      return Status::OK();
+    }
+    for (size_t i = 0, end = shape.NumDimensions(); i < end; ++i) {
+      if (i != axis_index && (*input_shape)[i] != shape[i]) {
+        return Status::OK();
+      }
+    }
+    output_dims[axis_index] += (*input_shape)[axis_index];
+    if (is_before) {
+      offset += input_shape->Size();
+    }
+  }
+
+  const TensorShape output_shape(output_dims);
+  OrtValue& output = GetMutableMLValue(concat.output);
+  if (!output.IsAllocated()) {
+    ORT_RETURN_IF_ERROR(AllocateAsPerAllocationPlan(output, concat.output, &output_shape));
+  }
+  if (!output.IsTensor()) {
+    return Status::OK();
+  }
+  Tensor& output_tensor = *output.GetMutable<Tensor>();
+  if (output_tensor.Shape() != output_shape || output_tensor.DataType() != element_type ||
+      output_tensor.Location().device != location) {
+    return Status::OK();
+  }
+
+  void* buffer = static_cast<char*>(output_tensor.MutableDataRaw()) +
+                 SafeInt<size_t>(offset) * element_type->Size();
+  ORT_RETURN_IF_ERROR(AllocateTensorWithPreAllocateBufferHelper(ort_value, buffer, element_type, location, shape));
+  placed = true;
+  return Status::OK();
+}
+
 static Status AllocateTraditionalMLValue(OrtValue& ort_value, const NonTensorTypeBase& type) {
   auto creator = type.GetCreateFunc();
   ort_value.Init(creator(), &type, type.GetDeleteFunc());
@@ -753,8 +836,15 @@ Status ExecutionFrame::AllocateAsPerAllocationPlan(OrtValue& ort_value, int ort_
       // In the future we may want to have different way to handle it.
       case AllocKind::kAllocateOutput:
       case AllocKind::kAllocate: {
-        ORT_RETURN_IF_ERROR(AllocateMLValueTensorSelfOwnBuffer(ort_value, ort_value_index, ml_data_type, alloc_info,
-                                                               *shape));
+        bool placed = false;
+        if (!session_state_.GetExecutionPlan()->concat_in_place_inputs.empty()) {
+          ORT_RETURN_IF_ERROR(TryAllocateInConcatOutput(ort_value, ort_value_index, ml_data_type, alloc_info,
+                                                        *shape, placed));
+        }
+        if (!placed) {
+          ORT_RETURN_IF_ERROR(AllocateMLValueTensorSelfOwnBuffer(ort_value, ort_value_index, ml_data_type,
+                                                                 alloc_info, *shape));
+        }
         break;
       }
       case AllocKind::kReuse: {
@@ -864,6 +954,7 @@ void ExecutionFrame::VerifyOutputSizes(int output_index, const Node& node, const
 Status ExecutionFrame::ReleaseMLValueImpl(int ort_value_idx) {
   ORT_RETURN_IF_ERROR(IExecutionFrame::ReleaseMLValueImpl(ort_value_idx));
   TraceFree(ort_value_idx);
+  TrackMemoryFree(ort_value_idx);
   return Status::OK();
 }
 
@@ -913,6 +1004,37 @@ void ExecutionFrame::TraceFree(int ort_value_idx) {
   }
 }
 
+void ExecutionFrame::TrackMemoryAllocation(int ort_value_idx, size_t size) {
+  if (!profile_memory_) {
+    return;
+  }
+  allocated_sizes_[ort_value_idx] = size;
+  allocated_bytes_ += size;
+  const size_t live_bytes = live_bytes_ += size;
+  size_t peak_live_bytes = peak_live_bytes_.load();
+  while (live_bytes > peak_live_bytes && !peak_live_bytes_.compare_exchange_weak(peak_live_bytes, live_bytes)) {
+  }
+}
+
+void ExecutionFrame::TrackMemoryFree(int ort_value_idx) {
+  if (!profile_memory_) {
+    return;
+  }
+  // OrtValues reusing the buffer of another OrtValue have no size of their own
+  const size_t size = std::exchange(allocated_sizes_[ort_value_idx], 0);
+  freed_bytes_ += size;
+  live_bytes_ -= size;
+}
+
+ExecutionFrame::MemoryStats ExecutionFrame::GetMemoryStats() const {
+  MemoryStats stats;
+  stats.allocated_bytes = allocated_bytes_.load();
+  stats.freed_bytes = freed_bytes_.load();
+  stats.live_bytes = live_bytes_.load();
+  stats.peak_live_bytes = peak_live_bytes_.load();
+  return stats;
+}
+
 // generate memory pattern based on the tracing of memory allocation/free in current execution
 // return error if the planner is not setup.
 Status ExecutionFrame::GeneratePatterns(MemoryPatternGroup& out) {
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <mutex>
 #include <vector>
 
@@ -168,6 +169,21 @@ class ExecutionFrame final : public IExecutionFrame {
   // If the retrival is sucessful, this function returns true and false otherwise.
   bool TryGetInferredShape(int index, TensorShape& shape) const override;
 
+  // Bytes of the tensors the frame allocated for the OrtValues of the graph, excluding feeds, initializers and
+  // tensors reusing the buffer of another OrtValue. Only tracked if memory profiling is enabled.
+  struct MemoryStats {
+    size_t allocated_bytes{0};  // allocated so far
+    size_t freed_bytes{0};      // released so far
+    size_t live_bytes{0};       // allocated and not released yet
+    size_t peak_live_bytes{0};  // maximum of live_bytes so far
+  };
+
+  bool IsMemoryProfilingEnabled() const {
+    return profile_memory_;
+  }
+
+  MemoryStats GetMemoryStats() const;
+
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
   // Return the size of virtual memory allocated in runtime.
   // The memory is usually used for activations in forward and backward passes.
@@ -210,9 +226,17 @@ class ExecutionFrame final : public IExecutionFrame {
   Status AllocateTensorWithPreAllocateBufferHelper(OrtValue& ort_value, void* pBuffer, MLDataType element_type,
                                                    const OrtDevice& location, const TensorShape& shape);
 
+  // Places the tensor at its offset in the output of the Concat consuming it if possible, see
+  // SequentialExecutionPlan::ConcatInPlace. `placed` is false if the tensor needs a buffer of its own.
+  Status TryAllocateInConcatOutput(OrtValue& ort_value, int ort_value_index, MLDataType element_type,
+                                   const OrtDevice& location, const TensorShape& shape, bool& placed);
+
   void TraceAllocate(int ort_value_idx, size_t size);
   void TraceFree(int ort_value_idx);
 
+  void TrackMemoryAllocation(int ort_value_idx, size_t size);
+  void TrackMemoryFree(int ort_value_idx);
+
   const AllocPlanPerValue& GetAllocationPlan(int ort_value_idx);
 
   Stream* GetValueStream(int ort_value_idx) const;
@@ -229,7 +253,7 @@ class ExecutionFrame final : public IExecutionFrame {
   // If we already have cached memory pattern on these input shapes
   // Use this mem pattern that create a big chunk for all the internal
   // kernel's input/output tensors.
-  const MemoryPatternGroup* mem_patterns_;
+  std::shared_ptr<const MemoryPatternGroup> mem_patterns_;
 
   // If no cached memory pattern, and we enable the memory pattern optimization
   // use this planner_ to trace the memory allocation in current executor.
@@ -243,7 +267,18 @@ class ExecutionFrame final : public IExecutionFrame {
   // by i, if the key i exists.
   // inferred_shapes_ is generated together with mem_patterns_.
   // It is never updated after creation
-  const InlinedHashMap<int, TensorShape>* inferred_shapes_{nullptr};
+  std::shared_ptr<const InlinedHashMap<int, TensorShape>> inferred_shapes_;
+
+  // Whether the memory of the OrtValues is tracked for the memory profiling of the session.
+  const bool profile_memory_;
+
+  // allocated_sizes_[i] is the size of the tensor allocated for the OrtValue indexed by i, if it has not been
+  // released yet. Only used if memory profiling is enabled.
+  std::vector<size_t> allocated_sizes_;
+  std::atomic<size_t> allocated_bytes_{0};
+  std::atomic<size_t> freed_bytes_{0};
+  std::atomic<size_t> live_bytes_{0};
+  std::atomic<size_t> peak_live_bytes_{0};
 
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
   // Size of virtual memory allocated before any kernel execution.
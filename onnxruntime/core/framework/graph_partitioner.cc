@@ -12,6 +12,7 @@
 #include "core/framework/kernel_lookup.h"
 #include "core/framework/kernel_registry_manager.h"
 #include "core/framework/kernel_registry.h"
+#include "core/framework/partitioning_cost_model.h"
 #include "core/graph/function.h"
 #include "core/graph/graph_viewer.h"
 
@@ -326,6 +327,40 @@ static Node* PlaceNode(Graph& graph, const IndexedSubGraph& capability,
   return result;
 }
 
+// remove the capabilities that the cost model estimates to run slower on the current EP than on the CPU EP,
+// including the copies of the values crossing between the devices. e.g. a small island of nodes between nodes that
+// run on the CPU is usually not worth the copies to and from the device.
+static void RemoveUnprofitableCapabilities(const Graph& graph, const IExecutionProvider& current_ep,
+                                           const PartitioningCostModel& cost_model,
+                                           std::vector<std::unique_ptr<ComputeCapability>>& capabilities) {
+  // the nodes of the other capabilities are expected to run on the EP, so the values exchanged with them are not
+  // copied. removing a capability can make its neighbors unprofitable, so repeat until nothing changes.
+  InlinedHashSet<NodeIndex> ep_nodes;
+  for (const auto& capability : capabilities) {
+    ep_nodes.insert(capability->sub_graph->nodes.begin(), capability->sub_graph->nodes.end());
+  }
+
+  bool removed = true;
+  while (removed) {
+    removed = false;
+    for (auto it = capabilities.begin(); it != capabilities.end();) {
+      const IndexedSubGraph& sub_graph = *(*it)->sub_graph;
+      if (cost_model.IsAssignmentProfitable(graph, sub_graph, current_ep.Type(), ep_nodes)) {
+        ++it;
+        continue;
+      }
+
+      LOGS_DEFAULT(VERBOSE) << "Cost model leaves " << sub_graph.nodes.size() << " nodes that "
+                            << current_ep.Type() << " can run to the CPU execution provider";
+      for (auto node_index : sub_graph.nodes) {
+        ep_nodes.erase(node_index);
+      }
+      it = capabilities.erase(it);
+      removed = true;
+    }
+  }
+}
+
 // for the current EP, recursively iterate through the Graph and any nested subgraphs (recursion is bottom-up).
 // assign any nodes to the EP that are currently unassigned, and that the EP can handle.
 static Status PartitionOnnxFormatModelImpl(Graph& graph, FuncManager& func_mgr,
@@ -335,7 +370,8 @@ static Status PartitionOnnxFormatModelImpl(Graph& graph, FuncManager& func_mgr,
                                            GraphPartitioner::Mode mode,
                                            int& fused_node_unique_id,
                                            const layout_transformer::TransformLayoutFunction& transform_layout_function,
-                                           const layout_transformer::DebugGraphFn& debug_graph_fn) {
+                                           const layout_transformer::DebugGraphFn& debug_graph_fn,
+                                           const PartitioningCostModel* cost_model) {
   // handle testing edge case where optimizers or constant lifting results in graph with no nodes.
   // doing it here saves all providers checking for this in GetCapability
   if (graph.NumberOfNodes() == 0) {
@@ -349,7 +385,7 @@ static Status PartitionOnnxFormatModelImpl(Graph& graph, FuncManager& func_mgr,
       // we pass through the FuncManager from the top level graph
       ORT_RETURN_IF_ERROR(PartitionOnnxFormatModelImpl(*subgraph, func_mgr, kernel_registry_mgr,
                                                        fused_kernel_registry, current_ep, mode, fused_node_unique_id,
-                                                       transform_layout_function, debug_graph_fn));
+                                                       transform_layout_function, debug_graph_fn, cost_model));
     }
   }
 
@@ -375,6 +411,15 @@ static Status PartitionOnnxFormatModelImpl(Graph& graph, FuncManager& func_mgr,
       std::cref(debug_graph_fn)};
 
   ORT_RETURN_IF_ERROR(GetCapabilityForEP(get_capability_params));
+
+  // the cost model only applies to EPs that copy values to another device. an EP with NHWC layout has its nodes
+  // transformed already in GetCapabilityForEP, so it must take all of them.
+  if (cost_model != nullptr && mode == GraphPartitioner::Mode::kNormal &&
+      current_ep.GetOrtDeviceByMemType(OrtMemTypeDefault).Type() != OrtDevice::CPU &&
+      current_ep.GetPreferredLayout() != DataLayout::NHWC) {
+    RemoveUnprofitableCapabilities(graph, current_ep, *cost_model, capabilities);
+  }
+
   if (capabilities.empty()) {
     return Status::OK();
   }
@@ -534,7 +579,8 @@ static Status InlineNodes(Graph& graph, bool& modified_graph) {
 
 static Status PartitionOnnxFormatModel(const PartitionParams& partition_params, GraphPartitioner::Mode mode,
                                        const ExecutionProviders& execution_providers,
-                                       KernelRegistryManager& kernel_registry_manager) {
+                                       KernelRegistryManager& kernel_registry_manager,
+                                       const PartitioningCostModel* cost_model) {
   bool modified_graph = false;
 
   auto& graph = partition_params.graph.get();
@@ -549,7 +595,7 @@ static Status PartitionOnnxFormatModel(const PartitionParams& partition_params,
       ORT_RETURN_IF_ERROR(PartitionOnnxFormatModelImpl(graph, func_mgr, kernel_registry_manager,
                                                        fused_kernel_registry, *ep, mode, fused_node_unique_id,
                                                        transform_layout_function,
-                                                       partition_params.debug_graph_fn));
+                                                       partition_params.debug_graph_fn, cost_model));
     }
 
     // expand any nodes that have an ONNX function definition but no matching ORT kernel.
@@ -703,6 +749,8 @@ Status GraphPartitioner::Partition(Graph& graph, FuncManager& func_mgr,
   //          but are completely separate Graph instances and not a subset of nodes within a single Graph instance.
   // 3. CPU execution provider is expected to be able to run any node and is the last one in execution provider
   //    preference.
+  // 4. If a cost model is provided, the sub-graphs of an execution provider on another device are only assigned to it
+  //    if they are estimated to run faster there than on the CPU, including the copies between the devices.
   if (providers_.Empty()) {
     return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "No provider specified.");
   }
@@ -738,8 +786,9 @@ Status GraphPartitioner::Partition(Graph& graph, FuncManager& func_mgr,
   if (mode == Mode::kNormal || mode == Mode::kAssignOnly) {
 #if !defined(ORT_MINIMAL_BUILD)
     ORT_RETURN_IF_ERROR(PartitionOnnxFormatModel(partition_params, mode,
-                                                 providers_, kernel_registry_mgr_));
+                                                 providers_, kernel_registry_mgr_, cost_model_));
 #else
+    ORT_UNUSED_PARAMETER(cost_model_);
     return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "ONNX models are not supported in this build.");
 #endif  //! defined(ORT_MINIMAL_BUILD)
   } else {
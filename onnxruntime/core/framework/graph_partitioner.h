@@ -12,6 +12,7 @@ namespace onnxruntime {
 
 class ExecutionProviders;
 class KernelRegistryManager;
+class PartitioningCostModel;
 
 class GraphPartitioner {
  public:
@@ -22,9 +23,13 @@ class GraphPartitioner {
   };
 
   // The order of providers represents the user preference.
-  GraphPartitioner(KernelRegistryManager& kernel_registry_mgr, const ExecutionProviders& providers)
+  // If a cost model is provided, the nodes an execution provider on a device other than the CPU can run are only
+  // assigned to it if the cost model estimates they run faster there, including the copies between the devices.
+  GraphPartitioner(KernelRegistryManager& kernel_registry_mgr, const ExecutionProviders& providers,
+                   const PartitioningCostModel* cost_model = nullptr)
       : kernel_registry_mgr_(kernel_registry_mgr),
-        providers_(providers) {
+        providers_(providers),
+        cost_model_(cost_model) {
   }
 
   // Run partitioning.
@@ -38,6 +43,7 @@ class GraphPartitioner {
 
   KernelRegistryManager& kernel_registry_mgr_;
   const ExecutionProviders& providers_;
+  const PartitioningCostModel* cost_model_;
 };
 
 }  // namespace onnxruntime
@@ -0,0 +1,235 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/host_shape_evaluation.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "core/common/inlined_containers.h"
+#include "core/framework/execution_frame.h"
+#include "core/framework/session_state.h"
+
+namespace onnxruntime {
+
+namespace {
+
+using HostShapeProgram = SequentialExecutionPlan::HostShapeProgram;
+
+// an int64 tensor of the program, copied to the host
+struct HostValue {
+  bool present{false};
+  TensorShapeVector dims;
+  InlinedVector<int64_t> data;
+};
+
+bool ReadHostValue(const Tensor& tensor, HostValue& value) {
+  if (!tensor.IsDataType<int64_t>() || tensor.Location().device.Type() != OrtDevice::CPU) {
+    return false;
+  }
+  const auto dims = tensor.Shape().GetDims();
+  const auto data = tensor.DataAsSpan<int64_t>();
+  value.present = true;
+  value.dims.assign(dims.begin(), dims.end());
+  value.data.assign(data.begin(), data.end());
+  return true;
+}
+
+// Normalizes the axes against `rank`, returns false if one is out of range or repeated.
+bool NormalizeAxes(gsl::span<const int64_t> axes, int64_t rank, InlinedVector<bool>& is_axis) {
+  is_axis.assign(static_cast<size_t>(rank), false);
+  for (int64_t axis : axes) {
+    if (axis < 0) {
+      axis += rank;
+    }
+    if (axis < 0 || axis >= rank || is_axis[static_cast<size_t>(axis)]) {
+      return false;
+    }
+    is_axis[static_cast<size_t>(axis)] = true;
+  }
+  return true;
+}
+
+bool EvaluateBinary(HostShapeProgram::Op op, const HostValue& a, const HostValue& b, HostValue& output) {
+  // the same shapes, or a single element broadcast to the other input
+  if (a.dims == b.dims) {
+    output.dims = a.dims;
+  } else if (b.data.size() == 1 && b.dims.size() <= a.dims.size()) {
+    output.dims = a.dims;
+  } else if (a.data.size() == 1 && a.dims.size() <= b.dims.size()) {
+    output.dims = b.dims;
+  } else {
+    return false;
+  }
+  const size_t size = std::max(a.data.size(), b.data.size());
+  output.data.resize(size);
+  for (size_t i = 0; i < size; ++i) {
+    const int64_t x = a.data[a.data.size() == 1 ? 0 : i];
+    const int64_t y = b.data[b.data.size() == 1 ? 0 : i];
+    switch (op) {
+      case HostShapeProgram::Op::kAdd:
+        output.data[i] = x + y;
+        break;
+      case HostShapeProgram::Op::kSub:
+        output.data[i] = x - y;
+        break;
+      case HostShapeProgram::Op::kMul:
+        output.data[i] = x * y;
+        break;
+      default:
+        // the kernel reports the division by zero
+        if (y == 0 || (x == std::numeric_limits<int64_t>::min() && y == -1)) {
+          return false;
+        }
+        output.data[i] = x / y;
+        break;
+    }
+  }
+  return true;
+}
+
+// Computes the output of the instruction, returns false if its kernel has to compute it.
+bool EvaluateInstruction(const HostShapeProgram::Instruction& instruction, gsl::span<const Tensor* const> inputs,
+                         HostValue& output) {
+  output.dims.clear();
+  output.data.clear();
+
+  if (instruction.op == HostShapeProgram::Op::kShape) {
+    const auto dims = inputs[0]->Shape().GetDims();
+    const int64_t rank = static_cast<int64_t>(dims.size());
+    const auto clamp = [rank](int64_t value) { return std::clamp<int64_t>(value < 0 ? value + rank : value, 0, rank); };
+    const int64_t start = clamp(instruction.start);
+    const int64_t end = std::max(start, clamp(instruction.end));
+    output.data.assign(dims.begin() + start, dims.begin() + end);
+    output.dims.push_back(end - start);
+    return true;
+  }
+
+  InlinedVector<HostValue> values(inputs.size());
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    if (inputs[i] != nullptr && !ReadHostValue(*inputs[i], values[i])) {
+      return false;
+    }
+  }
+  InlinedVector<bool> is_axis;
+  switch (instruction.op) {
+    case HostShapeProgram::Op::kGather: {
+      const auto& data = values[0];
+      const auto& indices = values[1];
+      const int64_t size = static_cast<int64_t>(data.data.size());
+      if (data.dims.size() != 1) {
+        return false;
+      }
+      for (int64_t index : indices.data) {
+        if (index < 0) {
+          index += size;
+        }
+        if (index < 0 || index >= size) {
+          return false;
+        }
+        output.data.push_back(data.data[static_cast<size_t>(index)]);
+      }
+      output.dims = indices.dims;
+      return true;
+    }
+    case HostShapeProgram::Op::kUnsqueeze:
+    case HostShapeProgram::Op::kSqueeze: {
+      const auto& data = values[0];
+      const bool has_axes_input = values.size() > 1 && values[1].present;
+      if (!instruction.axes.has_value() && !has_axes_input &&
+          instruction.op == HostShapeProgram::Op::kUnsqueeze) {
+        return false;
+      }
+      const gsl::span<const int64_t> axes = instruction.axes.has_value()
+                                                ? gsl::span<const int64_t>(*instruction.axes)
+                                            : has_axes_input ? gsl::span<const int64_t>(values[1].data)
+                                                             : gsl::span<const int64_t>();
+      const int64_t rank = static_cast<int64_t>(data.dims.size());
+      if (instruction.op == HostShapeProgram::Op::kUnsqueeze) {
+        if (!NormalizeAxes(axes, rank + static_cast<int64_t>(axes.size()), is_axis)) {
+          return false;
+        }
+        auto dim = data.dims.begin();
+        for (bool inserted : is_axis) {
+          output.dims.push_back(inserted ? 1 : *dim++);
+        }
+      } else {
+        if (!NormalizeAxes(axes, rank, is_axis)) {
+          return false;
+        }
+        for (size_t i = 0; i < data.dims.size(); ++i) {
+          // without axes, all the dimensions of size 1 are removed
+          const bool removed = axes.empty() ? data.dims[i] == 1 : is_axis[i];
+          if (removed && data.dims[i] != 1) {
+            return false;
+          }
+          if (!removed) {
+            output.dims.push_back(data.dims[i]);
+          }
+        }
+      }
+      output.data = data.data;
+      return true;
+    }
+    case HostShapeProgram::Op::kConcat: {
+      for (const auto& value : values) {
+        if (!value.present || value.dims.size() != 1) {
+          return false;
+        }
+        output.data.insert(output.data.end(), value.data.begin(), value.data.end());
+      }
+      output.dims.push_back(static_cast<int64_t>(output.data.size()));
+      return true;
+    }
+    case HostShapeProgram::Op::kIdentity:
+      output.dims = values[0].dims;
+      output.data = values[0].data;
+      return true;
+    default:
+      return EvaluateBinary(instruction.op, values[0], values[1], output);
+  }
+}
+
+}  // namespace
+
+Status EvaluateHostShapeProgram(const SessionState& session_state, ExecutionFrame& frame,
+                                std::vector<bool>& evaluated_nodes) {
+  const auto& program = *session_state.GetExecutionPlan()->host_shape_program;
+  const auto& graph_viewer = session_state.GetGraphViewer();
+  evaluated_nodes.assign(graph_viewer.MaxNodeIndex(), false);
+
+  InlinedVector<const Tensor*> inputs;
+  HostValue output;
+  for (const auto& instruction : program.instructions) {
+    const Node& node = *graph_viewer.GetNode(instruction.node_index);
+    const int node_offset = frame.GetNodeOffset(instruction.node_index);
+    const auto input_defs = node.InputDefs();
+    inputs.assign(input_defs.size(), nullptr);
+    bool ready = true;
+    for (size_t i = 0; i < input_defs.size() && ready; ++i) {
+      if (!input_defs[i]->Exists()) {
+        continue;
+      }
+      // the outputs of the nodes of the program that were not evaluated are not allocated
+      const OrtValue* value = frame.GetNodeInputOrOutputMLValue(node_offset + static_cast<int>(i));
+      ready = value != nullptr && value->IsTensor();
+      if (ready) {
+        inputs[i] = &value->Get<Tensor>();
+      }
+    }
+    if (!ready || !EvaluateInstruction(instruction, inputs, output)) {
+      continue;
+    }
+
+    const TensorShape output_shape(output.dims);
+    const int output_arg_index =
+        node_offset + static_cast<int>(input_defs.size() + node.ImplicitInputDefs().size());
+    OrtValue* p_output = nullptr;
+    ORT_RETURN_IF_ERROR(frame.GetOrCreateNodeOutputMLValue(0, output_arg_index, &output_shape, p_output, node));
+    std::copy(output.data.begin(), output.data.end(), p_output->GetMutable<Tensor>()->MutableData<int64_t>());
+    evaluated_nodes[instruction.node_index] = true;
+  }
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,27 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <vector>
+
+#include "core/common/status.h"
+
+namespace onnxruntime {
+
+class ExecutionFrame;
+class SessionState;
+
+/**
+ * Evaluates the nodes of SequentialExecutionPlan::host_shape_program from the shapes of the feeds and the constant
+ * initializers in `frame`, writing their outputs into the frame, see kOrtSessionOptionsConfigHostShapeEvaluation.
+ * Must be called before any node of the plan runs.
+ *
+ * `evaluated_nodes` is indexed by node index and set for the nodes whose outputs were written. The other nodes of the
+ * program, e.g. a Gather with an index out of range or an Add whose inputs need a general broadcast, are left to their
+ * kernels, and so are the nodes consuming their outputs.
+ */
+Status EvaluateHostShapeProgram(const SessionState& session_state, ExecutionFrame& frame,
+                                std::vector<bool>& evaluated_nodes);
+
+}  // namespace onnxruntime
@@ -24,7 +24,8 @@ Status KernelRegistryManager::CreateKernel(const Node& node,
                            session_state.GetConstantInitializedTensors(),
                            session_state.GetOrtValueNameIdxMap(),
                            session_state.GetDataTransferMgr(),
-                           session_state.GetAllocators());
+                           session_state.GetAllocators(),
+                           &session_state.GetSessionOptions().config_options);
 
   return kernel_create_info.kernel_create_func(session_state.GetMutableFuncMgr(), kernel_info, out);
 }
@@ -44,6 +45,7 @@ Status KernelRegistryManager::RegisterKernels(const ExecutionProviders& executio
 
     provider_type_to_registry_.insert(std::make_pair(provider->Type(), registry));
   }
+  ClearKernelLookupCache();
   return Status::OK();
 }
 
@@ -53,9 +55,30 @@ void KernelRegistryManager::RegisterKernelRegistry(std::shared_ptr<KernelRegistr
     return;
   }
   custom_kernel_registries_.push_front(kernel_registry);
+  ClearKernelLookupCache();
 }
 #endif
 
+std::string KernelRegistryManager::GetKernelLookupKey(const Node& node) {
+  std::string key;
+  key.reserve(64);
+  key.append(node.GetExecutionProviderType()).append(1, ':');
+  key.append(node.Domain()).append(1, ':');
+  key.append(node.OpType()).append(1, ':');
+  key.append(std::to_string(node.SinceVersion())).append(1, ':');
+  // the type strings are interned, their addresses identify them
+  const auto append_types = [&key](ConstPointerContainer<std::vector<NodeArg*>> args) {
+    for (const auto* arg : args) {
+      const auto* type = arg->Exists() ? arg->Type() : nullptr;
+      key.append(reinterpret_cast<const char*>(&type), sizeof(type));
+    }
+    key.append(1, ':');
+  };
+  append_types(node.InputDefs());
+  append_types(node.OutputDefs());
+  return key;
+}
+
 Status KernelRegistryManager::SearchKernelRegistry(const Node& node,
                                                    /*out*/ const KernelCreateInfo** kernel_create_info) const {
   Status status;
@@ -74,9 +97,24 @@ Status KernelRegistryManager::SearchKernelRegistry(const Node& node,
     return Status(ONNXRUNTIME, FAIL, create_error_message("The node is not placed on any Execution Provider. "));
   }
 
+  const std::string lookup_key = GetKernelLookupKey(node);
+  {
+    std::lock_guard<OrtMutex> lock(kernel_lookup_cache_mutex_);
+    const auto cached = kernel_lookup_cache_.find(lookup_key);
+    if (cached != kernel_lookup_cache_.end()) {
+      *kernel_create_info = cached->second;
+      return Status::OK();
+    }
+  }
+  const auto cache_result = [this, &lookup_key, kernel_create_info]() {
+    std::lock_guard<OrtMutex> lock(kernel_lookup_cache_mutex_);
+    kernel_lookup_cache_.emplace(lookup_key, *kernel_create_info);
+  };
+
   for (auto& registry : custom_kernel_registries_) {
     status = registry->TryFindKernel(node, std::string(), GetKernelTypeStrResolver(), kernel_create_info);
     if (status.IsOK()) {
+      cache_result();
       return status;
     }
   }
@@ -90,6 +128,7 @@ Status KernelRegistryManager::SearchKernelRegistry(const Node& node,
   if (p != nullptr) {
     status = p->TryFindKernel(node, std::string(), GetKernelTypeStrResolver(), kernel_create_info);
     if (status.IsOK()) {
+      cache_result();
       return status;
     }
   }
@@ -86,11 +86,21 @@ class KernelRegistryManager {
 
   void SetKernelTypeStrResolver(KernelTypeStrResolver&& kernel_type_str_resolver) {
     kernel_type_str_resolver_variant_ = std::move(kernel_type_str_resolver);
+    ClearKernelLookupCache();
   }
 
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(KernelRegistryManager);
 
  private:
+  // The kernel lookup cache key of a node: its provider, domain, op type and since version, and the types of its
+  // inputs and outputs, which are all the node properties the kernel matching depends on.
+  static std::string GetKernelLookupKey(const Node& node);
+
+  void ClearKernelLookupCache() {
+    std::lock_guard<OrtMutex> lock(kernel_lookup_cache_mutex_);
+    kernel_lookup_cache_.clear();
+  }
+
   // key is provider type. Each kernel registry in this collection only belongs to one specific provider
   std::unordered_map<std::string, std::shared_ptr<KernelRegistry>> provider_type_to_registry_;
   // Each kernel registry may contain kernels from many different providers.
@@ -105,5 +115,10 @@ class KernelRegistryManager {
       KernelTypeStrResolver  // the default in a minimal build
       >;
   KernelTypeStrResolverVariant kernel_type_str_resolver_variant_;
+
+  // the kernels found by SearchKernelRegistry, so that the nodes of the same op with the same types, which make up
+  // most of a large model, match the type constraints of the kernels once.
+  mutable InlinedHashMap<std::string, const KernelCreateInfo*> kernel_lookup_cache_;
+  mutable OrtMutex kernel_lookup_cache_mutex_;
 };
 }  // namespace onnxruntime
@@ -0,0 +1,205 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/memory_pattern_cache.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+#include "core/common/logging/logging.h"
+#include "core/common/narrow.h"
+#include "core/framework/murmurhash3.h"
+#include "core/framework/ort_value_name_idx_map.h"
+#include "core/framework/sequential_execution_plan.h"
+#include "core/framework/tensor.h"
+#include "core/graph/graph_viewer.h"
+
+namespace onnxruntime {
+
+namespace {
+
+// File format: a header line, the fingerprint line, then for every pattern group:
+// <key> <number of locations>
+// and for every location:
+// <device type> <memory type> <device id> <peak size> <number of blocks>
+// followed by one line per block: <OrtValue index> <offset> <size>
+constexpr const char* kFileHeader = "onnxruntime_memory_patterns 2";
+
+}  // namespace
+
+std::string MemoryPatternCache::MakeKey(gsl::span<const OrtValue> tensor_inputs) {
+  std::ostringstream key;
+  key << tensor_inputs.size() << ":";
+  for (const auto& input : tensor_inputs) {
+    key << "(";
+    const auto dims = input.Get<Tensor>().Shape().GetDims();
+    for (size_t i = 0; i < dims.size(); ++i) {
+      key << (i > 0 ? "," : "") << dims[i];
+    }
+    key << ")";
+  }
+  return key.str();
+}
+
+const MemoryPatternCache::Entry* MemoryPatternCache::Find(const std::string& key) {
+  auto it = entries_.find(key);
+  if (it == entries_.end()) {
+    return nullptr;
+  }
+  it->second.last_use = ++clock_;
+  return &it->second;
+}
+
+const MemoryPatternCache::Entry& MemoryPatternCache::Insert(const std::string& key, MemoryPatternGroup patterns,
+                                                            InlinedHashMap<int, TensorShape> inferred_shapes) {
+  auto it = entries_.find(key);
+  if (it == entries_.end()) {
+    EvictIfFull();
+    Entry entry;
+    entry.patterns = std::make_shared<const MemoryPatternGroup>(std::move(patterns));
+    entry.inferred_shapes = std::make_shared<const InlinedHashMap<int, TensorShape>>(std::move(inferred_shapes));
+    it = entries_.emplace(key, std::move(entry)).first;
+  }
+  it->second.last_use = ++clock_;
+  return it->second;
+}
+
+void MemoryPatternCache::EvictIfFull() {
+  if (capacity_ == 0 || entries_.size() < capacity_) {
+    return;
+  }
+  auto lru = std::min_element(entries_.begin(), entries_.end(), [](const auto& a, const auto& b) {
+    return a.second.last_use < b.second.last_use;
+  });
+  entries_.erase(lru);
+}
+
+std::string MemoryPatternCache::ComputeFingerprint(const GraphViewer& graph_viewer,
+                                                   const OrtValueNameIdxMap& ort_value_name_idx_map,
+                                                   const SequentialExecutionPlan& plan) {
+  std::ostringstream desc;
+  for (const auto& node : graph_viewer.Nodes()) {
+    desc << node.Index() << " " << node.Domain() << " " << node.OpType() << " " << node.GetExecutionProviderType()
+         << "\n";
+  }
+
+  // by index, the iteration order of the name map is not deterministic
+  std::map<int, const std::string*> names;
+  for (const auto& [name, idx] : ort_value_name_idx_map) {
+    names[idx] = &name;
+  }
+  const auto& allocation_plan = plan.GetAllocationPlan();
+  for (const auto& [idx, name] : names) {
+    desc << idx << " " << *name;
+    if (static_cast<size_t>(idx) < allocation_plan.size()) {
+      const auto& value_plan = allocation_plan[idx];
+      desc << " " << static_cast<int>(value_plan.alloc_kind) << " " << value_plan.location.ToString() << " "
+           << value_plan.reused_buffer;
+    }
+    desc << "\n";
+  }
+
+  const std::string str = desc.str();
+  uint32_t hash[4] = {0, 0, 0, 0};
+  MurmurHash3::x86_128(str.data(), narrow<int>(str.size()), hash[0], &hash);
+  std::ostringstream ss;
+  ss << std::hex << std::setfill('0');
+  for (uint32_t part : hash) {
+    ss << std::setw(8) << part;
+  }
+  return ss.str();
+}
+
+size_t MemoryPatternCache::Load(const PathString& file, const std::string& fingerprint) {
+  std::ifstream in(file);
+  std::string line;
+  if (!in || !std::getline(in, line) || line != kFileHeader) {
+    return 0;
+  }
+  if (!std::getline(in, line) || line != fingerprint) {
+    LOGS_DEFAULT(INFO) << "Ignoring memory pattern cache written for a different execution plan";
+    return 0;
+  }
+
+  std::vector<std::pair<std::string, MemoryPatternGroup>> loaded;
+  std::string key;
+  size_t num_locations = 0;
+  while (in >> key >> num_locations) {
+    MemoryPatternGroup group;
+    for (size_t i = 0; i < num_locations; ++i) {
+      int device_type = 0;
+      int memory_type = 0;
+      int device_id = 0;
+      size_t num_blocks = 0;
+      MemoryPattern pattern;
+      if (!(in >> device_type >> memory_type >> device_id >> pattern.peak_size_ >> num_blocks)) {
+        break;
+      }
+      for (size_t j = 0; j < num_blocks; ++j) {
+        int ort_value_idx = 0;
+        MemoryBlock block;
+        if (!(in >> ort_value_idx >> block.offset_ >> block.size_) ||
+            block.offset_ + block.size_ > pattern.peak_size_) {
+          LOGS_DEFAULT(WARNING) << "Ignoring malformed memory pattern cache";
+          return 0;
+        }
+        pattern.patterns_[ort_value_idx] = block;
+      }
+      group.locations.emplace_back(static_cast<OrtDevice::DeviceType>(device_type),
+                                   static_cast<OrtDevice::MemoryType>(memory_type),
+                                   static_cast<OrtDevice::DeviceId>(device_id));
+      group.patterns.push_back(std::move(pattern));
+    }
+    if (group.locations.size() != num_locations) {
+      LOGS_DEFAULT(WARNING) << "Ignoring malformed memory pattern cache";
+      return 0;
+    }
+    loaded.emplace_back(key, std::move(group));
+  }
+  if (!in.eof()) {
+    LOGS_DEFAULT(WARNING) << "Ignoring malformed memory pattern cache";
+    return 0;
+  }
+
+  size_t num_loaded = 0;
+  for (auto& [loaded_key, group] : loaded) {
+    if (entries_.count(loaded_key) == 0) {
+      Insert(loaded_key, std::move(group));
+      ++num_loaded;
+    }
+  }
+  return num_loaded;
+}
+
+Status MemoryPatternCache::Save(const PathString& file, const std::string& fingerprint) const {
+  std::ostringstream ss;
+  ss << kFileHeader << "\n"
+     << fingerprint << "\n";
+  for (const auto& [key, entry] : entries_) {
+    const MemoryPatternGroup& group = *entry.patterns;
+    ss << key << " " << group.locations.size() << "\n";
+    for (size_t i = 0; i < group.locations.size(); ++i) {
+      const OrtDevice& location = group.locations[i];
+      const MemoryPattern& pattern = group.patterns[i];
+      ss << static_cast<int>(location.Type()) << " " << static_cast<int>(location.MemType()) << " " << location.Id()
+         << " " << pattern.PeakSize() << " " << pattern.GetPatternsMap().size() << "\n";
+      for (const auto& [ort_value_idx, block] : pattern.GetPatternsMap()) {
+        ss << ort_value_idx << " " << block.offset_ << " " << block.size_ << "\n";
+      }
+    }
+  }
+
+  std::ofstream out(file, std::ios::trunc);
+  ORT_RETURN_IF_NOT(out.good(), "Failed to open memory pattern cache file");
+  out << ss.str();
+  out.close();
+  ORT_RETURN_IF_NOT(out.good(), "Failed to write memory pattern cache file");
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,76 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "core/common/common.h"
+#include "core/common/gsl.h"
+#include "core/common/inlined_containers.h"
+#include "core/common/path_string.h"
+#include "core/framework/mem_pattern.h"
+#include "core/framework/ort_value.h"
+#include "core/framework/tensor_shape.h"
+
+namespace onnxruntime {
+
+class GraphViewer;
+class OrtValueNameIdxMap;
+struct SequentialExecutionPlan;
+
+// The memory patterns of a session, by the shapes of the inputs of a Run().
+//
+// An entry is looked up by the rank and dimensions of every input, and holds the layout of the intermediate buffers
+// of the execution plan for those shapes. If a capacity is set, the least recently used entry is evicted when the
+// cache is full. Entries are shared with the execution frames using them, so an evicted entry stays valid until the
+// Run() that uses it completes. Not thread-safe, SessionState serializes the access.
+//
+// The entries can be persisted in a file so the next session that loads the same model starts with them
+// (see kOrtSessionOptionsConfigMemoryPatternCacheFile). Memory patterns are offsets into the buffers planned for the
+// OrtValues of an execution plan, so a file is only used by a session whose execution plan has the same fingerprint:
+// the nodes with their execution providers, and the OrtValues with their allocation plan.
+class MemoryPatternCache {
+ public:
+  struct Entry {
+    std::shared_ptr<const MemoryPatternGroup> patterns;
+    // inferred shapes of the OrtValues, only generated in training builds
+    std::shared_ptr<const InlinedHashMap<int, TensorShape>> inferred_shapes;
+    uint64_t last_use = 0;
+  };
+
+  // Key of the memory patterns for a Run() with `tensor_inputs`, e.g. "2:(1,128)(1,128,768)".
+  static std::string MakeKey(gsl::span<const OrtValue> tensor_inputs);
+
+  // `capacity` is the maximum number of entries, 0 for no limit.
+  void SetCapacity(size_t capacity) { capacity_ = capacity; }
+
+  // Returns the entry for `key` and marks it as most recently used, or nullptr if there is none.
+  const Entry* Find(const std::string& key);
+
+  // Adds an entry for `key` unless there is one already, evicting the least recently used entry if the cache is full.
+  // Returns the entry for `key`.
+  const Entry& Insert(const std::string& key, MemoryPatternGroup patterns,
+                      InlinedHashMap<int, TensorShape> inferred_shapes = {});
+
+  size_t Size() const { return entries_.size(); }
+
+  static std::string ComputeFingerprint(const GraphViewer& graph_viewer, const OrtValueNameIdxMap& ort_value_name_idx_map,
+                                        const SequentialExecutionPlan& plan);
+
+  // Adds the patterns stored in `file` if the file exists and was written for `fingerprint`.
+  // Patterns already present for a key are kept. Returns the number of patterns loaded.
+  size_t Load(const PathString& file, const std::string& fingerprint);
+
+  Status Save(const PathString& file, const std::string& fingerprint) const;
+
+ private:
+  void EvictIfFull();
+
+  NodeHashMap<std::string, Entry> entries_;
+  size_t capacity_ = 0;
+  uint64_t clock_ = 0;
+};
+
+}  // namespace onnxruntime
@@ -0,0 +1,295 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/node_flops.h"
+
+#include <algorithm>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+
+#include "core/common/cpuid_info.h"
+#include "core/graph/graph.h"
+
+namespace onnxruntime {
+
+namespace profiling {
+
+namespace {
+
+using Shapes = gsl::span<const TensorShape* const>;
+using FlopsFunction = bool (*)(const Node& node, Shapes inputs, Shapes outputs, double& flops);
+
+const TensorShape* GetShape(Shapes shapes, size_t i) {
+  return i < shapes.size() ? shapes[i] : nullptr;
+}
+
+int64_t GetIntAttribute(const Node& node, const std::string& name, int64_t default_value) {
+  const auto& attributes = node.GetAttributes();
+  auto it = attributes.find(name);
+  return it != attributes.end() && it->second.has_i() ? it->second.i() : default_value;
+}
+
+// Product of the dimensions of the kernel of a convolution or pooling, from its weights or from the kernel_shape
+double KernelSize(const TensorShape& weights) {
+  return weights.NumDimensions() > 2 ? static_cast<double>(weights.SizeFromDimension(2)) : 1.0;
+}
+
+double KernelSize(const Node& node) {
+  const auto& attributes = node.GetAttributes();
+  auto it = attributes.find("kernel_shape");
+  double size = 1.0;
+  if (it != attributes.end()) {
+    for (auto dim : it->second.ints()) {
+      size *= static_cast<double>(dim);
+    }
+  }
+  return size;
+}
+
+// Y = A * B, with A at the first input
+bool MatMulFlops(const Node& node, Shapes inputs, Shapes outputs, double& flops) {
+  const TensorShape* a = GetShape(inputs, 0);
+  const TensorShape* y = GetShape(outputs, 0);
+  if (a == nullptr || y == nullptr || a->NumDimensions() == 0) {
+    return false;
+  }
+  const size_t rank = a->NumDimensions();
+  // FusedMatMul transposes the last two dimensions of A when transA is set
+  const int64_t k = rank > 1 && GetIntAttribute(node, "transA", 0) != 0 ? (*a)[rank - 2] : (*a)[rank - 1];
+  flops = 2.0 * static_cast<double>(y->Size()) * static_cast<double>(k);
+  return true;
+}
+
+bool GemmFlops(const Node& node, Shapes inputs, Shapes outputs, double& flops) {
+  const TensorShape* a = GetShape(inputs, 0);
+  const TensorShape* y = GetShape(outputs, 0);
+  if (a == nullptr || y == nullptr || a->NumDimensions() != 2) {
+    return false;
+  }
+  const int64_t k = GetIntAttribute(node, "transA", 0) != 0 ? (*a)[0] : (*a)[1];
+  flops = 2.0 * static_cast<double>(y->Size()) * static_cast<double>(k);
+  if (GetShape(inputs, 2) != nullptr) {
+    flops += static_cast<double>(y->Size());
+  }
+  return true;
+}
+
+// Weights of shape {M, C / group, k1, k2, ...} at input kWeightsInput
+template <size_t kWeightsInput>
+bool ConvFlops(const Node& /*node*/, Shapes inputs, Shapes outputs, double& flops) {
+  const TensorShape* w = GetShape(inputs, kWeightsInput);
+  const TensorShape* y = GetShape(outputs, 0);
+  if (w == nullptr || y == nullptr || w->NumDimensions() < 2) {
+    return false;
+  }
+  flops = 2.0 * static_cast<double>(y->Size()) * static_cast<double>((*w)[1]) * KernelSize(*w);
+  return true;
+}
+
+// Weights of shape {C, M / group, k1, k2, ...}: every input element is multiplied by a kernel for each output channel
+bool ConvTransposeFlops(const Node& /*node*/, Shapes inputs, Shapes /*outputs*/, double& flops) {
+  const TensorShape* x = GetShape(inputs, 0);
+  const TensorShape* w = GetShape(inputs, 1);
+  if (x == nullptr || w == nullptr || w->NumDimensions() < 2) {
+    return false;
+  }
+  flops = 2.0 * static_cast<double>(x->Size()) * static_cast<double>((*w)[1]) * KernelSize(*w);
+  return true;
+}
+
+// Attention with the input of shape {B, S, D} projected to Q, K and V by weights of shape {D, Dq + Dk + Dv}
+bool AttentionFlops(const Node& /*node*/, Shapes inputs, Shapes outputs, double& flops) {
+  const TensorShape* x = GetShape(inputs, 0);
+  const TensorShape* w = GetShape(inputs, 1);
+  const TensorShape* y = GetShape(outputs, 0);
+  if (x == nullptr || w == nullptr || y == nullptr || x->NumDimensions() != 3 || w->NumDimensions() != 2) {
+    return false;
+  }
+  const double batch_size = static_cast<double>((*x)[0]);
+  const double sequence_length = static_cast<double>((*x)[1]);
+  // the past state has the shape {2, B, N, P, H}
+  const TensorShape* past = GetShape(inputs, 4);
+  const double total_sequence_length =
+      sequence_length + (past != nullptr && past->NumDimensions() == 5 ? static_cast<double>((*past)[3]) : 0.0);
+  const double hidden_size = static_cast<double>((*y)[2]);
+  flops = 2.0 * batch_size * sequence_length * static_cast<double>((*w)[0]) * static_cast<double>((*w)[1]) +
+          // Q * K' and the product of the probabilities with V
+          4.0 * batch_size * sequence_length * total_sequence_length * hidden_size;
+  return true;
+}
+
+// Attention on the query of shape {B, S, D} and the key of shape {B, L, D}
+bool MultiHeadAttentionFlops(const Node& /*node*/, Shapes inputs, Shapes outputs, double& flops) {
+  const TensorShape* query = GetShape(inputs, 0);
+  const TensorShape* key = GetShape(inputs, 1);
+  const TensorShape* y = GetShape(outputs, 0);
+  if (query == nullptr || y == nullptr || query->NumDimensions() != 3 || y->NumDimensions() != 3) {
+    return false;
+  }
+  const double batch_size = static_cast<double>((*query)[0]);
+  const double sequence_length = static_cast<double>((*query)[1]);
+  const double kv_sequence_length =
+      key != nullptr && key->NumDimensions() == 3 ? static_cast<double>((*key)[1]) : sequence_length;
+  flops = 2.0 * batch_size * sequence_length * kv_sequence_length *
+          (static_cast<double>((*query)[2]) + static_cast<double>((*y)[2]));
+  return true;
+}
+
+template <int kFlopsPerElement>
+bool ElementwiseFlops(const Node& /*node*/, Shapes /*inputs*/, Shapes outputs, double& flops) {
+  const TensorShape* y = GetShape(outputs, 0);
+  if (y == nullptr) {
+    return false;
+  }
+  flops = kFlopsPerElement * static_cast<double>(y->Size());
+  return true;
+}
+
+// Reductions and normalizations, which go over every element of the first input
+template <int kFlopsPerElement>
+bool InputElementsFlops(const Node& /*node*/, Shapes inputs, Shapes /*outputs*/, double& flops) {
+  const TensorShape* x = GetShape(inputs, 0);
+  if (x == nullptr) {
+    return false;
+  }
+  flops = kFlopsPerElement * static_cast<double>(x->Size());
+  return true;
+}
+
+bool PoolFlops(const Node& node, Shapes /*inputs*/, Shapes outputs, double& flops) {
+  const TensorShape* y = GetShape(outputs, 0);
+  if (y == nullptr) {
+    return false;
+  }
+  flops = static_cast<double>(y->Size()) * KernelSize(node);
+  return true;
+}
+
+const std::unordered_map<std::string, FlopsFunction>& FlopsFunctions() {
+  static const std::unordered_map<std::string, FlopsFunction> functions{
+      {"MatMul", MatMulFlops},
+      {"FusedMatMul", MatMulFlops},
+      {"MatMulInteger", MatMulFlops},
+      {"MatMulIntegerToFloat", MatMulFlops},
+      {"DynamicQuantizeMatMul", MatMulFlops},
+      {"QLinearMatMul", MatMulFlops},
+      {"Gemm", GemmFlops},
+      {"Conv", ConvFlops<1>},
+      {"FusedConv", ConvFlops<1>},
+      {"NhwcConv", ConvFlops<1>},
+      {"NhwcFusedConv", ConvFlops<1>},
+      {"ConvInteger", ConvFlops<1>},
+      {"QLinearConv", ConvFlops<3>},
+      {"ConvTranspose", ConvTransposeFlops},
+      {"Attention", AttentionFlops},
+      {"MultiHeadAttention", MultiHeadAttentionFlops},
+
+      {"Add", ElementwiseFlops<1>},
+      {"Sub", ElementwiseFlops<1>},
+      {"Mul", ElementwiseFlops<1>},
+      {"Div", ElementwiseFlops<1>},
+      {"Pow", ElementwiseFlops<1>},
+      {"Max", ElementwiseFlops<1>},
+      {"Min", ElementwiseFlops<1>},
+      {"Sum", ElementwiseFlops<1>},
+      {"Abs", ElementwiseFlops<1>},
+      {"Neg", ElementwiseFlops<1>},
+      {"Sqrt", ElementwiseFlops<1>},
+      {"Reciprocal", ElementwiseFlops<1>},
+      {"Exp", ElementwiseFlops<1>},
+      {"Log", ElementwiseFlops<1>},
+      {"Erf", ElementwiseFlops<1>},
+      {"Tanh", ElementwiseFlops<1>},
+      {"Sigmoid", ElementwiseFlops<1>},
+      {"Relu", ElementwiseFlops<1>},
+      {"LeakyRelu", ElementwiseFlops<1>},
+      {"PRelu", ElementwiseFlops<1>},
+      {"Clip", ElementwiseFlops<1>},
+      {"Where", ElementwiseFlops<1>},
+      {"Equal", ElementwiseFlops<1>},
+      {"Less", ElementwiseFlops<1>},
+      {"Greater", ElementwiseFlops<1>},
+      {"Gelu", ElementwiseFlops<1>},
+      {"FastGelu", ElementwiseFlops<1>},
+      {"BiasGelu", ElementwiseFlops<1>},
+      {"QuickGelu", ElementwiseFlops<1>},
+
+      {"ReduceSum", InputElementsFlops<1>},
+      {"ReduceMean", InputElementsFlops<1>},
+      {"ReduceMax", InputElementsFlops<1>},
+      {"ReduceMin", InputElementsFlops<1>},
+      {"ReduceProd", InputElementsFlops<1>},
+      {"ReduceSumSquare", InputElementsFlops<1>},
+      {"ReduceL1", InputElementsFlops<1>},
+      {"ReduceL2", InputElementsFlops<1>},
+      {"ArgMax", InputElementsFlops<1>},
+      {"ArgMin", InputElementsFlops<1>},
+      {"GlobalAveragePool", InputElementsFlops<1>},
+      {"GlobalMaxPool", InputElementsFlops<1>},
+      // max, exponential and sum, division
+      {"Softmax", InputElementsFlops<3>},
+      {"LogSoftmax", InputElementsFlops<3>},
+      // scale and bias
+      {"BatchNormalization", InputElementsFlops<2>},
+      // mean, variance, normalization, scale and bias
+      {"LayerNormalization", InputElementsFlops<5>},
+      {"SimplifiedLayerNormalization", InputElementsFlops<4>},
+      {"SkipLayerNormalization", InputElementsFlops<6>},
+      {"SkipSimplifiedLayerNormalization", InputElementsFlops<5>},
+      {"InstanceNormalization", InputElementsFlops<5>},
+
+      {"MaxPool", PoolFlops},
+      {"AveragePool", PoolFlops},
+  };
+  return functions;
+}
+
+// Single precision operations per cycle of a core with two fused multiply-add units
+double FlopsPerCycle() {
+  const auto& cpuid_info = CPUIDInfo::GetCPUIDInfo();
+#if defined(CPUIDINFO_ARCH_X86)
+  if (cpuid_info.HasAVX512f()) {
+    return 64.0;
+  }
+  if (cpuid_info.HasAVX2()) {
+    return 32.0;
+  }
+  if (cpuid_info.HasAVX()) {
+    return 16.0;
+  }
+  return 8.0;
+#else
+  ORT_UNUSED_PARAMETER(cpuid_info);
+  // NEON
+  return 16.0;
+#endif
+}
+
+// Maximum frequency of the cores in GHz, or 0 if it is unknown
+double MaxFrequencyGhz() {
+#ifdef __linux__
+  std::ifstream file("/sys/devices/system/cpu/cpu0/cpufreq/cpuinfo_max_freq");
+  double frequency_khz = 0;
+  if (file >> frequency_khz) {
+    return frequency_khz / 1e6;
+  }
+#endif
+  return 0.0;
+}
+
+}  // namespace
+
+bool EstimateNodeFlops(const Node& node, gsl::span<const TensorShape* const> input_shapes,
+                       gsl::span<const TensorShape* const> output_shapes, double& flops) {
+  const auto& functions = FlopsFunctions();
+  auto it = functions.find(node.OpType());
+  return it != functions.end() && it->second(node, input_shapes, output_shapes, flops);
+}
+
+double EstimatePeakGflops(int num_threads) {
+  return FlopsPerCycle() * MaxFrequencyGhz() * std::max(num_threads, 1);
+}
+
+}  // namespace profiling
+}  // namespace onnxruntime
@@ -0,0 +1,37 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/gsl.h"
+#include "core/framework/tensor_shape.h"
+
+namespace onnxruntime {
+
+class Node;
+
+namespace profiling {
+
+/**
+ * Estimates the arithmetic operations of a node from the shapes of its inputs and outputs, for the roofline analysis
+ * of the profiles. Multiply-adds count as two operations, other element-wise operations, reductions and comparisons
+ * as one operation per element, and normalizations as a few operations per element. Integer operations of quantized
+ * operators are counted like floating point ones.
+ *
+ * `input_shapes` and `output_shapes` have nullptr for the inputs and outputs that are missing or are not tensors.
+ * Returns false if the operator is not one of the common operators the estimation covers.
+ */
+bool EstimateNodeFlops(const Node& node,
+                       gsl::span<const TensorShape* const> input_shapes,
+                       gsl::span<const TensorShape* const> output_shapes,
+                       double& flops);
+
+/**
+ * Estimates the peak single precision throughput in GFLOP/s of `num_threads` cores of the processor, from the vector
+ * instructions reported by CPUIDInfo, assuming two fused multiply-add units per core, and the maximum frequency of
+ * the cores. Returns 0 if the frequency is unknown, which is the case on other platforms than Linux.
+ */
+double EstimatePeakGflops(int num_threads);
+
+}  // namespace profiling
+}  // namespace onnxruntime
@@ -0,0 +1,68 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/nvtx_ranges.h"
+
+#include <atomic>
+
+// NVTX 3 is header only and ships with the CUDA toolkit, so the ranges do not need a build with ENABLE_NVTX_PROFILE
+#if defined(USE_CUDA) && defined(__has_include)
+#if __has_include(<nvtx3/nvToolsExt.h>)
+#include <nvtx3/nvToolsExt.h>
+#define ORT_NVTX_RANGES_AVAILABLE
+#endif
+#endif
+
+namespace onnxruntime {
+
+namespace profiling {
+
+namespace {
+
+std::atomic<int> enable_count{0};
+
+}  // namespace
+
+void NvtxRanges::Enable() {
+#ifdef ORT_NVTX_RANGES_AVAILABLE
+  enable_count.fetch_add(1, std::memory_order_relaxed);
+#endif
+}
+
+void NvtxRanges::Disable() {
+#ifdef ORT_NVTX_RANGES_AVAILABLE
+  enable_count.fetch_sub(1, std::memory_order_relaxed);
+#endif
+}
+
+bool NvtxRanges::IsEnabled() {
+  return enable_count.load(std::memory_order_relaxed) > 0;
+}
+
+#ifdef ORT_NVTX_RANGES_AVAILABLE
+
+void NvtxRanges::Push(const char* message, NvtxColor color) {
+  nvtxEventAttributes_t attributes{};
+  attributes.version = NVTX_VERSION;
+  attributes.size = NVTX_EVENT_ATTRIB_STRUCT_SIZE;
+  attributes.colorType = NVTX_COLOR_ARGB;
+  attributes.color = static_cast<uint32_t>(color);
+  attributes.messageType = NVTX_MESSAGE_TYPE_ASCII;
+  attributes.message.ascii = message;
+  nvtxRangePushEx(&attributes);
+}
+
+void NvtxRanges::Pop() {
+  nvtxRangePop();
+}
+
+#else
+
+void NvtxRanges::Push(const char* /*message*/, NvtxColor /*color*/) {}
+
+void NvtxRanges::Pop() {}
+
+#endif  // ORT_NVTX_RANGES_AVAILABLE
+
+}  // namespace profiling
+}  // namespace onnxruntime
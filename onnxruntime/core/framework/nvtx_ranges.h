@@ -0,0 +1,67 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstdint>
+
+#include "core/common/common.h"
+
+namespace onnxruntime {
+
+namespace profiling {
+
+// Colors of the ranges in ARGB, one per kind of work so that they can be told apart in the timeline
+enum class NvtxColor : uint32_t {
+  kSession = 0xff76b900,  // session initialization phases and runs
+  kNode = 0xffffbf00,     // compute of a node
+  kMemcpy = 0xff00bfff,   // memcpy nodes and copies of the inputs and outputs across devices
+  kGraphReplay = 0xffff00ff,
+  kAllocation = 0xffff4040,
+};
+
+/**
+ * NVTX ranges around the phases of the session initialization, the runs, the compute of every node, the copies across
+ * devices, CUDA graph replays and arena extensions, so that Nsight Systems shows what the runtime does between the
+ * CUDA calls.
+ *
+ * The ranges are emitted while at least one session enabled them with kOrtSessionOptionsConfigNvtxRanges, in builds
+ * with CUDA, where NVTX is header only. Otherwise a range costs a relaxed atomic load. NVTX itself does nothing unless
+ * a tool like Nsight Systems is attached to the process.
+ */
+class NvtxRanges {
+ public:
+  // Enabling is counted: the ranges are emitted until Disable is called as many times as Enable
+  static void Enable();
+  static void Disable();
+
+  static bool IsEnabled();
+
+  // Pushes a range on the stack of the calling thread. `message` is copied.
+  static void Push(const char* message, NvtxColor color);
+  static void Pop();
+};
+
+// Range over the lifetime of the object, if the ranges are enabled when it is created
+class NvtxRange {
+ public:
+  NvtxRange(const char* message, NvtxColor color) : pushed_(NvtxRanges::IsEnabled()) {
+    if (pushed_) {
+      NvtxRanges::Push(message, color);
+    }
+  }
+
+  ~NvtxRange() {
+    if (pushed_) {
+      NvtxRanges::Pop();
+    }
+  }
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(NvtxRange);
+
+ private:
+  const bool pushed_;
+};
+
+}  // namespace profiling
+}  // namespace onnxruntime
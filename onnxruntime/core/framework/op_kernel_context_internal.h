@@ -46,6 +46,11 @@ class OpKernelContextInternal : public OpKernelContext {
     return session_state_.GetSubgraphSessionState(GetNodeIndex(), attribute_name);
   }
 
+  // Finalize the session state of a subgraph whose finalization was deferred until its first execution.
+  Status FinalizeSubgraphSessionState(const std::string& attribute_name) {
+    return session_state_.FinalizeDeferredSubgraphSessionState(GetNodeIndex(), attribute_name);
+  }
+
   const OrtValue* GetInputMLValue(int index) const override {
     return OpKernelContext::GetInputMLValue(index);
   }
@@ -0,0 +1,179 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#if !defined(ORT_MINIMAL_BUILD)
+
+#include "core/framework/partitioning_cost_model.h"
+
+#include <fstream>
+
+#include "core/framework/data_types.h"
+#include "core/framework/tensorprotoutils.h"
+#include "nlohmann/json.hpp"
+
+using json = nlohmann::json;
+
+namespace onnxruntime {
+
+namespace {
+
+// Kernel time events of the session profiler are named "<node name>_kernel_time".
+constexpr std::string_view kKernelTimeSuffix = "_kernel_time";
+
+// Estimates for a copy between the host and a device over PCIe.
+constexpr double kCopyLatencyUs = 10.0;
+constexpr double kCopyBytesPerUs = 8000.0;
+
+std::string MakeKey(const std::string& provider_type, const std::string& name) {
+  return provider_type + '/' + name;
+}
+
+// Gets the string value of a member of a json object, or an empty string.
+std::string GetString(const json& object, const char* name) {
+  auto it = object.find(name);
+  return it != object.end() && it->is_string() ? it->get<std::string>() : std::string{};
+}
+
+}  // namespace
+
+Status PartitioningCostModel::LoadProfile(const PathString& profile_path) {
+  std::ifstream profile_stream(profile_path);
+  ORT_RETURN_IF_NOT(profile_stream.is_open(), "Failed to open profile ", ToUTF8String(profile_path));
+
+  const json events = json::parse(profile_stream, nullptr, /*allow_exceptions*/ false);
+  ORT_RETURN_IF_NOT(events.is_array(), "Profile ", ToUTF8String(profile_path), " is not an array of trace events.");
+
+  for (const auto& event : events) {
+    if (!event.is_object() || GetString(event, "cat") != "Node") {
+      continue;
+    }
+
+    const std::string name = GetString(event, "name");
+    auto args = event.find("args");
+    auto dur = event.find("dur");
+    if (name.size() <= kKernelTimeSuffix.size() ||
+        name.compare(name.size() - kKernelTimeSuffix.size(), kKernelTimeSuffix.size(), kKernelTimeSuffix) != 0 ||
+        args == event.end() || !args->is_object() || dur == event.end() || !dur->is_number()) {
+      continue;
+    }
+
+    const std::string provider_type = GetString(*args, "provider");
+    const std::string op_type = GetString(*args, "op_name");
+    if (!provider_type.empty() && !op_type.empty()) {
+      AddKernelTime(provider_type, name.substr(0, name.size() - kKernelTimeSuffix.size()), op_type,
+                    dur->get<double>());
+    }
+  }
+
+  return Status::OK();
+}
+
+void PartitioningCostModel::AddKernelTime(const std::string& provider_type, const std::string& node_name,
+                                          const std::string& op_type, double duration_us) {
+  auto& node_time = node_times_[MakeKey(provider_type, node_name)];
+  node_time.total_us += duration_us;
+  node_time.count++;
+
+  auto& op_time = op_times_[MakeKey(provider_type, op_type)];
+  op_time.total_us += duration_us;
+  op_time.count++;
+}
+
+std::optional<double> PartitioningCostModel::GetNodeCost(const Node& node, const std::string& provider_type) const {
+  auto it = node_times_.find(MakeKey(provider_type, node.Name()));
+  if (it == node_times_.end()) {
+    it = op_times_.find(MakeKey(provider_type, node.OpType()));
+    if (it == op_times_.end()) {
+      return std::nullopt;
+    }
+  }
+  return it->second.total_us / static_cast<double>(it->second.count);
+}
+
+double PartitioningCostModel::GetTransferCost(const NodeArg& node_arg) {
+  // The size of values with dynamic shapes is unknown, so only the latency of the copy is counted for them.
+  const auto* type = node_arg.TypeAsProto();
+  const auto* shape = node_arg.Shape();
+  if (type == nullptr || shape == nullptr || !utils::HasTensorType(*type)) {
+    return kCopyLatencyUs;
+  }
+
+  const auto* tensor_type = DataTypeImpl::TensorTypeFromONNXEnum(type->tensor_type().elem_type());
+  double bytes = static_cast<double>(tensor_type->GetElementType()->Size());
+  for (const auto& dim : shape->dim()) {
+    if (!utils::HasDimValue(dim)) {
+      return kCopyLatencyUs;
+    }
+    bytes *= static_cast<double>(dim.dim_value());
+  }
+  return kCopyLatencyUs + bytes / kCopyBytesPerUs;
+}
+
+bool PartitioningCostModel::IsAssignmentProfitable(const Graph& graph, const IndexedSubGraph& sub_graph,
+                                                   const std::string& provider_type,
+                                                   const InlinedHashSet<NodeIndex>& provider_nodes) const {
+  double provider_cost = 0.0;
+  double cpu_cost = 0.0;
+
+  for (NodeIndex node_index : sub_graph.nodes) {
+    const Node* node = graph.GetNode(node_index);
+    if (node == nullptr) {
+      return true;
+    }
+    auto node_provider_cost = GetNodeCost(*node, provider_type);
+    auto node_cpu_cost = GetNodeCost(*node, kCpuExecutionProvider);
+    if (!node_provider_cost.has_value() || !node_cpu_cost.has_value()) {
+      return true;
+    }
+    provider_cost += *node_provider_cost;
+    cpu_cost += *node_cpu_cost;
+  }
+
+  // A value crossing the boundary of the sub-graph is copied if the node on the other side runs on the other device.
+  // Graph inputs and outputs are on the CPU. Initializers are copied once when the session is created.
+  const InlinedHashSet<NodeIndex> sub_graph_nodes(sub_graph.nodes.begin(), sub_graph.nodes.end());
+  InlinedHashSet<std::string_view> copied_to_provider;
+  InlinedHashSet<std::string_view> copied_to_cpu;
+  auto add_transfer = [&](const NodeArg& node_arg, bool other_side_on_provider) {
+    auto& copied = other_side_on_provider ? copied_to_cpu : copied_to_provider;
+    if (copied.insert(node_arg.Name()).second) {
+      (other_side_on_provider ? cpu_cost : provider_cost) += GetTransferCost(node_arg);
+    }
+  };
+
+  for (NodeIndex node_index : sub_graph.nodes) {
+    const Node& node = *graph.GetNode(node_index);
+
+    for (const auto* input_def : node.InputDefs()) {
+      if (!input_def->Exists() || graph.GetConstantInitializer(input_def->Name(), true) != nullptr) {
+        continue;
+      }
+      const Node* producer = graph.GetProducerNode(input_def->Name());
+      if (producer == nullptr) {
+        add_transfer(*input_def, false);
+      } else if (sub_graph_nodes.count(producer->Index()) == 0) {
+        add_transfer(*input_def, provider_nodes.count(producer->Index()) > 0);
+      }
+    }
+
+    for (auto it = node.OutputEdgesBegin(), end = node.OutputEdgesEnd(); it != end; ++it) {
+      const NodeIndex consumer_index = it->GetNode().Index();
+      if (sub_graph_nodes.count(consumer_index) == 0) {
+        add_transfer(*node.OutputDefs()[it->GetSrcArgIndex()], provider_nodes.count(consumer_index) > 0);
+      }
+    }
+  }
+
+  for (const auto* output : graph.GetOutputs()) {
+    const Node* producer = graph.GetProducerNode(output->Name());
+    if (producer != nullptr && sub_graph_nodes.count(producer->Index()) > 0) {
+      add_transfer(*output, false);
+    }
+  }
+
+  return provider_cost < cpu_cost;
+}
+
+}  // namespace onnxruntime
+
+#endif  // !defined(ORT_MINIMAL_BUILD)
@@ -0,0 +1,67 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#if !defined(ORT_MINIMAL_BUILD)
+
+#include <optional>
+#include <string>
+
+#include "core/common/common.h"
+#include "core/common/inlined_containers.h"
+#include "core/common/path_string.h"
+#include "core/graph/graph.h"
+#include "core/graph/indexed_sub_graph.h"
+
+namespace onnxruntime {
+
+/**
+Cost model for the graph partitioner, built from the kernel times in profiles written by the session profiler.
+The partitioner uses it to only assign a group of nodes to an execution provider on another device than the CPU
+if the nodes are estimated to run faster there than on the CPU execution provider, including the time to copy the
+tensors that cross between the devices.
+*/
+class PartitioningCostModel {
+ public:
+  PartitioningCostModel() = default;
+
+  /** Adds the kernel times of a profile written by the session profiler.
+  Profiles of runs with different execution providers, including the CPU execution provider, can be combined. */
+  Status LoadProfile(const PathString& profile_path);
+
+  /** Adds the kernel time of one run of a node. */
+  void AddKernelTime(const std::string& provider_type, const std::string& node_name, const std::string& op_type,
+                     double duration_us);
+
+  /** Gets the estimated kernel time of a node on an execution provider in microseconds.
+  The average time of the node with the same name is used if it was profiled, else that of nodes of the same op type.
+  @returns nullopt if neither was profiled. */
+  std::optional<double> GetNodeCost(const Node& node, const std::string& provider_type) const;
+
+  /** Gets the estimated time to copy a value between devices in microseconds. */
+  static double GetTransferCost(const NodeArg& node_arg);
+
+  /** Checks if the nodes of sub_graph are estimated to run faster on an execution provider than on the CPU.
+  @param provider_nodes The nodes that are expected to be assigned to the execution provider, which are used to
+                        decide which of the values crossing the boundary of sub_graph need to be copied.
+  @returns true if the estimate is lower on the execution provider, or if a node was not profiled. */
+  bool IsAssignmentProfitable(const Graph& graph, const IndexedSubGraph& sub_graph, const std::string& provider_type,
+                              const InlinedHashSet<NodeIndex>& provider_nodes) const;
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(PartitioningCostModel);
+
+  struct KernelTime {
+    double total_us = 0.0;
+    size_t count = 0;
+  };
+
+  // Kernel times keyed by provider type and node name, and by provider type and op type.
+  InlinedHashMap<std::string, KernelTime> node_times_;
+  InlinedHashMap<std::string, KernelTime> op_times_;
+};
+
+}  // namespace onnxruntime
+
+#endif  // !defined(ORT_MINIMAL_BUILD)
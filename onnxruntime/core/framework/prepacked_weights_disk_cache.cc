@@ -0,0 +1,290 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/prepacked_weights_disk_cache.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iterator>
+#include <sstream>
+#include <type_traits>
+#include <vector>
+
+#include "core/common/cpuid_info.h"
+#include "core/common/logging/logging.h"
+#include "core/common/narrow.h"
+#include "core/common/safeint.h"
+#include "core/framework/config_options.h"
+#include "core/framework/murmurhash3.h"
+#include "core/framework/tensor.h"
+#include "core/graph/graph.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/path_lib.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
+#include "onnxruntime_config.h"
+
+namespace onnxruntime {
+
+namespace {
+
+// File layout: FileHeader, num_buffers uint64_t buffer sizes, then the buffers, each at an offset that is a multiple
+// of kBufferAlignment. The mapping starts at a page boundary, so the buffers are as aligned as an allocation would be.
+constexpr char kFileMagic[8] = {'O', 'R', 'T', 'P', 'A', 'C', 'K', '\0'};
+constexpr uint32_t kFileVersion = 1;
+constexpr size_t kBufferAlignment = 64;
+
+struct FileHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t num_buffers;
+};
+
+size_t AlignOffset(size_t offset) {
+  return (offset + kBufferAlignment - 1) / kBufferAlignment * kBufferAlignment;
+}
+
+// Offsets of the buffers in the file, given their sizes. Returns the file length.
+size_t ComputeBufferOffsets(const std::vector<uint64_t>& buffer_sizes, std::vector<size_t>& offsets) {
+  SafeInt<size_t> offset = sizeof(FileHeader) + buffer_sizes.size() * sizeof(uint64_t);
+  offsets.clear();
+  for (uint64_t size : buffer_sizes) {
+    offset = AlignOffset(offset);
+    offsets.push_back(offset);
+    offset += size;
+  }
+  return offset;
+}
+
+class KeyHasher {
+ public:
+  void Add(const void* data, size_t length) {
+    const char* bytes = static_cast<const char*>(data);
+    // MurmurHash3 takes an int length, large initializers are hashed in chunks
+    constexpr size_t kMaxChunk = size_t{1} << 30;
+    do {
+      const size_t chunk = std::min(length, kMaxChunk);
+      MurmurHash3::x86_128(bytes, static_cast<int>(chunk), hash_[0], &hash_);
+      bytes += chunk;
+      length -= chunk;
+    } while (length > 0);
+  }
+
+  template <typename T>
+  void Add(T value) {
+    static_assert(std::is_arithmetic_v<T>);
+    Add(&value, sizeof(value));
+  }
+
+  void Add(const std::string& value) {
+    Add(value.size());
+    Add(value.data(), value.size());
+  }
+
+  std::string ToString() const {
+    std::ostringstream ss;
+    ss << std::hex << std::setfill('0');
+    for (uint32_t part : hash_) {
+      ss << std::setw(8) << part;
+    }
+    return ss.str();
+  }
+
+ private:
+  uint32_t hash_[4] = {0, 0, 0, 0};
+};
+
+uint32_t GetCpuFeatures() {
+  const auto& cpu_info = CPUIDInfo::GetCPUIDInfo();
+  const bool features[] = {cpu_info.HasSSE3(), cpu_info.HasSSE4_1(), cpu_info.HasAVX(), cpu_info.HasAVX2(),
+                           cpu_info.HasF16C(), cpu_info.HasAVX512f(), cpu_info.HasAVX512Skylake(),
+                           cpu_info.HasAVX512_BF16(), cpu_info.HasAMX_BF16(), cpu_info.HasArmNeonDot(),
+                           cpu_info.HasFp16VectorAcceleration()};
+  uint32_t mask = 0;
+  for (size_t i = 0; i < std::size(features); ++i) {
+    mask |= static_cast<uint32_t>(features[i]) << i;
+  }
+  return mask;
+}
+
+int RemoveFile(const PathString& path) {
+#ifdef _WIN32
+  return _wremove(path.c_str());
+#else
+  return std::remove(path.c_str());
+#endif
+}
+
+int RenameFile(const PathString& from, const PathString& to) {
+#ifdef _WIN32
+  return _wrename(from.c_str(), to.c_str());
+#else
+  return std::rename(from.c_str(), to.c_str());
+#endif
+}
+
+}  // namespace
+
+PrepackedWeightsDiskCache::PrepackedWeightsDiskCache(const Env& env, PathString cache_dir)
+    : env_(env), cache_dir_(std::move(cache_dir)) {
+}
+
+std::string PrepackedWeightsDiskCache::GenerateKey(const Node& node, int input_idx, const Tensor& tensor,
+                                                   const ConfigOptions& config_options) {
+  KeyHasher hasher;
+  hasher.Add(std::string(ORT_VERSION));
+  hasher.Add(sizeof(void*));
+  hasher.Add(GetCpuFeatures());
+  // the float kernels pack their weights as bfloat16 when this is enabled
+  hasher.Add(config_options.GetConfigOrDefault(kOrtSessionOptionsMlasGemmFastMathBf16, "0"));
+  // the float MatMul and Gemm kernels pack quantized weights when this is set
+  hasher.Add(config_options.GetConfigOrDefault(kOrtSessionOptionsMatMulWeightQuantization, ""));
+  // quantized weights are packed unsigned where the U8S8 kernels saturate, which the CPU features do not tell
+  hasher.Add(static_cast<uint32_t>(MlasPlatformU8S8Overflow()));
+
+  hasher.Add(node.Domain());
+  hasher.Add(node.OpType());
+  hasher.Add(node.SinceVersion());
+  const auto& attributes = node.GetAttributes();
+  std::vector<std::string> attribute_names;
+  attribute_names.reserve(attributes.size());
+  for (const auto& attribute : attributes) {
+    attribute_names.push_back(attribute.first);
+  }
+  std::sort(attribute_names.begin(), attribute_names.end());
+  for (const auto& name : attribute_names) {
+    hasher.Add(name);
+    hasher.Add(attributes.at(name).SerializeAsString());
+  }
+
+  hasher.Add(input_idx);
+  hasher.Add(tensor.GetElementType());
+  for (int64_t dim : tensor.Shape().GetDims()) {
+    hasher.Add(dim);
+  }
+  if (tensor.IsDataTypeString()) {
+    for (const auto& element : tensor.DataAsSpan<std::string>()) {
+      hasher.Add(element);
+    }
+  } else {
+    hasher.Add(tensor.DataRaw(), tensor.SizeInBytes());
+  }
+
+  return node.OpType() + "_" + hasher.ToString();
+}
+
+PathString PrepackedWeightsDiskCache::GetFilePath(const std::string& key) const {
+  return ConcatPathComponent<PATH_CHAR_TYPE>(cache_dir_, ToPathString(key + ".ortpack"));
+}
+
+const PrePackedWeights* PrepackedWeightsDiskCache::Load(const std::string& key) {
+  auto it = loaded_weights_.find(key);
+  if (it != loaded_weights_.end()) {
+    return it->second;
+  }
+
+  const PathString path = GetFilePath(key);
+  size_t file_length = 0;
+  if (!env_.GetFileLength(path.c_str(), file_length).IsOK() || file_length < sizeof(FileHeader)) {
+    return nullptr;
+  }
+
+  Entry entry;
+  auto status = env_.MapFileIntoMemory(path.c_str(), 0, file_length, entry.mapped_file);
+  if (!status.IsOK()) {
+    LOGS_DEFAULT(WARNING) << "Failed to map pre-packed weights file " << PathToUTF8String(path) << ": "
+                          << status.ErrorMessage();
+    return nullptr;
+  }
+
+  const char* data = entry.mapped_file.get();
+  FileHeader header;
+  std::memcpy(&header, data, sizeof(header));
+  if (std::memcmp(header.magic, kFileMagic, sizeof(kFileMagic)) != 0 || header.version != kFileVersion ||
+      file_length < sizeof(FileHeader) + SafeInt<size_t>(header.num_buffers) * sizeof(uint64_t)) {
+    LOGS_DEFAULT(WARNING) << "Ignoring invalid pre-packed weights file " << PathToUTF8String(path);
+    return nullptr;
+  }
+
+  std::vector<uint64_t> buffer_sizes(header.num_buffers);
+  std::memcpy(buffer_sizes.data(), data + sizeof(FileHeader), buffer_sizes.size() * sizeof(uint64_t));
+  std::vector<size_t> offsets;
+  if (ComputeBufferOffsets(buffer_sizes, offsets) != file_length) {
+    LOGS_DEFAULT(WARNING) << "Ignoring truncated pre-packed weights file " << PathToUTF8String(path);
+    return nullptr;
+  }
+
+  for (size_t i = 0; i < buffer_sizes.size(); ++i) {
+    // the buffers point into the mapping, which is released with the entry
+    void* buffer = buffer_sizes[i] == 0 ? nullptr : const_cast<char*>(data) + offsets[i];
+    entry.weights.buffers_.emplace_back(buffer, [](void*) {});
+    entry.weights.buffer_sizes_.push_back(static_cast<size_t>(buffer_sizes[i]));
+  }
+
+  const PrePackedWeights* weights = &entries_.emplace_back(std::move(entry)).weights;
+  loaded_weights_[key] = weights;
+  return weights;
+}
+
+const PrePackedWeights& PrepackedWeightsDiskCache::Add(PrePackedWeights&& weights) {
+  Entry& entry = entries_.emplace_back();
+  entry.weights = std::move(weights);
+  return entry.weights;
+}
+
+Status PrepackedWeightsDiskCache::Write(const std::string& key, const PrePackedWeights& weights) const {
+  ORT_ENFORCE(weights.buffers_.size() == weights.buffer_sizes_.size());
+
+  FileHeader header;
+  std::memcpy(header.magic, kFileMagic, sizeof(kFileMagic));
+  header.version = kFileVersion;
+  header.num_buffers = narrow<uint32_t>(weights.buffers_.size());
+
+  // placeholder buffers are stored with size 0 and restored as nullptr
+  std::vector<uint64_t> buffer_sizes;
+  for (size_t i = 0; i < weights.buffers_.size(); ++i) {
+    buffer_sizes.push_back(weights.buffers_[i] ? weights.buffer_sizes_[i] : 0);
+  }
+  std::vector<size_t> offsets;
+  const size_t file_length = ComputeBufferOffsets(buffer_sizes, offsets);
+
+  const PathString path = GetFilePath(key);
+  const PathString temp_path = path + ToPathString(".tmp" + std::to_string(env_.GetSelfPid()));
+  {
+    std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+    ORT_RETURN_IF_NOT(file.good(), "Failed to create pre-packed weights file ", PathToUTF8String(temp_path));
+
+    const std::vector<char> padding(kBufferAlignment, 0);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(buffer_sizes.data()),
+               static_cast<std::streamsize>(buffer_sizes.size() * sizeof(uint64_t)));
+    size_t written = sizeof(header) + buffer_sizes.size() * sizeof(uint64_t);
+    for (size_t i = 0; i < buffer_sizes.size(); ++i) {
+      file.write(padding.data(), static_cast<std::streamsize>(offsets[i] - written));
+      file.write(static_cast<const char*>(weights.buffers_[i].get()), static_cast<std::streamsize>(buffer_sizes[i]));
+      written = offsets[i] + static_cast<size_t>(buffer_sizes[i]);
+    }
+    ORT_ENFORCE(written == file_length);
+
+    file.close();
+    if (!file.good()) {
+      RemoveFile(temp_path);
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Failed to write pre-packed weights file ",
+                             PathToUTF8String(temp_path));
+    }
+  }
+
+  if (RenameFile(temp_path, path) != 0) {
+    RemoveFile(temp_path);
+    // another session may have stored the same weight in the meantime
+    size_t existing_length = 0;
+    ORT_RETURN_IF_NOT(env_.GetFileLength(path.c_str(), existing_length).IsOK() && existing_length == file_length,
+                      "Failed to create pre-packed weights file ", PathToUTF8String(path));
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,67 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <list>
+#include <string>
+#include <unordered_map>
+
+#include "core/common/common.h"
+#include "core/common/path_string.h"
+#include "core/framework/prepacked_weights.h"
+#include "core/platform/env.h"
+
+namespace onnxruntime {
+
+struct ConfigOptions;
+class Node;
+class Tensor;
+
+// Persists pre-packed weights of CPU kernels in a directory so the next session that loads the same model
+// does not have to call OpKernel::PrePack() again. See kOrtSessionOptionsConfigPrepackedWeightsCacheDir.
+//
+// Every pre-packed weight is stored in its own file. The key of a weight is a hash of the CPU features (the pre-packed
+// layout of MLAS depends on them), the onnxruntime version, the op and its attributes, the input index and the
+// contents of the initializer, so a cached file is never used for a different model, kernel or machine. Kernels
+// still check the sizes and layout of the loaded buffers, and pre-pack again if they do not match.
+// Cached files are memory mapped, and the mapping is held by this instance for as long as the session lives.
+class PrepackedWeightsDiskCache final {
+ public:
+  PrepackedWeightsDiskCache(const Env& env, PathString cache_dir);
+
+  // Returns the key of the pre-packed form of `tensor` when it is used as input `input_idx` of `node`. The session
+  // options that change the packed layout of a kernel are part of the key.
+  static std::string GenerateKey(const Node& node, int input_idx, const Tensor& tensor,
+                                 const ConfigOptions& config_options);
+
+  // Returns the weight cached under `key`, mapping its file into memory on first use, or nullptr if there is no
+  // valid file.
+  const PrePackedWeights* Load(const std::string& key);
+
+  // Keeps a freshly pre-packed weight alive for the kernels that use it and returns the stored instance.
+  const PrePackedWeights& Add(PrePackedWeights&& weights);
+
+  // Writes `weights` to the cache directory under `key`. The file is written to a temporary name first and then
+  // renamed, so concurrent sessions never observe a partial file.
+  Status Write(const std::string& key, const PrePackedWeights& weights) const;
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(PrepackedWeightsDiskCache);
+
+ private:
+  struct Entry {
+    Env::MappedMemoryPtr mapped_file;  // null for weights packed by this session
+    PrePackedWeights weights;
+  };
+
+  PathString GetFilePath(const std::string& key) const;
+
+  const Env& env_;
+  const PathString cache_dir_;
+
+  // node based, the kernels hold on to pointers into the stored weights
+  std::list<Entry> entries_;
+  std::unordered_map<std::string, const PrePackedWeights*> loaded_weights_;
+};
+
+}  // namespace onnxruntime
@@ -0,0 +1,89 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#if !defined(ORT_MINIMAL_BUILD)
+
+#include "core/framework/profile_guided_optimization.h"
+
+#include <fstream>
+#include <vector>
+
+#include "nlohmann/json.hpp"
+
+using json = nlohmann::json;
+
+namespace onnxruntime {
+
+namespace {
+
+// Gets the string value of a member of a json object, or an empty string.
+std::string GetString(const json& object, const char* name) {
+  auto it = object.find(name);
+  return it != object.end() && it->is_string() ? it->get<std::string>() : std::string{};
+}
+
+// The NchwcTransformer inserts these nodes around the nodes it converts to the NCHWc layout.
+bool IsNchwcReorder(const std::string& op_type) {
+  return op_type == "ReorderInput" || op_type == "ReorderOutput";
+}
+
+}  // namespace
+
+Status ProfileGuidedOptimization::LoadProfile(const PathString& profile_path) {
+  std::ifstream profile_stream(profile_path);
+  ORT_RETURN_IF_NOT(profile_stream.is_open(), "Failed to open profile ", ToUTF8String(profile_path));
+
+  const json events = json::parse(profile_stream, nullptr, /*allow_exceptions*/ false);
+  ORT_RETURN_IF_NOT(events.is_array(), "Profile ", ToUTF8String(profile_path), " is not an array of trace events.");
+
+  bool uses_nchwc_layout = false;
+  std::vector<double> run_times;
+  for (const auto& event : events) {
+    if (!event.is_object()) {
+      continue;
+    }
+
+    const std::string category = GetString(event, "cat");
+    if (category == "Node") {
+      auto args = event.find("args");
+      if (args != event.end() && args->is_object() && IsNchwcReorder(GetString(*args, "op_name"))) {
+        uses_nchwc_layout = true;
+      }
+    } else if (category == "Session" && GetString(event, "name") == "model_run") {
+      auto dur = event.find("dur");
+      if (dur != event.end() && dur->is_number()) {
+        run_times.push_back(dur->get<double>());
+      }
+    }
+  }
+
+  // The first run includes the allocations of the memory patterns and warms up the caches, so it is skipped if
+  // there are others.
+  for (size_t i = run_times.size() > 1 ? 1 : 0; i < run_times.size(); ++i) {
+    AddRunTime(uses_nchwc_layout, run_times[i]);
+  }
+
+  return Status::OK();
+}
+
+void ProfileGuidedOptimization::AddRunTime(bool uses_nchwc_layout, double duration_us) {
+  auto& runs = uses_nchwc_layout ? nchwc_runs_ : other_runs_;
+  runs.total_us += duration_us;
+  runs.count++;
+}
+
+InlinedHashSet<std::string> ProfileGuidedOptimization::GetOptimizersToDisable() const {
+  InlinedHashSet<std::string> optimizers_to_disable;
+
+  if (nchwc_runs_.count > 0 && other_runs_.count > 0 &&
+      nchwc_runs_.total_us / static_cast<double>(nchwc_runs_.count) >=
+          other_runs_.total_us / static_cast<double>(other_runs_.count)) {
+    optimizers_to_disable.insert("NchwcTransformer");
+  }
+
+  return optimizers_to_disable;
+}
+
+}  // namespace onnxruntime
+
+#endif  // !defined(ORT_MINIMAL_BUILD)
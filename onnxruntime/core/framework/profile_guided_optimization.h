@@ -0,0 +1,52 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#if !defined(ORT_MINIMAL_BUILD)
+
+#include <string>
+
+#include "core/common/common.h"
+#include "core/common/inlined_containers.h"
+#include "core/common/path_string.h"
+
+namespace onnxruntime {
+
+/**
+Summary of profiles written by the session profiler in earlier runs of a model, used to make the optimization
+decisions of a new session that depend on how the model actually performed.
+Currently this selects whether the CPU execution provider uses the NCHWc layout, by comparing the run times of
+profiles with and without it. The kernel times of the profiles are used for the placement of nodes by the graph
+partitioner, see PartitioningCostModel.
+*/
+class ProfileGuidedOptimization {
+ public:
+  ProfileGuidedOptimization() = default;
+
+  /** Adds the model runs of a profile written by the session profiler. */
+  Status LoadProfile(const PathString& profile_path);
+
+  /** Adds the time of a model run, with or without the NCHWc layout. */
+  void AddRunTime(bool uses_nchwc_layout, double duration_us);
+
+  /** Gets the optimizers that should be disabled based on the loaded profiles.
+  The NchwcTransformer is disabled if runs with and without the NCHWc layout were profiled and the runs with it
+  were not faster on average. */
+  InlinedHashSet<std::string> GetOptimizersToDisable() const;
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(ProfileGuidedOptimization);
+
+  struct RunTime {
+    double total_us = 0.0;
+    size_t count = 0;
+  };
+
+  RunTime nchwc_runs_;
+  RunTime other_runs_;
+};
+
+}  // namespace onnxruntime
+
+#endif  // !defined(ORT_MINIMAL_BUILD)
@@ -3,6 +3,9 @@
 
 #pragma once
 
+#include <limits>
+#include <optional>
+
 #include "core/graph/basic_types.h"
 #include "core/common/inlined_containers.h"
 #include "core/framework/alloc_kind.h"
@@ -165,6 +168,118 @@ struct SequentialExecutionPlan : public ExecutionPlanBase {
 
   size_t num_barriers{0};
 
+  // Whether the streams of this subgraph were split into its independent branches
+  // (kOrtSessionOptionsConfigConcurrentSubgraphStreams), to run them on separate device streams.
+  bool concurrent_subgraph_streams{false};
+
+  // Dynamic inter-op scheduling (kOrtSessionOptionsConfigDynamicInterOpScheduling): instead of running each logic
+  // stream in order, a node is run by the inter-op thread pool as soon as all the nodes it consumes outputs of
+  // completed. The following are only filled in if the plan can be executed that way.
+  bool dynamic_scheduling{false};
+  // indexed by node index: number of distinct producer nodes
+  std::vector<int> node_dependency_counts;
+  // indexed by node index: the nodes consuming its outputs
+  std::vector<InlinedVector<NodeIndex>> node_downstreams;
+  // indexed by node index: the logic stream the node was assigned to
+  std::vector<size_t> node_stream_map;
+  // the nodes without producers, which are ready when the execution starts
+  InlinedVector<NodeIndex> dynamic_schedule_roots;
+
+  // Symbolic memory planning (kOrtSessionOptionsConfigSymbolicMemoryPlanning): the allocations and frees of the
+  // intermediate tensors in execution order, with the size of each tensor as a function of the symbolic dimensions
+  // of the graph inputs. SessionState evaluates it with the shapes of the feeds to generate the memory pattern of a
+  // Run() with new input shapes. Only computed if the plan has a single stream, and only contains the tensors whose
+  // shapes are known up to symbolic dimensions.
+  struct SymbolicMemoryPlan {
+    // where the value of a symbolic dimension is read from: the axis of a graph input
+    struct Dimension {
+      OrtValueIndex input;
+      size_t axis;
+    };
+    struct Step {
+      OrtValueIndex value;
+      bool is_free{false};
+      // for allocations: the number of elements is num_fixed_elements times the product of the symbolic dimensions
+      // at the given indices of `dimensions`
+      size_t element_size{0};
+      size_t num_fixed_elements{1};
+      InlinedVector<size_t> dimensions;
+    };
+    std::vector<Dimension> dimensions;
+    std::vector<Step> steps;
+  };
+  std::optional<SymbolicMemoryPlan> symbolic_memory_plan;
+
+  // Concat in place (kOrtSessionOptionsConfigConcatInPlace): the CPU Concat nodes whose inputs the ExecutionFrame
+  // tries to place in the output of the Concat when allocating them. These inputs are planned as kAllocate and their
+  // buffers are never reused by other values, the output of the Concat is planned as kAllocate or kAllocateOutput.
+  struct ConcatInPlace {
+    OrtValueIndex output;
+    int64_t axis;
+    // all the inputs of the Concat, in order
+    InlinedVector<OrtValueIndex> inputs;
+  };
+  std::vector<ConcatInPlace> concats_in_place;
+  // the inputs that may be placed in the output of a Concat, to the index in concats_in_place
+  InlinedHashMap<OrtValueIndex, size_t> concat_in_place_inputs;
+
+  // Lean execution (kOrtSessionOptionsConfigLeanExecution): the nodes of a plan with a single CPU stream in execution
+  // order, each with the values to release after it ran. Only computed if every step of the stream launches a kernel.
+  struct LeanProgram {
+    struct Instruction {
+      NodeIndex node_index;
+      // the values to release are released_values[release_begin, release_end)
+      size_t release_begin;
+      size_t release_end;
+    };
+    size_t stream_index{0};
+    std::vector<Instruction> instructions;
+    std::vector<OrtValueIndex> released_values;
+  };
+  std::optional<LeanProgram> lean_program;
+
+  // Host shape evaluation (kOrtSessionOptionsConfigHostShapeEvaluation): the CPU nodes of the main graph computing
+  // int64 values from the shapes of the graph inputs and constant initializers only, e.g. Shape -> Gather ->
+  // Unsqueeze -> Concat chains, in topological order. The executor evaluates them on the host before running the
+  // streams and skips their kernels, see EvaluateHostShapeProgram(). Their outputs are planned as kAllocate.
+  struct HostShapeProgram {
+    enum class Op {
+      kShape,
+      kGather,
+      kUnsqueeze,
+      kSqueeze,
+      kConcat,
+      kAdd,
+      kSub,
+      kMul,
+      kDiv,
+      kIdentity,
+    };
+    struct Instruction {
+      NodeIndex node_index;
+      Op op;
+      // Shape: the range of dimensions
+      int64_t start{0};
+      int64_t end{std::numeric_limits<int64_t>::max()};
+      // Unsqueeze/Squeeze: the axes attribute, if the axes are not an input
+      std::optional<InlinedVector<int64_t>> axes;
+    };
+    std::vector<Instruction> instructions;
+  };
+  std::optional<HostShapeProgram> host_shape_program;
+
+  // How the intermediate values of the plan get their buffers. The bytes only count the values whose shape is
+  // known when planning.
+  struct BufferReuseStats {
+    size_t num_allocated{0};       // own buffer
+    size_t num_reused{0};          // buffer of a value that is no longer used
+    size_t num_inplace_reused{0};  // buffer of an input of the node, last use of the input or alias
+    size_t allocated_bytes{0};
+    size_t reused_bytes{0};
+    size_t inplace_reused_bytes{0};
+  };
+  BufferReuseStats buffer_reuse_stats;
+
 #ifdef ENABLE_TRAINING
   InlinedVector<NodeIndex> node_execution_order_in_training;
   InlinedHashMap<NodeIndex, size_t> node_index_2_toposort_index;
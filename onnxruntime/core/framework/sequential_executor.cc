@@ -4,13 +4,17 @@
 #include "core/framework/sequential_executor.h"
 
 #include <chrono>
+#include <locale>
 #include <thread>
 #include <vector>
 #include <sstream>
 #include "core/common/common.h"
+#include "core/common/hardware_counters.h"
 #include "core/common/logging/logging.h"
 #include "core/framework/allocation_planner.h"
 #include "core/framework/execution_frame.h"
+#include "core/framework/node_flops.h"
+#include "core/framework/nvtx_ranges.h"
 #include "core/framework/stream_execution_context.h"
 #include "core/framework/session_state.h"
 #include "core/framework/op_kernel_context_internal.h"
@@ -138,6 +142,118 @@ static void CalculateTotalInputSizes(const OpKernelContextInternal* op_kernel_co
   input_type_shape = ss.str();
 }
 
+static void RecordThreadPoolTimeline(profiling::Profiler& profiler, const std::string& node_name,
+                                     const std::string& op_name,
+                                     const std::vector<concurrency::ThreadPoolTimelineEvent>& events) {
+  using Kind = concurrency::ThreadPoolTimelineEvent::Kind;
+  for (const auto& event : events) {
+    switch (event.kind) {
+      case Kind::kParallelLoop: {
+        std::ostringstream imbalance;
+        imbalance.imbue(std::locale::classic());
+        imbalance << event.imbalance;
+        profiler.RecordEvent(profiling::THREADPOOL_EVENT, node_name + "_parallel_loop", event.thread_id,
+                             event.start, event.end,
+                             {{"op_name", op_name},
+                              {"degree_of_parallelism", std::to_string(event.degree_of_parallelism)},
+                              {"block_size", std::to_string(event.block_size)},
+                              {"imbalance", imbalance.str()}});
+        break;
+      }
+      case Kind::kShard:
+        profiler.RecordEvent(profiling::THREADPOOL_EVENT, node_name + "_shard", event.thread_id, event.start,
+                             event.end, {{"op_name", op_name}, {"shard_index", std::to_string(event.shard_index)}});
+        break;
+      case Kind::kSpin:
+        profiler.RecordEvent(profiling::THREADPOOL_EVENT, "spin", event.thread_id, event.start, event.end);
+        break;
+      case Kind::kPark:
+        profiler.RecordEvent(profiling::THREADPOOL_EVENT, "park", event.thread_id, event.start, event.end);
+        break;
+    }
+  }
+}
+
+static std::string ToStringWithClassicLocale(double value) {
+  std::ostringstream os;
+  os.imbue(std::locale::classic());
+  os << value;
+  return os.str();
+}
+
+static void RecordRoofline(profiling::Profiler& profiler, OpKernelContextInternal& kernel_context,
+                           const OpKernel& kernel, const std::string& node_name, const TimePoint& start_time,
+                           const TimePoint& end_time, size_t bytes) {
+  InlinedVector<const TensorShape*> input_shapes;
+  for (int i = 0, end = kernel_context.InputCount(); i < end; ++i) {
+    const OrtValue* input = kernel_context.GetInputMLValue(i);
+    input_shapes.push_back(input != nullptr && input->IsTensor() ? &input->Get<Tensor>().Shape() : nullptr);
+  }
+  InlinedVector<const TensorShape*> output_shapes;
+  for (int i = 0, end = kernel_context.OutputCount(); i < end; ++i) {
+    const OrtValue* output = kernel_context.GetOutputMLValue(i);
+    output_shapes.push_back(output != nullptr && output->IsTensor() ? &output->Get<Tensor>().Shape() : nullptr);
+  }
+  double flops = 0;
+  if (!profiling::EstimateNodeFlops(kernel.Node(), input_shapes, output_shapes, flops)) {
+    return;
+  }
+
+  std::unordered_map<std::string, std::string> args{
+      {"op_name", kernel.KernelDef().OpName()},
+      {"flops", ToStringWithClassicLocale(flops)},
+      {"bytes", std::to_string(bytes)},
+      {"arithmetic_intensity", ToStringWithClassicLocale(bytes > 0 ? flops / static_cast<double>(bytes) : 0.0)},
+  };
+  // the kernels of other execution providers may run asynchronously, so their compute time is not known here
+  const double seconds = std::chrono::duration<double>(end_time - start_time).count();
+  if (kernel.KernelDef().Provider() == kCpuExecutionProvider && seconds > 0) {
+    const double gflops_per_second = flops / seconds / 1e9;
+    const double gbytes_per_second = static_cast<double>(bytes) / seconds / 1e9;
+    args.emplace("gflops_per_second", ToStringWithClassicLocale(gflops_per_second));
+    args.emplace("gbytes_per_second", ToStringWithClassicLocale(gbytes_per_second));
+    if (profiler.GetPeakGflops() > 0) {
+      args.emplace("peak_gflops_ratio", ToStringWithClassicLocale(gflops_per_second / profiler.GetPeakGflops()));
+    }
+    if (profiler.GetPeakGbytesPerSecond() > 0) {
+      args.emplace("peak_gbytes_per_second_ratio",
+                   ToStringWithClassicLocale(gbytes_per_second / profiler.GetPeakGbytesPerSecond()));
+    }
+  }
+  profiler.RecordEvent(profiling::NODE_EVENT, node_name + "_roofline", logging::GetThreadId(), start_time, end_time,
+                       std::move(args));
+}
+
+static bool IsMemcpyNode(const Node& node) {
+  return node.OpType() == "MemcpyFromHost" || node.OpType() == "MemcpyToHost";
+}
+
+static void RecordHardwareCounters(profiling::Profiler& profiler, const std::string& node_name,
+                                   const std::string& op_name, const TimePoint& start_time,
+                                   const TimePoint& end_time, const profiling::HardwareCounterValues& begin,
+                                   const profiling::HardwareCounterValues& end) {
+  const uint64_t cycles = end.cycles - begin.cycles;
+  const uint64_t instructions = end.instructions - begin.instructions;
+  const uint64_t llc_misses = end.llc_misses - begin.llc_misses;
+  const double seconds = std::chrono::duration<double>(end_time - start_time).count();
+
+  std::ostringstream instructions_per_cycle;
+  instructions_per_cycle.imbue(std::locale::classic());
+  instructions_per_cycle << (cycles > 0 ? static_cast<double>(instructions) / static_cast<double>(cycles) : 0.0);
+  // every miss of the last level cache reads a cache line from memory
+  const uint64_t memory_bandwidth =
+      seconds > 0 ? static_cast<uint64_t>(static_cast<double>(llc_misses * profiling::kCacheLineBytes) / seconds) : 0;
+
+  profiler.RecordEvent(profiling::NODE_EVENT, node_name + "_hardware_counters", logging::GetThreadId(), start_time,
+                       end_time,
+                       {{"op_name", op_name},
+                        {"cycles", std::to_string(cycles)},
+                        {"instructions", std::to_string(instructions)},
+                        {"instructions_per_cycle", instructions_per_cycle.str()},
+                        {"llc_misses", std::to_string(llc_misses)},
+                        {"memory_bandwidth_bytes_per_second", std::to_string(memory_bandwidth)}});
+}
+
 class KernelScope;
 
 #ifdef CONCURRENCY_VISUALIZER
@@ -179,6 +295,9 @@ class SessionScope {
     if (session_state_.Profiler().IsEnabled()) {
       session_start_ = session_state.Profiler().Start();
     }
+    if (auto* sampling_profiler = session_state_.GetSamplingProfiler()) {
+      sampled_run_ = sampling_profiler->BeginRun();
+    }
 
     auto& logger = session_state_.Logger();
     LOGS(logger, VERBOSE) << "Begin execution";
@@ -227,6 +346,9 @@ class SessionScope {
     if (session_state_.Profiler().IsEnabled()) {
       session_state_.Profiler().EndTimeAndRecordEvent(profiling::SESSION_EVENT, "SequentialExecutor::Execute", session_start_);
     }
+    if (sampled_run_ != nullptr) {
+      session_state_.GetSamplingProfiler()->EndRun(*sampled_run_);
+    }
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
     auto& logger = session_state_.Logger();
     for (auto i : frame_.GetStaticMemorySizeInfo()) {
@@ -250,6 +372,8 @@ class SessionScope {
  private:
   const SessionState& session_state_;
   TimePoint session_start_;
+  // set if the run is sampled by the sampling profiler of the session
+  profiling::SamplingProfiler::RunSlot* sampled_run_{nullptr};
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
   const ExecutionFrame& frame_;
   // Whether memory profiler need create events and flush to file.
@@ -334,6 +458,17 @@ class KernelScope {
     node_compute_range_.Begin();
 #endif
 
+    if (profiling::NvtxRanges::IsEnabled()) {
+      const auto& node = kernel_.Node();
+      profiling::NvtxRanges::Push(node.Name().empty() ? node.OpType().c_str() : node.Name().c_str(),
+                                  IsMemcpyNode(node) ? profiling::NvtxColor::kMemcpy : profiling::NvtxColor::kNode);
+      nvtx_range_pushed_ = true;
+    }
+
+    if (session_scope_.sampled_run_ != nullptr) {
+      sampled_begin_time_ = std::chrono::high_resolution_clock::now();
+    }
+
     if (session_state_.Profiler().IsEnabled()) {
       auto& node = kernel.Node();
       node_name_ = node.Name().empty() ? MakeString(node.OpType(), "_", node.Index()) : node.Name();
@@ -344,11 +479,18 @@ class KernelScope {
                                      sync_time_begin,
                                      {{"op_name", kernel_.KernelDef().OpName()}});
       concurrency::ThreadPool::StartProfiling(session_state_.GetThreadPool());
+      if (profiler.IsThreadPoolTimelineProfilingEnabled()) {
+        concurrency::ThreadPool::StartTimelineProfiling(session_state_.GetThreadPool());
+      }
       VLOGS(session_state_.Logger(), 1) << "Computing kernel: " << node_name_;
       kernel_begin_time_ = session_state_.Profiler().Start();
       CalculateTotalInputSizes(&kernel_context, &kernel_,
                                input_activation_sizes_, input_parameter_sizes_,
                                node_name_, input_type_shape_);
+      if (profiler.IsHardwareCounterProfilingEnabled()) {
+        hardware_counters_read_ = profiling::ReadThreadHardwareCounters(hardware_counters_begin_);
+      }
+      compute_begin_time_ = std::chrono::high_resolution_clock::now();
     }
   }
 
@@ -359,8 +501,21 @@ class KernelScope {
     node_compute_range_.End();
 #endif
 
+    if (nvtx_range_pushed_) {
+      profiling::NvtxRanges::Pop();
+    }
+
+    if (session_scope_.sampled_run_ != nullptr) {
+      session_state_.GetSamplingProfiler()->RecordNode(*session_scope_.sampled_run_, kernel_.Node().Index(),
+                                                       sampled_begin_time_, std::chrono::high_resolution_clock::now());
+    }
+
     if (session_state_.Profiler().IsEnabled()) {
       auto& profiler = session_state_.Profiler();
+      profiling::HardwareCounterValues hardware_counters_end;
+      const bool hardware_counters_read =
+          hardware_counters_read_ && profiling::ReadThreadHardwareCounters(hardware_counters_end);
+      const TimePoint compute_end_time = std::chrono::high_resolution_clock::now();
       std::string output_type_shape_;
       CalculateTotalOutputSizes(&kernel_context_, total_output_sizes_, node_name_, output_type_shape_);
       profiler.EndTimeAndRecordEvent(profiling::NODE_EVENT,
@@ -379,6 +534,18 @@ class KernelScope {
                                          {"thread_scheduling_stats",
                                           concurrency::ThreadPool::StopProfiling(session_state_.GetThreadPool())},
                                      });
+      if (profiler.IsThreadPoolTimelineProfilingEnabled()) {
+        RecordThreadPoolTimeline(profiler, node_name_, kernel_.KernelDef().OpName(),
+                                 concurrency::ThreadPool::StopTimelineProfiling(session_state_.GetThreadPool()));
+      }
+      if (hardware_counters_read) {
+        RecordHardwareCounters(profiler, node_name_, kernel_.KernelDef().OpName(), compute_begin_time_,
+                               compute_end_time, hardware_counters_begin_, hardware_counters_end);
+      }
+      if (profiler.IsRooflineProfilingEnabled()) {
+        RecordRoofline(profiler, kernel_context_, kernel_, node_name_, compute_begin_time_, compute_end_time,
+                       input_activation_sizes_ + input_parameter_sizes_ + total_output_sizes_);
+      }
       auto sync_time_begin = profiler.Start();
       profiler.EndTimeAndRecordEvent(profiling::NODE_EVENT,
                                      node_name_ + "_fence_after",
@@ -407,6 +574,13 @@ class KernelScope {
 
  private:
   TimePoint kernel_begin_time_;
+  TimePoint sampled_begin_time_;
+  // start of the compute of the kernel, after the profiling of its inputs
+  TimePoint compute_begin_time_;
+  // counted over the compute of the kernel only, when hardware counter profiling is enabled
+  bool hardware_counters_read_ = false;
+  profiling::HardwareCounterValues hardware_counters_begin_;
+  bool nvtx_range_pushed_ = false;
   SessionScope& session_scope_;
   const SessionState& session_state_;
   std::string node_name_;
@@ -446,6 +620,17 @@ onnxruntime::Status ExecuteKernel(StreamExecutionContext& ctx,
     ctx.RecycleNodeInputs(idx);
     return Status::OK();
   }
+  if (ctx.EarlyExited()) {
+    // the outputs of the skipped nodes are left unallocated
+    ctx.RecycleNodeInputs(idx);
+    return Status::OK();
+  }
+  if (ctx.IsEvaluatedOnHost(idx)) {
+    // the outputs were computed when the execution started, see EvaluateHostShapeProgram
+    ORT_RETURN_IF_ERROR(ctx.EvaluateEarlyExit(idx));
+    ctx.RecycleNodeInputs(idx);
+    return Status::OK();
+  }
   // TODO: set terminate flag from run_option
   OpKernelContextInternal kernel_ctx(ctx.GetSessionState(),
                                      ctx.GetExecutionFrame(),
@@ -455,6 +640,17 @@ onnxruntime::Status ExecuteKernel(StreamExecutionContext& ctx,
                                      ctx.GetDeviceStream(stream_idx));
   onnxruntime::Status status;
   auto& logger = ctx.GetLogger();
+  // attribute the memory the frame allocates and releases to the node. the stats of the frame are shared by
+  // the streams, so the attribution is approximate if nodes run concurrently.
+  auto& frame = ctx.GetExecutionFrame();
+  auto& profiler = ctx.GetSessionState().Profiler();
+  const bool profile_memory = frame.IsMemoryProfilingEnabled() && profiler.IsEnabled();
+  ExecutionFrame::MemoryStats memory_before;
+  TimePoint memory_begin_time;
+  if (profile_memory) {
+    memory_before = frame.GetMemoryStats();
+    memory_begin_time = profiler.Start();
+  }
   if (p_kernel->IsAsync()) {
     ORT_THROW("Async Kernel Support is not implemented yet.");
   } else {
@@ -514,11 +710,95 @@ onnxruntime::Status ExecuteKernel(StreamExecutionContext& ctx,
     LOGS(logger, ERROR) << msg_string;
     return Status(status.Category(), status.Code(), msg_string);
   }
+  ExecutionFrame::MemoryStats memory_after_compute;
+  if (profile_memory) {
+    memory_after_compute = frame.GetMemoryStats();
+    profiler.RecordCounterEvent("live_memory", {{"live_bytes", static_cast<int64_t>(memory_after_compute.live_bytes)}});
+  }
+  ORT_RETURN_IF_ERROR(ctx.EvaluateEarlyExit(idx));
   ctx.RecycleNodeInputs(idx);
+  if (profile_memory) {
+    const auto memory_after_release = frame.GetMemoryStats();
+    profiler.RecordCounterEvent("live_memory", {{"live_bytes", static_cast<int64_t>(memory_after_release.live_bytes)}});
+    const auto& node = p_kernel->Node();
+    const std::string node_name = node.Name().empty() ? MakeString(node.OpType(), "_", node.Index()) : node.Name();
+    profiler.EndTimeAndRecordEvent(
+        profiling::NODE_EVENT,
+        node_name + "_memory",
+        memory_begin_time,
+        {
+            {"op_name", p_kernel->KernelDef().OpName()},
+            {"node_index", std::to_string(node.Index())},
+            {"allocated_bytes", std::to_string(memory_after_compute.allocated_bytes - memory_before.allocated_bytes)},
+            {"freed_bytes", std::to_string(memory_after_release.freed_bytes - memory_after_compute.freed_bytes)},
+            {"live_bytes", std::to_string(memory_after_compute.live_bytes)},
+            {"peak_live_bytes", std::to_string(memory_after_compute.peak_live_bytes)},
+            {"raises_peak", memory_after_compute.peak_live_bytes > memory_before.peak_live_bytes ? "1" : "0"},
+        });
+  }
   LOGS(logger, VERBOSE) << "stream " << stream_idx << " launch kernel with idx " << idx;
   return Status::OK();
 }
 
+// Builds whose KernelScope traces every node do not run the lean program.
+#if defined(DEBUG_NODE_INPUTS_OUTPUTS) || defined(ENABLE_NVTX_PROFILE) || defined(CONCURRENCY_VISUALIZER) || \
+    defined(ONNXRUNTIME_ENABLE_INSTRUMENT)
+constexpr bool kLeanProgramSupported = false;
+#else
+constexpr bool kLeanProgramSupported = true;
+#endif
+
+// Runs the nodes of SequentialExecutionPlan::lean_program one after the other on the calling thread, see
+// kOrtSessionOptionsConfigLeanExecution.
+static Status RunLeanProgram(StreamExecutionContext& ctx, const bool& terminate_flag) {
+  const auto& session_state = ctx.GetSessionState();
+  const auto& program = *session_state.GetExecutionPlan()->lean_program;
+  auto& frame = ctx.GetExecutionFrame();
+  const auto& logger = ctx.GetLogger();
+  Stream* stream = ctx.GetDeviceStream(program.stream_index);
+  for (const auto& instruction : program.instructions) {
+    if (terminate_flag) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Exiting due to terminate flag being set to true.");
+    }
+    if (ctx.IsEvaluatedOnHost(instruction.node_index)) {
+      ORT_RETURN_IF_ERROR(ctx.EvaluateEarlyExit(instruction.node_index));
+      for (size_t i = instruction.release_begin; i < instruction.release_end; ++i) {
+        ORT_RETURN_IF_ERROR(frame.ReleaseMLValue(program.released_values[i]));
+      }
+      if (ctx.EarlyExited()) {
+        break;
+      }
+      continue;
+    }
+    const OpKernel& kernel = *session_state.GetKernel(instruction.node_index);
+    OpKernelContextInternal kernel_ctx(session_state, frame, kernel, logger, terminate_flag, stream);
+    Status status;
+    ORT_TRY {
+      status = kernel.Compute(&kernel_ctx);
+    }
+    ORT_CATCH(const std::exception& ex) {
+      ORT_HANDLE_EXCEPTION([&]() {
+        status = ORT_MAKE_STATUS(ONNXRUNTIME, RUNTIME_EXCEPTION, ex.what());
+      });
+    }
+    if (!status.IsOK()) {
+      const auto& node = kernel.Node();
+      const auto msg_string = MakeString("Non-zero status code returned while running ", node.OpType(),
+                                         " node. Name:'", node.Name(), "' Status Message: ", status.ErrorMessage());
+      LOGS(logger, ERROR) << msg_string;
+      return Status(status.Category(), status.Code(), msg_string);
+    }
+    ORT_RETURN_IF_ERROR(ctx.EvaluateEarlyExit(instruction.node_index));
+    for (size_t i = instruction.release_begin; i < instruction.release_end; ++i) {
+      ORT_RETURN_IF_ERROR(frame.ReleaseMLValue(program.released_values[i]));
+    }
+    if (ctx.EarlyExited()) {
+      break;
+    }
+  }
+  return Status::OK();
+}
+
 onnxruntime::Status ExecuteThePlan(const SessionState& session_state, gsl::span<const int> feed_mlvalue_idxs,
                                    gsl::span<const OrtValue> feeds, gsl::span<const int> fetch_mlvalue_idxs,
                                    std::vector<OrtValue>& fetches,
@@ -529,7 +809,8 @@ onnxruntime::Status ExecuteThePlan(const SessionState& session_state, gsl::span<
 #endif
                                    const bool& terminate_flag,
                                    const bool only_execute_path_to_fetches,
-                                   bool single_thread_mode) {
+                                   bool single_thread_mode,
+                                   int early_exit_value_idx) {
   auto* execution_plan = session_state.GetExecutionPlan();
   LOGS(logger, VERBOSE) << "Number of streams: " << execution_plan->execution_plan.size();
   int32_t valid_streams = 0;
@@ -538,10 +819,23 @@ onnxruntime::Status ExecuteThePlan(const SessionState& session_state, gsl::span<
       valid_streams++;
   }
 
+  auto* tp = single_thread_mode ? nullptr : session_state.GetInterOpThreadPool();
+  // run the ready nodes instead of the streams, when the plan supports it and there are threads to run them on
+  const bool dynamic_scheduling = execution_plan->dynamic_scheduling && tp != nullptr &&
+                                  !only_execute_path_to_fetches;
+  // run the nodes in a loop on this thread, when no per node profiling or tracing is needed
+  const bool lean_execution = kLeanProgramSupported && execution_plan->lean_program.has_value() &&
+                              !dynamic_scheduling && !only_execute_path_to_fetches &&
+                              !session_state.Profiler().IsEnabled() && session_state.GetSamplingProfiler() == nullptr &&
+                              !profiling::NvtxRanges::IsEnabled();
+  const int32_t num_tasks = lean_execution       ? 0
+                            : dynamic_scheduling ? static_cast<int32_t>(execution_plan->dynamic_schedule_roots.size())
+                                                 : valid_streams;
+
   // prepare the execution context, notifications got initialized.
 #ifdef ORT_ENABLE_STREAM
   StreamExecutionContext ctx(session_state,
-                             valid_streams,
+                             num_tasks,
                              execution_plan->notification_owners,
                              execution_plan->num_barriers,
                              device_streams,
@@ -554,7 +848,7 @@ onnxruntime::Status ExecuteThePlan(const SessionState& session_state, gsl::span<
                              single_thread_mode);
 #else
   StreamExecutionContext ctx(session_state,
-                             valid_streams,
+                             num_tasks,
                              feed_mlvalue_idxs,
                              feeds,
                              fetch_mlvalue_idxs,
@@ -572,27 +866,45 @@ onnxruntime::Status ExecuteThePlan(const SessionState& session_state, gsl::span<
   ORT_UNUSED_PARAMETER(only_execute_path_to_fetches);
 #endif
 
+  if (early_exit_value_idx >= 0) {
+    ORT_RETURN_IF_ERROR(ctx.SetEarlyExitValue(early_exit_value_idx));
+  }
+
   SessionScope session_scope(session_state, ctx.GetExecutionFrame());
 
-  auto* tp = single_thread_mode ? nullptr : session_state.GetInterOpThreadPool();
+  if (execution_plan->host_shape_program.has_value()) {
+    ORT_RETURN_IF_ERROR(ctx.EvaluateHostShapeProgram());
+  }
 
-  for (size_t i = 0; i < execution_plan->execution_plan.size(); ++i) {
-    if (execution_plan->execution_plan[i]->steps_.empty()) {
-      // execution context is initialized with number of valid streams
-      // for invalid stream (0 steps), it doesn't count in number of tasks
-      // so don't need to invoke CompleteTask here
-      // ctx.CompleteTask();
-    } else {
-      concurrency::ThreadPool::Schedule(tp, [i, &ctx, &terminate_flag, &session_scope]() {
-        RunSince(i, ctx, session_scope, terminate_flag, 0);
+  if (lean_execution) {
+    ORT_RETURN_IF_ERROR(RunLeanProgram(ctx, terminate_flag));
+  } else if (dynamic_scheduling) {
+    ctx.EnableDynamicScheduling();
+    for (auto node_index : execution_plan->dynamic_schedule_roots) {
+      concurrency::ThreadPool::Schedule(tp, [node_index, &ctx, &terminate_flag, &session_scope]() {
+        RunNode(node_index, ctx, session_scope, terminate_flag);
       });
     }
+  } else {
+    for (size_t i = 0; i < execution_plan->execution_plan.size(); ++i) {
+      if (execution_plan->execution_plan[i]->steps_.empty()) {
+        // execution context is initialized with number of valid streams
+        // for invalid stream (0 steps), it doesn't count in number of tasks
+        // so don't need to invoke CompleteTask here
+        // ctx.CompleteTask();
+      } else {
+        concurrency::ThreadPool::Schedule(tp, [i, &ctx, &terminate_flag, &session_scope]() {
+          RunSince(i, ctx, session_scope, terminate_flag, 0);
+        });
+      }
+    }
   }
 
   ctx.WaitAll();
   ORT_RETURN_IF_ERROR(ctx.TaskStatus());
   ORT_RETURN_IF_ERROR(ctx.GetExecutionFrame().GetOutputs(fetches));
-  if (ctx.GetExecutionFrame().HasMemoryPatternPlanner()) {
+  // the allocations of a run that exited early are not those of a complete run
+  if (ctx.GetExecutionFrame().HasMemoryPatternPlanner() && !ctx.EarlyExited()) {
     bool all_tensors = true;
     for (const auto& feed : feeds) {
       if (!(feed.IsTensor())) {
@@ -3,17 +3,21 @@
 
 #include "core/framework/session_state.h"
 
+#include <algorithm>
 #include <sstream>
 
 #include "core/platform/ort_mutex.h"
 #include "core/common/logging/logging.h"
+#include "core/common/parse_string.h"
 #include "core/common/safeint.h"
 #include "core/flatbuffers/schema/ort.fbs.h"
 #include "core/framework/allocator.h"
 #include "core/framework/node_index_info.h"
+#include "core/framework/memory_pattern_cache.h"
 #include "core/framework/op_kernel.h"
 #include "core/framework/ort_value_pattern_planner.h"
 #include "core/framework/session_state_utils.h"
+#include "core/framework/tensorprotoutils.h"
 #include "core/framework/utils.h"
 #include "core/providers/cpu/controlflow/utils.h"
 #include "core/session/onnxruntime_session_options_config_keys.h"
@@ -70,7 +74,8 @@ SessionState::SessionState(Graph& graph,
                            profiling::Profiler& profiler,
                            const SessionOptions& sess_options,
                            PrepackedWeightsContainer* prepacked_weights_container,
-                           AllocatorMap* parent_allocators)
+                           AllocatorMap* parent_allocators,
+                           SharedInitializerStore* shared_initializer_store)
     : graph_(graph),
       execution_providers_(execution_providers),
       logger_(logger),
@@ -79,7 +84,8 @@ SessionState::SessionState(Graph& graph,
       inter_op_thread_pool_(inter_op_thread_pool),
       data_transfer_mgr_(data_transfer_mgr),
       sess_options_(sess_options),
-      prepacked_weights_container_(prepacked_weights_container)
+      prepacked_weights_container_(prepacked_weights_container),
+      shared_initializer_store_(shared_initializer_store)
 #ifdef ORT_ENABLE_STREAM
       ,
       stream_handles_registry_(std::make_unique<StreamCommandHandleRegistryImpl>())
@@ -87,6 +93,8 @@ SessionState::SessionState(Graph& graph,
 {
   enable_mem_pattern_ = sess_options_.enable_mem_pattern &&
                         sess_options_.execution_mode == ExecutionMode::ORT_SEQUENTIAL;
+  mem_patterns_.SetCapacity(ParseStringWithClassicLocale<size_t>(
+      sess_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigMemoryPatternCacheCapacity, "0")));
   if (parent_allocators) {
     allocators_ = parent_allocators;
   } else {
@@ -222,7 +230,8 @@ Status SessionState::CreateKernels(const KernelRegistryManager& kernel_registry_
     }
     session_kernels_.clear();
     session_kernels_.resize(max_nodeid + 1);
-    for (const auto& node : nodes) {
+
+    auto create_kernel = [this, &kernel_registry_manager](const Node& node) -> Status {
       // construct and save the kernels
       const KernelCreateInfo& kci = GetNodeKernelCreateInfo(node.Index());
 
@@ -231,8 +240,25 @@ Status SessionState::CreateKernels(const KernelRegistryManager& kernel_registry_
       const IExecutionProvider& exec_provider = *execution_providers_.Get(exec_provider_name);
 
       // assumes vector is already resize()'ed to the number of nodes in the graph
-      ORT_RETURN_IF_ERROR(kernel_registry_manager.CreateKernel(node, exec_provider, *this, kci, session_kernels_[node.Index()]));
+      return kernel_registry_manager.CreateKernel(node, exec_provider, *this, kci, session_kernels_[node.Index()]);
+    };
+
+    // kernels of other execution providers may use device state that is not safe to set up concurrently
+    InlinedVector<const Node*> cpu_nodes;
+    for (const auto& node : nodes) {
+      if (parallel_initialization_ && thread_pool_ != nullptr &&
+          node.GetExecutionProviderType() == kCpuExecutionProvider) {
+        cpu_nodes.push_back(&node);
+      } else {
+        ORT_RETURN_IF_ERROR(create_kernel(node));
+      }
     }
+
+    // every kernel is stored in its own slot of session_kernels_
+    ORT_RETURN_IF_ERROR(session_state_utils::ParallelForEach(
+        thread_pool_, cpu_nodes.size(), [&cpu_nodes, &create_kernel](size_t i) {
+          return create_kernel(*cpu_nodes[i]);
+        }));
   }
   node_index_info_.emplace(*graph_viewer_, ort_value_name_idx_map_);
   return Status::OK();
@@ -308,12 +334,148 @@ Status SessionState::AddInitializedTensor(int ort_value_index, const OrtValue& o
   return Status::OK();
 }
 
+Status SessionState::ShareInitializerByContent(const std::basic_string<PATH_CHAR_TYPE>& graph_location,
+                                               const std::string& name, const OrtValue& value,
+                                               OrtValue& shared_value) {
+  if (!value.IsTensor()) {
+    return Status::OK();
+  }
+
+  // a tensor that does not own its buffer is either in a weights buffer of this session or a view over mapped
+  // external data, which is already shared through the page cache
+  const Tensor& tensor = value.Get<Tensor>();
+  const ONNX_NAMESPACE::TensorProto* tensor_proto = nullptr;
+  if (!tensor.OwnsBuffer() || tensor.IsDataTypeString() || !graph_.GetInitializedTensor(name, tensor_proto)) {
+    return Status::OK();
+  }
+
+  std::string key;
+  ORT_RETURN_IF_ERROR(SharedInitializerStore::ComputeKey(Env::Default(), graph_location.c_str(), *tensor_proto,
+                                                         tensor.Location().device, key));
+  return shared_initializer_store_->GetOrAdd(key, value, data_transfer_mgr_, shared_value);
+}
+
 const std::unordered_map<int, OrtValue>& SessionState::GetInitializedTensors() const { return initialized_tensors_; }
 
 const std::unordered_map<int, OrtValue>& SessionState::GetConstantInitializedTensors() const {
   return constant_initialized_tensors_;
 }
 
+Status SessionState::UpdateConstantInitializers(const KernelRegistryManager& kernel_registry_manager,
+                                                gsl::span<const std::string> names,
+                                                gsl::span<const OrtValue> values) {
+  ORT_RETURN_IF_NOT(names.size() == values.size(), "Expected a value for each of the ", names.size(),
+                    " initializers, got ", values.size());
+
+  // copy the new values to the devices of the initializers they replace
+  InlinedHashMap<int, OrtValue> new_values;
+  InlinedHashSet<std::string> updated_names;
+  for (size_t i = 0; i < names.size(); ++i) {
+    int ort_value_idx;
+    ORT_RETURN_IF_NOT(ort_value_name_idx_map_.GetIdx(names[i], ort_value_idx).IsOK() &&
+                          constant_initialized_tensors_.count(ort_value_idx) != 0,
+                      "'", names[i], "' is not a constant initializer of the session. It may have been removed by ",
+                      "graph optimizations, or released once all of its consumers pre-packed it.");
+    ORT_RETURN_IF_NOT(values[i].IsTensor(), "The value of '", names[i], "' is not a tensor.");
+
+    const Tensor& current = constant_initialized_tensors_[ort_value_idx].Get<Tensor>();
+    const Tensor& value = values[i].Get<Tensor>();
+    ORT_RETURN_IF(current.IsDataTypeString(), "String initializer '", names[i], "' can not be updated.");
+    ORT_RETURN_IF_NOT(value.DataType() == current.DataType() && value.Shape() == current.Shape(),
+                      "The value of '", names[i], "' must have the type ", DataTypeImpl::ToString(current.DataType()),
+                      " and the shape ", current.Shape(), " of the initializer.");
+
+    AllocatorPtr allocator = GetAllocator(current.Location().device);
+    ORT_RETURN_IF_NOT(allocator, "No allocator for the device of initializer '", names[i], "'.");
+    OrtValue& new_value = new_values[ort_value_idx];
+    Tensor::InitOrtValue(current.DataType(), current.Shape(), std::move(allocator), new_value);
+    ORT_RETURN_IF_ERROR(data_transfer_mgr_.CopyTensor(value, *new_value.GetMutable<Tensor>()));
+    updated_names.insert(names[i]);
+  }
+
+  // find the nodes consuming the initializers, whose kernels are created again
+  InlinedVector<const Node*> consumers;
+  for (const auto& node : graph_viewer_->Nodes()) {
+    for (const auto* input_def : node.ImplicitInputDefs()) {
+      ORT_RETURN_IF(updated_names.count(input_def->Name()) != 0, "'", input_def->Name(),
+                    "' can not be updated as it is used by a subgraph of node '", node.Name(), "'.");
+    }
+
+    const auto& input_defs = node.InputDefs();
+    if (std::none_of(input_defs.begin(), input_defs.end(), [&updated_names](const NodeArg* input_def) {
+          return input_def->Exists() && updated_names.count(input_def->Name()) != 0;
+        })) {
+      continue;
+    }
+
+    ORT_RETURN_IF(node.NodeType() == Node::Type::Fused, "The initializers consumed by node '", node.Name(),
+                  "' can not be updated as they are compiled into it by its execution provider.");
+    InlinedVector<std::string> removable_attributes;
+    ORT_RETURN_IF_ERROR(GetKernel(node.Index())->GetRemovableAttributes(removable_attributes));
+    ORT_RETURN_IF_NOT(removable_attributes.empty(), "The kernel of node '", node.Name(),
+                      "' can not be created again as attributes it needs were removed from the node.");
+
+    // the new kernel reads the initializers it consumes, which must not have been released after pre-packing
+    const auto& graph_inputs = graph_viewer_->GetInputsIncludingInitializers();
+    for (const auto* input_def : input_defs) {
+      int ort_value_idx;
+      ORT_RETURN_IF(input_def->Exists() && ort_value_name_idx_map_.GetIdx(input_def->Name(), ort_value_idx).IsOK() &&
+                        initialized_tensors_.count(ort_value_idx) == 0 &&
+                        graph_viewer_->GetProducerNode(input_def->Name()) == nullptr &&
+                        std::find(graph_inputs.begin(), graph_inputs.end(), input_def) == graph_inputs.end(),
+                    "The initializers consumed by node '", node.Name(), "' can not be updated as its initializer '",
+                    input_def->Name(), "' was released once pre-packed.");
+    }
+    consumers.push_back(&node);
+  }
+
+  // the new kernels see the new values when they are created and pre-packed
+  InlinedHashMap<int, OrtValue> old_values;
+  for (auto& entry : new_values) {
+    old_values.emplace(entry.first, constant_initialized_tensors_[entry.first]);
+    initialized_tensors_[entry.first] = entry.second;
+    constant_initialized_tensors_[entry.first] = std::move(entry.second);
+  }
+
+  const bool disable_prepacking =
+      sess_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigDisablePrepacking, "0") == "1";
+  std::vector<std::unique_ptr<OpKernel>> new_kernels(consumers.size());
+  Status status;
+  for (size_t i = 0; i < consumers.size() && status.IsOK(); ++i) {
+    const Node& node = *consumers[i];
+    const IExecutionProvider& exec_provider = *execution_providers_.Get(node.GetExecutionProviderType());
+    status = kernel_registry_manager.CreateKernel(node, exec_provider, *this, GetNodeKernelCreateInfo(node.Index()),
+                                                  new_kernels[i]);
+    for (size_t input_idx = 0; input_idx < node.InputDefs().size() && status.IsOK() && !disable_prepacking;
+         ++input_idx) {
+      int ort_value_idx;
+      if (!node.InputDefs()[input_idx]->Exists() ||
+          !ort_value_name_idx_map_.GetIdx(node.InputDefs()[input_idx]->Name(), ort_value_idx).IsOK() ||
+          constant_initialized_tensors_.count(ort_value_idx) == 0 ||
+          mapped_external_initializers_.count(ort_value_idx) != 0) {
+        continue;
+      }
+      bool is_packed = false;
+      AllocatorPtr session_alloc = GetAllocator(new_kernels[i]->Info().GetDevice(OrtMemType::OrtMemTypeDefault));
+      status = new_kernels[i]->PrePack(constant_initialized_tensors_[ort_value_idx].Get<Tensor>(),
+                                       static_cast<int>(input_idx), session_alloc, is_packed, nullptr);
+    }
+  }
+
+  if (!status.IsOK()) {
+    for (auto& entry : old_values) {
+      initialized_tensors_[entry.first] = entry.second;
+      constant_initialized_tensors_[entry.first] = std::move(entry.second);
+    }
+    return status;
+  }
+
+  for (size_t i = 0; i < consumers.size(); ++i) {
+    session_kernels_[consumers[i]->Index()] = std::move(new_kernels[i]);
+  }
+  return Status::OK();
+}
+
 #if !defined(DISABLE_SPARSE_TENSORS)
 bool SessionState::IsSparseInitializer(int ort_value_index) const {
   return sparse_initialized_tensors_.count(ort_value_index) > 0;
@@ -412,7 +574,10 @@ Status SessionState::PrepackConstantInitializedTensors(InlinedHashMap<std::strin
             if (st->GetOrtValueNameIdxMap().GetIdx(input_name, ort_value_idx).IsOK()) {
               std::unordered_map<int, OrtValue>& constant_initialized_tensors = st->constant_initialized_tensors_;
 
-              if (constant_initialized_tensors.count(ort_value_idx)) {
+              // initializers kept as views over a mapped file are shared across processes; packing them would
+              // replace that with a private copy
+              if (constant_initialized_tensors.count(ort_value_idx) &&
+                  st->mapped_external_initializers_.count(ort_value_idx) == 0) {
                 bool is_packed = false;
                 const Tensor& const_initialized_tensor = constant_initialized_tensors[ort_value_idx].Get<Tensor>();
 
@@ -476,6 +641,10 @@ Status SessionState::PrepackConstantInitializedTensors(InlinedHashMap<std::strin
                     }
                   }
 
+                } else if (prepacked_weights_disk_cache_ != nullptr &&
+                           node.GetExecutionProviderType() == kCpuExecutionProvider) {
+                  ORT_RETURN_IF_ERROR(PrepackWithDiskCache(*kernel, node, input_idx, const_initialized_tensor,
+                                                           is_packed));
                 } else {  // caching of pre-packed weights' turned OFF
                   AllocatorPtr session_cpu_alloc = GetAllocator(kernel->Info().GetDevice(OrtMemType::OrtMemTypeDefault));
                   ORT_RETURN_IF_ERROR(kernel->PrePack(const_initialized_tensor, input_idx,
@@ -513,6 +682,11 @@ Status SessionState::PrepackConstantInitializedTensors(InlinedHashMap<std::strin
 
   bool should_cache_prepacked_weights_for_shared_initializers = (prepacked_weights_container_ != nullptr);
 
+  if (parallel_initialization_ && thread_pool_ != nullptr && !should_cache_prepacked_weights_for_shared_initializers &&
+      prepacked_weights_disk_cache_ == nullptr) {
+    return ParallelPrepackConstantInitializedTensors(constant_initializers_use_count);
+  }
+
   if (should_cache_prepacked_weights_for_shared_initializers) {
     // serialize calls to the method that looks up the container, calls UseCachedPrePackedWeight/PrePack
     // and writes pre-packed weights to the container
@@ -523,12 +697,154 @@ Status SessionState::PrepackConstantInitializedTensors(InlinedHashMap<std::strin
   }
 }
 
-static int64_t CalculateMemoryPatternsKey(const gsl::span<const OrtValue>& tensor_inputs) {
-  int64_t key = 0;
-  for (const auto& input : tensor_inputs) {
-    for (auto dim : input.Get<Tensor>().Shape().GetDims()) key ^= dim;
+Status SessionState::ParallelPrepackConstantInitializedTensors(
+    InlinedHashMap<std::string, size_t>& constant_initializers_use_count) {
+  struct PrepackInput {
+    int input_idx;
+    const std::string* input_name;
+    SessionState* st;
+    int ort_value_idx;
+    bool is_packed;
+  };
+
+  struct NodePrepackInputs {
+    const Node* node;
+    OpKernel* kernel;
+    InlinedVector<PrepackInput> inputs;
+  };
+
+  // find the constant initialized tensors to pre-pack first, the same way PrepackConstantInitializedTensors does.
+  // the inputs of a kernel are pre-packed by the same thread as a kernel is not expected to support concurrent
+  // PrePack() calls.
+  std::vector<NodePrepackInputs> cpu_nodes;
+  std::vector<NodePrepackInputs> other_nodes;
+  for (auto& node : GetGraphViewer().Nodes()) {
+    NodePrepackInputs node_inputs{&node, GetMutableKernel(node.Index()), {}};
+    int input_idx = 0;
+    for (auto& input_def : node.InputDefs()) {
+      if (input_def->Exists()) {
+        const std::string& input_name = input_def->Name();
+        SessionState* st = this;
+        do {
+          int ort_value_idx;
+          if (st->GetOrtValueNameIdxMap().GetIdx(input_name, ort_value_idx).IsOK()) {
+            if (st->constant_initialized_tensors_.count(ort_value_idx) &&
+                st->mapped_external_initializers_.count(ort_value_idx) == 0) {
+              node_inputs.inputs.push_back({input_idx, &input_name, st, ort_value_idx, false});
+            }
+            if (st != this || !st->graph_.IsOuterScopeValue(input_name)) {
+              break;
+            }
+          }
+          st = st->Parent();
+        } while (st);
+      }
+      input_idx++;
+    }
+
+    if (!node_inputs.inputs.empty()) {
+      auto& target = node.GetExecutionProviderType() == kCpuExecutionProvider ? cpu_nodes : other_nodes;
+      target.push_back(std::move(node_inputs));
+    }
   }
-  return key;
+
+  // the constant initialized tensors are only read until all kernels are pre-packed
+  auto prepack_node = [this](NodePrepackInputs& node_inputs) -> Status {
+    OpKernel& kernel = *node_inputs.kernel;
+    AllocatorPtr session_cpu_alloc = GetAllocator(kernel.Info().GetDevice(OrtMemType::OrtMemTypeDefault));
+    for (auto& input : node_inputs.inputs) {
+      const Tensor& const_initialized_tensor =
+          input.st->constant_initialized_tensors_.at(input.ort_value_idx).Get<Tensor>();
+      ORT_RETURN_IF_ERROR(kernel.PrePack(const_initialized_tensor, input.input_idx, session_cpu_alloc,
+                                         input.is_packed, nullptr));
+    }
+    return Status::OK();
+  };
+
+  for (auto& node_inputs : other_nodes) {
+    ORT_RETURN_IF_ERROR(prepack_node(node_inputs));
+  }
+  ORT_RETURN_IF_ERROR(session_state_utils::ParallelForEach(thread_pool_, cpu_nodes.size(),
+                                                           [&cpu_nodes, &prepack_node](size_t i) {
+                                                             return prepack_node(cpu_nodes[i]);
+                                                           }));
+
+  for (auto* nodes : {&other_nodes, &cpu_nodes}) {
+    for (const auto& node_inputs : *nodes) {
+      for (const auto& input : node_inputs.inputs) {
+        if (input.is_packed) {
+          ++number_of_prepacks_counter_;
+
+          const std::string& input_name = *input.input_name;
+          if (constant_initializers_use_count.count(input_name) && --constant_initializers_use_count[input_name] == 0) {
+            // release the constant initialized tensor
+            input.st->initialized_tensors_.erase(input.ort_value_idx);
+            input.st->constant_initialized_tensors_.erase(input.ort_value_idx);
+          }
+        }
+      }
+    }
+  }
+
+  return Status::OK();
+}
+
+static Status KernelUsePersistedPrePackedBuffers(OpKernel& kernel, int input_idx, const Tensor& tensor,
+                                                 const PrePackedWeights& prepacked_weights,
+                                                 /*out*/ bool& used_prepacked_buffers) {
+  std::vector<BufferUniquePtr> prepacked_buffers;
+  prepacked_buffers.reserve(prepacked_weights.buffers_.size());
+
+  for (const auto& prepacked_buffer : prepacked_weights.buffers_) {
+    // the buffers are owned by the disk cache
+    prepacked_buffers.emplace_back(prepacked_buffer.get(), BufferDeleter(nullptr));
+  }
+
+  return kernel.UsePersistedPrePackedBuffers(tensor, input_idx, prepacked_buffers, prepacked_weights.buffer_sizes_,
+                                             used_prepacked_buffers);
+}
+
+Status SessionState::PrepackWithDiskCache(OpKernel& kernel, const Node& node, int input_idx, const Tensor& tensor,
+                                          /*out*/ bool& is_packed) {
+  const std::string key = PrepackedWeightsDiskCache::GenerateKey(node, input_idx, tensor,
+                                                                 sess_options_.config_options);
+
+  const PrePackedWeights* persisted_weights = prepacked_weights_disk_cache_->Load(key);
+  if (persisted_weights != nullptr) {
+    ORT_RETURN_IF_ERROR(KernelUsePersistedPrePackedBuffers(kernel, input_idx, tensor, *persisted_weights, is_packed));
+    if (is_packed) {
+      LOGS(logger_, INFO) << "Using persisted pre-packed weight for input " << input_idx
+                          << " of the node: " << node.Name() << " which is of op type: " << node.OpType();
+      ++used_persisted_pre_packed_weights_counter_;
+      return Status::OK();
+    }
+  }
+
+  PrePackedWeights weights;
+  ORT_RETURN_IF_ERROR(kernel.PrePack(tensor, input_idx, GetAllocator(kernel.Info().GetDevice(OrtMemTypeDefault)),
+                                     is_packed, &weights));
+  if (!is_packed || weights.buffers_.empty()) {
+    // the kernel keeps its pre-packed state itself, there is nothing to persist
+    return Status::OK();
+  }
+
+  const PrePackedWeights& packed_weights = prepacked_weights_disk_cache_->Add(std::move(weights));
+
+  // Hand the buffers over the same way a later session would. Kernels that can not restore from them only get
+  // them as shared buffers, and they are not persisted.
+  bool persistable = false;
+  ORT_RETURN_IF_ERROR(KernelUsePersistedPrePackedBuffers(kernel, input_idx, tensor, packed_weights, persistable));
+  if (!persistable) {
+    return KernelUseSharedPrePackedBuffers(kernel, input_idx, packed_weights, node.Name());
+  }
+
+  auto status = prepacked_weights_disk_cache_->Write(key, packed_weights);
+  if (!status.IsOK()) {
+    LOGS(logger_, WARNING) << "Failed to persist the pre-packed weight for input " << input_idx
+                           << " of the node: " << node.Name() << ". " << status.ErrorMessage();
+  }
+
+  return Status::OK();
 }
 
 #ifdef ENABLE_TRAINING
@@ -765,38 +1081,93 @@ Status SessionState::GeneratePatternGroupCache(gsl::span<const OrtValue> tensor_
 
 #endif
 
-// MemoryPatternGroup pointer is cached. It only inserted upon creation
+Status SessionState::GeneratePatternGroupFromSymbolicPlan(gsl::span<const OrtValue> tensor_inputs,
+                                                          gsl::span<const int> feed_mlvalue_idxs,
+                                                          MemoryPatternGroup& output) const {
+  const auto& symbolic_plan = *p_seq_exec_plan_->symbolic_memory_plan;
+
+  // -1 for the dimensions of graph inputs that are not fed
+  InlinedVector<int64_t> dimensions;
+  dimensions.reserve(symbolic_plan.dimensions.size());
+  for (const auto& dimension : symbolic_plan.dimensions) {
+    int64_t value = -1;
+    for (size_t i = 0, end = feed_mlvalue_idxs.size(); i < end; ++i) {
+      if (feed_mlvalue_idxs[i] == dimension.input) {
+        const auto& shape = tensor_inputs[i].Get<Tensor>().Shape();
+        if (dimension.axis < shape.NumDimensions()) {
+          value = shape[dimension.axis];
+        }
+        break;
+      }
+    }
+    dimensions.push_back(value);
+  }
+
+  // A tensor whose size is not as planned, e.g. because inputs sharing a symbolic dimension were fed with different
+  // values, is allocated individually by the execution frame, which only uses a block of the same size.
+  OrtValuePatternPlanner mem_planner(*p_seq_exec_plan_);
+  for (const auto& step : symbolic_plan.steps) {
+    if (step.is_free) {
+      ORT_RETURN_IF_ERROR(mem_planner.TraceFree(step.value));
+      continue;
+    }
+
+    SafeInt<size_t> num_elements = step.num_fixed_elements;
+    bool is_resolved = true;
+    for (size_t dimension : step.dimensions) {
+      if (dimensions[dimension] < 0) {
+        is_resolved = false;
+        break;
+      }
+      num_elements *= dimensions[dimension];
+    }
+    if (!is_resolved) {
+      continue;
+    }
+
+    size_t size = 0;
+    if (!IAllocator::CalcMemSizeForArrayWithAlignment<kAllocAlignment>(num_elements, step.element_size, &size)) {
+      return Status(ONNXRUNTIME, FAIL, "Size overflow");
+    }
+    ORT_RETURN_IF_ERROR(mem_planner.TraceAllocation(step.value, size));
+  }
+
+  return mem_planner.GeneratePatterns(output);
+}
+
+// MemoryPatternGroup is shared with the execution frames using it. It is only inserted upon creation
 // and is not updated if already present.
-const MemoryPatternGroup* SessionState::GetMemoryPatternGroup(
+std::shared_ptr<const MemoryPatternGroup> SessionState::GetMemoryPatternGroup(
     gsl::span<const OrtValue> tensor_inputs,
     gsl::span<const int> feed_mlvalue_idxs,
-    const InlinedHashMap<int, TensorShape>*& out_inferred_shapes) const {
+    std::shared_ptr<const InlinedHashMap<int, TensorShape>>& out_inferred_shapes) const {
   out_inferred_shapes = nullptr;
-  int64_t key = CalculateMemoryPatternsKey(tensor_inputs);
+  const std::string key = MemoryPatternCache::MakeKey(tensor_inputs);
   std::lock_guard<OrtMutex> lock(mem_patterns_lock_);
-  auto it = mem_patterns_.find(key);
-  if (it == mem_patterns_.end()) {
+  const MemoryPatternCache::Entry* entry = mem_patterns_.Find(key);
+  if (entry == nullptr) {
 #ifdef ENABLE_TRAINING
     MemoryPatternGroup mem_patterns;
     InlinedHashMap<int, TensorShape> inferred_shapes;
     if (GeneratePatternGroupCache(tensor_inputs, feed_mlvalue_idxs, mem_patterns, inferred_shapes).IsOK()) {
-      auto patt_insert = mem_patterns_.insert_or_assign(key, std::move(mem_patterns));
-      auto ptr = &patt_insert.first->second;
-      auto shape_insert = shape_patterns_.insert_or_assign(key, std::move(inferred_shapes));
-      out_inferred_shapes = &shape_insert.first->second;
-      return ptr;
+      const auto& inserted = mem_patterns_.Insert(key, std::move(mem_patterns), std::move(inferred_shapes));
+      out_inferred_shapes = inserted.inferred_shapes;
+      return inserted.patterns;
     }
-#else
-    ORT_UNUSED_PARAMETER(feed_mlvalue_idxs);
 #endif
+    if (p_seq_exec_plan_->symbolic_memory_plan.has_value()) {
+      MemoryPatternGroup symbolic_mem_patterns;
+      if (GeneratePatternGroupFromSymbolicPlan(tensor_inputs, feed_mlvalue_idxs, symbolic_mem_patterns).IsOK()) {
+        return mem_patterns_.Insert(key, std::move(symbolic_mem_patterns)).patterns;
+      }
+    }
     return nullptr;
   }
 
-  auto patt_hit = shape_patterns_.find(key);
-  if (patt_hit != shape_patterns_.cend()) {
-    out_inferred_shapes = &patt_hit->second;
+  if (!entry->inferred_shapes->empty()) {
+    out_inferred_shapes = entry->inferred_shapes;
   }
-  return &it->second;
+  return entry->patterns;
 }
 
 void SessionState::ResolveMemoryPatternFlag() {
@@ -843,18 +1214,49 @@ void SessionState::ResolveMemoryPatternFlag() {
       }
     }
   }
+
+  for (const auto& entry : subgraph_session_states_) {
+    for (const auto& name_to_subgraph_session_state : entry.second) {
+      SessionState& subgraph_session_state = *name_to_subgraph_session_state.second;
+      // subgraphs deferred by kOrtSessionOptionsConfigLazySubgraphInitialization resolve it when they are finalized
+      if (subgraph_session_state.GetExecutionPlan() != nullptr) {
+        subgraph_session_state.ResolveMemoryPatternFlag();
+      }
+    }
+  }
 }
 
 Status SessionState::UpdateMemoryPatternGroupCache(gsl::span<const OrtValue> tensor_inputs,
                                                    MemoryPatternGroup mem_patterns) const {
-  int64_t key = CalculateMemoryPatternsKey(tensor_inputs);
+  const std::string key = MemoryPatternCache::MakeKey(tensor_inputs);
 
   std::lock_guard<OrtMutex> lock(mem_patterns_lock_);
-  // Do not update if present, as the pointer to the existing one is cached
-  mem_patterns_.emplace(key, std::move(mem_patterns));
+  // Do not update if present, as the existing one may be in use
+  mem_patterns_.Insert(key, std::move(mem_patterns));
   return Status::OK();
 }
 
+void SessionState::LoadMemoryPatternGroupCache(const PathString& file) {
+  if (!enable_mem_pattern_) {
+    return;
+  }
+  const std::string fingerprint =
+      MemoryPatternCache::ComputeFingerprint(*graph_viewer_, ort_value_name_idx_map_, *p_seq_exec_plan_);
+  std::lock_guard<OrtMutex> lock(mem_patterns_lock_);
+  const size_t num_loaded = mem_patterns_.Load(file, fingerprint);
+  LOGS(logger_, INFO) << "Loaded " << num_loaded << " memory patterns from " << PathToUTF8String(file);
+}
+
+Status SessionState::SaveMemoryPatternGroupCache(const PathString& file) const {
+  if (!enable_mem_pattern_) {
+    return Status::OK();
+  }
+  const std::string fingerprint =
+      MemoryPatternCache::ComputeFingerprint(*graph_viewer_, ort_value_name_idx_map_, *p_seq_exec_plan_);
+  std::lock_guard<OrtMutex> lock(mem_patterns_lock_);
+  return mem_patterns_.Save(file, fingerprint);
+}
+
 bool SessionState::GetEnableMemoryPattern() const { return enable_mem_pattern_; }
 
 bool SessionState::GetEnableMemoryReuse() const { return sess_options_.enable_mem_reuse; }
@@ -979,6 +1381,33 @@ const SessionState* SessionState::GetSubgraphSessionState(onnxruntime::NodeIndex
   return const_cast<SessionState*>(this)->GetMutableSubgraphSessionState(index, attribute_name);
 }
 
+Status SessionState::FinalizeDeferredSubgraphSessionState(onnxruntime::NodeIndex index,
+                                                          const std::string& attribute_name) const {
+  auto node_entry = deferred_subgraph_finalizations_.find(index);
+  if (node_entry == deferred_subgraph_finalizations_.cend()) {
+    return Status::OK();
+  }
+  auto entry = node_entry->second.find(attribute_name);
+  if (entry == node_entry->second.cend()) {
+    return Status::OK();
+  }
+
+  DeferredSubgraphFinalization& deferred = *entry->second;
+  std::call_once(deferred.once, [&deferred]() {
+    ORT_TRY {
+      deferred.status = deferred.finalize();
+    }
+    ORT_CATCH(const std::exception& ex) {
+      ORT_HANDLE_EXCEPTION([&]() {
+        deferred.status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Failed to finalize subgraph: ", ex.what());
+      });
+    }
+    // release the captured state
+    deferred.finalize = nullptr;
+  });
+  return deferred.status;
+}
+
 const NodeIndexInfo& SessionState::GetNodeIndexInfo() const {
   ORT_ENFORCE(node_index_info_.has_value(), "SetGraphAndCreateKernels must be called prior to GetExecutionInfo.");
   return *node_index_info_;
@@ -1043,7 +1472,8 @@ Status SessionState::CreateSubgraphSessionState() {
       auto subgraph_session_state =
           std::make_unique<SessionState>(*subgraph, execution_providers_,
                                          thread_pool_, inter_op_thread_pool_, data_transfer_mgr_,
-                                         logger_, profiler_, sess_options_, nullptr, allocators_);
+                                         logger_, profiler_, sess_options_, nullptr, allocators_,
+                                         shared_initializer_store_);
 
       // Pass fused function manager to subgraph
       subgraph_session_state->fused_funcs_mgr_.SetFusedFuncs(fused_funcs_mgr_);
@@ -1323,6 +1753,12 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
     CreateGraphInfo();
   }
 
+  parallel_initialization_ =
+      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigParallelInitialization, "0") == "1";
+  lazy_subgraph_initialization_ =
+      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigLazySubgraphInitialization,
+                                                        "0") == "1";
+
 #if defined(ORT_EXTENDED_MINIMAL_BUILD)
   // Remove any unused initializers.
   // Not needed in a full build because unused initializers should have been removed earlier by Graph::Resolve().
@@ -1372,9 +1808,36 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
   SubgraphsKernelCreateInfoMaps subgraphs_kernel_create_info_maps;
   AccumulateAllNestedSubgraphsInfo(*this, "", 0, subgraphs_kernel_create_info_maps);
 
+  // subgraphs are executed sequentially by their control flow kernel
+  const bool enable_dynamic_scheduling =
+      parent_node == nullptr && session_options.execution_mode == ExecutionMode::ORT_PARALLEL &&
+      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigDynamicInterOpScheduling, "0") == "1";
+  const bool enable_symbolic_memory_planning =
+      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigSymbolicMemoryPlanning, "0") == "1";
+  const bool enable_concurrent_subgraph_streams =
+      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigConcurrentSubgraphStreams, "0") == "1";
+  const auto max_streams_per_device = ParseStringWithClassicLocale<int>(
+      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigMaxStreamsPerDevice, "1"));
+  ORT_RETURN_IF_NOT(max_streams_per_device >= 1, kOrtSessionOptionsConfigMaxStreamsPerDevice, " must be at least 1.");
+  const bool enable_memcpy_streams =
+      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigMemcpyStreams, "0") == "1";
+  const bool enable_concat_in_place =
+      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigConcatInPlace, "0") == "1";
+  const bool enable_lean_execution =
+      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigLeanExecution, "0") == "1";
+  const bool enable_host_shape_evaluation =
+      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigHostShapeEvaluation, "0") == "1";
   SequentialPlannerContext context(session_options.execution_mode,
                                    session_options.execution_order,
-                                   session_options.enable_mem_reuse);
+                                   session_options.enable_mem_reuse,
+                                   enable_dynamic_scheduling,
+                                   enable_symbolic_memory_planning,
+                                   enable_concurrent_subgraph_streams,
+                                   static_cast<size_t>(max_streams_per_device),
+                                   enable_memcpy_streams,
+                                   enable_concat_in_place,
+                                   enable_lean_execution,
+                                   enable_host_shape_evaluation);
 
 #ifdef _WIN32
 
@@ -1403,6 +1866,14 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
                                               p_seq_exec_plan_);
   ORT_RETURN_IF_ERROR(status);
 
+  const auto& reuse_stats = p_seq_exec_plan_->buffer_reuse_stats;
+  LOGS(logger_, INFO) << "Buffers of the intermediate values of graph " << graph_viewer_->Name() << ": "
+                      << reuse_stats.num_allocated << " allocated (" << reuse_stats.allocated_bytes
+                      << " bytes of static size), " << reuse_stats.num_reused << " reusing a free buffer ("
+                      << reuse_stats.reused_bytes << " bytes), " << reuse_stats.num_inplace_reused
+                      << " reusing the buffer of an input in place (" << reuse_stats.inplace_reused_bytes
+                      << " bytes)";
+
   // Record the allocation plan
 
   // Uncomment the below to dump the allocation plan to std::cout
@@ -1469,20 +1940,40 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
   }
 #endif
 
+  const bool keep_external_initializers_mapped =
+      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigKeepExternalInitializersMapped,
+                                                        "0") == "1";
+
   ORT_RETURN_IF_ERROR(
       session_state_utils::SaveInitializedTensors(
           Env::Default(), graph_location, *graph_viewer_,
           GetAllocator(OrtDevice()),
           ort_value_name_idx_map_, initializer_allocation_order, *tensor_allocator,
-          [this, remove_initializers](const std::string& name, int idx, const OrtValue& value, const OrtCallback& d,
-                                      bool constant, bool sparse) -> Status {
-            ORT_RETURN_IF_ERROR(AddInitializedTensor(idx, value, &d, constant, sparse));
+          [this, remove_initializers, keep_external_initializers_mapped, &session_options, &graph_location](
+              const std::string& name, int idx, const OrtValue& value, const OrtCallback& d,
+              bool constant, bool sparse) -> Status {
+            OrtValue shared_value;
+            if (shared_initializer_store_ != nullptr && constant && !sparse &&
+                session_options.initializers_to_share_map.count(name) == 0) {
+              ORT_RETURN_IF_ERROR(ShareInitializerByContent(graph_location, name, value, shared_value));
+            }
+            ORT_RETURN_IF_ERROR(AddInitializedTensor(idx, shared_value.IsAllocated() ? shared_value : value, &d,
+                                                     constant, sparse));
+            if (keep_external_initializers_mapped && constant &&
+                session_options.initializers_to_share_map.count(name) == 0 &&
+                value.Get<Tensor>().Location().device.Type() == OrtDevice::CPU) {
+              const ONNX_NAMESPACE::TensorProto* tensor_proto = nullptr;
+              if (graph_.GetInitializedTensor(name, tensor_proto) && utils::HasExternalData(*tensor_proto)) {
+                mapped_external_initializers_.insert(idx);
+              }
+            }
             if (remove_initializers) {
               graph_.RemoveInitializedTensor(name);
             }
             return Status::OK();
           },
-          logger_, data_transfer_mgr_, *p_seq_exec_plan_, session_options, memory_profile_func));
+          logger_, data_transfer_mgr_, *p_seq_exec_plan_, session_options, memory_profile_func,
+          parallel_initialization_ ? thread_pool_ : nullptr));
 
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
   // Record Weight allocation info on device
@@ -1499,6 +1990,13 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
   ORT_RETURN_IF_ERROR(CreateKernels(kernel_registry_manager));
 
   if (!disable_prepacking) {
+    const std::string prepacked_weights_cache_dir =
+        session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigPrepackedWeightsCacheDir, "");
+    if (!prepacked_weights_cache_dir.empty()) {
+      prepacked_weights_disk_cache_ = std::make_unique<PrepackedWeightsDiskCache>(
+          Env::Default(), ToPathString(prepacked_weights_cache_dir));
+    }
+
     ORT_RETURN_IF_ERROR(PrepackConstantInitializedTensors(constant_initializers_use_count,
                                                           session_options.initializers_to_share_map));
   }
@@ -1537,6 +2035,27 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
                                                                node,
                                                                subgraph_session_state.GetGraphViewer(),
                                                                subgraph_outer_scope_node_arg_to_location_map));
+
+      // If::Compute finalizes the branch it takes on first execution. The constant initializers of the outer scope
+      // stay in place for a deferred branch, so the use counts are not shared with it.
+      if (lazy_subgraph_initialization_ && node.OpType() == "If" && node.Domain() == kOnnxDomain) {
+        auto deferred = std::make_unique<DeferredSubgraphFinalization>();
+        deferred->finalize = [this, &node, &subgraph_session_state, &kernel_registry_manager, attr_name,
+                              graph_location, subgraph_session_options, remove_initializers,
+                              outer_scope_map = std::move(subgraph_outer_scope_node_arg_to_location_map)]() -> Status {
+          InlinedHashMap<std::string, size_t> subgraph_constant_initializers_use_count;
+          ORT_RETURN_IF_ERROR(subgraph_session_state.FinalizeSessionStateImpl(
+              graph_location, kernel_registry_manager, &node, subgraph_session_options, remove_initializers,
+              subgraph_constant_initializers_use_count, outer_scope_map, true));
+          subgraph_session_state.ResolveMemoryPatternFlag();
+
+          auto& control_flow_kernel = static_cast<controlflow::IControlFlowKernel&>(*GetMutableKernel(node.Index()));
+          return control_flow_kernel.SetupSubgraphExecutionInfo(*this, attr_name, subgraph_session_state);
+        };
+        deferred_subgraph_finalizations_[node.Index()][attr_name] = std::move(deferred);
+        continue;
+      }
+
       ORT_RETURN_IF_ERROR(subgraph_session_state.FinalizeSessionStateImpl(
           graph_location, kernel_registry_manager, &node, subgraph_session_options, remove_initializers,
           constant_initializers_use_count, subgraph_outer_scope_node_arg_to_location_map, true));
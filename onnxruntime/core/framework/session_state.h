@@ -3,8 +3,10 @@
 
 #pragma once
 
+#include <functional>
 #include <memory>
 #include <map>
+#include <mutex>
 #include <unordered_map>
 #include <vector>
 
@@ -14,6 +16,7 @@
 #include "core/common/inlined_containers.h"
 #include "core/common/logging/logging.h"
 #include "core/common/profiler.h"
+#include "core/common/sampling_profiler.h"
 #include "core/framework/allocation_planner.h"
 #include "core/framework/callback.h"
 #include "core/framework/data_transfer_manager.h"
@@ -22,9 +25,12 @@
 #include "core/framework/feeds_fetches_manager.h"
 #include "core/framework/framework_common.h"
 #include "core/framework/prepacked_weights_container.h"
+#include "core/framework/prepacked_weights_disk_cache.h"
+#include "core/framework/shared_initializer_store.h"
 #include "core/framework/fuse_nodes_funcs.h"
 #include "core/framework/kernel_registry_manager.h"
 #include "core/framework/mem_pattern.h"
+#include "core/framework/memory_pattern_cache.h"
 #include "core/framework/ort_value.h"
 #include "core/framework/node_index_info.h"
 #include "core/framework/op_kernel.h"
@@ -100,7 +106,8 @@ class SessionState {
                profiling::Profiler& profiler,
                const SessionOptions& sess_options,
                PrepackedWeightsContainer* prepacked_weights_container = nullptr,
-               AllocatorMap* parent_allocators = nullptr);
+               AllocatorMap* parent_allocators = nullptr,
+               SharedInitializerStore* shared_initializer_store = nullptr);
 
   ~SessionState() {
     for (auto& kvp : deleter_for_initialized_tensors_) {
@@ -165,6 +172,15 @@ class SessionState {
    */
   const std::unordered_map<int, OrtValue>& GetConstantInitializedTensors() const;
 
+  /**
+   * Replaces the values of constant initializers of the main graph with `values`, which must have the same type and
+   * shape. The kernels of the nodes consuming the initializers are created again, and pre-pack the new values, while
+   * the other kernels and their pre-packed weights are kept. Nothing is changed if an error is returned.
+   * The caller must ensure that the session state is not used by a Run() meanwhile.
+   */
+  Status UpdateConstantInitializers(const KernelRegistryManager& kernel_registry_manager,
+                                    gsl::span<const std::string> names, gsl::span<const OrtValue> values);
+
 #if !defined(DISABLE_SPARSE_TENSORS)
   bool IsSparseInitializer(int ort_value_index) const;
 #endif
@@ -207,6 +223,15 @@ class SessionState {
   */
   profiling::Profiler& Profiler() const noexcept { return profiler_; }
 
+  /**
+  Get the sampling profiler of the session, if enabled. Only set for the main graph.
+  */
+  profiling::SamplingProfiler* GetSamplingProfiler() const noexcept { return sampling_profiler_; }
+
+  void SetSamplingProfiler(profiling::SamplingProfiler* sampling_profiler) noexcept {
+    sampling_profiler_ = sampling_profiler;
+  }
+
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
   MemoryProfiler* GetMemoryProfiler() const noexcept { return memory_profiler_; }
 
@@ -224,10 +249,10 @@ class SessionState {
   it is not mutable, we do not obtain a lock and simply get a pointer
   w/o copying a hashtable
   */
-  const MemoryPatternGroup* GetMemoryPatternGroup(
+  std::shared_ptr<const MemoryPatternGroup> GetMemoryPatternGroup(
       gsl::span<const OrtValue> tensor_inputs,
       gsl::span<const int> feed_mlvalue_idxs,
-      const InlinedHashMap<int, TensorShape>*& inferred_shapes) const;
+      std::shared_ptr<const InlinedHashMap<int, TensorShape>>& inferred_shapes) const;
 
   /**
   Set generated memory pattern with a given input shapes.
@@ -237,6 +262,17 @@ class SessionState {
   Status UpdateMemoryPatternGroupCache(gsl::span<const OrtValue> tensor_inputs,
                                        MemoryPatternGroup mem_patterns) const;
 
+  /**
+  Add the memory patterns saved by an earlier session for the same execution plan
+  to the cache. See kOrtSessionOptionsConfigMemoryPatternCacheFile.
+  */
+  void LoadMemoryPatternGroupCache(const PathString& file);
+
+  /**
+  Save the memory patterns generated so far to `file`.
+  */
+  Status SaveMemoryPatternGroupCache(const PathString& file) const;
+
   bool GetUseDeterministicCompute() const { return sess_options_.use_deterministic_compute; }
 
   /**
@@ -253,6 +289,7 @@ class SessionState {
   /**
   Update enable_mem_pattern_ flag according to the presence of graph inputs' shape
   If any one of the graph input is shapeless, enable_mem_pattern_ will be set to false
+  The flags of the subgraph session states that are already finalized are resolved as well.
   */
   void ResolveMemoryPatternFlag();
 
@@ -290,6 +327,13 @@ class SessionState {
   /// Return SessionState for the given Node index and attribute name if found.
   const SessionState* GetSubgraphSessionState(NodeIndex index, const std::string& attribute_name) const;
 
+  /**
+  Finalize the session state of the subgraph in `attribute_name` of node `index` if its finalization was deferred
+  until the first execution of the subgraph. See kOrtSessionOptionsConfigLazySubgraphInitialization.
+  Thread-safe: the first call finalizes the subgraph and later calls return the status of that.
+  */
+  Status FinalizeDeferredSubgraphSessionState(NodeIndex index, const std::string& attribute_name) const;
+
   concurrency::ThreadPool* GetThreadPool() const noexcept { return thread_pool_; }
   concurrency::ThreadPool* GetInterOpThreadPool() const noexcept { return inter_op_thread_pool_; }
 
@@ -327,6 +371,10 @@ class SessionState {
     return used_shared_pre_packed_weights_counter_;
   }
 
+  size_t GetUsedPersistedPrePackedWeightCounter() const {
+    return used_persisted_pre_packed_weights_counter_;
+  }
+
   const KernelCreateInfoMap& GetKernelCreateInfoMap() const {
     return kernel_create_info_map_;
   }
@@ -371,6 +419,13 @@ class SessionState {
   // (replaced byOrtValue instances in initialized_tensors_)
   void CleanInitializedTensorsFromGraph();
 
+  // Looks up the initializer `name` deserialized into `value` in shared_initializer_store_ by its content, and returns
+  // in shared_value the tensor with the same content stored by another session, or `value` once stored.
+  // shared_value is left unallocated for the initializers that are not shared, including an initializer whose key
+  // matches a stored one of different data.
+  Status ShareInitializerByContent(const std::basic_string<PATH_CHAR_TYPE>& graph_location, const std::string& name,
+                                   const OrtValue& value, OrtValue& shared_value);
+
   /**
    * Prepack the constant initialized tensors for better performance.
    * The original constant initialized tensors will be removed to save memory.
@@ -378,6 +433,19 @@ class SessionState {
   Status PrepackConstantInitializedTensors(InlinedHashMap<std::string, size_t>& constant_initializers_use_count,
                                            const std::unordered_map<std::string, const OrtValue*>& initializers_to_share_map);
 
+  /**
+   * Prepack a constant initialized tensor through the on-disk cache of pre-packed weights: use the pre-packed buffers
+   * persisted by an earlier session if there are any, otherwise pre-pack it and persist the buffers for the next one.
+   */
+  /**
+   * Prepack the constant initialized tensors of the CPU execution provider's nodes in parallel on thread_pool_.
+   * Only used if pre-packed weights are neither shared between sessions nor cached on disk.
+   */
+  Status ParallelPrepackConstantInitializedTensors(InlinedHashMap<std::string, size_t>& constant_initializers_use_count);
+
+  Status PrepackWithDiskCache(OpKernel& kernel, const Node& node, int input_idx, const Tensor& tensor,
+                              /*out*/ bool& is_packed);
+
   SessionState* GetMutableSubgraphSessionState(onnxruntime::NodeIndex index, const std::string& attribute_name);
 
   Status CreateSubgraphSessionState();
@@ -405,6 +473,11 @@ class SessionState {
       InlinedHashMap<int, TensorShape>& inferred_shapes) const;
 #endif
 
+  // Generates the memory patterns for the shapes of the feeds from the symbolic memory plan of the execution plan.
+  Status GeneratePatternGroupFromSymbolicPlan(gsl::span<const OrtValue> tensor_inputs,
+                                              gsl::span<const int> feed_mlvalue_idxs,
+                                              MemoryPatternGroup& output) const;
+
   // KernelCreateInfo for each node so we do kernel lookup once
   KernelCreateInfoMap kernel_create_info_map_;
 
@@ -462,6 +535,9 @@ class SessionState {
   std::unordered_map<int, OrtValue> initialized_tensors_;  // key is ort_value_index
   // subset of initialized_tensors_ that are constant and cannot be overridden at runtime
   std::unordered_map<int, OrtValue> constant_initialized_tensors_;
+  // subset of initialized_tensors_ that are views over a memory mapped external data file, and are kept mapped
+  // rather than pre-packed. See kOrtSessionOptionsConfigKeepExternalInitializersMapped.
+  InlinedHashSet<int> mapped_external_initializers_;
 
 #if !defined(DISABLE_SPARSE_TENSORS)
   // This is an auxiliary lookup to check if the OrtValue was actually a sparse tensor
@@ -479,6 +555,7 @@ class SessionState {
 
   const logging::Logger& logger_;
   profiling::Profiler& profiler_;
+  profiling::SamplingProfiler* sampling_profiler_{nullptr};
 
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
   MemoryProfiler* memory_profiler_;
@@ -489,26 +566,35 @@ class SessionState {
 
   // lock for the mem_patterns_
   mutable OrtMutex mem_patterns_lock_;
-  // cache for the generated mem_patterns. key is calculated based on input shapes.
-  // must be a node based container as a pointer is cached.
-  mutable NodeHashMap<int64_t, MemoryPatternGroup> mem_patterns_;
-  // This is mutable under mutex in training scenarios so execution frame would make a copy
-  // of the value when created.
-#ifdef ENABLE_TRAINING
-  mutable NodeHashMap<int64_t, InlinedHashMap<int, TensorShape>> shape_patterns_;
-#else
-  NodeHashMap<int64_t, InlinedHashMap<int, TensorShape>> shape_patterns_;
-#endif
+  // cache for the generated mem_patterns and, in training scenarios, the inferred shapes, by input shapes.
+  // see kOrtSessionOptionsConfigMemoryPatternCacheCapacity
+  mutable MemoryPatternCache mem_patterns_;
 
   NameNodeInfoMapType input_names_to_nodeinfo_mapping_;
   NameNodeInfoMapType output_names_to_nodeinfo_mapping_;
 
   SubgraphSessionStateMap subgraph_session_states_;
 
+  struct DeferredSubgraphFinalization {
+    std::once_flag once;
+    Status status;
+    std::function<Status()> finalize;
+  };
+
+  // subgraph session states whose finalization is deferred until their first execution
+  InlinedHashMap<NodeIndex, InlinedHashMap<std::string, std::unique_ptr<DeferredSubgraphFinalization>>>
+      deferred_subgraph_finalizations_;
+
   // either threadpool could be nullptr
   concurrency::ThreadPool* const thread_pool_{};
   concurrency::ThreadPool* const inter_op_thread_pool_{};
 
+  // create kernels, pre-pack and load initializers using thread_pool_. see kOrtSessionOptionsConfigParallelInitialization
+  bool parallel_initialization_ = false;
+
+  // defer finalization of If branches until they run. see kOrtSessionOptionsConfigLazySubgraphInitialization
+  bool lazy_subgraph_initialization_ = false;
+
   const DataTransferManager& data_transfer_mgr_;
 
   const SessionOptions& sess_options_;
@@ -521,6 +607,13 @@ class SessionState {
   // prepacked_weights_container_ can be nullptr if no caching is required for prepacked weights
   PrepackedWeightsContainer* const prepacked_weights_container_{};
 
+  // shared_initializer_store_ is nullptr unless the constant initializers are shared by content between sessions
+  SharedInitializerStore* const shared_initializer_store_{};
+
+  // On-disk cache of pre-packed weights. nullptr unless kOrtSessionOptionsConfigPrepackedWeightsCacheDir is set.
+  // Holds the buffers the kernels use, so it lives as long as the session state.
+  std::unique_ptr<PrepackedWeightsDiskCache> prepacked_weights_disk_cache_;
+
 #ifdef ENABLE_TRAINING
 // Needed for ORTTrainer. Should be removed along with ORTTrainer code
 #ifndef DISABLE_ABSEIL
@@ -551,6 +644,9 @@ class SessionState {
   // a constant initialized weight was used by the session state
   size_t used_shared_pre_packed_weights_counter_ = 0;
 
+  // Counter for number of times a pre-packed weight was loaded from the on-disk cache instead of being pre-packed
+  size_t used_persisted_pre_packed_weights_counter_ = 0;
+
 #ifdef DEBUG_NODE_INPUTS_OUTPUTS
   // Counter for number of times the session graph has been executed
   size_t graph_executions_counter_ = 0;
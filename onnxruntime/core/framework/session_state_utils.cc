@@ -1,6 +1,7 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
 #include <functional>
 #include <limits>
 #include <utility>
@@ -26,6 +27,7 @@
 #include "core/session/onnxruntime_session_options_config_keys.h"
 #include "core/framework/mem_buffer.h"
 #include "core/framework/tensor_allocator.h"
+#include "core/platform/threadpool.h"
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
 #include "core/framework/memory_info.h"
 #endif
@@ -103,6 +105,23 @@ static common::Status DeserializeTensorProto(const Env& env, const std::basic_st
                   "DeserializeTensorProto() takes either pre-allocated buffer or an allocator!");
   }
 
+  const OrtMemoryInfo& location = m != nullptr ? m->GetAllocInfo() : alloc->Info();
+  if (location.device.Type() == OrtDevice::CPU && utils::HasExternalData(tensor_proto)) {
+    // NB: The file containing external data for the tensor is mmap'd. If the tensor will be used on CPU we can
+    // utilize the mmap'd buffer directly by calling ExtDataTensorProtoToTensor. If we called
+    // TensorProtoToTensor it would copy the data, causing unnecessary overhead.
+    // No buffer is allocated up front since the tensor ends up pointing to the mapped data.
+    auto p_tensor = std::make_unique<Tensor>();
+    OrtCallback ext_data_deleter;
+    ORT_RETURN_IF_ERROR(ExtDataTensorProtoToTensor(env, proto_path, tensor_proto, *p_tensor, ext_data_deleter));
+
+    ExtDataValueDeleter deleter{ext_data_deleter, p_tensor.get()};
+
+    MLDataType ml_tensor_type = DataTypeImpl::GetType<Tensor>();
+    ort_value.Init(p_tensor.release(), ml_tensor_type, deleter);
+    return common::Status::OK();
+  }
+
   // Get shape and type of the tensor, and allocate the empty tensor
   TensorShape tensor_shape = utils::GetTensorShapeFromTensorProto(tensor_proto);
   const DataTypeImpl* const type = DataTypeImpl::TensorTypeFromONNXEnum(tensor_proto.data_type())->GetElementType();
@@ -128,28 +147,19 @@ static common::Status DeserializeTensorProto(const Env& env, const std::basic_st
 
   if (p_tensor->Location().device.Type() == OrtDevice::CPU) {
     // deserialize directly to CPU tensor
-    if (utils::HasExternalData(tensor_proto)) {
-      // NB: The file containing external data for the tensor is mmap'd. If the tensor will be used on CPU we can
-      // utilize the mmap'd buffer directly by calling ExtDataTensorProtoToTensor. If we called
-      // TensorProtoToTensor it would copy the data, causing unnecessary overhead
-      OrtCallback ext_data_deleter;
-      ORT_RETURN_IF_ERROR(ExtDataTensorProtoToTensor(env, proto_path, tensor_proto, *p_tensor, ext_data_deleter));
-
-      ExtDataValueDeleter deleter{ext_data_deleter, p_tensor.get()};
-
-      MLDataType ml_tensor_type = DataTypeImpl::GetType<Tensor>();
-      ort_value.Init(p_tensor.release(), ml_tensor_type, deleter);
-      return common::Status::OK();
-    }
     ORT_RETURN_IF_ERROR(utils::TensorProtoToTensor(env, proto_path.c_str(), tensor_proto, *p_tensor));
   } else {  // non-cpu tensor
     if (tensor_proto.data_type() == ONNX_NAMESPACE::TensorProto_DataType_STRING) {
       return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "string tensor is not supported for copying between allocators");
     }
 
-    // deserialize to CPU first for non-CPU allocator, then copy
+    // deserialize to CPU first for non-CPU allocator, then copy.
+    // External data is copied straight from the mapped file, so no CPU buffer is allocated for it. Otherwise loading
+    // a large model with external data would need a CPU copy of every tensor on its way to the device.
     std::unique_ptr<Tensor> p_deserialize_tensor;
-    if (use_device_allocator_for_initializers) {
+    if (utils::HasExternalData(tensor_proto)) {
+      p_deserialize_tensor = std::make_unique<Tensor>();
+    } else if (use_device_allocator_for_initializers) {
       void* tensor_buffer = nullptr;
       ORT_RETURN_IF_ERROR(AllocateBufferUsingDeviceAllocatorFromShapeAndType(tensor_shape, type, default_cpu_alloc, tensor_buffer));
       p_deserialize_tensor = std::make_unique<Tensor>(type, tensor_shape, tensor_buffer, default_cpu_alloc);
@@ -187,6 +197,19 @@ static common::Status DeserializeTensorProto(const Env& env, const std::basic_st
   return common::Status::OK();
 }
 
+// Size of the parts of the external data of initializers that are prefetched by one task
+constexpr size_t kPrefetchChunkSize = 4 * 1024 * 1024;
+
+// Reads one byte of each page so that the pages of mapped external data are loaded
+static void PrefetchPages(gsl::span<const char> data) {
+  constexpr size_t kPageSize = 4096;
+  volatile char sink = 0;
+  for (size_t offset = 0; offset < data.size(); offset += kPageSize) {
+    sink = data[offset];
+  }
+  ORT_UNUSED_PARAMETER(sink);
+}
+
 common::Status SaveInitializedTensors(
     const Env& env, const std::basic_string<PATH_CHAR_TYPE>& graph_loc,
     const GraphViewer& graph, const AllocatorPtr& default_cpu_alloc,
@@ -197,7 +220,8 @@ common::Status SaveInitializedTensors(
     const logging::Logger& logger, const DataTransferManager& data_transfer_mgr,
     const ExecutionPlanBase& exec_plan,
     const SessionOptions& session_options,
-    const MemoryProfileFunction& memory_profile_func) {
+    const MemoryProfileFunction& memory_profile_func,
+    concurrency::ThreadPool* thread_pool) {
   LOGS(logger, INFO) << "Saving initialized tensors.";
   ORT_ENFORCE(ort_value_name_idx_map.MaxIdx() > -1, "OrtValue indexes should have been populated.");
 
@@ -272,6 +296,10 @@ common::Status SaveInitializedTensors(
       // do not trace string tensor
       continue;
     }
+    if (utils::HasExternalData(*entry.second) && exec_plan.GetLocation(entry.first).Type() == OrtDevice::CPU) {
+      // the tensor will point to the mmap'd external data, see NB2 above
+      continue;
+    }
     ORT_RETURN_IF_ERROR(planner.Trace(entry.first, entry.second));
   }
   // 2. allocate weight buffer on different locations
@@ -291,6 +319,83 @@ common::Status SaveInitializedTensors(
 
   OrtCallback deleter{nullptr, nullptr};
 
+  const bool use_device_allocator_for_initializers =
+      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsUseDeviceAllocatorForInitializers, "0") == "1";
+
+  auto deserialize_tensor = [&](const ONNX_NAMESPACE::TensorProto& tensor_proto, std::optional<MemBuffer>& m,
+                                const AllocatorPtr& alloc, OrtValue& ort_value) -> Status {
+    Status st = DeserializeTensorProto(env, graph_loc, tensor_proto, (m.has_value()) ? &*m : nullptr, alloc,
+                                       default_cpu_alloc, ort_value, data_transfer_mgr,
+                                       use_device_allocator_for_initializers);
+    if (!st.IsOK()) {
+      std::ostringstream oss;
+      oss << "Deserialize tensor " << tensor_proto.name() << " failed." << st.ErrorMessage();
+      return Status(st.Category(), st.Code(), oss.str());
+    }
+    return Status::OK();
+  };
+
+  // With a thread pool the initializers that live on CPU are deserialized in parallel up front. Their buffers are
+  // taken from the planner beforehand as it is not thread-safe, and they are saved below in the usual order.
+  InlinedHashMap<int, OrtValue> deserialized_tensors;
+  if (thread_pool != nullptr) {
+    struct DeserializeTask {
+      const ONNX_NAMESPACE::TensorProto* tensor_proto;
+      int ort_value_index;
+      std::optional<MemBuffer> m;
+      AllocatorPtr alloc;
+      OrtValue ort_value;
+    };
+    std::vector<DeserializeTask> tasks;
+    for (const auto& entry : id_to_initialized_tensor) {
+      const std::string& name = entry.second->name();
+      if (name.empty() || user_supplied_initializer_ids.count(entry.first) != 0 ||
+          exec_plan.GetLocation(entry.first).Type() != OrtDevice::CPU) {
+        continue;
+      }
+      DeserializeTask& task = tasks.emplace_back();
+      task.tensor_proto = entry.second;
+      task.ort_value_index = entry.first;
+      if (utils::HasExternalData(*entry.second)) {
+        task.alloc = default_cpu_alloc;
+      } else {
+        ORT_RETURN_IF_ERROR(planner.GetPreallocatedBuffer(entry.first, name, task.m, task.alloc));
+      }
+    }
+
+    ORT_RETURN_IF_ERROR(ParallelForEach(thread_pool, tasks.size(), [&tasks, &deserialize_tensor](size_t i) {
+      DeserializeTask& task = tasks[i];
+      return deserialize_tensor(*task.tensor_proto, task.m, task.alloc, task.ort_value);
+    }));
+
+    // The mapped external data is only read from disk when it is first accessed, one page fault at a time. Reading
+    // it here in chunks spread over the thread pool keeps several reads in flight at once.
+    if (session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigPrefetchExternalInitializers,
+                                                          "0") == "1") {
+      std::vector<gsl::span<const char>> chunks;
+      for (const auto& task : tasks) {
+        if (!utils::HasExternalData(*task.tensor_proto)) {
+          continue;
+        }
+        const Tensor& tensor = task.ort_value.Get<Tensor>();
+        const char* data = static_cast<const char*>(tensor.DataRaw());
+        for (size_t offset = 0; offset < tensor.SizeInBytes(); offset += kPrefetchChunkSize) {
+          chunks.emplace_back(data + offset, std::min(kPrefetchChunkSize, tensor.SizeInBytes() - offset));
+        }
+      }
+
+      ORT_RETURN_IF_ERROR(ParallelForEach(thread_pool, chunks.size(), [&chunks](size_t i) {
+        PrefetchPages(chunks[i]);
+        return Status::OK();
+      }));
+    }
+
+    deserialized_tensors.reserve(tasks.size());
+    for (auto& task : tasks) {
+      deserialized_tensors.emplace(task.ort_value_index, std::move(task.ort_value));
+    }
+  }
+
   // 3. create weight tensors based on weights buffer
   for (const auto& entry : id_to_initialized_tensor) {
     int ort_value_index = entry.first;
@@ -306,24 +411,21 @@ common::Status SaveInitializedTensors(
     if (user_supplied_initializer_ids.find(entry.first) != user_supplied_initializer_ids.end()) {
       ort_value = *(session_options.initializers_to_share_map.at(name));
       LOGS(logger, INFO) << "Using user supplied initializer with name (" << name << ").";
+    } else if (auto it = deserialized_tensors.find(ort_value_index); it != deserialized_tensors.end()) {
+      ort_value = std::move(it->second);
     } else {
       const ONNX_NAMESPACE::TensorProto& tensor_proto = *(entry.second);
 
       std::optional<MemBuffer> m;
       AllocatorPtr alloc;
-      // TODO: if the tensor need be copied, does it have enough room?
-      ORT_RETURN_IF_ERROR(planner.GetPreallocatedBuffer(ort_value_index, name, m, alloc));
-      bool use_device_allocator_for_initializers =
-          session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsUseDeviceAllocatorForInitializers, "0") == "1";
-
-      Status st = DeserializeTensorProto(env, graph_loc, tensor_proto, (m.has_value()) ? &*m : nullptr, alloc,
-                                         default_cpu_alloc, ort_value, data_transfer_mgr,
-                                         use_device_allocator_for_initializers);
-      if (!st.IsOK()) {
-        std::ostringstream oss;
-        oss << "Deserialize tensor " << name << " failed." << st.ErrorMessage();
-        return Status(st.Category(), st.Code(), oss.str());
+      if (utils::HasExternalData(tensor_proto) && exec_plan.GetLocation(ort_value_index).Type() == OrtDevice::CPU) {
+        // not traced, the tensor will point to the mmap'd external data
+        alloc = default_cpu_alloc;
+      } else {
+        // TODO: if the tensor need be copied, does it have enough room?
+        ORT_RETURN_IF_ERROR(planner.GetPreallocatedBuffer(ort_value_index, name, m, alloc));
       }
+      ORT_RETURN_IF_ERROR(deserialize_tensor(tensor_proto, m, alloc, ort_value));
     }
 
     // 'name' is a reference to a string within the TensorProto that save_tensor_func may free
@@ -345,6 +447,27 @@ common::Status SaveInitializedTensors(
   return common::Status::OK();
 }
 
+common::Status ParallelForEach(concurrency::ThreadPool* thread_pool, size_t n,
+                               const std::function<common::Status(size_t)>& fn) {
+  std::vector<Status> statuses(n);
+  concurrency::ThreadPool::TrySimpleParallelFor(
+      thread_pool, static_cast<std::ptrdiff_t>(n), [&statuses, &fn](std::ptrdiff_t i) {
+        ORT_TRY {
+          statuses[i] = fn(static_cast<size_t>(i));
+        }
+        ORT_CATCH(const std::exception& ex) {
+          ORT_HANDLE_EXCEPTION([&]() {
+            statuses[i] = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, ex.what());
+          });
+        }
+      });
+
+  for (auto& status : statuses) {
+    ORT_RETURN_IF_ERROR(status);
+  }
+  return Status::OK();
+}
+
 template <typename T>  // T is container of const NodeArg* or NodeArg*
 static bool IsArgNameInInputsOutputs(const std::string& name,
                                      const T& graph_args) {
@@ -29,6 +29,10 @@ namespace logging {
 class Logger;
 }
 
+namespace concurrency {
+class ThreadPool;
+}
+
 namespace session_state_utils {
 using SaveTensorFunction = std::function<Status(const std::string& name, int idx, const OrtValue& value,
                                                 const OrtCallback& d, bool constant, bool sparse)>;
@@ -44,7 +48,13 @@ common::Status SaveInitializedTensors(
     const DataTransferManager& data_transfer_mgr,
     const ExecutionPlanBase& exec_plan,
     const SessionOptions& session_options,
-    const MemoryProfileFunction& memory_profile_func);
+    const MemoryProfileFunction& memory_profile_func,
+    concurrency::ThreadPool* thread_pool = nullptr);
+
+// Calls fn(i) for every i in [0, n), in parallel on `thread_pool` or sequentially if it is nullptr.
+// Exceptions thrown by fn are converted to a failed status. Returns the failure with the lowest index.
+common::Status ParallelForEach(concurrency::ThreadPool* thread_pool, size_t n,
+                               const std::function<common::Status(size_t)>& fn);
 
 common::Status SaveInputOutputNamesToNodeMapping(const GraphViewer& graph,
                                                  SessionState& session_state,
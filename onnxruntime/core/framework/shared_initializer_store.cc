@@ -0,0 +1,135 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/shared_initializer_store.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <sstream>
+#include <vector>
+
+#include "core/common/safeint.h"
+#include "core/framework/allocator.h"
+#include "core/framework/callback.h"
+#include "core/framework/murmurhash3.h"
+#include "core/framework/tensorprotoutils.h"
+
+namespace onnxruntime {
+
+namespace {
+
+// 128-bit hash of data of any size. MurmurHash3 takes an int length, so larger data is hashed in parts and the hash
+// of each part is combined with the hash of the previous ones.
+void HashData(const char* data, size_t size, uint32_t (&hash)[4]) {
+  constexpr size_t kMaxPartSize = static_cast<size_t>(std::numeric_limits<int>::max()) / 2;
+  MurmurHash3::x86_128(data, static_cast<int>(std::min(size, kMaxPartSize)), 0, hash);
+  for (size_t offset = kMaxPartSize; offset < size; offset += kMaxPartSize) {
+    uint32_t combined[8];
+    std::memcpy(combined, hash, sizeof(hash));
+    MurmurHash3::x86_128(data + offset, static_cast<int>(std::min(size - offset, kMaxPartSize)), 0, combined + 4);
+    MurmurHash3::x86_128(combined, static_cast<int>(sizeof(combined)), 0, hash);
+  }
+}
+
+// Returns whether the tensors of the same type and shape have the same data. The tensors that are not on the CPU are
+// copied to it to be compared, which happens once per shared initializer when a session is initialized.
+Status HaveSameData(const Tensor& a, const Tensor& b, const DataTransferManager& data_transfer_mgr, bool& same) {
+  auto cpu_allocator = std::make_shared<CPUAllocator>();
+  std::unique_ptr<Tensor> cpu_copies[2];
+  const Tensor* tensors[2] = {&a, &b};
+  for (size_t i = 0; i < 2; ++i) {
+    if (tensors[i]->Location().device.Type() != OrtDevice::CPU) {
+      cpu_copies[i] = std::make_unique<Tensor>(tensors[i]->DataType(), tensors[i]->Shape(), cpu_allocator);
+      ORT_RETURN_IF_ERROR(data_transfer_mgr.CopyTensor(*tensors[i], *cpu_copies[i]));
+      tensors[i] = cpu_copies[i].get();
+    }
+  }
+
+  same = tensors[0]->SizeInBytes() == tensors[1]->SizeInBytes() &&
+         std::memcmp(tensors[0]->DataRaw(), tensors[1]->DataRaw(), tensors[0]->SizeInBytes()) == 0;
+  return Status::OK();
+}
+
+}  // namespace
+
+Status SharedInitializerStore::ComputeKey(const Env& env, const PATH_CHAR_TYPE* model_path,
+                                          const ONNX_NAMESPACE::TensorProto& tensor_proto, const OrtDevice& device,
+                                          std::string& key) {
+  ORT_RETURN_IF(tensor_proto.data_type() == ONNX_NAMESPACE::TensorProto_DataType_STRING,
+                "String initializers can not be shared by content");
+
+  uint32_t hash[4];
+  if (utils::HasExternalData(tensor_proto)) {
+    void* ext_data = nullptr;
+    SafeInt<size_t> ext_data_len = 0;
+    OrtCallback ext_data_deleter;
+    ORT_RETURN_IF_ERROR(utils::GetExtDataFromTensorProto(env, model_path, tensor_proto, ext_data, ext_data_len,
+                                                         ext_data_deleter));
+    ScopedOrtCallbackInvoker ext_data_deleter_invoker(ext_data_deleter);
+    HashData(static_cast<const char*>(ext_data), ext_data_len, hash);
+  } else if (utils::HasRawData(tensor_proto)) {
+    HashData(tensor_proto.raw_data().data(), tensor_proto.raw_data().size(), hash);
+  } else {
+    std::vector<uint8_t> unpacked_tensor;
+    ORT_RETURN_IF_ERROR(utils::UnpackInitializerData(tensor_proto, unpacked_tensor));
+    HashData(reinterpret_cast<const char*>(unpacked_tensor.data()), unpacked_tensor.size(), hash);
+  }
+
+  std::ostringstream oss;
+  oss << device.ToString() << ";" << tensor_proto.data_type() << ";";
+  for (auto dim : tensor_proto.dims()) {
+    oss << dim << ",";
+  }
+  oss << ";" << std::hex << hash[0] << "-" << hash[1] << "-" << hash[2] << "-" << hash[3];
+  key = oss.str();
+  return Status::OK();
+}
+
+Status SharedInitializerStore::GetOrAdd(const std::string& key, const OrtValue& value,
+                                        const DataTransferManager& data_transfer_mgr, OrtValue& shared_value) {
+  std::shared_ptr<OrtValue> owner;
+  bool added = false;
+  {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    auto& entry = values_[key];
+    owner = entry.lock();
+    if (owner == nullptr) {
+      owner = std::make_shared<OrtValue>(value);
+      entry = owner;
+      added = true;
+
+      if (values_.size() >= purge_size_) {
+        for (auto it = values_.begin(); it != values_.end();) {
+          it = it->second.expired() ? values_.erase(it) : std::next(it);
+        }
+        purge_size_ = std::max(purge_size_, values_.size() * 2);
+      }
+    }
+  }
+
+  // owner keeps the stored initializer alive while it is compared, outside of the lock
+  const Tensor& tensor = owner->Get<Tensor>();
+  if (!added) {
+    bool same = false;
+    ORT_RETURN_IF_ERROR(HaveSameData(tensor, value.Get<Tensor>(), data_transfer_mgr, same));
+    if (!same) {
+      return Status::OK();
+    }
+  }
+
+  // the returned tensor keeps the stored initializer alive
+  auto p_tensor = std::make_unique<Tensor>(tensor.DataType(), tensor.Shape(), const_cast<void*>(tensor.DataRaw()),
+                                           tensor.Location());
+  auto ml_tensor = DataTypeImpl::GetType<Tensor>();
+  shared_value.Init(p_tensor.release(), ml_tensor, [owner](void* p) { delete static_cast<Tensor*>(p); });
+  return Status::OK();
+}
+
+size_t SharedInitializerStore::GetNumberOfElements() {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  return static_cast<size_t>(std::count_if(values_.begin(), values_.end(),
+                                           [](const auto& entry) { return !entry.second.expired(); }));
+}
+
+}  // namespace onnxruntime
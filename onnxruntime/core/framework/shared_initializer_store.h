@@ -0,0 +1,58 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "core/common/common.h"
+#include "core/framework/data_transfer_manager.h"
+#include "core/framework/ort_value.h"
+#include "core/graph/onnx_protobuf.h"
+#include "core/platform/env.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+
+// Store of the constant initializers of the sessions of an Environment, keyed by their content, so that sessions of
+// models with identical initializers (e.g. fine-tuned variants of a base model) share a single copy of each of them
+// per device.
+//
+// The store does not own the initializers. An initializer is released once no session uses it anymore. The stored
+// tensor holds the allocator of the session that added it, so that allocator outlives the session until the last
+// session sharing one of its initializers is released. When the initializers are allocated from an arena, the
+// whole arena of the first session stays alive with it. Setting
+// kOrtSessionOptionsUseDeviceAllocatorForInitializers allocates them outside of the arenas instead.
+class SharedInitializerStore final {
+ public:
+  SharedInitializerStore() = default;
+
+  // Computes the key of an initializer placed on `device`, made of its type, shape and a 128-bit hash of its data.
+  // `model_path` locates the external data of the initializer, if any.
+  static Status ComputeKey(const Env& env, const PATH_CHAR_TYPE* model_path,
+                           const ONNX_NAMESPACE::TensorProto& tensor_proto, const OrtDevice& device,
+                           std::string& key);
+
+  // Returns a tensor sharing the data of the initializer stored under `key` by another session if it is still used,
+  // otherwise stores `value` under `key` and returns a tensor sharing its data. The data of a stored initializer is
+  // compared with the data of `value`, through `data_transfer_mgr` if it is not on the CPU, so that a collision of
+  // the hashes does not substitute another initializer. The returned value is unallocated in that case, and the
+  // session keeps its own copy.
+  Status GetOrAdd(const std::string& key, const OrtValue& value, const DataTransferManager& data_transfer_mgr,
+                  OrtValue& shared_value);
+
+  // Returns the number of initializers that are still used by a session
+  size_t GetNumberOfElements();
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(SharedInitializerStore);
+
+ private:
+  OrtMutex mutex_;
+  std::unordered_map<std::string, std::weak_ptr<OrtValue>> values_;
+  // the released initializers are removed from values_ when it has doubled in size since the last time
+  size_t purge_size_{16};
+};
+
+}  // namespace onnxruntime
@@ -1,10 +1,15 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 #include "core/framework/stream_execution_context.h"
+#include <algorithm>
 #include "core/framework/execution_provider.h"
 #include "core/framework/execution_frame.h"
 #include "core/framework/bfc_arena.h"
+#include "core/framework/host_shape_evaluation.h"
+#include "core/framework/sequential_executor.h"
 #include "core/framework/session_state.h"
+#include "core/framework/tensor.h"
+#include "core/graph/constants.h"
 #include "core/common/spin_pause.h"
 
 namespace onnxruntime {
@@ -173,6 +178,81 @@ void StreamExecutionContext::RecycleNodeInputs(onnxruntime::NodeIndex node_index
   }
 }
 
+Status StreamExecutionContext::EvaluateHostShapeProgram() {
+  return onnxruntime::EvaluateHostShapeProgram(*session_state_, frame_, host_evaluated_nodes_);
+}
+
+void StreamExecutionContext::EnableDynamicScheduling() {
+  auto& dependency_counts = session_state_->GetExecutionPlan()->node_dependency_counts;
+#ifdef _WIN32
+#pragma warning(push)
+#pragma warning(disable : 26409 26400)
+#endif
+  node_dependencies_ = std::unique_ptr<std::atomic_int[]>(new std::atomic_int[dependency_counts.size()]);
+#ifdef _WIN32
+#pragma warning(pop)
+#endif
+  for (size_t i = 0; i < dependency_counts.size(); ++i) {
+    node_dependencies_[i] = dependency_counts[i];
+  }
+}
+
+bool StreamExecutionContext::DecNodeDependency(onnxruntime::NodeIndex node_index) {
+  return --node_dependencies_[node_index] == 0;
+}
+
+Status StreamExecutionContext::SetEarlyExitValue(int ort_value_idx) {
+  std::string name;
+  ORT_RETURN_IF_ERROR(session_state_->GetOrtValueNameIdxMap().GetName(ort_value_idx, name));
+  const Node* node = session_state_->GetGraphViewer().GetProducerNode(name);
+  ORT_RETURN_IF(node == nullptr, "The early exit value '", name, "' is not produced by a node.");
+  // the predicate is read on the host as soon as the kernel returns, so it must not be computed asynchronously
+  ORT_RETURN_IF(node->GetExecutionProviderType() != kCpuExecutionProvider, "The early exit value '", name,
+                "' must be produced by a node assigned to the CPU execution provider.");
+
+  const auto& output_defs = node->OutputDefs();
+  auto output = std::find_if(output_defs.begin(), output_defs.end(),
+                             [&name](const NodeArg* def) { return def->Name() == name; });
+  early_exit_node_ = node->Index();
+  early_exit_entry_ = frame_.GetNodeOffset(node->Index()) +
+                      static_cast<int>(node->InputDefs().size() + node->ImplicitInputDefs().size() +
+                                       static_cast<size_t>(output - output_defs.begin()));
+  return Status::OK();
+}
+
+Status StreamExecutionContext::EvaluateEarlyExit(onnxruntime::NodeIndex node_index) {
+  if (node_index != early_exit_node_) {
+    return Status::OK();
+  }
+
+  const OrtValue* value = frame_.GetNodeInputOrOutputMLValue(early_exit_entry_);
+  ORT_RETURN_IF(value == nullptr || !value->IsTensor() || value->Get<Tensor>().Shape().Size() != 1,
+                "The early exit value must be a tensor with a single element.");
+  const Tensor& tensor = value->Get<Tensor>();
+  bool exit = false;
+  if (tensor.IsDataType<bool>()) {
+    exit = *tensor.Data<bool>();
+  } else if (tensor.IsDataType<float>()) {
+    exit = *tensor.Data<float>() != 0.0f;
+  } else if (tensor.IsDataType<int32_t>()) {
+    exit = *tensor.Data<int32_t>() != 0;
+  } else if (tensor.IsDataType<int64_t>()) {
+    exit = *tensor.Data<int64_t>() != 0;
+  } else if (tensor.IsDataType<uint8_t>()) {
+    exit = *tensor.Data<uint8_t>() != 0;
+  } else {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "The early exit value must be a bool, float, int32, int64 or uint8 tensor, got ",
+                           DataTypeImpl::ToString(tensor.DataType()));
+  }
+
+  if (exit) {
+    early_exited_.store(true, std::memory_order_relaxed);
+    LOGS(*logger_, VERBOSE) << "Early exit after node " << node_index;
+  }
+  return Status::OK();
+}
+
 void RunSince(size_t stream_idx, StreamExecutionContext& ctx, SessionScope& session_scope, const bool& terminate_flag, size_t since) {
   if (!ctx.TaskStatus().IsOK()) {
     // already in bad status, terminate it
@@ -242,6 +322,60 @@ void RunSince(size_t stream_idx, StreamExecutionContext& ctx, SessionScope& sess
   return;
 }
 
+void RunNode(onnxruntime::NodeIndex node_index, StreamExecutionContext& ctx, SessionScope& session_scope,
+             const bool& terminate_flag) {
+  auto* plan = ctx.GetSessionState().GetExecutionPlan();
+  auto* tp = ctx.GetSessionState().GetInterOpThreadPool();
+  while (true) {
+    if (!ctx.TaskStatus().IsOK()) {
+      // already in bad status, terminate it
+      break;
+    }
+    if (terminate_flag) {
+      Status status_made = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Exiting due to terminate flag being set to true.");
+      ctx.SetStatus(status_made);
+      break;
+    }
+    Status status;
+    ORT_TRY {
+      status = ExecuteKernel(ctx, node_index, plan->node_stream_map[node_index], terminate_flag, session_scope);
+    }
+    ORT_CATCH(const std::exception& ex) {
+      ORT_HANDLE_EXCEPTION([&]() {
+        status = ORT_MAKE_STATUS(ONNXRUNTIME, RUNTIME_EXCEPTION, ex.what());
+      });
+    }
+    if (!status.IsOK()) {
+      ctx.SetStatus(status);
+      break;
+    }
+
+    // keep the first ready node on this thread, and let the other threads steal the rest
+    bool has_next = false;
+    onnxruntime::NodeIndex next = 0;
+    for (auto downstream : plan->node_downstreams[node_index]) {
+      if (!ctx.DecNodeDependency(downstream)) {
+        continue;
+      }
+      if (!has_next) {
+        has_next = true;
+        next = downstream;
+        continue;
+      }
+      // increase the task count before schedule down-stream
+      ctx.AddTask();
+      concurrency::ThreadPool::ScheduleLocal(tp, [downstream, &ctx, &session_scope, &terminate_flag]() {
+        RunNode(downstream, ctx, session_scope, terminate_flag);
+      });
+    }
+    if (!has_next) {
+      break;
+    }
+    node_index = next;
+  }
+  ctx.CompleteTask();
+}
+
 void ScheduleDownstream(StreamExecutionContext& ctx, size_t trigger, bool single_thread_mode,
                         const bool& terminate_flag, SessionScope& session_scope) {
   auto* plan = ctx.GetSessionState().GetExecutionPlan();
@@ -1,6 +1,8 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 #pragma once
+#include <atomic>
+#include <limits>
 #include "core/common/logging/logging.h"
 #include "core/framework/device_stream_collection.h"
 #include "core/framework/execution_frame.h"
@@ -114,6 +116,30 @@ class StreamExecutionContext {
   // Release the OrtValues after a step, based on the execution plan.
   void RecycleNodeInputs(onnxruntime::NodeIndex node_index);
 
+  // Initialize the number of pending producers of each node, see SequentialExecutionPlan::dynamic_scheduling.
+  void EnableDynamicScheduling();
+
+  // Decrease the number of pending producers of a node by 1. Returns true if the node is ready to run.
+  bool DecNodeDependency(onnxruntime::NodeIndex node_index);
+
+  // Evaluate SequentialExecutionPlan::host_shape_program into the frame, before any node runs.
+  Status EvaluateHostShapeProgram();
+
+  // Whether the outputs of a node were computed by EvaluateHostShapeProgram(), its kernel is not run then.
+  bool IsEvaluatedOnHost(onnxruntime::NodeIndex node_index) const {
+    return !host_evaluated_nodes_.empty() && host_evaluated_nodes_[node_index];
+  }
+
+  // Set the value evaluated as early exit predicate, see kOrtRunOptionsConfigEarlyExitValue.
+  Status SetEarlyExitValue(int ort_value_idx);
+
+  // Evaluate the early exit predicate if the node produces it. Must be called before the outputs of the node are
+  // released.
+  Status EvaluateEarlyExit(onnxruntime::NodeIndex node_index);
+
+  // Whether the early exit predicate evaluated to true, the kernels that have not started are not run then.
+  bool EarlyExited() const { return early_exited_.load(std::memory_order_relaxed); }
+
 #ifdef ENABLE_TRAINING
   void SetOrtValueCache(OrtValueCachePtr cache) {
     cache_ = std::move(cache);
@@ -154,6 +180,17 @@ class StreamExecutionContext {
 
   std::unique_ptr<std::atomic_int[]> release_plan_;
 
+  // only used with dynamic scheduling
+  std::unique_ptr<std::atomic_int[]> node_dependencies_;
+
+  // only used with host shape evaluation
+  std::vector<bool> host_evaluated_nodes_;
+
+  // only used with an early exit predicate: the node producing it and the frame entry of the predicate
+  onnxruntime::NodeIndex early_exit_node_{std::numeric_limits<onnxruntime::NodeIndex>::max()};
+  int early_exit_entry_{-1};
+  std::atomic_bool early_exited_{false};
+
   CountDownBarrier remain_tasks_;
 
   Status task_status_{Status::OK()};
@@ -187,6 +224,14 @@ void RunSince(size_t stream_idx,
               const bool& terminate_flag,
               size_t since);
 
+// Execute the node at index 'node_index' with execution context 'ctx', then the downstream nodes that become ready.
+// Only used with dynamic scheduling. The first ready downstream node runs on the current thread, the others are
+// pushed to its queue in the inter-op thread pool, from which idle threads steal them.
+void RunNode(onnxruntime::NodeIndex node_index,
+             StreamExecutionContext& ctx,
+             SessionScope& session_scope,
+             const bool& terminate_flag);
+
 // Schedule the downstream jobs from other streams at 'trigger' step, based on the execution plan.
 void ScheduleDownstream(StreamExecutionContext& ctx,
                         size_t trigger,
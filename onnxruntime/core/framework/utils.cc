@@ -14,6 +14,7 @@
 #include "core/framework/feeds_fetches_manager.h"
 #include "core/framework/kernel_def_builder.h"
 #include "core/framework/kernel_registry_manager.h"
+#include "core/framework/nvtx_ranges.h"
 #include "core/framework/op_kernel_context_internal.h"
 #include "core/framework/session_state.h"
 #include "core/framework/sequential_executor.h"
@@ -103,6 +104,12 @@ static common::Status AllocateHelper(const AllocatorPtr& allocator,
                              p_data,
                              allocator, target_mlvalue);
       }
+    } else if (allocator->IsStreamOrdered() && target_stream) {
+      size_t len = Tensor::CalculateTensorStorageSize(source_tensor.DataType(), source_tensor.Shape());
+      Tensor::InitOrtValue(source_tensor.DataType(),
+                           source_tensor.Shape(),
+                           allocator->StreamOrderedAlloc(len, target_stream),
+                           allocator, target_mlvalue);
     } else {
       Tensor::InitOrtValue(source_tensor.DataType(),
                            source_tensor.Shape(),
@@ -161,6 +168,11 @@ static Status BatchOrCopyMLValue(const SessionState& session_state,
     return Status::OK();
   }
 
+  // an output not computed by a run that exited early, see kOrtRunOptionsConfigEarlyExitValue
+  if (!source_mlvalue.IsAllocated()) {
+    return Status::OK();
+  }
+
   auto allocator = session_state.GetAllocator(copy_info.target_device);
   if (!target_mlvalue.IsAllocated()) {
     ORT_ENFORCE(allocator != nullptr, "Failed to find allocator for device ", copy_info.target_device.ToString());
@@ -442,6 +454,7 @@ static common::Status CopyInputsAcrossDevices(const SessionState& session_state,
                                               std::vector<OrtValue>& new_feeds,
                                               gsl::span<const MLValueCopyInfo> copy_info,
                                               gsl::span<Stream* const> feed_streams) {
+  profiling::NvtxRange nvtx_range("CopyInputsAcrossDevices", profiling::NvtxColor::kMemcpy);
   size_t num_feeds = orig_feeds.size();
   ORT_ENFORCE(copy_info.size() == num_feeds);
   ORT_ENFORCE(feed_streams.size() == num_feeds);
@@ -486,28 +499,31 @@ static common::Status CopyInputsAcrossDevices(const SessionState& session_state,
 }
 
 #ifdef ORT_ENABLE_STREAM
-static void UpdateWithParentStream(DeviceStreamCollection& device_stream_collection,
-                                   Stream* parent_stream) {
+static Status UpdateWithParentStream(const SessionState& session_state,
+                                     DeviceStreamCollection& device_stream_collection,
+                                     Stream* parent_stream) {
   if (parent_stream) {
     // TODO: in theory, we should make current subgraph's stream depends on parent stream.
     // but in current code structure, it causing issues with the resource sharing and stream
     // lifetime. it also may cause additional cost of stream sync for single stream case.
-    // In first phase, let's just put all the subgraph execution on the parent stream.
-    for (size_t i = 0; i < device_stream_collection.NumStreams(); ++i) {
-      auto* stream = device_stream_collection.GetStream(i);
-      if (stream) {
-        // if current logic stream is not on the same EP instance as parent stream
-        // and the EP instance does have async streams (not EP like CPU)
-        // throw error as we don't have the code to setup the dependency at this moment.
-        if (stream->GetDevice() != parent_stream->GetDevice()) {
-          ORT_THROW("Subgraph has nodes running on device: ", stream->GetDevice().Type(),
-                    " while parent graph node running on device: ", parent_stream->GetDevice().Type(),
-                    ", this is not supported yet.");
-        }
-        device_stream_collection.SetDeviceStream(i, parent_stream);
-      }
-    }
+    // So the subgraph execution is put on the parent stream, unless the planner split the subgraph into
+    // branches to run on separate streams (kOrtSessionOptionsConfigConcurrentSubgraphStreams): then the
+    // other streams are forked from the parent stream, and joined by JoinParentStream.
+    ORT_RETURN_IF_ERROR(device_stream_collection.UseParentStream(
+        *parent_stream, session_state.GetStreamHandleRegistryInstance(),
+        session_state.GetExecutionPlan()->concurrent_subgraph_streams));
+  }
+  return Status::OK();
+}
+
+static Status JoinParentStream(const SessionState& session_state,
+                               DeviceStreamCollection* device_stream_collection,
+                               Stream* parent_stream) {
+  if (device_stream_collection && parent_stream) {
+    ORT_RETURN_IF_ERROR(device_stream_collection->JoinParentStream(
+        *parent_stream, session_state.GetStreamHandleRegistryInstance()));
   }
+  return Status::OK();
 }
 #endif
 
@@ -555,6 +571,7 @@ static common::Status CopyOutputsAcrossDevices(const SessionState& session_state
                                                std::vector<OrtValue>& user_fetches,
                                                gsl::span<const MLValueCopyInfo> copy_info,
                                                gsl::span<Stream* const> fetch_streams) {
+  profiling::NvtxRange nvtx_range("CopyOutputsAcrossDevices", profiling::NvtxColor::kMemcpy);
   auto num_outputs = fetches.size();
   user_fetches.resize(num_outputs);
 
@@ -597,13 +614,14 @@ ExecuteGraphImpl(const SessionState& session_state,
                  DeviceStreamCollection* device_stream_collection,
 #endif
                  const bool only_execute_path_to_fetches = false,
-                 Stream* parent_stream = nullptr) {
+                 Stream* parent_stream = nullptr,
+                 int early_exit_value_idx = -1) {
   const auto& feeds_fetches_info = feeds_fetches_manager.GetFeedsFetchesInfo();
   const auto& device_copy_checks = feeds_fetches_manager.GetDeviceCopyChecks();
 #ifdef ORT_ENABLE_STREAM
   auto* execution_plan = session_state.GetExecutionPlan();
   if (device_stream_collection)
-    UpdateWithParentStream(*device_stream_collection, parent_stream);
+    ORT_RETURN_IF_ERROR(UpdateWithParentStream(session_state, *device_stream_collection, parent_stream));
 #else
   ORT_UNUSED_PARAMETER(parent_stream);
 #endif
@@ -629,7 +647,8 @@ ExecuteGraphImpl(const SessionState& session_state,
                                   terminate_flag,
                                   only_execute_path_to_fetches,
                                   // single thread mode
-                                  single_thread_mode));
+                                  single_thread_mode,
+                                  early_exit_value_idx));
     ORT_RETURN_IF_ERROR(status);
   } else {
     auto feeds_to_use = feeds;
@@ -698,7 +717,8 @@ ExecuteGraphImpl(const SessionState& session_state,
 #endif
                                   terminate_flag,
                                   only_execute_path_to_fetches,
-                                  single_thread_mode));
+                                  single_thread_mode,
+                                  early_exit_value_idx));
     ORT_RETURN_IF_ERROR(status);
     InlinedVector<Stream*> fetches_streams;
     fetches_streams.reserve(feeds_fetches_info.fetches_mlvalue_idxs.size());
@@ -736,7 +756,8 @@ common::Status ExecuteGraph(const SessionState& session_state,
                             DeviceStreamCollectionHolder& device_stream_collection_holder,
 #endif
                             bool only_execute_path_to_fetches,
-                            Stream* parent_stream) {
+                            Stream* parent_stream,
+                            int early_exit_value_idx) {
   ORT_RETURN_IF_ERROR(utils::InitializeFeedFetchCopyInfo(session_state, feeds_fetches_manager));
 
   // finalize the copy info using the provided feeds and fetches. will update device_copy_checks in the background
@@ -747,13 +768,16 @@ common::Status ExecuteGraph(const SessionState& session_state,
                                  execution_mode, terminate_flag, logger,
                                  device_stream_collection,
                                  only_execute_path_to_fetches,
-                                 parent_stream);
+                                 parent_stream,
+                                 early_exit_value_idx);
+  ORT_CHECK_AND_SET_RETVAL(JoinParentStream(session_state, device_stream_collection, parent_stream));
   return retval;
 #else
   return ExecuteGraphImpl(session_state, feeds_fetches_manager, feeds, fetches, {},
                           execution_mode, terminate_flag, logger,
                           only_execute_path_to_fetches,
-                          parent_stream);
+                          parent_stream,
+                          early_exit_value_idx);
 #endif
 }
 
@@ -765,6 +789,13 @@ common::Status ExecuteGraph(const SessionState& session_state,
                             DeviceStreamCollectionHolder& device_stream_collection_holder,
 #endif
                             const logging::Logger& logger) {
+  int early_exit_value_idx = -1;
+  const std::string early_exit_value =
+      run_options.config_options.GetConfigOrDefault(kOrtRunOptionsConfigEarlyExitValue, "");
+  if (!early_exit_value.empty()) {
+    ORT_RETURN_IF_ERROR(session_state.GetOrtValueNameIdxMap().GetIdx(early_exit_value, early_exit_value_idx));
+  }
+
   return ExecuteGraph(session_state,
                       feeds_fetches_manager,
                       feeds, fetches,
@@ -774,7 +805,9 @@ common::Status ExecuteGraph(const SessionState& session_state,
 #ifdef ORT_ENABLE_STREAM
                       device_stream_collection_holder,
 #endif
-                      run_options.only_execute_path_to_fetches);
+                      run_options.only_execute_path_to_fetches,
+                      nullptr,
+                      early_exit_value_idx);
 }
 
 #ifdef ENABLE_TRAINING
@@ -794,7 +827,7 @@ common::Status ExecutePartialGraphImpl(const SessionState& session_state, FeedsF
 
   auto* execution_plan = session_state.GetExecutionPlan();
   if (device_stream_collection)
-    UpdateWithParentStream(*device_stream_collection, parent_stream);
+    ORT_RETURN_IF_ERROR(UpdateWithParentStream(session_state, *device_stream_collection, parent_stream));
 
   // see if we can skip copies due to the types of execution providers available
   if (device_copy_checks.status == DeviceCopyCheck::NoCopy) {
@@ -906,6 +939,7 @@ common::Status ExecutePartialGraph(const SessionState& session_state, FeedsFetch
   auto retval = ExecutePartialGraphImpl(session_state, feeds_fetches_manager, feeds, fetches,
                                         logger, state, cache, terminate_flag, device_stream_collection,
                                         partial_graph_index, parent_stream);
+  ORT_CHECK_AND_SET_RETVAL(JoinParentStream(session_state, device_stream_collection, parent_stream));
   if (device_stream_collection)
     ORT_CHECK_AND_SET_RETVAL(device_stream_collection->CleanUp(false));
   return retval;
@@ -924,6 +958,7 @@ common::Status ExecuteSubgraph(const SessionState& session_state, const FeedsFet
 
   auto retval = ExecuteGraphImpl(session_state, feeds_fetches_manager, feeds, fetches, fetch_allocators,
                                  execution_mode, terminate_flag, logger, device_stream_collection, false, parent_stream);
+  ORT_CHECK_AND_SET_RETVAL(JoinParentStream(session_state, device_stream_collection, parent_stream));
   if (device_stream_collection)
     ORT_CHECK_AND_SET_RETVAL(device_stream_collection->CleanUp(false));
 #else
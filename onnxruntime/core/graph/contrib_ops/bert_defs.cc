@@ -593,6 +593,10 @@ constexpr const char* DecoderMaskedMultiHeadAttention_ver1_doc = R"DOC(
 Multihead attention that supports input sequence length of 1.
 Similar to DecoderMaskedSelfAttention but this op excludes QKV MatMul and Bias.
 This op supports both Self and Cross Attention.
+
+The key/value cache of self attention may hold int8 or float8e4m3fn values to reduce its memory. Each head then has
+a scale in key_cache_scale and value_cache_scale: the key and value of the current step are stored as value / scale
+and the cached ones are multiplied by the scale when they are loaded.
 )DOC";
 
 ONNX_MS_OPERATOR_SET_SCHEMA(
@@ -650,15 +654,16 @@ ONNX_MS_OPERATOR_SET_SCHEMA(
                "The keys buffer is re-ordered in such a way that its virtual sub-tensor of shape "
                "(batch_size, num_heads, max_sequence_length, head_size) which may be perceived as being of shape "
                "(batch_size, num_heads, max_sequence_length, head_size / x, x) is reordered to "
-               "become (batch_size, num_heads, head_size / x, max_sequence_length, x) where `x = 16 / sizeof(T)`.",
-               "T",
+               "become (batch_size, num_heads, head_size / x, max_sequence_length, x) where `x = 16 / sizeof(T)`, "
+               "also when the cache holds 8-bit values.",
+               "T_CACHE",
                OpSchema::Optional)
         .Input(6,
                "past_value",
                "past state for value with shape (batch_size, num_heads, past_sequence_length, head_size) for self attention"
                "When past_present_share_buffer is set, "
                "its shape is (batch_size, num_heads, max_sequence_length, head_size). ",
-               "T",
+               "T_CACHE",
                OpSchema::Optional)
         .Input(7,
                "past_sequence_length",
@@ -684,6 +689,16 @@ ONNX_MS_OPERATOR_SET_SCHEMA(
                "Bias tensor with shape (hidden_size + hidden_size + v_hidden_size) from input projection",
                "T",
                OpSchema::Optional)
+        .Input(11,
+               "key_cache_scale",
+               "Scale of each head of an int8 or float8e4m3fn key cache, with shape (num_heads)",
+               "tensor(float)",
+               OpSchema::Optional)
+        .Input(12,
+               "value_cache_scale",
+               "Scale of each head of an int8 or float8e4m3fn value cache, with shape (num_heads)",
+               "tensor(float)",
+               OpSchema::Optional)
         .Output(0,
                 "output",
                 "3D output tensor with shape (batch_size, sequence_length, v_hidden_size)",
@@ -694,7 +709,7 @@ ONNX_MS_OPERATOR_SET_SCHEMA(
                 "If past_present_share_buffer is set, "
                 "its shape is (batch_size, num_heads, max_sequence_length, head_size), "
                 "while effective_seq_length = (past_sequence_length + kv_sequence_length).",
-                "T",
+                "T_CACHE",
                 OpSchema::Optional)
         .Output(2,
                 "present_value",
@@ -702,11 +717,14 @@ ONNX_MS_OPERATOR_SET_SCHEMA(
                 "If past_present_share_buffer is set, "
                 "its shape is (batch_size, num_heads, max_sequence_length, head_size), "
                 "while effective_seq_length = (past_sequence_length + kv_sequence_length).",
-                "T",
+                "T_CACHE",
                 OpSchema::Optional)
         .TypeConstraint("T",
                         {"tensor(float)", "tensor(float16)"},
                         "Constrain input and output types to float tensors.")
+        .TypeConstraint("T_CACHE",
+                        {"tensor(float)", "tensor(float16)", "tensor(int8)", "tensor(float8e4m3fn)"},
+                        "Constrain the key/value cache to the type of the inputs, or to 8-bit types.")
         .TypeConstraint("M",
                         {"tensor(int32)"},
                         "Constrain mask index to integer types")
@@ -797,6 +815,285 @@ ONNX_MS_OPERATOR_SET_SCHEMA(
           MultiHeadAttentionTypeAndShapeInference(ctx, 6);
         }));
 
+constexpr const char* GroupQueryAttention_ver1_doc = R"DOC(
+Group Query Self Attention with a key/value cache of fixed capacity. Heads of the query are split into
+kv_num_heads groups, and all query heads of a group attend to the same key and value head. Multi-query attention
+is the special case kv_num_heads = 1.
+
+The attention is causal: query token i of a batch entry attends to the cached tokens of that entry and to the new
+tokens up to and including token i.
+
+past_key and past_value are buffers of shape (batch_size, kv_num_heads, max_sequence_length, head_size) holding
+past_seqlens[b] valid tokens for batch entry b. The new key and value are written at positions
+[past_seqlens[b], past_seqlens[b] + sequence_length) and the updated buffers are returned as present_key and
+present_value. The outputs may share the buffers of the inputs so that the cache is updated in place instead of
+being copied on every step. past_seqlens[b] + sequence_length must not exceed max_sequence_length.
+
+When do_rotary is 1, rotary positional embeddings are applied to the query and the new key before attention, which
+saves a separate RotaryEmbedding node for each of them. The position of new token s of batch entry b is
+past_seqlens[b] + s.
+
+The cache may hold int8 or float8e4m3fn values to reduce its memory, in which case past_key and past_value are
+required and key_cache_scale and value_cache_scale give the scale of each key/value head. The new key and value
+are stored as value / scale, and the cached ones are multiplied by the scale when they are loaded for attention.
+)DOC";
+
+ONNX_MS_OPERATOR_SET_SCHEMA(
+    GroupQueryAttention, 1,
+    OpSchema()
+        .SetDoc(GroupQueryAttention_ver1_doc)
+        .Attr("num_heads", "Number of attention heads for q", AttributeProto::INT)
+        .Attr("kv_num_heads", "Number of attention heads for k and v", AttributeProto::INT)
+        .Attr("scale",
+              "Custom scale will be used if specified. Default value is 1/sqrt(head_size)",
+              AttributeProto::FLOAT,
+              OPTIONAL_VALUE)
+        .Attr("do_rotary",
+              "Whether to apply rotary positional embeddings to query and key. Default value is 0.",
+              AttributeProto::INT,
+              OPTIONAL_VALUE)
+        .Attr("rotary_interleaved",
+              "Rotate adjacent pairs of elements when 1, or the two halves of each head when 0. "
+              "Only used when do_rotary is 1. Default value is 0.",
+              AttributeProto::INT,
+              OPTIONAL_VALUE)
+        .Input(0,
+               "query",
+               "Query with shape (batch_size, sequence_length, hidden_size)",
+               "T")
+        .Input(1,
+               "key",
+               "Key with shape (batch_size, sequence_length, kv_hidden_size)",
+               "T")
+        .Input(2,
+               "value",
+               "Value with shape (batch_size, sequence_length, kv_hidden_size)",
+               "T")
+        .Input(3,
+               "past_key",
+               "Key cache with shape (batch_size, kv_num_heads, max_sequence_length, head_size)",
+               "T_CACHE",
+               OpSchema::Optional)
+        .Input(4,
+               "past_value",
+               "Value cache with shape (batch_size, kv_num_heads, max_sequence_length, head_size)",
+               "T_CACHE",
+               OpSchema::Optional)
+        .Input(5,
+               "past_seqlens",
+               "Number of valid tokens in the cache for each batch entry, with shape (batch_size). "
+               "Treated as zeros when not provided",
+               "M",
+               OpSchema::Optional)
+        .Input(6,
+               "cos_cache",
+               "2D tensor with shape (max_sequence_length, head_size / 2). Required when do_rotary is 1",
+               "T",
+               OpSchema::Optional)
+        .Input(7,
+               "sin_cache",
+               "2D tensor with shape (max_sequence_length, head_size / 2). Required when do_rotary is 1",
+               "T",
+               OpSchema::Optional)
+        .Input(8,
+               "key_cache_scale",
+               "Scale of each head of an int8 or float8e4m3fn key cache, with shape (kv_num_heads)",
+               "tensor(float)",
+               OpSchema::Optional)
+        .Input(9,
+               "value_cache_scale",
+               "Scale of each head of an int8 or float8e4m3fn value cache, with shape (kv_num_heads)",
+               "tensor(float)",
+               OpSchema::Optional)
+        .Output(0,
+                "output",
+                "3D output tensor with shape (batch_size, sequence_length, hidden_size)",
+                "T")
+        .Output(1,
+                "present_key",
+                "Updated key cache with the shape of past_key, or with shape "
+                "(batch_size, kv_num_heads, sequence_length, head_size) when past_key is not provided",
+                "T_CACHE")
+        .Output(2,
+                "present_value",
+                "Updated value cache with the shape of past_value, or with shape "
+                "(batch_size, kv_num_heads, sequence_length, head_size) when past_value is not provided",
+                "T_CACHE")
+        .TypeConstraint("T", {"tensor(float)", "tensor(float16)"}, "Constrain input and output to float tensors.")
+        .TypeConstraint("T_CACHE",
+                        {"tensor(float)", "tensor(float16)", "tensor(int8)", "tensor(float8e4m3fn)"},
+                        "Constrain the key/value cache to the type of the inputs, or to 8-bit types.")
+        .TypeConstraint("M", {"tensor(int32)"}, "Constrain past sequence lengths to int32 tensor.")
+        .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+          propagateElemTypeFromInputToOutput(ctx, 0, 0);
+          const bool has_past = ctx.getNumInputs() > 4 && ctx.getInputType(3) != nullptr;
+          propagateElemTypeFromInputToOutput(ctx, has_past ? 3 : 0, 1);
+          propagateElemTypeFromInputToOutput(ctx, has_past ? 4 : 0, 2);
+
+          if (hasInputShape(ctx, 0)) {
+            propagateShapeFromInputToOutput(ctx, 0, 0);
+          }
+
+          if (hasInputShape(ctx, 3) && hasInputShape(ctx, 4)) {
+            propagateShapeFromInputToOutput(ctx, 3, 1);
+            propagateShapeFromInputToOutput(ctx, 4, 2);
+            return;
+          }
+
+          if (!hasInputShape(ctx, 1)) {
+            return;
+          }
+          auto& key_shape = getInputShape(ctx, 1);
+          if (key_shape.dim_size() != 3) {
+            fail_shape_inference("key shall be a 3D tensor");
+          }
+
+          int64_t kv_num_heads = getAttribute(ctx, "kv_num_heads", 0);
+          if (kv_num_heads <= 0) {
+            fail_shape_inference("kv_num_heads shall be positive");
+          }
+
+          ONNX_NAMESPACE::TensorShapeProto present_shape;
+          *present_shape.add_dim() = key_shape.dim(0);
+          present_shape.add_dim()->set_dim_value(kv_num_heads);
+          *present_shape.add_dim() = key_shape.dim(1);
+          if (key_shape.dim(2).has_dim_value()) {
+            present_shape.add_dim()->set_dim_value(key_shape.dim(2).dim_value() / kv_num_heads);
+          } else {
+            present_shape.add_dim();
+          }
+          updateOutputShape(ctx, 1, present_shape);
+          updateOutputShape(ctx, 2, present_shape);
+        }));
+
+constexpr const char* PagedAttention_ver1_doc = R"DOC(
+Group Query Self Attention over a block-paged key/value cache. The cache is a pool of blocks of block_size tokens
+with shape (num_blocks, kv_num_heads, block_size, head_size). Token t of batch entry b is stored in block
+block_tables[b][t / block_size] at offset t % block_size, so sequences of different lengths only hold the blocks
+they use instead of a buffer of the maximum length.
+
+past_seqlens[b] is the number of tokens of batch entry b already in the cache. The new key and value are written
+at positions [past_seqlens[b], past_seqlens[b] + sequence_length), and the blocks covering these positions must
+already be listed in block_tables. The attention is causal, and heads of the query are grouped over the key/value
+heads as in GroupQueryAttention.
+
+key_cache_out and value_cache_out may share the buffers of key_cache and value_cache so that the cache is updated
+in place.
+)DOC";
+
+ONNX_MS_OPERATOR_SET_SCHEMA(
+    PagedAttention, 1,
+    OpSchema()
+        .SetDoc(PagedAttention_ver1_doc)
+        .Attr("num_heads", "Number of attention heads for q", AttributeProto::INT)
+        .Attr("kv_num_heads", "Number of attention heads for k and v", AttributeProto::INT)
+        .Attr("scale",
+              "Custom scale will be used if specified. Default value is 1/sqrt(head_size)",
+              AttributeProto::FLOAT,
+              OPTIONAL_VALUE)
+        .Input(0,
+               "query",
+               "Query with shape (batch_size, sequence_length, hidden_size)",
+               "T")
+        .Input(1,
+               "key",
+               "Key with shape (batch_size, sequence_length, kv_hidden_size)",
+               "T")
+        .Input(2,
+               "value",
+               "Value with shape (batch_size, sequence_length, kv_hidden_size)",
+               "T")
+        .Input(3,
+               "key_cache",
+               "Key cache blocks with shape (num_blocks, kv_num_heads, block_size, head_size)",
+               "T")
+        .Input(4,
+               "value_cache",
+               "Value cache blocks with shape (num_blocks, kv_num_heads, block_size, head_size)",
+               "T")
+        .Input(5,
+               "block_tables",
+               "Blocks of each batch entry in token order, with shape (batch_size, max_blocks_per_sequence)",
+               "M")
+        .Input(6,
+               "past_seqlens",
+               "Number of tokens in the cache for each batch entry, with shape (batch_size)",
+               "M")
+        .Output(0,
+                "output",
+                "3D output tensor with shape (batch_size, sequence_length, hidden_size)",
+                "T")
+        .Output(1,
+                "key_cache_out",
+                "Updated key cache with the shape of key_cache",
+                "T")
+        .Output(2,
+                "value_cache_out",
+                "Updated value cache with the shape of value_cache",
+                "T")
+        .TypeConstraint("T", {"tensor(float)", "tensor(float16)"}, "Constrain input and output to float tensors.")
+        .TypeConstraint("M", {"tensor(int32)"}, "Constrain block tables and sequence lengths to int32 tensors.")
+        .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+          propagateElemTypeFromInputToOutput(ctx, 0, 0);
+          propagateElemTypeFromInputToOutput(ctx, 0, 1);
+          propagateElemTypeFromInputToOutput(ctx, 0, 2);
+          if (hasInputShape(ctx, 0)) {
+            propagateShapeFromInputToOutput(ctx, 0, 0);
+          }
+          if (hasInputShape(ctx, 3)) {
+            propagateShapeFromInputToOutput(ctx, 3, 1);
+          }
+          if (hasInputShape(ctx, 4)) {
+            propagateShapeFromInputToOutput(ctx, 4, 2);
+          }
+        }));
+
+constexpr const char* RotaryEmbedding_ver1_doc = R"DOC(
+RotaryEmbedding is the implementation of rotary positional embeddings (RoPE). Each head of the input is split
+into pairs of elements and each pair is rotated by an angle given by cos_cache and sin_cache at the position of
+its token. With interleaved = 0 element i of a head is paired with element i + head_size / 2, otherwise elements
+2i and 2i + 1 are paired.
+
+position_ids is either a tensor of shape (batch_size, sequence_length) giving the position of each token, or a
+tensor of shape (1) giving the position of the first token, with the following tokens at consecutive positions.
+)DOC";
+
+ONNX_MS_OPERATOR_SET_SCHEMA(
+    RotaryEmbedding, 1,
+    OpSchema()
+        .SetDoc(RotaryEmbedding_ver1_doc)
+        .Attr("interleaved",
+              "Rotate adjacent pairs of elements when 1, or the two halves of each head when 0. Default value is 0.",
+              AttributeProto::INT,
+              OPTIONAL_VALUE)
+        .Input(0,
+               "input",
+               "3D tensor with shape (batch_size, sequence_length, hidden_size) or 4D tensor with shape "
+               "(batch_size, num_heads, sequence_length, head_size)",
+               "T")
+        .Input(1,
+               "position_ids",
+               "1D tensor with shape (1) or 2D tensor with shape (batch_size, sequence_length)",
+               "M")
+        .Input(2,
+               "cos_cache",
+               "2D tensor with shape (max_sequence_length, head_size / 2)",
+               "T")
+        .Input(3,
+               "sin_cache",
+               "2D tensor with shape (max_sequence_length, head_size / 2)",
+               "T")
+        .Output(0,
+                "output",
+                "Tensor with the same shape as input",
+                "T")
+        .TypeConstraint("T", {"tensor(float)", "tensor(float16)"}, "Constrain input and output types to float tensors.")
+        .TypeConstraint("M", {"tensor(int64)"}, "Constrain position_ids to integer tensor.")
+        .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+          propagateElemTypeFromInputToOutput(ctx, 0, 0);
+          propagateShapeFromInputToOutput(ctx, 0, 0);
+        }));
+
 constexpr const char* Longformer_Attention_doc = R"DOC(
 Longformer Self Attention with a local context and a global context. Tokens attend locally: Each token
 attends to its W previous tokens and W succeeding tokens with W being the window length. A selected few tokens
@@ -629,6 +629,145 @@ ONNX_MS_OPERATOR_SET_SCHEMA(
           return true;
         }));
 
+constexpr const char* FusedElementwise_ver1_doc = R"DOC(
+FusedElementwise evaluates a chain of elementwise operators in a single pass over its output, so that the
+intermediate results are never written to memory. The chain is given as a list of steps in evaluation order.
+Each step applies the operator named in ops to one or two operands. Operand k refers to input k when k is less
+than the number of inputs, and to the result of step k - number of inputs otherwise. The result of the last step
+is the output.
+
+The inputs are broadcast to the output shape following the multidirectional broadcasting rules, which gives the
+same result as broadcasting each intermediate result since every step is elementwise. Supported operators are
+Add, Sub, Mul, Div, Max, Min and PRelu with two operands, and Neg, Abs, Relu, Sigmoid, Tanh, Exp, Sqrt,
+Reciprocal, Erf, LeakyRelu, Gelu and QuickGelu with one operand.
+)DOC";
+ONNX_MS_OPERATOR_SET_SCHEMA(
+    FusedElementwise, 1,
+    OpSchema()
+        .SetDomain(kMSDomain)
+        .SinceVersion(1)
+        .SetDoc(FusedElementwise_ver1_doc)
+        .Attr("ops", "Operator type of each step.", AttributeProto::STRINGS)
+        .Attr("operands",
+              "Two operands per step. The second operand of a step with one operand is -1.",
+              AttributeProto::INTS)
+        .Attr("alphas", "Alpha of each step, used by LeakyRelu and QuickGelu.", AttributeProto::FLOATS,
+              OPTIONAL_VALUE)
+        .Input(0, "inputs", "Inputs of the chain.", "T", OpSchema::Variadic)
+        .Output(0, "Y", "Result of the last step, with the broadcast shape of the inputs.", "T")
+        .TypeConstraint("T", {"tensor(float)"}, "Constrain input and output types to float tensors.")
+        .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+          propagateElemTypeFromInputToOutput(ctx, 0, 0);
+          const size_t num_inputs = ctx.getNumInputs();
+          if (hasNInputShapes(ctx, static_cast<int>(num_inputs))) {
+            std::vector<const TensorShapeProto*> shapes;
+            for (size_t i = 0; i < num_inputs; i++) {
+              shapes.push_back(&ctx.getInputType(i)->tensor_type().shape());
+            }
+            multidirectionalBroadcastShapeInference(
+                shapes, *ctx.getOutputType(0)->mutable_tensor_type()->mutable_shape());
+          }
+        }));
+
+constexpr const char* EmbeddingBag_ver1_doc = R"DOC(
+EmbeddingBag looks up rows of the embedding table weight and reduces each bag of rows to one output row with
+the sum, mean or max, without materializing the gathered rows.
+
+With offsets, indices is 1-D and bag b holds the lookups from offsets[b] up to offsets[b + 1], or up to the end
+of indices for the last bag. Without offsets, indices is 2-D and each of its rows is a bag. Negative indices
+count from the end of the table. An empty bag produces a row of zeros.
+
+per_sample_weights scales each looked up row before the sum and is only supported in sum mode. An int8 table is
+dequantized with one scale per row.
+)DOC";
+
+ONNX_MS_OPERATOR_SET_SCHEMA(
+    EmbeddingBag, 1,
+    OpSchema()
+        .SetDoc(EmbeddingBag_ver1_doc)
+        .Attr("mode", "Reduction of each bag: sum, mean or max.", AttributeProto::STRING, std::string("sum"))
+        .Input(0, "weight", "Embedding table of shape (num_embeddings, embedding_dim).", "T1")
+        .Input(1, "indices", "Rows to look up, 1-D with offsets or (num_bags, bag_size) without.", "Tind")
+        .Input(2, "offsets", "1-D start of each bag in indices.", "Tind", OpSchema::Optional)
+        .Input(3, "per_sample_weights", "Weight of each lookup, with the shape of indices.", "T",
+               OpSchema::Optional)
+        .Input(4, "scales", "1-D scale of each row of an int8 weight.", "T", OpSchema::Optional)
+        .Output(0, "output", "Reduced bags of shape (num_bags, embedding_dim).", "T")
+        .TypeConstraint("T1", {"tensor(float)", "tensor(float16)", "tensor(int8)"},
+                        "Constrain the embedding table to float, float16 or int8 tensors.")
+        .TypeConstraint("Tind", {"tensor(int32)", "tensor(int64)"}, "Constrain indices to integer types.")
+        .TypeConstraint("T", {"tensor(float)"}, "Constrain the output to float tensors.")
+        .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+          updateOutputElemType(ctx, 0, ONNX_NAMESPACE::TensorProto::FLOAT);
+          if (!hasInputShape(ctx, 0) || !hasInputShape(ctx, 1)) {
+            return;
+          }
+
+          const auto& weight_shape = getInputShape(ctx, 0);
+          if (weight_shape.dim_size() != 2) {
+            fail_shape_inference("weight must be 2-D");
+          }
+
+          ONNX_NAMESPACE::TensorShapeProto output_shape;
+          if (ctx.hasInput(2)) {
+            if (!hasInputShape(ctx, 2)) {
+              return;
+            }
+            *output_shape.add_dim() = getInputShape(ctx, 2).dim(0);
+          } else {
+            const auto& indices_shape = getInputShape(ctx, 1);
+            if (indices_shape.dim_size() != 2) {
+              fail_shape_inference("indices must be 2-D without offsets");
+            }
+            *output_shape.add_dim() = indices_shape.dim(0);
+          }
+          *output_shape.add_dim() = weight_shape.dim(1);
+          updateOutputShape(ctx, 0, output_shape);
+        }));
+
+constexpr const char* ImagePreprocess_ver1_doc = R"DOC(
+ImagePreprocess turns uint8 images of shape (N, H, W, C) into the normalized float (N, C, size[0], size[1]) input of
+a vision model in a single pass, in place of Resize, Cast, Sub, Div and Transpose nodes.
+
+The images are resized as Resize with mode linear and the half_pixel coordinate transformation mode does, without
+rounding the resized values, and each value x of channel c becomes (x * scale - mean[c]) / std[c]. mean and std
+have one value per channel, or a single value for all the channels.
+)DOC";
+
+ONNX_MS_OPERATOR_SET_SCHEMA(
+    ImagePreprocess, 1,
+    OpSchema()
+        .SetDoc(ImagePreprocess_ver1_doc)
+        .Attr("size", "Height and width of the output images.", AttributeProto::INTS)
+        .Attr("scale", "Scale of the resized values before the normalization, e.g. 1/255.", AttributeProto::FLOAT,
+              1.0f)
+        .Attr("mean", "Mean subtracted from the scaled values.", AttributeProto::FLOATS, OPTIONAL_VALUE)
+        .Attr("std", "Standard deviation dividing the centered values.", AttributeProto::FLOATS, OPTIONAL_VALUE)
+        .Input(0, "X", "Images of shape (N, H, W, C).", "tensor(uint8)")
+        .Output(0, "Y", "Normalized images of shape (N, C, size[0], size[1]).", "tensor(float)")
+        .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+          updateOutputElemType(ctx, 0, ONNX_NAMESPACE::TensorProto::FLOAT);
+          const auto* size = ctx.getAttribute("size");
+          if (size == nullptr || size->ints_size() != 2) {
+            fail_shape_inference("size must have two values");
+          }
+          if (!hasInputShape(ctx, 0)) {
+            return;
+          }
+
+          const auto& input_shape = getInputShape(ctx, 0);
+          if (input_shape.dim_size() != 4) {
+            fail_shape_inference("X must be 4-D");
+          }
+
+          ONNX_NAMESPACE::TensorShapeProto output_shape;
+          *output_shape.add_dim() = input_shape.dim(0);
+          *output_shape.add_dim() = input_shape.dim(3);
+          output_shape.add_dim()->set_dim_value(size->ints(0));
+          output_shape.add_dim()->set_dim_value(size->ints(1));
+          updateOutputShape(ctx, 0, output_shape);
+        }));
+
 // Used to be ONNX 1.7 Inverse(12)
 // Comment out docs not to increase the binary size
 //
@@ -827,6 +966,31 @@ ONNX_MS_OPERATOR_SET_SCHEMA(Trilu, 1,
                                   }
                                 }));
 
+constexpr const char* TritonOp_ver1_doc = R"DOC(
+TritonOp runs a GPU kernel compiled ahead of time by Triton, or a cubin with the same calling convention, that is
+registered in the group named func_name followed by the data type of the inputs, e.g. "my_kernel_fp16". The groups
+are built from the kernel scripts listed in onnxruntime_TRITON_KERNEL_SCRIPTS.
+
+The inputs are viewed as (n_rows, n_cols) matrices, where n_cols is the last dimension of the first input. Every
+input has the shape of the first input, or n_cols elements that apply to all the rows. The kernel is called with
+(Y, inputs..., n_rows, n_cols) on a grid of ceil(n_rows / ROW_BLOCK_SIZE) programs, where the constants BLOCK_SIZE
+and ROW_BLOCK_SIZE the kernel is compiled with give the columns and the rows that a program covers. A kernel without
+BLOCK_SIZE supports any n_cols, and one without ROW_BLOCK_SIZE covers a row.
+
+When the group has several kernels, TunableOp selects the fastest one that supports n_cols, or the one with the
+smallest BLOCK_SIZE that does when tuning is disabled.
+)DOC";
+
+ONNX_MS_OPERATOR_SET_SCHEMA(
+    TritonOp, 1,
+    OpSchema()
+        .SetDoc(TritonOp_ver1_doc)
+        .Attr("func_name", "Name of the kernel group, without the data type suffix.", AttributeProto::STRING)
+        .Input(0, "inputs", "Inputs of the kernel.", "T", OpSchema::Variadic)
+        .Output(0, "Y", "Output of the kernel, with the shape of the first input.", "T")
+        .TypeConstraint("T", {"tensor(float)", "tensor(float16)"}, "Constrain input and output types to float tensors.")
+        .TypeAndShapeInferenceFunction(ONNX_NAMESPACE::propagateShapeAndTypeFromFirstInput));
+
 ONNX_MS_OPERATOR_SET_SCHEMA(BiasSoftmax, 1,
                             OpSchema()
                                 .SetDoc(
@@ -1656,6 +1820,88 @@ ONNX_MS_OPERATOR_SET_SCHEMA(Tokenizer, 1,
                                   updateOutputShape(ctx, 0, output_shape);
                                 }));
 
+// Shape inference of WordPieceTokenizer and BpeTokenizer, the outputs are (batch_size, max_tokens)
+void SubwordTokenizerShapeInference(ONNX_NAMESPACE::InferenceContext& ctx) {
+  for (size_t i = 0; i < ctx.getNumOutputs(); ++i) {
+    updateOutputElemType(ctx, i, ONNX_NAMESPACE::TensorProto::INT64);
+  }
+  if (!hasInputShape(ctx, 0)) {
+    return;
+  }
+
+  const auto& input_shape = getInputShape(ctx, 0);
+  if (input_shape.dim_size() != 1) {
+    fail_shape_inference("X must be 1-D");
+  }
+
+  ONNX_NAMESPACE::TensorShapeProto output_shape;
+  *output_shape.add_dim() = input_shape.dim(0);
+  output_shape.add_dim();
+  for (size_t i = 0; i < ctx.getNumOutputs(); ++i) {
+    updateOutputShape(ctx, i, output_shape);
+  }
+}
+
+constexpr const char* WordPieceTokenizer_ver1_doc = R"DOC(
+WordPieceTokenizer maps each string of X to the ids of its WordPiece tokens, as the BERT tokenizer does.
+
+Each string is split into words at whitespace, and every ASCII punctuation character becomes a word of its own.
+Each word is then split into the longest pieces of the vocab from its start, the pieces after the first one being
+matched against the vocab entries starting with suffix_indicator. A word longer than max_input_chars_per_word
+characters, or with a part matching no piece, becomes unk_token. The id of a token is its position in vocab.
+Casing is left to the model, e.g. a StringNormalizer before this op.
+
+The rows of Y are padded with pad_id up to the largest number of tokens in the batch, and mask marks the tokens
+with 1 and the padding with 0.
+)DOC";
+
+ONNX_MS_OPERATOR_SET_SCHEMA(
+    WordPieceTokenizer, 1,
+    OpSchema()
+        .SetDoc(WordPieceTokenizer_ver1_doc)
+        .Attr("vocab", "The tokens, the id of a token is its position.", AttributeProto::STRINGS)
+        .Attr("unk_token", "The token of unknown words, which must be in vocab.", AttributeProto::STRING,
+              std::string("[UNK]"))
+        .Attr("suffix_indicator", "Prefix of the vocab entries continuing a word.", AttributeProto::STRING,
+              std::string("##"))
+        .Attr("max_input_chars_per_word", "Longest word which is split into pieces, in characters.",
+              AttributeProto::INT, static_cast<int64_t>(100))
+        .Attr("pad_id", "The id padding the rows of Y.", AttributeProto::INT, static_cast<int64_t>(0))
+        .Input(0, "X", "1-D UTF-8 strings to tokenize.", "tensor(string)")
+        .Output(0, "Y", "Token ids of shape (batch_size, max_tokens).", "tensor(int64)")
+        .Output(1, "mask", "1 for the tokens of Y and 0 for its padding.", "tensor(int64)", OpSchema::Optional)
+        .TypeAndShapeInferenceFunction(SubwordTokenizerShapeInference));
+
+constexpr const char* BpeTokenizer_ver1_doc = R"DOC(
+BpeTokenizer maps each string of X to the ids of its byte pair encoding tokens.
+
+Each string is split into words at whitespace, and every ASCII punctuation character becomes a word of its own.
+Each word starts as its UTF-8 characters, the last one with end_of_word_suffix appended, and the adjacent pair of
+the lowest rank in merges is merged until no pair can be merged. A merge is the two tokens separated by a space,
+its rank is its position in merges, and the tokens and their concatenation must be in vocab. A character which is
+not in vocab becomes unk_token, or is dropped if unk_token is empty. The id of a token is its position in vocab.
+
+The rows of Y are padded with pad_id up to the largest number of tokens in the batch, and mask marks the tokens
+with 1 and the padding with 0.
+)DOC";
+
+ONNX_MS_OPERATOR_SET_SCHEMA(
+    BpeTokenizer, 1,
+    OpSchema()
+        .SetDoc(BpeTokenizer_ver1_doc)
+        .Attr("vocab", "The tokens, the id of a token is its position.", AttributeProto::STRINGS)
+        .Attr("merges", "The merges in priority order, each one being two tokens separated by a space.",
+              AttributeProto::STRINGS, OPTIONAL_VALUE)
+        .Attr("unk_token", "The token of unknown characters, which must be in vocab if set.", AttributeProto::STRING,
+              std::string(""))
+        .Attr("end_of_word_suffix", "Suffix of the last character of each word.", AttributeProto::STRING,
+              std::string(""))
+        .Attr("pad_id", "The id padding the rows of Y.", AttributeProto::INT, static_cast<int64_t>(0))
+        .Input(0, "X", "1-D UTF-8 strings to tokenize.", "tensor(string)")
+        .Output(0, "Y", "Token ids of shape (batch_size, max_tokens).", "tensor(int64)")
+        .Output(1, "mask", "1 for the tokens of Y and 0 for its padding.", "tensor(int64)", OpSchema::Optional)
+        .TypeAndShapeInferenceFunction(SubwordTokenizerShapeInference));
+
 ONNX_MS_OPERATOR_SET_SCHEMA(MatMulInteger16, 1,
                             OpSchema()
                                 .SetDoc(R"DOC(
@@ -1800,6 +2046,64 @@ ONNX_MS_OPERATOR_SET_SCHEMA(FusedMatMulActivation, 1,
                                 .SetDoc(FusedMatMulActivation_doc)
                                 .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) { FusedMatMulShapeInference(ctx); }));
 
+constexpr const char* GemmFloat8_doc = R"DOC(
+General matrix multiplication with float 8 inputs:
+Y = activation(alpha * (scaleA * A) * (scaleB * B)' + beta * C)
+
+A has the shape (M, K) and B the shape (N, K), i.e. transA must be 0 and transB must be 1, so that the reduction
+dimension of both is contiguous as the float 8 tensor cores require. scaleA and scaleB are the per tensor scales
+of the quantization of A and B, e.g. computed by QuantizeLinear, and default to 1. C has the shape (M, N) and the
+type of Y. A and B cannot both be float8e5m2.
+)DOC";
+
+ONNX_MS_OPERATOR_SET_SCHEMA(GemmFloat8, 1,
+                            OpSchema()
+                                .SetDoc(GemmFloat8_doc)
+                                .Input(0, "A", "Input tensor A of shape (M, K).", "TA")
+                                .Input(1, "B", "Input tensor B of shape (N, K).", "TB")
+                                .Input(2, "C", "Optional input tensor C of shape (M, N).", "TR", OpSchema::Optional)
+                                .Input(3, "scaleA", "Scale of A, a scalar.", "TS", OpSchema::Optional)
+                                .Input(4, "scaleB", "Scale of B, a scalar.", "TS", OpSchema::Optional)
+                                .Output(0, "Y", "Output tensor of shape (M, N).", "TR")
+                                .Attr("transA", "Whether A should be transposed. Only 0 is supported.",
+                                      AttributeProto::INT, static_cast<int64_t>(0))
+                                .Attr("transB", "Whether B should be transposed. Only 1 is supported.",
+                                      AttributeProto::INT, static_cast<int64_t>(1))
+                                .Attr("alpha", "Scalar multiplier for the product of the input tensors.",
+                                      AttributeProto::FLOAT, 1.0f)
+                                .Attr("beta", "Scalar multiplier for C.", AttributeProto::FLOAT, 0.0f)
+                                .Attr("activation", "Activation applied to the result: NONE, RELU or GELU.",
+                                      AttributeProto::STRING, std::string("NONE"))
+                                .Attr("dtype", "Type of the output, as the attribute 'to' of Cast. The default is float.",
+                                      AttributeProto::INT, static_cast<int64_t>(ONNX_NAMESPACE::TensorProto::FLOAT))
+                                .TypeConstraint("TA", {"tensor(float8e4m3fn)", "tensor(float8e5m2)"},
+                                                "Constrain A to float 8 tensors.")
+                                .TypeConstraint("TB", {"tensor(float8e4m3fn)", "tensor(float8e5m2)"},
+                                                "Constrain B to float 8 tensors.")
+                                .TypeConstraint("TR", {"tensor(float)", "tensor(float16)", "tensor(bfloat16)"},
+                                                "Constrain C and Y to float tensors.")
+                                .TypeConstraint("TS", {"tensor(float)"}, "Constrain the scales to float tensors.")
+                                .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+                                  const auto dtype = getAttribute(ctx, "dtype",
+                                                                  static_cast<int64_t>(ONNX_NAMESPACE::TensorProto::FLOAT));
+                                  updateOutputElemType(ctx, 0, static_cast<int32_t>(dtype));
+                                  if (!hasNInputShapes(ctx, 2)) {
+                                    return;
+                                  }
+
+                                  const auto& a_shape = getInputShape(ctx, 0);
+                                  const auto& b_shape = getInputShape(ctx, 1);
+                                  if (a_shape.dim_size() != 2 || b_shape.dim_size() != 2) {
+                                    fail_shape_inference("GemmFloat8 expects 2D A and B.");
+                                  }
+                                  const bool trans_a = getAttribute(ctx, "transA", 0) != 0;
+                                  const bool trans_b = getAttribute(ctx, "transB", 1) != 0;
+                                  ONNX_NAMESPACE::TensorShapeProto output_shape;
+                                  *output_shape.add_dim() = a_shape.dim(trans_a ? 1 : 0);
+                                  *output_shape.add_dim() = b_shape.dim(trans_b ? 0 : 1);
+                                  updateOutputShape(ctx, 0, output_shape);
+                                }));
+
 ONNX_MS_OPERATOR_SET_SCHEMA(SparseToDenseMatMul, 1,
                             OpSchema()
                                 .Input(0, "A", "2-dimensional sparse matrix A. Either COO or CSR format", "T")
@@ -1837,6 +2141,150 @@ ONNX_MS_OPERATOR_SET_SCHEMA(SparseToDenseMatMul, 1,
                                   sparseCompatibleMatmulShapeInference(ctx, 0, 1);
                                 }));
 
+constexpr const char* MatMulFpQ4_ver1_doc = R"DOC(
+Matrix product with right hand matrix being pre-packed and quantized int4 data blob.
+During quantization, the matrix is divided into blocks, where each block is a
+contiguous subset inside each column. Each block is quantized into a
+sequence of 4b integers with a scaling factor and an optional offset.
+Currently 3 quantization types are supported:
+(0): block size 32, no offset, (1): block size 32, with offset, (2): block size 64, no offset,
+(3): block size 128, no offset.
+The packed blob is produced by MlasQ4GemmPackB.
+)DOC";
+
+ONNX_MS_OPERATOR_SET_SCHEMA(MatMulFpQ4, 1,
+                            OpSchema()
+                                .SetDoc(MatMulFpQ4_ver1_doc)
+                                .Attr("blk_quant_type", "Quantization type", AttributeProto::INT, static_cast<int64_t>(1))
+                                .Input(0, "A", "N-dimensional matrix A", "T1")
+                                .Input(1, "B", "1-dimensional data blob", "T2")
+                                .Input(2, "B_shape", "Shape information of B. Must be a constant 2D tensor [K, N]", "T3")
+                                .Output(0, "Y", "Matrix multiply results from A * B", "T1")
+                                .TypeConstraint("T1", {"tensor(float)"}, "Constrain input and output types to float tensors.")
+                                .TypeConstraint("T2", {"tensor(uint8)"}, "Constrain quantized weight types to uint8.")
+                                .TypeConstraint("T3", {"tensor(int64)"}, "Constrain shape of weight to int64.")
+                                .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+                                  // Type inference
+                                  propagateElemTypeFromInputToOutput(ctx, 0, 0);
+
+                                  // Shape inference
+                                  if (!hasInputShape(ctx, 0)) {
+                                    return;
+                                  }
+                                  const auto* b_shape_initializer = ctx.getInputData(2);
+                                  if (nullptr == b_shape_initializer) {
+                                    return;
+                                  }
+                                  std::vector<int64_t> b_shape = ParseData<int64_t>(b_shape_initializer);
+                                  if (b_shape.size() != 2) {
+                                    fail_shape_inference("B_shape must describe a 2D matrix [K, N]");
+                                  }
+
+                                  const auto& a_shape = ctx.getInputType(0)->tensor_type().shape();
+                                  const int a_rank = a_shape.dim_size();
+                                  if (a_rank < 1) {
+                                    fail_shape_inference("Input A must have rank >= 1");
+                                  }
+                                  const auto& a_k = a_shape.dim(a_rank - 1);
+                                  if (a_k.has_dim_value() && a_k.dim_value() != b_shape[0]) {
+                                    fail_shape_inference("Incompatible dimensions for matrix multiplication");
+                                  }
+
+                                  ONNX_NAMESPACE::TensorShapeProto output_shape;
+                                  for (int i = 0; i < a_rank - 1; i++) {
+                                    *output_shape.add_dim() = a_shape.dim(i);
+                                  }
+                                  output_shape.add_dim()->set_dim_value(b_shape[1]);
+                                  updateOutputShape(ctx, 0, output_shape);
+                                }));
+
+constexpr const char* MatMulNBits_ver1_doc = R"DOC(
+MatMulNBits computes the matrix product Y = A * B', where B is a constant N x K matrix quantized to 4 or 8 bits
+along K in blocks of block_size elements, for the weight-only quantization of large language models.
+Each block is dequantized as (q - zero_point) * scale, with one scale and one zero point per block.
+A block_size covering all of K gives per-channel quantization.
+
+B has shape [N, ceil(K / block_size), block_size * bits / 8]: the quantized values of each row of B are stored in
+order of k, two per byte for 4 bits with the even k in the low nibble. The scales have shape
+[N * ceil(K / block_size)]. The zero points are uint8, one per block for 8 bits and two per byte for 4 bits
+(ceil(ceil(K / block_size) / 2) bytes per row, the even block in the low nibble). Without zero points, the zero
+point is 2^(bits - 1).
+)DOC";
+
+ONNX_MS_OPERATOR_SET_SCHEMA(MatMulNBits, 1,
+                            OpSchema()
+                                .SetDoc(MatMulNBits_ver1_doc)
+                                .Attr("K", "Size of each input feature.", AttributeProto::INT)
+                                .Attr("N", "Size of each output feature.", AttributeProto::INT)
+                                .Attr("bits", "Number of bits of the quantized weight, 4 or 8.", AttributeProto::INT)
+                                .Attr("block_size",
+                                      "Number of elements of K sharing a scale and a zero point. "
+                                      "It must be a multiple of 16.",
+                                      AttributeProto::INT)
+                                .Input(0, "A", "The input tensor, of shape [..., K].", "T1")
+                                .Input(1, "B", "The quantized weight, of shape [N, ceil(K / block_size), block_size * bits / 8].", "T2")
+                                .Input(2, "scales", "The scales of the blocks, of shape [N * ceil(K / block_size)].", "T1")
+                                .Input(3, "zero_points", "The zero points of the blocks.", "T2", OpSchema::Optional)
+                                .Output(0, "Y", "The output tensor, of shape [..., N].", "T1")
+                                .TypeConstraint("T1", {"tensor(float)", "tensor(float16)"}, "Constrain input and output types to float tensors.")
+                                .TypeConstraint("T2", {"tensor(uint8)"}, "Constrain quantized weight types to uint8.")
+                                .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+                                  propagateElemTypeFromInputToOutput(ctx, 0, 0);
+
+                                  if (!hasInputShape(ctx, 0)) {
+                                    return;
+                                  }
+                                  const int64_t K = getAttribute(ctx, "K", -1);
+                                  const int64_t N = getAttribute(ctx, "N", -1);
+                                  const auto& a_shape = ctx.getInputType(0)->tensor_type().shape();
+                                  const int a_rank = a_shape.dim_size();
+                                  if (a_rank < 1) {
+                                    fail_shape_inference("Input A must have rank >= 1");
+                                  }
+                                  const auto& a_k = a_shape.dim(a_rank - 1);
+                                  if (a_k.has_dim_value() && a_k.dim_value() != K) {
+                                    fail_shape_inference("The last dimension of A must be K");
+                                  }
+
+                                  ONNX_NAMESPACE::TensorShapeProto output_shape;
+                                  for (int i = 0; i < a_rank - 1; i++) {
+                                    *output_shape.add_dim() = a_shape.dim(i);
+                                  }
+                                  output_shape.add_dim()->set_dim_value(N);
+                                  updateOutputShape(ctx, 0, output_shape);
+                                }));
+
+constexpr const char* BatchedLoRA_ver1_doc = R"DOC(
+BatchedLoRA adds the low-rank update of a LoRA adapter to the output of a projection shared by all the adapters,
+with a different adapter for each sequence of the batch:
+output[b] = base_output[b] + (input[b] * lora_a[i]') * lora_b[i]' with i = adapter_indices[b].
+An index of -1 leaves the sequence on the base weight, as does any other index out of
+[0, num_adapters). The scaling of the adapter (alpha / rank) is expected to be folded into lora_b.
+
+The adapters are stacked in pools of shape [num_adapters, rank, input_size] and [num_adapters, output_size, rank],
+the layouts of the lora_A and lora_B weights of PEFT. Since the pools are inputs, an application can keep them on
+the device, bind them with IOBinding and load a new adapter into a free slot between runs, without recreating the
+session. Adapters of a smaller rank are padded with zeros.
+)DOC";
+
+ONNX_MS_OPERATOR_SET_SCHEMA(BatchedLoRA, 1,
+                            OpSchema()
+                                .SetDoc(BatchedLoRA_ver1_doc)
+                                .Input(0, "input", "The input of the projection, of shape [batch_size, sequence_length, input_size].", "T")
+                                .Input(1, "base_output", "The output of the projection by the base weight, of shape [batch_size, sequence_length, output_size].", "T")
+                                .Input(2, "lora_a", "The pool of the down projections of the adapters, of shape [num_adapters, rank, input_size].", "T")
+                                .Input(3, "lora_b", "The pool of the up projections of the adapters, of shape [num_adapters, output_size, rank].", "T")
+                                .Input(4, "adapter_indices", "The index in the pools of the adapter of each sequence, of shape [batch_size]. An index of -1 selects no adapter.", "I")
+                                .Output(0, "output", "The output of the projection with the adapters, of shape [batch_size, sequence_length, output_size].", "T")
+                                .TypeConstraint("T", {"tensor(float)", "tensor(float16)"}, "Constrain input and output types to float tensors.")
+                                .TypeConstraint("I", {"tensor(int32)"}, "Constrain adapter_indices to int32 tensors.")
+                                .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+                                  propagateElemTypeFromInputToOutput(ctx, 1, 0);
+                                  if (hasInputShape(ctx, 1)) {
+                                    propagateShapeFromInputToOutput(ctx, 1, 0);
+                                  }
+                                }));
+
 ONNX_MS_OPERATOR_SET_SCHEMA(MurmurHash3, 1,
                             OpSchema()
                                 .SetDoc(R"DOC(The underlying implementation is MurmurHash3_x86_32 generating low latency 32bits hash suitable for implementing lookup tables, Bloom filters, count min sketch or feature hashing.)DOC")
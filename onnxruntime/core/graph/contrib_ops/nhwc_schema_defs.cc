@@ -234,6 +234,16 @@ ONNX_MS_OPERATOR_SET_SCHEMA(QLinearConv, 1,
                                 .Input(6, "y_scale", "", "tensor(float)")
                                 .Input(7, "y_zero_point", "", "T3")
                                 .Input(8, "B", "", "T4", OpSchema::Optional)
+                                .Input(9, "sum", "Optional residual input with the shape of y, added to the result "
+                                       "as QLinearAdd does", "T3", OpSchema::Optional)
+                                .Input(10, "sum_scale", "", "tensor(float)", OpSchema::Optional)
+                                .Input(11, "sum_zero_point", "", "T3", OpSchema::Optional)
+                                .Input(12, "sum_y_scale", "Scale of the result of the residual add", "tensor(float)",
+                                       OpSchema::Optional)
+                                .Input(13, "sum_y_zero_point", "", "T3", OpSchema::Optional)
+                                .Input(14, "activation_y_scale", "Scale of the result of the activation applied "
+                                       "after the residual add", "tensor(float)", OpSchema::Optional)
+                                .Input(15, "activation_y_zero_point", "", "T3", OpSchema::Optional)
                                 .Output(0, "y", "", "T3")
                                 .TypeConstraint("T1", {"tensor(int8)", "tensor(uint8)"}, "")
                                 .TypeConstraint("T2", {"tensor(int8)", "tensor(uint8)"}, "")
@@ -246,6 +256,9 @@ ONNX_MS_OPERATOR_SET_SCHEMA(QLinearConv, 1,
                                 .Attr("pads", "", AttributeProto::INTS, OPTIONAL_VALUE)
                                 .Attr("group", "", AttributeProto::INT, static_cast<int64_t>(1))
                                 .Attr("channels_last", "", AttributeProto::INT, static_cast<int64_t>(0))
+                                .Attr("activation", "Quantized activation applied after the residual add, "
+                                      "either empty or LeakyRelu", AttributeProto::STRING, std::string(""))
+                                .Attr("activation_params", "", AttributeProto::FLOATS, OPTIONAL_VALUE)
                                 .TypeAndShapeInferenceFunction([](InferenceContext& ctx) {
                                   auto x_type = ctx.getInputType(0);
                                   auto w_type = ctx.getInputType(3);
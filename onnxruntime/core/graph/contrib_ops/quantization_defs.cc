@@ -650,6 +650,49 @@ The output tensor has the same shape.
           propagateShapeFromInputToOutput(ctx, 0, 0);
         }));
 
+ONNX_MS_OPERATOR_SET_SCHEMA(
+    QLinearLayerNormalization, 1,
+    OpSchema()
+        .SetDoc(R"DOC(
+QLinearLayerNormalization computes LayerNormalization of a quantized tensor:
+Y = Quantize((Dequantize(X) - Mean) / Sqrt(Variance + epsilon) * Scale + B)
+The mean and the variance are computed over the dimensions from "axis" to the last one.
+The normalization is computed in float, so the result matches
+DequantizeLinear -> LayerNormalization -> QuantizeLinear.
+)DOC")
+        .Attr("axis",
+              "The first normalization dimension. Negative value means counting dimensions from the back.",
+              AttributeProto::INT, static_cast<int64_t>(-1))
+        .Attr("epsilon", "The epsilon value to use to avoid division by zero.", AttributeProto::FLOAT, 1e-5f)
+        .Input(0, "X", "The input tensor", "T")
+        .Input(1, "X_scale", "Scale of quantized input 'X'. It must be a scalar.", "tensor(float)")
+        .Input(2, "X_zero_point", "Zero point of quantized input 'X'. It must be a scalar.", "T", OpSchema::Optional)
+        .Input(3, "Scale", "Scale (gamma), with the shape of the normalized dimensions.", "tensor(float)")
+        .Input(4, "Y_scale", "Scale of quantized output 'Y'. It must be a scalar.", "tensor(float)")
+        .Input(5, "Y_zero_point", "Zero point of quantized output 'Y'. It must be a scalar.", "T",
+               OpSchema::Optional)
+        .Input(6, "B", "Bias (beta), with the shape of the normalized dimensions.", "tensor(float)",
+               OpSchema::Optional)
+        .Output(0, "Y", "The normalized tensor, with the shape of 'X'.", "T")
+        .TypeConstraint("T", {"tensor(uint8)", "tensor(int8)"},
+                        "Constrain input and output types to signed/unsigned int8 tensors.")
+        .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+          propagateElemTypeFromInputToOutput(ctx, 0, 0);
+
+          if (!hasNInputShapes(ctx, 1)) {
+            return;
+          }
+
+          const ONNX_NAMESPACE::TensorShapeProto& input_shape = ctx.getInputType(0)->tensor_type().shape();
+          int r = input_shape.dim_size();
+          int axis = static_cast<int>(getAttribute(ctx, "axis", -1));
+          if (axis < -r || axis >= r) {
+            fail_shape_inference("'axis' must be in [", -r, " , ", (r - 1), "]. Its actual value is: ", axis);
+          }
+
+          propagateShapeFromInputToOutput(ctx, 0, 0);
+        }));
+
 ONNX_MS_OPERATOR_SET_SCHEMA(
     DynamicQuantizeLSTM, 1,
     OpSchema()
@@ -29,11 +29,13 @@
 #include "core/graph/op.h"
 #include "core/graph/runtime_optimization_record_container.h"
 #include "core/graph/function_utils.h"
+#include "core/platform/threadpool.h"
 
 #if !defined(ORT_MINIMAL_BUILD)
 #include "core/graph/function.h"
 #include "core/graph/function_impl.h"
 #include "core/graph/schema_registry.h"
+#include "core/graph/symbolic_shape_inference.h"
 #include "onnx/checker.h"
 using namespace ONNX_NAMESPACE::checker;
 #endif
@@ -494,6 +496,10 @@ common::Status NodeArg::UpdateTypeAndShape(const NodeArg& node_arg, bool strict,
   return status;
 }
 
+const TensorShapeProto* NodeArg::InferredShapeValues() const noexcept {
+  return inferred_shape_values_.has_value() ? &*inferred_shape_values_ : nullptr;
+}
+
 void NodeArg::SetType(DataType p_type) {
   if (nullptr == p_type) {
     return;
@@ -672,6 +678,7 @@ void Node::ToProto(NodeProto& proto, bool update_subgraphs) const {
 }
 
 Status Node::SaveToOrtFormat(flatbuffers::FlatBufferBuilder& builder,
+                             const OrtFormatSaveOptions& save_options,
                              flatbuffers::Offset<fbs::Node>& fbs_node) const {
   // if type is Primitive it's an ONNX function and currently we have kernel implementations for all those
   if (func_body_ != nullptr && node_type_ != Type::Primitive) {
@@ -719,7 +726,7 @@ Status Node::SaveToOrtFormat(flatbuffers::FlatBufferBuilder& builder,
       subgraph = it->second;
     }
     ORT_RETURN_IF_ERROR(
-        fbs::utils::SaveAttributeOrtFormat(builder, attr_proto, fbs_attr, ModelPath(), subgraph));
+        fbs::utils::SaveAttributeOrtFormat(builder, attr_proto, fbs_attr, ModelPath(), subgraph, save_options));
     attributes_vec.push_back(fbs_attr);
   }
   auto attributes = builder.CreateVector(attributes_vec);
@@ -2075,9 +2082,14 @@ class InferenceContextImpl : public ONNX_NAMESPACE::InferenceContext {
     return initializer;
   }
 
-  // ORT does not implement partial data propagation yet so just return nullptr.
-  const TensorShapeProto* getSymbolicInput(size_t) const override {
-    return nullptr;
+  // Return the values derived from shapes by InferShapeValues, e.g. the output of Shape -> Gather -> Concat,
+  // so that ops like Reshape and Expand can infer symbolic output dimensions such as "batch*seq".
+  const TensorShapeProto* getSymbolicInput(size_t index) const override {
+    auto def = node_.InputDefs()[index];
+    if (!def || !def->Exists())
+      return nullptr;
+
+    return def->InferredShapeValues();
   }
 
   GraphInferencer* getGraphAttributeInferencer(const std::string& attribute_name) override {
@@ -2426,6 +2438,12 @@ Status Graph::InferAndVerifyTypeMatch(Node& node, const OpSchema& op, const Reso
     }
   }
 
+  // Propagate the values of small integer tensors computed from shapes so that later nodes can use them.
+  // This runs after the output shapes are updated as the values are only tracked for outputs of rank 0 or 1.
+  if (!node.OutputDefs().empty()) {
+    node.MutableOutputDefs()[0]->inferred_shape_values_ = InferShapeValues(*this, node);
+  }
+
   return Status::OK();
 }
 
@@ -2526,23 +2544,33 @@ Status Graph::VerifyNodeAndOpMatch(const ResolveOptions& options) {
     parent.output_names.insert(outer_scope_node_arg_names_.cbegin(), outer_scope_node_arg_names_.cend());
   }
 
+  // The ONNX checker only runs on the nodes without an op schema, i.e. the nodes added since the last resolve, so the
+  // NodeProto of a node and the lexical scope of the graph are only built when there are such nodes. A re-resolve
+  // after a graph transformer then costs type and shape inferencing only.
+  const bool has_unchecked_nodes = std::any_of(nodes_in_topological_order_.cbegin(),
+                                               nodes_in_topological_order_.cend(),
+                                               [this](NodeIndex node_index) {
+                                                 return GetNode(node_index)->Op() == nullptr;
+                                               });
+
   LexicalScopeContext lsc{parent};
-  lsc.output_names.reserve(resolve_context_.inputs_and_initializers.size() + resolve_context_.output_args.size());
+  if (has_unchecked_nodes) {
+    lsc.output_names.reserve(resolve_context_.inputs_and_initializers.size() + resolve_context_.output_args.size());
 
-  for (const std::string_view& input : resolve_context_.inputs_and_initializers) {
-    lsc.output_names.insert(std::string(input));
+    for (const std::string_view& input : resolve_context_.inputs_and_initializers) {
+      lsc.output_names.insert(std::string(input));
+    }
   }
 
   for (auto node_index : nodes_in_topological_order_) {
     // Node verification.
     auto& node = *GetNode(node_index);
-
-    NodeProto node_proto;
-    node.ToProto(node_proto);
     const auto& node_name = node.Name();
 
     if (!node.Op()) {
       {
+        NodeProto node_proto;
+        node.ToProto(node_proto);
         auto status = Status::OK();
         ORT_TRY {
           checker::check_node(node_proto, ctx, lsc);
@@ -2617,8 +2645,10 @@ Status Graph::VerifyNodeAndOpMatch(const ResolveOptions& options) {
     NO_CHANGE_ON_SYNC_FLAG(ORT_RETURN_IF_ERROR(InferAndVerifyTypeMatch(node, *p_op, options)));
 
     // Accumulate output names of the iterated Node
-    for (auto& output_name : node_proto.output()) {
-      lsc.output_names.insert(output_name);
+    if (has_unchecked_nodes) {
+      for (const auto* output_def : node.OutputDefs()) {
+        lsc.output_names.insert(output_def->Name());
+      }
     }
   }
 
@@ -3103,6 +3133,7 @@ SaveInputsOutputsToOrtFormat(flatbuffers::FlatBufferBuilder& builder, const std:
 }
 
 common::Status Graph::SaveToOrtFormat(flatbuffers::FlatBufferBuilder& builder,
+                                      const OrtFormatSaveOptions& save_options,
                                       flatbuffers::Offset<fbs::Graph>& fbs_graph) const {
   auto inputs = SaveInputsOutputsToOrtFormat(builder, graph_inputs_including_initializers_);
   auto outputs = SaveInputsOutputsToOrtFormat(builder, graph_outputs_);
@@ -3126,7 +3157,7 @@ common::Status Graph::SaveToOrtFormat(flatbuffers::FlatBufferBuilder& builder,
     if (sparse_tensor_names_.find(pair.first) == sparse_end) {
       flatbuffers::Offset<fbs::Tensor> fbs_tensor;
       ORT_RETURN_IF_ERROR(
-          fbs::utils::SaveInitializerOrtFormat(builder, *pair.second, model_path, fbs_tensor));
+          fbs::utils::SaveInitializerOrtFormat(builder, *pair.second, model_path, save_options, fbs_tensor));
       initializers_data.push_back(fbs_tensor);
     }
 #if !defined(DISABLE_SPARSE_TENSORS)
@@ -3135,7 +3166,8 @@ common::Status Graph::SaveToOrtFormat(flatbuffers::FlatBufferBuilder& builder,
       ORT_RETURN_IF_ERROR(utils::DenseTensorToSparseTensorProto(*pair.second, model_path, sparse_initializer));
       flatbuffers::Offset<fbs::SparseTensor> fbs_sparse_tensor;
       ORT_RETURN_IF_ERROR(
-          fbs::utils::SaveSparseInitializerOrtFormat(builder, sparse_initializer, model_path, fbs_sparse_tensor));
+          fbs::utils::SaveSparseInitializerOrtFormat(builder, sparse_initializer, model_path, save_options,
+                                                     fbs_sparse_tensor));
       sparse_initializers_data.push_back(fbs_sparse_tensor);
     }
 #endif
@@ -3161,7 +3193,7 @@ common::Status Graph::SaveToOrtFormat(flatbuffers::FlatBufferBuilder& builder,
   for (const auto& node : nodes_) {
     if (node != nullptr) {
       flatbuffers::Offset<fbs::Node> fbs_node;
-      ORT_RETURN_IF_ERROR(node->SaveToOrtFormat(builder, fbs_node));
+      ORT_RETURN_IF_ERROR(node->SaveToOrtFormat(builder, save_options, fbs_node));
       nodes_vec.push_back(fbs_node);
       node_edges_vec.push_back(node->SaveEdgesToOrtFormat(builder));
     }
@@ -4348,10 +4380,36 @@ common::Status Graph::LoadFromOrtFormat(const onnxruntime::fbs::Graph& fbs_graph
   }
 
   if (fbs_initializers) {
+    // Initializers with compressed data are loaded after the others, in parallel as decompressing them dominates.
+    // Each decompresses into the TensorProto it was assigned, so they are only added to the graph once all are loaded.
+    InlinedVector<TensorProto*> initializers;
+    InlinedVector<std::pair<const fbs::Tensor*, TensorProto*>> compressed_initializers;
+    initializers.reserve(fbs_initializers->size());
     for (const auto* fbs_tensor : *fbs_initializers) {
       ORT_RETURN_IF(nullptr == fbs_tensor, "Initializer tensor is missing. Invalid ORT format model.");
       TensorProto* initializer = deserialized_proto_data_.add_initializer();
-      ORT_RETURN_IF_ERROR(fbs::utils::LoadInitializerOrtFormat(*fbs_tensor, *initializer, load_options));
+      if (fbs_tensor->raw_data_compression() != fbs::CompressionType::NONE) {
+        compressed_initializers.emplace_back(fbs_tensor, initializer);
+      } else {
+        ORT_RETURN_IF_ERROR(fbs::utils::LoadInitializerOrtFormat(*fbs_tensor, *initializer, load_options));
+      }
+      initializers.push_back(initializer);
+    }
+
+    if (!compressed_initializers.empty()) {
+      std::vector<Status> statuses(compressed_initializers.size());
+      concurrency::ThreadPool::TrySimpleParallelFor(
+          load_options.thread_pool, static_cast<std::ptrdiff_t>(compressed_initializers.size()),
+          [&](std::ptrdiff_t i) {
+            const auto& [fbs_tensor, initializer] = compressed_initializers[i];
+            statuses[i] = fbs::utils::LoadInitializerOrtFormat(*fbs_tensor, *initializer, load_options);
+          });
+      for (const auto& status : statuses) {
+        ORT_RETURN_IF_ERROR(status);
+      }
+    }
+
+    for (TensorProto* initializer : initializers) {
       auto p = name_to_initial_tensor_.emplace(initializer->name(), initializer);
       if (!p.second) {
         LOGS(logger_, WARNING) << "Duplicate initializer (dense or ConstantNode): '" << initializer->name()
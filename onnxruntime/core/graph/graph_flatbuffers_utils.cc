@@ -8,6 +8,7 @@
 #include "core/common/narrow.h"
 #include "core/flatbuffers/flatbuffers_utils.h"
 #include "core/flatbuffers/schema/ort.fbs.h"
+#include "core/flatbuffers/tensor_compression.h"
 #include "core/framework/tensorprotoutils.h"
 #include "core/framework/tensor_external_data_info.h"
 #include "core/graph/graph.h"
@@ -16,6 +17,12 @@ using namespace ONNX_NAMESPACE;
 
 namespace onnxruntime::fbs::utils {
 
+// Size in bytes of an element of a non-string initializer, from the size of its raw data.
+static size_t GetElementSize(const TensorProto& initializer, size_t raw_data_size) {
+  const int64_t num_elements = onnxruntime::utils::GetTensorShapeFromTensorProto(initializer).Size();
+  return num_elements > 0 ? raw_data_size / static_cast<size_t>(num_elements) : 0;
+}
+
 template <typename DimsFieldType>
 inline flatbuffers::Offset<flatbuffers::Vector<int64_t>>
 SaveDims(flatbuffers::FlatBufferBuilder& builder, const DimsFieldType& dims) {
@@ -29,6 +36,7 @@ SaveDims(flatbuffers::FlatBufferBuilder& builder, const DimsFieldType& dims) {
 Status SaveInitializerOrtFormat(flatbuffers::FlatBufferBuilder& builder,
                                 const TensorProto& initializer,
                                 const Path& model_path,
+                                const OrtFormatSaveOptions& save_options,
                                 flatbuffers::Offset<fbs::Tensor>& fbs_tensor) {
   auto name = SaveStringToOrtFormat(builder, initializer.has_name(), initializer.name());
   auto doc_string = SaveStringToOrtFormat(builder, initializer.has_doc_string(), initializer.doc_string());
@@ -36,6 +44,7 @@ Status SaveInitializerOrtFormat(flatbuffers::FlatBufferBuilder& builder,
 
   flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<flatbuffers::String>>> string_data;
   flatbuffers::Offset<flatbuffers::Vector<uint8_t>> raw_data;
+  auto raw_data_compression = fbs::CompressionType::NONE;
 
   auto src_type = initializer.data_type();
   const bool has_string_data = src_type == ONNX_NAMESPACE::TensorProto_DataType_STRING;
@@ -47,6 +56,18 @@ Status SaveInitializerOrtFormat(flatbuffers::FlatBufferBuilder& builder,
     std::vector<uint8_t> unpacked_tensor;
     ORT_RETURN_IF_ERROR(
         onnxruntime::utils::UnpackInitializerData(initializer, model_path, unpacked_tensor));
+
+    if (save_options.compress_initializers && unpacked_tensor.size() >= kMinCompressedRawDataSize) {
+      // byte shuffling only helps when the elements have multiple bytes
+      const size_t element_size = GetElementSize(initializer, unpacked_tensor.size());
+      const auto compression = element_size > 1 ? fbs::CompressionType::BYTE_SHUFFLE_LZ4 : fbs::CompressionType::LZ4;
+      std::vector<uint8_t> compressed;
+      if (CompressTensorRawData(unpacked_tensor, element_size, compression, compressed)) {
+        raw_data_compression = compression;
+        unpacked_tensor.swap(compressed);
+      }
+    }
+
     raw_data = builder.CreateVector(unpacked_tensor.data(), unpacked_tensor.size());
   }
 
@@ -59,6 +80,7 @@ Status SaveInitializerOrtFormat(flatbuffers::FlatBufferBuilder& builder,
     tb.add_string_data(string_data);
   else
     tb.add_raw_data(raw_data);
+  tb.add_raw_data_compression(raw_data_compression);
   fbs_tensor = tb.Finish();
   return Status::OK();
 }
@@ -67,16 +89,17 @@ Status SaveInitializerOrtFormat(flatbuffers::FlatBufferBuilder& builder,
 Status SaveSparseInitializerOrtFormat(flatbuffers::FlatBufferBuilder& builder,
                                       const ONNX_NAMESPACE::SparseTensorProto& initializer,
                                       const Path& model_path,
+                                      const OrtFormatSaveOptions& save_options,
                                       flatbuffers::Offset<fbs::SparseTensor>& fbs_sparse_tensor) {
   // values
   const auto& values = initializer.values();
   flatbuffers::Offset<fbs::Tensor> values_off;
-  ORT_RETURN_IF_ERROR(SaveInitializerOrtFormat(builder, values, model_path, values_off));
+  ORT_RETURN_IF_ERROR(SaveInitializerOrtFormat(builder, values, model_path, save_options, values_off));
 
   // Indicies
   const auto& indicies = initializer.indices();
   flatbuffers::Offset<fbs::Tensor> indicies_off;
-  ORT_RETURN_IF_ERROR(SaveInitializerOrtFormat(builder, indicies, model_path, indicies_off));
+  ORT_RETURN_IF_ERROR(SaveInitializerOrtFormat(builder, indicies, model_path, save_options, indicies_off));
 
   // Shape
   auto shape = SaveDims(builder, initializer.dims());
@@ -108,7 +131,8 @@ Status SaveAttributeOrtFormat(flatbuffers::FlatBufferBuilder& builder,
                               const AttributeProto& attr_proto,
                               flatbuffers::Offset<fbs::Attribute>& fbs_attr,
                               const Path& model_path,
-                              const onnxruntime::Graph* subgraph) {
+                              const onnxruntime::Graph* subgraph,
+                              const OrtFormatSaveOptions& save_options) {
   auto name = SaveStringToOrtFormat(builder, attr_proto.has_name(), attr_proto.name());
   auto doc_string = SaveStringToOrtFormat(builder, attr_proto.has_doc_string(), attr_proto.doc_string());
   auto type = static_cast<fbs::AttributeType>(attr_proto.type());
@@ -126,13 +150,13 @@ Status SaveAttributeOrtFormat(flatbuffers::FlatBufferBuilder& builder,
     case fbs::AttributeType::TENSOR: {
       flatbuffers::Offset<fbs::Tensor> fbs_tensor;
       ORT_RETURN_IF_ERROR(
-          SaveInitializerOrtFormat(builder, attr_proto.t(), model_path, fbs_tensor));
+          SaveInitializerOrtFormat(builder, attr_proto.t(), model_path, save_options, fbs_tensor));
       GET_FBS_ATTR(builder, type, t, fbs_tensor);
     } break;
     case fbs::AttributeType::GRAPH: {
       ORT_RETURN_IF(nullptr == subgraph, "Graph attribute value was null. Invalid ORT format model.");
       flatbuffers::Offset<fbs::Graph> fbs_graph;
-      ORT_RETURN_IF_ERROR(subgraph->SaveToOrtFormat(builder, fbs_graph));
+      ORT_RETURN_IF_ERROR(subgraph->SaveToOrtFormat(builder, save_options, fbs_graph));
       GET_FBS_ATTR(builder, type, g, fbs_graph);
     } break;
     case fbs::AttributeType::FLOATS: {
@@ -156,7 +180,7 @@ Status SaveAttributeOrtFormat(flatbuffers::FlatBufferBuilder& builder,
       for (const auto& tensor : attr_proto.tensors()) {
         flatbuffers::Offset<fbs::Tensor> fbs_tensor;
         ORT_RETURN_IF_ERROR(
-            SaveInitializerOrtFormat(builder, tensor, model_path, fbs_tensor));
+            SaveInitializerOrtFormat(builder, tensor, model_path, save_options, fbs_tensor));
         fbs_tensors_vec.push_back(fbs_tensor);
       }
       auto tensors = builder.CreateVector(fbs_tensors_vec);
@@ -201,7 +225,18 @@ Status LoadInitializerOrtFormat(const fbs::Tensor& fbs_tensor, TensorProto& init
     const auto* fbs_raw_data = fbs_tensor.raw_data();
     ORT_RETURN_IF(nullptr == fbs_raw_data, "Missing raw data for initializer. Invalid ORT format model.");
 
-    if (load_options.can_use_flatbuffer_for_initializers && fbs_raw_data->size() > 127) {
+    const auto raw_data_compression = fbs_tensor.raw_data_compression();
+    if (raw_data_compression != fbs::CompressionType::NONE) {
+      // compressed data cannot be used in place, so it is decompressed straight into the raw_data of the initializer
+      size_t raw_data_size = 0;
+      ORT_RETURN_IF_ERROR(onnxruntime::utils::GetSizeInBytesFromTensorProto<0>(initializer, &raw_data_size));
+      std::string& raw_data = *initializer.mutable_raw_data();
+      raw_data.resize(raw_data_size);
+      ORT_RETURN_IF_ERROR(DecompressTensorRawData(
+          raw_data_compression, gsl::make_span(fbs_raw_data->Data(), fbs_raw_data->size()),
+          GetElementSize(initializer, raw_data_size),
+          gsl::make_span(reinterpret_cast<uint8_t*>(raw_data.data()), raw_data.size())));
+    } else if (load_options.can_use_flatbuffer_for_initializers && fbs_raw_data->size() > 127) {
       initializer.set_data_location(ONNX_NAMESPACE::TensorProto_DataLocation_EXTERNAL);
 
       static_assert(sizeof(void*) <= sizeof(ExternalDataInfo::OFFSET_TYPE));
@@ -384,6 +419,8 @@ Status LoadOrtTensorOrtFormat(const fbs::Tensor& fbs_tensor, const AllocatorPtr
 
   auto* tensor_dims = fbs_tensor.dims();
   ORT_RETURN_IF_NOT(tensor_dims, "Flatbuffer tensor is invalid. Expected: Valid tensor dims. Actual: nullptr.");
+  ORT_RETURN_IF(fbs_tensor.raw_data_compression() != fbs::CompressionType::NONE,
+                "Flatbuffer tensor is invalid. Checkpoint tensors are not expected to be compressed.");
 
   const auto tensor_data_type = static_cast<int32_t>(fbs_tensor.data_type());
   const DataTypeImpl* tensor_dtype = DataTypeImpl::TensorTypeFromONNXEnum(
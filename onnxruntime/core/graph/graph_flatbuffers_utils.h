@@ -7,6 +7,7 @@
 
 #include "core/common/status.h"
 #include "core/graph/ort_format_load_options.h"
+#include "core/graph/ort_format_save_options.h"
 #include "core/framework/tensor.h"
 
 namespace ONNX_NAMESPACE {
@@ -44,14 +45,16 @@ struct SparseTensor;
 
 namespace utils {
 
+// The raw data of the initializer is compressed if save_options.compress_initializers is set and that makes it smaller.
 Status SaveInitializerOrtFormat(
     flatbuffers::FlatBufferBuilder& builder, const ONNX_NAMESPACE::TensorProto& initializer,
-    const Path& model_path, flatbuffers::Offset<fbs::Tensor>& fbs_tensor);
+    const Path& model_path, const OrtFormatSaveOptions& save_options, flatbuffers::Offset<fbs::Tensor>& fbs_tensor);
 
 #if !defined(DISABLE_SPARSE_TENSORS)
 Status SaveSparseInitializerOrtFormat(
     flatbuffers::FlatBufferBuilder& builder, const ONNX_NAMESPACE::SparseTensorProto& initializer,
-    const Path& model_path, flatbuffers::Offset<fbs::SparseTensor>& fbs_sparse_tensor);
+    const Path& model_path, const OrtFormatSaveOptions& save_options,
+    flatbuffers::Offset<fbs::SparseTensor>& fbs_sparse_tensor);
 #endif  // !defined(DISABLE_SPARSE_TENSORS)
 
 // Convert a given AttributeProto into fbs::Attribute
@@ -61,10 +64,11 @@ Status SaveSparseInitializerOrtFormat(
 Status SaveAttributeOrtFormat(
     flatbuffers::FlatBufferBuilder& builder, const ONNX_NAMESPACE::AttributeProto& attr_proto,
     flatbuffers::Offset<fbs::Attribute>& fbs_attr, const Path& model_path,
-    const onnxruntime::Graph* subgraph);
+    const onnxruntime::Graph* subgraph, const OrtFormatSaveOptions& save_options);
 
 /// <summary>
 /// Load an initializer from an ORT format flatbuffer.
+/// Compressed raw data is decompressed into the raw_data of the TensorProto.
 /// </summary>
 /// <param name="fbs_tensor">Flatbuffer Tensor</param>
 /// <param name="initializer">TensorProto to load data into</param>
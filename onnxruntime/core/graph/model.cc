@@ -1,6 +1,7 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <limits>
 #include <memory>
 #include "core/common/logging/logging.h"
 #include "core/flatbuffers/schema/ort.fbs.h"
@@ -659,6 +660,13 @@ Status Model::Load(int fd, ONNX_NAMESPACE::ModelProto& model_proto) {
   int block_size = -1;
   Status st = Env::Default().GetFileLength(fd, file_size);
   if (st.IsOK()) {
+    // protobuf can not parse messages of 2GB or more. The weights of larger models must be stored as external data,
+    // which is mapped into memory when the initializers are created instead of being parsed with the graph.
+    if (file_size > static_cast<size_t>(std::numeric_limits<int>::max())) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_PROTOBUF, "The model file is ", file_size,
+                             " bytes, which exceeds the 2GB limit of protobuf. "
+                             "Save the model with its initializers as external data to load it.");
+    }
     block_size = std::min(DEFAULT_PROTOBUF_BLOCK_SIZE, static_cast<int>(file_size));
   }
   FileInputStream input(fd, block_size);
@@ -740,6 +748,7 @@ Status Model::SaveWithExternalInitializers(Model& model,
 }
 
 common::Status Model::SaveToOrtFormat(flatbuffers::FlatBufferBuilder& builder,
+                                      const OrtFormatSaveOptions& save_options,
                                       flatbuffers::Offset<fbs::Model>& fbs_model) const {
   auto producer_name = fbs::utils::SaveStringToOrtFormat(
       builder, model_proto_.has_producer_name(), model_proto_.producer_name());
@@ -778,7 +787,7 @@ common::Status Model::SaveToOrtFormat(flatbuffers::FlatBufferBuilder& builder,
   }
 
   flatbuffers::Offset<fbs::Graph> fbs_graph;
-  ORT_RETURN_IF_ERROR(graph_->SaveToOrtFormat(builder, fbs_graph));
+  ORT_RETURN_IF_ERROR(graph_->SaveToOrtFormat(builder, save_options, fbs_graph));
 
   fbs::ModelBuilder mb(builder);
   mb.add_ir_version(IrVersion());
@@ -10,6 +10,7 @@
 #include "core/common/path.h"
 #include "core/graph/graph_viewer.h"
 #include "core/graph/ort_format_load_options.h"
+#include "core/graph/ort_format_save_options.h"
 #include "core/session/onnxruntime_c_api.h"
 #if !defined(ORT_MINIMAL_BUILD)
 #include "core/graph/function_template.h"
@@ -290,6 +291,7 @@ class Model {
                              const ModelOptions& options = {});
 
   common::Status SaveToOrtFormat(flatbuffers::FlatBufferBuilder& builder,
+                                 const OrtFormatSaveOptions& save_options,
                                  flatbuffers::Offset<onnxruntime::fbs::Model>& model) const;
 
 #endif  // !defined(ORT_MINIMAL_BUILD)
@@ -5,6 +5,10 @@
 
 namespace onnxruntime {
 
+namespace concurrency {
+class ThreadPool;
+}
+
 /// Options to configure how an ORT format model is loaded.
 struct OrtFormatLoadOptions {
   /// If true, set initializer TensorProtos to point to memory in the flatbuffer instead of copying data.
@@ -13,6 +17,9 @@ struct OrtFormatLoadOptions {
 
   /// If true, do not load any saved runtime optimizations.
   bool ignore_saved_runtime_optimizations{false};
+
+  /// Thread pool to decompress compressed initializers with. They are decompressed sequentially if nullptr.
+  concurrency::ThreadPool* thread_pool{nullptr};
 };
 
 }  // namespace onnxruntime
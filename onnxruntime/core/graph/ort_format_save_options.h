@@ -0,0 +1,16 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+namespace onnxruntime {
+
+/// Options to configure how an ORT format model is saved.
+struct OrtFormatSaveOptions {
+  /// If true, compress the raw data of initializers where that makes it smaller.
+  /// Compressed initializers are decompressed when the model is loaded, so they cannot use the flatbuffer bytes
+  /// directly. See OrtFormatLoadOptions::can_use_flatbuffer_for_initializers.
+  bool compress_initializers{false};
+};
+
+}  // namespace onnxruntime
@@ -0,0 +1,253 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#if !defined(ORT_MINIMAL_BUILD)
+
+#include "core/graph/symbolic_dim.h"
+
+#include <algorithm>
+#include <cctype>
+#include <iterator>
+#include <limits>
+
+#include "core/common/common.h"
+
+namespace onnxruntime {
+
+namespace {
+
+bool IsIdentifierStart(char c) {
+  return std::isalpha(static_cast<unsigned char>(c)) || c == '_';
+}
+
+bool IsIdentifierChar(char c) {
+  return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+}
+
+// Recursive descent parser for expr := ['-'] term (('+' | '-') term)*, term := factor ('*' factor)*,
+// factor := integer | identifier. Whitespace is ignored.
+class Parser {
+ public:
+  explicit Parser(const std::string& text) : text_(text) {}
+
+  std::optional<SymbolicDim> ParseExpression() {
+    SymbolicDim result;
+    bool negate = Accept('-');
+    while (true) {
+      auto term = ParseTerm();
+      if (!term.has_value()) {
+        return std::nullopt;
+      }
+      result = negate ? result - *term : result + *term;
+      SkipWhitespace();
+      if (pos_ == text_.size()) {
+        return result;
+      }
+      if (Accept('+')) {
+        negate = false;
+      } else if (Accept('-')) {
+        negate = true;
+      } else {
+        return std::nullopt;
+      }
+    }
+  }
+
+ private:
+  std::optional<SymbolicDim> ParseTerm() {
+    auto result = ParseFactor();
+    while (result.has_value() && Accept('*')) {
+      auto factor = ParseFactor();
+      if (!factor.has_value()) {
+        return std::nullopt;
+      }
+      result = *result * *factor;
+    }
+    return result;
+  }
+
+  std::optional<SymbolicDim> ParseFactor() {
+    SkipWhitespace();
+    const size_t start = pos_;
+    if (pos_ < text_.size() && std::isdigit(static_cast<unsigned char>(text_[pos_]))) {
+      int64_t value = 0;
+      while (pos_ < text_.size() && std::isdigit(static_cast<unsigned char>(text_[pos_]))) {
+        if (value > (std::numeric_limits<int64_t>::max() - 9) / 10) {
+          return std::nullopt;
+        }
+        value = value * 10 + (text_[pos_++] - '0');
+      }
+      return SymbolicDim(value);
+    }
+    if (pos_ < text_.size() && IsIdentifierStart(text_[pos_])) {
+      while (pos_ < text_.size() && IsIdentifierChar(text_[pos_])) {
+        ++pos_;
+      }
+      return SymbolicDim::Symbol(text_.substr(start, pos_ - start));
+    }
+    return std::nullopt;
+  }
+
+  bool Accept(char c) {
+    SkipWhitespace();
+    if (pos_ < text_.size() && text_[pos_] == c) {
+      ++pos_;
+      return true;
+    }
+    return false;
+  }
+
+  void SkipWhitespace() {
+    while (pos_ < text_.size() && std::isspace(static_cast<unsigned char>(text_[pos_]))) {
+      ++pos_;
+    }
+  }
+
+  const std::string& text_;
+  size_t pos_ = 0;
+};
+
+}  // namespace
+
+SymbolicDim::SymbolicDim(int64_t value) {
+  AddTerm({}, value);
+}
+
+SymbolicDim SymbolicDim::Symbol(const std::string& name) {
+  SymbolicDim result;
+  result.AddTerm({name}, 1);
+  return result;
+}
+
+SymbolicDim SymbolicDim::Parse(const std::string& dim_param) {
+  auto result = Parser(dim_param).ParseExpression();
+  return result.has_value() ? *result : Symbol(dim_param);
+}
+
+std::optional<SymbolicDim> SymbolicDim::FromDimension(const ONNX_NAMESPACE::TensorShapeProto_Dimension& dim) {
+  if (dim.has_dim_value()) {
+    return SymbolicDim(dim.dim_value());
+  }
+  if (dim.has_dim_param() && !dim.dim_param().empty()) {
+    return Parse(dim.dim_param());
+  }
+  return std::nullopt;
+}
+
+void SymbolicDim::ToDimension(ONNX_NAMESPACE::TensorShapeProto_Dimension& dim) const {
+  if (IsConstant()) {
+    dim.set_dim_value(ConstantValue());
+  } else {
+    dim.set_dim_param(ToString());
+  }
+}
+
+bool SymbolicDim::IsConstant() const noexcept {
+  return terms_.empty() || (terms_.size() == 1 && terms_.begin()->first.empty());
+}
+
+int64_t SymbolicDim::ConstantValue() const {
+  ORT_ENFORCE(IsConstant(), "Expression ", ToString(), " is not a constant.");
+  return terms_.empty() ? 0 : terms_.begin()->second;
+}
+
+std::string SymbolicDim::ToString() const {
+  if (terms_.empty()) {
+    return "0";
+  }
+
+  // The constant term sorts first in the map but is written last, as in "2*seq+1".
+  std::string result;
+  auto write_term = [&result](const Monomial& monomial, int64_t coefficient) {
+    if (coefficient < 0) {
+      result += "-";
+      coefficient = -coefficient;
+    } else if (!result.empty()) {
+      result += "+";
+    }
+    if (monomial.empty() || coefficient != 1) {
+      result += std::to_string(coefficient);
+      if (!monomial.empty()) {
+        result += "*";
+      }
+    }
+    for (size_t i = 0; i < monomial.size(); ++i) {
+      result += (i > 0 ? "*" : "") + monomial[i];
+    }
+  };
+
+  for (const auto& [monomial, coefficient] : terms_) {
+    if (!monomial.empty()) {
+      write_term(monomial, coefficient);
+    }
+  }
+  auto constant = terms_.find(Monomial{});
+  if (constant != terms_.end()) {
+    write_term(constant->first, constant->second);
+  }
+  return result;
+}
+
+void SymbolicDim::AddTerm(const Monomial& monomial, int64_t coefficient) {
+  auto& value = terms_[monomial];
+  value += coefficient;
+  if (value == 0) {
+    terms_.erase(monomial);
+  }
+}
+
+SymbolicDim SymbolicDim::operator+(const SymbolicDim& other) const {
+  SymbolicDim result = *this;
+  for (const auto& [monomial, coefficient] : other.terms_) {
+    result.AddTerm(monomial, coefficient);
+  }
+  return result;
+}
+
+SymbolicDim SymbolicDim::operator-(const SymbolicDim& other) const {
+  SymbolicDim result = *this;
+  for (const auto& [monomial, coefficient] : other.terms_) {
+    result.AddTerm(monomial, -coefficient);
+  }
+  return result;
+}
+
+SymbolicDim SymbolicDim::operator*(const SymbolicDim& other) const {
+  SymbolicDim result;
+  for (const auto& [lhs_monomial, lhs_coefficient] : terms_) {
+    for (const auto& [rhs_monomial, rhs_coefficient] : other.terms_) {
+      Monomial monomial;
+      std::merge(lhs_monomial.begin(), lhs_monomial.end(), rhs_monomial.begin(), rhs_monomial.end(),
+                 std::back_inserter(monomial));
+      result.AddTerm(monomial, lhs_coefficient * rhs_coefficient);
+    }
+  }
+  return result;
+}
+
+std::optional<SymbolicDim> SymbolicDim::Divide(const SymbolicDim& divisor) const {
+  if (*this == divisor && !terms_.empty()) {
+    return SymbolicDim(1);
+  }
+  if (divisor.terms_.size() != 1) {
+    return std::nullopt;
+  }
+
+  const auto& [divisor_monomial, divisor_coefficient] = *divisor.terms_.begin();
+  SymbolicDim result;
+  for (const auto& [monomial, coefficient] : terms_) {
+    if (coefficient % divisor_coefficient != 0 ||
+        !std::includes(monomial.begin(), monomial.end(), divisor_monomial.begin(), divisor_monomial.end())) {
+      return std::nullopt;
+    }
+    Monomial quotient;
+    std::set_difference(monomial.begin(), monomial.end(), divisor_monomial.begin(), divisor_monomial.end(),
+                        std::back_inserter(quotient));
+    result.AddTerm(quotient, coefficient / divisor_coefficient);
+  }
+  return result;
+}
+
+}  // namespace onnxruntime
+
+#endif  // !defined(ORT_MINIMAL_BUILD)
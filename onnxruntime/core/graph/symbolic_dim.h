@@ -0,0 +1,72 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#if !defined(ORT_MINIMAL_BUILD)
+
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "core/graph/onnx_protobuf.h"
+
+namespace onnxruntime {
+
+/**
+@class SymbolicDim
+A dimension given as a polynomial with integer coefficients over named symbols, such as "batch*seq" or "2*seq+1".
+The terms are kept in a canonical order, so equal expressions compare equal and have the same string form,
+which is what is stored in the dim_param of a TensorShapeProto dimension.
+*/
+class SymbolicDim {
+ public:
+  SymbolicDim() = default;
+
+  explicit SymbolicDim(int64_t value);
+
+  static SymbolicDim Symbol(const std::string& name);
+
+  /** Parses the string form of an expression.
+  A string that is not a sum of products of integers and identifiers is treated as a single symbol. */
+  static SymbolicDim Parse(const std::string& dim_param);
+
+  /** Gets the expression of a dimension.
+  @returns nullopt if the dimension has neither a value nor a param. */
+  static std::optional<SymbolicDim> FromDimension(const ONNX_NAMESPACE::TensorShapeProto_Dimension& dim);
+
+  /** Sets dim to the value of a constant expression, or to the string form otherwise. */
+  void ToDimension(ONNX_NAMESPACE::TensorShapeProto_Dimension& dim) const;
+
+  bool IsConstant() const noexcept;
+
+  /** Gets the value of a constant expression. */
+  int64_t ConstantValue() const;
+
+  std::string ToString() const;
+
+  SymbolicDim operator+(const SymbolicDim& other) const;
+  SymbolicDim operator-(const SymbolicDim& other) const;
+  SymbolicDim operator*(const SymbolicDim& other) const;
+
+  /** Divides by a constant or by a single term.
+  @returns nullopt unless every term is exactly divisible by the divisor. */
+  std::optional<SymbolicDim> Divide(const SymbolicDim& divisor) const;
+
+  bool operator==(const SymbolicDim& other) const { return terms_ == other.terms_; }
+  bool operator!=(const SymbolicDim& other) const { return terms_ != other.terms_; }
+
+ private:
+  // Sorted symbol names of a term, with a symbol repeated for each power. The constant term is empty.
+  using Monomial = std::vector<std::string>;
+
+  void AddTerm(const Monomial& monomial, int64_t coefficient);
+
+  // Coefficient of each term. Terms with a zero coefficient are not stored.
+  std::map<Monomial, int64_t> terms_;
+};
+
+}  // namespace onnxruntime
+
+#endif  // !defined(ORT_MINIMAL_BUILD)
@@ -0,0 +1,314 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#if !defined(ORT_MINIMAL_BUILD)
+
+#include "core/graph/symbolic_shape_inference.h"
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+#include "core/framework/tensorprotoutils.h"
+#include "core/graph/symbolic_dim.h"
+
+using namespace ONNX_NAMESPACE;
+
+namespace onnxruntime {
+
+namespace {
+
+// Values of a tensor with rank 0 or 1. An element is nullopt if it is unknown.
+using Values = std::vector<std::optional<SymbolicDim>>;
+
+bool IsIntegerTensor(const NodeArg& arg) {
+  const auto* type = arg.TypeAsProto();
+  return type != nullptr && utils::HasTensorType(*type) &&
+         (type->tensor_type().elem_type() == TensorProto_DataType_INT64 ||
+          type->tensor_type().elem_type() == TensorProto_DataType_INT32);
+}
+
+int64_t GetIntAttribute(const Node& node, const std::string& name, int64_t default_value) {
+  const auto& attributes = node.GetAttributes();
+  auto it = attributes.find(name);
+  return it != attributes.end() ? it->second.i() : default_value;
+}
+
+template <typename T>
+std::optional<Values> UnpackValues(const Graph& graph, const TensorProto& initializer, size_t size) {
+  std::vector<T> data(size);
+  if (!utils::UnpackTensor(initializer, graph.ModelPath(), data.data(), size).IsOK()) {
+    return std::nullopt;
+  }
+  Values values;
+  for (T value : data) {
+    values.push_back(SymbolicDim(static_cast<int64_t>(value)));
+  }
+  return values;
+}
+
+std::optional<Values> GetInputValues(const Graph& graph, const Node& node, size_t index) {
+  const auto& input_defs = node.InputDefs();
+  if (index >= input_defs.size() || !input_defs[index]->Exists()) {
+    return std::nullopt;
+  }
+
+  const NodeArg& input = *input_defs[index];
+  if (const auto* inferred_values = input.InferredShapeValues()) {
+    Values values;
+    for (const auto& dim : inferred_values->dim()) {
+      values.push_back(SymbolicDim::FromDimension(dim));
+    }
+    return values;
+  }
+
+  const TensorProto* initializer = graph.GetConstantInitializer(input.Name(), true);
+  if (initializer == nullptr || initializer->dims_size() > 1) {
+    return std::nullopt;
+  }
+  const int64_t size = initializer->dims_size() == 0 ? 1 : initializer->dims(0);
+  if (size < 0 || size > kMaxInferredShapeValues) {
+    return std::nullopt;
+  }
+  if (initializer->data_type() == TensorProto_DataType_INT64) {
+    return UnpackValues<int64_t>(graph, *initializer, static_cast<size_t>(size));
+  }
+  if (initializer->data_type() == TensorProto_DataType_INT32) {
+    return UnpackValues<int32_t>(graph, *initializer, static_cast<size_t>(size));
+  }
+  return std::nullopt;
+}
+
+// Gets the values of an input if they are all constants.
+std::optional<std::vector<int64_t>> GetConstantInputValues(const Graph& graph, const Node& node, size_t index) {
+  auto values = GetInputValues(graph, node, index);
+  if (!values.has_value()) {
+    return std::nullopt;
+  }
+  std::vector<int64_t> result;
+  for (const auto& value : *values) {
+    if (!value.has_value() || !value->IsConstant()) {
+      return std::nullopt;
+    }
+    result.push_back(value->ConstantValue());
+  }
+  return result;
+}
+
+std::optional<Values> InferShape(const Node& node) {
+  const auto* shape = node.InputDefs()[0]->Shape();
+  if (shape == nullptr) {
+    return std::nullopt;
+  }
+
+  // Opset-15 Shape supports slicing using a 'start' and 'end' attribute
+  const int64_t rank = shape->dim_size();
+  int64_t start = GetIntAttribute(node, "start", 0);
+  int64_t end = GetIntAttribute(node, "end", std::numeric_limits<int64_t>::max());
+  start = std::clamp(start < 0 ? start + rank : start, int64_t{0}, rank);
+  end = std::clamp(end < 0 ? end + rank : end, int64_t{0}, rank);
+
+  Values values;
+  for (int64_t i = start; i < end; ++i) {
+    values.push_back(SymbolicDim::FromDimension(shape->dim(static_cast<int>(i))));
+  }
+  return values;
+}
+
+std::optional<Values> InferSize(const Node& node) {
+  const auto* shape = node.InputDefs()[0]->Shape();
+  if (shape == nullptr) {
+    return std::nullopt;
+  }
+
+  SymbolicDim size(1);
+  for (const auto& dim : shape->dim()) {
+    auto value = SymbolicDim::FromDimension(dim);
+    if (!value.has_value()) {
+      return std::nullopt;
+    }
+    size = size * *value;
+  }
+  return Values{size};
+}
+
+std::optional<Values> InferGather(const Graph& graph, const Node& node) {
+  const auto* data_shape = node.InputDefs()[0]->Shape();
+  const int64_t axis = GetIntAttribute(node, "axis", 0);
+  if (data_shape == nullptr || data_shape->dim_size() != 1 || (axis != 0 && axis != -1)) {
+    return std::nullopt;
+  }
+
+  auto data = GetInputValues(graph, node, 0);
+  auto indices = GetConstantInputValues(graph, node, 1);
+  if (!data.has_value() || !indices.has_value()) {
+    return std::nullopt;
+  }
+
+  const int64_t size = static_cast<int64_t>(data->size());
+  Values values;
+  for (int64_t index : *indices) {
+    index = index < 0 ? index + size : index;
+    if (index < 0 || index >= size) {
+      return std::nullopt;
+    }
+    values.push_back((*data)[static_cast<size_t>(index)]);
+  }
+  return values;
+}
+
+std::optional<Values> InferSlice(const Graph& graph, const Node& node) {
+  auto data = GetInputValues(graph, node, 0);
+  auto starts = GetConstantInputValues(graph, node, 1);
+  auto ends = GetConstantInputValues(graph, node, 2);
+  if (!data.has_value() || !starts.has_value() || !ends.has_value() || starts->size() != 1 || ends->size() != 1) {
+    return std::nullopt;
+  }
+
+  const auto& input_defs = node.InputDefs();
+  if (input_defs.size() > 3 && input_defs[3]->Exists()) {
+    auto axes = GetConstantInputValues(graph, node, 3);
+    if (!axes.has_value() || axes->size() != 1 || ((*axes)[0] != 0 && (*axes)[0] != -1)) {
+      return std::nullopt;
+    }
+  }
+
+  int64_t step = 1;
+  if (input_defs.size() > 4 && input_defs[4]->Exists()) {
+    auto steps = GetConstantInputValues(graph, node, 4);
+    if (!steps.has_value() || steps->size() != 1 || (*steps)[0] == 0) {
+      return std::nullopt;
+    }
+    step = (*steps)[0];
+  }
+
+  // Clamp the start and end as the Slice kernel does.
+  const int64_t size = static_cast<int64_t>(data->size());
+  int64_t start = (*starts)[0];
+  int64_t end = (*ends)[0];
+  start = start < 0 ? start + size : start;
+  end = end < 0 ? end + size : end;
+  if (step > 0) {
+    start = std::clamp(start, int64_t{0}, size);
+    end = std::clamp(end, int64_t{0}, size);
+  } else {
+    start = std::clamp(start, int64_t{0}, size - 1);
+    end = std::clamp(end, int64_t{-1}, size - 1);
+  }
+
+  Values values;
+  for (int64_t i = start; step > 0 ? i < end : i > end; i += step) {
+    values.push_back((*data)[static_cast<size_t>(i)]);
+  }
+  return values;
+}
+
+std::optional<Values> InferConcat(const Graph& graph, const Node& node) {
+  const int64_t axis = GetIntAttribute(node, "axis", 0);
+  if (axis != 0 && axis != -1) {
+    return std::nullopt;
+  }
+
+  Values values;
+  for (size_t i = 0; i < node.InputDefs().size(); ++i) {
+    auto input = GetInputValues(graph, node, i);
+    if (!input.has_value()) {
+      // Keep the values that are known if the number of elements of the input is.
+      const auto* shape = node.InputDefs()[i]->Shape();
+      if (shape == nullptr || shape->dim_size() != 1 || !utils::HasDimValue(shape->dim(0)) ||
+          shape->dim(0).dim_value() > kMaxInferredShapeValues) {
+        return std::nullopt;
+      }
+      input = Values(static_cast<size_t>(shape->dim(0).dim_value()));
+    }
+    values.insert(values.end(), input->begin(), input->end());
+  }
+  return values;
+}
+
+std::optional<Values> InferElementwise(const Graph& graph, const Node& node) {
+  auto lhs = GetInputValues(graph, node, 0);
+  auto rhs = GetInputValues(graph, node, 1);
+  if (!lhs.has_value() || !rhs.has_value() ||
+      (lhs->size() != rhs->size() && lhs->size() != 1 && rhs->size() != 1)) {
+    return std::nullopt;
+  }
+
+  const std::string& op_type = node.OpType();
+  const size_t size = std::max(lhs->size(), rhs->size());
+  Values values(size);
+  for (size_t i = 0; i < size; ++i) {
+    const auto& a = (*lhs)[lhs->size() == 1 ? 0 : i];
+    const auto& b = (*rhs)[rhs->size() == 1 ? 0 : i];
+    if (!a.has_value() || !b.has_value()) {
+      continue;
+    }
+    if (op_type == "Add") {
+      values[i] = *a + *b;
+    } else if (op_type == "Sub") {
+      values[i] = *a - *b;
+    } else if (op_type == "Mul") {
+      values[i] = *a * *b;
+    } else if (a->IsConstant() && b->IsConstant()) {
+      // Integer Div truncates.
+      if (b->ConstantValue() != 0) {
+        values[i] = SymbolicDim(a->ConstantValue() / b->ConstantValue());
+      }
+    } else {
+      values[i] = a->Divide(*b);
+    }
+  }
+  return values;
+}
+
+}  // namespace
+
+std::optional<TensorShapeProto> InferShapeValues(const Graph& graph, const Node& node) {
+  // The values are tracked for small integer tensors of rank 0 or 1 only.
+  if (node.Domain() != kOnnxDomain || node.OutputDefs().empty() || !node.OutputDefs()[0]->Exists() ||
+      !IsIntegerTensor(*node.OutputDefs()[0]) || node.InputDefs().empty() || !node.InputDefs()[0]->Exists()) {
+    return std::nullopt;
+  }
+  const auto* output_shape = node.OutputDefs()[0]->Shape();
+  if (output_shape == nullptr || output_shape->dim_size() > 1) {
+    return std::nullopt;
+  }
+
+  const std::string& op_type = node.OpType();
+  std::optional<Values> values;
+  if (op_type == "Shape") {
+    values = InferShape(node);
+  } else if (op_type == "Size") {
+    values = InferSize(node);
+  } else if (op_type == "Gather") {
+    values = InferGather(graph, node);
+  } else if (op_type == "Slice" && node.SinceVersion() >= 10) {
+    values = InferSlice(graph, node);
+  } else if (op_type == "Concat") {
+    values = InferConcat(graph, node);
+  } else if (op_type == "Add" || op_type == "Sub" || op_type == "Mul" || op_type == "Div") {
+    values = InferElementwise(graph, node);
+  } else if (op_type == "Unsqueeze" || op_type == "Squeeze" || op_type == "Reshape" || op_type == "Flatten" ||
+             op_type == "Identity" || op_type == "Cast") {
+    // The output has the elements of the input in the same order, and Cast is to an integer type.
+    values = GetInputValues(graph, node, 0);
+  }
+
+  if (!values.has_value() || values->size() > static_cast<size_t>(kMaxInferredShapeValues) ||
+      std::none_of(values->begin(), values->end(), [](const auto& value) { return value.has_value(); })) {
+    return std::nullopt;
+  }
+
+  TensorShapeProto result;
+  for (const auto& value : *values) {
+    auto* dim = result.add_dim();
+    if (value.has_value()) {
+      value->ToDimension(*dim);
+    }
+  }
+  return result;
+}
+
+}  // namespace onnxruntime
+
+#endif  // !defined(ORT_MINIMAL_BUILD)
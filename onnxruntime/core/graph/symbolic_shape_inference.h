@@ -0,0 +1,29 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#if !defined(ORT_MINIMAL_BUILD)
+
+#include <optional>
+
+#include "core/graph/graph.h"
+
+namespace onnxruntime {
+
+/** Maximum number of elements of a tensor whose values are tracked by InferShapeValues. */
+constexpr int kMaxInferredShapeValues = 64;
+
+/**
+Derives the values of the output of a node that computes on shapes, such as Shape, Gather, Slice, Concat,
+Unsqueeze and the arithmetic ops, from the shapes and values of its inputs.
+Values are symbolic expressions over the dim_params of the input shapes (see SymbolicDim), so for example
+Mul(Shape(x)[0], Shape(x)[1]) with x of shape [batch, seq, 768] has the value "batch*seq".
+The input values are taken from NodeArg::InferredShapeValues, or from small integer constant initializers.
+@returns The values of output 0 as one dimension per element, or nullopt if none of them is known.
+*/
+std::optional<ONNX_NAMESPACE::TensorShapeProto> InferShapeValues(const Graph& graph, const Node& node);
+
+}  // namespace onnxruntime
+
+#endif  // !defined(ORT_MINIMAL_BUILD)
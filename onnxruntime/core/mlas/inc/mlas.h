@@ -64,6 +64,9 @@ Abstract:
 #define MLAS_TARGET_WASM
 #if defined(__wasm_simd128__)
 #define MLAS_TARGET_WASM_SIMD
+#if defined(__wasm_relaxed_simd__)
+#define MLAS_TARGET_WASM_RELAXED_SIMD
+#endif
 #else
 #define MLAS_TARGET_WASM_SCALAR
 #endif
@@ -143,6 +146,53 @@ MlasPlatformU8S8Overflow(
     void
     );
 
+/**
+ * @brief Instruction set levels of the x86 kernels, in the order the platform
+ *        initialization selects them
+ */
+enum MLAS_ISA_LEVEL {
+    MlasIsaLevelSse2,
+    MlasIsaLevelSse41,
+    MlasIsaLevelAvx,
+    MlasIsaLevelAvx2,
+    MlasIsaLevelAvxVnni,
+    MlasIsaLevelAvx512F,
+    MlasIsaLevelAvx512Core,
+    MlasIsaLevelAvx512Vnni,
+    MlasIsaLevelAmx,
+    MlasIsaLevelCount,
+};
+
+/**
+ * @brief Re-initializes the platform so that the kernels are selected as if
+ *        the processor did not support the instruction sets above the supplied
+ *        level. Levels the processor does not support are not enabled. This is
+ *        meant for benchmarks and tests that compare the kernels of several
+ *        levels on the same machine.
+ *
+ *        Must not be called while other MLAS routines are running. Buffers
+ *        packed before the call (MlasGemmPackB and friends) are not valid
+ *        afterwards, since the packing format depends on the kernels.
+ *
+ * @param MaximumIsaLevel  Supplies the highest instruction set level to use.
+ */
+void
+MLASCALL
+MlasSetMaximumIsaLevel(
+    MLAS_ISA_LEVEL MaximumIsaLevel
+    );
+
+/**
+ * @brief Returns the lowercase name of an instruction set level, for example
+ *        "avx2", as accepted by the --mlas_isa option of the MLAS benchmarks
+ *        and unit tests
+ */
+const char*
+MLASCALL
+MlasGetIsaLevelName(
+    MLAS_ISA_LEVEL IsaLevel
+    );
+
 #endif
 
 
@@ -196,6 +246,34 @@ MlasActivation(
 // op(X) = X or op(X) = transpose(X) or op(X) = conjg(transpose(X))
 //
 
+/**
+ * @brief Element-wise functions that an SGEMM epilogue can apply in addition
+ *        to the MLAS_ACTIVATION kinds
+ */
+enum MLAS_SGEMM_EPILOGUE_FUNCTION {
+    MlasSgemmEpilogueNoFunction,
+    MlasSgemmEpilogueGelu, /**< x * 0.5 * (1 + erf(x / sqrt(2))) */
+    MlasSgemmEpilogueSilu, /**< x * sigmoid(x) */
+};
+
+/**
+ * @brief Describes the operations applied to each output tile of a single
+ *        precision gemm while the tile is still resident in the cache.
+ *
+ *        C := Function(Activation(C + Bias + Residual))
+ *
+ *        where C is the result of the multiplication (including the beta
+ *        term), Bias is broadcast along the rows and Residual is an M x N
+ *        matrix. Each operation is optional.
+ */
+struct MLAS_SGEMM_EPILOGUE {
+    const float* Bias = nullptr;                  /**< Supplies the optional bias vector of N elements */
+    const float* Residual = nullptr;              /**< Supplies the optional residual matrix */
+    size_t ldr = 0;                               /**< Supplies the first dimension of the residual matrix */
+    const MLAS_ACTIVATION* Activation = nullptr;  /**< Supplies the optional activation */
+    MLAS_SGEMM_EPILOGUE_FUNCTION Function = MlasSgemmEpilogueNoFunction; /**< Supplies the optional function */
+};
+
 /**
  * @brief Supply matrices data information to single precision gemm functions
  */
@@ -209,6 +287,7 @@ struct MLAS_SGEMM_DATA_PARAMS {
     float alpha = 1.0f;       /**< Supplies the scalar alpha multiplier (see SGEMM definition) */
     float beta = 0.0f;        /**< Supplies the scalar beta multiplier (see SGEMM definition) */
     bool BIsPacked = false;   /**< Whether B is pre-packed */
+    const MLAS_SGEMM_EPILOGUE* Epilogue = nullptr; /**< Supplies the optional output tile epilogue */
 };
 
 /**
@@ -489,6 +568,85 @@ MlasGemm(
     MlasGemmBatch(TransA, TransB, M, N, K, &Data, 1, ThreadPool);
 }
 
+/**
+ * @brief Whether current CPU supports single precision matrix multiply
+ *        with bfloat16 inputs (SBGEMM).
+ */
+bool
+MLASCALL
+MlasBf16AccelerationSupported(
+    void
+    );
+
+/**
+ * @brief  Batched single precision matrix/matrix multiply operation computed
+ *         with bfloat16 inputs and single precision accumulation (SBGEMM).
+ *
+ *         Matrices A and B are rounded to bfloat16 before the multiplication,
+ *         so the result is less accurate than MlasGemmBatch. Only supported
+ *         when MlasBf16AccelerationSupported() returns true.
+ *
+ * @param TransA     Supplies the transpose operation for matrix A.
+ * @param TransB     Supplies the transpose operation for matrix B.
+ * @param M          Supplies the number of rows of matrix A and matrix C.
+ * @param N          Supplies the number of columns of matrix B and matrix C.
+ * @param K          Supplies the number of columns of matrix A and the number
+                     of rows of matrix B.
+ * @param Data       A array of matrices data parameters. A pre-packed B must
+                     be packed by MlasSBGemmPackB.
+ * @param BatchSize  Supplies number of multiplications in this batch
+ * @param ThreadPool Supplies the thread pool object to use, else nullptr if the
+                     base library threading support should be used.
+ */
+void
+MLASCALL
+MlasSBGemmBatch(
+    CBLAS_TRANSPOSE TransA,
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    const MLAS_SGEMM_DATA_PARAMS* Data,
+    size_t BatchSize,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+/**
+ * @brief For SBGEMM, returns size of the packing buffer needed for right
+ *        hand side
+ * @param N  Number of columns
+ * @param K  Number of rows
+ * @return  size of the packing buffer,
+ *          0 if operation not supported
+ */
+size_t
+MLASCALL
+MlasSBGemmPackBSize(
+    size_t N,
+    size_t K
+    );
+
+/**
+ * @brief For SBGEMM, convert the float matrix B to bfloat16 and pack it
+ *        into a packing buffer sized by MlasSBGemmPackBSize
+ * @param TransB   Supplies the transpose operation for matrix B.
+ * @param N        Number of columns
+ * @param K        Number of rows
+ * @param B        Address of matrix B
+ * @param ldb      leading dimension of input matrix B
+ * @param PackedB  Address of the packed matrix
+ */
+void
+MLASCALL
+MlasSBGemmPackB(
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const float* B,
+    size_t ldb,
+    void* PackedB
+    );
+
 enum class MLAS_QUANTIZATION_GRANULARITY {
     PerMatrix,
     PerColumn,
@@ -625,6 +783,62 @@ MlasGemm(
     MlasGemmBatch(Shape, &DataParams, 1, ThreadPool);
 }
 
+/**
+ * @brief Supply data parameters for dynamically quantized GEMM. Matrix A is
+ *        float, and it is quantized to uint8 a block of rows at a time, right
+ *        before the block is multiplied, so that the quantized rows are still
+ *        in the cache. The float output is
+ *        C = (A_quant - ZeroPointA) * ScaleA * ScaleB * (B - ZeroPointB) + Bias
+ */
+struct MLAS_GEMM_DYNAMIC_QUANT_DATA_PARAMS {
+    const float* A = nullptr;
+    size_t lda = 0;
+    float ScaleA = 1.0f;           /**< Scale of A, ignored with per-row scales */
+    uint8_t ZeroPointA = 0;        /**< Zero point of A, ignored with per-row scales */
+    const void* B = nullptr;
+    size_t ldb = 0;
+    const uint8_t* ZeroPointB = nullptr;
+    bool BIsPacked = false;
+    bool PerColumnZeroPoints = false;
+    const float* ScaleB = nullptr; /**< Optional scale of B, per matrix or per column */
+    bool PerColumnScaleB = false;
+    const float* Bias = nullptr;   /**< Optional bias of N elements */
+    float* C = nullptr;
+    size_t ldc = 0;
+    float OutlierThreshold = 0.0f; /**< Columns of A with a larger magnitude are multiplied in float, 0 disables */
+};
+
+/**
+ * @brief Batched GEMM of float matrices A, quantized on the fly, with
+ *        quantized matrices B.
+ *
+ *        With per-row scales, each row of A is quantized symmetrically with
+ *        its own scale and a zero point of 128, which keeps the accuracy of
+ *        rows with small values next to rows with large values. Otherwise the
+ *        ScaleA and ZeroPointA of the data parameters are used.
+ *
+ *        With an OutlierThreshold, the columns of A that have a value of a
+ *        larger magnitude in a block of rows are left out of the quantization
+ *        of the rows, and are multiplied in float with the dequantized rows of
+ *        B instead (mixed precision decomposition of outlier channels). This
+ *        requires per-row scales and a B that is not packed.
+ *
+ * @param [IN]  Shape        Shape of the multiplications, A must be unsigned
+ * @param [IN]  DataParams   Array of data descriptors for the matrices.
+ * @param [IN]  BatchN       Size of the parameters array
+ * @param [IN]  PerRowScaleA Whether to quantize A with per-row scales
+ * @param [IN]  ThreadPool   optional thread pool for parallel processing
+ */
+void
+MLASCALL
+MlasDynamicQuantizeGemmBatch(
+    const MLAS_GEMM_QUANT_SHAPE_PARAMS& Shape,
+    const MLAS_GEMM_DYNAMIC_QUANT_DATA_PARAMS* DataParams,
+    const size_t BatchN,
+    bool PerRowScaleA,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
 //
 // Symmetric QGEMM has limited buffer overrun.
 // Currently only supported in ARM64
@@ -751,6 +965,7 @@ enum MLAS_CONV_ALGORITHM {
     MlasConvAlgorithmGemmDirect,
     MlasConvAlgorithmExpandThenGemm,
     MlasConvAlgorithmExpandThenGemmSegmented,
+    MlasConvAlgorithmWinograd,
 #if defined(MLAS_TARGET_WASM_SCALAR)
     MlasConvAlgorithmDepthwise,
 #endif
@@ -773,6 +988,7 @@ struct MLAS_CONV_PARAMETERS {
     size_t OutputSize;
     size_t K;
     float Beta;
+    bool Bf16Compute;
     MLAS_CONV_ALGORITHM Algorithm;
     ptrdiff_t ThreadCount;
     union {
@@ -783,6 +999,10 @@ struct MLAS_CONV_PARAMETERS {
         struct {
             size_t ThreadStrideN;
         } ExpandThenGemmSegmented;
+        struct {
+            size_t TileCount;
+            size_t TileBlockSize;
+        } Winograd;
     } u;
 };
 
@@ -802,7 +1022,8 @@ MlasConvPrepare(MLAS_CONV_PARAMETERS* Parameters,
                 const MLAS_ACTIVATION* Activation,
                 size_t* WorkingBufferSize,
                 float Beta,
-                MLAS_THREADPOOL* ThreadPool);
+                MLAS_THREADPOOL* ThreadPool,
+                bool UseBf16Compute = false);
 
 void
 MLASCALL
@@ -1013,6 +1234,124 @@ MlasComputeSoftmax(
     MLAS_THREADPOOL* ThreadPool
     );
 
+/**
+ * @brief Supply the shapes and buffers to the fused attention routine
+ */
+struct MLAS_FLASH_ATTENTION_PARAMS {
+    size_t BatchSize = 0;            /**< Supplies the batch size (B) */
+    size_t NumHeads = 0;             /**< Supplies the number of attention heads (N) */
+    size_t SequenceLength = 0;       /**< Supplies the sequence length of the query (S) */
+    size_t KvSequenceLength = 0;     /**< Supplies the sequence length of the key and value (L) */
+    size_t QkHeadSize = 0;           /**< Supplies the head size of the query and key (H) */
+    size_t VHeadSize = 0;            /**< Supplies the head size of the value (H_v) */
+    float Scale = 1.0f;              /**< Supplies the scale applied to the query-key products */
+    bool Causal = false;             /**< Query i only attends to keys up to i + L - S when true */
+    const float* Query = nullptr;    /**< Supplies the query with shape BxNxSxH */
+    const float* Key = nullptr;      /**< Supplies the key with shape BxNxLxH */
+    const float* Value = nullptr;    /**< Supplies the value with shape BxNxLxH_v */
+    float* Output = nullptr;         /**< Receives the output with shape BxSxNxH_v */
+};
+
+/**
+ * @brief  Computes softmax(Scale * Query x Key') x Value without materializing
+ *         the SxL attention probabilities. The key and value are processed in
+ *         blocks while a running maximum and sum of exponentials is kept for
+ *         each query row (online softmax).
+ *
+ * @param Params     Supplies the attention shapes and buffers.
+ * @param ThreadPool Supplies the thread pool object to use, else nullptr if the
+                     base library threading support should be used.
+ */
+void
+MLASCALL
+MlasFlashAttention(
+    const MLAS_FLASH_ATTENTION_PARAMS* Params,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+/**
+ * @brief Supply the buffers to the layer normalization routine. The optional
+ *        residual and bias are added to the input before it is normalized.
+ */
+struct MLAS_LAYER_NORM_PARAMS {
+    const float* Input = nullptr;     /**< Supplies the input rows, N x D */
+    const float* Skip = nullptr;      /**< Optionally supplies a residual added to the input, N x D */
+    const float* Bias = nullptr;      /**< Optionally supplies a bias of D elements added to the input */
+    const float* Scale = nullptr;     /**< Supplies the scale (gamma) of D elements */
+    const float* NormBias = nullptr;  /**< Optionally supplies the bias (beta) of D elements */
+    float* Output = nullptr;          /**< Receives the normalized rows, N x D */
+    float* SumOutput = nullptr;       /**< Optionally receives Input + Skip + Bias, N x D */
+    float* Mean = nullptr;            /**< Optionally receives the mean of each row */
+    float* InvStdDev = nullptr;       /**< Optionally receives the inverse standard deviation of each row */
+    float Epsilon = 0.0f;             /**< Supplies the epsilon added to the variance */
+    bool Simplified = false;          /**< Computes RMS normalization (no mean subtraction) when true */
+};
+
+/**
+ * @brief  Computes layer normalization (or RMS normalization) of N rows of D
+ *         elements, with the optional residual and bias inputs fused ahead of
+ *         the normalization.
+ *
+ * @param Params     Supplies the buffers and options.
+ * @param N          Supplies the number of rows.
+ * @param D          Supplies the number of elements per row.
+ * @param ThreadPool Supplies the thread pool object to use, else nullptr if the
+                     base library threading support should be used.
+ */
+void
+MLASCALL
+MlasComputeLayerNorm(
+    const MLAS_LAYER_NORM_PARAMS* Params,
+    size_t N,
+    size_t D,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+/**
+ * @brief  Computes C = A * B for row major int16 matrices, with int32
+ *         accumulation. Pairs of products along K are summed in int32 before
+ *         they are accumulated (vpmaddwd), so the only product pair that
+ *         overflows is two -32768 * -32768 products. Weights quantized to 8
+ *         bits can be sign or zero extended to int16 by the caller.
+ *
+ * @param M          Supplies the number of rows of A and C.
+ * @param N          Supplies the number of columns of B and C.
+ * @param K          Supplies the number of columns of A and rows of B.
+ * @param A          Supplies the A matrix.
+ * @param lda        Supplies the first dimension of the A matrix.
+ * @param B          Supplies the B matrix.
+ * @param ldb        Supplies the first dimension of the B matrix.
+ * @param C          Receives the C matrix.
+ * @param ldc        Supplies the first dimension of the C matrix.
+ * @param ThreadPool Supplies the thread pool object to use, else nullptr if the
+                     base library threading support should be used.
+ */
+void
+MLASCALL
+MlasGemmS16(
+    size_t M,
+    size_t N,
+    size_t K,
+    const int16_t* A,
+    size_t lda,
+    const int16_t* B,
+    size_t ldb,
+    int32_t* C,
+    size_t ldc,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+void
+MLASCALL
+MlasRotaryEmbedOneRow(
+    const float* Input,
+    const float* SinData,
+    const float* CosData,
+    size_t RotaryEmbeddingDim,
+    bool Interleaved,
+    float* Output
+    );
+
 void
 MLASCALL
 MlasComputeTanh(
@@ -1034,6 +1373,36 @@ MlasConvertHalfToFloatBuffer(
     size_t Count
     );
 
+extern "C"
+void
+MLASCALL
+MlasConvertFloatToHalfBuffer(
+    const float* Source,
+    unsigned short* Destination,
+    size_t Count
+    );
+
+//
+// Brain floating-point routines. Conversions to bfloat16 round to nearest
+// even and map NaNs to the quiet NaN of the same sign.
+//
+
+void
+MLASCALL
+MlasConvertBFloat16ToFloatBuffer(
+    const unsigned short* Source,
+    float* Destination,
+    size_t Count
+    );
+
+void
+MLASCALL
+MlasConvertFloatToBFloat16Buffer(
+    const float* Source,
+    unsigned short* Destination,
+    size_t Count
+    );
+
 //
 // Transpose routines.
 //
@@ -1394,6 +1763,109 @@ MlasQLinearMul(
     bool IsScalarB
     );
 
+/**
+ * @brief Quantized add of two vectors of size N, followed by an optional
+ *        lookup of the sums in a table of 256 entries indexed by the bit
+ *        pattern of the quantized value. OutputC may alias InputA or InputB.
+ *
+ *        Used as the residual add and activation epilogue of quantized
+ *        convolutions, which requantize a block of the result that is still
+ *        in cache.
+ *
+ * @param Table     Optional lookup table of a quantized activation, or
+ *                  nullptr to store the sums directly
+*/
+template<typename DataType>
+void
+MLASCALL
+MlasQLinearAddLookup(
+    const DataType* InputA,
+    float ScaleA,
+    int32_t ZeroPointA,
+    const DataType* InputB,
+    float ScaleB,
+    int32_t ZeroPointB,
+    float ScaleC,
+    int32_t ZeroPointC,
+    const DataType* Table,
+    DataType* OutputC,
+    size_t N
+    );
+
+/**
+ * @brief Output processor of a quantized GEMM that requantizes a tile of the
+ *        result, adds the tile of a quantized residual input with the same
+ *        layout as the output and optionally applies the lookup table of a
+ *        quantized activation, before the tile leaves the cache.
+*/
+template<typename OutputType>
+class MLAS_QGEMM_REQUANT_ADD_OUTPUT_PROCESSOR : public MLAS_QGEMM_OUTPUT_PROCESSOR
+{
+   public:
+    MLAS_QGEMM_REQUANT_ADD_OUTPUT_PROCESSOR(
+        OutputType* Output,
+        size_t OutputLeadingDimension,
+        const int32_t* Bias,
+        const float* Scale,
+        bool PerColumnScale,
+        float OutputScale,
+        OutputType ZeroPoint,
+        const OutputType* Sum,
+        float SumScale,
+        int32_t SumZeroPoint,
+        float ResultScale,
+        int32_t ResultZeroPoint,
+        const OutputType* Table)
+        : Output_(Output),
+          OutputLeadingDimension_(OutputLeadingDimension),
+          Bias_(Bias),
+          Scale_(Scale),
+          PerColumnScale_(PerColumnScale),
+          OutputScale_(OutputScale),
+          ZeroPoint_(ZeroPoint),
+          Sum_(Sum),
+          SumScale_(SumScale),
+          SumZeroPoint_(SumZeroPoint),
+          ResultScale_(ResultScale),
+          ResultZeroPoint_(ResultZeroPoint),
+          Table_(Table)
+    {
+    }
+
+    void Process(const int32_t* C,
+                 size_t StartM,
+                 size_t StartN,
+                 size_t CountM,
+                 size_t CountN,
+                 size_t ldc) const override
+    {
+        MlasRequantizeOutput(C, ldc, Output_, OutputLeadingDimension_, Bias_, Scale_, PerColumnScale_,
+                             ZeroPoint_, StartM, StartN, CountM, CountN);
+
+        for (size_t m = StartM; m < StartM + CountM; m++) {
+            OutputType* Output = Output_ + m * OutputLeadingDimension_ + StartN;
+            const OutputType* Sum = Sum_ + m * OutputLeadingDimension_ + StartN;
+            MlasQLinearAddLookup(Output, OutputScale_, int32_t(ZeroPoint_), Sum, SumScale_, SumZeroPoint_,
+                                 ResultScale_, ResultZeroPoint_, Table_, Output, CountN);
+        }
+    }
+
+   private:
+    OutputType* Output_;
+    size_t OutputLeadingDimension_;
+    const int32_t* Bias_;
+    const float* Scale_;
+    bool PerColumnScale_;
+    float OutputScale_;
+    OutputType ZeroPoint_;
+    const OutputType* Sum_;
+    float SumScale_;
+    int32_t SumZeroPoint_;
+    float ResultScale_;
+    int32_t ResultZeroPoint_;
+    const OutputType* Table_;
+};
+
 //
 // Half precision routines
 //
@@ -1688,4 +2160,81 @@ MlasNhwcAvgPool(
     size_t KernelSize
     );
 
+enum MLAS_HALF_ELTWISE_KIND {
+    MlasHalfEltwiseAdd,
+    MlasHalfEltwiseSub,
+    MlasHalfEltwiseMul,
+    MlasHalfEltwiseDiv,
+};
+
+/**
+ * @brief Elementwise binary operation on fp16 vectors, Output = InputA op InputB
+ * @param Kind          The binary operation
+ * @param InputA        Address of the first operand
+ * @param BroadcastA    InputA points to a single value used for all elements
+ * @param InputB        Address of the second operand
+ * @param BroadcastB    InputB points to a single value used for all elements
+ * @param Output        Address of the result, may alias an input of N elements
+ * @param N             Number of output elements
+*/
+void
+MLASCALL
+MlasHalfEltwiseBinary(
+    MLAS_HALF_ELTWISE_KIND Kind,
+    const MLAS_FP16* InputA,
+    bool BroadcastA,
+    const MLAS_FP16* InputB,
+    bool BroadcastB,
+    MLAS_FP16* Output,
+    size_t N
+    );
+
+/**
+ * @brief Softmax or log softmax over the rows of an fp16 matrix. The
+ *        exponentials and their sums are computed in fp32.
+ * @param Input         Address of the input matrix
+ * @param Output        Address of the output matrix, may be the same as Input
+ * @param N             Number of rows
+ * @param D             Number of columns per row
+ * @param LogSoftmax    Compute log softmax instead of softmax
+ * @param ThreadPool    Thread pool to use
+*/
+void
+MLASCALL
+MlasComputeHalfSoftmax(
+    const MLAS_FP16* Input,
+    MLAS_FP16* Output,
+    size_t N,
+    size_t D,
+    bool LogSoftmax,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+/**
+ * @brief Layer normalization of one fp16 row. The mean and the variance are
+ *        accumulated in fp32.
+ * @param Input         Address of the input row
+ * @param Scale         Address of the scale vector of D elements
+ * @param Bias          Address of the bias vector of D elements, optional
+ * @param Output        Address of the output row, may be the same as Input
+ * @param D             Number of elements in the row
+ * @param Epsilon       Added to the variance to avoid dividing by zero
+ * @param Simplified    Skip mean subtraction (RMS normalization)
+ * @param Mean          Receives the mean of the row, zero when Simplified
+ * @param InvStdDev     Receives the reciprocal of the standard deviation
+*/
+void
+MLASCALL
+MlasComputeHalfLayerNorm(
+    const MLAS_FP16* Input,
+    const MLAS_FP16* Scale,
+    const MLAS_FP16* Bias,
+    MLAS_FP16* Output,
+    size_t D,
+    float Epsilon,
+    bool Simplified,
+    float* Mean,
+    float* InvStdDev
+    );
+
 #endif
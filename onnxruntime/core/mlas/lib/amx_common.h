@@ -0,0 +1,47 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    amx_common.h
+
+Abstract:
+
+    This module contains the tile load and store wrappers used by the AMX
+    kernels.
+
+    GCC implements the tile load and store intrinsics as inline assembly
+    without a memory operand or clobber, so the compiler is free to move the
+    accesses of the stack buffers that accumulators are staged through across
+    the tile instructions. The wrappers add the clobber. The intrinsics of the
+    other compilers are builtins that describe the memory they access.
+
+--*/
+
+#pragma once
+
+#if defined(__GNUC__) && !defined(__clang__)
+
+#define tile_loadd(dst, base, stride) tile_loadd_internal(dst, base, stride)
+
+#define tile_loadd_internal(dst, base, stride)                                  \
+    __asm__ volatile(                                                           \
+        "{tileloadd\t(%0,%1,1), %%tmm" #dst "|tileloadd\t%%tmm" #dst ", [%0+%1*1]}" \
+        :: "r"((const void*)(base)), "r"((long)(stride)) : "memory")
+
+#define tile_stored(src, base, stride) tile_stored_internal(src, base, stride)
+
+#define tile_stored_internal(src, base, stride)                                 \
+    __asm__ volatile(                                                           \
+        "{tilestored\t%%tmm" #src ", (%0,%1,1)|tilestored\t[%0+%1*1], %%tmm" #src "}" \
+        :: "r"((void*)(base)), "r"((long)(stride)) : "memory")
+
+#else
+
+#define tile_loadd(dst, base, stride) _tile_loadd(dst, base, stride)
+#define tile_stored(src, base, stride) _tile_stored(src, base, stride)
+
+#endif
@@ -0,0 +1,315 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    cast.cpp
+
+Abstract:
+
+    This module implements the conversions between single precision floats
+    and the half precision and brain floating point formats.
+
+--*/
+
+#include "mlasi.h"
+
+MLAS_FORCEINLINE
+float
+MlasBFloat16ToFloat(
+    unsigned short Value
+    )
+{
+    uint32_t Bits = uint32_t(Value) << 16;
+    float Result;
+    std::memcpy(&Result, &Bits, sizeof(Result));
+    return Result;
+}
+
+MLAS_FORCEINLINE
+unsigned short
+MlasFloatToBFloat16(
+    float Value
+    )
+{
+    uint32_t Bits;
+    std::memcpy(&Bits, &Value, sizeof(Bits));
+
+    if (Value != Value) {
+        return static_cast<unsigned short>(((Bits >> 16) & 0x8000) | 0x7FC0);
+    }
+
+    //
+    // Round to nearest even: the bias carries into the upper half when the
+    // discarded bits are above the halfway point, or exactly halfway and the
+    // retained bits are odd.
+    //
+
+    Bits += 0x7FFF + ((Bits >> 16) & 1);
+    return static_cast<unsigned short>(Bits >> 16);
+}
+
+#if defined(MLAS_NEON64_INTRINSICS)
+
+MLAS_FORCEINLINE
+uint16x4_t
+MlasFloatToBFloat16Neon(
+    float32x4_t Vector
+    )
+{
+    uint32x4_t Bits = vreinterpretq_u32_f32(Vector);
+    uint32x4_t Rounded = vaddq_u32(Bits, vaddq_u32(vdupq_n_u32(0x7FFF), vandq_u32(vshrq_n_u32(Bits, 16), vdupq_n_u32(1))));
+    uint32x4_t QuietNaN = vorrq_u32(vandq_u32(Bits, vdupq_n_u32(0x80000000)), vdupq_n_u32(0x7FC00000));
+    uint32x4_t IsNumber = vceqq_f32(Vector, Vector);
+
+    return vshrn_n_u32(vbslq_u32(IsNumber, Rounded, QuietNaN), 16);
+}
+
+#endif
+
+void
+MLASCALL
+MlasCastF16ToF32Kernel(
+    const unsigned short* Source,
+    float* Destination,
+    size_t Count
+    )
+{
+#if defined(MLAS_NEON64_INTRINSICS) && !defined(_MSC_VER)
+    while (Count >= 8) {
+        float16x8_t Vector = vreinterpretq_f16_u16(vld1q_u16(Source));
+        vst1q_f32(Destination, vcvt_f32_f16(vget_low_f16(Vector)));
+        vst1q_f32(Destination + 4, vcvt_high_f32_f16(Vector));
+        Source += 8;
+        Destination += 8;
+        Count -= 8;
+    }
+#endif
+
+    for (size_t i = 0; i < Count; i++) {
+        Destination[i] = MLAS_Half2Float(Source[i]);
+    }
+}
+
+void
+MLASCALL
+MlasCastF32ToF16Kernel(
+    const float* Source,
+    unsigned short* Destination,
+    size_t Count
+    )
+{
+#if defined(MLAS_NEON64_INTRINSICS) && !defined(_MSC_VER)
+    while (Count >= 8) {
+        float16x8_t Vector = vcvt_high_f16_f32(vcvt_f16_f32(vld1q_f32(Source)), vld1q_f32(Source + 4));
+        vst1q_u16(Destination, vreinterpretq_u16_f16(Vector));
+        Source += 8;
+        Destination += 8;
+        Count -= 8;
+    }
+#endif
+
+    for (size_t i = 0; i < Count; i++) {
+        Destination[i] = MLAS_Float2Half(Source[i]);
+    }
+}
+
+void
+MLASCALL
+MlasCastBF16ToF32Kernel(
+    const unsigned short* Source,
+    float* Destination,
+    size_t Count
+    )
+{
+#if defined(MLAS_NEON64_INTRINSICS)
+    while (Count >= 8) {
+        uint16x8_t Vector = vld1q_u16(Source);
+        vst1q_f32(Destination, vreinterpretq_f32_u32(vshll_n_u16(vget_low_u16(Vector), 16)));
+        vst1q_f32(Destination + 4, vreinterpretq_f32_u32(vshll_n_u16(vget_high_u16(Vector), 16)));
+        Source += 8;
+        Destination += 8;
+        Count -= 8;
+    }
+#endif
+
+    for (size_t i = 0; i < Count; i++) {
+        Destination[i] = MlasBFloat16ToFloat(Source[i]);
+    }
+}
+
+void
+MLASCALL
+MlasCastF32ToBF16Kernel(
+    const float* Source,
+    unsigned short* Destination,
+    size_t Count
+    )
+{
+#if defined(MLAS_NEON64_INTRINSICS)
+    while (Count >= 8) {
+        uint16x4_t Low = MlasFloatToBFloat16Neon(vld1q_f32(Source));
+        uint16x4_t High = MlasFloatToBFloat16Neon(vld1q_f32(Source + 4));
+        vst1q_u16(Destination, vcombine_u16(Low, High));
+        Source += 8;
+        Destination += 8;
+        Count -= 8;
+    }
+#endif
+
+    for (size_t i = 0; i < Count; i++) {
+        Destination[i] = MlasFloatToBFloat16(Source[i]);
+    }
+}
+
+extern "C"
+void
+MLASCALL
+MlasConvertHalfToFloatBuffer(
+    const unsigned short* Source,
+    float* Destination,
+    size_t Count
+    )
+/*++
+
+Routine Description:
+
+    This routine converts the source buffer of half precision floats to the
+    destination buffer of single precision floats.
+
+Arguments:
+
+    Source - Supplies the address of the source buffer of half precision
+        floats.
+
+    Destination - Supplies the address of the destination buffer of single
+        precision floats.
+
+    Count - Supplies the number of elements to convert.
+
+Return Value:
+
+    None.
+
+--*/
+{
+#if defined(MLAS_TARGET_AMD64)
+    GetMlasPlatform().CastF16ToF32Kernel(Source, Destination, Count);
+#else
+    MlasCastF16ToF32Kernel(Source, Destination, Count);
+#endif
+}
+
+extern "C"
+void
+MLASCALL
+MlasConvertFloatToHalfBuffer(
+    const float* Source,
+    unsigned short* Destination,
+    size_t Count
+    )
+/*++
+
+Routine Description:
+
+    This routine converts the source buffer of single precision floats to the
+    destination buffer of half precision floats, rounding to nearest even.
+
+Arguments:
+
+    Source - Supplies the address of the source buffer of single precision
+        floats.
+
+    Destination - Supplies the address of the destination buffer of half
+        precision floats.
+
+    Count - Supplies the number of elements to convert.
+
+Return Value:
+
+    None.
+
+--*/
+{
+#if defined(MLAS_TARGET_AMD64)
+    GetMlasPlatform().CastF32ToF16Kernel(Source, Destination, Count);
+#else
+    MlasCastF32ToF16Kernel(Source, Destination, Count);
+#endif
+}
+
+void
+MLASCALL
+MlasConvertBFloat16ToFloatBuffer(
+    const unsigned short* Source,
+    float* Destination,
+    size_t Count
+    )
+/*++
+
+Routine Description:
+
+    This routine converts the source buffer of bfloat16 values to the
+    destination buffer of single precision floats.
+
+Arguments:
+
+    Source - Supplies the address of the source buffer of bfloat16 values.
+
+    Destination - Supplies the address of the destination buffer of single
+        precision floats.
+
+    Count - Supplies the number of elements to convert.
+
+Return Value:
+
+    None.
+
+--*/
+{
+#if defined(MLAS_TARGET_AMD64)
+    GetMlasPlatform().CastBF16ToF32Kernel(Source, Destination, Count);
+#else
+    MlasCastBF16ToF32Kernel(Source, Destination, Count);
+#endif
+}
+
+void
+MLASCALL
+MlasConvertFloatToBFloat16Buffer(
+    const float* Source,
+    unsigned short* Destination,
+    size_t Count
+    )
+/*++
+
+Routine Description:
+
+    This routine converts the source buffer of single precision floats to the
+    destination buffer of bfloat16 values, rounding to nearest even.
+
+Arguments:
+
+    Source - Supplies the address of the source buffer of single precision
+        floats.
+
+    Destination - Supplies the address of the destination buffer of bfloat16
+        values.
+
+    Count - Supplies the number of elements to convert.
+
+Return Value:
+
+    None.
+
+--*/
+{
+#if defined(MLAS_TARGET_AMD64)
+    GetMlasPlatform().CastF32ToBF16Kernel(Source, Destination, Count);
+#else
+    MlasCastF32ToBF16Kernel(Source, Destination, Count);
+#endif
+}
@@ -0,0 +1,733 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    compute_fp16.cpp
+
+Abstract:
+
+    This module implements the elementwise binary, softmax and layer
+    normalization routines for fp16 data types.
+
+    Elementwise arithmetic and maximum reductions run on fp16 vectors. The
+    reductions that lose too much precision in fp16 (the sum of exponentials
+    and the mean/variance of a row) are widened to fp32.
+
+--*/
+
+#include "fp16_common.h"
+
+#ifdef MLAS_F16VEC_INTRINSICS_SUPPORTED
+
+//
+// Number of elements of a softmax row converted to fp32 at a time.
+//
+
+#define MLAS_HALF_SOFTMAX_CHUNK                     256
+
+MLAS_FORCEINLINE
+MLAS_FLOAT32X4
+MlasHalfLowToFloat32x4(MLAS_FLOAT16X8 Vector)
+{
+    return vcvt_f32_f16(vget_low_f16(Vector));
+}
+
+MLAS_FORCEINLINE
+MLAS_FLOAT32X4
+MlasHalfHighToFloat32x4(MLAS_FLOAT16X8 Vector)
+{
+    return vcvt_f32_f16(vget_high_f16(Vector));
+}
+
+MLAS_FORCEINLINE
+MLAS_FLOAT16X8
+MlasFloat32x4ToHalf(MLAS_FLOAT32X4 Low, MLAS_FLOAT32X4 High)
+{
+    return vcombine_f16(vcvt_f16_f32(Low), vcvt_f16_f32(High));
+}
+
+//
+// Templates for elementwise binary operations.
+//
+
+template<MLAS_HALF_ELTWISE_KIND Kind>
+struct MLAS_HALF_ELTWISE_OPERATION;
+
+template<>
+struct MLAS_HALF_ELTWISE_OPERATION<MlasHalfEltwiseAdd>
+{
+    static MLAS_FLOAT16X8 Apply(MLAS_FLOAT16X8 A, MLAS_FLOAT16X8 B) { return MlasAddFloat16x8(A, B); }
+
+    static MLAS_FLOAT16X4 Apply(MLAS_FLOAT16X4 A, MLAS_FLOAT16X4 B) { return MlasAddFloat16x4(A, B); }
+};
+
+template<>
+struct MLAS_HALF_ELTWISE_OPERATION<MlasHalfEltwiseSub>
+{
+    static MLAS_FLOAT16X8 Apply(MLAS_FLOAT16X8 A, MLAS_FLOAT16X8 B) { return MlasSubtractFloat16x8(A, B); }
+
+    static MLAS_FLOAT16X4 Apply(MLAS_FLOAT16X4 A, MLAS_FLOAT16X4 B) { return MlasSubtractFloat16x4(A, B); }
+};
+
+template<>
+struct MLAS_HALF_ELTWISE_OPERATION<MlasHalfEltwiseMul>
+{
+    static MLAS_FLOAT16X8 Apply(MLAS_FLOAT16X8 A, MLAS_FLOAT16X8 B) { return MlasMultiplyFloat16x8(A, B); }
+
+    static MLAS_FLOAT16X4 Apply(MLAS_FLOAT16X4 A, MLAS_FLOAT16X4 B) { return MlasMultiplyFloat16x4(A, B); }
+};
+
+template<>
+struct MLAS_HALF_ELTWISE_OPERATION<MlasHalfEltwiseDiv>
+{
+    static MLAS_FLOAT16X8 Apply(MLAS_FLOAT16X8 A, MLAS_FLOAT16X8 B) { return MlasDivFloat16x8(A, B); }
+
+    static MLAS_FLOAT16X4 Apply(MLAS_FLOAT16X4 A, MLAS_FLOAT16X4 B) { return MlasDivFloat16x4(A, B); }
+};
+
+template<MLAS_HALF_ELTWISE_KIND Kind, bool BroadcastA, bool BroadcastB>
+void
+MlasHalfEltwiseBinaryKernel(
+    const _mlas_fp16_* InputA,
+    const _mlas_fp16_* InputB,
+    _mlas_fp16_* Output,
+    size_t N
+    )
+{
+    using Operation = MLAS_HALF_ELTWISE_OPERATION<Kind>;
+
+    const MLAS_FLOAT16X8 ScalarA = MlasBroadcastFloat16x8(InputA);
+    const MLAS_FLOAT16X8 ScalarB = MlasBroadcastFloat16x8(InputB);
+
+    while (N >= 8) {
+
+        MLAS_FLOAT16X8 A = BroadcastA ? ScalarA : MlasLoadFloat16x8(InputA);
+        MLAS_FLOAT16X8 B = BroadcastB ? ScalarB : MlasLoadFloat16x8(InputB);
+
+        MlasStoreFloat16x8(Output, Operation::Apply(A, B));
+
+        InputA += BroadcastA ? 0 : 8;
+        InputB += BroadcastB ? 0 : 8;
+        Output += 8;
+        N -= 8;
+    }
+
+    if (N >= 4) {
+
+        MLAS_FLOAT16X4 A = BroadcastA ? MlasToLowHalfFloat16x4(ScalarA) : MlasLoadFloat16x4(InputA);
+        MLAS_FLOAT16X4 B = BroadcastB ? MlasToLowHalfFloat16x4(ScalarB) : MlasLoadFloat16x4(InputB);
+
+        MlasStoreFloat16x4(Output, Operation::Apply(A, B));
+
+        InputA += BroadcastA ? 0 : 4;
+        InputB += BroadcastB ? 0 : 4;
+        Output += 4;
+        N -= 4;
+    }
+
+    if (N > 0) {
+
+        MLAS_FLOAT16X4 A = MlasToLowHalfFloat16x4(ScalarA);
+        MLAS_FLOAT16X4 B = MlasToLowHalfFloat16x4(ScalarB);
+
+        if (!BroadcastA) {
+            std::memcpy(&A, InputA, N * sizeof(_mlas_fp16_));
+        }
+
+        if (!BroadcastB) {
+            std::memcpy(&B, InputB, N * sizeof(_mlas_fp16_));
+        }
+
+        MlasStorePartialFloat16x4(Output, Operation::Apply(A, B), N);
+    }
+}
+
+template<MLAS_HALF_ELTWISE_KIND Kind>
+void
+MlasHalfEltwiseBinaryDispatch(
+    const _mlas_fp16_* InputA,
+    bool BroadcastA,
+    const _mlas_fp16_* InputB,
+    bool BroadcastB,
+    _mlas_fp16_* Output,
+    size_t N
+    )
+{
+    if (BroadcastA) {
+        if (BroadcastB) {
+            MlasHalfEltwiseBinaryKernel<Kind, true, true>(InputA, InputB, Output, N);
+        } else {
+            MlasHalfEltwiseBinaryKernel<Kind, true, false>(InputA, InputB, Output, N);
+        }
+    } else {
+        if (BroadcastB) {
+            MlasHalfEltwiseBinaryKernel<Kind, false, true>(InputA, InputB, Output, N);
+        } else {
+            MlasHalfEltwiseBinaryKernel<Kind, false, false>(InputA, InputB, Output, N);
+        }
+    }
+}
+
+void
+MLASCALL
+MlasHalfEltwiseBinary(
+    MLAS_HALF_ELTWISE_KIND Kind,
+    const MLAS_FP16* InputA,
+    bool BroadcastA,
+    const MLAS_FP16* InputB,
+    bool BroadcastB,
+    MLAS_FP16* Output,
+    size_t N
+    )
+{
+    if (N == 0) {
+        return;
+    }
+
+    const auto* A = reinterpret_cast<const _mlas_fp16_*>(InputA);
+    const auto* B = reinterpret_cast<const _mlas_fp16_*>(InputB);
+    auto* C = reinterpret_cast<_mlas_fp16_*>(Output);
+
+    switch (Kind) {
+        case MlasHalfEltwiseAdd:
+            MlasHalfEltwiseBinaryDispatch<MlasHalfEltwiseAdd>(A, BroadcastA, B, BroadcastB, C, N);
+            break;
+
+        case MlasHalfEltwiseSub:
+            MlasHalfEltwiseBinaryDispatch<MlasHalfEltwiseSub>(A, BroadcastA, B, BroadcastB, C, N);
+            break;
+
+        case MlasHalfEltwiseMul:
+            MlasHalfEltwiseBinaryDispatch<MlasHalfEltwiseMul>(A, BroadcastA, B, BroadcastB, C, N);
+            break;
+
+        case MlasHalfEltwiseDiv:
+            MlasHalfEltwiseBinaryDispatch<MlasHalfEltwiseDiv>(A, BroadcastA, B, BroadcastB, C, N);
+            break;
+
+        default:
+            MLAS_THROW_EX(std::runtime_error, "bad mlas eltwise kind");
+    }
+}
+
+//
+// Softmax.
+//
+
+struct MLAS_HALF_SOFTMAX_WORK_BLOCK {
+    ptrdiff_t ThreadCountN;
+    bool LogSoftmax;
+    const _mlas_fp16_* Input;
+    _mlas_fp16_* Output;
+    size_t N;
+    size_t D;
+};
+
+void
+MlasConvertHalfToFloatRow(
+    const _mlas_fp16_* Source,
+    float* Destination,
+    size_t Count
+    )
+{
+    while (Count >= 8) {
+
+        MLAS_FLOAT16X8 Vector = MlasLoadFloat16x8(Source);
+
+        MlasStoreFloat32x4(Destination, MlasHalfLowToFloat32x4(Vector));
+        MlasStoreFloat32x4(Destination + 4, MlasHalfHighToFloat32x4(Vector));
+
+        Source += 8;
+        Destination += 8;
+        Count -= 8;
+    }
+
+    while (Count > 0) {
+
+        *Destination++ = MLAS_Half2Float(*Source++);
+        Count -= 1;
+    }
+}
+
+void
+MlasConvertFloatToHalfRow(
+    const float* Source,
+    _mlas_fp16_* Destination,
+    size_t Count
+    )
+{
+    while (Count >= 8) {
+
+        MLAS_FLOAT32X4 Low = MlasLoadFloat32x4(Source);
+        MLAS_FLOAT32X4 High = MlasLoadFloat32x4(Source + 4);
+
+        MlasStoreFloat16x8(Destination, MlasFloat32x4ToHalf(Low, High));
+
+        Source += 8;
+        Destination += 8;
+        Count -= 8;
+    }
+
+    while (Count > 0) {
+
+        *Destination++ = MLAS_Float2Half(*Source++);
+        Count -= 1;
+    }
+}
+
+float
+MlasReduceMaximumHalfKernel(
+    const _mlas_fp16_* Input,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine finds the maximum value of a row. The comparisons are exact
+    in fp16, so no widening is needed.
+
+--*/
+{
+    float Maximum = std::numeric_limits<float>::lowest();
+
+    if (N >= 8) {
+
+        MLAS_FLOAT16X8 MaximumVector = MlasLoadFloat16x8(Input);
+
+        Input += 8;
+        N -= 8;
+
+        while (N >= 8) {
+
+            MaximumVector = MlasMaximumFloat16x8(MaximumVector, MlasLoadFloat16x8(Input));
+
+            Input += 8;
+            N -= 8;
+        }
+
+        MaximumVector = vpmaxq_f16(MaximumVector, MaximumVector);
+        MaximumVector = vpmaxq_f16(MaximumVector, MaximumVector);
+        MaximumVector = vpmaxq_f16(MaximumVector, MaximumVector);
+
+        Maximum = MLAS_Half2Float(vgetq_lane_u16(vreinterpretq_u16_f16(MaximumVector), 0));
+    }
+
+    while (N > 0) {
+
+        Maximum = std::max(Maximum, MLAS_Half2Float(*Input));
+
+        Input += 1;
+        N -= 1;
+    }
+
+    return Maximum;
+}
+
+float
+MlasComputeHalfSumExpKernel(
+    const _mlas_fp16_* Input,
+    _mlas_fp16_* Output,
+    size_t N,
+    float NegativeMaximum
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the sum of the exponential functions of a row. The
+    row is converted to fp32 in chunks, so that the single precision kernel
+    computes the exponentials and accumulates their sum.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Optionally supplies the output buffer that receives the
+        intermediate exp() results.
+
+    N - Supplies the number of elements to process.
+
+    NegativeMaximum - Supplies the negative maximum value of the row.
+
+Return Value:
+
+    Returns the sum of the exponential functions.
+
+--*/
+{
+    MLAS_DECLSPEC_ALIGN(float Buffer[MLAS_HALF_SOFTMAX_CHUNK], 16);
+
+    float Accumulation = 0.0f;
+
+    while (N > 0) {
+
+        const size_t Count = std::min(N, size_t(MLAS_HALF_SOFTMAX_CHUNK));
+
+        MlasConvertHalfToFloatRow(Input, Buffer, Count);
+
+        Accumulation += MlasComputeSumExpF32Kernel(Buffer, (Output != nullptr) ? Buffer : nullptr,
+                                                   Count, &NegativeMaximum);
+
+        if (Output != nullptr) {
+            MlasConvertFloatToHalfRow(Buffer, Output, Count);
+            Output += Count;
+        }
+
+        Input += Count;
+        N -= Count;
+    }
+
+    return Accumulation;
+}
+
+void
+MlasComputeHalfAffineKernel(
+    const _mlas_fp16_* Input,
+    _mlas_fp16_* Output,
+    size_t N,
+    float Scale,
+    float Shift
+    )
+/*++
+
+Routine Description:
+
+    This routine computes Output = Input * Scale + Shift in fp32, which
+    produces the normalized softmax output (Shift = 0) and the log softmax
+    output (Scale = 1).
+
+--*/
+{
+    const MLAS_FLOAT32X4 ScaleVector = MlasBroadcastFloat32x4(Scale);
+    const MLAS_FLOAT32X4 ShiftVector = MlasBroadcastFloat32x4(Shift);
+
+    while (N >= 8) {
+
+        MLAS_FLOAT16X8 Vector = MlasLoadFloat16x8(Input);
+
+        MLAS_FLOAT32X4 Low = MlasMultiplyAddFloat32x4(MlasHalfLowToFloat32x4(Vector), ScaleVector, ShiftVector);
+        MLAS_FLOAT32X4 High = MlasMultiplyAddFloat32x4(MlasHalfHighToFloat32x4(Vector), ScaleVector, ShiftVector);
+
+        MlasStoreFloat16x8(Output, MlasFloat32x4ToHalf(Low, High));
+
+        Input += 8;
+        Output += 8;
+        N -= 8;
+    }
+
+    while (N > 0) {
+
+        *Output = MLAS_Float2Half(MLAS_Half2Float(*Input) * Scale + Shift);
+
+        Input += 1;
+        Output += 1;
+        N -= 1;
+    }
+}
+
+void
+MlasComputeHalfSoftmaxThreaded(
+    void* Context,
+    ptrdiff_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of a
+    softmax or log softmax operation.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    ThreadId - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const auto* WorkBlock = (MLAS_HALF_SOFTMAX_WORK_BLOCK*)Context;
+
+    size_t n;
+    size_t CountN;
+
+    MlasPartitionWork(Index, WorkBlock->ThreadCountN, WorkBlock->N, &n, &CountN);
+
+    const size_t D = WorkBlock->D;
+    const bool LogSoftmax = WorkBlock->LogSoftmax;
+
+    const _mlas_fp16_* Input = WorkBlock->Input + n * D;
+    _mlas_fp16_* Output = WorkBlock->Output + n * D;
+
+    while (CountN > 0) {
+
+        const float NegativeMaximum = -MlasReduceMaximumHalfKernel(Input, D);
+
+        if (LogSoftmax) {
+
+            float Accumulation = MlasComputeHalfSumExpKernel(Input, nullptr, D, NegativeMaximum);
+
+            MlasComputeHalfAffineKernel(Input, Output, D, 1.0f,
+                                        NegativeMaximum - std::log(Accumulation));
+
+        } else {
+
+            //
+            // The exponentials are in (0, 1] after subtracting the maximum,
+            // so the intermediate results keep full fp16 precision.
+            //
+
+            float Accumulation = MlasComputeHalfSumExpKernel(Input, Output, D, NegativeMaximum);
+
+            MlasComputeHalfAffineKernel(Output, Output, D, 1.0f / Accumulation, 0.0f);
+        }
+
+        Input += D;
+        Output += D;
+        CountN--;
+    }
+}
+
+void
+MLASCALL
+MlasComputeHalfSoftmax(
+    const MLAS_FP16* Input,
+    MLAS_FP16* Output,
+    size_t N,
+    size_t D,
+    bool LogSoftmax,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the softmax or log softmax function for fp16 data.
+
+    N.B. This implementation supports in place updates of the output buffer.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of rows to process.
+
+    D - Supplies the number of columns per row to process.
+
+    LogSoftmax - Supplies true if this is a log softmax operation, else false
+        if this is a softmax operation.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_HALF_SOFTMAX_WORK_BLOCK WorkBlock;
+
+    WorkBlock.LogSoftmax = LogSoftmax;
+    WorkBlock.Input = reinterpret_cast<const _mlas_fp16_*>(Input);
+    WorkBlock.Output = reinterpret_cast<_mlas_fp16_*>(Output);
+    WorkBlock.N = N;
+    WorkBlock.D = D;
+
+    //
+    // Use the same partitioning as the single precision softmax.
+    //
+
+    ptrdiff_t ThreadCountN = MlasGetMaximumThreadCount(ThreadPool);
+
+    if (size_t(ThreadCountN) > N) {
+        ThreadCountN = ptrdiff_t(N);
+    }
+
+    constexpr size_t MinimumElementsPerThread = 16384;
+
+    size_t BlockCount = ((N * D) / MinimumElementsPerThread) + 1;
+
+    if (size_t(ThreadCountN) > BlockCount) {
+        ThreadCountN = ptrdiff_t(BlockCount);
+    }
+
+    WorkBlock.ThreadCountN = ThreadCountN;
+
+    MlasExecuteThreaded(MlasComputeHalfSoftmaxThreaded, &WorkBlock, ThreadCountN, ThreadPool);
+}
+
+//
+// Layer normalization.
+//
+
+void
+MLASCALL
+MlasComputeHalfLayerNorm(
+    const MLAS_FP16* Input,
+    const MLAS_FP16* Scale,
+    const MLAS_FP16* Bias,
+    MLAS_FP16* Output,
+    size_t D,
+    float Epsilon,
+    bool Simplified,
+    float* Mean,
+    float* InvStdDev
+    )
+/*++
+
+Routine Description:
+
+    This routine normalizes one row of fp16 data:
+
+        Output = (Input - mean) / sqrt(variance + Epsilon) * Scale + Bias
+
+    The statistics are accumulated in fp32 and the row is normalized in fp32
+    before rounding back to fp16, so that rows with a large mean relative to
+    their deviation do not lose precision.
+
+    N.B. This implementation supports in place updates of the output buffer.
+
+Arguments:
+
+    Input - Supplies the input row.
+
+    Scale - Supplies the scale vector.
+
+    Bias - Optionally supplies the bias vector.
+
+    Output - Supplies the output row.
+
+    D - Supplies the number of elements in the row.
+
+    Epsilon - Supplies the value added to the variance.
+
+    Simplified - Supplies true to skip the mean subtraction (RMS
+        normalization), else false.
+
+    Mean - Receives the mean of the row, or zero if Simplified is true.
+
+    InvStdDev - Receives the reciprocal of the standard deviation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const auto* input = reinterpret_cast<const _mlas_fp16_*>(Input);
+    const auto* scale = reinterpret_cast<const _mlas_fp16_*>(Scale);
+    const auto* bias = reinterpret_cast<const _mlas_fp16_*>(Bias);
+    auto* output = reinterpret_cast<_mlas_fp16_*>(Output);
+
+    //
+    // Accumulate the sum and the sum of squares of the row.
+    //
+
+    MLAS_FLOAT32X4 SumVector = MlasZeroFloat32x4();
+    MLAS_FLOAT32X4 SumSquareVector = MlasZeroFloat32x4();
+
+    const _mlas_fp16_* x = input;
+    size_t n = D;
+
+    while (n >= 8) {
+
+        MLAS_FLOAT16X8 Vector = MlasLoadFloat16x8(x);
+        MLAS_FLOAT32X4 Low = MlasHalfLowToFloat32x4(Vector);
+        MLAS_FLOAT32X4 High = MlasHalfHighToFloat32x4(Vector);
+
+        SumVector = MlasAddFloat32x4(SumVector, MlasAddFloat32x4(Low, High));
+        SumSquareVector = MlasMultiplyAddFloat32x4(Low, Low, SumSquareVector);
+        SumSquareVector = MlasMultiplyAddFloat32x4(High, High, SumSquareVector);
+
+        x += 8;
+        n -= 8;
+    }
+
+    float Sum = MlasReduceAddFloat32x4(SumVector);
+    float SumSquare = MlasReduceAddFloat32x4(SumSquareVector);
+
+    while (n > 0) {
+
+        const float Value = MLAS_Half2Float(*x++);
+
+        Sum += Value;
+        SumSquare += Value * Value;
+        n -= 1;
+    }
+
+    const float MeanValue = Simplified ? 0.0f : Sum / float(D);
+    const float Variance = std::max(SumSquare / float(D) - MeanValue * MeanValue, 0.0f);
+    const float InvStdDevValue = 1.0f / std::sqrt(Variance + Epsilon);
+
+    if (Mean != nullptr) {
+        *Mean = MeanValue;
+    }
+
+    if (InvStdDev != nullptr) {
+        *InvStdDev = InvStdDevValue;
+    }
+
+    //
+    // Normalize the row and apply the scale and bias.
+    //
+
+    const MLAS_FLOAT32X4 MeanVector = MlasBroadcastFloat32x4(MeanValue);
+    const MLAS_FLOAT32X4 InvStdDevVector = MlasBroadcastFloat32x4(InvStdDevValue);
+
+    n = D;
+
+    while (n >= 8) {
+
+        MLAS_FLOAT16X8 Vector = MlasLoadFloat16x8(input);
+        MLAS_FLOAT16X8 ScaleVector = MlasLoadFloat16x8(scale);
+
+        MLAS_FLOAT32X4 Low = MlasMultiplyFloat32x4(
+            MlasSubtractFloat32x4(MlasHalfLowToFloat32x4(Vector), MeanVector), InvStdDevVector);
+        MLAS_FLOAT32X4 High = MlasMultiplyFloat32x4(
+            MlasSubtractFloat32x4(MlasHalfHighToFloat32x4(Vector), MeanVector), InvStdDevVector);
+
+        Low = MlasMultiplyFloat32x4(Low, MlasHalfLowToFloat32x4(ScaleVector));
+        High = MlasMultiplyFloat32x4(High, MlasHalfHighToFloat32x4(ScaleVector));
+
+        if (bias != nullptr) {
+            MLAS_FLOAT16X8 BiasVector = MlasLoadFloat16x8(bias);
+            Low = MlasAddFloat32x4(Low, MlasHalfLowToFloat32x4(BiasVector));
+            High = MlasAddFloat32x4(High, MlasHalfHighToFloat32x4(BiasVector));
+            bias += 8;
+        }
+
+        MlasStoreFloat16x8(output, MlasFloat32x4ToHalf(Low, High));
+
+        input += 8;
+        scale += 8;
+        output += 8;
+        n -= 8;
+    }
+
+    while (n > 0) {
+
+        float Value = (MLAS_Half2Float(*input++) - MeanValue) * InvStdDevValue;
+
+        Value *= MLAS_Half2Float(*scale++);
+
+        if (bias != nullptr) {
+            Value += MLAS_Half2Float(*bias++);
+        }
+
+        *output++ = MLAS_Float2Half(Value);
+        n -= 1;
+    }
+}
+
+#endif  // MLAS_F16VEC_INTRINSICS_SUPPORTED
@@ -481,6 +481,78 @@ Return Value:
     }
 }
 
+void
+MlasConvGemmOperation(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    const float* A,
+    size_t lda,
+    const float* B,
+    size_t ldb,
+    float beta,
+    float* C,
+    size_t ldc
+    )
+/*++
+
+Routine Description:
+
+    This routine invokes the single threaded GEMM for a convolution, computed
+    with bfloat16 inputs if requested by the convolution parameters.
+
+--*/
+{
+    if (Parameters->Bf16Compute) {
+        MlasSBGemmOperation(CblasNoTrans, TransB, M, N, K, 1.0f, A, lda, B, ldb, beta, C, ldc);
+    } else {
+        MlasSgemmOperation(CblasNoTrans, TransB, M, N, K, 1.0f, A, lda, B, ldb, beta, C, ldc);
+    }
+}
+
+void
+MlasConvGemm(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    const float* A,
+    size_t lda,
+    const float* B,
+    size_t ldb,
+    float beta,
+    float* C,
+    size_t ldc,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine invokes the threaded GEMM for a convolution, computed with
+    bfloat16 inputs if requested by the convolution parameters.
+
+--*/
+{
+    MLAS_SGEMM_DATA_PARAMS Data;
+    Data.A = A;
+    Data.lda = lda;
+    Data.B = B;
+    Data.ldb = ldb;
+    Data.C = C;
+    Data.ldc = ldc;
+    Data.beta = beta;
+
+    if (Parameters->Bf16Compute) {
+        MlasSBGemmBatch(CblasNoTrans, TransB, M, N, K, &Data, 1, ThreadPool);
+    } else {
+        MlasGemmBatch(CblasNoTrans, TransB, M, N, K, &Data, 1, ThreadPool);
+    }
+}
+
 void
 MlasConvOperation(
     const MLAS_CONV_PARAMETERS* Parameters,
@@ -590,8 +662,8 @@ Return Value:
                     SegmentStartN + n, CountN);
             }
 
-            MlasSgemmOperation(CblasNoTrans, CblasNoTrans, FilterCount, CountN,
-                CountK, 1.0f, Filter + k, K, ColumnBuffer, CountN, beta,
+            MlasConvGemmOperation(Parameters, CblasNoTrans, FilterCount, CountN,
+                CountK, Filter + k, K, ColumnBuffer, CountN, beta,
                 SegmentOutput, OutputSize);
 
             beta = 1.0f;
@@ -710,9 +782,9 @@ Return Value:
         // Invoke the non-threaded GEMM directly with the input tensor.
         //
 
-        MlasSgemmOperation(CblasNoTrans, Parameters->u.GemmDirect.TransB, FilterCount, OutputSize,
-                           K, 1.0f, filter, K, input, Parameters->u.GemmDirect.ldb, Beta, output,
-                           OutputSize);
+        MlasConvGemmOperation(Parameters, Parameters->u.GemmDirect.TransB, FilterCount,
+                              OutputSize, K, filter, K, input, Parameters->u.GemmDirect.ldb, Beta,
+                              output, OutputSize);
 
         //
         // Apply the activation with optional bias.
@@ -819,6 +891,704 @@ Return Value:
     return true;
 }
 
+//
+// Define the Winograd F(4x4, 3x3) transform sizes. Each tile produces a 4x4
+// block of the output from a 6x6 block of the input.
+//
+
+#define MLAS_CONV_WINOGRAD_TILE_OUTPUT              4
+#define MLAS_CONV_WINOGRAD_TILE_INPUT               6
+#define MLAS_CONV_WINOGRAD_TILE_POINTS              36
+
+//
+// Define the padding added to each of the 36 matrices in the Winograd domain.
+// This keeps the matrices from aliasing to the same cache sets when their
+// sizes are powers of two.
+//
+
+#define MLAS_CONV_WINOGRAD_MATRIX_PADDING           16
+
+//
+// Define the limits used to select the Winograd algorithm. The transforms
+// add overhead that is only amortized by convolutions with enough channels
+// and output tiles.
+//
+
+#define MLAS_CONV_WINOGRAD_MINIMUM_CHANNELS         16
+#define MLAS_CONV_WINOGRAD_MINIMUM_OUTPUT_SHAPE     16
+
+//
+// Define the target number of working buffer elements for the transformed
+// input and output of a block of tiles.
+//
+
+#define MLAS_CONV_WINOGRAD_BLOCK_BUFFER_SIZE        (64 * 1024)
+#define MLAS_CONV_WINOGRAD_MINIMUM_TILE_BLOCK       16
+
+MLAS_FORCEINLINE
+void
+MlasConvWinogradTransformFilterRow(
+    const MLAS_FLOAT32X4* g,
+    size_t Stride,
+    MLAS_FLOAT32X4* u,
+    size_t OutputStride
+    )
+/*++
+
+Routine Description:
+
+    This routine multiplies a 3 element filter vector by the Winograd
+    F(4x4, 3x3) filter transform matrix G for four filters at a time.
+
+--*/
+{
+    const MLAS_FLOAT32X4 g0 = g[0];
+    const MLAS_FLOAT32X4 g1 = g[Stride];
+    const MLAS_FLOAT32X4 g2 = g[2 * Stride];
+
+    const MLAS_FLOAT32X4 s02 = MlasAddFloat32x4(g0, g2);
+    const MLAS_FLOAT32X4 t02 = MlasMultiplyAddFloat32x4(g0, 0.25f, g2);
+
+    u[0 * OutputStride] = MlasMultiplyFloat32x4(g0, MlasBroadcastFloat32x4(1.0f / 4.0f));
+    u[1 * OutputStride] = MlasMultiplyFloat32x4(MlasAddFloat32x4(s02, g1), MlasBroadcastFloat32x4(-1.0f / 6.0f));
+    u[2 * OutputStride] = MlasMultiplyFloat32x4(MlasSubtractFloat32x4(s02, g1), MlasBroadcastFloat32x4(-1.0f / 6.0f));
+    u[3 * OutputStride] = MlasMultiplyFloat32x4(MlasMultiplyAddFloat32x4(g1, 0.5f, t02), MlasBroadcastFloat32x4(1.0f / 6.0f));
+    u[4 * OutputStride] = MlasMultiplyFloat32x4(MlasMultiplyAddFloat32x4(g1, -0.5f, t02), MlasBroadcastFloat32x4(1.0f / 6.0f));
+    u[5 * OutputStride] = g2;
+}
+
+MLAS_FORCEINLINE
+void
+MlasConvWinogradTransformInputRow(
+    const MLAS_FLOAT32X4* d,
+    size_t Stride,
+    MLAS_FLOAT32X4* v,
+    size_t OutputStride
+    )
+/*++
+
+Routine Description:
+
+    This routine multiplies a 6 element input vector by the Winograd
+    F(4x4, 3x3) input transform matrix B^T for four tiles at a time.
+
+--*/
+{
+    const MLAS_FLOAT32X4 d0 = d[0];
+    const MLAS_FLOAT32X4 d1 = d[Stride];
+    const MLAS_FLOAT32X4 d2 = d[2 * Stride];
+    const MLAS_FLOAT32X4 d3 = d[3 * Stride];
+    const MLAS_FLOAT32X4 d4 = d[4 * Stride];
+    const MLAS_FLOAT32X4 d5 = d[5 * Stride];
+
+    const MLAS_FLOAT32X4 t1 = MlasMultiplyAddFloat32x4(d2, -4.0f, d4);
+    const MLAS_FLOAT32X4 t2 = MlasMultiplyAddFloat32x4(d1, -4.0f, d3);
+    const MLAS_FLOAT32X4 t3 = MlasSubtractFloat32x4(d4, d2);
+    const MLAS_FLOAT32X4 t4 = MlasMultiplyFloat32x4(MlasSubtractFloat32x4(d1, d3), MlasBroadcastFloat32x4(2.0f));
+
+    v[0 * OutputStride] = MlasAddFloat32x4(MlasMultiplyAddFloat32x4(d0, 4.0f, d4), MlasMultiplyFloat32x4(d2, MlasBroadcastFloat32x4(-5.0f)));
+    v[1 * OutputStride] = MlasAddFloat32x4(t1, t2);
+    v[2 * OutputStride] = MlasSubtractFloat32x4(t1, t2);
+    v[3 * OutputStride] = MlasSubtractFloat32x4(t3, t4);
+    v[4 * OutputStride] = MlasAddFloat32x4(t3, t4);
+    v[5 * OutputStride] = MlasAddFloat32x4(MlasMultiplyAddFloat32x4(d1, 4.0f, d5), MlasMultiplyFloat32x4(d3, MlasBroadcastFloat32x4(-5.0f)));
+}
+
+MLAS_FORCEINLINE
+void
+MlasConvWinogradTransformOutputRow(
+    const MLAS_FLOAT32X4* m,
+    size_t Stride,
+    MLAS_FLOAT32X4* o,
+    size_t OutputStride
+    )
+/*++
+
+Routine Description:
+
+    This routine multiplies a 6 element vector by the Winograd F(4x4, 3x3)
+    output transform matrix A^T for four tiles at a time.
+
+--*/
+{
+    const MLAS_FLOAT32X4 m0 = m[0];
+    const MLAS_FLOAT32X4 m1 = m[Stride];
+    const MLAS_FLOAT32X4 m2 = m[2 * Stride];
+    const MLAS_FLOAT32X4 m3 = m[3 * Stride];
+    const MLAS_FLOAT32X4 m4 = m[4 * Stride];
+    const MLAS_FLOAT32X4 m5 = m[5 * Stride];
+
+    const MLAS_FLOAT32X4 s12 = MlasAddFloat32x4(m1, m2);
+    const MLAS_FLOAT32X4 d12 = MlasSubtractFloat32x4(m1, m2);
+    const MLAS_FLOAT32X4 s34 = MlasAddFloat32x4(m3, m4);
+    const MLAS_FLOAT32X4 d34 = MlasSubtractFloat32x4(m3, m4);
+
+    o[0 * OutputStride] = MlasAddFloat32x4(MlasAddFloat32x4(m0, s12), s34);
+    o[1 * OutputStride] = MlasMultiplyAddFloat32x4(d34, 2.0f, d12);
+    o[2 * OutputStride] = MlasMultiplyAddFloat32x4(s34, 4.0f, s12);
+    o[3 * OutputStride] = MlasAddFloat32x4(MlasMultiplyAddFloat32x4(d34, 8.0f, d12), m5);
+}
+
+MLAS_FORCEINLINE
+void
+MlasConvWinogradTranspose4x4(
+    MLAS_FLOAT32X4& v0,
+    MLAS_FLOAT32X4& v1,
+    MLAS_FLOAT32X4& v2,
+    MLAS_FLOAT32X4& v3
+    )
+{
+    const MLAS_FLOAT32X4 t0 = MlasInterleaveLowFloat32x4(v0, v2);
+    const MLAS_FLOAT32X4 t1 = MlasInterleaveHighFloat32x4(v0, v2);
+    const MLAS_FLOAT32X4 t2 = MlasInterleaveLowFloat32x4(v1, v3);
+    const MLAS_FLOAT32X4 t3 = MlasInterleaveHighFloat32x4(v1, v3);
+
+    v0 = MlasInterleaveLowFloat32x4(t0, t2);
+    v1 = MlasInterleaveHighFloat32x4(t0, t2);
+    v2 = MlasInterleaveLowFloat32x4(t1, t3);
+    v3 = MlasInterleaveHighFloat32x4(t1, t3);
+}
+
+void
+MlasConvWinogradTransformFilter(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* Filter,
+    float* TransformedFilter,
+    size_t StartF,
+    size_t CountF
+    )
+/*++
+
+Routine Description:
+
+    This routine transforms a range of 3x3 filters to the Winograd domain.
+
+Arguments:
+
+    Parameters - Supplies the structure that contains the convolution
+        parameters.
+
+    Filter - Supplies the filter tensor for the group.
+
+    TransformedFilter - Supplies the buffer to receive the transformed filter
+        tensor, stored as 36 matrices of FilterCount rows by InputChannels
+        columns.
+
+    StartF - Supplies the first filter to transform.
+
+    CountF - Supplies the number of filters to transform.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t InputChannels = Parameters->InputChannels;
+    const size_t MatrixStride = Parameters->FilterCount * InputChannels + MLAS_CONV_WINOGRAD_MATRIX_PADDING;
+
+    MLAS_DECLSPEC_ALIGN(float g[9][4], 16);
+    MLAS_DECLSPEC_ALIGN(float u[MLAS_CONV_WINOGRAD_TILE_POINTS][4], 16);
+    MLAS_FLOAT32X4 gv[9];
+    MLAS_FLOAT32X4 Temp[MLAS_CONV_WINOGRAD_TILE_INPUT * 3];
+    MLAS_FLOAT32X4 uv[MLAS_CONV_WINOGRAD_TILE_POINTS];
+
+    for (size_t f = StartF; f < StartF + CountF; f++) {
+
+        //
+        // Transform the filters of four input channels at a time.
+        //
+
+        for (size_t c = 0; c < InputChannels; c += 4) {
+
+            const size_t CountC = std::min(InputChannels - c, size_t(4));
+            const float* filter = Filter + (f * InputChannels + c) * 9;
+
+            for (size_t k = 0; k < 9; k++) {
+                for (size_t l = 0; l < 4; l++) {
+                    g[k][l] = (l < CountC) ? filter[l * 9 + k] : 0.0f;
+                }
+                gv[k] = MlasLoadFloat32x4(g[k]);
+            }
+
+            //
+            // Compute G * g, then (G * g) * G^T.
+            //
+
+            for (size_t j = 0; j < 3; j++) {
+                MlasConvWinogradTransformFilterRow(&gv[j], 3, &Temp[j], 3);
+            }
+
+            for (size_t i = 0; i < MLAS_CONV_WINOGRAD_TILE_INPUT; i++) {
+                MlasConvWinogradTransformFilterRow(&Temp[i * 3], 1, &uv[i * MLAS_CONV_WINOGRAD_TILE_INPUT], 1);
+            }
+
+            float* d = TransformedFilter + f * InputChannels + c;
+
+            if (CountC == 4) {
+                for (size_t p = 0; p < MLAS_CONV_WINOGRAD_TILE_POINTS; p++) {
+                    MlasStoreFloat32x4(d + p * MatrixStride, uv[p]);
+                }
+            } else {
+                for (size_t p = 0; p < MLAS_CONV_WINOGRAD_TILE_POINTS; p++) {
+                    MlasStoreAlignedFloat32x4(u[p], uv[p]);
+                    for (size_t l = 0; l < CountC; l++) {
+                        d[p * MatrixStride + l] = u[p][l];
+                    }
+                }
+            }
+        }
+    }
+}
+
+void
+MlasConvWinogradTransformInput(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* Input,
+    float* TransformedInput,
+    size_t StartTile,
+    size_t CountTile
+    )
+/*++
+
+Routine Description:
+
+    This routine transforms a range of 6x6 input tiles to the Winograd domain.
+
+Arguments:
+
+    Parameters - Supplies the structure that contains the convolution
+        parameters.
+
+    Input - Supplies the input tensor for the group.
+
+    TransformedInput - Supplies the buffer to receive the transformed input
+        tiles, stored as 36 matrices of InputChannels rows by CountTile
+        columns.
+
+    StartTile - Supplies the first tile to transform.
+
+    CountTile - Supplies the number of tiles to transform.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t InputChannels = Parameters->InputChannels;
+    const size_t InputHeight = Parameters->InputShape[0];
+    const size_t InputWidth = Parameters->InputShape[1];
+    const size_t InputSize = Parameters->InputSize;
+    const size_t PaddingTop = Parameters->Padding[0];
+    const size_t PaddingLeft = Parameters->Padding[1];
+    const size_t TileCountW = (Parameters->OutputShape[1] + MLAS_CONV_WINOGRAD_TILE_OUTPUT - 1) /
+        MLAS_CONV_WINOGRAD_TILE_OUTPUT;
+    const size_t MatrixStride = InputChannels * CountTile + MLAS_CONV_WINOGRAD_MATRIX_PADDING;
+
+    MLAS_DECLSPEC_ALIGN(float d[MLAS_CONV_WINOGRAD_TILE_POINTS][4], 16);
+    MLAS_DECLSPEC_ALIGN(float v[MLAS_CONV_WINOGRAD_TILE_POINTS][4], 16);
+    MLAS_FLOAT32X4 dv[MLAS_CONV_WINOGRAD_TILE_POINTS + 2];
+    MLAS_FLOAT32X4 Temp[MLAS_CONV_WINOGRAD_TILE_POINTS];
+    MLAS_FLOAT32X4 vv[MLAS_CONV_WINOGRAD_TILE_POINTS];
+
+    //
+    // Transform four tiles at a time, one per vector lane.
+    //
+
+    for (size_t t = 0; t < CountTile; t += 4) {
+
+        const size_t CountT = std::min(CountTile - t, size_t(4));
+        const size_t Tile = StartTile + t;
+        const size_t OriginH = (Tile / TileCountW) * MLAS_CONV_WINOGRAD_TILE_OUTPUT - PaddingTop;
+        const size_t OriginW = (Tile % TileCountW) * MLAS_CONV_WINOGRAD_TILE_OUTPUT - PaddingLeft;
+
+        //
+        // Four tiles in the same row and the interior of the image can be
+        // loaded directly from the input tensor and transposed. Otherwise, the
+        // tiles are gathered with zero padding.
+        //
+
+        const bool Interior = (CountT == 4) && ((Tile % TileCountW) + 4 <= TileCountW) &&
+            (OriginH < InputHeight && InputHeight - OriginH >= MLAS_CONV_WINOGRAD_TILE_INPUT) &&
+            (OriginW < InputWidth && InputWidth - OriginW >= 4 * MLAS_CONV_WINOGRAD_TILE_OUTPUT + 4);
+
+        for (size_t c = 0; c < InputChannels; c++) {
+
+            const float* input = Input + c * InputSize;
+
+            if (Interior) {
+
+                for (size_t i = 0; i < MLAS_CONV_WINOGRAD_TILE_INPUT; i++) {
+
+                    const float* row = input + (OriginH + i) * InputWidth + OriginW;
+                    MLAS_FLOAT32X4* dd = &dv[i * MLAS_CONV_WINOGRAD_TILE_INPUT];
+
+                    MLAS_FLOAT32X4 x0 = MlasLoadFloat32x4(row);
+                    MLAS_FLOAT32X4 x1 = MlasLoadFloat32x4(row + 4);
+                    MLAS_FLOAT32X4 x2 = MlasLoadFloat32x4(row + 8);
+                    MLAS_FLOAT32X4 x3 = MlasLoadFloat32x4(row + 12);
+                    MLAS_FLOAT32X4 x4 = MlasLoadFloat32x4(row + 16);
+                    MLAS_FLOAT32X4 y1 = x1;
+                    MLAS_FLOAT32X4 y2 = x2;
+                    MLAS_FLOAT32X4 y3 = x3;
+
+                    MlasConvWinogradTranspose4x4(x0, x1, x2, x3);
+                    MlasConvWinogradTranspose4x4(y1, y2, y3, x4);
+
+                    dd[0] = x0;
+                    dd[1] = x1;
+                    dd[2] = x2;
+                    dd[3] = x3;
+                    dd[4] = y1;
+                    dd[5] = y2;
+                }
+
+            } else {
+
+                for (size_t l = 0; l < 4; l++) {
+
+                    const size_t tl = Tile + l;
+                    const size_t oh = (tl / TileCountW) * MLAS_CONV_WINOGRAD_TILE_OUTPUT - PaddingTop;
+                    const size_t ow = (tl % TileCountW) * MLAS_CONV_WINOGRAD_TILE_OUTPUT - PaddingLeft;
+
+                    for (size_t i = 0; i < MLAS_CONV_WINOGRAD_TILE_INPUT; i++) {
+                        const size_t ih = oh + i;
+                        for (size_t j = 0; j < MLAS_CONV_WINOGRAD_TILE_INPUT; j++) {
+                            const size_t iw = ow + j;
+                            d[i * MLAS_CONV_WINOGRAD_TILE_INPUT + j][l] =
+                                (l < CountT && ih < InputHeight && iw < InputWidth) ?
+                                input[ih * InputWidth + iw] : 0.0f;
+                        }
+                    }
+                }
+
+                for (size_t p = 0; p < MLAS_CONV_WINOGRAD_TILE_POINTS; p++) {
+                    dv[p] = MlasLoadFloat32x4(d[p]);
+                }
+            }
+
+            //
+            // Compute B^T * d, then (B^T * d) * B.
+            //
+
+            for (size_t j = 0; j < MLAS_CONV_WINOGRAD_TILE_INPUT; j++) {
+                MlasConvWinogradTransformInputRow(&dv[j], MLAS_CONV_WINOGRAD_TILE_INPUT, &Temp[j],
+                    MLAS_CONV_WINOGRAD_TILE_INPUT);
+            }
+
+            for (size_t i = 0; i < MLAS_CONV_WINOGRAD_TILE_INPUT; i++) {
+                MlasConvWinogradTransformInputRow(&Temp[i * MLAS_CONV_WINOGRAD_TILE_INPUT], 1,
+                    &vv[i * MLAS_CONV_WINOGRAD_TILE_INPUT], 1);
+            }
+
+            float* output = TransformedInput + c * CountTile + t;
+
+            if (CountT == 4) {
+                for (size_t p = 0; p < MLAS_CONV_WINOGRAD_TILE_POINTS; p++) {
+                    MlasStoreFloat32x4(output + p * MatrixStride, vv[p]);
+                }
+            } else {
+                for (size_t p = 0; p < MLAS_CONV_WINOGRAD_TILE_POINTS; p++) {
+                    MlasStoreAlignedFloat32x4(v[p], vv[p]);
+                    for (size_t l = 0; l < CountT; l++) {
+                        output[p * MatrixStride + l] = v[p][l];
+                    }
+                }
+            }
+        }
+    }
+}
+
+void
+MlasConvWinogradTransformOutput(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* TransformedOutput,
+    float* Output,
+    size_t StartTile,
+    size_t CountTile
+    )
+/*++
+
+Routine Description:
+
+    This routine transforms a range of output tiles from the Winograd domain
+    and stores the 4x4 results to the output tensor.
+
+Arguments:
+
+    Parameters - Supplies the structure that contains the convolution
+        parameters.
+
+    TransformedOutput - Supplies the transformed output tiles, stored as 36
+        matrices of FilterCount rows by CountTile columns.
+
+    Output - Supplies the output tensor for the group.
+
+    StartTile - Supplies the first tile to transform.
+
+    CountTile - Supplies the number of tiles to transform.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t FilterCount = Parameters->FilterCount;
+    const size_t OutputHeight = Parameters->OutputShape[0];
+    const size_t OutputWidth = Parameters->OutputShape[1];
+    const size_t OutputSize = Parameters->OutputSize;
+    const size_t TileCountW = (OutputWidth + MLAS_CONV_WINOGRAD_TILE_OUTPUT - 1) / MLAS_CONV_WINOGRAD_TILE_OUTPUT;
+    const size_t MatrixStride = FilterCount * CountTile + MLAS_CONV_WINOGRAD_MATRIX_PADDING;
+    const float Beta = Parameters->Beta;
+
+    MLAS_DECLSPEC_ALIGN(float m[MLAS_CONV_WINOGRAD_TILE_POINTS][4], 16);
+    MLAS_DECLSPEC_ALIGN(float o[MLAS_CONV_WINOGRAD_TILE_OUTPUT * MLAS_CONV_WINOGRAD_TILE_OUTPUT][4], 16);
+    MLAS_FLOAT32X4 mv[MLAS_CONV_WINOGRAD_TILE_POINTS];
+    MLAS_FLOAT32X4 Temp[MLAS_CONV_WINOGRAD_TILE_OUTPUT * MLAS_CONV_WINOGRAD_TILE_INPUT];
+    MLAS_FLOAT32X4 ov[MLAS_CONV_WINOGRAD_TILE_OUTPUT * MLAS_CONV_WINOGRAD_TILE_OUTPUT];
+
+    //
+    // Transform four tiles at a time, one per vector lane.
+    //
+
+    for (size_t t = 0; t < CountTile; t += 4) {
+
+        const size_t CountT = std::min(CountTile - t, size_t(4));
+        const size_t Tile = StartTile + t;
+        const size_t OriginH = (Tile / TileCountW) * MLAS_CONV_WINOGRAD_TILE_OUTPUT;
+        const size_t OriginW = (Tile % TileCountW) * MLAS_CONV_WINOGRAD_TILE_OUTPUT;
+
+        //
+        // Four complete tiles in the same row can be transposed and stored
+        // directly to the output tensor.
+        //
+
+        const bool Interior = (CountT == 4) && ((Tile % TileCountW) + 4 <= TileCountW) &&
+            (OriginH + MLAS_CONV_WINOGRAD_TILE_OUTPUT <= OutputHeight) &&
+            (OriginW + 4 * MLAS_CONV_WINOGRAD_TILE_OUTPUT <= OutputWidth);
+
+        for (size_t f = 0; f < FilterCount; f++) {
+
+            const float* input = TransformedOutput + f * CountTile + t;
+
+            if (CountT == 4) {
+                for (size_t p = 0; p < MLAS_CONV_WINOGRAD_TILE_POINTS; p++) {
+                    mv[p] = MlasLoadFloat32x4(input + p * MatrixStride);
+                }
+            } else {
+                for (size_t p = 0; p < MLAS_CONV_WINOGRAD_TILE_POINTS; p++) {
+                    for (size_t l = 0; l < 4; l++) {
+                        m[p][l] = (l < CountT) ? input[p * MatrixStride + l] : 0.0f;
+                    }
+                    mv[p] = MlasLoadFloat32x4(m[p]);
+                }
+            }
+
+            //
+            // Compute A^T * m, then (A^T * m) * A.
+            //
+
+            for (size_t j = 0; j < MLAS_CONV_WINOGRAD_TILE_INPUT; j++) {
+                MlasConvWinogradTransformOutputRow(&mv[j], MLAS_CONV_WINOGRAD_TILE_INPUT, &Temp[j],
+                    MLAS_CONV_WINOGRAD_TILE_INPUT);
+            }
+
+            for (size_t i = 0; i < MLAS_CONV_WINOGRAD_TILE_OUTPUT; i++) {
+                MlasConvWinogradTransformOutputRow(&Temp[i * MLAS_CONV_WINOGRAD_TILE_INPUT], 1,
+                    &ov[i * MLAS_CONV_WINOGRAD_TILE_OUTPUT], 1);
+            }
+
+            float* output = Output + f * OutputSize;
+
+            if (Interior) {
+
+                for (size_t i = 0; i < MLAS_CONV_WINOGRAD_TILE_OUTPUT; i++) {
+
+                    MLAS_FLOAT32X4* oo = &ov[i * MLAS_CONV_WINOGRAD_TILE_OUTPUT];
+                    MlasConvWinogradTranspose4x4(oo[0], oo[1], oo[2], oo[3]);
+
+                    float* row = output + (OriginH + i) * OutputWidth + OriginW;
+
+                    for (size_t l = 0; l < 4; l++) {
+                        MLAS_FLOAT32X4 Value = oo[l];
+                        if (Beta != 0.0f) {
+                            Value = MlasMultiplyAddFloat32x4(MlasLoadFloat32x4(row + l * 4), Beta, Value);
+                        }
+                        MlasStoreFloat32x4(row + l * 4, Value);
+                    }
+                }
+
+            } else {
+
+                for (size_t p = 0; p < MLAS_CONV_WINOGRAD_TILE_OUTPUT * MLAS_CONV_WINOGRAD_TILE_OUTPUT; p++) {
+                    MlasStoreAlignedFloat32x4(o[p], ov[p]);
+                }
+
+                for (size_t l = 0; l < CountT; l++) {
+
+                    const size_t tl = Tile + l;
+                    const size_t oh = (tl / TileCountW) * MLAS_CONV_WINOGRAD_TILE_OUTPUT;
+                    const size_t ow = (tl % TileCountW) * MLAS_CONV_WINOGRAD_TILE_OUTPUT;
+                    const size_t CountH = std::min(OutputHeight - oh, size_t(MLAS_CONV_WINOGRAD_TILE_OUTPUT));
+                    const size_t CountW = std::min(OutputWidth - ow, size_t(MLAS_CONV_WINOGRAD_TILE_OUTPUT));
+
+                    for (size_t i = 0; i < CountH; i++) {
+                        float* row = output + (oh + i) * OutputWidth + ow;
+                        for (size_t j = 0; j < CountW; j++) {
+                            float Value = o[i * MLAS_CONV_WINOGRAD_TILE_OUTPUT + j][l];
+                            if (Beta != 0.0f) {
+                                Value += Beta * row[j];
+                            }
+                            row[j] = Value;
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+void
+MlasConvWinogradThreaded(
+    void* Context,
+    ptrdiff_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of a
+    Winograd convolution operation. Each thread transforms blocks of input
+    tiles, multiplies them by the transformed filter and transforms the
+    results back to the output tensor.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    Index - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_CONV_WORK_BLOCK* WorkBlock = (MLAS_CONV_WORK_BLOCK*)Context;
+
+    const MLAS_CONV_PARAMETERS* Parameters = WorkBlock->Parameters;
+
+    const size_t FilterCount = Parameters->FilterCount;
+    const size_t InputChannels = Parameters->InputChannels;
+    const size_t TileBlockSize = Parameters->u.Winograd.TileBlockSize;
+    const size_t TileCount = Parameters->u.Winograd.TileCount;
+    const size_t TileBlockCount = (TileCount + TileBlockSize - 1) / TileBlockSize;
+    const size_t FilterMatrixStride = FilterCount * InputChannels + MLAS_CONV_WINOGRAD_MATRIX_PADDING;
+
+    const size_t InputBufferSize =
+        MLAS_CONV_WINOGRAD_TILE_POINTS * (InputChannels * TileBlockSize + MLAS_CONV_WINOGRAD_MATRIX_PADDING);
+    const size_t OutputBufferSize =
+        MLAS_CONV_WINOGRAD_TILE_POINTS * (FilterCount * TileBlockSize + MLAS_CONV_WINOGRAD_MATRIX_PADDING);
+
+    float* TransformedInput = WorkBlock->WorkingBuffer + Index * (InputBufferSize + OutputBufferSize);
+    float* TransformedOutput = TransformedInput + InputBufferSize;
+
+    size_t BlockIndex;
+    size_t BlockRemaining;
+
+    MlasPartitionWork(Index, WorkBlock->TargetThreadCount, TileBlockCount, &BlockIndex, &BlockRemaining);
+
+    for (; BlockRemaining > 0; BlockRemaining--, BlockIndex++) {
+
+        const size_t StartTile = BlockIndex * TileBlockSize;
+        const size_t CountTile = std::min(TileCount - StartTile, TileBlockSize);
+        const size_t InputMatrixStride = InputChannels * CountTile + MLAS_CONV_WINOGRAD_MATRIX_PADDING;
+        const size_t OutputMatrixStride = FilterCount * CountTile + MLAS_CONV_WINOGRAD_MATRIX_PADDING;
+
+        MlasConvWinogradTransformInput(Parameters, WorkBlock->Input, TransformedInput, StartTile, CountTile);
+
+        for (size_t p = 0; p < MLAS_CONV_WINOGRAD_TILE_POINTS; p++) {
+            MlasConvGemmOperation(Parameters, CblasNoTrans, FilterCount, CountTile, InputChannels,
+                WorkBlock->Filter + p * FilterMatrixStride, InputChannels,
+                TransformedInput + p * InputMatrixStride, CountTile, 0.0f,
+                TransformedOutput + p * OutputMatrixStride, CountTile);
+        }
+
+        MlasConvWinogradTransformOutput(Parameters, TransformedOutput, WorkBlock->Output, StartTile, CountTile);
+    }
+}
+
+void
+MlasConvWinograd(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* Input,
+    const float* Filter,
+    float* WorkingBuffer,
+    float* Output,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine implements a 3x3 stride 1 convolution for one group using
+    the Winograd F(4x4, 3x3) algorithm.
+
+Arguments:
+
+    Parameters - Supplies the structure that contains the convolution
+        parameters.
+
+    Input - Supplies the input tensor for the group.
+
+    Filter - Supplies the filter tensor for the group.
+
+    WorkingBuffer - Supplies a working buffer sized to the number of elements
+        returned by MlasConvPrepare.
+
+    Output - Supplies the output tensor for the group.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t FilterCount = Parameters->FilterCount;
+    const ptrdiff_t ThreadCount = Parameters->ThreadCount;
+
+    float* TransformedFilter = WorkingBuffer;
+
+    //
+    // Transform the filter tensor across the worker threads.
+    //
+
+    MlasTrySimpleParallel(ThreadPool, ThreadCount, [&](ptrdiff_t tid) {
+        size_t StartF;
+        size_t CountF;
+        MlasPartitionWork(tid, ThreadCount, FilterCount, &StartF, &CountF);
+        MlasConvWinogradTransformFilter(Parameters, Filter, TransformedFilter, StartF, CountF);
+    });
+
+    MLAS_CONV_WORK_BLOCK WorkBlock;
+
+    WorkBlock.Parameters = Parameters;
+    WorkBlock.Input = Input;
+    WorkBlock.Filter = TransformedFilter;
+    WorkBlock.Bias = nullptr;
+    WorkBlock.WorkingBuffer = TransformedFilter +
+        MLAS_CONV_WINOGRAD_TILE_POINTS * (FilterCount * Parameters->InputChannels + MLAS_CONV_WINOGRAD_MATRIX_PADDING);
+    WorkBlock.Output = Output;
+    WorkBlock.TargetThreadCount = ThreadCount;
+
+    MlasExecuteThreaded(MlasConvWinogradThreaded, &WorkBlock, ThreadCount, ThreadPool);
+}
+
 void
 MLASCALL
 MlasConv(
@@ -935,9 +1705,9 @@ Return Value:
                     // Invoke the threaded GEMM directly with the input tensor.
                     //
 
-                    MlasGemm(CblasNoTrans, Parameters->u.GemmDirect.TransB, FilterCount, OutputSize,
-                             K, 1.0f, filter, K, Input, Parameters->u.GemmDirect.ldb,
-                             Parameters->Beta, Output, OutputSize, ThreadPool);
+                    MlasConvGemm(Parameters, Parameters->u.GemmDirect.TransB, FilterCount,
+                                 OutputSize, K, filter, K, Input, Parameters->u.GemmDirect.ldb,
+                                 Parameters->Beta, Output, OutputSize, ThreadPool);
 
                     //
                     // Apply the activation with optional bias.
@@ -962,9 +1732,9 @@ Return Value:
                         MlasConvVol2Col(Parameters, Input, WorkingBuffer, 0, K, 0, OutputSize);
                     }
 
-                    MlasGemm(CblasNoTrans, CblasNoTrans, FilterCount, OutputSize, K, 1.0f, filter,
-                             K, WorkingBuffer, OutputSize, Parameters->Beta, Output, OutputSize,
-                             ThreadPool);
+                    MlasConvGemm(Parameters, CblasNoTrans, FilterCount, OutputSize, K, filter,
+                                 K, WorkingBuffer, OutputSize, Parameters->Beta, Output, OutputSize,
+                                 ThreadPool);
 
                     //
                     // Apply the activation with optional bias.
@@ -987,6 +1757,20 @@ Return Value:
 
 #endif
 
+                case MlasConvAlgorithmWinograd:
+                {
+                    MlasConvWinograd(Parameters, Input, filter, WorkingBuffer, Output, ThreadPool);
+
+                    //
+                    // Apply the activation with optional bias.
+                    //
+
+                    MlasActivation(Parameters->Activation, Output, bias, FilterCount,
+                        OutputSize, OutputSize);
+
+                    break;
+                }
+
                 case MlasConvAlgorithmExpandThenGemmSegmented:
                 {
                     //
@@ -1041,7 +1825,8 @@ MlasConvPrepare(
     const MLAS_ACTIVATION* Activation,
     size_t* WorkingBufferSize,
     float Beta,
-    MLAS_THREADPOOL* ThreadPool
+    MLAS_THREADPOOL* ThreadPool,
+    bool UseBf16Compute
     )
 /*++
 
@@ -1088,6 +1873,10 @@ Arguments:
     ThreadPool - Supplies the thread pool object to use, else nullptr if the
         base library threading support should be used.
 
+    UseBf16Compute - Supplies true to compute the convolution GEMMs with
+        bfloat16 inputs and single precision accumulation. Ignored if the
+        processor does not support SBGEMM.
+
 Return Value:
 
     None.
@@ -1104,6 +1893,7 @@ Return Value:
     Parameters->InputChannels = InputChannels;
     Parameters->FilterCount = FilterCount;
     Parameters->Beta = Beta;
+    Parameters->Bf16Compute = UseBf16Compute && MlasBf16AccelerationSupported();
 
     size_t InputSize = 1;
     size_t OutputSize = 1;
@@ -1211,6 +2001,51 @@ Return Value:
         }
     }
 
+    if (Dimensions == 2 && AllStridesAreOne && AllDilationsAreOne &&
+        Parameters->KernelShape[0] == 3 && Parameters->KernelShape[1] == 3 &&
+        InputChannels >= MLAS_CONV_WINOGRAD_MINIMUM_CHANNELS &&
+        FilterCount >= MLAS_CONV_WINOGRAD_MINIMUM_CHANNELS &&
+        Parameters->OutputShape[0] >= MLAS_CONV_WINOGRAD_MINIMUM_OUTPUT_SHAPE &&
+        Parameters->OutputShape[1] >= MLAS_CONV_WINOGRAD_MINIMUM_OUTPUT_SHAPE) {
+
+        //
+        // Use the Winograd F(4x4, 3x3) algorithm, which reduces the number of
+        // multiplies by 4x relative to the direct convolution. The input tiles
+        // are processed in blocks sized so that the transformed input and
+        // output for a block remain cache resident.
+        //
+
+        const size_t TileCount =
+            ((Parameters->OutputShape[0] + MLAS_CONV_WINOGRAD_TILE_OUTPUT - 1) / MLAS_CONV_WINOGRAD_TILE_OUTPUT) *
+            ((Parameters->OutputShape[1] + MLAS_CONV_WINOGRAD_TILE_OUTPUT - 1) / MLAS_CONV_WINOGRAD_TILE_OUTPUT);
+        const size_t TileBufferSize = MLAS_CONV_WINOGRAD_TILE_POINTS * (InputChannels + FilterCount);
+
+        size_t TileBlockSize = MLAS_CONV_WINOGRAD_BLOCK_BUFFER_SIZE / TileBufferSize;
+        TileBlockSize = std::max(TileBlockSize & ~size_t(3), size_t(MLAS_CONV_WINOGRAD_MINIMUM_TILE_BLOCK));
+        TileBlockSize = std::min(TileBlockSize, TileCount);
+
+        const size_t TileBlockCount = (TileCount + TileBlockSize - 1) / TileBlockSize;
+
+        ptrdiff_t TargetThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+        if (size_t(TargetThreadCount) > TileBlockCount) {
+            TargetThreadCount = ptrdiff_t(TileBlockCount);
+        }
+
+        Parameters->ThreadCount = TargetThreadCount;
+
+        Parameters->Algorithm = MlasConvAlgorithmWinograd;
+        Parameters->u.Winograd.TileCount = TileCount;
+        Parameters->u.Winograd.TileBlockSize = TileBlockSize;
+
+        *WorkingBufferSize =
+            MLAS_CONV_WINOGRAD_TILE_POINTS * (FilterCount * InputChannels + MLAS_CONV_WINOGRAD_MATRIX_PADDING) +
+            TargetThreadCount * (TileBufferSize * TileBlockSize +
+                2 * MLAS_CONV_WINOGRAD_TILE_POINTS * MLAS_CONV_WINOGRAD_MATRIX_PADDING);
+
+        return;
+    }
+
     if (FilterCount > OutputSize) {
 
         //
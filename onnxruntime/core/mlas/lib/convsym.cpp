@@ -78,6 +78,9 @@ extern "C" {
     MLAS_CONV_SYM_DEPTHWISE_KERNEL MlasConvSymDepthwiseKernelAvx512Core;
     MLAS_CONV_SYM_KERNEL MlasConvSymKernelAvx512Vnni;
     MLAS_CONV_SYM_DEPTHWISE_KERNEL MlasConvSymDepthwiseKernelAvx512Vnni;
+#if defined(MLAS_AMX_SUPPORTED)
+    MLAS_CONV_SYM_KERNEL MlasConvSymKernelAmx;
+#endif
 #elif defined(MLAS_TARGET_ARM64)
     MLAS_CONV_SYM_KERNEL MlasConvSymS8KernelNeon;
     MLAS_CONV_SYM_KERNEL MlasConvSymU8KernelNeon;
@@ -229,6 +232,32 @@ const MLAS_CONV_SYM_DISPATCH MlasConvSymDispatchAvx512Vnni = {
     false,                                  // FixupInputZeroPoint
 };
 
+#if defined(MLAS_AMX_SUPPORTED)
+
+//
+// The AMX kernel computes a 16 output by 64 output channel block with four
+// accumulator tiles. Processors with AMX also have AVX512 VNNI, which runs the
+// depthwise convolutions.
+//
+
+const MLAS_CONV_SYM_DISPATCH MlasConvSymDispatchAmx = {
+    MlasConvSymKernelAmx,
+    MlasConvSymDepthwiseKernelAvx512Vnni,
+    nullptr,
+    nullptr,
+    4,                                      // FilterInputChannelPackCount
+    16,                                     // FilterOutputChannelPackCount
+    64,                                     // KernelChannelCount
+    16,                                     // KernelOutputCount
+    4,                                      // KernelInputChannelAlignment
+    4,                                      // KernelOutputChannelAlignment
+    64,                                     // KernelDepthwiseChannelCount
+    6,                                      // KernelDepthwiseOutputCount
+    false,                                  // FixupInputZeroPoint
+};
+
+#endif // MLAS_AMX_SUPPORTED
+
 #endif // ORT_MINIMAL_BUILD
 
 #elif defined(MLAS_TARGET_ARM64)
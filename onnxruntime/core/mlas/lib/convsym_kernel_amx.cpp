@@ -0,0 +1,295 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    convsym_kernel_amx.cpp
+
+Abstract:
+
+    This module implements the symmetric quantized integer convolution kernel
+    for amx.
+
+    The convolution runs as an implicit GEMM: each kernel element and block of
+    64 input channels is one tile multiply step. The rows of the A tile are the
+    input channel vectors of up to 16 outputs, gathered through the indirection
+    buffer. The packed filter already has the 4 input channel by 16 output
+    channel layout of a B tile, so it is loaded in place.
+
+--*/
+
+#include "mlasi.h"
+#include "amx_common.h"
+
+#define TMM0 0
+#define TMM1 1
+#define TMM2 2
+#define TMM3 3
+#define TMM4 4
+#define TMM5 5
+#define TMM6 6
+#define TMM7 7
+
+#define TILE_M 16
+#define TILE_N 16
+#define TILE_K 64
+
+//
+// Tile configure structure
+//
+
+struct MLAS_CONV_SYM_TILECONFIG {
+    uint8_t palette_id;
+    uint8_t start_row;
+    uint8_t reserved1[14];
+    uint16_t colb[8];
+    uint8_t reserved2[16];
+    uint8_t rows[8];
+    uint8_t reserved3[8];
+};
+
+MLAS_FORCEINLINE
+void
+MlasConvSymTileConfigAmx(
+    void
+    )
+/*++
+
+Routine Description:
+
+    This routine loads the configuration of 8 tiles of 16 rows by 64 bytes,
+    unless the thread already uses it. This is the configuration of the
+    QGEMM kernel, so the two share tiles without reloading.
+
+--*/
+{
+    MLAS_CONV_SYM_TILECONFIG tc = {};
+    tc.palette_id = 1;
+    for (int t = 0; t < 8; t++) {
+        tc.rows[t] = TILE_M;
+        tc.colb[t] = TILE_K;
+    }
+
+    MLAS_CONV_SYM_TILECONFIG current_tc = {};
+    _tile_storeconfig(&current_tc);
+
+    if (std::memcmp(&current_tc, &tc, sizeof(tc)) != 0) {
+        _tile_loadconfig(&tc);
+    }
+}
+
+MLAS_FORCEINLINE
+void
+MlasConvSymPostProcessAmx(
+    const int32_t* Accumulators,
+    uint8_t* Output,
+    size_t OutputChannels,
+    size_t ChannelOffset,
+    unsigned ChannelCount,
+    unsigned OutputCount,
+    const MLAS_CONV_SYM_POST_PROCESS_PARAMS* PostProcessParams,
+    unsigned KernelFlags
+    )
+/*++
+
+Routine Description:
+
+    This routine requantizes a 16 by 16 block of accumulators and stores the
+    rows of the valid outputs, matching the post processing of the AVX512 core
+    kernels.
+
+--*/
+{
+    const __mmask16 ChannelMask = __mmask16((uint32_t(1) << ChannelCount) - 1);
+
+    const __m512i BiasVector = _mm512_maskz_loadu_epi32(ChannelMask, PostProcessParams->Bias + ChannelOffset);
+    const __m512 ScaleVector = (KernelFlags & MLAS_CONV_SYM_FLAG_PER_CHANNEL_SCALE) != 0
+        ? _mm512_maskz_loadu_ps(ChannelMask, PostProcessParams->Scale + ChannelOffset)
+        : _mm512_set1_ps(PostProcessParams->Scale[0]);
+    const __m512 MinimumVector = _mm512_set1_ps(PostProcessParams->MinimumValue);
+    const __m512 MaximumVector = _mm512_set1_ps(PostProcessParams->MaximumValue);
+    const __m512i ZeroPointVector = _mm512_set1_epi32(PostProcessParams->OutputZeroPoint);
+
+    for (unsigned m = 0; m < OutputCount; m++) {
+
+        __m512i Accumulator = _mm512_add_epi32(_mm512_loadu_si512(Accumulators + m * TILE_N), BiasVector);
+        __m512 Value = _mm512_mul_ps(_mm512_cvtepi32_ps(Accumulator), ScaleVector);
+
+        Value = _mm512_min_ps(_mm512_max_ps(Value, MinimumVector), MaximumVector);
+
+        __m512i Quantized = _mm512_add_epi32(_mm512_cvtps_epi32(Value), ZeroPointVector);
+        _mm512_mask_cvtusepi32_storeu_epi8(Output + m * OutputChannels + ChannelOffset, ChannelMask, Quantized);
+    }
+}
+
+extern "C"
+void
+MLASCALL
+MlasConvSymKernelAmx(
+    const void* Input,
+    const void* Filter,
+    void* Output,
+    size_t KernelSize,
+    size_t InputChannels,
+    size_t OutputChannels,
+    unsigned ChannelCount,
+    unsigned OutputCount,
+    const MLAS_CONV_SYM_POST_PROCESS_PARAMS* PostProcessParams,
+    unsigned KernelFlags
+    )
+/*++
+
+Routine Description:
+
+    This routine computes up to 16 outputs of up to 64 output channels of the
+    symmetric U8S8 convolution.
+
+Arguments:
+
+    Input - Supplies the indirection buffer of the outputs, KernelSize pointers
+        per output, or the input rows if MLAS_CONV_SYM_FLAG_INPUT_DIRECT is set.
+
+    Filter - Supplies the packed filter of the output channel block.
+
+    Output - Supplies the address of the first output.
+
+    KernelSize - Supplies the number of kernel elements.
+
+    InputChannels - Supplies the number of input channels.
+
+    OutputChannels - Supplies the number of output channels, the row stride
+        of the output.
+
+    ChannelCount - Supplies the number of output channels to compute.
+
+    OutputCount - Supplies the number of outputs to compute.
+
+    PostProcessParams - Supplies the requantization parameters.
+
+    KernelFlags - Supplies the MLAS_CONV_SYM_FLAG_* flags.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MlasConvSymTileConfigAmx();
+
+    MLAS_DECLSPEC_ALIGN(uint8_t PanelA[TILE_M * TILE_K], 64);
+    MLAS_DECLSPEC_ALIGN(int8_t PanelB[TILE_K / 4 * TILE_N * 4], 64);
+    MLAS_DECLSPEC_ALIGN(int32_t Accumulators[TILE_M * TILE_N], 64);
+
+    const size_t BlockCount = (ChannelCount + TILE_N - 1) / TILE_N;
+    const size_t FilterBlockStride = TILE_N * InputChannels * KernelSize;
+
+    //
+    // The rows past the output count are multiplied but never stored.
+    //
+
+    if (OutputCount < TILE_M) {
+        std::memset(PanelA + OutputCount * TILE_K, 0, (TILE_M - OutputCount) * TILE_K);
+    }
+
+    _tile_zero(TMM0);
+    _tile_zero(TMM1);
+    _tile_zero(TMM2);
+    _tile_zero(TMM3);
+
+    for (size_t k = 0; k < KernelSize; k++) {
+
+        for (size_t ic = 0; ic < InputChannels; ic += TILE_K) {
+
+            const size_t CountK = std::min<size_t>(InputChannels - ic, TILE_K);
+            const __mmask64 InputMask = (CountK == TILE_K) ? ~__mmask64(0) : (__mmask64(1) << CountK) - 1;
+
+            //
+            // Gather the input channel vectors of the outputs into the A
+            // panel, zero filling past the input channel count.
+            //
+
+            for (unsigned m = 0; m < OutputCount; m++) {
+
+                const uint8_t* input;
+
+                if ((KernelFlags & MLAS_CONV_SYM_FLAG_INPUT_DIRECT) != 0) {
+                    input = static_cast<const uint8_t*>(Input) + m * InputChannels;
+                } else {
+                    input = static_cast<const uint8_t* const*>(Input)[m * KernelSize + k];
+                }
+
+                _mm512_store_si512(PanelA + m * TILE_K, _mm512_maskz_loadu_epi8(InputMask, input + ic));
+            }
+
+            tile_loadd(TMM4, PanelA, TILE_K);
+
+            //
+            // The B tile of an output channel block is in place in the packed
+            // filter, unless the input channels end inside the tile: the rows
+            // past them would run into the next kernel element or past the
+            // filter buffer.
+            //
+
+            const int8_t* filter = static_cast<const int8_t*>(Filter) + (k * InputChannels + ic) * TILE_N;
+
+            for (size_t block = 0; block < BlockCount; block++) {
+
+                const int8_t* b = filter + block * FilterBlockStride;
+
+                if (CountK < TILE_K) {
+                    std::memcpy(PanelB, b, CountK * TILE_N);
+                    std::memset(PanelB + CountK * TILE_N, 0, (TILE_K - CountK) * TILE_N);
+                    b = PanelB;
+                }
+
+                switch (block) {
+                    case 0:
+                        tile_loadd(TMM5, b, TILE_N * 4);
+                        _tile_dpbusd(TMM0, TMM4, TMM5);
+                        break;
+                    case 1:
+                        tile_loadd(TMM6, b, TILE_N * 4);
+                        _tile_dpbusd(TMM1, TMM4, TMM6);
+                        break;
+                    case 2:
+                        tile_loadd(TMM7, b, TILE_N * 4);
+                        _tile_dpbusd(TMM2, TMM4, TMM7);
+                        break;
+                    default:
+                        tile_loadd(TMM5, b, TILE_N * 4);
+                        _tile_dpbusd(TMM3, TMM4, TMM5);
+                        break;
+                }
+            }
+        }
+    }
+
+    uint8_t* output = static_cast<uint8_t*>(Output);
+
+    for (size_t block = 0; block < BlockCount; block++) {
+
+        switch (block) {
+            case 0:
+                tile_stored(TMM0, Accumulators, TILE_N * sizeof(int32_t));
+                break;
+            case 1:
+                tile_stored(TMM1, Accumulators, TILE_N * sizeof(int32_t));
+                break;
+            case 2:
+                tile_stored(TMM2, Accumulators, TILE_N * sizeof(int32_t));
+                break;
+            default:
+                tile_stored(TMM3, Accumulators, TILE_N * sizeof(int32_t));
+                break;
+        }
+
+        const unsigned ChannelOffset = unsigned(block * TILE_N);
+
+        MlasConvSymPostProcessAmx(Accumulators, output, OutputChannels, ChannelOffset,
+                                  std::min<unsigned>(ChannelCount - ChannelOffset, TILE_N),
+                                  OutputCount, PostProcessParams, KernelFlags);
+    }
+}
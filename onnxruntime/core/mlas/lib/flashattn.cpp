@@ -0,0 +1,290 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    flashattn.cpp
+
+Abstract:
+
+    This module implements a fused attention operation that computes
+    softmax(Scale * Query x Key') x Value one block of query rows at a time.
+
+    The key and value are walked in blocks. For each block, the scores are
+    computed with SGEMM, folded into a running row maximum and sum of
+    exponentials (online softmax), and multiplied with the value block into
+    an output accumulator. The SxL attention probabilities are never
+    materialized, so the working set per thread is bounded by the block
+    sizes instead of growing with the square of the sequence length.
+
+    The matrix multiplies and the row reductions use the platform SGEMM,
+    maximum, exponential and scaling kernels, so AVX512F/AVX2 and NEON
+    targets run their vectorized implementations.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Number of query rows and key/value rows processed per block. The score
+// block and the output accumulator of a query block stay resident in the
+// L2 cache for typical head sizes.
+//
+
+#define MLAS_FLASH_ATTENTION_Q_BLOCK                64
+#define MLAS_FLASH_ATTENTION_KV_BLOCK               256
+
+MLAS_FORCEINLINE
+float
+MlasFlashAttentionReduceMaximum(
+    const float* Input,
+    size_t N
+    )
+{
+#if defined(MLAS_TARGET_AMD64)
+    return GetMlasPlatform().ReduceMaximumF32Kernel(Input, N);
+#else
+    return MlasReduceMaximumF32Kernel(Input, N);
+#endif
+}
+
+MLAS_FORCEINLINE
+float
+MlasFlashAttentionSumExp(
+    float* Scores,
+    size_t N,
+    float NegativeMaximum
+    )
+{
+#if defined(MLAS_TARGET_AMD64)
+    return GetMlasPlatform().ComputeSumExpF32Kernel(Scores, Scores, N, &NegativeMaximum);
+#else
+    return MlasComputeSumExpF32Kernel(Scores, Scores, N, &NegativeMaximum);
+#endif
+}
+
+MLAS_FORCEINLINE
+void
+MlasFlashAttentionScale(
+    float* Output,
+    size_t N,
+    float Scale
+    )
+{
+    const float Parameters[] = { Scale };
+
+#if defined(MLAS_TARGET_AMD64)
+    GetMlasPlatform().ComputeSoftmaxOutputF32Kernel(Output, N, Parameters);
+#else
+    MlasComputeSoftmaxOutputF32Kernel(Output, N, Parameters);
+#endif
+}
+
+void
+MlasFlashAttentionQueryBlock(
+    const MLAS_FLASH_ATTENTION_PARAMS* Params,
+    size_t BatchHead,
+    size_t QueryStart,
+    size_t QueryCount,
+    float* Buffer
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the attention output for a block of query rows of
+    a single batch and head.
+
+Arguments:
+
+    Params - Supplies the attention shapes and buffers.
+
+    BatchHead - Supplies the index of the batch and head (b * N + n).
+
+    QueryStart - Supplies the first query row of the block.
+
+    QueryCount - Supplies the number of query rows in the block.
+
+    Buffer - Supplies the scratch buffer for the score block, the output
+        accumulator and the running row statistics.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t S = Params->SequenceLength;
+    const size_t L = Params->KvSequenceLength;
+    const size_t H = Params->QkHeadSize;
+    const size_t Hv = Params->VHeadSize;
+
+    const float* Query = Params->Query + (BatchHead * S + QueryStart) * H;
+    const float* Key = Params->Key + BatchHead * L * H;
+    const float* Value = Params->Value + BatchHead * L * Hv;
+
+    float* Scores = Buffer;
+    float* Accumulator = Scores + MLAS_FLASH_ATTENTION_Q_BLOCK * MLAS_FLASH_ATTENTION_KV_BLOCK;
+    float* RowMaximum = Accumulator + MLAS_FLASH_ATTENTION_Q_BLOCK * Hv;
+    float* RowSum = RowMaximum + MLAS_FLASH_ATTENTION_Q_BLOCK;
+
+    //
+    // With a causal mask, query row i attends to the keys up to i + L - S so
+    // that the last query row lines up with the last key.
+    //
+
+    const ptrdiff_t CausalOffset = ptrdiff_t(L) - ptrdiff_t(S);
+
+    size_t KeyEnd = L;
+
+    if (Params->Causal) {
+        const ptrdiff_t LastKey = ptrdiff_t(QueryStart + QueryCount - 1) + CausalOffset;
+        KeyEnd = size_t(std::min(std::max(LastKey + 1, ptrdiff_t(0)), ptrdiff_t(L)));
+    }
+
+    for (size_t m = 0; m < QueryCount; m++) {
+        RowMaximum[m] = std::numeric_limits<float>::lowest();
+        RowSum[m] = 0.0f;
+    }
+
+    bool FirstBlock = true;
+
+    for (size_t KeyStart = 0; KeyStart < KeyEnd; KeyStart += MLAS_FLASH_ATTENTION_KV_BLOCK) {
+
+        const size_t KeyCount = std::min(KeyEnd - KeyStart, size_t(MLAS_FLASH_ATTENTION_KV_BLOCK));
+
+        //
+        // Scores = Scale * Query x Key' for the block.
+        //
+
+        MlasSgemmOperation(CblasNoTrans, CblasTrans, QueryCount, KeyCount, H, Params->Scale,
+                           Query, H, Key + KeyStart * H, H, 0.0f, Scores, KeyCount);
+
+        //
+        // Fold the block into the running statistics of each row and
+        // replace the scores with their exponentials.
+        //
+
+        for (size_t m = 0; m < QueryCount; m++) {
+
+            float* RowScores = Scores + m * KeyCount;
+            size_t ValidCount = KeyCount;
+
+            if (Params->Causal) {
+                const ptrdiff_t LastKey = ptrdiff_t(QueryStart + m) + CausalOffset;
+                ValidCount = size_t(std::min(std::max(LastKey + 1 - ptrdiff_t(KeyStart), ptrdiff_t(0)),
+                                             ptrdiff_t(KeyCount)));
+                std::fill_n(RowScores + ValidCount, KeyCount - ValidCount, 0.0f);
+            }
+
+            if (ValidCount == 0) {
+                continue;
+            }
+
+            const float BlockMaximum = MlasFlashAttentionReduceMaximum(RowScores, ValidCount);
+            const float Maximum = std::max(RowMaximum[m], BlockMaximum);
+            const float Correction = std::exp(RowMaximum[m] - Maximum);
+
+            RowSum[m] = RowSum[m] * Correction + MlasFlashAttentionSumExp(RowScores, ValidCount, -Maximum);
+            RowMaximum[m] = Maximum;
+
+            if (!FirstBlock && Correction != 1.0f) {
+                MlasFlashAttentionScale(Accumulator + m * Hv, Hv, Correction);
+            }
+        }
+
+        //
+        // Accumulator += exp(Scores) x Value for the block. The first block
+        // initializes the accumulator.
+        //
+
+        MlasSgemmOperation(CblasNoTrans, CblasNoTrans, QueryCount, Hv, KeyCount, 1.0f,
+                           Scores, KeyCount, Value + KeyStart * Hv, Hv, FirstBlock ? 0.0f : 1.0f,
+                           Accumulator, Hv);
+
+        FirstBlock = false;
+    }
+
+    //
+    // Normalize each row by its sum of exponentials and store it to the
+    // output, which is laid out as BxSxNxH_v.
+    //
+
+    const size_t BatchIndex = BatchHead / Params->NumHeads;
+    const size_t HeadIndex = BatchHead % Params->NumHeads;
+    const size_t OutputStride = Params->NumHeads * Hv;
+
+    float* Output = Params->Output + ((BatchIndex * S + QueryStart) * Params->NumHeads + HeadIndex) * Hv;
+
+    for (size_t m = 0; m < QueryCount; m++) {
+
+        if (FirstBlock || RowSum[m] == 0.0f) {
+            std::fill_n(Output, Hv, 0.0f);
+        } else {
+            std::copy_n(Accumulator + m * Hv, Hv, Output);
+            MlasFlashAttentionScale(Output, Hv, 1.0f / RowSum[m]);
+        }
+
+        Output += OutputStride;
+    }
+}
+
+void
+MLASCALL
+MlasFlashAttention(
+    const MLAS_FLASH_ATTENTION_PARAMS* Params,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine computes softmax(Scale * Query x Key') x Value for each batch
+    and head without materializing the attention probabilities.
+
+Arguments:
+
+    Params - Supplies the attention shapes and buffers.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t BatchHeads = Params->BatchSize * Params->NumHeads;
+    const size_t QueryBlocks = MlasDivRoundup(Params->SequenceLength, MLAS_FLASH_ATTENTION_Q_BLOCK);
+
+    if (BatchHeads == 0 || QueryBlocks == 0 || Params->VHeadSize == 0) {
+        return;
+    }
+
+    const size_t BufferSize = UpAlignSize(
+        sizeof(float) * (MLAS_FLASH_ATTENTION_Q_BLOCK * MLAS_FLASH_ATTENTION_KV_BLOCK +
+                         MLAS_FLASH_ATTENTION_Q_BLOCK * Params->VHeadSize +
+                         MLAS_FLASH_ATTENTION_Q_BLOCK * 2));
+
+    //
+    // Each work item is one block of query rows of one batch and head. The
+    // scratch buffer is private to the worker thread.
+    //
+
+    MlasTrySimpleParallel(ThreadPool, ptrdiff_t(BatchHeads * QueryBlocks), [&](ptrdiff_t tid) {
+
+        const size_t BatchHead = size_t(tid) / QueryBlocks;
+        const size_t QueryStart = (size_t(tid) % QueryBlocks) * MLAS_FLASH_ATTENTION_Q_BLOCK;
+        const size_t QueryCount = std::min(Params->SequenceLength - QueryStart,
+                                           size_t(MLAS_FLASH_ATTENTION_Q_BLOCK));
+
+        MlasThreadedBufAlloc(BufferSize);
+        float* Buffer = reinterpret_cast<float*>(ThreadedBufHolder.get());
+
+        MlasFlashAttentionQueryBlock(Params, BatchHead, QueryStart, QueryCount, Buffer);
+    });
+}
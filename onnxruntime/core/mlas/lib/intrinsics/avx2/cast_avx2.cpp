@@ -0,0 +1,178 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    cast_avx2.cpp
+
+Abstract:
+
+    This module implements the conversions between single precision floats
+    and the half precision and brain floating point formats with AVX2 and F16C
+    instructions.
+
+--*/
+
+#include "mlasi.h"
+
+MLAS_FORCEINLINE
+__m256i
+MlasFloatToBFloat16Avx2(
+    __m256 Vector
+    )
+/*++
+
+Routine Description:
+
+    This routine rounds 8 floats to nearest even bfloat16 values, returned in
+    the low halves of the 32-bit elements. NaNs become the quiet NaN of the
+    same sign.
+
+--*/
+{
+    const __m256i Bits = _mm256_castps_si256(Vector);
+    const __m256i Bias = _mm256_add_epi32(_mm256_set1_epi32(0x7FFF),
+        _mm256_and_si256(_mm256_srli_epi32(Bits, 16), _mm256_set1_epi32(1)));
+    const __m256i Rounded = _mm256_srli_epi32(_mm256_add_epi32(Bits, Bias), 16);
+    const __m256i QuietNaN = _mm256_or_si256(
+        _mm256_and_si256(_mm256_srli_epi32(Bits, 16), _mm256_set1_epi32(0x8000)), _mm256_set1_epi32(0x7FC0));
+    const __m256 IsNaN = _mm256_cmp_ps(Vector, Vector, _CMP_UNORD_Q);
+
+    return _mm256_castps_si256(_mm256_blendv_ps(_mm256_castsi256_ps(Rounded), _mm256_castsi256_ps(QuietNaN), IsNaN));
+}
+
+void
+MLASCALL
+MlasCastF16ToF32KernelAvx2(
+    const unsigned short* Source,
+    float* Destination,
+    size_t Count
+    )
+{
+    while (Count >= 16) {
+        __m256 Vector0 = _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)Source));
+        __m256 Vector1 = _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)(Source + 8)));
+        _mm256_storeu_ps(Destination, Vector0);
+        _mm256_storeu_ps(Destination + 8, Vector1);
+        Source += 16;
+        Destination += 16;
+        Count -= 16;
+    }
+
+    if (Count >= 8) {
+        _mm256_storeu_ps(Destination, _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)Source)));
+        Source += 8;
+        Destination += 8;
+        Count -= 8;
+    }
+
+    if (Count > 0) {
+        MLAS_DECLSPEC_ALIGN(unsigned short Buffer[8], 16) = {};
+        MLAS_DECLSPEC_ALIGN(float Result[8], 32);
+        std::memcpy(Buffer, Source, Count * sizeof(unsigned short));
+        _mm256_store_ps(Result, _mm256_cvtph_ps(_mm_load_si128((const __m128i*)Buffer)));
+        std::memcpy(Destination, Result, Count * sizeof(float));
+    }
+}
+
+void
+MLASCALL
+MlasCastF32ToF16KernelAvx2(
+    const float* Source,
+    unsigned short* Destination,
+    size_t Count
+    )
+{
+    while (Count >= 16) {
+        __m128i Vector0 = _mm256_cvtps_ph(_mm256_loadu_ps(Source), _MM_FROUND_TO_NEAREST_INT);
+        __m128i Vector1 = _mm256_cvtps_ph(_mm256_loadu_ps(Source + 8), _MM_FROUND_TO_NEAREST_INT);
+        _mm_storeu_si128((__m128i*)Destination, Vector0);
+        _mm_storeu_si128((__m128i*)(Destination + 8), Vector1);
+        Source += 16;
+        Destination += 16;
+        Count -= 16;
+    }
+
+    if (Count >= 8) {
+        _mm_storeu_si128((__m128i*)Destination, _mm256_cvtps_ph(_mm256_loadu_ps(Source), _MM_FROUND_TO_NEAREST_INT));
+        Source += 8;
+        Destination += 8;
+        Count -= 8;
+    }
+
+    if (Count > 0) {
+        MLAS_DECLSPEC_ALIGN(float Buffer[8], 32) = {};
+        MLAS_DECLSPEC_ALIGN(unsigned short Result[8], 16);
+        std::memcpy(Buffer, Source, Count * sizeof(float));
+        _mm_store_si128((__m128i*)Result, _mm256_cvtps_ph(_mm256_load_ps(Buffer), _MM_FROUND_TO_NEAREST_INT));
+        std::memcpy(Destination, Result, Count * sizeof(unsigned short));
+    }
+}
+
+void
+MLASCALL
+MlasCastBF16ToF32KernelAvx2(
+    const unsigned short* Source,
+    float* Destination,
+    size_t Count
+    )
+{
+    while (Count >= 8) {
+        __m256i Vector = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)Source));
+        _mm256_storeu_si256((__m256i*)Destination, _mm256_slli_epi32(Vector, 16));
+        Source += 8;
+        Destination += 8;
+        Count -= 8;
+    }
+
+    if (Count > 0) {
+        MLAS_DECLSPEC_ALIGN(unsigned short Buffer[8], 16) = {};
+        MLAS_DECLSPEC_ALIGN(float Result[8], 32);
+        std::memcpy(Buffer, Source, Count * sizeof(unsigned short));
+        __m256i Vector = _mm256_cvtepu16_epi32(_mm_load_si128((const __m128i*)Buffer));
+        _mm256_store_si256((__m256i*)Result, _mm256_slli_epi32(Vector, 16));
+        std::memcpy(Destination, Result, Count * sizeof(float));
+    }
+}
+
+void
+MLASCALL
+MlasCastF32ToBF16KernelAvx2(
+    const float* Source,
+    unsigned short* Destination,
+    size_t Count
+    )
+{
+    while (Count >= 16) {
+        __m256i Vector0 = MlasFloatToBFloat16Avx2(_mm256_loadu_ps(Source));
+        __m256i Vector1 = MlasFloatToBFloat16Avx2(_mm256_loadu_ps(Source + 8));
+
+        //
+        // The pack interleaves the 128-bit lanes of the two vectors, so
+        // restore the element order with a permute.
+        //
+
+        __m256i Packed = _mm256_permute4x64_epi64(_mm256_packus_epi32(Vector0, Vector1), 0xD8);
+        _mm256_storeu_si256((__m256i*)Destination, Packed);
+        Source += 16;
+        Destination += 16;
+        Count -= 16;
+    }
+
+    while (Count > 0) {
+        MLAS_DECLSPEC_ALIGN(float Buffer[8], 32) = {};
+        MLAS_DECLSPEC_ALIGN(unsigned short Result[8], 16);
+        const size_t CountN = std::min<size_t>(Count, 8);
+        std::memcpy(Buffer, Source, CountN * sizeof(float));
+        __m256i Vector = MlasFloatToBFloat16Avx2(_mm256_load_ps(Buffer));
+        __m128i Packed = _mm_packus_epi32(_mm256_castsi256_si128(Vector), _mm256_extracti128_si256(Vector, 1));
+        _mm_store_si128((__m128i*)Result, Packed);
+        std::memcpy(Destination, Result, CountN * sizeof(unsigned short));
+        Source += CountN;
+        Destination += CountN;
+        Count -= CountN;
+    }
+}
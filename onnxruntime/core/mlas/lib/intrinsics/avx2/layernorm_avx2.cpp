@@ -0,0 +1,183 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    layernorm_avx2.cpp
+
+Abstract:
+
+    This module implements the layer normalization kernel with AVX2 and FMA
+    instructions.
+
+--*/
+
+#include "mlasi.h"
+
+MLAS_FORCEINLINE
+float
+MlasReduceAddFloat32x8(
+    __m256 Vector
+    )
+{
+    __m128 Sum = _mm_add_ps(_mm256_castps256_ps128(Vector), _mm256_extractf128_ps(Vector, 1));
+    Sum = _mm_add_ps(Sum, _mm_movehl_ps(Sum, Sum));
+    Sum = _mm_add_ss(Sum, _mm_movehdup_ps(Sum));
+    return _mm_cvtss_f32(Sum);
+}
+
+void
+MLASCALL
+MlasLayerNormF32KernelAvx2(
+    const MLAS_LAYER_NORM_PARAMS* Params,
+    size_t Row,
+    size_t D
+    )
+{
+    const size_t Offset = Row * D;
+    const float* Input = Params->Input + Offset;
+    const float* Skip = (Params->Skip != nullptr) ? Params->Skip + Offset : nullptr;
+    const float* Bias = Params->Bias;
+    float* Output = Params->Output + Offset;
+    float* SumOutput = (Params->SumOutput != nullptr) ? Params->SumOutput + Offset : nullptr;
+
+    const bool HasAddend = (Skip != nullptr || Bias != nullptr);
+
+    __m256 SumVector0 = _mm256_setzero_ps();
+    __m256 SumVector1 = _mm256_setzero_ps();
+    __m256 SumSquareVector0 = _mm256_setzero_ps();
+    __m256 SumSquareVector1 = _mm256_setzero_ps();
+
+    size_t d = 0;
+
+    for (; d + 16 <= D; d += 16) {
+
+        __m256 Vector0 = _mm256_loadu_ps(Input + d);
+        __m256 Vector1 = _mm256_loadu_ps(Input + d + 8);
+
+        if (Skip != nullptr) {
+            Vector0 = _mm256_add_ps(Vector0, _mm256_loadu_ps(Skip + d));
+            Vector1 = _mm256_add_ps(Vector1, _mm256_loadu_ps(Skip + d + 8));
+        }
+
+        if (Bias != nullptr) {
+            Vector0 = _mm256_add_ps(Vector0, _mm256_loadu_ps(Bias + d));
+            Vector1 = _mm256_add_ps(Vector1, _mm256_loadu_ps(Bias + d + 8));
+        }
+
+        if (HasAddend) {
+            _mm256_storeu_ps(Output + d, Vector0);
+            _mm256_storeu_ps(Output + d + 8, Vector1);
+
+            if (SumOutput != nullptr) {
+                _mm256_storeu_ps(SumOutput + d, Vector0);
+                _mm256_storeu_ps(SumOutput + d + 8, Vector1);
+            }
+        }
+
+        SumVector0 = _mm256_add_ps(SumVector0, Vector0);
+        SumVector1 = _mm256_add_ps(SumVector1, Vector1);
+        SumSquareVector0 = _mm256_fmadd_ps(Vector0, Vector0, SumSquareVector0);
+        SumSquareVector1 = _mm256_fmadd_ps(Vector1, Vector1, SumSquareVector1);
+    }
+
+    for (; d + 8 <= D; d += 8) {
+
+        __m256 Vector = _mm256_loadu_ps(Input + d);
+
+        if (Skip != nullptr) {
+            Vector = _mm256_add_ps(Vector, _mm256_loadu_ps(Skip + d));
+        }
+
+        if (Bias != nullptr) {
+            Vector = _mm256_add_ps(Vector, _mm256_loadu_ps(Bias + d));
+        }
+
+        if (HasAddend) {
+            _mm256_storeu_ps(Output + d, Vector);
+
+            if (SumOutput != nullptr) {
+                _mm256_storeu_ps(SumOutput + d, Vector);
+            }
+        }
+
+        SumVector0 = _mm256_add_ps(SumVector0, Vector);
+        SumSquareVector0 = _mm256_fmadd_ps(Vector, Vector, SumSquareVector0);
+    }
+
+    float Sum = MlasReduceAddFloat32x8(_mm256_add_ps(SumVector0, SumVector1));
+    float SumSquare = MlasReduceAddFloat32x8(_mm256_add_ps(SumSquareVector0, SumSquareVector1));
+
+    for (; d < D; d++) {
+
+        float Value = Input[d];
+
+        if (Skip != nullptr) {
+            Value += Skip[d];
+        }
+
+        if (Bias != nullptr) {
+            Value += Bias[d];
+        }
+
+        if (HasAddend) {
+            Output[d] = Value;
+
+            if (SumOutput != nullptr) {
+                SumOutput[d] = Value;
+            }
+        }
+
+        Sum += Value;
+        SumSquare += Value * Value;
+    }
+
+    const float Mean = Params->Simplified ? 0.0f : Sum / float(D);
+    const float Variance = std::max(SumSquare / float(D) - Mean * Mean, 0.0f);
+    const float InvStdDev = 1.0f / std::sqrt(Variance + Params->Epsilon);
+
+    if (Params->Mean != nullptr) {
+        Params->Mean[Row] = Mean;
+    }
+
+    if (Params->InvStdDev != nullptr) {
+        Params->InvStdDev[Row] = InvStdDev;
+    }
+
+    const float* Source = HasAddend ? Output : Input;
+    const float* Scale = Params->Scale;
+    const float* NormBias = Params->NormBias;
+
+    const __m256 MeanVector = _mm256_set1_ps(Mean);
+    const __m256 InvStdDevVector = _mm256_set1_ps(InvStdDev);
+
+    d = 0;
+
+    for (; d + 8 <= D; d += 8) {
+
+        __m256 Vector = _mm256_sub_ps(_mm256_loadu_ps(Source + d), MeanVector);
+        Vector = _mm256_mul_ps(Vector, InvStdDevVector);
+
+        if (NormBias != nullptr) {
+            Vector = _mm256_fmadd_ps(Vector, _mm256_loadu_ps(Scale + d), _mm256_loadu_ps(NormBias + d));
+        } else {
+            Vector = _mm256_mul_ps(Vector, _mm256_loadu_ps(Scale + d));
+        }
+
+        _mm256_storeu_ps(Output + d, Vector);
+    }
+
+    for (; d < D; d++) {
+
+        float Value = (Source[d] - Mean) * InvStdDev * Scale[d];
+
+        if (NormBias != nullptr) {
+            Value += NormBias[d];
+        }
+
+        Output[d] = Value;
+    }
+}
@@ -0,0 +1,141 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    q4gemm_avx2.cpp
+
+Abstract:
+
+    This module implements the fused dequantize and dot product kernels for
+    fp32 activations and blockwise int4 quantized weights using AVX2 and FMA3
+    instructions.
+
+--*/
+
+#include "../../q4gemm.h"
+
+MLAS_FORCEINLINE
+float
+MlasReduceAddFloat32x8(
+    __m256 Vector
+    )
+{
+    __m128 Sum = _mm_add_ps(_mm256_castps256_ps128(Vector), _mm256_extractf128_ps(Vector, 1));
+    Sum = _mm_add_ps(Sum, _mm_movehl_ps(Sum, Sum));
+    Sum = _mm_add_ss(Sum, _mm_movehdup_ps(Sum));
+    return _mm_cvtss_f32(Sum);
+}
+
+template <MLAS_BLK_QUANT_TYPE QType, size_t NCols>
+MLAS_FORCEINLINE
+void
+MlasQ4GemvColumnsAvx2(
+    const float* A,
+    const uint8_t* PackedB,
+    size_t ColumnStride,
+    const float* Bias,
+    float* C,
+    size_t CountK
+    )
+{
+    const MLAS_Q4_BLK_LAYOUT Layout = MlasQ4GetBlkLayout(QType);
+    const size_t BlkLen = Layout.BlkLen;
+    const size_t Half = BlkLen / 2;
+
+    const __m128i LowMask = _mm_set1_epi8(0x0F);
+
+    __m256 Acc[NCols];
+    for (size_t c = 0; c < NCols; c++) {
+        Acc[c] = _mm256_setzero_ps();
+    }
+
+    size_t k = 0;
+    const uint8_t* b = PackedB;
+
+    for (; k + BlkLen <= CountK; k += BlkLen) {
+        for (size_t c = 0; c < NCols; c++) {
+            const uint8_t* Blk = b + ColumnStride * c;
+            const __m256 Scale = _mm256_set1_ps(MlasQ4BlkScale(Blk));
+            const __m256 ZeroPoint = _mm256_set1_ps(float(MlasQ4BlkZeroPoint(Blk, Layout.HasZeroPoint)));
+            const uint8_t* Data = Blk + Layout.DataOffset();
+
+            __m256 BlkAcc0 = _mm256_setzero_ps();
+            __m256 BlkAcc1 = _mm256_setzero_ps();
+
+            for (size_t j = 0; j < Half; j += 16) {
+                const __m128i Bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Data + j));
+                const __m128i Lo = _mm_and_si128(Bytes, LowMask);
+                const __m128i Hi = _mm_and_si128(_mm_srli_epi16(Bytes, 4), LowMask);
+
+                const __m256 Lo0 = _mm256_sub_ps(_mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(Lo)), ZeroPoint);
+                const __m256 Lo1 = _mm256_sub_ps(_mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_srli_si128(Lo, 8))), ZeroPoint);
+                const __m256 Hi0 = _mm256_sub_ps(_mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(Hi)), ZeroPoint);
+                const __m256 Hi1 = _mm256_sub_ps(_mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_srli_si128(Hi, 8))), ZeroPoint);
+
+                BlkAcc0 = _mm256_fmadd_ps(Lo0, _mm256_loadu_ps(A + k + j), BlkAcc0);
+                BlkAcc1 = _mm256_fmadd_ps(Lo1, _mm256_loadu_ps(A + k + j + 8), BlkAcc1);
+                BlkAcc0 = _mm256_fmadd_ps(Hi0, _mm256_loadu_ps(A + k + Half + j), BlkAcc0);
+                BlkAcc1 = _mm256_fmadd_ps(Hi1, _mm256_loadu_ps(A + k + Half + j + 8), BlkAcc1);
+            }
+
+            Acc[c] = _mm256_fmadd_ps(_mm256_add_ps(BlkAcc0, BlkAcc1), Scale, Acc[c]);
+        }
+
+        b += Layout.BlkSize();
+    }
+
+    for (size_t c = 0; c < NCols; c++) {
+        float Sum = MlasReduceAddFloat32x8(Acc[c]);
+        if (k < CountK) {
+            Sum += MlasQ4BlkDotScalar(A + k, b + ColumnStride * c, Layout, CountK - k);
+        }
+        if (Bias != nullptr) {
+            Sum += Bias[c];
+        }
+        C[c] = Sum;
+    }
+}
+
+template <MLAS_BLK_QUANT_TYPE QType>
+void
+MLASCALL
+MlasQ4GemvKernelAvx2(
+    const float* A,
+    const uint8_t* PackedB,
+    const float* Bias,
+    float* C,
+    size_t CountN,
+    size_t CountK
+    )
+{
+    const MLAS_Q4_BLK_LAYOUT Layout = MlasQ4GetBlkLayout(QType);
+    const size_t ColumnStride = MlasDivRoundup(CountK, Layout.BlkLen) * Layout.BlkSize();
+
+    //
+    // Process four columns at a time to hide the latency of the FMA chains
+    // and to reuse each load of A.
+    //
+
+    size_t n = 0;
+    for (; n + 4 <= CountN; n += 4) {
+        MlasQ4GemvColumnsAvx2<QType, 4>(A, PackedB + ColumnStride * n, ColumnStride,
+                                        (Bias != nullptr) ? Bias + n : nullptr, C + n, CountK);
+    }
+    for (; n < CountN; n++) {
+        MlasQ4GemvColumnsAvx2<QType, 1>(A, PackedB + ColumnStride * n, ColumnStride,
+                                        (Bias != nullptr) ? Bias + n : nullptr, C + n, CountK);
+    }
+}
+
+const MLAS_Q4GEMM_DISPATCH MlasQ4GemmDispatchAvx2 = {
+    {
+        MlasQ4GemvKernelAvx2<BlkQ4Sym>,
+        MlasQ4GemvKernelAvx2<BlkQ4Zp8>,
+        MlasQ4GemvKernelAvx2<BlkQ4Sym64>,
+        MlasQ4GemvKernelAvx2<BlkQ4Sym128>,
+    }
+};
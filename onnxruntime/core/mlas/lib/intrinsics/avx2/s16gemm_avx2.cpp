@@ -0,0 +1,124 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    s16gemm_avx2.cpp
+
+Abstract:
+
+    This module implements the kernel of the int16 matrix/matrix multiply
+    operation (S16GEMM) with AVX2 instructions.
+
+    A pair of A is broadcast and multiplied with the interleaved pairs of a
+    packed panel of B with VPMADDWD, which sums each pair of products to an
+    int32 lane.
+
+--*/
+
+#include "../../s16gemm.h"
+
+template<size_t RowCount>
+MLAS_FORCEINLINE
+void
+MlasGemmS16KernelAvx2Rows(
+    const int16_t* A,
+    const int16_t* PackedB,
+    int32_t* C,
+    size_t CountK,
+    size_t CountN,
+    size_t lda,
+    size_t ldc,
+    bool ZeroMode
+    )
+{
+    const size_t PackedCountK = (CountK + 1) / 2;
+
+    while (CountN > 0) {
+
+        __m256i Accumulators[RowCount][2];
+
+        for (size_t m = 0; m < RowCount; m++) {
+            Accumulators[m][0] = _mm256_setzero_si256();
+            Accumulators[m][1] = _mm256_setzero_si256();
+        }
+
+        const int16_t* b = PackedB;
+
+        for (size_t k = 0; k < CountK; k += 2) {
+
+            const __m256i BElements0 = _mm256_load_si256((const __m256i*)b);
+            const __m256i BElements1 = _mm256_load_si256((const __m256i*)(b + 16));
+
+            for (size_t m = 0; m < RowCount; m++) {
+                const __m256i APair = _mm256_set1_epi32(MlasGemmS16LoadPairA(A + m * lda + k, CountK - k));
+                Accumulators[m][0] = _mm256_add_epi32(Accumulators[m][0], _mm256_madd_epi16(APair, BElements0));
+                Accumulators[m][1] = _mm256_add_epi32(Accumulators[m][1], _mm256_madd_epi16(APair, BElements1));
+            }
+
+            b += MLAS_GEMM_S16_PANEL_N * 2;
+        }
+
+        for (size_t m = 0; m < RowCount; m++) {
+
+            int32_t* c = C + m * ldc;
+
+            if (CountN >= MLAS_GEMM_S16_PANEL_N) {
+
+                if (!ZeroMode) {
+                    Accumulators[m][0] = _mm256_add_epi32(Accumulators[m][0], _mm256_loadu_si256((const __m256i*)c));
+                    Accumulators[m][1] = _mm256_add_epi32(Accumulators[m][1], _mm256_loadu_si256((const __m256i*)(c + 8)));
+                }
+
+                _mm256_storeu_si256((__m256i*)c, Accumulators[m][0]);
+                _mm256_storeu_si256((__m256i*)(c + 8), Accumulators[m][1]);
+
+            } else {
+
+                MLAS_DECLSPEC_ALIGN(int32_t Values[MLAS_GEMM_S16_PANEL_N], 32);
+
+                _mm256_store_si256((__m256i*)Values, Accumulators[m][0]);
+                _mm256_store_si256((__m256i*)(Values + 8), Accumulators[m][1]);
+
+                for (size_t n = 0; n < CountN; n++) {
+                    c[n] = ZeroMode ? Values[n] : c[n] + Values[n];
+                }
+            }
+        }
+
+        PackedB += PackedCountK * MLAS_GEMM_S16_PANEL_N * 2;
+        C += MLAS_GEMM_S16_PANEL_N;
+        CountN -= std::min(CountN, size_t(MLAS_GEMM_S16_PANEL_N));
+    }
+}
+
+size_t
+MLASCALL
+MlasGemmS16KernelAvx2(
+    const int16_t* A,
+    const int16_t* PackedB,
+    int32_t* C,
+    size_t CountK,
+    size_t CountM,
+    size_t CountN,
+    size_t lda,
+    size_t ldc,
+    bool ZeroMode
+    )
+{
+    if (CountM >= 4) {
+        MlasGemmS16KernelAvx2Rows<4>(A, PackedB, C, CountK, CountN, lda, ldc, ZeroMode);
+        return 4;
+    }
+
+    if (CountM >= 2) {
+        MlasGemmS16KernelAvx2Rows<2>(A, PackedB, C, CountK, CountN, lda, ldc, ZeroMode);
+        return 2;
+    }
+
+    MlasGemmS16KernelAvx2Rows<1>(A, PackedB, C, CountK, CountN, lda, ldc, ZeroMode);
+    return 1;
+}
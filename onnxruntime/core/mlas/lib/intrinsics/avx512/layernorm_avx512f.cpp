@@ -0,0 +1,148 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    layernorm_avx512f.cpp
+
+Abstract:
+
+    This module implements the layer normalization kernel with AVX512F
+    instructions. The remainder of a row is handled with masked loads and
+    stores.
+
+--*/
+
+#include "mlasi.h"
+
+void
+MLASCALL
+MlasLayerNormF32KernelAvx512F(
+    const MLAS_LAYER_NORM_PARAMS* Params,
+    size_t Row,
+    size_t D
+    )
+{
+    const size_t Offset = Row * D;
+    const float* Input = Params->Input + Offset;
+    const float* Skip = (Params->Skip != nullptr) ? Params->Skip + Offset : nullptr;
+    const float* Bias = Params->Bias;
+    float* Output = Params->Output + Offset;
+    float* SumOutput = (Params->SumOutput != nullptr) ? Params->SumOutput + Offset : nullptr;
+
+    const bool HasAddend = (Skip != nullptr || Bias != nullptr);
+
+    __m512 SumVector0 = _mm512_setzero_ps();
+    __m512 SumVector1 = _mm512_setzero_ps();
+    __m512 SumSquareVector0 = _mm512_setzero_ps();
+    __m512 SumSquareVector1 = _mm512_setzero_ps();
+
+    size_t d = 0;
+
+    for (; d + 32 <= D; d += 32) {
+
+        __m512 Vector0 = _mm512_loadu_ps(Input + d);
+        __m512 Vector1 = _mm512_loadu_ps(Input + d + 16);
+
+        if (Skip != nullptr) {
+            Vector0 = _mm512_add_ps(Vector0, _mm512_loadu_ps(Skip + d));
+            Vector1 = _mm512_add_ps(Vector1, _mm512_loadu_ps(Skip + d + 16));
+        }
+
+        if (Bias != nullptr) {
+            Vector0 = _mm512_add_ps(Vector0, _mm512_loadu_ps(Bias + d));
+            Vector1 = _mm512_add_ps(Vector1, _mm512_loadu_ps(Bias + d + 16));
+        }
+
+        if (HasAddend) {
+            _mm512_storeu_ps(Output + d, Vector0);
+            _mm512_storeu_ps(Output + d + 16, Vector1);
+
+            if (SumOutput != nullptr) {
+                _mm512_storeu_ps(SumOutput + d, Vector0);
+                _mm512_storeu_ps(SumOutput + d + 16, Vector1);
+            }
+        }
+
+        SumVector0 = _mm512_add_ps(SumVector0, Vector0);
+        SumVector1 = _mm512_add_ps(SumVector1, Vector1);
+        SumSquareVector0 = _mm512_fmadd_ps(Vector0, Vector0, SumSquareVector0);
+        SumSquareVector1 = _mm512_fmadd_ps(Vector1, Vector1, SumSquareVector1);
+    }
+
+    while (d < D) {
+
+        const size_t Count = std::min(D - d, size_t(16));
+        const __mmask16 Mask = __mmask16((1u << Count) - 1);
+
+        __m512 Vector = _mm512_maskz_loadu_ps(Mask, Input + d);
+
+        if (Skip != nullptr) {
+            Vector = _mm512_add_ps(Vector, _mm512_maskz_loadu_ps(Mask, Skip + d));
+        }
+
+        if (Bias != nullptr) {
+            Vector = _mm512_add_ps(Vector, _mm512_maskz_loadu_ps(Mask, Bias + d));
+        }
+
+        if (HasAddend) {
+            _mm512_mask_storeu_ps(Output + d, Mask, Vector);
+
+            if (SumOutput != nullptr) {
+                _mm512_mask_storeu_ps(SumOutput + d, Mask, Vector);
+            }
+        }
+
+        SumVector0 = _mm512_add_ps(SumVector0, Vector);
+        SumSquareVector0 = _mm512_fmadd_ps(Vector, Vector, SumSquareVector0);
+
+        d += Count;
+    }
+
+    const float Sum = _mm512_reduce_add_ps(_mm512_add_ps(SumVector0, SumVector1));
+    const float SumSquare = _mm512_reduce_add_ps(_mm512_add_ps(SumSquareVector0, SumSquareVector1));
+
+    const float Mean = Params->Simplified ? 0.0f : Sum / float(D);
+    const float Variance = std::max(SumSquare / float(D) - Mean * Mean, 0.0f);
+    const float InvStdDev = 1.0f / std::sqrt(Variance + Params->Epsilon);
+
+    if (Params->Mean != nullptr) {
+        Params->Mean[Row] = Mean;
+    }
+
+    if (Params->InvStdDev != nullptr) {
+        Params->InvStdDev[Row] = InvStdDev;
+    }
+
+    const float* Source = HasAddend ? Output : Input;
+    const float* Scale = Params->Scale;
+    const float* NormBias = Params->NormBias;
+
+    const __m512 MeanVector = _mm512_set1_ps(Mean);
+    const __m512 InvStdDevVector = _mm512_set1_ps(InvStdDev);
+
+    d = 0;
+
+    while (d < D) {
+
+        const size_t Count = std::min(D - d, size_t(16));
+        const __mmask16 Mask = __mmask16((1u << Count) - 1);
+
+        __m512 Vector = _mm512_sub_ps(_mm512_maskz_loadu_ps(Mask, Source + d), MeanVector);
+        Vector = _mm512_mul_ps(Vector, InvStdDevVector);
+
+        if (NormBias != nullptr) {
+            Vector = _mm512_fmadd_ps(Vector, _mm512_maskz_loadu_ps(Mask, Scale + d),
+                                     _mm512_maskz_loadu_ps(Mask, NormBias + d));
+        } else {
+            Vector = _mm512_mul_ps(Vector, _mm512_maskz_loadu_ps(Mask, Scale + d));
+        }
+
+        _mm512_mask_storeu_ps(Output + d, Mask, Vector);
+
+        d += Count;
+    }
+}
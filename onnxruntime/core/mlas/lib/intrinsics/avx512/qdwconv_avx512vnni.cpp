@@ -0,0 +1,177 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    qdwconv_avx512vnni.cpp
+
+Abstract:
+
+    This module implements the quantized integer depthwise convolution kernels.
+
+    This implementation uses AVX512 VNNI instructions. The zero point adjusted
+    inputs and filters of two kernel elements are interleaved into 16-bit pairs
+    per channel, so VPDPWSSD multiplies and accumulates two kernel elements for
+    16 channels at once.
+
+--*/
+
+#include "mlasi.h"
+
+template<typename T>
+MLAS_FORCEINLINE
+__m256i
+MlasConvDepthwiseLoadVectorAvx512Vnni(
+    const T* Vector,
+    __mmask16 ChannelMask,
+    __m256i ZeroPointVector
+    )
+{
+    __m128i Bytes = _mm_maskz_loadu_epi8(ChannelMask, Vector);
+    __m256i Words;
+
+    if (std::is_signed<T>::value) {
+        Words = _mm256_cvtepi8_epi16(Bytes);
+    } else {
+        Words = _mm256_cvtepu8_epi16(Bytes);
+    }
+
+    return _mm256_sub_epi16(Words, ZeroPointVector);
+}
+
+template<typename InputType, typename FilterType>
+void
+MLASCALL
+MlasConvDepthwiseKernelAvx512Vnni(
+    const InputType* const* Input,
+    InputType InputZeroPoint,
+    const FilterType* Filter,
+    FilterType FilterZeroPoint,
+    int32_t* Output,
+    size_t Channels,
+    size_t OutputCount,
+    size_t KernelSize
+    )
+{
+    const __m256i InputZeroPointVector = _mm256_set1_epi16(InputZeroPoint);
+    const __m256i FilterZeroPointVector = _mm256_set1_epi16(FilterZeroPoint);
+
+    //
+    // Interleave the words of two vectors held in the low halves of the
+    // sources: word i of the first vector goes to word 2*i of the result and
+    // word i of the second vector to word 2*i+1.
+    //
+
+    const __m512i InterleaveIndices = _mm512_set_epi16(
+        47, 15, 46, 14, 45, 13, 44, 12, 43, 11, 42, 10, 41, 9, 40, 8,
+        39, 7, 38, 6, 37, 5, 36, 4, 35, 3, 34, 2, 33, 1, 32, 0);
+
+    while (OutputCount > 0) {
+
+        for (size_t ChannelOffset = 0; ChannelOffset < Channels; ChannelOffset += 16) {
+
+            const size_t ChannelCount = std::min<size_t>(Channels - ChannelOffset, 16);
+            const __mmask16 ChannelMask = __mmask16((uint32_t(1) << ChannelCount) - 1);
+
+            __m512i Accumulator = _mm512_setzero_si512();
+            const FilterType* filter = Filter + ChannelOffset;
+
+            for (size_t k = 0; k < KernelSize; k += 2) {
+
+                __m256i InputVector0 = MlasConvDepthwiseLoadVectorAvx512Vnni(
+                    &Input[k][ChannelOffset], ChannelMask, InputZeroPointVector);
+                __m256i FilterVector0 = MlasConvDepthwiseLoadVectorAvx512Vnni(
+                    filter, ChannelMask, FilterZeroPointVector);
+
+                //
+                // An odd kernel size pairs the last element with zeros.
+                //
+
+                __m256i InputVector1 = _mm256_setzero_si256();
+                __m256i FilterVector1 = _mm256_setzero_si256();
+
+                if (k + 1 < KernelSize) {
+                    InputVector1 = MlasConvDepthwiseLoadVectorAvx512Vnni(
+                        &Input[k + 1][ChannelOffset], ChannelMask, InputZeroPointVector);
+                    FilterVector1 = MlasConvDepthwiseLoadVectorAvx512Vnni(
+                        filter + Channels, ChannelMask, FilterZeroPointVector);
+                }
+
+                __m512i InputPairs = _mm512_permutex2var_epi16(
+                    _mm512_castsi256_si512(InputVector0), InterleaveIndices,
+                    _mm512_castsi256_si512(InputVector1));
+                __m512i FilterPairs = _mm512_permutex2var_epi16(
+                    _mm512_castsi256_si512(FilterVector0), InterleaveIndices,
+                    _mm512_castsi256_si512(FilterVector1));
+
+                Accumulator = _mm512_dpwssd_epi32(Accumulator, InputPairs, FilterPairs);
+                filter += 2 * Channels;
+            }
+
+            _mm512_mask_storeu_epi32(Output, ChannelMask, Accumulator);
+            Output += ChannelCount;
+        }
+
+        Input += KernelSize;
+        OutputCount -= 1;
+    }
+}
+
+template
+void
+MLASCALL
+MlasConvDepthwiseKernelAvx512Vnni<uint8_t, int8_t>(
+    const uint8_t* const* Input,
+    uint8_t InputZeroPoint,
+    const int8_t* Filter,
+    int8_t FilterZeroPoint,
+    int32_t* Output,
+    size_t Channels,
+    size_t OutputCount,
+    size_t KernelSize
+    );
+
+template
+void
+MLASCALL
+MlasConvDepthwiseKernelAvx512Vnni<uint8_t, uint8_t>(
+    const uint8_t* const* Input,
+    uint8_t InputZeroPoint,
+    const uint8_t* Filter,
+    uint8_t FilterZeroPoint,
+    int32_t* Output,
+    size_t Channels,
+    size_t OutputCount,
+    size_t KernelSize
+    );
+
+template
+void
+MLASCALL
+MlasConvDepthwiseKernelAvx512Vnni<int8_t, int8_t>(
+    const int8_t* const* Input,
+    int8_t InputZeroPoint,
+    const int8_t* Filter,
+    int8_t FilterZeroPoint,
+    int32_t* Output,
+    size_t Channels,
+    size_t OutputCount,
+    size_t KernelSize
+    );
+
+template
+void
+MLASCALL
+MlasConvDepthwiseKernelAvx512Vnni<int8_t, uint8_t>(
+    const int8_t* const* Input,
+    int8_t InputZeroPoint,
+    const uint8_t* Filter,
+    uint8_t FilterZeroPoint,
+    int32_t* Output,
+    size_t Channels,
+    size_t OutputCount,
+    size_t KernelSize
+    );
@@ -0,0 +1,147 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    s16gemm_avx512.cpp
+
+Abstract:
+
+    This module implements the kernels of the int16 matrix/matrix multiply
+    operation (S16GEMM) with AVX512 core and AVX512 VNNI instructions.
+
+    A packed panel of B is a single 512-bit vector per pair of rows. The
+    AVX512 core kernel multiplies and sums the pairs with VPMADDWD and adds
+    them to the accumulators, and the VNNI kernel does both with VPDPWSSD.
+
+--*/
+
+#include "../../s16gemm.h"
+
+template<size_t RowCount, bool Vnni>
+MLAS_FORCEINLINE
+void
+MlasGemmS16KernelAvx512Rows(
+    const int16_t* A,
+    const int16_t* PackedB,
+    int32_t* C,
+    size_t CountK,
+    size_t CountN,
+    size_t lda,
+    size_t ldc,
+    bool ZeroMode
+    )
+{
+    const size_t PackedCountK = (CountK + 1) / 2;
+
+    while (CountN > 0) {
+
+        __m512i Accumulators[RowCount];
+
+        for (size_t m = 0; m < RowCount; m++) {
+            Accumulators[m] = _mm512_setzero_si512();
+        }
+
+        const int16_t* b = PackedB;
+
+        for (size_t k = 0; k < CountK; k += 2) {
+
+            const __m512i BElements = _mm512_load_si512((const __m512i*)b);
+
+            for (size_t m = 0; m < RowCount; m++) {
+                const __m512i APair = _mm512_set1_epi32(MlasGemmS16LoadPairA(A + m * lda + k, CountK - k));
+                if constexpr (Vnni) {
+                    Accumulators[m] = _mm512_dpwssd_epi32(Accumulators[m], APair, BElements);
+                } else {
+                    Accumulators[m] = _mm512_add_epi32(Accumulators[m], _mm512_madd_epi16(APair, BElements));
+                }
+            }
+
+            b += MLAS_GEMM_S16_PANEL_N * 2;
+        }
+
+        const __mmask16 StoreMask = (CountN >= MLAS_GEMM_S16_PANEL_N) ?
+            __mmask16(0xFFFF) : __mmask16((1u << CountN) - 1);
+
+        for (size_t m = 0; m < RowCount; m++) {
+
+            int32_t* c = C + m * ldc;
+
+            if (!ZeroMode) {
+                Accumulators[m] = _mm512_add_epi32(Accumulators[m], _mm512_maskz_loadu_epi32(StoreMask, c));
+            }
+
+            _mm512_mask_storeu_epi32(c, StoreMask, Accumulators[m]);
+        }
+
+        PackedB += PackedCountK * MLAS_GEMM_S16_PANEL_N * 2;
+        C += MLAS_GEMM_S16_PANEL_N;
+        CountN -= std::min(CountN, size_t(MLAS_GEMM_S16_PANEL_N));
+    }
+}
+
+template<bool Vnni>
+MLAS_FORCEINLINE
+size_t
+MlasGemmS16KernelAvx512(
+    const int16_t* A,
+    const int16_t* PackedB,
+    int32_t* C,
+    size_t CountK,
+    size_t CountM,
+    size_t CountN,
+    size_t lda,
+    size_t ldc,
+    bool ZeroMode
+    )
+{
+    if (CountM >= 4) {
+        MlasGemmS16KernelAvx512Rows<4, Vnni>(A, PackedB, C, CountK, CountN, lda, ldc, ZeroMode);
+        return 4;
+    }
+
+    if (CountM >= 2) {
+        MlasGemmS16KernelAvx512Rows<2, Vnni>(A, PackedB, C, CountK, CountN, lda, ldc, ZeroMode);
+        return 2;
+    }
+
+    MlasGemmS16KernelAvx512Rows<1, Vnni>(A, PackedB, C, CountK, CountN, lda, ldc, ZeroMode);
+    return 1;
+}
+
+size_t
+MLASCALL
+MlasGemmS16KernelAvx512Core(
+    const int16_t* A,
+    const int16_t* PackedB,
+    int32_t* C,
+    size_t CountK,
+    size_t CountM,
+    size_t CountN,
+    size_t lda,
+    size_t ldc,
+    bool ZeroMode
+    )
+{
+    return MlasGemmS16KernelAvx512<false>(A, PackedB, C, CountK, CountM, CountN, lda, ldc, ZeroMode);
+}
+
+size_t
+MLASCALL
+MlasGemmS16KernelAvx512Vnni(
+    const int16_t* A,
+    const int16_t* PackedB,
+    int32_t* C,
+    size_t CountK,
+    size_t CountM,
+    size_t CountN,
+    size_t lda,
+    size_t ldc,
+    bool ZeroMode
+    )
+{
+    return MlasGemmS16KernelAvx512<true>(A, PackedB, C, CountK, CountM, CountN, lda, ldc, ZeroMode);
+}
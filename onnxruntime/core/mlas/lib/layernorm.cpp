@@ -0,0 +1,292 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    layernorm.cpp
+
+Abstract:
+
+    This module implements routines to compute layer normalization and RMS
+    normalization, with an optional residual and bias added to the input
+    ahead of the normalization (skip layer normalization).
+
+    The row statistics are accumulated in the same pass that forms the sum of
+    the input, residual and bias, and the normalized row is written in a
+    second pass.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Structure to pass the layer normalization parameters to worker threads.
+//
+
+struct MLAS_LAYER_NORM_WORK_BLOCK {
+    ptrdiff_t ThreadCountN;
+    const MLAS_LAYER_NORM_PARAMS* Params;
+    size_t N;
+    size_t D;
+};
+
+void
+MLASCALL
+MlasLayerNormF32Kernel(
+    const MLAS_LAYER_NORM_PARAMS* Params,
+    size_t Row,
+    size_t D
+    )
+/*++
+
+Routine Description:
+
+    This routine normalizes a single row.
+
+Arguments:
+
+    Params - Supplies the buffers and options.
+
+    Row - Supplies the index of the row to normalize.
+
+    D - Supplies the number of elements per row.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t Offset = Row * D;
+    const float* Input = Params->Input + Offset;
+    const float* Skip = (Params->Skip != nullptr) ? Params->Skip + Offset : nullptr;
+    const float* Bias = Params->Bias;
+    float* Output = Params->Output + Offset;
+    float* SumOutput = (Params->SumOutput != nullptr) ? Params->SumOutput + Offset : nullptr;
+
+    //
+    // Form the sum of the input, residual and bias in the output buffer and
+    // accumulate the row statistics.
+    //
+
+    const bool HasAddend = (Skip != nullptr || Bias != nullptr);
+
+    MLAS_FLOAT32X4 SumVector = MlasZeroFloat32x4();
+    MLAS_FLOAT32X4 SumSquareVector = MlasZeroFloat32x4();
+
+    size_t d = 0;
+
+    for (; d + 4 <= D; d += 4) {
+
+        MLAS_FLOAT32X4 Vector = MlasLoadFloat32x4(Input + d);
+
+        if (Skip != nullptr) {
+            Vector = MlasAddFloat32x4(Vector, MlasLoadFloat32x4(Skip + d));
+        }
+
+        if (Bias != nullptr) {
+            Vector = MlasAddFloat32x4(Vector, MlasLoadFloat32x4(Bias + d));
+        }
+
+        if (HasAddend) {
+            MlasStoreFloat32x4(Output + d, Vector);
+
+            if (SumOutput != nullptr) {
+                MlasStoreFloat32x4(SumOutput + d, Vector);
+            }
+        }
+
+        SumVector = MlasAddFloat32x4(SumVector, Vector);
+        SumSquareVector = MlasMultiplyAddFloat32x4(Vector, Vector, SumSquareVector);
+    }
+
+    float Sum = MlasReduceAddFloat32x4(SumVector);
+    float SumSquare = MlasReduceAddFloat32x4(SumSquareVector);
+
+    for (; d < D; d++) {
+
+        float Value = Input[d];
+
+        if (Skip != nullptr) {
+            Value += Skip[d];
+        }
+
+        if (Bias != nullptr) {
+            Value += Bias[d];
+        }
+
+        if (HasAddend) {
+            Output[d] = Value;
+
+            if (SumOutput != nullptr) {
+                SumOutput[d] = Value;
+            }
+        }
+
+        Sum += Value;
+        SumSquare += Value * Value;
+    }
+
+    const float Mean = Params->Simplified ? 0.0f : Sum / float(D);
+    const float Variance = std::max(SumSquare / float(D) - Mean * Mean, 0.0f);
+    const float InvStdDev = 1.0f / std::sqrt(Variance + Params->Epsilon);
+
+    if (Params->Mean != nullptr) {
+        Params->Mean[Row] = Mean;
+    }
+
+    if (Params->InvStdDev != nullptr) {
+        Params->InvStdDev[Row] = InvStdDev;
+    }
+
+    //
+    // Normalize the row: Output = (Value - Mean) * InvStdDev * Scale + NormBias.
+    //
+
+    const float* Source = HasAddend ? Output : Input;
+    const float* Scale = Params->Scale;
+    const float* NormBias = Params->NormBias;
+
+    const MLAS_FLOAT32X4 MeanVector = MlasBroadcastFloat32x4(Mean);
+    const MLAS_FLOAT32X4 InvStdDevVector = MlasBroadcastFloat32x4(InvStdDev);
+
+    d = 0;
+
+    for (; d + 4 <= D; d += 4) {
+
+        MLAS_FLOAT32X4 Vector = MlasSubtractFloat32x4(MlasLoadFloat32x4(Source + d), MeanVector);
+        Vector = MlasMultiplyFloat32x4(Vector, InvStdDevVector);
+
+        if (NormBias != nullptr) {
+            Vector = MlasMultiplyAddFloat32x4(Vector, MlasLoadFloat32x4(Scale + d), MlasLoadFloat32x4(NormBias + d));
+        } else {
+            Vector = MlasMultiplyFloat32x4(Vector, MlasLoadFloat32x4(Scale + d));
+        }
+
+        MlasStoreFloat32x4(Output + d, Vector);
+    }
+
+    for (; d < D; d++) {
+
+        float Value = (Source[d] - Mean) * InvStdDev * Scale[d];
+
+        if (NormBias != nullptr) {
+            Value += NormBias[d];
+        }
+
+        Output[d] = Value;
+    }
+}
+
+void
+MlasComputeLayerNormThreaded(
+    void* Context,
+    ptrdiff_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of a
+    layer normalization operation.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    Index - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const auto* WorkBlock = (MLAS_LAYER_NORM_WORK_BLOCK*)Context;
+
+    size_t n;
+    size_t CountN;
+
+    MlasPartitionWork(Index, WorkBlock->ThreadCountN, WorkBlock->N, &n, &CountN);
+
+#if defined(MLAS_TARGET_AMD64)
+    MLAS_LAYER_NORM_FLOAT_KERNEL* Kernel = GetMlasPlatform().LayerNormF32Kernel;
+#else
+    MLAS_LAYER_NORM_FLOAT_KERNEL* Kernel = MlasLayerNormF32Kernel;
+#endif
+
+    for (size_t Row = n; Row < n + CountN; Row++) {
+        Kernel(WorkBlock->Params, Row, WorkBlock->D);
+    }
+}
+
+void
+MLASCALL
+MlasComputeLayerNorm(
+    const MLAS_LAYER_NORM_PARAMS* Params,
+    size_t N,
+    size_t D,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine computes layer normalization or RMS normalization of a set
+    of rows.
+
+    N.B. This implementation supports in place updates of the output buffer.
+
+Arguments:
+
+    Params - Supplies the buffers and options.
+
+    N - Supplies the number of rows to process.
+
+    D - Supplies the number of elements per row.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (N == 0 || D == 0) {
+        return;
+    }
+
+    MLAS_LAYER_NORM_WORK_BLOCK WorkBlock;
+
+    WorkBlock.Params = Params;
+    WorkBlock.N = N;
+    WorkBlock.D = D;
+
+    //
+    // Compute the number of target threads given the complexity of the
+    // operation, as done for softmax.
+    //
+
+    ptrdiff_t ThreadCountN = MlasGetMaximumThreadCount(ThreadPool);
+
+    if (size_t(ThreadCountN) > N) {
+        ThreadCountN = ptrdiff_t(N);
+    }
+
+    constexpr size_t MinimumElementsPerThread = 16384;
+
+    size_t BlockCount = ((N * D) / MinimumElementsPerThread) + 1;
+
+    if (size_t(ThreadCountN) > BlockCount) {
+        ThreadCountN = ptrdiff_t(BlockCount);
+    }
+
+    WorkBlock.ThreadCountN = ThreadCountN;
+
+    MlasExecuteThreaded(MlasComputeLayerNormThreaded, &WorkBlock, ThreadCountN, ThreadPool);
+}
@@ -574,6 +574,44 @@ void
     size_t N
     );
 
+typedef
+void
+(MLASCALL MLAS_LAYER_NORM_FLOAT_KERNEL)(
+    const MLAS_LAYER_NORM_PARAMS* Params,
+    size_t Row,
+    size_t D
+    );
+
+typedef
+void
+(MLASCALL MLAS_CAST_TO_F32_KERNEL)(
+    const unsigned short* Source,
+    float* Destination,
+    size_t Count
+    );
+
+typedef
+void
+(MLASCALL MLAS_CAST_FROM_F32_KERNEL)(
+    const float* Source,
+    unsigned short* Destination,
+    size_t Count
+    );
+
+typedef
+size_t
+(MLASCALL MLAS_GEMM_S16_KERNEL)(
+    const int16_t* A,
+    const int16_t* PackedB,
+    int32_t* C,
+    size_t CountK,
+    size_t CountM,
+    size_t CountN,
+    size_t lda,
+    size_t ldc,
+    bool ZeroMode
+    );
+
 typedef
 void
 (MLASCALL MLAS_QLINEAR_BINARY_OP_S8_KERNEL)(
@@ -765,6 +803,33 @@ extern "C" {
     MLAS_REDUCE_MINIMUM_MAXIMUM_FLOAT_KERNEL MlasReduceMinimumMaximumF32KernelAvx;
 #endif
 
+    MLAS_LAYER_NORM_FLOAT_KERNEL MlasLayerNormF32Kernel;
+#if defined(MLAS_TARGET_AMD64)
+    MLAS_LAYER_NORM_FLOAT_KERNEL MlasLayerNormF32KernelAvx2;
+    MLAS_LAYER_NORM_FLOAT_KERNEL MlasLayerNormF32KernelAvx512F;
+#endif
+
+    MLAS_CAST_TO_F32_KERNEL MlasCastF16ToF32Kernel;
+    MLAS_CAST_FROM_F32_KERNEL MlasCastF32ToF16Kernel;
+    MLAS_CAST_TO_F32_KERNEL MlasCastBF16ToF32Kernel;
+    MLAS_CAST_FROM_F32_KERNEL MlasCastF32ToBF16Kernel;
+#if defined(MLAS_TARGET_AMD64)
+#if defined(_WIN32)
+    MLAS_CAST_TO_F32_KERNEL MlasCastF16ToF32KernelSse;
+#endif
+    MLAS_CAST_TO_F32_KERNEL MlasCastF16ToF32KernelAvx2;
+    MLAS_CAST_FROM_F32_KERNEL MlasCastF32ToF16KernelAvx2;
+    MLAS_CAST_TO_F32_KERNEL MlasCastBF16ToF32KernelAvx2;
+    MLAS_CAST_FROM_F32_KERNEL MlasCastF32ToBF16KernelAvx2;
+#endif
+
+    MLAS_GEMM_S16_KERNEL MlasGemmS16Kernel;
+#if defined(MLAS_TARGET_AMD64)
+    MLAS_GEMM_S16_KERNEL MlasGemmS16KernelAvx2;
+    MLAS_GEMM_S16_KERNEL MlasGemmS16KernelAvx512Core;
+    MLAS_GEMM_S16_KERNEL MlasGemmS16KernelAvx512Vnni;
+#endif
+
 }
 
 //
@@ -793,12 +858,63 @@ extern "C" {
 #define MLAS_DGEMM_THREAD_COMPLEXITY                (size_t(64) * size_t(1024))
 #define MLAS_QGEMM_THREAD_COMPLEXITY                65536
 
+//
+// Define the maximum complexity of a single precision matrix/matrix multiply
+// that is computed without packing matrix B.
+//
+
+#define MLAS_SGEMM_SMALL_COMPLEXITY                 512
+
 //
 // Single-threaded single precision matrix/matrix multiply operation.
 //
 
 void
 MlasSgemmOperation(
+    CBLAS_TRANSPOSE TransA,
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const float* A,
+    size_t lda,
+    const float* B,
+    size_t ldb,
+    float beta,
+    float* C,
+    size_t ldc,
+    const MLAS_SGEMM_EPILOGUE* Epilogue = nullptr
+    );
+
+void
+MlasSgemmMultiplyBeta(
+    float* C,
+    size_t CountM,
+    size_t CountN,
+    size_t ldc,
+    float beta
+    );
+
+void
+MlasSgemmApplyEpilogue(
+    const MLAS_SGEMM_EPILOGUE* Epilogue,
+    size_t StartM,
+    size_t StartN,
+    float* C,
+    size_t CountM,
+    size_t CountN,
+    size_t ldc
+    );
+
+//
+// Single-threaded single precision matrix/matrix multiply operation computed
+// with bfloat16 inputs. Only supported when MlasBf16AccelerationSupported()
+// returns true.
+//
+
+void
+MlasSBGemmOperation(
     CBLAS_TRANSPOSE TransA,
     CBLAS_TRANSPOSE TransB,
     size_t M,
@@ -831,6 +947,8 @@ extern const MLAS_GEMM_QUANT_DISPATCH MlasGemmU8X8DispatchNeon;
 extern const MLAS_GEMM_QUANT_DISPATCH MlasGemmX8S8DispatchNeon;
 extern const MLAS_GEMM_QUANT_DISPATCH MlasGemmU8X8DispatchUdot;
 extern const MLAS_GEMM_QUANT_DISPATCH MlasGemmS8S8DispatchSdot;
+extern const MLAS_GEMM_QUANT_DISPATCH MlasGemmU8X8DispatchUmmla;
+extern const MLAS_GEMM_QUANT_DISPATCH MlasGemmS8S8DispatchSmmla;
 extern const MLAS_GEMM_QUANT_DISPATCH MlasGemmU8X8DispatchWasmSimd;
 extern const MLAS_GEMM_QUANT_DISPATCH MlasGemmQuantDispatchDefault;
 extern const MLAS_GEMM_QUANT_DISPATCH MlasGemm8X8DispatchPOWER10;
@@ -852,11 +970,31 @@ extern const MLAS_CONV_SYM_DISPATCH MlasConvSymDispatchAvx2;
 extern const MLAS_CONV_SYM_DISPATCH MlasConvSymDispatchAvxVnni;
 extern const MLAS_CONV_SYM_DISPATCH MlasConvSymDispatchAvx512Core;
 extern const MLAS_CONV_SYM_DISPATCH MlasConvSymDispatchAvx512Vnni;
+extern const MLAS_CONV_SYM_DISPATCH MlasConvSymDispatchAmx;
 extern const MLAS_CONV_SYM_DISPATCH MlasConvSymU8DispatchNeon;
 extern const MLAS_CONV_SYM_DISPATCH MlasConvSymS8DispatchNeon;
 extern const MLAS_CONV_SYM_DISPATCH MlasConvSymU8DispatchDot;
 extern const MLAS_CONV_SYM_DISPATCH MlasConvSymS8DispatchDot;
 
+//
+// Blockwise int4 quantized weight gemm dispatch structure.
+//
+
+struct MLAS_Q4GEMM_DISPATCH;
+
+extern const MLAS_Q4GEMM_DISPATCH MlasQ4GemmDispatchAvx2;
+extern const MLAS_Q4GEMM_DISPATCH MlasQ4GemmDispatchAvx512;
+extern const MLAS_Q4GEMM_DISPATCH MlasQ4GemmDispatchNeon;
+
+//
+// Single precision gemm with bfloat16 inputs dispatch structure.
+//
+
+struct MLAS_SBGEMM_DISPATCH;
+
+extern const MLAS_SBGEMM_DISPATCH MlasSBGemmDispatchAvx512Bf16;
+extern const MLAS_SBGEMM_DISPATCH MlasSBGemmDispatchAmx;
+
 //
 // Quantized depthwise convolution kernels.
 //
@@ -889,6 +1027,20 @@ MlasConvDepthwiseKernelAvx2(
     size_t KernelSize
     );
 
+template <typename InputType, typename FilterType>
+void
+MLASCALL
+MlasConvDepthwiseKernelAvx512Vnni(
+    const InputType* const* Input,
+    InputType InputZeroPoint,
+    const FilterType* Filter,
+    FilterType FilterZeroPoint,
+    int32_t* Output,
+    size_t Channels,
+    size_t OutputCount,
+    size_t KernelSize
+    );
+
 //
 // Define the kernel flags for conv sym
 //
@@ -917,7 +1069,11 @@ enum MlasCoreType { mlas_core_unknown = 0, mlas_core_little = 2, mlas_core_big =
 
 struct MLAS_PLATFORM {
 
+#if defined(MLAS_TARGET_AMD64_IX86)
+    MLAS_PLATFORM(MLAS_ISA_LEVEL MaximumIsaLevel = MlasIsaLevelAmx);
+#else
     MLAS_PLATFORM(void);
+#endif
 
 #if defined(MLAS_TARGET_AMD64_IX86) || defined(MLAS_TARGET_POWER)
     MLAS_GEMM_FLOAT_KERNEL* GemmFloatKernel;
@@ -936,6 +1092,10 @@ struct MLAS_PLATFORM {
     const MLAS_CONV_SYM_DISPATCH* ConvSymU8S8Dispatch{nullptr};
     const MLAS_CONV_SYM_DISPATCH* ConvSymS8S8Dispatch{nullptr};
 
+    const MLAS_Q4GEMM_DISPATCH* Q4GemmDispatch{nullptr};
+
+    const MLAS_SBGEMM_DISPATCH* SBGemmDispatch{nullptr};
+
     MLAS_QUANT_KERNEL<uint8_t, int8_t>::DepthwiseKernel* ConvDepthwiseU8S8Kernel;
     MLAS_QUANT_KERNEL<uint8_t, uint8_t>::DepthwiseKernel* ConvDepthwiseU8U8Kernel;
     MLAS_QUANT_KERNEL<int8_t, int8_t>::DepthwiseKernel* ConvDepthwiseS8S8Kernel;
@@ -971,6 +1131,12 @@ struct MLAS_PLATFORM {
     MLAS_COMPUTE_LOGSOFTMAX_OUTPUT_FLOAT_KERNEL* ComputeLogSoftmaxOutputF32Kernel;
     MLAS_REDUCE_MAXIMUM_FLOAT_KERNEL* ReduceMaximumF32Kernel;
     MLAS_REDUCE_MINIMUM_MAXIMUM_FLOAT_KERNEL* ReduceMinimumMaximumF32Kernel;
+    MLAS_LAYER_NORM_FLOAT_KERNEL* LayerNormF32Kernel;
+    MLAS_CAST_TO_F32_KERNEL* CastF16ToF32Kernel;
+    MLAS_CAST_FROM_F32_KERNEL* CastF32ToF16Kernel;
+    MLAS_CAST_TO_F32_KERNEL* CastBF16ToF32Kernel;
+    MLAS_CAST_FROM_F32_KERNEL* CastF32ToBF16Kernel;
+    MLAS_GEMM_S16_KERNEL* GemmS16Kernel;
     MLAS_QUANTIZE_LINEAR_S8_KERNEL* QuantizeLinearS8Kernel;
     MLAS_QUANTIZE_LINEAR_U8_KERNEL* QuantizeLinearU8Kernel;
     uint32_t NchwcBlockSize;
@@ -1174,6 +1340,9 @@ MlasConvDepthwiseFloat_CHW(
 #endif
 #elif defined(MLAS_TARGET_WASM_SIMD)
 #define MLAS_WASM_SIMD_INTRINSICS
+#if defined(MLAS_TARGET_WASM_RELAXED_SIMD)
+#define MLAS_WASM_RELAXED_SIMD_INTRINSICS
+#endif
 #endif
 
 #if defined(MLAS_NEON_INTRINSICS)
@@ -1771,6 +1940,8 @@ MlasMultiplyAddFloat32x4(MLAS_FLOAT32X4 Vector1, MLAS_FLOAT32X4 Vector2, MLAS_FL
     return _mm_add_ps(_mm_mul_ps(Vector1, Vector2), Vector3);
 #elif defined(MLAS_VSX_INTRINSICS)
     return vec_madd(Vector1, Vector2, Vector3);
+#elif defined(MLAS_WASM_RELAXED_SIMD_INTRINSICS)
+    return wasm_f32x4_relaxed_madd(Vector1, Vector2, Vector3);
 #elif defined(MLAS_WASM_SIMD_INTRINSICS)
     return wasm_f32x4_add(wasm_f32x4_mul(Vector1, Vector2), Vector3);
 #else
@@ -1900,6 +2071,10 @@ MlasMaximumFloat32x4(MLAS_FLOAT32X4 Vector1, MLAS_FLOAT32X4 Vector2)
 #elif defined(MLAS_VSX_INTRINSICS)
     // Don't use vec_max to avoid undefined behavior if NAN
     return vec_sel(Vector2, Vector1, vec_cmpgt(Vector1, Vector2));
+#elif defined(MLAS_WASM_RELAXED_SIMD_INTRINSICS)
+    // Like _mm_max_ps, the result is implementation defined if either input is NAN or
+    // the inputs are zeros of opposite sign.
+    return wasm_f32x4_relaxed_max(Vector1, Vector2);
 #elif defined(MLAS_WASM_SIMD_INTRINSICS)
     return wasm_f32x4_max(Vector1, Vector2);
 #else
@@ -1918,6 +2093,8 @@ MlasMinimumFloat32x4(MLAS_FLOAT32X4 Vector1, MLAS_FLOAT32X4 Vector2)
 #elif defined(MLAS_VSX_INTRINSICS)
     // Don't use vec_min to avoid undefined behavior if NAN
     return vec_sel(Vector2, Vector1, vec_cmpgt(Vector2, Vector1));
+#elif defined(MLAS_WASM_RELAXED_SIMD_INTRINSICS)
+    return wasm_f32x4_relaxed_min(Vector1, Vector2);
 #elif defined(MLAS_WASM_SIMD_INTRINSICS)
     return wasm_f32x4_min(Vector1, Vector2);
 #else
@@ -51,6 +51,9 @@ MLASCPUIDInfo::MLASCPUIDInfo()
 #ifndef HWCAP_ASIMDDP
 #define HWCAP_ASIMDDP (1 << 20)
 #endif
+#ifndef HWCAP2_I8MM
+#define HWCAP2_I8MM (1 << 13)
+#endif
 
 #if defined(BUILD_MLAS_NO_ONNXRUNTIME)
 MLASCPUIDInfo::MLASCPUIDInfo()
@@ -64,6 +67,10 @@ MLASCPUIDInfo::MLASCPUIDInfo()
 
 #else
 
+#if defined(__APPLE__)
+#include <sys/sysctl.h>
+#endif
+
 #if defined(BUILD_MLAS_NO_ONNXRUNTIME)
 MLASCPUIDInfo::MLASCPUIDInfo() {}
 #endif
@@ -172,7 +179,11 @@ MlasInitAMX()
 #endif // MLAS_TARGET_AMD64_IX86
 
 MLAS_PLATFORM::MLAS_PLATFORM(
+#if defined(MLAS_TARGET_AMD64_IX86)
+    MLAS_ISA_LEVEL MaximumIsaLevel
+#else
     void
+#endif
     )
 /*++
 
@@ -182,7 +193,9 @@ Routine Description:
 
 Arguments:
 
-    None.
+    MaximumIsaLevel - Supplies the highest instruction set level to select
+        kernels for (x86 only). The processor features above this level are
+        ignored.
 
 Return Value:
 
@@ -226,6 +239,16 @@ Return Value:
     this->ComputeLogSoftmaxOutputF32Kernel = MlasComputeLogSoftmaxOutputF32Kernel;
     this->ReduceMaximumF32Kernel = MlasReduceMaximumF32Kernel;
     this->ReduceMinimumMaximumF32Kernel = MlasReduceMinimumMaximumF32Kernel;
+    this->LayerNormF32Kernel = MlasLayerNormF32Kernel;
+#if defined(_WIN32)
+    this->CastF16ToF32Kernel = MlasCastF16ToF32KernelSse;
+#else
+    this->CastF16ToF32Kernel = MlasCastF16ToF32Kernel;
+#endif
+    this->CastF32ToF16Kernel = MlasCastF32ToF16Kernel;
+    this->CastBF16ToF32Kernel = MlasCastBF16ToF32Kernel;
+    this->CastF32ToBF16Kernel = MlasCastF32ToBF16Kernel;
+    this->GemmS16Kernel = MlasGemmS16Kernel;
     this->QLinearAddS8Kernel = MlasQLinearAddS8Kernel;
     this->QLinearAddU8Kernel = MlasQLinearAddU8Kernel;
     this->QuantizeLinearS8Kernel = MlasQuantizeLinearS8Kernel;
@@ -251,7 +274,7 @@ Return Value:
     // Check if the processor supports SSE 4.1 instructions.
     //
 
-    if ((Cpuid1[2] & 0x80000) != 0) {
+    if ((Cpuid1[2] & 0x80000) != 0 && MaximumIsaLevel >= MlasIsaLevelSse41) {
         this->GemmU8S8Dispatch = &MlasGemmU8S8DispatchSse41;
     }
 
@@ -261,7 +284,7 @@ Return Value:
     // Check if the processor supports the AVX and OSXSAVE features.
     //
 
-    if ((Cpuid1[2] & 0x18000000) == 0x18000000) {
+    if ((Cpuid1[2] & 0x18000000) == 0x18000000 && MaximumIsaLevel >= MlasIsaLevelAvx) {
 
         //
         // Check if the operating system supports saving SSE and AVX states.
@@ -303,7 +326,8 @@ Return Value:
             __cpuid_count(7, 0, Cpuid7[0], Cpuid7[1], Cpuid7[2], Cpuid7[3]);
 #endif
 
-            if (((Cpuid1[2] & 0x1000) != 0) && ((Cpuid7[1] & 0x20) != 0)) {
+            if (((Cpuid1[2] & 0x1000) != 0) && ((Cpuid7[1] & 0x20) != 0) &&
+                MaximumIsaLevel >= MlasIsaLevelAvx2) {
 
                 this->GemmU8S8Dispatch = &MlasGemmU8S8DispatchAvx2;
                 this->GemmU8S8Kernel = MlasGemmU8S8KernelAvx2;
@@ -329,6 +353,21 @@ Return Value:
                 this->ConvDepthwiseS8S8Kernel = MlasConvDepthwiseKernelAvx2<int8_t, int8_t>;
                 this->ConvDepthwiseS8U8Kernel = MlasConvDepthwiseKernelAvx2<int8_t, uint8_t>;
                 this->ComputeSumExpF32Kernel = MlasComputeSumExpF32KernelFma3;
+                this->LayerNormF32Kernel = MlasLayerNormF32KernelAvx2;
+                this->GemmS16Kernel = MlasGemmS16KernelAvx2;
+                this->Q4GemmDispatch = &MlasQ4GemmDispatchAvx2;
+
+                //
+                // Check if the processor supports the F16C conversions.
+                //
+
+                if ((Cpuid1[2] & 0x20000000) != 0) {
+                    this->CastF16ToF32Kernel = MlasCastF16ToF32KernelAvx2;
+                    this->CastF32ToF16Kernel = MlasCastF32ToF16KernelAvx2;
+                }
+
+                this->CastBF16ToF32Kernel = MlasCastBF16ToF32KernelAvx2;
+                this->CastF32ToBF16Kernel = MlasCastF32ToBF16KernelAvx2;
 
                 //
                 // Check if the processor supports Hybrid core architecture.
@@ -349,7 +388,7 @@ Return Value:
                 __cpuid_count(7, 1, Cpuid7_1[0], Cpuid7_1[1], Cpuid7_1[2], Cpuid7_1[3]);
 #endif
 
-                if ((Cpuid7_1[0] & 0x10) != 0) {
+                if ((Cpuid7_1[0] & 0x10) != 0 && MaximumIsaLevel >= MlasIsaLevelAvxVnni) {
 
                     this->GemmU8U8Dispatch = &MlasGemmU8S8DispatchAvx2;
                     this->GemmU8S8Kernel = MlasGemmU8S8KernelAvxVnni;
@@ -364,7 +403,8 @@ Return Value:
                 // operating system supports saving AVX512F state.
                 //
 
-                if (((Cpuid7[1] & 0x10000) != 0) && ((xcr0 & 0xE0) == 0xE0)) {
+                if (((Cpuid7[1] & 0x10000) != 0) && ((xcr0 & 0xE0) == 0xE0) &&
+                    MaximumIsaLevel >= MlasIsaLevelAvx512F) {
 
                     this->GemmFloatKernel = MlasGemmFloatKernelAvx512F;
                     this->GemmDoubleKernel = MlasGemmDoubleKernelAvx512F;
@@ -377,8 +417,10 @@ Return Value:
                     this->PoolFloatKernel[MlasAveragePoolingIncludePad] = MlasPoolAverageIncludePadFloatKernelAvx512F;
                     this->ComputeExpF32Kernel = MlasComputeExpF32KernelAvx512F;
                     this->ComputeSumExpF32Kernel = MlasComputeSumExpF32KernelAvx512F;
+                    this->LayerNormF32Kernel = MlasLayerNormF32KernelAvx512F;
                     this->QuantizeLinearS8Kernel = MlasQuantizeLinearS8KernelAvx512F;
                     this->QuantizeLinearU8Kernel = MlasQuantizeLinearU8KernelAvx512F;
+                    this->Q4GemmDispatch = &MlasQ4GemmDispatchAvx512;
                     this->NchwcBlockSize = 16;
                     this->PreferredBufferAlignment = 64;
 
@@ -387,24 +429,48 @@ Return Value:
                     // (AVX512BW/AVX512DQ/AVX512VL).
                     //
 
-                    if ((Cpuid7[1] & 0xC0020000) == 0xC0020000) {
+                    if ((Cpuid7[1] & 0xC0020000) == 0xC0020000 && MaximumIsaLevel >= MlasIsaLevelAvx512Core) {
 
+                        //
+                        // The AVXVNNI branch above routes U8U8 through the
+                        // U8S8 kernels, which saturate without VNNI. Real
+                        // processors with AVXVNNI and AVX512 core also have
+                        // AVX512VNNI, but a maximum ISA level may cap it.
+                        //
+
+                        this->GemmU8U8Dispatch = &MlasGemmU8U8DispatchAvx2;
                         this->GemmU8S8Kernel = MlasGemmU8S8KernelAvx512Core;
                         this->GemvU8S8Kernel = MlasGemvU8S8KernelAvx512Core;
                         this->GemmU8U8Kernel = MlasGemmU8U8KernelAvx512Core;
                         this->ConvSymU8S8Dispatch = &MlasConvSymDispatchAvx512Core;
+                        this->GemmS16Kernel = MlasGemmS16KernelAvx512Core;
 
                         //
                         // Check if the processor supports AVX512VNNI.
                         //
 
-                        if ((Cpuid7[2] & 0x800) != 0) {
+                        if ((Cpuid7[2] & 0x800) != 0 && MaximumIsaLevel >= MlasIsaLevelAvx512Vnni) {
 
                             this->GemmU8U8Dispatch = &MlasGemmU8S8DispatchAvx2;
                             this->GemmU8S8Kernel = MlasGemmU8S8KernelAvx512Vnni;
                             this->GemvU8S8Kernel = MlasGemvU8S8KernelAvx512Vnni;
                             this->ConvSymU8S8Dispatch = &MlasConvSymDispatchAvx512Vnni;
+                            this->GemmS16Kernel = MlasGemmS16KernelAvx512Vnni;
+                            this->ConvDepthwiseU8S8Kernel = MlasConvDepthwiseKernelAvx512Vnni<uint8_t, int8_t>;
+                            this->ConvDepthwiseU8U8Kernel = MlasConvDepthwiseKernelAvx512Vnni<uint8_t, uint8_t>;
+                            this->ConvDepthwiseS8S8Kernel = MlasConvDepthwiseKernelAvx512Vnni<int8_t, int8_t>;
+                            this->ConvDepthwiseS8U8Kernel = MlasConvDepthwiseKernelAvx512Vnni<int8_t, uint8_t>;
                         }
+
+#ifdef MLAS_AMX_SUPPORTED
+                        //
+                        // Check if the processor supports AVX512_BF16.
+                        //
+
+                        if ((Cpuid7_1[0] & 0x20) != 0 && MaximumIsaLevel >= MlasIsaLevelAvx512Vnni) {
+                            this->SBGemmDispatch = &MlasSBGemmDispatchAvx512Bf16;
+                        }
+#endif // MLAS_AMX_SUPPORTED
                     }
                 }
 
@@ -413,10 +479,24 @@ Return Value:
                 // Check if the processor supports AMX-TILE and AMX-INT8
                 // features.
                 //
-                if ((Cpuid7[3] & 0b1 << 24) != 0 && (Cpuid7[3] & 0b1 << 25) != 0) {
+                if ((Cpuid7[3] & 0b1 << 24) != 0 && (Cpuid7[3] & 0b1 << 25) != 0 &&
+                    MaximumIsaLevel >= MlasIsaLevelAmx) {
                     if (MlasInitAMX()) {
                         this->GemmU8U8Dispatch = &MlasGemmU8S8DispatchAmx;
                         this->GemmU8S8Dispatch = &MlasGemmU8S8DispatchAmx;
+                        this->ConvSymU8S8Dispatch = &MlasConvSymDispatchAmx;
+                    }
+                }
+
+                //
+                // Check if the processor supports AMX-TILE and AMX-BF16
+                // features. The kernel falls back to AVX512_BF16 for small
+                // blocks.
+                //
+                if ((Cpuid7[3] & 0b1 << 24) != 0 && (Cpuid7[3] & 0b1 << 22) != 0 &&
+                    this->SBGemmDispatch != nullptr && MaximumIsaLevel >= MlasIsaLevelAmx) {
+                    if (MlasInitAMX()) {
+                        this->SBGemmDispatch = &MlasSBGemmDispatchAmx;
                     }
                 }
 #endif // MLAS_AMX_SUPPORTED
@@ -440,6 +520,7 @@ Return Value:
     this->SymmQgemmDispatch = &MlasSymmQgemmS8DispatchNeon;
     this->ConvSymU8S8Dispatch = &MlasConvSymU8DispatchNeon;
     this->ConvSymS8S8Dispatch = &MlasConvSymS8DispatchNeon;
+    this->Q4GemmDispatch = &MlasQ4GemmDispatchNeon;
 
     //
     // Check if the processor supports ASIMD dot product instructions.
@@ -464,6 +545,31 @@ Return Value:
         this->ConvSymS8S8Dispatch = &MlasConvSymS8DispatchDot;
     }
 
+    //
+    // Check if the processor supports the I8MM matrix multiply instructions.
+    // These kernels are not built for Windows.
+    //
+
+#if defined(__linux__) || defined(__APPLE__)
+    bool HasI8MMInstructions;
+
+#if defined(__linux__)
+    HasI8MMInstructions = ((getauxval(AT_HWCAP2) & HWCAP2_I8MM) != 0);
+#else
+    int FeatureI8MM = 0;
+    size_t FeatureI8MMSize = sizeof(FeatureI8MM);
+    HasI8MMInstructions =
+        sysctlbyname("hw.optional.arm.FEAT_I8MM", &FeatureI8MM, &FeatureI8MMSize, nullptr, 0) == 0 &&
+        FeatureI8MM != 0;
+#endif
+
+    if (HasDotProductInstructions && HasI8MMInstructions) {
+        this->GemmU8U8Dispatch = &MlasGemmU8X8DispatchUmmla;
+        this->GemmU8S8Dispatch = &MlasGemmU8X8DispatchUmmla;
+        this->GemmS8S8Dispatch = &MlasGemmS8S8DispatchSmmla;
+    }
+#endif
+
 #endif // MLAS_TARGET_ARM64
 #if defined(MLAS_TARGET_POWER)
     this->GemmFloatKernel = MlasSgemmKernel;
@@ -539,6 +645,41 @@ MlasPlatformU8S8Overflow(
     return p.GemmU8U8Dispatch != p.GemmU8S8Dispatch;
 }
 
+void
+MLASCALL
+MlasSetMaximumIsaLevel(
+    MLAS_ISA_LEVEL MaximumIsaLevel
+    )
+{
+    GetMlasPlatform() = MLAS_PLATFORM(MaximumIsaLevel);
+}
+
+const char*
+MLASCALL
+MlasGetIsaLevelName(
+    MLAS_ISA_LEVEL IsaLevel
+    )
+{
+    static const char* const IsaLevelNames[] = {
+        "sse2",
+        "sse41",
+        "avx",
+        "avx2",
+        "avxvnni",
+        "avx512f",
+        "avx512core",
+        "avx512vnni",
+        "amx",
+    };
+    static_assert(sizeof(IsaLevelNames) / sizeof(IsaLevelNames[0]) == MlasIsaLevelCount,
+                  "IsaLevelNames must name every MLAS_ISA_LEVEL");
+
+    if (unsigned(IsaLevel) >= unsigned(MlasIsaLevelCount)) {
+        return "unknown";
+    }
+    return IsaLevelNames[IsaLevel];
+}
+
 #endif
 
 thread_local size_t ThreadedBufSize = 0;
@@ -0,0 +1,187 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    q4_dq.cpp
+
+Abstract:
+
+    This module contains the data structures and implementations
+    for blocked int4 quantization and dequantization.
+
+    Int4 block quantization is used to compress weight tensors of large
+    language models.
+
+--*/
+
+#include "q4gemm.h"
+
+#include <cmath>
+
+size_t
+MLASCALL
+MlasQ4GemmPackBSize(
+    MLAS_BLK_QUANT_TYPE QType,
+    size_t N,
+    size_t K
+    )
+{
+    const MLAS_Q4_BLK_LAYOUT Layout = MlasQ4GetBlkLayout(QType);
+    if (Layout.BlkLen == 0) {
+        return 0;
+    }
+
+    const size_t BlkCount = MlasDivRoundup(K, Layout.BlkLen);
+    return N * BlkCount * Layout.BlkSize();
+}
+
+static
+void
+MlasQ4QuantizeBlk(
+    const MLAS_Q4_BLK_LAYOUT& Layout,
+    uint8_t* Blk,
+    const float* FpData,
+    size_t ldb,
+    size_t CountK
+    )
+/*++
+
+Routine Description:
+
+    This routine quantizes CountK values of one column of B, read with a
+    stride of ldb, into a single block.
+
+--*/
+{
+    float Scale;
+    float ReciprocalScale;
+    uint8_t ZeroPoint;
+
+    if (Layout.HasZeroPoint) {
+
+        //
+        // The range must include zero so that the zero point is representable.
+        //
+
+        float Min = 0.0f;
+        float Max = 0.0f;
+        for (size_t k = 0; k < CountK; k++) {
+            const float v = FpData[ldb * k];
+            Min = std::min(Min, v);
+            Max = std::max(Max, v);
+        }
+
+        Scale = (Max - Min) / 15.0f;
+        ReciprocalScale = (Scale != 0.0f) ? 1.0f / Scale : 0.0f;
+
+        const float ZeroPointFp = (ReciprocalScale != 0.0f) ? std::nearbyintf(-Min * ReciprocalScale) : 0.0f;
+        ZeroPoint = uint8_t(std::clamp(ZeroPointFp, 0.0f, 15.0f));
+        Blk[sizeof(float)] = ZeroPoint;
+
+    } else {
+
+        //
+        // Map the value with the largest magnitude to -8 so that the full
+        // [-8, 7] range is used.
+        //
+
+        float AbsMax = 0.0f;
+        float Max = 0.0f;
+        for (size_t k = 0; k < CountK; k++) {
+            const float v = FpData[ldb * k];
+            if (AbsMax < std::fabs(v)) {
+                AbsMax = std::fabs(v);
+                Max = v;
+            }
+        }
+
+        Scale = Max / -8.0f;
+        ReciprocalScale = (Scale != 0.0f) ? 1.0f / Scale : 0.0f;
+        ZeroPoint = MLAS_Q4_SYMMETRIC_ZERO_POINT;
+    }
+
+    memcpy(Blk, &Scale, sizeof(float));
+
+    uint8_t* Data = Blk + Layout.DataOffset();
+    const size_t Half = Layout.BlkLen / 2;
+
+    auto Quantize = [&](size_t k) -> uint8_t {
+        if (k >= CountK) {
+            return ZeroPoint;
+        }
+        const float v = std::nearbyintf(FpData[ldb * k] * ReciprocalScale) + float(ZeroPoint);
+        return uint8_t(std::clamp(v, 0.0f, 15.0f));
+    };
+
+    for (size_t j = 0; j < Half; j++) {
+        Data[j] = uint8_t(Quantize(j) | (Quantize(j + Half) << 4));
+    }
+}
+
+void
+MLASCALL
+MlasQ4GemmPackB(
+    MLAS_BLK_QUANT_TYPE QType,
+    void* PackedBuf,
+    const float* FpData,
+    size_t N,
+    size_t K,
+    size_t ldb
+    )
+{
+    const MLAS_Q4_BLK_LAYOUT Layout = MlasQ4GetBlkLayout(QType);
+    if (Layout.BlkLen == 0) {
+        MLAS_THROW_EX(std::invalid_argument, "Unsupported block quantization type");
+    }
+
+    uint8_t* Blk = reinterpret_cast<uint8_t*>(PackedBuf);
+
+    for (size_t n = 0; n < N; n++) {
+        for (size_t k = 0; k < K; k += Layout.BlkLen) {
+            const size_t CountK = std::min(K - k, Layout.BlkLen);
+            MlasQ4QuantizeBlk(Layout, Blk, FpData + ldb * k + n, ldb, CountK);
+            Blk += Layout.BlkSize();
+        }
+    }
+}
+
+void
+MLASCALL
+MlasQ4GemmUnPackB(
+    MLAS_BLK_QUANT_TYPE QType,
+    float* FpData,
+    const void* PackedBuf,
+    size_t N,
+    size_t K,
+    size_t ldb
+    )
+{
+    const MLAS_Q4_BLK_LAYOUT Layout = MlasQ4GetBlkLayout(QType);
+    if (Layout.BlkLen == 0) {
+        MLAS_THROW_EX(std::invalid_argument, "Unsupported block quantization type");
+    }
+
+    const uint8_t* Blk = reinterpret_cast<const uint8_t*>(PackedBuf);
+    const size_t Half = Layout.BlkLen / 2;
+
+    for (size_t n = 0; n < N; n++) {
+        for (size_t k = 0; k < K; k += Layout.BlkLen) {
+            const size_t CountK = std::min(K - k, Layout.BlkLen);
+            const float Scale = MlasQ4BlkScale(Blk);
+            const float ZeroPoint = float(MlasQ4BlkZeroPoint(Blk, Layout.HasZeroPoint));
+            const uint8_t* Data = Blk + Layout.DataOffset();
+
+            for (size_t kk = 0; kk < CountK; kk++) {
+                const uint8_t Packed = Data[kk % Half];
+                const uint8_t Value = (kk < Half) ? (Packed & 0x0F) : (Packed >> 4);
+                FpData[ldb * (k + kk) + n] = (float(Value) - ZeroPoint) * Scale;
+            }
+
+            Blk += Layout.BlkSize();
+        }
+    }
+}
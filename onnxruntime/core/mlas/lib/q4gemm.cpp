@@ -0,0 +1,304 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    q4gemm.cpp
+
+Abstract:
+
+    This module implements the fp32 matrix multiplication with compressed
+    weight tensor (right hand side). The assumption is the right hand side
+    tensor can be pre-packed and compressed using int-4 quantization to save
+    memory.
+
+    Rows of A that are few in number (the token generation case) are handled
+    by fused dequantize and dot product kernels that read the packed weights
+    exactly once per row. Larger M dequantizes panels of B into a small fp32
+    buffer and feeds them to the SGEMM kernels.
+
+--*/
+
+#include "q4gemm.h"
+
+//
+// Number of rows of A at or below which the fused GEMV kernels are used.
+//
+
+constexpr size_t MLAS_Q4GEMM_GEMV_THRESHOLD_M = 4;
+
+//
+// Blocking of B used by the dequantize panel path. StrideK must be a
+// multiple of the largest supported block length.
+//
+
+constexpr size_t MLAS_Q4GEMM_STRIDEN = 32;
+constexpr size_t MLAS_Q4GEMM_STRIDEK = 256;
+
+//
+// Number of columns handled by a GEMV work item. A work item is small enough
+// that its packed weights stay cache resident while looping over the rows.
+//
+
+constexpr size_t MLAS_Q4GEMV_STRIDEN = 32;
+
+template <MLAS_BLK_QUANT_TYPE QType>
+void
+MLASCALL
+MlasQ4GemvKernelDefault(
+    const float* A,
+    const uint8_t* PackedB,
+    const float* Bias,
+    float* C,
+    size_t CountN,
+    size_t CountK
+    )
+{
+    const MLAS_Q4_BLK_LAYOUT Layout = MlasQ4GetBlkLayout(QType);
+    const size_t BlkSize = Layout.BlkSize();
+
+    for (size_t n = 0; n < CountN; n++) {
+        float Sum = (Bias != nullptr) ? Bias[n] : 0.0f;
+        for (size_t k = 0; k < CountK; k += Layout.BlkLen) {
+            Sum += MlasQ4BlkDotScalar(A + k, PackedB, Layout, std::min(CountK - k, Layout.BlkLen));
+            PackedB += BlkSize;
+        }
+        C[n] = Sum;
+    }
+}
+
+const MLAS_Q4GEMM_DISPATCH MlasQ4GemmDispatchDefault = {
+    {
+        MlasQ4GemvKernelDefault<BlkQ4Sym>,
+        MlasQ4GemvKernelDefault<BlkQ4Zp8>,
+        MlasQ4GemvKernelDefault<BlkQ4Sym64>,
+        MlasQ4GemvKernelDefault<BlkQ4Sym128>,
+    }
+};
+
+MLAS_FORCEINLINE
+const MLAS_Q4GEMM_DISPATCH*
+MlasQ4GemmGetDispatch()
+{
+    const MLAS_Q4GEMM_DISPATCH* Dispatch = GetMlasPlatform().Q4GemmDispatch;
+    return (Dispatch != nullptr) ? Dispatch : &MlasQ4GemmDispatchDefault;
+}
+
+static
+void
+MlasQ4DequantizePanel(
+    const MLAS_Q4_BLK_LAYOUT& Layout,
+    float* Panel,
+    const uint8_t* PackedB,
+    size_t ColumnStride,
+    size_t CountN,
+    size_t CountK
+    )
+/*++
+
+Routine Description:
+
+    This routine dequantizes CountK rows and CountN columns of the packed
+    matrix B into a row major panel with a leading dimension of
+    MLAS_Q4GEMM_STRIDEN. PackedB addresses the first block to dequantize and
+    CountK starts on a block boundary.
+
+--*/
+{
+    const size_t Half = Layout.BlkLen / 2;
+
+    for (size_t n = 0; n < CountN; n++) {
+        const uint8_t* Blk = PackedB + ColumnStride * n;
+        for (size_t k = 0; k < CountK; k += Layout.BlkLen) {
+            const float Scale = MlasQ4BlkScale(Blk);
+            const float ZeroPoint = float(MlasQ4BlkZeroPoint(Blk, Layout.HasZeroPoint));
+            const uint8_t* Data = Blk + Layout.DataOffset();
+            const size_t CountBlk = std::min(CountK - k, Layout.BlkLen);
+            float* p = Panel + MLAS_Q4GEMM_STRIDEN * k + n;
+
+            for (size_t kk = 0; kk < std::min(CountBlk, Half); kk++) {
+                p[MLAS_Q4GEMM_STRIDEN * kk] = (float(Data[kk] & 0x0F) - ZeroPoint) * Scale;
+            }
+            for (size_t kk = Half; kk < CountBlk; kk++) {
+                p[MLAS_Q4GEMM_STRIDEN * kk] = (float(Data[kk - Half] >> 4) - ZeroPoint) * Scale;
+            }
+
+            Blk += Layout.BlkSize();
+        }
+    }
+}
+
+static
+void
+MlasQ4GemvOperation(
+    MLAS_Q4GEMV_KERNEL* Kernel,
+    const MLAS_Q4_BLK_LAYOUT& Layout,
+    const size_t K,
+    const MLAS_Q4_GEMM_DATA_PARAMS* Data,
+    const size_t RangeStartM,
+    const size_t RangeCountM,
+    const size_t RangeStartN,
+    const size_t RangeCountN
+    )
+{
+    const size_t ColumnStride = MlasDivRoundup(K, Layout.BlkLen) * Layout.BlkSize();
+    const uint8_t* PackedB = reinterpret_cast<const uint8_t*>(Data->B);
+
+    for (size_t n = 0; n < RangeCountN; n += MLAS_Q4GEMV_STRIDEN) {
+        const size_t CountN = std::min(RangeCountN - n, MLAS_Q4GEMV_STRIDEN);
+        const size_t StartN = RangeStartN + n;
+        const float* Bias = (Data->Bias != nullptr) ? Data->Bias + StartN : nullptr;
+
+        for (size_t m = RangeStartM; m < RangeStartM + RangeCountM; m++) {
+            Kernel(Data->A + Data->lda * m,
+                   PackedB + ColumnStride * StartN,
+                   Bias,
+                   Data->C + Data->ldc * m + StartN,
+                   CountN,
+                   K);
+        }
+    }
+}
+
+static
+void
+MlasQ4GemmOperation(
+    const MLAS_Q4_BLK_LAYOUT& Layout,
+    const size_t K,
+    const MLAS_Q4_GEMM_DATA_PARAMS* Data,
+    const size_t RangeStartM,
+    const size_t RangeCountM,
+    const size_t RangeStartN,
+    const size_t RangeCountN
+    )
+{
+    MLAS_DECLSPEC_ALIGN(float PanelB[MLAS_Q4GEMM_STRIDEN * MLAS_Q4GEMM_STRIDEK], 64);
+
+    const size_t BlkSize = Layout.BlkSize();
+    const size_t ColumnStride = MlasDivRoundup(K, Layout.BlkLen) * BlkSize;
+    const uint8_t* PackedB = reinterpret_cast<const uint8_t*>(Data->B);
+
+    const float* A = Data->A + Data->lda * RangeStartM;
+    float* C = Data->C + Data->ldc * RangeStartM;
+
+    for (size_t n = 0; n < RangeCountN; n += MLAS_Q4GEMM_STRIDEN) {
+        const size_t CountN = std::min(RangeCountN - n, MLAS_Q4GEMM_STRIDEN);
+        const size_t StartN = RangeStartN + n;
+
+        for (size_t k = 0; k < K; k += MLAS_Q4GEMM_STRIDEK) {
+            const size_t CountK = std::min(K - k, MLAS_Q4GEMM_STRIDEK);
+
+            MlasQ4DequantizePanel(Layout, PanelB,
+                                  PackedB + ColumnStride * StartN + (k / Layout.BlkLen) * BlkSize,
+                                  ColumnStride, CountN, CountK);
+
+            MlasGemm(CblasNoTrans, CblasNoTrans, RangeCountM, CountN, CountK,
+                     1.0f, A + k, Data->lda, PanelB, MLAS_Q4GEMM_STRIDEN,
+                     (k == 0) ? 0.0f : 1.0f, C + StartN, Data->ldc, nullptr);
+        }
+
+        if (Data->Bias != nullptr) {
+            for (size_t m = 0; m < RangeCountM; m++) {
+                float* c = C + Data->ldc * m + StartN;
+                for (size_t nn = 0; nn < CountN; nn++) {
+                    c[nn] += Data->Bias[StartN + nn];
+                }
+            }
+        }
+    }
+}
+
+void
+MLASCALL
+MlasQ4GemmBatch(
+    MLAS_BLK_QUANT_TYPE QType,
+    const size_t M,
+    const size_t N,
+    const size_t K,
+    const size_t BatchN,
+    const MLAS_Q4_GEMM_DATA_PARAMS* DataParams,
+    MLAS_THREADPOOL* ThreadPool
+    )
+{
+    const MLAS_Q4_BLK_LAYOUT Layout = MlasQ4GetBlkLayout(QType);
+    if (Layout.BlkLen == 0) {
+        MLAS_THROW_EX(std::invalid_argument, "Unsupported block quantization type");
+    }
+
+    const bool UseGemv = (M <= MLAS_Q4GEMM_GEMV_THRESHOLD_M);
+    MLAS_Q4GEMV_KERNEL* GemvKernel = MlasQ4GemmGetDispatch()->GemvKernel[QType];
+
+    auto Operation = [&](const MLAS_Q4_GEMM_DATA_PARAMS* Data,
+                         size_t RangeStartM, size_t RangeCountM,
+                         size_t RangeStartN, size_t RangeCountN) {
+        if (UseGemv) {
+            MlasQ4GemvOperation(GemvKernel, Layout, K, Data,
+                                RangeStartM, RangeCountM, RangeStartN, RangeCountN);
+        } else {
+            MlasQ4GemmOperation(Layout, K, Data,
+                                RangeStartM, RangeCountM, RangeStartN, RangeCountN);
+        }
+    };
+
+    if (ThreadPool == nullptr) {
+        for (size_t gemm_i = 0; gemm_i < BatchN; gemm_i++) {
+            Operation(&DataParams[gemm_i], 0, M, 0, N);
+        }
+        return;
+    }
+
+    //
+    // Compute the number of target threads given the complexity of the
+    // operation. Small requests should run using the single threaded path.
+    //
+
+    const double Complexity = double(M) * double(N) * double(K) * double(BatchN);
+
+    ptrdiff_t TargetThreadCount = ptrdiff_t(Complexity / double(MLAS_SGEMM_THREAD_COMPLEXITY)) + 1;
+
+    ptrdiff_t MaximumThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+    if (TargetThreadCount >= MaximumThreadCount) {
+        TargetThreadCount = MaximumThreadCount;
+    }
+
+    ptrdiff_t ThreadsPerGemm = TargetThreadCount / BatchN;
+    if (ThreadsPerGemm < 1) {
+        ThreadsPerGemm = 1;
+    }
+
+    //
+    // Partition the columns first: every column block is read by exactly one
+    // thread. Only split the rows when there are not enough column blocks.
+    //
+
+    const size_t StrideN = UseGemv ? MLAS_Q4GEMV_STRIDEN : MLAS_Q4GEMM_STRIDEN;
+    const size_t BlockCountN = MlasDivRoundup(N, StrideN);
+
+    const ptrdiff_t ThreadCountN = std::min(ThreadsPerGemm, ptrdiff_t(BlockCountN));
+    const ptrdiff_t ThreadCountM = std::max(ptrdiff_t(1), std::min(ThreadsPerGemm / ThreadCountN, ptrdiff_t(M)));
+    ThreadsPerGemm = ThreadCountN * ThreadCountM;
+
+    MlasTrySimpleParallel(ThreadPool, ThreadsPerGemm * BatchN, [&](ptrdiff_t tid) {
+        const auto gemm_i = tid / ThreadsPerGemm;
+        const auto blk_i = tid % ThreadsPerGemm;
+
+        size_t RangeStartM;
+        size_t RangeCountM;
+        MlasPartitionWork(blk_i / ThreadCountN, ThreadCountM, M, &RangeStartM, &RangeCountM);
+
+        size_t BlockStartN;
+        size_t BlockCountPerThread;
+        MlasPartitionWork(blk_i % ThreadCountN, ThreadCountN, BlockCountN, &BlockStartN, &BlockCountPerThread);
+
+        const size_t RangeStartN = BlockStartN * StrideN;
+        const size_t RangeCountN = std::min(N - RangeStartN, BlockCountPerThread * StrideN);
+
+        if (RangeCountM > 0 && BlockCountPerThread > 0) {
+            Operation(&DataParams[gemm_i], RangeStartM, RangeCountM, RangeStartN, RangeCountN);
+        }
+    });
+}
@@ -0,0 +1,151 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    q4gemm.h
+
+Abstract:
+
+    This module defines the memory layout of blockwise int4 quantized
+    weights and the hardware dependent dispatch for the fp32 x int4
+    matrix multiply operation.
+
+    Each block of BlkLen values along the K dimension is stored as
+
+        float    Scale
+        uint8_t  ZeroPoint          (only present for BlkQ4Zp8)
+        uint8_t  Data[BlkLen / 2]
+
+    Byte j of Data holds element j in its low nibble and element
+    j + BlkLen / 2 in its high nibble. This lets vectorized kernels expand
+    both halves of a block with a mask and a shift instead of shuffles.
+    Symmetric types use an implicit zero point of 8.
+
+    All the blocks of one column of B are stored contiguously, the columns
+    follow one another. A partial trailing block is padded with the zero
+    point so that it dequantizes to zeros.
+
+--*/
+
+#pragma once
+
+#include "mlas_q4.h"
+#include "mlasi.h"
+
+#include <string.h>
+
+/**
+ * @brief Memory layout of a single quantized block
+ */
+struct MLAS_Q4_BLK_LAYOUT {
+    size_t BlkLen;      /**< number of values in a block, 0 if unsupported */
+    bool HasZeroPoint;  /**< whether an explicit zero point is stored */
+
+    constexpr size_t DataOffset() const { return sizeof(float) + (HasZeroPoint ? 1 : 0); }
+    constexpr size_t BlkSize() const { return DataOffset() + BlkLen / 2; }
+};
+
+MLAS_FORCEINLINE
+MLAS_Q4_BLK_LAYOUT
+MlasQ4GetBlkLayout(
+    MLAS_BLK_QUANT_TYPE QType
+    )
+{
+    switch (QType) {
+        case BlkQ4Sym:
+            return {32, false};
+        case BlkQ4Zp8:
+            return {32, true};
+        case BlkQ4Sym64:
+            return {64, false};
+        case BlkQ4Sym128:
+            return {128, false};
+        default:
+            return {0, false};
+    }
+}
+
+constexpr uint8_t MLAS_Q4_SYMMETRIC_ZERO_POINT = 8;
+
+MLAS_FORCEINLINE
+float
+MlasQ4BlkScale(
+    const uint8_t* Blk
+    )
+{
+    float Scale;
+    memcpy(&Scale, Blk, sizeof(float));
+    return Scale;
+}
+
+MLAS_FORCEINLINE
+uint8_t
+MlasQ4BlkZeroPoint(
+    const uint8_t* Blk,
+    bool HasZeroPoint
+    )
+{
+    return HasZeroPoint ? Blk[sizeof(float)] : MLAS_Q4_SYMMETRIC_ZERO_POINT;
+}
+
+/**
+ * @brief Scalar dot product of a (possibly partial) block with a row of A.
+ *        Used for the trailing block of a column and by the default kernel.
+ */
+MLAS_FORCEINLINE
+float
+MlasQ4BlkDotScalar(
+    const float* A,
+    const uint8_t* Blk,
+    const MLAS_Q4_BLK_LAYOUT& Layout,
+    size_t CountK
+    )
+{
+    const float Scale = MlasQ4BlkScale(Blk);
+    const float ZeroPoint = float(MlasQ4BlkZeroPoint(Blk, Layout.HasZeroPoint));
+    const uint8_t* Data = Blk + Layout.DataOffset();
+    const size_t Half = Layout.BlkLen / 2;
+
+    float Sum = 0.0f;
+    for (size_t k = 0; k < CountK; k++) {
+        const uint8_t Packed = Data[k % Half];
+        const uint8_t Value = (k < Half) ? (Packed & 0x0F) : (Packed >> 4);
+        Sum += A[k] * (float(Value) - ZeroPoint);
+    }
+    return Sum * Scale;
+}
+
+/**
+ * @brief Computes C[n] = A * B[:, n] + Bias[n] for CountN consecutive columns
+ *        of the packed matrix B, where A is a single row of CountK values.
+ *
+ * @param A        row vector of CountK values
+ * @param PackedB  address of the first column to process
+ * @param Bias     optional bias, addressed at the first column to process
+ * @param C        output, CountN values
+ * @param CountN   number of columns to process
+ * @param CountK   number of rows of B
+ */
+typedef
+void
+(MLASCALL MLAS_Q4GEMV_KERNEL)(
+    const float* A,
+    const uint8_t* PackedB,
+    const float* Bias,
+    float* C,
+    size_t CountN,
+    size_t CountK
+    );
+
+/**
+ * @brief Hardware dependent dispatch for the fp32 x int4 GEMM
+ */
+struct MLAS_Q4GEMM_DISPATCH {
+    MLAS_Q4GEMV_KERNEL* GemvKernel[4];  /**< indexed by MLAS_BLK_QUANT_TYPE */
+};
+
+extern const MLAS_Q4GEMM_DISPATCH MlasQ4GemmDispatchDefault;
@@ -0,0 +1,147 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    q4gemm_kernel_neon.cpp
+
+Abstract:
+
+    This module implements the fused dequantize and dot product kernels for
+    fp32 activations and blockwise int4 quantized weights using ARM64 NEON
+    instructions.
+
+--*/
+
+#include "q4gemm.h"
+
+MLAS_FORCEINLINE
+float32x4_t
+MlasQ4DotNibblesNeon(
+    uint8x16_t Nibbles,
+    float32x4_t ZeroPoint,
+    const float* A,
+    float32x4_t Acc
+    )
+/*++
+
+Routine Description:
+
+    This routine widens 16 unsigned 4-bit values to fp32, removes the zero
+    point and accumulates the product with 16 consecutive values of A.
+
+--*/
+{
+    const uint16x8_t Lo = vmovl_u8(vget_low_u8(Nibbles));
+    const uint16x8_t Hi = vmovl_u8(vget_high_u8(Nibbles));
+
+    const float32x4_t V0 = vsubq_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(Lo))), ZeroPoint);
+    const float32x4_t V1 = vsubq_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(Lo))), ZeroPoint);
+    const float32x4_t V2 = vsubq_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(Hi))), ZeroPoint);
+    const float32x4_t V3 = vsubq_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(Hi))), ZeroPoint);
+
+    Acc = vfmaq_f32(Acc, V0, vld1q_f32(A));
+    Acc = vfmaq_f32(Acc, V1, vld1q_f32(A + 4));
+    Acc = vfmaq_f32(Acc, V2, vld1q_f32(A + 8));
+    Acc = vfmaq_f32(Acc, V3, vld1q_f32(A + 12));
+
+    return Acc;
+}
+
+template <MLAS_BLK_QUANT_TYPE QType, size_t NCols>
+MLAS_FORCEINLINE
+void
+MlasQ4GemvColumnsNeon(
+    const float* A,
+    const uint8_t* PackedB,
+    size_t ColumnStride,
+    const float* Bias,
+    float* C,
+    size_t CountK
+    )
+{
+    const MLAS_Q4_BLK_LAYOUT Layout = MlasQ4GetBlkLayout(QType);
+    const size_t BlkLen = Layout.BlkLen;
+    const size_t Half = BlkLen / 2;
+
+    const uint8x16_t LowMask = vdupq_n_u8(0x0F);
+
+    float32x4_t Acc[NCols];
+    for (size_t c = 0; c < NCols; c++) {
+        Acc[c] = vdupq_n_f32(0.0f);
+    }
+
+    size_t k = 0;
+    const uint8_t* b = PackedB;
+
+    for (; k + BlkLen <= CountK; k += BlkLen) {
+        for (size_t c = 0; c < NCols; c++) {
+            const uint8_t* Blk = b + ColumnStride * c;
+            const float Scale = MlasQ4BlkScale(Blk);
+            const float32x4_t ZeroPoint = vdupq_n_f32(float(MlasQ4BlkZeroPoint(Blk, Layout.HasZeroPoint)));
+            const uint8_t* Data = Blk + Layout.DataOffset();
+
+            float32x4_t BlkAcc0 = vdupq_n_f32(0.0f);
+            float32x4_t BlkAcc1 = vdupq_n_f32(0.0f);
+
+            for (size_t j = 0; j < Half; j += 16) {
+                const uint8x16_t Bytes = vld1q_u8(Data + j);
+                BlkAcc0 = MlasQ4DotNibblesNeon(vandq_u8(Bytes, LowMask), ZeroPoint, A + k + j, BlkAcc0);
+                BlkAcc1 = MlasQ4DotNibblesNeon(vshrq_n_u8(Bytes, 4), ZeroPoint, A + k + Half + j, BlkAcc1);
+            }
+
+            Acc[c] = vfmaq_f32(Acc[c], vaddq_f32(BlkAcc0, BlkAcc1), vdupq_n_f32(Scale));
+        }
+
+        b += Layout.BlkSize();
+    }
+
+    for (size_t c = 0; c < NCols; c++) {
+        float Sum = vaddvq_f32(Acc[c]);
+        if (k < CountK) {
+            Sum += MlasQ4BlkDotScalar(A + k, b + ColumnStride * c, Layout, CountK - k);
+        }
+        if (Bias != nullptr) {
+            Sum += Bias[c];
+        }
+        C[c] = Sum;
+    }
+}
+
+template <MLAS_BLK_QUANT_TYPE QType>
+void
+MLASCALL
+MlasQ4GemvKernelNeon(
+    const float* A,
+    const uint8_t* PackedB,
+    const float* Bias,
+    float* C,
+    size_t CountN,
+    size_t CountK
+    )
+{
+    const MLAS_Q4_BLK_LAYOUT Layout = MlasQ4GetBlkLayout(QType);
+    const size_t ColumnStride = MlasDivRoundup(CountK, Layout.BlkLen) * Layout.BlkSize();
+
+    size_t n = 0;
+    for (; n + 4 <= CountN; n += 4) {
+        MlasQ4GemvColumnsNeon<QType, 4>(A, PackedB + ColumnStride * n, ColumnStride,
+                                        (Bias != nullptr) ? Bias + n : nullptr, C + n, CountK);
+    }
+    for (; n < CountN; n++) {
+        MlasQ4GemvColumnsNeon<QType, 1>(A, PackedB + ColumnStride * n, ColumnStride,
+                                        (Bias != nullptr) ? Bias + n : nullptr, C + n, CountK);
+    }
+}
+
+const MLAS_Q4GEMM_DISPATCH MlasQ4GemmDispatchNeon = {
+    {
+        MlasQ4GemvKernelNeon<BlkQ4Sym>,
+        MlasQ4GemvKernelNeon<BlkQ4Zp8>,
+        MlasQ4GemvKernelNeon<BlkQ4Sym64>,
+        MlasQ4GemvKernelNeon<BlkQ4Sym128>,
+    }
+};
@@ -0,0 +1,686 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    qdynamicgemm.cpp
+
+Abstract:
+
+    This module implements the dynamically quantized matrix/matrix multiply
+    operation, which multiplies a float matrix A with a quantized matrix B.
+
+    The rows of matrix A are quantized a block at a time to a buffer that
+    fits in the cache, and the block is multiplied by QGEMM right away,
+    instead of quantizing the whole of matrix A to memory first.
+
+    Columns of a block with outlier values, which would make the scales of
+    the rows coarse, can be multiplied in float instead (mixed precision
+    decomposition).
+
+--*/
+
+#include "mlasi.h"
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+//
+// Target size of a block of quantized rows of matrix A, which should stay in
+// the L2 cache, and the minimum and maximum number of rows of a block. QGEMM
+// is called once per block, so a block is not made smaller than the minimum
+// number of rows, which keeps the kernels efficient.
+//
+
+constexpr size_t MLAS_DYNAMIC_QGEMM_BLOCK_SIZE = 256 * 1024;
+constexpr size_t MLAS_DYNAMIC_QGEMM_MINIMUM_ROWS = 128;
+constexpr size_t MLAS_DYNAMIC_QGEMM_STRIDEM = 256;
+
+//
+// Zero point of matrix A with per-row scales.
+//
+
+constexpr uint8_t MLAS_DYNAMIC_QGEMM_ROW_ZERO_POINT = 128;
+
+//
+// Scale of matrix B when none is supplied.
+//
+
+static const float MlasDynamicQuantizeGemmUnitScale = 1.0f;
+
+class MLAS_DYNAMIC_QGEMM_OUTPUT_PROCESSOR : public MLAS_QGEMM_OUTPUT_PROCESSOR {
+public:
+    MLAS_DYNAMIC_QGEMM_OUTPUT_PROCESSOR(
+        float* Output,
+        size_t LeadingDimensionOutput,
+        const float* ScaleA,
+        bool PerRowScaleA,
+        const float* ScaleB,
+        bool PerColumnScaleB,
+        const float* Bias
+        )
+        : Output_(Output),
+          LeadingDimensionOutput_(LeadingDimensionOutput),
+          ScaleA_(ScaleA),
+          PerRowScaleA_(PerRowScaleA),
+          ScaleB_(ScaleB),
+          PerColumnScaleB_(PerColumnScaleB),
+          Bias_(Bias)
+    {
+    }
+
+    void
+    Process(
+        const int32_t* C,
+        size_t StartM,
+        size_t StartN,
+        size_t CountM,
+        size_t CountN,
+        size_t ldc
+        ) const override;
+
+private:
+    float* Output_;
+    size_t LeadingDimensionOutput_;
+    const float* ScaleA_;
+    bool PerRowScaleA_;
+    const float* ScaleB_;
+    bool PerColumnScaleB_;
+    const float* Bias_;
+};
+
+void
+MLAS_DYNAMIC_QGEMM_OUTPUT_PROCESSOR::Process(
+    const int32_t* C,
+    size_t StartM,
+    size_t StartN,
+    size_t CountM,
+    size_t CountN,
+    size_t ldc
+    ) const
+/*++
+
+Routine Description:
+
+    This routine converts the output matrix C to a floating point format,
+    scaled by the scale of the row of matrix A and the scale of matrix B, and
+    adds the bias.
+
+Arguments:
+
+    C - Supplies the address of matrix C.
+
+    StartM - Supplies the starting row offset relative to the matrix.
+
+    StartN - Supplies the starting column offset relative to the matrix.
+
+    CountM - Supplies the number of rows of the output matrix to process.
+
+    CountN - Supplies the number of columns of the output matrix to process.
+
+    ldc - Supplies the leading dimension of C.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const float* ScaleB = ScaleB_ + (PerColumnScaleB_ ? StartN : 0);
+    const float* Bias = (Bias_ != nullptr) ? Bias_ + StartN : nullptr;
+
+    C += StartM * ldc + StartN;
+    float* Output = Output_ + StartM * LeadingDimensionOutput_ + StartN;
+
+    for (size_t m = 0; m < CountM; m++) {
+
+        const float RowScale = ScaleA_[PerRowScaleA_ ? StartM + m : 0];
+        const float MatrixScale = PerColumnScaleB_ ? RowScale : RowScale * ScaleB[0];
+        const MLAS_FLOAT32X4 RowScaleVector = MlasBroadcastFloat32x4(MatrixScale);
+
+        float* c_out = Output;
+        const int32_t* c = C;
+        size_t n = 0;
+
+        for (; n + 4 <= CountN; n += 4) {
+
+            MLAS_FLOAT32X4 ScaleVector = RowScaleVector;
+
+            if (PerColumnScaleB_) {
+                ScaleVector = MlasMultiplyFloat32x4(ScaleVector, MlasLoadFloat32x4(ScaleB + n));
+            }
+
+            MLAS_FLOAT32X4 FloatVector = MlasMultiplyFloat32x4(MlasCastToFloat32x4(MlasLoadInt32x4(c + n)), ScaleVector);
+
+            if (Bias != nullptr) {
+                FloatVector = MlasAddFloat32x4(FloatVector, MlasLoadFloat32x4(Bias + n));
+            }
+
+            MlasStoreFloat32x4(c_out + n, FloatVector);
+        }
+
+        for (; n < CountN; n++) {
+
+            const float Scale = PerColumnScaleB_ ? RowScale * ScaleB[n] : MatrixScale;
+            float Value = float(c[n]) * Scale;
+
+            if (Bias != nullptr) {
+                Value += Bias[n];
+            }
+
+            c_out[n] = Value;
+        }
+
+        C += ldc;
+        Output += LeadingDimensionOutput_;
+    }
+}
+
+//
+// Structure to pass the dynamically quantized GEMM parameters to worker
+// threads.
+//
+
+struct MLAS_DYNAMIC_QGEMM_WORK_BLOCK {
+    ptrdiff_t ThreadCount;
+    const MLAS_GEMM_QUANT_SHAPE_PARAMS* Shape;
+    const MLAS_GEMM_DYNAMIC_QUANT_DATA_PARAMS* DataParams;
+    size_t BatchN;
+    size_t RowsPerBlock;
+    size_t BlockCountM;
+    bool PerRowScaleA;
+};
+
+void
+MlasDynamicQuantizeFindOutliers(
+    const MLAS_GEMM_DYNAMIC_QUANT_DATA_PARAMS& Data,
+    size_t StartM,
+    size_t CountM,
+    size_t K,
+    std::vector<size_t>& Outliers
+    )
+/*++
+
+Routine Description:
+
+    This routine finds the columns of a block of rows of matrix A that have a
+    value of a larger magnitude than the outlier threshold.
+
+Arguments:
+
+    Data - Supplies the data parameters of the operation.
+
+    StartM - Supplies the first row of the block.
+
+    CountM - Supplies the number of rows of the block.
+
+    K - Supplies the number of columns of matrix A.
+
+    Outliers - Returns the sorted indices of the outlier columns.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    Outliers.clear();
+
+    if (Data.OutlierThreshold <= 0.0f) {
+        return;
+    }
+
+    const float* a = Data.A + StartM * Data.lda;
+
+    for (size_t m = 0; m < CountM; m++) {
+
+        for (size_t k = 0; k < K; k++) {
+            if (std::fabs(a[k]) > Data.OutlierThreshold) {
+                Outliers.push_back(k);
+            }
+        }
+
+        a += Data.lda;
+    }
+
+    std::sort(Outliers.begin(), Outliers.end());
+    Outliers.erase(std::unique(Outliers.begin(), Outliers.end()), Outliers.end());
+}
+
+void
+MlasDynamicQuantizeAddOutliers(
+    const MLAS_GEMM_QUANT_SHAPE_PARAMS& Shape,
+    const MLAS_GEMM_DYNAMIC_QUANT_DATA_PARAMS& Data,
+    size_t StartM,
+    size_t CountM,
+    const std::vector<size_t>& Outliers,
+    float* RowB
+    )
+/*++
+
+Routine Description:
+
+    This routine adds the products of the outlier columns of a block of rows
+    of matrix A, in float, with the dequantized rows of matrix B to the output
+    of the block.
+
+Arguments:
+
+    Shape - Supplies the shape of the operation.
+
+    Data - Supplies the data parameters of the operation.
+
+    StartM - Supplies the first row of the block.
+
+    CountM - Supplies the number of rows of the block.
+
+    Outliers - Supplies the indices of the outlier columns.
+
+    RowB - Supplies a buffer of N elements for a dequantized row of matrix B.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t N = Shape.N;
+
+    for (size_t k : Outliers) {
+
+        const uint8_t* b = static_cast<const uint8_t*>(Data.B) + k * Data.ldb;
+
+        for (size_t n = 0; n < N; n++) {
+
+            const uint8_t ZeroPoint = Data.ZeroPointB[Data.PerColumnZeroPoints ? n : 0];
+            const int32_t Value = Shape.BIsSigned ? int32_t(int8_t(b[n])) - int32_t(int8_t(ZeroPoint))
+                                                  : int32_t(b[n]) - int32_t(ZeroPoint);
+            const float Scale = (Data.ScaleB != nullptr) ? Data.ScaleB[Data.PerColumnScaleB ? n : 0] : 1.0f;
+
+            RowB[n] = float(Value) * Scale;
+        }
+
+        for (size_t m = StartM; m < StartM + CountM; m++) {
+
+            const float AValue = Data.A[m * Data.lda + k];
+            const MLAS_FLOAT32X4 AVector = MlasBroadcastFloat32x4(AValue);
+            float* c = Data.C + m * Data.ldc;
+            size_t n = 0;
+
+            for (; n + 4 <= N; n += 4) {
+                MlasStoreFloat32x4(c + n, MlasMultiplyAddFloat32x4(AVector, MlasLoadFloat32x4(RowB + n),
+                                                                   MlasLoadFloat32x4(c + n)));
+            }
+
+            for (; n < N; n++) {
+                c[n] += AValue * RowB[n];
+            }
+        }
+    }
+}
+
+void
+MlasDynamicQuantizeRows(
+    const MLAS_GEMM_DYNAMIC_QUANT_DATA_PARAMS& Data,
+    size_t StartM,
+    size_t CountM,
+    size_t K,
+    bool PerRowScaleA,
+    const std::vector<size_t>& Outliers,
+    float* RowBuffer,
+    uint8_t* QuantA,
+    float* RowScales
+    )
+/*++
+
+Routine Description:
+
+    This routine quantizes a block of rows of matrix A.
+
+Arguments:
+
+    Data - Supplies the data parameters of the operation.
+
+    StartM - Supplies the first row of the block.
+
+    CountM - Supplies the number of rows of the block.
+
+    K - Supplies the number of columns of matrix A.
+
+    PerRowScaleA - Supplies true if each row is quantized with its own scale,
+        else the scale and zero point of the data parameters are used.
+
+    Outliers - Supplies the indices of the outlier columns, which are
+        quantized as zeros.
+
+    RowBuffer - Supplies a buffer of K elements for a row without its outlier
+        columns, used if there are outliers.
+
+    QuantA - Supplies the address of the quantized rows, with a leading
+        dimension of K.
+
+    RowScales - Supplies the address of the scales of the rows, written with
+        per-row scales.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const float* a = Data.A + StartM * Data.lda;
+
+    for (size_t m = 0; m < CountM; m++) {
+
+        const float* Row = a;
+
+        if (!Outliers.empty()) {
+            std::copy_n(a, K, RowBuffer);
+            for (size_t k : Outliers) {
+                RowBuffer[k] = 0.0f;
+            }
+            Row = RowBuffer;
+        }
+
+        float Scale = Data.ScaleA;
+        uint8_t ZeroPoint = Data.ZeroPointA;
+
+        if (PerRowScaleA) {
+
+            float Minimum = 0.0f;
+            float Maximum = 0.0f;
+
+            if (K > 0) {
+                MlasFindMinMaxElement(Row, &Minimum, &Maximum, K);
+            }
+
+            const float MaximumAbs = std::max(Maximum, -Minimum);
+
+            Scale = (MaximumAbs > 0.0f) ? MaximumAbs / 127.0f : 1.0f;
+            ZeroPoint = MLAS_DYNAMIC_QGEMM_ROW_ZERO_POINT;
+            RowScales[m] = Scale;
+        }
+
+        MlasQuantizeLinear<uint8_t>(Row, QuantA, K, Scale, ZeroPoint);
+
+        a += Data.lda;
+        QuantA += K;
+    }
+}
+
+void
+MlasDynamicQuantizeGemmThreaded(
+    void* Context,
+    ptrdiff_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of a
+    dynamically quantized GEMM operation. Each block of rows is quantized and
+    then multiplied while the quantized rows are in the cache.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    Index - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const auto* WorkBlock = (MLAS_DYNAMIC_QGEMM_WORK_BLOCK*)Context;
+
+    const size_t M = WorkBlock->Shape->M;
+    const size_t K = WorkBlock->Shape->K;
+    const size_t RowsPerBlock = WorkBlock->RowsPerBlock;
+    const bool PerRowScaleA = WorkBlock->PerRowScaleA;
+
+    size_t BlockStart;
+    size_t BlockCount;
+
+    MlasPartitionWork(Index, WorkBlock->ThreadCount, WorkBlock->BatchN * WorkBlock->BlockCountM,
+                      &BlockStart, &BlockCount);
+
+    if (BlockCount == 0) {
+        return;
+    }
+
+    //
+    // The buffer is allocated from the heap, as the thread local buffer of
+    // MLAS is used by QGEMM for the packed panels.
+    //
+
+    std::unique_ptr<uint8_t[]> Buffer(new uint8_t[RowsPerBlock * K]);
+    uint8_t* QuantA = Buffer.get();
+
+    float RowScales[MLAS_DYNAMIC_QGEMM_STRIDEM];
+
+    std::vector<size_t> Outliers;
+    std::vector<float> OutlierBuffer;
+
+    MLAS_GEMM_QUANT_SHAPE_PARAMS BlockShape = *WorkBlock->Shape;
+
+    for (size_t b = BlockStart; b < BlockStart + BlockCount; b++) {
+
+        const MLAS_GEMM_DYNAMIC_QUANT_DATA_PARAMS& Data = WorkBlock->DataParams[b / WorkBlock->BlockCountM];
+
+        const size_t StartM = (b % WorkBlock->BlockCountM) * RowsPerBlock;
+        const size_t CountM = std::min(M - StartM, RowsPerBlock);
+
+        MlasDynamicQuantizeFindOutliers(Data, StartM, CountM, K, Outliers);
+
+        if (!Outliers.empty()) {
+            OutlierBuffer.resize(std::max(K, WorkBlock->Shape->N));
+        }
+
+        MlasDynamicQuantizeRows(Data, StartM, CountM, K, PerRowScaleA, Outliers, OutlierBuffer.data(), QuantA,
+                                RowScales);
+
+        float* Output = Data.C + StartM * Data.ldc;
+
+        MLAS_DYNAMIC_QGEMM_OUTPUT_PROCESSOR OutputProcessor(
+            Output, Data.ldc, PerRowScaleA ? RowScales : &Data.ScaleA, PerRowScaleA,
+            (Data.ScaleB != nullptr) ? Data.ScaleB : &MlasDynamicQuantizeGemmUnitScale,
+            Data.PerColumnScaleB, Data.Bias);
+
+        MLAS_GEMM_QUANT_DATA_PARAMS BlockData;
+        BlockData.A = QuantA;
+        BlockData.lda = K;
+        BlockData.ZeroPointA = PerRowScaleA ? MLAS_DYNAMIC_QGEMM_ROW_ZERO_POINT : Data.ZeroPointA;
+        BlockData.B = Data.B;
+        BlockData.ldb = Data.ldb;
+        BlockData.ZeroPointB = Data.ZeroPointB;
+        BlockData.BIsPacked = Data.BIsPacked;
+        BlockData.PerColumnZeroPoints = Data.PerColumnZeroPoints;
+        BlockData.C = reinterpret_cast<int32_t*>(Output);
+        BlockData.ldc = Data.ldc;
+        BlockData.OutputProcessor = &OutputProcessor;
+
+        BlockShape.M = CountM;
+
+        MlasGemmBatch(BlockShape, &BlockData, 1, nullptr);
+
+        if (!Outliers.empty()) {
+            MlasDynamicQuantizeAddOutliers(*WorkBlock->Shape, Data, StartM, CountM, Outliers, OutlierBuffer.data());
+        }
+    }
+}
+
+void
+MLASCALL
+MlasDynamicQuantizeGemmBatch(
+    const MLAS_GEMM_QUANT_SHAPE_PARAMS& Shape,
+    const MLAS_GEMM_DYNAMIC_QUANT_DATA_PARAMS* DataParams,
+    const size_t BatchN,
+    bool PerRowScaleA,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine computes a batch of dynamically quantized matrix/matrix
+    multiply operations.
+
+Arguments:
+
+    Shape - Supplies the shape of the operations. Matrix A is quantized to
+        uint8, so AIsSigned must be false.
+
+    DataParams - Supplies the data parameters of the operations.
+
+    BatchN - Supplies the number of operations.
+
+    PerRowScaleA - Supplies true if each row of matrix A is quantized with its
+        own scale, else the scale and zero point of the data parameters are
+        used.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (Shape.AIsSigned || Shape.IsAccumulateMode) {
+        MLAS_THROW_EX(std::invalid_argument, "dynamically quantized GEMM requires unsigned A and overwrites C");
+    }
+
+    for (size_t gemm = 0; gemm < BatchN; gemm++) {
+        if (DataParams[gemm].OutlierThreshold > 0.0f && (!PerRowScaleA || DataParams[gemm].BIsPacked)) {
+            MLAS_THROW_EX(std::invalid_argument, "outlier columns require per-row scales and an unpacked B");
+        }
+    }
+
+    const size_t M = Shape.M;
+    const size_t N = Shape.N;
+    const size_t K = Shape.K;
+
+    if (M == 0 || N == 0 || BatchN == 0) {
+        return;
+    }
+
+    //
+    // Compute the number of target threads given the complexity of the
+    // operation, as done for the quantized GEMM.
+    //
+
+    const double Complexity = double(M) * double(N) * double(K) * double(BatchN);
+
+    ptrdiff_t TargetThreadCount;
+
+    if (Complexity < double(MLAS_QGEMM_THREAD_COMPLEXITY * GetMlasPlatform().MaximumThreadCount)) {
+        TargetThreadCount = ptrdiff_t(Complexity / double(MLAS_QGEMM_THREAD_COMPLEXITY)) + 1;
+    } else {
+        TargetThreadCount = GetMlasPlatform().MaximumThreadCount;
+    }
+
+    ptrdiff_t MaximumThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+    if (TargetThreadCount >= MaximumThreadCount) {
+        TargetThreadCount = MaximumThreadCount;
+    }
+
+    //
+    // Size the blocks of rows for the cache, and to give each thread at
+    // least one block when there are enough rows.
+    //
+
+    size_t RowsPerBlock = MLAS_DYNAMIC_QGEMM_BLOCK_SIZE / std::max(K, size_t(1));
+    RowsPerBlock = std::min(std::max(RowsPerBlock, MLAS_DYNAMIC_QGEMM_MINIMUM_ROWS), MLAS_DYNAMIC_QGEMM_STRIDEM);
+
+    const size_t ThreadsPerMatrix = MlasDivRoundup(size_t(TargetThreadCount), BatchN);
+
+    if (ThreadsPerMatrix > 1) {
+        RowsPerBlock = std::min(RowsPerBlock,
+                                std::max(MlasDivRoundup(M, ThreadsPerMatrix), MLAS_DYNAMIC_QGEMM_MINIMUM_ROWS));
+    }
+
+    RowsPerBlock = std::min(RowsPerBlock, M);
+
+    const size_t BlockCountM = MlasDivRoundup(M, RowsPerBlock);
+    const size_t TotalBlocks = BatchN * BlockCountM;
+
+    if (TotalBlocks >= size_t(TargetThreadCount)) {
+
+        MLAS_DYNAMIC_QGEMM_WORK_BLOCK WorkBlock;
+
+        WorkBlock.ThreadCount = TargetThreadCount;
+        WorkBlock.Shape = &Shape;
+        WorkBlock.DataParams = DataParams;
+        WorkBlock.BatchN = BatchN;
+        WorkBlock.RowsPerBlock = RowsPerBlock;
+        WorkBlock.BlockCountM = BlockCountM;
+        WorkBlock.PerRowScaleA = PerRowScaleA;
+
+        MlasExecuteThreaded(MlasDynamicQuantizeGemmThreaded, &WorkBlock, TargetThreadCount, ThreadPool);
+        return;
+    }
+
+    //
+    // There are too few rows to keep the threads busy, as when a single token
+    // is processed. Quantize all the rows of matrix A, which are few, and let
+    // QGEMM split the columns of matrix B between the threads.
+    //
+
+    std::vector<uint8_t> QuantA(BatchN * M * K);
+    std::vector<float> RowScales(PerRowScaleA ? BatchN * M : 0);
+    std::vector<std::vector<size_t>> Outliers(BatchN);
+    std::vector<float> OutlierBuffer;
+    std::vector<MLAS_DYNAMIC_QGEMM_OUTPUT_PROCESSOR> OutputProcessors;
+    std::vector<MLAS_GEMM_QUANT_DATA_PARAMS> GemmData(BatchN);
+
+    OutputProcessors.reserve(BatchN);
+
+    for (size_t gemm = 0; gemm < BatchN; gemm++) {
+
+        const MLAS_GEMM_DYNAMIC_QUANT_DATA_PARAMS& Data = DataParams[gemm];
+        float* GemmRowScales = PerRowScaleA ? RowScales.data() + gemm * M : nullptr;
+
+        MlasDynamicQuantizeFindOutliers(Data, 0, M, K, Outliers[gemm]);
+
+        if (!Outliers[gemm].empty()) {
+            OutlierBuffer.resize(std::max(K, N));
+        }
+
+        MlasDynamicQuantizeRows(Data, 0, M, K, PerRowScaleA, Outliers[gemm], OutlierBuffer.data(),
+                                QuantA.data() + gemm * M * K, GemmRowScales);
+
+        OutputProcessors.emplace_back(
+            Data.C, Data.ldc, PerRowScaleA ? GemmRowScales : &Data.ScaleA, PerRowScaleA,
+            (Data.ScaleB != nullptr) ? Data.ScaleB : &MlasDynamicQuantizeGemmUnitScale,
+            Data.PerColumnScaleB, Data.Bias);
+
+        MLAS_GEMM_QUANT_DATA_PARAMS& Params = GemmData[gemm];
+        Params.A = QuantA.data() + gemm * M * K;
+        Params.lda = K;
+        Params.ZeroPointA = PerRowScaleA ? MLAS_DYNAMIC_QGEMM_ROW_ZERO_POINT : Data.ZeroPointA;
+        Params.B = Data.B;
+        Params.ldb = Data.ldb;
+        Params.ZeroPointB = Data.ZeroPointB;
+        Params.BIsPacked = Data.BIsPacked;
+        Params.PerColumnZeroPoints = Data.PerColumnZeroPoints;
+        Params.C = reinterpret_cast<int32_t*>(Data.C);
+        Params.ldc = Data.ldc;
+        Params.OutputProcessor = &OutputProcessors[gemm];
+    }
+
+    MlasGemmBatch(Shape, GemmData.data(), BatchN, ThreadPool);
+
+    for (size_t gemm = 0; gemm < BatchN; gemm++) {
+        if (!Outliers[gemm].empty()) {
+            MlasDynamicQuantizeAddOutliers(Shape, DataParams[gemm], 0, M, Outliers[gemm], OutlierBuffer.data());
+        }
+    }
+}
@@ -0,0 +1,481 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    qgemm_kernel_smmla.cpp
+
+Abstract:
+
+    This module implements the QGEMM kernel for signed matrices A and B using
+    the ARMv8.6 I8MM SMMLA instruction.
+
+    SMMLA multiplies a 2x8 block of matrix A by an 8x2 block of matrix B and
+    accumulates the 2x2 result, which doubles the multiply throughput of the
+    SDOT kernel.
+
+--*/
+
+#include "mlasi.h"
+#include "qgemm.h"
+
+struct MLAS_GEMM_S8S8_KERNEL_SMMLA
+{
+    typedef uint8_t PackedAType;
+    typedef uint8_t PackedBType;
+    typedef int8_t OffsetAType;
+    typedef int8_t OffsetBType;
+
+    static constexpr size_t PackedK = 8;
+    static constexpr MLAS_GEMM_QUANT_STRIDES Strides{ 24, 128, 256 };
+    static constexpr MLAS_GEMM_QUANT_STRIDES PackedStrides{ 24, 128, 384 };
+};
+
+constexpr size_t MLAS_GEMM_S8S8_KERNEL_SMMLA::PackedK;
+constexpr MLAS_GEMM_QUANT_STRIDES MLAS_GEMM_S8S8_KERNEL_SMMLA::Strides;
+constexpr MLAS_GEMM_QUANT_STRIDES MLAS_GEMM_S8S8_KERNEL_SMMLA::PackedStrides;
+
+//
+// Returns the number of rows of matrix A handled by one call of the kernel.
+// The packing of matrix A uses the same blocking.
+//
+
+MLAS_FORCEINLINE
+size_t
+MlasGemmS8S8SmmlaRowCount(
+    size_t CountM
+    )
+{
+    return (CountM >= 8) ? 8 : (CountM >= 4) ? 4 : (CountM >= 2) ? 2 : 1;
+}
+
+template<>
+MLAS_FORCEINLINE
+int32_t
+MlasGemmQuantFixupZeroPointB<MLAS_GEMM_S8S8_KERNEL_SMMLA>(
+    int32_t ZeroPointB,
+    bool BIsSigned
+    )
+{
+    MLAS_UNREFERENCED_PARAMETER(BIsSigned);
+    return ZeroPointB;
+}
+
+template<>
+void
+MlasGemmQuantCopyPackA<MLAS_GEMM_S8S8_KERNEL_SMMLA>(
+    MLAS_GEMM_S8S8_KERNEL_SMMLA::PackedAType* D_uint8_t,
+    const uint8_t* A_uint8_t,
+    size_t lda,
+    size_t CountM,
+    size_t CountK,
+    int32_t* RowSumBuffer,
+    bool AIsSigned
+    )
+{
+    MLAS_UNREFERENCED_PARAMETER(AIsSigned);
+
+    int8_t* D = reinterpret_cast<int8_t*>(D_uint8_t);
+    const int8_t* A = reinterpret_cast<const int8_t*>(A_uint8_t);
+
+    const size_t AlignedCountK = (CountK + 7) & ~size_t(7);
+
+    //
+    // Process a block of 8, 4, 2 or 1 rows of matrix A.
+    //
+    // SMMLA loads a 2x8 block of A with one vector register. So A is packed as
+    // a series of 8 byte rows of each block, which places each pair of rows
+    // in one vector:
+    //
+    //      [ A0 A1 A2 A3 A4 A5 A6 A7 B0 B1 B2 B3 B4 B5 B6 B7 ]
+    //      [ C0 C1 C2 C3 C4 C5 C6 C7 D0 D1 D2 D3 D4 D5 D6 D7 ]
+    //      ...
+    //      [ A8 A9 A10 ...                                   ]
+    //
+    // If CountK is not aligned to a multiple of eight, then the rows are padded
+    // with zeroes.
+    //
+
+    while (CountM > 0) {
+
+        const size_t RowCount = MlasGemmS8S8SmmlaRowCount(CountM);
+
+        for (size_t r = 0; r < RowCount; r++) {
+
+            const int8_t* a = A + r * lda;
+            int8_t* d = D + r * 8;
+            int32_t RowSum = 0;
+            size_t k = CountK;
+
+            while (k >= 8) {
+
+                int8x8_t Bytes = vld1_s8(a);
+                vst1_s8(d, Bytes);
+                RowSum += vaddlv_s8(Bytes);
+
+                a += 8;
+                d += RowCount * 8;
+                k -= 8;
+            }
+
+            if (k > 0) {
+
+                int8_t PaddedRow[8] = {};
+                std::copy_n(a, k, PaddedRow);
+
+                int8x8_t Bytes = vld1_s8(PaddedRow);
+                vst1_s8(d, Bytes);
+                RowSum += vaddlv_s8(Bytes);
+            }
+
+            RowSumBuffer[r] = RowSum;
+        }
+
+        A += RowCount * lda;
+        D += RowCount * AlignedCountK;
+        RowSumBuffer += RowCount;
+        CountM -= RowCount;
+    }
+}
+
+MLAS_FORCEINLINE
+void
+MlasGemmS8S8CopyPackBProcessSmmla(
+    int8_t* D,
+    int8x8_t BytesRows[8],
+    int32x4_t ColumnSums[2]
+    )
+{
+    //
+    // Accumulate the column sums before the rows are transposed.
+    //
+
+    int16x8_t Sums = vaddl_s8(BytesRows[0], BytesRows[1]);
+    Sums = vaddw_s8(Sums, BytesRows[2]);
+    Sums = vaddw_s8(Sums, BytesRows[3]);
+    Sums = vaddw_s8(Sums, BytesRows[4]);
+    Sums = vaddw_s8(Sums, BytesRows[5]);
+    Sums = vaddw_s8(Sums, BytesRows[6]);
+    Sums = vaddw_s8(Sums, BytesRows[7]);
+
+    ColumnSums[0] = vaddw_s16(ColumnSums[0], vget_low_s16(Sums));
+    ColumnSums[1] = vaddw_s16(ColumnSums[1], vget_high_s16(Sums));
+
+    //
+    // Transpose the 8x8 block so that each column is stored as 8 bytes.
+    //
+
+    int8x8x2_t t01 = vtrn_s8(BytesRows[0], BytesRows[1]);
+    int8x8x2_t t23 = vtrn_s8(BytesRows[2], BytesRows[3]);
+    int8x8x2_t t45 = vtrn_s8(BytesRows[4], BytesRows[5]);
+    int8x8x2_t t67 = vtrn_s8(BytesRows[6], BytesRows[7]);
+
+    int16x4x2_t u02 = vtrn_s16(vreinterpret_s16_s8(t01.val[0]), vreinterpret_s16_s8(t23.val[0]));
+    int16x4x2_t u13 = vtrn_s16(vreinterpret_s16_s8(t01.val[1]), vreinterpret_s16_s8(t23.val[1]));
+    int16x4x2_t u46 = vtrn_s16(vreinterpret_s16_s8(t45.val[0]), vreinterpret_s16_s8(t67.val[0]));
+    int16x4x2_t u57 = vtrn_s16(vreinterpret_s16_s8(t45.val[1]), vreinterpret_s16_s8(t67.val[1]));
+
+    int32x2x2_t v04 = vtrn_s32(vreinterpret_s32_s16(u02.val[0]), vreinterpret_s32_s16(u46.val[0]));
+    int32x2x2_t v15 = vtrn_s32(vreinterpret_s32_s16(u13.val[0]), vreinterpret_s32_s16(u57.val[0]));
+    int32x2x2_t v26 = vtrn_s32(vreinterpret_s32_s16(u02.val[1]), vreinterpret_s32_s16(u46.val[1]));
+    int32x2x2_t v37 = vtrn_s32(vreinterpret_s32_s16(u13.val[1]), vreinterpret_s32_s16(u57.val[1]));
+
+    vst1_s8(&D[0], vreinterpret_s8_s32(v04.val[0]));
+    vst1_s8(&D[8], vreinterpret_s8_s32(v15.val[0]));
+    vst1_s8(&D[16], vreinterpret_s8_s32(v26.val[0]));
+    vst1_s8(&D[24], vreinterpret_s8_s32(v37.val[0]));
+    vst1_s8(&D[32], vreinterpret_s8_s32(v04.val[1]));
+    vst1_s8(&D[40], vreinterpret_s8_s32(v15.val[1]));
+    vst1_s8(&D[48], vreinterpret_s8_s32(v26.val[1]));
+    vst1_s8(&D[56], vreinterpret_s8_s32(v37.val[1]));
+}
+
+template<>
+void
+MlasGemmQuantCopyPackB<MLAS_GEMM_S8S8_KERNEL_SMMLA>(
+    MLAS_GEMM_S8S8_KERNEL_SMMLA::PackedBType* D_uint8_t,
+    const uint8_t* B_uint8_t,
+    size_t ldb,
+    size_t CountN,
+    size_t CountK,
+    int32_t* ColumnSumBuffer,
+    bool BIsSigned
+    )
+{
+    MLAS_UNREFERENCED_PARAMETER(BIsSigned);
+
+    int8_t* D = reinterpret_cast<int8_t*>(D_uint8_t);
+    const int8_t* B = reinterpret_cast<const int8_t*>(B_uint8_t);
+    int8x8_t BytesRows[8];
+
+    //
+    // Process 8 columns of matrix B in a loop.
+    //
+    // SMMLA loads an 8x2 block of B with one vector register. So B is packed
+    // as a series of 64 byte blocks that hold 8 bytes of each column:
+    //
+    //      [ A0 A1 A2 A3 A4 A5 A6 A7 B0 B1 B2 B3 B4 B5 B6 B7 ]
+    //      [ C0 C1 C2 C3 C4 C5 C6 C7 D0 D1 D2 D3 D4 D5 D6 D7 ]
+    //      [ E0 E1 E2 E3 E4 E5 E6 E7 F0 F1 F2 F3 F4 F5 F6 F7 ]
+    //      [ G0 G1 G2 G3 G4 G5 G6 G7 H0 H1 H2 H3 H4 H5 H6 H7 ]
+    //
+    // If CountK is not aligned to a multiple of eight, then the packed buffer
+    // is padded with zeroes.
+    //
+    // If CountN is not aligned to a multiple of eight, then the extra columns
+    // are padded with zeroes.
+    //
+
+    while (CountN > 0) {
+
+        const size_t CountColumns = std::min(CountN, size_t(8));
+        const int8_t* b = B;
+        size_t k = CountK;
+        int32x4_t ColumnSums[2];
+
+        ColumnSums[0] = vmovq_n_s32(0);
+        ColumnSums[1] = vmovq_n_s32(0);
+
+        while (k > 0) {
+
+            const size_t CountRows = std::min(k, size_t(8));
+
+            if (CountColumns == 8 && CountRows == 8) {
+
+                for (size_t r = 0; r < 8; r++) {
+                    BytesRows[r] = vld1_s8(&b[ldb * r]);
+                }
+
+            } else {
+
+                int8_t PaddedRows[8][8] = {};
+
+                for (size_t r = 0; r < CountRows; r++) {
+                    std::copy_n(&b[ldb * r], CountColumns, PaddedRows[r]);
+                }
+
+                for (size_t r = 0; r < 8; r++) {
+                    BytesRows[r] = vld1_s8(PaddedRows[r]);
+                }
+            }
+
+            MlasGemmS8S8CopyPackBProcessSmmla(D, BytesRows, ColumnSums);
+
+            b += ldb * CountRows;
+            D += 64;
+            k -= CountRows;
+        }
+
+        vst1q_s32(&ColumnSumBuffer[0], ColumnSums[0]);
+        vst1q_s32(&ColumnSumBuffer[4], ColumnSums[1]);
+
+        B += CountColumns;
+        ColumnSumBuffer += 8;
+        CountN -= CountColumns;
+    }
+}
+
+MLAS_FORCEINLINE
+void
+MlasGemmS8S8StoreRowSmmla(
+    int32_t* C,
+    int32x4_t Accumulators0,
+    int32x4_t Accumulators1,
+    size_t CountN,
+    bool ZeroMode
+    )
+{
+    if (CountN >= 8) {
+
+        if (!ZeroMode) {
+            Accumulators0 = vaddq_s32(Accumulators0, vld1q_s32(&C[0]));
+            Accumulators1 = vaddq_s32(Accumulators1, vld1q_s32(&C[4]));
+        }
+
+        vst1q_s32(&C[0], Accumulators0);
+        vst1q_s32(&C[4], Accumulators1);
+
+    } else {
+
+        int32_t Row[8];
+
+        vst1q_s32(&Row[0], Accumulators0);
+        vst1q_s32(&Row[4], Accumulators1);
+
+        for (size_t n = 0; n < CountN; n++) {
+            C[n] = ZeroMode ? Row[n] : C[n] + Row[n];
+        }
+    }
+}
+
+template<size_t RowCount>
+MLAS_FORCEINLINE
+void
+MlasGemmS8S8KernelSmmla(
+    const int8_t* A,
+    const int8_t* B,
+    int32_t* C,
+    size_t PackedCountK,
+    size_t CountN,
+    size_t ldc,
+    const int32_t* RowSumBuffer,
+    const int32_t* ColumnSumBuffer,
+    const int32_t* ZeroPointB,
+    bool ZeroMode
+    )
+/*++
+
+Routine Description:
+
+    This routine multiplies a block of RowCount rows of the packed matrix A by
+    the packed matrix B, eight columns at a time.
+
+    Each accumulator holds the 2x2 result of a pair of rows and a pair of
+    columns:
+
+        [ R0C0 R0C1 R1C0 R1C1 ]
+
+    A block of one row is multiplied with a zero second row.
+
+--*/
+{
+    constexpr size_t PairCount = (RowCount + 1) / 2;
+
+    while (CountN > 0) {
+
+        int32x4_t Accumulators[PairCount][4];
+
+        for (size_t p = 0; p < PairCount; p++) {
+            for (size_t j = 0; j < 4; j++) {
+                Accumulators[p][j] = vmovq_n_s32(0);
+            }
+        }
+
+        const int8_t* a = A;
+        const int8_t* b = B;
+
+        for (size_t k = 0; k < PackedCountK; k++) {
+
+            int8x16_t BColumns[4];
+
+            for (size_t j = 0; j < 4; j++) {
+                BColumns[j] = vld1q_s8(&b[j * 16]);
+            }
+
+            for (size_t p = 0; p < PairCount; p++) {
+
+                int8x16_t ARows = (RowCount == 1) ? vcombine_s8(vld1_s8(a), vdup_n_s8(0))
+                                                  : vld1q_s8(&a[p * 16]);
+
+                for (size_t j = 0; j < 4; j++) {
+                    Accumulators[p][j] = vmmlaq_s32(Accumulators[p][j], ARows, BColumns[j]);
+                }
+            }
+
+            a += RowCount * 8;
+            b += 64;
+        }
+
+        //
+        // Apply the row and column sums, then store the rows of the result.
+        //
+
+        const int32x4_t ColumnSums0 = vld1q_s32(&ColumnSumBuffer[0]);
+        const int32x4_t ColumnSums1 = vld1q_s32(&ColumnSumBuffer[4]);
+
+        for (size_t r = 0; r < RowCount; r++) {
+
+            const size_t p = r / 2;
+            int32x4_t Row0;
+            int32x4_t Row1;
+
+            if ((r & 1) == 0) {
+                Row0 = vcombine_s32(vget_low_s32(Accumulators[p][0]), vget_low_s32(Accumulators[p][1]));
+                Row1 = vcombine_s32(vget_low_s32(Accumulators[p][2]), vget_low_s32(Accumulators[p][3]));
+            } else {
+                Row0 = vcombine_s32(vget_high_s32(Accumulators[p][0]), vget_high_s32(Accumulators[p][1]));
+                Row1 = vcombine_s32(vget_high_s32(Accumulators[p][2]), vget_high_s32(Accumulators[p][3]));
+            }
+
+            const int32x4_t RowSum = vdupq_n_s32(RowSumBuffer[r]);
+
+            if (ZeroPointB != nullptr) {
+                Row0 = vmlaq_s32(Row0, RowSum, vld1q_s32(&ZeroPointB[0]));
+                Row1 = vmlaq_s32(Row1, RowSum, vld1q_s32(&ZeroPointB[4]));
+            } else {
+                Row0 = vaddq_s32(Row0, RowSum);
+                Row1 = vaddq_s32(Row1, RowSum);
+            }
+
+            Row0 = vaddq_s32(Row0, ColumnSums0);
+            Row1 = vaddq_s32(Row1, ColumnSums1);
+
+            MlasGemmS8S8StoreRowSmmla(C + r * ldc, Row0, Row1, CountN, ZeroMode);
+        }
+
+        const size_t CountColumns = std::min(CountN, size_t(8));
+
+        B += 64 * PackedCountK;
+        C += CountColumns;
+        ColumnSumBuffer += 8;
+        if (ZeroPointB != nullptr) {
+            ZeroPointB += 8;
+        }
+        CountN -= CountColumns;
+    }
+}
+
+template<>
+size_t
+MlasGemmQuantKernel<MLAS_GEMM_S8S8_KERNEL_SMMLA>(
+    const MLAS_GEMM_S8S8_KERNEL_SMMLA::PackedAType* A_uint8_t,
+    const MLAS_GEMM_S8S8_KERNEL_SMMLA::PackedBType* B_uint8_t,
+    int32_t* C,
+    size_t PackedCountK,
+    size_t CountM,
+    size_t CountN,
+    size_t ldc,
+    const int32_t* RowSumBuffer,
+    const int32_t* ColumnSumBuffer,
+    const int32_t* ZeroPointB,
+    bool ZeroMode
+    )
+{
+    const int8_t* A = reinterpret_cast<const int8_t*>(A_uint8_t);
+    const int8_t* B = reinterpret_cast<const int8_t*>(B_uint8_t);
+
+    const size_t RowCount = MlasGemmS8S8SmmlaRowCount(CountM);
+
+    switch (RowCount) {
+        case 8:
+            MlasGemmS8S8KernelSmmla<8>(A, B, C, PackedCountK, CountN, ldc,
+                RowSumBuffer, ColumnSumBuffer, ZeroPointB, ZeroMode);
+            break;
+        case 4:
+            MlasGemmS8S8KernelSmmla<4>(A, B, C, PackedCountK, CountN, ldc,
+                RowSumBuffer, ColumnSumBuffer, ZeroPointB, ZeroMode);
+            break;
+        case 2:
+            MlasGemmS8S8KernelSmmla<2>(A, B, C, PackedCountK, CountN, ldc,
+                RowSumBuffer, ColumnSumBuffer, ZeroPointB, ZeroMode);
+            break;
+        default:
+            MlasGemmS8S8KernelSmmla<1>(A, B, C, PackedCountK, CountN, ldc,
+                RowSumBuffer, ColumnSumBuffer, ZeroPointB, ZeroMode);
+            break;
+    }
+
+    return RowCount;
+}
+
+const MLAS_GEMM_QUANT_DISPATCH MlasGemmS8S8DispatchSmmla = {
+    MlasGemmQuantOperation<MLAS_GEMM_S8S8_KERNEL_SMMLA>,
+    MlasGemmQuantPackedOperation<MLAS_GEMM_S8S8_KERNEL_SMMLA>,
+    MlasGemmQuantCopyPackB<MLAS_GEMM_S8S8_KERNEL_SMMLA>,
+    MLAS_GEMM_S8S8_KERNEL_SMMLA::PackedK,
+    MLAS_GEMM_S8S8_KERNEL_SMMLA::PackedStrides.K,
+    8
+};
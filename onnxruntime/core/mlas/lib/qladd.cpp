@@ -654,6 +654,122 @@ MlasQLinearAdd<uint8_t>(
             InputA, ScaleA, ZeroPointA, InputB, ScaleB, ZeroPointB, ScaleC, ZeroPointC, OutputC, N, IsScalarB);
 }
 
+template<typename DataType>
+void
+MLASCALL
+MlasQLinearAddLookup(
+    const DataType* InputA,
+    float ScaleA,
+    int32_t ZeroPointA,
+    const DataType* InputB,
+    float ScaleB,
+    int32_t ZeroPointB,
+    float ScaleC,
+    int32_t ZeroPointC,
+    const DataType* Table,
+    DataType* OutputC,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine adds two quantized vectors and optionally maps the sums
+    through the lookup table of a quantized activation.
+
+    The sums are produced in blocks on the stack, so the output may alias
+    either input and the table lookup reads the sums while they are in cache.
+
+Arguments:
+
+    InputA - Supplies the first input vector.
+
+    ScaleA - Supplies the scale of the first input.
+
+    ZeroPointA - Supplies the zero point of the first input.
+
+    InputB - Supplies the second input vector.
+
+    ScaleB - Supplies the scale of the second input.
+
+    ZeroPointB - Supplies the zero point of the second input.
+
+    ScaleC - Supplies the scale of the sums.
+
+    ZeroPointC - Supplies the zero point of the sums.
+
+    Table - Supplies the optional lookup table of 256 entries, indexed by the
+        bit pattern of the quantized sums.
+
+    OutputC - Returns the output vector.
+
+    N - Supplies the number of elements.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    constexpr size_t BlockSize = 256;
+    DataType Block[BlockSize];
+
+    while (N > 0) {
+
+        const size_t CountN = std::min(N, BlockSize);
+
+        MlasQLinearAdd<DataType>(InputA, ScaleA, ZeroPointA, InputB, ScaleB, ZeroPointB,
+                                 ScaleC, ZeroPointC, Block, CountN, false);
+
+        if (Table != nullptr) {
+            for (size_t n = 0; n < CountN; n++) {
+                OutputC[n] = Table[static_cast<uint8_t>(Block[n])];
+            }
+        } else {
+            std::copy_n(Block, CountN, OutputC);
+        }
+
+        InputA += CountN;
+        InputB += CountN;
+        OutputC += CountN;
+        N -= CountN;
+    }
+}
+
+template
+void
+MLASCALL
+MlasQLinearAddLookup<int8_t>(
+    const int8_t* InputA,
+    float ScaleA,
+    int32_t ZeroPointA,
+    const int8_t* InputB,
+    float ScaleB,
+    int32_t ZeroPointB,
+    float ScaleC,
+    int32_t ZeroPointC,
+    const int8_t* Table,
+    int8_t* OutputC,
+    size_t N
+    );
+
+template
+void
+MLASCALL
+MlasQLinearAddLookup<uint8_t>(
+    const uint8_t* InputA,
+    float ScaleA,
+    int32_t ZeroPointA,
+    const uint8_t* InputB,
+    float ScaleB,
+    int32_t ZeroPointB,
+    float ScaleC,
+    int32_t ZeroPointC,
+    const uint8_t* Table,
+    uint8_t* OutputC,
+    size_t N
+    );
+
 //
 // Function definition for platform usage
 //
@@ -0,0 +1,129 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    rotary_embedding.cpp
+
+Abstract:
+
+    This module implements rotary position embedding (RoPE) for one row of a
+    single attention head.
+
+--*/
+
+#include "mlasi.h"
+
+void
+MLASCALL
+MlasRotaryEmbedOneRow(
+    const float* Input,
+    const float* SinData,
+    const float* CosData,
+    size_t RotaryEmbeddingDim,
+    bool Interleaved,
+    float* Output
+    )
+/*++
+
+Routine Description:
+
+    This routine rotates the pairs of a row by the angles whose sine and cosine
+    are supplied.
+
+    For the non-interleaved layout, element i is paired with element
+    i + RotaryEmbeddingDim / 2. For the interleaved layout, element 2i is paired
+    with element 2i + 1. Each pair (x0, x1) becomes
+
+        (x0 * cos - x1 * sin, x1 * cos + x0 * sin).
+
+Arguments:
+
+    Input - Supplies the input row of RotaryEmbeddingDim elements.
+
+    SinData - Supplies RotaryEmbeddingDim / 2 sine values.
+
+    CosData - Supplies RotaryEmbeddingDim / 2 cosine values.
+
+    RotaryEmbeddingDim - Supplies the number of elements to rotate. Must be
+        even.
+
+    Interleaved - Supplies true if pairs are adjacent elements.
+
+    Output - Returns the rotated row. May be the same buffer as Input.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t HalfDim = RotaryEmbeddingDim / 2;
+    size_t i = 0;
+
+    if (Interleaved) {
+
+        //
+        // Each iteration handles four pairs using four sine/cosine values.
+        //
+
+        const MLAS_FLOAT32X4 SignMask = MlasReinterpretAsFloat32x4(
+            MlasBroadcastInt32x4(static_cast<int32_t>(0x80000000u)));
+        const MLAS_FLOAT32X4 SignEven = MlasInterleaveLowFloat32x4(SignMask, MlasZeroFloat32x4());
+
+        for (; i + 4 <= HalfDim; i += 4) {
+
+            MLAS_FLOAT32X4 Cos = MlasLoadFloat32x4(CosData + i);
+            MLAS_FLOAT32X4 Sin = MlasLoadFloat32x4(SinData + i);
+
+            MLAS_FLOAT32X4 CosLow = MlasInterleaveLowFloat32x4(Cos, Cos);
+            MLAS_FLOAT32X4 CosHigh = MlasInterleaveHighFloat32x4(Cos, Cos);
+            MLAS_FLOAT32X4 SinLow = MlasXorFloat32x4(MlasInterleaveLowFloat32x4(Sin, Sin), SignEven);
+            MLAS_FLOAT32X4 SinHigh = MlasXorFloat32x4(MlasInterleaveHighFloat32x4(Sin, Sin), SignEven);
+
+            MLAS_FLOAT32X4 XLow = MlasLoadFloat32x4(Input + 2 * i);
+            MLAS_FLOAT32X4 XHigh = MlasLoadFloat32x4(Input + 2 * i + 4);
+            MLAS_FLOAT32X4 SwappedLow = MlasShuffleFloat32x4<1, 0, 3, 2>(XLow);
+            MLAS_FLOAT32X4 SwappedHigh = MlasShuffleFloat32x4<1, 0, 3, 2>(XHigh);
+
+            XLow = MlasMultiplyAddFloat32x4(SwappedLow, SinLow, MlasMultiplyFloat32x4(XLow, CosLow));
+            XHigh = MlasMultiplyAddFloat32x4(SwappedHigh, SinHigh, MlasMultiplyFloat32x4(XHigh, CosHigh));
+
+            MlasStoreFloat32x4(Output + 2 * i, XLow);
+            MlasStoreFloat32x4(Output + 2 * i + 4, XHigh);
+        }
+
+        for (; i < HalfDim; i++) {
+            const float X0 = Input[2 * i];
+            const float X1 = Input[2 * i + 1];
+            Output[2 * i] = X0 * CosData[i] - X1 * SinData[i];
+            Output[2 * i + 1] = X1 * CosData[i] + X0 * SinData[i];
+        }
+
+    } else {
+
+        for (; i + 4 <= HalfDim; i += 4) {
+
+            MLAS_FLOAT32X4 Cos = MlasLoadFloat32x4(CosData + i);
+            MLAS_FLOAT32X4 Sin = MlasLoadFloat32x4(SinData + i);
+            MLAS_FLOAT32X4 X0 = MlasLoadFloat32x4(Input + i);
+            MLAS_FLOAT32X4 X1 = MlasLoadFloat32x4(Input + i + HalfDim);
+
+            MLAS_FLOAT32X4 Y0 = MlasSubtractFloat32x4(MlasMultiplyFloat32x4(X0, Cos), MlasMultiplyFloat32x4(X1, Sin));
+            MLAS_FLOAT32X4 Y1 = MlasMultiplyAddFloat32x4(X0, Sin, MlasMultiplyFloat32x4(X1, Cos));
+
+            MlasStoreFloat32x4(Output + i, Y0);
+            MlasStoreFloat32x4(Output + i + HalfDim, Y1);
+        }
+
+        for (; i < HalfDim; i++) {
+            const float X0 = Input[i];
+            const float X1 = Input[i + HalfDim];
+            Output[i] = X0 * CosData[i] - X1 * SinData[i];
+            Output[i + HalfDim] = X1 * CosData[i] + X0 * SinData[i];
+        }
+    }
+}
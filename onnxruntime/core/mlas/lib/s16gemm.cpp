@@ -0,0 +1,392 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    s16gemm.cpp
+
+Abstract:
+
+    This module implements the int16 matrix/matrix multiply operation with
+    int32 accumulation (S16GEMM).
+
+    Matrix B is packed one block of MLAS_GEMM_S16_STRIDEK rows by
+    MLAS_GEMM_S16_STRIDEN columns at a time, and the kernel streams the rows
+    of A over the packed block.
+
+--*/
+
+#include "s16gemm.h"
+
+//
+// Structure to pass the S16GEMM parameters to worker threads.
+//
+
+struct MLAS_GEMM_S16_WORK_BLOCK {
+    ptrdiff_t ThreadCountM;
+    ptrdiff_t ThreadCountN;
+    size_t M;
+    size_t N;
+    size_t K;
+    const int16_t* A;
+    size_t lda;
+    const int16_t* B;
+    size_t ldb;
+    int32_t* C;
+    size_t ldc;
+};
+
+void
+MlasGemmS16PackB(
+    int16_t* D,
+    const int16_t* B,
+    size_t ldb,
+    size_t CountN,
+    size_t CountK
+    )
+/*++
+
+Routine Description:
+
+    This routine packs a block of matrix B to the panels consumed by the
+    kernels, see s16gemm.h.
+
+Arguments:
+
+    D - Supplies the address of the packed panels.
+
+    B - Supplies the address of the source block.
+
+    ldb - Supplies the first dimension of matrix B.
+
+    CountN - Supplies the number of columns to pack.
+
+    CountK - Supplies the number of rows to pack.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    for (size_t n = 0; n < CountN; n += MLAS_GEMM_S16_PANEL_N) {
+
+        const size_t PanelCountN = std::min(CountN - n, size_t(MLAS_GEMM_S16_PANEL_N));
+
+        for (size_t k = 0; k < CountK; k += 2) {
+
+            const int16_t* b0 = B + k * ldb + n;
+            const int16_t* b1 = (k + 1 < CountK) ? b0 + ldb : nullptr;
+
+            size_t nn = 0;
+
+            for (; nn < PanelCountN; nn++) {
+                D[nn * 2] = b0[nn];
+                D[nn * 2 + 1] = (b1 != nullptr) ? b1[nn] : 0;
+            }
+
+            for (; nn < MLAS_GEMM_S16_PANEL_N; nn++) {
+                D[nn * 2] = 0;
+                D[nn * 2 + 1] = 0;
+            }
+
+            D += MLAS_GEMM_S16_PANEL_N * 2;
+        }
+    }
+}
+
+size_t
+MLASCALL
+MlasGemmS16Kernel(
+    const int16_t* A,
+    const int16_t* PackedB,
+    int32_t* C,
+    size_t CountK,
+    size_t CountM,
+    size_t CountN,
+    size_t lda,
+    size_t ldc,
+    bool ZeroMode
+    )
+/*++
+
+Routine Description:
+
+    This routine is the portable kernel of the S16GEMM operation.
+
+Arguments:
+
+    A - Supplies the address of matrix A.
+
+    PackedB - Supplies the address of the packed panels of matrix B.
+
+    C - Supplies the address of matrix C.
+
+    CountK - Supplies the number of columns of matrix A and rows of matrix B
+        in the packed panels.
+
+    CountM - Supplies the maximum number of rows to process.
+
+    CountN - Supplies the number of columns to process.
+
+    lda - Supplies the first dimension of matrix A.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    ZeroMode - Supplies true if the output matrix is overwritten, else the
+        product is accumulated to the output matrix.
+
+Return Value:
+
+    Returns the number of rows processed.
+
+--*/
+{
+    const size_t RowCount = std::min(CountM, size_t(MLAS_GEMM_S16_KERNEL_ROWS));
+    const size_t PackedCountK = (CountK + 1) / 2;
+
+    for (size_t n = 0; n < CountN; n += MLAS_GEMM_S16_PANEL_N) {
+
+        const size_t PanelCountN = std::min(CountN - n, size_t(MLAS_GEMM_S16_PANEL_N));
+
+        for (size_t m = 0; m < RowCount; m++) {
+
+            int32_t Accumulators[MLAS_GEMM_S16_PANEL_N] = {};
+            const int16_t* a = A + m * lda;
+            const int16_t* b = PackedB;
+
+            for (size_t k = 0; k < CountK; k += 2) {
+
+                const int32_t a0 = a[k];
+                const int32_t a1 = (k + 1 < CountK) ? a[k + 1] : 0;
+
+                for (size_t nn = 0; nn < MLAS_GEMM_S16_PANEL_N; nn++) {
+                    Accumulators[nn] += a0 * b[nn * 2] + a1 * b[nn * 2 + 1];
+                }
+
+                b += MLAS_GEMM_S16_PANEL_N * 2;
+            }
+
+            int32_t* c = C + m * ldc + n;
+
+            for (size_t nn = 0; nn < PanelCountN; nn++) {
+                c[nn] = ZeroMode ? Accumulators[nn] : c[nn] + Accumulators[nn];
+            }
+        }
+
+        PackedB += PackedCountK * MLAS_GEMM_S16_PANEL_N * 2;
+    }
+
+    return RowCount;
+}
+
+void
+MlasGemmS16Threaded(
+    void* Context,
+    ptrdiff_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of a
+    S16GEMM operation.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    Index - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const auto* WorkBlock = (MLAS_GEMM_S16_WORK_BLOCK*)Context;
+
+    const ptrdiff_t ThreadIdM = Index / WorkBlock->ThreadCountN;
+    const ptrdiff_t ThreadIdN = Index % WorkBlock->ThreadCountN;
+
+    size_t RangeStartM;
+    size_t RangeCountM;
+
+    MlasPartitionWork(ThreadIdM, WorkBlock->ThreadCountM, WorkBlock->M, &RangeStartM, &RangeCountM);
+
+    //
+    // Partition the columns in units of panels, so that the threads do not
+    // share the cache lines of C.
+    //
+
+    const size_t PanelCount = MlasDivRoundup(WorkBlock->N, MLAS_GEMM_S16_PANEL_N);
+
+    size_t RangeStartN;
+    size_t RangeCountN;
+
+    MlasPartitionWork(ThreadIdN, WorkBlock->ThreadCountN, PanelCount, &RangeStartN, &RangeCountN);
+
+    RangeStartN *= MLAS_GEMM_S16_PANEL_N;
+    RangeCountN *= MLAS_GEMM_S16_PANEL_N;
+
+    if (RangeStartN >= WorkBlock->N || RangeCountM == 0) {
+        return;
+    }
+
+    RangeCountN = std::min(WorkBlock->N - RangeStartN, RangeCountN);
+
+#if defined(MLAS_TARGET_AMD64)
+    MLAS_GEMM_S16_KERNEL* Kernel = GetMlasPlatform().GemmS16Kernel;
+#else
+    MLAS_GEMM_S16_KERNEL* Kernel = MlasGemmS16Kernel;
+#endif
+
+    MLAS_DECLSPEC_ALIGN(int16_t PanelB[MLAS_GEMM_S16_STRIDEN * MLAS_GEMM_S16_STRIDEK], 64);
+
+    const size_t K = WorkBlock->K;
+    const size_t lda = WorkBlock->lda;
+    const size_t ldc = WorkBlock->ldc;
+
+    for (size_t n = 0; n < RangeCountN; n += MLAS_GEMM_S16_STRIDEN) {
+
+        const size_t CountN = std::min(RangeCountN - n, size_t(MLAS_GEMM_S16_STRIDEN));
+
+        for (size_t k = 0; k < K; k += MLAS_GEMM_S16_STRIDEK) {
+
+            const size_t CountK = std::min(K - k, size_t(MLAS_GEMM_S16_STRIDEK));
+
+            MlasGemmS16PackB(PanelB, WorkBlock->B + k * WorkBlock->ldb + RangeStartN + n,
+                             WorkBlock->ldb, CountN, CountK);
+
+            const int16_t* a = WorkBlock->A + RangeStartM * lda + k;
+            int32_t* c = WorkBlock->C + RangeStartM * ldc + RangeStartN + n;
+            size_t CountM = RangeCountM;
+
+            while (CountM > 0) {
+
+                const size_t RowsHandled = Kernel(a, PanelB, c, CountK, CountM, CountN, lda, ldc, k == 0);
+
+                a += RowsHandled * lda;
+                c += RowsHandled * ldc;
+                CountM -= RowsHandled;
+            }
+        }
+    }
+}
+
+void
+MLASCALL
+MlasGemmS16(
+    size_t M,
+    size_t N,
+    size_t K,
+    const int16_t* A,
+    size_t lda,
+    const int16_t* B,
+    size_t ldb,
+    int32_t* C,
+    size_t ldc,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the int16 matrix/matrix multiply operation with
+    int32 accumulation.
+
+Arguments:
+
+    M - Supplies the number of rows of matrix A and matrix C.
+
+    N - Supplies the number of columns of matrix B and matrix C.
+
+    K - Supplies the number of columns of matrix A and rows of matrix B.
+
+    A - Supplies the address of matrix A.
+
+    lda - Supplies the first dimension of matrix A.
+
+    B - Supplies the address of matrix B.
+
+    ldb - Supplies the first dimension of matrix B.
+
+    C - Supplies the address of matrix C.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (M == 0 || N == 0) {
+        return;
+    }
+
+    if (K == 0) {
+        for (size_t m = 0; m < M; m++) {
+            std::fill_n(C + m * ldc, N, 0);
+        }
+        return;
+    }
+
+    MLAS_GEMM_S16_WORK_BLOCK WorkBlock;
+
+    WorkBlock.M = M;
+    WorkBlock.N = N;
+    WorkBlock.K = K;
+    WorkBlock.A = A;
+    WorkBlock.lda = lda;
+    WorkBlock.B = B;
+    WorkBlock.ldb = ldb;
+    WorkBlock.C = C;
+    WorkBlock.ldc = ldc;
+
+    //
+    // Compute the number of target threads given the complexity of the
+    // operation, as done for the quantized GEMM.
+    //
+
+    const double Complexity = double(M) * double(N) * double(K);
+
+    ptrdiff_t TargetThreadCount;
+
+    if (Complexity < double(MLAS_QGEMM_THREAD_COMPLEXITY * GetMlasPlatform().MaximumThreadCount)) {
+        TargetThreadCount = ptrdiff_t(Complexity / double(MLAS_QGEMM_THREAD_COMPLEXITY)) + 1;
+    } else {
+        TargetThreadCount = GetMlasPlatform().MaximumThreadCount;
+    }
+
+    ptrdiff_t MaximumThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+    if (TargetThreadCount >= MaximumThreadCount) {
+        TargetThreadCount = MaximumThreadCount;
+    }
+
+    //
+    // Segment the operation across multiple threads along the larger of the
+    // two dimensions. Splitting M repacks the same columns of B in each
+    // thread, which is cheap next to the multiply of the rows.
+    //
+
+    const size_t PanelCount = MlasDivRoundup(N, MLAS_GEMM_S16_PANEL_N);
+
+    if (M >= N) {
+        WorkBlock.ThreadCountM = std::min(TargetThreadCount, ptrdiff_t(MlasDivRoundup(M, MLAS_GEMM_S16_KERNEL_ROWS)));
+        WorkBlock.ThreadCountN = 1;
+    } else {
+        WorkBlock.ThreadCountM = 1;
+        WorkBlock.ThreadCountN = std::min(TargetThreadCount, ptrdiff_t(PanelCount));
+    }
+
+    MlasExecuteThreaded(MlasGemmS16Threaded, &WorkBlock,
+                        WorkBlock.ThreadCountM * WorkBlock.ThreadCountN, ThreadPool);
+}
@@ -0,0 +1,63 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    s16gemm.h
+
+Abstract:
+
+    This module defines the packed layout of the int16 matrix/matrix multiply
+    operation with int32 accumulation (S16GEMM).
+
+    Matrix B is packed in panels of MLAS_GEMM_S16_PANEL_N columns. A panel
+    stores pairs of rows as interleaved int16 values, so each 32-bit element
+    holds B[k][n] and B[k+1][n]. This is the layout consumed by VPMADDWD and
+    VPDPWSSD, which multiply a broadcast pair of A with the pairs of 8 or 16
+    columns and sum each pair of products in int32. Columns past N and the
+    row past an odd K are padded with zeros.
+
+--*/
+
+#pragma once
+
+#include "mlasi.h"
+
+//
+// Define the shape of the packed panels and the strides to step through
+// slices of the input matrices.
+//
+
+#define MLAS_GEMM_S16_PANEL_N                       16
+#define MLAS_GEMM_S16_STRIDEN                       128
+#define MLAS_GEMM_S16_STRIDEK                       256
+
+//
+// Number of rows of A processed by one invocation of the kernel.
+//
+
+#define MLAS_GEMM_S16_KERNEL_ROWS                   4
+
+/**
+ * @brief Loads the pair A[k] and A[k+1] as a 32-bit value, as broadcast by
+ *        the kernels. The second value is zero if it is past the end of the
+ *        row.
+ *
+ * @param A         Address of A[k]
+ * @param CountK    Number of values of the row from A[k]
+ */
+MLAS_FORCEINLINE
+int32_t
+MlasGemmS16LoadPairA(
+    const int16_t* A,
+    size_t CountK
+    )
+{
+    const uint32_t Low = uint16_t(A[0]);
+    const uint32_t High = (CountK > 1) ? uint16_t(A[1]) : 0;
+
+    return int32_t(Low | (High << 16));
+}
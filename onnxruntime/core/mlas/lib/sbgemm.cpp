@@ -0,0 +1,695 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    sbgemm.cpp
+
+Abstract:
+
+    This module implements the single precision matrix/matrix multiply
+    operation computed with bfloat16 inputs and single precision accumulation
+    (SBGEMM).
+
+--*/
+
+#include "sbgemm.h"
+
+bool
+MLASCALL
+MlasBf16AccelerationSupported(
+    void
+    )
+{
+    return GetMlasPlatform().SBGemmDispatch != nullptr;
+}
+
+static
+void
+MlasSBGemmConvertPackA(
+    const MLAS_SBGEMM_DISPATCH* Dispatch,
+    uint16_t* D,
+    const float* A,
+    size_t lda,
+    CBLAS_TRANSPOSE TransA,
+    size_t CountM,
+    size_t CountK,
+    size_t PackedK
+    )
+/*++
+
+Routine Description:
+
+    This routine converts a block of matrix A to bfloat16 rows of PackedK
+    elements. The columns past CountK are zero filled.
+
+Arguments:
+
+    Dispatch - Supplies the SBGEMM dispatch of the platform.
+
+    D - Supplies the address of the bfloat16 block.
+
+    A - Supplies the address of matrix A.
+
+    lda - Supplies the first dimension of matrix A.
+
+    TransA - Supplies the transpose operation for matrix A.
+
+    CountM - Supplies the number of rows to convert.
+
+    CountK - Supplies the number of columns to convert.
+
+    PackedK - Supplies the number of columns of a converted row.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    float Row[MLAS_SBGEMM_STRIDEK];
+
+    for (size_t m = 0; m < CountM; m++) {
+
+        const float* a = A + m * lda;
+
+        if (TransA != CblasNoTrans) {
+
+            for (size_t k = 0; k < CountK; k++) {
+                Row[k] = A[k * lda + m];
+            }
+
+            a = Row;
+        }
+
+        Dispatch->ConvertFloatToBf16(a, D, CountK);
+        std::fill_n(D + CountK, PackedK - CountK, uint16_t(0));
+
+        D += PackedK;
+    }
+}
+
+static
+void
+MlasSBGemmKernelLoop(
+    const MLAS_SBGEMM_DISPATCH* Dispatch,
+    uint16_t* PanelA,
+    CBLAS_TRANSPOSE TransA,
+    size_t M,
+    size_t CountK,
+    size_t PackedK,
+    float alpha,
+    const float* A,
+    size_t lda,
+    const uint16_t* PanelB,
+    size_t ldb,
+    float* C,
+    size_t ldc,
+    size_t CountN,
+    bool ZeroMode
+    )
+/*++
+
+Routine Description:
+
+    This routine steps through the rows of matrix A, converts them to bfloat16
+    and multiplies them by a slice of the packed panels of matrix B.
+
+Arguments:
+
+    Dispatch - Supplies the SBGEMM dispatch of the platform.
+
+    PanelA - Supplies the address of a buffer of MLAS_SBGEMM_STRIDEM rows by
+        MLAS_SBGEMM_STRIDEK columns.
+
+    TransA - Supplies the transpose operation for matrix A.
+
+    M - Supplies the number of rows of matrix A and matrix C.
+
+    CountK - Supplies the number of columns of the slice of matrix A.
+
+    PackedK - Supplies the number of packed rows of the slice of matrix B.
+
+    alpha - Supplies the scalar alpha multiplier (see SGEMM definition).
+
+    A - Supplies the address of the slice of matrix A.
+
+    lda - Supplies the first dimension of matrix A.
+
+    PanelB - Supplies the address of the first packed panel of matrix B.
+
+    ldb - Supplies the number of elements between two packed panels.
+
+    C - Supplies the address of matrix C.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    CountN - Supplies the number of columns of the slice of matrix B.
+
+    ZeroMode - Supplies true if the output matrix must be zero initialized,
+        else false if the output matrix is accumulated into.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    size_t CountM;
+
+    for (size_t m = 0; m < M; m += CountM) {
+
+        CountM = std::min(M - m, size_t(MLAS_SBGEMM_STRIDEM));
+
+        const float* a = A + m * ((TransA == CblasNoTrans) ? lda : 1);
+
+        MlasSBGemmConvertPackA(Dispatch, PanelA, a, lda, TransA, CountM, CountK, PackedK);
+
+        Dispatch->Kernel(PanelA, PackedK, PanelB, ldb, C + m * ldc, ldc, CountM, CountN,
+            PackedK, alpha, ZeroMode);
+    }
+}
+
+void
+MlasSBGemmOperation(
+    CBLAS_TRANSPOSE TransA,
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const float* A,
+    size_t lda,
+    const float* B,
+    size_t ldb,
+    float beta,
+    float* C,
+    size_t ldc
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the single precision matrix/matrix multiply
+    operation computed with bfloat16 inputs (SBGEMM).
+
+Arguments:
+
+    TransA - Supplies the transpose operation for matrix A.
+
+    TransB - Supplies the transpose operation for matrix B.
+
+    M - Supplies the number of rows of matrix A and matrix C.
+
+    N - Supplies the number of columns of matrix B and matrix C.
+
+    K - Supplies the number of columns of matrix A and the number of rows of
+        matrix B.
+
+    alpha - Supplies the scalar alpha multiplier (see SGEMM definition).
+
+    A - Supplies the address of matrix A.
+
+    lda - Supplies the first dimension of matrix A.
+
+    B - Supplies the address of matrix B.
+
+    ldb - Supplies the first dimension of matrix B.
+
+    beta - Supplies the scalar beta multiplier (see SGEMM definition).
+
+    C - Supplies the address of matrix C.
+
+    ldc - Supplies the first dimension of matrix C.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_DECLSPEC_ALIGN(uint16_t PanelA[MLAS_SBGEMM_STRIDEM * MLAS_SBGEMM_STRIDEK], 64);
+    MLAS_DECLSPEC_ALIGN(uint16_t PanelB[MLAS_SBGEMM_STRIDEN * MLAS_SBGEMM_STRIDEK], 64);
+
+    const MLAS_SBGEMM_DISPATCH* Dispatch = GetMlasPlatform().SBGemmDispatch;
+
+    //
+    // Handle the special case of K equals zero. Apply the beta multiplier to
+    // the output matrix and exit.
+    //
+
+    if (K == 0) {
+        MlasSgemmMultiplyBeta(C, M, N, ldc, beta);
+        return;
+    }
+
+    //
+    // Handle the special case of a single row. Converting matrix B to
+    // bfloat16 costs more than the single precision matrix/vector multiply.
+    //
+
+    if (M == 1) {
+        MlasSgemmOperation(TransA, TransB, M, N, K, alpha, A, lda, B, ldb, beta, C, ldc);
+        return;
+    }
+
+    //
+    // Step through each slice of matrix B along the N dimension.
+    //
+
+    size_t CountN;
+
+    for (size_t n = 0; n < N; n += CountN) {
+
+        CountN = std::min(N - n, size_t(MLAS_SBGEMM_STRIDEN));
+
+        //
+        // Multiply the output matrix by beta as needed.
+        //
+
+        if (beta != 0.0f && beta != 1.0f) {
+            MlasSgemmMultiplyBeta(C + n, M, CountN, ldc, beta);
+        }
+
+        //
+        // Step through each slice of matrix B along the K dimension.
+        //
+
+        size_t CountK;
+        bool ZeroMode = (beta == 0.0f);
+
+        for (size_t k = 0; k < K; k += CountK) {
+
+            CountK = std::min(K - k, size_t(MLAS_SBGEMM_STRIDEK));
+
+            const size_t PackedK = (CountK + MLAS_SBGEMM_PACKED_K - 1) & ~(MLAS_SBGEMM_PACKED_K - 1);
+
+            //
+            // Convert the slice of matrix B to packed panels.
+            //
+
+            if (TransB == CblasNoTrans) {
+                Dispatch->PackB(PanelB, B + k * ldb + n, ldb, false, CountN, CountK, PackedK);
+            } else {
+                Dispatch->PackB(PanelB, B + n * ldb + k, ldb, true, CountN, CountK, PackedK);
+            }
+
+            //
+            // Step through each slice of matrix A along the M dimension.
+            //
+
+            const float* a = A + k * ((TransA == CblasNoTrans) ? 1 : lda);
+
+            MlasSBGemmKernelLoop(Dispatch, PanelA, TransA, M, CountK, PackedK, alpha, a, lda,
+                PanelB, PackedK * MLAS_SBGEMM_PANEL_N, C + n, ldc, CountN, ZeroMode);
+
+            ZeroMode = false;
+        }
+    }
+}
+
+static
+void
+MlasSBGemmPackedOperation(
+    CBLAS_TRANSPOSE TransA,
+    size_t M,
+    size_t RangeStartN,
+    size_t RangeCountN,
+    size_t K,
+    float alpha,
+    const float* A,
+    size_t lda,
+    const void* PackedB,
+    float beta,
+    float* C,
+    size_t ldc
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the single precision matrix/matrix multiply
+    operation computed with bfloat16 inputs (SBGEMM) using a matrix B packed
+    by MlasSBGemmPackB.
+
+Arguments:
+
+    TransA - Supplies the transpose operation for matrix A.
+
+    M - Supplies the number of rows of matrix A and matrix C.
+
+    RangeStartN - Supplies the starting column from packed matrix B, a
+        multiple of MLAS_SBGEMM_PANEL_N.
+
+    RangeCountN - Supplies the number of columns of matrix B and matrix C.
+
+    K - Supplies the number of columns of matrix A and the number of rows of
+        matrix B.
+
+    alpha - Supplies the scalar alpha multiplier (see SGEMM definition).
+
+    A - Supplies the address of matrix A.
+
+    lda - Supplies the first dimension of matrix A.
+
+    PackedB - Supplies the address of packed matrix B.
+
+    beta - Supplies the scalar beta multiplier (see SGEMM definition).
+
+    C - Supplies the address of matrix C.
+
+    ldc - Supplies the first dimension of matrix C.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_DECLSPEC_ALIGN(uint16_t PanelA[MLAS_SBGEMM_STRIDEM * MLAS_SBGEMM_STRIDEK], 64);
+
+    const MLAS_SBGEMM_DISPATCH* Dispatch = GetMlasPlatform().SBGemmDispatch;
+
+    const size_t AlignedK = (K + MLAS_SBGEMM_PACKED_K - 1) & ~(MLAS_SBGEMM_PACKED_K - 1);
+    const size_t ldb = AlignedK * MLAS_SBGEMM_PANEL_N;
+
+    if (K == 0) {
+        MlasSgemmMultiplyBeta(C, M, RangeCountN, ldc, beta);
+        return;
+    }
+
+    //
+    // Step through each slice of matrix B along the N dimension.
+    //
+
+    size_t CountN;
+
+    for (size_t n = 0; n < RangeCountN; n += CountN) {
+
+        CountN = std::min(RangeCountN - n, size_t(MLAS_SBGEMM_STRIDEN));
+
+        //
+        // Multiply the output matrix by beta as needed.
+        //
+
+        if (beta != 0.0f && beta != 1.0f) {
+            MlasSgemmMultiplyBeta(C + n, M, CountN, ldc, beta);
+        }
+
+        //
+        // Step through each slice of matrix B along the K dimension.
+        //
+
+        const uint16_t* pb = (const uint16_t*)PackedB +
+            ((RangeStartN + n) / MLAS_SBGEMM_PANEL_N) * ldb;
+
+        size_t CountK;
+        bool ZeroMode = (beta == 0.0f);
+
+        for (size_t k = 0; k < K; k += CountK) {
+
+            CountK = std::min(K - k, size_t(MLAS_SBGEMM_STRIDEK));
+
+            const size_t PackedK = std::min(AlignedK - k, size_t(MLAS_SBGEMM_STRIDEK));
+
+            const float* a = A + k * ((TransA == CblasNoTrans) ? 1 : lda);
+
+            MlasSBGemmKernelLoop(Dispatch, PanelA, TransA, M, CountK, PackedK, alpha, a, lda,
+                pb + k * MLAS_SBGEMM_PANEL_N, ldb, C + n, ldc, CountN, ZeroMode);
+
+            ZeroMode = false;
+        }
+    }
+}
+
+static
+void
+MlasSBGemmThreaded(
+    const ptrdiff_t ThreadCountM,
+    const ptrdiff_t ThreadCountN,
+    const CBLAS_TRANSPOSE TransA,
+    const CBLAS_TRANSPOSE TransB,
+    const size_t M,
+    const size_t N,
+    const size_t K,
+    const MLAS_SGEMM_DATA_PARAMS* DataParams,
+    ptrdiff_t ThreadId
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of a
+    SBGEMM operation.
+
+Arguments:
+
+    ThreadCountM - Supplies the total thread partition on the M dimension.
+
+    ThreadCountN - Supplies the total thread partition on the N dimension.
+
+    TransA - Supplies the transpose operation on A matrix
+
+    TransB - Supplies the transpose operation on B matrix
+
+    M, N, K - Supplies the shape of the multiplication
+
+    DataParams - Supplies the data position and layout of the matrices
+
+    ThreadId - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const ptrdiff_t ThreadIdM = ThreadId / ThreadCountN;
+    const ptrdiff_t ThreadIdN = ThreadId % ThreadCountN;
+
+    //
+    // Partition the operation along the M dimension.
+    //
+
+    size_t RangeStartM;
+    size_t RangeCountM;
+
+    MlasPartitionWork(ThreadIdM, ThreadCountM, M, &RangeStartM, &RangeCountM);
+
+    //
+    // Partition the operation along the N dimension. Each partition starts
+    // at a packed panel of matrix B.
+    //
+
+    size_t RangeStartN;
+    size_t RangeCountN;
+
+    const size_t BlockedN = (N + MLAS_SBGEMM_PANEL_N - 1) / MLAS_SBGEMM_PANEL_N;
+
+    MlasPartitionWork(ThreadIdN, ThreadCountN, BlockedN, &RangeStartN, &RangeCountN);
+
+    RangeStartN *= MLAS_SBGEMM_PANEL_N;
+    RangeCountN *= MLAS_SBGEMM_PANEL_N;
+
+    RangeCountN = std::min(N - RangeStartN, RangeCountN);
+
+    //
+    // Dispatch the partitioned operation.
+    //
+
+    const size_t lda = DataParams->lda;
+    const size_t ldc = DataParams->ldc;
+
+    const float* A = DataParams->A + RangeStartM * ((TransA == CblasNoTrans) ? lda : 1);
+    float* C = DataParams->C + RangeStartM * ldc + RangeStartN;
+
+    if (DataParams->BIsPacked) {
+
+        MlasSBGemmPackedOperation(TransA, RangeCountM, RangeStartN, RangeCountN, K,
+            DataParams->alpha, A, lda, DataParams->B, DataParams->beta, C, ldc);
+
+    } else {
+
+        const size_t ldb = DataParams->ldb;
+
+        const float* B = DataParams->B + RangeStartN * ((TransB == CblasNoTrans) ? 1 : ldb);
+
+        MlasSBGemmOperation(TransA, TransB, RangeCountM, RangeCountN, K,
+            DataParams->alpha, A, lda, B, ldb, DataParams->beta, C, ldc);
+    }
+
+    //
+    // Apply the epilogue to the partitioned region of the output matrix.
+    //
+
+    if (DataParams->Epilogue != nullptr) {
+        MlasSgemmApplyEpilogue(DataParams->Epilogue, RangeStartM, RangeStartN, C,
+            RangeCountM, RangeCountN, ldc);
+    }
+}
+
+void
+MLASCALL
+MlasSBGemmBatch(
+    CBLAS_TRANSPOSE TransA,
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    const MLAS_SGEMM_DATA_PARAMS* Data,
+    size_t BatchSize,
+    MLAS_THREADPOOL* ThreadPool
+    )
+{
+    if (GetMlasPlatform().SBGemmDispatch == nullptr) {
+        MLAS_THROW_EX(std::runtime_error, "SBGEMM is not supported by the processor");
+    }
+
+    //
+    // Compute the number of target threads given the complexity of the SBGEMM
+    // operation. Small requests should run using the single threaded path.
+    //
+
+    const double Complexity = double(M) * double(N) * double(K);
+
+    ptrdiff_t TargetThreadCount;
+
+    if (Complexity < double(MLAS_SGEMM_THREAD_COMPLEXITY * GetMlasPlatform().MaximumThreadCount)) {
+        TargetThreadCount = ptrdiff_t(Complexity / double(MLAS_SGEMM_THREAD_COMPLEXITY)) + 1;
+    } else {
+        TargetThreadCount = GetMlasPlatform().MaximumThreadCount;
+    }
+
+    ptrdiff_t MaximumThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+    if (TargetThreadCount >= MaximumThreadCount) {
+        TargetThreadCount = MaximumThreadCount;
+    }
+
+    //
+    // Segment the operation across multiple threads.
+    //
+
+    ptrdiff_t ThreadsPerGemm = (TargetThreadCount + BatchSize - 1) / BatchSize;
+    ptrdiff_t ThreadCountM;
+    ptrdiff_t ThreadCountN;
+
+    if (N > M) {
+
+        const size_t BlockedN = (N + MLAS_SBGEMM_PANEL_N - 1) / MLAS_SBGEMM_PANEL_N;
+
+        if (size_t(ThreadsPerGemm) > BlockedN) {
+            ThreadsPerGemm = ptrdiff_t(BlockedN);
+        }
+
+        ThreadCountM = 1;
+        ThreadCountN = ThreadsPerGemm;
+
+    } else {
+
+        if (size_t(ThreadsPerGemm) > M) {
+            ThreadsPerGemm = ptrdiff_t(M);
+        }
+
+        ThreadCountM = ThreadsPerGemm;
+        ThreadCountN = 1;
+    }
+
+    MlasTrySimpleParallel(ThreadPool,
+        ThreadsPerGemm * static_cast<ptrdiff_t>(BatchSize),
+        [=](ptrdiff_t tid)
+    {
+        ptrdiff_t GemmIdx = tid / ThreadsPerGemm;
+        ptrdiff_t ThreadIdx = tid % ThreadsPerGemm;
+        MlasSBGemmThreaded(ThreadCountM, ThreadCountN,
+            TransA, TransB, M, N, K, &(Data[GemmIdx]), ThreadIdx);
+    });
+}
+
+size_t
+MLASCALL
+MlasSBGemmPackBSize(
+    size_t N,
+    size_t K
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the length in bytes for the packed matrix B buffer.
+
+Arguments:
+
+    N - Supplies the number of columns of matrix B.
+
+    K - Supplies the number of rows of matrix B.
+
+Return Value:
+
+    Returns the size in bytes for the packed matrix B buffer, or zero if the
+    operation is not supported.
+
+--*/
+{
+    if (GetMlasPlatform().SBGemmDispatch == nullptr) {
+        return 0;
+    }
+
+    const size_t AlignedN = (N + MLAS_SBGEMM_PANEL_N - 1) & ~(MLAS_SBGEMM_PANEL_N - 1);
+    const size_t AlignedK = (K + MLAS_SBGEMM_PACKED_K - 1) & ~(MLAS_SBGEMM_PACKED_K - 1);
+
+    const size_t BytesRequired = AlignedN * AlignedK * sizeof(uint16_t);
+    const size_t BufferAlignment = MlasGetPreferredBufferAlignment();
+    const size_t AlignedBytesRequired = (BytesRequired + BufferAlignment - 1) &
+        ~(BufferAlignment - 1);
+
+    return AlignedBytesRequired;
+}
+
+void
+MLASCALL
+MlasSBGemmPackB(
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const float* B,
+    size_t ldb,
+    void* PackedB
+    )
+/*++
+
+Routine Description:
+
+    This routine converts the contents of matrix B to bfloat16 and packs it to
+    the destination buffer. The destination buffer should be sized based on
+    MlasSBGemmPackBSize().
+
+Arguments:
+
+    TransB - Supplies the transpose operation for matrix B.
+
+    N - Supplies the number of columns of matrix B.
+
+    K - Supplies the number of rows of matrix B.
+
+    B - Supplies the address of matrix B.
+
+    ldb - Supplies the first dimension of matrix B.
+
+    PackedB - Supplies the address of packed matrix B.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const MLAS_SBGEMM_DISPATCH* Dispatch = GetMlasPlatform().SBGemmDispatch;
+
+    const size_t AlignedK = (K + MLAS_SBGEMM_PACKED_K - 1) & ~(MLAS_SBGEMM_PACKED_K - 1);
+
+    Dispatch->PackB((uint16_t*)PackedB, B, ldb, TransB != CblasNoTrans, N, K, AlignedK);
+}
@@ -0,0 +1,128 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    sbgemm.h
+
+Abstract:
+
+    This module defines the dispatch structure and the packed layouts of the
+    single precision matrix/matrix multiply operation computed with bfloat16
+    inputs and single precision accumulation (SBGEMM).
+
+    Matrix B is packed in panels of MLAS_SBGEMM_PANEL_N columns. A panel
+    stores pairs of rows as interleaved bfloat16 values, so each 32-bit
+    element holds B[k][n] and B[k+1][n]. This is the layout consumed by both
+    VDPBF16PS and the B operand of TDPBF16PS, so the kernels share the packing
+    routines. The packed K dimension is padded with zeros to a multiple of
+    MLAS_SBGEMM_PACKED_K.
+
+    Matrix A is converted to row major bfloat16 blocks of at most
+    MLAS_SBGEMM_STRIDEM rows by MLAS_SBGEMM_STRIDEK columns.
+
+--*/
+
+#pragma once
+
+#include "mlasi.h"
+
+//
+// Define the shape of the packed panels and the strides to step through
+// slices of the input matrices.
+//
+
+#define MLAS_SBGEMM_PANEL_N                         16
+#define MLAS_SBGEMM_PACKED_K                        32
+#define MLAS_SBGEMM_STRIDEM                         32
+#define MLAS_SBGEMM_STRIDEN                         128
+#define MLAS_SBGEMM_STRIDEK                         256
+
+/**
+ * @brief Converts a row of single precision values to bfloat16 with round
+ *        to nearest even.
+ *
+ * @param[in]  Source       Address of the source values
+ * @param[out] Destination  Address of the bfloat16 values
+ * @param[in]  Count        Number of values to convert
+ */
+typedef
+void
+(MLASCALL MLAS_SBGEMM_CONVERT_ROUTINE)(
+    const float* Source,
+    uint16_t* Destination,
+    size_t Count
+    );
+
+/**
+ * @brief Converts a block of matrix B to bfloat16 panels.
+ *
+ * @param[out] D          Address of the first panel
+ * @param[in]  B          Address of the source block
+ * @param[in]  ldb        Leading dimension of B
+ * @param[in]  TransB     Whether B is transposed
+ * @param[in]  CountN     Number of columns to pack
+ * @param[in]  CountK     Number of rows to pack
+ * @param[in]  PackedK    Number of packed rows per panel, a multiple of
+ *                        MLAS_SBGEMM_PACKED_K; rows from CountK are zero
+ */
+typedef
+void
+(MLASCALL MLAS_SBGEMM_PACKB_ROUTINE)(
+    uint16_t* D,
+    const float* B,
+    size_t ldb,
+    bool TransB,
+    size_t CountN,
+    size_t CountK,
+    size_t PackedK
+    );
+
+/**
+ * @brief Multiplies a block of bfloat16 matrix A by packed panels of B.
+ *
+ * @param[in]  A          Address of the bfloat16 block of A
+ * @param[in]  lda        Leading dimension of A
+ * @param[in]  B          Address of the first packed panel
+ * @param[in]  ldb        Number of elements between two panels
+ * @param[out] C          Address of matrix C
+ * @param[in]  ldc        Leading dimension of C
+ * @param[in]  CountM     Number of rows, at most MLAS_SBGEMM_STRIDEM
+ * @param[in]  CountN     Number of columns
+ * @param[in]  CountK     Number of packed rows, a multiple of
+ *                        MLAS_SBGEMM_PACKED_K
+ * @param[in]  alpha      Scalar multiplier of the product
+ * @param[in]  ZeroMode   Whether to overwrite C instead of accumulating
+ */
+typedef
+void
+(MLASCALL MLAS_SBGEMM_KERNEL_ROUTINE)(
+    const uint16_t* A,
+    size_t lda,
+    const uint16_t* B,
+    size_t ldb,
+    float* C,
+    size_t ldc,
+    size_t CountM,
+    size_t CountN,
+    size_t CountK,
+    float alpha,
+    bool ZeroMode
+    );
+
+struct MLAS_SBGEMM_DISPATCH {
+    MLAS_SBGEMM_CONVERT_ROUTINE* ConvertFloatToBf16;
+    MLAS_SBGEMM_PACKB_ROUTINE* PackB;
+    MLAS_SBGEMM_KERNEL_ROUTINE* Kernel;
+};
+
+#if defined(MLAS_TARGET_AMD64)
+
+MLAS_SBGEMM_CONVERT_ROUTINE MlasSBGemmConvertFloatToBf16Avx512Bf16;
+MLAS_SBGEMM_PACKB_ROUTINE MlasSBGemmPackBAvx512Bf16;
+MLAS_SBGEMM_KERNEL_ROUTINE MlasSBGemmKernelAvx512Bf16;
+
+#endif
@@ -0,0 +1,223 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    sbgemm_kernel_amx.cpp
+
+Abstract:
+
+    This module implements the SBGEMM kernel for AMX-BF16. Matrix B is packed
+    by the AVX512_BF16 routines, whose panels have the layout of the B operand
+    of TDPBF16PS.
+
+--*/
+
+#include "sbgemm.h"
+#include "amx_common.h"
+
+#define TMM0 0
+#define TMM1 1
+#define TMM2 2
+#define TMM3 3
+#define TMM4 4
+#define TMM5 5
+#define TMM6 6
+#define TMM7 7
+
+#define TILE_M 16
+#define TILE_N 16
+#define TILE_K 32
+
+static_assert(TILE_N == MLAS_SBGEMM_PANEL_N, "tile columns must match the packed panels");
+static_assert(TILE_K == MLAS_SBGEMM_PACKED_K, "tile depth must match the packed rows");
+
+//
+// Use the AVX512_BF16 kernel for the blocks of matrix A that only fill a few
+// rows of a tile.
+//
+
+#define MLAS_SBGEMM_AMX_MINIMUM_ROWS                4
+
+// Tile configure structure
+struct sbgemm_tileconfig_t {
+    uint8_t palette_id = 0;
+    uint8_t start_row = 0;
+    uint8_t reserved1[14] = {0};
+    uint16_t colb[8] = {0};
+    uint8_t reserved2[16] = {0};
+    uint8_t rows[8] = {0};
+    uint8_t reserved3[8] = {0};
+};
+
+static
+void
+MlasSBGemmAmxThreadInit()
+{
+    //
+    // All tiles are 16 rows of 64 bytes. Reload the configuration if another
+    // component changed it on this thread.
+    //
+
+    static thread_local sbgemm_tileconfig_t tc;
+    sbgemm_tileconfig_t current_tc;
+    _tile_storeconfig(&current_tc);
+
+    if (tc.palette_id == 0 || std::memcmp(&current_tc, &tc, sizeof(tc)) != 0) {
+        tc.palette_id = 1;
+        for (int t = 0; t < 8; t++) {
+            tc.rows[t] = TILE_M;
+            tc.colb[t] = TILE_N * sizeof(float);
+        }
+        _tile_loadconfig(&tc);
+    }
+}
+
+static
+void
+MlasSBGemmMoveTile(
+    const float* Tile,
+    float* C,
+    size_t ldc,
+    size_t CountM,
+    size_t CountN,
+    __m512 Alpha,
+    bool ZeroMode
+    )
+{
+    const __mmask16 Mask = (CountN >= TILE_N) ? __mmask16(0xFFFF) : __mmask16((1u << CountN) - 1);
+
+    for (size_t m = 0; m < CountM; m++) {
+
+        __m512 Result = _mm512_mul_ps(_mm512_load_ps(Tile + m * TILE_N), Alpha);
+
+        if (!ZeroMode) {
+            Result = _mm512_add_ps(Result, _mm512_maskz_loadu_ps(Mask, C));
+        }
+
+        _mm512_mask_storeu_ps(C, Mask, Result);
+
+        C += ldc;
+    }
+}
+
+void
+MLASCALL
+MlasSBGemmKernelAmx(
+    const uint16_t* A,
+    size_t lda,
+    const uint16_t* B,
+    size_t ldb,
+    float* C,
+    size_t ldc,
+    size_t CountM,
+    size_t CountN,
+    size_t CountK,
+    float alpha,
+    bool ZeroMode
+    )
+/*++
+
+Routine Description:
+
+    This routine multiplies a block of matrix A by packed panels of matrix B
+    with 2x2 tiles of matrix C.
+
+    N.B. The tiles of matrix A always load 16 rows, so the block of matrix A
+    must be backed by a buffer of MLAS_SBGEMM_STRIDEM rows. The rows past
+    CountM are never stored to matrix C.
+
+--*/
+{
+    if (CountM <= MLAS_SBGEMM_AMX_MINIMUM_ROWS) {
+        MlasSBGemmKernelAvx512Bf16(A, lda, B, ldb, C, ldc, CountM, CountN, CountK, alpha, ZeroMode);
+        return;
+    }
+
+    MlasSBGemmAmxThreadInit();
+
+    MLAS_DECLSPEC_ALIGN(float Tile[4][TILE_M * TILE_N], 64);
+
+    const __m512 Alpha = _mm512_set1_ps(alpha);
+    const int StrideA = static_cast<int>(lda * sizeof(uint16_t));
+    constexpr int StrideB = TILE_N * 2 * sizeof(uint16_t);
+    constexpr int StrideTile = TILE_N * sizeof(float);
+
+    for (size_t m = 0; m < CountM; m += 2 * TILE_M) {
+
+        const size_t RowsRemaining = CountM - m;
+        const bool TwoRowTiles = RowsRemaining > TILE_M;
+
+        const uint16_t* a0 = A + m * lda;
+        const uint16_t* a1 = a0 + TILE_M * lda;
+
+        for (size_t n = 0; n < CountN; n += 2 * TILE_N) {
+
+            const size_t ColumnsRemaining = CountN - n;
+            const bool TwoColumnTiles = ColumnsRemaining > TILE_N;
+
+            const uint16_t* b0 = B + (n / TILE_N) * ldb;
+            const uint16_t* b1 = b0 + ldb;
+
+            _tile_zero(TMM0);
+            _tile_zero(TMM1);
+            _tile_zero(TMM2);
+            _tile_zero(TMM3);
+
+            for (size_t k = 0; k < CountK; k += TILE_K) {
+
+                tile_loadd(TMM4, a0 + k, StrideA);
+                tile_loadd(TMM6, b0 + k * TILE_N, StrideB);
+                _tile_dpbf16ps(TMM0, TMM4, TMM6);
+
+                if (TwoColumnTiles) {
+                    tile_loadd(TMM7, b1 + k * TILE_N, StrideB);
+                    _tile_dpbf16ps(TMM1, TMM4, TMM7);
+                }
+
+                if (TwoRowTiles) {
+                    tile_loadd(TMM5, a1 + k, StrideA);
+                    _tile_dpbf16ps(TMM2, TMM5, TMM6);
+
+                    if (TwoColumnTiles) {
+                        _tile_dpbf16ps(TMM3, TMM5, TMM7);
+                    }
+                }
+            }
+
+            const size_t Rows0 = std::min(RowsRemaining, size_t(TILE_M));
+            const size_t Columns0 = std::min(ColumnsRemaining, size_t(TILE_N));
+            float* c = C + m * ldc + n;
+
+            tile_stored(TMM0, Tile[0], StrideTile);
+            MlasSBGemmMoveTile(Tile[0], c, ldc, Rows0, Columns0, Alpha, ZeroMode);
+
+            if (TwoColumnTiles) {
+                tile_stored(TMM1, Tile[1], StrideTile);
+                MlasSBGemmMoveTile(Tile[1], c + TILE_N, ldc, Rows0, ColumnsRemaining - TILE_N,
+                    Alpha, ZeroMode);
+            }
+
+            if (TwoRowTiles) {
+                tile_stored(TMM2, Tile[2], StrideTile);
+                MlasSBGemmMoveTile(Tile[2], c + TILE_M * ldc, ldc, RowsRemaining - TILE_M, Columns0,
+                    Alpha, ZeroMode);
+
+                if (TwoColumnTiles) {
+                    tile_stored(TMM3, Tile[3], StrideTile);
+                    MlasSBGemmMoveTile(Tile[3], c + TILE_M * ldc + TILE_N, ldc,
+                        RowsRemaining - TILE_M, ColumnsRemaining - TILE_N, Alpha, ZeroMode);
+                }
+            }
+        }
+    }
+}
+
+const MLAS_SBGEMM_DISPATCH MlasSBGemmDispatchAmx = {
+    MlasSBGemmConvertFloatToBf16Avx512Bf16,
+    MlasSBGemmPackBAvx512Bf16,
+    MlasSBGemmKernelAmx,
+};
@@ -0,0 +1,361 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    sbgemm_kernel_avx512bf16.cpp
+
+Abstract:
+
+    This module implements the SBGEMM kernels for AVX512_BF16. The kernel
+    multiplies pairs of bfloat16 values with VDPBF16PS and accumulates the
+    products in single precision.
+
+--*/
+
+#include "sbgemm.h"
+
+//
+// Define the number of rows of matrix A and the number of packed panels of
+// matrix B processed by an iteration of the kernel.
+//
+
+#define MLAS_SBGEMM_AVX512BF16_ROWS                 8
+#define MLAS_SBGEMM_AVX512BF16_PANELS               2
+
+MLAS_FORCEINLINE
+__m512bh
+MlasLoadBf16Pairs(
+    const uint16_t* Buffer
+    )
+{
+    return (__m512bh)_mm512_loadu_si512(Buffer);
+}
+
+MLAS_FORCEINLINE
+__m512bh
+MlasBroadcastBf16Pair(
+    const uint16_t* Buffer
+    )
+{
+    return (__m512bh)_mm512_set1_epi32(*reinterpret_cast<const int32_t*>(Buffer));
+}
+
+MLAS_FORCEINLINE
+__mmask16
+MlasSBGemmColumnMask(
+    size_t CountN
+    )
+{
+    return (CountN >= 16) ? __mmask16(0xFFFF) : __mmask16((1u << CountN) - 1);
+}
+
+void
+MLASCALL
+MlasSBGemmConvertFloatToBf16Avx512Bf16(
+    const float* Source,
+    uint16_t* Destination,
+    size_t Count
+    )
+{
+    while (Count >= 32) {
+
+        __m512 Low = _mm512_loadu_ps(Source);
+        __m512 High = _mm512_loadu_ps(Source + 16);
+
+        _mm512_storeu_si512(Destination, (__m512i)_mm512_cvtne2ps_pbh(High, Low));
+
+        Source += 32;
+        Destination += 32;
+        Count -= 32;
+    }
+
+    while (Count > 0) {
+
+        const __mmask16 Mask = MlasSBGemmColumnMask(Count);
+
+        __m256bh Converted = _mm512_cvtneps_pbh(_mm512_maskz_loadu_ps(Mask, Source));
+
+        _mm256_mask_storeu_epi16(Destination, Mask, (__m256i)Converted);
+
+        const size_t CountConverted = std::min(Count, size_t(16));
+
+        Source += CountConverted;
+        Destination += CountConverted;
+        Count -= CountConverted;
+    }
+}
+
+void
+MLASCALL
+MlasSBGemmPackBAvx512Bf16(
+    uint16_t* D,
+    const float* B,
+    size_t ldb,
+    bool TransB,
+    size_t CountN,
+    size_t CountK,
+    size_t PackedK
+    )
+{
+    //
+    // Interleave the rows k and k+1 of a panel, which VCVTNE2PS2BF16 leaves
+    // in the low and the high half of the vector.
+    //
+
+    const __m512i InterleaveIndex = _mm512_set_epi16(
+        31, 15, 30, 14, 29, 13, 28, 12, 27, 11, 26, 10, 25, 9, 24, 8,
+        23, 7, 22, 6, 21, 5, 20, 4, 19, 3, 18, 2, 17, 1, 16, 0);
+
+    for (size_t n = 0; n < CountN; n += MLAS_SBGEMM_PANEL_N) {
+
+        const size_t CountColumns = std::min(CountN - n, size_t(MLAS_SBGEMM_PANEL_N));
+
+        if (!TransB) {
+
+            const __mmask16 Mask = MlasSBGemmColumnMask(CountColumns);
+            const float* b = B + n;
+
+            for (size_t k = 0; k < PackedK; k += 2) {
+
+                __m512 Row0 = _mm512_setzero_ps();
+                __m512 Row1 = _mm512_setzero_ps();
+
+                if (k < CountK) {
+                    Row0 = _mm512_maskz_loadu_ps(Mask, b + k * ldb);
+                }
+
+                if (k + 1 < CountK) {
+                    Row1 = _mm512_maskz_loadu_ps(Mask, b + (k + 1) * ldb);
+                }
+
+                __m512i Rows = (__m512i)_mm512_cvtne2ps_pbh(Row1, Row0);
+
+                _mm512_storeu_si512(D + k * MLAS_SBGEMM_PANEL_N,
+                    _mm512_permutexvar_epi16(InterleaveIndex, Rows));
+            }
+
+        } else {
+
+            //
+            // Convert the columns of the panel to a local buffer, so that a
+            // row of the packed panel is a gather of a pair from each column.
+            //
+
+            MLAS_DECLSPEC_ALIGN(uint16_t Columns[MLAS_SBGEMM_PANEL_N * MLAS_SBGEMM_STRIDEK], 64);
+
+            const __m512i ColumnOffsets = _mm512_mullo_epi32(
+                _mm512_set_epi32(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0),
+                _mm512_set1_epi32(MLAS_SBGEMM_STRIDEK / 2));
+
+            for (size_t k = 0; k < PackedK; k += MLAS_SBGEMM_STRIDEK) {
+
+                const size_t ChunkK = std::min(PackedK - k, size_t(MLAS_SBGEMM_STRIDEK));
+                const size_t ConvertK = (k < CountK) ? std::min(CountK - k, ChunkK) : 0;
+
+                for (size_t c = 0; c < MLAS_SBGEMM_PANEL_N; c++) {
+
+                    uint16_t* Column = Columns + c * MLAS_SBGEMM_STRIDEK;
+
+                    if (c < CountColumns) {
+                        MlasSBGemmConvertFloatToBf16Avx512Bf16(B + (n + c) * ldb + k, Column, ConvertK);
+                        std::fill_n(Column + ConvertK, ChunkK - ConvertK, uint16_t(0));
+                    } else {
+                        std::fill_n(Column, ChunkK, uint16_t(0));
+                    }
+                }
+
+                for (size_t p = 0; p < ChunkK / 2; p++) {
+
+                    __m512i Pairs = _mm512_i32gather_epi32(
+                        _mm512_add_epi32(ColumnOffsets, _mm512_set1_epi32(int32_t(p))), Columns, 4);
+
+                    _mm512_storeu_si512(D + (k + p * 2) * MLAS_SBGEMM_PANEL_N, Pairs);
+                }
+            }
+        }
+
+        D += PackedK * MLAS_SBGEMM_PANEL_N;
+    }
+}
+
+MLAS_FORCEINLINE
+void
+MlasSBGemmStoreVector(
+    float* C,
+    __m512 Accumulator,
+    __m512 Alpha,
+    __mmask16 Mask,
+    bool ZeroMode
+    )
+{
+    __m512 Result = _mm512_mul_ps(Accumulator, Alpha);
+
+    if (!ZeroMode) {
+        Result = _mm512_add_ps(Result, _mm512_maskz_loadu_ps(Mask, C));
+    }
+
+    _mm512_mask_storeu_ps(C, Mask, Result);
+}
+
+template<size_t RowCount, size_t PanelCount>
+MLAS_FORCEINLINE
+void
+MlasSBGemmKernelBlockAvx512Bf16(
+    const uint16_t* A,
+    size_t lda,
+    const uint16_t* B,
+    size_t ldb,
+    float* C,
+    size_t ldc,
+    size_t CountN,
+    size_t CountK,
+    __m512 Alpha,
+    bool ZeroMode
+    )
+/*++
+
+Routine Description:
+
+    This routine multiplies RowCount rows of matrix A by PanelCount packed
+    panels of matrix B.
+
+--*/
+{
+    __m512 Accumulators[RowCount][PanelCount];
+
+    for (size_t r = 0; r < RowCount; r++) {
+        for (size_t p = 0; p < PanelCount; p++) {
+            Accumulators[r][p] = _mm512_setzero_ps();
+        }
+    }
+
+    for (size_t k = 0; k < CountK; k += 2) {
+
+        __m512bh BPairs[PanelCount];
+
+        for (size_t p = 0; p < PanelCount; p++) {
+            BPairs[p] = MlasLoadBf16Pairs(B + p * ldb + k * MLAS_SBGEMM_PANEL_N);
+        }
+
+        for (size_t r = 0; r < RowCount; r++) {
+
+            __m512bh APair = MlasBroadcastBf16Pair(A + r * lda + k);
+
+            for (size_t p = 0; p < PanelCount; p++) {
+                Accumulators[r][p] = _mm512_dpbf16_ps(Accumulators[r][p], APair, BPairs[p]);
+            }
+        }
+    }
+
+    for (size_t p = 0; p < PanelCount; p++) {
+
+        const size_t CountColumns = CountN - p * MLAS_SBGEMM_PANEL_N;
+        const __mmask16 Mask = MlasSBGemmColumnMask(CountColumns);
+
+        for (size_t r = 0; r < RowCount; r++) {
+            MlasSBGemmStoreVector(C + r * ldc + p * MLAS_SBGEMM_PANEL_N, Accumulators[r][p],
+                Alpha, Mask, ZeroMode);
+        }
+    }
+}
+
+template<size_t RowCount>
+MLAS_FORCEINLINE
+void
+MlasSBGemmKernelRowsAvx512Bf16(
+    const uint16_t* A,
+    size_t lda,
+    const uint16_t* B,
+    size_t ldb,
+    float* C,
+    size_t ldc,
+    size_t CountN,
+    size_t CountK,
+    __m512 Alpha,
+    bool ZeroMode
+    )
+{
+    constexpr size_t BlockN = MLAS_SBGEMM_PANEL_N * MLAS_SBGEMM_AVX512BF16_PANELS;
+
+    while (CountN > MLAS_SBGEMM_PANEL_N) {
+
+        MlasSBGemmKernelBlockAvx512Bf16<RowCount, MLAS_SBGEMM_AVX512BF16_PANELS>(
+            A, lda, B, ldb, C, ldc, CountN, CountK, Alpha, ZeroMode);
+
+        if (CountN <= BlockN) {
+            return;
+        }
+
+        B += MLAS_SBGEMM_AVX512BF16_PANELS * ldb;
+        C += BlockN;
+        CountN -= BlockN;
+    }
+
+    MlasSBGemmKernelBlockAvx512Bf16<RowCount, 1>(
+        A, lda, B, ldb, C, ldc, CountN, CountK, Alpha, ZeroMode);
+}
+
+void
+MLASCALL
+MlasSBGemmKernelAvx512Bf16(
+    const uint16_t* A,
+    size_t lda,
+    const uint16_t* B,
+    size_t ldb,
+    float* C,
+    size_t ldc,
+    size_t CountM,
+    size_t CountN,
+    size_t CountK,
+    float alpha,
+    bool ZeroMode
+    )
+{
+    const __m512 Alpha = _mm512_set1_ps(alpha);
+
+    while (CountM >= MLAS_SBGEMM_AVX512BF16_ROWS) {
+
+        MlasSBGemmKernelRowsAvx512Bf16<MLAS_SBGEMM_AVX512BF16_ROWS>(
+            A, lda, B, ldb, C, ldc, CountN, CountK, Alpha, ZeroMode);
+
+        A += MLAS_SBGEMM_AVX512BF16_ROWS * lda;
+        C += MLAS_SBGEMM_AVX512BF16_ROWS * ldc;
+        CountM -= MLAS_SBGEMM_AVX512BF16_ROWS;
+    }
+
+    //
+    // Process the remaining rows in blocks of 4, 2 and 1 rows.
+    //
+
+    if (CountM >= 4) {
+
+        MlasSBGemmKernelRowsAvx512Bf16<4>(A, lda, B, ldb, C, ldc, CountN, CountK, Alpha, ZeroMode);
+
+        A += 4 * lda;
+        C += 4 * ldc;
+        CountM -= 4;
+    }
+
+    if (CountM >= 2) {
+
+        MlasSBGemmKernelRowsAvx512Bf16<2>(A, lda, B, ldb, C, ldc, CountN, CountK, Alpha, ZeroMode);
+
+        A += 2 * lda;
+        C += 2 * ldc;
+        CountM -= 2;
+    }
+
+    if (CountM >= 1) {
+        MlasSBGemmKernelRowsAvx512Bf16<1>(A, lda, B, ldb, C, ldc, CountN, CountK, Alpha, ZeroMode);
+    }
+}
+
+const MLAS_SBGEMM_DISPATCH MlasSBGemmDispatchAvx512Bf16 = {
+    MlasSBGemmConvertFloatToBf16Avx512Bf16,
+    MlasSBGemmPackBAvx512Bf16,
+    MlasSBGemmKernelAvx512Bf16,
+};
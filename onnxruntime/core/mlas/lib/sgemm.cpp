@@ -1003,6 +1003,182 @@ Return Value:
 
 #endif
 
+MLAS_SGEMM_EPILOGUE
+MlasSgemmOffsetEpilogue(
+    const MLAS_SGEMM_EPILOGUE* Epilogue,
+    size_t StartM,
+    size_t StartN
+    )
+/*++
+
+Routine Description:
+
+    This routine returns a copy of the epilogue that applies to the
+    submatrix of the output starting at the specified row and column.
+
+Arguments:
+
+    Epilogue - Supplies the epilogue of the full output matrix.
+
+    StartM - Supplies the starting row of the submatrix.
+
+    StartN - Supplies the starting column of the submatrix.
+
+Return Value:
+
+    Returns the epilogue for the submatrix.
+
+--*/
+{
+    MLAS_SGEMM_EPILOGUE OffsetEpilogue = *Epilogue;
+
+    if (OffsetEpilogue.Bias != nullptr) {
+        OffsetEpilogue.Bias += StartN;
+    }
+
+    if (OffsetEpilogue.Residual != nullptr) {
+        OffsetEpilogue.Residual += StartM * OffsetEpilogue.ldr + StartN;
+    }
+
+    return OffsetEpilogue;
+}
+
+void
+MlasSgemmApplyEpilogue(
+    const MLAS_SGEMM_EPILOGUE* Epilogue,
+    size_t StartM,
+    size_t StartN,
+    float* C,
+    size_t CountM,
+    size_t CountN,
+    size_t ldc
+    )
+/*++
+
+Routine Description:
+
+    This routine applies the epilogue operations to a tile of the output
+    matrix.
+
+Arguments:
+
+    Epilogue - Supplies the epilogue of the output matrix.
+
+    StartM - Supplies the row of the output matrix where the tile starts.
+
+    StartN - Supplies the column of the output matrix where the tile starts.
+
+    C - Supplies the address of the tile.
+
+    CountM - Supplies the number of rows of the tile.
+
+    CountN - Supplies the number of columns of the tile.
+
+    ldc - Supplies the first dimension of matrix C.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const float* Bias = (Epilogue->Bias != nullptr) ? Epilogue->Bias + StartN : nullptr;
+    const float* Residual = (Epilogue->Residual != nullptr) ?
+        Epilogue->Residual + StartM * Epilogue->ldr + StartN : nullptr;
+
+    //
+    // Add the bias vector and the residual matrix.
+    //
+
+    if (Bias != nullptr || Residual != nullptr) {
+
+        float* c = C;
+
+        for (size_t m = 0; m < CountM; m++) {
+
+            size_t n = 0;
+
+            for (; n + 4 <= CountN; n += 4) {
+
+                MLAS_FLOAT32X4 Vector = MlasLoadFloat32x4(c + n);
+
+                if (Bias != nullptr) {
+                    Vector = MlasAddFloat32x4(Vector, MlasLoadFloat32x4(Bias + n));
+                }
+
+                if (Residual != nullptr) {
+                    Vector = MlasAddFloat32x4(Vector, MlasLoadFloat32x4(Residual + n));
+                }
+
+                MlasStoreFloat32x4(c + n, Vector);
+            }
+
+            for (; n < CountN; n++) {
+
+                if (Bias != nullptr) {
+                    c[n] += Bias[n];
+                }
+
+                if (Residual != nullptr) {
+                    c[n] += Residual[n];
+                }
+            }
+
+            c += ldc;
+
+            if (Residual != nullptr) {
+                Residual += Epilogue->ldr;
+            }
+        }
+    }
+
+    if (Epilogue->Activation != nullptr) {
+        MlasActivation(Epilogue->Activation, C, nullptr, CountM, CountN, ldc);
+    }
+
+    if (Epilogue->Function == MlasSgemmEpilogueNoFunction) {
+        return;
+    }
+
+    //
+    // Apply the function through a local buffer in chunks of each row.
+    //
+
+    constexpr size_t ChunkSize = 128;
+    float Buffer[ChunkSize];
+
+    for (size_t m = 0; m < CountM; m++) {
+
+        float* c = C + m * ldc;
+
+        for (size_t n = 0; n < CountN; n += ChunkSize) {
+
+            const size_t CountChunk = std::min(CountN - n, ChunkSize);
+
+            if (Epilogue->Function == MlasSgemmEpilogueGelu) {
+
+                for (size_t i = 0; i < CountChunk; i++) {
+                    Buffer[i] = c[n + i] * 0.70710678118654752f;
+                }
+
+                MlasComputeErf(Buffer, Buffer, CountChunk);
+
+                for (size_t i = 0; i < CountChunk; i++) {
+                    c[n + i] = 0.5f * c[n + i] * (1.0f + Buffer[i]);
+                }
+
+            } else {
+
+                MlasComputeLogistic(c + n, Buffer, CountChunk);
+
+                for (size_t i = 0; i < CountChunk; i++) {
+                    c[n + i] *= Buffer[i];
+                }
+            }
+        }
+    }
+}
+
 MLAS_FORCEINLINE
 float*
 MlasSgemmKernelLoop(
@@ -1015,7 +1191,10 @@ MlasSgemmKernelLoop(
     size_t lda,
     size_t ldc,
     float alpha,
-    bool ZeroMode
+    bool ZeroMode,
+    const MLAS_SGEMM_EPILOGUE* Epilogue,
+    size_t StartM,
+    size_t StartN
     )
 /*++
 
@@ -1051,6 +1230,16 @@ Arguments:
     ZeroMode - Supplies true if the output matrix must be zero initialized,
         else false if the output matrix is accumulated into.
 
+    Epilogue - Optionally supplies the epilogue to apply to each block of
+        rows produced by the kernel, else nullptr if the output is not yet
+        complete.
+
+    StartM - Supplies the row of the full output matrix that corresponds to
+        the first row of matrix C.
+
+    StartN - Supplies the column of the full output matrix that corresponds
+        to the first column of matrix C.
+
 Return Value:
 
     Returns the next address of matrix C.
@@ -1071,6 +1260,11 @@ Return Value:
         }
 #endif
 
+        if (Epilogue != nullptr) {
+            MlasSgemmApplyEpilogue(Epilogue, StartM, StartN, C, RowsHandled, CountN, ldc);
+            StartM += RowsHandled;
+        }
+
         C += ldc * RowsHandled;
         A += lda * RowsHandled;
         CountM -= RowsHandled;
@@ -1093,7 +1287,8 @@ MlasSgemmOperation(
     size_t ldb,
     float beta,
     float* C,
-    size_t ldc
+    size_t ldc,
+    const MLAS_SGEMM_EPILOGUE* Epilogue
     )
 /*++
 
@@ -1131,6 +1326,8 @@ Arguments:
 
     ldc - Supplies the first dimension of matrix C.
 
+    Epilogue - Optionally supplies the epilogue to apply to the output matrix.
+
 Return Value:
 
     None.
@@ -1147,6 +1344,11 @@ Return Value:
 
     if (K == 0) {
         MlasSgemmMultiplyBeta(C, M, N, ldc, beta);
+
+        if (Epilogue != nullptr) {
+            MlasSgemmApplyEpilogue(Epilogue, 0, 0, C, M, N, ldc);
+        }
+
         return;
     }
 
@@ -1170,6 +1372,11 @@ Return Value:
 
         if (SgemmKernelM1Routine != nullptr) {
             SgemmKernelM1Routine(A, B, C, K, N, ldb, beta);
+
+            if (Epilogue != nullptr) {
+                MlasSgemmApplyEpilogue(Epilogue, 0, 0, C, 1, N, ldc);
+            }
+
             return;
         }
 
@@ -1177,6 +1384,11 @@ Return Value:
 
         if (TransB == CblasNoTrans) {
             MlasGemvFloatKernel(A, B, C, K, N, ldb, (beta == 0.0f));
+
+            if (Epilogue != nullptr) {
+                MlasSgemmApplyEpilogue(Epilogue, 0, 0, C, 1, N, ldc);
+            }
+
             return;
         }
 
@@ -1205,6 +1417,11 @@ Return Value:
 
         if (SgemmKernelM1Routine != nullptr) {
             SgemmKernelM1Routine(B, A, C, K, M, lda, beta);
+
+            if (Epilogue != nullptr) {
+                MlasSgemmApplyEpilogue(Epilogue, 0, 0, C, M, 1, ldc);
+            }
+
             return;
         }
 
@@ -1267,6 +1484,13 @@ Return Value:
 
             CountK = std::min(K - k, StrideK);
 
+            //
+            // Apply the epilogue to the output once the last slice of the K
+            // dimension has been accumulated.
+            //
+
+            const MLAS_SGEMM_EPILOGUE* TileEpilogue = (k + CountK == K) ? Epilogue : nullptr;
+
             //
             // Copy or transpose a panel of matrix B to a local packed buffer.
             //
@@ -1285,7 +1509,8 @@ Return Value:
 
             if (TransA == CblasNoTrans) {
 
-                MlasSgemmKernelLoop(A + k, PanelB, c, CountK, M, CountN, lda, ldc, alpha, ZeroMode);
+                MlasSgemmKernelLoop(A + k, PanelB, c, CountK, M, CountN, lda, ldc, alpha, ZeroMode,
+                    TileEpilogue, 0, n);
 
             } else {
 
@@ -1302,6 +1527,8 @@ Return Value:
 
                     MlasSgemmTransposeA(PanelA, a, lda, RowsTransposed, CountK);
 
+                    const size_t StartM = M - RowsRemaining;
+
                     RowsRemaining -= RowsTransposed;
                     a += RowsTransposed;
 
@@ -1309,7 +1536,8 @@ Return Value:
                     // Step through the rows of the local buffer.
                     //
 
-                    c = MlasSgemmKernelLoop(PanelA, PanelB, c, CountK, RowsTransposed, CountN, CountK, ldc, alpha, ZeroMode);
+                    c = MlasSgemmKernelLoop(PanelA, PanelB, c, CountK, RowsTransposed, CountN, CountK, ldc, alpha, ZeroMode,
+                        TileEpilogue, StartM, n);
                 }
             }
 
@@ -1332,7 +1560,8 @@ MlasSgemmPackedOperation(
     size_t AlignedN,
     float beta,
     float* C,
-    size_t ldc
+    size_t ldc,
+    const MLAS_SGEMM_EPILOGUE* Epilogue
     )
 /*++
 
@@ -1372,6 +1601,8 @@ Arguments:
 
     ldc - Supplies the first dimension of matrix C.
 
+    Epilogue - Optionally supplies the epilogue to apply to the output matrix.
+
 Return Value:
 
     None.
@@ -1411,6 +1642,8 @@ Return Value:
 
             CountK = std::min(K - k, size_t(MLAS_SGEMM_PACKED_STRIDEK));
 
+            const MLAS_SGEMM_EPILOGUE* TileEpilogue = (k + CountK == K) ? Epilogue : nullptr;
+
             //
             // Step through each slice of matrix A along the M dimension.
             //
@@ -1420,7 +1653,8 @@ Return Value:
 
             if (TransA == CblasNoTrans) {
 
-                MlasSgemmKernelLoop(A + k, pb, c, CountK, M, CountN, lda, ldc, alpha, ZeroMode);
+                MlasSgemmKernelLoop(A + k, pb, c, CountK, M, CountN, lda, ldc, alpha, ZeroMode,
+                    TileEpilogue, 0, n);
 
             } else {
 
@@ -1437,6 +1671,8 @@ Return Value:
 
                     MlasSgemmTransposeA(PanelA, a, lda, RowsTransposed, CountK);
 
+                    const size_t StartM = M - RowsRemaining;
+
                     RowsRemaining -= RowsTransposed;
                     a += RowsTransposed;
 
@@ -1444,7 +1680,8 @@ Return Value:
                     // Step through the rows of the local buffer.
                     //
 
-                    c = MlasSgemmKernelLoop(PanelA, pb, c, CountK, RowsTransposed, CountN, CountK, ldc, alpha, ZeroMode);
+                    c = MlasSgemmKernelLoop(PanelA, pb, c, CountK, RowsTransposed, CountN, CountK, ldc, alpha, ZeroMode,
+                        TileEpilogue, StartM, n);
                 }
             }
 
@@ -1453,6 +1690,396 @@ Return Value:
     }
 }
 
+MLAS_FORCEINLINE
+void
+MlasSgemmSmallStore(
+    MLAS_FLOAT32X4 Accumulator,
+    float* c,
+    float alpha,
+    float beta
+    )
+{
+    MLAS_FLOAT32X4 Result = MlasMultiplyFloat32x4(Accumulator, MlasBroadcastFloat32x4(alpha));
+
+    if (beta != 0.0f) {
+        Result = MlasMultiplyAddFloat32x4(MlasLoadFloat32x4(c), beta, Result);
+    }
+
+    MlasStoreFloat32x4(c, Result);
+}
+
+MLAS_FORCEINLINE
+void
+MlasSgemmSmallStore(
+    float Accumulator,
+    float* c,
+    float alpha,
+    float beta
+    )
+{
+    float Result = Accumulator * alpha;
+
+    if (beta != 0.0f) {
+        Result += *c * beta;
+    }
+
+    *c = Result;
+}
+
+template<size_t RowCount>
+void
+MlasSgemmSmallKernelNN(
+    const float* A,
+    size_t lda,
+    const float* B,
+    size_t ldb,
+    float* C,
+    size_t ldc,
+    size_t N,
+    size_t K,
+    float alpha,
+    float beta
+    )
+/*++
+
+Routine Description:
+
+    This routine computes RowCount rows of a small SGEMM where matrix B is not
+    transposed. Matrix B is read in place: each row of matrix B is multiplied
+    by a broadcast element from each row of matrix A and accumulated into a
+    fixed block of RowCount x 8 registers.
+
+Arguments:
+
+    A - Supplies the address of matrix A.
+
+    lda - Supplies the first dimension of matrix A.
+
+    B - Supplies the address of matrix B.
+
+    ldb - Supplies the first dimension of matrix B.
+
+    C - Supplies the address of matrix C.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    N - Supplies the number of columns of matrix B and matrix C.
+
+    K - Supplies the number of columns of matrix A and the number of rows of
+        matrix B.
+
+    alpha - Supplies the scalar alpha multiplier (see SGEMM definition).
+
+    beta - Supplies the scalar beta multiplier (see SGEMM definition).
+
+Return Value:
+
+    None.
+
+--*/
+{
+    size_t n = 0;
+
+    for (; n + 8 <= N; n += 8) {
+
+        MLAS_FLOAT32X4 Accumulators[RowCount][2];
+
+        for (size_t r = 0; r < RowCount; r++) {
+            Accumulators[r][0] = MlasZeroFloat32x4();
+            Accumulators[r][1] = MlasZeroFloat32x4();
+        }
+
+        const float* b = B + n;
+
+        for (size_t k = 0; k < K; k++) {
+
+            const MLAS_FLOAT32X4 B0 = MlasLoadFloat32x4(b);
+            const MLAS_FLOAT32X4 B1 = MlasLoadFloat32x4(b + 4);
+
+            for (size_t r = 0; r < RowCount; r++) {
+                const MLAS_FLOAT32X4 a = MlasBroadcastFloat32x4(A + r * lda + k);
+                Accumulators[r][0] = MlasMultiplyAddFloat32x4(a, B0, Accumulators[r][0]);
+                Accumulators[r][1] = MlasMultiplyAddFloat32x4(a, B1, Accumulators[r][1]);
+            }
+
+            b += ldb;
+        }
+
+        for (size_t r = 0; r < RowCount; r++) {
+            MlasSgemmSmallStore(Accumulators[r][0], C + r * ldc + n, alpha, beta);
+            MlasSgemmSmallStore(Accumulators[r][1], C + r * ldc + n + 4, alpha, beta);
+        }
+    }
+
+    if (n + 4 <= N) {
+
+        MLAS_FLOAT32X4 Accumulators[RowCount];
+
+        for (size_t r = 0; r < RowCount; r++) {
+            Accumulators[r] = MlasZeroFloat32x4();
+        }
+
+        const float* b = B + n;
+
+        for (size_t k = 0; k < K; k++) {
+
+            const MLAS_FLOAT32X4 B0 = MlasLoadFloat32x4(b);
+
+            for (size_t r = 0; r < RowCount; r++) {
+                Accumulators[r] = MlasMultiplyAddFloat32x4(MlasBroadcastFloat32x4(A + r * lda + k), B0, Accumulators[r]);
+            }
+
+            b += ldb;
+        }
+
+        for (size_t r = 0; r < RowCount; r++) {
+            MlasSgemmSmallStore(Accumulators[r], C + r * ldc + n, alpha, beta);
+        }
+
+        n += 4;
+    }
+
+    for (; n < N; n++) {
+
+        float Accumulators[RowCount] = {};
+
+        const float* b = B + n;
+
+        for (size_t k = 0; k < K; k++) {
+
+            for (size_t r = 0; r < RowCount; r++) {
+                Accumulators[r] += A[r * lda + k] * *b;
+            }
+
+            b += ldb;
+        }
+
+        for (size_t r = 0; r < RowCount; r++) {
+            MlasSgemmSmallStore(Accumulators[r], C + r * ldc + n, alpha, beta);
+        }
+    }
+}
+
+template<size_t RowCount>
+void
+MlasSgemmSmallKernelNT(
+    const float* A,
+    size_t lda,
+    const float* B,
+    size_t ldb,
+    float* C,
+    size_t ldc,
+    size_t N,
+    size_t K,
+    float alpha,
+    float beta
+    )
+/*++
+
+Routine Description:
+
+    This routine computes RowCount rows of a small SGEMM where matrix B is
+    transposed. Each output is the dot product of a row of matrix A and a row
+    of matrix B, so both matrices are read in place along the K dimension
+    for a fixed block of RowCount x 4 outputs.
+
+Arguments:
+
+    A - Supplies the address of matrix A.
+
+    lda - Supplies the first dimension of matrix A.
+
+    B - Supplies the address of matrix B.
+
+    ldb - Supplies the first dimension of matrix B.
+
+    C - Supplies the address of matrix C.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    N - Supplies the number of rows of matrix B and columns of matrix C.
+
+    K - Supplies the number of columns of matrix A and matrix B.
+
+    alpha - Supplies the scalar alpha multiplier (see SGEMM definition).
+
+    beta - Supplies the scalar beta multiplier (see SGEMM definition).
+
+Return Value:
+
+    None.
+
+--*/
+{
+    size_t n = 0;
+
+    for (; n + 4 <= N; n += 4) {
+
+        MLAS_FLOAT32X4 Accumulators[RowCount][4];
+
+        for (size_t r = 0; r < RowCount; r++) {
+            for (size_t j = 0; j < 4; j++) {
+                Accumulators[r][j] = MlasZeroFloat32x4();
+            }
+        }
+
+        const float* b = B + n * ldb;
+        size_t k = 0;
+
+        for (; k + 4 <= K; k += 4) {
+
+            const MLAS_FLOAT32X4 B0 = MlasLoadFloat32x4(b + k);
+            const MLAS_FLOAT32X4 B1 = MlasLoadFloat32x4(b + ldb + k);
+            const MLAS_FLOAT32X4 B2 = MlasLoadFloat32x4(b + 2 * ldb + k);
+            const MLAS_FLOAT32X4 B3 = MlasLoadFloat32x4(b + 3 * ldb + k);
+
+            for (size_t r = 0; r < RowCount; r++) {
+                const MLAS_FLOAT32X4 a = MlasLoadFloat32x4(A + r * lda + k);
+                Accumulators[r][0] = MlasMultiplyAddFloat32x4(a, B0, Accumulators[r][0]);
+                Accumulators[r][1] = MlasMultiplyAddFloat32x4(a, B1, Accumulators[r][1]);
+                Accumulators[r][2] = MlasMultiplyAddFloat32x4(a, B2, Accumulators[r][2]);
+                Accumulators[r][3] = MlasMultiplyAddFloat32x4(a, B3, Accumulators[r][3]);
+            }
+        }
+
+        for (size_t r = 0; r < RowCount; r++) {
+
+            //
+            // Transpose and add the accumulators to form the dot products
+            // of the four columns in a single vector.
+            //
+
+            MLAS_FLOAT32X4 Sum02 = MlasAddFloat32x4(
+                MlasInterleaveLowFloat32x4(Accumulators[r][0], Accumulators[r][2]),
+                MlasInterleaveHighFloat32x4(Accumulators[r][0], Accumulators[r][2]));
+            MLAS_FLOAT32X4 Sum13 = MlasAddFloat32x4(
+                MlasInterleaveLowFloat32x4(Accumulators[r][1], Accumulators[r][3]),
+                MlasInterleaveHighFloat32x4(Accumulators[r][1], Accumulators[r][3]));
+            MLAS_FLOAT32X4 Sum = MlasAddFloat32x4(MlasInterleaveLowFloat32x4(Sum02, Sum13),
+                MlasInterleaveHighFloat32x4(Sum02, Sum13));
+
+            if (k < K) {
+
+                float Tail[4] = {};
+
+                for (size_t j = 0; j < 4; j++) {
+                    for (size_t kk = k; kk < K; kk++) {
+                        Tail[j] += A[r * lda + kk] * b[j * ldb + kk];
+                    }
+                }
+
+                Sum = MlasAddFloat32x4(Sum, MlasLoadFloat32x4(Tail));
+            }
+
+            MlasSgemmSmallStore(Sum, C + r * ldc + n, alpha, beta);
+        }
+    }
+
+    for (; n < N; n++) {
+
+        const float* b = B + n * ldb;
+
+        for (size_t r = 0; r < RowCount; r++) {
+
+            MLAS_FLOAT32X4 Accumulator = MlasZeroFloat32x4();
+            size_t k = 0;
+
+            for (; k + 4 <= K; k += 4) {
+                Accumulator = MlasMultiplyAddFloat32x4(MlasLoadFloat32x4(A + r * lda + k),
+                    MlasLoadFloat32x4(b + k), Accumulator);
+            }
+
+            float Sum = MlasReduceAddFloat32x4(Accumulator);
+
+            for (; k < K; k++) {
+                Sum += A[r * lda + k] * b[k];
+            }
+
+            MlasSgemmSmallStore(Sum, C + r * ldc + n, alpha, beta);
+        }
+    }
+}
+
+void
+MlasSgemmSmallOperation(
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    const MLAS_SGEMM_DATA_PARAMS* DataParams
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the single precision matrix/matrix multiply
+    operation (SGEMM) for small matrices without packing matrix B. Matrix A
+    must not be transposed.
+
+Arguments:
+
+    TransB - Supplies the transpose operation for matrix B.
+
+    M - Supplies the number of rows of matrix A and matrix C.
+
+    N - Supplies the number of columns of matrix B and matrix C.
+
+    K - Supplies the number of columns of matrix A and the number of rows of
+        matrix B.
+
+    DataParams - Supplies the data position and layout of the matrices.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const float* A = DataParams->A;
+    const float* B = DataParams->B;
+    float* C = DataParams->C;
+    const size_t lda = DataParams->lda;
+    const size_t ldb = DataParams->ldb;
+    const size_t ldc = DataParams->ldc;
+    const float alpha = DataParams->alpha;
+    const float beta = DataParams->beta;
+
+    size_t m = 0;
+
+    if (TransB == CblasNoTrans) {
+
+        for (; m + 4 <= M; m += 4) {
+            MlasSgemmSmallKernelNN<4>(A + m * lda, lda, B, ldb, C + m * ldc, ldc, N, K, alpha, beta);
+        }
+
+        switch (M - m) {
+            case 3:
+                MlasSgemmSmallKernelNN<3>(A + m * lda, lda, B, ldb, C + m * ldc, ldc, N, K, alpha, beta);
+                break;
+            case 2:
+                MlasSgemmSmallKernelNN<2>(A + m * lda, lda, B, ldb, C + m * ldc, ldc, N, K, alpha, beta);
+                break;
+            case 1:
+                MlasSgemmSmallKernelNN<1>(A + m * lda, lda, B, ldb, C + m * ldc, ldc, N, K, alpha, beta);
+                break;
+        }
+
+    } else {
+
+        for (; m + 2 <= M; m += 2) {
+            MlasSgemmSmallKernelNT<2>(A + m * lda, lda, B, ldb, C + m * ldc, ldc, N, K, alpha, beta);
+        }
+
+        if (m < M) {
+            MlasSgemmSmallKernelNT<1>(A + m * lda, lda, B, ldb, C + m * ldc, ldc, N, K, alpha, beta);
+        }
+    }
+
+    if (DataParams->Epilogue != nullptr) {
+        MlasSgemmApplyEpilogue(DataParams->Epilogue, 0, 0, C, M, N, ldc);
+    }
+}
+
 void
 MlasSgemmThreaded(
     const ptrdiff_t ThreadCountM,
@@ -1536,11 +2163,23 @@ Return Value:
     const float* A = DataParams->A + RangeStartM * ((TransA == CblasNoTrans) ? lda : 1);
     float* C = DataParams->C + RangeStartM * ldc + RangeStartN;
 
+    //
+    // Offset the epilogue to the partitioned region of the output matrix.
+    //
+
+    MLAS_SGEMM_EPILOGUE Epilogue;
+
+    if (DataParams->Epilogue != nullptr) {
+        Epilogue = MlasSgemmOffsetEpilogue(DataParams->Epilogue, RangeStartM, RangeStartN);
+    }
+
+    const MLAS_SGEMM_EPILOGUE* RangeEpilogue = (DataParams->Epilogue != nullptr) ? &Epilogue : nullptr;
+
     if (DataParams->BIsPacked) {
 
         MlasSgemmPackedOperation(TransA, RangeCountM, RangeStartN, RangeCountN,
             K, DataParams->alpha, A, lda, DataParams->B,
-            BlockedN * MLAS_SGEMM_STRIDEN_THREAD_ALIGN, DataParams->beta, C, ldc);
+            BlockedN * MLAS_SGEMM_STRIDEN_THREAD_ALIGN, DataParams->beta, C, ldc, RangeEpilogue);
 
     } else {
 
@@ -1549,9 +2188,81 @@ Return Value:
         const float* B = (const float*)DataParams->B + RangeStartN * ((TransB == CblasNoTrans) ? 1 : ldb);
 
         MlasSgemmOperation(TransA, TransB, RangeCountM, RangeCountN, K,
-            DataParams->alpha, A, lda, B, ldb, DataParams->beta, C, ldc);
+            DataParams->alpha, A, lda, B, ldb, DataParams->beta, C, ldc, RangeEpilogue);
     }
 }
+void
+MlasSgemmSmallBatch(
+    CBLAS_TRANSPOSE TransA,
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    const MLAS_SGEMM_DATA_PARAMS* Data,
+    size_t BatchSize,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine executes a batch of SGEMM operations that are each too small
+    to benefit from being partitioned across threads.
+
+    Each multiplication runs whole on a single thread and the batch is split
+    into contiguous ranges across threads, so that the thread pool dispatches
+    a task per thread rather than per multiplication. The smallest
+    multiplications bypass the packing of matrix B.
+
+Arguments:
+
+    TransA - Supplies the transpose operation for matrix A.
+
+    TransB - Supplies the transpose operation for matrix B.
+
+    M, N, K - Supplies the shape of each multiplication.
+
+    Data - Supplies an array of matrices data parameters.
+
+    BatchSize - Supplies the number of multiplications in the batch.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const double Complexity = double(M) * double(N) * double(K) * double(BatchSize);
+
+    ptrdiff_t ThreadCount = ptrdiff_t(Complexity / double(MLAS_SGEMM_THREAD_COMPLEXITY)) + 1;
+
+    ThreadCount = std::min(ThreadCount, MlasGetMaximumThreadCount(ThreadPool));
+    ThreadCount = std::min(ThreadCount, ptrdiff_t(BatchSize));
+
+    const bool UseSmallKernel = TransA == CblasNoTrans && K != 0 &&
+        M * N * K <= MLAS_SGEMM_SMALL_COMPLEXITY;
+
+    MlasTrySimpleParallel(ThreadPool, ThreadCount, [&](ptrdiff_t tid) {
+
+        size_t BatchStart;
+        size_t BatchCount;
+
+        MlasPartitionWork(tid, ThreadCount, BatchSize, &BatchStart, &BatchCount);
+
+        for (size_t GemmIdx = BatchStart; GemmIdx < BatchStart + BatchCount; GemmIdx++) {
+
+            if (UseSmallKernel && !Data[GemmIdx].BIsPacked) {
+                MlasSgemmSmallOperation(TransB, M, N, K, &Data[GemmIdx]);
+            } else {
+                MlasSgemmThreaded(1, 1, TransA, TransB, M, N, K, &Data[GemmIdx], 0);
+            }
+        }
+    });
+}
+
 #if defined(_MSC_VER) && !defined(__clang__)
 #pragma warning(push)
 // Chance of arithmetic overflow could be reduced
@@ -1578,6 +2289,11 @@ MlasGemmBatch(
 
     const double Complexity = double(M) * double(N) * double(K);
 
+    if (Complexity < double(MLAS_SGEMM_THREAD_COMPLEXITY)) {
+        MlasSgemmSmallBatch(TransA, TransB, M, N, K, Data, BatchSize, ThreadPool);
+        return;
+    }
+
     ptrdiff_t TargetThreadCount;
 
     if (Complexity < double(MLAS_SGEMM_THREAD_COMPLEXITY * GetMlasPlatform().MaximumThreadCount)) {
@@ -0,0 +1,331 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/auto_mixed_precision.h"
+
+#include "core/graph/graph_utils.h"
+#include "core/graph/graph_viewer.h"
+#include "core/optimizer/initializer.h"
+#include "core/optimizer/utils.h"
+
+using namespace ONNX_NAMESPACE;
+
+namespace onnxruntime {
+
+namespace {
+
+// Compute bound ops that are always converted.
+const InlinedHashSet<std::string> kDefaultAllowOps = {"Conv", "ConvTranspose", "Einsum", "Gemm", "MatMul"};
+
+// Ops that are converted if their float inputs are converted values or constants. They either do not change the
+// values, or lose little precision compared to their converted producers.
+const InlinedHashSet<std::string> kDefaultFollowOps = {
+    "Add", "AveragePool", "Clip", "Concat", "DepthToSpace", "Div", "Expand", "Flatten", "Gather", "GlobalAveragePool",
+    "GlobalMaxPool", "Identity", "LeakyRelu", "MaxPool", "Mul", "Pad", "Relu", "Reshape", "Resize", "Sigmoid", "Slice",
+    "SpaceToDepth", "Split", "Squeeze", "Sub", "Tanh", "Tile", "Transpose", "Unsqueeze", "Where"};
+
+bool IsFloatTensor(const NodeArg& node_arg) {
+  const auto* type = node_arg.TypeAsProto();
+  return node_arg.Exists() && type != nullptr && type->has_tensor_type() &&
+         type->tensor_type().elem_type() == TensorProto_DataType_FLOAT;
+}
+
+// Gets the type constraint of each input or output of a node, from the formal parameters of its schema.
+template <typename FormalParameters>
+InlinedVector<std::string> GetArgTypeStrs(const FormalParameters& formal_parameters, size_t num_args,
+                                          const std::vector<int>* arg_counts) {
+  InlinedVector<std::string> type_strs;
+  for (size_t formal_idx = 0; formal_idx < formal_parameters.size() && type_strs.size() < num_args; ++formal_idx) {
+    const auto& formal = formal_parameters[formal_idx];
+    size_t count = 1;
+    if (arg_counts != nullptr && formal_idx < arg_counts->size()) {
+      count = static_cast<size_t>((*arg_counts)[formal_idx]);
+    } else if (formal.GetOption() == OpSchema::FormalParameterOption::Variadic) {
+      count = num_args - type_strs.size();
+    }
+    for (size_t i = 0; i < count && type_strs.size() < num_args; ++i) {
+      type_strs.push_back(formal.GetTypeStr());
+    }
+  }
+  return type_strs;
+}
+
+// Gets the indices of the float inputs and outputs of a node with the type constraint of its float outputs.
+// Returns false if the node has no float outputs, if they have different type constraints, if the constraint does
+// not allow target_type, or if it types non-float values.
+bool GetConvertibleArgs(const Node& node, TensorProto_DataType target_type,
+                        InlinedVector<int>& inputs, InlinedVector<int>& outputs) {
+  const auto* schema = node.Op();
+  if (schema == nullptr) {
+    return false;
+  }
+
+  const auto& input_defs = node.InputDefs();
+  const auto& output_defs = node.OutputDefs();
+  const auto input_type_strs = GetArgTypeStrs(schema->inputs(), input_defs.size(), &node.InputArgCount());
+  const auto output_type_strs = GetArgTypeStrs(schema->outputs(), output_defs.size(), nullptr);
+  if (input_type_strs.size() != input_defs.size() || output_type_strs.size() != output_defs.size()) {
+    return false;
+  }
+
+  std::string type_str;
+  for (size_t i = 0; i < output_defs.size(); ++i) {
+    if (IsFloatTensor(*output_defs[i])) {
+      if (!type_str.empty() && type_str != output_type_strs[i]) {
+        return false;
+      }
+      type_str = output_type_strs[i];
+    }
+  }
+
+  const auto& type_constraints = schema->typeConstraintMap();
+  const auto constraint = type_constraints.find(type_str);
+  if (type_str.empty() || constraint == type_constraints.end()) {
+    return false;
+  }
+
+  const std::string target_type_str = target_type == TensorProto_DataType_FLOAT16 ? "tensor(float16)"
+                                                                                   : "tensor(bfloat16)";
+  const auto& allowed_types = constraint->second.first;
+  if (std::none_of(allowed_types.begin(), allowed_types.end(),
+                   [&target_type_str](DataType allowed_type) { return *allowed_type == target_type_str; })) {
+    return false;
+  }
+
+  inputs.clear();
+  outputs.clear();
+  for (size_t i = 0; i < input_defs.size(); ++i) {
+    if (input_type_strs[i] == type_str && input_defs[i]->Exists()) {
+      if (!IsFloatTensor(*input_defs[i])) {
+        return false;
+      }
+      inputs.push_back(static_cast<int>(i));
+    }
+  }
+  for (size_t i = 0; i < output_defs.size(); ++i) {
+    if (output_type_strs[i] == type_str && output_defs[i]->Exists()) {
+      if (!IsFloatTensor(*output_defs[i])) {
+        return false;
+      }
+      outputs.push_back(static_cast<int>(i));
+    }
+  }
+
+  return true;
+}
+
+// Checks if a node is part of a QDQ node unit, whose float values must stay float.
+bool IsInQDQNodeUnit(const Node& node) {
+  for (auto it = node.InputNodesBegin(), end = node.InputNodesEnd(); it != end; ++it) {
+    if (it->OpType() == "DequantizeLinear") {
+      return true;
+    }
+  }
+  for (auto it = node.OutputNodesBegin(), end = node.OutputNodesEnd(); it != end; ++it) {
+    if (it->OpType() == "QuantizeLinear") {
+      return true;
+    }
+  }
+  return false;
+}
+
+TypeProto ConvertedType(const NodeArg& node_arg, TensorProto_DataType target_type) {
+  TypeProto type(*node_arg.TypeAsProto());
+  type.mutable_tensor_type()->set_elem_type(target_type);
+  return type;
+}
+
+// The float inputs and outputs of a node that is converted.
+struct ConvertedNode {
+  InlinedVector<int> inputs;
+  InlinedVector<int> outputs;
+};
+
+}  // namespace
+
+AutoMixedPrecision::AutoMixedPrecision(TensorProto_DataType target_type,
+                                       const InlinedHashSet<std::string>& extra_allow_ops,
+                                       const InlinedHashSet<std::string>& deny_ops,
+                                       const InlinedHashSet<std::string_view>& compatible_execution_providers)
+    : GraphTransformer("AutoMixedPrecision", compatible_execution_providers), target_type_(target_type) {
+  ORT_ENFORCE(target_type == TensorProto_DataType_FLOAT16 || target_type == TensorProto_DataType_BFLOAT16,
+              "AutoMixedPrecision converts to float16 or bfloat16.");
+
+  for (const auto& op_type : kDefaultAllowOps) {
+    if (deny_ops.count(op_type) == 0) {
+      allow_ops_.insert(op_type);
+    }
+  }
+  for (const auto& op_type : extra_allow_ops) {
+    if (deny_ops.count(op_type) == 0) {
+      allow_ops_.insert(op_type);
+    }
+  }
+  for (const auto& op_type : kDefaultFollowOps) {
+    if (deny_ops.count(op_type) == 0 && allow_ops_.count(op_type) == 0) {
+      follow_ops_.insert(op_type);
+    }
+  }
+}
+
+Status AutoMixedPrecision::ApplyImpl(Graph& graph, bool& modified, int graph_level,
+                                     const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& order = graph_viewer.GetNodesInTopologicalOrder();
+
+  // decide which nodes are converted first, so that the follow ops see the decisions for their producers
+  InlinedHashMap<NodeIndex, ConvertedNode> converted;
+  for (NodeIndex index : order) {
+    auto* node = graph.GetNode(index);
+    if (node == nullptr) {
+      continue;
+    }
+
+    ORT_RETURN_IF_ERROR(Recurse(*node, modified, graph_level, logger));
+
+    const bool is_allowed = allow_ops_.count(node->OpType()) > 0;
+    const bool is_follow = follow_ops_.count(node->OpType()) > 0;
+    if ((!is_allowed && !is_follow) || node->Domain() != kOnnxDomain || node->ContainsSubgraph() ||
+        !graph_utils::IsSupportedProvider(*node, GetCompatibleExecutionProviders()) || IsInQDQNodeUnit(*node)) {
+      continue;
+    }
+
+    ConvertedNode args;
+    if (!GetConvertibleArgs(*node, target_type_, args.inputs, args.outputs)) {
+      continue;
+    }
+
+    if (is_follow) {
+      bool has_converted_input = false;
+      bool all_inputs_converted = true;
+      for (int input_idx : args.inputs) {
+        const std::string& name = node->InputDefs()[input_idx]->Name();
+        const Node* producer = graph.GetProducerNode(name);
+        if (producer != nullptr && converted.count(producer->Index()) > 0) {
+          has_converted_input = true;
+        } else if (graph.GetConstantInitializer(name, true) == nullptr) {
+          all_inputs_converted = false;
+        }
+      }
+      if (!has_converted_input || !all_inputs_converted) {
+        continue;
+      }
+    }
+
+    converted.emplace(index, std::move(args));
+  }
+
+  if (converted.empty()) {
+    return Status::OK();
+  }
+
+  // values that enter a converted region by the name of the float value, with the Cast that converts them
+  InlinedHashMap<std::string, std::pair<NodeArg*, Node*>> converted_inputs;
+
+  auto add_cast = [&](NodeArg& input, NodeArg& output, TensorProto_DataType to, const Node& node) -> Node& {
+    Node& cast = graph.AddNode(graph.GenerateNodeName("AutoMixedPrecisionCast"), "Cast",
+                               to == TensorProto_DataType_FLOAT ? "Cast from the converted region."
+                                                                : "Cast to the converted region.",
+                               {&input}, {&output});
+    cast.AddAttribute("to", static_cast<int64_t>(to));
+    cast.SetExecutionProviderType(node.GetExecutionProviderType());
+    graph.UpdateProducerNode(output.Name(), cast.Index());
+    return cast;
+  };
+
+  for (NodeIndex index : order) {
+    auto converted_it = converted.find(index);
+    if (converted_it == converted.end()) {
+      continue;
+    }
+    Node& node = *graph.GetNode(index);
+    const ConvertedNode& args = converted_it->second;
+
+    for (int input_idx : args.inputs) {
+      NodeArg* input_def = node.MutableInputDefs()[input_idx];
+      const Node* producer = graph.GetProducerNode(input_def->Name());
+      if (producer != nullptr && converted.count(producer->Index()) > 0) {
+        // already connected to the converted output of the producer
+        continue;
+      }
+
+      const int src_idx = producer != nullptr ? optimizer_utils::IndexOfNodeOutput(*producer, *input_def) : -1;
+      auto input_it = converted_inputs.find(input_def->Name());
+      if (input_it == converted_inputs.end()) {
+        NodeArg* new_input = nullptr;
+        Node* cast = nullptr;
+        const auto* initializer = graph.GetConstantInitializer(input_def->Name(), true);
+        if (initializer != nullptr) {
+          const Initializer value{*initializer, graph.ModelPath()};
+          const std::string name = graph.GenerateNodeArgName(input_def->Name() + "_converted");
+          new_input = &graph_utils::AddInitializer(graph, target_type_ == TensorProto_DataType_FLOAT16
+                                                              ? value.ToFP16(name)
+                                                              : value.ToBFloat16(name));
+        } else {
+          const TypeProto type = ConvertedType(*input_def, target_type_);
+          new_input = &graph.GetOrCreateNodeArg(graph.GenerateNodeArgName(input_def->Name() + "_converted"), &type);
+          cast = &add_cast(*input_def, *new_input, target_type_, node);
+          if (producer != nullptr) {
+            graph.AddEdge(producer->Index(), cast->Index(), src_idx, 0);
+          }
+        }
+        input_it = converted_inputs.emplace(input_def->Name(), std::make_pair(new_input, cast)).first;
+      }
+
+      if (producer != nullptr) {
+        graph.RemoveEdge(producer->Index(), node.Index(), src_idx, input_idx);
+      }
+      graph_utils::ReplaceNodeInput(node, input_idx, *input_it->second.first);
+      if (input_it->second.second != nullptr) {
+        graph.AddEdge(input_it->second.second->Index(), node.Index(), 0, input_idx);
+      }
+    }
+
+    for (int output_idx : args.outputs) {
+      NodeArg* output_def = node.MutableOutputDefs()[output_idx];
+      const auto edges = graph_utils::GraphEdge::GetNodeOutputEdges(node, output_idx);
+      graph_utils::GraphEdge::RemoveGraphEdges(graph, edges);
+
+      const TypeProto type = ConvertedType(*output_def, target_type_);
+      NodeArg& new_output = graph.GetOrCreateNodeArg(graph.GenerateNodeArgName(output_def->Name() + "_converted"),
+                                                     &type);
+      node.MutableOutputDefs()[output_idx] = &new_output;
+      graph.UpdateProducerNode(new_output.Name(), node.Index());
+
+      // converted consumers use the new value, the others and the graph outputs get it cast back to float
+      Node* cast = nullptr;
+      auto get_cast = [&]() -> Node& {
+        if (cast == nullptr) {
+          cast = &add_cast(new_output, *output_def, TensorProto_DataType_FLOAT, node);
+          graph.AddEdge(node.Index(), cast->Index(), output_idx, 0);
+        }
+        return *cast;
+      };
+
+      for (const auto& edge : edges) {
+        auto consumer_it = converted.find(edge.dst_node);
+        const bool is_converted_input =
+            consumer_it != converted.end() &&
+            std::find(consumer_it->second.inputs.begin(), consumer_it->second.inputs.end(), edge.dst_arg_index) !=
+                consumer_it->second.inputs.end();
+        if (is_converted_input) {
+          graph_utils::ReplaceNodeInput(*graph.GetNode(edge.dst_node), edge.dst_arg_index, new_output);
+          graph.AddEdge(node.Index(), edge.dst_node, output_idx, edge.dst_arg_index);
+        } else {
+          graph.AddEdge(get_cast().Index(), edge.dst_node, 0, edge.dst_arg_index);
+        }
+      }
+
+      if (graph.IsOutput(output_def)) {
+        get_cast();
+      }
+    }
+  }
+
+  LOGS(logger, INFO) << "Converted " << converted.size() << " nodes to "
+                     << (target_type_ == TensorProto_DataType_FLOAT16 ? "float16." : "bfloat16.");
+  modified = true;
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,44 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class AutoMixedPrecision
+
+Transformer that converts the float computation of a model to float16 or bfloat16 when the session is created, without
+an offline conversion of the model.
+
+The nodes with an op type of the allow list, e.g. MatMul and Conv, are converted. The conversion is propagated down
+the graph to the nodes with an op type of the follow list, e.g. Add, Relu and Transpose, whose float inputs are all
+converted values or constant initializers, so that the converted regions grow without extra casts. Other op types,
+e.g. Softmax and the reductions, stay in float for accuracy. Op types of the deny list are never converted.
+
+Only the inputs and outputs of a node with the type constraint of its float outputs are converted, so that e.g. the
+scales of a Resize stay in float. Constant initializers are converted in place of a Cast. A Cast is inserted where a
+float value enters a converted region, and where a converted value leaves it, once per value.
+
+Nodes for which the execution provider has no kernel of the target type get Casts back to float from the
+InsertCastTransformer, so the allow and follow lists should match the kernels of the execution providers used.
+Nodes of QDQ node units are not converted.
+*/
+class AutoMixedPrecision : public GraphTransformer {
+ public:
+  AutoMixedPrecision(ONNX_NAMESPACE::TensorProto_DataType target_type,
+                     const InlinedHashSet<std::string>& extra_allow_ops = {},
+                     const InlinedHashSet<std::string>& deny_ops = {},
+                     const InlinedHashSet<std::string_view>& compatible_execution_providers = {});
+
+ private:
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+
+  ONNX_NAMESPACE::TensorProto_DataType target_type_;
+  InlinedHashSet<std::string> allow_ops_;
+  InlinedHashSet<std::string> follow_ops_;
+};
+
+}  // namespace onnxruntime
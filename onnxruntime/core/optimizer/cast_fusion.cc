@@ -0,0 +1,110 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/cast_fusion.h"
+
+#include <algorithm>
+
+#include "core/graph/graph_utils.h"
+
+namespace onnxruntime {
+
+namespace {
+
+// An input of a consumer kernel that accepts the source type of a widening Cast in place of float.
+// An empty list of types accepts any type, for inputs of which only the shape is read.
+struct CastConsumer {
+  std::string_view op_type;
+  std::string_view domain;
+  InlinedVector<ONNX_NAMESPACE::OperatorSetVersion> versions;
+  int input_index;
+  InlinedVector<std::string_view> types;
+};
+
+bool AcceptsCastInput(const Node& consumer, int input_index, const std::string& type) {
+  static const CastConsumer cast_consumers[] = {
+      {"EmbeddingBag", kMSDomain, {1}, 0, {"tensor(float16)"}},
+      {"Shape", kOnnxDomain, {1, 13, 15, 19}, 0, {}},
+      {"Size", kOnnxDomain, {1, 13}, 0, {}},
+  };
+
+  for (const auto& entry : cast_consumers) {
+    if (entry.input_index == input_index && consumer.OpType() == entry.op_type &&
+        graph_utils::MatchesOpSetDomain(consumer, entry.domain) &&
+        graph_utils::MatchesOpSinceVersion(consumer, entry.versions)) {
+      return entry.types.empty() || std::find(entry.types.begin(), entry.types.end(), type) != entry.types.end();
+    }
+  }
+  return false;
+}
+
+bool FuseCast(Graph& graph, Node& cast) {
+  const NodeArg& input = *cast.InputDefs()[0];
+  const NodeArg& output = *cast.OutputDefs()[0];
+  if (input.Type() == nullptr || output.Type() == nullptr || *output.Type() != "tensor(float)" ||
+      (*input.Type() != "tensor(float16)" && *input.Type() != "tensor(bfloat16)")) {
+    return false;
+  }
+
+  // Collect the consumers reading the Cast output through an input that accepts the narrow type.
+  InlinedVector<Node::EdgeEnd> fused_edges;
+  for (auto it = cast.OutputEdgesBegin(), end = cast.OutputEdgesEnd(); it != end; ++it) {
+    const Node& consumer = it->GetNode();
+    if (consumer.GetExecutionProviderType() == cast.GetExecutionProviderType() &&
+        it->GetDstArgIndex() < static_cast<int>(consumer.InputDefs().size()) &&
+        AcceptsCastInput(consumer, it->GetDstArgIndex(), *input.Type())) {
+      fused_edges.push_back(*it);
+    }
+  }
+
+  if (fused_edges.empty()) {
+    return false;
+  }
+
+  const Node::EdgeEnd* input_edge = graph_utils::GetInputEdge(cast, 0);
+  NodeArg& replacement = *cast.MutableInputDefs()[0];
+
+  for (const auto& edge : fused_edges) {
+    Node& consumer = *graph.GetNode(edge.GetNode().Index());
+    const int dst_idx = edge.GetDstArgIndex();
+    graph.RemoveEdge(cast.Index(), consumer.Index(), 0, dst_idx);
+    graph_utils::ReplaceNodeInput(consumer, dst_idx, replacement);
+    if (input_edge != nullptr) {
+      graph.AddEdge(input_edge->GetNode().Index(), consumer.Index(), input_edge->GetSrcArgIndex(), dst_idx);
+    }
+  }
+
+  if (cast.GetOutputEdgesCount() == 0 && !graph.NodeProducesGraphOutput(cast)) {
+    graph.RemoveNode(cast.Index());
+  }
+
+  return true;
+}
+
+}  // namespace
+
+Status CastFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+
+  for (auto node_index : node_topology_list) {
+    Node* p_node = graph.GetNode(node_index);
+    if (p_node == nullptr) continue;  // node was removed as part of an earlier fusion
+
+    Node& node = *p_node;
+    ORT_RETURN_IF_ERROR(Recurse(node, modified, graph_level, logger));
+
+    if (!graph_utils::IsSupportedOptypeVersionAndDomain(node, "Cast", {6, 9, 13, 19}) ||
+        !graph_utils::IsSupportedProvider(node, GetCompatibleExecutionProviders())) {
+      continue;
+    }
+
+    if (FuseCast(graph, node)) {
+      modified = true;
+    }
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,26 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class CastFusion
+
+Fuse a Cast from float16 or bfloat16 to float into the consumers whose kernels read the narrow type directly
+with the same result, e.g. EmbeddingBag, which converts only the looked up rows of a float16 table.
+Mixed precision graphs and InsertCastTransformer put such Casts in front of large tensors, so the fusion saves
+converting and storing the whole float copy. The Cast is removed once no consumer needs its output.
+*/
+class CastFusion : public GraphTransformer {
+ public:
+  CastFusion(const InlinedHashSet<std::string_view>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("CastFusion", compatible_execution_providers) {}
+
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+};
+
+}  // namespace onnxruntime
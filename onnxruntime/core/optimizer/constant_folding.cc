@@ -1,7 +1,9 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
 #include <limits>
+#include <optional>
 
 #include "core/optimizer/constant_folding.h"
 #include "core/optimizer/utils.h"
@@ -18,13 +20,45 @@ namespace onnxruntime {
 ConstantFolding::ConstantFolding(const IExecutionProvider& execution_provider,
                                  bool skip_dequantize_linear,
                                  const InlinedHashSet<std::string_view>& compatible_execution_providers,
-                                 const InlinedHashSet<std::string>& excluded_initializers) noexcept
+                                 const InlinedHashSet<std::string>& excluded_initializers,
+                                 float max_output_growth_ratio) noexcept
     : GraphTransformer("ConstantFolding", compatible_execution_providers),
       skip_dequantize_linear_(skip_dequantize_linear),
+      max_output_growth_ratio_(max_output_growth_ratio),
       excluded_initializers_(excluded_initializers),
       execution_provider_(execution_provider) {
 }
 
+bool ConstantFolding::ExceedsOutputGrowthLimit(size_t input_bytes, size_t output_bytes) const {
+  return max_output_growth_ratio_ > 0.0f &&
+         output_bytes > kMinOutputBytesToLimit &&
+         static_cast<double>(output_bytes) > static_cast<double>(max_output_growth_ratio_) *
+                                                 static_cast<double>(std::max<size_t>(input_bytes, 1));
+}
+
+// Gets the size of the outputs of a node from their inferred shapes, or nullopt if a shape is not fully known.
+static std::optional<size_t> GetInferredOutputBytes(const Node& node) {
+  size_t total_bytes = 0;
+  for (const auto* output_def : node.OutputDefs()) {
+    const auto* type = output_def->TypeAsProto();
+    const auto* shape = output_def->Shape();
+    if (type == nullptr || shape == nullptr || !utils::HasTensorType(*type) ||
+        type->tensor_type().elem_type() == ONNX_NAMESPACE::TensorProto_DataType_STRING) {
+      return std::nullopt;
+    }
+
+    size_t bytes = DataTypeImpl::TensorTypeFromONNXEnum(type->tensor_type().elem_type())->GetElementType()->Size();
+    for (const auto& dim : shape->dim()) {
+      if (!utils::HasDimValue(dim) || dim.dim_value() < 0) {
+        return std::nullopt;
+      }
+      bytes *= static_cast<size_t>(dim.dim_value());
+    }
+    total_bytes += bytes;
+  }
+  return total_bytes;
+}
+
 // We need to handle a Shape node separately as the input doesn't need to be a constant initializer for
 // Shape to be able to be constant folded.
 static bool ConstantFoldShapeNode(Graph& graph, Node& node) {
@@ -90,6 +124,60 @@ static bool ConstantFoldShapeNode(Graph& graph, Node& node) {
   return is_concrete_shape;  // convert to constant if this is true
 }
 
+// Graph shape inferencing derives the values of small integer tensors computed from shapes, which may be constant
+// even if the shapes they come from are not, e.g. Shape -> Gather selecting a static dimension of an input with a
+// symbolic batch size, or Sub(Shape(x)[1], Shape(x)[1]). Such a node can be replaced by an initializer directly.
+static bool ConstantFoldShapeValues(Graph& graph, Node& node, const InlinedHashSet<std::string>& excluded_initializers) {
+  if (node.OutputDefs().size() != 1 || node.ContainsSubgraph()) {
+    return false;
+  }
+
+  auto* constant_arg_out = node.MutableOutputDefs()[0];
+  const auto* values = constant_arg_out->InferredShapeValues();
+  const auto* shape = constant_arg_out->Shape();
+  if (values == nullptr || shape == nullptr || shape->dim_size() > 1) {
+    return false;
+  }
+
+  // the values may have been derived from an initializer that must not be treated as a constant
+  for (const auto* input_def : node.InputDefs()) {
+    if (excluded_initializers.count(input_def->Name()) > 0) {
+      return false;
+    }
+  }
+
+  std::vector<int64_t> dim_values;
+  for (const auto& dim : values->dim()) {
+    if (!utils::HasDimValue(dim)) {
+      return false;
+    }
+    dim_values.push_back(dim.dim_value());
+  }
+
+  ONNX_NAMESPACE::TensorProto values_constant;
+  values_constant.set_name(constant_arg_out->Name());
+  if (shape->dim_size() == 1) {
+    values_constant.add_dims(static_cast<int64_t>(dim_values.size()));
+  }
+
+  const auto data_type = constant_arg_out->TypeAsProto()->tensor_type().elem_type();
+  values_constant.set_data_type(data_type);
+  if (data_type == ONNX_NAMESPACE::TensorProto_DataType_INT32) {
+    std::vector<int32_t> int32_values(dim_values.begin(), dim_values.end());
+    values_constant.set_raw_data(int32_values.data(), int32_values.size() * sizeof(int32_t));
+  } else {
+    values_constant.set_raw_data(dim_values.data(), dim_values.size() * sizeof(int64_t));
+  }
+
+  ONNX_NAMESPACE::TensorShapeProto result_shape;
+  if (shape->dim_size() == 1) {
+    result_shape.add_dim()->set_dim_value(static_cast<int64_t>(dim_values.size()));
+  }
+  constant_arg_out->SetShape(result_shape);
+  graph.AddInitializedTensor(values_constant);
+  return true;
+}
+
 Status ConstantFolding::ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const {
   bool have_updated_nodes = false;
   GraphViewer graph_viewer(graph);
@@ -120,7 +208,13 @@ Status ConstantFolding::ApplyImpl(Graph& graph, bool& modified, int graph_level,
     bool converted_to_constant = false;
     if (node->OpType().compare("Shape") == 0) {
       converted_to_constant = ConstantFoldShapeNode(graph, *node);
-    } else {
+    }
+
+    if (!converted_to_constant && graph_utils::IsSupportedProvider(*node, GetCompatibleExecutionProviders())) {
+      converted_to_constant = ConstantFoldShapeValues(graph, *node, excluded_initializers_);
+    }
+
+    if (!converted_to_constant && node->OpType().compare("Shape") != 0) {
       InitializedTensorSet constant_inputs;
 
       // we currently constant fold using the CPU EP only.
@@ -150,6 +244,25 @@ Status ConstantFolding::ApplyImpl(Graph& graph, bool& modified, int graph_level,
         continue;
       }
 
+      // refuse folding nodes whose outputs would be much larger than their constant inputs
+      size_t constant_input_bytes = 0;
+      if (max_output_growth_ratio_ > 0.0f) {
+        for (const auto& constant_input : constant_inputs) {
+          size_t input_bytes = 0;
+          if (utils::GetSizeInBytesFromTensorProto<0>(*constant_input.second, &input_bytes).IsOK()) {
+            constant_input_bytes += input_bytes;
+          }
+        }
+
+        const auto inferred_output_bytes = GetInferredOutputBytes(*node);
+        if (inferred_output_bytes.has_value() &&
+            ExceedsOutputGrowthLimit(constant_input_bytes, *inferred_output_bytes)) {
+          LOGS(logger, INFO) << "Not constant folding " << node->OpType() << " node '" << node->Name()
+                             << "' as its outputs of " << *inferred_output_bytes << " bytes exceed the growth limit.";
+          continue;
+        }
+      }
+
       // if skip_dequantize_linear is true we want to maintain QDQ node units so avoid constant folding
       // DequantizeLinear unless we can fold the whole QDQ node unit
       if (skip_dequantize_linear_ && node->OpType() == "DequantizeLinear") {
@@ -234,7 +347,22 @@ Status ConstantFolding::ApplyImpl(Graph& graph, bool& modified, int graph_level,
       // added to the graph as initializers.
       ORT_ENFORCE(fetches.size() == node->OutputDefs().size());
       converted_to_constant = true;
-      for (size_t fetch_idx = 0; fetch_idx < fetches.size(); ++fetch_idx) {
+
+      // the output shapes may not have been inferred before computing the node
+      if (max_output_growth_ratio_ > 0.0f) {
+        size_t output_bytes = 0;
+        for (const auto& fetch : fetches) {
+          if (fetch.IsTensor()) {
+            output_bytes += fetch.Get<Tensor>().SizeInBytes();
+          }
+        }
+        if (ExceedsOutputGrowthLimit(constant_input_bytes, output_bytes)) {
+          LOGS(logger, INFO) << "Not constant folding " << node->OpType() << " node '" << node->Name()
+                             << "' as its outputs of " << output_bytes << " bytes exceed the growth limit.";
+          converted_to_constant = false;
+        }
+      }
+      for (size_t fetch_idx = 0; converted_to_constant && fetch_idx < fetches.size(); ++fetch_idx) {
         const auto& constant_arg_out = *node->OutputDefs()[fetch_idx];
         // XXX: Add support for SparseTensors outputs when we have sparse outputs
         if (!utils::HasTensorType(*constant_arg_out.TypeAsProto())) {
@@ -21,16 +21,27 @@ class ConstantFolding : public GraphTransformer {
   /*! Constant folding will not be applied to nodes that have one of initializers from excluded_initializers as input.
       For pre-training, the trainable weights are those initializers to be excluded.
       \param execution_provider Execution provider instance to execute constant folding.
+      \param max_output_growth_ratio If greater than 0, a node is not folded if its outputs are larger than
+             kMinOutputBytesToLimit and more than max_output_growth_ratio times the size of its constant inputs,
+             e.g. an Expand or Tile that would turn a small initializer into a huge one.
   */
   ConstantFolding(const IExecutionProvider& execution_provider,
                   bool skip_dequantize_linear,
                   const InlinedHashSet<std::string_view>& compatible_execution_providers = {},
-                  const InlinedHashSet<std::string>& excluded_initializers = {}) noexcept;
+                  const InlinedHashSet<std::string>& excluded_initializers = {},
+                  float max_output_growth_ratio = 0.0f) noexcept;
+
+  // Outputs up to this size are always folded, so that small shape computations are not limited by the ratio.
+  static constexpr size_t kMinOutputBytesToLimit = 64 * 1024;
 
  private:
   Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
 
+  // Checks if outputs of output_bytes exceed the growth limit for constant inputs of input_bytes.
+  bool ExceedsOutputGrowthLimit(size_t input_bytes, size_t output_bytes) const;
+
   bool skip_dequantize_linear_;
+  const float max_output_growth_ratio_;
   const InlinedHashSet<std::string> excluded_initializers_;
   const IExecutionProvider& execution_provider_;
 };
@@ -0,0 +1,190 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/constant_if_inlining.h"
+
+#include <optional>
+
+#include "core/graph/graph_utils.h"
+#include "core/graph/graph_viewer.h"
+#include "core/optimizer/initializer.h"
+
+using namespace ONNX_NAMESPACE;
+
+namespace onnxruntime {
+
+namespace {
+
+// Gets the value of the condition of an If node if it is a constant initializer.
+std::optional<bool> GetConstantCondition(const Graph& graph, const Node& if_node) {
+  const auto* cond_proto = graph.GetConstantInitializer(if_node.InputDefs()[0]->Name(), true);
+  if (cond_proto == nullptr || cond_proto->data_type() != TensorProto_DataType_BOOL) {
+    return std::nullopt;
+  }
+
+  const Initializer cond{*cond_proto, graph.ModelPath()};
+  if (cond.size() != 1) {
+    return std::nullopt;
+  }
+  return *cond.data<bool>();
+}
+
+// Copy of a node of the branch, as the branch is destroyed with the If node before the copies are added.
+struct BranchNode {
+  std::string name;
+  std::string op_type;
+  std::string description;
+  std::string domain;
+  NodeAttributes attributes;
+  InlinedVector<std::string> inputs;
+  InlinedVector<std::string> outputs;
+};
+
+// Replaces if_node with the nodes and initializers of branch.
+void InlineBranch(Graph& graph, Node& if_node, const Graph& branch) {
+  const std::string suffix = graph.GenerateNodeName("_inline_" + if_node.Name());
+
+  // names of the values of the branch in the parent graph, and their types
+  InlinedHashMap<std::string, std::string> renamed;
+  InlinedHashMap<std::string, TypeProto> types;
+  auto record_type = [&types](const NodeArg& node_arg) {
+    if (node_arg.TypeAsProto() != nullptr) {
+      types.emplace(node_arg.Name(), *node_arg.TypeAsProto());
+    }
+  };
+
+  // the outputs of the If node are produced by the nodes producing the branch outputs. Branch outputs that are not
+  // produced by a node of the branch, or that are used for more than one If output, are copied with an Identity.
+  const auto& if_outputs = if_node.OutputDefs();
+  const auto& branch_outputs = branch.GetOutputs();
+  InlinedVector<std::pair<std::string, std::string>> identities;  // (branch value, If output)
+  for (size_t i = 0; i < branch_outputs.size() && i < if_outputs.size(); ++i) {
+    const std::string& branch_output = branch_outputs[i]->Name();
+    if (branch.GetProducerNode(branch_output) != nullptr && renamed.count(branch_output) == 0) {
+      renamed[branch_output] = if_outputs[i]->Name();
+    } else {
+      identities.emplace_back(branch_output, if_outputs[i]->Name());
+    }
+  }
+
+  InlinedVector<TensorProto> initializers;
+  for (const auto& entry : branch.GetAllInitializedTensors()) {
+    TensorProto initializer(*entry.second);
+    initializer.set_name(graph.GenerateNodeArgName(entry.first + suffix));
+    renamed[entry.first] = initializer.name();
+    initializers.push_back(std::move(initializer));
+  }
+
+  InlinedVector<BranchNode> nodes;
+  for (const auto& node : branch.Nodes()) {
+    BranchNode copy{graph.GenerateNodeName(node.Name() + suffix), node.OpType(), node.Description(), node.Domain(),
+                    node.GetAttributes(), {}, {}};
+    for (const auto* output_def : node.OutputDefs()) {
+      if (output_def->Exists() && renamed.count(output_def->Name()) == 0) {
+        renamed[output_def->Name()] = graph.GenerateNodeArgName(output_def->Name() + suffix);
+      }
+      record_type(*output_def);
+      copy.outputs.push_back(output_def->Name());
+    }
+    for (const auto* input_def : node.InputDefs()) {
+      record_type(*input_def);
+      copy.inputs.push_back(input_def->Name());
+    }
+    nodes.push_back(std::move(copy));
+  }
+
+  for (auto& identity : identities) {
+    for (const auto* output : branch_outputs) {
+      if (output->Name() == identity.first) {
+        record_type(*output);
+      }
+    }
+  }
+
+  // gets the node arg in the parent graph for a name in the branch. names that are not produced in the branch are
+  // outer scope values, which keep their names. The If outputs keep their node args.
+  auto get_node_arg = [&](const std::string& branch_name) -> NodeArg* {
+    if (branch_name.empty()) {
+      return &graph.GetOrCreateNodeArg(branch_name, nullptr);
+    }
+    auto renamed_it = renamed.find(branch_name);
+    const std::string& name = renamed_it != renamed.end() ? renamed_it->second : branch_name;
+    auto type_it = types.find(branch_name);
+    return &graph.GetOrCreateNodeArg(name, type_it != types.end() ? &type_it->second : nullptr);
+  };
+
+  // remove the If node, which destroys the branch, before adding the nodes that produce its outputs
+  graph_utils::RemoveNodeOutputEdges(graph, if_node);
+  graph.RemoveNode(if_node.Index());
+
+  for (auto& initializer : initializers) {
+    graph_utils::AddInitializer(graph, initializer);
+  }
+
+  for (auto& node : nodes) {
+    InlinedVector<NodeArg*> inputs;
+    InlinedVector<NodeArg*> outputs;
+    for (const auto& input : node.inputs) {
+      inputs.push_back(get_node_arg(input));
+    }
+    for (const auto& output : node.outputs) {
+      outputs.push_back(get_node_arg(output));
+    }
+    graph.AddNode(node.name, node.op_type, node.description, inputs, outputs, &node.attributes, node.domain);
+  }
+
+  for (const auto& identity : identities) {
+    NodeArg* input = get_node_arg(identity.first);
+    NodeArg* output = graph.GetNodeArg(identity.second);
+    graph.AddNode(graph.GenerateNodeName("Identity" + suffix), "Identity", "Output of an inlined If branch.",
+                  {input}, {output});
+  }
+}
+
+}  // namespace
+
+Status ConstantIfInlining::ApplyImpl(Graph& graph, bool& modified, int graph_level,
+                                     const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& order = graph_viewer.GetNodesInTopologicalOrder();
+
+  for (NodeIndex index : order) {
+    auto* node = graph.GetNode(index);
+    if (node == nullptr) {
+      continue;
+    }
+
+    ORT_RETURN_IF_ERROR(Recurse(*node, modified, graph_level, logger));
+
+    if (node->OpType() != "If" || node->Domain() != kOnnxDomain) {
+      continue;
+    }
+
+    const auto cond = GetConstantCondition(graph, *node);
+    if (!cond.has_value()) {
+      continue;
+    }
+
+    const Graph* branch = node->GetGraphAttribute(*cond ? "then_branch" : "else_branch");
+    if (branch == nullptr) {
+      continue;
+    }
+
+    bool has_nested_subgraph = false;
+    for (const auto& branch_node : branch->Nodes()) {
+      has_nested_subgraph = has_nested_subgraph || branch_node.ContainsSubgraph();
+    }
+    if (has_nested_subgraph) {
+      continue;
+    }
+
+    LOGS(logger, INFO) << "Inlining the " << (*cond ? "then" : "else") << " branch of If node '" << node->Name()
+                       << "' with a constant condition.";
+    InlineBranch(graph, *node, *branch);
+    modified = true;
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,29 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class ConstantIfInlining
+
+Transformer that replaces an If node whose condition is a constant initializer with the nodes of the branch that is
+taken. Conditions that depend on shapes become constant once the dimensions are static or overridden by the free
+dimension overrides, and ConstantFolding has folded the Shape based computation of the condition. Inlining the branch
+removes the cost of executing the subgraph on every run and lets the other optimizers work across the former
+subgraph boundary.
+
+Branches that contain nodes with subgraphs are not inlined.
+*/
+class ConstantIfInlining : public GraphTransformer {
+ public:
+  ConstantIfInlining() noexcept : GraphTransformer("ConstantIfInlining") {}
+
+ private:
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+};
+
+}  // namespace onnxruntime
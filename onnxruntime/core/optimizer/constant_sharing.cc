@@ -1,8 +1,11 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <limits>
+#include <sstream>
 #include <variant>
 
+#include "core/framework/murmurhash3.h"
 #include "core/framework/tensorprotoutils.h"
 #include "core/graph/graph_utils.h"
 #include "core/optimizer/initializer.h"
@@ -172,6 +175,97 @@ size_t GetOrAddValueInConstantStore(
   return it - data_store.begin();
 }
 
+// Gets the number of elements of an initializer, or -1 if a dimension is negative.
+int64_t GetNumElements(const ONNX_NAMESPACE::TensorProto& tensor_proto) {
+  int64_t num_elements = 1;
+  for (int64_t dim : tensor_proto.dims()) {
+    if (dim < 0) {
+      return -1;
+    }
+    num_elements *= dim;
+  }
+  return num_elements;
+}
+
+/**
+ * @brief Deduplicate initializers with more than TENSOR_ELEM_COUNT_THRESHOLD elements.
+ *
+ * Initializers are grouped by data type and shape. Within a group, the data of each initializer is hashed with
+ * MurmurHash3, and initializers with the same hash are compared byte by byte before the consumers of the duplicate
+ * are moved to the first initializer, so at most two initializers are unpacked at a time.
+ * Returns the number of removed duplicates.
+ */
+int ShareLargeInitializers(Graph& graph, const InlinedVector<std::string>& initializer_names) {
+  InlinedHashMap<std::string, InlinedVector<std::string>> shape_groups;
+  for (const auto& initializer_name : initializer_names) {
+    const ONNX_NAMESPACE::TensorProto* tensor_proto = graph.GetConstantInitializer(initializer_name, true);
+    if (tensor_proto == nullptr || tensor_proto->data_type() == ONNX_NAMESPACE::TensorProto_DataType_STRING ||
+        GetNumElements(*tensor_proto) <= ConstantSharing::TENSOR_ELEM_COUNT_THRESHOLD) {
+      continue;
+    }
+
+    std::ostringstream key;
+    key << tensor_proto->data_type();
+    for (int64_t dim : tensor_proto->dims()) {
+      key << '_' << dim;
+    }
+    shape_groups[key.str()].push_back(initializer_name);
+  }
+
+  int shared_count = 0;
+  for (const auto& shape_group : shape_groups) {
+    const auto& names = shape_group.second;
+    if (names.size() < 2) {
+      continue;
+    }
+
+    // initializers kept for each hash of the data
+    InlinedHashMap<std::string, InlinedVector<const NodeArg*>> hash_to_kept_args;
+    for (const auto& initializer_name : names) {
+      const ONNX_NAMESPACE::TensorProto* tensor_proto = graph.GetConstantInitializer(initializer_name, true);
+      const NodeArg* node_arg = graph.GetNodeArg(initializer_name);
+      if (tensor_proto == nullptr || node_arg == nullptr) {
+        continue;
+      }
+
+      const Initializer initializer{*tensor_proto, graph.ModelPath()};
+      const auto data = initializer.DataAsByteSpan();
+      if (data.size() > static_cast<size_t>(std::numeric_limits<int>::max())) {
+        continue;
+      }
+      uint32_t hash[4] = {0, 0, 0, 0};
+      MurmurHash3::x86_128(data.data(), static_cast<int>(data.size()), 0, hash);
+      auto& kept_args = hash_to_kept_args[std::string(reinterpret_cast<const char*>(hash), sizeof(hash))];
+
+      const NodeArg* shared_arg = nullptr;
+      for (const NodeArg* kept_arg : kept_args) {
+        const Initializer kept_initializer{*graph.GetConstantInitializer(kept_arg->Name(), true), graph.ModelPath()};
+        if (SpanEq(kept_initializer.DataAsByteSpan(), data)) {
+          shared_arg = kept_arg;
+          break;
+        }
+      }
+
+      if (shared_arg == nullptr) {
+        kept_args.push_back(node_arg);
+        continue;
+      }
+
+      InlinedHashMap<const Node*, InlinedVector<int>> consumer_node_to_input_ports_map;
+      bool found_subgraph_usage = PrepareInputPortsToReplace(graph, node_arg, consumer_node_to_input_ports_map);
+      if (found_subgraph_usage || consumer_node_to_input_ports_map.size() == 0) {
+        continue;
+      }
+
+      ReplaceInputsToUseSharedInitializer(graph, consumer_node_to_input_ports_map, node_arg,
+                                          graph.GetNodeArg(shared_arg->Name()));
+      shared_count += 1;
+    }
+  }
+
+  return shared_count;
+}
+
 }  // namespace
 
 Status ConstantSharing::ApplyImpl(Graph& graph, bool& modified, int /*graph_level*/,
@@ -254,6 +348,12 @@ Status ConstantSharing::ApplyImpl(Graph& graph, bool& modified, int /*graph_leve
   }
 
   LOGS(logger, INFO) << "Total shared scalar initializer count: " << shared_count;
+
+  const int shared_large_count = ShareLargeInitializers(graph, original_initializer_names);
+  if (shared_large_count > 0) {
+    modified = true;
+  }
+  LOGS(logger, INFO) << "Total shared large initializer count: " << shared_large_count;
   return Status::OK();
 }
 
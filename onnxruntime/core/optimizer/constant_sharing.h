@@ -15,7 +15,8 @@ namespace onnxruntime {
 
 Transformer that traverses the graph top-down and performs constant sharing, i.e.,
 constant initializers having same dtype, value and shape, will be replaced by one single (newly created) initializer.
-Currently, only scalar valued initializers are handled.
+Initializers with up to TENSOR_ELEM_COUNT_THRESHOLD elements are compared by value. Larger initializers with the same
+dtype and shape are deduplicated by a MurmurHash3 of their data, and their consumers use the first of them.
 */
 class ConstantSharing : public GraphTransformer {
  public:
@@ -0,0 +1,216 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/elementwise_chain_fusion.h"
+
+#include "core/graph/graph_utils.h"
+#include "core/optimizer/utils.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace onnxruntime::common;
+
+namespace onnxruntime {
+
+// The CPU kernel of FusedElementwise supports float only.
+static constexpr std::array supported_data_types{"tensor(float)"};
+
+namespace {
+
+// Returns true if node is an elementwise operator supported by FusedElementwise::GetOpCode.
+bool IsFusibleOp(const Node& node, bool& is_binary) {
+  using graph_utils::IsSupportedOptypeVersionAndDomain;
+  if (IsSupportedOptypeVersionAndDomain(node, "Add", {7, 13, 14}) ||
+      IsSupportedOptypeVersionAndDomain(node, "Sub", {7, 13, 14}) ||
+      IsSupportedOptypeVersionAndDomain(node, "Mul", {7, 13, 14}) ||
+      IsSupportedOptypeVersionAndDomain(node, "Div", {7, 13, 14}) ||
+      IsSupportedOptypeVersionAndDomain(node, "Max", {8, 12, 13}) ||
+      IsSupportedOptypeVersionAndDomain(node, "Min", {8, 12, 13}) ||
+      IsSupportedOptypeVersionAndDomain(node, "PRelu", {7, 9, 16})) {
+    is_binary = true;
+  } else if (IsSupportedOptypeVersionAndDomain(node, "Neg", {6, 13}) ||
+             IsSupportedOptypeVersionAndDomain(node, "Abs", {6, 13}) ||
+             IsSupportedOptypeVersionAndDomain(node, "Relu", {6, 13, 14}) ||
+             IsSupportedOptypeVersionAndDomain(node, "Sigmoid", {6, 13}) ||
+             IsSupportedOptypeVersionAndDomain(node, "Tanh", {6, 13}) ||
+             IsSupportedOptypeVersionAndDomain(node, "Exp", {6, 13}) ||
+             IsSupportedOptypeVersionAndDomain(node, "Sqrt", {6, 13}) ||
+             IsSupportedOptypeVersionAndDomain(node, "Reciprocal", {6, 13}) ||
+             IsSupportedOptypeVersionAndDomain(node, "Erf", {9, 13}) ||
+             IsSupportedOptypeVersionAndDomain(node, "LeakyRelu", {6, 16}) ||
+             IsSupportedOptypeVersionAndDomain(node, "Gelu", {1}, kMSDomain) ||
+             IsSupportedOptypeVersionAndDomain(node, "QuickGelu", {1}, kMSDomain)) {
+    is_binary = false;
+  } else {
+    return false;
+  }
+
+  // Max and Min are variadic.
+  return node.InputDefs().size() == (is_binary ? 2u : 1u) && node.OutputDefs().size() == 1;
+}
+
+float GetAlpha(const Node& node, float default_value) {
+  const auto* attr = graph_utils::GetNodeAttribute(node, "alpha");
+  return attr != nullptr ? attr->f() : default_value;
+}
+
+// Steps of a tree of elementwise nodes in evaluation order, as described by the FusedElementwise schema.
+class ChainBuilder {
+ public:
+  ChainBuilder(Graph& graph, const Node& root, const InlinedHashSet<std::string_view>& providers)
+      : graph_(graph), root_(root), providers_(providers) {}
+
+  bool IsFusible(const Node& node) const {
+    bool is_binary;
+    return IsFusibleOp(node, is_binary) && graph_utils::IsSupportedProvider(node, providers_) &&
+           node.GetExecutionProviderType() == root_.GetExecutionProviderType() &&
+           optimizer_utils::IsSupportedDataType(node, supported_data_types);
+  }
+
+  // Adds the steps of node and of the producers absorbed into the tree, and returns the operand of its result.
+  int64_t AddNode(const Node& node) {
+    bool is_binary = false;
+    IsFusibleOp(node, is_binary);
+    int64_t operands[2] = {-1, -1};
+
+    for (int i = 0; i < (is_binary ? 2 : 1); i++) {
+      const Node::EdgeEnd* edge = graph_utils::GetInputEdge(node, i);
+      const Node* producer = edge != nullptr ? &edge->GetNode() : nullptr;
+      if (producer != nullptr && producer->GetOutputEdgesCount() == 1 && !graph_.NodeProducesGraphOutput(*producer) &&
+          IsFusible(*producer)) {
+        operands[i] = AddNode(*producer);
+      } else {
+        operands[i] = AddInput(node, i);
+      }
+    }
+
+    float alpha = 0.0f;
+    if (node.OpType() == "LeakyRelu") {
+      alpha = GetAlpha(node, 0.01f);
+    } else if (node.OpType() == "QuickGelu") {
+      alpha = GetAlpha(node, 1.702f);
+    }
+
+    ops_.push_back(node.OpType());
+    step_operands_.push_back({operands[0], operands[1]});
+    alphas_.push_back(alpha);
+    nodes_.push_back(node.Index());
+    return kStepOperand + static_cast<int64_t>(ops_.size() - 1);
+  }
+
+  size_t StepCount() const { return ops_.size(); }
+
+  // Replaces the nodes of the tree with a FusedElementwise node.
+  void Fuse() {
+    // Inputs refer to the producers with edges, since the producer map of the graph is only updated by Resolve.
+    InlinedVector<std::pair<const Node*, int>> input_sources;
+    for (const auto& [node_index, input_index] : input_args_) {
+      const Node::EdgeEnd* edge = graph_utils::GetInputEdge(*graph_.GetNode(node_index), input_index);
+      input_sources.push_back({edge != nullptr ? &edge->GetNode() : nullptr,
+                               edge != nullptr ? edge->GetSrcArgIndex() : -1});
+    }
+
+    InlinedVector<NodeArg*> inputs;
+    for (const auto& [node_index, input_index] : input_args_) {
+      inputs.push_back(graph_.GetNode(node_index)->MutableInputDefs()[input_index]);
+    }
+
+    Node& root = *graph_.GetNode(root_.Index());
+    NodeArg* output = root.MutableOutputDefs()[0];
+    const std::string provider = root.GetExecutionProviderType();
+    InlinedVector<std::pair<NodeIndex, int>> output_edges;
+    for (auto it = root.OutputEdgesBegin(), end = root.OutputEdgesEnd(); it != end; ++it) {
+      output_edges.push_back({it->GetNode().Index(), it->GetDstArgIndex()});
+    }
+
+    for (NodeIndex index : nodes_) {
+      Node& node = *graph_.GetNode(index);
+      graph_utils::RemoveNodeOutputEdges(graph_, node);
+      graph_.RemoveNode(index);
+    }
+
+    std::vector<int64_t> operands;
+    const int64_t input_count = static_cast<int64_t>(inputs.size());
+    for (const auto& step : step_operands_) {
+      for (int64_t operand : step) {
+        operands.push_back(operand >= kStepOperand ? operand - kStepOperand + input_count : operand);
+      }
+    }
+
+    Node& fused_node = graph_.AddNode(graph_.GenerateNodeName("FusedElementwise"), "FusedElementwise",
+                                      "Fused elementwise chain", inputs, {output}, nullptr, kMSDomain);
+    fused_node.AddAttribute("ops", gsl::make_span(ops_));
+    fused_node.AddAttribute("operands", gsl::make_span(operands));
+    fused_node.AddAttribute("alphas", gsl::make_span(alphas_));
+    fused_node.SetExecutionProviderType(provider);
+
+    for (size_t i = 0; i < input_sources.size(); i++) {
+      if (input_sources[i].first != nullptr) {
+        graph_.AddEdge(input_sources[i].first->Index(), fused_node.Index(), input_sources[i].second,
+                       static_cast<int>(i));
+      }
+    }
+    for (const auto& [node_index, dst_arg_index] : output_edges) {
+      graph_.AddEdge(fused_node.Index(), node_index, 0, dst_arg_index);
+    }
+  }
+
+ private:
+  // Operands at or above this value refer to steps until the number of inputs is known.
+  static constexpr int64_t kStepOperand = int64_t{1} << 32;
+
+  int64_t AddInput(const Node& node, int input_index) {
+    const std::string& name = node.InputDefs()[input_index]->Name();
+    for (size_t i = 0; i < input_args_.size(); i++) {
+      const auto& [other_node, other_index] = input_args_[i];
+      if (graph_.GetNode(other_node)->InputDefs()[other_index]->Name() == name) {
+        return static_cast<int64_t>(i);
+      }
+    }
+    input_args_.push_back({node.Index(), input_index});
+    return static_cast<int64_t>(input_args_.size() - 1);
+  }
+
+  Graph& graph_;
+  const Node& root_;
+  const InlinedHashSet<std::string_view>& providers_;
+  std::vector<std::string> ops_;
+  std::vector<std::array<int64_t, 2>> step_operands_;
+  std::vector<float> alphas_;
+  InlinedVector<NodeIndex> nodes_;
+  // Node and input index of each input of the fused node, with duplicates removed.
+  InlinedVector<std::pair<NodeIndex, int>> input_args_;
+};
+
+}  // namespace
+
+Status ElementwiseChainFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level,
+                                         const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+
+  // Visit the consumers first, so that each tree is collected from its root and is as large as possible.
+  for (auto it = node_topology_list.rbegin(); it != node_topology_list.rend(); ++it) {
+    Node* p_node = graph.GetNode(*it);
+    if (p_node == nullptr) continue;  // node was removed as part of an earlier fusion
+
+    Node& node = *p_node;
+    ORT_RETURN_IF_ERROR(Recurse(node, modified, graph_level, logger));
+
+    ChainBuilder chain(graph, node, GetCompatibleExecutionProviders());
+    if (!chain.IsFusible(node)) {
+      continue;
+    }
+
+    chain.AddNode(node);
+    if (chain.StepCount() < 2) {
+      continue;
+    }
+
+    chain.Fuse();
+    modified = true;
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
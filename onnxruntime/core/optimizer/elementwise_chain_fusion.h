@@ -0,0 +1,26 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class ElementwiseChainFusion
+
+Collapse every maximal tree of float elementwise nodes (Add, Sub, Mul, Div, Max, Min, PRelu and the unary
+activations) into one FusedElementwise node, so that the intermediate results are not written to memory.
+A producer is absorbed into the tree when its only consumer is in the tree and its output is not a graph output.
+The specialized fusions (BiasGelu, QuickGelu, ...) should run before this one so that they keep their patterns.
+*/
+class ElementwiseChainFusion : public GraphTransformer {
+ public:
+  ElementwiseChainFusion(const InlinedHashSet<std::string_view>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("ElementwiseChainFusion", compatible_execution_providers) {}
+
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+};
+
+}  // namespace onnxruntime
@@ -0,0 +1,125 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/embedding_bag_fusion.h"
+
+#include "core/graph/graph_utils.h"
+#include "core/optimizer/utils.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace onnxruntime::common;
+
+namespace onnxruntime {
+
+// The fusion is limited to float tables, so the float output of EmbeddingBag matches the Reduce output.
+static constexpr std::array supported_data_types{"tensor(float)"};
+
+// Map a Reduce node to the EmbeddingBag mode, along with the first opset version of the op taking axes as input.
+static const char* GetReduceMode(const Node& node, int& axes_input_since) {
+  if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "ReduceSum", {1, 11, 13})) {
+    axes_input_since = 13;
+    return "sum";
+  }
+  if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "ReduceMean", {1, 11, 13, 18})) {
+    axes_input_since = 18;
+    return "mean";
+  }
+  if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "ReduceMax", {1, 11, 12, 13, 18})) {
+    axes_input_since = 18;
+    return "max";
+  }
+  return nullptr;
+}
+
+static bool GetReduceAxes(const Graph& graph, const Node& reduce, int axes_input_since, InlinedVector<int64_t>& axes) {
+  if (reduce.SinceVersion() >= axes_input_since) {
+    return reduce.InputDefs().size() > 1 && reduce.InputDefs()[1]->Exists() &&
+           optimizer_utils::AppendTensorFromInitializer(graph, *reduce.InputDefs()[1], axes);
+  }
+
+  const auto* axes_attr = graph_utils::GetNodeAttribute(reduce, "axes");
+  if (axes_attr == nullptr) {
+    return false;
+  }
+  axes.assign(axes_attr->ints().begin(), axes_attr->ints().end());
+  return true;
+}
+
+static bool FuseEmbeddingBag(Graph& graph, Node& reduce) {
+  int axes_input_since = 0;
+  const char* mode = GetReduceMode(reduce, axes_input_since);
+  if (mode == nullptr || !optimizer_utils::IsAttributeWithExpectedValue(reduce, "keepdims", static_cast<int64_t>(0))) {
+    return false;
+  }
+
+  // Gather(weight, indices) with 2-D indices has rank 3, and the bag axis is axis 1.
+  InlinedVector<int64_t> axes;
+  if (!GetReduceAxes(graph, reduce, axes_input_since, axes) || axes.size() != 1 || (axes[0] != 1 && axes[0] != -2)) {
+    return false;
+  }
+
+  const Node* gather = graph_utils::GetInputNode(reduce, 0);
+  if (gather == nullptr || !graph_utils::IsSupportedOptypeVersionAndDomain(*gather, "Gather", {1, 11, 13}) ||
+      gather->GetExecutionProviderType() != reduce.GetExecutionProviderType() ||
+      gather->GetOutputEdgesCount() != 1 || graph.NodeProducesGraphOutput(*gather)) {
+    return false;
+  }
+
+  const auto* gather_axis = graph_utils::GetNodeAttribute(*gather, "axis");
+  if (gather_axis != nullptr && gather_axis->i() != 0) {
+    return false;
+  }
+
+  const NodeArg& weight = *gather->InputDefs()[0];
+  const NodeArg& indices = *gather->InputDefs()[1];
+  if (weight.Shape() == nullptr || weight.Shape()->dim_size() != 2 ||
+      indices.Shape() == nullptr || indices.Shape()->dim_size() != 2) {
+    return false;
+  }
+
+  Node& embedding_bag = graph.AddNode(graph.GenerateNodeName("EmbeddingBag"),
+                                      "EmbeddingBag",
+                                      "Fused Gather and " + reduce.OpType(),
+                                      {graph.GetNodeArg(weight.Name()), graph.GetNodeArg(indices.Name())},
+                                      {reduce.MutableOutputDefs()[0]},
+                                      nullptr,
+                                      kMSDomain);
+  embedding_bag.AddAttribute("mode", std::string(mode));
+  embedding_bag.SetExecutionProviderType(reduce.GetExecutionProviderType());
+
+  const NodeIndex nodes_to_remove[] = {reduce.Index(), gather->Index()};
+  for (NodeIndex index : nodes_to_remove) {
+    Node* node = graph.GetNode(index);
+    graph_utils::RemoveNodeOutputEdges(graph, *node);
+    graph.RemoveNode(index);
+  }
+
+  return true;
+}
+
+Status EmbeddingBagFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level,
+                                     const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+
+  for (auto node_index : node_topology_list) {
+    Node* p_node = graph.GetNode(node_index);
+    if (p_node == nullptr) continue;  // node was removed as part of an earlier fusion
+
+    Node& node = *p_node;
+    ORT_RETURN_IF_ERROR(Recurse(node, modified, graph_level, logger));
+
+    if (!graph_utils::IsSupportedProvider(node, GetCompatibleExecutionProviders()) ||
+        !optimizer_utils::IsSupportedDataType(node, supported_data_types)) {
+      continue;
+    }
+
+    if (FuseEmbeddingBag(graph, node)) {
+      modified = true;
+    }
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,28 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class EmbeddingBagFusion
+
+Rewrite the embedding bag lookups of recommendation models exported as
+
+    ReduceSum|ReduceMean|ReduceMax(Gather(weight, indices), axes=[1], keepdims=0)
+
+with 2-D indices of shape (num_bags, bag_size) to an EmbeddingBag node, which reduces the looked up rows of
+each bag without materializing the (num_bags, bag_size, embedding_dim) Gather output.
+*/
+class EmbeddingBagFusion : public GraphTransformer {
+ public:
+  EmbeddingBagFusion(const InlinedHashSet<std::string_view>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("EmbeddingBagFusion", compatible_execution_providers) {}
+
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+};
+
+}  // namespace onnxruntime
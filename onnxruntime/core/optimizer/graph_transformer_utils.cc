@@ -6,6 +6,8 @@
 #include <algorithm>
 #include <variant>
 
+#include "core/common/parse_string.h"
+#include "core/common/string_utils.h"
 #include "core/optimizer/conv_activation_fusion.h"
 #include "core/optimizer/nhwc_transformer.h"
 #include "core/optimizer/qdq_transformer/qdq_final_cleanup.h"
@@ -17,12 +19,15 @@
 
 #include "core/mlas/inc/mlas.h"
 #include "core/optimizer/attention_fusion.h"
+#include "core/optimizer/auto_mixed_precision.h"
 #include "core/optimizer/bias_dropout_fusion.h"
 #include "core/optimizer/bias_gelu_fusion.h"
 #include "core/optimizer/bias_softmax_fusion.h"
 #include "core/optimizer/cast_elimination.h"
+#include "core/optimizer/cast_fusion.h"
 #include "core/optimizer/common_subexpression_elimination.h"
 #include "core/optimizer/constant_folding.h"
+#include "core/optimizer/constant_if_inlining.h"
 #include "core/optimizer/constant_sharing.h"
 #include "core/optimizer/conv_add_act_fusion.h"
 #include "core/optimizer/conv_add_fusion.h"
@@ -32,7 +37,9 @@
 #include "core/optimizer/double_qdq_pairs_remover.h"
 #include "core/optimizer/dropout_elimination.h"
 #include "core/optimizer/dynamic_quantize_matmul_fusion.h"
+#include "core/optimizer/elementwise_chain_fusion.h"
 #include "core/optimizer/embed_layer_norm_fusion.h"
+#include "core/optimizer/embedding_bag_fusion.h"
 #include "core/optimizer/expand_elimination.h"
 #include "core/optimizer/fast_gelu_fusion.h"
 #include "core/optimizer/free_dim_override_transformer.h"
@@ -45,11 +52,13 @@
 #include "core/optimizer/identical_children_consolidation.h"
 #include "core/optimizer/identity_elimination.h"
 #include "core/optimizer/layer_norm_fusion.h"
+#include "core/optimizer/loop_unrolling.h"
 #include "core/optimizer/matmul_activation_fusion.h"
 #include "core/optimizer/matmul_add_fusion.h"
 #include "core/optimizer/matmul_integer_to_float.h"
 #include "core/optimizer/matmul_scale_fusion.h"
 #include "core/optimizer/matmul_transpose_fusion.h"
+#include "core/optimizer/memory_budget_optimizer.h"
 #include "core/optimizer/nchwc_transformer.h"
 #include "core/optimizer/noop_elimination.h"
 #include "core/optimizer/not_where_fusion.h"
@@ -62,13 +71,17 @@
 #include "core/optimizer/qdq_transformer/qdq_propagation.h"
 #include "core/optimizer/qdq_transformer/qdq_s8_to_u8.h"
 #include "core/optimizer/qdq_transformer/relu_quantizelinear.h"
+#include "core/optimizer/qlinear_conv_add_fusion.h"
 #include "core/optimizer/quick_gelu_fusion.h"
 #include "core/optimizer/relu_clip_fusion.h"
 #include "core/optimizer/reshape_fusion.h"
 #include "core/optimizer/rocm_blas_alt_impl.h"
+#include "core/optimizer/rotary_embedding_fusion.h"
 #include "core/optimizer/rule_based_graph_transformer.h"
+#include "core/optimizer/scaled_dot_product_attention_fusion.h"
 #include "core/optimizer/skip_layer_norm_fusion.h"
 #include "core/optimizer/slice_elimination.h"
+#include "core/optimizer/tensor_parallel_transformer.h"
 #include "core/optimizer/transpose_optimizer/ort_transpose_optimizer.h"
 #include "core/optimizer/unsqueeze_elimination.h"
 #ifdef ENABLE_TRAINING
@@ -214,7 +227,16 @@ InlinedVector<std::unique_ptr<GraphTransformer>> GenerateTransformers(
       transformers.emplace_back(std::make_unique<ConstantSharing>(no_limit_empty_ep_list, excluded_initializers));
 
       transformers.emplace_back(std::make_unique<CommonSubexpressionElimination>());
-      transformers.emplace_back(std::make_unique<ConstantFolding>(cpu_execution_provider, !disable_quant_qdq));
+      const float constant_folding_max_growth_ratio = ParseStringWithClassicLocale<float>(
+          session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConstantFoldingMaxGrowthRatio, "0"));
+      transformers.emplace_back(std::make_unique<ConstantFolding>(cpu_execution_provider, !disable_quant_qdq,
+                                                                  InlinedHashSet<std::string_view>{},
+                                                                  InlinedHashSet<std::string>{},
+                                                                  constant_folding_max_growth_ratio));
+      // inline the taken branch of If nodes whose condition was folded to a constant, e.g. from static dimensions.
+      transformers.emplace_back(std::make_unique<ConstantIfInlining>());
+      // unroll Loop nodes with small constant trip counts and batch Scan nodes over MatMul and element-wise bodies.
+      transformers.emplace_back(std::make_unique<LoopUnrolling>());
       transformers.emplace_back(std::make_unique<MatMulAddFusion>());
       transformers.emplace_back(std::make_unique<ReshapeFusion>());
       transformers.emplace_back(std::make_unique<FreeDimensionOverrideTransformer>(
@@ -230,6 +252,27 @@ InlinedVector<std::unique_ptr<GraphTransformer>> GenerateTransformers(
         transformers.emplace_back(std::make_unique<EnsureUniqueDQForNodeUnit>());
       }
 
+      // convert the float computation to float16 or bfloat16 once the other Level1 optimizers simplified the graph.
+      const std::string auto_mixed_precision =
+          session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsAutoMixedPrecision, "");
+      if (!auto_mixed_precision.empty()) {
+        ORT_ENFORCE(auto_mixed_precision == "fp16" || auto_mixed_precision == "bf16",
+                    "Invalid value for ", kOrtSessionOptionsAutoMixedPrecision, ": ", auto_mixed_precision);
+        auto get_op_types = [&session_options](const char* config_key) {
+          const std::string op_types_str = session_options.config_options.GetConfigOrDefault(config_key, "");
+          InlinedHashSet<std::string> op_types;
+          for (const auto& op_type : utils::SplitString(op_types_str, ",")) {
+            op_types.emplace(op_type);
+          }
+          return op_types;
+        };
+        transformers.emplace_back(std::make_unique<AutoMixedPrecision>(
+            auto_mixed_precision == "fp16" ? ONNX_NAMESPACE::TensorProto_DataType_FLOAT16
+                                           : ONNX_NAMESPACE::TensorProto_DataType_BFLOAT16,
+            get_op_types(kOrtSessionOptionsAutoMixedPrecisionAllowOps),
+            get_op_types(kOrtSessionOptionsAutoMixedPrecisionDenyOps)));
+      }
+
       // add __backwardpass attribute to nodes after YieldOp, ROCm-only
       const InlinedHashSet<std::string_view> rocm_ep = {onnxruntime::kRocmExecutionProvider};
       transformers.emplace_back(std::make_unique<RocmBlasAltImpl>(rocm_ep));
@@ -286,13 +329,19 @@ InlinedVector<std::unique_ptr<GraphTransformer>> GenerateTransformers(
       transformers.emplace_back(std::make_unique<GemmActivationFusion>(cpu_ep));
       transformers.emplace_back(std::make_unique<MatMulIntegerToFloatFusion>(cpu_ep));
       transformers.emplace_back(std::make_unique<DynamicQuantizeMatMulFusion>(cpu_ep));
+      transformers.emplace_back(std::make_unique<QLinearConvAddFusion>(cpu_ep));
 
       transformers.emplace_back(std::make_unique<ConvActivationFusion>(cpu_cuda_rocm_acl_armnn_eps));
 
       transformers.emplace_back(std::make_unique<GeluFusion>(cpu_cuda_dml_rocm_eps));
       transformers.emplace_back(std::make_unique<LayerNormFusion>(cpu_cuda_dml_rocm_eps));
       transformers.emplace_back(std::make_unique<SimplifiedLayerNormFusion>(cpu_cuda_rocm_eps));
+      transformers.emplace_back(std::make_unique<LayerNormScaleFusion>(cpu_cuda_dml_rocm_eps));
       transformers.emplace_back(std::make_unique<AttentionFusion>(cpu_cuda_dml_rocm_eps));
+      transformers.emplace_back(std::make_unique<ScaledDotProductAttentionFusion>(cpu_cuda_rocm_eps));
+      transformers.emplace_back(std::make_unique<RotaryEmbeddingFusion>(cpu_ep));
+      transformers.emplace_back(std::make_unique<EmbeddingBagFusion>(cpu_ep));
+      transformers.emplace_back(std::make_unique<CastFusion>(cpu_ep));
       transformers.emplace_back(std::make_unique<EmbedLayerNormFusion>(cpu_cuda_dml_rocm_eps));
       transformers.emplace_back(std::make_unique<GatherToSplitFusion>(cpu_cuda_rocm_eps));
       transformers.emplace_back(std::make_unique<GatherToSliceFusion>(cpu_cuda_rocm_eps));
@@ -328,11 +377,35 @@ InlinedVector<std::unique_ptr<GraphTransformer>> GenerateTransformers(
       }
 #endif
 
+      // shard the weights once the MLP and attention blocks are fused
+      const int64_t tensor_parallel_world_size = ParseStringWithClassicLocale<int64_t>(
+          session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsTensorParallelWorldSize, "1"));
+      if (tensor_parallel_world_size > 1) {
+        const int64_t tensor_parallel_rank = ParseStringWithClassicLocale<int64_t>(
+            session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsTensorParallelRank, "0"));
+        ORT_ENFORCE(tensor_parallel_rank >= 0 && tensor_parallel_rank < tensor_parallel_world_size,
+                    "Invalid value for ", kOrtSessionOptionsTensorParallelRank, ": ", tensor_parallel_rank);
+#ifdef USE_MPI
+        const InlinedHashSet<std::string_view> cuda_ep = {onnxruntime::kCudaExecutionProvider};
+        transformers.emplace_back(std::make_unique<TensorParallelTransformer>(tensor_parallel_world_size,
+                                                                              tensor_parallel_rank, cuda_ep));
+#else
+        ORT_THROW(kOrtSessionOptionsTensorParallelWorldSize, " requires a build with MPI and NCCL.");
+#endif
+      }
+
 #endif  // !defined(DISABLE_CONTRIB_OPS)
       // The QDQFinalCleanupTransformer must run AFTER other transformers that fuse Q/DQ nodes. Otherwise, their
       // fusions might be prevented if this one removes a Q/DQ node too early.
       transformers.emplace_back(std::make_unique<QDQFinalCleanupTransformer>(enable_quant_qdq_cleanup));
 
+      // MemoryBudgetOptimizer runs after the fusions so that it estimates the memory of the nodes that will run.
+      const size_t memory_budget = ParseStringWithClassicLocale<size_t>(
+          session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsMemoryBudgetBytes, "0"));
+      if (memory_budget > 0) {
+        transformers.emplace_back(std::make_unique<MemoryBudgetOptimizer>(memory_budget));
+      }
+
 #ifdef ENABLE_TRAINING
       // Put memory optimization transformer at last (which is done after most of fusions are done) by intention.
       // Known issue: after memory optimization is completed, if some fusion happens, it is possible that the
@@ -342,7 +415,10 @@ InlinedVector<std::unique_ptr<GraphTransformer>> GenerateTransformers(
           session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsMemoryOptimizerEnabler, "");
       const std::string probe_level =
           session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsMemoryOptimizerProbeLevel, "0");
-      transformers.emplace_back(std::make_unique<MemoryOptimizer>(enable_memory_optimizer, probe_level));
+      const std::string memory_budget_ratio =
+          session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsMemoryOptimizerBudget, "");
+      transformers.emplace_back(
+          std::make_unique<MemoryOptimizer>(enable_memory_optimizer, probe_level, memory_budget_ratio));
 #endif
 
     } break;
@@ -366,6 +442,12 @@ InlinedVector<std::unique_ptr<GraphTransformer>> GenerateTransformers(
       // PR #6351 implemented similar fusion-pattern for CUDA only, and can only fuse conv-add-relu,
       // while we can fuse more activation.
       transformers.emplace_back(std::make_unique<ConvAddActivationFusion>(cpu_ep));
+
+      // ElementwiseChainFusion runs after the layout transformers, which fuse Add/Relu into the convolutions.
+      if (session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsEnableElementwiseChainFusion, "0") ==
+          "1") {
+        transformers.emplace_back(std::make_unique<ElementwiseChainFusion>(cpu_ep));
+      }
 #endif
 
     } break;
@@ -732,4 +732,129 @@ Status SimplifiedLayerNormFusion::ApplyImpl(Graph& graph, bool& modified, int gr
   return Status::OK();
 }
 
+/**
+Fold the smoothing factors s of a Mul that follows a normalization node into its scale and bias. The normalized
+values are multiplied by scale * s + bias * s, as the Mul multiplies each channel of the last axis by s. Only the
+first output of the normalization depends on the scale and bias, so its other outputs (e.g. the sum of the input
+and the skip of SkipLayerNormalization) are left as they are.
+*/
+Status LayerNormScaleFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level,
+                                       const logging::Logger& logger) const {
+  struct NormalizationOp {
+    std::string_view op_type;
+    std::string_view domain;
+    int scale_index;
+    int bias_index;  // -1 if the op has no bias
+  };
+  static const std::array<NormalizationOp, 4> normalization_ops{{
+      {"LayerNormalization", kOnnxDomain, 1, 2},
+      {"SimplifiedLayerNormalization", kOnnxDomain, 1, -1},
+      {"SkipLayerNormalization", kMSDomain, 2, 3},
+      {"SkipSimplifiedLayerNormalization", kMSDomain, 2, -1},
+  }};
+
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+
+  for (auto node_index : node_topology_list) {
+    auto* p_norm = graph.GetNode(node_index);
+    if (p_norm == nullptr)
+      continue;  // we removed the node as part of an earlier fusion
+
+    Node& norm_node = *p_norm;
+    ORT_RETURN_IF_ERROR(Recurse(norm_node, modified, graph_level, logger));
+
+    const auto op = std::find_if(normalization_ops.begin(), normalization_ops.end(), [&](const NormalizationOp& op) {
+      return norm_node.OpType() == op.op_type && norm_node.Domain() == op.domain;
+    });
+    if (op == normalization_ops.end() ||
+        !graph_utils::IsSupportedProvider(norm_node, GetCompatibleExecutionProviders()) ||
+        norm_node.GetOutputEdgesCount() == 0) {
+      continue;
+    }
+
+    // The first output must only be consumed by the Mul.
+    const auto output_edges = graph_utils::GraphEdge::GetNodeOutputEdges(norm_node, 0);
+    if (output_edges.size() != 1 || graph.IsOutput(norm_node.OutputDefs()[0])) {
+      continue;
+    }
+
+    Node& mul_node = *graph.GetNode(output_edges[0].dst_node);
+    if (!graph_utils::IsSupportedOptypeVersionAndDomain(mul_node, "Mul", {7, 13, 14}) ||
+        mul_node.GetExecutionProviderType() != norm_node.GetExecutionProviderType() ||
+        graph.NodeProducesGraphOutput(mul_node)) {
+      continue;
+    }
+
+    const NodeArg* smoothing_arg = mul_node.InputDefs()[1 - output_edges[0].dst_arg_index];
+    const auto& norm_inputs = norm_node.InputDefs();
+    const bool has_bias = op->bias_index >= 0 && static_cast<int>(norm_inputs.size()) > op->bias_index &&
+                          norm_inputs[op->bias_index]->Exists();
+    if (static_cast<int>(norm_inputs.size()) <= op->scale_index ||
+        !graph_utils::NodeArgIsConstant(graph, *smoothing_arg) ||
+        !graph_utils::NodeArgIsConstant(graph, *norm_inputs[op->scale_index]) ||
+        (has_bias && !graph_utils::NodeArgIsConstant(graph, *norm_inputs[op->bias_index]))) {
+      continue;
+    }
+
+    const auto* smoothing_proto = graph_utils::GetConstantInitializer(graph, smoothing_arg->Name());
+    const auto* scale_proto = graph_utils::GetConstantInitializer(graph, norm_inputs[op->scale_index]->Name());
+    const auto* bias_proto =
+        has_bias ? graph_utils::GetConstantInitializer(graph, norm_inputs[op->bias_index]->Name()) : nullptr;
+    if (smoothing_proto == nullptr || scale_proto == nullptr || (has_bias && bias_proto == nullptr)) {
+      continue;
+    }
+
+    // The scale normalizes the last axis, and the Mul must multiply the channels of that axis without broadcasting
+    // its output to a larger shape than the output of the normalization.
+    if (scale_proto->dims_size() != 1 || !optimizer_utils::IsFloatingPointDataType(*scale_proto) ||
+        smoothing_proto->data_type() != scale_proto->data_type() ||
+        (has_bias && (bias_proto->data_type() != scale_proto->data_type() ||
+                      bias_proto->dims_size() != 1 || bias_proto->dims(0) != scale_proto->dims(0)))) {
+      continue;
+    }
+
+    const int smoothing_rank = smoothing_proto->dims_size();
+    if (smoothing_rank == 0 || smoothing_proto->dims(smoothing_rank - 1) != scale_proto->dims(0)) {
+      continue;
+    }
+    bool is_per_channel = true;
+    for (int i = 0; i < smoothing_rank - 1; i++) {
+      is_per_channel = is_per_channel && smoothing_proto->dims(i) == 1;
+    }
+    const auto* output_shape = norm_node.OutputDefs()[0]->Shape();
+    if (!is_per_channel ||
+        (smoothing_rank > 1 && (output_shape == nullptr || output_shape->dim_size() < smoothing_rank))) {
+      continue;
+    }
+
+    Initializer smoothing{*smoothing_proto, graph.ModelPath()};
+    Initializer scale{*scale_proto, graph.ModelPath()};
+    scale.mul(smoothing);
+
+    ONNX_NAMESPACE::TensorProto new_scale_proto(*scale_proto);
+    scale.ToProto(new_scale_proto);
+    new_scale_proto.set_name(graph.GenerateNodeArgName("LayerNormScaleFusion_scale_" + scale_proto->name()));
+    graph_utils::ReplaceNodeInput(norm_node, op->scale_index, graph_utils::AddInitializer(graph, new_scale_proto));
+
+    if (has_bias) {
+      Initializer bias{*bias_proto, graph.ModelPath()};
+      bias.mul(smoothing);
+
+      ONNX_NAMESPACE::TensorProto new_bias_proto(*bias_proto);
+      bias.ToProto(new_bias_proto);
+      new_bias_proto.set_name(graph.GenerateNodeArgName("LayerNormScaleFusion_bias_" + bias_proto->name()));
+      graph_utils::ReplaceNodeInput(norm_node, op->bias_index, graph_utils::AddInitializer(graph, new_bias_proto));
+    }
+
+    // Connect the consumers of the Mul to the normalization and remove the Mul.
+    graph_utils::RemoveNodeOutputEdges(graph, norm_node, 0);
+    graph_utils::ReplaceDownstreamNodeInput(graph, mul_node, 0, norm_node, 0);
+    graph.RemoveNode(mul_node.Index());
+
+    modified = true;
+  }
+  return Status::OK();
+}
+
 }  // namespace onnxruntime
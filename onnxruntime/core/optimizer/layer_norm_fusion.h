@@ -49,4 +49,24 @@ class SimplifiedLayerNormFusion : public GraphTransformer {
   bool skip_device_check_;
 };
 
+/**
+@Class LayerNormScaleFusion
+
+Fold a per-channel Mul by a constant that follows a (Skip)(Simplified)LayerNormalization node into its scale and
+bias, as inserted by SmoothQuant style quantization to divide the activation outliers by per-channel smoothing
+factors before they are quantized:
+
+X --> LayerNormalization --> Mul(s) --> QuantizeLinear / MatMul    =>    X --> LayerNormalization --> ...
+          ^        ^                                                              ^          ^
+        scale     bias                                                       scale * s   bias * s
+
+*/
+class LayerNormScaleFusion : public GraphTransformer {
+ public:
+  LayerNormScaleFusion(const InlinedHashSet<std::string_view>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("LayerNormScaleFusion", compatible_execution_providers) {}
+
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+};
+
 }  // namespace onnxruntime
@@ -0,0 +1,545 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/loop_unrolling.h"
+
+#include <algorithm>
+#include <optional>
+#include <string_view>
+
+#include "core/graph/graph_utils.h"
+#include "core/graph/graph_viewer.h"
+#include "core/optimizer/initializer.h"
+
+using namespace ONNX_NAMESPACE;
+
+namespace onnxruntime {
+
+namespace {
+
+// Element-wise ops that can be applied to the whole scan inputs instead of one slice at a time.
+constexpr std::string_view kBatchableElementwiseOps[] = {
+    "Abs", "Add", "Cast", "Div", "Erf", "Exp", "Identity", "LeakyRelu", "Log", "Mul", "Neg", "Pow",
+    "Reciprocal", "Relu", "Sigmoid", "Softplus", "Sqrt", "Sub", "Tanh"};
+
+bool IsBatchableElementwiseOp(const std::string& op_type) {
+  return std::find(std::begin(kBatchableElementwiseOps), std::end(kBatchableElementwiseOps), op_type) !=
+         std::end(kBatchableElementwiseOps);
+}
+
+// Copy of a node of a body, as the body is destroyed with its Loop or Scan node before the copies are added.
+struct BodyNode {
+  std::string name;
+  std::string op_type;
+  std::string description;
+  std::string domain;
+  NodeAttributes attributes;
+  InlinedVector<std::string> inputs;
+  InlinedVector<std::string> outputs;
+};
+
+// Copy of the nodes and initializers of a body, with the element types of its values. The shapes of the body values
+// are those of one iteration or slice, so they are left to be inferred when the graph is resolved.
+struct BodyCopy {
+  InlinedVector<BodyNode> nodes;
+  InlinedVector<TensorProto> initializers;
+  InlinedHashMap<std::string, TypeProto> types;
+};
+
+BodyCopy CopyBody(const Graph& body) {
+  BodyCopy copy;
+  auto record_type = [&copy](const NodeArg& node_arg) {
+    if (node_arg.Exists() && node_arg.TypeAsProto() != nullptr && copy.types.count(node_arg.Name()) == 0) {
+      TypeProto type(*node_arg.TypeAsProto());
+      if (type.has_tensor_type()) {
+        type.mutable_tensor_type()->clear_shape();
+      }
+      copy.types.emplace(node_arg.Name(), std::move(type));
+    }
+  };
+
+  GraphViewer body_viewer(body);
+  for (NodeIndex index : body_viewer.GetNodesInTopologicalOrder()) {
+    const Node& node = *body.GetNode(index);
+    BodyNode node_copy{node.Name(), node.OpType(), node.Description(), node.Domain(), node.GetAttributes(), {}, {}};
+    for (const auto* input_def : node.InputDefs()) {
+      record_type(*input_def);
+      node_copy.inputs.push_back(input_def->Name());
+    }
+    for (const auto* output_def : node.OutputDefs()) {
+      record_type(*output_def);
+      node_copy.outputs.push_back(output_def->Name());
+    }
+    copy.nodes.push_back(std::move(node_copy));
+  }
+
+  for (const auto* output : body.GetOutputs()) {
+    record_type(*output);
+  }
+
+  for (const auto& entry : body.GetAllInitializedTensors()) {
+    copy.initializers.push_back(*entry.second);
+  }
+
+  return copy;
+}
+
+bool HasNestedSubgraph(const Graph& body) {
+  return std::any_of(body.Nodes().begin(), body.Nodes().end(),
+                     [](const Node& node) { return node.ContainsSubgraph(); });
+}
+
+// Gets the single value of a constant initializer of the given type, checking the outer scope too.
+template <typename T>
+std::optional<T> GetConstantScalar(const Graph& graph, const std::string& name, int32_t data_type) {
+  const auto* tensor_proto = name.empty() ? nullptr : graph.GetConstantInitializer(name, true);
+  if (tensor_proto == nullptr || tensor_proto->data_type() != data_type) {
+    return std::nullopt;
+  }
+
+  const Initializer value{*tensor_proto, graph.ModelPath()};
+  if (value.size() != 1) {
+    return std::nullopt;
+  }
+  return *value.data<T>();
+}
+
+bool IsConstantTrue(const Graph& graph, const std::string& name) {
+  const auto value = GetConstantScalar<bool>(graph, name, TensorProto_DataType_BOOL);
+  return value.has_value() && *value;
+}
+
+// Checks if the condition output of a Loop body is always true when its condition input is.
+bool BodyKeepsConditionTrue(const Graph& body) {
+  const std::string& cond_in = body.GetInputs()[1]->Name();
+  const std::string& cond_out = body.GetOutputs()[0]->Name();
+  if (cond_out == cond_in || IsConstantTrue(body, cond_out)) {
+    return true;
+  }
+
+  const Node* producer = body.GetProducerNode(cond_out);
+  return producer != nullptr && producer->OpType() == "Identity" && producer->InputDefs()[0]->Name() == cond_in;
+}
+
+// Gets the trip count of a Loop node that can be unrolled.
+std::optional<int64_t> GetUnrollableTripCount(const Graph& graph, const Node& loop_node, const Graph& body) {
+  const auto& inputs = loop_node.InputDefs();
+  const auto trip_count = GetConstantScalar<int64_t>(graph, inputs[0]->Name(), TensorProto_DataType_INT64);
+  if (!trip_count.has_value() || *trip_count < 1 || *trip_count > LoopUnrolling::kMaxTripCount) {
+    return std::nullopt;
+  }
+
+  // without a constant true condition the number of iterations is only known at run time
+  if (inputs.size() < 2 || (inputs[1]->Exists() && !IsConstantTrue(graph, inputs[1]->Name())) ||
+      body.GetInputs().size() < 2 || body.GetOutputs().empty() || !BodyKeepsConditionTrue(body)) {
+    return std::nullopt;
+  }
+
+  if (static_cast<size_t>(*trip_count) * static_cast<size_t>(body.NumberOfNodes()) >
+      LoopUnrolling::kMaxUnrolledNodes) {
+    return std::nullopt;
+  }
+
+  return trip_count;
+}
+
+// Replaces loop_node with trip_count copies of the nodes of its body.
+void UnrollLoop(Graph& graph, Node& loop_node, const Graph& body, int64_t trip_count) {
+  const std::string suffix = graph.GenerateNodeName("_unroll_" + loop_node.Name());
+
+  BodyCopy copy = CopyBody(body);
+
+  const auto& body_inputs = body.GetInputs();
+  const auto& body_outputs = body.GetOutputs();
+  const size_t num_carried = body_inputs.size() - 2;
+  const std::string iteration_num = body_inputs[0]->Name();
+  const std::string cond_in = body_inputs[1]->Name();
+
+  InlinedVector<std::string> body_carried_inputs;
+  for (size_t i = 0; i < num_carried; ++i) {
+    body_carried_inputs.push_back(body_inputs[2 + i]->Name());
+  }
+  InlinedVector<std::string> body_carried_outputs;
+  InlinedVector<std::string> body_scan_outputs;
+  for (size_t i = 1; i < body_outputs.size(); ++i) {
+    (i <= num_carried ? body_carried_outputs : body_scan_outputs).push_back(body_outputs[i]->Name());
+  }
+
+  // the values carried into the first iteration are the initial values of the Loop node
+  InlinedVector<std::string> carried;
+  for (size_t i = 2; i < loop_node.InputDefs().size(); ++i) {
+    carried.push_back(loop_node.InputDefs()[i]->Name());
+  }
+  InlinedVector<std::string> loop_outputs;
+  for (const auto* output_def : loop_node.OutputDefs()) {
+    loop_outputs.push_back(output_def->Exists() ? output_def->Name() : std::string{});
+  }
+
+  // the initializers of the body are shared by all the iterations
+  InlinedHashMap<std::string, std::string> initializer_names;
+  for (auto& initializer : copy.initializers) {
+    initializer_names[initializer.name()] = graph.GenerateNodeArgName(initializer.name() + suffix);
+    initializer.set_name(initializer_names[initializer.name()]);
+  }
+
+  // remove the Loop node, which destroys the body, before adding the nodes that produce its outputs
+  graph_utils::RemoveNodeOutputEdges(graph, loop_node);
+  graph.RemoveNode(loop_node.Index());
+
+  for (const auto& initializer : copy.initializers) {
+    graph_utils::AddInitializer(graph, initializer);
+  }
+
+  TensorProto cond_true;
+  cond_true.set_name(graph.GenerateNodeArgName(cond_in + suffix));
+  cond_true.set_data_type(TensorProto_DataType_BOOL);
+  cond_true.add_int32_data(1);
+  graph_utils::AddInitializer(graph, cond_true);
+
+  auto get_node_arg = [&](const std::string& name, const std::string& body_name) -> NodeArg* {
+    auto type_it = copy.types.find(body_name);
+    return &graph.GetOrCreateNodeArg(name, type_it != copy.types.end() ? &type_it->second : nullptr);
+  };
+
+  InlinedVector<InlinedVector<std::string>> scan_values(body_scan_outputs.size());
+  for (int64_t iteration = 0; iteration < trip_count; ++iteration) {
+    const std::string iteration_suffix = suffix + "_" + std::to_string(iteration);
+
+    TensorProto iteration_value;
+    iteration_value.set_name(graph.GenerateNodeArgName(iteration_num + iteration_suffix));
+    iteration_value.set_data_type(TensorProto_DataType_INT64);
+    iteration_value.add_int64_data(iteration);
+    graph_utils::AddInitializer(graph, iteration_value);
+
+    // names of the values of the body in the parent graph. names that are not in the map are outer scope values.
+    InlinedHashMap<std::string, std::string> renamed(initializer_names.begin(), initializer_names.end());
+    renamed[iteration_num] = iteration_value.name();
+    renamed[cond_in] = cond_true.name();
+    for (size_t i = 0; i < num_carried; ++i) {
+      renamed[body_carried_inputs[i]] = carried[i];
+    }
+    auto resolve = [&renamed](const std::string& body_name) -> const std::string& {
+      auto it = renamed.find(body_name);
+      return it != renamed.end() ? it->second : body_name;
+    };
+
+    for (auto& node : copy.nodes) {
+      InlinedVector<NodeArg*> inputs;
+      InlinedVector<NodeArg*> outputs;
+      for (const auto& input : node.inputs) {
+        inputs.push_back(input.empty() ? &graph.GetOrCreateNodeArg(input, nullptr)
+                                       : get_node_arg(resolve(input), input));
+      }
+      for (const auto& output : node.outputs) {
+        if (!output.empty()) {
+          renamed[output] = graph.GenerateNodeArgName(output + iteration_suffix);
+        }
+        outputs.push_back(output.empty() ? &graph.GetOrCreateNodeArg(output, nullptr)
+                                         : get_node_arg(renamed[output], output));
+      }
+      NodeAttributes attributes(node.attributes);
+      graph.AddNode(graph.GenerateNodeName(node.name + iteration_suffix), node.op_type, node.description,
+                    inputs, outputs, &attributes, node.domain);
+    }
+
+    for (size_t i = 0; i < num_carried; ++i) {
+      carried[i] = resolve(body_carried_outputs[i]);
+    }
+    for (size_t i = 0; i < body_scan_outputs.size(); ++i) {
+      scan_values[i].push_back(resolve(body_scan_outputs[i]));
+    }
+  }
+
+  // the final loop carried values are copied to the Loop outputs
+  for (size_t i = 0; i < num_carried && i < loop_outputs.size(); ++i) {
+    if (!loop_outputs[i].empty()) {
+      graph.AddNode(graph.GenerateNodeName("Identity" + suffix), "Identity", "Loop carried output of an unrolled Loop.",
+                    {get_node_arg(carried[i], body_carried_outputs[i])}, {graph.GetNodeArg(loop_outputs[i])});
+    }
+  }
+
+  // the scan outputs are the values of the iterations stacked along a new first axis.
+  // Unsqueeze has the axes as an input instead of an attribute from opset 13.
+  const auto& domain_to_version = graph.DomainToVersionMap();
+  const auto onnx_opset_it = domain_to_version.find(kOnnxDomain);
+  const bool axes_as_input = onnx_opset_it != domain_to_version.end() && onnx_opset_it->second >= 13;
+  NodeArg* axes_arg = nullptr;
+  if (axes_as_input && !body_scan_outputs.empty()) {
+    TensorProto axes;
+    axes.set_name(graph.GenerateNodeArgName("unsqueeze_axes" + suffix));
+    axes.set_data_type(TensorProto_DataType_INT64);
+    axes.add_dims(1);
+    axes.add_int64_data(0);
+    axes_arg = &graph_utils::AddInitializer(graph, axes);
+  }
+
+  for (size_t i = 0; i < body_scan_outputs.size() && num_carried + i < loop_outputs.size(); ++i) {
+    const std::string& loop_output = loop_outputs[num_carried + i];
+    if (loop_output.empty()) {
+      continue;
+    }
+
+    InlinedVector<NodeArg*> unsqueezed;
+    for (const auto& value : scan_values[i]) {
+      NodeArg* value_arg = get_node_arg(value, body_scan_outputs[i]);
+      NodeArg* unsqueezed_arg = get_node_arg(graph.GenerateNodeArgName(value + "_unsqueezed"), body_scan_outputs[i]);
+      InlinedVector<NodeArg*> unsqueeze_inputs{value_arg};
+      if (axes_as_input) {
+        unsqueeze_inputs.push_back(axes_arg);
+      }
+      Node& unsqueeze_node = graph.AddNode(graph.GenerateNodeName("Unsqueeze" + suffix), "Unsqueeze",
+                                           "Scan output of an unrolled Loop.", unsqueeze_inputs, {unsqueezed_arg});
+      if (!axes_as_input) {
+        unsqueeze_node.AddAttribute("axes", std::vector<int64_t>{0});
+      }
+      unsqueezed.push_back(unsqueezed_arg);
+    }
+
+    Node& concat_node = graph.AddNode(graph.GenerateNodeName("Concat" + suffix), "Concat",
+                                      "Scan output of an unrolled Loop.", unsqueezed, {graph.GetNodeArg(loop_output)});
+    concat_node.AddAttribute("axis", static_cast<int64_t>(0));
+  }
+}
+
+bool HasOnlyZeros(const Node& node, const std::string& attr_name) {
+  InlinedVector<int64_t> values;
+  if (!graph_utils::GetRepeatedNodeAttributeValues(node, attr_name, values)) {
+    return true;
+  }
+  return std::all_of(values.begin(), values.end(), [](int64_t value) { return value == 0; });
+}
+
+std::optional<int> GetRank(const NodeArg& node_arg) {
+  const auto* shape = node_arg.Shape();
+  if (shape == nullptr) {
+    return std::nullopt;
+  }
+  return shape->dim_size();
+}
+
+// Checks if the body of a Scan node computes the same values when applied to the whole scan inputs, with the scan
+// axis as an extra leading batch dimension of the values that depend on the scan inputs.
+bool CanBatchScan(const Node& scan_node, const Graph& body) {
+  // opset 8 Scan has a batch axis and sequence lengths
+  if (scan_node.SinceVersion() < 9) {
+    return false;
+  }
+
+  // state variables are carried from one slice to the next
+  const auto* num_scan_inputs = graph_utils::GetNodeAttribute(scan_node, "num_scan_inputs");
+  if (num_scan_inputs == nullptr ||
+      static_cast<size_t>(num_scan_inputs->i()) != scan_node.InputDefs().size() ||
+      body.GetInputs().size() != scan_node.InputDefs().size() ||
+      body.GetOutputs().size() != scan_node.OutputDefs().size()) {
+    return false;
+  }
+
+  if (!HasOnlyZeros(scan_node, "scan_input_axes") || !HasOnlyZeros(scan_node, "scan_input_directions") ||
+      !HasOnlyZeros(scan_node, "scan_output_axes") || !HasOnlyZeros(scan_node, "scan_output_directions")) {
+    return false;
+  }
+
+  // ranks of the slices of the values that depend on the scan inputs
+  InlinedHashMap<std::string, int> slice_ranks;
+  for (const auto* input : body.GetInputs()) {
+    const auto rank = GetRank(*input);
+    if (!rank.has_value()) {
+      return false;
+    }
+    slice_ranks[input->Name()] = *rank;
+  }
+
+  GraphViewer body_viewer(body);
+  for (NodeIndex index : body_viewer.GetNodesInTopologicalOrder()) {
+    const Node& node = *body.GetNode(index);
+    const bool is_matmul = node.OpType() == "MatMul";
+    if (node.Domain() != kOnnxDomain || (!is_matmul && !IsBatchableElementwiseOp(node.OpType()))) {
+      return false;
+    }
+
+    // ranks of the inputs, and if they depend on the scan inputs
+    InlinedVector<std::pair<int, bool>> inputs;
+    for (const auto* input_def : node.InputDefs()) {
+      if (!input_def->Exists()) {
+        return false;
+      }
+      auto slice_rank_it = slice_ranks.find(input_def->Name());
+      if (slice_rank_it != slice_ranks.end()) {
+        inputs.emplace_back(slice_rank_it->second, true);
+      } else {
+        const auto rank = GetRank(*input_def);
+        if (!rank.has_value()) {
+          return false;
+        }
+        inputs.emplace_back(*rank, false);
+      }
+    }
+
+    const bool is_dependent = std::any_of(inputs.begin(), inputs.end(), [](const auto& input) { return input.second; });
+    if (!is_dependent) {
+      continue;
+    }
+
+    if (is_matmul) {
+      // the batch dimension must line up with the leading dimensions of the slices
+      const auto& a = inputs[0];
+      const auto& b = inputs[1];
+      const bool can_batch = (a.second && b.second && a.first == b.first && a.first >= 2) ||
+                             (a.second && !b.second && a.first >= 1 && b.first <= 2) ||
+                             (!a.second && b.second && b.first >= 2 && a.first <= 2);
+      if (!can_batch) {
+        return false;
+      }
+    } else {
+      // broadcasting aligns the trailing dimensions, so the other inputs must not have more dimensions than the
+      // slices, and all the slices must have the same rank
+      int slice_rank = -1;
+      for (const auto& input : inputs) {
+        if (input.second) {
+          if (slice_rank != -1 && slice_rank != input.first) {
+            return false;
+          }
+          slice_rank = input.first;
+        }
+      }
+      for (const auto& input : inputs) {
+        if (!input.second && input.first > slice_rank) {
+          return false;
+        }
+      }
+    }
+
+    for (const auto* output_def : node.OutputDefs()) {
+      const auto rank = GetRank(*output_def);
+      if (!rank.has_value()) {
+        return false;
+      }
+      slice_ranks[output_def->Name()] = *rank;
+    }
+  }
+
+  // every output must be stacked from the slices
+  return std::all_of(body.GetOutputs().begin(), body.GetOutputs().end(),
+                     [&slice_ranks](const NodeArg* output) { return slice_ranks.count(output->Name()) > 0; });
+}
+
+// Replaces scan_node with the nodes of its body applied to the whole scan inputs.
+void BatchScan(Graph& graph, Node& scan_node, const Graph& body) {
+  const std::string suffix = graph.GenerateNodeName("_batched_" + scan_node.Name());
+
+  BodyCopy copy = CopyBody(body);
+
+  // the body inputs are the scan inputs, and the body outputs are produced as the scan outputs
+  InlinedHashMap<std::string, std::string> renamed;
+  const auto& body_inputs = body.GetInputs();
+  for (size_t i = 0; i < body_inputs.size(); ++i) {
+    renamed[body_inputs[i]->Name()] = scan_node.InputDefs()[i]->Name();
+  }
+
+  InlinedVector<std::pair<std::string, std::string>> identities;  // (body value, Scan output)
+  const auto& body_outputs = body.GetOutputs();
+  for (size_t i = 0; i < body_outputs.size(); ++i) {
+    const auto* output_def = scan_node.OutputDefs()[i];
+    if (!output_def->Exists()) {
+      continue;
+    }
+    const std::string& body_output = body_outputs[i]->Name();
+    if (body.GetProducerNode(body_output) != nullptr && renamed.count(body_output) == 0) {
+      renamed[body_output] = output_def->Name();
+    } else {
+      identities.emplace_back(body_output, output_def->Name());
+    }
+  }
+
+  for (auto& initializer : copy.initializers) {
+    renamed[initializer.name()] = graph.GenerateNodeArgName(initializer.name() + suffix);
+    initializer.set_name(renamed[initializer.name()]);
+  }
+
+  for (auto& node : copy.nodes) {
+    for (const auto& output : node.outputs) {
+      if (!output.empty() && renamed.count(output) == 0) {
+        renamed[output] = graph.GenerateNodeArgName(output + suffix);
+      }
+    }
+  }
+
+  // the Scan outputs keep their node args, other values only keep their element types
+  auto get_node_arg = [&](const std::string& body_name) -> NodeArg* {
+    if (body_name.empty()) {
+      return &graph.GetOrCreateNodeArg(body_name, nullptr);
+    }
+    auto renamed_it = renamed.find(body_name);
+    const std::string& name = renamed_it != renamed.end() ? renamed_it->second : body_name;
+    auto type_it = copy.types.find(body_name);
+    return &graph.GetOrCreateNodeArg(name, type_it != copy.types.end() ? &type_it->second : nullptr);
+  };
+
+  // remove the Scan node, which destroys the body, before adding the nodes that produce its outputs
+  graph_utils::RemoveNodeOutputEdges(graph, scan_node);
+  graph.RemoveNode(scan_node.Index());
+
+  for (const auto& initializer : copy.initializers) {
+    graph_utils::AddInitializer(graph, initializer);
+  }
+
+  for (auto& node : copy.nodes) {
+    InlinedVector<NodeArg*> inputs;
+    InlinedVector<NodeArg*> outputs;
+    for (const auto& input : node.inputs) {
+      inputs.push_back(get_node_arg(input));
+    }
+    for (const auto& output : node.outputs) {
+      outputs.push_back(get_node_arg(output));
+    }
+    graph.AddNode(graph.GenerateNodeName(node.name + suffix), node.op_type, node.description, inputs, outputs,
+                  &node.attributes, node.domain);
+  }
+
+  for (const auto& identity : identities) {
+    graph.AddNode(graph.GenerateNodeName("Identity" + suffix), "Identity", "Output of a batched Scan.",
+                  {get_node_arg(identity.first)}, {graph.GetNodeArg(identity.second)});
+  }
+}
+
+}  // namespace
+
+Status LoopUnrolling::ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& order = graph_viewer.GetNodesInTopologicalOrder();
+
+  for (NodeIndex index : order) {
+    auto* node = graph.GetNode(index);
+    if (node == nullptr) {
+      continue;
+    }
+
+    ORT_RETURN_IF_ERROR(Recurse(*node, modified, graph_level, logger));
+
+    if (node->Domain() != kOnnxDomain || (node->OpType() != "Loop" && node->OpType() != "Scan")) {
+      continue;
+    }
+
+    const Graph* body = node->GetGraphAttribute("body");
+    if (body == nullptr || HasNestedSubgraph(*body)) {
+      continue;
+    }
+
+    if (node->OpType() == "Loop") {
+      const auto trip_count = GetUnrollableTripCount(graph, *node, *body);
+      if (trip_count.has_value()) {
+        LOGS(logger, INFO) << "Unrolling " << *trip_count << " iterations of Loop node '" << node->Name() << "'.";
+        UnrollLoop(graph, *node, *body, *trip_count);
+        modified = true;
+      }
+    } else if (CanBatchScan(*node, *body)) {
+      LOGS(logger, INFO) << "Replacing Scan node '" << node->Name() << "' with its body applied to the whole inputs.";
+      BatchScan(graph, *node, *body);
+      modified = true;
+    }
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
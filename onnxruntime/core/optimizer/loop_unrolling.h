@@ -0,0 +1,41 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class LoopUnrolling
+
+Transformer that removes the per-iteration subgraph execution of Loop and Scan nodes with simple bodies, which are
+common in models converted from TensorFlow.
+
+A Loop node is unrolled if its trip count is a constant initializer of at most kMaxTripCount, its condition is absent
+or a constant true and the body passes the condition through unchanged. The body is copied once per iteration, the
+loop carried values are chained from one copy to the next, and the scan outputs are stacked with Unsqueeze and Concat.
+
+A Scan node without state variables whose body only contains MatMul and element-wise nodes is replaced with the body
+applied to the whole scan inputs, e.g. a MatMul per slice becomes one batched MatMul. This requires scanning forward
+along the first axis of the inputs and outputs, and the ranks of the body values to be known so that the broadcasting
+of the batched nodes matches that of the slices.
+
+Bodies that contain nodes with subgraphs are not transformed.
+*/
+class LoopUnrolling : public GraphTransformer {
+ public:
+  LoopUnrolling() noexcept : GraphTransformer("LoopUnrolling") {}
+
+  // Loops with more iterations are not unrolled.
+  static constexpr int64_t kMaxTripCount = 16;
+
+  // Loops whose unrolled body would have more nodes are not unrolled.
+  static constexpr size_t kMaxUnrolledNodes = 256;
+
+ private:
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+};
+
+}  // namespace onnxruntime
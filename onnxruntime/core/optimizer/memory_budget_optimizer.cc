@@ -0,0 +1,326 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/memory_budget_optimizer.h"
+
+#include <algorithm>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "core/common/safeint.h"
+#include "core/framework/data_types.h"
+#include "core/framework/session_options.h"
+#include "core/framework/tensorprotoutils.h"
+#include "core/graph/graph_utils.h"
+#include "core/graph/graph_viewer.h"
+#include "core/optimizer/utils.h"
+
+namespace onnxruntime {
+
+namespace {
+
+// An intermediate value with a static shape, and its lifetime in the execution order.
+struct Value {
+  NodeArg* arg;
+  Node* producer;
+  std::string_view location;  // execution provider whose memory holds the value
+  size_t size;
+  size_t def_step;
+  size_t last_use_step;
+};
+
+struct MemoryEstimate {
+  InlinedHashMap<NodeIndex, size_t> steps;
+  std::vector<Value> values;
+  InlinedHashMap<std::string_view, size_t> value_indices;
+};
+
+struct Candidate {
+  size_t value_index;
+  bool recompute;
+  size_t saving;
+  InlinedVector<Node*> later_consumers;
+};
+
+bool IsCheapToRecompute(const Node& node) {
+  static const InlinedHashSet<std::string_view> cheap_ops = {
+      "Abs", "Add", "And", "Cast", "ConstantOfShape", "Div", "Equal", "Erf", "Expand", "Greater",
+      "LeakyRelu", "Less", "Mul", "Neg", "Not", "Or", "Range", "Relu", "Sigmoid", "Sub", "Tanh",
+      "Tile", "Where"};
+  return node.Domain() == kOnnxDomain && cheap_ops.count(node.OpType()) > 0 && node.OutputDefs().size() == 1 &&
+         !node.ContainsSubgraph();
+}
+
+bool CanOffload(std::string_view location) {
+  // the execution providers registering MemcpyToHost and MemcpyFromHost kernels
+  return location == kCudaExecutionProvider || location == kRocmExecutionProvider;
+}
+
+std::optional<size_t> GetStaticSizeInBytes(const NodeArg& arg) {
+  const auto* type = arg.TypeAsProto();
+  const auto* shape = arg.Shape();
+  if (type == nullptr || shape == nullptr || !utils::HasTensorType(*type) || !utils::HasElemType(type->tensor_type()) ||
+      type->tensor_type().elem_type() == ONNX_NAMESPACE::TensorProto_DataType_STRING) {
+    return std::nullopt;
+  }
+
+  SafeInt<size_t> size = DataTypeImpl::TensorTypeFromONNXEnum(type->tensor_type().elem_type())->GetElementType()->Size();
+  for (const auto& dim : shape->dim()) {
+    if (!utils::HasDimValue(dim) || dim.dim_value() < 0) {
+      return std::nullopt;
+    }
+    size *= dim.dim_value();
+  }
+  return size;
+}
+
+MemoryEstimate EstimateMemory(Graph& graph) {
+  MemoryEstimate estimate;
+  GraphViewer graph_viewer(graph);
+  const auto& order = graph_viewer.GetNodesInTopologicalOrder(ExecutionOrder::PRIORITY_BASED);
+  for (size_t step = 0; step < order.size(); ++step) {
+    estimate.steps[order[step]] = step;
+  }
+
+  for (size_t step = 0; step < order.size(); ++step) {
+    Node* node = graph.GetNode(order[step]);
+    // the copies to host memory run on the device execution provider, but their output is in host memory
+    const std::string_view location = node->OpType() == "MemcpyToHost" || node->GetExecutionProviderType().empty()
+                                          ? std::string_view(kCpuExecutionProvider)
+                                          : std::string_view(node->GetExecutionProviderType());
+    for (NodeArg* output : node->MutableOutputDefs()) {
+      const auto size = output->Exists() ? GetStaticSizeInBytes(*output) : std::nullopt;
+      if (!size) {
+        continue;
+      }
+
+      size_t last_use_step = graph.IsOutput(output) ? order.size() - 1 : step;
+      for (const Node* consumer : graph.GetConsumerNodes(output->Name())) {
+        last_use_step = std::max(last_use_step, estimate.steps.at(consumer->Index()));
+      }
+      estimate.value_indices[output->Name()] = estimate.values.size();
+      estimate.values.push_back({output, node, location, *size, step, last_use_step});
+    }
+  }
+  return estimate;
+}
+
+// Returns the step at which the memory of the values in `location` peaks, and the peak.
+std::pair<size_t, size_t> FindPeak(const MemoryEstimate& estimate, std::string_view location) {
+  std::vector<size_t> usage(estimate.steps.size() + 1, 0);
+  for (const auto& value : estimate.values) {
+    if (value.location == location) {
+      usage[value.def_step] += value.size;
+      usage[value.last_use_step + 1] -= value.size;
+    }
+  }
+
+  std::pair<size_t, size_t> peak{0, 0};
+  size_t current = 0;
+  for (size_t step = 0; step < estimate.steps.size(); ++step) {
+    current += usage[step];
+    if (current > peak.second) {
+      peak = {step, current};
+    }
+  }
+  return peak;
+}
+
+// Finds the values in `location` that are alive at `peak_step` but not used there, with the consumers that run after
+// it. If `recompute` is true only the values with a cheap producer are considered, and the saving accounts for the
+// inputs of the producer that have to stay alive until the later consumers.
+std::optional<Candidate> FindCandidate(Graph& graph, const MemoryEstimate& estimate, std::string_view location,
+                                       size_t peak_step, bool recompute) {
+  std::optional<Candidate> best;
+  for (size_t i = 0; i < estimate.values.size(); ++i) {
+    const Value& value = estimate.values[i];
+    if (value.location != location || value.def_step >= peak_step || value.last_use_step <= peak_step ||
+        graph.IsOutput(value.arg) || (recompute ? !IsCheapToRecompute(*value.producer) : !CanOffload(location))) {
+      continue;
+    }
+
+    Candidate candidate{i, recompute, value.size, {}};
+    bool usable = true;
+    for (Node* consumer : graph.GetMutableConsumerNodes(value.arg->Name())) {
+      const size_t step = estimate.steps.at(consumer->Index());
+      const auto& input_defs = consumer->InputDefs();
+      if (step == peak_step) {
+        usable = false;
+      } else if (step > peak_step) {
+        // values used by subgraphs are implicit inputs which can't be redirected
+        usable = usable && std::find(input_defs.begin(), input_defs.end(), value.arg) != input_defs.end();
+        candidate.later_consumers.push_back(consumer);
+      }
+    }
+    if (!usable) {
+      continue;
+    }
+
+    if (recompute) {
+      size_t first_later_step = estimate.steps.size();
+      for (const Node* consumer : candidate.later_consumers) {
+        first_later_step = std::min(first_later_step, estimate.steps.at(consumer->Index()));
+      }
+
+      size_t cost = 0;
+      for (const NodeArg* input : value.producer->InputDefs()) {
+        if (!input->Exists() || graph.GetProducerNode(input->Name()) == nullptr) {
+          // graph inputs and initializers are alive anyway
+          continue;
+        }
+        auto it = estimate.value_indices.find(input->Name());
+        if (it == estimate.value_indices.end()) {
+          usable = false;
+          break;
+        }
+        const Value& input_value = estimate.values[it->second];
+        if (input_value.location == location && input_value.last_use_step < first_later_step) {
+          cost += input_value.size;
+        }
+      }
+      if (!usable || cost >= value.size) {
+        continue;
+      }
+      candidate.saving = value.size - cost;
+    }
+
+    if (!best || candidate.saving > best->saving) {
+      best = std::move(candidate);
+    }
+  }
+  return best;
+}
+
+void AddInputEdges(Graph& graph, Node& node) {
+  const auto& input_defs = node.MutableInputDefs();
+  for (size_t i = 0; i < input_defs.size(); ++i) {
+    NodeArg* input = input_defs[i];
+    if (!input->Exists()) {
+      continue;
+    }
+    const Node* producer = graph.GetProducerNode(input->Name());
+    if (producer != nullptr) {
+      graph.AddEdge(producer->Index(), node.Index(), optimizer_utils::IndexOfNodeOutput(*producer, *input),
+                    static_cast<int>(i));
+    }
+    graph.AddConsumerNode(input->Name(), &node);
+  }
+}
+
+// Makes `consumers` read `new_arg`, the only output of `new_producer`, instead of `old_arg`.
+void RedirectConsumers(Graph& graph, NodeArg& old_arg, NodeArg& new_arg, Node& new_producer,
+                       gsl::span<Node* const> consumers) {
+  const Node& old_producer = *graph.GetProducerNode(old_arg.Name());
+  const int old_output_index = optimizer_utils::IndexOfNodeOutput(old_producer, old_arg);
+  for (Node* consumer : consumers) {
+    auto& input_defs = consumer->MutableInputDefs();
+    for (size_t i = 0; i < input_defs.size(); ++i) {
+      if (input_defs[i] == &old_arg) {
+        graph.RemoveEdge(old_producer.Index(), consumer->Index(), old_output_index, static_cast<int>(i));
+        input_defs[i] = &new_arg;
+        graph.AddEdge(new_producer.Index(), consumer->Index(), 0, static_cast<int>(i));
+      }
+    }
+    graph.RemoveConsumerNode(old_arg.Name(), consumer);
+    graph.AddConsumerNode(new_arg.Name(), consumer);
+  }
+}
+
+void Recompute(Graph& graph, const Value& value, gsl::span<Node* const> later_consumers) {
+  Node& producer = *value.producer;
+  NodeArg& recomputed_arg = graph.GetOrCreateNodeArg(graph.GenerateNodeArgName(value.arg->Name() + "_recompute"),
+                                                     value.arg->TypeAsProto());
+  Node& recompute_node = graph.AddNode(graph.GenerateNodeName(producer.Name() + "_recompute"), producer.OpType(),
+                                       "Recompute of " + producer.Name(), producer.MutableInputDefs(),
+                                       {&recomputed_arg}, &producer.GetAttributes(), producer.Domain());
+  // run it as late as possible, i.e. right before the first consumer
+  recompute_node.SetPriority(static_cast<int>(ExecutionPriority::LOCAL_LOW));
+  recompute_node.SetExecutionProviderType(producer.GetExecutionProviderType());
+  graph.UpdateProducerNode(recomputed_arg.Name(), recompute_node.Index());
+  AddInputEdges(graph, recompute_node);
+
+  RedirectConsumers(graph, *value.arg, recomputed_arg, recompute_node, later_consumers);
+}
+
+void Offload(Graph& graph, const Value& value, gsl::span<Node* const> later_consumers) {
+  const auto& provider = value.producer->GetExecutionProviderType();
+  NodeArg& host_arg = graph.GetOrCreateNodeArg(graph.GenerateNodeArgName(value.arg->Name() + "_host"),
+                                               value.arg->TypeAsProto());
+  NodeArg& device_arg = graph.GetOrCreateNodeArg(graph.GenerateNodeArgName(value.arg->Name() + "_" + provider),
+                                                 value.arg->TypeAsProto());
+
+  Node& to_host = graph.AddNode(graph.GenerateNodeName("Memcpy"), "MemcpyToHost", "Offload to host memory",
+                                {value.arg}, {&host_arg});
+  // run it as early as possible, i.e. right after the producer
+  to_host.SetPriority(static_cast<int>(ExecutionPriority::LOCAL_HIGH));
+  to_host.SetExecutionProviderType(provider);
+  graph.UpdateProducerNode(host_arg.Name(), to_host.Index());
+  AddInputEdges(graph, to_host);
+
+  Node& from_host = graph.AddNode(graph.GenerateNodeName("Memcpy"), "MemcpyFromHost", "Reload from host memory",
+                                  {&host_arg}, {&device_arg});
+  // run it as late as possible, i.e. right before the first consumer
+  from_host.SetPriority(static_cast<int>(ExecutionPriority::LOCAL_LOW));
+  from_host.SetExecutionProviderType(provider);
+  graph.UpdateProducerNode(device_arg.Name(), from_host.Index());
+  AddInputEdges(graph, from_host);
+
+  RedirectConsumers(graph, *value.arg, device_arg, from_host, later_consumers);
+}
+
+}  // namespace
+
+Status MemoryBudgetOptimizer::ApplyImpl(Graph& graph, bool& modified, int /*graph_level*/,
+                                        const logging::Logger& logger) const {
+  // every change moves one value, bound them in case the peak keeps moving around
+  const int max_changes = graph.NumberOfNodes();
+  for (int change = 0; change <= max_changes; ++change) {
+    const MemoryEstimate estimate = EstimateMemory(graph);
+
+    InlinedHashSet<std::string_view> locations;
+    for (const auto& value : estimate.values) {
+      locations.insert(value.location);
+    }
+
+    // the location that is the most over the budget
+    std::string_view location;
+    std::pair<size_t, size_t> peak{0, memory_budget_};
+    for (const auto& candidate_location : locations) {
+      auto candidate_peak = FindPeak(estimate, candidate_location);
+      if (candidate_peak.second > peak.second) {
+        location = candidate_location;
+        peak = candidate_peak;
+      }
+    }
+    if (location.empty()) {
+      break;
+    }
+
+    auto candidate = FindCandidate(graph, estimate, location, peak.first, /*recompute*/ true);
+    if (!candidate) {
+      candidate = FindCandidate(graph, estimate, location, peak.first, /*recompute*/ false);
+    }
+    if (!candidate || change == max_changes) {
+      LOGS(logger, WARNING) << "The estimated peak memory of the intermediate values for " << location << " is "
+                            << peak.second << " bytes, which can't be reduced to the memory budget of "
+                            << memory_budget_ << " bytes.";
+      break;
+    }
+
+    const Value& value = estimate.values[candidate->value_index];
+    LOGS(logger, INFO) << (candidate->recompute ? "Recomputing " : "Offloading to host memory ") << value.arg->Name()
+                       << " to save " << candidate->saving << " bytes at the estimated peak of " << peak.second
+                       << " bytes for " << location;
+    if (candidate->recompute) {
+      Recompute(graph, value, candidate->later_consumers);
+    } else {
+      Offload(graph, value, candidate->later_consumers);
+    }
+    modified = true;
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
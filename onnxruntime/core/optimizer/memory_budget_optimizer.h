@@ -0,0 +1,40 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class MemoryBudgetOptimizer
+
+Trade compute or copies for memory when the estimated peak memory of the intermediate values of the graph exceeds
+a budget (see kOrtSessionOptionsMemoryBudgetBytes).
+
+The peak is estimated per execution provider from the lifetimes of the values with a static shape in the priority
+based execution order. While it is over the budget, a value that is alive at the peak but not used there is either
+- recomputed: if its producer is cheap (Cast, Expand, elementwise ops, ...), the producer is duplicated right
+  before the later consumers, so the value is released early, or
+- offloaded: if it lives on a CUDA or ROCm device, it is copied to host memory behind its producer with a
+  MemcpyToHost node and copied back right before the later consumers with a MemcpyFromHost node.
+Recomputation is preferred as it does not depend on the bandwidth between host and device.
+
+The placement of the added nodes relies on their priority, so the session uses the priority based execution order.
+*/
+class MemoryBudgetOptimizer : public GraphTransformer {
+ public:
+  explicit MemoryBudgetOptimizer(size_t memory_budget) noexcept
+      : GraphTransformer("MemoryBudgetOptimizer"), memory_budget_(memory_budget) {
+  }
+
+  bool ShouldOnlyApplyOnce() const override { return true; }
+
+ private:
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+
+  const size_t memory_budget_;
+};
+
+}  // namespace onnxruntime
@@ -209,7 +209,16 @@ Status NhwcTransformer::ApplyImpl(Graph& graph, bool& modified, int graph_level,
     size_t rank = shape->dim_size();
     std::vector<int64_t> input_perm = ChannelFirstToLastPerm(rank);
     std::vector<int64_t> output_perm = ChannelLastToFirstPerm(rank);
-    WrapTransposesAroundNode(*api_graph, *node, {&input_perm}, {&output_perm});
+    std::vector<const std::vector<int64_t>*> input_perms{&input_perm};
+    // The residual input of a QLinearConv fused with QLinearAdd has the layout of the output.
+    constexpr size_t qlinear_conv_sum_index = 9;
+    auto inputs = node->Inputs();
+    if (node->OpType() == "QLinearConv" && inputs.size() > qlinear_conv_sum_index &&
+        !inputs[qlinear_conv_sum_index].empty()) {
+      input_perms.resize(qlinear_conv_sum_index + 1, nullptr);
+      input_perms[qlinear_conv_sum_index] = &input_perm;
+    }
+    WrapTransposesAroundNode(*api_graph, *node, input_perms, {&output_perm});
 
     // Replace the operator if needed
     if (node->Domain() != transform->domain_ ||
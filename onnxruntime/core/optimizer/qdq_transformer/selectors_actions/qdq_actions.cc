@@ -113,6 +113,53 @@ QDQReplaceWithNew MatMulIntToFloatReplacer() {
   return QDQReplaceWithNew(kMSDomain, "MatMulIntegerToFloat", std::move(moves));
 }
 
+// moves for replacing an Attention node with DQ nodes for the input and the weight with QAttention
+std::vector<NodeAndMoveInfo> AttentionMoves() {
+  NTO::NodeLocation dq_input{NTO::NodeType::kInput, 0};
+  NTO::NodeLocation dq_weight{NTO::NodeType::kInput, 1};
+  NTO::NodeLocation target{NTO::NodeType::kTarget, 0};
+
+  std::vector<NodeAndMoveInfo> moves{
+      MoveAndAppend(dq_input, ArgType::kInput, 0, ArgType::kInput),
+      MoveAndAppend(dq_weight, ArgType::kInput, 0, ArgType::kInput),
+      MoveAndAppend(target, ArgType::kInput, 2, ArgType::kInput),  // bias
+      MoveAndAppend(dq_input, ArgType::kInput, 1, ArgType::kInput),
+      MoveAndAppend(dq_weight, ArgType::kInput, 1, ArgType::kInput),
+      MoveAndAppend(target, ArgType::kInput, 3, ArgType::kInput),  // (optional) mask_index
+      MoveAndAppend(dq_input, ArgType::kInput, 2, ArgType::kInput),
+      MoveAndAppend(dq_weight, ArgType::kInput, 2, ArgType::kInput),
+      MoveAll(target, ArgType::kOutput)};
+
+  return moves;
+}
+
+// moves for replacing a LayerNormalization node with a DQ node for X and a Q node with QLinearLayerNormalization
+std::vector<NodeAndMoveInfo> LayerNormalizationMoves() {
+  NTO::NodeLocation dq{NTO::NodeType::kInput, 0};
+  NTO::NodeLocation target{NTO::NodeType::kTarget, 0};
+  NTO::NodeLocation q{NTO::NodeType::kOutput, 0};
+
+  std::vector<NodeAndMoveInfo> moves{
+      MoveAll(dq, ArgType::kInput),                                // append all inputs from dq
+      MoveAndAppend(target, ArgType::kInput, 1, ArgType::kInput),  // append Scale
+      MoveAndAppend(q, ArgType::kInput, 1, ArgType::kInput),       // append scale (input 1) from q
+      MoveAndAppend(q, ArgType::kInput, 2, ArgType::kInput),       // append zp (input 2) from q
+      MoveAndAppend(target, ArgType::kInput, 2, ArgType::kInput),  // (optional) append B
+      MoveAll(q, ArgType::kOutput)};                               // and use the outputs from q
+
+  return moves;
+}
+
+// adds missing optional inputs to the target node so that they can be moved to the replacement node
+void AddMissingTargetInputs(Graph& graph, const NodesToOptimize& selected_nodes, size_t num_inputs) {
+  Node& target = selected_nodes.Target();
+  auto& input_defs = target.MutableInputDefs();
+  while (input_defs.size() < num_inputs) {
+    input_defs.push_back(&graph.GetOrCreateNodeArg("", nullptr));
+    target.MutableInputArgsCount().push_back(1);
+  }
+}
+
 struct SetOptionalZeroPoint {
   static void UpdateNodes(Graph&, const NodesToOptimize& selected_nodes);
 
@@ -323,5 +370,47 @@ Status GemmReplaceWithQuant::RunForSave(Graph& graph,
 }
 #endif  // !defined(ORT_MINIMAL_BUILD)
 
+AttentionReplaceWithQuant::AttentionReplaceWithQuant()
+    : qattention_replacer_(kMSDomain, "QAttention", AttentionMoves()) {
+}
+
+Status AttentionReplaceWithQuant::Run(Graph& graph, const NodesToOptimize& selected_nodes) const {
+  AddMissingTargetInputs(graph, selected_nodes, 4);
+  return qattention_replacer_.Run(graph, selected_nodes);
+}
+
+#if !defined(ORT_MINIMAL_BUILD)
+Status AttentionReplaceWithQuant::RunForSave(Graph& graph,
+                                             const NodesToOptimize& selected_nodes,
+                                             const SatRuntimeOptimizationSaveContext& save_context,
+                                             SavedState& saved_state,
+                                             bool& graph_modified) const {
+  AddMissingTargetInputs(graph, selected_nodes, 4);
+  return qattention_replacer_.RunForSave(graph, selected_nodes, save_context, saved_state, graph_modified);
+}
+#endif  // !defined(ORT_MINIMAL_BUILD)
+
+LayerNormalizationReplaceWithQLinear::LayerNormalizationReplaceWithQLinear()
+    : qlinear_layer_norm_replacer_(kMSDomain, "QLinearLayerNormalization", LayerNormalizationMoves()) {
+}
+
+Status LayerNormalizationReplaceWithQLinear::Run(Graph& graph, const NodesToOptimize& selected_nodes) const {
+  AddMissingTargetInputs(graph, selected_nodes, 3);
+  RemoveAttrStashType(selected_nodes);
+  return qlinear_layer_norm_replacer_.Run(graph, selected_nodes);
+}
+
+#if !defined(ORT_MINIMAL_BUILD)
+Status LayerNormalizationReplaceWithQLinear::RunForSave(Graph& graph,
+                                                        const NodesToOptimize& selected_nodes,
+                                                        const SatRuntimeOptimizationSaveContext& save_context,
+                                                        SavedState& saved_state,
+                                                        bool& graph_modified) const {
+  AddMissingTargetInputs(graph, selected_nodes, 3);
+  RemoveAttrStashType(selected_nodes);
+  return qlinear_layer_norm_replacer_.RunForSave(graph, selected_nodes, save_context, saved_state, graph_modified);
+}
+#endif  // !defined(ORT_MINIMAL_BUILD)
+
 }  // namespace QDQ
 }  // namespace onnxruntime
@@ -96,5 +96,41 @@ struct GemmReplaceWithQuant : public Action {
   QDQReplaceWithNew qgemm_with_8bits_as_output_replacer_;
 };
 
+// Attention with DQ nodes for the input and the weight -> QAttention, which keeps the float bias and output
+struct AttentionReplaceWithQuant : public Action {
+  AttentionReplaceWithQuant();
+
+  Status Run(Graph&, const NodesToOptimize& selected_nodes) const override;
+
+#if !defined(ORT_MINIMAL_BUILD)
+  Status RunForSave(Graph& /*graph*/, const NodesToOptimize& /*selected_nodes*/,
+                    const SatRuntimeOptimizationSaveContext& /*save_context*/,
+                    SavedState& /*saved_state*/, bool& /*graph_modified*/) const override;
+#endif  // !defined(ORT_MINIMAL_BUILD)
+
+ private:
+  QDQReplaceWithNew qattention_replacer_;
+};
+
+struct LayerNormalizationReplaceWithQLinear : public Action {
+  LayerNormalizationReplaceWithQLinear();
+
+  Status Run(Graph&, const NodesToOptimize& selected_nodes) const override;
+
+#if !defined(ORT_MINIMAL_BUILD)
+  Status RunForSave(Graph& /*graph*/, const NodesToOptimize& /*selected_nodes*/,
+                    const SatRuntimeOptimizationSaveContext& /*save_context*/,
+                    SavedState& /*saved_state*/, bool& /*graph_modified*/) const override;
+#endif  // !defined(ORT_MINIMAL_BUILD)
+
+  // the statistics are always computed in float
+  static inline void RemoveAttrStashType(const NodesToOptimize& selected_nodes) {
+    selected_nodes.Target().ClearAttribute("stash_type");
+  }
+
+ private:
+  QDQReplaceWithNew qlinear_layer_norm_replacer_;
+};
+
 }  // namespace QDQ
 }  // namespace onnxruntime
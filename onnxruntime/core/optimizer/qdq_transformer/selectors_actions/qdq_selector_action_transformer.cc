@@ -226,6 +226,44 @@ void WhereQDQRules(SelectorActionRegistry& qdq_selector_action_registry) {
 #endif
 }
 
+void AttentionQDQRules(SelectorActionRegistry& qdq_selector_action_registry) {
+  // 3 nodes. DQ for the input, DQ for the weight and Attention (com.microsoft) with a float bias
+  // Replace with QAttention. The output stays float, so a Q consuming it is not part of the group.
+  // Delete all original nodes.
+  const std::string action_name{"Attention"};
+  std::unique_ptr<Action> action = std::make_unique<QDQ::AttentionReplaceWithQuant>();
+
+#if !defined(ORT_MINIMAL_BUILD)
+  std::unique_ptr<NodeSelector> selector = std::make_unique<QDQ::AttentionSelector>();
+  qdq_selector_action_registry.RegisterSelectorAndAction(action_name,
+                                                         {{"Attention", {}}},
+                                                         std::move(selector),
+                                                         std::move(action));
+
+#else
+  qdq_selector_action_registry.RegisterAction(action_name, std::move(action));
+#endif
+}
+
+void LayerNormalizationQDQRules(SelectorActionRegistry& qdq_selector_action_registry) {
+  // 3 nodes. DQ for X, LayerNormalization with float Scale and B, and Q for Y
+  // Replace with QLinearLayerNormalization
+  // Delete all original nodes.
+  const std::string action_name{"LayerNormalization"};
+  std::unique_ptr<Action> action = std::make_unique<QDQ::LayerNormalizationReplaceWithQLinear>();
+
+#if !defined(ORT_MINIMAL_BUILD)
+  std::unique_ptr<NodeSelector> selector = std::make_unique<QDQ::LayerNormalizationSelector>();
+  qdq_selector_action_registry.RegisterSelectorAndAction(action_name,
+                                                         {{"LayerNormalization", {}}},
+                                                         std::move(selector),
+                                                         std::move(action));
+
+#else
+  qdq_selector_action_registry.RegisterAction(action_name, std::move(action));
+#endif
+}
+
 SelectorActionRegistry CreateSelectorActionRegistry(bool is_int8_allowed) {
   SelectorActionRegistry qdq_selector_action_registry;
   SplitQDQRules(qdq_selector_action_registry);
@@ -238,6 +276,8 @@ SelectorActionRegistry CreateSelectorActionRegistry(bool is_int8_allowed) {
   MatMulQDQRules(qdq_selector_action_registry, is_int8_allowed);
   GemmQDQRules(qdq_selector_action_registry);
   WhereQDQRules(qdq_selector_action_registry);
+  AttentionQDQRules(qdq_selector_action_registry);
+  LayerNormalizationQDQRules(qdq_selector_action_registry);
 
   return qdq_selector_action_registry;
 }
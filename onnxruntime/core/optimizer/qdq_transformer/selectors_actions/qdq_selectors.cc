@@ -386,6 +386,102 @@ bool LogicalComparisonNodeGroupSelector::Check(const GraphViewer& graph_viewer,
   return dt_input_1 == dt_input_2;
 }
 
+bool AttentionNodeGroupSelector::Check(const GraphViewer& graph_viewer,
+                                       const Node& node,
+                                       const std::vector<const Node*>& dq_nodes,
+                                       const std::vector<const Node*>& /*q_nodes*/) const {
+  if (node.Domain() != kMSDomain || dq_nodes.size() != 2) {
+    return false;
+  }
+
+  // the DQ nodes must provide the input and the weight, and the float bias must exist
+  const auto& input_defs = node.InputDefs();
+  if (input_defs.size() < 3 || !input_defs[2]->Exists() ||
+      dq_nodes[0]->OutputDefs()[0] != input_defs[0] || dq_nodes[1]->OutputDefs()[0] != input_defs[1]) {
+    return false;
+  }
+
+  if (const auto dq_validation_status = QDQ::ValidateNodeGroupDQNodes(graph_viewer, node, dq_nodes);
+      !dq_validation_status.IsOK()) {
+    return false;
+  }
+
+  // QAttention does not take past, attention_bias or past_sequence_length, and has no separate Q/K/V hidden sizes
+  for (size_t i = 4; i < input_defs.size(); ++i) {
+    if (input_defs[i]->Exists()) {
+      return false;
+    }
+  }
+  const auto& output_defs = node.OutputDefs();
+  if (output_defs.size() > 1 && output_defs[1]->Exists()) {
+    return false;
+  }
+  if (graph_utils::GetNodeAttribute(node, "qkv_hidden_sizes") != nullptr) {
+    return false;
+  }
+
+  // the CPU kernel takes an uint8 input with a per-tensor scale, and an 8 bit weight with a per-tensor or per-column
+  // scale
+  const int32_t dt_input = dq_nodes[0]->InputDefs()[0]->TypeAsProto()->tensor_type().elem_type();
+  const int32_t dt_weight = dq_nodes[1]->InputDefs()[0]->TypeAsProto()->tensor_type().elem_type();
+  if (dt_input != ONNX_NAMESPACE::TensorProto_DataType::TensorProto_DataType_UINT8 ||
+      (dt_weight != ONNX_NAMESPACE::TensorProto_DataType::TensorProto_DataType_UINT8 &&
+       dt_weight != ONNX_NAMESPACE::TensorProto_DataType::TensorProto_DataType_INT8)) {
+    return false;
+  }
+
+  if (!optimizer_utils::IsScalar(*dq_nodes[0]->InputDefs()[1])) {
+    return false;
+  }
+
+  if (!optimizer_utils::IsScalar(*dq_nodes[1]->InputDefs()[1])) {
+    const auto* axis_attr = graph_utils::GetNodeAttribute(*dq_nodes[1], "axis");
+    const int64_t axis = axis_attr != nullptr ? axis_attr->i() : 1;
+    const auto* block_size_attr = graph_utils::GetNodeAttribute(*dq_nodes[1], "block_size");
+    if ((axis != 1 && axis != -1) || (block_size_attr != nullptr && block_size_attr->i() != 0)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+void AttentionSelector::UpdateBuilder(NodesToOptimizeIndicesBuilder& builder) const {
+  // QAttention produces float, so a Q node consuming the output stays in the graph
+  builder.output_nodes.clear();
+}
+
+bool LayerNormalizationNodeGroupSelector::Check(const GraphViewer& graph_viewer,
+                                                const Node& node,
+                                                const std::vector<const Node*>& dq_nodes,
+                                                const std::vector<const Node*>& q_nodes) const {
+  // only X is quantized. Scale and B are float, and Mean and InvStdDev must not be used
+  if (!CheckQDQNodes(graph_viewer, node, dq_nodes, q_nodes, 1) ||
+      dq_nodes[0]->OutputDefs()[0] != node.InputDefs()[0] ||
+      NumActualValues(node, false) != 1) {
+    return false;
+  }
+
+  if (!optimizer_utils::IsScalar(*dq_nodes[0]->InputDefs()[1]) ||
+      !optimizer_utils::IsScalar(*q_nodes[0]->InputDefs()[1])) {
+    return false;
+  }
+
+  // the contrib LayerNormalization in the ONNX domain may use other types than float for Scale and B
+  for (size_t i = 1; i < node.InputDefs().size(); ++i) {
+    const NodeArg* input_def = node.InputDefs()[i];
+    if (input_def->Exists() &&
+        input_def->TypeAsProto()->tensor_type().elem_type() !=
+            ONNX_NAMESPACE::TensorProto_DataType::TensorProto_DataType_FLOAT) {
+      return false;
+    }
+  }
+
+  int32_t dt_input = dq_nodes[0]->InputDefs()[0]->TypeAsProto()->tensor_type().elem_type();
+  int32_t dt_output = q_nodes[0]->OutputDefs()[0]->TypeAsProto()->tensor_type().elem_type();
+  return dt_input == dt_output;
+}
+
 }  // namespace QDQ
 }  // namespace onnxruntime
 
@@ -160,6 +160,23 @@ class BatchNormalizationNodeGroupSelector : public NodeGroupSelector {
   bool int8_allowed_;
 };
 
+// DQ nodes for the input and the weight -> Attention (com.microsoft), for QAttention.
+// The bias stays float and the output is float, so a following Q node, if any, is not part of the group.
+class AttentionNodeGroupSelector : public NodeGroupSelector {
+ private:
+  bool Check(const GraphViewer& graph_viewer, const Node& node,
+             const std::vector<const Node*>& dq_nodes,
+             const std::vector<const Node*>& q_nodes) const override;
+};
+
+// DQ node for X -> LayerNormalization with float Scale and B -> Q, for QLinearLayerNormalization
+class LayerNormalizationNodeGroupSelector : public NodeGroupSelector {
+ private:
+  bool Check(const GraphViewer& graph_viewer, const Node& node,
+             const std::vector<const Node*>& dq_nodes,
+             const std::vector<const Node*>& q_nodes) const override;
+};
+
 // 2 DQ nodes providing input -> node with bool output tensor.
 // Example: Equal, Less, Greater.
 class LogicalComparisonNodeGroupSelector : public NodeGroupSelector {
@@ -274,6 +291,20 @@ class BatchNormalizationSelector : public BaseSelector {
       : BaseSelector(std::make_unique<BatchNormalizationNodeGroupSelector>(int8_allowed)) {}
 };
 
+// DQ nodes for the input and the weight -> Attention
+class AttentionSelector : public BaseSelector {
+ public:
+  AttentionSelector() : BaseSelector(std::make_unique<AttentionNodeGroupSelector>()) {}
+
+  void UpdateBuilder(NodesToOptimizeIndicesBuilder&) const override;
+};
+
+// DQ node for X -> LayerNormalization -> Q
+class LayerNormalizationSelector : public BaseSelector {
+ public:
+  LayerNormalizationSelector() : BaseSelector(std::make_unique<LayerNormalizationNodeGroupSelector>()) {}
+};
+
 }  // namespace QDQ
 }  // namespace onnxruntime
 
@@ -0,0 +1,224 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/qlinear_conv_add_fusion.h"
+
+#include <algorithm>
+
+#include "core/common/span_utils.h"
+#include "core/graph/graph_utils.h"
+#include "core/optimizer/initializer.h"
+#include "core/optimizer/utils.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace ::onnxruntime::common;
+namespace onnxruntime {
+
+namespace {
+
+bool ArgExists(const std::vector<NodeArg*>& args, size_t index) {
+  return index < args.size() && args[index]->Exists();
+}
+
+// Both shapes are known and the same, so the residual add does not broadcast.
+bool HaveSameShape(const NodeArg& arg, const NodeArg& other_arg) {
+  const auto* shape = arg.Shape();
+  const auto* other_shape = other_arg.Shape();
+  if (shape == nullptr || other_shape == nullptr || shape->dim_size() != other_shape->dim_size()) {
+    return false;
+  }
+
+  for (int i = 0; i < shape->dim_size(); ++i) {
+    const auto& dim = shape->dim(i);
+    const auto& other_dim = other_shape->dim(i);
+    if (utils::HasDimValue(dim) && utils::HasDimValue(other_dim)) {
+      if (dim.dim_value() != other_dim.dim_value()) {
+        return false;
+      }
+    } else if (!utils::HasDimParam(dim) || !utils::HasDimParam(other_dim) ||
+               dim.dim_param() != other_dim.dim_param()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Whether two optional scale or zero point inputs hold the same value. A missing zero point is zero.
+bool IsSameQuantParam(const Graph& graph, const NodeArg* arg, const NodeArg* other_arg) {
+  const bool exists = arg != nullptr && arg->Exists();
+  const bool other_exists = other_arg != nullptr && other_arg->Exists();
+  if (exists && other_exists && arg->Name() == other_arg->Name()) {
+    return true;
+  }
+
+  const TensorProto* tensor_proto = exists ? graph_utils::GetConstantInitializer(graph, arg->Name()) : nullptr;
+  const TensorProto* other_tensor_proto =
+      other_exists ? graph_utils::GetConstantInitializer(graph, other_arg->Name()) : nullptr;
+  if ((exists && tensor_proto == nullptr) || (other_exists && other_tensor_proto == nullptr)) {
+    return false;
+  }
+
+  auto is_zero = [&graph](const TensorProto* proto) {
+    if (proto == nullptr) {
+      return true;
+    }
+    Initializer initializer(*proto, graph.ModelPath());
+    const auto bytes = initializer.DataAsByteSpan();
+    return std::all_of(bytes.begin(), bytes.end(), [](std::byte b) { return b == std::byte{0}; });
+  };
+
+  if (tensor_proto == nullptr || other_tensor_proto == nullptr) {
+    return is_zero(tensor_proto) && is_zero(other_tensor_proto);
+  }
+
+  Initializer initializer(*tensor_proto, graph.ModelPath());
+  Initializer other_initializer(*other_tensor_proto, graph.ModelPath());
+  return initializer.data_type() == other_initializer.data_type() && initializer.size() == 1 &&
+         other_initializer.size() == 1 &&
+         SpanEq(initializer.DataAsByteSpan(), other_initializer.DataAsByteSpan());
+}
+
+}  // namespace
+
+/**
+QLinearConvAddFusion will fuse the quantized residual blocks of networks like ResNet and YOLO:
+
+       (x)                                            (x)
+        |                                              |
+        v                                              v
+   QLinearConv          (sum)                     QLinearConv <-- (sum)
+        |                 |                            |
+        v                 |                ---->       v
+   QLinearAdd <-----------+                         (output)
+        |
+        v
+   QLinearLeakyRelu (optional)
+        |
+        v
+     (output)
+
+The fused node is a com.microsoft QLinearConv with the residual input, the quantization parameters of the add and
+of the activation appended to its inputs. The conv output must be dequantized by the add with the same scale and
+zero point it was quantized with, and likewise the add output by the activation, so the fused epilogue produces
+the same values as the chain.
+ */
+Status QLinearConvAddFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level,
+                                       const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+  InlinedVector<std::reference_wrapper<Node>> nodes_to_remove;
+  InlinedHashSet<NodeIndex> fused_nodes;
+
+  for (auto node_index : node_topology_list) {
+    auto* node_ptr = graph.GetNode(node_index);
+    if (nullptr == node_ptr)
+      continue;  // node was removed
+
+    auto& conv_node = *node_ptr;
+
+    ORT_RETURN_IF_ERROR(Recurse(conv_node, modified, graph_level, logger));
+
+    const bool is_ms_conv = graph_utils::IsSupportedOptypeVersionAndDomain(conv_node, "QLinearConv", {1}, kMSDomain);
+    if ((!is_ms_conv && !graph_utils::IsSupportedOptypeVersionAndDomain(conv_node, "QLinearConv", {10})) ||
+        !graph_utils::IsSupportedProvider(conv_node, GetCompatibleExecutionProviders()) ||
+        !optimizer_utils::CheckOutputEdges(graph, conv_node, 1)) {
+      continue;
+    }
+
+    auto& conv_input_args = conv_node.MutableInputDefs();
+    if (ArgExists(conv_input_args, 9)) {
+      continue;  // already fused
+    }
+
+    // The add may already be fused with the conv producing its other operand.
+    Node& add_node = *graph.GetNode(conv_node.OutputNodesBegin()->Index());
+    if (fused_nodes.count(add_node.Index()) != 0 ||
+        !graph_utils::IsSupportedOptypeVersionAndDomain(add_node, "QLinearAdd", {1}, kMSDomain) ||
+        add_node.GetExecutionProviderType() != conv_node.GetExecutionProviderType()) {
+      continue;
+    }
+
+    // The conv output may be either operand of the add.
+    auto& add_input_args = add_node.MutableInputDefs();
+    NodeArg* conv_output_arg = conv_node.MutableOutputDefs()[0];
+    const size_t conv_operand = add_input_args[0] == conv_output_arg ? 0 : 3;
+    const size_t sum_operand = 3 - conv_operand;
+    if (add_input_args[conv_operand] != conv_output_arg || add_input_args[sum_operand] == conv_output_arg ||
+        !HaveSameShape(*conv_output_arg, *add_input_args[sum_operand]) ||
+        !IsSameQuantParam(graph, conv_input_args[6], add_input_args[conv_operand + 1]) ||
+        !IsSameQuantParam(graph, conv_input_args[7],
+                          ArgExists(add_input_args, conv_operand + 2) ? add_input_args[conv_operand + 2] : nullptr)) {
+      continue;
+    }
+
+    NodeArg* add_y_zero_point = ArgExists(add_input_args, 7) ? add_input_args[7] : nullptr;
+
+    // Fuse the activation when the add output feeds only it.
+    Node* activation_node = nullptr;
+    if (optimizer_utils::CheckOutputEdges(graph, add_node, 1)) {
+      Node& next_node = *graph.GetNode(add_node.OutputNodesBegin()->Index());
+      auto& next_input_args = next_node.MutableInputDefs();
+      if (graph_utils::IsSupportedOptypeVersionAndDomain(next_node, "QLinearLeakyRelu", {1}, kMSDomain) &&
+          next_node.GetExecutionProviderType() == conv_node.GetExecutionProviderType() &&
+          IsSameQuantParam(graph, add_input_args[6], next_input_args[1]) &&
+          IsSameQuantParam(graph, add_y_zero_point, ArgExists(next_input_args, 2) ? next_input_args[2] : nullptr)) {
+        activation_node = &next_node;
+      }
+    }
+
+    NodeArg& optional_node_arg = graph.GetOrCreateNodeArg("", nullptr);
+    InlinedVector<NodeArg*> input_defs;
+    for (size_t i = 0; i < 9; ++i) {
+      input_defs.push_back(ArgExists(conv_input_args, i) ? conv_input_args[i] : &optional_node_arg);
+    }
+    input_defs.push_back(add_input_args[sum_operand]);
+    input_defs.push_back(add_input_args[sum_operand + 1]);
+    input_defs.push_back(ArgExists(add_input_args, sum_operand + 2) ? add_input_args[sum_operand + 2]
+                                                                    : &optional_node_arg);
+    input_defs.push_back(add_input_args[6]);
+    input_defs.push_back(add_y_zero_point != nullptr ? add_y_zero_point : &optional_node_arg);
+
+    Node& last_node = activation_node != nullptr ? *activation_node : add_node;
+    if (activation_node != nullptr) {
+      auto& activation_input_args = activation_node->MutableInputDefs();
+      input_defs.push_back(activation_input_args[3]);
+      if (ArgExists(activation_input_args, 4)) {
+        input_defs.push_back(activation_input_args[4]);
+      }
+    }
+
+    Node& fused_node = graph.AddNode(graph.GenerateNodeName(conv_node.Name() + "_add_fusion"),
+                                     "QLinearConv",
+                                     "fused QLinearConv " + conv_node.Name() + " with residual add",
+                                     input_defs,
+                                     last_node.MutableOutputDefs(),
+                                     &conv_node.GetAttributes(),
+                                     kMSDomain);
+    if (activation_node != nullptr) {
+      const auto* alpha_attr = graph_utils::GetNodeAttribute(*activation_node, "alpha");
+      fused_node.AddAttribute("activation", std::string("LeakyRelu"));
+      fused_node.AddAttribute("activation_params",
+                              std::vector<float>{alpha_attr != nullptr ? alpha_attr->f() : 0.01f});
+    }
+
+    // Assign provider to this new node. Provider should be same as the provider for old node.
+    fused_node.SetExecutionProviderType(conv_node.GetExecutionProviderType());
+
+    nodes_to_remove.push_back(conv_node);
+    nodes_to_remove.push_back(add_node);
+    fused_nodes.insert(add_node.Index());
+    if (activation_node != nullptr) {
+      nodes_to_remove.push_back(*activation_node);
+    }
+  }
+
+  modified = modified || !nodes_to_remove.empty();
+
+  for (const auto& node : nodes_to_remove) {
+    graph_utils::RemoveNodeOutputEdges(graph, node);
+    graph.RemoveNode(node.get().Index());
+  }
+
+  return Status::OK();
+}
+}  // namespace onnxruntime
@@ -0,0 +1,25 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class QLinearConvAddFusion
+Fuse QLinearConv + QLinearAdd, optionally followed by QLinearLeakyRelu, into a com.microsoft QLinearConv whose
+epilogue performs the residual add and the activation lookup on the requantized output, instead of writing and
+reading back the full tensor between the three kernels.
+*/
+class QLinearConvAddFusion : public GraphTransformer {
+ public:
+  QLinearConvAddFusion(const InlinedHashSet<std::string_view>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("QLinearConvAddFusion", compatible_execution_providers) {
+  }
+
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+};
+
+}  // namespace onnxruntime
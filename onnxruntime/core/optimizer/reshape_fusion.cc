@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "core/graph/graph_utils.h"
+#include "core/graph/symbolic_dim.h"
 #include "core/optimizer/initializer.h"
 #include "core/optimizer/reshape_fusion.h"
 #include "core/optimizer/utils.h"
@@ -323,13 +324,48 @@ bool ReshapeFusion::Is_One_Element_Output_Subgraph(Graph& graph, const NodeArg&
   return false;
 }
 
+// Calculate the shape_value from the values of the Reshape shape input that graph shape inferencing derived.
+// A symbolic value that equals the dimension of the root input at the same index becomes 0 and any other
+// symbolic or unknown value becomes -1.
+static bool GetInferredShapeValue(const NodeArg& root_input, const Node& reshape, const NodeArg& shape_input,
+                                  InlinedVector<int64_t>& shape_value) {
+  const auto* values = shape_input.InferredShapeValues();
+  const auto* root_shape = root_input.Shape();
+  if (values == nullptr || root_shape == nullptr) {
+    return false;
+  }
+
+  // With allowzero, 0 is a zero dimension instead of a copy of the input dimension.
+  const auto* allow_zero = graph_utils::GetNodeAttribute(reshape, "allowzero");
+  if (allow_zero != nullptr && allow_zero->i() != 0) {
+    return false;
+  }
+
+  InlinedVector<int64_t> result;
+  for (int i = 0; i < values->dim_size(); ++i) {
+    const auto& dim = values->dim(i);
+    if (utils::HasDimValue(dim)) {
+      result.push_back(dim.dim_value());
+      continue;
+    }
+
+    auto value = SymbolicDim::FromDimension(dim);
+    auto root_dim = i < root_shape->dim_size() ? SymbolicDim::FromDimension(root_shape->dim(i)) : std::nullopt;
+    result.push_back(value.has_value() && root_dim.has_value() && *value == *root_dim ? 0 : -1);
+  }
+
+  shape_value = std::move(result);
+  return true;
+}
+
 /**
 Apply Reshape Fusion. The following are subgraphs before and after fusion:
 (a[] and b[] are int64[] constant initializers; Concat may have any number of arguments,
 each of which is a constant initializer or a Shape->Gather->Unsqueeze chain with the
 index corresponding to the index of the argument, or a custom subgraph in which nodes
-have only one output edge. Note the resulting shape value should contain no more than one
-value of -1.
+have only one output edge. If the arguments match none of these, the values of the Concat output
+derived by graph shape inferencing are used. Note the resulting shape value should contain no more
+than one value of -1.
 
 Before fusion:
    [Sub-graph    Root]
@@ -376,6 +412,7 @@ bool ReshapeFusion::Fuse_Subgraph(Node& reshape, Graph& graph, const logging::Lo
   InlinedVector<int64_t> shape_value;
   shape_value.reserve(concat_input_count);
 
+  bool matched_patterns = true;
   for (int i = 0; i < concat_input_count; ++i) {
     // First check if the i-th argument is a constant initializer.
     if (optimizer_utils::AppendTensorFromInitializer(graph, *(concat.InputDefs()[i]), shape_value, true)) {
@@ -403,6 +440,13 @@ bool ReshapeFusion::Fuse_Subgraph(Node& reshape, Graph& graph, const logging::Lo
       shape_value.push_back(-1);
       continue;
     }
+    matched_patterns = false;
+    break;
+  }
+
+  // The values derived by graph shape inferencing cover subgraphs that the patterns above do not match,
+  // e.g. a dimension computed as Mul(Shape(x)[0], Shape(x)[1]).
+  if (!matched_patterns && !GetInferredShapeValue(root_input, reshape, *concat.OutputDefs()[0], shape_value)) {
     return false;
   }
 
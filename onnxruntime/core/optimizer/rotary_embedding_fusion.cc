@@ -0,0 +1,306 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/rotary_embedding_fusion.h"
+
+#include "core/graph/graph_utils.h"
+#include "core/optimizer/initializer.h"
+#include "core/optimizer/utils.h"
+
+#define DEBUG_LOG(x) LOGS(logger, VERBOSE) << x
+
+using namespace ONNX_NAMESPACE;
+using namespace onnxruntime::common;
+
+namespace onnxruntime {
+
+// The CPU kernel of RotaryEmbedding supports float only.
+static constexpr std::array supported_data_types{"tensor(float)"};
+
+static bool IsIntermediateNode(const Graph& graph, const Node& node) {
+  return node.GetOutputEdgesCount() == 1 && !graph.NodeProducesGraphOutput(node);
+}
+
+// Get the start and end of a Slice on the last axis of a tensor with the given rank.
+static bool GetLastAxisSlice(const Graph& graph, const Node& slice, int64_t rank, int64_t& start, int64_t& end) {
+  if (!graph_utils::IsSupportedOptypeVersionAndDomain(slice, "Slice", {10, 11, 13}) ||
+      slice.InputDefs().size() < 4 || !IsIntermediateNode(graph, slice)) {
+    return false;
+  }
+
+  InlinedVector<int64_t> starts;
+  InlinedVector<int64_t> ends;
+  InlinedVector<int64_t> axes;
+  if (!optimizer_utils::AppendTensorFromInitializer(graph, *slice.InputDefs()[1], starts) ||
+      !optimizer_utils::AppendTensorFromInitializer(graph, *slice.InputDefs()[2], ends) ||
+      !optimizer_utils::AppendTensorFromInitializer(graph, *slice.InputDefs()[3], axes) ||
+      starts.size() != 1 || ends.size() != 1 || axes.size() != 1 ||
+      (axes[0] != -1 && axes[0] != rank - 1)) {
+    return false;
+  }
+
+  if (slice.InputDefs().size() > 4 && slice.InputDefs()[4]->Exists()) {
+    InlinedVector<int64_t> steps;
+    if (!optimizer_utils::AppendTensorFromInitializer(graph, *slice.InputDefs()[4], steps) ||
+        steps.size() != 1 || steps[0] != 1) {
+      return false;
+    }
+  }
+
+  start = starts[0];
+  end = ends[0];
+  return true;
+}
+
+// Match Unsqueeze(Gather(cache, position_ids), axes=[1]) which produces the cos or sin input of a Mul.
+static bool MatchCacheGather(const Graph& graph, const NodeArg& arg, const NodeArg*& cache, const Node*& unsqueeze,
+                             const Node*& gather) {
+  unsqueeze = graph.GetProducerNode(arg.Name());
+  if (unsqueeze == nullptr ||
+      !graph_utils::IsSupportedOptypeVersionAndDomain(*unsqueeze, "Unsqueeze", {1, 11, 13})) {
+    return false;
+  }
+
+  InlinedVector<int64_t> axes;
+  if (unsqueeze->SinceVersion() >= 13) {
+    if (unsqueeze->InputDefs().size() < 2 ||
+        !optimizer_utils::AppendTensorFromInitializer(graph, *unsqueeze->InputDefs()[1], axes)) {
+      return false;
+    }
+  } else {
+    const auto* axes_attr = graph_utils::GetNodeAttribute(*unsqueeze, "axes");
+    if (axes_attr == nullptr) {
+      return false;
+    }
+    axes.assign(axes_attr->ints().begin(), axes_attr->ints().end());
+  }
+  if (axes.size() != 1 || axes[0] != 1) {
+    return false;
+  }
+
+  gather = graph.GetProducerNode(unsqueeze->InputDefs()[0]->Name());
+  if (gather == nullptr || !graph_utils::IsSupportedOptypeVersionAndDomain(*gather, "Gather", {1, 11, 13})) {
+    return false;
+  }
+  const auto* axis_attr = graph_utils::GetNodeAttribute(*gather, "axis");
+  if (axis_attr != nullptr && axis_attr->i() != 0) {
+    return false;
+  }
+
+  cache = gather->InputDefs()[0];
+  return true;
+}
+
+// RotaryEmbedding takes caches of shape (max_sequence_length, head_size / 2) while the rotate-half form uses
+// (max_sequence_length, head_size) caches whose two halves are equal. Returns nullptr if the halves differ.
+static NodeArg* GetHalfCache(Graph& graph, const NodeArg& cache_arg, int64_t head_size,
+                             InlinedHashMap<std::string, NodeArg*>& half_caches) {
+  auto it = half_caches.find(cache_arg.Name());
+  if (it != half_caches.end()) {
+    return it->second;
+  }
+
+  const TensorProto* tensor_proto = graph_utils::GetConstantInitializer(graph, cache_arg.Name());
+  if (tensor_proto == nullptr || tensor_proto->data_type() != TensorProto_DataType_FLOAT ||
+      tensor_proto->dims_size() != 2 || tensor_proto->dims(1) != head_size) {
+    return nullptr;
+  }
+
+  Initializer cache{*tensor_proto, graph.ModelPath()};
+  const float* data = cache.data<float>();
+  const int64_t rows = tensor_proto->dims(0);
+  const int64_t half_head_size = head_size / 2;
+
+  std::vector<float> half_data(gsl::narrow<size_t>(rows * half_head_size));
+  for (int64_t r = 0; r < rows; r++) {
+    for (int64_t i = 0; i < half_head_size; i++) {
+      const float value = data[r * head_size + i];
+      if (value != data[r * head_size + half_head_size + i]) {
+        return nullptr;
+      }
+      half_data[gsl::narrow<size_t>(r * half_head_size + i)] = value;
+    }
+  }
+
+  TensorProto half_proto;
+  half_proto.set_name(graph.GenerateNodeArgName(cache_arg.Name() + "_half"));
+  half_proto.set_data_type(TensorProto_DataType_FLOAT);
+  half_proto.add_dims(rows);
+  half_proto.add_dims(half_head_size);
+  half_proto.set_raw_data(half_data.data(), half_data.size() * sizeof(float));
+
+  NodeArg* half_arg = &graph_utils::AddInitializer(graph, half_proto);
+  half_caches[cache_arg.Name()] = half_arg;
+  return half_arg;
+}
+
+static bool FuseRotaryEmbedding(Graph& graph, Node& add, int rotate_input_index,
+                                InlinedHashMap<std::string, NodeArg*>& half_caches, const logging::Logger& logger) {
+  const Node* mul_x = graph_utils::GetInputNode(add, 1 - rotate_input_index);
+  const Node* mul_rotate = graph_utils::GetInputNode(add, rotate_input_index);
+  if (mul_x == nullptr || mul_rotate == nullptr ||
+      !graph_utils::IsSupportedOptypeVersionAndDomain(*mul_x, "Mul", {7, 13, 14}) ||
+      !graph_utils::IsSupportedOptypeVersionAndDomain(*mul_rotate, "Mul", {7, 13, 14}) ||
+      !IsIntermediateNode(graph, *mul_x) || !IsIntermediateNode(graph, *mul_rotate)) {
+    return false;
+  }
+
+  // Concat(Neg(x[..., H/2:]), x[..., :H/2]) is the rotate-half input of one Mul.
+  const Node* concat = nullptr;
+  int concat_input_index = -1;
+  for (int i = 0; i < 2; i++) {
+    const Node* input_node = graph_utils::GetInputNode(*mul_rotate, i);
+    if (input_node != nullptr && graph_utils::IsSupportedOptypeVersionAndDomain(*input_node, "Concat", {4, 11, 13})) {
+      concat = input_node;
+      concat_input_index = i;
+      break;
+    }
+  }
+  if (concat == nullptr || concat->InputDefs().size() != 2 || !IsIntermediateNode(graph, *concat)) {
+    return false;
+  }
+
+  const Node* neg = graph_utils::GetInputNode(*concat, 0);
+  if (neg == nullptr || !graph_utils::IsSupportedOptypeVersionAndDomain(*neg, "Neg", {6, 13}) ||
+      !IsIntermediateNode(graph, *neg)) {
+    return false;
+  }
+
+  const Node* slice_second_half = graph_utils::GetInputNode(*neg, 0);
+  const Node* slice_first_half = graph_utils::GetInputNode(*concat, 1);
+  if (slice_second_half == nullptr || slice_first_half == nullptr ||
+      slice_first_half->InputDefs()[0]->Name() != slice_second_half->InputDefs()[0]->Name()) {
+    return false;
+  }
+
+  const NodeArg& x_arg = *slice_first_half->InputDefs()[0];
+  const auto* x_shape = x_arg.Shape();
+  if (x_shape == nullptr || x_shape->dim_size() != 4 || !x_shape->dim(3).has_dim_value()) {
+    DEBUG_LOG("RotaryEmbeddingFusion requires input of rank 4 with known head size");
+    return false;
+  }
+  const int64_t rank = 4;
+  const int64_t head_size = x_shape->dim(3).dim_value();
+  if (head_size <= 0 || head_size % 2 != 0) {
+    return false;
+  }
+
+  const auto* concat_axis = graph_utils::GetNodeAttribute(*concat, "axis");
+  if (concat_axis == nullptr || (concat_axis->i() != -1 && concat_axis->i() != rank - 1)) {
+    return false;
+  }
+
+  int64_t start = 0;
+  int64_t end = 0;
+  if (!GetLastAxisSlice(graph, *slice_first_half, rank, start, end) || start != 0 || end != head_size / 2) {
+    DEBUG_LOG("First half Slice does not match");
+    return false;
+  }
+  if (!GetLastAxisSlice(graph, *slice_second_half, rank, start, end) || start != head_size / 2 || end < head_size) {
+    DEBUG_LOG("Second half Slice does not match");
+    return false;
+  }
+
+  // The other Mul multiplies x by the cos cache.
+  int x_input_index = -1;
+  for (int i = 0; i < 2; i++) {
+    if (mul_x->InputDefs()[i]->Name() == x_arg.Name()) {
+      x_input_index = i;
+      break;
+    }
+  }
+  if (x_input_index < 0) {
+    return false;
+  }
+
+  const NodeArg* cos_cache = nullptr;
+  const NodeArg* sin_cache = nullptr;
+  const Node* cos_unsqueeze = nullptr;
+  const Node* cos_gather = nullptr;
+  const Node* sin_unsqueeze = nullptr;
+  const Node* sin_gather = nullptr;
+  if (!MatchCacheGather(graph, *mul_x->InputDefs()[1 - x_input_index], cos_cache, cos_unsqueeze, cos_gather) ||
+      !MatchCacheGather(graph, *mul_rotate->InputDefs()[1 - concat_input_index], sin_cache, sin_unsqueeze,
+                        sin_gather)) {
+    DEBUG_LOG("cos/sin caches are not gathered by position ids");
+    return false;
+  }
+
+  const NodeArg* position_ids = cos_gather->InputDefs()[1];
+  if (position_ids->Name() != sin_gather->InputDefs()[1]->Name() || position_ids->TypeAsProto() == nullptr ||
+      position_ids->TypeAsProto()->tensor_type().elem_type() != TensorProto_DataType_INT64 ||
+      position_ids->Shape() == nullptr || position_ids->Shape()->dim_size() != 2) {
+    DEBUG_LOG("position ids of cos and sin caches do not match");
+    return false;
+  }
+
+  NodeArg* cos_half = GetHalfCache(graph, *cos_cache, head_size, half_caches);
+  NodeArg* sin_half = GetHalfCache(graph, *sin_cache, head_size, half_caches);
+  if (cos_half == nullptr || sin_half == nullptr) {
+    DEBUG_LOG("cos/sin caches are not constant or their halves differ");
+    return false;
+  }
+
+  Node& rotary_node = graph.AddNode(graph.GenerateNodeName("RotaryEmbedding"),
+                                    "RotaryEmbedding",
+                                    "Fused rotary embedding",
+                                    {graph.GetNodeArg(x_arg.Name()), graph.GetNodeArg(position_ids->Name()),
+                                     cos_half, sin_half},
+                                    {add.MutableOutputDefs()[0]},
+                                    nullptr,
+                                    kMSDomain);
+  rotary_node.AddAttribute("interleaved", static_cast<int64_t>(0));
+  rotary_node.SetExecutionProviderType(add.GetExecutionProviderType());
+
+  const NodeIndex nodes_to_remove[] = {slice_first_half->Index(), slice_second_half->Index(), neg->Index(),
+                                       concat->Index(), mul_x->Index(), mul_rotate->Index(), add.Index()};
+  for (NodeIndex index : nodes_to_remove) {
+    Node* node = graph.GetNode(index);
+    graph_utils::RemoveNodeOutputEdges(graph, *node);
+    graph.RemoveNode(index);
+  }
+
+  // The gathered caches are usually shared by the query and key rotations; remove them after the last use.
+  const NodeIndex cache_nodes[] = {cos_unsqueeze->Index(), sin_unsqueeze->Index(), cos_gather->Index(),
+                                   sin_gather->Index()};
+  for (NodeIndex index : cache_nodes) {
+    Node* node = graph.GetNode(index);
+    if (node != nullptr && node->GetOutputEdgesCount() == 0 && !graph.NodeProducesGraphOutput(*node)) {
+      graph.RemoveNode(index);
+    }
+  }
+
+  return true;
+}
+
+Status RotaryEmbeddingFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level,
+                                        const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+  InlinedHashMap<std::string, NodeArg*> half_caches;
+
+  for (auto node_index : node_topology_list) {
+    Node* p_node = graph.GetNode(node_index);
+    if (p_node == nullptr) continue;  // node was removed as part of an earlier fusion
+
+    Node& node = *p_node;
+    ORT_RETURN_IF_ERROR(Recurse(node, modified, graph_level, logger));
+
+    if (!graph_utils::IsSupportedOptypeVersionAndDomain(node, "Add", {7, 13, 14}) ||
+        !graph_utils::IsSupportedProvider(node, GetCompatibleExecutionProviders()) ||
+        !optimizer_utils::IsSupportedDataType(node, supported_data_types)) {
+      continue;
+    }
+
+    for (int rotate_input_index = 0; rotate_input_index < 2; rotate_input_index++) {
+      if (FuseRotaryEmbedding(graph, node, rotate_input_index, half_caches, logger)) {
+        modified = true;
+        break;
+      }
+    }
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,29 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class RotaryEmbeddingFusion
+
+Rewrite the rotate-half form of rotary position embeddings exported from PyTorch
+
+    x * Unsqueeze(Gather(cos_cache, position_ids)) +
+    Concat(-x[..., H/2:], x[..., :H/2]) * Unsqueeze(Gather(sin_cache, position_ids))
+
+to a RotaryEmbedding node. The cos/sin caches must be constant initializers whose two halves of each row are
+equal, which is how they are built by Llama style models.
+*/
+class RotaryEmbeddingFusion : public GraphTransformer {
+ public:
+  RotaryEmbeddingFusion(const InlinedHashSet<std::string_view>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("RotaryEmbeddingFusion", compatible_execution_providers) {}
+
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+};
+
+}  // namespace onnxruntime
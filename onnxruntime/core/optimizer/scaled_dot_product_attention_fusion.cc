@@ -0,0 +1,292 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/scaled_dot_product_attention_fusion.h"
+
+#include <array>
+
+#include "core/graph/graph_utils.h"
+#include "core/optimizer/utils.h"
+
+using namespace ONNX_NAMESPACE;
+
+namespace onnxruntime {
+
+namespace {
+
+// types supported by MultiHeadAttention. The CPU kernel only supports float.
+constexpr std::array supported_data_types{"tensor(float)"};
+constexpr std::array gpu_supported_data_types{"tensor(float16)", "tensor(float)"};
+
+bool IsTranspose(const Node* node, const std::vector<int64_t>& perm) {
+  return node != nullptr && graph_utils::IsSupportedOptypeVersionAndDomain(*node, "Transpose", {1, 13}) &&
+         optimizer_utils::IsAttributeWithExpectedValues(*node, "perm", perm);
+}
+
+// Matches the Reshape of a query, key or value from (B, S, N*H) to (B, S, N, H), and checks that the number of heads
+// and the head size match those of the other Reshapes, and that the batch and sequence dimensions are kept.
+// Returns the 3D input of the Reshape, or nullptr.
+const NodeArg* MatchHeadsReshape(const Graph& graph, const Node* reshape, int64_t& num_heads, int64_t& head_size) {
+  if (reshape == nullptr || !graph_utils::IsSupportedOptypeVersionAndDomain(*reshape, "Reshape", {5, 13, 14, 19})) {
+    return nullptr;
+  }
+
+  InlinedVector<int64_t> shape;
+  if (!optimizer_utils::AppendTensorFromInitializer(graph, *reshape->InputDefs()[1], shape) || shape.size() != 4 ||
+      shape[2] <= 0 || shape[3] <= 0) {
+    return nullptr;
+  }
+  if ((num_heads > 0 && num_heads != shape[2]) || (head_size > 0 && head_size != shape[3])) {
+    return nullptr;
+  }
+  num_heads = shape[2];
+  head_size = shape[3];
+
+  // MultiHeadAttention takes the 3D inputs
+  const NodeArg* input = reshape->InputDefs()[0];
+  const auto* input_shape = input->Shape();
+  if (input_shape == nullptr || input_shape->dim_size() != 3 ||
+      (utils::HasDimValue(input_shape->dim(2)) && input_shape->dim(2).dim_value() != num_heads * head_size)) {
+    return nullptr;
+  }
+
+  // A dimension is kept if it is copied from the input (0, unless allowzero is set) or equals the input dimension.
+  const auto* allowzero = graph_utils::GetNodeAttribute(*reshape, "allowzero");
+  const bool copies_zero_dims = allowzero == nullptr || allowzero->i() == 0;
+  auto keeps_dim = [&](int i) {
+    const auto& input_dim = input_shape->dim(i);
+    return (shape[i] == 0 && copies_zero_dims) ||
+           (utils::HasDimValue(input_dim) && input_dim.dim_value() == shape[i]);
+  };
+  // -1 is inferred as the input dimension only if the other dimensions are known to be kept
+  const bool keeps_hidden_size = utils::HasDimValue(input_shape->dim(2));
+  const bool keeps_batch = keeps_dim(0) || (shape[0] == -1 && keeps_hidden_size && keeps_dim(1));
+  const bool keeps_sequence = keeps_dim(1) || (shape[1] == -1 && keeps_hidden_size && keeps_dim(0));
+  if (!keeps_batch || !keeps_sequence) {
+    return nullptr;
+  }
+  return input;
+}
+
+bool IsSameDim(const TensorShapeProto_Dimension& dim, const TensorShapeProto_Dimension& other_dim) {
+  return (utils::HasDimValue(dim) && utils::HasDimValue(other_dim) && dim.dim_value() == other_dim.dim_value()) ||
+         (utils::HasDimParam(dim) && utils::HasDimParam(other_dim) && dim.dim_param() == other_dim.dim_param());
+}
+
+// Checks if an attention bias added to the scores of shape (B, N, S, L) has the shape (B or 1, N, S, L) that
+// MultiHeadAttention takes.
+bool IsSupportedAttentionBias(const NodeArg& bias, const NodeArg& scores, int64_t num_heads) {
+  const auto* bias_shape = bias.Shape();
+  const auto* scores_shape = scores.Shape();
+  if (bias_shape == nullptr || scores_shape == nullptr || bias_shape->dim_size() != 4 ||
+      scores_shape->dim_size() != 4) {
+    return false;
+  }
+
+  const auto& batch_dim = bias_shape->dim(0);
+  const bool is_broadcast_batch = utils::HasDimValue(batch_dim) && batch_dim.dim_value() == 1;
+  return (is_broadcast_batch || IsSameDim(batch_dim, scores_shape->dim(0))) &&
+         utils::HasDimValue(bias_shape->dim(1)) && bias_shape->dim(1).dim_value() == num_heads &&
+         IsSameDim(bias_shape->dim(2), scores_shape->dim(2)) && IsSameDim(bias_shape->dim(3), scores_shape->dim(3));
+}
+
+// The nodes of a matched attention subgraph, and the inputs of the MultiHeadAttention node that replaces it.
+struct AttentionMatch {
+  InlinedVector<const Node*> nodes;
+  const NodeArg* query = nullptr;
+  const NodeArg* key = nullptr;
+  const NodeArg* value = nullptr;
+  const NodeArg* attention_bias = nullptr;
+  float scale = 1.0f;
+  int64_t num_heads = 0;
+  int64_t head_size = 0;
+  Node* output_reshape = nullptr;
+};
+
+// Matches the attention subgraph around a Softmax node.
+bool MatchAttention(Graph& graph, const Node& softmax, AttentionMatch& match) {
+  const bool is_gpu = softmax.GetExecutionProviderType() == kCudaExecutionProvider ||
+                      softmax.GetExecutionProviderType() == kRocmExecutionProvider;
+  if (!graph_utils::IsSupportedOptypeVersionAndDomain(softmax, "Softmax", {13}) ||
+      !(is_gpu ? optimizer_utils::IsSupportedDataType(softmax, gpu_supported_data_types)
+               : optimizer_utils::IsSupportedDataType(softmax, supported_data_types)) ||
+      !(optimizer_utils::IsAttributeWithExpectedValue(softmax, "axis", static_cast<int64_t>(-1)) ||
+        optimizer_utils::IsAttributeWithExpectedValue(softmax, "axis", static_cast<int64_t>(3)) ||
+        graph_utils::GetNodeAttribute(softmax, "axis") == nullptr) ||
+      !optimizer_utils::CheckOutputEdges(graph, softmax, 1)) {
+    return false;
+  }
+  match.nodes.push_back(&softmax);
+
+  // optional attention bias and scale between the MatMul of query and key and the Softmax
+  const Node* node = graph_utils::GetInputNode(softmax, 0);
+  if (node != nullptr && graph_utils::IsSupportedOptypeVersionAndDomain(*node, "Add", {7, 13, 14})) {
+    if (!optimizer_utils::CheckOutputEdges(graph, *node, 1)) {
+      return false;
+    }
+    // the scores are the input produced by the scale or the MatMul
+    const Node* input_0 = graph_utils::GetInputNode(*node, 0);
+    const int scores_index = input_0 != nullptr && (input_0->OpType() == "MatMul" || input_0->OpType() == "Div" ||
+                                                    input_0->OpType() == "Mul")
+                                 ? 0
+                                 : 1;
+    match.attention_bias = node->InputDefs()[1 - scores_index];
+    match.nodes.push_back(node);
+    node = graph_utils::GetInputNode(*node, scores_index);
+  }
+
+  if (node != nullptr && (graph_utils::IsSupportedOptypeVersionAndDomain(*node, "Div", {7, 13, 14}) ||
+                          graph_utils::IsSupportedOptypeVersionAndDomain(*node, "Mul", {7, 13, 14}))) {
+    float scale = 0.0f;
+    if (!optimizer_utils::CheckOutputEdges(graph, *node, 1) ||
+        !optimizer_utils::GetScalarInitializerValue(graph, *node->InputDefs()[1], scale, true) || scale == 0.0f) {
+      return false;
+    }
+    match.scale = node->OpType() == "Div" ? 1.0f / scale : scale;
+    match.nodes.push_back(node);
+    node = graph_utils::GetInputNode(*node, 0);
+  }
+
+  const Node* qk_matmul = node;
+  if (qk_matmul == nullptr || !graph_utils::IsSupportedOptypeVersionAndDomain(*qk_matmul, "MatMul", {1, 9, 13}) ||
+      !optimizer_utils::CheckOutputEdges(graph, *qk_matmul, 1)) {
+    return false;
+  }
+  match.nodes.push_back(qk_matmul);
+
+  // query: Reshape -> Transpose (0, 2, 1, 3)
+  const Node* q_transpose = graph_utils::GetInputNode(*qk_matmul, 0);
+  if (!IsTranspose(q_transpose, {0, 2, 1, 3}) || !optimizer_utils::CheckOutputEdges(graph, *q_transpose, 1)) {
+    return false;
+  }
+  const Node* q_reshape = graph_utils::GetInputNode(*q_transpose, 0);
+  match.query = MatchHeadsReshape(graph, q_reshape, match.num_heads, match.head_size);
+  if (match.query == nullptr || !optimizer_utils::CheckOutputEdges(graph, *q_reshape, 1)) {
+    return false;
+  }
+  match.nodes.push_back(q_transpose);
+  match.nodes.push_back(q_reshape);
+
+  // key: Reshape -> Transpose (0, 2, 3, 1), or Reshape -> Transpose (0, 2, 1, 3) -> Transpose (0, 1, 3, 2)
+  const Node* k_transpose = graph_utils::GetInputNode(*qk_matmul, 1);
+  if (k_transpose == nullptr || !optimizer_utils::CheckOutputEdges(graph, *k_transpose, 1)) {
+    return false;
+  }
+  match.nodes.push_back(k_transpose);
+  if (IsTranspose(k_transpose, {0, 1, 3, 2})) {
+    k_transpose = graph_utils::GetInputNode(*k_transpose, 0);
+    if (!IsTranspose(k_transpose, {0, 2, 1, 3}) || !optimizer_utils::CheckOutputEdges(graph, *k_transpose, 1)) {
+      return false;
+    }
+    match.nodes.push_back(k_transpose);
+  } else if (!IsTranspose(k_transpose, {0, 2, 3, 1})) {
+    return false;
+  }
+  const Node* k_reshape = graph_utils::GetInputNode(*k_transpose, 0);
+  match.key = MatchHeadsReshape(graph, k_reshape, match.num_heads, match.head_size);
+  if (match.key == nullptr || !optimizer_utils::CheckOutputEdges(graph, *k_reshape, 1)) {
+    return false;
+  }
+  match.nodes.push_back(k_reshape);
+
+  // value: Reshape -> Transpose (0, 2, 1, 3) -> MatMul with the probabilities
+  const Node& qkv_matmul = *softmax.OutputNodesBegin();
+  if (!graph_utils::IsSupportedOptypeVersionAndDomain(qkv_matmul, "MatMul", {1, 9, 13}) ||
+      qkv_matmul.InputDefs()[0] != softmax.OutputDefs()[0] ||
+      !optimizer_utils::CheckOutputEdges(graph, qkv_matmul, 1)) {
+    return false;
+  }
+  match.nodes.push_back(&qkv_matmul);
+  const Node* v_transpose = graph_utils::GetInputNode(qkv_matmul, 1);
+  if (!IsTranspose(v_transpose, {0, 2, 1, 3}) || !optimizer_utils::CheckOutputEdges(graph, *v_transpose, 1)) {
+    return false;
+  }
+  const Node* v_reshape = graph_utils::GetInputNode(*v_transpose, 0);
+  match.value = MatchHeadsReshape(graph, v_reshape, match.num_heads, match.head_size);
+  if (match.value == nullptr || !optimizer_utils::CheckOutputEdges(graph, *v_reshape, 1)) {
+    return false;
+  }
+  match.nodes.push_back(v_transpose);
+  match.nodes.push_back(v_reshape);
+
+  // output: Transpose (0, 2, 1, 3) -> Reshape to (B, S, N*H)
+  const Node& output_transpose = *qkv_matmul.OutputNodesBegin();
+  if (!IsTranspose(&output_transpose, {0, 2, 1, 3}) || !optimizer_utils::CheckOutputEdges(graph, output_transpose, 1)) {
+    return false;
+  }
+  match.nodes.push_back(&output_transpose);
+  Node& output_reshape = *graph.GetNode(output_transpose.OutputNodesBegin()->Index());
+  InlinedVector<int64_t> output_shape;
+  if (!graph_utils::IsSupportedOptypeVersionAndDomain(output_reshape, "Reshape", {5, 13, 14, 19}) ||
+      !optimizer_utils::AppendTensorFromInitializer(graph, *output_reshape.InputDefs()[1], output_shape) ||
+      output_shape.size() != 3 || output_shape[2] != match.num_heads * match.head_size) {
+    return false;
+  }
+  match.nodes.push_back(&output_reshape);
+  match.output_reshape = &output_reshape;
+
+  if (match.attention_bias != nullptr &&
+      !IsSupportedAttentionBias(*match.attention_bias, *qk_matmul->OutputDefs()[0], match.num_heads)) {
+    return false;
+  }
+
+  return true;
+}
+
+}  // namespace
+
+Status ScaledDotProductAttentionFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level,
+                                                  const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+
+  for (auto node_index : node_topology_list) {
+    auto* p_node = graph.GetNode(node_index);
+    if (p_node == nullptr) {
+      continue;  // we removed the node as part of an earlier fusion
+    }
+
+    Node& node = *p_node;
+    ORT_RETURN_IF_ERROR(Recurse(node, modified, graph_level, logger));
+
+    if (node.OpType() != "Softmax" || !graph_utils::IsSupportedProvider(node, GetCompatibleExecutionProviders())) {
+      continue;
+    }
+
+    AttentionMatch match;
+    if (!MatchAttention(graph, node, match)) {
+      continue;
+    }
+
+    // the scale is always set, as the default of MultiHeadAttention is 1/sqrt(head_size)
+    NodeArg& empty = graph.GetOrCreateNodeArg("", nullptr);
+    InlinedVector<NodeArg*> inputs{graph.GetNodeArg(match.query->Name()), graph.GetNodeArg(match.key->Name()),
+                                   graph.GetNodeArg(match.value->Name())};
+    if (match.attention_bias != nullptr) {
+      inputs.push_back(&empty);  // bias
+      inputs.push_back(&empty);  // key_padding_mask
+      inputs.push_back(graph.GetNodeArg(match.attention_bias->Name()));
+    }
+
+    Node& attention_node = graph.AddNode(graph.GenerateNodeName("MultiHeadAttention"), "MultiHeadAttention",
+                                         "Fused scaled dot product attention", inputs,
+                                         {match.output_reshape->MutableOutputDefs()[0]}, nullptr, kMSDomain);
+    attention_node.AddAttribute("num_heads", match.num_heads);
+    attention_node.AddAttribute("scale", match.scale);
+    attention_node.SetExecutionProviderType(node.GetExecutionProviderType());
+
+    // the new node produces the output of the final Reshape, and is connected when the graph is resolved
+    for (const Node* matched_node : match.nodes) {
+      Node* node_to_remove = graph.GetNode(matched_node->Index());
+      graph_utils::RemoveNodeOutputEdges(graph, *node_to_remove);
+      graph.RemoveNode(node_to_remove->Index());
+    }
+
+    LOGS(logger, VERBOSE) << "Fused scaled dot product attention into " << attention_node.Name();
+    modified = true;
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
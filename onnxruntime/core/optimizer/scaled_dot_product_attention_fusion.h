@@ -0,0 +1,32 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class ScaledDotProductAttentionFusion
+
+Rewrite the generic scaled dot product attention subgraph of vision and speech transformers (ViT, CLIP, Whisper
+encoders, ...) into a MultiHeadAttention node:
+
+  query/key/value (B, S, N*H) -> Reshape (B, S, N, H) -> Transpose to (B, N, S, H), or (B, N, H, S) for the key
+  MatMul(query, key) -> [Div or Mul by a constant scale] -> [Add(attention bias)] -> Softmax(axis=-1)
+  MatMul(probabilities, value) -> Transpose to (B, S, N, H) -> Reshape (B, S, N*H)
+
+The transpose of the key may be one Transpose with perm (0, 2, 3, 1), or a Transpose with perm (0, 2, 1, 3)
+followed by a Transpose with perm (0, 1, 3, 2). An attention bias is fused if its shape is
+(B or 1, N, S, kv_sequence_length).
+*/
+class ScaledDotProductAttentionFusion : public GraphTransformer {
+ public:
+  ScaledDotProductAttentionFusion(const InlinedHashSet<std::string_view>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("ScaledDotProductAttentionFusion", compatible_execution_providers) {}
+
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+};
+
+}  // namespace onnxruntime
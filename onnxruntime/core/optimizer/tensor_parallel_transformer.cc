@@ -0,0 +1,322 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/tensor_parallel_transformer.h"
+
+#include <utility>
+
+#include "core/graph/graph_utils.h"
+#include "core/optimizer/initializer.h"
+#include "core/optimizer/utils.h"
+
+using namespace ONNX_NAMESPACE;
+
+namespace onnxruntime {
+
+namespace {
+
+using Range = std::pair<int64_t, int64_t>;
+
+// A constant initializer input of a node to replace with the slices [begin, end) along an axis, concatenated.
+struct WeightShard {
+  Node* node;
+  int input_index;
+  const TensorProto* weight;
+  int axis;
+  InlinedVector<Range> ranges;
+};
+
+// The changes that shard one MLP or attention block.
+struct ShardPlan {
+  InlinedVector<WeightShard> weight_shards;
+  // the outputs whose last dimension becomes smaller
+  InlinedVector<NodeArg*> sharded_outputs;
+  // the MatMul that computes the partial result of the rank, followed by the AllReduce
+  Node* reduced_matmul = nullptr;
+};
+
+// Returns the constant initializer input of a node if it has the rank and a type supported by AllReduce.
+const TensorProto* GetConstantWeight(const Graph& graph, const Node& node, size_t input_index, int rank) {
+  const auto& input_defs = node.InputDefs();
+  if (input_index >= input_defs.size() || !input_defs[input_index]->Exists()) {
+    return nullptr;
+  }
+
+  const TensorProto* weight = graph_utils::GetConstantInitializer(graph, input_defs[input_index]->Name());
+  if (weight == nullptr || weight->dims_size() != rank) {
+    return nullptr;
+  }
+
+  const auto data_type = weight->data_type();
+  if (data_type != TensorProto_DataType_FLOAT && data_type != TensorProto_DataType_FLOAT16 &&
+      data_type != TensorProto_DataType_DOUBLE) {
+    return nullptr;
+  }
+  return weight;
+}
+
+// Returns the only consumer of the first output of a node, if it takes the output as its first input.
+Node* GetOnlyConsumer(Graph& graph, const Node& node) {
+  if (!optimizer_utils::CheckOutputEdges(graph, node, 1)) {
+    return nullptr;
+  }
+
+  const auto& edge = *node.OutputEdgesBegin();
+  if (edge.GetSrcArgIndex() != 0 || edge.GetDstArgIndex() != 0) {
+    return nullptr;
+  }
+  return graph.GetNode(edge.GetNode().Index());
+}
+
+bool IsMatMul(const Node& node) {
+  return graph_utils::IsSupportedOptypeVersionAndDomain(node, "MatMul", {1, 9, 13});
+}
+
+// Checks if a node is an element-wise activation, which can run on the sharded columns.
+bool IsActivation(const Node& node) {
+  if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "Relu", {6, 13, 14}) ||
+      graph_utils::IsSupportedOptypeVersionAndDomain(node, "Sigmoid", {6, 13}) ||
+      graph_utils::IsSupportedOptypeVersionAndDomain(node, "Tanh", {6, 13}) ||
+      graph_utils::IsSupportedOptypeVersionAndDomain(node, "Gelu", {20})) {
+    return true;
+  }
+  return node.Domain() == kMSDomain && (node.OpType() == "Gelu" || node.OpType() == "FastGelu" ||
+                                        node.OpType() == "BiasGelu" || node.OpType() == "QuickGelu");
+}
+
+// Matches MatMul(X, W1) -> [Add(B1)] -> activation -> MatMul(W2), starting from the first MatMul.
+bool MatchMlp(Graph& graph, Node& matmul, int64_t world_size, int64_t rank, ShardPlan& plan) {
+  const TensorProto* weight = GetConstantWeight(graph, matmul, 1, 2);
+  if (weight == nullptr) {
+    return false;
+  }
+
+  const int64_t hidden_size = weight->dims(1);
+  if (hidden_size <= 0 || hidden_size % world_size != 0) {
+    return false;
+  }
+  const Range range{rank * hidden_size / world_size, (rank + 1) * hidden_size / world_size};
+  plan.weight_shards.push_back({&matmul, 1, weight, 1, {range}});
+  plan.sharded_outputs.push_back(matmul.MutableOutputDefs()[0]);
+
+  // the bias added to all the columns is sharded the same way
+  auto add_bias_shard = [&graph, &plan, hidden_size, &range](Node& node, size_t input_index) {
+    const TensorProto* bias = GetConstantWeight(graph, node, input_index, 1);
+    if (bias == nullptr || bias->dims(0) != hidden_size) {
+      return false;
+    }
+    plan.weight_shards.push_back({&node, static_cast<int>(input_index), bias, 0, {range}});
+    return true;
+  };
+
+  Node* next = GetOnlyConsumer(graph, matmul);
+  if (next != nullptr && graph_utils::IsSupportedOptypeVersionAndDomain(*next, "Add", {7, 13, 14})) {
+    if (!add_bias_shard(*next, 1)) {
+      return false;
+    }
+    plan.sharded_outputs.push_back(next->MutableOutputDefs()[0]);
+    next = GetOnlyConsumer(graph, *next);
+  }
+
+  if (next == nullptr || !IsActivation(*next)) {
+    return false;
+  }
+  if (next->InputDefs().size() > 1 && next->InputDefs()[1]->Exists() && !add_bias_shard(*next, 1)) {
+    return false;
+  }
+  plan.sharded_outputs.push_back(next->MutableOutputDefs()[0]);
+
+  Node* output_matmul = GetOnlyConsumer(graph, *next);
+  if (output_matmul == nullptr || !IsMatMul(*output_matmul) ||
+      output_matmul->GetExecutionProviderType() != matmul.GetExecutionProviderType()) {
+    return false;
+  }
+  const TensorProto* output_weight = GetConstantWeight(graph, *output_matmul, 1, 2);
+  if (output_weight == nullptr || output_weight->dims(0) != hidden_size) {
+    return false;
+  }
+  plan.weight_shards.push_back({output_matmul, 1, output_weight, 0, {range}});
+  plan.reduced_matmul = output_matmul;
+  return true;
+}
+
+// Matches Attention(X, W_qkv, B_qkv, mask_index) -> MatMul(W_out), starting from the Attention.
+bool MatchAttention(Graph& graph, Node& attention, int64_t world_size, int64_t rank, ShardPlan& plan) {
+  // the past and present of the rank, and the attention bias, would need to be sharded by heads as well
+  const auto& input_defs = attention.InputDefs();
+  for (size_t i = 4; i < input_defs.size(); ++i) {
+    if (input_defs[i]->Exists()) {
+      return false;
+    }
+  }
+  const auto& output_defs = attention.OutputDefs();
+  if (output_defs.size() > 1 && output_defs[1]->Exists()) {
+    return false;
+  }
+  if (graph_utils::GetNodeAttribute(attention, "qkv_hidden_sizes") != nullptr) {
+    return false;
+  }
+
+  const auto* num_heads_attr = graph_utils::GetNodeAttribute(attention, "num_heads");
+  const TensorProto* weight = GetConstantWeight(graph, attention, 1, 2);
+  if (num_heads_attr == nullptr || weight == nullptr) {
+    return false;
+  }
+
+  const int64_t num_heads = num_heads_attr->i();
+  const int64_t hidden_size = weight->dims(1) / 3;
+  if (num_heads <= 0 || num_heads % world_size != 0 || hidden_size <= 0 || weight->dims(1) != 3 * hidden_size ||
+      hidden_size % num_heads != 0) {
+    return false;
+  }
+
+  // the columns of the query, key and value of the heads of the rank
+  const int64_t rank_hidden_size = hidden_size / world_size;
+  InlinedVector<Range> qkv_ranges;
+  for (int64_t i = 0; i < 3; ++i) {
+    const int64_t begin = i * hidden_size + rank * rank_hidden_size;
+    qkv_ranges.emplace_back(begin, begin + rank_hidden_size);
+  }
+  plan.weight_shards.push_back({&attention, 1, weight, 1, qkv_ranges});
+
+  if (input_defs.size() > 2 && input_defs[2]->Exists()) {
+    const TensorProto* bias = GetConstantWeight(graph, attention, 2, 1);
+    if (bias == nullptr || bias->dims(0) != 3 * hidden_size) {
+      return false;
+    }
+    plan.weight_shards.push_back({&attention, 2, bias, 0, qkv_ranges});
+  }
+  plan.sharded_outputs.push_back(attention.MutableOutputDefs()[0]);
+
+  Node* output_matmul = GetOnlyConsumer(graph, attention);
+  if (output_matmul == nullptr || !IsMatMul(*output_matmul) ||
+      output_matmul->GetExecutionProviderType() != attention.GetExecutionProviderType()) {
+    return false;
+  }
+  const TensorProto* output_weight = GetConstantWeight(graph, *output_matmul, 1, 2);
+  if (output_weight == nullptr || output_weight->dims(0) != hidden_size) {
+    return false;
+  }
+  plan.weight_shards.push_back(
+      {output_matmul, 1, output_weight, 0, {Range{rank * rank_hidden_size, (rank + 1) * rank_hidden_size}}});
+  plan.reduced_matmul = output_matmul;
+  return true;
+}
+
+// Replaces the initializer input of a node with its shard. The initializers are 1D or 2D.
+void ShardWeight(Graph& graph, const WeightShard& shard, int64_t rank) {
+  Initializer initializer{*shard.weight, graph.ModelPath()};
+  const auto dims = initializer.dims();
+  const auto data = initializer.DataAsByteSpan();
+  const size_t element_size = data.size() / static_cast<size_t>(initializer.size());
+
+  // the weight is viewed as (outer, axis dim, inner)
+  const int64_t outer = shard.axis == 0 ? 1 : dims[0];
+  const int64_t axis_dim = dims[shard.axis];
+  const int64_t inner = shard.axis == 0 && dims.size() == 2 ? dims[1] : 1;
+
+  int64_t shard_dim = 0;
+  for (const auto& range : shard.ranges) {
+    shard_dim += range.second - range.first;
+  }
+
+  std::vector<uint8_t> shard_data;
+  shard_data.reserve(static_cast<size_t>(outer * shard_dim * inner) * element_size);
+  for (int64_t i = 0; i < outer; ++i) {
+    for (const auto& range : shard.ranges) {
+      const auto begin = data.begin() + static_cast<size_t>((i * axis_dim + range.first) * inner) * element_size;
+      const auto end = begin + static_cast<size_t>((range.second - range.first) * inner) * element_size;
+      shard_data.insert(shard_data.end(), begin, end);
+    }
+  }
+
+  TensorProto shard_proto;
+  shard_proto.set_name(graph.GenerateNodeArgName(shard.weight->name() + "_rank_" + std::to_string(rank)));
+  shard_proto.set_data_type(shard.weight->data_type());
+  for (size_t i = 0; i < dims.size(); ++i) {
+    shard_proto.add_dims(static_cast<int>(i) == shard.axis ? shard_dim : dims[i]);
+  }
+  shard_proto.set_raw_data(shard_data.data(), shard_data.size());
+
+  NodeArg& shard_arg = graph_utils::AddInitializer(graph, shard_proto);
+  graph_utils::ReplaceNodeInput(*shard.node, shard.input_index, shard_arg);
+}
+
+// Inserts an AllReduce that sums the partial results of the ranks computed by a MatMul.
+void InsertAllReduce(Graph& graph, Node& matmul) {
+  NodeArg* output = matmul.MutableOutputDefs()[0];
+  NodeArg& partial_output = graph.GetOrCreateNodeArg(graph.GenerateNodeArgName(output->Name() + "_partial"),
+                                                     output->TypeAsProto());
+
+  // the AllReduce takes over the consumers of the MatMul output
+  const auto output_edges = graph_utils::GraphEdge::GetNodeOutputEdges(matmul);
+  graph_utils::GraphEdge::RemoveGraphEdges(graph, output_edges);
+  matmul.MutableOutputDefs()[0] = &partial_output;
+
+  Node& all_reduce = graph.AddNode(graph.GenerateNodeName("AllReduce"), "AllReduce",
+                                   "Sum of the tensor parallel partial results", {&partial_output}, {output},
+                                   nullptr, kMSDomain);
+  all_reduce.SetExecutionProviderType(matmul.GetExecutionProviderType());
+
+  graph.UpdateProducerNode(partial_output.Name(), matmul.Index());
+  graph.UpdateProducerNode(output->Name(), all_reduce.Index());
+  graph.UpdateConsumerNodes(partial_output.Name(), {&all_reduce});
+  graph.AddEdge(matmul.Index(), all_reduce.Index(), 0, 0);
+  for (const auto& edge : output_edges) {
+    graph.AddEdge(all_reduce.Index(), edge.dst_node, 0, edge.dst_arg_index);
+  }
+}
+
+}  // namespace
+
+Status TensorParallelTransformer::ApplyImpl(Graph& graph, bool& modified, int graph_level,
+                                            const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+
+  for (auto node_index : node_topology_list) {
+    auto* p_node = graph.GetNode(node_index);
+    if (p_node == nullptr) {
+      continue;
+    }
+
+    Node& node = *p_node;
+    ORT_RETURN_IF_ERROR(Recurse(node, modified, graph_level, logger));
+
+    if (!graph_utils::IsSupportedProvider(node, GetCompatibleExecutionProviders())) {
+      continue;
+    }
+
+    ShardPlan plan;
+    if (IsMatMul(node)) {
+      if (!MatchMlp(graph, node, world_size_, rank_, plan)) {
+        continue;
+      }
+    } else if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "Attention", {1}, kMSDomain)) {
+      if (!MatchAttention(graph, node, world_size_, rank_, plan)) {
+        continue;
+      }
+      const int64_t num_heads = graph_utils::GetNodeAttribute(node, "num_heads")->i();
+      node.AddAttribute("num_heads", num_heads / world_size_);
+    } else {
+      continue;
+    }
+
+    for (const auto& weight_shard : plan.weight_shards) {
+      ShardWeight(graph, weight_shard, rank_);
+    }
+    // the shapes are inferred again when the graph is resolved
+    for (NodeArg* sharded_output : plan.sharded_outputs) {
+      sharded_output->ClearShape();
+    }
+    InsertAllReduce(graph, *plan.reduced_matmul);
+
+    LOGS(logger, VERBOSE) << "Sharded the weights of " << node.OpType() << " node " << node.Name() << " for rank "
+                          << rank_ << " of " << world_size_;
+    modified = true;
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
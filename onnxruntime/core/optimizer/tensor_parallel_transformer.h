@@ -0,0 +1,45 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class TensorParallelTransformer
+
+Transformer that shards the weights of a model for the tensor parallel inference of one rank, Megatron style, so that
+a model too large for one GPU runs with one session per GPU. The sessions of all the ranks run the same model and the
+partial results are summed with the AllReduce collective op.
+
+Two patterns are sharded:
+
+  MLP: MatMul(X, W1) -> [Add(B1)] -> activation -> MatMul(W2)
+    W1 and B1 are split by columns and W2 by rows, and an AllReduce is inserted after the second MatMul.
+    The activation is one of Gelu, FastGelu, BiasGelu, QuickGelu, Relu, Sigmoid and Tanh.
+
+  Attention: Attention(X, W_qkv, B_qkv, ...) -> MatMul(W_out)
+    The heads are split between the ranks: the query, key and value columns of W_qkv and B_qkv of the heads of the
+    rank are kept, num_heads is divided by the world size, W_out is split by rows, and an AllReduce is inserted after
+    the MatMul.
+
+The other weights, e.g. the embeddings, are replicated.
+*/
+class TensorParallelTransformer : public GraphTransformer {
+ public:
+  TensorParallelTransformer(int64_t world_size, int64_t rank,
+                            const InlinedHashSet<std::string_view>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("TensorParallelTransformer", compatible_execution_providers),
+        world_size_(world_size),
+        rank_(rank) {}
+
+ private:
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+
+  const int64_t world_size_;
+  const int64_t rank_;
+};
+
+}  // namespace onnxruntime
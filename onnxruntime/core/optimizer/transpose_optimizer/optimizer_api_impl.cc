@@ -910,6 +910,40 @@ PostLayoutTransformCostCheck(const api::GraphRef& graph, const api::NodeRef& nod
   return OrtEPCostCheck(graph, node, perm, outputs_leading_to_transpose);
 }
 
+// The CUDA EP has kernels in the internal NHWC domain for a subset of the layout sensitive ops, which do not support
+// all of their attributes. Other nodes are left in NCHW layout.
+static bool IsNhwcSupportedByCuda(const api::NodeRef& node, size_t rank) {
+  if (node.Domain() != kOnnxDomain || rank != 4) {
+    return false;
+  }
+
+  const auto op_type = node.OpType();
+  if (op_type == "Conv" || op_type == "BatchNormalization" || op_type == "AveragePool" ||
+      op_type == "GlobalAveragePool" || op_type == "GlobalMaxPool") {
+    return true;
+  }
+
+  if (op_type == "MaxPool") {
+    // the indices output and dilations require MaxPoolWithIndex, which only handles NCHW
+    const auto dilations = node.GetAttributeInts("dilations");
+    const bool default_dilations = !dilations.has_value() ||
+                                   std::all_of(dilations->begin(), dilations->end(), [](int64_t d) { return d == 1; });
+    return node.Outputs().size() == 1 && default_dilations;
+  }
+
+  if (op_type == "Resize") {
+    // the nearest and linear modes handle scales for the spatial dims of NHWC input. The ROI is not permuted.
+    const auto mode = node.GetAttributeString("mode");
+    const auto coordinate_transformation_mode = node.GetAttributeString("coordinate_transformation_mode");
+    return node.SinceVersion() >= 11 &&
+           (!mode.has_value() || *mode == "nearest" || *mode == "linear") &&
+           coordinate_transformation_mode != "tf_crop_and_resize" &&
+           node.GetAttributeIntDefault("antialias", 0) == 0;
+  }
+
+  return false;
+}
+
 Status TransformLayoutForEP(Graph& graph, bool& modified, const IExecutionProvider& execution_provider,
                             AllocatorPtr cpu_allocator, const DebugGraphFn& debug_graph_fn) {
   auto api_graph = MakeApiGraph(graph, cpu_allocator, nullptr);
@@ -946,6 +980,10 @@ Status TransformLayoutForEP(Graph& graph, bool& modified, const IExecutionProvid
       // Convert to channels last
       size_t rank = shape->size();
 
+      if (execution_provider.Type() == kCudaExecutionProvider && !IsNhwcSupportedByCuda(*node, rank)) {
+        continue;
+      }
+
       bool has_channel_last_attr = node->GetAttributeInt("channels_last").has_value() ? true : false;
       if (has_channel_last_attr) {
         node->SetAttributeInt("channels_last", 1);
@@ -91,6 +91,30 @@ struct ThreadOptions {
   void* custom_thread_creation_options = nullptr;
   OrtCustomJoinThreadFn custom_join_thread_fn = nullptr;
   int dynamic_block_base_ = 0;
+
+  // If the vector is not empty, numa_nodes[i] is the NUMA node that the processors in affinities[i] belong to,
+  // or -1 if they don't belong to a single node. The thread pool uses it to keep work on the node it comes from.
+  std::vector<int> numa_nodes;
+
+  // If true, ParallelFor measures how long its loops take and picks the number of shards of a loop from the
+  // measurements instead of the cost passed by the caller. See concurrency::ParallelForCalibration.
+  bool parallel_for_calibration = false;
+
+  // If not empty, the calibration measurements are loaded from this file and saved to it when the pool is destroyed.
+  PathString parallel_for_calibration_file;
+
+  // If true and the CPU has cores of different performance, the blocks of iterations that a parallel loop hands
+  // to a thread are scaled by the capacity of the core the thread runs on, and the threads bound to efficiency cores
+  // do not spin. See CPUIDInfo::GetCoreCapacity.
+  bool heterogeneous_scheduling = false;
+
+  // If true, idle threads spin for a window that follows the recent time between parallel sections instead of a
+  // fixed number of iterations. Ignored if spinning is not allowed.
+  bool adaptive_spinning = false;
+
+  // Set by the thread pool in heterogeneous scheduling mode: efficiency_cores[i] tells whether affinities[i] only
+  // contains efficiency cores.
+  std::vector<bool> efficiency_cores;
 };
 
 std::ostream& operator<<(std::ostream& os, const LogicalProcessors&);
@@ -141,6 +165,13 @@ class Env {
 
   virtual std::vector<LogicalProcessors> GetDefaultThreadAffinities() const = 0;
 
+  /// \brief Returns the logical processors of each NUMA node of the system, indexed by node number.
+  /// Returns an empty vector if the information is not available.
+  virtual std::vector<LogicalProcessors> GetNumaNodes() const { return {}; }
+
+  /// \brief Returns the NUMA node of the processor that the calling thread runs on, or -1 if it is unknown.
+  virtual int GetCurrentNumaNode() const { return -1; }
+
   /// \brief Returns the number of micro-seconds since the Unix epoch.
   virtual uint64_t NowMicros() const {
     return env_time_->NowMicros();
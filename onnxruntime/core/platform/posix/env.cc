@@ -29,8 +29,10 @@ limitations under the License.
 #include <sys/syscall.h>
 #include <unistd.h>
 
+#include <fstream>
 #include <iostream>
 #include <optional>
+#include <sstream>
 #include <thread>
 #include <utility>  // for std::forward
 #include <vector>
@@ -48,6 +50,7 @@ limitations under the License.
 #include "core/common/logging/logging.h"
 #include "core/common/narrow.h"
 #include "core/platform/scoped_resource.h"
+#include "core/platform/posix/sysfs_utils.h"
 #include "core/platform/EigenNonBlockingThreadPool.h"
 
 namespace onnxruntime {
@@ -344,6 +347,37 @@ class PosixEnv : public Env {
     return ret;
   }
 
+  std::vector<LogicalProcessors> GetNumaNodes() const override {
+    std::vector<LogicalProcessors> ret;
+#if defined(__linux__)
+    std::string online;
+    if (!sysfs_utils::ReadLine("/sys/devices/system/node/online", online)) {
+      return ret;
+    }
+    for (int node : sysfs_utils::ParseIdList(online)) {
+      if (static_cast<size_t>(node) >= ret.size()) {
+        ret.resize(static_cast<size_t>(node) + 1);
+      }
+      std::string cpu_list;
+      if (sysfs_utils::ReadLine("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist", cpu_list)) {
+        ret[node] = sysfs_utils::ParseIdList(cpu_list);
+      }
+    }
+#endif
+    return ret;
+  }
+
+  int GetCurrentNumaNode() const override {
+#if defined(__linux__) && defined(SYS_getcpu)
+    unsigned cpu = 0;
+    unsigned node = 0;
+    if (syscall(SYS_getcpu, &cpu, &node, nullptr) == 0) {
+      return static_cast<int>(node);
+    }
+#endif
+    return -1;
+  }
+
   void SleepForMicroseconds(int64_t micros) const override {
     while (micros > 0) {
       timespec sleep_time;
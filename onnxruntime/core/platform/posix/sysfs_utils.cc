@@ -0,0 +1,40 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/platform/posix/sysfs_utils.h"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+namespace onnxruntime {
+namespace sysfs_utils {
+
+std::vector<int> ParseIdList(const std::string& id_list) {
+  std::vector<int> ids;
+  std::istringstream ss(id_list);
+  std::string range;
+  while (std::getline(ss, range, ',')) {
+    int from = 0;
+    int to = 0;
+    const int n = sscanf(range.c_str(), "%d-%d", &from, &to);
+    if (n == 1) {
+      to = from;
+    }
+    if (n < 1 || from < 0 || to < from) {
+      return {};
+    }
+    for (int id = from; id <= to; ++id) {
+      ids.push_back(id);
+    }
+  }
+  return ids;
+}
+
+bool ReadLine(const std::string& path, std::string& line) {
+  std::ifstream file(path);
+  return static_cast<bool>(std::getline(file, line));
+}
+
+}  // namespace sysfs_utils
+}  // namespace onnxruntime
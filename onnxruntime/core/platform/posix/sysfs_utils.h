@@ -0,0 +1,20 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace onnxruntime {
+namespace sysfs_utils {
+
+// Parses a list of ids in the format of the sysfs cpu and node lists, e.g. "0-3,8,10-11".
+// Returns an empty vector if the list is malformed.
+std::vector<int> ParseIdList(const std::string& id_list);
+
+// Reads the first line of a sysfs file. Returns false if the file does not exist or is empty.
+bool ReadLine(const std::string& path, std::string& line);
+
+}  // namespace sysfs_utils
+}  // namespace onnxruntime
@@ -16,6 +16,7 @@ limitations under the License.
 
 #include "core/platform/windows/env.h"
 
+#include <algorithm>
 #include <iostream>
 #include <fstream>
 #include <optional>
@@ -260,6 +261,34 @@ std::vector<LogicalProcessors> WindowsEnv::GetDefaultThreadAffinities() const {
   return cores_.empty() ? std::vector<LogicalProcessors>(DefaultNumCores(), LogicalProcessors{}) : cores_;
 }
 
+std::vector<LogicalProcessors> WindowsEnv::GetNumaNodes() const {
+  ULONG highest_node = 0;
+  if (!GetNumaHighestNodeNumber(&highest_node)) {
+    return {};
+  }
+  std::vector<LogicalProcessors> ret(static_cast<size_t>(highest_node) + 1);
+  for (const auto& [global_processor_id, processor_info] : global_processor_info_map_) {
+    PROCESSOR_NUMBER processor_number{};
+    processor_number.Group = static_cast<WORD>(processor_info.group_id);
+    processor_number.Number = static_cast<BYTE>(processor_info.local_processor_id);
+    USHORT node = 0;
+    if (GetNumaProcessorNodeEx(&processor_number, &node) && node <= highest_node) {
+      ret[node].push_back(global_processor_id);
+    }
+  }
+  for (auto& node_processors : ret) {
+    std::sort(node_processors.begin(), node_processors.end());
+  }
+  return ret;
+}
+
+int WindowsEnv::GetCurrentNumaNode() const {
+  PROCESSOR_NUMBER processor_number{};
+  GetCurrentProcessorNumberEx(&processor_number);
+  USHORT node = 0;
+  return GetNumaProcessorNodeEx(&processor_number, &node) ? static_cast<int>(node) : -1;
+}
+
 WindowsEnv& WindowsEnv::Instance() {
   static WindowsEnv default_env;
   return default_env;
@@ -55,6 +55,8 @@ class WindowsEnv : public Env {
   static int DefaultNumCores();
   int GetNumPhysicalCpuCores() const override;
   std::vector<LogicalProcessors> GetDefaultThreadAffinities() const override;
+  std::vector<LogicalProcessors> GetNumaNodes() const override;
+  int GetCurrentNumaNode() const override;
   static WindowsEnv& Instance();
   PIDType GetSelfPid() const override;
   Status GetFileLength(_In_z_ const ORTCHAR_T* file_path, size_t& length) const override;
@@ -2,12 +2,15 @@
 // Licensed under the MIT License.
 
 #include <fstream>
+#include <iomanip>
 #include <core/common/safeint.h>
 
 #include "model_builder.h"
 #include "helper.h"
 #include "op_builder_factory.h"
 
+#include "core/common/gsl.h"
+#include "core/framework/murmurhash3.h"
 #include "core/providers/common.h"
 #include "core/providers/coreml/model/model.h"
 #include "core/providers/coreml/model/host_utils.h"
@@ -228,7 +231,7 @@ Status ModelBuilder::RegisterModelOutputs() {
 
 Status ModelBuilder::Compile(std::unique_ptr<Model>& model, const std::string& path) {
   ORT_RETURN_IF_ERROR(SaveCoreMLModel(path));
-  model.reset(new Model(path, logger_, coreml_flags_));
+  model.reset(new Model(path, coreml_model_hash_, logger_, coreml_flags_));
   model->SetScalarOutputs(std::move(scalar_outputs_));
   model->SetInt64Outputs(std::move(int64_outputs_));
   model->SetInputOutputInfo(std::move(input_output_info_));
@@ -237,8 +240,22 @@ Status ModelBuilder::Compile(std::unique_ptr<Model>& model, const std::string& p
 
 Status ModelBuilder::SaveCoreMLModel(const std::string& path) {
   ORT_RETURN_IF_ERROR(Initialize());
+  std::string serialized_model;
+  ORT_RETURN_IF_NOT(coreml_model_->SerializeToString(&serialized_model), "Serialize the CoreML model failed");
+
+  {
+    uint32_t hash[4] = {0, 0, 0, 0};
+    MurmurHash3::x86_128(serialized_model.data(), gsl::narrow_cast<int32_t>(serialized_model.size()), hash[0], &hash);
+    std::ostringstream hash_stream;
+    for (const auto part : hash) {
+      hash_stream << std::hex << std::setw(8) << std::setfill('0') << part;
+    }
+    coreml_model_hash_ = hash_stream.str();
+  }
+
   std::ofstream stream(path, std::ofstream::out | std::ofstream::binary);
-  ORT_RETURN_IF_NOT(coreml_model_->SerializeToOstream(&stream), "Save the CoreML model failed");
+  ORT_RETURN_IF_NOT(stream.write(serialized_model.data(), static_cast<std::streamsize>(serialized_model.size())),
+                    "Save the CoreML model failed");
 
   // TODO, Delete, debug only
   if (const char* path = std::getenv("ORT_COREML_EP_CONVERTED_MODEL_PATH")) {
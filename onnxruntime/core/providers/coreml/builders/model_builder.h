@@ -44,6 +44,8 @@ class ModelBuilder {
   uint32_t coreml_flags_;
 
   std::unique_ptr<CoreML::Specification::Model> coreml_model_;
+  // Hex string of the hash of the serialized coreml_model_, used as the key of the compiled model cache
+  std::string coreml_model_hash_;
   std::unordered_set<std::string> scalar_outputs_;
   std::unordered_set<std::string> int64_outputs_;
   std::unordered_map<std::string, OnnxTensorInfo> input_output_info_;
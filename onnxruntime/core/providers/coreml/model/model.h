@@ -59,7 +59,9 @@ class Model {
 
   OrtMutex mutex_;
 
-  Model(const std::string& path, const logging::Logger& logger, uint32_t coreml_flags);
+  // model_hash identifies the CoreML model at path, it is the key of the compiled model cache
+  Model(const std::string& path, const std::string& model_hash, const logging::Logger& logger,
+        uint32_t coreml_flags);
   onnxruntime::common::Status LoadModel();
 
   void SetInputOutputInfo(std::unordered_map<std::string, OnnxTensorInfo>&& input_output_info) {
@@ -39,17 +39,22 @@ asm(".linker_option \"-framework\", \"CoreML\"");
 // Execution for a CoreML model, it performs
 // 1. Compile the model by given path for execution
 // 2. Predict using given OnnxTensorFeatureProvider input and copy the output data back ORT
-// 3. The compiled model will be removed in dealloc or removed using cleanup function
+// 3. The compiled model will be removed in dealloc or removed using cleanup function, unless it is kept
+//    in the compiled model cache (COREML_FLAG_ENABLE_COMPILED_MODEL_CACHE)
 @interface CoreMLExecution : NSObject {
   NSString* coreml_model_path_;
+  NSString* coreml_model_hash_;
   NSString* compiled_model_path_;
   const onnxruntime::logging::Logger* logger_;
   uint32_t coreml_flags_;
 }
 
 - (instancetype)initWithPath:(const std::string&)path
+                  model_hash:(const std::string&)model_hash
                       logger:(const onnxruntime::logging::Logger&)logger
                 coreml_flags:(uint32_t)coreml_flags;
+- (NSURL*)cachedCompiledModelURL;
+- (onnxruntime::common::Status)compileModel:(NSURL**)compiledUrl;
 - (void)cleanup;
 - (void)dealloc;
 - (onnxruntime::common::Status)loadModel API_AVAILABLE_OS_VERSIONS;
@@ -140,10 +145,12 @@ asm(".linker_option \"-framework\", \"CoreML\"");
 @implementation CoreMLExecution
 
 - (instancetype)initWithPath:(const std::string&)path
+                  model_hash:(const std::string&)model_hash
                       logger:(const onnxruntime::logging::Logger&)logger
                 coreml_flags:(uint32_t)coreml_flags {
   if (self = [super init]) {
     coreml_model_path_ = [NSString stringWithUTF8String:path.c_str()];
+    coreml_model_hash_ = [NSString stringWithUTF8String:model_hash.c_str()];
     logger_ = &logger;
     coreml_flags_ = coreml_flags;
   }
@@ -176,23 +183,94 @@ asm(".linker_option \"-framework\", \"CoreML\"");
   [self cleanup];
 }
 
-- (onnxruntime::common::Status)loadModel {
+// The compiled model cache lives in the caches directory of the app, which the OS may purge when the device is
+// low on storage. The key contains the OS build since a model compiled by one version of CoreML is not guaranteed
+// to be loadable by another.
+- (NSURL*)cachedCompiledModelURL {
+  NSError* error = nil;
+  NSURL* caches_url = [[NSFileManager defaultManager] URLForDirectory:NSCachesDirectory
+                                                             inDomain:NSUserDomainMask
+                                                    appropriateForURL:nil
+                                                               create:YES
+                                                                error:&error];
+  if (error != nil) {
+    LOGS(*logger_, WARNING) << "Failed to get the caches directory, the compiled model will not be cached: "
+                            << [[error localizedDescription] UTF8String];
+    return nil;
+  }
+
+  NSURL* cache_dir_url = [caches_url URLByAppendingPathComponent:@"onnxruntime-coreml" isDirectory:YES];
+  [[NSFileManager defaultManager] createDirectoryAtURL:cache_dir_url
+                           withIntermediateDirectories:YES
+                                            attributes:nil
+                                                 error:&error];
+  if (error != nil) {
+    LOGS(*logger_, WARNING) << "Failed to create the compiled model cache directory: "
+                            << [[error localizedDescription] UTF8String];
+    return nil;
+  }
+
+  NSString* os_build = [[NSProcessInfo processInfo] operatingSystemVersionString];
+  NSCharacterSet* separators = [[NSCharacterSet alphanumericCharacterSet] invertedSet];
+  NSString* os_key = [[os_build componentsSeparatedByCharactersInSet:separators] componentsJoinedByString:@""];
+  NSString* name = [NSString stringWithFormat:@"%@_%@.mlmodelc", coreml_model_hash_, os_key];
+  return [cache_dir_url URLByAppendingPathComponent:name isDirectory:YES];
+}
+
+- (onnxruntime::common::Status)compileModel:(NSURL**)compiledUrl {
   NSError* error = nil;
   NSURL* modelUrl = [NSURL URLWithString:coreml_model_path_];
   NSAssert(modelUrl != nil, @"modelUrl must not be nil");
-  NSURL* compileUrl = [MLModel compileModelAtURL:modelUrl error:&error];
+  *compiledUrl = [MLModel compileModelAtURL:modelUrl error:&error];
 
   if (error != nil) {
     return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Error compiling model ",
                            [[error localizedDescription] cStringUsingEncoding:NSUTF8StringEncoding]);
   }
 
-  compiled_model_path_ = [compileUrl path];
+  return onnxruntime::common::Status::OK();
+}
 
+- (onnxruntime::common::Status)loadModel {
+  NSError* error = nil;
   MLModelConfiguration* config = [MLModelConfiguration alloc];
   config.computeUnits = (coreml_flags_ & COREML_FLAG_USE_CPU_ONLY)
                             ? MLComputeUnitsCPUOnly
                             : MLComputeUnitsAll;
+  config.allowLowPrecisionAccumulationOnGPU = (coreml_flags_ & COREML_FLAG_ALLOW_LOW_PRECISION_ACCUMULATION_ON_GPU)
+                                                  ? YES
+                                                  : NO;
+
+  NSURL* cachedUrl = (coreml_flags_ & COREML_FLAG_ENABLE_COMPILED_MODEL_CACHE) ? [self cachedCompiledModelURL] : nil;
+  if (cachedUrl != nil && [[NSFileManager defaultManager] fileExistsAtPath:[cachedUrl path]]) {
+    _model = [MLModel modelWithContentsOfURL:cachedUrl configuration:config error:&error];
+    if (error == nil) {
+      LOGS(*logger_, VERBOSE) << "Loaded the compiled model from the cache: " << [[cachedUrl path] UTF8String];
+      return onnxruntime::common::Status::OK();
+    }
+
+    // A stale or partially written entry, compile the model again and replace it
+    LOGS(*logger_, WARNING) << "Failed to load the cached compiled model, it will be compiled again: "
+                            << [[error localizedDescription] UTF8String];
+    error = nil;
+    [[NSFileManager defaultManager] removeItemAtURL:cachedUrl error:nil];
+  }
+
+  NSURL* compileUrl = nil;
+  ORT_RETURN_IF_ERROR([self compileModel:&compileUrl]);
+  compiled_model_path_ = [compileUrl path];
+
+  // Move the compiled model into the cache. The move is atomic within a volume, so a concurrent session of the same
+  // model either finds a complete entry or fails to move and keeps its own temporary copy.
+  if (cachedUrl != nil &&
+      [[NSFileManager defaultManager] moveItemAtURL:compileUrl toURL:cachedUrl error:&error]) {
+    compileUrl = cachedUrl;
+    compiled_model_path_ = nil;
+  } else if (error != nil) {
+    LOGS(*logger_, VERBOSE) << "The compiled model is not cached: " << [[error localizedDescription] UTF8String];
+    error = nil;
+  }
+
   _model = [MLModel modelWithContentsOfURL:compileUrl configuration:config error:&error];
 
   if (error != NULL) {
@@ -301,7 +379,8 @@ namespace coreml {
 // This class will bridge Model (c++) with CoreMLExecution (objective c++)
 class Execution {
  public:
-  Execution(const std::string& path, const logging::Logger& logger, uint32_t coreml_flags);
+  Execution(const std::string& path, const std::string& model_hash, const logging::Logger& logger,
+            uint32_t coreml_flags);
   ~Execution(){};
 
   Status LoadModel();
@@ -313,9 +392,11 @@ class Execution {
   CoreMLExecution* execution_;
 };
 
-Execution::Execution(const std::string& path, const logging::Logger& logger, uint32_t coreml_flags) {
+Execution::Execution(const std::string& path, const std::string& model_hash, const logging::Logger& logger,
+                     uint32_t coreml_flags) {
   @autoreleasepool {
     execution_ = [[CoreMLExecution alloc] initWithPath:path
+                                            model_hash:model_hash
                                                 logger:logger
                                           coreml_flags:coreml_flags];
   }
@@ -351,8 +432,9 @@ Status Execution::Predict(const std::unordered_map<std::string, OnnxTensorData>&
   return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Execution::LoadModel requires macos 10.15+ or ios 13+ ");
 }
 
-Model::Model(const std::string& path, const logging::Logger& logger, uint32_t coreml_flags)
-    : execution_(std::make_unique<Execution>(path, logger, coreml_flags)) {
+Model::Model(const std::string& path, const std::string& model_hash, const logging::Logger& logger,
+             uint32_t coreml_flags)
+    : execution_(std::make_unique<Execution>(path, model_hash, logger, coreml_flags)) {
 }
 
 Model::~Model() {}
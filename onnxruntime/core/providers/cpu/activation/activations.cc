@@ -50,6 +50,11 @@ REGISTER_VERSIONED_UNARY_ELEMENTWISE_TYPED_KERNEL(Relu, 13, 13, MLFloat16);
 REGISTER_UNARY_ELEMENTWISE_TYPED_KERNEL(Relu, 14, MLFloat16);
 REGISTER_VERSIONED_UNARY_ELEMENTWISE_TYPED_KERNEL(LeakyRelu, 6, 15, MLFloat16);
 REGISTER_UNARY_ELEMENTWISE_TYPED_KERNEL(LeakyRelu, 16, MLFloat16);
+REGISTER_UNARY_ELEMENTWISE_TYPED_KERNEL(HardSigmoid, 6, MLFloat16);
+REGISTER_VERSIONED_UNARY_ELEMENTWISE_TYPED_KERNEL(Sigmoid, 6, 12, MLFloat16);
+REGISTER_UNARY_ELEMENTWISE_TYPED_KERNEL(Sigmoid, 13, MLFloat16);
+REGISTER_VERSIONED_UNARY_ELEMENTWISE_TYPED_KERNEL(Tanh, 6, 12, MLFloat16);
+REGISTER_UNARY_ELEMENTWISE_TYPED_KERNEL(Tanh, 13, MLFloat16);
 #endif  // MLAS_F16VEC_INTRINSICS_SUPPORTED
 
 REGISTER_UNARY_ELEMENTWISE_KERNEL(Selu, 6);
@@ -243,14 +243,17 @@ common::Status If::SetupSubgraphExecutionInfo(const SessionState& session_state,
 }
 
 Status If::Compute(OpKernelContext* ctx) const {
-  ORT_ENFORCE(then_feeds_fetches_manager_ && else_feeds_fetches_manager_,
-              "CreateFeedsFetchesManager must be called prior to execution of graph.");
-
   auto ctx_internal = static_cast<OpKernelContextInternal*>(ctx);
 
   auto condition = *ctx->Input<Tensor>(0)->Data<bool>();
 
   auto attribute = condition ? "then_branch" : "else_branch";
+  // with lazy subgraph initialization the branch is finalized, and SetupSubgraphExecutionInfo called for it,
+  // when it runs for the first time
+  ORT_RETURN_IF_ERROR(ctx_internal->FinalizeSubgraphSessionState(attribute));
+  ORT_ENFORCE(condition ? then_feeds_fetches_manager_ != nullptr : else_feeds_fetches_manager_ != nullptr,
+              "CreateFeedsFetchesManager must be called prior to execution of graph.");
+
   auto* session_state = ctx_internal->SubgraphSessionState(attribute);
   ORT_ENFORCE(session_state, "Subgraph SessionState was not found for '", attribute, "' attribute.");
 
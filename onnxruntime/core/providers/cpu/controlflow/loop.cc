@@ -25,6 +25,10 @@
 
 #include "core/common/gsl.h"
 
+#include <algorithm>
+#include <array>
+#include <unordered_map>
+
 #ifdef _MSC_VER
 #pragma warning(pop)
 #endif
@@ -183,6 +187,94 @@ Loop::Info::Info(const onnxruntime::Node& node, const GraphViewer& subgraph_in)
   }
 }
 
+namespace {
+
+// true if the tensors of a and b have the same shape in every Run, i.e. the same dim_value or dim_param in every
+// dimension
+bool HaveSameShape(const NodeArg& a, const NodeArg& b) {
+  const auto* a_type = a.TypeAsProto();
+  const auto* b_type = b.TypeAsProto();
+  if (a_type == nullptr || b_type == nullptr || !a_type->has_tensor_type() || !b_type->has_tensor_type() ||
+      a_type->tensor_type().elem_type() != b_type->tensor_type().elem_type()) {
+    return false;
+  }
+
+  const auto* a_shape = a.Shape();
+  const auto* b_shape = b.Shape();
+  if (a_shape == nullptr || b_shape == nullptr || a_shape->dim_size() != b_shape->dim_size()) {
+    return false;
+  }
+
+  for (int i = 0, end = a_shape->dim_size(); i < end; ++i) {
+    const auto& a_dim = a_shape->dim(i);
+    const auto& b_dim = b_shape->dim(i);
+    if (a_dim.has_dim_value() && b_dim.has_dim_value()) {
+      if (a_dim.dim_value() != b_dim.dim_value()) {
+        return false;
+      }
+    } else if (!a_dim.has_dim_param() || !b_dim.has_dim_param() || a_dim.dim_param().empty() ||
+               a_dim.dim_param() != b_dim.dim_param()) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// A loop carried var can be double buffered if the buffer the subgraph writes it to is not referenced by anything
+// that outlives the next iteration: its output must be allocated by the subgraph, and no subgraph output may be
+// (or share the buffer of) its input, as the Loop keeps the scan outputs of every iteration.
+std::vector<bool> FindDoubleBufferedLoopCarriedVars(const Loop::Info& info,
+                                                    const SessionState& subgraph_session_state) {
+  std::vector<bool> double_buffered(info.num_loop_carried_vars, false);
+
+  const auto& subgraph_inputs = info.subgraph.GetInputs();
+  const auto& subgraph_outputs = info.subgraph.GetOutputs();
+  const auto& name_to_idx = subgraph_session_state.GetOrtValueNameIdxMap();
+  const auto& alloc_plan = subgraph_session_state.GetExecutionPlan()->allocation_plan;
+
+  auto get_buffer_owner = [&alloc_plan](int idx) {
+    for (size_t i = 0; i < alloc_plan.size() && (alloc_plan[idx].alloc_kind == AllocKind::kReuse ||
+                                                 alloc_plan[idx].alloc_kind == AllocKind::kShare);
+         ++i) {
+      idx = alloc_plan[idx].reused_buffer;
+    }
+    return idx;
+  };
+
+  std::vector<int> output_buffer_owners;
+  std::unordered_map<int, int> output_counts;
+  for (const auto* output : subgraph_outputs) {
+    int idx;
+    if (!name_to_idx.GetIdx(output->Name(), idx).IsOK()) {
+      return double_buffered;
+    }
+    output_buffer_owners.push_back(get_buffer_owner(idx));
+    ++output_counts[idx];
+  }
+
+  for (int i = 0; i < info.num_loop_carried_vars; ++i) {
+    // skip iter_num and cond in the subgraph inputs, and cond in the subgraph outputs
+    const NodeArg& input = *subgraph_inputs[static_cast<size_t>(i) + 2];
+    const NodeArg& output = *subgraph_outputs[static_cast<size_t>(i) + 1];
+    int input_idx, output_idx;
+    if (!HaveSameShape(input, output) ||
+        !name_to_idx.GetIdx(input.Name(), input_idx).IsOK() ||
+        !name_to_idx.GetIdx(output.Name(), output_idx).IsOK() ||
+        alloc_plan[output_idx].alloc_kind != AllocKind::kAllocateOutput ||
+        output_counts[output_idx] != 1 ||
+        std::find(output_buffer_owners.begin(), output_buffer_owners.end(), input_idx) !=
+            output_buffer_owners.end()) {
+      continue;
+    }
+    double_buffered[i] = true;
+  }
+
+  return double_buffered;
+}
+
+}  // namespace
+
 class LoopImpl {
  public:
   LoopImpl(OpKernelContextInternal& context,
@@ -200,6 +292,8 @@ class LoopImpl {
  private:
   void CreateInitialFeeds(std::vector<OrtValue>& feeds);
   void SaveOutputsAndUpdateFeeds(const std::vector<OrtValue>& last_outputs, std::vector<OrtValue>& next_inputs);
+  // provide the buffers the double buffered loop carried vars are written to in this iteration
+  void SetLoopCarriedVarFetches(const std::vector<OrtValue>& feeds, std::vector<OrtValue>& fetches);
 
   // create the single Loop output from a collection of per-iteration outputs
   Status ConcatenateLoopOutput(std::vector<OrtValue>& per_iteration_output, int output_index);
@@ -220,6 +314,9 @@ class LoopImpl {
   // the order from the subgraph matches the order from the loop output
   std::vector<std::vector<OrtValue>> loop_output_tensors_;
 
+  // the two buffers of each double buffered loop carried var. iteration N writes to buffer N % 2.
+  std::vector<std::array<OrtValue, 2>> loop_carried_var_buffers_;
+
   const Loop::ConcatOutput& concat_output_func_;
 };
 
@@ -280,6 +377,7 @@ common::Status Loop::SetupSubgraphExecutionInfo(const SessionState& session_stat
 
   const auto& node = Node();
   info_ = std::make_unique<Loop::Info>(node, subgraph_session_state.GetGraphViewer());
+  info_->double_buffered_loop_carried_vars = FindDoubleBufferedLoopCarriedVars(*info_, subgraph_session_state);
 
   // the Loop inputs are matched to subgraph feeds based on order.
   // we first need the names of the Loop inputs to determine what device they are available on
@@ -421,6 +519,7 @@ Status LoopImpl::Initialize() {
   condition_mlvalue_ = MakeScalarMLValue<bool>(cpu_allocator, condition_, condition_rank != 0);
 
   loop_output_tensors_.resize(static_cast<size_t>(info_.num_outputs) - info_.num_loop_carried_vars);
+  loop_carried_var_buffers_.resize(info_.num_loop_carried_vars);
 
   return status;
 }
@@ -460,6 +559,34 @@ void LoopImpl::SaveOutputsAndUpdateFeeds(const std::vector<OrtValue>& last_outpu
   }
 }
 
+void LoopImpl::SetLoopCarriedVarFetches(const std::vector<OrtValue>& feeds, std::vector<OrtValue>& fetches) {
+  const auto iter_num = *iter_num_mlvalue_.Get<Tensor>().Data<int64_t>();
+
+  for (int i = 0; i < info_.num_loop_carried_vars; ++i) {
+    // +2 to skip iter_num and cond in the feeds
+    const OrtValue& input = feeds[static_cast<size_t>(i) + 2];
+    if (!info_.double_buffered_loop_carried_vars[i] || !input.IsTensor()) {
+      continue;
+    }
+
+    const auto& input_tensor = input.Get<Tensor>();
+    OrtValue& buffer = loop_carried_var_buffers_[i][iter_num % 2];
+    if (!buffer.IsAllocated() || buffer.Get<Tensor>().Shape() != input_tensor.Shape()) {
+      auto allocator = session_state_.GetAllocator(input_tensor.Location().device);
+      if (!allocator) {
+        continue;
+      }
+      Tensor::InitOrtValue(input_tensor.DataType(), input_tensor.Shape(), std::move(allocator), buffer);
+    }
+
+    if (fetches.empty()) {
+      fetches.resize(info_.num_subgraph_outputs);
+    }
+    // +1 to skip cond in the subgraph outputs
+    fetches[static_cast<size_t>(i) + 1] = buffer;
+  }
+}
+
 Status LoopImpl::ConcatenateLoopOutput(std::vector<OrtValue>& per_iteration_output, int output_index) {
   const auto& first_output = per_iteration_output.front().Get<Tensor>();
   const auto& per_iteration_dims = first_output.Shape().GetDims();
@@ -496,6 +623,8 @@ Status LoopImpl::Execute(const FeedsFetchesManager& ffm) {
       fetches.clear();
     }
 
+    SetLoopCarriedVarFetches(feeds, fetches);
+
     status = utils::ExecuteSubgraph(session_state_, ffm, feeds, fetches, {},
                                     ExecutionMode::ORT_SEQUENTIAL, context_.GetTerminateFlag(), context_.Logger(),
                                     context_.GetComputeStream(),
@@ -38,6 +38,11 @@ class Loop : public controlflow::IControlFlowKernel {
     std::vector<std::string> subgraph_output_names;
 
     std::vector<const ONNX_NAMESPACE::TypeProto*> loop_carried_vars_types;
+
+    // loop carried vars that keep their shape across iterations and whose subgraph output has a buffer of its own.
+    // the subgraph writes them into one of two buffers, alternating between iterations, instead of allocating
+    // a new buffer in every iteration.
+    std::vector<bool> double_buffered_loop_carried_vars;
   };
 
   // function to concatenate the OrtValue instances from each Loop iteration into a single output buffer.
@@ -11,6 +11,8 @@ namespace onnxruntime {
 // Information needed to construct CPU execution providers.
 struct CPUExecutionProviderInfo {
   bool create_arena{true};
+  // back the large buffers of the allocator with huge pages, see AllocatorHugePageAlloc
+  bool use_huge_pages{false};
 
   explicit CPUExecutionProviderInfo(bool use_arena)
       : create_arena(use_arena) {}
@@ -71,11 +71,84 @@ struct LeakyRelu<MLFloat16> : public ElementWiseRangedTransform<MLFloat16> {
   }
 };
 
-// TODO Add the following activations:
-//    MlasTanhActivation,
-//    MlasLogisticActivation,
-//    MlasClipActivation,
-//    MlasHardSigmoidActivation,
+template <>
+struct Sigmoid<MLFloat16> : public ElementWiseRangedTransform<MLFloat16> {
+  MLAS_ACTIVATION Activation;
+  Status Init(const onnxruntime::NodeAttributes&) {
+    Activation.ActivationKind = MlasLogisticActivation;
+    return Status::OK();
+  }
+  GSL_SUPPRESS(r .11)
+  ElementWiseRangedTransform<MLFloat16>* Copy() const final {
+    using T1 = typename std::remove_pointer<decltype(this)>::type;
+    using T2 = typename std::remove_const<T1>::type;
+    return new T2(*this);
+  }
+  float Cost() const final {
+    return 2.0f;
+  }
+  void operator()(std::ptrdiff_t first, std::ptrdiff_t last) const final {
+    ptrdiff_t len = last - first;
+    MLFloat16* output_ptr = this->output + first;
+    const MLFloat16* input_ptr = this->input + first;
+    memcpy(output_ptr, input_ptr, len * sizeof(MLFloat16));
+
+    MlasFp16Activation(&Activation, output_ptr, 1, len, len);
+  }
+};
+
+template <>
+struct Tanh<MLFloat16> : public ElementWiseRangedTransform<MLFloat16> {
+  MLAS_ACTIVATION Activation;
+  Status Init(const onnxruntime::NodeAttributes&) {
+    Activation.ActivationKind = MlasTanhActivation;
+    return Status::OK();
+  }
+  GSL_SUPPRESS(r .11)
+  ElementWiseRangedTransform<MLFloat16>* Copy() const final {
+    using T1 = typename std::remove_pointer<decltype(this)>::type;
+    using T2 = typename std::remove_const<T1>::type;
+    return new T2(*this);
+  }
+  float Cost() const final {
+    return 1.0f;
+  }
+  void operator()(std::ptrdiff_t first, std::ptrdiff_t last) const final {
+    ptrdiff_t len = last - first;
+    MLFloat16* output_ptr = this->output + first;
+    const MLFloat16* input_ptr = this->input + first;
+    memcpy(output_ptr, input_ptr, len * sizeof(MLFloat16));
+
+    MlasFp16Activation(&Activation, output_ptr, 1, len, len);
+  }
+};
+
+template <>
+struct HardSigmoid<MLFloat16> : public ElementWiseRangedTransform<MLFloat16> {
+  MLAS_ACTIVATION Activation;
+  Status Init(const onnxruntime::NodeAttributes& attributes) {
+    Activation.ActivationKind = MlasHardSigmoidActivation;
+    ORT_RETURN_IF_ERROR(GetFloatParam("alpha", attributes, Activation.Parameters.HardSigmoid.alpha));
+    return GetFloatParam("beta", attributes, Activation.Parameters.HardSigmoid.beta);
+  }
+  GSL_SUPPRESS(r .11)
+  ElementWiseRangedTransform<MLFloat16>* Copy() const final {
+    using T1 = typename std::remove_pointer<decltype(this)>::type;
+    using T2 = typename std::remove_const<T1>::type;
+    return new T2(*this);
+  }
+  float Cost() const final {
+    return 0.5f;
+  }
+  void operator()(std::ptrdiff_t first, std::ptrdiff_t last) const final {
+    ptrdiff_t len = last - first;
+    MLFloat16* output_ptr = this->output + first;
+    const MLFloat16* input_ptr = this->input + first;
+    memcpy(output_ptr, input_ptr, len * sizeof(MLFloat16));
+
+    MlasFp16Activation(&Activation, output_ptr, 1, len, len);
+  }
+};
 
 }  // namespace functors
 }  // namespace onnxruntime
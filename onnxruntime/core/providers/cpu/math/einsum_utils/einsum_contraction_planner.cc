@@ -0,0 +1,149 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "einsum_contraction_planner.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace onnxruntime {
+
+namespace EinsumOp {
+
+namespace {
+
+using Dims = std::vector<int64_t>;
+
+double Size(const Dims& dims) {
+  double size = 1.0;
+  for (auto dim : dims) {
+    size *= static_cast<double>(dim);
+  }
+  return size;
+}
+
+// Multiply-adds of the contraction of two operands, which runs over every subscript either of them has
+double ContractionCost(const Dims& left, const Dims& right) {
+  double cost = 1.0;
+  for (size_t i = 0; i < left.size(); ++i) {
+    cost *= static_cast<double>(std::max(left[i], right[i]));
+  }
+  return cost;
+}
+
+// Dims of the contraction of operands `first` and `second`: the subscripts of the output or of another
+// remaining operand are kept and the others are summed over
+Dims ContractedDims(const std::vector<Dims>& operands, size_t first, size_t second,
+                    const std::vector<bool>& in_output) {
+  const Dims& left = operands[first];
+  const Dims& right = operands[second];
+  Dims result(left.size(), 1);
+  for (size_t i = 0; i < left.size(); ++i) {
+    const int64_t dim = std::max(left[i], right[i]);
+    bool kept = in_output[i];
+    for (size_t k = 0; k < operands.size() && !kept; ++k) {
+      kept = k != first && k != second && operands[k][i] > 1;
+    }
+    if (kept) {
+      result[i] = dim;
+    }
+  }
+  return result;
+}
+
+std::vector<Dims> Contract(const std::vector<Dims>& operands, size_t first, size_t second, Dims result) {
+  std::vector<Dims> remaining = operands;
+  remaining[first] = std::move(result);
+  remaining.erase(remaining.begin() + second);
+  return remaining;
+}
+
+// Depth-first search of the cheapest order. Orders are explored from the left-to-right one, so that it is kept
+// when no other order is strictly cheaper.
+void SearchOptimalOrder(const std::vector<Dims>& operands, const std::vector<bool>& in_output, double cost,
+                        ContractionPath& path, double& best_cost, ContractionPath& best_path) {
+  if (operands.size() == 1) {
+    best_cost = cost;
+    best_path = path;
+    return;
+  }
+
+  for (size_t first = 0; first < operands.size(); ++first) {
+    for (size_t second = first + 1; second < operands.size(); ++second) {
+      const double step_cost = cost + ContractionCost(operands[first], operands[second]);
+      if (step_cost >= best_cost) {
+        continue;
+      }
+      path.emplace_back(first, second);
+      SearchOptimalOrder(Contract(operands, first, second, ContractedDims(operands, first, second, in_output)),
+                         in_output, step_cost, path, best_cost, best_path);
+      path.pop_back();
+    }
+  }
+}
+
+ContractionPath GreedyOrder(std::vector<Dims> operands, const std::vector<bool>& in_output) {
+  ContractionPath path;
+  while (operands.size() > 1) {
+    size_t best_first = 0;
+    size_t best_second = 1;
+    Dims best_result;
+    std::pair<double, double> best_score{std::numeric_limits<double>::max(), std::numeric_limits<double>::max()};
+    for (size_t first = 0; first < operands.size(); ++first) {
+      for (size_t second = first + 1; second < operands.size(); ++second) {
+        Dims result = ContractedDims(operands, first, second, in_output);
+        const std::pair<double, double> score{Size(result) - Size(operands[first]) - Size(operands[second]),
+                                              ContractionCost(operands[first], operands[second])};
+        if (score < best_score) {
+          best_score = score;
+          best_first = first;
+          best_second = second;
+          best_result = std::move(result);
+        }
+      }
+    }
+    path.emplace_back(best_first, best_second);
+    operands = Contract(operands, best_first, best_second, std::move(best_result));
+  }
+  return path;
+}
+
+}  // namespace
+
+ContractionPath PlanContractionOrder(const std::vector<std::vector<int64_t>>& operand_dims,
+                                     const std::vector<bool>& in_output) {
+  if (operand_dims.size() > kMaxOptimalOperands) {
+    return GreedyOrder(operand_dims, in_output);
+  }
+
+  ContractionPath path;
+  ContractionPath best_path;
+  double best_cost = std::numeric_limits<double>::infinity();
+  SearchOptimalOrder(operand_dims, in_output, 0.0, path, best_cost, best_path);
+  return best_path;
+}
+
+ContractionPath ContractionPlanCache::Get(const std::vector<std::vector<int64_t>>& operand_dims,
+                                          const std::vector<bool>& in_output) {
+  std::vector<int64_t> key;
+  for (const auto& dims : operand_dims) {
+    key.insert(key.end(), dims.begin(), dims.end());
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = plans_.find(key);
+  if (it != plans_.end()) {
+    return it->second;
+  }
+
+  if (plans_.size() >= kMaxPlans) {
+    plans_.clear();
+  }
+  ContractionPath path = PlanContractionOrder(operand_dims, in_output);
+  plans_.emplace(std::move(key), path);
+  return path;
+}
+
+}  // namespace EinsumOp
+
+}  // namespace onnxruntime
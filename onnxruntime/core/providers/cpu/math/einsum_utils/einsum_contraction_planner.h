@@ -0,0 +1,47 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+// This module hosts the planner of the order in which Einsum contracts its operands pair-wise
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace onnxruntime {
+
+namespace EinsumOp {
+
+// Each step contracts the operands at positions `first` and `second` (first < second) of the list of remaining
+// operands. The result takes the place of the first operand and the second operand is removed from the list.
+using ContractionPath = std::vector<std::pair<size_t, size_t>>;
+
+// Plans the order of the pair-wise contractions of operands given by their homogenized dims (one dim per subscript
+// index, 1 where the operand does not have the subscript). `in_output` flags the subscript indices of the output.
+// Up to kMaxOptimalOperands operands, every order is searched for the one with the fewest multiply-adds.
+// More operands are contracted greedily, taking the pair whose result is the smallest relative to its operands
+// at each step, as opt_einsum does.
+constexpr size_t kMaxOptimalOperands = 5;
+
+ContractionPath PlanContractionOrder(const std::vector<std::vector<int64_t>>& operand_dims,
+                                     const std::vector<bool>& in_output);
+
+// Contraction orders planned for an Einsum node, by the dims of its operands
+class ContractionPlanCache {
+ public:
+  ContractionPath Get(const std::vector<std::vector<int64_t>>& operand_dims, const std::vector<bool>& in_output);
+
+ private:
+  // A node with inputs of varying shapes drops its plans when it has accumulated this many
+  static constexpr size_t kMaxPlans = 64;
+
+  std::mutex mutex_;
+  std::map<std::vector<int64_t>, ContractionPath> plans_;
+};
+
+}  // namespace EinsumOp
+
+}  // namespace onnxruntime
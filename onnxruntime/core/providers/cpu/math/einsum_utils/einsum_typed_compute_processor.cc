@@ -357,13 +357,11 @@ Status EinsumTypedComputeProcessor<T>::Run() {
 
   auto num_inputs = context_->InputCount();
 
-  // Pre-process the first input so as to reduce any dims that only it has
-  std::unique_ptr<const Tensor> result;
-
-  {
+  if (num_inputs == 1) {
+    // Reduce the dims that do not appear in the output
+    std::unique_ptr<const Tensor> result;
     TensorShapeVector reduced_dims;
     TensorShapeVector preserved_dims;                                           // dims which were not reduced
-    TensorShapeVector preserved_shape;                                          // shape pertaining to only the dims that were preserved (not reduced)
     reduced_dims.reserve(onnxruntime::narrow<size_t>(num_subscript_labels));    // num_subscript_labels is the upper bound. No harm in over-reserving.
     preserved_dims.reserve(onnxruntime::narrow<size_t>(num_subscript_labels));  // num_subscript_labels is the upper bound. No harm in over-reserving.
 
@@ -375,52 +373,72 @@ Status EinsumTypedComputeProcessor<T>::Run() {
       }
     }
 
-    // Reduce the dims that are last seen in the first input alone
     if (reduced_dims.size() != 0) {
       result = EinsumOp::ReduceSum<T>(preprocessed_inputs[0] ? *preprocessed_inputs[0] : *raw_inputs[0],
                                       homogenized_input_dims[0].GetDims(), reduced_dims, allocator_, tp_,
                                       einsum_ep_assets_, device_reduce_sum_func_);
-    } else {
-      // Check if there is a pre-processed version of this input
-      // If so assign it to result
-      if (preprocessed_inputs[0]) {
-        result = std::move(preprocessed_inputs[0]);
-      }
+    } else if (preprocessed_inputs[0]) {
+      result = std::move(preprocessed_inputs[0]);
     }
 
-    // Finalize the output at this stage if num_inputs == 1
-    if (num_inputs == 1) {
-      // Finalize the output by applying any transpose required to get
-      // it to the required output ordering and move it to the op's output
-      FinalizeOutput(result ? *result : *raw_inputs[0], preserved_dims);
+    // Finalize the output by applying any transpose required to get
+    // it to the required output ordering and move it to the op's output
+    FinalizeOutput(result ? *result : *raw_inputs[0], preserved_dims);
 
-      return Status::OK();
-    }
+    return Status::OK();
   }
 
-  // Process the operands in a pair-wise fashion
-  {
-    bool is_final_pair = false;
-    // Keep processing each input pair-wise
-    for (int input = 1; input < num_inputs; ++input) {
-      TensorShapeVector reduced_dims;
-      reduced_dims.reserve(onnxruntime::narrow<size_t>(num_subscript_labels));  // num_subscript_labels is the upper bound. No harm in over-reserving by a small margin.
-      for (int64_t dim = 0; dim < num_subscript_labels; ++dim) {
-        if (mapped_indices_to_last_input_index[onnxruntime::narrow<size_t>(dim)] == input) {
-          // This is the last input we are seeing this dimension (and it doesn't occur in the output), so reduce along the dimension
-          reduced_dims.push_back(dim);
-        }
+  // Process the operands in a pair-wise fashion, in the planned order.
+  // The operands keep the homogenized layout (one dim per subscript index) through the contractions,
+  // so any two of them can be contracted together.
+  const auto num_labels = onnxruntime::narrow<size_t>(num_subscript_labels);
+  std::vector<bool> in_output(num_labels);
+  for (size_t i = 0; i < num_labels; ++i) {
+    in_output[i] = mapped_indices_to_last_input_index[i] == -1;
+  }
+
+  std::vector<const Tensor*> operands;
+  std::vector<std::unique_ptr<Tensor>> owned_operands(onnxruntime::narrow<size_t>(num_inputs));
+  std::vector<TensorShape> operand_shapes;
+  std::vector<std::vector<int64_t>> operand_dims;
+  for (int input = 0; input < num_inputs; ++input) {
+    operands.push_back(preprocessed_inputs[input] ? preprocessed_inputs[input].get() : raw_inputs[input]);
+    operand_shapes.push_back(homogenized_input_dims[input]);
+    const auto dims = homogenized_input_dims[input].GetDims();
+    operand_dims.emplace_back(dims.begin(), dims.end());
+  }
+
+  const EinsumOp::ContractionPath path = contraction_plan_cache_ != nullptr
+                                             ? contraction_plan_cache_->Get(operand_dims, in_output)
+                                             : EinsumOp::PlanContractionOrder(operand_dims, in_output);
+
+  for (size_t step = 0; step < path.size(); ++step) {
+    const size_t first = path[step].first;
+    const size_t second = path[step].second;
+
+    // Reduce along the dims that neither the output nor the other remaining operands have
+    TensorShapeVector reduced_dims;
+    reduced_dims.reserve(num_labels);  // num_labels is the upper bound. No harm in over-reserving by a small margin.
+    for (size_t dim = 0; dim < num_labels; ++dim) {
+      bool kept = in_output[dim];
+      for (size_t k = 0; k < operands.size() && !kept; ++k) {
+        kept = k != first && k != second && operand_shapes[k][dim] > 1;
       }
-      if (input == num_inputs - 1) {
-        is_final_pair = true;
+      if (!kept) {
+        reduced_dims.push_back(static_cast<int64_t>(dim));
       }
-      // Use either the preprocessed inputs (if it is available) or the corresponding raw inputs
-      result = PairwiseOperandProcess(result ? *result : *raw_inputs[0],
-                                      result ? result->Shape() : homogenized_input_dims[0],
-                                      preprocessed_inputs[input] ? *preprocessed_inputs[input] : *raw_inputs[input],
-                                      homogenized_input_dims[input],
-                                      reduced_dims, is_final_pair);
     }
+
+    auto result = PairwiseOperandProcess(*operands[first], operand_shapes[first],
+                                         *operands[second], operand_shapes[second],
+                                         reduced_dims, step + 1 == path.size());
+
+    operand_shapes[first] = result->Shape();
+    operands[first] = result.get();
+    owned_operands[first] = std::move(result);
+    operands.erase(operands.begin() + second);
+    operand_shapes.erase(operand_shapes.begin() + second);
+    owned_operands.erase(owned_operands.begin() + second);
   }
 
   return Status::OK();
@@ -9,6 +9,7 @@
 
 #include "einsum_auxiliary_ops.h"
 #include "einsum_compute_preprocessor.h"
+#include "einsum_contraction_planner.h"
 
 namespace onnxruntime {
 
@@ -33,6 +34,11 @@ class EinsumTypedComputeProcessor {
                         const EinsumOp::DeviceHelpers::ReduceSum<T>& device_reduce_sum_func,
                         const EinsumOp::DeviceHelpers::DataCopy& device_data_copy_func);
 
+  // Contraction orders planned by previous runs of the node, if it keeps any
+  void SetContractionPlanCache(EinsumOp::ContractionPlanCache* contraction_plan_cache) {
+    contraction_plan_cache_ = contraction_plan_cache;
+  }
+
   Status Run();
 
  private:
@@ -67,6 +73,8 @@ class EinsumTypedComputeProcessor {
 
   // Holds EP-specific assets required for (auxiliary) ops that need to be executed on non-CPU EPs
   void* einsum_ep_assets_;
+
+  EinsumOp::ContractionPlanCache* contraction_plan_cache_ = nullptr;
 };
 
 }  // namespace onnxruntime
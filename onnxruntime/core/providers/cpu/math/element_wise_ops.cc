@@ -84,6 +84,51 @@ void Exp<float>::operator()(std::ptrdiff_t first, std::ptrdiff_t last) const {
       KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<TYPE>()), \
       KERNEL_CLASS<TYPE>);
 
+// for ops that compute each output element from the input elements at the same position (after broadcasting),
+// so the output can be written to the buffer of an input of the same size
+#define REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(OP_TYPE, VERSION, TYPE, KERNEL_CLASS) \
+  ONNX_CPU_OPERATOR_TYPED_KERNEL(                                                 \
+      OP_TYPE,                                                                    \
+      VERSION,                                                                    \
+      TYPE,                                                                       \
+      KernelDefBuilder()                                                          \
+          .MayInplace(0, 0)                                                       \
+          .MayInplace(1, 0)                                                       \
+          .TypeConstraint("T", DataTypeImpl::GetTensorType<TYPE>()),              \
+      KERNEL_CLASS<TYPE>);
+
+#define REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(OP_TYPE, VERSION_FROM, VERSION_TO, TYPE, KERNEL_CLASS) \
+  ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(                                                                   \
+      OP_TYPE,                                                                                                \
+      VERSION_FROM, VERSION_TO,                                                                               \
+      TYPE,                                                                                                   \
+      KernelDefBuilder()                                                                                      \
+          .MayInplace(0, 0)                                                                                   \
+          .MayInplace(1, 0)                                                                                   \
+          .TypeConstraint("T", DataTypeImpl::GetTensorType<TYPE>()),                                          \
+      KERNEL_CLASS<TYPE>);
+
+// for unary ops, whose only input is the one the output can be written to
+#define REG_ELEMENTWISE_UNARY_INPLACE_TYPED_KERNEL(OP_TYPE, VERSION, TYPE, KERNEL_CLASS) \
+  ONNX_CPU_OPERATOR_TYPED_KERNEL(                                                       \
+      OP_TYPE,                                                                          \
+      VERSION,                                                                          \
+      TYPE,                                                                             \
+      KernelDefBuilder()                                                                \
+          .MayInplace(0, 0)                                                             \
+          .TypeConstraint("T", DataTypeImpl::GetTensorType<TYPE>()),                    \
+      KERNEL_CLASS<TYPE>);
+
+#define REG_ELEMENTWISE_UNARY_INPLACE_VERSIONED_TYPED_KERNEL(OP_TYPE, VERSION_FROM, VERSION_TO, TYPE, KERNEL_CLASS) \
+  ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(                                                                         \
+      OP_TYPE,                                                                                                      \
+      VERSION_FROM, VERSION_TO,                                                                                     \
+      TYPE,                                                                                                         \
+      KernelDefBuilder()                                                                                            \
+          .MayInplace(0, 0)                                                                                         \
+          .TypeConstraint("T", DataTypeImpl::GetTensorType<TYPE>()),                                                \
+      KERNEL_CLASS<TYPE>);
+
 #define REG_ELEMENTWISE_LOGICALOP_TYPED_KERNEL(OP_TYPE, VERSION, TYPE, KERNEL_CLASS) \
   ONNX_CPU_OPERATOR_TYPED_KERNEL(                                                    \
       OP_TYPE,                                                                       \
@@ -153,110 +198,110 @@ void Exp<float>::operator()(std::ptrdiff_t first, std::ptrdiff_t last) const {
           .TypeConstraint("T1", T2_CONSTRAINTS),                                                 \
       KERNEL_CLASS);
 
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Add, 7, 12, float, Add);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Add, 7, 12, double, Add);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Add, 7, 12, int32_t, Add);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Add, 7, 12, int64_t, Add);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Add, 13, 13, float, Add);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Add, 13, 13, double, Add);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Add, 13, 13, int32_t, Add);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Add, 13, 13, int64_t, Add);
-REG_ELEMENTWISE_TYPED_KERNEL(Add, 14, float, Add);
-REG_ELEMENTWISE_TYPED_KERNEL(Add, 14, double, Add);
-REG_ELEMENTWISE_TYPED_KERNEL(Add, 14, int32_t, Add);
-REG_ELEMENTWISE_TYPED_KERNEL(Add, 14, int64_t, Add);
-
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Sub, 7, 12, float, Sub);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Sub, 7, 12, double, Sub);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Sub, 7, 12, int32_t, Sub);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Sub, 7, 12, int64_t, Sub);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Sub, 13, 13, float, Sub);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Sub, 13, 13, double, Sub);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Sub, 13, 13, int32_t, Sub);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Sub, 13, 13, int64_t, Sub);
-REG_ELEMENTWISE_TYPED_KERNEL(Sub, 14, float, Sub);
-REG_ELEMENTWISE_TYPED_KERNEL(Sub, 14, double, Sub);
-REG_ELEMENTWISE_TYPED_KERNEL(Sub, 14, int32_t, Sub);
-REG_ELEMENTWISE_TYPED_KERNEL(Sub, 14, int64_t, Sub);
-
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Mul, 7, 12, float, Mul);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Mul, 7, 12, double, Mul);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Mul, 7, 12, int32_t, Mul);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Mul, 7, 12, int64_t, Mul);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Mul, 13, 13, float, Mul);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Mul, 13, 13, double, Mul);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Mul, 13, 13, int32_t, Mul);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Mul, 13, 13, int64_t, Mul);
-REG_ELEMENTWISE_TYPED_KERNEL(Mul, 14, float, Mul);
-REG_ELEMENTWISE_TYPED_KERNEL(Mul, 14, double, Mul);
-REG_ELEMENTWISE_TYPED_KERNEL(Mul, 14, int32_t, Mul);
-REG_ELEMENTWISE_TYPED_KERNEL(Mul, 14, int64_t, Mul);
-
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Div, 7, 12, float, Div);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Div, 7, 12, double, Div);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Div, 7, 12, int32_t, Div);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Div, 7, 12, int64_t, Div);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Div, 13, 13, float, Div);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Div, 13, 13, double, Div);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Div, 13, 13, int32_t, Div);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Div, 13, 13, int64_t, Div);
-REG_ELEMENTWISE_TYPED_KERNEL(Div, 14, float, Div);
-REG_ELEMENTWISE_TYPED_KERNEL(Div, 14, double, Div);
-REG_ELEMENTWISE_TYPED_KERNEL(Div, 14, int32_t, Div);
-REG_ELEMENTWISE_TYPED_KERNEL(Div, 14, int64_t, Div);
-
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Abs, 6, 12, float, Abs);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Abs, 6, 12, double, Abs);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Abs, 6, 12, int8_t, Abs);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Abs, 6, 12, int16_t, Abs);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Abs, 6, 12, int32_t, Abs);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Abs, 6, 12, int64_t, Abs);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Abs, 6, 12, uint8_t, Abs);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Abs, 6, 12, uint16_t, Abs);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Abs, 6, 12, uint32_t, Abs);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Abs, 6, 12, uint64_t, Abs);
-
-REG_ELEMENTWISE_TYPED_KERNEL(Abs, 13, float, Abs);
-REG_ELEMENTWISE_TYPED_KERNEL(Abs, 13, double, Abs);
-REG_ELEMENTWISE_TYPED_KERNEL(Abs, 13, int8_t, Abs);
-REG_ELEMENTWISE_TYPED_KERNEL(Abs, 13, int16_t, Abs);
-REG_ELEMENTWISE_TYPED_KERNEL(Abs, 13, int32_t, Abs);
-REG_ELEMENTWISE_TYPED_KERNEL(Abs, 13, int64_t, Abs);
-REG_ELEMENTWISE_TYPED_KERNEL(Abs, 13, uint8_t, Abs);
-REG_ELEMENTWISE_TYPED_KERNEL(Abs, 13, uint16_t, Abs);
-REG_ELEMENTWISE_TYPED_KERNEL(Abs, 13, uint32_t, Abs);
-REG_ELEMENTWISE_TYPED_KERNEL(Abs, 13, uint64_t, Abs);
-
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Neg, 6, 12, float, Neg);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Neg, 6, 12, double, Neg);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Neg, 6, 12, int8_t, Neg);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Neg, 6, 12, int32_t, Neg);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Neg, 6, 12, int64_t, Neg);
-REG_ELEMENTWISE_TYPED_KERNEL(Neg, 13, float, Neg);
-REG_ELEMENTWISE_TYPED_KERNEL(Neg, 13, double, Neg);
-REG_ELEMENTWISE_TYPED_KERNEL(Neg, 13, int8_t, Neg);
-REG_ELEMENTWISE_TYPED_KERNEL(Neg, 13, int32_t, Neg);
-REG_ELEMENTWISE_TYPED_KERNEL(Neg, 13, int64_t, Neg);
-
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Floor, 6, 12, float, Floor);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Floor, 6, 12, double, Floor);
-REG_ELEMENTWISE_TYPED_KERNEL(Floor, 13, float, Floor);
-REG_ELEMENTWISE_TYPED_KERNEL(Floor, 13, double, Floor);
-
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Ceil, 6, 12, float, Ceil);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Ceil, 6, 12, double, Ceil);
-REG_ELEMENTWISE_TYPED_KERNEL(Ceil, 13, float, Ceil);
-REG_ELEMENTWISE_TYPED_KERNEL(Ceil, 13, double, Ceil);
-
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Reciprocal, 6, 12, float, Reciprocal);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Reciprocal, 6, 12, double, Reciprocal);
-REG_ELEMENTWISE_TYPED_KERNEL(Reciprocal, 13, float, Reciprocal);
-REG_ELEMENTWISE_TYPED_KERNEL(Reciprocal, 13, double, Reciprocal);
-
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Sqrt, 6, 12, float, Sqrt);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Sqrt, 6, 12, double, Sqrt);
-REG_ELEMENTWISE_TYPED_KERNEL(Sqrt, 13, float, Sqrt);
-REG_ELEMENTWISE_TYPED_KERNEL(Sqrt, 13, double, Sqrt);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Add, 7, 12, float, Add);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Add, 7, 12, double, Add);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Add, 7, 12, int32_t, Add);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Add, 7, 12, int64_t, Add);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Add, 13, 13, float, Add);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Add, 13, 13, double, Add);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Add, 13, 13, int32_t, Add);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Add, 13, 13, int64_t, Add);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Add, 14, float, Add);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Add, 14, double, Add);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Add, 14, int32_t, Add);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Add, 14, int64_t, Add);
+
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Sub, 7, 12, float, Sub);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Sub, 7, 12, double, Sub);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Sub, 7, 12, int32_t, Sub);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Sub, 7, 12, int64_t, Sub);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Sub, 13, 13, float, Sub);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Sub, 13, 13, double, Sub);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Sub, 13, 13, int32_t, Sub);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Sub, 13, 13, int64_t, Sub);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Sub, 14, float, Sub);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Sub, 14, double, Sub);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Sub, 14, int32_t, Sub);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Sub, 14, int64_t, Sub);
+
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Mul, 7, 12, float, Mul);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Mul, 7, 12, double, Mul);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Mul, 7, 12, int32_t, Mul);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Mul, 7, 12, int64_t, Mul);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Mul, 13, 13, float, Mul);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Mul, 13, 13, double, Mul);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Mul, 13, 13, int32_t, Mul);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Mul, 13, 13, int64_t, Mul);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Mul, 14, float, Mul);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Mul, 14, double, Mul);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Mul, 14, int32_t, Mul);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Mul, 14, int64_t, Mul);
+
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Div, 7, 12, float, Div);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Div, 7, 12, double, Div);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Div, 7, 12, int32_t, Div);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Div, 7, 12, int64_t, Div);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Div, 13, 13, float, Div);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Div, 13, 13, double, Div);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Div, 13, 13, int32_t, Div);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Div, 13, 13, int64_t, Div);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Div, 14, float, Div);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Div, 14, double, Div);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Div, 14, int32_t, Div);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Div, 14, int64_t, Div);
+
+REG_ELEMENTWISE_UNARY_INPLACE_VERSIONED_TYPED_KERNEL(Abs, 6, 12, float, Abs);
+REG_ELEMENTWISE_UNARY_INPLACE_VERSIONED_TYPED_KERNEL(Abs, 6, 12, double, Abs);
+REG_ELEMENTWISE_UNARY_INPLACE_VERSIONED_TYPED_KERNEL(Abs, 6, 12, int8_t, Abs);
+REG_ELEMENTWISE_UNARY_INPLACE_VERSIONED_TYPED_KERNEL(Abs, 6, 12, int16_t, Abs);
+REG_ELEMENTWISE_UNARY_INPLACE_VERSIONED_TYPED_KERNEL(Abs, 6, 12, int32_t, Abs);
+REG_ELEMENTWISE_UNARY_INPLACE_VERSIONED_TYPED_KERNEL(Abs, 6, 12, int64_t, Abs);
+REG_ELEMENTWISE_UNARY_INPLACE_VERSIONED_TYPED_KERNEL(Abs, 6, 12, uint8_t, Abs);
+REG_ELEMENTWISE_UNARY_INPLACE_VERSIONED_TYPED_KERNEL(Abs, 6, 12, uint16_t, Abs);
+REG_ELEMENTWISE_UNARY_INPLACE_VERSIONED_TYPED_KERNEL(Abs, 6, 12, uint32_t, Abs);
+REG_ELEMENTWISE_UNARY_INPLACE_VERSIONED_TYPED_KERNEL(Abs, 6, 12, uint64_t, Abs);
+
+REG_ELEMENTWISE_UNARY_INPLACE_TYPED_KERNEL(Abs, 13, float, Abs);
+REG_ELEMENTWISE_UNARY_INPLACE_TYPED_KERNEL(Abs, 13, double, Abs);
+REG_ELEMENTWISE_UNARY_INPLACE_TYPED_KERNEL(Abs, 13, int8_t, Abs);
+REG_ELEMENTWISE_UNARY_INPLACE_TYPED_KERNEL(Abs, 13, int16_t, Abs);
+REG_ELEMENTWISE_UNARY_INPLACE_TYPED_KERNEL(Abs, 13, int32_t, Abs);
+REG_ELEMENTWISE_UNARY_INPLACE_TYPED_KERNEL(Abs, 13, int64_t, Abs);
+REG_ELEMENTWISE_UNARY_INPLACE_TYPED_KERNEL(Abs, 13, uint8_t, Abs);
+REG_ELEMENTWISE_UNARY_INPLACE_TYPED_KERNEL(Abs, 13, uint16_t, Abs);
+REG_ELEMENTWISE_UNARY_INPLACE_TYPED_KERNEL(Abs, 13, uint32_t, Abs);
+REG_ELEMENTWISE_UNARY_INPLACE_TYPED_KERNEL(Abs, 13, uint64_t, Abs);
+
+REG_ELEMENTWISE_UNARY_INPLACE_VERSIONED_TYPED_KERNEL(Neg, 6, 12, float, Neg);
+REG_ELEMENTWISE_UNARY_INPLACE_VERSIONED_TYPED_KERNEL(Neg, 6, 12, double, Neg);
+REG_ELEMENTWISE_UNARY_INPLACE_VERSIONED_TYPED_KERNEL(Neg, 6, 12, int8_t, Neg);
+REG_ELEMENTWISE_UNARY_INPLACE_VERSIONED_TYPED_KERNEL(Neg, 6, 12, int32_t, Neg);
+REG_ELEMENTWISE_UNARY_INPLACE_VERSIONED_TYPED_KERNEL(Neg, 6, 12, int64_t, Neg);
+REG_ELEMENTWISE_UNARY_INPLACE_TYPED_KERNEL(Neg, 13, float, Neg);
+REG_ELEMENTWISE_UNARY_INPLACE_TYPED_KERNEL(Neg, 13, double, Neg);
+REG_ELEMENTWISE_UNARY_INPLACE_TYPED_KERNEL(Neg, 13, int8_t, Neg);
+REG_ELEMENTWISE_UNARY_INPLACE_TYPED_KERNEL(Neg, 13, int32_t, Neg);
+REG_ELEMENTWISE_UNARY_INPLACE_TYPED_KERNEL(Neg, 13, int64_t, Neg);
+
+REG_ELEMENTWISE_UNARY_INPLACE_VERSIONED_TYPED_KERNEL(Floor, 6, 12, float, Floor);
+REG_ELEMENTWISE_UNARY_INPLACE_VERSIONED_TYPED_KERNEL(Floor, 6, 12, double, Floor);
+REG_ELEMENTWISE_UNARY_INPLACE_TYPED_KERNEL(Floor, 13, float, Floor);
+REG_ELEMENTWISE_UNARY_INPLACE_TYPED_KERNEL(Floor, 13, double, Floor);
+
+REG_ELEMENTWISE_UNARY_INPLACE_VERSIONED_TYPED_KERNEL(Ceil, 6, 12, float, Ceil);
+REG_ELEMENTWISE_UNARY_INPLACE_VERSIONED_TYPED_KERNEL(Ceil, 6, 12, double, Ceil);
+REG_ELEMENTWISE_UNARY_INPLACE_TYPED_KERNEL(Ceil, 13, float, Ceil);
+REG_ELEMENTWISE_UNARY_INPLACE_TYPED_KERNEL(Ceil, 13, double, Ceil);
+
+REG_ELEMENTWISE_UNARY_INPLACE_VERSIONED_TYPED_KERNEL(Reciprocal, 6, 12, float, Reciprocal);
+REG_ELEMENTWISE_UNARY_INPLACE_VERSIONED_TYPED_KERNEL(Reciprocal, 6, 12, double, Reciprocal);
+REG_ELEMENTWISE_UNARY_INPLACE_TYPED_KERNEL(Reciprocal, 13, float, Reciprocal);
+REG_ELEMENTWISE_UNARY_INPLACE_TYPED_KERNEL(Reciprocal, 13, double, Reciprocal);
+
+REG_ELEMENTWISE_UNARY_INPLACE_VERSIONED_TYPED_KERNEL(Sqrt, 6, 12, float, Sqrt);
+REG_ELEMENTWISE_UNARY_INPLACE_VERSIONED_TYPED_KERNEL(Sqrt, 6, 12, double, Sqrt);
+REG_ELEMENTWISE_UNARY_INPLACE_TYPED_KERNEL(Sqrt, 13, float, Sqrt);
+REG_ELEMENTWISE_UNARY_INPLACE_TYPED_KERNEL(Sqrt, 13, double, Sqrt);
 
 REG_ELEMENTWISE_VERSIONED_KERNEL_NONT(Pow, 7, 11, Pow,
                                       BuildKernelDefConstraintsFromTypeList<EnabledPow7Types>());
@@ -273,15 +318,15 @@ REG_ELEMENTWISE_KERNEL_NONT_2(Pow, 15, Pow,
                               BuildKernelDefConstraintsFromTypeList<EnabledPow12BaseTypes>(),
                               BuildKernelDefConstraintsFromTypeList<EnabledPow12ExpTypes>());
 
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Exp, 6, 12, float, Exp);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Exp, 6, 12, double, Exp);
-REG_ELEMENTWISE_TYPED_KERNEL(Exp, 13, float, Exp);
-REG_ELEMENTWISE_TYPED_KERNEL(Exp, 13, double, Exp);
+REG_ELEMENTWISE_UNARY_INPLACE_VERSIONED_TYPED_KERNEL(Exp, 6, 12, float, Exp);
+REG_ELEMENTWISE_UNARY_INPLACE_VERSIONED_TYPED_KERNEL(Exp, 6, 12, double, Exp);
+REG_ELEMENTWISE_UNARY_INPLACE_TYPED_KERNEL(Exp, 13, float, Exp);
+REG_ELEMENTWISE_UNARY_INPLACE_TYPED_KERNEL(Exp, 13, double, Exp);
 
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Log, 6, 12, float, Log);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Log, 6, 12, double, Log);
-REG_ELEMENTWISE_TYPED_KERNEL(Log, 13, float, Log);
-REG_ELEMENTWISE_TYPED_KERNEL(Log, 13, double, Log);
+REG_ELEMENTWISE_UNARY_INPLACE_VERSIONED_TYPED_KERNEL(Log, 6, 12, float, Log);
+REG_ELEMENTWISE_UNARY_INPLACE_VERSIONED_TYPED_KERNEL(Log, 6, 12, double, Log);
+REG_ELEMENTWISE_UNARY_INPLACE_TYPED_KERNEL(Log, 13, float, Log);
+REG_ELEMENTWISE_UNARY_INPLACE_TYPED_KERNEL(Log, 13, double, Log);
 
 REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Sum, 6, 7, float, Sum_6);
 REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Sum, 6, 7, double, Sum_6);
@@ -417,9 +462,9 @@ REG_ELEMENTWISE_TYPED_KERNEL(BitwiseXor, 18, uint16_t, BitwiseXor);
 REG_ELEMENTWISE_TYPED_KERNEL(BitwiseXor, 18, uint32_t, BitwiseXor);
 REG_ELEMENTWISE_TYPED_KERNEL(BitwiseXor, 18, uint64_t, BitwiseXor);
 
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Erf, 9, 12, float, Erf);
+REG_ELEMENTWISE_UNARY_INPLACE_VERSIONED_TYPED_KERNEL(Erf, 9, 12, float, Erf);
 // Supposed to add BFloat16 but we are not supporting now, however, separate registration
-REG_ELEMENTWISE_TYPED_KERNEL(Erf, 13, float, Erf);
+REG_ELEMENTWISE_UNARY_INPLACE_TYPED_KERNEL(Erf, 13, float, Erf);
 
 // REG_ELEMENTWISE_LOGICALOP_TYPED_KERNEL(Not, 1, bool, Not);
 // REG_ELEMENTWISE_LOGICALOP_TYPED_KERNEL(And, 7, bool, And);
@@ -533,6 +578,79 @@ Status Div<T>::Compute(OpKernelContext* context) const {
   return Status::OK();
 }
 
+#ifdef MLAS_F16VEC_INTRINSICS_SUPPORTED
+namespace {
+template <MLAS_HALF_ELTWISE_KIND Kind>
+void HalfEltwiseBroadcastTwo(OpKernelContext& context) {
+  ProcessBroadcastSpanFuncs funcs{
+      [](BroadcastHelper& per_iter_bh) {
+        const MLFloat16& input0 = per_iter_bh.ScalarInput0<MLFloat16>();
+        auto input1 = per_iter_bh.SpanInput1<MLFloat16>();
+        auto output = per_iter_bh.OutputSpan<MLFloat16>();
+        MlasHalfEltwiseBinary(Kind, reinterpret_cast<const MLAS_FP16*>(&input0), true,
+                              reinterpret_cast<const MLAS_FP16*>(input1.data()), false,
+                              reinterpret_cast<MLAS_FP16*>(output.data()), output.size());
+      },
+      [](BroadcastHelper& per_iter_bh) {
+        auto input0 = per_iter_bh.SpanInput0<MLFloat16>();
+        const MLFloat16& input1 = per_iter_bh.ScalarInput1<MLFloat16>();
+        auto output = per_iter_bh.OutputSpan<MLFloat16>();
+        MlasHalfEltwiseBinary(Kind, reinterpret_cast<const MLAS_FP16*>(input0.data()), false,
+                              reinterpret_cast<const MLAS_FP16*>(&input1), true,
+                              reinterpret_cast<MLAS_FP16*>(output.data()), output.size());
+      },
+      [](BroadcastHelper& per_iter_bh) {
+        auto input0 = per_iter_bh.SpanInput0<MLFloat16>();
+        auto input1 = per_iter_bh.SpanInput1<MLFloat16>();
+        auto output = per_iter_bh.OutputSpan<MLFloat16>();
+        MlasHalfEltwiseBinary(Kind, reinterpret_cast<const MLAS_FP16*>(input0.data()), false,
+                              reinterpret_cast<const MLAS_FP16*>(input1.data()), false,
+                              reinterpret_cast<MLAS_FP16*>(output.data()), output.size());
+      }};
+
+  UntypedBroadcastTwo(context, funcs, 1.0);
+}
+}  // namespace
+
+template <>
+Status Add<MLFloat16>::Compute(OpKernelContext* context) const {
+  HalfEltwiseBroadcastTwo<MlasHalfEltwiseAdd>(*context);
+  return Status::OK();
+}
+
+template <>
+Status Sub<MLFloat16>::Compute(OpKernelContext* context) const {
+  HalfEltwiseBroadcastTwo<MlasHalfEltwiseSub>(*context);
+  return Status::OK();
+}
+
+template <>
+Status Mul<MLFloat16>::Compute(OpKernelContext* context) const {
+  HalfEltwiseBroadcastTwo<MlasHalfEltwiseMul>(*context);
+  return Status::OK();
+}
+
+template <>
+Status Div<MLFloat16>::Compute(OpKernelContext* context) const {
+  HalfEltwiseBroadcastTwo<MlasHalfEltwiseDiv>(*context);
+  return Status::OK();
+}
+
+// registered after the specializations above so that they are the ones instantiated
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Add, 7, 12, MLFloat16, Add);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Add, 13, 13, MLFloat16, Add);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Add, 14, MLFloat16, Add);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Sub, 7, 12, MLFloat16, Sub);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Sub, 13, 13, MLFloat16, Sub);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Sub, 14, MLFloat16, Sub);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Mul, 7, 12, MLFloat16, Mul);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Mul, 13, 13, MLFloat16, Mul);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Mul, 14, MLFloat16, Mul);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Div, 7, 12, MLFloat16, Div);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Div, 13, 13, MLFloat16, Div);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Div, 14, MLFloat16, Div);
+#endif  // MLAS_F16VEC_INTRINSICS_SUPPORTED
+
 namespace pow_internal {
 
 template <typename T, typename E>
@@ -1923,6 +2041,24 @@ Status Mod::Compute(OpKernelContext* context) const {
   return Status::OK();
 }
 
+// Processes the output elements [first, last) of a partition, which may start and end within a span.
+static void BroadcastRange(const InputBroadcaster& input_broadcaster, Tensor& output_tensor, size_t span_size,
+                           size_t first, size_t last, const ProcessBroadcastSpanFuncs& funcs, void* user_data) {
+  const size_t first_span_start = first / span_size * span_size;
+  const size_t last_span_end = (last + span_size - 1) / span_size * span_size;
+
+  // copy original input_broadcaster (which is at start of all input) and advance to this segment
+  InputBroadcaster segment_input_broadcaster(input_broadcaster);
+  segment_input_broadcaster.AdvanceBy(first_span_start);
+
+  // create broadcaster for the spans covering this segment of output
+  OutputBroadcaster segment_output_broadcaster(span_size, output_tensor, static_cast<ptrdiff_t>(first_span_start),
+                                               static_cast<ptrdiff_t>(last_span_end));
+
+  BroadcastHelper segment_helper(segment_input_broadcaster, segment_output_broadcaster, user_data);
+  BroadcastRangeLooper(segment_helper, first, last, funcs);
+}
+
 // Broadcast two inputs with no parallelization.
 //
 // This function is type agnostic, and uses function pointers instead of std::function, to minimize binary size.
@@ -1964,28 +2100,22 @@ void UntypedBroadcastTwo(OpKernelContext& context, const ProcessBroadcastSpanFun
     BroadcastHelper broadcast_helper(input_broadcaster, output_broadcaster, user_data, tp, unit_cost);
     BroadcastLooper(broadcast_helper, funcs);
   } else {
-    // Input data will be processed in multiple spans, so parallelize across spans.
+    // Input data will be processed in multiple spans. The output elements are partitioned evenly, so a partition
+    // may start or end within a span: with a few large spans, e.g. [1, C, H, W] + [1, C, 1, 1] with a small C,
+    // partitioning whole spans would leave threads idle.
 
     // enforce const on input broadcaster we copy from
     const InputBroadcaster& const_input_broadcaster = input_broadcaster;
 
     concurrency::ThreadPool::TryParallelFor(
-        tp, output_size / span_size,
-        TensorOpCost{static_cast<double>(input_broadcaster.Input0ElementSize()) * span_size,
-                     static_cast<double>(output_tensor.DataType()->Size()) * span_size,
-                     unit_cost * span_size},
-        [span_size, &const_input_broadcaster, &output_tensor, &funcs, user_data](std::ptrdiff_t first_span,
-                                                                                 std::ptrdiff_t last_span) {
-          // copy original input_broadcaster (which is at start of all input) and advance to this segment
-          InputBroadcaster segment_input_broadcaster(const_input_broadcaster);
-          segment_input_broadcaster.AdvanceBy(first_span * span_size);
-
-          // create broadcaster for this segment of output
-          OutputBroadcaster segment_output_broadcaster(span_size, output_tensor,
-                                                       first_span * span_size, last_span * span_size);
-
-          BroadcastHelper segment_helper(segment_input_broadcaster, segment_output_broadcaster, user_data);
-          BroadcastLooper(segment_helper, funcs);
+        tp, output_size,
+        TensorOpCost{static_cast<double>(input_broadcaster.Input0ElementSize()),
+                     static_cast<double>(output_tensor.DataType()->Size()),
+                     unit_cost},
+        [span_size, &const_input_broadcaster, &output_tensor, &funcs, user_data](std::ptrdiff_t first,
+                                                                                 std::ptrdiff_t last) {
+          BroadcastRange(const_input_broadcaster, output_tensor, span_size, static_cast<size_t>(first),
+                         static_cast<size_t>(last), funcs, user_data);
         });
   }
 }
@@ -876,6 +876,7 @@ class BroadcastHelper {
   size_t NumOutputElements() const { return output_broadcaster_.NumOutputElements(); }
 
   bool SingleSpanOutput() const { return input_broadcaster_.GetSpanSize() == output_broadcaster_.NumOutputElements(); }
+  size_t SpanSize() const { return input_broadcaster_.GetSpanSize(); }
 
   template <typename T>
   const T& ScalarInput0() { return input_broadcaster_.Scalar0<T>(); }
@@ -1023,6 +1024,31 @@ void BroadcastLooper(TBroadcastHelper& helper, const ProcessBroadcastSpanFuncs&
   }
 }
 
+// Helper to process the output elements [first, last) of a partition that may start and end within a span, so that
+// the output can be partitioned evenly across threads whatever the span size.
+// The broadcasters of the helper must start at the span containing first and cover the spans up to the one containing
+// last - 1.
+template <typename TBroadcastHelper>
+void BroadcastRangeLooper(TBroadcastHelper& helper, size_t first, size_t last, const ProcessBroadcastSpanFuncs& functors) {
+  ORT_ENFORCE(helper.HaveTwoTensorInputs(), "BroadcastRangeLooper requires two tensors as input.");
+
+  const ProcessSpanFunc process = helper.IsInput0Scalar()   ? functors.input0scalar
+                                  : helper.IsInput1Scalar() ? functors.input1scalar
+                                                            : functors.general;
+  const size_t span_size = helper.SpanSize();
+  for (size_t span_start = first / span_size * span_size; span_start < last; span_start += span_size) {
+    const size_t begin = std::max(first, span_start) - span_start;
+    const size_t end = std::min(last, span_start + span_size) - span_start;
+    if (begin == 0 && end == span_size) {
+      process(helper);
+    } else {
+      TBroadcastHelper piece_helper(helper, begin, end - begin);
+      process(piece_helper);
+    }
+    helper.Next();
+  }
+}
+
 struct TensorAllocator {
   TensorAllocator(OpKernelContext& context) {
     auto status = context.GetTempSpaceAllocator(&allocator_);
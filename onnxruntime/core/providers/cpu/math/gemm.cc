@@ -5,10 +5,13 @@
 #include "core/providers/cpu/math/gemm.h"
 #include "core/common/narrow.h"
 #include "core/common/safeint.h"
+#include "core/framework/config_options.h"
 #include "core/providers/cpu/math/gemm_matmul_common.h"
 #include "core/util/math_cpuonly.h"
 #include "gemm_helper.h"
 #include "core/mlas/inc/mlas.h"
+#include "core/mlas/inc/mlas_q4.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 
 namespace onnxruntime {
 
@@ -100,12 +103,121 @@ ONNX_CPU_OPERATOR_TYPED_KERNEL(
     KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
     Gemm<MLFloat16>);
 
+bool GemmUseBf16Compute(const OpKernelInfo& info) {
+  return info.GetConfigOptions().GetConfigOrDefault(kOrtSessionOptionsMlasGemmFastMathBf16, "0") == "1" &&
+         MlasBf16AccelerationSupported();
+}
+
+namespace {
+
+// The int4 weights use blocks of 32 values with a scale and a zero point each.
+constexpr MLAS_BLK_QUANT_TYPE kGemmWeightQ4Type = BlkQ4Zp8;
+
+// The int8 weights are stored as the scales of the N columns, followed by B in the layout of MlasGemmPackB (or
+// row major if MLAS does not pack B on this platform).
+size_t GemmQuantizedBInt8Offset(size_t N) {
+  return (N * sizeof(float) + 63) & ~size_t{63};
+}
+
+// The U8S8 kernels of AVX2 without VNNI saturate the sums of pairs of products, so B is then stored unsigned with a
+// zero point of 128 and multiplied by the U8U8 kernels.
+bool GemmQuantizedBInt8IsSigned() {
+  return !MlasPlatformU8S8Overflow();
+}
+
+// Size of the (K, N) matrix B packed by GemmPackBFp32 or GemmQuantizeBFp32, 0 if it is not packed.
+size_t GemmPackedBSize(GemmWeightQuantization quantization, bool use_bf16_compute, size_t N, size_t K) {
+  switch (quantization) {
+    case GemmWeightQuantization::kNone:
+      return use_bf16_compute ? MlasSBGemmPackBSize(N, K) : MlasGemmPackBSize(N, K);
+    case GemmWeightQuantization::kInt4:
+      return MlasQ4GemmPackBSize(kGemmWeightQ4Type, N, K);
+    case GemmWeightQuantization::kInt8: {
+      const size_t mlas_packed_size = MlasGemmPackBSize(N, K, false, GemmQuantizedBInt8IsSigned());
+      return GemmQuantizedBInt8Offset(N) + (mlas_packed_size != 0 ? mlas_packed_size : K * N);
+    }
+  }
+  return 0;
+}
+
+// Layouts of a packed B, see GemmAddPackedB.
+enum class GemmPackedBFormat : uint32_t {
+  kFp32 = 1,
+  kBf16 = 2,
+  kInt8Signed = 3,
+  kInt8Unsigned = 4,
+  kInt4 = 5,
+};
+
+GemmPackedBFormat GemmGetPackedBFormat(GemmWeightQuantization quantization, bool use_bf16_compute) {
+  switch (quantization) {
+    case GemmWeightQuantization::kInt8:
+      return GemmQuantizedBInt8IsSigned() ? GemmPackedBFormat::kInt8Signed : GemmPackedBFormat::kInt8Unsigned;
+    case GemmWeightQuantization::kInt4:
+      return GemmPackedBFormat::kInt4;
+    default:
+      return use_bf16_compute ? GemmPackedBFormat::kBf16 : GemmPackedBFormat::kFp32;
+  }
+}
+
+// Second buffer stored by GemmAddPackedB.
+struct GemmPackedBInfo {
+  uint32_t format;
+  uint32_t reserved;
+  uint64_t size;
+};
+
+}  // namespace
+
+void GemmAddPackedB(AllocatorPtr& alloc,
+                    IAllocatorUniquePtr<void>& packed_b,
+                    size_t packed_b_size,
+                    GemmWeightQuantization quantization,
+                    bool use_bf16_compute,
+                    PrePackedWeights& prepacked_weights) {
+  auto info_buffer = IAllocator::MakeUniquePtr<void>(alloc, sizeof(GemmPackedBInfo), true);
+  GemmPackedBInfo info{};
+  info.format = static_cast<uint32_t>(GemmGetPackedBFormat(quantization, use_bf16_compute));
+  info.size = packed_b_size;
+  memcpy(info_buffer.get(), &info, sizeof(info));
+
+  prepacked_weights.buffers_.push_back(std::move(packed_b));
+  prepacked_weights.buffer_sizes_.push_back(packed_b_size);
+  prepacked_weights.buffers_.push_back(std::move(info_buffer));
+  prepacked_weights.buffer_sizes_.push_back(sizeof(GemmPackedBInfo));
+}
+
+bool GemmIsPersistedPackedBValid(const Tensor& tensor_b,
+                                 bool trans_b,
+                                 GemmWeightQuantization quantization,
+                                 bool use_bf16_compute,
+                                 const std::vector<BufferUniquePtr>& prepacked_buffers,
+                                 const std::vector<size_t>& prepacked_buffer_sizes) {
+  // only 2D weights are packed
+  const auto& b_shape = tensor_b.Shape();
+  if (b_shape.NumDimensions() != 2 || prepacked_buffers.size() != 2 || prepacked_buffer_sizes.size() != 2 ||
+      prepacked_buffers[0] == nullptr || prepacked_buffers[1] == nullptr ||
+      prepacked_buffer_sizes[1] != sizeof(GemmPackedBInfo)) {
+    return false;
+  }
+
+  GemmPackedBInfo info;
+  memcpy(&info, prepacked_buffers[1].get(), sizeof(info));
+
+  const size_t K = trans_b ? static_cast<size_t>(b_shape[1]) : static_cast<size_t>(b_shape[0]);
+  const size_t N = trans_b ? static_cast<size_t>(b_shape[0]) : static_cast<size_t>(b_shape[1]);
+  const size_t expected_size = GemmPackedBSize(quantization, use_bf16_compute, N, K);
+  return info.format == static_cast<uint32_t>(GemmGetPackedBFormat(quantization, use_bf16_compute)) &&
+         expected_size != 0 && info.size == expected_size && prepacked_buffer_sizes[0] == expected_size;
+}
+
 bool GemmPackBFp32(AllocatorPtr& alloc,
                    const Tensor& tensor_b,
                    bool trans_b,
                    IAllocatorUniquePtr<void>& packed_b,
                    size_t& packed_b_size,
-                   TensorShape& b_shape) {
+                   TensorShape& b_shape,
+                   bool use_bf16_compute) {
   // Only handle the common case of a 2D weight matrix. Additional matrices
   // could be handled by stacking the packed buffers.
   if (tensor_b.Shape().NumDimensions() != 2) {
@@ -116,7 +228,7 @@ bool GemmPackBFp32(AllocatorPtr& alloc,
   const size_t K = trans_b ? static_cast<size_t>(b_shape[1]) : static_cast<size_t>(b_shape[0]);
   const size_t N = trans_b ? static_cast<size_t>(b_shape[0]) : static_cast<size_t>(b_shape[1]);
 
-  packed_b_size = MlasGemmPackBSize(N, K);
+  packed_b_size = GemmPackedBSize(GemmWeightQuantization::kNone, use_bf16_compute, N, K);
   if (packed_b_size == 0) {
     return false;
   }
@@ -129,15 +241,172 @@ bool GemmPackBFp32(AllocatorPtr& alloc,
   // if and when we try to cache this pre-packed buffer for sharing between sessions.
   memset(packed_b_data, 0, packed_b_size);
 
-  MlasGemmPackB(trans_b ? CblasTrans : CblasNoTrans,
-                N,
-                K,
-                tensor_b.Data<float>(),
-                trans_b ? K : N,
-                packed_b_data);
+  if (use_bf16_compute) {
+    MlasSBGemmPackB(trans_b ? CblasTrans : CblasNoTrans,
+                    N,
+                    K,
+                    tensor_b.Data<float>(),
+                    trans_b ? K : N,
+                    packed_b_data);
+  } else {
+    MlasGemmPackB(trans_b ? CblasTrans : CblasNoTrans,
+                  N,
+                  K,
+                  tensor_b.Data<float>(),
+                  trans_b ? K : N,
+                  packed_b_data);
+  }
+  return true;
+}
+
+GemmWeightQuantization GemmGetWeightQuantization(const OpKernelInfo& info) {
+  const std::string quantization =
+      info.GetConfigOptions().GetConfigOrDefault(kOrtSessionOptionsMatMulWeightQuantization, "");
+  if (quantization.empty()) {
+    return GemmWeightQuantization::kNone;
+  }
+  if (quantization == "int8") {
+    return GemmWeightQuantization::kInt8;
+  }
+  if (quantization == "int4") {
+    return GemmWeightQuantization::kInt4;
+  }
+  ORT_THROW("Unsupported value for ", kOrtSessionOptionsMatMulWeightQuantization, ": ", quantization,
+            ". Expected \"int8\" or \"int4\".");
+}
+
+bool GemmQuantizeBFp32(AllocatorPtr& alloc,
+                       const Tensor& tensor_b,
+                       bool trans_b,
+                       float alpha,
+                       GemmWeightQuantization quantization,
+                       IAllocatorUniquePtr<void>& packed_b,
+                       size_t& packed_b_size,
+                       TensorShape& b_shape) {
+  if (quantization == GemmWeightQuantization::kNone || tensor_b.Shape().NumDimensions() != 2) {
+    return false;
+  }
+  b_shape = tensor_b.Shape();
+
+  const size_t K = trans_b ? static_cast<size_t>(b_shape[1]) : static_cast<size_t>(b_shape[0]);
+  const size_t N = trans_b ? static_cast<size_t>(b_shape[0]) : static_cast<size_t>(b_shape[1]);
+  if (K == 0 || N == 0) {
+    return false;
+  }
+
+  const float* b_data = tensor_b.Data<float>();
+  auto b_value = [&](size_t k, size_t n) { return trans_b ? b_data[n * K + k] : b_data[k * N + n]; };
+
+  if (quantization == GemmWeightQuantization::kInt4) {
+    packed_b_size = GemmPackedBSize(quantization, false, N, K);
+    if (packed_b_size == 0) {
+      return false;
+    }
+
+    // MlasQ4GemmPackB reads a row major (K, N) matrix, so make a copy of B if it is transposed or scaled
+    std::vector<float> b_copy;
+    if (trans_b || alpha != 1.0f) {
+      b_copy.resize(K * N);
+      for (size_t k = 0; k < K; k++) {
+        for (size_t n = 0; n < N; n++) {
+          b_copy[k * N + n] = alpha * b_value(k, n);
+        }
+      }
+      b_data = b_copy.data();
+    }
+
+    packed_b = IAllocator::MakeUniquePtr<void>(alloc, packed_b_size, true);
+    memset(packed_b.get(), 0, packed_b_size);
+    MlasQ4GemmPackB(kGemmWeightQ4Type, packed_b.get(), b_data, N, K, N);
+    return true;
+  }
+
+  std::vector<float> max_abs(N, 0.0f);
+  for (size_t k = 0; k < K; k++) {
+    for (size_t n = 0; n < N; n++) {
+      max_abs[n] = std::max(max_abs[n], std::fabs(b_value(k, n)));
+    }
+  }
+
+  const bool b_is_signed = GemmQuantizedBInt8IsSigned();
+  const int32_t zero_point = b_is_signed ? 0 : 128;
+  std::vector<uint8_t> b_quantized(K * N);
+  std::vector<float> scales(N);
+  for (size_t n = 0; n < N; n++) {
+    const float scale = max_abs[n] > 0.0f ? max_abs[n] / 127.0f : 1.0f;
+    for (size_t k = 0; k < K; k++) {
+      const int32_t value = static_cast<int32_t>(std::nearbyintf(b_value(k, n) / scale));
+      b_quantized[k * N + n] = static_cast<uint8_t>(std::clamp(value, -127, 127) + zero_point);
+    }
+    scales[n] = scale * alpha;
+  }
+
+  const size_t b_offset = GemmQuantizedBInt8Offset(N);
+  const size_t mlas_packed_size = MlasGemmPackBSize(N, K, false, b_is_signed);
+  packed_b_size = GemmPackedBSize(quantization, false, N, K);
+  packed_b = IAllocator::MakeUniquePtr<void>(alloc, packed_b_size, true);
+  auto* packed_b_data = static_cast<uint8_t*>(packed_b.get());
+  memset(packed_b_data, 0, packed_b_size);
+
+  memcpy(packed_b_data, scales.data(), N * sizeof(float));
+  if (mlas_packed_size != 0) {
+    MlasGemmPackB(N, K, b_quantized.data(), N, false, b_is_signed, packed_b_data + b_offset);
+  } else {
+    memcpy(packed_b_data + b_offset, b_quantized.data(), K * N);
+  }
   return true;
 }
 
+void GemmQuantizedBFp32(GemmWeightQuantization quantization,
+                        size_t M,
+                        size_t N,
+                        size_t K,
+                        const float* a_data,
+                        size_t lda,
+                        const void* packed_b,
+                        const float* bias,
+                        float* c_data,
+                        size_t ldc,
+                        concurrency::ThreadPool* thread_pool) {
+  if (quantization == GemmWeightQuantization::kInt4) {
+    MLAS_Q4_GEMM_DATA_PARAMS data;
+    data.A = a_data;
+    data.lda = lda;
+    data.B = packed_b;
+    data.Bias = bias;
+    data.C = c_data;
+    data.ldc = ldc;
+    MlasQ4GemmBatch(kGemmWeightQ4Type, M, N, K, 1, &data, thread_pool);
+    return;
+  }
+
+  ORT_ENFORCE(quantization == GemmWeightQuantization::kInt8);
+
+  const bool b_is_signed = GemmQuantizedBInt8IsSigned();
+  const uint8_t zero_point_b = b_is_signed ? 0 : 128;
+  const auto* packed_b_data = static_cast<const uint8_t*>(packed_b);
+
+  MLAS_GEMM_QUANT_SHAPE_PARAMS shape;
+  shape.M = M;
+  shape.N = N;
+  shape.K = K;
+  shape.BIsSigned = b_is_signed;
+
+  MLAS_GEMM_DYNAMIC_QUANT_DATA_PARAMS data;
+  data.A = a_data;
+  data.lda = lda;
+  data.B = packed_b_data + GemmQuantizedBInt8Offset(N);
+  data.ldb = N;
+  data.BIsPacked = MlasGemmPackBSize(N, K, false, b_is_signed) != 0;
+  data.ZeroPointB = &zero_point_b;
+  data.ScaleB = reinterpret_cast<const float*>(packed_b_data);
+  data.PerColumnScaleB = true;
+  data.Bias = bias;
+  data.C = c_data;
+  data.ldc = ldc;
+  MlasDynamicQuantizeGemmBatch(shape, &data, 1, /*PerRowScaleA*/ true, thread_pool);
+}
+
 template <typename T>
 void Gemm<T>::ComputeGemm(CBLAS_TRANSPOSE trans_a, CBLAS_TRANSPOSE trans_b,
                           ptrdiff_t M, ptrdiff_t N, ptrdiff_t K,
@@ -253,11 +522,16 @@ Status Gemm<float>::PrePack(const Tensor& tensor, int input_idx,
   // only pack Matrix B
   if (input_idx == 1) {
     size_t packed_b_size;
-    is_packed = GemmPackBFp32(alloc, tensor, trans_B_ != CblasNoTrans, packed_b_, packed_b_size, b_shape_);
+    if (weight_quantization_ != GemmWeightQuantization::kNone) {
+      is_packed = GemmQuantizeBFp32(alloc, tensor, trans_B_ != CblasNoTrans, alpha_, weight_quantization_, packed_b_,
+                                    packed_b_size, b_shape_);
+    } else {
+      is_packed = GemmPackBFp32(alloc, tensor, trans_B_ != CblasNoTrans, packed_b_, packed_b_size, b_shape_,
+                                use_bf16_compute_);
+    }
     bool share_prepacked_weights = (prepacked_weights != nullptr);
     if (is_packed && share_prepacked_weights) {
-      prepacked_weights->buffers_.push_back(std::move(packed_b_));
-      prepacked_weights->buffer_sizes_.push_back(packed_b_size);
+      GemmAddPackedB(alloc, packed_b_, packed_b_size, weight_quantization_, use_bf16_compute_, *prepacked_weights);
     }
   }
   return Status::OK();
@@ -284,6 +558,31 @@ Status Gemm<float>::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prep
   return Status::OK();
 }
 
+template <typename T>
+Status Gemm<T>::UsePersistedPrePackedBuffers(const Tensor& /*tensor*/, int /*input_idx*/,
+                                             std::vector<BufferUniquePtr>& /*prepacked_buffers*/,
+                                             const std::vector<size_t>& /*prepacked_buffer_sizes*/,
+                                             /*out*/ bool& used_prepacked_buffers) {
+  used_prepacked_buffers = false;
+  return Status::OK();
+}
+
+template <>
+Status Gemm<float>::UsePersistedPrePackedBuffers(const Tensor& tensor, int input_idx,
+                                                 std::vector<BufferUniquePtr>& prepacked_buffers,
+                                                 const std::vector<size_t>& prepacked_buffer_sizes,
+                                                 /*out*/ bool& used_prepacked_buffers) {
+  used_prepacked_buffers = false;
+
+  if (input_idx == 1 && GemmIsPersistedPackedBValid(tensor, trans_B_ != CblasNoTrans, weight_quantization_,
+                                                    use_bf16_compute_, prepacked_buffers, prepacked_buffer_sizes)) {
+    used_prepacked_buffers = true;
+    b_shape_ = tensor.Shape();
+    packed_b_ = std::move(prepacked_buffers[0]);
+  }
+  return Status::OK();
+}
+
 template <typename T>
 void Gemm<T>::ComputeActivation(_Inout_updates_(y_size) T* y_data, ptrdiff_t y_size, _Inout_opt_ concurrency::ThreadPool* thread_pool) const {
   if (activation_) {
@@ -408,27 +707,93 @@ Status Gemm<float>::Compute(OpKernelContext* context) const {
   const float* c_data = C != nullptr ? C->Data<float>() : nullptr;
   const TensorShape* c_shape = C != nullptr ? &C->Shape() : nullptr;
 
-  if (B) {
-    ComputeGemm(trans_A_, trans_B_, M, N, K, alpha_, A->Data<float>(), B->Data<float>(), beta_,
-                c_data, c_shape, y_data, thread_pool);
-  } else {
+  if (packed_b_ && weight_quantization_ != GemmWeightQuantization::kNone) {
+    // alpha is applied to the quantized B. A bias vector is added by the quantized GEMM, other shapes of C after it.
+    const bool c_is_bias = c_data != nullptr && beta_ == 1.0f && c_shape->Size() == N &&
+                           (c_shape->NumDimensions() == 1 || (*c_shape)[0] == 1);
+    GemmQuantizedBFp32(weight_quantization_, static_cast<size_t>(M), static_cast<size_t>(N), static_cast<size_t>(K),
+                       A->Data<float>(), static_cast<size_t>(K), packed_b_.get(), c_is_bias ? c_data : nullptr,
+                       y_data, static_cast<size_t>(N), thread_pool);
+    if (c_data != nullptr && !c_is_bias && beta_ != 0.0f) {
+      AllocatorPtr alloc;
+      ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&alloc));
+      auto broadcast_c = IAllocator::MakeUniquePtr<float>(alloc, SafeInt<size_t>(M) * N);
+      GemmBroadcastBias(M, N, beta_, c_data, c_shape, broadcast_c.get());
+      EigenVectorArrayMap<float>(y_data, M * N) += beta_ * ConstEigenVectorArrayMap<float>(broadcast_c.get(), M * N);
+    }
+    ComputeActivation(y_data, SafeInt<size_t>(M) * N, thread_pool);
+    return Status::OK();
+  }
+
+  if (use_bf16_compute_) {
     GemmBroadcastBias(M, N, beta_, c_data, c_shape, y_data);
-    MlasGemm(
-        trans_A_,
-        static_cast<size_t>(M),
-        static_cast<size_t>(N),
-        static_cast<size_t>(K),
-        alpha_,
-        A->Data<float>(),
-        static_cast<size_t>(trans_A_ != CblasNoTrans ? M : K),
-        packed_b_.get(),
-        c_data != nullptr ? beta_ : 0.0f,
-        y_data,
-        static_cast<size_t>(N),
-        thread_pool);
+    MLAS_SGEMM_DATA_PARAMS data;
+    data.A = A->Data<float>();
+    data.lda = static_cast<size_t>(trans_A_ != CblasNoTrans ? M : K);
+    if (B) {
+      data.B = B->Data<float>();
+      data.ldb = static_cast<size_t>(trans_B_ != CblasNoTrans ? K : N);
+    } else {
+      data.B = static_cast<const float*>(packed_b_.get());
+      data.BIsPacked = true;
+    }
+    data.C = y_data;
+    data.ldc = static_cast<size_t>(N);
+    data.alpha = alpha_;
+    data.beta = c_data != nullptr ? beta_ : 0.0f;
+    MlasSBGemmBatch(trans_A_, trans_B_, static_cast<size_t>(M), static_cast<size_t>(N), static_cast<size_t>(K),
+                    &data, 1, thread_pool);
+    ComputeActivation(y_data, SafeInt<size_t>(M) * N, thread_pool);
+    return Status::OK();
   }
 
-  ComputeActivation(y_data, SafeInt<size_t>(M) * N, thread_pool);
+  // Apply the bias and the activation to each output tile from the MLAS epilogue instead of making separate
+  // passes over the output.
+  MLAS_SGEMM_EPILOGUE epilogue;
+  float beta = c_data != nullptr ? beta_ : 0.0f;
+
+  if (c_data != nullptr && beta_ == 1.0f && c_shape->Size() != 1) {
+    if (c_shape->NumDimensions() == 1 || (*c_shape)[0] == 1) {
+      // C is (N,) or (1, N)
+      epilogue.Bias = c_data;
+      beta = 0.0f;
+    } else if ((*c_shape)[1] != 1) {
+      // C is (M, N)
+      epilogue.Residual = c_data;
+      epilogue.ldr = static_cast<size_t>(N);
+      beta = 0.0f;
+    }
+  }
+
+  if (beta != 0.0f) {
+    GemmBroadcastBias(M, N, beta_, c_data, c_shape, y_data);
+  }
+
+  if (mlas_activation_.has_value()) {
+    epilogue.Activation = &*mlas_activation_;
+  }
+
+  MLAS_SGEMM_DATA_PARAMS data;
+  data.A = A->Data<float>();
+  data.lda = static_cast<size_t>(trans_A_ != CblasNoTrans ? M : K);
+  if (B) {
+    data.B = B->Data<float>();
+    data.ldb = static_cast<size_t>(trans_B_ != CblasNoTrans ? K : N);
+  } else {
+    data.B = static_cast<const float*>(packed_b_.get());
+    data.BIsPacked = true;
+  }
+  data.C = y_data;
+  data.ldc = static_cast<size_t>(N);
+  data.alpha = alpha_;
+  data.beta = beta;
+  data.Epilogue = &epilogue;
+  MlasGemmBatch(trans_A_, trans_B_, static_cast<size_t>(M), static_cast<size_t>(N), static_cast<size_t>(K),
+                &data, 1, thread_pool);
+
+  if (!mlas_activation_.has_value()) {
+    ComputeActivation(y_data, SafeInt<size_t>(M) * N, thread_pool);
+  }
 
   return Status::OK();
 }
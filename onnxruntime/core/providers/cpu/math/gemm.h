@@ -3,12 +3,16 @@
 
 #pragma once
 
+#include <optional>
+
 #include "gemm_base.h"
 
 #include "core/framework/op_kernel.h"
 #include "core/common/common.h"
 #include "core/util/math.h"
 #include "core/providers/cpu/activation/activations.h"
+#include "core/providers/cpu/math/gemm_matmul_common.h"
+#include "core/mlas/inc/mlas.h"
 
 namespace onnxruntime {
 
@@ -16,6 +20,13 @@ template <typename T>
 class Gemm : protected GemmBase, public OpKernel {
  public:
   Gemm(const OpKernelInfo& info) : GemmBase(info), OpKernel(info) {
+    if constexpr (std::is_same_v<T, float>) {
+      use_bf16_compute_ = GemmUseBf16Compute(info);
+      // the quantized GEMMs do not transpose A
+      if (trans_A_ == CblasNoTrans) {
+        weight_quantization_ = GemmGetWeightQuantization(info);
+      }
+    }
   }
 
   Status Compute(OpKernelContext* context) const override;
@@ -28,6 +39,11 @@ class Gemm : protected GemmBase, public OpKernel {
                                    int input_idx,
                                    /*out*/ bool& used_shared_buffers) override;
 
+  Status UsePersistedPrePackedBuffers(const Tensor& tensor, int input_idx,
+                                      std::vector<BufferUniquePtr>& prepacked_buffers,
+                                      const std::vector<size_t>& prepacked_buffer_sizes,
+                                      /*out*/ bool& used_prepacked_buffers) override;
+
   static void ComputeGemm(CBLAS_TRANSPOSE trans_a, CBLAS_TRANSPOSE trans_b,
                           ptrdiff_t M, ptrdiff_t N, ptrdiff_t K,
                           T alpha,
@@ -40,9 +56,17 @@ class Gemm : protected GemmBase, public OpKernel {
  protected:
   TensorShape b_shape_;
   IAllocatorUniquePtr<void> packed_b_;
+  // Multiply with MlasSBGemmBatch (see kOrtSessionOptionsMlasGemmFastMathBf16). packed_b_ is then in its layout.
+  bool use_bf16_compute_{false};
+  // Quantize B by the pre-packing (see kOrtSessionOptionsMatMulWeightQuantization). packed_b_ is then in the layout
+  // of GemmQuantizeBFp32.
+  GemmWeightQuantization weight_quantization_{GemmWeightQuantization::kNone};
 
   // For fused gemm + activation
   std::unique_ptr<functors::ElementWiseRangedTransform<T>> activation_;
+  // For fused gemm + activation when the activation can be applied by the MLAS SGEMM epilogue. activation_ is
+  // then only used by the paths that do not support the epilogue.
+  std::optional<MLAS_ACTIVATION> mlas_activation_;
 
   void ComputeActivation(_Inout_updates_(y_size) T* y_data, ptrdiff_t y_size, _Inout_opt_ concurrency::ThreadPool* thread_pool) const;
 };
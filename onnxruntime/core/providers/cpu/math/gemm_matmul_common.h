@@ -7,11 +7,69 @@
 
 namespace onnxruntime {
 
+// Returns true if the session enables kOrtSessionOptionsMlasGemmFastMathBf16 and MLAS has a bfloat16 GEMM
+// kernel for this machine.
+bool GemmUseBf16Compute(const OpKernelInfo& info);
+
+// Packs B with MlasGemmPackB, or with MlasSBGemmPackB for use by MlasSBGemmBatch if use_bf16_compute is set.
 bool GemmPackBFp32(AllocatorPtr& alloc,
                    const Tensor& tensor_b,
                    bool trans_b,
                    IAllocatorUniquePtr<void>& packed_b,
                    size_t& packed_b_size,
-                   TensorShape& b_shape);
+                   TensorShape& b_shape,
+                   bool use_bf16_compute = false);
+
+// Quantization of the constant B input of the fp32 MatMul and Gemm kernels by the pre-packing, see
+// kOrtSessionOptionsMatMulWeightQuantization.
+enum class GemmWeightQuantization {
+  kNone,
+  kInt8,
+  kInt4,
+};
+
+GemmWeightQuantization GemmGetWeightQuantization(const OpKernelInfo& info);
+
+// Quantizes alpha * B to packed_b for GemmQuantizedBFp32. Returns false if B is not a 2D matrix.
+bool GemmQuantizeBFp32(AllocatorPtr& alloc,
+                       const Tensor& tensor_b,
+                       bool trans_b,
+                       float alpha,
+                       GemmWeightQuantization quantization,
+                       IAllocatorUniquePtr<void>& packed_b,
+                       size_t& packed_b_size,
+                       TensorShape& b_shape);
+
+// Adds B packed by GemmPackBFp32 or GemmQuantizeBFp32 to prepacked_weights, followed by a second buffer that records
+// its layout. The layout depends on the session options and on the platform, so a B persisted by another session
+// (see kOrtSessionOptionsConfigPrepackedWeightsCacheDir) is only used if GemmIsPersistedPackedBValid accepts it.
+void GemmAddPackedB(AllocatorPtr& alloc,
+                    IAllocatorUniquePtr<void>& packed_b,
+                    size_t packed_b_size,
+                    GemmWeightQuantization quantization,
+                    bool use_bf16_compute,
+                    PrePackedWeights& prepacked_weights);
+
+// Returns true if buffers stored by GemmAddPackedB hold tensor_b packed in the layout this session packs it in.
+bool GemmIsPersistedPackedBValid(const Tensor& tensor_b,
+                                 bool trans_b,
+                                 GemmWeightQuantization quantization,
+                                 bool use_bf16_compute,
+                                 const std::vector<BufferUniquePtr>& prepacked_buffers,
+                                 const std::vector<size_t>& prepacked_buffer_sizes);
+
+// Computes C = A * B + bias, with the (M, K) matrix A, the (K, N) matrix B quantized by GemmQuantizeBFp32 and the
+// optional bias vector of N values.
+void GemmQuantizedBFp32(GemmWeightQuantization quantization,
+                        size_t M,
+                        size_t N,
+                        size_t K,
+                        const float* a_data,
+                        size_t lda,
+                        const void* packed_b,
+                        const float* bias,
+                        float* c_data,
+                        size_t ldc,
+                        concurrency::ThreadPool* thread_pool);
 
 };  // namespace onnxruntime
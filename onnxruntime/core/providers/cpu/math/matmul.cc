@@ -134,11 +134,16 @@ Status MatMul<float>::PrePack(const Tensor& tensor, int input_idx, /*out*/ Alloc
   // only pack Matrix B
   if (input_idx == 1) {
     size_t packed_b_size;
-    is_packed = GemmPackBFp32(alloc, tensor, trans_b_attr_ != 0, packed_b_, packed_b_size, b_shape_);
+    if (weight_quantization_ != GemmWeightQuantization::kNone) {
+      is_packed = GemmQuantizeBFp32(alloc, tensor, trans_b_attr_ != 0, alpha_attr_, weight_quantization_, packed_b_,
+                                    packed_b_size, b_shape_);
+    } else {
+      is_packed = GemmPackBFp32(alloc, tensor, trans_b_attr_ != 0, packed_b_, packed_b_size, b_shape_,
+                                use_bf16_compute_);
+    }
     bool share_prepacked_weights = (prepacked_weights != nullptr);
     if (is_packed && share_prepacked_weights) {
-      prepacked_weights->buffers_.push_back(std::move(packed_b_));
-      prepacked_weights->buffer_sizes_.push_back(packed_b_size);
+      GemmAddPackedB(alloc, packed_b_, packed_b_size, weight_quantization_, use_bf16_compute_, *prepacked_weights);
     }
   }
   return Status::OK();
@@ -157,6 +162,22 @@ Status MatMul<float>::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& pr
   return Status::OK();
 }
 
+Status MatMul<float>::UsePersistedPrePackedBuffers(const Tensor& tensor, int input_idx,
+                                                   std::vector<BufferUniquePtr>& prepacked_buffers,
+                                                   const std::vector<size_t>& prepacked_buffer_sizes,
+                                                   /*out*/ bool& used_prepacked_buffers) {
+  used_prepacked_buffers = false;
+
+  if (input_idx == 1 && GemmIsPersistedPackedBValid(tensor, trans_b_attr_ != 0, weight_quantization_,
+                                                    use_bf16_compute_, prepacked_buffers, prepacked_buffer_sizes)) {
+    used_prepacked_buffers = true;
+    b_shape_ = tensor.Shape();
+    packed_b_ = std::move(prepacked_buffers[0]);
+  }
+
+  return Status::OK();
+}
+
 Status MatMul<float>::Compute(OpKernelContext* ctx) const {
   concurrency::ThreadPool* thread_pool = ctx->GetOperatorThreadPool();
 
@@ -187,6 +208,15 @@ Status MatMul<float>::Compute(OpKernelContext* ctx) const {
   const size_t lda = helper.Lda(trans_a);
   const size_t ldb = helper.Ldb(trans_b);
 
+  if (packed_b_ && weight_quantization_ != GemmWeightQuantization::kNone) {
+    // alpha is applied to the quantized B
+    for (size_t i = 0; i < max_len; i++) {
+      GemmQuantizedBFp32(weight_quantization_, M, N, K, a_data + helper.LeftOffsets()[i], lda, packed_b_.get(),
+                         nullptr, y_data + helper.OutputOffsets()[i], N, thread_pool);
+    }
+    return Status::OK();
+  }
+
   std::vector<MLAS_SGEMM_DATA_PARAMS> data(max_len);
   for (size_t i = 0; i < max_len; i++) {
     data[i].BIsPacked = bool(packed_b_);
@@ -199,8 +229,13 @@ Status MatMul<float>::Compute(OpKernelContext* ctx) const {
     data[i].alpha = alpha_attr_;
     data[i].beta = 0.0f;
   }
-  MlasGemmBatch(trans_a ? CblasTrans : CblasNoTrans, trans_b ? CblasTrans : CblasNoTrans,
-                M, N, K, data.data(), max_len, thread_pool);
+  if (use_bf16_compute_) {
+    MlasSBGemmBatch(trans_a ? CblasTrans : CblasNoTrans, trans_b ? CblasTrans : CblasNoTrans,
+                    M, N, K, data.data(), max_len, thread_pool);
+  } else {
+    MlasGemmBatch(trans_a ? CblasTrans : CblasNoTrans, trans_b ? CblasTrans : CblasNoTrans,
+                  M, N, K, data.data(), max_len, thread_pool);
+  }
 
   return Status::OK();
 }
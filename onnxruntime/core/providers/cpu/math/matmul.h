@@ -4,6 +4,7 @@
 #pragma once
 
 #include "core/framework/op_kernel.h"
+#include "core/providers/cpu/math/gemm_matmul_common.h"
 
 namespace onnxruntime {
 
@@ -27,6 +28,11 @@ class MatMul<float> final : public OpKernel {
     info.GetAttrOrDefault<int64_t>("transBatchB", &trans_batch_b_attr, 0);
     trans_batch_a_ = trans_batch_a_attr != 0;
     trans_batch_b_ = trans_batch_b_attr != 0;
+    use_bf16_compute_ = GemmUseBf16Compute(info);
+    // the quantized GEMMs do not transpose A
+    if (trans_a_attr_ == 0 && !trans_batch_a_ && !trans_batch_b_) {
+      weight_quantization_ = GemmGetWeightQuantization(info);
+    }
   }
 
   Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
@@ -36,11 +42,21 @@ class MatMul<float> final : public OpKernel {
   Status UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers, int input_idx,
                                    /*out*/ bool& used_shared_buffers) override;
 
+  Status UsePersistedPrePackedBuffers(const Tensor& tensor, int input_idx,
+                                      std::vector<BufferUniquePtr>& prepacked_buffers,
+                                      const std::vector<size_t>& prepacked_buffer_sizes,
+                                      /*out*/ bool& used_prepacked_buffers) override;
+
   Status Compute(OpKernelContext* context) const override;
 
  private:
   TensorShape b_shape_;
   IAllocatorUniquePtr<void> packed_b_;
+  // Multiply with MlasSBGemmBatch (see kOrtSessionOptionsMlasGemmFastMathBf16). packed_b_ is then in its layout.
+  bool use_bf16_compute_;
+  // Quantize B by the pre-packing (see kOrtSessionOptionsMatMulWeightQuantization). packed_b_ is then in the layout
+  // of GemmQuantizeBFp32.
+  GemmWeightQuantization weight_quantization_{GemmWeightQuantization::kNone};
 
   // For FusedMatMul contrib ops
   float alpha_attr_;
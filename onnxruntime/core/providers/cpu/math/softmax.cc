@@ -3,6 +3,7 @@
 
 #include "core/providers/cpu/math/softmax.h"
 #include "core/providers/cpu/tensor/transpose.h"
+#include "core/mlas/inc/mlas.h"
 #include <vector>
 #include <numeric>
 
@@ -108,6 +109,54 @@ ONNX_CPU_OPERATOR_TYPED_KERNEL(
     KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<double>()),
     Softmax<double>);
 
+#ifdef MLAS_F16VEC_INTRINSICS_SUPPORTED
+ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
+    Softmax,
+    1,
+    10,
+    MLFloat16,
+    KernelDefBuilder().MayInplace(0, 0).TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    Softmax<MLFloat16>);
+
+ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
+    Softmax,
+    11,
+    12,
+    MLFloat16,
+    KernelDefBuilder().MayInplace(0, 0).TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    Softmax<MLFloat16>);
+
+ONNX_CPU_OPERATOR_TYPED_KERNEL(
+    Softmax,
+    13,
+    MLFloat16,
+    KernelDefBuilder().MayInplace(0, 0).TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    Softmax<MLFloat16>);
+
+ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
+    LogSoftmax,
+    1,
+    10,
+    MLFloat16,
+    KernelDefBuilder().MayInplace(0, 0).TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    Softmax<MLFloat16>);
+
+ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
+    LogSoftmax,
+    11,
+    12,
+    MLFloat16,
+    KernelDefBuilder().MayInplace(0, 0).TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    Softmax<MLFloat16>);
+
+ONNX_CPU_OPERATOR_TYPED_KERNEL(
+    LogSoftmax,
+    13,
+    MLFloat16,
+    KernelDefBuilder().MayInplace(0, 0).TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    Softmax<MLFloat16>);
+#endif  // MLAS_F16VEC_INTRINSICS_SUPPORTED
+
 // opset-12 and below
 template <typename T>
 Status Softmax<T>::ComputeImpl(const Tensor& input, Tensor& output, size_t axis,
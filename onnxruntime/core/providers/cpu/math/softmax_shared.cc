@@ -24,6 +24,7 @@
 #include <cmath>
 #include "core/common/gsl.h"
 
+#include "core/framework/float16.h"
 #include "core/util/math.h"
 #include "core/util/math_cpuonly.h"
 #include "core/mlas/inc/mlas.h"
@@ -103,4 +104,18 @@ common::Status SoftmaxCPU<float>(size_t N,
   return Status::OK();
 }
 
+#ifdef MLAS_F16VEC_INTRINSICS_SUPPORTED
+template <>
+common::Status SoftmaxCPU<MLFloat16>(size_t N,
+                                     size_t D,
+                                     const MLFloat16* Xdata,
+                                     MLFloat16* Ydata,
+                                     bool logarithmic,
+                                     onnxruntime::concurrency::ThreadPool* thread_pool) {
+  MlasComputeHalfSoftmax(reinterpret_cast<const MLAS_FP16*>(Xdata), reinterpret_cast<MLAS_FP16*>(Ydata),
+                         N, D, logarithmic, thread_pool);
+  return Status::OK();
+}
+#endif  // MLAS_F16VEC_INTRINSICS_SUPPORTED
+
 }  // namespace onnxruntime
@@ -25,6 +25,7 @@
 #include <queue>
 #include <algorithm>
 #include <cmath>
+#include <numeric>
 #include <core/common/safeint.h>
 
 namespace onnxruntime {
@@ -140,6 +141,46 @@ static void SelectTopK(const Comparator& comparer,
   // the data_holder now contains the indices of the top k elements in the first k elements
 }
 
+// Elements each part of a row split over the threads holds at least, also no fewer than kMinPartSizeOverK * k
+constexpr int64_t kMinPartSize = 16 * 1024;
+constexpr int64_t kMinPartSizeOverK = 8;
+
+// Selects the top k elements of rows along the last axis with each row split in num_parts parts over the threads.
+// Each part selects its own top k elements, and the top k elements of the row are selected among these candidates.
+// The comparator orders equal values by index, so the selection is the same as over the whole row.
+template <class Comparator>
+static void FindTopKElementsOverParts(const typename Comparator::DataType* input_data, int64_t rows, int64_t cols,
+                                      const unsigned k, bool sorted, int64_t num_parts,
+                                      typename Comparator::DataType* values_data, int64_t* indices_data,
+                                      concurrency::ThreadPool* threadpool) {
+  Comparator comparer(input_data);
+  std::vector<int64_t> candidates(SafeInt<size_t>(num_parts) * k);
+
+  for (int64_t i = 0; i < rows; ++i) {
+    const int64_t row_offset = i * cols;
+    concurrency::ThreadPool::TrySimpleParallelFor(
+        threadpool, onnxruntime::narrow<std::ptrdiff_t>(num_parts), [&](std::ptrdiff_t part) {
+          auto work = concurrency::ThreadPool::PartitionWork(part, onnxruntime::narrow<std::ptrdiff_t>(num_parts),
+                                                             onnxruntime::narrow<std::ptrdiff_t>(cols));
+          std::vector<int64_t> data_holder(onnxruntime::narrow<size_t>(work.end - work.start));
+          std::iota(data_holder.begin(), data_holder.end(), row_offset + work.start);
+          std::nth_element(data_holder.begin(), data_holder.begin() + (k - 1), data_holder.end(), comparer);
+          std::copy_n(data_holder.begin(), k, candidates.begin() + part * k);
+        });
+
+    std::nth_element(candidates.begin(), candidates.begin() + (k - 1), candidates.end(), comparer);
+    if (sorted) {
+      std::sort(candidates.begin(), candidates.begin() + k, comparer);
+    }
+
+    for (unsigned l = 0; l < k; ++l) {
+      const int64_t idx = candidates[l];
+      values_data[i * k + l] = input_data[idx];
+      indices_data[i * k + l] = idx - row_offset;
+    }
+  }
+}
+
 // Given an input tensor 'input' and metadata values - 'k' and 'axis_parsed',
 // this method will extract the sorted top k largest/smallest elements and place them in the output tensor 'values'
 // along with the metadata output 'indices'
@@ -165,6 +206,17 @@ static void FindTopKElements(const Tensor* input, const TensorShape& input_shape
   const int64_t block_slice = reduced_cols / k;
 
   int64_t tp_threads = concurrency::ThreadPool::DegreeOfParallelism(threadpool);
+
+  // Fewer rows than threads along a long last axis, as the scores of a detection model, are split over the threads
+  if (block_slice == 1 && rows < tp_threads) {
+    const int64_t num_parts = std::min(tp_threads,
+                                       num_blocks / std::max(kMinPartSize, kMinPartSizeOverK * static_cast<int64_t>(k)));
+    if (num_parts > 1) {
+      FindTopKElementsOverParts<Comparator>(input_data, rows, cols, k, sorted, num_parts, values_data, indices_data,
+                                            threadpool);
+      return;
+    }
+  }
   int64_t num_threads = std::min(tp_threads, rows);  // split on rows so can't have more threads than rows
 
   // rough attempt to make sure there's enough work for each thread. if there's insufficient work the usage of
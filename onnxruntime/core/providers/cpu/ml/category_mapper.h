@@ -4,6 +4,7 @@
 #pragma once
 
 #include "core/common/common.h"
+#include "core/common/inlined_containers.h"
 #include "core/framework/op_kernel.h"
 #include "core/providers/cpu/ml/ml_common.h"
 
@@ -41,8 +42,8 @@ class CategoryMapper final : public OpKernel {
   Status Compute(OpKernelContext* context) const override;
 
  private:
-  std::unordered_map<std::string, int64_t> string_to_int_map_;
-  std::unordered_map<int64_t, std::string> int_to_string_map_;
+  InlinedHashMap<std::string, int64_t> string_to_int_map_;
+  InlinedHashMap<int64_t, std::string> int_to_string_map_;
 
   std::string default_string_;
   int64_t default_int_;
@@ -4,6 +4,7 @@
 #pragma once
 
 #include "core/common/common.h"
+#include "core/common/inlined_containers.h"
 #include "core/framework/op_kernel.h"
 #include "core/providers/cpu/ml/ml_common.h"
 
@@ -36,8 +37,8 @@ class LabelEncoder final : public OpKernel {
   Status Compute(OpKernelContext* context) const override;
 
  private:
-  std::unordered_map<std::string, int64_t> string_to_int_map_;
-  std::unordered_map<int64_t, std::string> int_to_string_map_;
+  InlinedHashMap<std::string, int64_t> string_to_int_map_;
+  InlinedHashMap<int64_t, std::string> int_to_string_map_;
 
   std::string default_string_;
   int64_t default_int_;
@@ -64,6 +65,7 @@ class LabelEncoder_2 final : public OpKernel {
                 "However, the number of key is ", num_keys, " and the number of ",
                 "values is ", num_values, ".");
 
+    _map.reserve(num_keys);
     for (size_t i = 0; i < num_keys; ++i)
       _map[keys[i]] = values[i];
   }
@@ -78,12 +80,10 @@ class LabelEncoder_2 final : public OpKernel {
     auto input = X.template DataAsSpan<TKey>();
     auto output = Y.template MutableDataAsSpan<TValue>();
 
-    for (int64_t i = 0; i < shape.Size(); ++i) {
-      const auto found = _map.find(input[onnxruntime::narrow<size_t>(i)]);
-      if (found == _map.end())
-        output[onnxruntime::narrow<size_t>(i)] = _default_value;
-      else
-        output[onnxruntime::narrow<size_t>(i)] = found->second;
+    const auto map_end = _map.end();
+    for (size_t i = 0, size = input.size(); i < size; ++i) {
+      const auto found = _map.find(input[i]);
+      output[i] = found == map_end ? _default_value : found->second;
     }
 
     return Status::OK();
@@ -98,7 +98,7 @@ class LabelEncoder_2 final : public OpKernel {
   // A collection of key-value pairs. Each (a_key, a_value) pair
   // means that the "a_key" in the input would be mapped to "a_value".
   // If _map doesn't contain "a_key", we use _default_value as its output.
-  std::unordered_map<TKey, TValue> _map;
+  InlinedHashMap<TKey, TValue> _map;
   TValue _default_value;
   // ONNX attribute name to load keys.
   std::string _key_field_name;
@@ -3,6 +3,7 @@
 
 #include "core/providers/cpu/ml/svmclassifier.h"
 #include "core/platform/threadpool.h"
+#include "core/util/math.h"
 // TODO: fix the warnings
 #if defined(_MSC_VER) && !defined(__clang__)
 // Chance of arithmetic overflow could be reduced
@@ -63,6 +64,7 @@ SVMClassifier::SVMClassifier(const OpKernelInfo& info)
   if (vector_count_ > 0) {
     feature_count_ = support_vectors_.size() / vector_count_;  // length of each support vector
     mode_ = SVM_TYPE::SVM_SVC;
+    set_support_vectors(support_vectors_, feature_count_);
   } else {
     feature_count_ = coefficients_.size() / class_count_;  // liblinear mode
     mode_ = SVM_TYPE::SVM_LINEAR;
@@ -74,6 +76,31 @@ SVMClassifier::SVMClassifier(const OpKernelInfo& info)
   ORT_ENFORCE(coefficients_.size() > 0);
   weights_are_all_positive_ = std::all_of(coefficients_.cbegin(), coefficients_.cend(),
                                           [](float value) { return value >= 0.f; });
+
+  // The classifier comparing classes i and j combines the kernels of the support vectors of class i with the
+  // coefficients of row j - 1, and the kernels of the support vectors of class j with the coefficients of row i.
+  // Expand that to a dense matrix unless it gets too large.
+  constexpr size_t kMaxClassifierCoefficients = size_t{1} << 22;
+  const size_t num_classifiers = onnxruntime::narrow<size_t>(class_count_ * (class_count_ - 1) / 2);
+  const size_t vector_count = onnxruntime::narrow<size_t>(vector_count_);
+  if (mode_ == SVM_TYPE::SVM_SVC && num_classifiers > 0 &&
+      vectors_per_class_.size() == static_cast<size_t>(class_count_) &&
+      rho_.size() >= num_classifiers &&
+      coefficients_.size() >= vector_count * static_cast<size_t>(class_count_ - 1) &&
+      vector_count * num_classifiers <= kMaxClassifierCoefficients) {
+    classifier_coefficients_.resize(vector_count * num_classifiers, 0.f);
+    size_t classifier_idx = 0;
+    for (ptrdiff_t i = 0; i < class_count_ - 1; i++) {
+      for (ptrdiff_t j = i + 1; j < class_count_; j++, classifier_idx++) {
+        for (int64_t v = starting_vector_[i], end = v + vectors_per_class_[i]; v < end; ++v) {
+          classifier_coefficients_[v * num_classifiers + classifier_idx] = coefficients_[vector_count * (j - 1) + v];
+        }
+        for (int64_t v = starting_vector_[j], end = v + vectors_per_class_[j]; v < end; ++v) {
+          classifier_coefficients_[v * num_classifiers + classifier_idx] = coefficients_[vector_count * i + v];
+        }
+      }
+    }
+  }
 }
 
 template <typename LabelType>
@@ -247,7 +274,33 @@ Status SVMClassifier::ComputeImpl(OpKernelContext& ctx,
     batched_kernel_dot<float>(x_data, support_vectors_, num_batches, vector_count_, feature_count_, 0.f, kernels_span,
                               threadpool);
 
-    for (int64_t n = 0; n < num_batches; n++) {
+    if (!classifier_coefficients_.empty()) {
+      // scores: kernels [num_batches, vector_count_] * classifier_coefficients_ [vector_count_, num_classifiers] + rho
+      float* cur_scores = classifier_scores.data();
+      for (int64_t n = 0; n < num_batches; n++, cur_scores += num_slots_per_iteration) {
+        std::copy_n(rho_.data(), num_classifiers, cur_scores);
+      }
+
+      math::GemmEx<float, concurrency::ThreadPool>(CblasNoTrans, CblasNoTrans,
+                                                   num_batches, num_classifiers, vector_count_,
+                                                   1.f, kernels_data.data(), narrow<int>(vector_count_),
+                                                   classifier_coefficients_.data(), narrow<int>(num_classifiers),
+                                                   1.f, classifier_scores.data(), narrow<int>(num_slots_per_iteration),
+                                                   threadpool);
+
+      cur_scores = classifier_scores.data();
+      int64_t* cur_votes = votes_data.data();
+      for (int64_t n = 0; n < num_batches; n++, cur_scores += num_slots_per_iteration, cur_votes += class_count_) {
+        const float* score = cur_scores;
+        for (int64_t i = 0; i < class_count_ - 1; i++) {
+          for (int64_t j = i + 1; j < class_count_; j++) {
+            ++cur_votes[*score++ > 0 ? i : j];
+          }
+        }
+      }
+    }
+
+    for (int64_t n = 0; classifier_coefficients_.empty() && n < num_batches; n++) {
       // reduce scores from kernels using coefficients, taking into account the varying number of support vectors
       // per class.
       // coefficients: [num_classes - 1, vector_count_]
@@ -307,10 +360,13 @@ Status SVMClassifier::ComputeImpl(OpKernelContext& ctx,
     }
   }
 
+  // without a second class to add, the post transform is applied to all the rows at once once they are classified
+  const bool batched_post_transform = write_additional_scores < 0 && num_scores_per_batch == final_scores_per_batch;
+
   auto finalize_batch = [this, &final_scores, final_scores_per_batch,
                          have_proba, &probsp2_data, class_count_squared,
                          &classifier_scores_data, num_classifiers, &votes_data, &Y,
-                         num_scores_per_batch, write_additional_scores](ptrdiff_t idx) {
+                         num_scores_per_batch, write_additional_scores, batched_post_transform](ptrdiff_t idx) {
     int n = SafeInt<int32_t>(idx);  // convert to a usable sized type
     auto cur_scores = final_scores.subspan(n * SafeInt<size_t>(final_scores_per_batch), onnxruntime::narrow<size_t>(final_scores_per_batch));
 
@@ -370,8 +426,10 @@ Status SVMClassifier::ComputeImpl(OpKernelContext& ctx,
 
     // write the score for this batch
     // as we parallelize the batch processing we want to update the final scores for each batch in the separate threads
-    batched_update_scores_inplace<float>(cur_scores, 1, num_scores_per_batch, post_transform_,
-                                         write_additional_scores, true, nullptr);
+    if (!batched_post_transform) {
+      batched_update_scores_inplace<float>(cur_scores, 1, num_scores_per_batch, post_transform_,
+                                           write_additional_scores, true, nullptr);
+    }
   };
 
   // TODO: Refine this rough metric to choose when to parallelize.
@@ -385,6 +443,11 @@ Status SVMClassifier::ComputeImpl(OpKernelContext& ctx,
     }
   }
 
+  if (batched_post_transform && post_transform_ != POST_EVAL_TRANSFORM::NONE) {
+    batched_update_scores_inplace<float>(final_scores, num_batches, num_scores_per_batch, post_transform_,
+                                         -1, false, threadpool);
+  }
+
   return Status::OK();
 }
 
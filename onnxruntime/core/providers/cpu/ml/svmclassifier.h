@@ -3,6 +3,9 @@
 
 #pragma once
 
+#include <algorithm>
+#include <type_traits>
+
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
 #include "core/util/math_cpuonly.h"
@@ -28,6 +31,23 @@ class SVMCommon {
   }
 
   void set_kernel_type(KERNEL new_kernel_type) { kernel_type_ = new_kernel_type; }
+
+  // The RBF kernel uses ||a - b||^2 = ||a||^2 + ||b||^2 - 2 a.b so that the dot products come from a single GEMM.
+  // Caches ||b||^2 for each support vector.
+  void set_support_vectors(gsl::span<const float> support_vectors, ptrdiff_t feature_count) {
+    support_vectors_squared_norms_.clear();
+    if (kernel_type_ != KERNEL::RBF || feature_count <= 0) {
+      return;
+    }
+    const size_t count = static_cast<size_t>(feature_count);
+    for (size_t start = 0; start + count <= support_vectors.size(); start += count) {
+      float norm = 0.f;
+      for (size_t feature = 0; feature < count; ++feature) {
+        norm += support_vectors[start + feature] * support_vectors[start + feature];
+      }
+      support_vectors_squared_norms_.push_back(norm);
+    }
+  }
   KERNEL get_kernel_type() const { return kernel_type_; }
 
   template <typename T>
@@ -38,7 +58,43 @@ class SVMCommon {
                           concurrency::ThreadPool* threadpool) const {
     assert(a.size() == size_t(m * k) && b.size() == size_t(k * n) && out.size() == size_t(m * n));
 
-    if (kernel_type_ == KERNEL::RBF) {
+    if (kernel_type_ == KERNEL::RBF && m > 1 && support_vectors_squared_norms_.size() == size_t(n)) {
+      const T gamma = static_cast<T>(gamma_);
+
+      // out = -2 a.b^T, then add ||a||^2 and ||b||^2
+      onnxruntime::Gemm<T>::ComputeGemm(CBLAS_TRANSPOSE::CblasNoTrans, CBLAS_TRANSPOSE::CblasTrans,
+                                        m, n, k,
+                                        T(-2), a.data(), b.data(), T(0),
+                                        nullptr, nullptr,
+                                        out.data(),
+                                        threadpool);
+
+      T* cur_out = out.data();
+      const T* cur_batch = a.data();
+      for (int64_t batch = 0; batch < m; ++batch) {
+        T batch_norm = T(0);
+        for (int64_t feature = 0; feature < k; ++feature) {
+          batch_norm += cur_batch[feature] * cur_batch[feature];
+        }
+
+        for (int64_t support_vector = 0; support_vector < n; ++support_vector, ++cur_out) {
+          // rounding errors can make the distance of close vectors slightly negative
+          T sum = std::max(*cur_out + batch_norm + static_cast<T>(support_vectors_squared_norms_[support_vector]),
+                           T(0));
+          *cur_out = -gamma * sum;
+        }
+
+        cur_batch += k;
+      }
+
+      if constexpr (std::is_same_v<T, float>) {
+        MlasComputeExp(out.data(), out.data(), out.size());
+      } else {
+        auto map_out = EigenVectorArrayMap<T>(out.data(), out.size());
+        map_out = map_out.exp();
+      }
+    } else if (kernel_type_ == KERNEL::RBF) {
+      const T gamma = static_cast<T>(gamma_);
       T* cur_out = out.data();
       const T* cur_batch = a.data();
 
@@ -48,7 +104,7 @@ class SVMCommon {
 
         // broadcast the support vectors against the k features in each batch. output is one value per support vector
         for (int64_t support_vector = 0; support_vector < n; ++support_vector) {
-          T sum = 0.f;
+          T sum = T(0);
           const T* cur_input = cur_batch;
 
           for (int64_t feature = 0; feature < k; ++feature) {
@@ -56,7 +112,7 @@ class SVMCommon {
             sum += val * val;
           }
 
-          *cur_out++ = std::exp(-gamma_ * sum);
+          *cur_out++ = std::exp(-gamma * sum);
         }
 
         cur_batch += k;  // move to start of next batch
@@ -100,12 +156,14 @@ class SVMCommon {
   float gamma_{0.f};
   float coef0_{0.f};
   float degree_{0.f};
+  std::vector<float> support_vectors_squared_norms_;
 };
 
 class SVMClassifier final : public OpKernel, private SVMCommon {
   using SVMCommon::batched_kernel_dot;
   using SVMCommon::get_kernel_type;
   using SVMCommon::set_kernel_type;
+  using SVMCommon::set_support_vectors;
 
  public:
   SVMClassifier(const OpKernelInfo& info);
@@ -126,6 +184,10 @@ class SVMClassifier final : public OpKernel, private SVMCommon {
   std::vector<float> probb_;
   std::vector<float> coefficients_;
   std::vector<float> support_vectors_;
+  // coefficients_ expanded to [vector_count_, num_classifiers] so that all the classifiers of all the rows are
+  // computed with a GEMM, a coefficient is 0 if its support vector is not used by the classifier.
+  // empty if the matrix would be too large.
+  std::vector<float> classifier_coefficients_;
   std::vector<int64_t> classlabels_ints_;
   std::vector<std::string> classlabels_strings_;
   POST_EVAL_TRANSFORM post_transform_;
@@ -98,6 +98,21 @@ struct TreeNodeElement {
   inline bool is_missing_track_true() const { return flags & MissingTrack::kTrue; }
 };
 
+// Compact encoding of a node, 8 bytes instead of the 16 to 24 bytes of TreeNodeElement.
+// The nodes of a tree are stored in depth first order with the true subtree first, so the true node
+// of a node is the next one. The threshold is replaced by its rank among the sorted distinct thresholds
+// of the feature, and the input is converted once per row to the same ranks (see TreeEnsembleCommon::BinRow).
+struct TreeNodeCompactElement {
+  static constexpr uint16_t kLeaf = 0xFFFF;
+
+  uint16_t feature_id;  // kLeaf for a leaf
+  uint16_t threshold_bin;
+  // offset of the false node if the node is not a leaf, the index of the leaf in the leaf table otherwise
+  uint32_t falsenode_inc_or_leaf;
+
+  inline bool is_not_leaf() const { return feature_id != kLeaf; }
+};
+
 template <typename InputType, typename ThresholdType, typename OutputType>
 class TreeAggregator {
  protected:
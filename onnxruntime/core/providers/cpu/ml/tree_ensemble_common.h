@@ -3,9 +3,14 @@
 
 #pragma once
 
+#include <algorithm>
+#include <functional>
+#include <limits>
+
 #include "tree_ensemble_aggregator.h"
 #include "core/platform/ort_mutex.h"
 #include "core/platform/threadpool.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 #include "tree_ensemble_helper.h"
 
 namespace onnxruntime {
@@ -29,6 +34,7 @@ class TreeEnsembleCommonAttributes {
   int64_t n_trees_;
   bool same_mode_;
   bool has_missing_tracks_;
+  bool batch_traversal_;  // walks blocks of rows through a tree together, see ProcessTreeNodeLeaves
   int parallel_tree_;    // starts parallelizing the computing by trees if n_tree >= parallel_tree_
   int parallel_tree_N_;  // batch size if parallelizing by trees
   int parallel_N_;       // starts parallelizing the computing by rows if n_rows <= parallel_N_
@@ -48,6 +54,24 @@ class TreeEnsembleCommon : public TreeEnsembleCommonAttributes {
   std::vector<SparseValue<ThresholdType>> weights_;
   std::vector<TreeNodeElement<ThresholdType>*> roots_;
 
+  // Compiled trees (kOrtSessionOptionsCompileTreeEnsembles). Every tree is expanded to a complete tree of depth
+  // compiled_depth_ stored in level order: node k has its children at 2k+1 (condition true) and 2k+2. A leaf above
+  // the last level is repeated in both subtrees. compiled_depth_ is 0 if the trees are not compiled.
+  bool compile_trees_{false};
+  int64_t compiled_depth_{0};
+  NODE_MODE compiled_mode_{NODE_MODE::LEAF};
+  std::vector<int32_t> compiled_features_;
+  std::vector<ThresholdType> compiled_thresholds_;
+  std::vector<TreeNodeElement<ThresholdType>*> compiled_leaves_;
+
+  // Compact trees used for large ensembles, see TreeNodeCompactElement. compact_thresholds_[f] holds the sorted
+  // distinct thresholds of feature f. compact_nodes_ is empty if the ensemble is not compacted.
+  std::vector<TreeNodeCompactElement> compact_nodes_;
+  std::vector<uint32_t> compact_roots_;
+  std::vector<TreeNodeElement<ThresholdType>*> compact_leaves_;
+  std::vector<std::vector<ThresholdType>> compact_thresholds_;
+  NODE_MODE compact_mode_{NODE_MODE::LEAF};
+
  public:
   TreeEnsembleCommon() {}
 
@@ -83,6 +107,34 @@ class TreeEnsembleCommon : public TreeEnsembleCommonAttributes {
   TreeNodeElement<ThresholdType>* ProcessTreeNodeLeave(TreeNodeElement<ThresholdType>* root,
                                                        const InputType* x_data) const;
 
+  // Returns the leaf reached in tree tree_index, with the compiled trees if there are.
+  TreeNodeElement<ThresholdType>* GetTreeLeave(size_t tree_index, const InputType* x_data) const;
+
+  template <typename CMP>
+  TreeNodeElement<ThresholdType>* ProcessCompiledTreeLeave(size_t tree_index, const InputType* x_data, CMP cmp) const;
+
+  void CompileTrees();
+
+  void CompactTrees();
+
+  // Converts a row to the rank of its values among the thresholds of each feature.
+  void BinRow(const InputType* x_data, uint16_t* bins) const;
+
+  const TreeNodeElement<ThresholdType>* ProcessCompactTreeLeave(size_t tree_index, const uint16_t* bins) const;
+
+  template <typename AGG>
+  void ComputeAggCompact(concurrency::ThreadPool* ttp, const InputType* x_data, int64_t N, int64_t stride,
+                         OutputType* z_data, int64_t* label_data, const AGG& agg) const;
+
+  // Calls fct(i, leaf) for every row i in [begin_n, end_n) with the leaf the row reaches in tree tree_index.
+  template <typename FCT>
+  void ProcessTreeNodeLeaves(size_t tree_index, const InputType* x_data, int64_t stride,
+                             int64_t begin_n, int64_t end_n, FCT&& fct) const;
+
+  template <typename CMP>
+  void ProcessTreeNodeLeaveBlock(TreeNodeElement<ThresholdType>** nodes, int64_t n_rows,
+                                 const InputType* x_data, int64_t stride, CMP cmp) const;
+
   template <typename AGG>
   void ComputeAgg(concurrency::ThreadPool* ttp, const Tensor* X, Tensor* Y, Tensor* label, const AGG& agg) const;
 };
@@ -98,6 +150,7 @@ Status TreeEnsembleCommon<InputType, ThresholdType, OutputType>::Init(const OpKe
   ORT_THROW_IF_ERROR(GetVectorAttrsOrDefault(info, "target_weights_as_tensor", target_weights_as_tensor));
 #endif
 
+  compile_trees_ = info.GetConfigOptions().GetConfigOrDefault(kOrtSessionOptionsCompileTreeEnsembles, "0") == "1";
   return Init(
       80,
       128,
@@ -361,6 +414,50 @@ Status TreeEnsembleCommon<InputType, ThresholdType, OutputType>::Init(
       break;
     }
   }
+
+  // Depth of the deepest tree, computed level by level. Every node is visited once
+  // so that a malformed tree with a cycle cannot make this loop forever.
+  max_tree_depth_ = 0;
+  {
+    InlinedVector<bool> visited(nodes_.size(), false);
+    std::vector<TreeNodeElement<ThresholdType>*> level, next_level;
+    for (auto* root : roots_) {
+      int64_t depth = 0;
+      level.assign(1, root);
+      while (!level.empty()) {
+        next_level.clear();
+        for (auto* node : level) {
+          auto index = static_cast<size_t>(node - nodes_.data());
+          if (visited[index]) {
+            continue;
+          }
+          visited[index] = true;
+          if (node->is_not_leaf()) {
+            next_level.push_back(node + node->truenode_inc_or_first_weight);
+            next_level.push_back(node + node->falsenode_inc_or_n_weights);
+          }
+        }
+        if (!next_level.empty()) {
+          ++depth;
+        }
+        std::swap(level, next_level);
+      }
+      max_tree_depth_ = std::max(max_tree_depth_, depth);
+    }
+  }
+
+  // A single walk is a chain of dependent loads, one per level, and its branches are hard to predict.
+  // Walking a block of rows through the same tree interleaves independent chains and keeps the nodes
+  // of the tree in cache. It pays off once the trees are deep enough and there are enough of them.
+  // The block walk compares every node with the same rule, it requires same_mode_.
+  batch_traversal_ = same_mode_ && max_tree_depth_ >= 4 && n_trees_ >= 16;
+
+  if (compile_trees_) {
+    CompileTrees();
+  }
+  if (compiled_depth_ == 0) {
+    CompactTrees();
+  }
   return Status::OK();
 }
 
@@ -421,6 +518,11 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
 
   const InputType* x_data = X->Data<InputType>();
   int64_t* label_data = label == nullptr ? nullptr : label->MutableData<int64_t>();
+  if (!compact_nodes_.empty()) {
+    ComputeAggCompact(ttp, x_data, N, stride, z_data, label_data, agg);
+    return;
+  }
+
   auto max_num_threads = concurrency::ThreadPool::DegreeOfParallelism(ttp);
 
   if (n_targets_or_classes_ == 1) {
@@ -428,7 +530,7 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
       ScoreValue<ThresholdType> score = {0, 0};
       if (n_trees_ <= parallel_tree_ || max_num_threads == 1) { /* section A: 1 output, 1 row and not enough trees to parallelize */
         for (int64_t j = 0; j < n_trees_; ++j) {
-          agg.ProcessTreeNodePrediction1(score, *ProcessTreeNodeLeave(roots_[onnxruntime::narrow<size_t>(j)], x_data));
+          agg.ProcessTreeNodePrediction1(score, *GetTreeLeave(onnxruntime::narrow<size_t>(j), x_data));
         }
       } else { /* section B: 1 output, 1 row and enough trees to parallelize */
         std::vector<ScoreValue<ThresholdType>> scores(onnxruntime::narrow<size_t>(n_trees_), {0, 0});
@@ -436,7 +538,7 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
             ttp,
             SafeInt<int32_t>(n_trees_),
             [this, &scores, &agg, x_data](ptrdiff_t j) {
-              agg.ProcessTreeNodePrediction1(scores[j], *ProcessTreeNodeLeave(roots_[j], x_data));
+              agg.ProcessTreeNodePrediction1(scores[j], *GetTreeLeave(j, x_data));
             },
             max_num_threads);
 
@@ -466,9 +568,10 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
           scores[SafeInt<ptrdiff_t>(i - batch)] = {0, 0};
         }
         for (j = 0; j < static_cast<size_t>(n_trees_); ++j) {
-          for (i = batch; i < batch_end; ++i) {
-            agg.ProcessTreeNodePrediction1(scores[SafeInt<ptrdiff_t>(i - batch)], *ProcessTreeNodeLeave(roots_[j], x_data + i * stride));
-          }
+          ProcessTreeNodeLeaves(j, x_data, stride, batch, batch_end,
+                                [&agg, &scores, batch](int64_t i, const TreeNodeElement<ThresholdType>& leaf) {
+                                  agg.ProcessTreeNodePrediction1(scores[SafeInt<ptrdiff_t>(i - batch)], leaf);
+                                });
         }
         for (i = batch; i < batch_end; ++i) {
           agg.FinalizeScores1(z_data + i, scores[SafeInt<ptrdiff_t>(i - batch)],
@@ -490,10 +593,12 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
                 scores[batch_num * SafeInt<ptrdiff_t>(N) + i] = {0, 0};
               }
               for (auto j = work.start; j < work.end; ++j) {
-                for (int64_t i = begin_n; i < end_n; ++i) {
-                  agg.ProcessTreeNodePrediction1(scores[batch_num * SafeInt<ptrdiff_t>(N) + i],
-                                                 *ProcessTreeNodeLeave(roots_[j], x_data + i * stride));
-                }
+                ProcessTreeNodeLeaves(j, x_data, stride, begin_n, end_n,
+                                      [&agg, &scores, batch_num, N](int64_t i,
+                                                                    const TreeNodeElement<ThresholdType>& leaf) {
+                                        agg.ProcessTreeNodePrediction1(scores[batch_num * SafeInt<ptrdiff_t>(N) + i],
+                                                                       leaf);
+                                      });
               }
             });
         begin_n = end_n;
@@ -518,7 +623,7 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
           [this, &agg, x_data, z_data, stride, label_data](ptrdiff_t i) {
             ScoreValue<ThresholdType> score = {0, 0};
             for (size_t j = 0; j < static_cast<size_t>(n_trees_); ++j) {
-              agg.ProcessTreeNodePrediction1(score, *ProcessTreeNodeLeave(roots_[j], x_data + i * stride));
+              agg.ProcessTreeNodePrediction1(score, *GetTreeLeave(j, x_data + i * stride));
             }
 
             agg.FinalizeScores1(z_data + i, score,
@@ -531,7 +636,7 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
       if (n_trees_ <= parallel_tree_ || max_num_threads == 1) { /* section A2 */
         InlinedVector<ScoreValue<ThresholdType>> scores(onnxruntime::narrow<size_t>(n_targets_or_classes_), {0, 0});
         for (int64_t j = 0; j < n_trees_; ++j) {
-          agg.ProcessTreeNodePrediction(scores, *ProcessTreeNodeLeave(roots_[onnxruntime::narrow<size_t>(j)], x_data), weights_);
+          agg.ProcessTreeNodePrediction(scores, *GetTreeLeave(onnxruntime::narrow<size_t>(j), x_data), weights_);
         }
         agg.FinalizeScores(scores, z_data, -1, label_data);
       } else { /* section B2: 2+ outputs, 1 row, enough trees to parallelize */
@@ -544,7 +649,7 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
               scores[batch_num].resize(onnxruntime::narrow<size_t>(n_targets_or_classes_), {0, 0});
               auto work = concurrency::ThreadPool::PartitionWork(batch_num, num_threads, onnxruntime::narrow<size_t>(n_trees_));
               for (auto j = work.start; j < work.end; ++j) {
-                agg.ProcessTreeNodePrediction(scores[batch_num], *ProcessTreeNodeLeave(roots_[j], x_data), weights_);
+                agg.ProcessTreeNodePrediction(scores[batch_num], *GetTreeLeave(j, x_data), weights_);
               }
             });
         for (size_t i = 1, limit = scores.size(); i < limit; ++i) {
@@ -566,9 +671,10 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
           std::fill(scores[SafeInt<ptrdiff_t>(i - batch)].begin(), scores[SafeInt<ptrdiff_t>(i - batch)].end(), ScoreValue<ThresholdType>({0, 0}));
         }
         for (j = 0, limit = roots_.size(); j < limit; ++j) {
-          for (i = batch; i < batch_end; ++i) {
-            agg.ProcessTreeNodePrediction(scores[SafeInt<ptrdiff_t>(i - batch)], *ProcessTreeNodeLeave(roots_[j], x_data + i * stride), weights_);
-          }
+          ProcessTreeNodeLeaves(j, x_data, stride, batch, batch_end,
+                                [this, &agg, &scores, batch](int64_t i, const TreeNodeElement<ThresholdType>& leaf) {
+                                  agg.ProcessTreeNodePrediction(scores[SafeInt<ptrdiff_t>(i - batch)], leaf, weights_);
+                                });
         }
         for (i = batch; i < batch_end; ++i) {
           agg.FinalizeScores(scores[SafeInt<ptrdiff_t>(i - batch)], z_data + i * n_targets_or_classes_, -1,
@@ -591,10 +697,12 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
                 scores[batch_num * SafeInt<ptrdiff_t>(N) + i].resize(onnxruntime::narrow<size_t>(n_targets_or_classes_), {0, 0});
               }
               for (auto j = work.start; j < work.end; ++j) {
-                for (int64_t i = begin_n; i < end_n; ++i) {
-                  agg.ProcessTreeNodePrediction(scores[batch_num * SafeInt<ptrdiff_t>(N) + i],
-                                                *ProcessTreeNodeLeave(roots_[j], x_data + i * stride), weights_);
-                }
+                ProcessTreeNodeLeaves(j, x_data, stride, begin_n, end_n,
+                                      [this, &agg, &scores, batch_num, N](int64_t i,
+                                                                          const TreeNodeElement<ThresholdType>& leaf) {
+                                        agg.ProcessTreeNodePrediction(scores[batch_num * SafeInt<ptrdiff_t>(N) + i],
+                                                                      leaf, weights_);
+                                      });
               }
             });
         begin_n = end_n;
@@ -625,7 +733,7 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
             for (auto i = work.start; i < work.end; ++i) {
               std::fill(scores.begin(), scores.end(), ScoreValue<ThresholdType>({0, 0}));
               for (j = 0, limit = roots_.size(); j < limit; ++j) {
-                agg.ProcessTreeNodePrediction(scores, *ProcessTreeNodeLeave(roots_[j], x_data + i * stride), weights_);
+                agg.ProcessTreeNodePrediction(scores, *GetTreeLeave(j, x_data + i * stride), weights_);
               }
 
               agg.FinalizeScores(scores,
@@ -745,6 +853,388 @@ TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ProcessTreeNodeLeave(
   return root;
 }
 
+template <typename InputType, typename ThresholdType, typename OutputType>
+template <typename CMP>
+void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ProcessTreeNodeLeaveBlock(
+    TreeNodeElement<ThresholdType>** nodes, int64_t n_rows, const InputType* x_data, int64_t stride, CMP cmp) const {
+  // Every pass moves each row that has not reached a leaf yet one level down. The rows do not depend
+  // on each other, the processor overlaps their loads instead of waiting for one walk at a time.
+  bool moving = true;
+  while (moving) {
+    moving = false;
+    for (int64_t r = 0; r < n_rows; ++r) {
+      TreeNodeElement<ThresholdType>* node = nodes[r];
+      if (node->is_not_leaf()) {
+        InputType val = x_data[r * stride + node->feature_id];
+        node += (cmp(val, node->value_or_unique_weight) ||
+                 (has_missing_tracks_ && node->is_missing_track_true() && _isnan_(val)))
+                    ? node->truenode_inc_or_first_weight
+                    : node->falsenode_inc_or_n_weights;
+        nodes[r] = node;
+        moving = true;
+      }
+    }
+  }
+}
+
+template <typename InputType, typename ThresholdType, typename OutputType>
+template <typename FCT>
+void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ProcessTreeNodeLeaves(
+    size_t tree_index, const InputType* x_data, int64_t stride,
+    int64_t begin_n, int64_t end_n, FCT&& fct) const {
+  TreeNodeElement<ThresholdType>* root = roots_[tree_index];
+  if (compiled_depth_ > 0 || !batch_traversal_ || !root->is_not_leaf()) {
+    for (int64_t i = begin_n; i < end_n; ++i) {
+      fct(i, *GetTreeLeave(tree_index, x_data + i * stride));
+    }
+    return;
+  }
+
+  constexpr int64_t kBlockSize = 16;
+  TreeNodeElement<ThresholdType>* nodes[kBlockSize];
+  for (int64_t i = begin_n; i < end_n; i += kBlockSize) {
+    const int64_t n_rows = std::min(kBlockSize, end_n - i);
+    const InputType* x_rows = x_data + i * stride;
+    std::fill(nodes, nodes + n_rows, root);
+
+    // batch_traversal_ implies same_mode_, the root tells the rule of every node.
+    switch (root->mode()) {
+      case NODE_MODE::BRANCH_LEQ:
+        ProcessTreeNodeLeaveBlock(nodes, n_rows, x_rows, stride, std::less_equal<>());
+        break;
+      case NODE_MODE::BRANCH_LT:
+        ProcessTreeNodeLeaveBlock(nodes, n_rows, x_rows, stride, std::less<>());
+        break;
+      case NODE_MODE::BRANCH_GTE:
+        ProcessTreeNodeLeaveBlock(nodes, n_rows, x_rows, stride, std::greater_equal<>());
+        break;
+      case NODE_MODE::BRANCH_GT:
+        ProcessTreeNodeLeaveBlock(nodes, n_rows, x_rows, stride, std::greater<>());
+        break;
+      case NODE_MODE::BRANCH_EQ:
+        ProcessTreeNodeLeaveBlock(nodes, n_rows, x_rows, stride, std::equal_to<>());
+        break;
+      case NODE_MODE::BRANCH_NEQ:
+        ProcessTreeNodeLeaveBlock(nodes, n_rows, x_rows, stride, std::not_equal_to<>());
+        break;
+      case NODE_MODE::LEAF:
+        break;
+    }
+
+    for (int64_t r = 0; r < n_rows; ++r) {
+      fct(i + r, *nodes[r]);
+    }
+  }
+}
+
+template <typename InputType, typename ThresholdType, typename OutputType>
+void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::CompileTrees() {
+  constexpr int64_t kMaxCompiledDepth = 8;
+  compiled_depth_ = 0;
+  if (!same_mode_ || has_missing_tracks_ || max_tree_depth_ < 1 || max_tree_depth_ > kMaxCompiledDepth) {
+    return;
+  }
+
+  const size_t n_internal = (size_t{1} << max_tree_depth_) - 1;
+  const size_t n_leaves = size_t{1} << max_tree_depth_;
+  // same_mode_ tells all the nodes which are not leaves use the rule of the first one
+  compiled_mode_ = std::find_if(nodes_.begin(), nodes_.end(), [](const TreeNodeElement<ThresholdType>& node) {
+                     return node.is_not_leaf();
+                   })->mode();
+  compiled_features_.assign(roots_.size() * n_internal, 0);
+  compiled_thresholds_.assign(roots_.size() * n_internal, ThresholdType{});
+  compiled_leaves_.assign(roots_.size() * n_leaves, nullptr);
+
+  // (position in the complete tree, node) pairs of the current level
+  std::vector<std::pair<size_t, TreeNodeElement<ThresholdType>*>> level, next_level;
+  for (size_t j = 0; j < roots_.size(); ++j) {
+    int32_t* features = compiled_features_.data() + j * n_internal;
+    ThresholdType* thresholds = compiled_thresholds_.data() + j * n_internal;
+    TreeNodeElement<ThresholdType>** leaves = compiled_leaves_.data() + j * n_leaves;
+
+    level.assign(1, {0, roots_[j]});
+    for (int64_t depth = 0; depth < max_tree_depth_; ++depth) {
+      next_level.clear();
+      for (const auto& entry : level) {
+        TreeNodeElement<ThresholdType>* node = entry.second;
+        if (node->is_not_leaf()) {
+          features[entry.first] = node->feature_id;
+          thresholds[entry.first] = node->value_or_unique_weight;
+          next_level.emplace_back(2 * entry.first + 1, node + node->truenode_inc_or_first_weight);
+          next_level.emplace_back(2 * entry.first + 2, node + node->falsenode_inc_or_n_weights);
+        } else {
+          // both outcomes of the comparison lead to the same leaf
+          next_level.emplace_back(2 * entry.first + 1, node);
+          next_level.emplace_back(2 * entry.first + 2, node);
+        }
+      }
+      std::swap(level, next_level);
+    }
+
+    for (const auto& entry : level) {
+      // Every path of a tree ends on a leaf at this level. A malformed tree whose nodes are reached by
+      // several paths may be deeper than max_tree_depth_, it is left to the interpreter.
+      if (entry.second->is_not_leaf()) {
+        return;
+      }
+      leaves[entry.first - n_internal] = entry.second;
+    }
+  }
+  compiled_depth_ = max_tree_depth_;
+}
+
+template <typename InputType, typename ThresholdType, typename OutputType>
+template <typename CMP>
+TreeNodeElement<ThresholdType>* TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ProcessCompiledTreeLeave(
+    size_t tree_index, const InputType* x_data, CMP cmp) const {
+  const size_t n_internal = (size_t{1} << compiled_depth_) - 1;
+  const int32_t* features = compiled_features_.data() + tree_index * n_internal;
+  const ThresholdType* thresholds = compiled_thresholds_.data() + tree_index * n_internal;
+
+  // A fixed number of steps with no data dependent branch, the comparison only selects the next position.
+  size_t position = 0;
+  for (int64_t depth = 0; depth < compiled_depth_; ++depth) {
+    position = 2 * position + (cmp(x_data[features[position]], thresholds[position]) ? 1 : 2);
+  }
+  return compiled_leaves_[(tree_index << compiled_depth_) + position - n_internal];
+}
+
+template <typename InputType, typename ThresholdType, typename OutputType>
+TreeNodeElement<ThresholdType>* TreeEnsembleCommon<InputType, ThresholdType, OutputType>::GetTreeLeave(
+    size_t tree_index, const InputType* x_data) const {
+  if (compiled_depth_ == 0) {
+    return ProcessTreeNodeLeave(roots_[tree_index], x_data);
+  }
+
+  switch (compiled_mode_) {
+    case NODE_MODE::BRANCH_LEQ:
+      return ProcessCompiledTreeLeave(tree_index, x_data, std::less_equal<>());
+    case NODE_MODE::BRANCH_LT:
+      return ProcessCompiledTreeLeave(tree_index, x_data, std::less<>());
+    case NODE_MODE::BRANCH_GTE:
+      return ProcessCompiledTreeLeave(tree_index, x_data, std::greater_equal<>());
+    case NODE_MODE::BRANCH_GT:
+      return ProcessCompiledTreeLeave(tree_index, x_data, std::greater<>());
+    case NODE_MODE::BRANCH_EQ:
+      return ProcessCompiledTreeLeave(tree_index, x_data, std::equal_to<>());
+    case NODE_MODE::BRANCH_NEQ:
+      return ProcessCompiledTreeLeave(tree_index, x_data, std::not_equal_to<>());
+    case NODE_MODE::LEAF:
+      break;
+  }
+  return ProcessTreeNodeLeave(roots_[tree_index], x_data);
+}
+
+template <typename InputType, typename ThresholdType, typename OutputType>
+void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::CompactTrees() {
+  // The full nodes of a large ensemble do not hold in the caches anymore, the compact ones take a third.
+  constexpr int64_t kCompactMinNodes = int64_t{1} << 16;
+  compact_nodes_.clear();
+  if (!same_mode_ || has_missing_tracks_ || n_nodes_ < kCompactMinNodes ||
+      max_feature_id_ >= TreeNodeCompactElement::kLeaf || n_nodes_ >= std::numeric_limits<uint32_t>::max()) {
+    return;
+  }
+  auto first_branch = std::find_if(nodes_.begin(), nodes_.end(), [](const TreeNodeElement<ThresholdType>& node) {
+    return node.is_not_leaf();
+  });
+  if (first_branch == nodes_.end()) {
+    return;
+  }
+  compact_mode_ = first_branch->mode();
+  if (compact_mode_ == NODE_MODE::BRANCH_EQ || compact_mode_ == NODE_MODE::BRANCH_NEQ) {
+    return;
+  }
+
+  std::vector<std::vector<ThresholdType>> thresholds(static_cast<size_t>(max_feature_id_ + 1));
+  for (const auto& node : nodes_) {
+    if (node.is_not_leaf()) {
+      if (_isnan_(node.value_or_unique_weight)) {
+        return;
+      }
+      thresholds[node.feature_id].push_back(node.value_or_unique_weight);
+    }
+  }
+  for (auto& feature_thresholds : thresholds) {
+    std::sort(feature_thresholds.begin(), feature_thresholds.end());
+    feature_thresholds.erase(std::unique(feature_thresholds.begin(), feature_thresholds.end()),
+                             feature_thresholds.end());
+    // a bin is a rank in [0, number of thresholds]
+    if (feature_thresholds.size() >= std::numeric_limits<uint16_t>::max()) {
+      return;
+    }
+  }
+
+  std::vector<TreeNodeCompactElement> nodes;
+  std::vector<uint32_t> roots;
+  std::vector<TreeNodeElement<ThresholdType>*> leaves;
+  nodes.reserve(nodes_.size());
+  roots.reserve(roots_.size());
+  constexpr size_t kNoParent = std::numeric_limits<size_t>::max();
+  // (node, index of the compact node whose false node it is)
+  std::vector<std::pair<TreeNodeElement<ThresholdType>*, size_t>> stack;
+  for (auto* root : roots_) {
+    roots.push_back(static_cast<uint32_t>(nodes.size()));
+    stack.assign(1, {root, kNoParent});
+    while (!stack.empty()) {
+      auto entry = stack.back();
+      stack.pop_back();
+      if (nodes.size() >= nodes_.size()) {
+        return;  // a malformed tree reaches some nodes several times
+      }
+
+      const size_t index = nodes.size();
+      if (entry.second != kNoParent) {
+        nodes[entry.second].falsenode_inc_or_leaf = static_cast<uint32_t>(index - entry.second);
+      }
+
+      TreeNodeElement<ThresholdType>* node = entry.first;
+      TreeNodeCompactElement compact;
+      if (node->is_not_leaf()) {
+        const auto& feature_thresholds = thresholds[node->feature_id];
+        compact.feature_id = static_cast<uint16_t>(node->feature_id);
+        compact.threshold_bin = static_cast<uint16_t>(
+            std::lower_bound(feature_thresholds.begin(), feature_thresholds.end(), node->value_or_unique_weight) -
+            feature_thresholds.begin());
+        compact.falsenode_inc_or_leaf = 0;
+        // the true subtree is visited first and follows its parent
+        stack.emplace_back(node + node->falsenode_inc_or_n_weights, index);
+        stack.emplace_back(node + node->truenode_inc_or_first_weight, kNoParent);
+      } else {
+        compact.feature_id = TreeNodeCompactElement::kLeaf;
+        compact.threshold_bin = 0;
+        compact.falsenode_inc_or_leaf = static_cast<uint32_t>(leaves.size());
+        leaves.push_back(node);
+      }
+      nodes.push_back(compact);
+    }
+  }
+
+  compact_nodes_ = std::move(nodes);
+  compact_roots_ = std::move(roots);
+  compact_leaves_ = std::move(leaves);
+  compact_thresholds_ = std::move(thresholds);
+}
+
+template <typename InputType, typename ThresholdType, typename OutputType>
+void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::BinRow(const InputType* x_data, uint16_t* bins) const {
+  // With the bins below, a node compares bins[f] <= threshold_bin for BRANCH_LEQ and BRANCH_LT,
+  // and bins[f] > threshold_bin for BRANCH_GTE and BRANCH_GT, which gives the same result as comparing
+  // the value with the threshold:
+  //   x <= t[k]  <=>  k >= #{t < x}      x < t[k]  <=>  k >= #{t <= x}
+  //   x >= t[k]  <=>  k < #{t <= x}      x > t[k]  <=>  k < #{t < x}
+  // A missing value fails every comparison.
+  const bool use_upper_bound = compact_mode_ == NODE_MODE::BRANCH_LT || compact_mode_ == NODE_MODE::BRANCH_GTE;
+  const bool greater = compact_mode_ == NODE_MODE::BRANCH_GTE || compact_mode_ == NODE_MODE::BRANCH_GT;
+  for (size_t f = 0, limit = compact_thresholds_.size(); f < limit; ++f) {
+    const auto& thresholds = compact_thresholds_[f];
+    const InputType val = x_data[f];
+    size_t bin;
+    if (_isnan_(val)) {
+      bin = greater ? 0 : thresholds.size();
+    } else if (use_upper_bound) {
+      bin = std::upper_bound(thresholds.begin(), thresholds.end(), val,
+                             [](InputType v, ThresholdType t) { return v < t; }) -
+            thresholds.begin();
+    } else {
+      bin = std::lower_bound(thresholds.begin(), thresholds.end(), val,
+                             [](ThresholdType t, InputType v) { return t < v; }) -
+            thresholds.begin();
+    }
+    bins[f] = static_cast<uint16_t>(bin);
+  }
+}
+
+template <typename InputType, typename ThresholdType, typename OutputType>
+const TreeNodeElement<ThresholdType>* TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ProcessCompactTreeLeave(
+    size_t tree_index, const uint16_t* bins) const {
+  const TreeNodeCompactElement* node = compact_nodes_.data() + compact_roots_[tree_index];
+  if (compact_mode_ == NODE_MODE::BRANCH_GTE || compact_mode_ == NODE_MODE::BRANCH_GT) {
+    while (node->is_not_leaf()) {
+      node += bins[node->feature_id] > node->threshold_bin ? 1 : node->falsenode_inc_or_leaf;
+    }
+  } else {
+    while (node->is_not_leaf()) {
+      node += bins[node->feature_id] <= node->threshold_bin ? 1 : node->falsenode_inc_or_leaf;
+    }
+  }
+  return compact_leaves_[node->falsenode_inc_or_leaf];
+}
+
+template <typename InputType, typename ThresholdType, typename OutputType>
+template <typename AGG>
+void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAggCompact(
+    concurrency::ThreadPool* ttp, const InputType* x_data, int64_t N, int64_t stride,
+    OutputType* z_data, int64_t* label_data, const AGG& agg) const {
+  const size_t n_features = compact_thresholds_.size();
+  const size_t n_trees = compact_roots_.size();
+  auto max_num_threads = concurrency::ThreadPool::DegreeOfParallelism(ttp);
+
+  if (N == 1 && n_trees_ > parallel_tree_ && max_num_threads > 1) {
+    // one row, the trees are split between the threads
+    InlinedVector<uint16_t> bins(n_features);
+    BinRow(x_data, bins.data());
+    auto num_threads = std::min<int32_t>(max_num_threads, SafeInt<int32_t>(n_trees_));
+    if (n_targets_or_classes_ == 1) {
+      std::vector<ScoreValue<ThresholdType>> scores(num_threads, {0, 0});
+      concurrency::ThreadPool::TrySimpleParallelFor(
+          ttp, num_threads,
+          [this, &agg, &scores, &bins, num_threads, n_trees](ptrdiff_t batch_num) {
+            auto work = concurrency::ThreadPool::PartitionWork(batch_num, num_threads, static_cast<ptrdiff_t>(n_trees));
+            for (auto j = work.start; j < work.end; ++j) {
+              agg.ProcessTreeNodePrediction1(scores[batch_num], *ProcessCompactTreeLeave(j, bins.data()));
+            }
+          });
+      for (size_t i = 1; i < scores.size(); ++i) {
+        agg.MergePrediction1(scores[0], scores[i]);
+      }
+      agg.FinalizeScores1(z_data, scores[0], label_data);
+    } else {
+      std::vector<InlinedVector<ScoreValue<ThresholdType>>> scores(num_threads);
+      concurrency::ThreadPool::TrySimpleParallelFor(
+          ttp, num_threads,
+          [this, &agg, &scores, &bins, num_threads, n_trees](ptrdiff_t batch_num) {
+            scores[batch_num].resize(onnxruntime::narrow<size_t>(n_targets_or_classes_), {0, 0});
+            auto work = concurrency::ThreadPool::PartitionWork(batch_num, num_threads, static_cast<ptrdiff_t>(n_trees));
+            for (auto j = work.start; j < work.end; ++j) {
+              agg.ProcessTreeNodePrediction(scores[batch_num], *ProcessCompactTreeLeave(j, bins.data()), weights_);
+            }
+          });
+      for (size_t i = 1; i < scores.size(); ++i) {
+        agg.MergePrediction(scores[0], scores[i]);
+      }
+      agg.FinalizeScores(scores[0], z_data, -1, label_data);
+    }
+    return;
+  }
+
+  // Every row is binned once and then goes through all the compact trees, the rows are split between the threads.
+  auto num_threads = std::min<int32_t>(max_num_threads, SafeInt<int32_t>(N));
+  concurrency::ThreadPool::TrySimpleParallelFor(
+      ttp, num_threads,
+      [this, &agg, num_threads, n_features, n_trees, x_data, z_data, label_data, N, stride](ptrdiff_t batch_num) {
+        InlinedVector<uint16_t> bins(n_features);
+        InlinedVector<ScoreValue<ThresholdType>> scores(onnxruntime::narrow<size_t>(n_targets_or_classes_));
+        auto work = concurrency::ThreadPool::PartitionWork(batch_num, num_threads, onnxruntime::narrow<ptrdiff_t>(N));
+        for (auto i = work.start; i < work.end; ++i) {
+          BinRow(x_data + i * stride, bins.data());
+          if (n_targets_or_classes_ == 1) {
+            ScoreValue<ThresholdType> score = {0, 0};
+            for (size_t j = 0; j < n_trees; ++j) {
+              agg.ProcessTreeNodePrediction1(score, *ProcessCompactTreeLeave(j, bins.data()));
+            }
+            agg.FinalizeScores1(z_data + i, score, label_data == nullptr ? nullptr : (label_data + i));
+          } else {
+            std::fill(scores.begin(), scores.end(), ScoreValue<ThresholdType>({0, 0}));
+            for (size_t j = 0; j < n_trees; ++j) {
+              agg.ProcessTreeNodePrediction(scores, *ProcessCompactTreeLeave(j, bins.data()), weights_);
+            }
+            agg.FinalizeScores(scores, z_data + i * n_targets_or_classes_, -1,
+                               label_data == nullptr ? nullptr : (label_data + i));
+          }
+        }
+      });
+}
+
 // TI: input type
 // TH: threshold type, double if T==double, float otherwise
 // TO: output type
@@ -799,6 +1289,8 @@ Status TreeEnsembleCommonClassifier<InputType, ThresholdType, OutputType>::Init(
   ORT_THROW_IF_ERROR(GetVectorAttrsOrDefault(info, "class_weights_as_tensor", class_weights_as_tensor));
 #endif
 
+  this->compile_trees_ =
+      info.GetConfigOptions().GetConfigOrDefault(kOrtSessionOptionsCompileTreeEnsembles, "0") == "1";
   return Init(
       80,
       128,
@@ -7,6 +7,7 @@
 #include "core/common/status.h"
 #include "core/framework/tensor.h"
 #endif
+#include <algorithm>
 #include <sstream>
 // TODO: fix the warnings
 #if defined(_MSC_VER) && !defined(__clang__)
@@ -22,11 +23,16 @@ class BatchNormHelper {
                                        const Tensor* B,
                                        const Tensor* mean,
                                        const Tensor* var,
-                                       bool is_spatial = true) {
+                                       bool is_spatial = true,
+                                       bool is_nhwc = false) {
     const auto& x_dims = X->Shape().GetDims();
 
+    if (is_nhwc && !is_spatial) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Non-spatial BatchNormalization is not supported in NHWC.");
+    }
+
     // If x_dims size < 2, num_channels defaults to 1.
-    int64_t num_channels = x_dims.size() > 1 ? x_dims[1] : 1;
+    int64_t num_channels = x_dims.size() > 1 ? (is_nhwc ? x_dims.back() : x_dims[1]) : 1;
     // the first 2 are respectively - N and C.
     int num_feature_dims = x_dims.size() > 1 ? static_cast<int>(x_dims.size() - 2) : 0;
 
@@ -109,14 +115,18 @@ class BatchNormHelper {
     return common::Status::OK();
   }
 
-  static void NormalizeDims(const TensorShape& x_shape, std::vector<int64_t>& new_dims) {
+  // The dims are always returned in NCHW order. For NHWC input the channels are moved from the last dimension.
+  static void NormalizeDims(const TensorShape& x_shape, std::vector<int64_t>& new_dims, bool is_nhwc = false) {
     new_dims.clear();
-    auto orig_dims = x_shape.GetDims();
+    std::vector<int64_t> orig_dims(x_shape.GetDims().begin(), x_shape.GetDims().end());
     ORT_ENFORCE(orig_dims.size() < 6,
                 "Input dim size should be < 6 for BatchNorm, but got ", std::to_string(orig_dims.size()));
+    if (is_nhwc && orig_dims.size() > 2) {
+      std::rotate(orig_dims.begin() + 1, orig_dims.end() - 1, orig_dims.end());
+    }
     if (orig_dims.size() == 4 /*supported size by CUDA*/ ||
         orig_dims.size() == 5 /*supported size by CUDA*/) {
-      new_dims = std::vector<int64_t>(orig_dims.begin(), orig_dims.end());
+      new_dims = std::move(orig_dims);
       return;
     }
 
@@ -231,7 +231,8 @@ Status Conv<float>::Compute(OpKernelContext* context) const {
                     &activation_,
                     &WorkingBufferSize,
                     Beta,
-                    thread_pool);
+                    thread_pool,
+                    use_bf16_compute_);
 
     auto* working_data = WorkingBufferSize > 0 ? alloc->Alloc(sizeof(float) * SafeInt<size_t>(WorkingBufferSize))
                                                : nullptr;
@@ -4,6 +4,7 @@
 #pragma once
 
 #include "core/framework/op_kernel.h"
+#include "core/providers/cpu/math/gemm_matmul_common.h"
 #include "core/providers/cpu/nn/conv_attributes.h"
 #include "core/mlas/inc/mlas.h"
 
@@ -26,6 +27,7 @@ class Conv<float> : public OpKernel {
  public:
   Conv(const OpKernelInfo& info) : OpKernel(info), conv_attrs_(info) {
     activation_.ActivationKind = MlasIdentityActivation;
+    use_bf16_compute_ = GemmUseBf16Compute(info);
   }
 
   Status Compute(OpKernelContext* context) const override;
@@ -34,6 +36,9 @@ class Conv<float> : public OpKernel {
   MLAS_ACTIVATION activation_;
 
   ConvAttributes conv_attrs_;
+
+  // Run the GEMMs of the convolution with MlasSBGemmBatch (see kOrtSessionOptionsMlasGemmFastMathBf16).
+  bool use_bf16_compute_;
 };
 
 }  // namespace onnxruntime
@@ -3,17 +3,22 @@
 
 #include "layer_norm.h"
 
+#include "core/mlas/inc/mlas.h"
 #include "core/providers/common.h"
 
 namespace onnxruntime {
 #define REGISTER_ONNX_KERNEL_TYPED(T)                                                            \
   ONNX_CPU_OPERATOR_TYPED_KERNEL(LayerNormalization, 17, T,                                      \
                                  KernelDefBuilder()                                              \
+                                     .MayInplace(0, 0)                                           \
                                      .TypeConstraint("T", DataTypeImpl::GetTensorType<T>())      \
                                      .TypeConstraint("U", DataTypeImpl::GetTensorType<float>()), \
                                  LayerNorm);
 
 REGISTER_ONNX_KERNEL_TYPED(float)
 REGISTER_ONNX_KERNEL_TYPED(double)
+#ifdef MLAS_F16VEC_INTRINSICS_SUPPORTED
+REGISTER_ONNX_KERNEL_TYPED(MLFloat16)
+#endif
 
 }  // namespace onnxruntime
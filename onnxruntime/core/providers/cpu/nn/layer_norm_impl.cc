@@ -5,6 +5,7 @@
 
 #include "core/common/safeint.h"
 #include "core/framework/tensor.h"
+#include "core/mlas/inc/mlas.h"
 #include "core/platform/threadpool.h"
 #include "core/providers/common.h"
 #include "core/util/math_cpuonly.h"
@@ -18,6 +19,74 @@ LayerNormImpl::LayerNormImpl(const OpKernelInfo& op_kernel_info, bool simplified
 }
 
 namespace {
+template <typename T, typename U>
+void ComputeJob(const T* X_data, const T* scale_data, const T* bias_data, const ptrdiff_t task_idx,
+                const int64_t norm_size, const float epsilon, const bool simplified,
+                T* Y_data, U* mean_data, U* inv_std_dev_data) {
+  const T* p_input = X_data + task_idx * norm_size;
+  T* p_output = Y_data + task_idx * norm_size;
+
+  T mean = 0;
+  T mean_square = 0;
+
+  for (int64_t h = 0; h < norm_size; h++) {
+    mean += p_input[h];
+    mean_square += p_input[h] * p_input[h];
+  }
+
+  mean = mean / norm_size;
+  if (simplified) {
+    mean_square = sqrt(mean_square / norm_size + epsilon);
+  } else {
+    mean_square = sqrt(mean_square / norm_size - mean * mean + epsilon);
+  }
+
+  for (int64_t h = 0; h < norm_size; h++) {
+    if (simplified) {
+      p_output[h] = p_input[h] / mean_square * scale_data[h];
+    } else if (nullptr == bias_data) {
+      p_output[h] = (p_input[h] - mean) / mean_square * scale_data[h];
+    } else {
+      p_output[h] = (p_input[h] - mean) / mean_square * scale_data[h] + bias_data[h];
+    }
+  }
+
+  if (mean_data != nullptr) {
+    // ONNX spec doesn't support 'double' for 'U' so when 'T' == double, 'U' == float and we need to narrow
+    mean_data[task_idx] = gsl::narrow_cast<U>(mean);
+  }
+
+  if (inv_std_dev_data != nullptr) {
+    inv_std_dev_data[task_idx] = gsl::narrow_cast<U>(1 / mean_square);
+  }
+}
+
+#ifdef MLAS_F16VEC_INTRINSICS_SUPPORTED
+// fp16 rows are normalized by MLAS, which accumulates the statistics in fp32.
+template <typename U>
+void ComputeJob(const MLFloat16* X_data, const MLFloat16* scale_data, const MLFloat16* bias_data,
+                const ptrdiff_t task_idx, const int64_t norm_size, const float epsilon, const bool simplified,
+                MLFloat16* Y_data, U* mean_data, U* inv_std_dev_data) {
+  float mean;
+  float inv_std_dev;
+
+  MlasComputeHalfLayerNorm(reinterpret_cast<const MLAS_FP16*>(X_data + task_idx * norm_size),
+                           reinterpret_cast<const MLAS_FP16*>(scale_data),
+                           reinterpret_cast<const MLAS_FP16*>(bias_data),
+                           reinterpret_cast<MLAS_FP16*>(Y_data + task_idx * norm_size),
+                           onnxruntime::narrow<size_t>(norm_size), epsilon, simplified,
+                           &mean, &inv_std_dev);
+
+  if (mean_data != nullptr) {
+    mean_data[task_idx] = static_cast<U>(mean);
+  }
+
+  if (inv_std_dev_data != nullptr) {
+    inv_std_dev_data[task_idx] = static_cast<U>(inv_std_dev);
+  }
+}
+#endif  // MLAS_F16VEC_INTRINSICS_SUPPORTED
+
 template <typename T, typename U>
 Status ComputeImpl(OpKernelContext* p_ctx, int64_t orig_axis, float epsilon, bool simplified) {
   // Inputs
@@ -74,45 +143,26 @@ Status ComputeImpl(OpKernelContext* p_ctx, int64_t orig_axis, float epsilon, boo
     inv_std_dev_data = inv_std_dev->MutableData<U>();
   }
 
+  if constexpr (std::is_same<T, float>::value && std::is_same<U, float>::value) {
+    MLAS_LAYER_NORM_PARAMS params;
+    params.Input = X_data;
+    params.Scale = scale_data;
+    params.NormBias = bias_data;
+    params.Output = Y_data;
+    params.Mean = mean_data;
+    params.InvStdDev = inv_std_dev_data;
+    params.Epsilon = epsilon;
+    params.Simplified = simplified;
+    MlasComputeLayerNorm(&params, onnxruntime::narrow<size_t>(norm_count), onnxruntime::narrow<size_t>(norm_size),
+                         p_ctx->GetOperatorThreadPool());
+    return Status::OK();
+  }
+
   concurrency::ThreadPool::TryBatchParallelFor(
       p_ctx->GetOperatorThreadPool(), static_cast<int32_t>(norm_count),
       [&](ptrdiff_t task_idx) {
-        const T* p_input = X_data + task_idx * norm_size;
-        T* p_output = Y_data + task_idx * norm_size;
-
-        T mean = 0;
-        T mean_square = 0;
-
-        for (int64_t h = 0; h < norm_size; h++) {
-          mean += p_input[h];
-          mean_square += p_input[h] * p_input[h];
-        }
-
-        mean = mean / norm_size;
-        if (simplified) {
-          mean_square = sqrt(mean_square / norm_size + epsilon);
-        } else {
-          mean_square = sqrt(mean_square / norm_size - mean * mean + epsilon);
-        }
-
-        for (int64_t h = 0; h < norm_size; h++) {
-          if (simplified) {
-            p_output[h] = p_input[h] / mean_square * scale_data[h];
-          } else if (nullptr == bias) {
-            p_output[h] = (p_input[h] - mean) / mean_square * scale_data[h];
-          } else {
-            p_output[h] = (p_input[h] - mean) / mean_square * scale_data[h] + bias_data[h];
-          }
-        }
-
-        if (mean_data != nullptr) {
-          // ONNX spec doesn't support 'double' for 'U' so when 'T' == double, 'U' == float and we need to narrow
-          mean_data[task_idx] = gsl::narrow_cast<U>(mean);
-        }
-
-        if (inv_std_dev_data != nullptr) {
-          inv_std_dev_data[task_idx] = gsl::narrow_cast<U>(1 / mean_square);
-        }
+        ComputeJob(X_data, scale_data, bias_data, task_idx, norm_size, epsilon, simplified,
+                   Y_data, mean_data, inv_std_dev_data);
       },
       0);
 
@@ -141,7 +191,11 @@ struct SrcDispatcher {
 Status LayerNormImpl::Compute(OpKernelContext* p_ctx) const {
   const auto elem_type = p_ctx->Input<Tensor>(0)->GetElementType();
 
+#ifdef MLAS_F16VEC_INTRINSICS_SUPPORTED
+  using SupportedTypeList = boost::mp11::mp_list<float, double, MLFloat16>;
+#else
   using SupportedTypeList = boost::mp11::mp_list<float, double>;
+#endif
 
   utils::MLTypeCallDispatcherFromTypeList<SupportedTypeList> t_disp(elem_type);
   return t_disp.InvokeRet<Status, SrcDispatcher>(p_ctx, axis_, epsilon_, simplified_, contrib_op_);
@@ -17,6 +17,7 @@
 
 #endif  // _MSC_VER
 
+#include <algorithm>
 #include <locale>
 #include <functional>
 #include <unordered_set>
@@ -205,10 +206,44 @@ const std::string default_locale("en_US.UTF-8");  // All non-MS
 
 #endif  // _MSC_VER
 
+inline bool IsAscii(const std::string& s) {
+  return std::all_of(s.cbegin(), s.cend(), [](char ch) { return static_cast<unsigned char>(ch) < 0x80; });
+}
+
+// Returns the 128 entries table changing the case of the ASCII characters the way the locale does,
+// or an empty string if the locale maps one of them to a non ASCII character.
+std::string MakeAsciiCaseTable(const Locale& loc, StringNormalizer::CaseAction caseaction) {
+  if (caseaction == StringNormalizer::NONE) {
+    return std::string();
+  }
+
+  std::wstring wstr(0x80, L'\0');
+  for (size_t ch = 0; ch < wstr.size(); ++ch) {
+    wstr[ch] = static_cast<wchar_t>(ch);
+  }
+  loc.ChangeCase(caseaction, wstr);
+
+  std::string table(wstr.size(), '\0');
+  for (size_t ch = 0; ch < wstr.size(); ++ch) {
+    if (static_cast<uint32_t>(wstr[ch]) >= 0x80) {
+      return std::string();
+    }
+    table[ch] = static_cast<char>(wstr[ch]);
+  }
+  return table;
+}
+
+inline void ChangeAsciiCase(const std::string& table, const std::string& s, std::string& out) {
+  out.resize(s.size());
+  std::transform(s.cbegin(), s.cend(), out.begin(),
+                 [&table](char ch) { return table[static_cast<unsigned char>(ch)]; });
+}
+
 template <class ForwardIter>
 Status CopyCaseAction(ForwardIter first, ForwardIter end, OpKernelContext* ctx,
                       const Locale& loc,
                       Utf8Converter& converter,
+                      const std::string& ascii_case_table,
                       size_t N, size_t C,
                       StringNormalizer::CaseAction caseaction) {
   std::vector<int64_t> output_dims;
@@ -234,7 +269,10 @@ Status CopyCaseAction(ForwardIter first, ForwardIter end, OpKernelContext* ctx,
   size_t output_idx = 0;
   while (first != end) {
     auto& s = *first;
-    if (caseaction == StringNormalizer::LOWER || caseaction == StringNormalizer::UPPER) {
+    if ((caseaction == StringNormalizer::LOWER || caseaction == StringNormalizer::UPPER) &&
+        !ascii_case_table.empty() && IsAscii(s)) {
+      ChangeAsciiCase(ascii_case_table, s, *(output_data + output_idx));
+    } else if (caseaction == StringNormalizer::LOWER || caseaction == StringNormalizer::UPPER) {
       std::wstring wstr = converter.from_bytes(s);
       if (wstr == wconv_error) {
         // Please do not include the input text in the error message as it could
@@ -290,6 +328,9 @@ StringNormalizer::StringNormalizer(const OpKernelInfo& info) : OpKernel(info),
   Locale locale(locale_name_);
   Utf8Converter converter(conv_error, wconv_error);
 
+  ascii_change_case_ = MakeAsciiCaseTable(locale, case_change_action_);
+  ascii_compare_case_ = MakeAsciiCaseTable(locale, compare_caseaction_);
+
   std::vector<std::string> swords = info.GetAttrsOrDefault<std::string>("stopwords");
   for (auto& sw : swords) {
     ORT_ENFORCE(!sw.empty(), "Empty stopwords not allowed");
@@ -352,10 +393,11 @@ Status StringNormalizer::Compute(OpKernelContext* ctx) const {
         ++first;
       }
       status = CopyCaseAction(filtered_strings.cbegin(), filtered_strings.cend(), ctx, locale, converter,
-                              N, filtered_strings.size(), case_change_action_);
+                              ascii_change_case_, N, filtered_strings.size(), case_change_action_);
     } else {
       // Nothing to filter. Copy input to output and change case if needed
-      status = CopyCaseAction(input_data, input_data + C, ctx, locale, converter, N, C, case_change_action_);
+      status = CopyCaseAction(input_data, input_data + C, ctx, locale, converter, ascii_change_case_,
+                              N, C, case_change_action_);
     }
   } else {
     if (!wstopwords_.empty()) {
@@ -370,17 +412,28 @@ Status StringNormalizer::Compute(OpKernelContext* ctx) const {
       auto const last = input_data + C;
       while (first != last) {
         const std::string& s = *first;
-        std::wstring wstr = converter.from_bytes(s);
-        if (wstr == wconv_error) {
-          // Please do not include the input text in the error message as it could
-          // be deemed as a compliance violation by teams using this operator
-          return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
-                        "Input contains invalid utf8 chars");
+        std::wstring wstr;
+        std::string ascii_cased;
+        const bool ascii = !ascii_compare_case_.empty() && IsAscii(s);
+        if (ascii) {
+          ChangeAsciiCase(ascii_compare_case_, s, ascii_cased);
+          wstr.assign(ascii_cased.cbegin(), ascii_cased.cend());
+        } else {
+          wstr = converter.from_bytes(s);
+          if (wstr == wconv_error) {
+            // Please do not include the input text in the error message as it could
+            // be deemed as a compliance violation by teams using this operator
+            return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
+                          "Input contains invalid utf8 chars");
+          }
+          locale.ChangeCase(compare_caseaction_, wstr);
         }
-        locale.ChangeCase(compare_caseaction_, wstr);
         if (0 == wstopwords_.count(wstr)) {
           if (case_change_action_ == NONE) {
             filtered_orignal_strings.push_back(std::cref(s));
+          } else if (ascii) {
+            // compare_caseaction_ is case_change_action_ when the latter is not NONE
+            filtered_cased_strings.push_back(std::move(ascii_cased));
           } else {
             filtered_cased_strings.push_back(converter.to_bytes(wstr));
           }
@@ -389,14 +442,15 @@ Status StringNormalizer::Compute(OpKernelContext* ctx) const {
       }
       if (case_change_action_ == NONE) {
         status = CopyCaseAction(filtered_orignal_strings.cbegin(), filtered_orignal_strings.cend(), ctx, locale, converter,
-                                N, filtered_orignal_strings.size(), NONE);
+                                ascii_change_case_, N, filtered_orignal_strings.size(), NONE);
       } else {
         status = CopyCaseAction(filtered_cased_strings.begin(), filtered_cased_strings.end(), ctx, locale, converter,
-                                N, filtered_cased_strings.size(), NONE);
+                                ascii_change_case_, N, filtered_cased_strings.size(), NONE);
       }
     } else {
       // Nothing to filter. Copy input to output and change case if needed
-      status = CopyCaseAction(input_data, input_data + C, ctx, locale, converter, N, C, case_change_action_);
+      status = CopyCaseAction(input_data, input_data + C, ctx, locale, converter, ascii_change_case_,
+                              N, C, case_change_action_);
     }
   }
   return status;
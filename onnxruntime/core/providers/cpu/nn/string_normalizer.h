@@ -29,6 +29,11 @@ class StringNormalizer : public OpKernel {
   CaseAction case_change_action_;
   CaseAction compare_caseaction_;  // used for case-insensitive compare
   std::string locale_name_;
+  // The case mappings of the locale for the ASCII characters, strings made of ASCII characters only are
+  // converted with them instead of going through wide strings. Empty if the locale maps an ASCII character
+  // outside of ASCII.
+  std::string ascii_change_case_;   // case_change_action_
+  std::string ascii_compare_case_;  // compare_caseaction_
   // Either if these are populated but not both
   InlinedHashSet<std::string> stopwords_;
   InlinedHashSet<std::wstring> wstopwords_;
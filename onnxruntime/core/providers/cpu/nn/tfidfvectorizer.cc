@@ -3,11 +3,14 @@
 
 #include "tfidfvectorizer.h"
 #include "core/common/common.h"
+#include "core/common/inlined_containers.h"
 #include "core/framework/tensor.h"
 #include "core/platform/threadpool.h"
 
+#include <algorithm>
 #include <functional>
-#include <unordered_map>
+#include <limits>
+#include <string_view>
 #include <core/common/safeint.h>
 
 namespace onnxruntime {
@@ -24,64 +27,43 @@ ONNX_CPU_OPERATOR_KERNEL(
 
 namespace ngram_details {
 
-// NgrampPart implements a Trie like structure
-// for a unigram (1) it would insert into a root map with a valid id.
-// for (1,2,3) node 2 would be a child of 1 but have id == 0
-// because (1,2) does not exists. Node 3 would have a valid id.
-template <class T>
-struct NgramPart;
+// The n-grams of the pool form a trie. Its nodes are numbered with 0 for the root, and all its edges are kept in
+// a single flat hash map keyed by (node, token), so following an n-gram does not hop between per node maps.
+// The tokens are the pool items renumbered densely. The items of an input row are converted to tokens once,
+// before all the n-grams of the row are matched.
+constexpr uint32_t kNoToken = std::numeric_limits<uint32_t>::max();
 
-template <>
-struct NgramPart<int64_t>;
-
-template <>
-struct NgramPart<std::string>;
-
-using NgramPartInt = NgramPart<int64_t>;
-using NgramPartString = NgramPart<std::string>;
-
-// Avoid recursive class definitions using unique_ptr + forward declaration
-using IntMap = std::unordered_map<int64_t, std::unique_ptr<NgramPartInt>>;
-
-using StrMap = std::unordered_map<std::reference_wrapper<const std::string>, std::unique_ptr<NgramPartString>,
-                                  std::hash<std::string>, std::equal_to<std::string>>;
-
-template <>
-struct NgramPart<int64_t> {
-  size_t id_;  // 0 - means no entry, search for a bigger N
-  IntMap leafs_;
-  explicit NgramPart(size_t id) : id_(id) {}
-};
-
-template <>
-struct NgramPart<std::string> {
-  size_t id_;  // 0 - means no entry, search for a bigger N
-  StrMap leafs_;
-  explicit NgramPart(size_t id) : id_(id) {}
-};
+inline uint64_t EdgeKey(uint32_t node, uint32_t token) {
+  return (static_cast<uint64_t>(node) << 32) | token;
+}
 
-// Returns next ngram_id
-template <class K, class ForwardIter, class Map>
-inline size_t PopulateGrams(ForwardIter first, size_t ngrams, size_t ngram_size, size_t ngram_id,
-                            Map& c) {
-  for (; ngrams > 0; --ngrams) {
-    size_t n = 1;
-    Map* m = &c;
-    while (true) {
-      auto p = m->emplace(*first, std::make_unique<NgramPart<K>>(0));
-      ++first;
-      if (n == ngram_size) {
-        ORT_ENFORCE(p.first->second->id_ == 0, "Duplicate ngram detected, size: ", ngram_size, " id: ", ngram_id);
-        p.first->second->id_ = ngram_id;
-        ++ngram_id;
-        break;
+struct NgramTrie {
+  // (node, token) -> child node
+  InlinedHashMap<uint64_t, uint32_t> edges_;
+  // n-gram id of each node. 0 - means no entry, search for a bigger N
+  std::vector<size_t> ids_{0};
+
+  bool empty() const { return edges_.empty(); }
+
+  // Returns next ngram_id
+  template <class ForwardIter, class TokenFn>
+  size_t PopulateGrams(ForwardIter first, size_t ngrams, size_t ngram_size, size_t ngram_id, TokenFn&& to_token) {
+    for (; ngrams > 0; --ngrams) {
+      uint32_t node = 0;
+      for (size_t n = 0; n < ngram_size; ++n, ++first) {
+        auto p = edges_.emplace(EdgeKey(node, to_token(*first)), static_cast<uint32_t>(ids_.size()));
+        if (p.second) {
+          ids_.push_back(0);
+        }
+        node = p.first->second;
       }
-      ++n;
-      m = &p.first->second->leafs_;
+      ORT_ENFORCE(ids_[node] == 0, "Duplicate ngram detected, size: ", ngram_size, " id: ", ngram_id);
+      ids_[node] = ngram_id;
+      ++ngram_id;
     }
+    return ngram_id;
   }
-  return ngram_id;
-}
+};
 
 }  // namespace ngram_details
 }  // namespace onnxruntime
@@ -90,10 +72,6 @@ using namespace onnxruntime::ngram_details;
 
 namespace onnxruntime {
 
-inline const void* AdvanceElementPtr(const void* p, size_t elements, size_t element_size) {
-  return reinterpret_cast<const uint8_t*>(p) + elements * element_size;
-}
-
 // The weighting criteria.
 // "TF"(term frequency),
 //    the counts are propagated to output
@@ -128,11 +106,11 @@ struct TfIdfVectorizer::Impl {
   gsl::span<const int64_t> ngram_indexes_;
   gsl::span<const float> weights_;
 
-  // This map contains references to pool_string_ entries
-  // of pool_strings attribute
-  StrMap str_map_;
-  // This map contains pool_int64s entries
-  IntMap int64_map_;
+  NgramTrie trie_;
+  // Tokens of the items of pool_strings or pool_int64s, only one of them is populated.
+  // The string keys are views of the pool_strings attribute.
+  InlinedHashMap<std::string_view, uint32_t> str_tokens_;
+  InlinedHashMap<int64_t, uint32_t> int64_tokens_;
 
   size_t output_size_ = 0;
 
@@ -141,14 +119,44 @@ struct TfIdfVectorizer::Impl {
   Impl(const Impl&) = delete;
   Impl& operator=(const Impl&) = delete;
 
-  void IncrementCount(size_t ngram_id, size_t row_num,
-                      std::vector<uint32_t>& frequencies) const {
+  // The output row holds the counts of the n-grams until the weights are applied
+  void IncrementCount(size_t ngram_id, float* output_row) const {
     assert(ngram_id != 0);
     --ngram_id;
     assert(ngram_id < ngram_indexes_.size());
-    size_t output_idx = row_num * output_size_ + SafeInt<size_t>(ngram_indexes_[ngram_id]);
-    assert(output_idx < frequencies.size());
-    ++frequencies[output_idx];
+    size_t output_idx = static_cast<size_t>(ngram_indexes_[ngram_id]);
+    assert(output_idx < output_size_);
+    output_row[output_idx] += 1.f;
+  }
+
+  // Replaces the counts of a row by their weighted values
+  void ApplyWeights(float* output_row) const {
+    const auto& w = weights_;
+    switch (weighting_criteria_) {
+      case kTF:
+        break;
+      case kIDF: {
+        if (!w.empty()) {
+          for (size_t i = 0; i < output_size_; ++i) {
+            output_row[i] = (output_row[i] > 0) ? w[i] : 0;
+          }
+        } else {
+          for (size_t i = 0; i < output_size_; ++i) {
+            output_row[i] = (output_row[i] > 0) ? 1.0f : 0;
+          }
+        }
+      } break;
+      case kTFIDF: {
+        if (!w.empty()) {
+          for (size_t i = 0; i < output_size_; ++i) {
+            output_row[i] *= w[i];
+          }
+        }
+      } break;
+      case kNone:  // fall-through
+      default:
+        assert(false);
+    }
   }
 };
 
@@ -209,10 +217,15 @@ TfIdfVectorizer::TfIdfVectorizer(const OpKernelInfo& info) : OpKernel(info), imp
   }
 
   gsl::span<const int64_t> pool_int64s;
-  std::vector<std::reference_wrapper<const std::string>> pool_strings;
-  status = info.GetAttrsStringRefs("pool_strings", pool_strings);
+  std::vector<std::string_view> pool_strings;
+  std::vector<std::reference_wrapper<const std::string>> pool_string_refs;
+  status = info.GetAttrsStringRefs("pool_strings", pool_string_refs);
   if (status.IsOK()) {
-    ORT_ENFORCE(!pool_strings.empty(), "pool_strings must not be empty if specified");
+    ORT_ENFORCE(!pool_string_refs.empty(), "pool_strings must not be empty if specified");
+    pool_strings.reserve(pool_string_refs.size());
+    for (const std::string& pool_string : pool_string_refs) {
+      pool_strings.emplace_back(pool_string);
+    }
   } else {
     status = info.GetAttrsAsSpan("pool_int64s", pool_int64s);
     ORT_ENFORCE(status.IsOK() && !pool_int64s.empty(), "non-empty pool_int64s is required if pool_strings not provided");
@@ -238,9 +251,19 @@ TfIdfVectorizer::TfIdfVectorizer(const OpKernelInfo& info) : OpKernel(info), imp
       // Skip loading into hash_set ngrams that are not in the range of [min_gram_length-max_gram_length]
       if (ngram_size >= min_gram_length && ngram_size <= max_gram_length) {
         if (pool_strings.empty()) {
-          ngram_id = PopulateGrams<int64_t>(pool_int64s.begin() + start_idx, ngrams, ngram_size, ngram_id, impl_->int64_map_);
+          auto& tokens = impl_->int64_tokens_;
+          ngram_id = impl_->trie_.PopulateGrams(pool_int64s.begin() + start_idx, ngrams, ngram_size, ngram_id,
+                                                [&tokens](int64_t item) {
+                                                  return tokens.emplace(item, static_cast<uint32_t>(tokens.size()))
+                                                      .first->second;
+                                                });
         } else {
-          ngram_id = PopulateGrams<std::string>(pool_strings.begin() + start_idx, ngrams, ngram_size, ngram_id, impl_->str_map_);
+          auto& tokens = impl_->str_tokens_;
+          ngram_id = impl_->trie_.PopulateGrams(pool_strings.begin() + start_idx, ngrams, ngram_size, ngram_id,
+                                                [&tokens](std::string_view item) {
+                                                  return tokens.emplace(item, static_cast<uint32_t>(tokens.size()))
+                                                      .first->second;
+                                                });
         }
       } else {
         ngram_id += ngrams;
@@ -252,127 +275,64 @@ TfIdfVectorizer::TfIdfVectorizer(const OpKernelInfo& info) : OpKernel(info), imp
 
 TfIdfVectorizer::~TfIdfVectorizer() = default;
 
-void TfIdfVectorizer::OutputResult(OpKernelContext* ctx, size_t B, const std::vector<uint32_t>& frequences) const {
-  const Impl& impl = *impl_;
-  std::vector<int64_t> output_dims;
-  if (B == 0) {
-    output_dims.push_back(impl.output_size_);
-    B = 1;  // For use in the loops below
-  } else {
-    output_dims.push_back(B);
-    output_dims.push_back(impl.output_size_);
-  }
-
-  const auto row_size = impl.output_size_;
-
-  TensorShape output_shape(output_dims);
-  assert(frequences.size() == static_cast<size_t>(output_shape.Size()));
+void TfIdfVectorizer::ComputeImpl(const Tensor& X, ptrdiff_t row_num, size_t row_size, float* output_row) const {
+  const auto& impl = *impl_;
 
-  auto Y = ctx->Output(0, output_shape);
-  auto output_data = Y->MutableData<float>();
-  const auto& w = impl.weights_;
-  switch (impl.weighting_criteria_) {
-    case kTF: {
-      for (auto f : frequences) {
-        *output_data++ = static_cast<float>(f);
-      }
-    } break;
-    case kIDF: {
-      if (!w.empty()) {
-        const auto* freqs = frequences.data();
-        for (size_t batch = 0; batch < B; ++batch) {
-          for (size_t i = 0; i < row_size; ++i) {
-            *output_data++ = (*freqs++ > 0) ? w[i] : 0;
-          }
-        }
-      } else {
-        for (auto f : frequences) {
-          *output_data++ = (f > 0) ? 1.0f : 0;
-        }
-      }
-    } break;
-    case kTFIDF: {
-      if (!w.empty()) {
-        const auto* freqs = frequences.data();
-        for (size_t batch = 0; batch < B; ++batch) {
-          for (size_t i = 0; i < row_size; ++i) {
-            *output_data++ = *freqs++ * w[i];
-          }
-        }
-      } else {
-        for (auto f : frequences) {
-          *output_data++ = static_cast<float>(f);
-        }
-      }
-    } break;
-    case kNone:  // fall-through
-    default:
-      assert(false);
+  // Convert the items of the row to tokens, kNoToken for the items that are not in the pool
+  InlinedVector<uint32_t> tokens(row_size);
+  const size_t row_start = SafeInt<size_t>(row_num) * row_size;
+  if (X.IsDataTypeString()) {
+    const std::string* items = X.Data<std::string>() + row_start;
+    const auto tokens_end = impl.str_tokens_.end();
+    for (size_t i = 0; i < row_size; ++i) {
+      auto hit = impl.str_tokens_.find(std::string_view(items[i]));
+      tokens[i] = hit == tokens_end ? kNoToken : hit->second;
+    }
+  } else if (X.IsDataType<int32_t>()) {
+    const int32_t* items = X.Data<int32_t>() + row_start;
+    const auto tokens_end = impl.int64_tokens_.end();
+    for (size_t i = 0; i < row_size; ++i) {
+      auto hit = impl.int64_tokens_.find(int64_t{items[i]});
+      tokens[i] = hit == tokens_end ? kNoToken : hit->second;
+    }
+  } else {
+    const int64_t* items = X.Data<int64_t>() + row_start;
+    const auto tokens_end = impl.int64_tokens_.end();
+    for (size_t i = 0; i < row_size; ++i) {
+      auto hit = impl.int64_tokens_.find(items[i]);
+      tokens[i] = hit == tokens_end ? kNoToken : hit->second;
+    }
   }
-}
 
-void TfIdfVectorizer::ComputeImpl(OpKernelContext* ctx, ptrdiff_t row_num, size_t row_size,
-                                  std::vector<uint32_t>& frequencies) const {
-  auto X = ctx->Input<Tensor>(0);
-  const auto elem_size = X->DataType()->Size();
-
-  const void* const row_begin = AdvanceElementPtr(X->DataRaw(), row_num * row_size, elem_size);
-  const void* const row_end = AdvanceElementPtr(row_begin, row_size, elem_size);
-
-  const auto& impl = *impl_;
-  const auto max_gram_length = impl.max_gram_length_;
-  const auto max_skip_distance = impl.max_skip_count_ + 1;  // Convert to distance
-  auto start_ngram_size = impl.min_gram_length_;
+  const auto& edges = impl.trie_.edges_;
+  const auto edges_end = edges.end();
+  const size_t max_gram_length = onnxruntime::narrow<size_t>(impl.max_gram_length_);
+  const size_t max_skip_distance = onnxruntime::narrow<size_t>(impl.max_skip_count_) + 1;  // Convert to distance
+  size_t start_ngram_size = onnxruntime::narrow<size_t>(impl.min_gram_length_);
 
-  for (auto skip_distance = 1; skip_distance <= max_skip_distance; ++skip_distance) {
-    auto ngram_start = row_begin;
-    auto const ngram_row_end = row_end;
-
-    while (ngram_start < ngram_row_end) {
+  for (size_t skip_distance = 1; skip_distance <= max_skip_distance; ++skip_distance) {
+    for (size_t ngram_start = 0; ngram_start < row_size; ++ngram_start) {
       // We went far enough so no n-grams of any size can be gathered
-      auto at_least_this = AdvanceElementPtr(ngram_start, SafeInt<size_t>(skip_distance) * (start_ngram_size - 1), elem_size);
-      if (at_least_this >= ngram_row_end) {
+      if (ngram_start + skip_distance * (start_ngram_size - 1) >= row_size) {
         break;
       }
 
-      auto ngram_item = ngram_start;
-      if (X->IsDataTypeString()) {
-        const std::string* str_item = reinterpret_cast<const std::string*>(ngram_item);
-        const StrMap* str_map = &impl.str_map_;
-        for (auto ngram_size = 1;
-             !str_map->empty() &&
-             ngram_size <= max_gram_length &&
-             str_item < ngram_row_end;
-             ++ngram_size, str_item += skip_distance) {
-          auto hit = str_map->find(*str_item);
-          if (hit == str_map->end()) {
-            break;
-          }
-          if (ngram_size >= start_ngram_size && hit->second->id_ != 0) {
-            impl.IncrementCount(hit->second->id_, row_num, frequencies);
-          }
-          str_map = &hit->second->leafs_;
+      uint32_t node = 0;
+      for (size_t ngram_size = 1, pos = ngram_start;
+           ngram_size <= max_gram_length && pos < row_size;
+           ++ngram_size, pos += skip_distance) {
+        if (tokens[pos] == kNoToken) {
+          break;
         }
-      } else {
-        const IntMap* int_map = &impl.int64_map_;
-        for (auto ngram_size = 1;
-             !int_map->empty() &&
-             ngram_size <= max_gram_length &&
-             ngram_item < ngram_row_end;
-             ++ngram_size, ngram_item = AdvanceElementPtr(ngram_item, skip_distance, elem_size)) {
-          int64_t val = (X->IsDataType<int32_t>()) ? int64_t{*reinterpret_cast<const int32_t*>(ngram_item)} : *reinterpret_cast<const int64_t*>(ngram_item);
-          auto hit = int_map->find(val);
-          if (hit == int_map->end()) {
-            break;
-          }
-          if (ngram_size >= start_ngram_size && hit->second->id_ != 0) {
-            impl.IncrementCount(hit->second->id_, row_num, frequencies);
-          }
-          int_map = &hit->second->leafs_;
+        auto hit = edges.find(EdgeKey(node, tokens[pos]));
+        if (hit == edges_end) {
+          break;
+        }
+        node = hit->second;
+        if (ngram_size >= start_ngram_size && impl.trie_.ids_[node] != 0) {
+          impl.IncrementCount(impl.trie_.ids_[node], output_row);
         }
       }
-      // Sliding window shift
-      ngram_start = AdvanceElementPtr(ngram_start, 1, elem_size);
     }
     // We count UniGrams only once since they are not affected
     // by skip distance
@@ -412,31 +372,34 @@ Status TfIdfVectorizer::Compute(OpKernelContext* ctx) const {
   }
 
   assert((num_rows * C) == total_items);
-  // Frequency holder allocate [B..output_size_]
-  // and init all to zero
-  std::vector<uint32_t> frequencies;
-  frequencies.resize(num_rows * impl_->output_size_, 0);
-
-  if (total_items == 0 ||
-      (X->IsDataTypeString() && impl_->str_map_.empty()) ||
-      ((X->IsDataType<int32_t>() || X->IsDataType<int64_t>()) && impl_->int64_map_.empty())) {
+
+  const size_t output_size = impl_->output_size_;
+  TensorShape output_shape = B == 0 ? TensorShape({static_cast<int64_t>(output_size)})
+                                    : TensorShape({static_cast<int64_t>(B), static_cast<int64_t>(output_size)});
+  auto Y = ctx->Output(0, output_shape);
+  float* output_data = Y->MutableData<float>();
+  // The n-grams are counted in the output, then the weights are applied to each row
+  std::fill_n(output_data, SafeInt<size_t>(num_rows) * output_size, 0.f);
+
+  if (total_items == 0 || impl_->trie_.empty() ||
+      (X->IsDataTypeString() && impl_->str_tokens_.empty()) ||
+      ((X->IsDataType<int32_t>() || X->IsDataType<int64_t>()) && impl_->int64_tokens_.empty())) {
     // TfidfVectorizer may receive an empty input when it follows a Tokenizer
     // (for example for a string containing only stopwords).
     // TfidfVectorizer returns a zero tensor of shape
     // {b_dim, output_size} when b_dim is the number of received observations
     // and output_size the is the maximum value in ngram_indexes attribute plus 1.
-    OutputResult(ctx, B, frequencies);
     return Status::OK();
   }
 
-  std::function<void(ptrdiff_t)> fn = [this, ctx, C, &frequencies](ptrdiff_t row_num) {
-    ComputeImpl(ctx, row_num, C, frequencies);
+  std::function<void(ptrdiff_t)> fn = [this, X, C, output_data, output_size](ptrdiff_t row_num) {
+    float* output_row = output_data + row_num * output_size;
+    ComputeImpl(*X, row_num, C, output_row);
+    impl_->ApplyWeights(output_row);
   };
 
   concurrency::ThreadPool::TryBatchParallelFor(ctx->GetOperatorThreadPool(), num_rows, std::move(fn), 0);
 
-  OutputResult(ctx, B, frequencies);
-
   return Status::OK();
 }
 
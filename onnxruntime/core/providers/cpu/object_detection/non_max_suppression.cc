@@ -13,10 +13,12 @@ limitations under the License.
 
 #include "non_max_suppression.h"
 
-#include <queue>
+#include <algorithm>
 #include <utility>
+#include <vector>
 
 #include "core/common/narrow.h"
+#include "core/platform/threadpool.h"
 #include "non_max_suppression_helper.h"
 
 // TODO:fix the warnings
@@ -43,6 +45,100 @@ ONNX_OPERATOR_KERNEL_EX(
 
 using namespace nms_helpers;
 
+namespace {
+
+// Corners and areas of boxes, one array per coordinate so that the overlap of a box with many others is computed
+// in a loop the compiler vectorizes
+struct BoxCorners {
+  std::vector<float> x_min;
+  std::vector<float> y_min;
+  std::vector<float> x_max;
+  std::vector<float> y_max;
+  std::vector<float> area;
+};
+
+// A candidate is compared with the selected boxes by blocks of this many, so that the comparison stops soon after
+// the candidate is suppressed without a branch per selected box
+constexpr size_t kSuppressionBlockSize = 16;
+
+// Corners of a box as SuppressByIOU computes them
+inline void GetBoxCorners(const float* box, int64_t center_point_box,
+                          float& x_min, float& y_min, float& x_max, float& y_max) {
+  if (0 == center_point_box) {
+    // boxes data format [y1, x1, y2, x2]
+    MaxMin(box[1], box[3], x_min, x_max);
+    MaxMin(box[0], box[2], y_min, y_max);
+  } else {
+    // boxes data format [x_center, y_center, width, height]
+    const float width_half = box[2] / 2;
+    const float height_half = box[3] / 2;
+    x_min = box[0] - width_half;
+    x_max = box[0] + width_half;
+    y_min = box[1] - height_half;
+    y_max = box[1] + height_half;
+  }
+}
+
+// Greedily selects the boxes of one class in descending score order, suppressing the boxes that overlap a selected
+// one by more than iou_threshold. The overlap test matches SuppressByIOU.
+void SelectBoxesOfClass(const float* batch_boxes, const float* class_scores, int64_t num_boxes,
+                        bool has_score_threshold, float score_threshold, int64_t max_output_boxes_per_class,
+                        int64_t center_point_box, float iou_threshold, std::vector<int64_t>& selected_box_indices) {
+  std::vector<std::pair<float, int64_t>> candidates;
+  candidates.reserve(narrow<size_t>(num_boxes));
+  for (int64_t box_index = 0; box_index < num_boxes; ++box_index) {
+    if (!has_score_threshold || class_scores[box_index] > score_threshold) {
+      candidates.emplace_back(class_scores[box_index], box_index);
+    }
+  }
+
+  // Higher scores first, and lower indices first among equal scores
+  std::sort(candidates.begin(), candidates.end(),
+            [](const std::pair<float, int64_t>& lhs, const std::pair<float, int64_t>& rhs) {
+              return lhs.first > rhs.first || (lhs.first == rhs.first && lhs.second < rhs.second);
+            });
+
+  BoxCorners selected;
+  for (const auto& candidate : candidates) {
+    if (static_cast<int64_t>(selected_box_indices.size()) >= max_output_boxes_per_class) {
+      break;
+    }
+
+    float x_min, y_min, x_max, y_max;
+    GetBoxCorners(batch_boxes + 4 * candidate.second, center_point_box, x_min, y_min, x_max, y_max);
+    const float area = (x_max - x_min) * (y_max - y_min);
+
+    const size_t num_selected = selected.area.size();
+    bool suppressed = false;
+    for (size_t begin = 0; begin < num_selected && !suppressed; begin += kSuppressionBlockSize) {
+      const size_t end = std::min(begin + kSuppressionBlockSize, num_selected);
+      for (size_t j = begin; j < end; ++j) {
+        const float intersection_x_min = std::max(x_min, selected.x_min[j]);
+        const float intersection_x_max = std::min(x_max, selected.x_max[j]);
+        const float intersection_y_min = std::max(y_min, selected.y_min[j]);
+        const float intersection_y_max = std::min(y_max, selected.y_max[j]);
+        const float intersection_area = (intersection_x_max - intersection_x_min) *
+                                        (intersection_y_max - intersection_y_min);
+        const float union_area = area + selected.area[j] - intersection_area;
+        suppressed |= (intersection_x_max > intersection_x_min) & (intersection_y_max > intersection_y_min) &
+                      (intersection_area > .0f) & (area > .0f) & (selected.area[j] > .0f) & (union_area > .0f) &
+                      (intersection_area / union_area > iou_threshold);
+      }
+    }
+
+    if (!suppressed) {
+      selected.x_min.push_back(x_min);
+      selected.y_min.push_back(y_min);
+      selected.x_max.push_back(x_max);
+      selected.y_max.push_back(y_max);
+      selected.area.push_back(area);
+      selected_box_indices.push_back(candidate.second);
+    }
+  }
+}
+
+}  // namespace
+
 // This works for both CPU and GPU.
 // CUDA kernel declare OrtMemTypeCPUInput for max_output_boxes_per_class(2), iou_threshold(3) and score_threshold(4)
 Status NonMaxSuppressionBase::PrepareCompute(OpKernelContext* ctx, PrepareContext& pc) {
@@ -135,68 +231,31 @@ Status NonMaxSuppression::Compute(OpKernelContext* ctx) const {
 
   const auto* const boxes_data = pc.boxes_data_;
   const auto* const scores_data = pc.scores_data_;
-
-  struct BoxInfoPtr {
-    float score_{};
-    int64_t index_{};
-
-    BoxInfoPtr() = default;
-    explicit BoxInfoPtr(float score, int64_t idx) : score_(score), index_(idx) {}
-    inline bool operator<(const BoxInfoPtr& rhs) const {
-      return score_ < rhs.score_ || (score_ == rhs.score_ && index_ > rhs.index_);
-    }
-  };
-
   const auto center_point_box = GetCenterPointBox();
-
-  std::vector<SelectedIndex> selected_indices;
-  std::vector<BoxInfoPtr> selected_boxes_inside_class;
-  selected_boxes_inside_class.reserve(std::min<size_t>(static_cast<size_t>(max_output_boxes_per_class), pc.num_boxes_));
-
-  for (int64_t batch_index = 0; batch_index < pc.num_batches_; ++batch_index) {
-    for (int64_t class_index = 0; class_index < pc.num_classes_; ++class_index) {
-      int64_t box_score_offset = (batch_index * pc.num_classes_ + class_index) * pc.num_boxes_;
-      const float* batch_boxes = boxes_data + (batch_index * pc.num_boxes_ * 4);
-      std::vector<BoxInfoPtr> candidate_boxes;
-      candidate_boxes.reserve(pc.num_boxes_);
-
-      // Filter by score_threshold_
-      const auto* class_scores = scores_data + box_score_offset;
-      if (pc.score_threshold_ != nullptr) {
-        for (int64_t box_index = 0; box_index < pc.num_boxes_; ++box_index, ++class_scores) {
-          if (*class_scores > score_threshold) {
-            candidate_boxes.emplace_back(*class_scores, box_index);
-          }
-        }
-      } else {
-        for (int64_t box_index = 0; box_index < pc.num_boxes_; ++box_index, ++class_scores) {
-          candidate_boxes.emplace_back(*class_scores, box_index);
-        }
-      }
-      std::priority_queue<BoxInfoPtr, std::vector<BoxInfoPtr>> sorted_boxes(std::less<BoxInfoPtr>(), std::move(candidate_boxes));
-
-      selected_boxes_inside_class.clear();
-      // Get the next box with top score, filter by iou_threshold
-      while (!sorted_boxes.empty() && static_cast<int64_t>(selected_boxes_inside_class.size()) < max_output_boxes_per_class) {
-        const BoxInfoPtr& next_top_score = sorted_boxes.top();
-
-        bool selected = true;
-        // Check with existing selected boxes for this class, suppress if exceed the IOU (Intersection Over Union) threshold
-        for (const auto& selected_index : selected_boxes_inside_class) {
-          if (SuppressByIOU(batch_boxes, next_top_score.index_, selected_index.index_, center_point_box, iou_threshold)) {
-            selected = false;
-            break;
-          }
+  const bool has_score_threshold = pc.score_threshold_ != nullptr;
+  const int64_t num_boxes = pc.num_boxes_;
+
+  // The classes of every batch are independent, so they are processed in parallel and their selections are
+  // concatenated in order afterwards
+  const int64_t num_tasks = pc.num_batches_ * pc.num_classes_;
+  std::vector<std::vector<int64_t>> selected_boxes(narrow<size_t>(num_tasks));
+  concurrency::ThreadPool::TryParallelFor(
+      ctx->GetOperatorThreadPool(), narrow<std::ptrdiff_t>(num_tasks), static_cast<double>(num_boxes) * 16.0,
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t task = first; task < last; ++task) {
+          const int64_t batch_index = task / pc.num_classes_;
+          SelectBoxesOfClass(boxes_data + batch_index * num_boxes * 4, scores_data + task * num_boxes, num_boxes,
+                             has_score_threshold, score_threshold, max_output_boxes_per_class, center_point_box,
+                             iou_threshold, selected_boxes[task]);
         }
+      });
 
-        if (selected) {
-          selected_boxes_inside_class.push_back(next_top_score);
-          selected_indices.emplace_back(batch_index, class_index, next_top_score.index_);
-        }
-        sorted_boxes.pop();
-      }  // while
-    }    // for class_index
-  }      // for batch_index
+  std::vector<SelectedIndex> selected_indices;
+  for (int64_t task = 0; task < num_tasks; ++task) {
+    for (int64_t box_index : selected_boxes[narrow<size_t>(task)]) {
+      selected_indices.emplace_back(task / pc.num_classes_, task % pc.num_classes_, box_index);
+    }
+  }
 
   constexpr auto last_dim = 3;
   const auto num_selected = selected_indices.size();
@@ -20,6 +20,38 @@ class QLinearConv : public OpKernel {
  public:
   explicit QLinearConv(const OpKernelInfo& info) : OpKernel(info), conv_attrs_(info) {
     channels_last_ = (info.GetAttrOrDefault<int64_t>("channels_last", static_cast<int64_t>(0)) != 0);
+
+    // The residual add and activation of a fused QLinearConv -> QLinearAdd [-> QLinearLeakyRelu] chain.
+    const auto& input_defs = info.node().InputDefs();
+    has_sum_ = input_defs.size() > InputTensors::IN_SUM && input_defs[InputTensors::IN_SUM]->Exists();
+
+    const std::string activation = info.GetAttrOrDefault<std::string>("activation", "");
+    if (!activation.empty()) {
+      ORT_ENFORCE(has_sum_ && activation == "LeakyRelu",
+                  "QLinearConv : only a LeakyRelu activation following a residual add is supported");
+      const auto activation_params = info.GetAttrsOrDefault<float>("activation_params");
+      activation_alpha_ = activation_params.empty() ? 0.01f : activation_params[0];
+      has_activation_ = true;
+
+      // Missing zero points default to zero.
+      auto try_get_optional_constant = [&](int input_idx, const Tensor** tensor) {
+        return static_cast<size_t>(input_idx) >= input_defs.size() || !input_defs[input_idx]->Exists() ||
+               info.TryGetConstantInput(input_idx, tensor);
+      };
+
+      const Tensor* x_scale = nullptr;
+      const Tensor* x_zero_point = nullptr;
+      const Tensor* y_scale = nullptr;
+      const Tensor* y_zero_point = nullptr;
+      if (info.TryGetConstantInput(InputTensors::IN_SUM_Y_SCALE, &x_scale) &&
+          try_get_optional_constant(InputTensors::IN_SUM_Y_ZERO_POINT, &x_zero_point) &&
+          info.TryGetConstantInput(InputTensors::IN_ACTIVATION_Y_SCALE, &y_scale) &&
+          try_get_optional_constant(InputTensors::IN_ACTIVATION_Y_ZERO_POINT, &y_zero_point)) {
+        activation_table_.resize(256);
+        BuildActivationTable(activation_alpha_, x_scale, x_zero_point, y_scale, y_zero_point,
+                             activation_table_.data());
+      }
+    }
   }
 
   Status Compute(OpKernelContext* context) const override;
@@ -42,7 +74,14 @@ class QLinearConv : public OpKernel {
     IN_W_ZERO_POINT = 5,
     IN_Y_SCALE = 6,
     IN_Y_ZERO_POINT = 7,
-    IN_BIAS = 8
+    IN_BIAS = 8,
+    IN_SUM = 9,
+    IN_SUM_SCALE = 10,
+    IN_SUM_ZERO_POINT = 11,
+    IN_SUM_Y_SCALE = 12,
+    IN_SUM_Y_ZERO_POINT = 13,
+    IN_ACTIVATION_Y_SCALE = 14,
+    IN_ACTIVATION_Y_ZERO_POINT = 15
   };
 
   enum OutputTensors : int {
@@ -107,6 +146,37 @@ class QLinearConv : public OpKernel {
     return output_scales;
   }
 
+  static ActType GetZeroPointValue(const Tensor* zero_point) {
+    ORT_ENFORCE(zero_point == nullptr || IsScalarOr1ElementVector(zero_point),
+                "QLinearConv : zero point must be a scalar or 1D tensor of size 1");
+    return zero_point != nullptr ? *(zero_point->Data<ActType>()) : static_cast<ActType>(0);
+  }
+
+  static float GetScaleValue(const Tensor* scale) {
+    ORT_ENFORCE(IsScalarOr1ElementVector(scale), "QLinearConv : scale must be a scalar or 1D tensor of size 1");
+    return *(scale->Data<float>());
+  }
+
+  // Builds the table that maps the quantized results of the residual add to the
+  // quantized results of the LeakyRelu activation, as QLinearLeakyRelu does.
+  static void BuildActivationTable(float alpha,
+                                   const Tensor* x_scale,
+                                   const Tensor* x_zero_point,
+                                   const Tensor* y_scale,
+                                   const Tensor* y_zero_point,
+                                   ActType* table) {
+    const float x_scale_value = GetScaleValue(x_scale);
+    const ActType x_zero_point_value = GetZeroPointValue(x_zero_point);
+
+    float dequantized[256];
+    for (int i = 0; i < 256; ++i) {
+      const float x = x_scale_value * (static_cast<int>(static_cast<ActType>(i)) -
+                                       static_cast<int>(x_zero_point_value));
+      dequantized[i] = x >= 0.0f ? x : alpha * x;
+    }
+    MlasQuantizeLinear(dequantized, table, 256, GetScaleValue(y_scale), GetZeroPointValue(y_zero_point));
+  }
+
   /**
    * @brief Computes the partition stride of the activation tensor.
    *
@@ -298,6 +368,10 @@ class QLinearConv : public OpKernel {
   bool is_symmetric_conv_{false};
   bool is_symmetric_gemm_{false};
   bool channels_last_{false};
+  bool has_sum_{false};
+  bool has_activation_{false};
+  float activation_alpha_{0.01f};
+  std::vector<ActType> activation_table_;
   std::vector<int32_t> column_sums_;
 };
 
@@ -569,6 +643,47 @@ Status QLinearConv<ActType>::Compute(OpKernelContext* context) const {
     return Status::OK();
   }
 
+  // Quantization parameters of the fused residual add and activation.
+  const Tensor* Sum = has_sum_ ? context->Input<Tensor>(InputTensors::IN_SUM) : nullptr;
+  float Y_scale_value = 0.0f;
+  float Sum_scale_value = 0.0f;
+  ActType Sum_zero_point_value = 0;
+  float Sum_Y_scale_value = 0.0f;
+  ActType Sum_Y_zero_point_value = 0;
+  const ActType* activation_table = nullptr;
+  ActType dynamic_activation_table[256];
+  if (Sum != nullptr) {
+    ORT_RETURN_IF_NOT(Sum->Shape() == Y->Shape(), "QLinearConv : sum shape ", Sum->Shape(),
+                      " does not match the output shape ", Y->Shape());
+    Y_scale_value = GetScaleValue(context->Input<Tensor>(InputTensors::IN_Y_SCALE));
+    Sum_scale_value = GetScaleValue(context->Input<Tensor>(InputTensors::IN_SUM_SCALE));
+    Sum_zero_point_value = GetZeroPointValue(context->Input<Tensor>(InputTensors::IN_SUM_ZERO_POINT));
+    Sum_Y_scale_value = GetScaleValue(context->Input<Tensor>(InputTensors::IN_SUM_Y_SCALE));
+    Sum_Y_zero_point_value = GetZeroPointValue(context->Input<Tensor>(InputTensors::IN_SUM_Y_ZERO_POINT));
+    if (has_activation_) {
+      if (activation_table_.empty()) {
+        BuildActivationTable(activation_alpha_,
+                             context->Input<Tensor>(InputTensors::IN_SUM_Y_SCALE),
+                             context->Input<Tensor>(InputTensors::IN_SUM_Y_ZERO_POINT),
+                             context->Input<Tensor>(InputTensors::IN_ACTIVATION_Y_SCALE),
+                             context->Input<Tensor>(InputTensors::IN_ACTIVATION_Y_ZERO_POINT),
+                             dynamic_activation_table);
+        activation_table = dynamic_activation_table;
+      } else {
+        activation_table = activation_table_.data();
+      }
+    }
+  }
+
+  // Adds the residual input to a block of the requantized output and applies the
+  // activation, while the block is still in cache.
+  auto add_sum = [&](ActType* output, const ActType* sum, size_t count) {
+    MlasQLinearAddLookup(output, Y_scale_value, static_cast<int32_t>(Y_zero_point_value),
+                         sum, Sum_scale_value, static_cast<int32_t>(Sum_zero_point_value),
+                         Sum_Y_scale_value, static_cast<int32_t>(Sum_Y_zero_point_value),
+                         activation_table, output, count);
+  };
+
   const int64_t input_image_size = input_shape.Size();
   const int64_t output_image_size = output_shape.Size();
   const int64_t kernel_size = TensorShape(kernel_shape).Size();
@@ -629,6 +744,7 @@ Status QLinearConv<ActType>::Compute(OpKernelContext* context) const {
   const auto* Xdata = X->Data<ActType>();
   const auto* Bdata = B != nullptr ? B->Data<int32_t>() : nullptr;
   auto* Ydata = Y->MutableData<ActType>();
+  const auto* Sumdata = Sum != nullptr ? Sum->Data<ActType>() : nullptr;
 
   BufferUniquePtr transpose_input_buffer;
   BufferUniquePtr transpose_output_buffer;
@@ -769,6 +885,11 @@ Status QLinearConv<ActType>::Compute(OpKernelContext* context) const {
       } else {
         MlasConvSym(conv_params);
       }
+
+      if (Sumdata != nullptr) {
+        add_sum(worker_output, Sumdata + Y_offset * image_id + output_start * M,
+                static_cast<size_t>(output_count * M));
+      }
     };
 
     concurrency::ThreadPool::TrySimpleParallelFor(thread_pool, onnxruntime::narrow<ptrdiff_t>(task_count * N), conv_worker);
@@ -860,6 +981,10 @@ Status QLinearConv<ActType>::Compute(OpKernelContext* context) const {
         } else {
           MlasConvSym(conv_params);
         }
+
+        if (channels_last_ && Sumdata != nullptr) {
+          add_sum(worker_output, Sumdata + output_start * M, static_cast<size_t>(output_count * M));
+        }
         return;
       }
 
@@ -973,6 +1098,26 @@ Status QLinearConv<ActType>::Compute(OpKernelContext* context) const {
         }
       }
 
+      if (channels_last_ && Sumdata != nullptr) {
+        MLAS_QGEMM_REQUANT_ADD_OUTPUT_PROCESSOR<ActType> output_processor(
+            worker_output,
+            static_cast<size_t>(M),
+            Bdata,
+            output_scales.data(),
+            output_scales.size() > 1,
+            Y_scale_value,
+            Y_zero_point_value,
+            Sumdata + output_start * M,
+            Sum_scale_value,
+            static_cast<int32_t>(Sum_zero_point_value),
+            Sum_Y_scale_value,
+            static_cast<int32_t>(Sum_Y_zero_point_value),
+            activation_table);
+        output_processor.Process(worker_gemm_output, 0, 0, static_cast<size_t>(output_count),
+                                 static_cast<size_t>(M), static_cast<size_t>(M));
+        return;
+      }
+
       MlasRequantizeOutput(
           worker_gemm_output,
           static_cast<size_t>(M),
@@ -997,10 +1142,18 @@ Status QLinearConv<ActType>::Compute(OpKernelContext* context) const {
           Ydata,
           static_cast<size_t>(output_image_size),
           static_cast<size_t>(M));
+
+      // The residual input is channels first as well, so add it to the whole image.
+      if (Sumdata != nullptr) {
+        add_sum(Ydata, Sumdata, static_cast<size_t>(Y_offset));
+      }
     }
 
     Xdata += X_offset;
     Ydata += Y_offset;
+    if (Sumdata != nullptr) {
+      Sumdata += Y_offset;
+    }
   }
 
   return Status::OK();
@@ -326,6 +326,64 @@ void ReduceAggregatorBase::FastReduceKRK(const Tensor&, const gsl::span<const in
 void ReduceAggregatorBase::FastReduceRKR(const Tensor&, const gsl::span<const int64_t>&, Tensor&, concurrency::ThreadPool*) {
   ValidateMustBeOverloaded();
 }
+void ReduceAggregatorBase::FastReduceStrided(const Tensor&, const gsl::span<const int64_t>&, const gsl::span<const int64_t>&,
+                                             Tensor&, concurrency::ThreadPool*) {
+  ValidateMustBeOverloaded();
+}
+
+// Offsets of all the positions of the given dimensions, in row major order.
+static void StridedOffsets(gsl::span<const int64_t> dims, gsl::span<const int64_t> strides,
+                           TensorShapeVector& offsets) {
+  offsets.assign(1, 0);
+  for (size_t i = 0; i < dims.size(); ++i) {
+    const size_t previous = offsets.size();
+    const size_t dim = onnxruntime::narrow<size_t>(dims[i]);
+    offsets.resize(previous * dim);
+    // Expands in place from the end so that offsets[j] is read before it is overwritten.
+    for (size_t j = previous; j-- > 0;) {
+      const int64_t origin = offsets[j];
+      for (size_t k = 0; k < dim; ++k) {
+        offsets[j * dim + k] = origin + static_cast<int64_t>(k) * strides[i];
+      }
+    }
+  }
+}
+
+void PrepareStridedReduce(gsl::span<const int64_t> fast_shape, gsl::span<const int64_t> fast_axes,
+                          StridedReducePlan& plan) {
+  ORT_ENFORCE(!fast_shape.empty(), "Cannot reduce a scalar with a strided plan.");
+  const size_t n_dims = fast_shape.size();
+  InlinedVector<bool> reduce(n_dims, false);
+  for (auto a : fast_axes) {
+    reduce[onnxruntime::narrow<size_t>(a)] = true;
+  }
+
+  TensorShapeVector kept_dims, kept_strides, reduced_dims, reduced_strides;
+  int64_t stride = 1;
+  for (size_t i = n_dims; i-- > 0;) {
+    if (reduce[i]) {
+      reduced_dims.insert(reduced_dims.begin(), fast_shape[i]);
+      reduced_strides.insert(reduced_strides.begin(), stride);
+    } else {
+      kept_dims.insert(kept_dims.begin(), fast_shape[i]);
+      kept_strides.insert(kept_strides.begin(), stride);
+    }
+    stride *= fast_shape[i];
+  }
+
+  // The innermost dimension is contiguous and is not enumerated in the offsets.
+  plan.inner_reduced = reduce[n_dims - 1];
+  plan.inner_size = fast_shape[n_dims - 1];
+  if (plan.inner_reduced) {
+    reduced_dims.pop_back();
+    reduced_strides.pop_back();
+  } else {
+    kept_dims.pop_back();
+    kept_strides.pop_back();
+  }
+  StridedOffsets(kept_dims, kept_strides, plan.kept_offsets);
+  StridedOffsets(reduced_dims, reduced_strides, plan.reduced_offsets);
+}
 
 void NoTransposePrepareForReduce(const TensorShape& new_input_shape,
                                  gsl::span<const int64_t> reduced_axes,
@@ -713,6 +771,9 @@ bool CommonFastReduceCopy(OpKernelContext* ctx, TensorShapeVector& input_axes, b
 
 typedef void fast_reduce_fct(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
                              Tensor& output, concurrency::ThreadPool* tp);
+typedef void fast_reduce_strided_fct(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                                     const gsl::span<const int64_t>& fast_axes,
+                                     Tensor& output, concurrency::ThreadPool* tp);
 
 bool CommonFastReduceSwitch(OpKernelContext* ctx,
                             const gsl::span<const int64_t>& axes_,
@@ -726,7 +787,8 @@ bool CommonFastReduceSwitch(OpKernelContext* ctx,
                             fast_reduce_fct* case_kr,
                             fast_reduce_fct* case_rk,
                             fast_reduce_fct* case_krk,
-                            fast_reduce_fct* case_rkr) {
+                            fast_reduce_fct* case_rkr,
+                            fast_reduce_strided_fct* case_strided) {
   TensorShapeVector axes;
   const Tensor* input = ctx->Input<Tensor>(0);
   auto reduced_dims = input->Shape().GetDims();
@@ -739,6 +801,9 @@ bool CommonFastReduceSwitch(OpKernelContext* ctx,
   fast_kind = OptimizeShapeForFastReduce(
       reduced_dims, input_axes.empty() ? axes_ : input_axes,
       fast_shape, output_shape, fast_axes, keepdims_ != 0, noop_with_empty_axes);
+  if (fast_kind == FastReduceKind::kNone && fast_shape.size() > 3) {
+    fast_kind = FastReduceKind::kStrided;
+  }
 
   if (which_fast_reduce != FastReduceKind::kNone) {
     if (IsFastReduceKindAvailable(fast_kind, which_fast_reduce)) {
@@ -778,6 +843,9 @@ bool CommonFastReduceSwitch(OpKernelContext* ctx,
           } else {
             break;
           }
+        case FastReduceKind::kStrided:
+          case_strided(*input, fast_shape, fast_axes, *output, ctx->GetOperatorThreadPool());
+          return true;
         case FastReduceKind::kR:
         case FastReduceKind::kK:
         case FastReduceKind::kNone:
@@ -802,7 +870,7 @@ bool CommonFastReduce(OpKernelContext* ctx,
   return CommonFastReduceSwitch(ctx, axes_, keepdims_, noop_with_empty_axes,
                                 fast_kind, fast_shape, output_shape, fast_axes,
                                 AGG::WhichFastReduce(), &AGG::FastReduceKR, &AGG::FastReduceRK,
-                                &AGG::FastReduceKRK, &AGG::FastReduceRKR);
+                                &AGG::FastReduceKRK, &AGG::FastReduceRKR, &AGG::FastReduceStrided);
 }
 
 static void ValidateKeepDims(const TensorShape& shape, int64_t keepdims) {
@@ -949,6 +1017,9 @@ std::unique_ptr<Tensor> ReduceSum<T>::Impl(const Tensor& input, gsl::span<const
 
   FastReduceKind fast_kind = OptimizeShapeForFastReduce(
       reduced_dims, reduce_axes, fast_shape, output_shape, fast_axes, keep_dims, false);
+  if (fast_kind == FastReduceKind::kNone && fast_shape.size() > 3) {
+    fast_kind = FastReduceKind::kStrided;
+  }
 
   auto output = std::make_unique<Tensor>(input.DataType(), keep_dims ? output_shape : TensorShapeVector(), allocator);
 
@@ -997,6 +1068,9 @@ std::unique_ptr<Tensor> ReduceSum<T>::Impl(const Tensor& input, gsl::span<const
         } else {
           break;
         }
+      case FastReduceKind::kStrided:
+        ReduceAggregatorSum<T>::FastReduceStrided(input, fast_shape, fast_axes, *output, tp);
+        return output;
       case FastReduceKind::kR:
       case FastReduceKind::kK:
       case FastReduceKind::kNone:
@@ -14,19 +14,21 @@
 #include "core/util/math_cpuonly.h"
 #include "core/platform/threadpool.h"
 #include "core/common/safeint.h"
+#include <algorithm>
 #include <cmath>
 
 namespace onnxruntime {
 
 enum FastReduceKind {
-  kNone = 0,   // no fast implementation
-  kK = 1,      // kept dim = no reduce
-  kR = 2,      // reduced dim = all reduced
-  kKR = 4,     // kept dim, reduced dim
-  kRK = 8,     // reduced dim, kept dim
-  kKRK = 16,   // kept dim, reduced dim, kept dim
-  kRKR = 32,   // reduced dim, kept dim, reduced dim
-  kEmpty = 64  // empty reduce
+  kNone = 0,      // no fast implementation
+  kK = 1,         // kept dim = no reduce
+  kR = 2,         // reduced dim = all reduced
+  kKR = 4,        // kept dim, reduced dim
+  kRK = 8,        // reduced dim, kept dim
+  kKRK = 16,      // kept dim, reduced dim, kept dim
+  kRKR = 32,      // reduced dim, kept dim, reduced dim
+  kEmpty = 64,    // empty reduce
+  kStrided = 128  // any longer alternation of kept and reduced dims, see StridedReducePlan
 };
 
 FastReduceKind operator|(FastReduceKind a, FastReduceKind b);
@@ -60,6 +62,9 @@ constexpr TensorOpCost ParallelReduceFastCost(int64_t n_row, int64_t n_col, int6
   For these three configuration, the reduction may be optimized
   with vectors operations. Method WhichFastReduce() returns which case
   case be optimized for which aggregator.
+
+  Longer alternations such as KRKR or RKRK are returned as kNone and
+  may be reduced through a StridedReducePlan (kStrided).
 */
 FastReduceKind OptimizeShapeForFastReduce(gsl::span<const int64_t> input_shape,
                                           gsl::span<const int64_t> reduced_axes,
@@ -68,6 +73,28 @@ FastReduceKind OptimizeShapeForFastReduce(gsl::span<const int64_t> input_shape,
                                           TensorShapeVector& fast_axes,
                                           bool keep_dims, bool noop_with_empty_axes = false);
 
+/**
+  Strided plan of a reduction on a shape returned by OptimizeShapeForFastReduce,
+  whatever the number of alternations between kept and reduced dimensions.
+  The innermost dimension is contiguous:
+
+  * if it is reduced, every output element aggregates the contiguous runs
+    of inner_size elements starting at kept_offsets[i] + reduced_offsets[j],
+  * if it is kept, every block of inner_size output elements aggregates
+    element-wise the contiguous rows starting at kept_offsets[i] + reduced_offsets[j].
+
+  Both cases are vectorized along the innermost dimension.
+*/
+struct StridedReducePlan {
+  bool inner_reduced;
+  int64_t inner_size;
+  TensorShapeVector kept_offsets;
+  TensorShapeVector reduced_offsets;
+};
+
+void PrepareStridedReduce(gsl::span<const int64_t> fast_shape, gsl::span<const int64_t> fast_axes,
+                          StridedReducePlan& plan);
+
 class ResultsNoTransposePrepareForReduce {
  public:
   TensorShapeVector input_shape;
@@ -157,6 +184,8 @@ class ReduceAggregatorBase {
   static void FastReduceRK(const Tensor&, const gsl::span<const int64_t>&, Tensor&, concurrency::ThreadPool*);
   static void FastReduceKRK(const Tensor&, const gsl::span<const int64_t>&, Tensor&, concurrency::ThreadPool*);
   static void FastReduceRKR(const Tensor&, const gsl::span<const int64_t>&, Tensor&, concurrency::ThreadPool*);
+  static void FastReduceStrided(const Tensor&, const gsl::span<const int64_t>&, const gsl::span<const int64_t>&,
+                                Tensor&, concurrency::ThreadPool*);
 };
 
 template <typename T, typename TVAL = T>
@@ -203,6 +232,60 @@ class ReduceAggregator : public ReduceAggregatorBase {
           }
         });
   }
+
+  // f_init and f_update aggregate the contiguous runs when the innermost dimension is reduced,
+  // f_update_row aggregates element-wise a contiguous row into the output when it is kept.
+  static void CommonFastReduceStrided(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                                      const gsl::span<const int64_t>& fast_axes,
+                                      Tensor& output, concurrency::ThreadPool* tp,
+                                      std::function<TVAL(const T*)> f_init,
+                                      std::function<void(TVAL&, const T*, int64_t)> f_update,
+                                      std::function<void(TVAL*, const T*, int64_t)> f_update_row) {
+    StridedReducePlan plan;
+    PrepareStridedReduce(fast_shape, fast_axes, plan);
+    const T* data = input.Data<T>();
+    TVAL* out = output.MutableData<TVAL>();
+    const int64_t inner = plan.inner_size;
+    const TensorShapeVector& kept = plan.kept_offsets;
+    const TensorShapeVector& reduced = plan.reduced_offsets;
+    const int64_t n_reduced = static_cast<int64_t>(reduced.size());
+
+    if (plan.inner_reduced) {
+      concurrency::ThreadPool::TryParallelFor(
+          tp, onnxruntime::narrow<std::ptrdiff_t>(kept.size()),
+          ParallelReduceFastCost(1, n_reduced * inner, sizeof(T), 6),
+          [data, out, inner, &kept, &reduced, f_init, f_update](ptrdiff_t begin, ptrdiff_t last) {
+            for (ptrdiff_t d = begin; d < last; ++d) {
+              const T* p = data + kept[d];
+              out[d] = f_init(p);
+              for (int64_t offset : reduced) {
+                f_update(out[d], p + offset, inner);
+              }
+            }
+          });
+      return;
+    }
+
+    // Output elements are split in segments of their blocks, so that the threads are balanced
+    // even if there are fewer blocks than threads.
+    concurrency::ThreadPool::TryParallelFor(
+        tp, onnxruntime::narrow<std::ptrdiff_t>(static_cast<int64_t>(kept.size()) * inner),
+        ParallelReduceFastCost(1, n_reduced, sizeof(T), 6),
+        [data, out, inner, &kept, &reduced, f_update_row](ptrdiff_t begin, ptrdiff_t last) {
+          for (int64_t first = begin; first < last;) {
+            const int64_t block = first / inner;
+            const int64_t col = first % inner;
+            const int64_t size = std::min<int64_t>(inner - col, last - first);
+            const T* p = data + kept[onnxruntime::narrow<size_t>(block)] + col;
+            TVAL* o = out + first;
+            std::copy(p + reduced[0], p + reduced[0] + size, o);
+            for (size_t j = 1; j < reduced.size(); ++j) {
+              f_update_row(o, p + reduced[j], size);
+            }
+            first += size;
+          }
+        });
+  }
 };
 
 template <typename T>
@@ -219,7 +302,8 @@ class ReduceAggregatorSum : public ReduceAggregator<T, T> {
 
   // Fast reduction
   static inline FastReduceKind WhichFastReduce() {
-    return FastReduceKind::kKR | FastReduceKind::kRK | FastReduceKind::kKRK | FastReduceKind::kRKR;
+    return FastReduceKind::kKR | FastReduceKind::kRK | FastReduceKind::kKRK | FastReduceKind::kRKR |
+           FastReduceKind::kStrided;
   }
 
   static void FastReduceKR(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
@@ -280,6 +364,20 @@ class ReduceAggregatorSum : public ReduceAggregator<T, T> {
           value += aggall(p, size);
         });
   }
+
+  static void FastReduceStrided(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                                const gsl::span<const int64_t>& fast_axes,
+                                Tensor& output, concurrency::ThreadPool* tp) {
+    ReduceAggregator<T, T>::CommonFastReduceStrided(
+        input, fast_shape, fast_axes, output, tp,
+        [=](const T*) -> T { return 0; },
+        [=](T& value, const T* p, int64_t size) {
+          value += aggall(p, size);
+        },
+        [=](T* out, const T* p, int64_t size) {
+          EigenVectorArrayMap<T>(out, size) += ConstEigenVectorArrayMap<T>(p, size);
+        });
+  }
 };
 
 template <typename T, typename TVAL = T>
@@ -356,6 +454,16 @@ class ReduceAggregatorMean : public ReduceAggregatorSum<T> {
       *out /= div;
     }
   }
+  static void FastReduceStrided(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                                const gsl::span<const int64_t>& fast_axes,
+                                Tensor& output, concurrency::ThreadPool* tp) {
+    ReduceAggregatorSum<T>::FastReduceStrided(input, fast_shape, fast_axes, output, tp);
+    int64_t n_reduced = 1;
+    for (auto a : fast_axes) {
+      n_reduced *= fast_shape[onnxruntime::narrow<size_t>(a)];
+    }
+    EigenVectorArrayMap<T>(output.MutableData<T>(), output.Shape().Size()) /= static_cast<T>(n_reduced);
+  }
 };
 
 template <typename T>
@@ -372,7 +480,8 @@ class ReduceAggregatorMax : public ReduceAggregator<T> {
 
   // Fast reduction
   static inline FastReduceKind WhichFastReduce() {
-    return FastReduceKind::kKR | FastReduceKind::kRK | FastReduceKind::kKRK | FastReduceKind::kRKR;
+    return FastReduceKind::kKR | FastReduceKind::kRK | FastReduceKind::kKRK | FastReduceKind::kRKR |
+           FastReduceKind::kStrided;
   }
 
   static void FastReduceKR(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
@@ -442,6 +551,22 @@ class ReduceAggregatorMax : public ReduceAggregator<T> {
             value = v;
         });
   }
+
+  static void FastReduceStrided(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                                const gsl::span<const int64_t>& fast_axes,
+                                Tensor& output, concurrency::ThreadPool* tp) {
+    ReduceAggregator<T, T>::CommonFastReduceStrided(
+        input, fast_shape, fast_axes, output, tp,
+        [=](const T* p) -> T { return p[0]; },
+        [=](T& value, const T* p, int64_t size) {
+          T v = aggall(p, size);
+          if (v > value)
+            value = v;
+        },
+        [=](T* out, const T* p, int64_t size) {
+          EigenVectorArrayMap<T>(out, size) = EigenVectorArrayMap<T>(out, size).max(ConstEigenVectorArrayMap<T>(p, size));
+        });
+  }
 };
 
 template <typename T, typename TVAL = int64_t>
@@ -547,7 +672,8 @@ class ReduceAggregatorMin : public ReduceAggregator<T, T> {
 
   // Fast reduction
   static inline FastReduceKind WhichFastReduce() {
-    return FastReduceKind::kKR | FastReduceKind::kRK | FastReduceKind::kKRK | FastReduceKind::kRKR;
+    return FastReduceKind::kKR | FastReduceKind::kRK | FastReduceKind::kKRK | FastReduceKind::kRKR |
+           FastReduceKind::kStrided;
   }
 
   static void FastReduceKR(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
@@ -617,6 +743,22 @@ class ReduceAggregatorMin : public ReduceAggregator<T, T> {
             value = v;
         });
   }
+
+  static void FastReduceStrided(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                                const gsl::span<const int64_t>& fast_axes,
+                                Tensor& output, concurrency::ThreadPool* tp) {
+    ReduceAggregator<T, T>::CommonFastReduceStrided(
+        input, fast_shape, fast_axes, output, tp,
+        [=](const T* p) -> T { return p[0]; },
+        [=](T& value, const T* p, int64_t size) {
+          T v = aggall(p, size);
+          if (v < value)
+            value = v;
+        },
+        [=](T* out, const T* p, int64_t size) {
+          EigenVectorArrayMap<T>(out, size) = EigenVectorArrayMap<T>(out, size).min(ConstEigenVectorArrayMap<T>(p, size));
+        });
+  }
 };
 
 template <typename T>
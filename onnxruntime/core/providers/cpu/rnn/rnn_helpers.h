@@ -79,6 +79,17 @@ Status ValidateCommonRnnInputs(const Tensor& X,
                                int64_t num_directions,
                                int64_t hidden_size);
 
+// The two directions of a bidirectional LSTM or GRU run concurrently, each on a single thread for the whole
+// sequence, when the recurrent GEMM of a step is too small to be split over threads. The recurrent weights of a
+// direction then stay in the cache of the thread running it, and the steps do not pay for a parallel loop each.
+constexpr double kMaxConcurrentDirectionStepCost = 128.0 * 1024;
+
+inline bool RunDirectionsConcurrently(concurrency::ThreadPool* thread_pool, int batch_size, int num_gates,
+                                      int hidden_size) {
+  const double step_cost = static_cast<double>(batch_size) * num_gates * hidden_size * hidden_size;
+  return concurrency::ThreadPool::DegreeOfParallelism(thread_pool) >= 2 && step_cost <= kMaxConcurrentDirectionStepCost;
+}
+
 /// Copy an input array repeatedly to an output array
 /// @param input_begin Beginning of input
 /// @param input_end End of input
@@ -7,6 +7,7 @@
 #include <complex>
 #include <functional>
 #include <limits>
+#include <mutex>
 #include <vector>
 #include <core/common/safeint.h>
 
@@ -181,6 +182,118 @@ static Status fft_radix2(OpKernelContext* /*ctx*/, const Tensor* X, Tensor* Y, s
   return Status::OK();
 }
 
+// Sizes whose prime factors are all below this are transformed with a mixed-radix FFT, which costs
+// O(N * sum of factors) and so beats the three power-of-2 FFTs of twice the size that Bluestein's algorithm runs.
+constexpr size_t kMaxMixedRadixFactor = 32;
+
+// Prime factors of size, smallest first. Returns false if one of them is kMaxMixedRadixFactor or more.
+static bool mixed_radix_factors(size_t size, InlinedVector<size_t>& factors) {
+  factors.clear();
+  for (size_t p = 2; p < kMaxMixedRadixFactor && size > 1; p++) {
+    while (size % p == 0) {
+      factors.push_back(p);
+      size /= p;
+    }
+  }
+  return size == 1;
+}
+
+// Decimation-in-time step of a mixed-radix FFT of the n samples x[0], x[stride], ... into y[0..n). The twiddles
+// W_n^k of this size are twiddles[k * twiddle_stride], where twiddles holds those of the full size.
+template <typename T>
+static void fft_mixed_radix_step(const std::complex<T>* x, size_t stride, std::complex<T>* y, size_t n,
+                                 const size_t* factors, const std::complex<T>* twiddles, size_t twiddle_stride) {
+  const size_t p = factors[0];
+  const size_t m = n / p;
+
+  if (m == 1) {
+    for (size_t k = 0; k < p; k++) {
+      std::complex<T> sum = 0;
+      for (size_t j = 0; j < p; j++) {
+        sum += x[j * stride] * twiddles[((j * k) % p) * twiddle_stride];
+      }
+      y[k] = sum;
+    }
+    return;
+  }
+
+  // Transform the p interleaved subsequences of m samples into consecutive blocks of y
+  for (size_t r = 0; r < p; r++) {
+    fft_mixed_radix_step(x + r * stride, stride * p, y + r * m, m, factors + 1, twiddles, twiddle_stride * p);
+  }
+
+  // Y[k + q * m] = sum_r W_n^(r * k) * W_p^(r * q) * Y_r[k], where the p values of a k are read and written in place
+  std::complex<T> scaled[kMaxMixedRadixFactor];
+  for (size_t k = 0; k < m; k++) {
+    for (size_t r = 0; r < p; r++) {
+      scaled[r] = y[r * m + k] * twiddles[r * k * twiddle_stride];
+    }
+    if (p == 2) {
+      y[k] = scaled[0] + scaled[1];
+      y[k + m] = scaled[0] - scaled[1];
+      continue;
+    }
+    for (size_t q = 0; q < p; q++) {
+      std::complex<T> sum = scaled[0];
+      for (size_t r = 1; r < p; r++) {
+        sum += scaled[r] * twiddles[((r * q) % p) * m * twiddle_stride];
+      }
+      y[k + q * m] = sum;
+    }
+  }
+}
+
+template <typename T, typename U>
+static Status fft_mixed_radix(OpKernelContext* /*ctx*/, const Tensor* X, Tensor* Y, size_t X_offset, size_t X_stride,
+                              size_t Y_offset, size_t Y_stride, int64_t axis, size_t dft_length, const Tensor* window,
+                              bool is_onesided, bool inverse, InlinedVector<std::complex<T>>& V,
+                              InlinedVector<std::complex<T>>& temp_output) {
+  const auto& X_shape = X->Shape();
+  size_t number_of_samples = static_cast<size_t>(X_shape[onnxruntime::narrow<size_t>(axis)]);
+
+  InlinedVector<size_t> factors;
+  ORT_RETURN_IF_NOT(mixed_radix_factors(dft_length, factors), "dft_length ", dft_length,
+                    " has a prime factor too large for a mixed-radix FFT.");
+
+  auto* X_data = const_cast<U*>(reinterpret_cast<const U*>(X->DataRaw())) + X_offset;
+  U* window_data = nullptr;
+  if (window) {
+    window_data = const_cast<U*>(reinterpret_cast<const U*>(window->DataRaw()));
+  }
+
+  // The twiddles W_N^k in natural order
+  if (V.size() != dft_length) {
+    V.resize(dft_length);
+    auto angular_velocity = compute_angular_velocity<T>(dft_length, inverse);
+    for (size_t i = 0; i < dft_length; i++) {
+      V[i] = compute_exponential(i, angular_velocity);
+    }
+  }
+
+  // The windowed and zero-padded input is transformed from the first half of temp_output into the second half
+  if (temp_output.size() != 2 * dft_length) {
+    temp_output.resize(2 * dft_length);
+  }
+  std::complex<T>* input = temp_output.data();
+  std::complex<T>* output = input + dft_length;
+  for (size_t i = 0; i < dft_length; i++) {
+    auto x = (i < number_of_samples) ? *(X_data + i * X_stride) : 0;
+    auto window_element = window_data ? *(window_data + i) : 1;
+    input[i] = std::complex<T>(1, 0) * x * window_element;
+  }
+
+  fft_mixed_radix_step(input, 1, output, dft_length, factors.data(), V.data(), 1);
+
+  const size_t output_size = is_onesided ? (dft_length >> 1) + 1 : dft_length;
+  const T scale = inverse ? static_cast<T>(1) / static_cast<T>(dft_length) : static_cast<T>(1);
+  auto destination = reinterpret_cast<std::complex<T>*>(Y->MutableDataRaw()) + Y_offset;
+  for (size_t i = 0; i < output_size; i++) {
+    *(destination + Y_stride * i) = output[i] * scale;
+  }
+
+  return Status::OK();
+}
+
 template <typename T>
 T next_power_of_2(T in) {
   in--;
@@ -305,6 +418,31 @@ static Status dft_bluestein_z_chirp(
   return Status::OK();
 }
 
+// Runs count transforms of dft_length samples on the operator thread pool. Each block of transforms has its own
+// scratch buffer, and the first error is returned.
+template <typename T, typename TTransform>
+static Status run_dfts_in_parallel(OpKernelContext* ctx, size_t count, size_t dft_length, TTransform&& transform) {
+  std::mutex status_mutex;
+  Status status;
+  const double cost = 8.0 * static_cast<double>(dft_length) * std::log2(static_cast<double>(dft_length) + 1);
+  concurrency::ThreadPool::TryParallelFor(
+      ctx->GetOperatorThreadPool(), static_cast<std::ptrdiff_t>(count), cost,
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        InlinedVector<std::complex<T>> scratch;
+        for (std::ptrdiff_t i = first; i < last; i++) {
+          Status transform_status = transform(static_cast<size_t>(i), scratch);
+          if (!transform_status.IsOK()) {
+            std::lock_guard<std::mutex> lock(status_mutex);
+            if (status.IsOK()) {
+              status = transform_status;
+            }
+            return;
+          }
+        }
+      });
+  return status;
+}
+
 template <typename T, typename U>
 static Status discrete_fourier_transform(OpKernelContext* ctx, const Tensor* X, Tensor* Y, Tensor& b_fft, Tensor& chirp,
                                          int64_t axis, int64_t dft_length, const Tensor* window, bool is_onesided, bool inverse,
@@ -324,8 +462,13 @@ static Status discrete_fourier_transform(OpKernelContext* ctx, const Tensor* X,
     batch_and_signal_rank -= 1;
   }
 
+  const size_t length = onnxruntime::narrow<size_t>(dft_length);
+  InlinedVector<size_t> factors;
+  const bool use_radix2 = is_power_of_2(length);
+  const bool use_mixed_radix = !use_radix2 && mixed_radix_factors(length, factors);
+
   // Calculate x/y offsets/strides
-  for (size_t i = 0; i < total_dfts; i++) {
+  auto transform = [&](size_t i, InlinedVector<std::complex<T>>& dft_temp_output) -> Status {
     size_t X_offset = 0;
     size_t X_stride = onnxruntime::narrow<size_t>(X_shape.SizeFromDimension(SafeInt<size_t>(axis) + 1) / complex_input_factor);
     size_t cumulative_packed_stride = total_dfts;
@@ -354,13 +497,27 @@ static Status discrete_fourier_transform(OpKernelContext* ctx, const Tensor* X,
       Y_offset += index * SafeInt<size_t>(Y_shape.SizeFromDimension(r + 1)) / 2;
     }
 
-    if (is_power_of_2(onnxruntime::narrow<size_t>(dft_length))) {
-      ORT_RETURN_IF_ERROR((fft_radix2<T, U>(ctx, X, Y, X_offset, X_stride, Y_offset, Y_stride, axis, onnxruntime::narrow<size_t>(dft_length), window,
-                                            is_onesided, inverse, V, temp_output)));
-    } else {
-      ORT_RETURN_IF_ERROR(
-          (dft_bluestein_z_chirp<T, U>(ctx, X, Y, b_fft, chirp, X_offset, X_stride, Y_offset, Y_stride, axis, onnxruntime::narrow<size_t>(dft_length), window, inverse, V, temp_output)));
+    if (use_radix2) {
+      return fft_radix2<T, U>(ctx, X, Y, X_offset, X_stride, Y_offset, Y_stride, axis, length, window,
+                              is_onesided, inverse, V, dft_temp_output);
+    }
+    if (use_mixed_radix) {
+      return fft_mixed_radix<T, U>(ctx, X, Y, X_offset, X_stride, Y_offset, Y_stride, axis, length, window,
+                                   is_onesided, inverse, V, dft_temp_output);
     }
+    return dft_bluestein_z_chirp<T, U>(ctx, X, Y, b_fft, chirp, X_offset, X_stride, Y_offset, Y_stride, axis, length,
+                                       window, inverse, V, dft_temp_output);
+  };
+
+  // The first transform creates the twiddles and chirps of the size, after which they are only read, so the
+  // others run concurrently with a scratch buffer each.
+  if (total_dfts > 0) {
+    ORT_RETURN_IF_ERROR(transform(0, temp_output));
+  }
+  if (total_dfts > 1) {
+    ORT_RETURN_IF_ERROR(run_dfts_in_parallel<T>(
+        ctx, total_dfts - 1, length,
+        [&](size_t i, InlinedVector<std::complex<T>>& scratch) { return transform(i + 1, scratch); }));
   }
 
   return Status::OK();
@@ -520,23 +677,34 @@ static Status short_time_fourier_transform(OpKernelContext* ctx, bool is_oneside
   InlinedVector<std::complex<T>> temp_output;
 
   // Run each dft of each batch as if it was a real-valued batch size 1 dft operation
-  for (int64_t batch_idx = 0; batch_idx < batch_size; batch_idx++) {
-    for (int64_t i = 0; i < n_dfts; i++) {
-      auto input_frame_begin =
-          signal_data + (batch_idx * signal_size * signal_components) + (i * frame_step * signal_components);
+  auto transform_frame = [&](size_t frame, InlinedVector<std::complex<T>>& frame_temp_output) -> Status {
+    const int64_t batch_idx = static_cast<int64_t>(frame) / n_dfts;
+    const int64_t i = static_cast<int64_t>(frame) % n_dfts;
+    auto input_frame_begin =
+        signal_data + (batch_idx * signal_size * signal_components) + (i * frame_step * signal_components);
 
-      auto output_frame_begin = Y_data + (batch_idx * n_dfts * dft_output_size * output_components) +
-                                (i * dft_output_size * output_components);
+    auto output_frame_begin = Y_data + (batch_idx * n_dfts * dft_output_size * output_components) +
+                              (i * dft_output_size * output_components);
 
-      // Tensors do not own the backing memory, so no worries on destruction
-      auto input = onnxruntime::Tensor(signal->DataType(), dft_input_shape, input_frame_begin, signal->Location(), 0);
+    // Tensors do not own the backing memory, so no worries on destruction
+    auto input = onnxruntime::Tensor(signal->DataType(), dft_input_shape, input_frame_begin, signal->Location(), 0);
 
-      auto output = onnxruntime::Tensor(Y->DataType(), dft_output_shape, output_frame_begin, Y->Location(), 0);
+    auto output = onnxruntime::Tensor(Y->DataType(), dft_output_shape, output_frame_begin, Y->Location(), 0);
 
-      // Run individual dft
-      ORT_RETURN_IF_ERROR((discrete_fourier_transform<T, U>(ctx, &input, &output, b_fft, chirp, 1, window_size, window, is_onesided,
-                                                            false, V, temp_output)));
-    }
+    // Run individual dft
+    return discrete_fourier_transform<T, U>(ctx, &input, &output, b_fft, chirp, 1, window_size, window, is_onesided,
+                                            false, V, frame_temp_output);
+  };
+
+  // The first frame creates the twiddles and chirps shared by the others, which run concurrently
+  const size_t total_frames = onnxruntime::narrow<size_t>(batch_size * n_dfts);
+  if (total_frames > 0) {
+    ORT_RETURN_IF_ERROR(transform_frame(0, temp_output));
+  }
+  if (total_frames > 1) {
+    ORT_RETURN_IF_ERROR(run_dfts_in_parallel<T>(
+        ctx, total_frames - 1, onnxruntime::narrow<size_t>(window_size),
+        [&](size_t frame, InlinedVector<std::complex<T>>& scratch) { return transform_frame(frame + 1, scratch); }));
   }
 
   return Status::OK();
@@ -22,9 +22,7 @@
 #include "Eigen/src/Core/arch/Default/BFloat16.h"
 #include "Eigen/src/Core/arch/Default/Half.h"
 
-#if defined(_M_AMD64) && !defined(_M_ARM64EC)
 #include "core/mlas/inc/mlas.h"
-#endif
 
 namespace onnxruntime {
 
@@ -252,9 +250,7 @@ struct TensorCasterNoSat<std::string, DstType> {
 
 #endif
 
-#if defined(_M_AMD64) && !defined(_M_ARM64EC)
-// specializations to use optimized and Windows x64-specific
-// MlasConvertHalfToFloatBuffer() routine for MLFloat16 -> float conversion
+// specializations to use the vectorized MLAS conversions between float and the 16-bit float types
 
 // tensor MLFloat16 -> float
 template <>
@@ -267,6 +263,39 @@ struct TensorCaster<MLFloat16, float> {
   }
 };
 
+// tensor float -> MLFloat16
+template <>
+struct TensorCaster<float, MLFloat16> {
+  void Cast(const OpKernelContext&, const TensorShape& shape, const Tensor& in, Tensor& out) const {
+    auto out_data = out.MutableData<MLFloat16>();
+    auto in_data = in.Data<float>();
+    const size_t shape_size = narrow<size_t>(shape.Size());
+    MlasConvertFloatToHalfBuffer(in_data, &out_data[0].val, shape_size);
+  }
+};
+
+// tensor BFloat16 -> float
+template <>
+struct TensorCaster<BFloat16, float> {
+  void Cast(const OpKernelContext&, const TensorShape& shape, const Tensor& in, Tensor& out) const {
+    auto out_data = out.MutableData<float>();
+    auto in_data = in.Data<BFloat16>();
+    const size_t shape_size = narrow<size_t>(shape.Size());
+    MlasConvertBFloat16ToFloatBuffer(&in_data[0].val, out_data, shape_size);
+  }
+};
+
+// tensor float -> BFloat16
+template <>
+struct TensorCaster<float, BFloat16> {
+  void Cast(const OpKernelContext&, const TensorShape& shape, const Tensor& in, Tensor& out) const {
+    auto out_data = out.MutableData<BFloat16>();
+    auto in_data = in.Data<float>();
+    const size_t shape_size = narrow<size_t>(shape.Size());
+    MlasConvertFloatToBFloat16Buffer(in_data, &out_data[0].val, shape_size);
+  }
+};
+
 Tensor GetIntermediateMLFloat16ToFloatTensor(
     const OpKernelContext& context, const TensorShape& shape, const Tensor& in) {
   AllocatorPtr allocator;
@@ -299,7 +328,6 @@ struct TensorCaster<MLFloat16, std::string> {
     CastMLFloat16ThroughFloatTensor<std::string>(context, shape, in, out);
   }
 };
-#endif
 
 class Cast final : public OpKernel {
  public:
@@ -3,6 +3,13 @@
 
 #include "core/providers/cpu/tensor/compress.h"
 #include "core/providers/common.h"
+
+#include <algorithm>
+
+#include "core/common/narrow.h"
+#include "core/common/safeint.h"
+#include "core/platform/threadpool.h"
+
 using namespace ::onnxruntime::common;
 
 namespace onnxruntime {
@@ -25,6 +32,13 @@ ONNX_CPU_OPERATOR_KERNEL(
         .TypeConstraint("T1", DataTypeImpl::GetTensorType<bool>()),
     Compress);
 
+namespace {
+
+// Condition values scanned by each part of the condition at least, so that parts are not dispatched for a few values
+constexpr std::ptrdiff_t kMinConditionsPerPart = 16 * 1024;
+
+}  // namespace
+
 Status Compress::Compute(OpKernelContext* ctx) const {
   const auto* input_tensor = ctx->Input<Tensor>(0);
   size_t rank = input_tensor->Shape().NumDimensions();
@@ -38,17 +52,26 @@ Status Compress::Compute(OpKernelContext* ctx) const {
   auto condition_length = condition->Shape().Size();
   auto condition_data = condition->Data<bool>();
 
-  int64_t positive_condition_count = 0;
   // if has axis, we need to compress on dimension[axis], otherwise compress on the flattened input data
   int64_t compress_input_length = has_axis_ ? input_dimensions[onnxruntime::narrow<size_t>(axis)] : input_tensor->Shape().Size();
   int64_t valid_condition_length = compress_input_length < condition_length ? compress_input_length : condition_length;
 
-  // Figure out output shape
-  for (int i = 0; i < valid_condition_length; ++i) {
-    if (condition_data[i]) {
-      ++positive_condition_count;
-    }
+  // Collect the selected indices. The condition is split in parts that are scanned twice: once to count their
+  // selected indices, from which the position of the first one of each part follows by a prefix sum, and once to
+  // write them from that position on.
+  concurrency::ThreadPool* tp = ctx->GetOperatorThreadPool();
+  const std::ptrdiff_t num_parts = std::max<std::ptrdiff_t>(
+      1, std::min<std::ptrdiff_t>(concurrency::ThreadPool::DegreeOfParallelism(tp),
+                                  onnxruntime::narrow<std::ptrdiff_t>(valid_condition_length) / kMinConditionsPerPart));
+  std::vector<int64_t> part_offsets(SafeInt<size_t>(num_parts) + 1, 0);
+  concurrency::ThreadPool::TrySimpleParallelFor(tp, num_parts, [&](std::ptrdiff_t part) {
+    const auto work = concurrency::ThreadPool::PartitionWork(part, num_parts, valid_condition_length);
+    part_offsets[part + 1] = std::count(condition_data + work.start, condition_data + work.end, true);
+  });
+  for (std::ptrdiff_t part = 0; part < num_parts; ++part) {
+    part_offsets[part + 1] += part_offsets[part];
   }
+  const int64_t positive_condition_count = part_offsets[num_parts];
 
   std::vector<int64_t> output_dims(input_dimensions.begin(), input_dimensions.end());
   if (has_axis_) {
@@ -64,60 +87,69 @@ Status Compress::Compute(OpKernelContext* ctx) const {
     return Status::OK();
   }
 
+  std::vector<int64_t> selected(onnxruntime::narrow<size_t>(positive_condition_count));
+  concurrency::ThreadPool::TrySimpleParallelFor(tp, num_parts, [&](std::ptrdiff_t part) {
+    const auto work = concurrency::ThreadPool::PartitionWork(part, num_parts, valid_condition_length);
+    int64_t position = part_offsets[part];
+    for (std::ptrdiff_t j = work.start; j < work.end; ++j) {
+      if (condition_data[j]) {
+        selected[onnxruntime::narrow<size_t>(position++)] = j;
+      }
+    }
+  });
+
   const auto* input_data = static_cast<const uint8_t*>(input_tensor->DataRaw());
   auto* output_data = static_cast<uint8_t*>(output_tensor->MutableDataRaw());
   auto element_bytes = input_tensor->DataType()->Size();
   bool is_string_type = input_tensor->IsDataTypeString();
-  int64_t output_index = 0;
 
+  // Without an axis the flattened input is compressed, which is a compression on the only axis of a 1-D input
+  int64_t axes_left_stride = 1;
+  int64_t axes_right_stride = 1;
   if (has_axis_) {
-    int64_t axes_left_stride = 1;
-    int64_t axes_right_stride = 1;
-    for (int i = 0; i < axis; ++i) {
-      axes_left_stride *= input_dimensions[i];
+    for (int64_t i = 0; i < axis; ++i) {
+      axes_left_stride *= input_dimensions[onnxruntime::narrow<size_t>(i)];
     }
 
     for (auto i = static_cast<size_t>(axis + 1); i < rank; ++i) {
       axes_right_stride *= input_dimensions[i];
     }
-    int64_t axes_included_right_stride = axes_right_stride * input_dimensions[onnxruntime::narrow<size_t>(axis)];
-    int64_t axes_included_right_stride_bytes = axes_included_right_stride * element_bytes;
-    ORT_ENFORCE(axes_right_stride >= 0 &&
-                static_cast<uint64_t>(axes_right_stride) < std::numeric_limits<size_t>::max());
-    size_t axes_right_stride_bytes = 0;
-    if (!IAllocator::CalcMemSizeForArray(static_cast<size_t>(axes_right_stride), element_bytes,
-                                         &axes_right_stride_bytes))
-      return Status(ONNXRUNTIME, FAIL, "size overflow");
-    for (int i = 0; i < axes_left_stride; ++i) {
-      for (int j = 0; j < valid_condition_length; ++j) {
-        if (!condition_data[j]) {
-          continue;
-        }
-        if (is_string_type) {
-          for (int idxItem = 0; idxItem < axes_right_stride; ++idxItem) {
-            reinterpret_cast<std::string*>(output_data)[output_index + idxItem] =
-                reinterpret_cast<const std::string*>(input_data)[i * axes_included_right_stride + j * axes_right_stride + idxItem];
+  }
+  int64_t axes_included_right_stride = axes_right_stride * compress_input_length;
+  ORT_ENFORCE(axes_right_stride >= 0 &&
+              static_cast<uint64_t>(axes_right_stride) < std::numeric_limits<size_t>::max());
+  size_t axes_right_stride_bytes = 0;
+  if (!IAllocator::CalcMemSizeForArray(static_cast<size_t>(axes_right_stride), element_bytes,
+                                       &axes_right_stride_bytes))
+    return Status(ONNXRUNTIME, FAIL, "size overflow");
+
+  // Output slice n is the slice of selected index n % positive_condition_count in the outer slice
+  // n / positive_condition_count of the input
+  concurrency::ThreadPool::TryParallelFor(
+      tp, SafeInt<std::ptrdiff_t>(axes_left_stride) * positive_condition_count,
+      static_cast<double>(axes_right_stride_bytes),
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        int64_t i = first / positive_condition_count;
+        int64_t s = first % positive_condition_count;
+        for (std::ptrdiff_t n = first; n < last; ++n) {
+          const int64_t input_offset = i * axes_included_right_stride + selected[onnxruntime::narrow<size_t>(s)] * axes_right_stride;
+          const int64_t output_offset = n * axes_right_stride;
+          if (is_string_type) {
+            for (int64_t idx_item = 0; idx_item < axes_right_stride; ++idx_item) {
+              reinterpret_cast<std::string*>(output_data)[output_offset + idx_item] =
+                  reinterpret_cast<const std::string*>(input_data)[input_offset + idx_item];
+            }
+          } else {
+            memcpy(output_data + output_offset * element_bytes, input_data + input_offset * element_bytes,
+                   axes_right_stride_bytes);
+          }
+
+          if (++s == positive_condition_count) {
+            s = 0;
+            ++i;
           }
-          output_index += axes_right_stride;
-        } else {
-          memcpy(output_data + output_index, input_data + i * axes_included_right_stride_bytes + j * axes_right_stride_bytes, axes_right_stride_bytes);
-          output_index += axes_right_stride_bytes;
         }
-      }
-    }
-  } else {
-    for (int i = 0; i < valid_condition_length; ++i) {
-      if (!condition_data[i]) {
-        continue;
-      }
-      if (is_string_type) {
-        reinterpret_cast<std::string*>(output_data)[output_index] = reinterpret_cast<const std::string*>(input_data)[i];
-      } else {
-        memcpy(output_data + output_index * element_bytes, input_data + i * element_bytes, element_bytes);
-      }
-      ++output_index;
-    }
-  }
+      });
 
   return Status::OK();
 }
@@ -3,6 +3,7 @@
 
 #include "core/providers/cpu/tensor/concat.h"
 
+#include "core/common/safeint.h"
 #include "core/framework/element_type_lists.h"
 #include "core/framework/TensorSeq.h"
 #include "core/framework/copy.h"
@@ -263,16 +264,24 @@ Status ConcatBase::ComputeImpl(Prepare& p, OpKernelContext* ctx) const {
     if (prep.num_elements == 0)
       continue;
 
-    // parallel copy the data across
-    auto status = DispatchStridedCopy<EnabledDataTypes>(ctx->GetOperatorThreadPool(),
-                                                        *p.output_tensor,
-                                                        onnxruntime::narrow<ptrdiff_t>(initial_output_offset),
-                                                        output_strides_for_copy,
-                                                        prep.tensor->Shape(),
-                                                        *prep.tensor,
-                                                        0,  // src_offset
-                                                        StridesForTensor(*prep.tensor));
-    ORT_RETURN_IF_ERROR(status);
+    // the input was placed in the output by the ExecutionFrame (see SequentialExecutionPlan::ConcatInPlace),
+    // so its data is already there
+    const bool is_in_place =
+        !is_stack_ && !p.is_string_type &&
+        prep.tensor->DataRaw() == static_cast<const char*>(p.output_tensor->DataRaw()) +
+                                      SafeInt<size_t>(initial_output_offset) * p.output_tensor->DataType()->Size();
+    if (!is_in_place) {
+      // parallel copy the data across
+      auto status = DispatchStridedCopy<EnabledDataTypes>(ctx->GetOperatorThreadPool(),
+                                                          *p.output_tensor,
+                                                          onnxruntime::narrow<ptrdiff_t>(initial_output_offset),
+                                                          output_strides_for_copy,
+                                                          prep.tensor->Shape(),
+                                                          *prep.tensor,
+                                                          0,  // src_offset
+                                                          StridesForTensor(*prep.tensor));
+      ORT_RETURN_IF_ERROR(status);
+    }
 
     // advance along the axis that we are concatenating on (by the size of the axis of the tensor that we just copied)
     if (is_stack_) {
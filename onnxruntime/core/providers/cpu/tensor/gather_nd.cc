@@ -106,7 +106,7 @@ Status GatherNDBase::PrepareForCompute(const TensorShape& input_shape, const Ten
   concurrency::ThreadPool::TryParallelFor(
       tp, onnxruntime::narrow<size_t>(num_slices), static_cast<double>(num_slice_dims),
       [&lambda](ptrdiff_t first, ptrdiff_t last) {
-        for (int slice_idx = static_cast<int>(first), end = static_cast<int>(last); slice_idx < end; ++slice_idx) {
+        for (ptrdiff_t slice_idx = first; slice_idx < last; ++slice_idx) {
           lambda(slice_idx);
         }
       });
@@ -176,7 +176,45 @@ Status GatherND::Compute(OpKernelContext* context) const {
   return nullptr == p.input_str_base ? GatherNumber(p, tp) : GatherString(p, tp);
 }
 
+namespace {
+
+// Copies slices of a single element, as when the indices address every dimension of the input, with a typed copy
+// instead of a memcpy call per element.
+template <typename T>
+void GatherSingleElements(const GatherNDBase::Prepare& p, ptrdiff_t first, ptrdiff_t last) {
+  const T* input = reinterpret_cast<const T*>(p.input_base);
+  T* output = reinterpret_cast<T*>(p.output_base);
+  for (ptrdiff_t slice_idx = first; slice_idx < last; ++slice_idx) {
+    output[slice_idx] = input[p.slice_offsets[slice_idx]];
+  }
+}
+
+}  // namespace
+
 Status GatherND::GatherNumber(const Prepare& p, concurrency::ThreadPool* tp) const {
+  if (p.bytes_per_slice == static_cast<uint64_t>(p.element_bytes) &&
+      (p.element_bytes == 1 || p.element_bytes == 2 || p.element_bytes == 4 || p.element_bytes == 8)) {
+    concurrency::ThreadPool::TryParallelFor(
+        tp, p.slice_offsets.size(), static_cast<double>(p.bytes_per_slice),
+        [&p](ptrdiff_t first, ptrdiff_t last) {
+          switch (p.element_bytes) {
+            case 1:
+              GatherSingleElements<uint8_t>(p, first, last);
+              break;
+            case 2:
+              GatherSingleElements<uint16_t>(p, first, last);
+              break;
+            case 4:
+              GatherSingleElements<uint32_t>(p, first, last);
+              break;
+            default:
+              GatherSingleElements<uint64_t>(p, first, last);
+              break;
+          }
+        });
+    return Status::OK();
+  }
+
   auto lambda = [&](int64_t slice_idx) {
     memcpy(p.output_base + slice_idx * p.bytes_per_slice, p.input_base + p.slice_offsets[onnxruntime::narrow<size_t>(slice_idx)] * p.element_bytes,
            onnxruntime::narrow<size_t>(p.bytes_per_slice));
@@ -184,7 +222,7 @@ Status GatherND::GatherNumber(const Prepare& p, concurrency::ThreadPool* tp) con
   concurrency::ThreadPool::TryParallelFor(
       tp, p.slice_offsets.size(), static_cast<double>(p.bytes_per_slice),
       [&lambda](ptrdiff_t first, ptrdiff_t last) {
-        for (int slice_idx = static_cast<int>(first), end = static_cast<int>(last); slice_idx < end; ++slice_idx) {
+        for (ptrdiff_t slice_idx = first; slice_idx < last; ++slice_idx) {
           lambda(slice_idx);
         }
       });
@@ -201,7 +239,7 @@ Status GatherND::GatherString(const Prepare& p, concurrency::ThreadPool* tp) con
   concurrency::ThreadPool::TryParallelFor(
       tp, p.slice_offsets.size(), static_cast<double>(p.element_count_per_slice),
       [&lambda](ptrdiff_t first, ptrdiff_t last) {
-        for (int slice_idx = static_cast<int>(first), end = static_cast<int>(last); slice_idx < end; ++slice_idx) {
+        for (ptrdiff_t slice_idx = first; slice_idx < last; ++slice_idx) {
           lambda(slice_idx);
         }
       });
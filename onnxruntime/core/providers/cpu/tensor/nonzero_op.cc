@@ -3,10 +3,12 @@
 
 #include "core/providers/cpu/tensor/nonzero_op.h"
 
+#include <algorithm>
 #include <cassert>
 #include <vector>
 #include <core/common/safeint.h>
-#include "core/util/math_cpuonly.h"
+#include "core/common/narrow.h"
+#include "core/platform/threadpool.h"
 
 namespace onnxruntime {
 // kernel builder functions
@@ -51,6 +53,13 @@ NONZERO_TYPED_KERNEL(float)
 #undef NONZERO_9_TYPED_KERNEL
 #undef NONZERO_TYPED_KERNEL
 
+namespace {
+
+// Elements scanned by each part of the input at least, so that parts are not dispatched for a few elements
+constexpr std::ptrdiff_t kMinElementsPerPart = 16 * 1024;
+
+}  // namespace
+
 template <typename T>
 Status NonZero<T>::Compute(OpKernelContext* context) const {
   const auto X = context->Input<Tensor>(0);
@@ -59,59 +68,82 @@ Status NonZero<T>::Compute(OpKernelContext* context) const {
   const auto& X_shape = X->Shape();
   assert(X_shape.Size() >= 0);
 
-  const Eigen::Index coordinate_size = X_shape.IsScalar() ? 1 : onnxruntime::narrow<Eigen::Index>(X_shape.NumDimensions());
-  std::vector<int64_t> non_zero_indices_buffer{};
-  // reserve enough space for indices for every element of X
-  non_zero_indices_buffer.reserve(SafeInt<size_t>(X_shape.Size()) * coordinate_size);
-
   const T* data = X->Data<T>();
 
   if (X_shape.IsScalar()) {
-    const T& value = *data;
-    if (value != T{}) {
-      non_zero_indices_buffer.push_back(0);
+    const bool non_zero = *data != T{};
+    Tensor* const Y = context->Output(0, {1, non_zero ? 1 : 0});
+    ORT_ENFORCE(Y, "failed to get first output!");
+    if (non_zero) {
+      *Y->MutableData<int64_t>() = 0;
     }
-  } else {
-    std::vector<int64_t> coordinate(coordinate_size, 0);
-
-    // as we iterate the entries, increment the coordinate for the current entry
-    // e.g. if shape is {2,2}, we start with 0,0 increment to 0,1 increment to 1,0 and finally 1,1
-    auto increment_coordinate = [&coordinate, &coordinate_size, &X_shape]() {
-      for (Eigen::Index idx = coordinate_size - 1; idx >= 0; --idx) {
-        int64_t& cur_coord = coordinate[idx];
-        if (cur_coord != X_shape[idx] - 1) {
-          ++cur_coord;
-          break;
-        }
-        cur_coord = 0;
-      }
-    };
-
-    for (size_t i = 0, end = onnxruntime::narrow<size_t>(X_shape.Size()); i < end; ++i) {
-      const T& value = *data++;
-      if (value != T{}) {
-        non_zero_indices_buffer.insert(non_zero_indices_buffer.end(),
-                                       coordinate.begin(), coordinate.end());
-      }
+    return Status::OK();
+  }
 
-      increment_coordinate();
+  // The input is split in parts that are scanned twice: once to count their non-zero values, from which the
+  // position of the first non-zero value of each part in the output follows by a prefix sum, and once to write the
+  // coordinates of their non-zero values from that position on.
+  concurrency::ThreadPool* tp = context->GetOperatorThreadPool();
+  const size_t coordinate_size = X_shape.NumDimensions();
+  const std::ptrdiff_t size = onnxruntime::narrow<std::ptrdiff_t>(X_shape.Size());
+  const std::ptrdiff_t num_parts = std::max<std::ptrdiff_t>(
+      1, std::min<std::ptrdiff_t>(concurrency::ThreadPool::DegreeOfParallelism(tp), size / kMinElementsPerPart));
+
+  std::vector<int64_t> part_offsets(SafeInt<size_t>(num_parts) + 1, 0);
+  concurrency::ThreadPool::TrySimpleParallelFor(tp, num_parts, [&](std::ptrdiff_t part) {
+    const auto work = concurrency::ThreadPool::PartitionWork(part, num_parts, size);
+    int64_t count = 0;
+    for (std::ptrdiff_t i = work.start; i < work.end; ++i) {
+      count += data[i] != T{} ? 1 : 0;
     }
+    part_offsets[part + 1] = count;
+  });
+  for (std::ptrdiff_t part = 0; part < num_parts; ++part) {
+    part_offsets[part + 1] += part_offsets[part];
   }
+  const int64_t num_non_zero_values = part_offsets[num_parts];
 
-  const Eigen::Index num_non_zero_values = onnxruntime::narrow<Eigen::Index>(non_zero_indices_buffer.size()) / coordinate_size;
+  // The output holds the coordinates of the non-zero values dimension by dimension
+  Tensor* const Y = context->Output(0, {static_cast<int64_t>(coordinate_size), num_non_zero_values});
+  ORT_ENFORCE(Y, "failed to get first output!");
+  if (num_non_zero_values == 0) {
+    return Status::OK();
+  }
+  int64_t* y_data = Y->MutableData<int64_t>();
 
-  // transpose result for output
-  ConstEigenMatrixMapRowMajor<int64_t> non_zero_indices_matrix{
-      non_zero_indices_buffer.data(),
-      num_non_zero_values, coordinate_size};
+  concurrency::ThreadPool::TrySimpleParallelFor(tp, num_parts, [&](std::ptrdiff_t part) {
+    const auto work = concurrency::ThreadPool::PartitionWork(part, num_parts, size);
+    if (part_offsets[part] == part_offsets[part + 1]) {
+      return;
+    }
 
-  Tensor* const Y = context->Output(0, {coordinate_size, num_non_zero_values});
-  ORT_ENFORCE(Y, "failed to get first output!");
+    // the coordinate of the first element of the part
+    std::vector<int64_t> coordinate(coordinate_size, 0);
+    int64_t remainder = work.start;
+    for (size_t idx = coordinate_size; idx-- > 0;) {
+      coordinate[idx] = remainder % X_shape[idx];
+      remainder /= X_shape[idx];
+    }
+
+    int64_t position = part_offsets[part];
+    for (std::ptrdiff_t i = work.start; i < work.end; ++i) {
+      if (data[i] != T{}) {
+        for (size_t idx = 0; idx < coordinate_size; ++idx) {
+          y_data[idx * num_non_zero_values + position] = coordinate[idx];
+        }
+        ++position;
+      }
 
-  EigenMatrixMapRowMajor<int64_t> y_matrix{
-      Y->MutableData<int64_t>(),
-      coordinate_size, num_non_zero_values};
-  y_matrix = non_zero_indices_matrix.transpose();
+      // as we iterate the entries, increment the coordinate for the current entry
+      // e.g. if shape is {2,2}, we start with 0,0 increment to 0,1 increment to 1,0 and finally 1,1
+      for (size_t idx = coordinate_size; idx-- > 0;) {
+        if (++coordinate[idx] != X_shape[idx]) {
+          break;
+        }
+        coordinate[idx] = 0;
+      }
+    }
+  });
 
   return Status::OK();
 }
@@ -3,6 +3,11 @@
 
 #include "core/providers/cpu/tensor/scatter_nd.h"
 
+#include <algorithm>
+#include <functional>
+#include <numeric>
+
+#include "core/common/inlined_containers.h"
 #include "core/framework/element_type_lists.h"
 #include "core/framework/op_kernel_type_control_utils.h"
 #include "core/platform/threadpool.h"
@@ -396,11 +401,62 @@ struct ScatterNDDispatchTarget {
         } break;
       }
     };
+
+    // Updates of the same output slice race when they run on different threads, so when there are duplicate indices
+    // the updates are grouped by output slice and each group is applied on one thread, in the order of the updates.
+    // A sequential run applies them in order anyway.
+    const auto& offsets = prepare.element_offsets;
+    const size_t num_updates = offsets.size();
+    // The sort is only paid for when a duplicate is found. Increasing offsets, e.g. updates of consecutive rows,
+    // have none, and otherwise a pass over the offsets stops at the first duplicate.
+    bool has_duplicates = false;
+    if (concurrency::ThreadPool::DegreeOfParallelism(tp) > 1 && num_updates > 1 &&
+        std::adjacent_find(offsets.begin(), offsets.end(), std::greater_equal<uint64_t>()) != offsets.end()) {
+      InlinedHashSet<uint64_t> seen_offsets;
+      seen_offsets.reserve(num_updates);
+      for (uint64_t offset : offsets) {
+        if (!seen_offsets.insert(offset).second) {
+          has_duplicates = true;
+          break;
+        }
+      }
+    }
+
+    std::vector<size_t> order;
+    if (has_duplicates) {
+      order.resize(num_updates);
+      std::iota(order.begin(), order.end(), size_t{0});
+      std::stable_sort(order.begin(), order.end(), [&offsets](size_t a, size_t b) { return offsets[a] < offsets[b]; });
+    }
+
+    if (order.empty()) {
+      concurrency::ThreadPool::TryParallelFor(
+          tp, num_updates, static_cast<double>(prepare.element_to_copy),
+          [&lambda](ptrdiff_t first, ptrdiff_t last) {
+            for (ptrdiff_t i = first; i < last; ++i) {
+              lambda(i);
+            }
+          });
+      return Status::OK();
+    }
+
+    std::vector<size_t> group_starts;
+    for (size_t k = 0; k < num_updates; ++k) {
+      if (k == 0 || offsets[order[k]] != offsets[order[k - 1]]) {
+        group_starts.push_back(k);
+      }
+    }
+    group_starts.push_back(num_updates);
+    const size_t num_groups = group_starts.size() - 1;
+
     concurrency::ThreadPool::TryParallelFor(
-        tp, prepare.element_offsets.size(), static_cast<double>(prepare.element_to_copy),
-        [&lambda](ptrdiff_t first, ptrdiff_t last) {
-          for (int i = static_cast<int>(first), end = static_cast<int>(last); i < end; ++i) {
-            lambda(i);
+        tp, num_groups,
+        static_cast<double>(prepare.element_to_copy) * static_cast<double>(num_updates) / num_groups,
+        [&](ptrdiff_t first, ptrdiff_t last) {
+          for (ptrdiff_t g = first; g < last; ++g) {
+            for (size_t k = group_starts[g]; k < group_starts[g + 1]; ++k) {
+              lambda(static_cast<int64_t>(order[k]));
+            }
           }
         });
     return Status::OK();
@@ -7,6 +7,7 @@
 #include <unordered_map>
 
 #include "core/common/narrow.h"
+#include "core/framework/copy.h"
 #include "core/framework/element_type_lists.h"
 #include "core/framework/op_kernel_type_control_utils.h"
 #include "core/providers/common.h"
@@ -39,16 +40,22 @@ using EnabledIndicesTypes = ORT_OP_KERNEL_ARG_ENABLED_TYPE_LIST_ALL_OPSETS(kCpuE
                                                                            Slice, Input, 1);
 }  // namespace
 
+#ifdef ENABLE_STRIDED_TENSORS
+#define CREATE_SLICE_KERNEL_DEF KernelDefBuilder().MayStridedInput(0).MayStridedOutput(0, 0)
+#else
+#define CREATE_SLICE_KERNEL_DEF KernelDefBuilder()
+#endif
+
 ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
     Slice,
     1, 9,
-    KernelDefBuilder().TypeConstraint("T", BuildKernelDefConstraintsFromTypeList<EnabledDataTypes>()),
+    CREATE_SLICE_KERNEL_DEF.TypeConstraint("T", BuildKernelDefConstraintsFromTypeList<EnabledDataTypes>()),
     Slice1);
 
 ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
     Slice,
     10, 10,
-    KernelDefBuilder()
+    CREATE_SLICE_KERNEL_DEF
         .TypeConstraint("T", BuildKernelDefConstraintsFromTypeList<EnabledDataTypes>())
         .TypeConstraint("Tind", BuildKernelDefConstraintsFromTypeList<EnabledIndicesTypes>()),
     Slice10);
@@ -57,7 +64,7 @@ ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
     Slice,
     11,
     12,
-    KernelDefBuilder()
+    CREATE_SLICE_KERNEL_DEF
         .TypeConstraint("T", BuildKernelDefConstraintsFromTypeList<EnabledDataTypes>())
         .TypeConstraint("Tind", BuildKernelDefConstraintsFromTypeList<EnabledIndicesTypes>()),
     Slice10);
@@ -65,11 +72,13 @@ ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
 ONNX_CPU_OPERATOR_KERNEL(
     Slice,
     13,
-    KernelDefBuilder()
+    CREATE_SLICE_KERNEL_DEF
         .TypeConstraint("T", BuildKernelDefConstraintsFromTypeList<EnabledDataTypes>())
         .TypeConstraint("Tind", BuildKernelDefConstraintsFromTypeList<EnabledIndicesTypes>()),
     Slice10);
 
+#undef CREATE_SLICE_KERNEL_DEF
+
 // Coalesce contiguous non-slice dimensions into a single dimension.
 // Set p_flattened_input_dims_ and p_flattened_output_dims_ to nullptr if nothing coalesced.
 // Updates starts and steps to match the new dimensions.
@@ -297,12 +306,44 @@ Status SliceBase::Compute(OpKernelContext* ctx) const {
                                              input_starts, input_ends,
                                              input_axes, input_steps));
 
-    ORT_RETURN_IF_ERROR(PrepareForCompute(input_starts, input_ends, input_axes, input_steps, compute_metadata));
+    ORT_RETURN_IF_ERROR(SliceOp::PrepareForComputeHelper(input_starts, input_ends, input_axes, input_steps,
+                                                         compute_metadata));
   }
   // Slice V1-9
   else {
-    ORT_RETURN_IF_ERROR(PrepareForCompute(attr_starts_, attr_ends_, attr_axes_, compute_metadata));
+    ORT_RETURN_IF_ERROR(SliceOp::PrepareForComputeHelper(attr_starts_, attr_ends_, attr_axes_, compute_metadata));
+  }
+
+#ifdef ENABLE_STRIDED_TENSORS
+  // The planner makes the output a view of the input if all its consumers accept strided inputs, in which case
+  // the view starts at the first sliced element and steps through the input with its strides scaled by the steps.
+  // A strided input is copied into the contiguous output through the same view.
+  TensorShape output_shape(compute_metadata.output_dims_);
+  auto& output_tensor = *ctx->Output(0, output_shape);
+  const bool is_view = output_tensor.DataRaw() == input_tensor.DataRaw();
+  if (output_shape.Size() > 0 && (is_view || !input_tensor.IsContiguous())) {
+    const auto input_strides = input_tensor.Strides();
+    TensorShapeVector view_strides(input_dimensions.size());
+    std::ptrdiff_t view_offset = 0;
+    for (size_t i = 0; i < input_dimensions.size(); ++i) {
+      view_strides[i] = input_strides[i] * compute_metadata.steps_[i];
+      view_offset += static_cast<std::ptrdiff_t>(compute_metadata.starts_[i] * input_strides[i]);
+    }
+    if (is_view) {
+      output_tensor.SetShapeAndStrides(output_shape, view_strides);
+      output_tensor.SetByteOffset(output_tensor.ByteOffset() +
+                                  view_offset * static_cast<std::ptrdiff_t>(input_tensor.DataType()->Size()));
+      return Status::OK();
+    }
+    return DispatchStridedCopy<EnabledDataTypes>(ctx->GetOperatorThreadPool(), output_tensor, 0,
+                                                 StridesForTensor(output_tensor), output_shape,
+                                                 input_tensor, view_offset, view_strides);
   }
+#endif
+
+  FlattenOutputDims(compute_metadata.input_dimensions_, compute_metadata.output_dims_, compute_metadata.starts_,
+                    compute_metadata.ends_, compute_metadata.steps_, compute_metadata.p_flattened_input_dims_,
+                    compute_metadata.p_flattened_output_dims_);
 
   Status status = Status::OK();
 
@@ -3,11 +3,13 @@
 
 #include "core/providers/cpu/tensor/transpose.h"
 
+#include "core/framework/copy.h"
 #include "core/framework/element_type_lists.h"
 #include "core/framework/utils.h"
 #include "core/framework/transpose_helper.h"
 #include "core/framework/op_kernel_type_control_utils.h"
 #include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
 #include "core/providers/op_kernel_type_control.h"
 #include "utils.h"
 
@@ -128,13 +130,6 @@ static inline void IncrementIndexAndComputeOffset(MultiIndex& mindex, const T*&
 
 // DoTransposeSingleBlock: specialization of DoTranspose for the num_blocks=1 case.
 // copies source tensor to target, transposing elements.
-static inline void DoTransposeSingleBlock(size_t num_elts_in_block, const void* source, void* target,
-                                          size_t element_size) {
-  size_t blocksize = num_elts_in_block * element_size;
-  // copy
-  memcpy(target, source, blocksize);
-}
-
 static inline void DoTransposeSingleBlock(size_t num_elts_in_block, const std::string* source, std::string* target) {
   const std::string* end = source + num_elts_in_block;
   std::copy(source, end, target);
@@ -247,15 +242,265 @@ static void DoTransposeEltWise(int64_t num_axes, gsl::span<const int64_t> target
   }
 }
 
+/* The transpose of a non-string tensor is planned on the output axes: axes of size 1 are dropped and consecutive
+ * output axes that are also consecutive in the input are merged, so that e.g. [B, S, H, D] -> [B, H, D, S]
+ * becomes a batch of B transposes of [S, H * D] matrices.
+ * If the innermost axis is then the innermost axis of the input too, the output is a sequence of contiguous rows
+ * copied from the input. Otherwise the innermost axes of the input and output form a 2-D transpose, which is done
+ * in tiles of one cache line per row so that both its reads and writes stay in L1.
+ * The outer axes, and if there are not enough of them the rows of the 2-D transposes, are split over the threads.
+ */
+struct TransposePlan {
+  // merged output axes with their strides in the input and the output, in elements
+  InlinedVector<int64_t> dims;
+  InlinedVector<int64_t> input_strides;
+  InlinedVector<int64_t> output_strides;
+};
+
+static TransposePlan PlanTranspose(const gsl::span<const size_t>& permutations, gsl::span<const int64_t> input_dims) {
+  const size_t rank = input_dims.size();
+  InlinedVector<int64_t> input_strides(rank);
+  int64_t stride = 1;
+  for (size_t i = rank; i-- > 0;) {
+    input_strides[i] = stride;
+    stride *= input_dims[i];
+  }
+
+  TransposePlan plan;
+  for (size_t i = 0; i < rank; ++i) {
+    const int64_t dim = input_dims[permutations[i]];
+    if (dim == 1) {
+      continue;
+    }
+    const int64_t input_stride = input_strides[permutations[i]];
+    if (!plan.dims.empty() && plan.input_strides.back() == input_stride * dim) {
+      plan.dims.back() *= dim;
+      plan.input_strides.back() = input_stride;
+    } else {
+      plan.dims.push_back(dim);
+      plan.input_strides.push_back(input_stride);
+    }
+  }
+
+  plan.output_strides.resize(plan.dims.size());
+  stride = 1;
+  for (size_t i = plan.dims.size(); i-- > 0;) {
+    plan.output_strides[i] = stride;
+    stride *= plan.dims[i];
+  }
+  return plan;
+}
+
+// Multi-index over some of the axes of a plan, starting at a linear index, which keeps track of its offsets in the
+// input and the output as it is incremented.
+class TransposeOuterIndex {
+ public:
+  TransposeOuterIndex(const TransposePlan& plan, gsl::span<const size_t> axes, int64_t start)
+      : plan_(plan), axes_(axes), index_(axes.size()) {
+    for (size_t k = axes_.size(); k-- > 0;) {
+      const size_t axis = axes_[k];
+      index_[k] = start % plan_.dims[axis];
+      start /= plan_.dims[axis];
+      input_offset += index_[k] * plan_.input_strides[axis];
+      output_offset += index_[k] * plan_.output_strides[axis];
+    }
+  }
+
+  void Increment() {
+    for (size_t k = axes_.size(); k-- > 0;) {
+      const size_t axis = axes_[k];
+      input_offset += plan_.input_strides[axis];
+      output_offset += plan_.output_strides[axis];
+      if (++index_[k] < plan_.dims[axis]) {
+        return;
+      }
+      input_offset -= index_[k] * plan_.input_strides[axis];
+      output_offset -= index_[k] * plan_.output_strides[axis];
+      index_[k] = 0;
+    }
+  }
+
+  int64_t input_offset = 0;
+  int64_t output_offset = 0;
+
+ private:
+  const TransposePlan& plan_;
+  gsl::span<const size_t> axes_;
+  InlinedVector<int64_t> index_;
+};
+
+template <typename T>
+struct HasMlasTranspose : std::false_type {};
+template <>
+struct HasMlasTranspose<uint8_t> : std::true_type {};
+template <>
+struct HasMlasTranspose<uint16_t> : std::true_type {};
+template <>
+struct HasMlasTranspose<uint32_t> : std::true_type {};
+
+// Transposes the rows [row_begin, row_end) of the rows x cols matrix at source, whose rows are source_ld apart,
+// into the columns of target, whose rows are target_ld apart.
+template <typename T>
+static void TransposeTiles(const T* source, int64_t source_ld, T* target, int64_t target_ld,
+                           int64_t row_begin, int64_t row_end, int64_t cols) {
+  constexpr int64_t kTile = 64 / sizeof(T);
+  for (int64_t r0 = row_begin; r0 < row_end; r0 += kTile) {
+    const int64_t r1 = std::min(r0 + kTile, row_end);
+    for (int64_t c0 = 0; c0 < cols; c0 += kTile) {
+      const int64_t c1 = std::min(c0 + kTile, cols);
+      if (r1 - r0 == kTile && c1 - c0 == kTile) {
+        // a full tile has constant bounds, which the compiler unrolls and vectorizes
+        for (int64_t c = 0; c < kTile; ++c) {
+          T* t = target + (c0 + c) * target_ld + r0;
+          const T* s = source + r0 * source_ld + c0 + c;
+          for (int64_t r = 0; r < kTile; ++r) {
+            t[r] = s[r * source_ld];
+          }
+        }
+      } else {
+        for (int64_t c = c0; c < c1; ++c) {
+          for (int64_t r = r0; r < r1; ++r) {
+            target[c * target_ld + r] = source[r * source_ld + c];
+          }
+        }
+      }
+    }
+  }
+}
+
+template <typename T>
+static bool TypedTransposeWithPlan(const TransposePlan& plan, size_t inner_axis, const uint8_t* source,
+                                   uint8_t* target, concurrency::ThreadPool* tp) {
+  constexpr bool enabled = utils::HasTypeWithSameSize<EnabledDataTypes, T>();
+  if (!enabled) {
+    return false;
+  }
+
+  // The matrix of the innermost axes has a row per index of the innermost output axis, read with a stride, and a
+  // column per index of the innermost input axis, read contiguously.
+  const size_t last = plan.dims.size() - 1;
+  const int64_t rows = plan.dims[last];
+  const int64_t cols = plan.dims[inner_axis];
+  const int64_t source_ld = plan.input_strides[last];
+  const int64_t target_ld = plan.output_strides[inner_axis];
+
+  InlinedVector<size_t> outer_axes;
+  int64_t num_matrices = 1;
+  for (size_t axis = 0; axis < last; ++axis) {
+    if (axis != inner_axis) {
+      outer_axes.push_back(axis);
+      num_matrices *= plan.dims[axis];
+    }
+  }
+
+  constexpr int64_t kTile = 64 / sizeof(T);
+  const int64_t num_threads = concurrency::ThreadPool::DegreeOfParallelism(tp);
+  const int64_t row_tiles = (rows + kTile - 1) / kTile;
+  const int64_t splits = std::max<int64_t>(1, std::min(row_tiles, (4 * num_threads + num_matrices - 1) / num_matrices));
+  const int64_t rows_per_split = ((row_tiles + splits - 1) / splits) * kTile;
+  const bool contiguous = source_ld == cols && target_ld == rows;
+
+  const T* source_data = reinterpret_cast<const T*>(source);
+  T* target_data = reinterpret_cast<T*>(target);
+  const double cost = static_cast<double>(rows_per_split * cols * 2);
+  concurrency::ThreadPool::TryParallelFor(
+      tp, static_cast<std::ptrdiff_t>(num_matrices * splits), cost,
+      [&](std::ptrdiff_t first, std::ptrdiff_t last_work) {
+        TransposeOuterIndex index(plan, outer_axes, first / splits);
+        for (std::ptrdiff_t work = first; work < last_work; ++work) {
+          const int64_t split = work % splits;
+          if (work != first && split == 0) {
+            index.Increment();
+          }
+          const T* s = source_data + index.input_offset;
+          T* t = target_data + index.output_offset;
+          if constexpr (HasMlasTranspose<T>::value) {
+            if (contiguous && splits == 1) {
+              MlasTranspose(s, t, static_cast<size_t>(rows), static_cast<size_t>(cols));
+              continue;
+            }
+          }
+          TransposeTiles(s, source_ld, t, target_ld, split * rows_per_split,
+                         std::min(rows, (split + 1) * rows_per_split), cols);
+        }
+      });
+  return true;
+}
+
+static Status TransposeWithPlan(const gsl::span<const size_t>& permutations, gsl::span<const int64_t> input_dims,
+                                const uint8_t* source, uint8_t* target, size_t element_size,
+                                concurrency::ThreadPool* tp) {
+  const TransposePlan plan = PlanTranspose(permutations, input_dims);
+  const size_t num_axes = plan.dims.size();
+
+  if (num_axes == 0 || plan.input_strides.back() == 1) {
+    // the output is a sequence of rows that are contiguous in the input
+    const size_t row_bytes = element_size * static_cast<size_t>(num_axes == 0 ? 1 : plan.dims.back());
+    InlinedVector<size_t> outer_axes;
+    int64_t num_rows = 1;
+    for (size_t axis = 0; axis + 1 < num_axes; ++axis) {
+      outer_axes.push_back(axis);
+      num_rows *= plan.dims[axis];
+    }
+    concurrency::ThreadPool::TryParallelFor(
+        tp, static_cast<std::ptrdiff_t>(num_rows), static_cast<double>(row_bytes),
+        [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+          TransposeOuterIndex index(plan, outer_axes, first);
+          for (std::ptrdiff_t row = first; row < last; ++row) {
+            memcpy(target + index.output_offset * element_size, source + index.input_offset * element_size,
+                   row_bytes);
+            index.Increment();
+          }
+        });
+    return Status::OK();
+  }
+
+  // the innermost axis of the input, which is not the innermost axis of the output
+  size_t inner_axis = 0;
+  while (plan.input_strides[inner_axis] != 1) {
+    ++inner_axis;
+  }
+
+  bool enabled = false;
+  switch (element_size) {
+    case sizeof(uint64_t):
+      enabled = TypedTransposeWithPlan<uint64_t>(plan, inner_axis, source, target, tp);
+      break;
+    case sizeof(uint32_t):
+      enabled = TypedTransposeWithPlan<uint32_t>(plan, inner_axis, source, target, tp);
+      break;
+    case sizeof(uint16_t):
+      enabled = TypedTransposeWithPlan<uint16_t>(plan, inner_axis, source, target, tp);
+      break;
+    case sizeof(uint8_t):
+      enabled = TypedTransposeWithPlan<uint8_t>(plan, inner_axis, source, target, tp);
+      break;
+    default:
+      // leave enabled as false
+      break;
+  }
+
+  return enabled ? Status::OK()
+                 : ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Transpose of element size not supported in this build. Size=",
+                                   element_size);
+}
+
+// Size from which a transpose is split over the threads of the pool given to DoTranspose.
+constexpr size_t kParallelTransposeMinBytes = 64 * 1024;
+
 //  `input_shape_override` overrides the shape of `input` for compute purposes.
 static Status DoUntypedTranspose(const gsl::span<const size_t>& permutations, const Tensor& input, Tensor& output,
-                                 const TensorShape* input_shape_override = nullptr) {
+                                 const TensorShape* input_shape_override = nullptr,
+                                 concurrency::ThreadPool* tp = nullptr) {
   const auto& input_shape = input_shape_override ? *input_shape_override : input.Shape();
   const auto& input_dims = input_shape.GetDims();
   auto rank = input_shape.NumDimensions();
 
-  const auto element_size = input.DataType()->Size();
-  const bool is_string_type = input.IsDataTypeString();
+  if (!input.IsDataTypeString()) {
+    // this may return a failed status if the data size is not supported in this build
+    return TransposeWithPlan(permutations, input_dims, reinterpret_cast<const uint8_t*>(input.DataRaw()),
+                             reinterpret_cast<uint8_t*>(output.MutableDataRaw()), input.DataType()->Size(), tp);
+  }
 
   InlinedVector<size_t> stride(rank);
   for (size_t i = 0; i < rank; i++) {
@@ -286,37 +531,21 @@ static Status DoUntypedTranspose(const gsl::span<const size_t>& permutations, co
 
   Status status = Status::OK();
 
-  if (is_string_type) {
-    constexpr bool string_enabled = utils::HasType<EnabledDataTypes, std::string>();
-
-    if (string_enabled) {
-      const auto* input_data = input.Data<std::string>();
-      auto* output_data = output.MutableData<std::string>();
-      if (1 == prefix_blocksize) {
-        DoTransposeSingleBlock(suffix_blocksize, input_data, output_data);
-      } else if (1 == suffix_blocksize) {
-        DoTransposeEltWise(num_axes_in_prefix, output.Shape().GetDims(), prefix_blocksize, stride,
-                           input_data, output_data);
-      } else {
-        DoTransposeImpl(num_axes_in_prefix, output.Shape().GetDims(), prefix_blocksize, suffix_blocksize, stride,
-                        input_data, output_data);
-      }
-    } else {
-      status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Transpose of std::string is not supported in this build.");
-    }
-  } else {
-    const auto* input_data = reinterpret_cast<const uint8_t*>(input.DataRaw());
-    auto* output_data = reinterpret_cast<uint8_t*>(output.MutableDataRaw());
+  constexpr bool string_enabled = utils::HasType<EnabledDataTypes, std::string>();
+  if (string_enabled) {
+    const auto* input_data = input.Data<std::string>();
+    auto* output_data = output.MutableData<std::string>();
     if (1 == prefix_blocksize) {
-      DoTransposeSingleBlock(suffix_blocksize, input_data, output_data, element_size);
+      DoTransposeSingleBlock(suffix_blocksize, input_data, output_data);
     } else if (1 == suffix_blocksize) {
-      // this may return a failed status if the data size is not supported in this build
-      status = DoTransposeEltWise(num_axes_in_prefix, output.Shape().GetDims(), prefix_blocksize, stride,
-                                  input_data, output_data, element_size);
+      DoTransposeEltWise(num_axes_in_prefix, output.Shape().GetDims(), prefix_blocksize, stride,
+                         input_data, output_data);
     } else {
       DoTransposeImpl(num_axes_in_prefix, output.Shape().GetDims(), prefix_blocksize, suffix_blocksize, stride,
-                      input_data, output_data, element_size);
+                      input_data, output_data);
     }
+  } else {
+    status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Transpose of std::string is not supported in this build.");
   }
 
   return status;
@@ -338,7 +567,7 @@ bool IsTransposeReshape(const gsl::span<const size_t>& perm, gsl::span<const int
 
 //`input_shape_override` overrides the shape of `input` for compute purposes.
 Status TransposeBase::DoTranspose(const gsl::span<const size_t>& permutations, const Tensor& input, Tensor& output,
-                                  const TensorShape* input_shape_override) {
+                                  const TensorShape* input_shape_override, concurrency::ThreadPool* tp) {
   Status status = Status::OK();
 
   auto input_type = input.DataType();
@@ -356,14 +585,18 @@ Status TransposeBase::DoTranspose(const gsl::span<const size_t>& permutations, c
       return Status::OK();
     }
 
+    // The single axis transposes run on one thread, so larger transposes that can be split are planned instead
+    const bool parallel = concurrency::ThreadPool::DegreeOfParallelism(tp) > 1 &&
+                          static_cast<size_t>(shape.Size()) * input.DataType()->Size() >= kParallelTransposeMinBytes;
+
     size_t from = 0, to = 0;
     bool moving_single_axis = IsTransposeMovingSingleAxis(permutations, from, to);
 
-    if (moving_single_axis && !input.IsDataTypeString()) {
+    if (moving_single_axis && !input.IsDataTypeString() && !parallel) {
       SingleAxisTranspose(permutations, input, output, from, to, input_shape_override);
     } else {
       // fall back to default implementation
-      status = DoUntypedTranspose(permutations, input, output, input_shape_override);
+      status = DoUntypedTranspose(permutations, input, output, input_shape_override, tp);
     }
   }
 
@@ -391,37 +624,46 @@ Status Transpose::Compute(OpKernelContext* ctx) const {
   if (output_shape.Size() == 0)
     return Status::OK();
 
-  if (IsTransposeReshape(*p_perm, input_dims)) {
-    // As long as the dims with values > 1 stay in the same order, it's a reshape.
-    // Example: Shape=(1,1,1024,4096) -> perm=(2,0,3,1).
-    CopyCpuTensor(&X, &Y);
-    return Status::OK();
-  }
-
-  size_t from = 0, to = 0;
-  bool moving_single_axis = IsTransposeMovingSingleAxis(*p_perm, from, to);
-
-  if (moving_single_axis && !X.IsDataTypeString()) {
-    SingleAxisTranspose(*p_perm, X, Y, from, to);
-  } else {
-    // fall back to default implementation
-    status = DoUntypedTranspose(*p_perm, X, Y);
+#ifdef ENABLE_STRIDED_TENSORS
+  // The planner makes the output a view of the input if all its consumers accept strided inputs,
+  // in which case only the strides are permuted. A strided input is copied into the contiguous output.
+  if (Y.DataRaw() == X.DataRaw() || !X.IsContiguous()) {
+    const auto input_strides = X.Strides();
+    TensorShapeVector permuted_strides(rank);
+    for (size_t i = 0; i < rank; ++i) {
+      permuted_strides[i] = input_strides[(*p_perm)[i]];
+    }
+    if (Y.DataRaw() == X.DataRaw()) {
+      Y.SetShapeAndStrides(output_shape, permuted_strides);
+      return Status::OK();
+    }
+    return DispatchStridedCopy<EnabledDataTypes>(ctx->GetOperatorThreadPool(), Y, 0, StridesForTensor(Y),
+                                                 output_shape, X, 0, permuted_strides);
   }
+#endif
 
-  return status;
+  return DoTranspose(*p_perm, X, Y, nullptr, ctx->GetOperatorThreadPool());
 }
 
+#ifdef ENABLE_STRIDED_TENSORS
+#define CREATE_TRANSPOSE_KERNEL_DEF KernelDefBuilder().MayStridedInput(0).MayStridedOutput(0, 0)
+#else
+#define CREATE_TRANSPOSE_KERNEL_DEF KernelDefBuilder()
+#endif
+
 ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
     Transpose,
     1,
     12,
-    KernelDefBuilder().TypeConstraint("T", BuildKernelDefConstraintsFromTypeList<EnabledDataTypes>()),
+    CREATE_TRANSPOSE_KERNEL_DEF.TypeConstraint("T", BuildKernelDefConstraintsFromTypeList<EnabledDataTypes>()),
     Transpose);
 
 ONNX_CPU_OPERATOR_KERNEL(
     Transpose,
     13,
-    KernelDefBuilder().TypeConstraint("T", BuildKernelDefConstraintsFromTypeList<EnabledDataTypes>()),
+    CREATE_TRANSPOSE_KERNEL_DEF.TypeConstraint("T", BuildKernelDefConstraintsFromTypeList<EnabledDataTypes>()),
     Transpose);
 
+#undef CREATE_TRANSPOSE_KERNEL_DEF
+
 }  // namespace onnxruntime
@@ -14,6 +14,9 @@
 #include <sstream>
 
 namespace onnxruntime {
+namespace concurrency {
+class ThreadPool;
+}
 
 /** Tells if the transpose is equivalent to a reshape:
  empty dimensions can change place, not empty dimensions must be in
@@ -31,9 +34,11 @@ class TransposeBase {
   /**
   Transpose the input Tensor into the output Tensor using the provided permutations.
   Both Tensors must have the same data type. `input_shape_override` overrides the shape of `input` for compute purposes.
+  Large transposes are split over the threads of `tp` when one is given.
   */
   static Status DoTranspose(const gsl::span<const size_t>& permutations, const Tensor& input, Tensor& output,
-                            const TensorShape* input_shape_override = nullptr);
+                            const TensorShape* input_shape_override = nullptr,
+                            concurrency::ThreadPool* tp = nullptr);
 
  protected:
   TransposeBase(const OpKernelInfo& info) {
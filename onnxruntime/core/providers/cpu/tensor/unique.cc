@@ -2,10 +2,18 @@
 // Licensed under the MIT License.
 
 #include "core/providers/cpu/tensor/unique.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
 #include <map>
+#include <numeric>
+#include <string_view>
 #include <core/common/safeint.h>
 #include "core/common/gsl.h"
+#include "core/common/inlined_containers.h"
 #include "core/framework/op_kernel_type_control_utils.h"
+#include "core/platform/threadpool.h"
 #include "core/providers/common.h"
 #include "core/providers/op_kernel_type_control.h"
 
@@ -142,74 +150,200 @@ class Subtensor {
   std::vector<T> items_;
 };
 
+namespace {
+
+// First occurrence and number of occurrences of a unique value or subtensor.
+struct UniqueEntry {
+  int64_t first_index;
+  int64_t count;
+};
+
+// Key of a value in the hash map of the unique values. Strings are looked up in place rather than copied.
+// Floating point values are looked up by their bits, with both zeros and all the NaNs mapped to a single key so that
+// they are equal like they are when sorted.
 template <typename T>
-static void CreateFlattenedOutput(OpKernelContext& context,
-                                  const std::map<const T, int64_t>& offsets,         // map sorted key to unsorted idx
-                                  const std::vector<std::vector<int64_t>>& indices,  // unsorted
-                                  const std::vector<int64_t>& inverse_index,         // unsorted
-                                  bool sorted) {
-  int64_t num_unique = static_cast<int64_t>(indices.size());
-  Tensor& Y = *context.Output(0, {num_unique});
-  Tensor* indices_out = context.Output(1, {num_unique});
-  Tensor* inverse_indices = context.Output(2, {static_cast<int64_t>(inverse_index.size())});
-  Tensor* counts = context.Output(3, {num_unique});
+auto GetUniqueKey(const T& value) {
+  if constexpr (std::is_same_v<T, std::string>) {
+    return std::string_view(value);
+  } else if constexpr (std::is_floating_point_v<T>) {
+    using Bits = std::conditional_t<sizeof(T) == sizeof(uint32_t), uint32_t, uint64_t>;
+    static_assert(sizeof(Bits) == sizeof(T));
+    const T canonical = std::isnan(value) ? std::numeric_limits<T>::quiet_NaN() : (value == T(0) ? T(0) : value);
+    Bits bits;
+    std::memcpy(&bits, &canonical, sizeof(bits));
+    return bits;
+  } else {
+    return value;
+  }
+}
 
-  auto Y_data = Y.MutableDataAsSpan<T>();
-  gsl::span<int64_t> indices_data = indices_out != nullptr ? indices_out->MutableDataAsSpan<int64_t>()
-                                                           : gsl::span<int64_t>();
-  gsl::span<int64_t> inverse_indices_data = inverse_indices != nullptr ? inverse_indices->MutableDataAsSpan<int64_t>()
-                                                                       : gsl::span<int64_t>();
-  gsl::span<int64_t> counts_data = counts != nullptr ? counts->MutableDataAsSpan<int64_t>()
-                                                     : gsl::span<int64_t>();
+template <typename T>
+using UniqueKey = decltype(GetUniqueKey(std::declval<const T&>()));
 
-  // iterate using 'offsets' which is sorted, but contains the offset of the unsorted entry
-  auto offsets_iter = offsets.begin();
-  for (int64_t i = 0, end = num_unique; i < end; ++i, ++offsets_iter) {
-    // write sequentially if we want sorted output, use the unsorted_idx if not
-    auto unsorted_idx = offsets_iter->second;
-    auto output_idx = sorted ? i : unsorted_idx;
+// Orders NaN after all the other values, so the order of the unique values is strict.
+template <typename T>
+bool IsLess(const T& lhs, const T& rhs) {
+  if constexpr (std::is_floating_point_v<T>) {
+    return lhs < rhs || (std::isnan(rhs) && !std::isnan(lhs));
+  } else {
+    return lhs < rhs;
+  }
+}
 
-    Y_data[onnxruntime::narrow<size_t>(output_idx)] = offsets_iter->first;
+// Adds the unique values of data[begin, end) to entries in the order of their first occurrence, and sets
+// inverse_index[begin, end) to their index in entries.
+template <typename T>
+void FindUniqueValues(gsl::span<const T> data, size_t begin, size_t end,
+                      std::vector<UniqueEntry>& entries, gsl::span<int64_t> inverse_index) {
+  InlinedHashMap<UniqueKey<T>, int64_t> offsets;
+  for (size_t i = begin; i < end; ++i) {
+    auto insert_result = offsets.try_emplace(GetUniqueKey(data[i]), static_cast<int64_t>(entries.size()));
+    if (insert_result.second) {
+      entries.push_back({static_cast<int64_t>(i), 1});
+    } else {
+      ++entries[onnxruntime::narrow<size_t>(insert_result.first->second)].count;
+    }
+    inverse_index[i] = insert_result.first->second;
+  }
+}
+
+// Inputs are split in ranges of at least this many values to find their unique values in parallel. Merging the
+// unique values of the ranges costs more than it saves for smaller ranges.
+constexpr size_t kMinValuesPerRange = 64 * 1024;
+
+template <typename T>
+void FindUniqueValues(gsl::span<const T> data, concurrency::ThreadPool* tp,
+                      std::vector<UniqueEntry>& entries, std::vector<int64_t>& inverse_index) {
+  const size_t num_values = data.size();
+  inverse_index.resize(num_values);
+
+  const size_t num_ranges = std::clamp<size_t>(num_values / kMinValuesPerRange, 1,
+                                               concurrency::ThreadPool::DegreeOfParallelism(tp));
+  if (num_ranges == 1) {
+    FindUniqueValues(data, 0, num_values, entries, inverse_index);
+    return;
+  }
+
+  const size_t range_size = (num_values + num_ranges - 1) / num_ranges;
+  auto range_begin = [&](size_t r) { return std::min(r * range_size, num_values); };
+
+  std::vector<std::vector<UniqueEntry>> range_entries(num_ranges);
+  concurrency::ThreadPool::TrySimpleParallelFor(tp, num_ranges, [&](std::ptrdiff_t r) {
+    const auto range = static_cast<size_t>(r);
+    FindUniqueValues(data, range_begin(range), range_begin(range + 1), range_entries[range], inverse_index);
+  });
+
+  // merging the ranges in order keeps the entries in the order of their first occurrence
+  InlinedHashMap<UniqueKey<T>, int64_t> offsets;
+  std::vector<std::vector<int64_t>> range_to_entry(num_ranges);
+  for (size_t r = 0; r < num_ranges; ++r) {
+    range_to_entry[r].reserve(range_entries[r].size());
+    for (const auto& range_entry : range_entries[r]) {
+      auto insert_result = offsets.try_emplace(GetUniqueKey(data[onnxruntime::narrow<size_t>(range_entry.first_index)]),
+                                               static_cast<int64_t>(entries.size()));
+      if (insert_result.second) {
+        entries.push_back(range_entry);
+      } else {
+        entries[onnxruntime::narrow<size_t>(insert_result.first->second)].count += range_entry.count;
+      }
+      range_to_entry[r].push_back(insert_result.first->second);
+    }
+  }
 
-    if (indices_out) {
-      indices_data[onnxruntime::narrow<size_t>(output_idx)] = indices[onnxruntime::narrow<size_t>(unsorted_idx)].front();
+  concurrency::ThreadPool::TrySimpleParallelFor(tp, num_ranges, [&](std::ptrdiff_t r) {
+    const auto range = static_cast<size_t>(r);
+    const auto& to_entry = range_to_entry[range];
+    for (size_t i = range_begin(range), end = range_begin(range + 1); i < end; ++i) {
+      inverse_index[i] = to_entry[onnxruntime::narrow<size_t>(inverse_index[i])];
     }
+  });
+}
 
-    if (counts) {
-      counts_data[onnxruntime::narrow<size_t>(output_idx)] = indices[onnxruntime::narrow<size_t>(unsorted_idx)].size();
+// Writes the 'indices', 'inverse_indices' and 'counts' outputs.
+// order holds the index in entries of the unique value written at each position of the output.
+void CreateIndexOutputs(OpKernelContext& context,
+                        const std::vector<UniqueEntry>& entries,  // unsorted
+                        gsl::span<const int64_t> order,
+                        std::vector<int64_t>& inverse_index,  // unsorted
+                        bool sorted) {
+  int64_t num_unique = static_cast<int64_t>(entries.size());
+  Tensor* indices_out = context.Output(1, {num_unique});
+  Tensor* inverse_indices = context.Output(2, {static_cast<int64_t>(inverse_index.size())});
+  Tensor* counts = context.Output(3, {num_unique});
+
+  if (indices_out || counts) {
+    gsl::span<int64_t> indices_data = indices_out != nullptr ? indices_out->MutableDataAsSpan<int64_t>()
+                                                             : gsl::span<int64_t>();
+    gsl::span<int64_t> counts_data = counts != nullptr ? counts->MutableDataAsSpan<int64_t>()
+                                                       : gsl::span<int64_t>();
+    for (size_t i = 0; i < order.size(); ++i) {
+      const auto& entry = entries[onnxruntime::narrow<size_t>(order[i])];
+      if (indices_out) {
+        indices_data[i] = entry.first_index;
+      }
+      if (counts) {
+        counts_data[i] = entry.count;
+      }
     }
   }
 
   if (inverse_indices) {
+    gsl::span<int64_t> inverse_indices_data = inverse_indices->MutableDataAsSpan<int64_t>();
     if (sorted) {
       // need to convert unsorted entries in the inverse index to their sorted values
-      std::vector<int64_t> unsorted_to_sorted;
-      unsorted_to_sorted.resize(onnxruntime::narrow<size_t>(num_unique));
-      int64_t sorted_idx = 0;
-      for (const auto& offset : offsets) {
-        unsorted_to_sorted[onnxruntime::narrow<size_t>(offset.second)] = sorted_idx++;
+      std::vector<int64_t> unsorted_to_sorted(order.size());
+      for (size_t i = 0; i < order.size(); ++i) {
+        unsorted_to_sorted[onnxruntime::narrow<size_t>(order[i])] = static_cast<int64_t>(i);
       }
 
-      for (size_t i = 0, end = inverse_index.size(); i < end; ++i) {
-        inverse_indices_data[onnxruntime::narrow<size_t>(i)] = unsorted_to_sorted[onnxruntime::narrow<size_t>(inverse_index[i])];
-      }
+      concurrency::ThreadPool::TryParallelFor(
+          context.GetOperatorThreadPool(), static_cast<std::ptrdiff_t>(inverse_index.size()),
+          TensorOpCost{static_cast<double>(sizeof(int64_t)), static_cast<double>(sizeof(int64_t)), 1.0},
+          [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+            for (auto i = static_cast<size_t>(first), end = static_cast<size_t>(last); i < end; ++i) {
+              inverse_indices_data[i] = unsorted_to_sorted[onnxruntime::narrow<size_t>(inverse_index[i])];
+            }
+          });
     } else {
-      for (size_t i = 0, end = inverse_index.size(); i < end; ++i) {
-        inverse_indices_data[i] = inverse_index[i];
-      }
+      std::copy(inverse_index.cbegin(), inverse_index.cend(), inverse_indices_data.begin());
     }
   }
 }
 
 template <typename T>
-static void CreateOutput(OpKernelContext& context,
-                         const TensorShape& subtensor_shape,
-                         int64_t axis,
-                         const std::map<const Subtensor<T>, int64_t>& offsets,  // map sorted key to unsorted idx
-                         const std::vector<std::vector<int64_t>>& indices,      // unsorted
-                         const std::vector<int64_t>& inverse_index,             // unsorted
-                         bool sorted) {
-  int64_t num_unique = static_cast<int64_t>(indices.size());
+void CreateFlattenedOutput(OpKernelContext& context,
+                           gsl::span<const T> data,
+                           const std::vector<UniqueEntry>& entries,  // unsorted
+                           std::vector<int64_t>& inverse_index,      // unsorted
+                           bool sorted) {
+  std::vector<int64_t> order(entries.size());
+  std::iota(order.begin(), order.end(), int64_t{0});
+  if (sorted) {
+    // only the unique values are sorted, rather than looking up every value in a sorted map
+    std::sort(order.begin(), order.end(), [&](int64_t lhs, int64_t rhs) {
+      return IsLess(data[onnxruntime::narrow<size_t>(entries[onnxruntime::narrow<size_t>(lhs)].first_index)],
+                    data[onnxruntime::narrow<size_t>(entries[onnxruntime::narrow<size_t>(rhs)].first_index)]);
+    });
+  }
+
+  Tensor& Y = *context.Output(0, {static_cast<int64_t>(entries.size())});
+  auto Y_data = Y.MutableDataAsSpan<T>();
+  for (size_t i = 0; i < order.size(); ++i) {
+    Y_data[i] = data[onnxruntime::narrow<size_t>(entries[onnxruntime::narrow<size_t>(order[i])].first_index)];
+  }
+
+  CreateIndexOutputs(context, entries, order, inverse_index, sorted);
+}
+
+template <typename T>
+void CreateOutput(OpKernelContext& context,
+                  const TensorShape& subtensor_shape,
+                  int64_t axis,
+                  const std::map<const Subtensor<T>, int64_t>& offsets,  // map sorted key to unsorted idx
+                  const std::vector<UniqueEntry>& entries,               // unsorted
+                  std::vector<int64_t>& inverse_index,                   // unsorted
+                  bool sorted) {
+  int64_t num_unique = static_cast<int64_t>(entries.size());
 
   // rows and columns for the slice along axis, flattened to 2D by merging the dimensions before and after the axis
   int64_t num_cols = subtensor_shape.SizeFromDimension(onnxruntime::narrow<size_t>(axis));
@@ -226,17 +360,11 @@ static void CreateOutput(OpKernelContext& context,
   }
 
   Tensor& Y = *context.Output(0, TensorShape(std::move(Y_dims)));
-  Tensor* indices_out = context.Output(1, {num_unique});
-  Tensor* inverse_indices = context.Output(2, {static_cast<int64_t>(inverse_index.size())});
-  Tensor* counts = context.Output(3, {num_unique});
-
   auto Y_data = Y.MutableDataAsSpan<T>();
-  gsl::span<int64_t> indices_data = indices_out != nullptr ? indices_out->MutableDataAsSpan<int64_t>()
-                                                           : gsl::span<int64_t>();
-  gsl::span<int64_t> inverse_indices_data = inverse_indices != nullptr ? inverse_indices->MutableDataAsSpan<int64_t>()
-                                                                       : gsl::span<int64_t>();
-  gsl::span<int64_t> counts_data = counts != nullptr ? counts->MutableDataAsSpan<int64_t>()
-                                                     : gsl::span<int64_t>();
+
+  // order of the unsorted entries in the output
+  std::vector<int64_t> order;
+  order.reserve(onnxruntime::narrow<size_t>(num_unique));
 
   // iterate using 'offsets' which is sorted, but contains the offset of the unsorted entry
   auto offsets_iter = offsets.begin();
@@ -245,6 +373,9 @@ static void CreateOutput(OpKernelContext& context,
     // write sequentially if we want sorted output, use the unsorted_idx if not
     auto unsorted_idx = offsets_iter->second;
     auto output_idx = (sorted ? i : unsorted_idx);
+    if (sorted) {
+      order.push_back(unsorted_idx);
+    }
 
     const auto& items = offsets_iter->first.GetItems();
     auto item = items.cbegin();
@@ -265,37 +396,18 @@ static void CreateOutput(OpKernelContext& context,
     }
 
     assert(item == items.cend());
-
-    if (indices_out) {
-      indices_data[onnxruntime::narrow<size_t>(output_idx)] = indices[onnxruntime::narrow<size_t>(unsorted_idx)].front();
-    }
-
-    if (counts) {
-      counts_data[onnxruntime::narrow<size_t>(output_idx)] = indices[onnxruntime::narrow<size_t>(unsorted_idx)].size();
-    }
   }
 
-  if (inverse_indices) {
-    if (sorted) {
-      // need to convert unsorted entries in the inverse index to their sorted values
-      std::vector<int64_t> unsorted_to_sorted;
-      unsorted_to_sorted.resize(onnxruntime::narrow<size_t>(num_unique));
-      int64_t sorted_idx = 0;
-      for (const auto& offset : offsets) {
-        unsorted_to_sorted[onnxruntime::narrow<size_t>(offset.second)] = sorted_idx++;
-      }
-
-      for (size_t i = 0, end = inverse_index.size(); i < end; ++i) {
-        inverse_indices_data[i] = unsorted_to_sorted[onnxruntime::narrow<size_t>(inverse_index[i])];
-      }
-    } else {
-      for (size_t i = 0, end = inverse_index.size(); i < end; ++i) {
-        inverse_indices_data[i] = inverse_index[i];
-      }
-    }
+  if (!sorted) {
+    order.resize(onnxruntime::narrow<size_t>(num_unique));
+    std::iota(order.begin(), order.end(), int64_t{0});
   }
+
+  CreateIndexOutputs(context, entries, order, inverse_index, sorted);
 }
 
+}  // namespace
+
 template <typename T>
 Status Unique::ComputeImpl(OpKernelContext& context) const {
   if (!utils::HasType<EnabledUniqueDataTypes, T>()) {
@@ -306,30 +418,11 @@ Status Unique::ComputeImpl(OpKernelContext& context) const {
   auto data = input.DataAsSpan<T>();
 
   if (flatten_) {
-    std::map<const T, int64_t> offsets;  // offset of entry in indices. provides map between sorted and unsorted values
-    std::vector<std::vector<int64_t>> indices;
+    std::vector<UniqueEntry> entries;
     std::vector<int64_t> inverse_index;
+    FindUniqueValues(data, context.GetOperatorThreadPool(), entries, inverse_index);
 
-    indices.reserve(data.size() / 2);  // arbitrary value. at worst 1 realloc but could be too large
-    inverse_index.reserve(data.size());
-
-    int64_t num_unique = 0;
-
-    for (int64_t i = 0, end = input.Shape().Size(); i < end; ++i) {
-      auto entry = offsets.find(data[onnxruntime::narrow<size_t>(i)]);
-      if (entry == offsets.end()) {
-        offsets[data[onnxruntime::narrow<size_t>(i)]] = num_unique;
-        inverse_index.push_back({num_unique});
-        indices.push_back({i});
-        ++num_unique;
-      } else {
-        size_t indices_idx = onnxruntime::narrow<size_t>(entry->second);
-        indices[indices_idx].push_back(i);
-        inverse_index.push_back(onnxruntime::narrow<int64_t>(indices_idx));
-      }
-    }
-
-    CreateFlattenedOutput(context, offsets, indices, inverse_index, sort_);
+    CreateFlattenedOutput(context, data, entries, inverse_index, sort_);
   } else {
     const auto& input_shape = input.Shape();
     const int64_t input_dims = static_cast<int64_t>(input_shape.NumDimensions());
@@ -344,32 +437,25 @@ Status Unique::ComputeImpl(OpKernelContext& context) const {
     TensorShape subtensor_shape(std::move(subtensor_dims));
 
     std::map<const Subtensor<T>, int64_t> offsets;
-    std::vector<std::vector<int64_t>> indices;
+    std::vector<UniqueEntry> entries;
     std::vector<int64_t> inverse_index;
 
-    indices.reserve(data.size() / 2);  // arbitrary value. at worst 1 realloc but could be too large
-    inverse_index.reserve(data.size());
-
-    int64_t num_unique = 0;
     int64_t n_axis = input_shape[onnxruntime::narrow<size_t>(axis)];
+    inverse_index.reserve(onnxruntime::narrow<size_t>(n_axis));
 
     for (int64_t i = 0; i < n_axis; ++i) {
       Subtensor<T> s(data, subtensor_shape, axis, n_axis, i);
 
-      auto entry = offsets.find(s);
-      if (entry == offsets.end()) {
-        offsets[std::move(s)] = num_unique;
-        inverse_index.push_back({num_unique});
-        indices.push_back({i});
-        ++num_unique;
+      auto insert_result = offsets.try_emplace(std::move(s), static_cast<int64_t>(entries.size()));
+      if (insert_result.second) {
+        entries.push_back({i, 1});
       } else {
-        size_t indices_idx = onnxruntime::narrow<size_t>(entry->second);
-        indices[indices_idx].push_back(i);
-        inverse_index.push_back(onnxruntime::narrow<int64_t>(indices_idx));
+        ++entries[onnxruntime::narrow<size_t>(insert_result.first->second)].count;
       }
+      inverse_index.push_back(insert_result.first->second);
     }
 
-    CreateOutput(context, subtensor_shape, axis, offsets, indices, inverse_index, sort_);
+    CreateOutput(context, subtensor_shape, axis, offsets, entries, inverse_index, sort_);
   }
 
   return Status::OK();
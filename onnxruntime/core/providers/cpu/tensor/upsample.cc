@@ -511,6 +511,67 @@ BilinearParams SetupUpsampleBilinear(const int32_t input_height,
   return p;
 }
 
+void UpsampleBilinearSeparable(const BilinearParams& p,
+                               const int32_t num_images,
+                               const int32_t input_height,
+                               const int32_t input_width,
+                               const int32_t output_height,
+                               const int32_t output_width,
+                               const float* const XdataBase,
+                               float* const YdataBase,
+                               concurrency::ThreadPool* tp) {
+  const size_t width = narrow<size_t>(output_width);
+  const double cost = static_cast<double>(output_height) * output_width * 4;
+  concurrency::ThreadPool::TryParallelFor(
+      tp, num_images, cost,
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        // the input rows at offsets row_offset[0] and row_offset[1] interpolated along the width
+        std::vector<float> rows(2 * width);
+        float* row[2] = {rows.data(), rows.data() + width};
+        int32_t row_offset[2] = {-1, -1};
+
+        auto interpolate_row = [&](const float* Xdata, int32_t offset, float* out) {
+          const float* in = Xdata + offset;
+          for (size_t x = 0; x < width; ++x) {
+            out[x] = p.dx2[x] * in[p.in_x1[x]] + p.dx1[x] * in[p.in_x2[x]];
+          }
+        };
+
+        for (std::ptrdiff_t image = first; image < last; ++image) {
+          const float* const Xdata = XdataBase + image * (static_cast<std::ptrdiff_t>(input_height) * input_width);
+          float* Ydata = YdataBase + image * (static_cast<std::ptrdiff_t>(output_height) * output_width);
+          row_offset[0] = row_offset[1] = -1;
+
+          for (int32_t y = 0; y < output_height; ++y, Ydata += width) {
+            const int32_t y1 = p.input_width_mul_y1[y];
+            const int32_t y2 = p.input_width_mul_y2[y];
+            // output rows move down the input, so the rows of the previous output row are usually reused
+            if (row_offset[0] != y1) {
+              if (row_offset[1] == y1) {
+                std::swap(row[0], row[1]);
+                std::swap(row_offset[0], row_offset[1]);
+              } else {
+                interpolate_row(Xdata, y1, row[0]);
+                row_offset[0] = y1;
+              }
+            }
+            if (row_offset[1] != y2) {
+              interpolate_row(Xdata, y2, row[1]);
+              row_offset[1] = y2;
+            }
+
+            const float dy1 = p.dy1[y];
+            const float dy2 = p.dy2[y];
+            const float* r1 = row[0];
+            const float* r2 = row[1];
+            for (size_t x = 0; x < width; ++x) {
+              Ydata[x] = dy2 * r1[x] + dy1 * r2[x];
+            }
+          }
+        }
+      });
+}
+
 // Same as above, but doesn't use any floating-point for the coefficient (i.e., d*_scale_10) computation
 BilinearParamsInteger SetupUpsampleBilinearInteger(const int32_t input_height,
                                                    const int32_t input_width,
@@ -873,49 +934,62 @@ std::array<float, CubicModeGridLength> GetCubicCoeffs(float s, float cubic_coeff
   return coeffs;
 }
 
-// Get the tensor data at the requested coordinate
-template <typename T>
-T GetDataForCoordinate(const T* Xdata,
-                       int64_t x, int64_t y,
-                       int64_t input_height, int64_t input_width) {
-  x = std::max(static_cast<int64_t>(0), std::min(x, input_width - 1));
-  y = std::max(static_cast<int64_t>(0), std::min(y, input_height - 1));
-  return Xdata[y * input_width + x];
-}
+// Precomputed cubic interpolation along one axis: for each output index, the 4 input indices of its grid
+// clamped to the input, and their weights normalized so that they sum to 1.
+struct CubicParamsForAxis {
+  std::vector<float> original;
+  std::vector<int64_t> index;
+  std::vector<float> weight;
+};
 
-// Computes cubic convolution interpolation in 1D
-template <typename T>
-float CubicInterpolation1D(const T* Xdata,
-                           int64_t x,
-                           int64_t y,
-                           int64_t input_height,
-                           int64_t input_width,
-                           std::array<float, CubicModeGridLength>& coeff_array,
-                           float coeff_sum,
-                           std::unordered_map<int64_t, float>& cache) {
-  // When calculating cubic interpolation we move the 4*4 grid across the original data and therefore there is
-  // opportunity to cache the results for previously seen combinations.
-  // Check if the result is already available in the cache
-  auto grid_start_pos = (y)*input_width + (x - 1);
-  if (cache.find(grid_start_pos) != cache.end()) {
-    return cache[grid_start_pos];
-  }
+static CubicParamsForAxis SetupCubicParamsForAxis(int64_t input_size, int64_t output_size, float scale,
+                                                  float roi_start, float roi_end, float cubic_coeff_a,
+                                                  bool exclude_outside,
+                                                  const GetOriginalCoordinateFunc& get_original_coordinate) {
+  CubicParamsForAxis p;
+  p.original.resize(narrow<size_t>(output_size));
+  p.index.resize(narrow<size_t>(output_size) * CubicModeGridLength);
+  p.weight.resize(narrow<size_t>(output_size) * CubicModeGridLength);
+
+  for (int64_t o = 0; o < output_size; ++o) {
+    const float in = scale == 1 ? static_cast<float>(o)
+                                : get_original_coordinate(static_cast<float>(o), scale,
+                                                          static_cast<float>(output_size),
+                                                          static_cast<float>(input_size),
+                                                          roi_start, roi_end);
+    p.original[narrow<size_t>(o)] = in;
+    const auto in_int = static_cast<int64_t>(std::floor(in));
+    auto coeffs = GetCubicCoeffs(in - static_cast<float>(in_int), cubic_coeff_a);
+
+    // When exclude_outside is set, the weight of sampling locations outside the grid will be set to 0
+    // and the weight will be renormalized so that their sum is 1.0
+    float coeff_sum = 1;
+    if (exclude_outside) {
+      coeff_sum = 0;
+      for (int64_t i = 0, val = in_int - 1; val <= in_int + 2; val++, i++) {
+        if (val < 0 || val >= input_size) {
+          coeffs[narrow<size_t>(i)] = 0.0f;
+        }
+        coeff_sum += coeffs[narrow<size_t>(i)];
+      }
+    }
 
-  // get the neighbors in 1D and find interpolation for this dimension
-  // for 1D cubic interpolation 4 samples are used. 2 on the left and 2 on the right of x
-  float result = 0;
-  for (int i = 0, j = -1; i < static_cast<int>(CubicModeGridLength); i++, j++) {
-    auto orig_data = GetDataForCoordinate(Xdata, x + j, y, input_height, input_width);
-    result += coeff_array[narrow<size_t>(i)] / coeff_sum * orig_data;
+    int64_t* index = p.index.data() + o * CubicModeGridLength;
+    float* weight = p.weight.data() + o * CubicModeGridLength;
+    for (int64_t i = 0, val = in_int - 1; val <= in_int + 2; val++, i++) {
+      index[i] = std::max<int64_t>(0, std::min(val, input_size - 1));
+      weight[i] = coeffs[narrow<size_t>(i)] / coeff_sum;
+    }
   }
-  cache[grid_start_pos] = result;
-
-  return result;
+  return p;
 }
+
 #if defined(_MSC_VER)
 #pragma warning(push)
 #pragma warning(disable : 6001)
 #endif
+// Bicubic interpolation as two 1-D passes over the coefficient tables: the input rows used by the output are first
+// interpolated along the width, and then each output row is a weighted sum of 4 of the interpolated rows.
 template <typename T>
 void ResizeBiCubic(int64_t batch_size,
                    int64_t num_channels,
@@ -930,136 +1004,92 @@ void ResizeBiCubic(int64_t batch_size,
                    float extrapolation_value,
                    bool exclude_outside,
                    const std::vector<float>& roi,
-                   const T* Xdata,
-                   T* Ydata,
-                   const GetOriginalCoordinateFunc& get_original_coordinate) {
-  std::vector<float> y_original;
-  y_original.reserve(narrow<size_t>(output_height));
-
-  std::vector<float> x_original;
-  x_original.reserve(narrow<size_t>(output_width));
-
-  std::unordered_map<float, std::array<float, CubicModeGridLength>> cubic_coeffs;
-  std::unordered_map<float, std::unordered_map<int64_t, float>> coeff_to_1Dinterpolation_map;
+                   const T* XdataBase,
+                   T* YdataBase,
+                   const GetOriginalCoordinateFunc& get_original_coordinate,
+                   concurrency::ThreadPool* tp) {
   auto roi_y_start = roi.size() / 2 - 2;
   auto roi_y_end = roi.size() - 2;
   auto roi_x_start = roi.size() / 2 - 1;
   auto roi_x_end = roi.size() - 1;
 
-  // generate coefficients in y direction
-  for (int64_t y = 0; y < output_height; ++y) {
-    float in_y = height_scale == 1 ? static_cast<float>(y)
-                                   : get_original_coordinate(static_cast<float>(y), height_scale,
-                                                             static_cast<float>(output_height),
-                                                             static_cast<float>(input_height),
-                                                             roi[roi_y_start], roi[roi_y_end]);
-    y_original.emplace_back(in_y);
-    auto s = y_original[narrow<size_t>(y)] - std::floor(y_original[narrow<size_t>(y)]);
-    if (cubic_coeffs.find(s) == cubic_coeffs.end()) {
-      cubic_coeffs[s] = GetCubicCoeffs(s, cubic_coeff_a);
-      coeff_to_1Dinterpolation_map[s] = {};
-    }
-  }
+  const CubicParamsForAxis py = SetupCubicParamsForAxis(input_height, output_height, height_scale,
+                                                        roi[roi_y_start], roi[roi_y_end], cubic_coeff_a,
+                                                        exclude_outside, get_original_coordinate);
+  const CubicParamsForAxis px = SetupCubicParamsForAxis(input_width, output_width, width_scale,
+                                                        roi[roi_x_start], roi[roi_x_end], cubic_coeff_a,
+                                                        exclude_outside, get_original_coordinate);
+
+  // when use_extrapolation is set and original index is out of the dim range
+  // then use extrapolation_value as the output value.
+  auto y_outside = [&](int64_t y) {
+    const float in_y = py.original[narrow<size_t>(y)];
+    return use_extrapolation && (in_y < 0 || in_y > static_cast<float>(input_height - 1));
+  };
+  auto x_outside = [&](int64_t x) {
+    const float in_x = px.original[narrow<size_t>(x)];
+    return use_extrapolation && (in_x < 0 || in_x > static_cast<float>(input_width - 1));
+  };
 
-  // generate coefficients in x direction
-  for (int64_t x = 0; x < output_width; ++x) {
-    float in_x = width_scale == 1 ? static_cast<float>(x)
-                                  : get_original_coordinate(static_cast<float>(x),
-                                                            width_scale,
-                                                            static_cast<float>(output_width),
-                                                            static_cast<float>(input_width),
-                                                            roi[roi_x_start], roi[roi_x_end]);
-    x_original.emplace_back(in_x);
-    auto s = x_original[narrow<size_t>(x)] - std::floor(x_original[narrow<size_t>(x)]);
-    if (cubic_coeffs.find(s) == cubic_coeffs.end()) {
-      cubic_coeffs[s] = GetCubicCoeffs(s, cubic_coeff_a);
-      coeff_to_1Dinterpolation_map[s] = {};
+  // input rows read by the output rows that are not extrapolated
+  std::vector<uint8_t> row_used(narrow<size_t>(input_height), 0);
+  for (int64_t y = 0; y < output_height; ++y) {
+    if (!y_outside(y)) {
+      for (size_t i = 0; i < CubicModeGridLength; ++i) {
+        row_used[narrow<size_t>(py.index[y * CubicModeGridLength + i])] = 1;
+      }
     }
   }
 
-  // setup up temp arrays to hold coefficients when exclude_outside is set to true
-  std::array<float, CubicModeGridLength> y_coeff_holder;
-  std::array<float, CubicModeGridLength> x_coeff_holder;
-  float y_coeff_sum = 1;
-  float x_coeff_sum = 1;
-
-  for (int64_t n = 0; n < batch_size; n++) {
-    for (int64_t c = 0; c < num_channels; c++) {
-      for (int64_t y = 0; y < output_height; ++y) {
-        auto in_y = y_original[narrow<size_t>(y)];
-
-        // when use_extrapolation is set and original index is out of the dim range
-        // then use extrapolation_value as the output value.
-        if (use_extrapolation && (in_y < 0 || in_y > static_cast<float>(input_height - 1))) {
-          for (int64_t x = 0; x < output_width; ++x) {
-            Ydata[y * output_width + x] = extrapolation_value;
-          }
-          continue;
-        }
-
-        auto y_int = static_cast<int64_t>(std::floor(in_y));
-        auto& coeff_y = exclude_outside ? y_coeff_holder : cubic_coeffs[in_y - y_int];
-        y_coeff_sum = 1;
-
-        if (exclude_outside) {
-          // When true, the weight of sampling locations outside the grid will be set to 0
-          // and the weight will be renormalized so that their sum is 1.0
-          y_coeff_sum = 0;
-          auto& orig_y_coeffs = cubic_coeffs[in_y - y_int];
-          for (int64_t i = 0, y_val = y_int - 1; y_val <= y_int + 2; y_val++, i++) {
-            y_coeff_holder[narrow<size_t>(i)] = (y_val < 0 || y_val >= static_cast<float>(input_height)) ? 0.0f : orig_y_coeffs[narrow<size_t>(i)];
-            y_coeff_sum += y_coeff_holder[narrow<size_t>(i)];
-          }
-        }
+  const size_t width = narrow<size_t>(output_width);
+  const double cost = static_cast<double>(input_height + output_height) * output_width * CubicModeGridLength * 2;
+  concurrency::ThreadPool::TryParallelFor(
+      tp, static_cast<std::ptrdiff_t>(batch_size * num_channels), cost,
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        std::vector<float> rows(narrow<size_t>(input_height) * width);
 
-        for (int64_t x = 0; x < output_width; ++x) {
-          auto in_x = x_original[narrow<size_t>(x)];
-
-          // when use_extrapolation is set and original index is out of the dim range
-          // then use extrapolation_value as the output value.
-          if (use_extrapolation && (in_x < 0 || in_x > static_cast<float>(input_width - 1))) {
-            Ydata[y * output_width + x] = extrapolation_value;
-            continue;
-          }
+        for (std::ptrdiff_t image = first; image < last; ++image) {
+          const T* Xdata = XdataBase + image * input_height * input_width;
+          T* Ydata = YdataBase + image * output_height * output_width;
 
-          auto x_int = static_cast<int64_t>(std::floor(in_x));
-          auto s_x = static_cast<float>(in_x - x_int);
-          auto& coeff_x = exclude_outside ? x_coeff_holder : cubic_coeffs[s_x];
-          x_coeff_sum = 1;
-
-          if (exclude_outside) {
-            // When true, the weight of sampling locations outside the grid will be set to 0
-            // and the weight will be renormalized so that their sum is 1.0
-            x_coeff_sum = 0;
-            auto& orig_x_coeff = cubic_coeffs[s_x];
-            for (int64_t i = 0, x_val = x_int - 1; x_val <= x_int + 2; x_val++, i++) {
-              x_coeff_holder[narrow<size_t>(i)] = (x_val < 0 || x_val >= static_cast<float>(input_width)) ? 0.0f : orig_x_coeff[narrow<size_t>(i)];
-              x_coeff_sum += x_coeff_holder[narrow<size_t>(i)];
+          for (int64_t r = 0; r < input_height; ++r) {
+            if (!row_used[narrow<size_t>(r)]) {
+              continue;
+            }
+            const T* in = Xdata + r * input_width;
+            float* out = rows.data() + r * output_width;
+            for (size_t x = 0; x < width; ++x) {
+              const int64_t* index = px.index.data() + x * CubicModeGridLength;
+              const float* weight = px.weight.data() + x * CubicModeGridLength;
+              out[x] = weight[0] * in[index[0]] + weight[1] * in[index[1]] +
+                       weight[2] * in[index[2]] + weight[3] * in[index[3]];
             }
           }
 
-          // Compute cubic interpolation in x dimension using the x coefficients.
-          // From the result of cubic interpolation in x dim, compute cubic interpolation in y dimension
-          auto& interpolation_result_cache = coeff_to_1Dinterpolation_map[s_x];
-          float result = 0;
-          for (int64_t y_val = y_int - 1, i = 0; y_val <= y_int + 2; y_val++, i++) {
-            auto x_interpolation_result = CubicInterpolation1D(Xdata, x_int, y_val,
-                                                               input_height, input_width, coeff_x, x_coeff_sum,
-                                                               interpolation_result_cache);
-            result += x_interpolation_result * coeff_y[narrow<size_t>(i)] / y_coeff_sum;
+          for (int64_t y = 0; y < output_height; ++y, Ydata += output_width) {
+            if (y_outside(y)) {
+              std::fill_n(Ydata, width, static_cast<T>(extrapolation_value));
+              continue;
+            }
+            const int64_t* index = py.index.data() + y * CubicModeGridLength;
+            const float* weight = py.weight.data() + y * CubicModeGridLength;
+            const float* r0 = rows.data() + index[0] * output_width;
+            const float* r1 = rows.data() + index[1] * output_width;
+            const float* r2 = rows.data() + index[2] * output_width;
+            const float* r3 = rows.data() + index[3] * output_width;
+            for (size_t x = 0; x < width; ++x) {
+              Ydata[x] = static_cast<T>(weight[0] * r0[x] + weight[1] * r1[x] + weight[2] * r2[x] + weight[3] * r3[x]);
+            }
+            if (use_extrapolation) {
+              for (size_t x = 0; x < width; ++x) {
+                if (x_outside(static_cast<int64_t>(x))) {
+                  Ydata[x] = static_cast<T>(extrapolation_value);
+                }
+              }
+            }
           }
-
-          Ydata[y * output_width + x] = static_cast<T>(result);
         }
-      }
-
-      Xdata += input_height * input_width;
-      Ydata += output_height * output_width;
-
-      // clear the cache when moving to the next channel
-      coeff_to_1Dinterpolation_map.clear();
-    }
-  }
+      });
 }
 #if defined(_MSC_VER)
 #pragma warning(pop)
@@ -1307,7 +1337,8 @@ Status Upsample<T>::BaseCompute(OpKernelContext* context,
         ResizeBiCubic(batch_size, num_channels, input_height, input_width, output_height, output_width,
                       height_scale, width_scale, cubic_coeff_a_, use_extrapolation_,
                       extrapolation_value_, exclude_outside_, roi, X->Data<float>(),
-                      Y->MutableData<float>(), get_original_coordinate_);
+                      Y->MutableData<float>(), get_original_coordinate_,
+                      output_height * output_width * num_channels > 64 ? context->GetOperatorThreadPool() : nullptr);
       }
       return Status::OK();
     }
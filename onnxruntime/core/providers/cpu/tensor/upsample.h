@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <type_traits>
 #include <vector>
 #ifndef SHARED_PROVIDER
 #include "core/framework/op_kernel.h"
@@ -81,6 +82,18 @@ BilinearParams SetupUpsampleBilinear(const int32_t input_height,
                                      const GetOriginalCoordinateFunc& get_original_coordinate,
                                      const bool is_nchw);
 
+// Bilinear interpolation of float NCHW images as two 1-D passes: each input row used by the output is interpolated
+// along the width once, and each output row blends two of the interpolated rows with contiguous, vectorizable loops.
+void UpsampleBilinearSeparable(const BilinearParams& p,
+                               const int32_t num_images,
+                               const int32_t input_height,
+                               const int32_t input_width,
+                               const int32_t output_height,
+                               const int32_t output_width,
+                               const float* const XdataBase,
+                               float* const YdataBase,
+                               concurrency::ThreadPool* tp);
+
 template <typename T>
 void UpsampleBilinear(const int32_t batch_size,
                       const int32_t num_channels,
@@ -101,6 +114,14 @@ void UpsampleBilinear(const int32_t batch_size,
   BilinearParams p = SetupUpsampleBilinear(input_height, input_width, output_height, output_width,
                                            height_scale, width_scale, roi,
                                            alloc, get_original_coordinate, true);
+  if constexpr (std::is_same_v<T, float>) {
+    if (!use_extrapolation) {
+      UpsampleBilinearSeparable(p, batch_size * num_channels, input_height, input_width, output_height, output_width,
+                                XdataBase, YdataBase, tp);
+      return;
+    }
+  }
+
   for (int32_t n = 0; n < batch_size; ++n) {
     concurrency::ThreadPool::TrySimpleParallelFor(
         tp, num_channels,
@@ -4,6 +4,7 @@
 #include "cuda_allocator.h"
 #include "cuda_common.h"
 #include "gpu_data_transfer.h"
+#include "core/framework/stream_handles.h"
 
 namespace onnxruntime {
 
@@ -55,6 +56,72 @@ void CUDAAllocator::Free(void* p) {
   cudaFree(p);         // do not throw error since it's OK for cudaFree to fail during shutdown
 }
 
+CUDAMallocAsyncAllocator::CUDAMallocAsyncAllocator(OrtDevice::DeviceId device_id, const char* name,
+                                                   size_t release_threshold)
+    : CUDAAllocator(device_id, name) {
+#if CUDART_VERSION >= 11020
+  cudaMemPoolProps props{};
+  props.allocType = cudaMemAllocationTypePinned;
+  props.location.type = cudaMemLocationTypeDevice;
+  props.location.id = device_id;
+  CUDA_CALL_THROW(cudaMemPoolCreate(&pool_, &props));
+  uint64_t threshold = release_threshold;
+  CUDA_CALL_THROW(cudaMemPoolSetAttribute(pool_, cudaMemPoolAttrReleaseThreshold, &threshold));
+#else
+  ORT_UNUSED_PARAMETER(release_threshold);
+  ORT_THROW("The stream ordered allocator requires CUDA 11.2 or later.");
+#endif
+}
+
+CUDAMallocAsyncAllocator::~CUDAMallocAsyncAllocator() {
+#if CUDART_VERSION >= 11020
+  // do not throw error since it's OK for CUDA calls to fail during shutdown
+  if (pool_) {
+    cudaMemPoolDestroy(pool_);
+  }
+#endif
+}
+
+void* CUDAMallocAsyncAllocator::StreamOrderedAlloc(size_t size, Stream* stream) {
+  if (stream == nullptr) {
+    return Alloc(size);
+  }
+  void* p = nullptr;
+#if CUDART_VERSION >= 11020
+  if (size > 0) {
+    SetDevice(true);
+    CheckDevice(true);
+    cudaStream_t cuda_stream = static_cast<cudaStream_t>(stream->GetHandle());
+    CUDA_CALL_THROW(cudaMallocFromPoolAsync(&p, size, pool_, cuda_stream));
+    std::lock_guard<OrtMutex> lock(lock_);
+    streams_[p] = cuda_stream;
+  }
+#endif
+  return p;
+}
+
+void CUDAMallocAsyncAllocator::Free(void* p) {
+  bool from_pool = false;
+  cudaStream_t cuda_stream = nullptr;
+  {
+    std::lock_guard<OrtMutex> lock(lock_);
+    auto it = streams_.find(p);
+    if (it != streams_.end()) {
+      from_pool = true;
+      cuda_stream = it->second;
+      streams_.erase(it);
+    }
+  }
+  if (!from_pool) {
+    CUDAAllocator::Free(p);
+    return;
+  }
+#if CUDART_VERSION >= 11020
+  SetDevice(false);
+  cudaFreeAsync(p, cuda_stream);  // do not throw error since it's OK for cudaFreeAsync to fail during shutdown
+#endif
+}
+
 void* CUDAExternalAllocator::Alloc(size_t size) {
   void* p = nullptr;
   if (size > 0) {
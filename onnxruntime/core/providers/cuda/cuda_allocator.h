@@ -6,6 +6,7 @@
 #include "core/common/inlined_containers.h"
 #include "core/framework/allocator.h"
 #include "core/platform/ort_mutex.h"
+#include "core/providers/cuda/cuda_pch.h"
 
 namespace onnxruntime {
 
@@ -19,11 +20,34 @@ class CUDAAllocator : public IAllocator {
   void* Alloc(size_t size) override;
   void Free(void* p) override;
 
- private:
+ protected:
   void CheckDevice(bool throw_when_fail) const;
   void SetDevice(bool throw_when_fail) const;
 };
 
+// Allocator for the stream ordered memory pools of CUDA (cudaMallocAsync/cudaFreeAsync). The memory allocated on a
+// stream is freed in the order of that stream and can be reused by the pool without an arena, across streams once
+// the work that used it completed. The pool keeps up to release_threshold bytes of freed memory when a stream
+// synchronizes, and returns the rest to the device.
+// Memory allocated without a stream, e.g. for initializers, does not come from the pool: it is allocated and freed
+// synchronously like CUDAAllocator does.
+class CUDAMallocAsyncAllocator : public CUDAAllocator {
+ public:
+  CUDAMallocAsyncAllocator(OrtDevice::DeviceId device_id, const char* name, size_t release_threshold);
+  ~CUDAMallocAsyncAllocator() override;
+
+  void Free(void* p) override;
+  bool IsStreamOrdered() const override { return true; }
+  void* StreamOrderedAlloc(size_t size, Stream* stream) override;
+
+ private:
+  cudaMemPool_t pool_{nullptr};
+
+  // stream of every allocation from the pool, which its free is ordered on
+  mutable OrtMutex lock_;
+  InlinedHashMap<void*, cudaStream_t> streams_;
+};
+
 class CUDAExternalAllocator : public CUDAAllocator {
   typedef void* (*ExternalAlloc)(size_t size);
   typedef void (*ExternalFree)(void* p);
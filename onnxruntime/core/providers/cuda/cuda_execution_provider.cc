@@ -13,6 +13,7 @@
 
 #ifndef DISABLE_CONTRIB_OPS
 #include "contrib_ops/cuda/cuda_contrib_kernels.h"
+#include "core/providers/cuda/cuda_nhwc_kernels.h"
 #endif
 
 #ifdef ENABLE_TRAINING_OPS
@@ -162,7 +163,8 @@ AllocatorPtr CUDAExecutionProvider::CreateCudaAllocator(OrtDevice::DeviceId devi
 
 CUDAExecutionProvider::PerThreadContext::PerThreadContext(OrtDevice::DeviceId device_id, cudaStream_t stream, size_t /*gpu_mem_limit*/,
                                                           ArenaExtendStrategy /*arena_extend_strategy*/, CUDAExecutionProviderExternalAllocatorInfo /*external_allocator_info*/,
-                                                          OrtArenaCfg* /*default_memory_arena_cfg*/) {
+                                                          OrtArenaCfg* /*default_memory_arena_cfg*/, int cuda_graph_max_graphs)
+    : cuda_graph_manager_(cuda_graph_max_graphs, min_num_runs_before_cuda_graph_capture_) {
   CUDA_CALL_THROW(cudaSetDevice(device_id));
 
   CUBLAS_CALL_THROW(cublasCreate(&cublas_handle_));
@@ -172,7 +174,7 @@ CUDAExecutionProvider::PerThreadContext::PerThreadContext(OrtDevice::DeviceId de
   CUDNN_CALL_THROW(cudnnCreate(&cudnn_handle_));
   CUDNN_CALL_THROW(cudnnSetStream(cudnn_handle_, stream));
 
-  cuda_graph_.SetStream(stream);
+  cuda_graph_manager_.SetStream(stream);
 }
 
 CUDAExecutionProvider::PerThreadContext::~PerThreadContext() {
@@ -181,31 +183,32 @@ CUDAExecutionProvider::PerThreadContext::~PerThreadContext() {
   ORT_IGNORE_RETURN_VALUE(CUDNN_CALL(cudnnDestroy(cudnn_handle_)));
 }
 
+void CUDAExecutionProvider::PerThreadContext::SetGraphCaptureKey(gsl::span<const int64_t> key) {
+  cuda_graph_manager_.SetKey(key);
+}
+
 bool CUDAExecutionProvider::PerThreadContext::IsGraphCaptureAllowed() const {
-  return regular_run_count_before_graph_capture_ >= min_num_runs_before_cuda_graph_capture_;
+  return cuda_graph_manager_.IsGraphCaptureAllowed();
 }
 
 void CUDAExecutionProvider::PerThreadContext::CaptureBegin() {
-  cuda_graph_.Reset();
-  cuda_graph_.CaptureBegin();
+  cuda_graph_manager_.CaptureBegin();
 }
 
 void CUDAExecutionProvider::PerThreadContext::CaptureEnd() {
-  cuda_graph_.CaptureEnd();
-  is_graph_captured_ = true;
+  cuda_graph_manager_.CaptureEnd();
 }
 
 bool CUDAExecutionProvider::PerThreadContext::IsGraphCaptured() const {
-  return is_graph_captured_;
+  return cuda_graph_manager_.IsGraphCaptured();
 }
 
 Status CUDAExecutionProvider::PerThreadContext::ReplayGraph() {
-  ORT_ENFORCE(IsGraphCaptured());
-  return cuda_graph_.Replay();
+  return cuda_graph_manager_.Replay();
 }
 
 void CUDAExecutionProvider::PerThreadContext::IncrementRegularRunCountBeforeGraphCapture() {
-  ++regular_run_count_before_graph_capture_;
+  cuda_graph_manager_.IncrementRegularRunCount();
 }
 
 void OverrideTunableOpInfoByEnv(CUDAExecutionProviderInfo& info) {
@@ -324,7 +327,8 @@ CUDAExecutionProvider::PerThreadContext& CUDAExecutionProvider::GetPerThreadCont
     // get or create a context
     if (context_state_.retired_context_pool.empty()) {
       context = std::make_shared<PerThreadContext>(info_.device_id, stream_, info_.gpu_mem_limit,
-                                                   info_.arena_extend_strategy, info_.external_allocator_info, info_.default_memory_arena_cfg);
+                                                   info_.arena_extend_strategy, info_.external_allocator_info, info_.default_memory_arena_cfg,
+                                                   info_.cuda_graph_max_graphs);
     } else {
       context = context_state_.retired_context_pool.back();
       context_state_.retired_context_pool.pop_back();
@@ -424,6 +428,10 @@ Status CUDAExecutionProvider::ReplayGraph() {
   return GetPerThreadContext().ReplayGraph();
 }
 
+void CUDAExecutionProvider::SetGraphCaptureKey(gsl::span<const int64_t> key) {
+  GetPerThreadContext().SetGraphCaptureKey(key);
+}
+
 namespace cuda {
 // opset 1 to 9
 class ONNX_OPERATOR_KERNEL_CLASS_NAME(kCudaExecutionProvider, kOnnxDomain, 1, MemcpyFromHost);
@@ -2306,6 +2314,7 @@ static Status RegisterCudaKernels(KernelRegistry& kernel_registry) {
 
 #ifndef DISABLE_CONTRIB_OPS
   ORT_RETURN_IF_ERROR(::onnxruntime::contrib::cuda::RegisterCudaContribKernels(kernel_registry));
+  ORT_RETURN_IF_ERROR(RegisterCudaNhwcKernels(kernel_registry));
 #endif
 
 #ifdef ENABLE_TRAINING_OPS
@@ -2332,6 +2341,15 @@ std::shared_ptr<KernelRegistry> CUDAExecutionProvider::GetKernelRegistry() const
   return s_kernel_registry;
 }
 
+DataLayout CUDAExecutionProvider::GetPreferredLayout() const {
+#ifndef DISABLE_CONTRIB_OPS
+  // the NHWC kernels are registered for the internal NHWC domain, whose op schemas are part of the contrib ops
+  return info_.prefer_nhwc ? DataLayout::NHWC : DataLayout::NCHW;
+#else
+  return DataLayout::NCHW;
+#endif
+}
+
 static bool RNNNeedFallbackToCPU(const onnxruntime::Node& node,
                                  const std::vector<std::string> activations_supported,
                                  const std::string& op_type) {
@@ -2458,7 +2476,7 @@ static bool CastNeedFallbackToCPU(const onnxruntime::Node& node) {
 }
 
 std::unique_ptr<onnxruntime::IDataTransfer> CUDAExecutionProvider::GetDataTransfer() const {
-  return std::make_unique<onnxruntime::GPUDataTransfer>();
+  return std::make_unique<onnxruntime::GPUDataTransfer>(info_.use_pinned_staging_buffers);
 }
 
 std::vector<std::unique_ptr<ComputeCapability>>
@@ -2570,6 +2588,20 @@ std::vector<AllocatorPtr> CUDAExecutionProvider::CreatePreferredAllocators() {
       // correct to use the GPU device id, unless we wanted to share the pinned memory allocator across devices,
       // at the risk the lifetime isn't managed correctly if one of those devices go away.
       0);
+  if (info_.use_stream_ordered_allocator && !info_.external_allocator_info.UseExternalAllocator()) {
+    const size_t release_threshold = info_.mem_pool_release_threshold;
+    AllocatorCreationInfo default_memory_info(
+        [release_threshold](OrtDevice::DeviceId id) {
+          return std::make_unique<CUDAMallocAsyncAllocator>(id, CUDA, release_threshold);
+        },
+        info_.device_id,
+        // the memory pool of CUDA replaces the arena
+        false);
+    return std::vector<AllocatorPtr>{
+        CreateAllocator(default_memory_info),
+        CreateAllocator(pinned_memory_info),
+    };
+  }
   return std::vector<AllocatorPtr>{
       CreateCudaAllocator(info_.device_id, info_.gpu_mem_limit, info_.arena_extend_strategy,
                           info_.external_allocator_info, info_.default_memory_arena_cfg),
@@ -68,6 +68,10 @@ class CUDAExecutionProvider : public IExecutionProvider {
   bool GetCudnnConvUseMaxWorkspace() const { return info_.cudnn_conv_use_max_workspace; }
   bool GetCudnnConv1dPadToNc1d() const { return info_.cudnn_conv1d_pad_to_nc1d; }
   bool IsSkipLayerNormInStrictMode() const { return info_.enable_skip_layer_norm_strict_mode; }
+  bool IsNHWCPreferred() const { return info_.prefer_nhwc; }
+  size_t GetEmbeddingCacheSizeInMB() const { return info_.embedding_cache_size_in_mb; }
+
+  DataLayout GetPreferredLayout() const override;
 
   ProviderOptions GetProviderOptions() const override {
     return CUDAExecutionProviderInfo::ToProviderOptions(info_);
@@ -83,6 +87,7 @@ class CUDAExecutionProvider : public IExecutionProvider {
   bool IsGraphCaptureEnabled() const override;
   bool IsGraphCaptured() const override;
   Status ReplayGraph() override;
+  void SetGraphCaptureKey(gsl::span<const int64_t> key) override;
   void RegisterStreamHandlers(IStreamCommandHandleRegistry& stream_handle_registry, AllocatorMap& allocators) const override;
   OrtDevice GetOrtDeviceByMemType(OrtMemType mem_type) const override;
   std::vector<AllocatorPtr> CreatePreferredAllocators() override;
@@ -102,7 +107,8 @@ class CUDAExecutionProvider : public IExecutionProvider {
   class PerThreadContext final {
    public:
     PerThreadContext(OrtDevice::DeviceId device_id, cudaStream_t stream, size_t cuda_mem_limit, ArenaExtendStrategy arena_extend_strategy,
-                     CUDAExecutionProviderExternalAllocatorInfo external_alloc_info, OrtArenaCfg* arena_cfg);
+                     CUDAExecutionProviderExternalAllocatorInfo external_alloc_info, OrtArenaCfg* arena_cfg,
+                     int cuda_graph_max_graphs);
     ~PerThreadContext();
 
     cublasHandle_t CublasHandle() const {
@@ -164,6 +170,7 @@ class CUDAExecutionProvider : public IExecutionProvider {
       }
     }
 
+    void SetGraphCaptureKey(gsl::span<const int64_t> key);
     bool IsGraphCaptureAllowed() const;
     void CaptureBegin();
     void CaptureEnd();
@@ -185,17 +192,15 @@ class CUDAExecutionProvider : public IExecutionProvider {
     std::unique_ptr<cuda::IConstantBuffer<Float8E5M2>> constant_ones_float8e5m2_;
 #endif
 
-    // Cuda graph with multi threads will be supported in the future, so cuda_graph_
-    // is put under PerThreadContext.
-    CUDAGraph cuda_graph_;
-    bool is_graph_captured_ = false;
-    int regular_run_count_before_graph_capture_ = 0;
-
     // There is chance that the second regular run allocates GPU memory for causes like:
     // (1) memory pattern is enabled. (2) arena allocation for stream.
     // Since no GPU memory allocation is allowed during graph capturing, we need at least two regular runs
     // to allocate enough memory in Arena before graph capturing.
-    const int min_num_runs_before_cuda_graph_capture_ = 2;  // required min regular runs before graph capture for the necessary memory allocations.
+    static constexpr int min_num_runs_before_cuda_graph_capture_ = 2;  // required min regular runs before graph capture for the necessary memory allocations.
+
+    // Cuda graph with multi threads will be supported in the future, so the cuda graphs
+    // are put under PerThreadContext. A graph is kept per shape of the inputs of a run.
+    CUDAGraphManager cuda_graph_manager_;
   };
 
   using PerThreadContextMap = std::unordered_map<const CUDAExecutionProvider*, std::weak_ptr<PerThreadContext>>;
@@ -28,6 +28,12 @@ constexpr const char* kTunableOpEnable = "tunable_op_enable";
 constexpr const char* kTunableOpTuningEnable = "tunable_op_tuning_enable";
 constexpr const char* kTunableOpMaxTuningDurationMs = "tunable_op_max_tuning_duration_ms";
 constexpr const char* kEnableSkipLayerNormStrictMode = "enable_skip_layer_norm_strict_mode";
+constexpr const char* kUsePinnedStagingBuffers = "use_pinned_staging_buffers";
+constexpr const char* kUseStreamOrderedAllocator = "use_stream_ordered_allocator";
+constexpr const char* kMemPoolReleaseThreshold = "mem_pool_release_threshold";
+constexpr const char* kPreferNHWCMode = "prefer_nhwc";
+constexpr const char* kCudaGraphMaxGraphs = "cuda_graph_max_graphs";
+constexpr const char* kEmbeddingCacheSizeInMB = "embedding_cache_size_in_mb";
 }  // namespace provider_option_names
 }  // namespace cuda
 
@@ -97,6 +103,12 @@ CUDAExecutionProviderInfo CUDAExecutionProviderInfo::FromProviderOptions(const P
           .AddAssignmentToReference(cuda::provider_option_names::kEnableCudaGraph, info.enable_cuda_graph)
           .AddAssignmentToReference(cuda::provider_option_names::kCudnnConv1dPadToNc1d, info.cudnn_conv1d_pad_to_nc1d)
           .AddAssignmentToReference(cuda::provider_option_names::kEnableSkipLayerNormStrictMode, info.enable_skip_layer_norm_strict_mode)
+          .AddAssignmentToReference(cuda::provider_option_names::kUsePinnedStagingBuffers, info.use_pinned_staging_buffers)
+          .AddAssignmentToReference(cuda::provider_option_names::kUseStreamOrderedAllocator, info.use_stream_ordered_allocator)
+          .AddAssignmentToReference(cuda::provider_option_names::kMemPoolReleaseThreshold, info.mem_pool_release_threshold)
+          .AddAssignmentToReference(cuda::provider_option_names::kPreferNHWCMode, info.prefer_nhwc)
+          .AddAssignmentToReference(cuda::provider_option_names::kCudaGraphMaxGraphs, info.cuda_graph_max_graphs)
+          .AddAssignmentToReference(cuda::provider_option_names::kEmbeddingCacheSizeInMB, info.embedding_cache_size_in_mb)
           .AddValueParser(
               cuda::provider_option_names::kTunableOpEnable,
               [&info](const std::string& value_str) -> Status {
@@ -141,6 +153,12 @@ ProviderOptions CUDAExecutionProviderInfo::ToProviderOptions(const CUDAExecution
       {cuda::provider_option_names::kTunableOpTuningEnable, MakeStringWithClassicLocale(info.tunable_op.tuning_enable)},
       {cuda::provider_option_names::kTunableOpMaxTuningDurationMs, MakeStringWithClassicLocale(info.tunable_op.max_tuning_duration_ms)},
       {cuda::provider_option_names::kEnableSkipLayerNormStrictMode, MakeStringWithClassicLocale(info.enable_skip_layer_norm_strict_mode)},
+      {cuda::provider_option_names::kUsePinnedStagingBuffers, MakeStringWithClassicLocale(info.use_pinned_staging_buffers)},
+      {cuda::provider_option_names::kUseStreamOrderedAllocator, MakeStringWithClassicLocale(info.use_stream_ordered_allocator)},
+      {cuda::provider_option_names::kMemPoolReleaseThreshold, MakeStringWithClassicLocale(info.mem_pool_release_threshold)},
+      {cuda::provider_option_names::kPreferNHWCMode, MakeStringWithClassicLocale(info.prefer_nhwc)},
+      {cuda::provider_option_names::kCudaGraphMaxGraphs, MakeStringWithClassicLocale(info.cuda_graph_max_graphs)},
+      {cuda::provider_option_names::kEmbeddingCacheSizeInMB, MakeStringWithClassicLocale(info.embedding_cache_size_in_mb)},
   };
 
   return options;
@@ -158,6 +176,12 @@ ProviderOptions CUDAExecutionProviderInfo::ToProviderOptions(const OrtCUDAProvid
       {cuda::provider_option_names::kTunableOpEnable, MakeStringWithClassicLocale(info.tunable_op_enable)},
       {cuda::provider_option_names::kTunableOpTuningEnable, MakeStringWithClassicLocale(info.tunable_op_tuning_enable)},
       {cuda::provider_option_names::kTunableOpMaxTuningDurationMs, MakeStringWithClassicLocale(info.tunable_op_max_tuning_duration_ms)},
+      {cuda::provider_option_names::kUsePinnedStagingBuffers, MakeStringWithClassicLocale(info.use_pinned_staging_buffers)},
+      {cuda::provider_option_names::kUseStreamOrderedAllocator, MakeStringWithClassicLocale(info.use_stream_ordered_allocator)},
+      {cuda::provider_option_names::kMemPoolReleaseThreshold, MakeStringWithClassicLocale(info.mem_pool_release_threshold)},
+      {cuda::provider_option_names::kPreferNHWCMode, MakeStringWithClassicLocale(info.prefer_nhwc)},
+      {cuda::provider_option_names::kCudaGraphMaxGraphs, MakeStringWithClassicLocale(info.cuda_graph_max_graphs)},
+      {cuda::provider_option_names::kEmbeddingCacheSizeInMB, MakeStringWithClassicLocale(info.embedding_cache_size_in_mb)},
   };
 
   return options;
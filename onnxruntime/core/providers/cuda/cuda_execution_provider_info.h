@@ -64,6 +64,9 @@ struct CUDAExecutionProviderInfo {
   bool cudnn_conv_use_max_workspace{true};
 
   bool enable_cuda_graph{false};
+  // A graph is captured for each set of shapes of the inputs of a run. When more than cuda_graph_max_graphs graphs
+  // are captured, the least recently replayed one is destroyed.
+  int cuda_graph_max_graphs{8};
 
   // By default, for Conv1D, will pad [N,C,D] to [N,C,D,1], if turn on, will pad to [N,C,1,D].
   bool cudnn_conv1d_pad_to_nc1d{false};
@@ -72,6 +75,27 @@ struct CUDAExecutionProviderInfo {
 
   bool enable_skip_layer_norm_strict_mode{false};
 
+  // Stage the copies between pageable host memory and the GPU on the EP streams in a pool of pinned buffers,
+  // so that they overlap with the host memcpy and, for copies to the GPU, with the work after them on the stream.
+  bool use_pinned_staging_buffers{true};
+
+  // Allocate the GPU memory from a stream ordered memory pool of CUDA (cudaMallocAsync/cudaFreeAsync) instead of the
+  // BFC arena. The pool keeps up to mem_pool_release_threshold bytes of freed memory when a stream synchronizes.
+  // Not used with an external allocator.
+  bool use_stream_ordered_allocator{false};
+  size_t mem_pool_release_threshold{std::numeric_limits<size_t>::max()};
+
+  // Prefer the NHWC layout, so that the layout transformation converts Conv, BatchNormalization, the pooling ops and
+  // Resize to their NHWC kernels and the transposes between them are removed. cuDNN runs convolutions in NHWC on the
+  // tensor cores without converting the layout, which is faster for fp16 convnets.
+  // Requires the contrib ops, which contain the NHWC op schemas.
+  bool prefer_nhwc{false};
+
+  // The tables of EmbeddingBag nodes stay in host memory, which may be memory mapped external data, and the rows
+  // looked up are cached on the GPU. Each table gets a cache of embedding_cache_size_in_mb MB that evicts the least
+  // frequently used rows, for tables larger than the GPU memory. 0 sizes the cache to the whole table.
+  size_t embedding_cache_size_in_mb{0};
+
   static CUDAExecutionProviderInfo FromProviderOptions(const ProviderOptions& options);
   static ProviderOptions ToProviderOptions(const CUDAExecutionProviderInfo& info);
   static ProviderOptions ToProviderOptions(const OrtCUDAProviderOptionsV2& info);
@@ -4,6 +4,7 @@
 #include "core/providers/cuda/cuda_graph.h"
 
 #include "core/providers/cuda/cuda_common.h"
+#include "core/framework/nvtx_ranges.h"
 #include <cuda_runtime_api.h>
 #include <driver_types.h>
 
@@ -36,7 +37,13 @@ void CUDAGraph::CaptureEnd() {
   }
 
   has_graph_ = true;
+#if CUDART_VERSION >= 11040
+  // the stream ordered allocator adds allocation nodes to the graph for the memory allocated during the capture.
+  // the memory that is not freed in the graph, e.g. by a free after the capture ended, is freed before every replay.
+  CUDA_CALL_THROW(cudaGraphInstantiateWithFlags(&graph_exec_, graph_, cudaGraphInstantiateFlagAutoFreeOnLaunch));
+#else
   CUDA_CALL_THROW(cudaGraphInstantiate(&graph_exec_, graph_, NULL, NULL, 0));
+#endif
   has_graph_exec_ = true;
   CUDA_CALL_THROW(cudaGraphDestroy(graph_));
   has_graph_ = false;
@@ -46,8 +53,10 @@ Status CUDAGraph::Replay() {
   // Although this function is not thread safe, the lock is not needed here because
   // CUDA EP maintains a separate cuda graph per thread
   LOGS_DEFAULT(INFO) << "Replaying CUDA graph on stream " << stream_;
+  profiling::NvtxRange nvtx_range("CUDAGraph::Replay", profiling::NvtxColor::kGraphReplay);
   CUDA_RETURN_IF_ERROR(cudaGraphLaunch(graph_exec_, stream_));
   CUDA_RETURN_IF_ERROR(cudaStreamSynchronize(stream_));
+  metrics::AddToCounter("onnxruntime_cuda_graph_replays_total", "Replays of captured CUDA graphs.");
   return Status::OK();
 }
 
@@ -66,4 +75,69 @@ CUDAGraph::~CUDAGraph() {
   Reset();
 }
 
+void CUDAGraphManager::SetStream(cudaStream_t stream) {
+  stream_ = stream;
+}
+
+void CUDAGraphManager::SetKey(gsl::span<const int64_t> key) {
+  current_ = &entries_[std::vector<int64_t>(key.begin(), key.end())];
+}
+
+bool CUDAGraphManager::IsGraphCaptureAllowed() const {
+  return current_ != nullptr && current_->regular_run_count >= min_runs_before_capture_;
+}
+
+void CUDAGraphManager::CaptureBegin() {
+  ORT_ENFORCE(current_ != nullptr && current_->last_use == 0);
+  if (num_captured_graphs_ >= max_graphs_) {
+    EvictLeastRecentlyUsedGraph();
+  }
+  current_->graph = std::make_unique<CUDAGraph>(stream_);
+  current_->graph->CaptureBegin();
+}
+
+void CUDAGraphManager::CaptureEnd() {
+  current_->graph->CaptureEnd();
+  current_->last_use = ++use_count_;
+  ++num_captured_graphs_;
+}
+
+bool CUDAGraphManager::IsGraphCaptured() const {
+  return current_ != nullptr && current_->last_use != 0;
+}
+
+Status CUDAGraphManager::Replay() {
+  ORT_ENFORCE(IsGraphCaptured());
+  current_->last_use = ++use_count_;
+  return current_->graph->Replay();
+}
+
+void CUDAGraphManager::IncrementRegularRunCount() {
+  ++current_->regular_run_count;
+}
+
+void CUDAGraphManager::EvictLeastRecentlyUsedGraph() {
+  Entry* lru = nullptr;
+  for (auto& entry : entries_) {
+    if (entry.second.last_use != 0 && (lru == nullptr || entry.second.last_use < lru->last_use)) {
+      lru = &entry.second;
+    }
+  }
+  if (lru == nullptr) {
+    return;
+  }
+
+  LOGS_DEFAULT(INFO) << "Destroying the least recently used CUDA graph of " << num_captured_graphs_
+                     << " captured graphs";
+  lru->graph.reset();
+  lru->last_use = 0;
+  --num_captured_graphs_;
+#if CUDART_VERSION >= 11040
+  // return the memory of the allocations in the destroyed graph that the other graphs do not reuse
+  int device_id = 0;
+  CUDA_CALL_THROW(cudaGetDevice(&device_id));
+  CUDA_CALL_THROW(cudaDeviceGraphMemTrim(device_id));
+#endif
+}
+
 }  // namespace onnxruntime
@@ -3,6 +3,10 @@
 
 #pragma once
 
+#include <map>
+#include <memory>
+#include <vector>
+
 #include "core/common/common.h"
 #include "core/platform/ort_mutex.h"
 #include "core/providers/cuda/cuda_pch.h"
@@ -32,4 +36,47 @@ struct CUDAGraph {
   cudaStream_t stream_ = nullptr;  // Does not own the stream
 };
 
+// Keeps a captured graph per key, the shapes of the inputs of a run, so that a model run with a few input shapes,
+// e.g. a decoder with one shape per sequence length bucket, replays a graph for each of them.
+// A graph is captured for a key after min_runs_before_capture regular runs with it, which allocate the memory the
+// graph needs. The graphs share the memory of the allocator of the EP, which is reused between them as they are
+// replayed on the same stream one after the other. When more than max_graphs graphs are captured, the least recently
+// used one is destroyed.
+class CUDAGraphManager {
+ public:
+  CUDAGraphManager(int max_graphs, int min_runs_before_capture)
+      : max_graphs_(max_graphs), min_runs_before_capture_(min_runs_before_capture) {
+    ORT_ENFORCE(max_graphs_ > 0, "The maximum number of CUDA graphs must be positive.");
+    SetKey({});
+  }
+
+  void SetStream(cudaStream_t stream);
+  void SetKey(gsl::span<const int64_t> key);
+
+  bool IsGraphCaptureAllowed() const;
+  void CaptureBegin();
+  void CaptureEnd();
+  bool IsGraphCaptured() const;
+  Status Replay();
+  void IncrementRegularRunCount();
+
+ private:
+  struct Entry {
+    std::unique_ptr<CUDAGraph> graph;
+    int regular_run_count = 0;
+    uint64_t last_use = 0;  // 0 until the graph is captured
+  };
+
+  void EvictLeastRecentlyUsedGraph();
+
+  const int max_graphs_;
+  const int min_runs_before_capture_;
+  cudaStream_t stream_ = nullptr;  // Does not own the stream
+
+  std::map<std::vector<int64_t>, Entry> entries_;
+  Entry* current_ = nullptr;
+  int num_captured_graphs_ = 0;
+  uint64_t use_count_ = 0;
+};
+
 }  // namespace onnxruntime
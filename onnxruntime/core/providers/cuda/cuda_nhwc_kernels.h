@@ -0,0 +1,14 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+namespace onnxruntime {
+namespace cuda {
+
+// Registers the kernels of the layout sensitive ops in the internal NHWC domain, which are used when the
+// NHWC layout is preferred.
+Status RegisterCudaNhwcKernels(KernelRegistry& kernel_registry);
+
+}  // namespace cuda
+}  // namespace onnxruntime
@@ -223,6 +223,12 @@ struct CUDA_Provider : Provider {
     info.tunable_op.tuning_enable = params->tunable_op_tuning_enable;
     info.tunable_op.max_tuning_duration_ms = params->tunable_op_max_tuning_duration_ms;
     info.enable_skip_layer_norm_strict_mode = params->enable_skip_layer_norm_strict_mode != 0;
+    info.use_pinned_staging_buffers = params->use_pinned_staging_buffers != 0;
+    info.use_stream_ordered_allocator = params->use_stream_ordered_allocator != 0;
+    info.mem_pool_release_threshold = params->mem_pool_release_threshold;
+    info.prefer_nhwc = params->prefer_nhwc != 0;
+    info.cuda_graph_max_graphs = params->cuda_graph_max_graphs;
+    info.embedding_cache_size_in_mb = params->embedding_cache_size_in_mb;
 
     return std::make_shared<CUDAProviderFactory>(info);
   }
@@ -243,6 +249,12 @@ struct CUDA_Provider : Provider {
     cuda_options.enable_cuda_graph = internal_options.enable_cuda_graph;
     cuda_options.cudnn_conv1d_pad_to_nc1d = internal_options.cudnn_conv1d_pad_to_nc1d;
     cuda_options.enable_skip_layer_norm_strict_mode = internal_options.enable_skip_layer_norm_strict_mode;
+    cuda_options.use_pinned_staging_buffers = internal_options.use_pinned_staging_buffers;
+    cuda_options.use_stream_ordered_allocator = internal_options.use_stream_ordered_allocator;
+    cuda_options.mem_pool_release_threshold = internal_options.mem_pool_release_threshold;
+    cuda_options.prefer_nhwc = internal_options.prefer_nhwc;
+    cuda_options.cuda_graph_max_graphs = internal_options.cuda_graph_max_graphs;
+    cuda_options.embedding_cache_size_in_mb = internal_options.embedding_cache_size_in_mb;
   }
 
   ProviderOptions GetProviderOptions(const void* provider_options) override {
@@ -42,6 +42,32 @@ Status CudnnTensor::Set(gsl::span<const int64_t> input_dims, cudnnDataType_t dat
   return Status::OK();
 }
 
+Status CudnnTensor::Set(gsl::span<const int64_t> input_dims, cudnnDataType_t dataType, bool is_nhwc) {
+  if (!is_nhwc) {
+    return Set(input_dims, dataType);
+  }
+
+  ORT_RETURN_IF_ERROR(CreateTensorIfNeeded());
+
+  int rank = gsl::narrow_cast<int>(input_dims.size());
+  ORT_RETURN_IF_NOT(rank >= 3, "NHWC tensors need a batch, a channel and at least one spatial dimension.");
+  InlinedVector<int, kTensorShapeSmallBufferElementsSize> dims(rank);
+  InlinedVector<int, kTensorShapeSmallBufferElementsSize> strides(rank);
+  for (int i = 0; i < rank; i++) {
+    dims[i] = gsl::narrow_cast<int>(input_dims[i]);
+  }
+  // the channels are innermost, followed by the spatial dimensions and the batch
+  int64_t pitch = input_dims[1];
+  strides[1] = 1;
+  for (int i = rank - 1; i >= 2; i--) {
+    strides[i] = gsl::narrow_cast<int>(pitch);
+    pitch *= input_dims[i];
+  }
+  strides[0] = gsl::narrow_cast<int>(pitch);
+  CUDNN_RETURN_IF_ERROR(cudnnSetTensorNdDescriptor(tensor_, dataType, static_cast<int>(rank), dims.data(), strides.data()));
+  return Status::OK();
+}
+
 Status CudnnTensor::Set(cudnnTensorFormat_t format, cudnnDataType_t dataType, int n, int c, int h, int w) {
   ORT_RETURN_IF_ERROR(CreateTensorIfNeeded());
   CUDNN_RETURN_IF_ERROR(cudnnSetTensor4dDescriptor(tensor_, format, dataType, n, c, h, w));
@@ -114,6 +114,10 @@ void CUPTIManager::ProcessActivityBuffers(const std::vector<ProfilerActivityBuff
               {"block_x", std::to_string(kernel->blockX)},
               {"block_y", std::to_string(kernel->blockY)},
               {"block_z", std::to_string(kernel->blockZ)},
+              {"registers_per_thread", std::to_string(kernel->registersPerThread)},
+              {"static_shared_memory", std::to_string(kernel->staticSharedMemory)},
+              {"dynamic_shared_memory", std::to_string(kernel->dynamicSharedMemory)},
+              {"local_memory_per_thread", std::to_string(kernel->localMemoryPerThread)},
           };
 
           std::string name{demangle(kernel->name)};
@@ -138,7 +142,13 @@ void CUPTIManager::ProcessActivityBuffers(const std::vector<ProfilerActivityBuff
               {"block_x", "-1"},
               {"block_y", "-1"},
               {"block_z", "-1"},
+              {"bytes", std::to_string(mmcpy->bytes)},
           };
+          if (mmcpy->end > mmcpy->start) {
+            // bytes per nanosecond are gigabytes per second
+            const double bandwidth = static_cast<double>(mmcpy->bytes) / static_cast<double>(mmcpy->end - mmcpy->start);
+            args.emplace("bandwidth_gb_per_second", std::to_string(bandwidth));
+          }
           new (&event) EventRecord{
               /* cat = */ EventCategory::KERNEL_EVENT,
               /* pid = */ -1,
@@ -4,11 +4,18 @@
 #include "core/providers/shared_library/provider_api.h"
 
 #include "core/providers/cuda/gpu_data_transfer.h"
+#include "core/providers/cuda/pinned_staging_buffer_pool.h"
 #include "cuda_common.h"
 
 namespace onnxruntime {
 GPUDataTransfer::GPUDataTransfer() {}
 
+GPUDataTransfer::GPUDataTransfer(bool use_pinned_staging_buffers) {
+  if (use_pinned_staging_buffers) {
+    staging_pool_ = std::make_unique<PinnedStagingBufferPool>();
+  }
+}
+
 GPUDataTransfer::~GPUDataTransfer() {}
 
 bool GPUDataTransfer::CanCopy(const OrtDevice& src_device, const OrtDevice& dst_device) const {
@@ -32,6 +39,11 @@ common::Status GPUDataTransfer::CopyTensor(const Tensor& src, Tensor& dst) const
         CUDA_RETURN_IF_ERROR(cudaMemcpy(dst_data, src_data, bytes, cudaMemcpyDeviceToDevice));
         CUDA_RETURN_IF_ERROR(cudaStreamSynchronize(nullptr));
       }
+    } else if (staging_pool_ && src_device.MemType() != OrtDevice::MemType::CUDA_PINNED) {
+      // copy from pageable memory to GPU through the pinned staging buffers, so that reading the source (e.g. the
+      // mapped external data of an initializer) overlaps with the DMA of the previous chunk. this is blocking
+      ORT_RETURN_IF_ERROR(staging_pool_->CopyHostToDevice(dst_data, src_data, bytes, nullptr));
+      CUDA_RETURN_IF_ERROR(cudaStreamSynchronize(nullptr));
     } else {
       // copy from other CPU memory to GPU, this is blocking
       CUDA_RETURN_IF_ERROR(cudaMemcpy(dst_data, src_data, bytes, cudaMemcpyHostToDevice));
@@ -59,6 +71,10 @@ common::Status GPUDataTransfer::CopyTensorAsync(const Tensor& src, Tensor& dst,
 
   if (dst_device.Type() == OrtDevice::GPU) {
     if (src_device.Type() == OrtDevice::CPU) {
+      if (staging_pool_ && src_device.MemType() != OrtDevice::MemType::CUDA_PINNED) {
+        // copy from pageable memory to GPU through the pinned staging buffers, this is non-blocking once staged
+        return staging_pool_->CopyHostToDevice(dst_data, src_data, bytes, static_cast<cudaStream_t>(stream.GetHandle()));
+      }
       // copy from pinned memory to GPU, this is non-blocking
       CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(dst_data, src_data, bytes, cudaMemcpyHostToDevice, static_cast<cudaStream_t>(stream.GetHandle())));
     } else if (src_device.Type() == OrtDevice::GPU) {
@@ -69,6 +85,10 @@ common::Status GPUDataTransfer::CopyTensorAsync(const Tensor& src, Tensor& dst,
     }
   } else if (src_device.Type() == OrtDevice::GPU) {
     if (dst_device.Type() == OrtDevice::CPU) {
+      if (staging_pool_ && dst_device.MemType() != OrtDevice::MemType::CUDA_PINNED) {
+        // copying from GPU to pageable memory through the pinned staging buffers, this is blocking
+        return staging_pool_->CopyDeviceToHost(dst_data, src_data, bytes, static_cast<cudaStream_t>(stream.GetHandle()));
+      }
       // copying from GPU to pinned memory, this is non-blocking
       CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(dst_data, src_data, bytes, cudaMemcpyDeviceToHost, static_cast<cudaStream_t>(stream.GetHandle())));
     }
@@ -3,14 +3,22 @@
 
 #pragma once
 
+#include <memory>
+
 #include "cuda_pch.h"
 #include "core/framework/data_transfer.h"
 
 namespace onnxruntime {
 
+class PinnedStagingBufferPool;
+
 class GPUDataTransfer : public IDataTransfer {
  public:
   GPUDataTransfer();
+  // if use_pinned_staging_buffers is set, the async copies between pageable host memory and the GPU, and the
+  // blocking copies from pageable host memory to the GPU (e.g. of initializers), are staged in pinned buffers,
+  // see PinnedStagingBufferPool.
+  explicit GPUDataTransfer(bool use_pinned_staging_buffers);
   ~GPUDataTransfer();
 
   bool CanCopy(const OrtDevice& src_device, const OrtDevice& dst_device) const override;
@@ -19,6 +27,9 @@ class GPUDataTransfer : public IDataTransfer {
   using IDataTransfer::CopyTensor;
   common::Status CopyTensor(const Tensor& src, Tensor& dst) const override;
   common::Status CopyTensorAsync(const Tensor& src, Tensor& dst, Stream& stream) const override;
+
+ private:
+  std::unique_ptr<PinnedStagingBufferPool> staging_pool_;
 };
 
 }  // namespace onnxruntime
@@ -5,6 +5,7 @@
 #include "core/providers/cpu/math/gemm_helper.h"
 #include "core/providers/cuda/cuda_common.h"
 #include "core/providers/cuda/shared_inc/fpgeneric.h"
+#include "core/providers/cuda/tunable/gemm.h"
 
 namespace onnxruntime {
 namespace cuda {
@@ -124,23 +125,19 @@ Status Gemm<T>::ComputeInternal(OpKernelContext* ctx) const {
 
   CudaT alpha = ToCudaType<T>::FromFloat(alpha_);
   CudaT beta = ToCudaType<T>::FromFloat(beta_);
-  // Gemm, note that CUDA assumes col-major, so Y(N,M) = alpha * op(W) x op(X) + beta * Y
-  CUBLAS_RETURN_IF_ERROR(cublasGemmHelper(
-      GetCublasHandle(ctx),
-      trans_B_ ? CUBLAS_OP_T : CUBLAS_OP_N,
-      trans_A_ ? CUBLAS_OP_T : CUBLAS_OP_N,
-      N, M, K,
-      &alpha,
-      reinterpret_cast<const CudaT*>(W->Data<T>()),
-      (trans_B_ ? K : N),
-      reinterpret_cast<const CudaT*>(X->Data<T>()),
-      (trans_A_ ? M : K),
+  // Gemm, Y(M,N) = alpha * op(X) x op(W) + beta * Y
+  return tunable::blas::row_major::Gemm(
+      GetTuningContext(), Stream(ctx), GetCublasHandle(ctx), CublasLtHandle(), device_prop,
+      trans_A_ ? tunable::blas::BlasOp::T : tunable::blas::BlasOp::N,
+      trans_B_ ? tunable::blas::BlasOp::T : tunable::blas::BlasOp::N,
+      M, N, K,
+      alpha,
+      reinterpret_cast<const CudaT*>(X->Data<T>()), (trans_A_ ? M : K),
+      reinterpret_cast<const CudaT*>(W->Data<T>()), (trans_B_ ? K : N),
       // ideally we need to set the output buffer contents to 0 if bias is missing,
       // but passing 0 for beta is cheaper and it will ignore any junk in the output buffer
-      B != nullptr ? &beta : &zero,
-      out_data, N, device_prop));
-
-  return Status::OK();
+      B != nullptr ? beta : zero,
+      out_data, N);
 }
 
 }  // namespace cuda
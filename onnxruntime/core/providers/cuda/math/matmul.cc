@@ -5,6 +5,7 @@
 #include "core/providers/cpu/math/matmul_helper.h"
 #include "core/providers/cuda/shared_inc/fpgeneric.h"
 #include "core/providers/cuda/cuda_allocator.h"
+#include "core/providers/cuda/tunable/gemm.h"
 
 namespace onnxruntime {
 namespace cuda {
@@ -117,6 +118,7 @@ Status MatMul<T>::ComputeInternal(OpKernelContext* ctx) const {
   const CudaT alpha = ToCudaType<T>::FromFloat(alpha_);
   const CudaT zero = ToCudaType<T>::FromFloat(0.0f);
 
+  using tunable::blas::BlasOp;
   cublasOperation_t transA = transa ? CUBLAS_OP_T : CUBLAS_OP_N;
   cublasOperation_t transB = transb ? CUBLAS_OP_T : CUBLAS_OP_N;
   const int lda = helper.Lda(transa);
@@ -126,46 +128,29 @@ Status MatMul<T>::ComputeInternal(OpKernelContext* ctx) const {
   auto& device_prop = GetDeviceProp();
 
   if (helper.OutputOffsets().size() == 1) {
-    CUBLAS_RETURN_IF_ERROR(cublasGemmHelper(
-        GetCublasHandle(ctx),
-        transB,
-        transA,
-        static_cast<int>(helper.N()),
-        static_cast<int>(helper.M()),
-        static_cast<int>(helper.K()),
-        &alpha,
-        reinterpret_cast<const CudaT*>(right_X->Data<T>()),
-        ldb,
-        reinterpret_cast<const CudaT*>(left_X->Data<T>()),
-        lda,
-        &zero,
-        reinterpret_cast<CudaT*>(Y->MutableData<T>()),
-        ldc,
-        device_prop));
-    return Status::OK();
+    return tunable::blas::row_major::Gemm(
+        GetTuningContext(), Stream(ctx), GetCublasHandle(ctx), CublasLtHandle(), device_prop,
+        transa ? BlasOp::T : BlasOp::N,
+        transb ? BlasOp::T : BlasOp::N,
+        helper.M(), helper.N(), helper.K(),
+        alpha,
+        reinterpret_cast<const CudaT*>(left_X->Data<T>()), lda,
+        reinterpret_cast<const CudaT*>(right_X->Data<T>()), ldb,
+        zero,
+        reinterpret_cast<CudaT*>(Y->MutableData<T>()), ldc);
   } else if (CanUseStridedBatchedGemm(left_X->Shape(), right_X->Shape(),
                                       transa, transb, trans_batch_a_, trans_batch_b_, stride_A, stride_B, stride_C, batch_count)) {
-    CUBLAS_RETURN_IF_ERROR(cublasGemmStridedBatchedHelper(GetCublasHandle(ctx),
-                                                          transB,
-                                                          transA,
-                                                          static_cast<int>(helper.N()),
-                                                          static_cast<int>(helper.M()),
-                                                          static_cast<int>(helper.K()),
-                                                          &alpha,
-                                                          reinterpret_cast<const CudaT*>(right_X->Data<T>()),
-                                                          ldb,
-                                                          stride_B,
-                                                          reinterpret_cast<const CudaT*>(left_X->Data<T>()),
-                                                          lda,
-                                                          stride_A,
-                                                          &zero,
-                                                          reinterpret_cast<CudaT*>(Y->MutableData<T>()),
-                                                          ldc,
-                                                          stride_C,
-                                                          static_cast<int>(batch_count),
-                                                          device_prop));
-
-    return Status::OK();
+    return tunable::blas::row_major::StridedBatchedGemm(
+        GetTuningContext(), Stream(ctx), GetCublasHandle(ctx), CublasLtHandle(), device_prop,
+        transa ? BlasOp::T : BlasOp::N,
+        transb ? BlasOp::T : BlasOp::N,
+        helper.M(), helper.N(), helper.K(),
+        alpha,
+        reinterpret_cast<const CudaT*>(left_X->Data<T>()), lda, stride_A,
+        reinterpret_cast<const CudaT*>(right_X->Data<T>()), ldb, stride_B,
+        zero,
+        reinterpret_cast<CudaT*>(Y->MutableData<T>()), ldc, stride_C,
+        batch_count);
   }
 
   // Fill offsets when needed.
@@ -52,8 +52,8 @@ namespace cuda {
           .TypeConstraint("T2", DataTypeImpl::GetTensorType<T>()), \
       BatchNorm<T>);
 
-template <typename T>
-Status BatchNorm<T>::ComputeInternal(OpKernelContext* p_op_kernel_context) const {
+template <typename T, bool NHWC>
+Status BatchNorm<T, NHWC>::ComputeInternal(OpKernelContext* p_op_kernel_context) const {
   typedef typename ToCudaType<T>::MappedType CudaT;
 
   const Tensor* X = p_op_kernel_context->Input<Tensor>(0);
@@ -62,7 +62,7 @@ Status BatchNorm<T>::ComputeInternal(OpKernelContext* p_op_kernel_context) const
   const Tensor* mean = p_op_kernel_context->Input<Tensor>(3);
   const Tensor* var = p_op_kernel_context->Input<Tensor>(4);
 
-  ORT_RETURN_IF_ERROR(BatchNormHelper::ValidateInputs(X, scale, B, mean, var, spatial_ == 1));
+  ORT_RETURN_IF_ERROR(BatchNormHelper::ValidateInputs(X, scale, B, mean, var, spatial_ == 1, NHWC));
 
   const TensorShape& x_shape = X->Shape();
   const TensorShape& channel_shape = mean->Shape();
@@ -86,8 +86,8 @@ Status BatchNorm<T>::ComputeInternal(OpKernelContext* p_op_kernel_context) const
 
   CudnnTensor data_desc;
   vector<int64_t> new_dims;
-  BatchNormHelper::NormalizeDims(x_shape, new_dims);
-  ORT_RETURN_IF_ERROR(data_desc.Set(new_dims, CudnnTensor::GetDataType<CudaT>()));
+  BatchNormHelper::NormalizeDims(x_shape, new_dims, NHWC);
+  ORT_RETURN_IF_ERROR(data_desc.Set(new_dims, CudnnTensor::GetDataType<CudaT>(), NHWC));
 
   // For half data type, the alpha, beta, scale, B, mean, var need to be float type
   if (X->IsDataType<MLFloat16>()) {
@@ -97,7 +97,7 @@ Status BatchNorm<T>::ComputeInternal(OpKernelContext* p_op_kernel_context) const
     ORT_RETURN_IF_ERROR(bn_tensor_desc.Set(data_desc, cudnn_batch_norm_mode_));
 
     // Convert the scale, B, mean, var to float
-    const int64_t C = x_shape.GetDims()[1];
+    const int64_t C = new_dims[1];
     auto f_scale = GetScratchBuffer<float>(C, p_op_kernel_context->GetComputeStream());
     auto f_B = GetScratchBuffer<float>(C, p_op_kernel_context->GetComputeStream());
     auto f_mean = GetScratchBuffer<float>(C, p_op_kernel_context->GetComputeStream());
@@ -183,5 +183,44 @@ SPECIALIZED_COMPUTE(float)
 SPECIALIZED_COMPUTE(double)
 SPECIALIZED_COMPUTE(MLFloat16)
 
+#ifndef DISABLE_CONTRIB_OPS
+// BatchNormalization in the internal NHWC domain
+#define REGISTER_NHWC_KERNEL_TYPED(T)                              \
+  ONNX_OPERATOR_VERSIONED_TYPED_KERNEL_EX(                         \
+      BatchNormalization,                                          \
+      kMSInternalNHWCDomain,                                       \
+      9, 13,                                                       \
+      T,                                                           \
+      kCudaExecutionProvider,                                      \
+      (*KernelDefBuilder::Create())                                \
+          .TypeConstraint("T", DataTypeImpl::GetTensorType<T>()),  \
+      BatchNorm<T, true>);                                         \
+  ONNX_OPERATOR_VERSIONED_TYPED_KERNEL_EX(                         \
+      BatchNormalization,                                          \
+      kMSInternalNHWCDomain,                                       \
+      14, 14,                                                      \
+      T,                                                           \
+      kCudaExecutionProvider,                                      \
+      (*KernelDefBuilder::Create())                                \
+          .TypeConstraint("T", DataTypeImpl::GetTensorType<T>())   \
+          .TypeConstraint("U", DataTypeImpl::GetTensorType<T>()),  \
+      BatchNorm<T, true>);                                         \
+  ONNX_OPERATOR_TYPED_KERNEL_EX(                                   \
+      BatchNormalization,                                          \
+      kMSInternalNHWCDomain,                                       \
+      15,                                                          \
+      T,                                                           \
+      kCudaExecutionProvider,                                      \
+      (*KernelDefBuilder::Create())                                \
+          .TypeConstraint("T", DataTypeImpl::GetTensorType<T>())   \
+          .TypeConstraint("T1", DataTypeImpl::GetTensorType<T>())  \
+          .TypeConstraint("T2", DataTypeImpl::GetTensorType<T>()), \
+      BatchNorm<T, true>);                                         \
+  template Status BatchNorm<T, true>::ComputeInternal(OpKernelContext* ctx) const;
+
+REGISTER_NHWC_KERNEL_TYPED(float)
+REGISTER_NHWC_KERNEL_TYPED(MLFloat16)
+#endif
+
 }  // namespace cuda
 }  // namespace onnxruntime
@@ -9,7 +9,8 @@
 namespace onnxruntime {
 namespace cuda {
 
-template <typename T>
+// NHWC is used by BatchNormalization in the internal NHWC domain, with the channels as last dimension of X and Y.
+template <typename T, bool NHWC = false>
 class BatchNorm final : public CudaKernel {
  public:
   BatchNorm(const OpKernelInfo& op_kernel_info)
@@ -6,6 +6,7 @@
 #include "core/providers/cuda/cuda_common.h"
 #include "core/providers/cuda/shared_inc/fpgeneric.h"
 #include "core/providers/cuda/tensor/slice.h"
+#include "core/providers/cuda/tensor/transpose.h"
 
 namespace onnxruntime {
 namespace cuda {
@@ -86,6 +87,44 @@ Status SliceOutUnwantedOutputSection(cudaStream_t stream,
   return SliceCuda::Impl(stream, input_data, input_dims, output_data, compute_metadata, element_size);
 }
 
+template <typename T, bool NHWC>
+Status Conv<T, NHWC>::TransposeWeightsToNhwc(const Tensor& W, cudaStream_t stream, cublasHandle_t cublas_handle,
+                                             AllocatorPtr alloc) const {
+  const auto& w_shape = W.Shape();
+  const size_t rank = w_shape.NumDimensions();
+  InlinedVector<size_t> perm{0};
+  for (size_t i = 2; i < rank; ++i) {
+    perm.push_back(i);
+  }
+  perm.push_back(1);
+
+  TensorShapeVector nhwc_dims(rank);
+  for (size_t i = 0; i < rank; ++i) {
+    nhwc_dims[i] = w_shape[perm[i]];
+  }
+  if (!W_nhwc_ || W_nhwc_->Shape() != TensorShape(nhwc_dims)) {
+    W_nhwc_ = Tensor::Create(W.DataType(), TensorShape(nhwc_dims), std::move(alloc));
+  }
+
+  return Transpose::DoTranspose(GetDeviceProp(), stream, cublas_handle, perm, W, *W_nhwc_);
+}
+
+template <typename T, bool NHWC>
+Status Conv<T, NHWC>::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                              /*out*/ bool& is_packed,
+                              /*out*/ PrePackedWeights* /*prepacked_weights*/) {
+  is_packed = false;
+
+  if (is_nhwc_domain_ && input_idx == 1) {
+    ORT_RETURN_IF_ERROR(TransposeWeightsToNhwc(tensor, nullptr, DefaultCublasHandle(), std::move(alloc)));
+    CUDA_RETURN_IF_ERROR(cudaStreamSynchronize(nullptr));
+    W_prepacked_ = true;
+    is_packed = true;
+  }
+
+  return Status::OK();
+}
+
 template <typename T, bool NHWC>
 Status Conv<T, NHWC>::UpdateState(OpKernelContext* context, bool bias_expected) const {
   // set X
@@ -95,7 +134,17 @@ Status Conv<T, NHWC>::UpdateState(OpKernelContext* context, bool bias_expected)
   s_.x_data = reinterpret_cast<const CudaT*>(X->Data<T>());
   s_.element_size = X->DataType()->Size();
   // set W
-  const Tensor* W = context->Input<Tensor>(1);
+  const Tensor* W = nullptr;
+  if (W_prepacked_) {
+    W = W_nhwc_.get();
+  } else if (is_nhwc_domain_) {
+    ORT_RETURN_IF_ERROR(TransposeWeightsToNhwc(*context->Input<Tensor>(1), Stream(context),
+                                               GetCublasHandle(context),
+                                               Info().GetAllocator(OrtMemType::OrtMemTypeDefault)));
+    W = W_nhwc_.get();
+  } else {
+    W = context->Input<Tensor>(1);
+  }
   const TensorShape& w_shape = W->Shape();
   auto w_dims = w_shape.AsShapeVector();
   s_.w_data = reinterpret_cast<const CudaT*>(W->Data<T>());
@@ -475,6 +524,24 @@ Status CudnnConvolutionDescriptor::Set(
 // template instantiation for NhwcConv
 template class Conv<float, true>;
 template class Conv<MLFloat16, true>;
+
+// Conv in the internal NHWC domain
+ONNX_OPERATOR_TYPED_KERNEL_EX(
+    Conv,
+    kMSInternalNHWCDomain,
+    11,
+    float,
+    kCudaExecutionProvider,
+    (*KernelDefBuilder::Create()).TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    Conv<float, true>);
+ONNX_OPERATOR_TYPED_KERNEL_EX(
+    Conv,
+    kMSInternalNHWCDomain,
+    11,
+    MLFloat16,
+    kCudaExecutionProvider,
+    (*KernelDefBuilder::Create()).TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    Conv<MLFloat16, true>);
 #endif
 
 }  // namespace cuda
@@ -179,6 +179,8 @@ enum : size_t {
 
 // ONNX Conv operator uses NCHW format for input, weights and output.
 // NhwcConv contrib ops uses NHWC format: last dimension of input, weights and output are channels.
+// Conv in the internal NHWC domain, produced by the layout transformation, uses NHWC format for input and output, and
+// NCHW format for weights, which are transposed to NHWC when they are pre-packed or else on every run.
 template <typename T, bool NHWC>
 class Conv : public CudaKernel {
  public:
@@ -187,8 +189,13 @@ class Conv : public CudaKernel {
   Conv(const OpKernelInfo& info) : CudaKernel(info), conv_attrs_(info) {
     auto pads_size = conv_attrs_.pads.size();
     ORT_ENFORCE(pads_size % 2 == 0);
+    is_nhwc_domain_ = NHWC && info.node().Domain() == kMSInternalNHWCDomain;
   }
 
+  Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                 /*out*/ bool& is_packed,
+                 /*out*/ PrePackedWeights* prepacked_weights) override;
+
   Status ComputeInternal(OpKernelContext* context) const override;
 
  protected:
@@ -197,7 +204,16 @@ class Conv : public CudaKernel {
   }
 
   Status UpdateState(OpKernelContext* context, bool bias_expected = false) const;
+
+  // Transposes weights from {M, C/group, kH, kW} to {M, kH, kW, C/group}.
+  Status TransposeWeightsToNhwc(const Tensor& W, cudaStream_t stream, cublasHandle_t cublas_handle,
+                                AllocatorPtr alloc) const;
+
   ConvAttributes conv_attrs_;
+  bool is_nhwc_domain_ = false;
+  // the weights in NHWC format for the internal NHWC domain
+  mutable std::unique_ptr<Tensor> W_nhwc_;
+  bool W_prepacked_ = false;
   mutable CudnnConvState<cudnnConvolutionFwdAlgoPerf_t> s_;
   constexpr static auto kDefaultConvAlgo = CUDNN_CONVOLUTION_FWD_ALGO_IMPLICIT_PRECOMP_GEMM;
   static const cudnnConvolutionFwdAlgo_t kAllAlgos[];
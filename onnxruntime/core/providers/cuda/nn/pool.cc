@@ -1,6 +1,8 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
+
 #include "core/providers/shared_library/provider_api.h"
 #include "core/providers/cuda/nn/pool.h"
 #include "core/providers/cuda/cudnn_common.h"
@@ -93,6 +95,55 @@ POOLING_KERNEL(GlobalMaxPool, float, MaxPool<1>, 1)
 POOLING_KERNEL(GlobalMaxPool, double, MaxPool<1>, 1)
 POOLING_KERNEL(GlobalMaxPool, MLFloat16, MaxPool<1>, 1)
 
+#ifndef DISABLE_CONTRIB_OPS
+// Pooling in the internal NHWC domain
+#define POOLING_NHWC_KERNEL(op_name, data_type, pool_type, since_version)                          \
+  ONNX_OPERATOR_TYPED_KERNEL_EX(                                                                   \
+      op_name,                                                                                     \
+      kMSInternalNHWCDomain,                                                                       \
+      since_version,                                                                               \
+      data_type,                                                                                   \
+      kCudaExecutionProvider,                                                                      \
+      (*KernelDefBuilder::Create()).TypeConstraint("T", DataTypeImpl::GetTensorType<data_type>()), \
+      Pool<data_type, pool_type, true>);
+
+#define POOLING_NHWC_KERNEL_VERSIONED_WITH_INDICES(op_name, data_type, pool_type, since_version, end_version) \
+  ONNX_OPERATOR_VERSIONED_TYPED_KERNEL_EX(                                                                    \
+      op_name,                                                                                                \
+      kMSInternalNHWCDomain,                                                                                  \
+      since_version,                                                                                          \
+      end_version,                                                                                            \
+      data_type,                                                                                              \
+      kCudaExecutionProvider,                                                                                 \
+      (*KernelDefBuilder::Create())                                                                           \
+          .TypeConstraint("T", DataTypeImpl::GetTensorType<data_type>())                                      \
+          .TypeConstraint("I", DataTypeImpl::GetTensorType<int64_t>()),                                       \
+      Pool<data_type, pool_type, true>);
+
+#define POOLING_NHWC_KERNEL_WITH_INDICES(op_name, data_type, pool_type, since_version) \
+  ONNX_OPERATOR_TYPED_KERNEL_EX(                                                       \
+      op_name,                                                                         \
+      kMSInternalNHWCDomain,                                                           \
+      since_version,                                                                   \
+      data_type,                                                                       \
+      kCudaExecutionProvider,                                                          \
+      (*KernelDefBuilder::Create())                                                    \
+          .TypeConstraint("T", DataTypeImpl::GetTensorType<data_type>())               \
+          .TypeConstraint("I", DataTypeImpl::GetTensorType<int64_t>()),                \
+      Pool<data_type, pool_type, true>);
+
+POOLING_NHWC_KERNEL(AveragePool, float, AveragePool, 11)
+POOLING_NHWC_KERNEL(AveragePool, MLFloat16, AveragePool, 11)
+POOLING_NHWC_KERNEL(GlobalAveragePool, float, AveragePool, 1)
+POOLING_NHWC_KERNEL(GlobalAveragePool, MLFloat16, AveragePool, 1)
+POOLING_NHWC_KERNEL_VERSIONED_WITH_INDICES(MaxPool, float, MaxPool<8>, 11, 11)
+POOLING_NHWC_KERNEL_VERSIONED_WITH_INDICES(MaxPool, MLFloat16, MaxPool<8>, 11, 11)
+POOLING_NHWC_KERNEL_WITH_INDICES(MaxPool, float, MaxPool<8>, 12)
+POOLING_NHWC_KERNEL_WITH_INDICES(MaxPool, MLFloat16, MaxPool<8>, 12)
+POOLING_NHWC_KERNEL(GlobalMaxPool, float, MaxPool<1>, 1)
+POOLING_NHWC_KERNEL(GlobalMaxPool, MLFloat16, MaxPool<1>, 1)
+#endif
+
 class CudnnPoolingDescriptor final {
  public:
   CudnnPoolingDescriptor() : desc_(nullptr) {
@@ -146,17 +197,22 @@ class CudnnPoolingDescriptor final {
   cudnnPoolingDescriptor_t desc_;
 };
 
-template <typename T, typename PoolType>
-Status Pool<T, PoolType>::ComputeInternal(OpKernelContext* context) const {
+template <typename T, typename PoolType, bool NHWC>
+Status Pool<T, PoolType, NHWC>::ComputeInternal(OpKernelContext* context) const {
   typedef typename ToCudaType<T>::MappedType CudaT;
   const Tensor* X = context->Input<Tensor>(0);
   const TensorShape& x_shape = X->Shape();
-  const auto x_dims = x_shape.GetDims();
 
   if (x_shape.NumDimensions() < 3) {
     return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Input dimension cannot be less than 3.");
   }
 
+  // the pooling attributes and the cudnn descriptors use the NCHW order of the dims, with NHWC strides for NHWC.
+  TensorShapeVector x_dims(x_shape.GetDims().begin(), x_shape.GetDims().end());
+  if constexpr (NHWC) {
+    std::rotate(x_dims.begin() + 1, x_dims.end() - 1, x_dims.end());
+  }
+
   auto kernel_shape = pool_attrs_.kernel_shape;
   auto pads = pool_attrs_.pads;
   auto strides = pool_attrs_.strides;
@@ -167,8 +223,12 @@ Status Pool<T, PoolType>::ComputeInternal(OpKernelContext* context) const {
     strides.assign(kernel_shape.size(), 1);
   }
 
-  auto y_dims = pool_attrs_.SetOutputSize(x_shape, x_shape[1], &pads);
-  TensorShape y_shape(y_dims);
+  auto y_dims = pool_attrs_.SetOutputSize(TensorShape(x_dims), x_dims[1], &pads);
+  TensorShapeVector y_output_dims(y_dims);
+  if constexpr (NHWC) {
+    std::rotate(y_output_dims.begin() + 1, y_output_dims.begin() + 2, y_output_dims.end());
+  }
+  TensorShape y_shape(y_output_dims);
   Tensor* Y = context->Output(0, y_shape);
   // special case when there is a dim value of 0 in the shape.
   if (y_shape.Size() == 0)
@@ -203,8 +263,8 @@ Status Pool<T, PoolType>::ComputeInternal(OpKernelContext* context) const {
     const auto beta = Consts<float>::Zero;
     CudnnTensor x_tensor;
     CudnnTensor y_tensor;
-    ORT_RETURN_IF_ERROR(x_tensor.Set(x_dims_cudnn, CudnnTensor::GetDataType<float>()));
-    ORT_RETURN_IF_ERROR(y_tensor.Set(y_dims_cudnn, CudnnTensor::GetDataType<float>()));
+    ORT_RETURN_IF_ERROR(x_tensor.Set(x_dims_cudnn, CudnnTensor::GetDataType<float>(), NHWC));
+    ORT_RETURN_IF_ERROR(y_tensor.Set(y_dims_cudnn, CudnnTensor::GetDataType<float>(), NHWC));
 
     const auto input_count = x_shape.Size();
     const auto output_count = y_shape.Size();
@@ -219,8 +279,8 @@ Status Pool<T, PoolType>::ComputeInternal(OpKernelContext* context) const {
     const auto beta = Consts<CudaT>::Zero;
     CudnnTensor x_tensor;
     CudnnTensor y_tensor;
-    ORT_RETURN_IF_ERROR(x_tensor.Set(x_dims_cudnn, CudnnTensor::GetDataType<CudaT>()));
-    ORT_RETURN_IF_ERROR(y_tensor.Set(y_dims_cudnn, CudnnTensor::GetDataType<CudaT>()));
+    ORT_RETURN_IF_ERROR(x_tensor.Set(x_dims_cudnn, CudnnTensor::GetDataType<CudaT>(), NHWC));
+    ORT_RETURN_IF_ERROR(y_tensor.Set(y_dims_cudnn, CudnnTensor::GetDataType<CudaT>(), NHWC));
 
     CUDNN_RETURN_IF_ERROR(PoolingForwardHelper(GetCudnnHandle(context), pooling_desc, &alpha, x_tensor, x_data, &beta, y_tensor, y_data));
   }
@@ -228,56 +288,66 @@ Status Pool<T, PoolType>::ComputeInternal(OpKernelContext* context) const {
   return Status::OK();
 }
 
-template <typename T>
-Status Pool<T, MaxPool<8>>::ComputeInternal(OpKernelContext* context) const {
-  typedef typename ToCudaType<T>::MappedType CudaT;
-  const Tensor* X = context->Input<Tensor>(0);
-  const TensorShape& x_shape = X->Shape();
-  const auto& x_dims = x_shape.GetDims();
-
-  if (x_shape.NumDimensions() < 3) {
-    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Input dimension cannot be less than 3.");
-  }
+template <typename T, bool NHWC>
+Status Pool<T, MaxPool<8>, NHWC>::ComputeInternal(OpKernelContext* context) const {
+  if constexpr (NHWC) {
+    // MaxPoolWithIndex only supports NCHW. The layout transformation only converts MaxPool nodes without
+    // the indices output and with the default dilations, which are handled by the cudnn pooling.
+    if (context->OutputCount() > 1 || !this->pool_attrs_.default_dilations) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED,
+                             "NHWC MaxPool does not support the indices output or dilations.");
+    }
+    return Pool<T, MaxPool<1>, NHWC>::ComputeInternal(context);
+  } else {
+    typedef typename ToCudaType<T>::MappedType CudaT;
+    const Tensor* X = context->Input<Tensor>(0);
+    const TensorShape& x_shape = X->Shape();
+    const auto& x_dims = x_shape.GetDims();
 
-  auto kernel_shape = this->pool_attrs_.kernel_shape;
-  auto pads = this->pool_attrs_.pads;
-  auto strides = this->pool_attrs_.strides;
+    if (x_shape.NumDimensions() < 3) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Input dimension cannot be less than 3.");
+    }
 
-  if (this->pool_attrs_.global_pooling) {
-    kernel_shape.assign(x_dims.begin() + 2, x_dims.end());
-    pads.assign(kernel_shape.size(), 0);
-    strides.assign(kernel_shape.size(), 1);
-  }
+    auto kernel_shape = this->pool_attrs_.kernel_shape;
+    auto pads = this->pool_attrs_.pads;
+    auto strides = this->pool_attrs_.strides;
 
-  auto y_dims = this->pool_attrs_.SetOutputSize(x_shape, x_shape[1], &pads);
-  Tensor* Y = context->Output(0, TensorShape(y_dims));
+    if (this->pool_attrs_.global_pooling) {
+      kernel_shape.assign(x_dims.begin() + 2, x_dims.end());
+      pads.assign(kernel_shape.size(), 0);
+      strides.assign(kernel_shape.size(), 1);
+    }
 
-  // special case when there is a dim value of 0 in the shape.
-  if (Y->Shape().Size() == 0)
+    auto y_dims = this->pool_attrs_.SetOutputSize(x_shape, x_shape[1], &pads);
+    Tensor* Y = context->Output(0, TensorShape(y_dims));
+
+    // special case when there is a dim value of 0 in the shape.
+    if (Y->Shape().Size() == 0)
+      return Status::OK();
+
+    auto x_data = reinterpret_cast<const CudaT*>(X->Data<T>());
+    auto y_data = reinterpret_cast<CudaT*>(Y->MutableData<T>());
+
+    Tensor* I = context->Output(1, TensorShape(y_dims));
+    if (nullptr != I || !this->pool_attrs_.default_dilations) {
+      auto i_data = nullptr == I ? nullptr : I->MutableData<int64_t>();
+      MaxPoolWithIndex<CudaT>(
+          this->Stream(context),
+          x_shape,
+          TensorShape(y_dims),
+          kernel_shape,
+          strides,
+          pads,
+          this->pool_attrs_.dilations,
+          this->pool_attrs_.storage_order,
+          x_data,
+          y_data,
+          i_data);
+    } else {
+      ORT_RETURN_IF_ERROR((Pool<T, MaxPool<1>, NHWC>::ComputeInternal(context)));
+    }
     return Status::OK();
-
-  auto x_data = reinterpret_cast<const CudaT*>(X->Data<T>());
-  auto y_data = reinterpret_cast<CudaT*>(Y->MutableData<T>());
-
-  Tensor* I = context->Output(1, TensorShape(y_dims));
-  if (nullptr != I || !this->pool_attrs_.default_dilations) {
-    auto i_data = nullptr == I ? nullptr : I->MutableData<int64_t>();
-    MaxPoolWithIndex<CudaT>(
-        this->Stream(context),
-        x_shape,
-        TensorShape(y_dims),
-        kernel_shape,
-        strides,
-        pads,
-        this->pool_attrs_.dilations,
-        this->pool_attrs_.storage_order,
-        x_data,
-        y_data,
-        i_data);
-  } else {
-    ORT_RETURN_IF_ERROR((Pool<T, MaxPool<1>>::ComputeInternal(context)));
   }
-  return Status::OK();
 }
 
 }  // namespace cuda
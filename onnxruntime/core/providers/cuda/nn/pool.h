@@ -10,7 +10,8 @@
 namespace onnxruntime {
 namespace cuda {
 
-template <typename T, typename PoolType>
+// NHWC is used by the pooling ops in the internal NHWC domain, with the channels as last dimension of X and Y.
+template <typename T, typename PoolType, bool NHWC = false>
 class Pool : public CudaKernel, public PoolBase {
  public:
   Pool(const OpKernelInfo& info) : CudaKernel(info), PoolBase(info) {}
@@ -18,10 +19,10 @@ class Pool : public CudaKernel, public PoolBase {
   Status ComputeInternal(OpKernelContext* context) const override;
 };
 
-template <typename T>
-class Pool<T, MaxPool<8>> final : public Pool<T, MaxPool<1>> {
+template <typename T, bool NHWC>
+class Pool<T, MaxPool<8>, NHWC> final : public Pool<T, MaxPool<1>, NHWC> {
  public:
-  Pool(const OpKernelInfo& info) : Pool<T, MaxPool<1>>(info) {}
+  Pool(const OpKernelInfo& info) : Pool<T, MaxPool<1>, NHWC>(info) {}
 
   Status ComputeInternal(OpKernelContext* context) const override;
 };
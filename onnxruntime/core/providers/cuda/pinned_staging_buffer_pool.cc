@@ -0,0 +1,155 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/providers/shared_library/provider_api.h"
+#include "core/providers/cuda/pinned_staging_buffer_pool.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "core/providers/cuda/cuda_common.h"
+
+namespace onnxruntime {
+
+PinnedStagingBufferPool::~PinnedStagingBufferPool() {
+  // the pool may be destroyed while the process shuts down, so the errors are ignored
+  for (const auto& buffer : free_buffers_) {
+    cudaEventSynchronize(buffer.event);
+    cudaEventDestroy(buffer.event);
+    cudaFreeHost(buffer.data);
+  }
+}
+
+Status PinnedStagingBufferPool::Acquire(StagingBuffer& buffer) {
+  int device_id = 0;
+  CUDA_RETURN_IF_ERROR(cudaGetDevice(&device_id));
+  bool wait_for_dma = false;
+  {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    // prefer a buffer whose DMA completed, then a new buffer, then waiting for the DMA of a buffer
+    auto it = std::find_if(free_buffers_.begin(), free_buffers_.end(), [device_id](const StagingBuffer& b) {
+      return b.device_id == device_id && cudaEventQuery(b.event) == cudaSuccess;
+    });
+    if (it == free_buffers_.end() && num_buffers_ >= kMaxNumBuffers) {
+      it = std::find_if(free_buffers_.begin(), free_buffers_.end(),
+                        [device_id](const StagingBuffer& b) { return b.device_id == device_id; });
+      wait_for_dma = true;
+    }
+    if (it != free_buffers_.end()) {
+      buffer = *it;
+      free_buffers_.erase(it);
+    } else {
+      // all the buffers are used by concurrent copies, or by other devices
+      buffer = StagingBuffer{};
+      ++num_buffers_;
+    }
+  }
+
+  if (buffer.data != nullptr) {
+    if (wait_for_dma) {
+      CUDA_RETURN_IF_ERROR(cudaEventSynchronize(buffer.event));
+    }
+    return Status::OK();
+  }
+
+  buffer.device_id = device_id;
+  Status status = CUDA_CALL(cudaHostAlloc(&buffer.data, chunk_size_, cudaHostAllocPortable));
+  if (status.IsOK()) {
+    status = CUDA_CALL(cudaEventCreateWithFlags(&buffer.event, cudaEventDisableTiming));
+    if (!status.IsOK()) {
+      cudaFreeHost(buffer.data);
+    }
+  }
+  if (!status.IsOK()) {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    --num_buffers_;
+  }
+  return status;
+}
+
+Status PinnedStagingBufferPool::AcquireBuffers(size_t bytes, StagingBuffer* buffers, size_t& num_buffers) {
+  // a copy that fits in one chunk needs no double buffering
+  num_buffers = bytes > chunk_size_ ? 2 : 1;
+  for (size_t i = 0; i < num_buffers; ++i) {
+    Status status = Acquire(buffers[i]);
+    if (!status.IsOK()) {
+      ReleaseBuffers(buffers, i);
+      return status;
+    }
+  }
+  return Status::OK();
+}
+
+void PinnedStagingBufferPool::ReleaseBuffers(const StagingBuffer* buffers, size_t num_buffers) {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  free_buffers_.insert(free_buffers_.end(), buffers, buffers + num_buffers);
+}
+
+Status PinnedStagingBufferPool::CopyHostToDevice(void* dst, const void* src, size_t bytes, cudaStream_t stream) {
+  if (bytes == 0) {
+    return Status::OK();
+  }
+  StagingBuffer buffers[2];
+  size_t num_buffers = 0;
+  ORT_RETURN_IF_ERROR(AcquireBuffers(bytes, buffers, num_buffers));
+  Status status = StageHostToDevice(static_cast<char*>(dst), static_cast<const char*>(src), bytes, stream, buffers);
+  ReleaseBuffers(buffers, num_buffers);
+  return status;
+}
+
+Status PinnedStagingBufferPool::CopyDeviceToHost(void* dst, const void* src, size_t bytes, cudaStream_t stream) {
+  if (bytes == 0) {
+    return Status::OK();
+  }
+  StagingBuffer buffers[2];
+  size_t num_buffers = 0;
+  ORT_RETURN_IF_ERROR(AcquireBuffers(bytes, buffers, num_buffers));
+  Status status = StageDeviceToHost(static_cast<char*>(dst), static_cast<const char*>(src), bytes, stream, buffers);
+  ReleaseBuffers(buffers, num_buffers);
+  return status;
+}
+
+Status PinnedStagingBufferPool::StageHostToDevice(char* dst, const char* src, size_t bytes, cudaStream_t stream,
+                                                  StagingBuffer* buffers) {
+  for (size_t offset = 0, chunk = 0; offset < bytes; offset += chunk_size_, ++chunk) {
+    const size_t chunk_bytes = std::min(chunk_size_, bytes - offset);
+    StagingBuffer& buffer = buffers[chunk % 2];
+    // wait for the DMA of the chunk previously staged in the buffer, by this or an earlier copy
+    CUDA_RETURN_IF_ERROR(cudaEventSynchronize(buffer.event));
+    memcpy(buffer.data, src + offset, chunk_bytes);
+    CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(dst + offset, buffer.data, chunk_bytes, cudaMemcpyHostToDevice, stream));
+    CUDA_RETURN_IF_ERROR(cudaEventRecord(buffer.event, stream));
+  }
+  return Status::OK();
+}
+
+Status PinnedStagingBufferPool::StageDeviceToHost(char* dst, const char* src, size_t bytes, cudaStream_t stream,
+                                                  StagingBuffer* buffers) {
+  const size_t num_chunks = (bytes + chunk_size_ - 1) / chunk_size_;
+  auto enqueue_chunk = [&](size_t chunk) -> Status {
+    const size_t offset = chunk * chunk_size_;
+    const size_t chunk_bytes = std::min(chunk_size_, bytes - offset);
+    StagingBuffer& buffer = buffers[chunk % 2];
+    CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(buffer.data, src + offset, chunk_bytes, cudaMemcpyDeviceToHost, stream));
+    CUDA_RETURN_IF_ERROR(cudaEventRecord(buffer.event, stream));
+    return Status::OK();
+  };
+
+  // keep the DMA of the next chunk in flight while the current chunk is copied to the destination
+  for (size_t chunk = 0; chunk < std::min<size_t>(num_chunks, 2); ++chunk) {
+    ORT_RETURN_IF_ERROR(enqueue_chunk(chunk));
+  }
+  for (size_t chunk = 0; chunk < num_chunks; ++chunk) {
+    const size_t offset = chunk * chunk_size_;
+    const size_t chunk_bytes = std::min(chunk_size_, bytes - offset);
+    StagingBuffer& buffer = buffers[chunk % 2];
+    CUDA_RETURN_IF_ERROR(cudaEventSynchronize(buffer.event));
+    memcpy(dst + offset, buffer.data, chunk_bytes);
+    if (chunk + 2 < num_chunks) {
+      ORT_RETURN_IF_ERROR(enqueue_chunk(chunk + 2));
+    }
+  }
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,61 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <vector>
+
+#include "core/providers/cuda/cuda_pch.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+
+/**
+ * Pool of pinned host buffers to stage the copies between pageable host memory and GPU memory on a stream.
+ *
+ * cudaMemcpyAsync from or to pageable memory is synchronous with respect to the host, as the driver stages the data
+ * itself. Instead, a copy is split into chunks that alternate between two pinned buffers (double buffering), so the
+ * memcpy of a chunk on the host overlaps with the DMA of the previous chunk. A host to device copy returns once the
+ * last chunk is staged, so its DMA overlaps with the work enqueued after it on the stream. A device to host copy
+ * returns once the data arrived in the destination, like the copy it replaces.
+ *
+ * The buffers are reused across copies and released with the pool. A buffer is only reused once the DMA of its last
+ * chunk completed. Up to kMaxNumBuffers buffers are created before the copies wait for the DMA of a buffer to reuse it.
+ */
+class PinnedStagingBufferPool {
+ public:
+  static constexpr size_t kDefaultChunkSize = 4 * 1024 * 1024;
+  static constexpr size_t kMaxNumBuffers = 8;
+
+  explicit PinnedStagingBufferPool(size_t chunk_size = kDefaultChunkSize) : chunk_size_(chunk_size) {}
+  ~PinnedStagingBufferPool();
+
+  Status CopyHostToDevice(void* dst, const void* src, size_t bytes, cudaStream_t stream);
+  Status CopyDeviceToHost(void* dst, const void* src, size_t bytes, cudaStream_t stream);
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(PinnedStagingBufferPool);
+
+  struct StagingBuffer {
+    void* data{nullptr};
+    // recorded on the stream after the DMA of the last chunk staged in the buffer
+    cudaEvent_t event{nullptr};
+    // device of the event, which can only be recorded on the streams of that device
+    int device_id{-1};
+  };
+
+  Status Acquire(StagingBuffer& buffer);
+  Status AcquireBuffers(size_t bytes, StagingBuffer* buffers, size_t& num_buffers);
+  void ReleaseBuffers(const StagingBuffer* buffers, size_t num_buffers);
+
+  Status StageHostToDevice(char* dst, const char* src, size_t bytes, cudaStream_t stream, StagingBuffer* buffers);
+  Status StageDeviceToHost(char* dst, const char* src, size_t bytes, cudaStream_t stream, StagingBuffer* buffers);
+
+  const size_t chunk_size_;
+
+  OrtMutex mutex_;
+  std::vector<StagingBuffer> free_buffers_;
+  size_t num_buffers_{0};
+};
+
+}  // namespace onnxruntime
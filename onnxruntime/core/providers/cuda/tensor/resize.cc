@@ -47,5 +47,40 @@ REGISTER_KERNEL_TYPED(MLFloat16)
 REGISTER_KERNEL_TYPED(int32_t)
 REGISTER_KERNEL_TYPED(uint8_t)
 
+#ifndef DISABLE_CONTRIB_OPS
+// Resize in the internal NHWC domain. The nearest and linear modes support any input layout, as the scales of
+// the batch and the channels are 1.
+#define REGISTER_NHWC_KERNEL_TYPED(T)                              \
+  ONNX_OPERATOR_VERSIONED_TYPED_KERNEL_EX(                         \
+      Resize,                                                      \
+      kMSInternalNHWCDomain,                                       \
+      11, 12,                                                      \
+      T,                                                           \
+      kCudaExecutionProvider,                                      \
+      (*KernelDefBuilder::Create())                                \
+          .InputMemoryType(OrtMemTypeCPUInput, 1)                  \
+          .InputMemoryType(OrtMemTypeCPUInput, 2)                  \
+          .InputMemoryType(OrtMemTypeCPUInput, 3)                  \
+          .TypeConstraint("T1", DataTypeImpl::GetTensorType<T>()), \
+      Resize<T>);                                                  \
+  ONNX_OPERATOR_TYPED_KERNEL_EX(                                   \
+      Resize,                                                      \
+      kMSInternalNHWCDomain,                                       \
+      13,                                                          \
+      T,                                                           \
+      kCudaExecutionProvider,                                      \
+      (*KernelDefBuilder::Create())                                \
+          .InputMemoryType(OrtMemTypeCPUInput, 1)                  \
+          .InputMemoryType(OrtMemTypeCPUInput, 2)                  \
+          .InputMemoryType(OrtMemTypeCPUInput, 3)                  \
+          .TypeConstraint("T1", DataTypeImpl::GetTensorType<T>()), \
+      Resize<T>);
+
+REGISTER_NHWC_KERNEL_TYPED(float)
+REGISTER_NHWC_KERNEL_TYPED(MLFloat16)
+REGISTER_NHWC_KERNEL_TYPED(int32_t)
+REGISTER_NHWC_KERNEL_TYPED(uint8_t)
+#endif
+
 }  // namespace cuda
 }  // namespace onnxruntime
@@ -358,6 +358,52 @@ __global__ void _ResizeBilinearKernel(
       x11 * static_cast<T>(y_offset_0 * x_offset_0);
 }
 
+// The following method supports a 4-D input in 'Linear mode' with the channels as last dimension, [N, H, W, C].
+// the scale values for the batch and the channels are 1.
+template <typename T>
+__global__ void _ResizeBilinearNhwcKernel(
+    int64_t input_height, int64_t input_width, int64_t channels,
+    int64_t output_height,
+    fast_divmod div_output_image, fast_divmod div_output_row, fast_divmod div_channels,
+    const T* input_data, T* output_data, const size_t N,
+    const T extrapolation_value,
+    LinearMappingInfo* dims_mapping) {
+  CALCULATE_ELEMENTWISE_INDEX_OR_EXIT(id, N);
+  int batch, output_image_index;
+  div_output_image.divmod(id, batch, output_image_index);
+  int output_y, output_row_index;
+  div_output_row.divmod(output_image_index, output_y, output_row_index);
+  int output_x, c;
+  div_channels.divmod(output_row_index, output_x, c);
+
+  if (dims_mapping[output_y].extrapolate_ || dims_mapping[output_x + output_height].extrapolate_) {
+    output_data[id] = extrapolation_value;
+    return;
+  }
+  float y_offset_0 = dims_mapping[output_y].weight_;
+  int y_int = dims_mapping[output_y].origin_;
+  float x_offset_0 = dims_mapping[output_x + output_height].weight_;
+  int x_int = dims_mapping[output_x + output_height].origin_;
+  CUDA_LONG input_row_pitch = static_cast<CUDA_LONG>(input_width * channels);
+  CUDA_LONG input_index = (static_cast<CUDA_LONG>(batch * input_height + y_int) * input_width + x_int) * channels + c;
+
+  // neighbouring pixels are channels apart in a row, and rows are input_width * channels apart
+  T x00 = input_data[input_index];
+  bool end_of_h = (y_int >= input_height - 1);
+  bool end_of_w = (x_int >= input_width - 1);
+  T x10 = end_of_w ? x00 : input_data[input_index + channels];
+  T x01 = end_of_h ? x00 : input_data[input_index + input_row_pitch];
+  T x11 = end_of_w ? x01 : (end_of_h ? x10 : input_data[input_index + input_row_pitch + channels]);
+
+  float y_offset_1 = 1.0f - y_offset_0;
+  float x_offset_1 = 1.0f - x_offset_0;
+  output_data[id] =
+      x00 * static_cast<T>(y_offset_1 * x_offset_1) +
+      x01 * static_cast<T>(y_offset_0 * x_offset_1) +
+      x10 * static_cast<T>(y_offset_1 * x_offset_0) +
+      x11 * static_cast<T>(y_offset_0 * x_offset_0);
+}
+
 template <typename T, typename CudaFunctionOriginalCoordinate>
 __global__ void _ResizeTrilinearCoordinateMapping(
     int64_t input_depth, int64_t input_height, int64_t input_width,
@@ -581,7 +627,8 @@ size_t CalcResizeBufferSize(const onnxruntime::UpsampleMode upsample_mode,
     case UpsampleMode::NN:
       return sizeof(int64_t) * output_dims.size() + sizeof(NearestMappingInfo) * static_cast<size_t>(std::accumulate(output_dims.begin(), output_dims.end(), (int64_t)0));
     case UpsampleMode::LINEAR:
-      return sizeof(LinearMappingInfo) * static_cast<size_t>(std::accumulate(output_dims.rbegin(), output_dims.rbegin() + 2, (int64_t)0));
+      // the mapped dims are the last 2 or 3, or the middle 2 for a 4-D input with the channels as last dimension
+      return sizeof(LinearMappingInfo) * static_cast<size_t>(std::accumulate(output_dims.begin(), output_dims.end(), (int64_t)0));
     case UpsampleMode::CUBIC:
       return sizeof(CubicMappingInfo) * static_cast<size_t>(std::accumulate(output_dims.rbegin(), output_dims.rbegin() + 2, (int64_t)0));
   }
@@ -740,7 +787,29 @@ void ResizeImpl(
 
   switch (upsample_mode) {
     case UpsampleMode::LINEAR:
-      if (is_2D) {
+      if (rank == 4 && scales_vals[3] == 1.0f && scales_vals[1] != 1.0f) {
+        // [N, H, W, C] input, e.g. a Resize in the internal NHWC domain
+        int64_t output_height_nhwc = output_shape[1];
+        int64_t output_width_nhwc = output_shape[2];
+        int blocksPerNhwcMappingGrid = static_cast<int>(ceil((output_height_nhwc + output_width_nhwc) / 32.0));
+        DISPATCH_RESIZE_COORDINATE_TRANSFORMATION_MODE(coordinate_transform_mode, [&]() {
+          _ResizeBilinearCoordinateMapping<T><<<blocksPerNhwcMappingGrid, 32, 0, stream>>>(
+              input_shape[1], input_shape[2],
+              output_height_nhwc, output_width_nhwc,
+              scales_vals[1], scales_vals[2],
+              roi_vals[1], roi_vals[1 + rank],
+              roi_vals[2], roi_vals[2 + rank],
+              output_height_nhwc + output_width_nhwc, extrapolation_enabled, coord_t(),
+              reinterpret_cast<LinearMappingInfo*>(dims_mapping));
+        });
+        _ResizeBilinearNhwcKernel<T><<<blocksPerGrid, GridDim::maxThreadsPerBlock, 0, stream>>>(
+            input_shape[1], input_shape[2], input_shape[3],
+            output_height_nhwc,
+            output_div_pitches[0], output_div_pitches[1], output_div_pitches[2],
+            input_data, output_data, N, extrapolation_value,
+            reinterpret_cast<LinearMappingInfo*>(dims_mapping));
+        return;
+      } else if (is_2D) {
         DISPATCH_RESIZE_COORDINATE_TRANSFORMATION_MODE(coordinate_transform_mode, [&]() {
           _ResizeBilinearCoordinateMapping<T><<<blocksPerDimsMappingGrid, 32, 0, stream>>>(
               input_shape[rank - 2], input_shape[rank - 1],
@@ -0,0 +1,142 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#define _GEMM_H_KEEP_SIGNATURE_DEFINES
+#include "core/providers/cuda/tunable/gemm.h"
+
+#include "core/providers/cuda/tunable/gemm_cublas.h"
+#include "core/providers/cuda/tunable/gemm_tunable.cuh"
+
+namespace onnxruntime {
+namespace cuda {
+namespace tunable {
+namespace blas {
+
+namespace row_major {
+
+template <typename T>
+inline GEMM(T) {
+  GemmParams<T> params;
+  params.tuning_ctx = tuning_ctx;
+  params.stream = stream;
+  params.handle = handle;
+  params.lt_handle = lt_handle;
+  params.device_prop = &prop;
+
+  params.opa = opa;
+  params.opb = opb;
+  params.m = m;
+  params.n = n;
+  params.k = k;
+  params.alpha = alpha;
+  params.a = a;
+  params.lda = lda;
+  params.b = b;
+  params.ldb = ldb;
+  params.beta = beta;
+  params.c = c;
+  params.ldc = ldc;
+
+  if (tuning_ctx->IsTunableOpEnabled()) {
+    if (opa == BlasOp::N && opb == BlasOp::N) {
+      static internal::GemmTunableOp<T, internal::Row, internal::Row> gemm{};
+      return gemm(&params);
+    } else if (opa == BlasOp::T && opb == BlasOp::N) {
+      static internal::GemmTunableOp<T, internal::Col, internal::Row> gemm{};
+      return gemm(&params);
+    } else if (opa == BlasOp::N && opb == BlasOp::T) {
+      static internal::GemmTunableOp<T, internal::Row, internal::Col> gemm{};
+      return gemm(&params);
+    } else /*if (opa == BlasOp::T && opb == BlasOp::T)*/ {
+      static internal::GemmTunableOp<T, internal::Col, internal::Col> gemm{};
+      return gemm(&params);
+    }
+  }
+
+  return internal::CublasGemmOp(&params);
+}
+
+template <typename T>
+inline STRIDED_BATCHED_GEMM(T) {
+  StridedBatchedGemmParams<T> params;
+  params.tuning_ctx = tuning_ctx;
+  params.stream = stream;
+  params.handle = handle;
+  params.lt_handle = lt_handle;
+  params.device_prop = &prop;
+
+  params.opa = opa;
+  params.opb = opb;
+  params.m = m;
+  params.n = n;
+  params.k = k;
+  params.alpha = alpha;
+  params.a = a;
+  params.lda = lda;
+  params.stride_a = stride_a;
+  params.b = b;
+  params.ldb = ldb;
+  params.stride_b = stride_b;
+  params.beta = beta;
+  params.c = c;
+  params.ldc = ldc;
+  params.stride_c = stride_c;
+  params.batch = batch;
+
+  if (tuning_ctx->IsTunableOpEnabled()) {
+    if (opa == BlasOp::N && opb == BlasOp::N) {
+      static internal::StridedBatchedGemmTunableOp<T, internal::Row, internal::Row> gemm{};
+      return gemm(&params);
+    } else if (opa == BlasOp::T && opb == BlasOp::N) {
+      static internal::StridedBatchedGemmTunableOp<T, internal::Col, internal::Row> gemm{};
+      return gemm(&params);
+    } else if (opa == BlasOp::N && opb == BlasOp::T) {
+      static internal::StridedBatchedGemmTunableOp<T, internal::Row, internal::Col> gemm{};
+      return gemm(&params);
+    } else /*if (opa == BlasOp::T && opb == BlasOp::T)*/ {
+      static internal::StridedBatchedGemmTunableOp<T, internal::Col, internal::Col> gemm{};
+      return gemm(&params);
+    }
+  }
+
+  return internal::CublasStridedBatchedGemmOp(&params);
+}
+
+#define CALL_GEMM(T)                                   \
+  Gemm<T>(tuning_ctx, stream, handle, lt_handle, prop, \
+          opa, opb,                                    \
+          m, n, k,                                     \
+          alpha, a, lda, b, ldb,                       \
+          beta, c, ldc)
+
+#define CALL_STRIDED_BATCHED_GEMM(T)                           \
+  StridedBatchedGemm<T>(tuning_ctx, stream, handle, lt_handle, \
+                        prop, opa, opb,                        \
+                        m, n, k,                               \
+                        alpha,                                 \
+                        a, lda, stride_a,                      \
+                        b, ldb, stride_b,                      \
+                        beta, c, ldc, stride_c,                \
+                        batch)
+
+// clang-format off
+GEMM(double  ) { return CALL_GEMM(double  ); }
+GEMM(float   ) { return CALL_GEMM(float   ); }
+GEMM(half    ) { return CALL_GEMM(half    ); }
+GEMM(BFloat16) { return CALL_GEMM(BFloat16); }
+
+STRIDED_BATCHED_GEMM(double  ) { return CALL_STRIDED_BATCHED_GEMM(double  ); }
+STRIDED_BATCHED_GEMM(float   ) { return CALL_STRIDED_BATCHED_GEMM(float   ); }
+STRIDED_BATCHED_GEMM(half    ) { return CALL_STRIDED_BATCHED_GEMM(half    ); }
+STRIDED_BATCHED_GEMM(BFloat16) { return CALL_STRIDED_BATCHED_GEMM(BFloat16); }
+// clang-format on
+
+#undef CALL_GEMM
+#undef CALL_STRIDED_BATCHED_GEMM
+
+}  // namespace row_major
+
+}  // namespace blas
+}  // namespace tunable
+}  // namespace cuda
+}  // namespace onnxruntime
@@ -0,0 +1,62 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/status.h"
+#include "core/framework/float16.h"
+#include "core/providers/cuda/tunable/gemm_common.h"
+
+namespace onnxruntime {
+namespace cuda {
+namespace tunable {
+namespace blas {
+
+#define GEMM(T)                                                                      \
+  common::Status Gemm(                                                               \
+      CudaTuningContext* tuning_ctx, cudaStream_t stream,                            \
+      cublasHandle_t handle, cublasLtHandle_t lt_handle, const cudaDeviceProp& prop, \
+      BlasOp opa, BlasOp opb,                                                        \
+      std::int64_t m, std::int64_t n, std::int64_t k,                                \
+      T alpha, const T* a, std::int64_t lda, const T* b, std::int64_t ldb,           \
+      T beta, T* c, std::int64_t ldc)
+
+#define STRIDED_BATCHED_GEMM(T)                                                      \
+  common::Status StridedBatchedGemm(                                                 \
+      CudaTuningContext* tuning_ctx, cudaStream_t stream,                            \
+      cublasHandle_t handle, cublasLtHandle_t lt_handle, const cudaDeviceProp& prop, \
+      BlasOp opa, BlasOp opb,                                                        \
+      std::int64_t m, std::int64_t n, std::int64_t k,                                \
+      T alpha,                                                                       \
+      const T* a, std::int64_t lda, std::int64_t stride_a,                           \
+      const T* b, std::int64_t ldb, std::int64_t stride_b,                           \
+      T beta,                                                                        \
+      T* c, std::int64_t ldc, std::int64_t stride_c, std::int64_t batch)
+
+// Row-major GEMM, C = alpha op(A) op(B) + beta C. Without TunableOp enabled, these are the same calls to cuBLAS as
+// cublasGemmHelper and cublasGemmStridedBatchedHelper make. With TunableOp enabled, the fastest of the cuBLAS
+// algorithms, the cuBLASLt heuristics and the CUTLASS kernels is selected per problem size and is kept in the
+// TuningResults of the session.
+namespace row_major {
+
+GEMM(double);
+GEMM(float);
+GEMM(half);
+GEMM(BFloat16);
+
+STRIDED_BATCHED_GEMM(double);
+STRIDED_BATCHED_GEMM(float);
+STRIDED_BATCHED_GEMM(half);
+STRIDED_BATCHED_GEMM(BFloat16);
+
+}  // namespace row_major
+
+}  // namespace blas
+}  // namespace tunable
+}  // namespace cuda
+}  // namespace onnxruntime
+
+#ifndef _GEMM_H_KEEP_SIGNATURE_DEFINES
+#undef GEMM
+#undef STRIDED_BATCHED_GEMM
+#endif
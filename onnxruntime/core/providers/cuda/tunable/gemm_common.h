@@ -0,0 +1,146 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <string>
+
+#include "core/providers/cuda/cuda_common.h"
+#include "core/providers/cuda/tunable/cuda_tunable.h"
+
+namespace onnxruntime {
+namespace cuda {
+namespace tunable {
+namespace blas {
+
+enum class BlasOp {
+  N = 0,
+  T = 1,
+  NonTrans = 0,
+  Trans = 1,
+};
+
+inline std::string BlasOpToString(BlasOp op) {
+  switch (op) {
+    case BlasOp::N:
+      return "N";
+    case BlasOp::T:
+      return "T";
+    // following is unreachable, compiler is producing false-positive warning, unfortunately.
+    default:
+      ORT_THROW("unreachable");
+  }
+}
+
+inline cublasOperation_t ToCublasOp(BlasOp op) {
+  return op == BlasOp::N ? CUBLAS_OP_N : CUBLAS_OP_T;
+}
+
+namespace internal {
+
+// The layouts of the row-major A and B, Row for BlasOp::N and Col for BlasOp::T, to instantiate the kernels with
+// compile-time layouts for.
+struct Row {};
+struct Col {};
+
+// The data, compute and scale types of cublasGemmEx and cublasLtMatmul for a type. The half and bfloat16 GEMMs
+// accumulate in float, as cublasGemmHelper does by default.
+template <typename T>
+struct CublasGemmTypes;
+
+template <>
+struct CublasGemmTypes<double> {
+  using ScalarT = double;
+  static constexpr cudaDataType_t kDataType = CUDA_R_64F;
+  static constexpr cublasComputeType_t kComputeType = CUBLAS_COMPUTE_64F;
+  static constexpr cudaDataType_t kScaleType = CUDA_R_64F;
+  static ScalarT ToScalar(double v) { return v; }
+};
+
+template <>
+struct CublasGemmTypes<float> {
+  using ScalarT = float;
+  static constexpr cudaDataType_t kDataType = CUDA_R_32F;
+  static constexpr cublasComputeType_t kComputeType = CUBLAS_COMPUTE_32F;
+  static constexpr cudaDataType_t kScaleType = CUDA_R_32F;
+  static ScalarT ToScalar(float v) { return v; }
+};
+
+template <>
+struct CublasGemmTypes<half> {
+  using ScalarT = float;
+  static constexpr cudaDataType_t kDataType = CUDA_R_16F;
+  static constexpr cublasComputeType_t kComputeType = CUBLAS_COMPUTE_32F;
+  static constexpr cudaDataType_t kScaleType = CUDA_R_32F;
+  static ScalarT ToScalar(half v) { return math::halfToFloat(*reinterpret_cast<const uint16_t*>(&v)); }
+};
+
+template <>
+struct CublasGemmTypes<BFloat16> {
+  using ScalarT = float;
+  static constexpr cudaDataType_t kDataType = CUDA_R_16BF;
+  static constexpr cublasComputeType_t kComputeType = CUBLAS_COMPUTE_32F;
+  static constexpr cudaDataType_t kScaleType = CUDA_R_32F;
+  static ScalarT ToScalar(BFloat16 v) { return v.ToFloat(); }
+};
+
+}  // namespace internal
+
+// The params follow the row-major convention of the ROCm tunable GEMM, which is the native layout of numpy and
+// pytorch. The implementations backed by the column-major cuBLAS compute C^T = B^T A^T instead.
+template <typename T>
+struct GemmParams : tunable::OpParams {
+  std::string Signature() const override {
+    return MakeString(BlasOpToString(opa), BlasOpToString(opb), "_", m, "_", n, "_", k);
+  }
+
+  cublasHandle_t handle;
+  cublasLtHandle_t lt_handle;
+  const cudaDeviceProp* device_prop;
+  BlasOp opa;
+  BlasOp opb;
+  int64_t m;
+  int64_t n;
+  int64_t k;
+  T alpha;
+  const T* a;
+  int64_t lda;
+  const T* b;
+  int64_t ldb;
+  T beta;
+  T* c;
+  int64_t ldc;
+};
+
+template <typename T>
+struct StridedBatchedGemmParams : tunable::OpParams {
+  std::string Signature() const override {
+    return MakeString(BlasOpToString(opa), BlasOpToString(opb), "_", m, "_", n, "_", k, "_B", batch);
+  }
+
+  cublasHandle_t handle;
+  cublasLtHandle_t lt_handle;
+  const cudaDeviceProp* device_prop;
+  BlasOp opa;
+  BlasOp opb;
+  int64_t m;
+  int64_t n;
+  int64_t k;
+  T alpha;
+  const T* a;
+  int64_t lda;
+  int64_t stride_a;
+  const T* b;
+  int64_t ldb;
+  int64_t stride_b;
+  T beta;
+  T* c;
+  int64_t ldc;
+  int64_t stride_c;
+  int64_t batch;
+};
+
+}  // namespace blas
+}  // namespace tunable
+}  // namespace cuda
+}  // namespace onnxruntime
@@ -0,0 +1,125 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/common.h"
+#include "core/providers/cuda/shared_inc/fpgeneric.h"
+#include "core/providers/cuda/tunable/cuda_tunable.h"
+#include "core/providers/cuda/tunable/gemm_common.h"
+
+namespace onnxruntime {
+namespace cuda {
+namespace tunable {
+namespace blas {
+namespace internal {
+
+// The default implementations, the same calls to cuBLAS as outside of TunableOp.
+template <typename T>
+Status CublasGemmOp(const GemmParams<T>* params) {
+  // note that cublas is column major, so swap the row-major A and B
+  return CUBLAS_CALL(cublasGemmHelper(
+      params->handle,
+      ToCublasOp(params->opb), ToCublasOp(params->opa),
+      static_cast<int>(params->n), static_cast<int>(params->m), static_cast<int>(params->k),
+      &params->alpha,
+      params->b, static_cast<int>(params->ldb),
+      params->a, static_cast<int>(params->lda),
+      &params->beta,
+      params->c, static_cast<int>(params->ldc),
+      *params->device_prop));
+}
+
+template <typename T>
+Status CublasStridedBatchedGemmOp(const StridedBatchedGemmParams<T>* params) {
+  return CUBLAS_CALL(cublasGemmStridedBatchedHelper(
+      params->handle,
+      ToCublasOp(params->opb), ToCublasOp(params->opa),
+      static_cast<int>(params->n), static_cast<int>(params->m), static_cast<int>(params->k),
+      &params->alpha,
+      params->b, static_cast<int>(params->ldb), params->stride_b,
+      params->a, static_cast<int>(params->lda), params->stride_a,
+      &params->beta,
+      params->c, static_cast<int>(params->ldc), params->stride_c,
+      static_cast<int>(params->batch),
+      *params->device_prop));
+}
+
+// cublasGemmEx and cublasGemmStridedBatchedEx with an explicit algorithm. The algorithms are hints, cuBLAS may run
+// another algorithm for some of them, and return CUBLAS_STATUS_NOT_SUPPORTED for the ones it cannot run.
+template <typename T>
+class CublasGemmAlgoOp {
+ public:
+  explicit CublasGemmAlgoOp(cublasGemmAlgo_t algo) : algo_(algo) {}
+
+  Status operator()(const GemmParams<T>* params) {
+    using Types = CublasGemmTypes<T>;
+    const auto alpha = Types::ToScalar(params->alpha);
+    const auto beta = Types::ToScalar(params->beta);
+    return CheckStatus(cublasGemmEx(
+        params->handle,
+        ToCublasOp(params->opb), ToCublasOp(params->opa),
+        static_cast<int>(params->n), static_cast<int>(params->m), static_cast<int>(params->k),
+        &alpha,
+        params->b, Types::kDataType, static_cast<int>(params->ldb),
+        params->a, Types::kDataType, static_cast<int>(params->lda),
+        &beta,
+        params->c, Types::kDataType, static_cast<int>(params->ldc),
+        Types::kComputeType, algo_));
+  }
+
+  Status operator()(const StridedBatchedGemmParams<T>* params) {
+    using Types = CublasGemmTypes<T>;
+    const auto alpha = Types::ToScalar(params->alpha);
+    const auto beta = Types::ToScalar(params->beta);
+    return CheckStatus(cublasGemmStridedBatchedEx(
+        params->handle,
+        ToCublasOp(params->opb), ToCublasOp(params->opa),
+        static_cast<int>(params->n), static_cast<int>(params->m), static_cast<int>(params->k),
+        &alpha,
+        params->b, Types::kDataType, static_cast<int>(params->ldb), params->stride_b,
+        params->a, Types::kDataType, static_cast<int>(params->lda), params->stride_a,
+        &beta,
+        params->c, Types::kDataType, static_cast<int>(params->ldc), params->stride_c,
+        static_cast<int>(params->batch),
+        Types::kComputeType, algo_));
+  }
+
+ private:
+  Status CheckStatus(cublasStatus_t status) const {
+    TUNABLE_OP_RETURN_UNSUPPORTED_ARGUMENT_IF(status == CUBLAS_STATUS_NOT_SUPPORTED,
+                                              "cublas gemm algo ", static_cast<int>(algo_), " is not supported");
+    return CUBLAS_CALL(status);
+  }
+
+  cublasGemmAlgo_t algo_;
+};
+
+// Registers CublasGemmAlgoOp for the algorithms of cublasGemmEx: CUBLAS_GEMM_DEFAULT, CUBLAS_GEMM_ALGO0 to
+// CUBLAS_GEMM_ALGO23, CUBLAS_GEMM_DEFAULT_TENSOR_OP and CUBLAS_GEMM_ALGO0_TENSOR_OP to CUBLAS_GEMM_ALGO15_TENSOR_OP.
+template <typename ParamsT, typename T>
+class CublasGemmAlgoTunableOp : public TunableOp<ParamsT> {
+ public:
+  CublasGemmAlgoTunableOp() {
+    this->RegisterOp(CublasGemmAlgoOp<T>{CUBLAS_GEMM_DEFAULT});
+    for (int algo = CUBLAS_GEMM_ALGO0; algo <= CUBLAS_GEMM_ALGO23; ++algo) {
+      this->RegisterOp(CublasGemmAlgoOp<T>{static_cast<cublasGemmAlgo_t>(algo)});
+    }
+    this->RegisterOp(CublasGemmAlgoOp<T>{CUBLAS_GEMM_DEFAULT_TENSOR_OP});
+    for (int algo = CUBLAS_GEMM_ALGO0_TENSOR_OP; algo <= CUBLAS_GEMM_ALGO15_TENSOR_OP; ++algo) {
+      this->RegisterOp(CublasGemmAlgoOp<T>{static_cast<cublasGemmAlgo_t>(algo)});
+    }
+  }
+};
+
+template <typename T>
+using CublasGemmTunableOp = CublasGemmAlgoTunableOp<GemmParams<T>, T>;
+
+template <typename T>
+using CublasStridedBatchedGemmTunableOp = CublasGemmAlgoTunableOp<StridedBatchedGemmParams<T>, T>;
+
+}  // namespace internal
+}  // namespace blas
+}  // namespace tunable
+}  // namespace cuda
+}  // namespace onnxruntime
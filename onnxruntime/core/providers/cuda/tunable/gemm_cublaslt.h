@@ -0,0 +1,176 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/platform/ort_mutex.h"
+#include "core/providers/cuda/tunable/cuda_tunable.h"
+#include "core/providers/cuda/tunable/gemm_common.h"
+
+namespace onnxruntime {
+namespace cuda {
+namespace tunable {
+namespace blas {
+namespace internal {
+
+// The number of cuBLASLt heuristic results tried as candidates.
+constexpr int kNumCublasLtHeuristics = 8;
+
+// A column-major GEMM problem for cublasLtMatmul, D = alpha op(A) op(B) + beta C with D in place of C.
+struct CublasLtGemmProblem {
+  cublasOperation_t trans_a;
+  cublasOperation_t trans_b;
+  int64_t m;
+  int64_t n;
+  int64_t k;
+  int64_t lda;
+  int64_t stride_a;
+  int64_t ldb;
+  int64_t stride_b;
+  int64_t ldc;
+  int64_t stride_c;
+  int64_t batch;
+};
+
+// Owns the descriptors of a cublasLtMatmul call.
+class CublasLtMatmulDescriptors {
+ public:
+  CublasLtMatmulDescriptors(const CublasLtGemmProblem& problem, cublasComputeType_t compute_type,
+                            cudaDataType_t scale_type, cudaDataType_t data_type) {
+    CUBLAS_CALL_THROW(cublasLtMatmulDescCreate(&op_desc_, compute_type, scale_type));
+    CUBLAS_CALL_THROW(cublasLtMatmulDescSetAttribute(op_desc_, CUBLASLT_MATMUL_DESC_TRANSA,
+                                                     &problem.trans_a, sizeof(problem.trans_a)));
+    CUBLAS_CALL_THROW(cublasLtMatmulDescSetAttribute(op_desc_, CUBLASLT_MATMUL_DESC_TRANSB,
+                                                     &problem.trans_b, sizeof(problem.trans_b)));
+
+    const bool trans_a = problem.trans_a != CUBLAS_OP_N;
+    const bool trans_b = problem.trans_b != CUBLAS_OP_N;
+    a_desc_ = CreateLayout(data_type, trans_a ? problem.k : problem.m, trans_a ? problem.m : problem.k, problem.lda,
+                           problem.stride_a, problem.batch);
+    b_desc_ = CreateLayout(data_type, trans_b ? problem.n : problem.k, trans_b ? problem.k : problem.n, problem.ldb,
+                           problem.stride_b, problem.batch);
+    c_desc_ = CreateLayout(data_type, problem.m, problem.n, problem.ldc, problem.stride_c, problem.batch);
+
+    // the candidates run without a workspace, so that they can run with any stream and allocator
+    CUBLAS_CALL_THROW(cublasLtMatmulPreferenceCreate(&preference_));
+    const size_t workspace_size = 0;
+    CUBLAS_CALL_THROW(cublasLtMatmulPreferenceSetAttribute(preference_, CUBLASLT_MATMUL_PREF_MAX_WORKSPACE_BYTES,
+                                                           &workspace_size, sizeof(workspace_size)));
+  }
+
+  ~CublasLtMatmulDescriptors() {
+    cublasLtMatmulPreferenceDestroy(preference_);
+    cublasLtMatrixLayoutDestroy(c_desc_);
+    cublasLtMatrixLayoutDestroy(b_desc_);
+    cublasLtMatrixLayoutDestroy(a_desc_);
+    cublasLtMatmulDescDestroy(op_desc_);
+  }
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(CublasLtMatmulDescriptors);
+
+  cublasLtMatmulDesc_t op_desc_ = nullptr;
+  cublasLtMatrixLayout_t a_desc_ = nullptr;
+  cublasLtMatrixLayout_t b_desc_ = nullptr;
+  cublasLtMatrixLayout_t c_desc_ = nullptr;
+  cublasLtMatmulPreference_t preference_ = nullptr;
+
+ private:
+  static cublasLtMatrixLayout_t CreateLayout(cudaDataType_t data_type, int64_t rows, int64_t cols, int64_t ld,
+                                             int64_t stride, int64_t batch) {
+    cublasLtMatrixLayout_t layout = nullptr;
+    CUBLAS_CALL_THROW(cublasLtMatrixLayoutCreate(&layout, data_type, rows, cols, ld));
+    if (batch > 1) {
+      const int batch_count = static_cast<int>(batch);
+      CUBLAS_CALL_THROW(cublasLtMatrixLayoutSetAttribute(layout, CUBLASLT_MATRIX_LAYOUT_BATCH_COUNT,
+                                                         &batch_count, sizeof(batch_count)));
+      CUBLAS_CALL_THROW(cublasLtMatrixLayoutSetAttribute(layout, CUBLASLT_MATRIX_LAYOUT_STRIDED_BATCH_OFFSET,
+                                                         &stride, sizeof(stride)));
+    }
+    return layout;
+  }
+};
+
+// The heuristic results of cuBLASLt per params signature, shared by the candidates of a TunableOp, so that the
+// heuristic is queried once per problem. The results are in a deterministic order for a problem and a device, so the
+// index of a result identifies the same algorithm in the TuningResults of another session on the same device.
+class CublasLtHeuristicCache {
+ public:
+  const std::vector<cublasLtMatmulHeuristicResult_t>& Get(const std::string& signature, cublasLtHandle_t handle,
+                                                          const CublasLtMatmulDescriptors& descs) {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    auto it = results_.find(signature);
+    if (it == results_.end()) {
+      std::vector<cublasLtMatmulHeuristicResult_t> results(kNumCublasLtHeuristics);
+      int num_results = 0;
+      if (cublasLtMatmulAlgoGetHeuristic(handle, descs.op_desc_, descs.a_desc_, descs.b_desc_, descs.c_desc_,
+                                         descs.c_desc_, descs.preference_, kNumCublasLtHeuristics, results.data(),
+                                         &num_results) != CUBLAS_STATUS_SUCCESS) {
+        num_results = 0;
+      }
+      results.resize(num_results);
+      it = results_.emplace(signature, std::move(results)).first;
+    }
+    return it->second;
+  }
+
+ private:
+  OrtMutex mutex_;
+  std::unordered_map<std::string, std::vector<cublasLtMatmulHeuristicResult_t>> results_;
+};
+
+// cublasLtMatmul with the algorithm of the index-th heuristic result of cuBLASLt for the problem.
+template <typename T>
+class CublasLtGemmOp {
+ public:
+  CublasLtGemmOp(int index, std::shared_ptr<CublasLtHeuristicCache> cache) : index_(index), cache_(std::move(cache)) {}
+
+  Status operator()(const GemmParams<T>* params) {
+    // note that cublas is column major, so swap the row-major A and B
+    CublasLtGemmProblem problem{ToCublasOp(params->opb), ToCublasOp(params->opa),
+                                params->n, params->m, params->k,
+                                params->ldb, 0, params->lda, 0, params->ldc, 0, 1};
+    return Run(problem, params->Signature(), params->lt_handle, params->stream,
+               params->alpha, params->b, params->a, params->beta, params->c);
+  }
+
+  Status operator()(const StridedBatchedGemmParams<T>* params) {
+    CublasLtGemmProblem problem{ToCublasOp(params->opb), ToCublasOp(params->opa),
+                                params->n, params->m, params->k,
+                                params->ldb, params->stride_b, params->lda, params->stride_a,
+                                params->ldc, params->stride_c, params->batch};
+    return Run(problem, params->Signature(), params->lt_handle, params->stream,
+               params->alpha, params->b, params->a, params->beta, params->c);
+  }
+
+ private:
+  Status Run(const CublasLtGemmProblem& problem, const std::string& signature, cublasLtHandle_t handle,
+             cudaStream_t stream, T alpha, const T* a, const T* b, T beta, T* c) {
+    using Types = CublasGemmTypes<T>;
+    CublasLtMatmulDescriptors descs(problem, Types::kComputeType, Types::kScaleType, Types::kDataType);
+    const auto& heuristics = cache_->Get(signature, handle, descs);
+    TUNABLE_OP_RETURN_UNSUPPORTED_ARGUMENT_IF(index_ >= static_cast<int>(heuristics.size()),
+                                              "cublasLt has no heuristic result ", index_, " for ", signature);
+
+    const auto scalar_alpha = Types::ToScalar(alpha);
+    const auto scalar_beta = Types::ToScalar(beta);
+    return CUBLAS_CALL(cublasLtMatmul(handle, descs.op_desc_,
+                                      &scalar_alpha, a, descs.a_desc_, b, descs.b_desc_,
+                                      &scalar_beta, c, descs.c_desc_, c, descs.c_desc_,
+                                      &heuristics[index_].algo, nullptr, 0, stream));
+  }
+
+  int index_;
+  std::shared_ptr<CublasLtHeuristicCache> cache_;
+};
+
+}  // namespace internal
+}  // namespace blas
+}  // namespace tunable
+}  // namespace cuda
+}  // namespace onnxruntime
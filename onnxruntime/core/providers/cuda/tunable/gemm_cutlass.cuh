@@ -0,0 +1,165 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// CUTLASS is fetched by the builds with the memory efficient attention, which is built with it.
+#if USE_FLASH_ATTENTION
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-parameter"
+#pragma GCC diagnostic ignored "-Wstrict-aliasing"
+#endif
+
+#include "cutlass/gemm/device/gemm.h"
+#include "cutlass/gemm/device/gemm_batched.h"
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+#include "core/providers/cuda/tunable/cuda_tunable.h"
+#include "core/providers/cuda/tunable/gemm_common.h"
+
+namespace onnxruntime {
+namespace cuda {
+namespace tunable {
+namespace blas {
+namespace internal {
+
+template <typename Layout>
+struct CutlassLayout;
+
+template <>
+struct CutlassLayout<Row> {
+  using type = cutlass::layout::RowMajor;
+};
+
+template <>
+struct CutlassLayout<Col> {
+  using type = cutlass::layout::ColumnMajor;
+};
+
+// The half GEMM kernels of CUTLASS for the tensor cores of sm80 and later, accumulating in float. The kernels access
+// 8 halfs at once, so the dimensions, the leading dimensions, the strides and the pointers must be aligned to them.
+template <typename ALayout, typename BLayout, typename ThreadblockShape, typename WarpShape, int Stages>
+struct CutlassGemmKernels {
+  static constexpr int kAlignment = 8;
+
+  using EpilogueOp = cutlass::epilogue::thread::LinearCombination<cutlass::half_t, kAlignment, float, float>;
+
+  using Gemm = cutlass::gemm::device::Gemm<
+      cutlass::half_t, typename CutlassLayout<ALayout>::type,
+      cutlass::half_t, typename CutlassLayout<BLayout>::type,
+      cutlass::half_t, cutlass::layout::RowMajor,
+      float, cutlass::arch::OpClassTensorOp, cutlass::arch::Sm80,
+      ThreadblockShape, WarpShape, cutlass::gemm::GemmShape<16, 8, 16>,
+      EpilogueOp, cutlass::gemm::threadblock::GemmIdentityThreadblockSwizzle<>, Stages>;
+
+  using GemmBatched = cutlass::gemm::device::GemmBatched<
+      cutlass::half_t, typename CutlassLayout<ALayout>::type,
+      cutlass::half_t, typename CutlassLayout<BLayout>::type,
+      cutlass::half_t, cutlass::layout::RowMajor,
+      float, cutlass::arch::OpClassTensorOp, cutlass::arch::Sm80,
+      ThreadblockShape, WarpShape, cutlass::gemm::GemmShape<16, 8, 16>,
+      EpilogueOp, cutlass::gemm::threadblock::GemmBatchedIdentityThreadblockSwizzle, Stages>;
+};
+
+inline bool IsCutlassAligned(int64_t value) {
+  return value % 8 == 0;
+}
+
+inline bool IsCutlassAligned(const void* ptr) {
+  return reinterpret_cast<uintptr_t>(ptr) % 16 == 0;
+}
+
+template <typename ParamsT>
+Status CheckCutlassGemmSupported(const ParamsT* params) {
+  TUNABLE_OP_RETURN_UNSUPPORTED_ARGUMENT_IF(params->device_prop->major < 8, "CUTLASS gemm requires sm80 or later");
+  TUNABLE_OP_RETURN_UNSUPPORTED_ARGUMENT_IF(
+      !IsCutlassAligned(params->m) || !IsCutlassAligned(params->n) || !IsCutlassAligned(params->k) ||
+          !IsCutlassAligned(params->lda) || !IsCutlassAligned(params->ldb) || !IsCutlassAligned(params->ldc) ||
+          !IsCutlassAligned(params->a) || !IsCutlassAligned(params->b) || !IsCutlassAligned(params->c),
+      "CUTLASS gemm requires the dimensions and the pointers aligned to 8 halfs");
+  return Status::OK();
+}
+
+template <typename Kernels>
+class CutlassGemmOp {
+ public:
+  Status operator()(const GemmParams<half>* params) {
+    ORT_RETURN_IF_ERROR(CheckCutlassGemmSupported(params));
+
+    using Gemm = typename Kernels::Gemm;
+    const auto* a = reinterpret_cast<const cutlass::half_t*>(params->a);
+    const auto* b = reinterpret_cast<const cutlass::half_t*>(params->b);
+    auto* c = reinterpret_cast<cutlass::half_t*>(params->c);
+    typename Gemm::Arguments args(
+        {static_cast<int>(params->m), static_cast<int>(params->n), static_cast<int>(params->k)},
+        {a, params->lda}, {b, params->ldb}, {c, params->ldc}, {c, params->ldc},
+        {CublasGemmTypes<half>::ToScalar(params->alpha), CublasGemmTypes<half>::ToScalar(params->beta)});
+
+    Gemm gemm;
+    TUNABLE_OP_RETURN_UNSUPPORTED_ARGUMENT_IF(gemm.can_implement(args) != cutlass::Status::kSuccess,
+                                              "CUTLASS gemm cannot implement the problem");
+    ORT_RETURN_IF(gemm(args, nullptr, params->stream) != cutlass::Status::kSuccess, "CUTLASS gemm failed");
+    return CUDA_CALL(cudaGetLastError());
+  }
+
+  Status operator()(const StridedBatchedGemmParams<half>* params) {
+    ORT_RETURN_IF_ERROR(CheckCutlassGemmSupported(params));
+    TUNABLE_OP_RETURN_UNSUPPORTED_ARGUMENT_IF(
+        !IsCutlassAligned(params->stride_a) || !IsCutlassAligned(params->stride_b) ||
+            !IsCutlassAligned(params->stride_c),
+        "CUTLASS gemm requires the strides aligned to 8 halfs");
+
+    using GemmBatched = typename Kernels::GemmBatched;
+    const auto* a = reinterpret_cast<const cutlass::half_t*>(params->a);
+    const auto* b = reinterpret_cast<const cutlass::half_t*>(params->b);
+    auto* c = reinterpret_cast<cutlass::half_t*>(params->c);
+    typename GemmBatched::Arguments args(
+        {static_cast<int>(params->m), static_cast<int>(params->n), static_cast<int>(params->k)},
+        {a, params->lda}, params->stride_a,
+        {b, params->ldb}, params->stride_b,
+        {c, params->ldc}, params->stride_c,
+        {c, params->ldc}, params->stride_c,
+        {CublasGemmTypes<half>::ToScalar(params->alpha), CublasGemmTypes<half>::ToScalar(params->beta)},
+        static_cast<int>(params->batch));
+
+    GemmBatched gemm;
+    TUNABLE_OP_RETURN_UNSUPPORTED_ARGUMENT_IF(gemm.can_implement(args) != cutlass::Status::kSuccess,
+                                              "CUTLASS batched gemm cannot implement the problem");
+    ORT_RETURN_IF(gemm(args, nullptr, params->stream) != cutlass::Status::kSuccess, "CUTLASS batched gemm failed");
+    return CUDA_CALL(cudaGetLastError());
+  }
+};
+
+template <typename ALayout, typename BLayout, int TileM, int TileN, int WarpM, int WarpN, int Stages>
+using CutlassGemmOpWithTile = CutlassGemmOp<CutlassGemmKernels<ALayout, BLayout,
+                                                               cutlass::gemm::GemmShape<TileM, TileN, 32>,
+                                                               cutlass::gemm::GemmShape<WarpM, WarpN, 32>, Stages>>;
+
+// The candidate tile configurations, from large problems to small ones.
+template <typename ParamsT, typename ALayout, typename BLayout>
+std::vector<Op<ParamsT>> GetCutlassGemmOps() {
+  std::vector<Op<ParamsT>> ops;
+  ops.emplace_back(CutlassGemmOpWithTile<ALayout, BLayout, 128, 256, 64, 64, 3>{});
+  ops.emplace_back(CutlassGemmOpWithTile<ALayout, BLayout, 256, 128, 64, 64, 3>{});
+  ops.emplace_back(CutlassGemmOpWithTile<ALayout, BLayout, 128, 128, 64, 64, 4>{});
+  ops.emplace_back(CutlassGemmOpWithTile<ALayout, BLayout, 128, 64, 64, 32, 4>{});
+  ops.emplace_back(CutlassGemmOpWithTile<ALayout, BLayout, 64, 64, 32, 32, 5>{});
+  return ops;
+}
+
+}  // namespace internal
+}  // namespace blas
+}  // namespace tunable
+}  // namespace cuda
+}  // namespace onnxruntime
+
+#endif  // USE_FLASH_ATTENTION
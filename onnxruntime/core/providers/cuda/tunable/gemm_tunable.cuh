@@ -0,0 +1,124 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "core/providers/cuda/tunable/cuda_tunable.h"
+#include "core/providers/cuda/tunable/gemm_common.h"
+#include "core/providers/cuda/tunable/gemm_cublas.h"
+#include "core/providers/cuda/tunable/gemm_cublaslt.h"
+#include "core/providers/cuda/tunable/gemm_cutlass.cuh"
+
+namespace onnxruntime {
+namespace cuda {
+namespace tunable {
+namespace blas {
+namespace internal {
+
+template <typename T>
+bool IsZero(T v) {
+  return CublasGemmTypes<T>::ToScalar(v) == 0;
+}
+
+// The candidates of the ops are registered in a fixed order, so that the ids in the TuningResults of a session stay
+// valid for another session with the same build.
+template <typename T, typename ALayout, typename BLayout>
+class GemmTunableOp : public TunableOp<GemmParams<T>> {
+ public:
+  GemmTunableOp() {
+    this->RegisterOp(CublasGemmOp<T>);
+
+    this->RegisterNestedTunableOp(&cublas_gemm_tunable_op_);
+
+    auto heuristic_cache = std::make_shared<CublasLtHeuristicCache>();
+    for (int i = 0; i < kNumCublasLtHeuristics; ++i) {
+      this->RegisterOp(CublasLtGemmOp<T>{i, heuristic_cache});
+    }
+
+#if USE_FLASH_ATTENTION
+    if constexpr (std::is_same_v<T, half>) {
+      for (auto&& op : GetCutlassGemmOps<GemmParams<T>, ALayout, BLayout>()) {
+        this->RegisterOp(std::move(op));
+      }
+    }
+#endif
+  }
+
+  const GemmParams<T>* PreTuning(const GemmParams<T>* params) override {
+    if (!IsZero(params->beta)) {
+      // When beta != 0, C buffer is used as an input as well as an output. We need to create a proxy params for the
+      // tuning process, so that the tuning does not accumulate into the C buffer. See the ROCm GemmTunableOp.
+      GemmParams<T>* proxy = new GemmParams<T>();
+      *proxy = *params;
+      CUDA_CALL_THROW(cudaMalloc(&(proxy->c), proxy->m * proxy->ldc * sizeof(T)));
+      return proxy;
+    }
+
+    return params;
+  }
+
+  void PostTuning(const GemmParams<T>* params) override {
+    if (!IsZero(params->beta)) {
+      CUDA_CALL_THROW(cudaFree(params->c));
+      delete params;
+    }
+  }
+
+ private:
+  CublasGemmTunableOp<T> cublas_gemm_tunable_op_;
+};
+
+template <typename T, typename ALayout, typename BLayout>
+class StridedBatchedGemmTunableOp : public TunableOp<StridedBatchedGemmParams<T>> {
+ public:
+  StridedBatchedGemmTunableOp() {
+    this->RegisterOp(CublasStridedBatchedGemmOp<T>);
+
+    this->RegisterNestedTunableOp(&cublas_strided_batched_gemm_tunable_op_);
+
+    auto heuristic_cache = std::make_shared<CublasLtHeuristicCache>();
+    for (int i = 0; i < kNumCublasLtHeuristics; ++i) {
+      this->RegisterOp(CublasLtGemmOp<T>{i, heuristic_cache});
+    }
+
+#if USE_FLASH_ATTENTION
+    if constexpr (std::is_same_v<T, half>) {
+      for (auto&& op : GetCutlassGemmOps<StridedBatchedGemmParams<T>, ALayout, BLayout>()) {
+        this->RegisterOp(std::move(op));
+      }
+    }
+#endif
+  }
+
+  const StridedBatchedGemmParams<T>* PreTuning(const StridedBatchedGemmParams<T>* params) override {
+    if (!IsZero(params->beta)) {
+      // See GemmTunableOp<T>::PreTuning for more details
+      StridedBatchedGemmParams<T>* proxy = new StridedBatchedGemmParams<T>();
+      *proxy = *params;
+      CUDA_CALL_THROW(cudaMalloc(&(proxy->c), proxy->batch * proxy->stride_c * sizeof(T)));
+      return proxy;
+    }
+
+    return params;
+  }
+
+  void PostTuning(const StridedBatchedGemmParams<T>* params) override {
+    if (!IsZero(params->beta)) {
+      CUDA_CALL_THROW(cudaFree(params->c));
+      delete params;
+    }
+  }
+
+ private:
+  CublasStridedBatchedGemmTunableOp<T> cublas_strided_batched_gemm_tunable_op_;
+};
+
+}  // namespace internal
+}  // namespace blas
+}  // namespace tunable
+}  // namespace cuda
+}  // namespace onnxruntime
@@ -3,6 +3,9 @@
 
 #include "precomp.h"
 
+#include <map>
+#include <tuple>
+
 #include "core/session/onnxruntime_c_api.h"
 
 #include "BucketizedBufferAllocator.h"
@@ -19,8 +22,132 @@ namespace Dml
         }
     }
 
+    /*static*/ std::shared_ptr<SharedBufferPool> SharedBufferPool::Get(
+        ID3D12Device* device,
+        const D3D12_HEAP_PROPERTIES& heapProps,
+        D3D12_HEAP_FLAGS heapFlags,
+        D3D12_RESOURCE_FLAGS resourceFlags,
+        D3D12_RESOURCE_STATES initialState)
+    {
+        using PoolKey = std::tuple<
+            ID3D12Device*,
+            D3D12_HEAP_TYPE,
+            D3D12_CPU_PAGE_PROPERTY,
+            D3D12_MEMORY_POOL,
+            UINT,
+            UINT,
+            D3D12_HEAP_FLAGS,
+            D3D12_RESOURCE_FLAGS,
+            D3D12_RESOURCE_STATES>;
+
+        // The pools are only referenced weakly, so that their buffers are released with the last allocator using them
+        static std::mutex s_mutex;
+        static std::map<PoolKey, std::weak_ptr<SharedBufferPool>> s_pools;
+
+        const PoolKey key(
+            device,
+            heapProps.Type,
+            heapProps.CPUPageProperty,
+            heapProps.MemoryPoolPreference,
+            heapProps.CreationNodeMask,
+            heapProps.VisibleNodeMask,
+            heapFlags,
+            resourceFlags,
+            initialState);
+
+        std::lock_guard<std::mutex> lock(s_mutex);
+        std::shared_ptr<SharedBufferPool> pool = s_pools[key].lock();
+        if (!pool)
+        {
+            // The device may be a new one reusing the address of a destroyed device, whose pool is gone
+            pool = std::make_shared<SharedBufferPool>();
+            s_pools[key] = pool;
+        }
+
+        for (auto it = s_pools.begin(); it != s_pools.end();)
+        {
+            it = it->second.expired() ? s_pools.erase(it) : std::next(it);
+        }
+
+        return pool;
+    }
+
+    bool SharedBufferPool::TryTake(
+        gsl::index bucketIndex,
+        const std::shared_ptr<ExecutionContext>& context,
+        ComPtr<DmlResourceWrapper>& resource,
+        uint64_t& resourceId)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (gsl::narrow_cast<gsl::index>(m_buckets.size()) <= bucketIndex)
+        {
+            return false;
+        }
+
+        // Prefer the most recently freed buffers
+        auto& bucket = m_buckets[bucketIndex];
+        for (auto it = bucket.rbegin(); it != bucket.rend(); ++it)
+        {
+            // The work queued on the same context is ordered with the work using the buffer next. A destroyed
+            // context has waited for its work, or discarded it.
+            std::shared_ptr<ExecutionContext> freeingContext = it->context.lock();
+            const bool usable =
+                freeingContext == nullptr ||
+                freeingContext == context ||
+                !it->releaseEvent ||
+                it->releaseEvent->IsSignaled();
+
+            if (usable)
+            {
+                resource = std::move(it->resource);
+                resourceId = it->resourceId;
+                bucket.erase(std::next(it).base());
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void SharedBufferPool::Return(
+        gsl::index bucketIndex,
+        const BucketizedBufferAllocator* owner,
+        const std::shared_ptr<ExecutionContext>& context,
+        ComPtr<DmlResourceWrapper>&& resource,
+        uint64_t resourceId)
+    {
+        FreeResource freeResource = {std::move(resource), resourceId, owner, context, std::nullopt};
+        if (!context->IsClosed())
+        {
+            freeResource.releaseEvent = context->GetCurrentCompletionEvent();
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (gsl::narrow_cast<gsl::index>(m_buckets.size()) <= bucketIndex)
+        {
+            // Ensure there are sufficient buckets
+            m_buckets.resize(bucketIndex + 1);
+        }
+
+        m_buckets[bucketIndex].push_back(std::move(freeResource));
+    }
+
+    void SharedBufferPool::ReleaseResourcesOf(const BucketizedBufferAllocator* owner)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto& bucket : m_buckets)
+        {
+            bucket.erase(
+                std::remove_if(bucket.begin(), bucket.end(), [owner](const FreeResource& r) { return r.owner == owner; }),
+                bucket.end());
+        }
+    }
+
     BucketizedBufferAllocator::~BucketizedBufferAllocator()
     {
+        // Keep the memory footprint of a session bounded by its lifetime, as without the shared pool
+        m_pool->ReleaseResourcesOf(this);
+
 #ifdef PRINT_OUTSTANDING_ALLOCATIONS
         if (!m_outstandingAllocationsById.empty())
         {
@@ -56,7 +183,8 @@ namespace Dml
         m_resourceFlags(resourceFlags),
         m_initialState(initialState),
         m_context(context),
-        m_subAllocator(std::move(subAllocator))
+        m_subAllocator(std::move(subAllocator)),
+        m_pool(SharedBufferPool::Get(device, heapProps, heapFlags, resourceFlags, initialState))
     {
     }
 
@@ -64,20 +192,33 @@ namespace Dml
     {
         assert(size != 0);
 
-        // Each bucket is twice as large as the previous one, in ascending order
-        gsl::index index = static_cast<gsl::index>(ceil(log2(size)));
-        assert((1ull << index) >= size); // This must be true unless there were some strange rounding issues
-
         // The smallest bucket is 2^n bytes large, where n = c_minResourceSizeExponent
-        index = std::max<gsl::index>(index, c_minResourceSizeExponent);
-        index -= c_minResourceSizeExponent;
+        if (size <= (1ull << c_minResourceSizeExponent))
+        {
+            return 0;
+        }
+
+        // Find the power of two below the size, then the smallest of its bucket sizes which fits
+        uint32_t exponent = c_minResourceSizeExponent;
+        while (exponent < 62 && (2ull << exponent) <= size)
+        {
+            ++exponent;
+        }
+
+        const uint64_t step = (1ull << exponent) / c_bucketsPerPowerOfTwo;
+        const uint64_t stepIndex = (size - (1ull << exponent) + step - 1) / step;
+
+        // A step index of c_bucketsPerPowerOfTwo is the first bucket of the next power of two
+        gsl::index index = static_cast<gsl::index>((exponent - c_minResourceSizeExponent) * c_bucketsPerPowerOfTwo + stepIndex);
+        assert(GetBucketSizeFromIndex(index) >= size);
 
         return index;
     }
 
     /*static*/ uint64_t BucketizedBufferAllocator::GetBucketSizeFromIndex(gsl::index index)
     {
-        return (1ull << (index + c_minResourceSizeExponent));
+        const uint64_t powerOfTwo = 1ull << (index / c_bucketsPerPowerOfTwo + c_minResourceSizeExponent);
+        return powerOfTwo + (index % c_bucketsPerPowerOfTwo) * (powerOfTwo / c_bucketsPerPowerOfTwo);
     }
 
     void* BucketizedBufferAllocator::Alloc(size_t size)
@@ -92,32 +233,15 @@ namespace Dml
         // Use a pooled resource if the size (post rounding, if requested) matches a bucket size
         if (m_defaultRoundingMode == AllocatorRoundingMode::Enabled || size == GetBucketSizeFromIndex(GetBucketIndexFromSize(size)))
         {
-            Bucket* bucket = nullptr;
-
             // Find the bucket for this allocation size
             gsl::index bucketIndex = GetBucketIndexFromSize(size);
-
-            if (gsl::narrow_cast<gsl::index>(m_pool.size()) <= bucketIndex)
-            {
-                // Ensure there are sufficient buckets
-                m_pool.resize(bucketIndex + 1);
-            }
-
-            bucket = &m_pool[bucketIndex];
             bucketSize = GetBucketSizeFromIndex(bucketIndex);
 
-            if (bucket->resources.empty())
+            // Retrieve a resource from the bucket, or allocate a new one if none is free
+            if (!m_pool->TryTake(bucketIndex, m_context, resourceWrapper, resourceId))
             {
-                // No more resources in this bucket - allocate a new one
                 resourceWrapper = m_subAllocator->Alloc(onnxruntime::narrow<size_t>(bucketSize));
-                resourceId = ++m_currentResourceId;
-            }
-            else
-            {
-                // Retrieve a resource from the bucket
-                resourceWrapper = std::move(bucket->resources.back().resource);
-                resourceId = bucket->resources.back().resourceId;
-                bucket->resources.pop_back();
+                resourceId = m_pool->NextResourceId();
             }
         }
         else
@@ -125,7 +249,7 @@ namespace Dml
             // The allocation will not be pooled.  Construct a new one
             bucketSize = (size + 3) & ~3;
             resourceWrapper = m_subAllocator->Alloc(onnxruntime::narrow<size_t>(bucketSize));
-            resourceId = ++m_currentResourceId;
+            resourceId = m_pool->NextResourceId();
         }
 
         assert(resourceWrapper->GetD3D12Resource()->GetDesc().Width == bucketSize);
@@ -171,13 +295,8 @@ namespace Dml
         gsl::index bucketIndex = GetBucketIndexFromSize(allocInfo->GetRequestedSize());
         if (GetBucketSizeFromIndex(bucketIndex) == allocInfo->GetResource()->GetDesc().Width)
         {
-            assert(gsl::narrow_cast<gsl::index>(m_pool.size()) > bucketIndex);
-
             // Return the resource to the bucket
-            Bucket* bucket = &m_pool[bucketIndex];
-
-            Resource resource = {allocInfo->DetachResourceWrapper(), pooledResourceId};
-            bucket->resources.push_back(resource);
+            m_pool->Return(bucketIndex, this, m_context, allocInfo->DetachResourceWrapper(), pooledResourceId);
         }
         else
         {
@@ -3,9 +3,14 @@
 
 #pragma once
 
+#include <atomic>
+#include <mutex>
+#include <optional>
+
 #include "core/framework/allocator.h"
 #include "ExecutionContext.h"
 #include "DmlResourceWrapper.h"
+#include "GpuEvent.h"
 
 namespace Dml
 {
@@ -81,10 +86,63 @@ namespace Dml
         size_t m_requestedSize;
     };
 
+    // The free pooled buffers of all the BucketizedBufferAllocators of the process which allocate from the same device
+    // with the same heap properties and resource flags, so that the buffers freed by one session are reused by the
+    // other sessions instead of each session keeping its own. A buffer freed on one execution context is only reused
+    // on another one once the GPU work queued on the first context before the free has completed.
+    class SharedBufferPool
+    {
+    public:
+        // Returns the pool of the allocators with these parameters, which lives as long as one of them.
+        static std::shared_ptr<SharedBufferPool> Get(
+            ID3D12Device* device,
+            const D3D12_HEAP_PROPERTIES& heapProps,
+            D3D12_HEAP_FLAGS heapFlags,
+            D3D12_RESOURCE_FLAGS resourceFlags,
+            D3D12_RESOURCE_STATES initialState);
+
+        // Takes a free buffer of the bucket which `context` may use right away, returns false if there is none.
+        bool TryTake(
+            gsl::index bucketIndex,
+            const std::shared_ptr<ExecutionContext>& context,
+            ComPtr<DmlResourceWrapper>& resource,
+            uint64_t& resourceId);
+
+        // Returns a buffer freed by `owner` on `context` to the bucket.
+        void Return(
+            gsl::index bucketIndex,
+            const BucketizedBufferAllocator* owner,
+            const std::shared_ptr<ExecutionContext>& context,
+            ComPtr<DmlResourceWrapper>&& resource,
+            uint64_t resourceId);
+
+        // Releases the free buffers returned by `owner`, when it is destroyed.
+        void ReleaseResourcesOf(const BucketizedBufferAllocator* owner);
+
+        uint64_t NextResourceId() { return ++m_currentResourceId; }
+
+    private:
+        struct FreeResource
+        {
+            ComPtr<DmlResourceWrapper> resource;
+            uint64_t resourceId;
+            const BucketizedBufferAllocator* owner;
+            std::weak_ptr<ExecutionContext> context;
+            // Signaled once the work queued on `context` before the free has completed. Not set if the context was
+            // closed, which waits for its work.
+            std::optional<GpuEvent> releaseEvent;
+        };
+
+        std::mutex m_mutex;
+        std::vector<std::vector<FreeResource>> m_buckets;
+        std::atomic<uint64_t> m_currentResourceId{0};
+    };
+
     // Implements a Lotus allocator for D3D12 heap buffers, using a bucket allocation strategy. The allocator
     // maintains a set of fixed-size buckets, with each bucket containing one or more D3D12 buffers of that fixed size.
     // All requested allocation sizes are rounded up to the nearest bucket size, which ensures minimal fragmentation
-    // while providing an upper bound on the amount of memory "wasted" with each allocation.
+    // while providing an upper bound on the amount of memory "wasted" with each allocation. The free buffers of the
+    // buckets are kept in a SharedBufferPool.
     class BucketizedBufferAllocator : public onnxruntime::IAllocator
     {
     public:
@@ -114,18 +172,9 @@ namespace Dml
         static const uint32_t c_minResourceSizeExponent = 16; // 2^16 = 64KB
 
         // The pool consists of a number of buckets, and each bucket contains a number of resources of the same size.
-        // The resources in each bucket are always sized as a power of two, and each bucket contains resources twice
-        // as large as the previous bucket.
-        struct Resource
-        {
-            ComPtr<DmlResourceWrapper> resource;
-            uint64_t resourceId;
-        };
-
-        struct Bucket
-        {
-            std::vector<Resource> resources;
-        };
+        // Each power of two is split into c_bucketsPerPowerOfTwo evenly spaced sizes, e.g. 64KB, 80KB, 96KB, 112KB,
+        // 128KB, 160KB, ... so that rounding wastes at most 20% of a buffer instead of 50% with power of two sizes.
+        static const uint32_t c_bucketsPerPowerOfTwo = 4;
 
         static gsl::index GetBucketIndexFromSize(uint64_t size);
         static uint64_t GetBucketSizeFromIndex(gsl::index index);
@@ -139,12 +188,11 @@ namespace Dml
         D3D12_RESOURCE_FLAGS m_resourceFlags;
         D3D12_RESOURCE_STATES m_initialState;
 
-        std::vector<Bucket> m_pool;
         size_t m_currentAllocationId = 0;
-        uint64_t m_currentResourceId = 0;
         AllocatorRoundingMode m_defaultRoundingMode = AllocatorRoundingMode::Enabled;
         std::shared_ptr<ExecutionContext> m_context;
         std::unique_ptr<DmlSubAllocator> m_subAllocator;
+        std::shared_ptr<SharedBufferPool> m_pool;
 
     #if _DEBUG
         // Useful for debugging; keeps track of all allocations that haven't been freed yet
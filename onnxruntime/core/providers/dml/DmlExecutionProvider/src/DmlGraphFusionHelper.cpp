@@ -1,12 +1,151 @@
 #pragma once
 
+#include <mutex>
+#include <sstream>
+
 #include "DmlGraphFusionHelper.h"
+#include "core/common/logging/logging.h"
 
 
 namespace Dml
 {
 namespace DmlGraphFusionHelper
 {
+    namespace
+    {
+        struct CompiledGraphCacheEntry
+        {
+            // Keeps the device alive, so that its address identifies it as long as the entry exists.
+            ComPtr<IDMLDevice> device;
+            ComPtr<IDMLCompiledOperator> compiledOperator;
+        };
+
+        // Process wide cache of the compiled partition graphs, see kOrtSessionOptionsConfigEnableDmlGraphCompilationCache.
+        // The oldest entries are evicted first.
+        class CompiledGraphCache
+        {
+        public:
+            static CompiledGraphCache& Instance()
+            {
+                static CompiledGraphCache cache;
+                return cache;
+            }
+
+            ComPtr<IDMLCompiledOperator> Find(const std::string& key)
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                auto iter = m_entries.find(key);
+                return iter != m_entries.end() ? iter->second.compiledOperator : nullptr;
+            }
+
+            void Insert(const std::string& key, IDMLDevice* device, IDMLCompiledOperator* compiledOperator)
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (!m_entries.emplace(key, CompiledGraphCacheEntry{device, compiledOperator}).second)
+                {
+                    return;
+                }
+                m_insertionOrder.push_back(key);
+                if (m_insertionOrder.size() > c_maxEntries)
+                {
+                    m_entries.erase(m_insertionOrder.front());
+                    m_insertionOrder.pop_front();
+                }
+            }
+
+        private:
+            static constexpr size_t c_maxEntries = 256;
+
+            std::mutex m_mutex;
+            std::unordered_map<std::string, CompiledGraphCacheEntry> m_entries;
+            std::deque<std::string> m_insertionOrder;
+        };
+
+        // The key of a compiled partition graph: everything BuildGraphDesc reads from the partition, i.e. the nodes
+        // with their attributes, edge shapes and constant CPU inputs, the partition inputs and outputs and which of
+        // the inputs DML owns, plus the device and the compilation flags.
+        std::string GetCompiledGraphCacheKey(
+            IDMLDevice* device,
+            DML_EXECUTION_FLAGS executionFlags,
+            const onnxruntime::Graph& graph,
+            const onnxruntime::IndexedSubGraph& indexedSubGraph,
+            const std::unordered_map<std::string, GraphNodeProperties>& partitionNodePropsMap,
+            const std::unordered_map<std::string, std::pair<const ONNX_NAMESPACE::TensorProto*, bool>>& initializerNameToInitializerMap,
+            gsl::span<const uint8_t> isInputsUploadedByDmlEP)
+        {
+            std::ostringstream key;
+            key << static_cast<const void*>(device) << '|' << static_cast<uint32_t>(executionFlags) << '|';
+            for (size_t i = 0; i < indexedSubGraph.GetMetaDef()->inputs.size(); ++i)
+            {
+                key << indexedSubGraph.GetMetaDef()->inputs[i] << ':' << static_cast<uint32_t>(isInputsUploadedByDmlEP[i]) << ',';
+            }
+            key << '|';
+            for (const auto& output : indexedSubGraph.GetMetaDef()->outputs)
+            {
+                key << output << ',';
+            }
+
+            const auto appendShapes = [&key](const Windows::AI::MachineLearning::Adapter::EdgeShapes& shapes)
+            {
+                for (size_t edgeIndex = 0; edgeIndex < shapes.EdgeCount(); ++edgeIndex)
+                {
+                    key << '[';
+                    for (uint32_t dim : shapes.GetShape(edgeIndex))
+                    {
+                        key << dim << ',';
+                    }
+                    key << ']';
+                }
+            };
+
+            for (size_t nodeIndex : indexedSubGraph.nodes)
+            {
+                const onnxruntime::Node& node = *graph.GetNode(nodeIndex);
+                key << '|' << node.Domain() << ':' << node.OpType() << ':' << node.SinceVersion() << '(';
+                for (const auto* arg : node.InputDefs())
+                {
+                    key << arg->Name() << ':' << (arg->Type() ? *arg->Type() : std::string()) << ',';
+                }
+                key << ")(";
+                for (const auto* arg : node.OutputDefs())
+                {
+                    key << arg->Name() << ':' << (arg->Type() ? *arg->Type() : std::string()) << ',';
+                }
+                key << ')';
+
+                // NodeAttributes is unordered
+                std::map<std::string, const ONNX_NAMESPACE::AttributeProto*> attributes;
+                for (const auto& attribute : node.GetAttributes())
+                {
+                    attributes.emplace(attribute.first, &attribute.second);
+                }
+                for (const auto& attribute : attributes)
+                {
+                    key << attribute.first << '=' << attribute.second->SerializeAsString() << ';';
+                }
+
+                const GraphNodeProperties& nodeProps = partitionNodePropsMap.at(GraphDescBuilder::GetUniqueNodeName(node));
+                appendShapes(nodeProps.inputShapes);
+                appendShapes(nodeProps.outputShapes);
+
+                // The values of the constant CPU inputs are read into the operator descs
+                const auto inputDefs = node.InputDefs();
+                for (uint32_t inputIndex : nodeProps.internalRegInfo->requiredConstantCpuInputs)
+                {
+                    if (inputIndex < inputDefs.size())
+                    {
+                        auto iter = initializerNameToInitializerMap.find(inputDefs[inputIndex]->Name());
+                        if (iter != initializerNameToInitializerMap.end())
+                        {
+                            key << '#' << inputIndex << '=' << iter->second.first->SerializeAsString();
+                        }
+                    }
+                }
+            }
+            return key.str();
+        }
+    }
+
     Microsoft::WRL::ComPtr<ID3D12Resource>
     CreateResource(
         const ExecutionProviderImpl* provider,
@@ -332,7 +471,9 @@ namespace DmlGraphFusionHelper
         const std::unordered_map<std::string, GraphNodeProperties>& partitionNodePropsMap,
         const std::unordered_map<std::string, std::pair<const ONNX_NAMESPACE::TensorProto*, bool>>& initializerNameToInitializerMap,
         const ExecutionProviderImpl* providerImpl,
-        onnxruntime::KernelRegistry* registryForPartitionKernels)
+        onnxruntime::KernelRegistry* registryForPartitionKernels,
+        bool useGraphCompilationCache,
+        const onnxruntime::logging::Logger& logger)
     {
         // convert partitionONNXGraph into DML EP GraphDesc
         const uint32_t fusedNodeInputCount = gsl::narrow_cast<uint32_t>(indexedSubGraph.GetMetaDef()->inputs.size());
@@ -387,13 +528,62 @@ namespace DmlGraphFusionHelper
             executionFlags |= DML_EXECUTION_FLAG_DISABLE_META_COMMANDS;
         }
 
-        ComPtr<IDMLDevice1> device1;
-        ORT_THROW_IF_FAILED(device.As(&device1));
+        std::string cacheKey;
         ComPtr<IDMLCompiledOperator> compiledExecutionPlanOperator;
-        ORT_THROW_IF_FAILED(device1->CompileGraph(
-            &dmlGraphDesc,
-            executionFlags,
-            IID_PPV_ARGS(&compiledExecutionPlanOperator)));
+        if (useGraphCompilationCache)
+        {
+            cacheKey = GetCompiledGraphCacheKey(
+                device.Get(),
+                executionFlags,
+                graph,
+                indexedSubGraph,
+                partitionNodePropsMap,
+                initializerNameToInitializerMap,
+                isInputsUploadedByDmlEP);
+            compiledExecutionPlanOperator = CompiledGraphCache::Instance().Find(cacheKey);
+        }
+
+        const bool isCached = compiledExecutionPlanOperator != nullptr;
+        const auto compileStart = std::chrono::steady_clock::now();
+        if (!isCached)
+        {
+            ComPtr<IDMLDevice1> device1;
+            ORT_THROW_IF_FAILED(device.As(&device1));
+            ORT_THROW_IF_FAILED(device1->CompileGraph(
+                &dmlGraphDesc,
+                executionFlags,
+                IID_PPV_ARGS(&compiledExecutionPlanOperator)));
+
+            if (useGraphCompilationCache)
+            {
+                CompiledGraphCache::Instance().Insert(cacheKey, device.Get(), compiledExecutionPlanOperator.Get());
+            }
+        }
+        const auto compileMilliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - compileStart).count();
+
+        // DirectML does not report the metacommands it selects, so report what decides whether they can be used:
+        // the flags, and the operators of the partition.
+        if (logger.OutputIsEnabled(onnxruntime::logging::Severity::kINFO, onnxruntime::logging::DataType::SYSTEM))
+        {
+            std::map<std::string, uint32_t> opTypeCounts;
+            for (size_t nodeIndex : indexedSubGraph.nodes)
+            {
+                ++opTypeCounts[graph.GetNode(nodeIndex)->OpType()];
+            }
+            std::ostringstream opTypes;
+            for (const auto& opTypeCount : opTypeCounts)
+            {
+                opTypes << ' ' << opTypeCount.first << 'x' << opTypeCount.second;
+            }
+            LOGS(logger, INFO) << "DML partition " << indexedSubGraph.GetMetaDef()->name
+                               << ": " << indexedSubGraph.nodes.size() << " nodes, " << graphDesc.nodes.size()
+                               << " DML operators, metacommands "
+                               << ((executionFlags & DML_EXECUTION_FLAG_DISABLE_META_COMMANDS) ? "disabled" : "allowed")
+                               << (isCached ? ", compiled graph from cache" : ", compiled in ")
+                               << (isCached ? std::string() : std::to_string(compileMilliseconds) + " ms")
+                               << ", operators:" << opTypes.str();
+        }
 
         // Populate input bindings for operator initialization
         std::vector<Microsoft::WRL::ComPtr<ID3D12Resource>> initializeResourceRefs; // For lifetime control
@@ -457,7 +647,9 @@ namespace DmlGraphFusionHelper
         onnxruntime::KernelRegistry* registryForPartitionKernels,
         const std::string& partitionKernelPrefix,
         const std::unordered_map<std::string, std::pair<const ONNX_NAMESPACE::TensorProto*, bool>>& initializerNameToInitializerMap,
-        const ExecutionProviderImpl* providerImpl)
+        const ExecutionProviderImpl* providerImpl,
+        bool useGraphCompilationCache,
+        const onnxruntime::logging::Logger& logger)
     {
         assert(partition->IsDmlGraphPartition());
 
@@ -498,7 +690,9 @@ namespace DmlGraphFusionHelper
             partitionNodePropsMap,
             initializerNameToInitializerMap,
             providerImpl,
-            registryForPartitionKernels);
+            registryForPartitionKernels,
+            useGraphCompilationCache,
+            logger);
         graph.FinalizeFuseSubGraph(indexedSubGraph, fusedNode);
     }
 }
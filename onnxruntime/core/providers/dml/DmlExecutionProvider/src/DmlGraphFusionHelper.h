@@ -63,7 +63,9 @@ namespace DmlGraphFusionHelper
         const std::unordered_map<std::string, GraphNodeProperties>& partitionNodePropsMap,
         const std::unordered_map<std::string, std::pair<const ONNX_NAMESPACE::TensorProto*, bool>>& isInitializerTransferable,
         const ExecutionProviderImpl* providerImpl,
-        onnxruntime::KernelRegistry* registryForPartitionKernels);
+        onnxruntime::KernelRegistry* registryForPartitionKernels,
+        bool useGraphCompilationCache,
+        const onnxruntime::logging::Logger& logger);
 
     void FusePartitionAndRegisterKernel(
         GraphPartition* partition,
@@ -73,6 +75,8 @@ namespace DmlGraphFusionHelper
         onnxruntime::KernelRegistry* registryForPartitionKernels,
         const std::string& partitionKernelPrefix,
         const std::unordered_map<std::string, std::pair<const ONNX_NAMESPACE::TensorProto*, bool>>& isInitializerTransferable,
-        const ExecutionProviderImpl* providerImpl);
+        const ExecutionProviderImpl* providerImpl,
+        bool useGraphCompilationCache,
+        const onnxruntime::logging::Logger& logger);
 }
 }
@@ -17,10 +17,12 @@ namespace Dml
 {
     DmlGraphFusionTransformer::DmlGraphFusionTransformer(
         const std::string& name,
-        const onnxruntime::IExecutionProvider* provider
+        const onnxruntime::IExecutionProvider* provider,
+        bool enableGraphCompilationCache
     )
         :onnxruntime::GraphTransformer(name),
-         m_providerImpl(static_cast<const ExecutionProvider*>(provider)->GetImpl())
+         m_providerImpl(static_cast<const ExecutionProvider*>(provider)->GetImpl()),
+         m_enableGraphCompilationCache(enableGraphCompilationCache)
     {
     }
 	
@@ -125,7 +127,9 @@ namespace Dml
                     m_providerImpl->GetKernelRegistry().get(),
                     partitionKernelPrefix,
                     isInitializerTransferable,
-                    m_providerImpl
+                    m_providerImpl,
+                    m_enableGraphCompilationCache,
+                    logger
                 );
             }
         }
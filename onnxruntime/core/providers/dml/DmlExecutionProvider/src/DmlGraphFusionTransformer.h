@@ -15,7 +15,8 @@ namespace Dml
 	public:
 		DmlGraphFusionTransformer(
 			const std::string& name,
-			const onnxruntime::IExecutionProvider* provider
+			const onnxruntime::IExecutionProvider* provider,
+			bool enableGraphCompilationCache = false
 		);
 
 	public:
@@ -29,5 +30,6 @@ namespace Dml
 											  const onnxruntime::logging::Logger& logger) const final;
 	private:
 		const ExecutionProviderImpl* m_providerImpl = nullptr;
+		bool m_enableGraphCompilationCache = false;
 	};
 }
@@ -85,6 +85,8 @@ namespace Dml
 
         D3D12_COMMAND_LIST_TYPE GetCommandListTypeForQueue() const;
 
+        bool IsClosed() const { return m_closed; }
+
     private:
         ComPtr<ID3D12Device> m_d3dDevice;
 
@@ -21,3 +21,12 @@
 // "1": disabled (disallowed). Graph fusion will never be used.
 // The default value is "0"
 static const char* const kOrtSessionOptionsConfigDisableDmlGraphFusion = "ep.dml.disable_graph_fusion";
+
+// Influences whether the graphs the DirectML graph fusion transformer compiles are kept in a process wide cache.
+// A session fusing the same partitions on the same DirectML device, e.g. a session created again for the same
+// model, then reuses the compiled graphs instead of compiling them again. DirectML cannot serialize compiled graphs,
+// so the cache does not persist across processes. The cached graphs keep their device alive.
+// "0": disabled. "1": enabled.
+// The default value is "0"
+static const char* const kOrtSessionOptionsConfigEnableDmlGraphCompilationCache =
+    "ep.dml.enable_graph_compilation_cache";
@@ -7,6 +7,7 @@
 
 #include "core/providers/dnnl/dnnl_execution_provider.h"
 
+#include <algorithm>
 #include <fstream>
 #include <iomanip>
 #include <unordered_set>
@@ -50,6 +51,20 @@ DnnlExecutionProvider::DnnlExecutionProvider(const DnnlExecutionProviderInfo& in
     enable_fusion_ = (std::stoi(fusion_env) == 0 ? false : true);
   }
 
+  // number of input shapes of a dynamic subgraph whose compiled primitives are kept, so that going back to a
+  // shape seen before does not build its primitives again
+  const std::string shape_cache_env = onnxruntime::GetEnvironmentVar("ORT_DNNL_SUBGRAPH_CACHE_CAPACITY");
+  if (!shape_cache_env.empty()) {
+    shape_cache_capacity_ = static_cast<size_t>(std::max(1, std::stoi(shape_cache_env)));
+  }
+
+  // the oneDNN primitive cache is an LRU cache of the process keyed on the shapes and attributes of the primitives,
+  // so all the sessions reuse the primitives one of them has built
+  const std::string primitive_cache_env = onnxruntime::GetEnvironmentVar("ORT_DNNL_PRIMITIVE_CACHE_CAPACITY");
+  if (!primitive_cache_env.empty()) {
+    dnnl::set_primitive_cache_capacity(std::max(0, std::stoi(primitive_cache_env)));
+  }
+
   // Set the number of threads specified by the user
   // If provided arguments set them as the number of threads, else call
   // calc which usually = numcores
@@ -297,7 +312,8 @@ Status DnnlExecutionProvider::Compile(const std::vector<FusedNodeAndGraph>& fuse
     }
 
     // subgraph primitive
-    auto dnnl_subgraph_primitive = std::make_unique<ort_dnnl::DnnlSubgraphPrimitive>(*subgraphs_[fused_node.Name()].get());
+    auto dnnl_subgraph_primitive = std::make_unique<ort_dnnl::DnnlSubgraphPrimitive>(*subgraphs_[fused_node.Name()].get(),
+                                                                                     shape_cache_capacity_);
     {
       const auto& input_defs = fused_node.InputDefs();
       std::vector<std::string> onnx_input_names(input_defs.size());
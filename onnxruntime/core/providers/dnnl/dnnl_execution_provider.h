@@ -41,6 +41,8 @@ class DnnlExecutionProvider : public IExecutionProvider {
   bool debug_log_ = false;
   // enable fusion by default
   bool enable_fusion_ = true;
+  // compiled input shapes kept by each subgraph
+  size_t shape_cache_capacity_ = 4;
 };
 
 }  // namespace onnxruntime
@@ -4,17 +4,27 @@
 #include "dnnl_conv.h"
 #include "dnnl_subgraph.h"
 #include "dnnl_subgraph_primitive.h"
+#include "dnnl_util.h"
 #include <cassert>
+#include <string>
+#include <unordered_set>
+#include <vector>
 
 namespace onnxruntime {
 namespace ort_dnnl {
 
 DnnlConv::DnnlConv() {}
 
+// This handles ONNX defined "Conv" as well as "ConvPostOps", a OneDNN only fusion of Conv and upto 32
+// elementwise or binary ops. See dnnl_subgraph_transformer.cc ConvBinaryEltwise(...).
 void DnnlConv::CreatePrimitive(DnnlSubgraphPrimitive& sp, DnnlNode& node) {
-  bool has_relu = false;
-  if (node.OpType() == "ConvRelu") {
-    has_relu = true;
+  std::unordered_set<std::string> binary_ops = {"Add", "Div", "Mul", "Sub"};
+  std::unordered_set<std::string> elementwise_ops = {"Abs", "Elu", "Exp", "LeakyRelu", "Log", "Relu",
+                                                     "Round", "Sigmoid", "Softplus", "Sqrt", "Tanh"};
+
+  std::vector<std::string> post_ops;
+  if (node.OpType() == "ConvPostOps") {
+    post_ops = node.GetPostOps();
   }
 
   auto dnnl_engine = sp.GetEngine();
@@ -95,10 +105,60 @@ void DnnlConv::CreatePrimitive(DnnlSubgraphPrimitive& sp, DnnlNode& node) {
   auto prop_kind = dnnl::prop_kind::forward_inference;
 #endif  // ENABLE_TRAINING
 
+  // A first Add of a tensor with the shape of the output (the residual connection of the ResNets) is a sum post op:
+  // the tensor is copied to the output, and the convolution accumulates into it instead of reading the tensor again.
+  bool has_sum = !post_ops.empty() && post_ops[0] == "Add" &&
+                 sp.GetMemory(node.Input(IN_BINARY_0)).get_desc().get_dims() == dst_mem_dims;
+
   dnnl::primitive_attr attr;
-  if (has_relu) {
+  if (!post_ops.empty()) {
+    int binary_count = 0;
     dnnl::post_ops ops;
-    ops.append_eltwise(dnnl::algorithm::eltwise_relu, 0.f, 0.f);
+    for (size_t i = 0; i < post_ops.size(); ++i) {
+      dnnl::algorithm algo = dnnl_util::OrtOperatorToDnnlAlgorithm(post_ops[i]);
+      if (i == 0 && has_sum) {
+        ops.append_sum(1.0f);
+        binary_count++;
+        // Handle Binary post ops including the input memory
+      } else if (binary_ops.count(post_ops[i]) != 0) {
+        auto ori_binary_md = sp.GetMemory(node.Input(IN_BINARY_0 + binary_count)).get_desc();
+        auto binary_mem_dims = ori_binary_md.get_dims();
+        if (binary_mem_dims.size() > dst_mem_dims.size()) {
+          ORT_THROW("add fusion with conv output broadcasting by unsqueezing is not supported");
+        }
+        // expand the input (from the binary op) if needed to support broadcasting
+        while (binary_mem_dims.size() < dst_mem_dims.size()) {
+          binary_mem_dims.insert(binary_mem_dims.begin(), 1);
+        }
+        ops.append_binary(algo, ori_binary_md.reshape(binary_mem_dims));
+        binary_count++;
+        // Handle Elementwise post ops. Some of these require obtaining an 'alpha' attribute
+      } else if (elementwise_ops.count(post_ops[i]) != 0) {
+        float post_op_alpha = 0.0;
+        switch (algo) {
+          case dnnl::algorithm::eltwise_relu: {
+            // Need to check operator since both Relu and LeakyRelu are covered by algorithm::eltwise_relu
+            if (post_ops[i] == "LeakyRelu") {
+              post_op_alpha = GetFloatAttr(node, "alpha", /*default_alpha*/ 0.01f);
+            }
+            break;
+          }
+          case dnnl::algorithm::eltwise_elu: {
+            post_op_alpha = GetFloatAttr(node, "alpha", /*default_alpha*/ 1.0f);
+            break;
+          }
+          case dnnl::algorithm::eltwise_soft_relu: {
+            if (post_ops[i] == "Softplus") {
+              post_op_alpha = 1.0f;
+            }
+            break;
+          }
+          default:
+            post_op_alpha = 0.0;
+        }
+        ops.append_eltwise(algo, post_op_alpha, 0.0f);
+      }
+    }
     attr.set_post_ops(ops);
   }
 
@@ -121,18 +181,40 @@ void DnnlConv::CreatePrimitive(DnnlSubgraphPrimitive& sp, DnnlNode& node) {
   }
   auto conv_dst_mem = dnnl::memory(conv_pd.dst_desc(), dnnl_engine);
 
+  // the sum post op accumulates into the output, which starts as a copy of the tensor added
+  // since the tensor may have other consumers it is never summed into in place
+  if (has_sum) {
+    auto sum_src_mem = sp.GetMemory(node.Input(IN_BINARY_0));
+    sp.AddPrimitive(dnnl::reorder(sum_src_mem, conv_dst_mem), {{DNNL_ARG_FROM, sum_src_mem},
+                                                               {DNNL_ARG_TO, conv_dst_mem}});
+  }
+
   // Add the convolution layer to the subgraph
   auto conv_op = dnnl::convolution_forward(conv_pd);
+  std::unordered_map<int, dnnl::memory> mem_map({{DNNL_ARG_SRC, conv_src_mem},
+                                                 {DNNL_ARG_WEIGHTS, conv_weights_mem},
+                                                 {DNNL_ARG_DST, conv_dst_mem}});
   if (bias_exists) {
-    sp.AddPrimitive(conv_op, {{DNNL_ARG_SRC, conv_src_mem},
-                              {DNNL_ARG_WEIGHTS, conv_weights_mem},
-                              {DNNL_ARG_BIAS, conv_bias_mem},
-                              {DNNL_ARG_DST, conv_dst_mem}});
-  } else {
-    sp.AddPrimitive(conv_op, {{DNNL_ARG_SRC, conv_src_mem},
-                              {DNNL_ARG_WEIGHTS, conv_weights_mem},
-                              {DNNL_ARG_DST, conv_dst_mem}});
+    mem_map.insert({DNNL_ARG_BIAS, conv_bias_mem});
+  }
+
+  // add to memory map for extra binary inputs
+  int binary_count = has_sum ? 1 : 0;
+  for (size_t i = 0; i < post_ops.size(); ++i) {
+    if (i == 0 && has_sum) {
+      continue;
+    }
+    if (binary_ops.count(post_ops[i]) != 0) {
+      dnnl::algorithm algo;
+      dnnl::memory::desc binary_mem_desc;
+      conv_pd.get_primitive_attr().get_post_ops().get_params_binary(static_cast<int>(i), algo, binary_mem_desc);
+      auto binary_post_op_mem = sp.GetMemoryAndReshape(node.Input(IN_BINARY_0 + binary_count), binary_mem_desc,
+                                                       dnnl_engine);
+      mem_map[DNNL_ARG_ATTR_MULTIPLE_POST_OP(static_cast<int>(i)) | DNNL_ARG_SRC_1] = binary_post_op_mem;
+      binary_count++;
+    }
   }
+  sp.AddPrimitive(conv_op, mem_map);
 
   sp.SetMemory(node.Output(OUT_Y), conv_dst_mem);
 }
@@ -257,6 +339,14 @@ dnnl::memory::dims DnnlConv::GetStrides(DnnlNode& node, ConvShape shape) {
   return dnnl::memory::dims(strides.begin(), strides.end());
 }
 
+float DnnlConv::GetFloatAttr(DnnlNode& node, std::string attr_name, float default_value) {
+  auto attr = node.Attributes().find(attr_name);
+  if (attr != node.Attributes().end()) {
+    return attr->second().f();
+  }
+  return default_value;
+}
+
 // ComputePad is copy/paste of a the ComputePad found in core/providers/common.h
 // With some minor modifications.
 // ComputePad is not exposed to the shared library so this copy is used instead.
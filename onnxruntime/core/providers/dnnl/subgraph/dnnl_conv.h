@@ -13,7 +13,8 @@ class DnnlConv {
   enum InputTensors : int {
     IN_X = 0,
     IN_W = 1,
-    IN_B = 2
+    IN_B = 2,
+    IN_BINARY_0 = 3  // the inputs of the binary post ops of a ConvPostOps
   };
 
   enum OutputTensors : int {
@@ -85,6 +86,9 @@ class DnnlConv {
   /* Get the 'strides' attribute */
   dnnl::memory::dims GetStrides(DnnlNode& node, ConvShape shape);
 
+  /* Get a float attribute, the 'alpha' of an Elu or LeakyRelu post op */
+  float GetFloatAttr(DnnlNode& node, std::string attr_name, float default_value);
+
   /*
    * ComputePad is copy/paste of a the ComputePad found in core/providers/common.h
    * With some minor modifications. i.e. return bool instead of status.
@@ -35,6 +35,7 @@
 #include "dnnl_relugrad.h"
 #endif
 
+#include <algorithm>
 #include <inttypes.h>
 #include <stdio.h>
 #include <iostream>
@@ -179,7 +180,7 @@ void DnnlSubgraphPrimitive::AddKernels() {
       DnnlCast().CreatePrimitive(*this, node);
     } else if (node.OpType() == "Concat") {
       DnnlConcat().CreatePrimitive(*this, node);
-    } else if (node.OpType() == "Conv" || node.OpType() == "ConvRelu") {
+    } else if (node.OpType() == "Conv" || node.OpType() == "ConvPostOps") {
       DnnlConv().CreatePrimitive(*this, node);
     } else if (node.OpType() == "DequantizeLinear") {
       DnnlDequantizeLinear().CreatePrimitive(*this, node);
@@ -240,7 +241,8 @@ void DnnlSubgraphPrimitive::AddKernels() {
   }
 }
 
-DnnlSubgraphPrimitive::DnnlSubgraphPrimitive(ort_dnnl::DnnlSubgraph& dnnl_subgraph) {
+DnnlSubgraphPrimitive::DnnlSubgraphPrimitive(ort_dnnl::DnnlSubgraph& dnnl_subgraph, size_t shape_cache_capacity)
+    : shape_cache_capacity_(shape_cache_capacity) {
   subgraph_ = &dnnl_subgraph;
   if (dnnl_engine_get_count(dnnl_engine_kind_t::dnnl_cpu)) {
     cpu_engine_ = dnnl::engine(dnnl::engine::kind::cpu, 0);
@@ -276,9 +278,15 @@ void DnnlSubgraphPrimitive::Compile(const std::unordered_map<std::string, OnnxTe
     key += "|";
   }
   // if key different from shape key, update and recompile
-  if (key != shape_key_) {
-    shape_key_ = key;
-  } else {
+  if (key == shape_key_) {
+    return;
+  }
+  if (!shape_key_.empty()) {
+    SaveCompiledShape(shape_key_);
+  }
+  shape_key_ = key;
+  if (RestoreCompiledShape(key)) {
+    LOGS_DEFAULT(INFO) << "Reuse Compiled Shape";
     return;
   }
   if (IsDynamic()) {
@@ -289,6 +297,7 @@ void DnnlSubgraphPrimitive::Compile(const std::unordered_map<std::string, OnnxTe
 
   inputs_.clear();
   intermediates_.clear();
+  input_is_scalar_.clear();
   outputs_.clear();
   outputs_are_always_copied_.clear();
   inputs_md_.clear();
@@ -297,6 +306,7 @@ void DnnlSubgraphPrimitive::Compile(const std::unordered_map<std::string, OnnxTe
   net_args_.clear();
   reshapes_.clear();
   scalar_outputs_.clear();
+  items_to_print_.clear();
   // initializer should not be cleared upon recompile
   // initializers_.clear();
 
@@ -321,6 +331,53 @@ void DnnlSubgraphPrimitive::Compile(const std::unordered_map<std::string, OnnxTe
   AddOutputs();
 }
 
+void DnnlSubgraphPrimitive::SaveCompiledShape(const std::string& key) {
+  if (shape_cache_capacity_ <= 1) {
+    return;
+  }
+  CompiledShape compiled;
+  compiled.intermediates = std::move(intermediates_);
+  compiled.inputs = std::move(inputs_);
+  compiled.inputs_md = std::move(inputs_md_);
+  compiled.input_is_scalar = std::move(input_is_scalar_);
+  compiled.outputs = std::move(outputs_);
+  compiled.outputs_md = std::move(outputs_md_);
+  compiled.outputs_are_always_copied = std::move(outputs_are_always_copied_);
+  compiled.net = std::move(net_);
+  compiled.net_args = std::move(net_args_);
+  compiled.reshapes = std::move(reshapes_);
+  compiled.scalar_outputs = std::move(scalar_outputs_);
+  compiled.items_to_print = std::move(items_to_print_);
+  shape_cache_.emplace_front(key, std::move(compiled));
+  // the current shape takes one of the places
+  while (shape_cache_.size() > shape_cache_capacity_ - 1) {
+    shape_cache_.pop_back();
+  }
+}
+
+bool DnnlSubgraphPrimitive::RestoreCompiledShape(const std::string& key) {
+  auto it = std::find_if(shape_cache_.begin(), shape_cache_.end(),
+                         [&key](const std::pair<std::string, CompiledShape>& entry) { return entry.first == key; });
+  if (it == shape_cache_.end()) {
+    return false;
+  }
+  auto& compiled = it->second;
+  intermediates_ = std::move(compiled.intermediates);
+  inputs_ = std::move(compiled.inputs);
+  inputs_md_ = std::move(compiled.inputs_md);
+  input_is_scalar_ = std::move(compiled.input_is_scalar);
+  outputs_ = std::move(compiled.outputs);
+  outputs_md_ = std::move(compiled.outputs_md);
+  outputs_are_always_copied_ = std::move(compiled.outputs_are_always_copied);
+  net_ = std::move(compiled.net);
+  net_args_ = std::move(compiled.net_args);
+  reshapes_ = std::move(compiled.reshapes);
+  scalar_outputs_ = std::move(compiled.scalar_outputs);
+  items_to_print_ = std::move(compiled.items_to_print);
+  shape_cache_.erase(it);
+  return true;
+}
+
 dnnl::memory::format_tag DnnlSubgraphPrimitive::GetDnnlFormat(size_t dim_size) {
   dnnl::memory::format_tag source_format = dnnl::memory::format_tag::any;
   switch (dim_size) {
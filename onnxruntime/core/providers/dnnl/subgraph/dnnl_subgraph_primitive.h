@@ -2,6 +2,7 @@
 // Licensed under the MIT License
 
 #pragma once
+#include <list>
 #include "dnnl_subgraph.h"
 #include "dnnl.hpp"
 #include "core/platform/ort_mutex.h"
@@ -22,7 +23,9 @@ struct OnnxTensorData {
 
 class DnnlSubgraphPrimitive {
  public:
-  DnnlSubgraphPrimitive(ort_dnnl::DnnlSubgraph& dnnl_subgraph);
+  // shape_cache_capacity is the number of input shapes of a dynamic subgraph whose compiled primitives are kept.
+  // Going back to a shape that is kept does not build its primitives again.
+  DnnlSubgraphPrimitive(ort_dnnl::DnnlSubgraph& dnnl_subgraph, size_t shape_cache_capacity = 1);
   ~DnnlSubgraphPrimitive() = default;
 
   // compile subgraph primitive with runtime input information
@@ -96,8 +99,30 @@ class DnnlSubgraphPrimitive {
   }
 
  private:
+  // the primitives and memory compiled for one input shape of the subgraph
+  struct CompiledShape {
+    std::unordered_map<std::string, std::vector<dnnl::memory>> intermediates;
+    std::unordered_map<std::string, dnnl::memory> inputs;
+    std::unordered_map<std::string, dnnl::memory::desc> inputs_md;
+    std::unordered_set<std::string> input_is_scalar;
+    std::unordered_map<std::string, dnnl::memory> outputs;
+    std::unordered_map<std::string, dnnl::memory::desc> outputs_md;
+    std::unordered_set<std::string> outputs_are_always_copied;
+    std::vector<dnnl::primitive> net;
+    std::vector<std::unordered_map<int, dnnl::memory>> net_args;
+    std::vector<std::pair<dnnl::memory, dnnl::memory>> reshapes;
+    std::unordered_set<std::string> scalar_outputs;
+    std::vector<std::pair<int, int>> items_to_print;
+  };
+  void SaveCompiledShape(const std::string& key);
+  bool RestoreCompiledShape(const std::string& key);
+
   std::string shape_key_;
 
+  // compiled shapes other than the current one, the most recently used first
+  size_t shape_cache_capacity_;
+  std::list<std::pair<std::string, CompiledShape>> shape_cache_;
+
   std::unordered_map<std::string, std::vector<dnnl::memory>> intermediates_;
 
   std::unordered_map<std::string, dnnl::memory> inputs_;
@@ -19,7 +19,7 @@ namespace ort_dnnl {
 
 // apply all transformation rules in order
 void DnnlGraphTransformer::Apply(DnnlSubgraph& subgraph, const onnxruntime::GraphViewer& onnx_subgraph_viewer) {
-  ConvRelu(subgraph);
+  ConvBinaryEltwise(subgraph);
   MatMulBinaryEltwise(subgraph);
   Gelu(subgraph, onnx_subgraph_viewer);
   FastGelu(subgraph, onnx_subgraph_viewer);
@@ -635,53 +635,67 @@ bool DnnlGraphTransformer::FastGeluFormulaCommon(DnnlSubgraph& subgraph, const o
   return true;
 }
 
-void DnnlGraphTransformer::ConvRelu(DnnlSubgraph& subgraph) {
-  // global index of convrelu
-  static int conv_relu_index = 0;
-
-  // traverse with max index as there will be empty nodes due to fusion
+void DnnlGraphTransformer::ConvBinaryEltwise(DnnlSubgraph& subgraph) {
+  static int fused_index = 0;
   size_t max_index = subgraph.GetMaxNodeIndex();
   for (size_t index = 0; index < max_index; index++) {
+    std::vector<size_t> conv_binary_eltwise_indices = {};
     auto dnnl_node = subgraph.GetDnnlNode(index);
+    auto attr_node = dnnl_node;
 
-    // look for conv relu pattern
-    if (dnnl_node == nullptr) {
-      continue;
-    }
-
-    if (dnnl_node->OpType() != "Conv") {
+    if (dnnl_node == nullptr || dnnl_node->OpType() != "Conv") {
       continue;
     }
 
     if (!IsNodeFusable(subgraph, dnnl_node)) {
       continue;
     }
-
-    auto next_dnnl_node = dnnl_node->Output(0).GetConsumers()[0].GetNode();
-    if (next_dnnl_node == nullptr) {
-      continue;
+    auto conv_node = dnnl_node;
+    auto fused_node_inputs = dnnl_node->Inputs();
+    // the inputs of the binary post ops follow the optional bias
+    if (fused_node_inputs.size() < 3) {
+      fused_node_inputs.resize(3, nullptr);
     }
-    if (next_dnnl_node->OpType() != "Relu") {
+    conv_binary_eltwise_indices.push_back(dnnl_node->Index());
+
+    dnnl_node = FuseBinaryEltwisePostOps(subgraph,
+                                         dnnl_node,
+                                         conv_binary_eltwise_indices,
+                                         fused_node_inputs,
+                                         attr_node);
+
+    if (!(conv_binary_eltwise_indices.size() > 1)) {
+      conv_binary_eltwise_indices.clear();
       continue;
     }
 
     // construct new node
-    auto new_node = std::make_unique<DnnlNode>();
-    new_node->Name() = dnnl_node->Name() + "_ConvRelu_" + std::to_string(conv_relu_index++);
-    new_node->OpType() = "ConvRelu";
-    for (auto def : dnnl_node->Inputs()) {
-      new_node->Inputs().push_back(def);
+    auto fused_node = std::make_unique<DnnlNode>();
+    fused_node->Name() = "ConvPostOps_fusion" + std::to_string(fused_index++);
+    for (size_t i : conv_binary_eltwise_indices) {
+      if (subgraph.GetDnnlNode(i)->OpType() != "Conv") {
+        fused_node->AppendPostOp(subgraph.GetDnnlNode(i)->OpType());
+      }
     }
-    for (auto def : next_dnnl_node->Outputs()) {
-      new_node->Outputs().push_back(def);
+    fused_node->OpType() = "ConvPostOps";
+    fused_node->Inputs() = fused_node_inputs;
+    fused_node->Outputs() = {dnnl_node->Outputs()[0]};
+
+    // the attributes of the Conv, and the alpha of the Elu or LeakyRelu post op if there is one
+    fused_node->Attributes().insert(conv_node->Attributes());
+    if (attr_node != conv_node) {
+      fused_node->Attributes().insert(attr_node->Attributes());
     }
-    new_node->Attributes().insert(dnnl_node->Attributes());
 
-    // insert new node, remove original nodes, connect new edges
     if (debug_log_) {
-      LOGS_DEFAULT(ERROR) << "ConvRelu fusion of [" << dnnl_node->Name() << "] and [" << next_dnnl_node->Name() << "]";
+      std::stringstream ss;
+      for (size_t i : conv_binary_eltwise_indices) {
+        ss << subgraph.GetDnnlNode(i)->OpType() << "[" << subgraph.GetDnnlNode(i)->Name() << "] ";
+      }
+      LOGS_DEFAULT(ERROR) << fused_node->OpType() << "[" << fused_node->Name() << "] fusion of " << ss.str();
     }
-    ResolveFusion(subgraph, {dnnl_node->Index(), next_dnnl_node->Index()}, std::move(new_node));
+    // insert new node, remove original nodes, connect new edges
+    ResolveFusion(subgraph, conv_binary_eltwise_indices, std::move(fused_node));
   }
 }
 
@@ -0,0 +1,22 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/providers/js/js_kernel.h"
+#include "core/common/gsl.h"
+
+namespace onnxruntime {
+namespace js {
+
+class Concat final : public JsKernel {
+ public:
+  Concat(const OpKernelInfo& info) : JsKernel(info) {
+    // "axis" is optional with a default of 1 in Concat-1 only. the schema requires it in later versions.
+    int64_t axis = info.GetAttrOrDefault<int64_t>("axis", 1);
+    JSEP_INIT_KERNEL_ATTRIBUTE(Concat, ({"axis" : $1}), gsl::narrow_cast<int32_t>(axis));
+  }
+};
+
+}  // namespace js
+}  // namespace onnxruntime
@@ -0,0 +1,27 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/providers/js/js_kernel.h"
+#include "core/common/gsl.h"
+
+namespace onnxruntime {
+namespace js {
+
+class LayerNorm final : public JsKernel {
+ public:
+  LayerNorm(const OpKernelInfo& info) : JsKernel(info) {
+    int64_t axis = info.GetAttrOrDefault<int64_t>("axis", -1);
+    float epsilon = info.GetAttrOrDefault<float>("epsilon", 1e-05f);
+    JSEP_INIT_KERNEL_ATTRIBUTE(LayerNormalization, ({
+                                 "axis" : $1,
+                                 "epsilon" : $2
+                               }),
+                               gsl::narrow_cast<int32_t>(axis),
+                               static_cast<double>(epsilon));
+  }
+};
+
+}  // namespace js
+}  // namespace onnxruntime
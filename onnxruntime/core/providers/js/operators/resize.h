@@ -0,0 +1,38 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/providers/js/js_kernel.h"
+#include "core/common/gsl.h"
+#include "core/providers/cpu/tensor/upsamplebase.h"
+
+namespace onnxruntime {
+namespace js {
+
+class Resize final : public JsKernel, public UpsampleBase {
+ public:
+  Resize(const OpKernelInfo& info) : JsKernel(info), UpsampleBase(info) {
+    // roi, scales and sizes are kept on CPU. scales from a constant initializer are parsed here already.
+    std::vector<float> scales;
+    if (scales_cached_) {
+      scales = scales_;
+    }
+    JSEP_INIT_KERNEL_ATTRIBUTE(Resize, ({
+                                 "opset" : $1,
+                                 "mode" : $2,
+                                 "coordinateTransformMode" : $3,
+                                 "nearestMode" : $4,
+                                 "scales" : $5 ? Array.from(HEAPF32.subarray($6, $6 + $5)) : []
+                               }),
+                               static_cast<int32_t>(info.node().SinceVersion()),
+                               static_cast<int32_t>(mode_),
+                               static_cast<int32_t>(coordinate_transform_mode_),
+                               static_cast<int32_t>(nearest_mode_),
+                               gsl::narrow_cast<int32_t>(scales.size()),
+                               reinterpret_cast<int32_t>(scales.empty() ? nullptr : scales.data()) >> 2);
+  }
+};
+
+}  // namespace js
+}  // namespace onnxruntime
@@ -0,0 +1,49 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <algorithm>
+#include <limits>
+
+#include "core/providers/js/js_kernel.h"
+#include "core/common/gsl.h"
+
+namespace onnxruntime {
+namespace js {
+
+class Slice final : public JsKernel {
+ public:
+  Slice(const OpKernelInfo& info) : JsKernel(info) {
+    // Slice-1 takes "starts", "ends" and "axes" as attributes. the later versions take them as inputs, which are kept
+    // on CPU and read by the kernel at run time.
+    std::vector<int32_t> starts = ToInt32(info.GetAttrsOrDefault<int64_t>("starts"));
+    std::vector<int32_t> ends = ToInt32(info.GetAttrsOrDefault<int64_t>("ends"));
+    std::vector<int32_t> axes = ToInt32(info.GetAttrsOrDefault<int64_t>("axes"));
+    JSEP_INIT_KERNEL_ATTRIBUTE(Slice, ({
+                                 "starts" : $1 ? Array.from(HEAP32.subarray($2, $2 + $1)) : [],
+                                 "ends" : $3 ? Array.from(HEAP32.subarray($4, $4 + $3)) : [],
+                                 "axes" : $5 ? Array.from(HEAP32.subarray($6, $6 + $5)) : []
+                               }),
+                               gsl::narrow_cast<int32_t>(starts.size()),
+                               reinterpret_cast<int32_t>(starts.empty() ? nullptr : starts.data()) >> 2,
+                               gsl::narrow_cast<int32_t>(ends.size()),
+                               reinterpret_cast<int32_t>(ends.empty() ? nullptr : ends.data()) >> 2,
+                               gsl::narrow_cast<int32_t>(axes.size()),
+                               reinterpret_cast<int32_t>(axes.empty() ? nullptr : axes.data()) >> 2);
+  }
+
+ private:
+  // "ends" is commonly INT64_MAX to slice to the end of a dimension, so the values are clamped rather than narrowed
+  static std::vector<int32_t> ToInt32(const std::vector<int64_t>& values) {
+    std::vector<int32_t> result(values.size());
+    std::transform(values.begin(), values.end(), result.begin(), [](int64_t value) {
+      return static_cast<int32_t>(std::clamp<int64_t>(value, std::numeric_limits<int32_t>::min(),
+                                                      std::numeric_limits<int32_t>::max()));
+    });
+    return result;
+  }
+};
+
+}  // namespace js
+}  // namespace onnxruntime
@@ -0,0 +1,29 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/providers/js/js_kernel.h"
+#include "core/common/gsl.h"
+
+namespace onnxruntime {
+namespace js {
+
+class Softmax final : public JsKernel {
+ public:
+  Softmax(const OpKernelInfo& info) : JsKernel(info) {
+    // Softmax-13 normalizes along "axis" (default -1). the earlier versions coerce the input into 2D at "axis"
+    // (default 1) and normalize the rows.
+    const bool coerce_to_2d = info.node().SinceVersion() < 13;
+    int64_t axis = info.GetAttrOrDefault<int64_t>("axis", coerce_to_2d ? 1 : -1);
+    JSEP_INIT_KERNEL_ATTRIBUTE(Softmax, ({
+                                 "axis" : $1,
+                                 "coerceTo2D" : !!$2
+                               }),
+                               gsl::narrow_cast<int32_t>(axis),
+                               static_cast<int32_t>(coerce_to_2d));
+  }
+};
+
+}  // namespace js
+}  // namespace onnxruntime
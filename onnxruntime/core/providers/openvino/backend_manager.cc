@@ -267,8 +267,14 @@ void BackendManager::Compute(OrtKernelContext* context) {
     auto key = MakeMapKeyString(tensor_shapes, GetGlobalContext().device_type);
 
     std::shared_ptr<IBackend> dynamic_backend;
-    auto search = backend_map_.find(key);
-    if (search == backend_map_.end()) {
+    {
+      std::lock_guard<std::mutex> lock(backend_map_mutex_);
+      auto search = backend_map_.find(key);
+      if (search != backend_map_.end()) {
+        dynamic_backend = search->second;
+      }
+    }
+    if (dynamic_backend == nullptr) {
       LOGS_DEFAULT(INFO) << "[OpenVINO-EP] "
                          << "Creating concrete backend for key: " << key;
       LOGS_DEFAULT(INFO) << "[OpenVINO-EP] "
@@ -281,9 +287,9 @@ void BackendManager::Compute(OrtKernelContext* context) {
       } catch (std::string const& msg) {
         throw msg;
       }
-      backend_map_.insert({key, dynamic_backend});
-    } else {
-      dynamic_backend = search->second;
+      // a run of the same shape may have added its backend meanwhile, and keeps it
+      std::lock_guard<std::mutex> lock(backend_map_mutex_);
+      dynamic_backend = backend_map_.insert({key, dynamic_backend}).first->second;
     }
 
     dynamic_backend->Infer(context);
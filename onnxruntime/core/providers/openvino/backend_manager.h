@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <mutex>
+
 #include "ov_interface.h"
 #include "contexts.h"
 #include "ibackend.h"
@@ -35,6 +37,8 @@ class BackendManager {
   std::unique_ptr<ONNX_NAMESPACE::ModelProto> model_proto_;
   std::shared_ptr<IBackend> concrete_backend_;
   std::map<std::string, std::shared_ptr<IBackend>> backend_map_;
+  // the concurrent runs look up and add backends of the input shapes
+  std::mutex backend_map_mutex_;
   SubGraphContext subgraph_context_;
 };
 
@@ -1,6 +1,8 @@
 // Copyright (C) 2019-2022 Intel Corporation
 // Licensed under the MIT License
 
+#include <cstdio>
+#include <iomanip>
 #include <map>
 #include <string>
 #include <memory>
@@ -8,6 +10,7 @@
 #include <fstream>
 
 #include "core/providers/shared_library/provider_api.h"
+#include "core/framework/murmurhash3.h"
 #include "../backend_utils.h"
 #include <ngraph/pass/constant_folding.hpp>
 #include "basic_backend.h"
@@ -44,8 +47,12 @@ BasicBackend::BasicBackend(const ONNX_NAMESPACE::ModelProto& model_proto,
     model_proto.SerializeToOstream(outfile);
   }
 #endif
+  const std::string blob_path = GetBlobPath(model_proto, hw_target);
+  const bool blob_imported = !blob_path.empty() && ImportBlob(blob_path, hw_target, device_config);
   try {
-    if (global_context.is_wholly_supported_graph) {
+    if (blob_imported) {
+      LOGS_DEFAULT(INFO) << log_tag << "Loaded model to the plugin from " << blob_path;
+    } else if (global_context.is_wholly_supported_graph) {
 #if defined(IO_BUFFER_ENABLED)
       if ((global_context.device_type.find("GPU") != std::string::npos) &&
           (global_context_.context != nullptr)) {
@@ -85,6 +92,9 @@ BasicBackend::BasicBackend(const ONNX_NAMESPACE::ModelProto& model_proto,
   } catch (const char* msg) {
     throw(msg);
   }
+  if (!blob_path.empty() && !blob_imported) {
+    ExportBlob(blob_path);
+  }
 
   // The infer_requests_ pool will be intialized with a default value of 8 infer_request's
   // The nireq value can also be configured to any num_of_threads during runtime
@@ -108,6 +118,77 @@ bool BasicBackend::ValidateSubgraph(std::map<std::string, std::shared_ptr<ngraph
   return false;
 }
 
+// The compiled model of a wholly supported graph is all its backend needs, so it is exported to cache_dir under the
+// hash of the subgraph, the device and the OpenVINO build. The next sessions import it instead of converting and
+// compiling the subgraph again, which is most of the start up time on GPU and VPUX.
+std::string BasicBackend::GetBlobPath(const ONNX_NAMESPACE::ModelProto& model_proto, const std::string& hw_target) {
+  if (global_context_.cache_dir.empty() || !global_context_.is_wholly_supported_graph ||
+      (subgraph_context_.has_dynamic_input_shape && global_context_.enable_dynamic_shapes)) {
+    return "";
+  }
+#if defined(IO_BUFFER_ENABLED)
+  // the remote context is bound to the network at compile time
+  if (global_context_.context != nullptr) {
+    return "";
+  }
+#endif
+
+  uint32_t hash[4] = {0, 0, 0, 0};
+  auto hash_str = [&hash](const std::string& str) {
+    MurmurHash3::x86_128(str.data(), gsl::narrow_cast<int32_t>(str.size()), hash[0], &hash);
+  };
+  hash_str(model_proto.SerializeAsString());
+  hash_str(hw_target);
+  hash_str(global_context_.precision_str);
+  hash_str(global_context_.enable_opencl_throttling ? "opencl_throttling" : "");
+  hash_str(ov::get_openvino_version().buildNumber);
+
+  std::ostringstream blob_path;
+  blob_path << global_context_.cache_dir << "/" << std::hex << std::setfill('0') << std::setw(8) << hash[1]
+            << std::setw(8) << hash[0] << ".blob";
+  return blob_path.str();
+}
+
+bool BasicBackend::ImportBlob(const std::string& blob_path, std::string& hw_target, ov::AnyMap& device_config) {
+  std::ifstream blob(blob_path, std::ios::in | std::ios::binary);
+  if (!blob) {
+    return false;
+  }
+  try {
+    exe_network_ = global_context_.ie_core.ImportModel(blob, hw_target, device_config, subgraph_context_.subgraph_name);
+  } catch (std::string const& msg) {
+    // the subgraph is compiled again, and its blob replaced
+    LOGS_DEFAULT(WARNING) << log_tag << "Could not import " << blob_path << ": " << msg;
+    return false;
+  }
+  return true;
+}
+
+void BasicBackend::ExportBlob(const std::string& blob_path) {
+  // written next to the blob and renamed, so that the sessions starting meanwhile never import part of a blob
+  std::ostringstream tmp_path;
+  tmp_path << blob_path << "." << static_cast<const void*>(this) << ".tmp";
+  try {
+    {
+      std::ofstream blob(tmp_path.str(), std::ios::out | std::ios::trunc | std::ios::binary);
+      if (!blob) {
+        LOGS_DEFAULT(WARNING) << log_tag << "Could not write the blob cache to " << global_context_.cache_dir;
+        return;
+      }
+      exe_network_.ExportModel(blob);
+    }
+    if (std::rename(tmp_path.str().c_str(), blob_path.c_str()) != 0) {
+      std::remove(tmp_path.str().c_str());
+      return;
+    }
+    LOGS_DEFAULT(INFO) << log_tag << "Exported the compiled model to " << blob_path;
+  } catch (std::string const& msg) {
+    // some devices can not export their compiled models
+    std::remove(tmp_path.str().c_str());
+    LOGS_DEFAULT(WARNING) << log_tag << msg;
+  }
+}
+
 void BasicBackend::PopulateConfigValue(ov::AnyMap& device_config) {
   // Set inference precision if device_type != AUTO
   // if (global_context_.device_type.find("GPU_FP16")!= std::string::npos){
@@ -410,33 +491,24 @@ void BasicBackend::Infer(OrtKernelContext* ctx) {
     OVInferRequestPtr infer_request;
     infer_request = inferRequestsQueue_->getIdleRequest();
 
+    // The concurrent runs each take a request of the pool, so their inferences are in flight on the device together.
+    // A request is put back into the pool when its run fails too, or the pool runs dry and the next runs wait forever.
+    try {
 #ifdef IO_BUFFER_ENABLED
-    if ((global_context_.device_type.find("GPU") != std::string::npos) &&
-        (global_context_.context != nullptr) &&
-        (openvino_ep::BackendManager::GetGlobalContext().is_wholly_supported_graph)) {
-      try {
+      if ((global_context_.device_type.find("GPU") != std::string::npos) &&
+          (global_context_.context != nullptr) &&
+          (openvino_ep::BackendManager::GetGlobalContext().is_wholly_supported_graph)) {
         StartRemoteAsyncInference(context, infer_request);
-      } catch (std::string const& msg) {
-        throw msg;
-      }
-    } else {
-      try {
+      } else {
         StartAsyncInference(context, infer_request);
-      } catch (std::string const& msg) {
-        throw msg;
       }
-    }
 #else
-    try {
       StartAsyncInference(context, infer_request);
-    } catch (std::string const& msg) {
-      throw msg;
-    }
 #endif
-    try {
       CompleteAsyncInference(context, infer_request);
-    } catch (std::string const& msg) {
-      throw msg;
+    } catch (...) {
+      inferRequestsQueue_->putIdleRequest(infer_request);
+      throw;
     }
 
     // Get Output tensors
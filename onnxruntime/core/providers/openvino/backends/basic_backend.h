@@ -29,8 +29,9 @@ class BasicBackend : public IBackend {
   void Infer(OrtKernelContext* context) override;
 
  private:
-  bool ImportBlob(std::string hw_target, bool vpu_status);
-  void PopulateCompiledDirectory(std::string, std::string&, std::string&, bool&);
+  std::string GetBlobPath(const ONNX_NAMESPACE::ModelProto& model_proto, const std::string& hw_target);
+  bool ImportBlob(const std::string& blob_path, std::string& hw_target, ov::AnyMap& device_config);
+  void ExportBlob(const std::string& blob_path);
   bool ValidateSubgraph(std::map<std::string, std::shared_ptr<ngraph::Node>>& const_outputs_map);
   void PopulateConfigValue(ov::AnyMap& device_config);
   void EnableCaching();
@@ -57,6 +57,17 @@ OVExeNetwork OVCore::LoadNetwork(const std::string& model, std::string& hw_targe
 }
 #endif
 
+OVExeNetwork OVCore::ImportModel(std::istream& model_stream, std::string& hw_target, ov::AnyMap& device_config, std::string name) {
+  try {
+    auto obj = oe.import_model(model_stream, hw_target, device_config);
+    return OVExeNetwork(obj);
+  } catch (const Exception& e) {
+    throw std::string(log_tag + " Exception while Importing Network for graph: " + name + e.what());
+  } catch (...) {
+    throw std::string(log_tag + " Exception while Importing Network for graph " + name);
+  }
+}
+
 void OVCore::SetCache(std::string cache_dir_path) {
   oe.set_property(ov::cache_dir(cache_dir_path));
 }
@@ -91,6 +102,16 @@ OVInferRequest OVExeNetwork::CreateInferRequest() {
   }
 }
 
+void OVExeNetwork::ExportModel(std::ostream& model_stream) {
+  try {
+    obj.export_model(model_stream);
+  } catch (const Exception& e) {
+    throw std::string(log_tag + "Exception while exporting the compiled model: " + e.what());
+  } catch (...) {
+    throw std::string(log_tag + "Exception while exporting the compiled model.");
+  }
+}
+
 OVTensorPtr OVInferRequest::GetTensor(const std::string& input_name) {
   try {
     auto tobj = ovInfReq.get_tensor(input_name);
@@ -18,6 +18,7 @@
 #include <openvino/runtime/intel_gpu/ocl/ocl.hpp>
 #endif
 
+#include <iostream>
 #include <string>
 
 namespace onnxruntime {
@@ -48,6 +49,7 @@ class OVCore {
 #if defined(OPENVINO_2023_0)
   OVExeNetwork LoadNetwork(const std::string& model_stream, std::string& hw_target, ov::AnyMap& device_config, std::string name);
 #endif
+  OVExeNetwork ImportModel(std::istream& model_stream, std::string& hw_target, ov::AnyMap& device_config, std::string name);
   void SetCache(std::string cache_dir_path);
 #ifdef IO_BUFFER_ENABLED
   OVExeNetwork LoadNetwork(std::shared_ptr<OVNetwork>& model, OVRemoteContextPtr context, std::string& name);
@@ -66,6 +68,7 @@ class OVExeNetwork {
   OVExeNetwork() { obj = ov::CompiledModel(); }
   ov::CompiledModel& Get() { return obj; }
   OVInferRequest CreateInferRequest();
+  void ExportModel(std::ostream& model_stream);
 };
 
 class OVInferRequest {
@@ -416,7 +416,40 @@ Status QnnBackendManager::DumpQnnContext(const std::string& model_name, const st
   return Status::OK();
 }
 
-Status QnnBackendManager::LoadCachedQnnContext(QnnModel& qnn_model) {
+/* \brief: Find the model whose outputs are the outputs of the graph from the cached context.
+ *  The graphs of the context are not in the order of the partitions, but each output name belongs to one partition.
+ * \param[in] graph_info - graph info from the cached context binary
+ * \param[in] qnn_models - one model per partition, with the Ort graph inputs and outputs set
+ * \param[out] model_index - index of the matching model
+ */
+static Status MatchCachedGraphToModel(const QnnSystemContext_GraphInfo_t& graph_info,
+                                      const std::vector<QnnModel*>& qnn_models,
+                                      size_t& model_index) {
+  ORT_RETURN_IF(graph_info.version != QNN_SYSTEM_CONTEXT_GRAPH_INFO_VERSION_1,
+                "Unsupported graph info version from Qnn cached context.");
+  const auto output_num = graph_info.graphInfoV1.numGraphOutputs;
+  const Qnn_Tensor_t* output_tensors = graph_info.graphInfoV1.graphOutputs;
+  ORT_RETURN_IF(nullptr == output_tensors, "Graph from cached context doesn't have any outputs.");
+
+  for (size_t i = 0; i < qnn_models.size(); ++i) {
+    if (qnn_models[i]->GetOutputCount() != output_num) {
+      continue;
+    }
+    bool all_found = true;
+    for (size_t j = 0; j < output_num && all_found; ++j) {
+      all_found = qnn_models[i]->HasOutput(GetQnnTensorName(output_tensors[j]));
+    }
+    if (all_found) {
+      model_index = i;
+      return Status::OK();
+    }
+  }
+
+  return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Graph ", graph_info.graphInfoV1.graphName,
+                         " from Qnn cached context doesn't match any partition of the model.");
+}
+
+Status QnnBackendManager::LoadCachedQnnContext(std::vector<QnnModel*>& qnn_models) {
   bool result = nullptr == qnn_sys_interface_.systemContextCreate ||
                 nullptr == qnn_sys_interface_.systemContextGetBinaryInfo ||
                 nullptr == qnn_sys_interface_.systemContextFree;
@@ -472,8 +505,9 @@ Status QnnBackendManager::LoadCachedQnnContext(QnnModel& qnn_model) {
     graphs_info = binary_info->contextBinaryInfoV2.graphs;
   }
 
-  ORT_RETURN_IF(graph_count > 1, "Load from Qnn cached context only support 1 sub-graph.");
   ORT_RETURN_IF(graphs_info == nullptr, "Failed to get graph info from Qnn cached context.");
+  ORT_RETURN_IF(graph_count != qnn_models.size(), "Qnn cached context has ", graph_count,
+                " graphs, but the model has ", qnn_models.size(), " partitions.");
 
   ORT_RETURN_IF(nullptr == qnn_interface_.contextCreateFromBinary,
                 "Invalid function pointer for contextCreateFromBinary.");
@@ -486,7 +520,19 @@ Status QnnBackendManager::LoadCachedQnnContext(QnnModel& qnn_model) {
                                               profile_backend_handle_);
   ORT_RETURN_IF(QNN_SUCCESS != rt, "Failed to create context from binary.");
 
-  ORT_RETURN_IF_ERROR(qnn_model.DeserializeGraphInfoFromBinaryInfo(graphs_info[0]));
+  // All the graphs are in the one context, so the partitions share the weights loaded with it
+  if (1 == graph_count) {
+    ORT_RETURN_IF_ERROR(qnn_models[0]->DeserializeGraphInfoFromBinaryInfo(graphs_info[0]));
+  } else {
+    std::vector<bool> model_bound(qnn_models.size(), false);
+    for (uint32_t i = 0; i < graph_count; ++i) {
+      size_t model_index = 0;
+      ORT_RETURN_IF_ERROR(MatchCachedGraphToModel(graphs_info[i], qnn_models, model_index));
+      ORT_RETURN_IF(model_bound[model_index], "More than one graph from Qnn cached context match the same partition.");
+      model_bound[model_index] = true;
+      ORT_RETURN_IF_ERROR(qnn_models[model_index]->DeserializeGraphInfoFromBinaryInfo(graphs_info[i]));
+    }
+  }
 
   qnn_sys_interface_.systemContextFree(sys_ctx_handle);
   sys_ctx_handle = nullptr;
@@ -578,6 +624,20 @@ Status QnnBackendManager::GetMetadataFromOrtContextFile() {
   return Status::OK();
 }
 
+bool QnnBackendManager::IsOrtGeneratedContextCache() {
+  if (!ctx_file_exists_) {
+    return false;
+  }
+
+  auto status = GetMetadataFromOrtContextFile();
+  if (!status.IsOK()) {
+    LOGS_DEFAULT(WARNING) << "Failed to read metadata from context cache file: " << status.ErrorMessage();
+    return false;
+  }
+
+  return ort_generated_ctx_cache_;
+}
+
 /* \brief: Validate the model file name and graph name with Ort generated context cache metadata
  * \param[in] model_name - model file name
  * \param[in] graph_name - graph name, e.g Ort_QNN_[hash_id]_[id]. Since GetCapability is called twice,
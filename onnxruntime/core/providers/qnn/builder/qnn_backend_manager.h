@@ -71,7 +71,9 @@ class QnnBackendManager {
 
   Status DumpQnnContext(const std::string& model_name, const std::string& graph_name);
 
-  Status LoadCachedQnnContext(QnnModel& qnn_model);
+  // Creates the context from the cache file and binds each of its graphs to one of the qnn_models,
+  // one model per partition of the session. All the graphs share the context and its weights.
+  Status LoadCachedQnnContext(std::vector<QnnModel*>& qnn_models);
 
   Status GetMetadataFromOrtContextFile();
 
@@ -135,6 +137,9 @@ class QnnBackendManager {
                                 const std::string& model_description,
                                 const onnxruntime::PathString& model_pathstring);
 
+  // The cache file was dumped by Ort, so the partitions it holds come from the regular capability check
+  bool IsOrtGeneratedContextCache();
+
  private:
   void* LoadLib(const char* file_name, int flags, std::string& error_msg);
 
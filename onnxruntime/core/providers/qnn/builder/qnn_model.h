@@ -44,6 +44,12 @@ class QnnModel {
     return &(it->second);
   }
 
+  bool HasOutput(const std::string& name) const {
+    return outputs_info_.find(name) != outputs_info_.end();
+  }
+
+  size_t GetOutputCount() const { return outputs_info_.size(); }
+
   Status SetGraphInputOutputInfo(const GraphViewer& graph_viewer,
                                  const onnxruntime::Node& fused_node);
   Status ParseGraphInputOrOutput(ConstPointerContainer<std::vector<NodeArg*>>& input_output_defs,
@@ -211,9 +211,9 @@ QNNExecutionProvider::GetSupportedNodes(const GraphViewer& graph_viewer,
                                         bool load_from_cached_context,
                                         const logging::Logger& logger) const {
   std::unordered_set<const Node*> supported_nodes{};
-  // Enable Qnn context cache requires the whole graph partitioned to Qnn EP
-  // Blindly filter in all nodes if context cache is enabled
-  if (load_from_cached_context) {
+  // A context binary from the Qnn toolchain covers the whole graph, blindly filter in all nodes for it.
+  // The context dumped by Ort holds the partitions of the regular check below, which may be more than one.
+  if (load_from_cached_context && !qnn_backend_manager_->IsOrtGeneratedContextCache()) {
     for (const auto& node : graph_viewer.Nodes()) {
       supported_nodes.insert(&node);
     }
@@ -355,7 +355,8 @@ QNNExecutionProvider::GetCapability(const onnxruntime::GraphViewer& graph_viewer
       });
   const size_t num_nodes_in_graph = static_cast<size_t>(graph_viewer.NumberOfNodes());
 
-  if (load_from_cached_context && 1 == num_of_partitions) {
+  // The name of the first partition is dumped as the graph name of the context cache
+  if (load_from_cached_context && num_of_partitions > 0) {
     rt = qnn_backend_manager_->ValidateWithContextFile(GetFileNameFromModelPath(graph_viewer.ModelPath()),
                                                        result[0]->sub_graph->GetMetaDef()->name);
     if (Status::OK() != rt) {
@@ -364,10 +365,6 @@ QNNExecutionProvider::GetCapability(const onnxruntime::GraphViewer& graph_viewer
     }
   }
 
-  if (num_of_partitions > 1) {
-    ORT_ENFORCE(!context_cache_enabled_, "Only support single partition for context cache feature.");
-  }
-
   const auto summary_msg = MakeString("Number of partitions supported by QNN EP: ", num_of_partitions,
                                       ", number of nodes in the graph: ", num_nodes_in_graph,
                                       ", number of nodes supported by QNN: ", num_of_supported_nodes);
@@ -441,38 +438,49 @@ Status QNNExecutionProvider::Compile(const std::vector<FusedNodeAndGraph>& fused
   bool is_npu_backend = qnn_backend_manager_->IsNpuBackend();
 
   if (context_cache_enabled_) {
-    ORT_ENFORCE(fused_nodes_and_graphs.size() == 1, "Only support singel partition for context cache feature.");
-    Node& fused_node = fused_nodes_and_graphs[0].fused_node;
-    const onnxruntime::GraphViewer& graph_viewer(fused_nodes_and_graphs[0].filtered_graph);
+    const onnxruntime::GraphViewer& main_graph_viewer(fused_nodes_and_graphs[0].filtered_graph);
     // The dumy_model_description won't be used since IsContextCacheFileExists call cached the result
     // The graph_viewer.Description here is not same with original model
     std::string dumy_model_description = "";
     bool load_from_cached_context = qnn_backend_manager_->IsContextCacheFileExists(context_cache_path_,
                                                                                    dumy_model_description,
-                                                                                   graph_viewer.ModelPath().ToPathString());
+                                                                                   main_graph_viewer.ModelPath().ToPathString());
     // Load and execute from cached context if exist
     if (load_from_cached_context) {
-      std::unique_ptr<qnn::QnnModel> qnn_model = std::make_unique<qnn::QnnModel>(logger,
-                                                                                 qnn_backend_manager_.get(),
-                                                                                 is_npu_backend);
-      ORT_RETURN_IF_ERROR(qnn_backend_manager_->LoadCachedQnnContext(*(qnn_model.get())));
-      ORT_RETURN_IF_ERROR(qnn_model->SetGraphInputOutputInfo(graph_viewer, fused_node));
-      ORT_RETURN_IF_ERROR(qnn_model->SetupQnnInputOutput());
-
-      // fused node name is QNNExecutionProvider_QNN_[hash_id]_[id]
-      // the name here should be same with context->node_name in compute_info
-      LOGS(logger, VERBOSE) << "fused node name: " << fused_node.Name();
-      qnn_models_.emplace(fused_node.Name(), std::move(qnn_model));
-
-      ORT_RETURN_IF_ERROR(CreateComputeFunc(node_compute_funcs, logger));
+      // One QnnModel per partition, the graphs of all the partitions are in the one cached context
+      std::vector<std::unique_ptr<qnn::QnnModel>> qnn_models;
+      std::vector<qnn::QnnModel*> qnn_model_ptrs;
+      for (const auto& fused_node_and_graph : fused_nodes_and_graphs) {
+        auto qnn_model = std::make_unique<qnn::QnnModel>(logger, qnn_backend_manager_.get(), is_npu_backend);
+        ORT_RETURN_IF_ERROR(qnn_model->SetGraphInputOutputInfo(fused_node_and_graph.filtered_graph,
+                                                               fused_node_and_graph.fused_node));
+        qnn_model_ptrs.push_back(qnn_model.get());
+        qnn_models.push_back(std::move(qnn_model));
+      }
+
+      ORT_RETURN_IF_ERROR(qnn_backend_manager_->LoadCachedQnnContext(qnn_model_ptrs));
+
+      for (size_t i = 0; i < fused_nodes_and_graphs.size(); ++i) {
+        const Node& fused_node = fused_nodes_and_graphs[i].fused_node;
+        ORT_RETURN_IF_ERROR(qnn_models[i]->SetupQnnInputOutput());
+
+        // fused node name is QNNExecutionProvider_QNN_[hash_id]_[id]
+        // the name here should be same with context->node_name in compute_info
+        LOGS(logger, VERBOSE) << "fused node name: " << fused_node.Name();
+        qnn_models_.emplace(fused_node.Name(), std::move(qnn_models[i]));
+
+        ORT_RETURN_IF_ERROR(CreateComputeFunc(node_compute_funcs, logger));
+      }
       return Status::OK();
     } else {
       // Load and execute from Onnx model if not exit and dump the context
+      // All the partitions are composed into the one context, which is dumped once
       ORT_RETURN_IF_ERROR(CompileFromOrtGraph(fused_nodes_and_graphs, node_compute_funcs, logger));
       // graph_viewer.Name() is generated in GetCapability, e.g QNN_[hash_id]_[id]
-      // dump graph_viewer.Name() as metadata in context cache binary file, so that we can validate it in GetCapability
-      ORT_RETURN_IF_ERROR(qnn_backend_manager_->DumpQnnContext(GetFileNameFromModelPath(graph_viewer.ModelPath()),
-                                                               graph_viewer.Name()));
+      // dump the name of the first partition as metadata in context cache binary file, so that we can validate it
+      // in GetCapability
+      ORT_RETURN_IF_ERROR(qnn_backend_manager_->DumpQnnContext(GetFileNameFromModelPath(main_graph_viewer.ModelPath()),
+                                                               main_graph_viewer.Name()));
     }
     return Status::OK();
   }
@@ -88,6 +88,32 @@ Status MiopenTensor::Set(gsl::span<const int64_t> input_dims, miopenDataType_t d
   return Status::OK();
 }
 
+Status MiopenTensor::Set(gsl::span<const int64_t> input_dims, miopenDataType_t dataType, bool is_nhwc) {
+  if (!is_nhwc) {
+    return Set(input_dims, dataType);
+  }
+
+  ORT_RETURN_IF_ERROR(CreateTensorIfNeeded());
+
+  int rank = gsl::narrow_cast<int>(input_dims.size());
+  ORT_RETURN_IF_NOT(rank >= 3, "NHWC tensors need a batch, a channel and at least one spatial dimension.");
+  InlinedVector<int> dims(rank);
+  InlinedVector<int> strides(rank);
+  for (int i = 0; i < rank; i++) {
+    dims[i] = gsl::narrow_cast<int>(input_dims[i]);
+  }
+  // the channels are innermost, followed by the spatial dimensions and the batch
+  int64_t pitch = input_dims[1];
+  strides[1] = 1;
+  for (int i = rank - 1; i >= 2; i--) {
+    strides[i] = gsl::narrow_cast<int>(pitch);
+    pitch *= input_dims[i];
+  }
+  strides[0] = gsl::narrow_cast<int>(pitch);
+  MIOPEN_RETURN_IF_ERROR(miopenSetTensorDescriptor(tensor_, dataType, static_cast<int>(rank), dims.data(), strides.data()));
+  return Status::OK();
+}
+
 Status MiopenTensor::Set(miopenDataType_t dataType, miopenTensorLayout_t tensor_layout, int n, int c, int h, int w) {
   ORT_RETURN_IF_ERROR(CreateTensorIfNeeded());
 
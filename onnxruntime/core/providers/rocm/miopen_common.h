@@ -34,6 +34,8 @@ class MiopenTensor final {
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(MiopenTensor);
 
   Status Set(gsl::span<const int64_t> input_dims, miopenDataType_t dataType);
+  // Set N-D tensor format with input_dims in NCHW order, for data in NCHW or in NHWC layout
+  Status Set(gsl::span<const int64_t> input_dims, miopenDataType_t dataType, bool is_nhwc);
   Status Set(miopenDataType_t dataType, miopenTensorLayout_t tensor_layout, int n, int c, int h, int w);
   Status Set(const MiopenTensor& x_desc, miopenBatchNormMode_t mode);
 
@@ -2,6 +2,9 @@
 // Licensed under the MIT License.
 
 #include "core/providers/rocm/nn/conv.h"
+
+#include <sstream>
+
 #include "core/common/span_utils.h"
 #include "core/providers/rocm/nn/conv_impl.h"
 #include "core/providers/rocm/rocm_common.h"
@@ -67,6 +70,51 @@ size_t GetMaxWorkspaceSize(miopenHandle_t handle, const MiopenConvState<miopenCo
   return max_ws_size;
 }
 
+std::string GetMiopenConvParamsSignature(gsl::span<const int64_t> x_dims, gsl::span<const int64_t> w_dims,
+                                        gsl::span<const int64_t> pads, gsl::span<const int64_t> strides,
+                                        gsl::span<const int64_t> dilations, int64_t group,
+                                        miopenDataType_t data_type, bool channels_last) {
+  std::ostringstream oss;
+  auto write_dims = [&oss](const char* name, gsl::span<const int64_t> dims) {
+    oss << name << "=";
+    for (size_t i = 0; i < dims.size(); ++i) {
+      oss << (i > 0 ? "x" : "") << dims[i];
+    }
+    oss << "_";
+  };
+  write_dims("x", x_dims);
+  write_dims("w", w_dims);
+  write_dims("p", pads);
+  write_dims("s", strides);
+  write_dims("d", dilations);
+  oss << "g=" << group << "_t=" << static_cast<int>(data_type) << "_nhwc=" << channels_last;
+  return oss.str();
+}
+
+// Looks up the solution of the algorithm picked by miopenFindConvolutionForwardAlgorithm, which records the solutions
+// it measured in the find-db. The solutions are sorted by their execution time.
+Status GetMiopenConvFwdSolution(miopenHandle_t handle, const MiopenConvState<miopenConvAlgoPerf_t>& s,
+                                miopenConvFwdAlgorithm_t algo, uint64_t& solution_id) {
+  solution_id = kNoMiopenSolution;
+  size_t solution_count = 0;
+  MIOPEN_RETURN_IF_ERROR(miopenConvolutionForwardGetSolutionCount(handle, s.w_desc, s.x_tensor, s.conv_desc,
+                                                                  s.y_tensor, &solution_count));
+  if (solution_count == 0) {
+    return Status::OK();
+  }
+
+  std::vector<miopenConvSolution_t> solutions(solution_count);
+  MIOPEN_RETURN_IF_ERROR(miopenConvolutionForwardGetSolution(handle, s.w_desc, s.x_tensor, s.conv_desc, s.y_tensor,
+                                                             solution_count, &solution_count, solutions.data()));
+  for (size_t i = 0; i < solution_count; ++i) {
+    if (static_cast<int>(solutions[i].algorithm) == static_cast<int>(algo)) {
+      solution_id = solutions[i].solution_id;
+      break;
+    }
+  }
+  return Status::OK();
+}
+
 Status SliceOutUnwantedOutputSection(hipStream_t stream,
                                      const void* input_data,
                                      const gsl::span<const int64_t>& input_dims,
@@ -280,6 +328,26 @@ Status Conv<T, NHWC>::UpdateState(OpKernelContext* context, bool bias_expected)
       HIP_CALL_THROW(hipMemsetAsync(s_.b_zero, 0, malloc_size, Stream(context)));
     }
 
+    if (!s_.cached_benchmark_fwd_results.contains(x_dims_miopen)) {
+      // A solution found in an earlier process, e.g. loaded with the tuning results stored in the model, is compiled
+      // and used without searching again.
+      auto& tuning_results_manager = GetTuningContext()->GetTuningResultsManager();
+      const std::string params_signature = GetMiopenConvParamsSignature(
+          x_dims_miopen, w_dims, pads, strides, dilations, conv_attrs_.group, MiopenTensor::GetDataType<HipT>(),
+          channels_last);
+      const int tuned_solution_id = tuning_results_manager.Lookup(kMiopenConvFwdOpSignature, params_signature);
+      if (tuned_solution_id >= 0) {
+        const auto solution_id = static_cast<uint64_t>(tuned_solution_id);
+        size_t workspace_bytes = 0;
+        MIOPEN_RETURN_IF_ERROR(miopenConvolutionForwardGetSolutionWorkspaceSize(
+            GetMiopenHandle(context), s_.w_desc, s_.x_tensor, s_.conv_desc, s_.y_tensor, solution_id,
+            &workspace_bytes));
+        MIOPEN_RETURN_IF_ERROR(miopenConvolutionForwardCompileSolution(
+            GetMiopenHandle(context), s_.w_desc, s_.x_tensor, s_.conv_desc, s_.y_tensor, solution_id));
+        s_.cached_benchmark_fwd_results.insert(x_dims_miopen, {kDefaultConvAlgo, workspace_bytes, solution_id});
+      }
+    }
+
     if (!s_.cached_benchmark_fwd_results.contains(x_dims_miopen)) {
       miopenConvAlgoPerf_t perf;
       int algo_count = 1;
@@ -303,10 +371,22 @@ Status Conv<T, NHWC>::UpdateState(OpKernelContext* context, bool bias_expected)
           algo_search_workspace.get(),
           max_ws_size,
           false));  // Do not do exhaustive algo search.
-      s_.cached_benchmark_fwd_results.insert(x_dims_miopen, {perf.fwd_algo, perf.memory});
+      s_.cached_benchmark_fwd_results.insert(x_dims_miopen, {perf.fwd_algo, perf.memory, kNoMiopenSolution});
+
+      // keep the solution with the tuning results, the algorithm found is used in this process
+      uint64_t solution_id;
+      ORT_RETURN_IF_ERROR(GetMiopenConvFwdSolution(GetMiopenHandle(context), s_, perf.fwd_algo, solution_id));
+      if (solution_id <= static_cast<uint64_t>(std::numeric_limits<int>::max())) {
+        GetTuningContext()->GetTuningResultsManager().Add(
+            kMiopenConvFwdOpSignature,
+            GetMiopenConvParamsSignature(x_dims_miopen, w_dims, pads, strides, dilations, conv_attrs_.group,
+                                         MiopenTensor::GetDataType<HipT>(), channels_last),
+            static_cast<int>(solution_id));
+      }
     }
     const auto& perf = s_.cached_benchmark_fwd_results.at(x_dims_miopen);
     s_.fwd_algo = perf.fwd_algo;
+    s_.fwd_solution_id = perf.solution_id;
     s_.workspace_bytes = perf.memory;
   } else {
     // set Y
@@ -335,19 +415,7 @@ Status Conv<T, NHWC>::ComputeInternal(OpKernelContext* context) const {
   const auto beta = Consts<HipT>::Zero;
   IAllocatorUniquePtr<void> workspace = GetWorkSpace(context->GetComputeStream());
   auto miopen_handle = GetMiopenHandle(context);
-  MIOPEN_RETURN_IF_ERROR(miopenConvolutionForward(miopen_handle,
-                                                  &alpha,
-                                                  s_.x_tensor,
-                                                  s_.x_data,
-                                                  s_.w_desc,
-                                                  s_.w_data,
-                                                  s_.conv_desc,
-                                                  s_.fwd_algo,
-                                                  &beta,
-                                                  s_.y_tensor,
-                                                  s_.y_data,
-                                                  workspace.get(),
-                                                  s_.workspace_bytes));
+  ORT_RETURN_IF_ERROR(ConvolutionForward(miopen_handle, workspace.get()));
 
   constexpr bool channels_last = NHWC;
   if (nullptr != s_.b_data && !channels_last) {
@@ -372,6 +440,41 @@ Status Conv<T, NHWC>::ComputeInternal(OpKernelContext* context) const {
   return Status::OK();
 }
 
+template <typename T, bool NHWC>
+Status Conv<T, NHWC>::ConvolutionForward(miopenHandle_t handle, void* workspace) const {
+  if (s_.fwd_solution_id != kNoMiopenSolution) {
+    MIOPEN_RETURN_IF_ERROR(miopenConvolutionForwardImmediate(handle,
+                                                             s_.w_desc,
+                                                             s_.w_data,
+                                                             s_.x_tensor,
+                                                             s_.x_data,
+                                                             s_.conv_desc,
+                                                             s_.y_tensor,
+                                                             s_.y_data,
+                                                             workspace,
+                                                             s_.workspace_bytes,
+                                                             s_.fwd_solution_id));
+    return Status::OK();
+  }
+
+  const auto alpha = Consts<HipT>::One;
+  const auto beta = Consts<HipT>::Zero;
+  MIOPEN_RETURN_IF_ERROR(miopenConvolutionForward(handle,
+                                                  &alpha,
+                                                  s_.x_tensor,
+                                                  s_.x_data,
+                                                  s_.w_desc,
+                                                  s_.w_data,
+                                                  s_.conv_desc,
+                                                  s_.fwd_algo,
+                                                  &beta,
+                                                  s_.y_tensor,
+                                                  s_.y_data,
+                                                  workspace,
+                                                  s_.workspace_bytes));
+  return Status::OK();
+}
+
 MiopenConvolutionDescriptor::MiopenConvolutionDescriptor() : desc_(nullptr) {
 }
 
@@ -7,6 +7,7 @@
 #include "core/providers/rocm/rocm_kernel.h"
 #include "core/providers/rocm/miopen_common.h"
 #include "core/providers/cpu/nn/conv_attributes.h"
+#include <limits>
 #include <list>
 
 namespace onnxruntime {
@@ -108,6 +109,12 @@ class lru_unordered_map {
 // cached miopen descriptors
 constexpr size_t MAX_CACHED_ALGO_PERF_RESULTS = 10000;
 
+// The solutions of the forward convolutions found by MIOpen are kept in the tuning results of the EP under this op
+// signature, so that they can be saved with the model and used in later processes without searching again.
+constexpr const char* kMiopenConvFwdOpSignature = "MiopenConvFwd";
+// Runs the forward convolution with the algorithm found by the search rather than with a solution.
+constexpr uint64_t kNoMiopenSolution = std::numeric_limits<uint64_t>::max();
+
 template <typename AlgoPerfType>
 struct MiopenConvState {
   // if x/w dims changed, update algo and miopenTensors
@@ -120,6 +127,7 @@ struct MiopenConvState {
   size_t workspace_bytes;
   decltype(AlgoPerfType().bwd_data_algo) bwd_data_algo;
   decltype(AlgoPerfType().fwd_algo) fwd_algo;
+  uint64_t fwd_solution_id = kNoMiopenSolution;
   MiopenTensor x_tensor;
   const void* x_data = nullptr;
   size_t element_size = 0;
@@ -138,6 +146,7 @@ struct MiopenConvState {
   struct PerfFwdResultParams {
     decltype(AlgoPerfType().fwd_algo) fwd_algo;
     decltype(AlgoPerfType().memory) memory;
+    uint64_t solution_id;
   };
 
   struct PerfBwdResultParams {
@@ -190,6 +199,8 @@ class Conv : public RocmKernel {
   }
 
   Status UpdateState(OpKernelContext* context, bool bias_expected = false) const;
+  // Computes y = conv(x, w) with the algorithm or the solution picked by UpdateState.
+  Status ConvolutionForward(miopenHandle_t handle, void* workspace) const;
   ConvAttributes conv_attrs_;
   mutable MiopenConvState<miopenConvAlgoPerf_t> s_;
   constexpr static auto kDefaultConvAlgo = miopenConvolutionFwdAlgoGEMM;
@@ -65,6 +65,11 @@ struct ROCMExecutionProviderInfo {
 
   rocm::TunableOpInfo tunable_op{};
 
+  bool enable_hip_graph{false};
+  // A graph is captured for each set of shapes of the inputs of a run. When more than hip_graph_max_graphs graphs
+  // are captured, the least recently used one is destroyed.
+  int hip_graph_max_graphs{8};
+
   static ROCMExecutionProviderInfo FromProviderOptions(const ProviderOptions& options);
   static ProviderOptions ToProviderOptions(const ROCMExecutionProviderInfo& info);
   static ProviderOptions ToProviderOptions(const OrtROCMProviderOptions& info);
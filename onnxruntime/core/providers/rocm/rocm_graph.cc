@@ -0,0 +1,125 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/providers/rocm/rocm_graph.h"
+
+#include "core/providers/rocm/rocm_common.h"
+#include <hip/hip_runtime_api.h>
+
+namespace onnxruntime {
+
+ROCMGraph::ROCMGraph(hipStream_t stream) : stream_(stream) {
+}
+
+void ROCMGraph::SetStream(hipStream_t stream) {
+  stream_ = stream;
+}
+
+void ROCMGraph::CaptureBegin() {
+  ORT_ENFORCE(!has_graph_exec_,
+              "This hip graph has already captured a graph. "
+              "Create a new instance to capture a new graph.");
+
+  HIP_CALL_THROW(hipStreamSynchronize(stream_));
+  // For now hip graph can only work with a single thread, see CUDAGraph::CaptureBegin.
+  HIP_CALL_THROW(hipStreamBeginCapture(stream_, hipStreamCaptureModeGlobal));
+}
+
+void ROCMGraph::CaptureEnd() {
+  HIP_CALL_THROW(hipStreamEndCapture(stream_, &graph_));
+  if (graph_ == NULL) {
+    ORT_THROW("ROCMGraph::CaptureEnd: graph_ is NULL");
+  }
+
+  has_graph_ = true;
+  HIP_CALL_THROW(hipGraphInstantiate(&graph_exec_, graph_, NULL, NULL, 0));
+  has_graph_exec_ = true;
+  HIP_CALL_THROW(hipGraphDestroy(graph_));
+  has_graph_ = false;
+}
+
+Status ROCMGraph::Replay() {
+  // Although this function is not thread safe, the lock is not needed here because
+  // ROCM EP maintains a separate hip graph per thread
+  LOGS_DEFAULT(INFO) << "Replaying HIP graph on stream " << stream_;
+  HIP_RETURN_IF_ERROR(hipGraphLaunch(graph_exec_, stream_));
+  HIP_RETURN_IF_ERROR(hipStreamSynchronize(stream_));
+  metrics::AddToCounter("onnxruntime_rocm_graph_replays_total", "Replays of captured HIP graphs.");
+  return Status::OK();
+}
+
+void ROCMGraph::Reset() {
+  if (has_graph_) {
+    HIP_CALL_THROW(hipGraphDestroy(graph_));
+    has_graph_ = false;
+  }
+  if (has_graph_exec_) {
+    HIP_CALL_THROW(hipGraphExecDestroy(graph_exec_));
+    has_graph_exec_ = false;
+  }
+}
+
+ROCMGraph::~ROCMGraph() {
+  Reset();
+}
+
+void ROCMGraphManager::SetStream(hipStream_t stream) {
+  stream_ = stream;
+}
+
+void ROCMGraphManager::SetKey(gsl::span<const int64_t> key) {
+  current_ = &entries_[std::vector<int64_t>(key.begin(), key.end())];
+}
+
+bool ROCMGraphManager::IsGraphCaptureAllowed() const {
+  return current_ != nullptr && current_->regular_run_count >= min_runs_before_capture_;
+}
+
+void ROCMGraphManager::CaptureBegin() {
+  ORT_ENFORCE(current_ != nullptr && current_->last_use == 0);
+  if (num_captured_graphs_ >= max_graphs_) {
+    EvictLeastRecentlyUsedGraph();
+  }
+  current_->graph = std::make_unique<ROCMGraph>(stream_);
+  current_->graph->CaptureBegin();
+}
+
+void ROCMGraphManager::CaptureEnd() {
+  current_->graph->CaptureEnd();
+  current_->last_use = ++use_count_;
+  ++num_captured_graphs_;
+}
+
+bool ROCMGraphManager::IsGraphCaptured() const {
+  return current_ != nullptr && current_->last_use != 0;
+}
+
+Status ROCMGraphManager::Replay() {
+  ORT_ENFORCE(IsGraphCaptured());
+  current_->last_use = ++use_count_;
+  return current_->graph->Replay();
+}
+
+void ROCMGraphManager::IncrementRegularRunCount() {
+  ++current_->regular_run_count;
+}
+
+void ROCMGraphManager::EvictLeastRecentlyUsedGraph() {
+  Entry* lru = nullptr;
+  for (auto& entry : entries_) {
+    if (entry.second.last_use != 0 && (lru == nullptr || entry.second.last_use < lru->last_use)) {
+      lru = &entry.second;
+    }
+  }
+  if (lru == nullptr) {
+    return;
+  }
+
+  LOGS_DEFAULT(INFO) << "Destroying the least recently used HIP graph of " << num_captured_graphs_
+                     << " captured graphs";
+  lru->graph.reset();
+  lru->last_use = 0;
+  --num_captured_graphs_;
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,77 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/platform/ort_mutex.h"
+#include "core/providers/rocm/rocm_pch.h"
+
+namespace onnxruntime {
+
+struct ROCMGraph {
+  ROCMGraph(){};
+  ROCMGraph(hipStream_t stream);
+  ~ROCMGraph();
+
+  void SetStream(hipStream_t stream);
+  void CaptureBegin();
+  void CaptureEnd();
+  Status Replay();
+  void Reset();
+
+ private:
+  hipGraph_t graph_ = NULL;
+  hipGraphExec_t graph_exec_ = NULL;
+
+  bool has_graph_ = false;
+  bool has_graph_exec_ = false;
+
+  hipStream_t stream_ = nullptr;  // Does not own the stream
+};
+
+// Keeps a captured hipGraph per key, the shapes of the inputs of a run, like CUDAGraphManager does for CUDA graphs.
+// A graph is captured for a key after min_runs_before_capture regular runs with it, which allocate the memory the
+// graph needs from the arena. When more than max_graphs graphs are captured, the least recently used one is destroyed.
+class ROCMGraphManager {
+ public:
+  ROCMGraphManager(int max_graphs, int min_runs_before_capture)
+      : max_graphs_(max_graphs), min_runs_before_capture_(min_runs_before_capture) {
+    ORT_ENFORCE(max_graphs_ > 0, "The maximum number of HIP graphs must be positive.");
+    SetKey({});
+  }
+
+  void SetStream(hipStream_t stream);
+  void SetKey(gsl::span<const int64_t> key);
+
+  bool IsGraphCaptureAllowed() const;
+  void CaptureBegin();
+  void CaptureEnd();
+  bool IsGraphCaptured() const;
+  Status Replay();
+  void IncrementRegularRunCount();
+
+ private:
+  struct Entry {
+    std::unique_ptr<ROCMGraph> graph;
+    int regular_run_count = 0;
+    uint64_t last_use = 0;  // 0 until the graph is captured
+  };
+
+  void EvictLeastRecentlyUsedGraph();
+
+  const int max_graphs_;
+  const int min_runs_before_capture_;
+  hipStream_t stream_ = nullptr;  // Does not own the stream
+
+  std::map<std::vector<int64_t>, Entry> entries_;
+  Entry* current_ = nullptr;
+  int num_captured_graphs_ = 0;
+  uint64_t use_count_ = 0;
+};
+
+}  // namespace onnxruntime
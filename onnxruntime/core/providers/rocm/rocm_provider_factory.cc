@@ -177,6 +177,7 @@ struct ROCM_Provider : Provider {
     info.tunable_op.enable = params->tunable_op_enable;
     info.tunable_op.tuning_enable = params->tunable_op_tuning_enable;
     info.tunable_op.max_tuning_duration_ms = params->tunable_op_max_tuning_duration_ms;
+    info.enable_hip_graph = params->enable_hip_graph;
 
     return std::make_shared<ROCMProviderFactory>(info);
   }
@@ -196,6 +197,7 @@ struct ROCM_Provider : Provider {
     rocm_options.tunable_op_enable = info.tunable_op.enable;
     rocm_options.tunable_op_tuning_enable = info.tunable_op.tuning_enable;
     rocm_options.tunable_op_max_tuning_duration_ms = info.tunable_op.max_tuning_duration_ms;
+    rocm_options.enable_hip_graph = info.enable_hip_graph;
   }
 
   ProviderOptions GetProviderOptions(const void* provider_options) override {
@@ -41,6 +41,19 @@ static Status ValidateRocBlasVersion(const std::string& value) {
   return Status::OK();
 }
 
+static std::string GetMiopenVersion() {
+  size_t major, minor, patch;
+  MIOPEN_CALL_THROW(miopenGetVersion(&major, &minor, &patch));
+  return std::to_string(major) + "." + std::to_string(minor) + "." + std::to_string(patch);
+}
+
+static Status ValidateMiopenVersion(const std::string& value) {
+  auto current = GetMiopenVersion();
+  ORT_RETURN_IF(current != value, "MIOpen version mismatch: tuning results produced with MIOpen ", value,
+                ", onnxruntime currently run with MIOpen ", current);
+  return Status::OK();
+}
+
 std::string RocmTuningResultsValidator::GetDeviceModel() const {
   return ep_->GetDeviceProp().name;
 }
@@ -55,6 +68,8 @@ Status RocmTuningResultsValidator::ValidateDeviceModel(const std::string& value)
 RocmTuningResultsValidator::RocmTuningResultsValidator(ROCMExecutionProvider* ep) : ep_{ep} {
   RegisterValidator("HIP_VERSION", GetHipVersion, ValidateHipVersion);
   RegisterValidator("ROCBLAS_VERSION", GetRocBlasVersion, ValidateRocBlasVersion);
+  // the tuning results also keep the MIOpen convolution solutions, see Conv::UpdateState
+  RegisterValidator("MIOPEN_VERSION", GetMiopenVersion, ValidateMiopenVersion);
   RegisterValidator(
       "DEVICE_MODEL",
       [this]() { return GetDeviceModel(); },
@@ -272,6 +272,13 @@ std::unordered_set<NodeIndex> GetCpuPreferredNodes(const onnxruntime::GraphViewe
 
 std::string GetEnvironmentVar(const std::string& var_name);
 
+namespace metrics {
+
+// Adds `value` to the counter named `name` of the metrics of the process
+void AddToCounter(const std::string& name, const std::string& help, uint64_t value = 1);
+
+}  // namespace metrics
+
 namespace profiling {
 
 std::string demangle(const char* name);
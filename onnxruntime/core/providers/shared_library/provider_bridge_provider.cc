@@ -10,6 +10,7 @@
 
 #include "core/common/inlined_containers.h"
 #include "core/framework/murmurhash3.h"
+#include "core/framework/nvtx_ranges.h"
 #include "core/framework/random_generator.h"
 #include "core/providers/cpu/controlflow/if.h"
 #include "core/providers/cpu/controlflow/loop.h"
@@ -361,6 +362,14 @@ std::string GetEnvironmentVar(const std::string& var_name) {
   return g_host->GetEnvironmentVar(var_name);
 }
 
+namespace metrics {
+
+void AddToCounter(const std::string& name, const std::string& help, uint64_t value) {
+  g_host->AddToMetricsCounter(name, help, value);
+}
+
+}  // namespace metrics
+
 std::unordered_set<NodeIndex> GetCpuPreferredNodes(const onnxruntime::GraphViewer& graph,
                                                    const IExecutionProvider::IKernelLookup& kernel_lookup,
                                                    gsl::span<const NodeIndex> tentative_nodes) {
@@ -728,6 +737,14 @@ void MurmurHash3::x86_128(const void* key, int len, uint32_t seed, void* out) {
   return g_host->MurmurHash3__x86_128(key, len, seed, out);
 }
 
+namespace profiling {
+
+bool NvtxRanges::IsEnabled() { return g_host->NvtxRanges__IsEnabled(); }
+void NvtxRanges::Push(const char* message, NvtxColor color) { g_host->NvtxRanges__Push(message, color); }
+void NvtxRanges::Pop() { g_host->NvtxRanges__Pop(); }
+
+}  // namespace profiling
+
 #if !defined(ORT_MINIMAL_BUILD) || defined(ORT_MINIMAL_BUILD_CUSTOM_OPS)
 Status LoadDynamicLibrary(onnxruntime::PathString library_name) {
   return g_host->LoadDynamicLibrary(library_name);
@@ -33,6 +33,10 @@ class PhiloxGenerator;
 using ProviderType = const std::string&;
 class RandomGenerator;
 
+namespace profiling {
+enum class NvtxColor : uint32_t;
+}
+
 #ifdef ENABLE_TRAINING_TORCH_INTEROP
 namespace contrib {
 class PythonOpBase;
@@ -135,6 +139,8 @@ struct ProviderHost {
 
   virtual std::string GetEnvironmentVar(const std::string& var_name) = 0;
 
+  virtual void AddToMetricsCounter(const std::string& name, const std::string& help, uint64_t value) = 0;
+
   virtual void LogRuntimeError(uint32_t session_id, const common::Status& status,
                                const char* file, const char* function, uint32_t line) = 0;
 
@@ -943,6 +949,11 @@ struct ProviderHost {
 
   virtual void MurmurHash3__x86_128(const void* key, int len, uint32_t seed, void* out) = 0;
 
+  // NvtxRanges
+  virtual bool NvtxRanges__IsEnabled() = 0;
+  virtual void NvtxRanges__Push(const char* message, profiling::NvtxColor color) = 0;
+  virtual void NvtxRanges__Pop() = 0;
+
 #ifdef _WIN32
   virtual std::string ToUTF8String(const std::wstring& s) = 0;
   virtual std::wstring ToWideString(const std::string& s) = 0;
@@ -1,6 +1,8 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
+#include <algorithm>
 #include <fstream>
+#include <future>
 #include <list>
 #include <unordered_set>
 #include "core/providers/shared_library/provider_api.h"
@@ -363,6 +365,150 @@ std::unique_lock<OrtMutex> TensorrtExecutionProvider::GetApiLock() const {
   return std::unique_lock<OrtMutex>(singleton);
 }
 
+struct TensorrtEngineBuildState {
+  std::string subgraph_model;             // serialized fused subgraph, run by the fallback session
+  std::vector<std::string> input_names;   // input names of the fused node, by input index
+  std::vector<std::string> output_names;  // output names of the fused node, by output index
+  std::unique_ptr<Ort::Env> env;
+  std::unique_ptr<Ort::Session> fallback_session;
+  std::shared_ptr<nvinfer1::ICudaEngine> engine;  // written by the build
+  std::future<Status> build;                      // declared last, so that the destruction waits for the build first
+};
+
+namespace {
+// Engines deserialized from or written to the engine cache, shared by all the sessions of the process, so that the
+// replicas of a model hold the weights of each engine once and only create their own execution contexts. An engine is
+// keyed by its cache path, which holds the hash of the subgraph, the precision and the compute capability, and by the
+// device. The registry does not keep the engines alive.
+OrtMutex& GetSharedEnginesMutex() {
+  static OrtMutex mutex;
+  return mutex;
+}
+
+std::unordered_map<std::string, std::weak_ptr<nvinfer1::ICudaEngine>>& GetSharedEngines() {
+  static std::unordered_map<std::string, std::weak_ptr<nvinfer1::ICudaEngine>> engines;
+  return engines;
+}
+
+std::string GetSharedEngineKey(const std::string& engine_cache_path, int device_id) {
+  return engine_cache_path + ":" + std::to_string(device_id);
+}
+
+std::shared_ptr<nvinfer1::ICudaEngine> GetSharedEngine(const std::string& engine_cache_path, int device_id) {
+  std::lock_guard<OrtMutex> lock(GetSharedEnginesMutex());
+  auto& engines = GetSharedEngines();
+  auto it = engines.find(GetSharedEngineKey(engine_cache_path, device_id));
+  if (it == engines.end()) {
+    return nullptr;
+  }
+  return it->second.lock();
+}
+
+void ShareEngine(const std::string& engine_cache_path, int device_id, const std::shared_ptr<nvinfer1::ICudaEngine>& engine) {
+  std::lock_guard<OrtMutex> lock(GetSharedEnginesMutex());
+  auto& engines = GetSharedEngines();
+  for (auto it = engines.begin(); it != engines.end();) {
+    it = it->second.expired() ? engines.erase(it) : std::next(it);
+  }
+  engines[GetSharedEngineKey(engine_cache_path, device_id)] = engine;
+}
+
+// The engine keeps the runtime that deserialized it alive, as it may outlive the session that created the runtime.
+std::shared_ptr<nvinfer1::ICudaEngine> DeserializeEngine(const std::shared_ptr<nvinfer1::IRuntime>& runtime,
+                                                         const char* engine_buf, size_t engine_size) {
+  nvinfer1::ICudaEngine* engine = runtime->deserializeCudaEngine(engine_buf, engine_size, nullptr);
+  if (engine == nullptr) {
+    return nullptr;
+  }
+  return std::shared_ptr<nvinfer1::ICudaEngine>(engine, [runtime](nvinfer1::ICudaEngine* engine) { delete engine; });
+}
+}  // namespace
+
+namespace {
+size_t GetTensorElementSize(ONNXTensorElementDataType type) {
+  switch (type) {
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_BOOL:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT8:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT8:
+      return 1;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT16:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_BFLOAT16:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT16:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT16:
+      return 2;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT32:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT32:
+      return 4;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_DOUBLE:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT64:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT64:
+      return 8;
+    default:
+      return 0;
+  }
+}
+
+/*
+ * Run the fused subgraph with the CUDA EP, while its engine is built in the background.
+ *
+ * The fallback session is created on first use from the serialized subgraph. It runs on its own stream, so the
+ * inputs are synchronized before the run and the outputs are copied to the outputs of the fused node after it.
+ */
+Status RunFallbackSession(TensorrtEngineBuildState& build_state, Ort::KernelContext& ctx, cudaStream_t stream,
+                          int device_id) {
+  if (build_state.fallback_session == nullptr) {
+    build_state.env = std::make_unique<Ort::Env>();
+    Ort::SessionOptions session_options;
+    session_options.SetIntraOpNumThreads(1);
+    OrtCUDAProviderOptions cuda_options;
+    cuda_options.device_id = device_id;
+    session_options.AppendExecutionProvider_CUDA(cuda_options);
+    build_state.fallback_session = std::make_unique<Ort::Session>(*build_state.env, build_state.subgraph_model.data(),
+                                                                  build_state.subgraph_model.size(), session_options);
+    LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] Created the CUDA EP fallback session of the subgraph";
+  }
+  Ort::Session& session = *build_state.fallback_session;
+
+  Ort::AllocatorWithDefaultOptions allocator;
+  std::unordered_set<std::string> session_input_names;
+  for (size_t i = 0, end = session.GetInputCount(); i < end; ++i) {
+    session_input_names.insert(session.GetInputNameAllocated(i, allocator).get());
+  }
+
+  CUDA_RETURN_IF_ERROR(cudaStreamSynchronize(stream));
+  Ort::IoBinding binding(session);
+  for (size_t i = 0, end = build_state.input_names.size(); i < end; ++i) {
+    const std::string& input_name = build_state.input_names[i];
+    if (session_input_names.count(input_name) == 1) {
+      Ort::ThrowOnError(Ort::GetApi().BindInput(binding, input_name.c_str(), ctx.GetInput(i)));
+    }
+  }
+  Ort::MemoryInfo output_mem_info("Cuda", OrtDeviceAllocator, device_id, OrtMemTypeDefault);
+  for (const auto& output_name : build_state.output_names) {
+    binding.BindOutput(output_name.c_str(), output_mem_info);
+  }
+  session.Run(Ort::RunOptions(), binding);
+  binding.SynchronizeOutputs();
+
+  std::vector<Ort::Value> fallback_outputs = binding.GetOutputValues();
+  for (size_t i = 0, end = fallback_outputs.size(); i < end; ++i) {
+    auto tensor_info = fallback_outputs[i].GetTensorTypeAndShapeInfo();
+    const size_t element_size = GetTensorElementSize(tensor_info.GetElementType());
+    if (element_size == 0) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL, "TensorRT EP fallback output tensor data type: " +
+                                                       std::to_string(tensor_info.GetElementType()) + " not supported.");
+    }
+    auto output_tensor = ctx.GetOutput(i, tensor_info.GetShape());
+    CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(output_tensor.GetTensorMutableRawData(), fallback_outputs[i].GetTensorRawData(),
+                                         tensor_info.GetElementCount() * element_size, cudaMemcpyDeviceToDevice, stream));
+  }
+  // The outputs of the fallback session are released on return
+  CUDA_RETURN_IF_ERROR(cudaStreamSynchronize(stream));
+  return Status::OK();
+}
+}  // namespace
+
 /*
  * Apply TensorRT optimization profile shapes from provider options.
  *
@@ -647,6 +793,172 @@ Status ApplyProfileShapesFromInputTensorValue(std::vector<nvinfer1::IOptimizatio
   return Status::OK();
 }
 
+namespace {
+// Maximum number of optimization profiles clustered from the warm-up runs of trt_profile_warmup_runs.
+constexpr size_t kMaxTrafficProfiles = 4;
+
+double GetShapeVolume(const std::vector<int64_t>& shape) {
+  double volume = 1.0;
+  for (auto dim : shape) {
+    volume *= static_cast<double>(dim);
+  }
+  return volume;
+}
+
+/*
+ * Cluster the shapes observed during the warm-up runs into at most max_num_profiles optimization profiles.
+ *
+ * A shape holds the dynamic dimensions of all the inputs. The shapes are sorted by volume, and the neighbouring
+ * clusters whose merge adds the least padding are merged until max_num_profiles are left. The padding of a profile is
+ * the volume between its max shape and the shape of each of its runs. The opt shape of a profile is its most frequent
+ * shape.
+ *
+ * Returns the {min, max, opt} range of each value of the shape, for each profile.
+ */
+std::vector<std::vector<std::vector<int64_t>>> ClusterObservedShapes(const std::map<std::vector<int64_t>, size_t>& observed_shapes,
+                                                                     size_t max_num_profiles) {
+  struct ShapeCluster {
+    std::vector<int64_t> min_shape;
+    std::vector<int64_t> max_shape;
+    std::vector<int64_t> opt_shape;
+    size_t opt_count;
+    size_t count;
+    double volume_sum;  // sum of the volumes of the shapes of the runs
+
+    double Padding() const { return static_cast<double>(count) * GetShapeVolume(max_shape) - volume_sum; }
+  };
+
+  std::vector<ShapeCluster> clusters;
+  for (const auto& [shape, count] : observed_shapes) {
+    clusters.push_back({shape, shape, shape, count, count, static_cast<double>(count) * GetShapeVolume(shape)});
+  }
+  std::stable_sort(clusters.begin(), clusters.end(), [](const ShapeCluster& a, const ShapeCluster& b) {
+    return GetShapeVolume(a.max_shape) < GetShapeVolume(b.max_shape);
+  });
+
+  auto merge = [](const ShapeCluster& a, const ShapeCluster& b) {
+    ShapeCluster merged = a.opt_count >= b.opt_count ? a : b;
+    for (size_t i = 0; i < merged.min_shape.size(); ++i) {
+      merged.min_shape[i] = std::min(a.min_shape[i], b.min_shape[i]);
+      merged.max_shape[i] = std::max(a.max_shape[i], b.max_shape[i]);
+    }
+    merged.count = a.count + b.count;
+    merged.volume_sum = a.volume_sum + b.volume_sum;
+    return merged;
+  };
+  while (clusters.size() > max_num_profiles) {
+    size_t best = 0;
+    double best_padding = std::numeric_limits<double>::max();
+    for (size_t i = 0; i + 1 < clusters.size(); ++i) {
+      double padding = merge(clusters[i], clusters[i + 1]).Padding() - clusters[i].Padding() - clusters[i + 1].Padding();
+      if (padding < best_padding) {
+        best = i;
+        best_padding = padding;
+      }
+    }
+    clusters[best] = merge(clusters[best], clusters[best + 1]);
+    clusters.erase(clusters.begin() + best + 1);
+  }
+
+  std::vector<std::vector<std::vector<int64_t>>> profiles;
+  for (const auto& cluster : clusters) {
+    std::vector<std::vector<int64_t>> profile;
+    for (size_t i = 0; i < cluster.min_shape.size(); ++i) {
+      profile.push_back({cluster.min_shape[i], cluster.max_shape[i], cluster.opt_shape[i]});
+    }
+    profiles.push_back(std::move(profile));
+  }
+  return profiles;
+}
+
+/*
+ * Select the optimization profile of the shape among the profiles of shape_ranges, i.e. the profile with the smallest
+ * max shape that covers the shape. If no profile covers the shape, the profile that grows the least is widened to it,
+ * and *engine_update is set.
+ */
+int SelectTrafficProfile(std::unordered_map<std::string, std::unordered_map<size_t, std::vector<std::vector<int64_t>>>>& shape_ranges,
+                         const std::vector<std::pair<std::string, size_t>>& profile_dims,
+                         const std::vector<int64_t>& shape,
+                         bool* engine_update) {
+  const size_t num_profiles = shape_ranges[profile_dims[0].first][profile_dims[0].second].size();
+  int selected = -1;
+  double selected_volume = std::numeric_limits<double>::max();
+  for (size_t k = 0; k < num_profiles; ++k) {
+    bool covered = true;
+    double max_volume = 1.0;
+    for (size_t i = 0; i < profile_dims.size(); ++i) {
+      const auto& range = shape_ranges[profile_dims[i].first][profile_dims[i].second][k];
+      covered = covered && shape[i] >= range[0] && shape[i] <= range[1];
+      max_volume *= static_cast<double>(range[1]);
+    }
+    if (covered && max_volume < selected_volume) {
+      selected = static_cast<int>(k);
+      selected_volume = max_volume;
+    }
+  }
+  if (selected >= 0) {
+    return selected;
+  }
+
+  double selected_growth = std::numeric_limits<double>::max();
+  for (size_t k = 0; k < num_profiles; ++k) {
+    double max_volume = 1.0;
+    double widened_volume = 1.0;
+    for (size_t i = 0; i < profile_dims.size(); ++i) {
+      const auto& range = shape_ranges[profile_dims[i].first][profile_dims[i].second][k];
+      max_volume *= static_cast<double>(range[1]);
+      widened_volume *= static_cast<double>(std::max(range[1], shape[i]));
+    }
+    if (widened_volume - max_volume < selected_growth) {
+      selected = static_cast<int>(k);
+      selected_growth = widened_volume - max_volume;
+    }
+  }
+  for (size_t i = 0; i < profile_dims.size(); ++i) {
+    auto& range = shape_ranges[profile_dims[i].first][profile_dims[i].second][selected];
+    range[0] = std::min(range[0], shape[i]);
+    range[1] = std::max(range[1], shape[i]);
+  }
+  *engine_update = true;
+  return selected;
+}
+
+/*
+ * Set the optimization profiles of the fused node to the profiles of shape_ranges, creating the missing ones.
+ */
+void ApplyProfileShapesFromShapeRanges(TensorrtFuncState* trt_state) {
+  auto& shape_ranges = trt_state->input_shape_ranges;
+  const auto& profile_dims = trt_state->profile_dims;
+  const size_t num_profiles = shape_ranges[profile_dims[0].first][profile_dims[0].second].size();
+  auto& trt_profiles = trt_state->profiles;
+  while (trt_profiles.size() < num_profiles) {
+    trt_profiles.push_back(trt_state->builder->get()->createOptimizationProfile());
+  }
+  trt_profiles.resize(num_profiles);
+
+  auto trt_network = trt_state->network->get();
+  for (int i = 0, end = trt_network->getNbInputs(); i < end; ++i) {
+    auto input = trt_network->getInput(i);
+    const auto shape_ranges_it = shape_ranges.find(input->getName());
+    if (shape_ranges_it == shape_ranges.end()) {
+      continue;
+    }
+    nvinfer1::Dims dims = input->getDimensions();
+    for (size_t k = 0; k < num_profiles; ++k) {
+      nvinfer1::Dims dims_min(dims), dims_opt(dims), dims_max(dims);
+      for (const auto& [dim, ranges] : shape_ranges_it->second) {
+        dims_min.d[dim] = static_cast<int32_t>(ranges[k][0]);
+        dims_max.d[dim] = static_cast<int32_t>(ranges[k][1]);
+        dims_opt.d[dim] = static_cast<int32_t>(ranges[k][2]);
+      }
+      trt_profiles[k]->setDimensions(input->getName(), nvinfer1::OptProfileSelector::kMIN, dims_min);
+      trt_profiles[k]->setDimensions(input->getName(), nvinfer1::OptProfileSelector::kMAX, dims_max);
+      trt_profiles[k]->setDimensions(input->getName(), nvinfer1::OptProfileSelector::kOPT, dims_opt);
+    }
+  }
+}
+}  // namespace
+
 TensorrtExecutionProvider::TensorrtExecutionProvider(const TensorrtExecutionProviderInfo& info)
     : IExecutionProvider{onnxruntime::kTensorrtExecutionProvider, OrtDevice(OrtDevice::GPU, OrtDevice::MemType::DEFAULT, info.device_id), true}, info_(info), device_id_(info.device_id) {
   InitProviderOrtApi();
@@ -704,6 +1016,8 @@ TensorrtExecutionProvider::TensorrtExecutionProvider(const TensorrtExecutionProv
     profile_max_shapes = info.profile_max_shapes;
     profile_opt_shapes = info.profile_opt_shapes;
     cuda_graph_enable_ = info.cuda_graph_enable;
+    async_engine_build_enable_ = info.async_engine_build_enable;
+    profile_warmup_runs_ = info.profile_warmup_runs;
   } else {
     try {
       const std::string max_partition_iterations_env = onnxruntime::GetEnvironmentVar(tensorrt_env_vars::kMaxPartitionIterations);
@@ -848,6 +1162,16 @@ TensorrtExecutionProvider::TensorrtExecutionProvider(const TensorrtExecutionProv
       if (!cuda_graph_enable_env.empty()) {
         cuda_graph_enable_ = (std::stoi(cuda_graph_enable_env) == 0 ? false : true);
       }
+
+      const std::string async_engine_build_enable_env = onnxruntime::GetEnvironmentVar(tensorrt_env_vars::kAsyncEngineBuildEnable);
+      if (!async_engine_build_enable_env.empty()) {
+        async_engine_build_enable_ = (std::stoi(async_engine_build_enable_env) == 0 ? false : true);
+      }
+
+      const std::string profile_warmup_runs_env = onnxruntime::GetEnvironmentVar(tensorrt_env_vars::kProfileWarmupRuns);
+      if (!profile_warmup_runs_env.empty()) {
+        profile_warmup_runs_ = std::stoi(profile_warmup_runs_env);
+      }
     } catch (const std::invalid_argument& ex) {
       LOGS_DEFAULT(WARNING) << "[TensorRT EP] Invalid Argument (from environment variables): " << ex.what();
     } catch (const std::out_of_range& ex) {
@@ -883,7 +1207,7 @@ TensorrtExecutionProvider::TensorrtExecutionProvider(const TensorrtExecutionProv
     }
     {
       auto lock = GetApiLock();
-      runtime_ = std::unique_ptr<nvinfer1::IRuntime>(nvinfer1::createInferRuntime(GetTensorrtLogger()));
+      runtime_ = std::shared_ptr<nvinfer1::IRuntime>(nvinfer1::createInferRuntime(GetTensorrtLogger()));
     }
   }
 
@@ -979,7 +1303,9 @@ TensorrtExecutionProvider::TensorrtExecutionProvider(const TensorrtExecutionProv
                         << ", trt_profile_min_shapes: " << profile_min_shapes
                         << ", trt_profile_max_shapes: " << profile_max_shapes
                         << ", trt_profile_opt_shapes: " << profile_opt_shapes
-                        << ", trt_cuda_graph_enable: " << cuda_graph_enable_;
+                        << ", trt_cuda_graph_enable: " << cuda_graph_enable_
+                        << ", trt_async_engine_build_enable: " << async_engine_build_enable_
+                        << ", trt_profile_warmup_runs: " << profile_warmup_runs_;
 }
 
 TensorrtExecutionProvider::~TensorrtExecutionProvider() {
@@ -1695,6 +2021,64 @@ TensorrtExecutionProvider::GetCapability(const GraphViewer& graph,
   return result;
 }
 
+Status TensorrtExecutionProvider::BuildEngine(TensorrtFuncState* trt_state, nvinfer1::IBuilderConfig& trt_config,
+                                              std::unordered_map<std::string, std::unordered_map<size_t, std::vector<std::vector<int64_t>>>>& shape_ranges,
+                                              const std::string& engine_cache_path, const std::string& profile_cache_path,
+                                              const std::string& timing_cache_path, std::shared_ptr<nvinfer1::ICudaEngine>& engine) const {
+  {
+    auto lock = GetApiLock();
+    std::chrono::steady_clock::time_point engine_build_start;
+    if (detailed_build_log_) {
+      engine_build_start = std::chrono::steady_clock::now();
+    }
+    engine = std::shared_ptr<nvinfer1::ICudaEngine>(
+        trt_state->builder->get()->buildEngineWithConfig(*trt_state->network->get(), trt_config));
+    if (detailed_build_log_) {
+      auto engine_build_stop = std::chrono::steady_clock::now();
+      LOGS_DEFAULT(INFO) << "TensorRT engine build for " << trt_state->trt_node_name_with_precision << " took: " << std::chrono::duration_cast<std::chrono::milliseconds>(engine_build_stop - engine_build_start).count() << "ms" << std::endl;
+    }
+  }
+  if (engine == nullptr) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL, "TensorRT EP Failed to Build Engine.");
+  }
+  metrics::AddToCounter("onnxruntime_tensorrt_engine_builds_total", "TensorRT engines built.");
+  if (trt_state->engine_cache_enable) {
+    // Serialize engine profile
+    SerializeProfileV2(profile_cache_path, shape_ranges);
+    LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] Serialized " + profile_cache_path;
+
+    // Serialize engine
+    std::unique_ptr<nvinfer1::IHostMemory> serializedModel(engine->serialize());
+    size_t engine_size = serializedModel->size();
+    if (trt_state->engine_decryption_enable) {
+      // Encrypt engine
+      if (!trt_state->engine_encryption(engine_cache_path.c_str(), reinterpret_cast<char*>(serializedModel->data()), engine_size)) {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL,
+                               "TensorRT EP could not call engine encryption function encrypt");
+      }
+    } else {
+      std::ofstream file(engine_cache_path, std::ios::binary | std::ios::out);
+      file.write(reinterpret_cast<char*>(serializedModel->data()), engine_size);
+    }
+    ShareEngine(engine_cache_path, device_id_, engine);
+  }
+
+  // serialize and save timing cache
+  if (trt_state->timing_cache_enable) {
+    auto timing_cache = trt_config.getTimingCache();
+    std::unique_ptr<nvinfer1::IHostMemory> timingCacheHostData{timing_cache->serialize()};
+    if (timingCacheHostData == nullptr) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL,
+                             "TensorRT EP could not serialize timing cache: " + timing_cache_path);
+    }
+    saveTimingCacheFile(timing_cache_path, timingCacheHostData.get());
+    if (detailed_build_log_) {
+      LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] Serialized timing cache " + timing_cache_path;
+    }
+  }
+  return Status::OK();
+}
+
 common::Status TensorrtExecutionProvider::Compile(const std::vector<FusedNodeAndGraph>& fused_nodes_and_graphs,
                                                   std::vector<NodeComputeInfo>& node_compute_funcs) {
   for (auto& fused_node_graph : fused_nodes_and_graphs) {
@@ -1730,6 +2114,19 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<FusedNodeAnd
       model_proto->SerializeToOstream(dump);
     }
 
+    // Keep the subgraph to run it on the CUDA EP while its engines are built in the background
+    std::shared_ptr<TensorrtEngineBuildState> engine_build_state;
+    if (async_engine_build_enable_) {
+      engine_build_state = std::make_shared<TensorrtEngineBuildState>();
+      engine_build_state->subgraph_model = string_buf;
+      for (const auto* input_def : input_defs) {
+        engine_build_state->input_names.push_back(input_def->Name());
+      }
+      for (const auto* output_def : output_defs) {
+        engine_build_state->output_names.push_back(output_def->Name());
+      }
+    }
+
     TensorrtLogger& trt_logger = GetTensorrtLogger();
     auto trt_builder = std::unique_ptr<nvinfer1::IBuilder>(nvinfer1::createInferBuilder(trt_logger));
     const auto explicitBatch = 1U << static_cast<uint32_t>(nvinfer1::NetworkDefinitionCreationFlag::kEXPLICIT_BATCH);
@@ -1979,7 +2376,7 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<FusedNodeAnd
     //   (2) All the dynamic shape inputs have associated explicit profiles specified by user
     //
     // Otherwise engine will be handled at inference time.
-    std::unique_ptr<nvinfer1::ICudaEngine> trt_engine;
+    std::shared_ptr<nvinfer1::ICudaEngine> trt_engine;
     std::unique_ptr<nvinfer1::IExecutionContext> trt_context;
 
     // Name the engine cache based on GPU compute capacity and reduce the chance of loading an incompatible cache
@@ -2013,18 +2410,22 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<FusedNodeAnd
         }
 
         std::ifstream engine_file(engine_cache_path, std::ios::binary | std::ios::in);
-        if (engine_cache_enable_ && engine_file && !engine_update) {
+        if (engine_cache_enable_ && !engine_update &&
+            (trt_engine = GetSharedEngine(engine_cache_path, device_id_)) != nullptr) {
+          LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] Shared the engine of " + engine_cache_path;
+        } else if (engine_cache_enable_ && engine_file && !engine_update) {
           engine_file.seekg(0, std::ios::end);
           size_t engine_size = engine_file.tellg();
           engine_file.seekg(0, std::ios::beg);
           std::unique_ptr<char[]> engine_buf{new char[engine_size]};
           engine_file.read((char*)engine_buf.get(), engine_size);
-          trt_engine = std::unique_ptr<nvinfer1::ICudaEngine>(runtime_->deserializeCudaEngine(engine_buf.get(), engine_size, nullptr));
+          trt_engine = DeserializeEngine(runtime_, engine_buf.get(), engine_size);
           LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] DeSerialized " + engine_cache_path;
           if (trt_engine == nullptr) {
             return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL,
                                    "TensorRT EP could not deserialize engine from cache: " + engine_cache_path);
           }
+          ShareEngine(engine_cache_path, device_id_, trt_engine);
         } else if (engine_decryption_enable_ && engine_cache_enable_ && !engine_file && !engine_update) {
           // Decrypt engine
           size_t engine_size = 0;
@@ -2038,12 +2439,13 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<FusedNodeAnd
                                    "TensorRT EP could not call engine decryption function decrypt");
           }
           // Deserialize engine
-          trt_engine = std::unique_ptr<nvinfer1::ICudaEngine>(runtime_->deserializeCudaEngine(engine_buf.get(), engine_size, nullptr));
+          trt_engine = DeserializeEngine(runtime_, engine_buf.get(), engine_size);
           LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] DeSerialized " + engine_cache_path;
           if (trt_engine == nullptr) {
             return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL,
                                    "TensorRT EP could not deserialize engine from encrypted cache: " + engine_cache_path);
           }
+          ShareEngine(engine_cache_path, device_id_, trt_engine);
         } else {
           // Set INT8 per tensor dynamic range
           if (int8_enable_ && trt_builder->platformHasFastInt8() && int8_calibration_cache_available_) {
@@ -2074,11 +2476,12 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<FusedNodeAnd
           if (detailed_build_log_) {
             engine_build_start = std::chrono::steady_clock::now();
           }
-          trt_engine = std::unique_ptr<nvinfer1::ICudaEngine>(trt_builder->buildEngineWithConfig(*trt_network, *trt_config));
+          trt_engine = std::shared_ptr<nvinfer1::ICudaEngine>(trt_builder->buildEngineWithConfig(*trt_network, *trt_config));
           if (trt_engine == nullptr) {
             return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL,
                                    "TensorRT EP could not build engine for fused node: " + fused_node.Name());
           }
+          metrics::AddToCounter("onnxruntime_tensorrt_engine_builds_total", "TensorRT engines built.");
           if (detailed_build_log_) {
             auto engine_build_stop = std::chrono::steady_clock::now();
             LOGS_DEFAULT(INFO) << "TensorRT engine build for " << trt_node_name_with_precision << " took: " << std::chrono::duration_cast<std::chrono::milliseconds>(engine_build_stop - engine_build_start).count() << "ms" << std::endl;
@@ -2103,6 +2506,7 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<FusedNodeAnd
               file.write(reinterpret_cast<char*>(serializedModel->data()), engine_size);
             }
             LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] Serialized engine " + engine_cache_path;
+            ShareEngine(engine_cache_path, device_id_, trt_engine);
           }
           // serialize and save timing cache
           if (timing_cache_enable_) {
@@ -2189,6 +2593,8 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<FusedNodeAnd
             dynamic_range_map, engine_decryption_enable_, engine_decryption_, engine_encryption_, timing_cache_enable_,
             force_timing_cache_match_, detailed_build_log_, build_heuristics_enable_, sparsity_enable_,
             builder_optimization_level_, auxiliary_streams_, !tactic_sources_.empty(), tactics};
+      p->engine_build_state = engine_build_state;
+      p->profile_warmup_runs = profile_warmup_runs_;
       *state = p.release();
       return 0;
     };
@@ -2226,6 +2632,57 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<FusedNodeAnd
       Ort::ThrowOnError(api->KernelContext_GetGPUComputeStream(context, &cuda_stream));
       cudaStream_t stream = static_cast<cudaStream_t>(cuda_stream);
 
+      // Serve the run on the CUDA EP while an engine is built in the background, and switch to the engine once it is
+      // built. The builder, network and profiles are not touched until then, since the build uses them.
+      TensorrtEngineBuildState* engine_build_state = trt_state->engine_build_state.get();
+      if (engine_build_state != nullptr && engine_build_state->build.valid()) {
+        if (engine_build_state->build.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+          return RunFallbackSession(*engine_build_state, ctx, stream, device_id_);
+        }
+        ORT_RETURN_IF_ERROR(engine_build_state->build.get());
+        *(trt_state->engine) = std::move(engine_build_state->engine);
+        trt_engine = trt_state->engine->get();
+        if (trt_state->context_memory_sharing_enable) {
+          *(trt_state->context) = std::unique_ptr<nvinfer1::IExecutionContext>(
+              trt_state->engine->get()->createExecutionContextWithoutDeviceMemory());
+        } else {
+          *(trt_state->context) = std::unique_ptr<nvinfer1::IExecutionContext>(
+              trt_state->engine->get()->createExecutionContext());
+        }
+        if (*(trt_state->context) == nullptr) {
+          return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL, "TensorRT EP failed to create context.");
+        }
+        trt_context = trt_state->context->get();
+        LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] Switched to the engine built in the background for " << trt_state->trt_node_name_with_precision;
+      }
+
+      // Resolve the dynamic dimensions whose observed values make the traffic-driven profiles. Subgraphs with shape
+      // tensor inputs keep the single profile that follows the input shapes.
+      if (trt_state->profile_warmup_runs > 0 && trt_state->profile_dims.empty() && !shape_ranges.empty()) {
+        for (int i = 0, end = num_inputs; i < end; ++i) {
+          auto input = trt_state->network->get()->getInput(i);
+          const auto shape_ranges_it = shape_ranges.find(input->getName());
+          if (shape_ranges_it == shape_ranges.end()) {
+            continue;
+          }
+          if (input->isShapeTensor()) {
+            LOGS_DEFAULT(WARNING) << "[TensorRT EP] Profiles from the observed traffic are not supported with shape tensor inputs, "
+                                  << "ignoring trt_profile_warmup_runs for " << trt_state->trt_node_name_with_precision;
+            trt_state->profile_warmup_runs = 0;
+            trt_state->profile_dims.clear();
+            break;
+          }
+          std::vector<size_t> dims;
+          for (const auto& dim_range : shape_ranges_it->second) {
+            dims.push_back(dim_range.first);
+          }
+          std::sort(dims.begin(), dims.end());
+          for (auto dim : dims) {
+            trt_state->profile_dims.emplace_back(input->getName(), dim);
+          }
+        }
+      }
+
       // Name the engine cache based on GPU compute capacity and reduce the chance of loading an incompatible cache
       // Note: Engine cache generated on a GPU with large memory might not be loadable on a GPU with smaller memory, even if they share the same compute capacity
       cudaDeviceProp prop;
@@ -2247,20 +2704,31 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<FusedNodeAnd
           // Deserialize profile
           shape_ranges = DeserializeProfileV2(profile_file);
           LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] DeSerialized " + profile_cache_path;
+          if (!trt_state->profile_dims.empty()) {
+            // The cached profiles take the place of the warm-up
+            ApplyProfileShapesFromShapeRanges(trt_state);
+            trt_profiles = trt_state->profiles;
+            trt_state->traffic_profiles_ready = true;
+          }
           // Deserialize engine
           trt_state->context->reset();
           trt_state->engine->reset();
-          engine_file.seekg(0, std::ios::end);
-          size_t engine_size = engine_file.tellg();
-          engine_file.seekg(0, std::ios::beg);
-          std::unique_ptr<char[]> engine_buf{new char[engine_size]};
-          engine_file.read((char*)engine_buf.get(), engine_size);
-          *(trt_state->engine) = std::unique_ptr<nvinfer1::ICudaEngine>(
-              trt_state->runtime->deserializeCudaEngine(engine_buf.get(), engine_size, nullptr));
-          if (*(trt_state->engine) == nullptr) {
-            return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL, "TensorRT EP Failed to Build Engine.");
+          *(trt_state->engine) = GetSharedEngine(engine_cache_path, device_id_);
+          if (*(trt_state->engine) != nullptr) {
+            LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] Shared the engine of " + engine_cache_path;
+          } else {
+            engine_file.seekg(0, std::ios::end);
+            size_t engine_size = engine_file.tellg();
+            engine_file.seekg(0, std::ios::beg);
+            std::unique_ptr<char[]> engine_buf{new char[engine_size]};
+            engine_file.read((char*)engine_buf.get(), engine_size);
+            *(trt_state->engine) = DeserializeEngine(runtime_, engine_buf.get(), engine_size);
+            if (*(trt_state->engine) == nullptr) {
+              return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL, "TensorRT EP Failed to Build Engine.");
+            }
+            LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] DeSerialized " + engine_cache_path;
+            ShareEngine(engine_cache_path, device_id_, *(trt_state->engine));
           }
-          LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] DeSerialized " + engine_cache_path;
           trt_engine = trt_state->engine->get();
           if (trt_state->context_memory_sharing_enable) {
             *(trt_state->context) = std::unique_ptr<nvinfer1::IExecutionContext>(
@@ -2276,6 +2744,12 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<FusedNodeAnd
         } else if (trt_state->engine_decryption_enable && !engine_file && profile_file) {
           shape_ranges = DeserializeProfileV2(profile_file);
           LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] DeSerialized " + profile_cache_path;
+          if (!trt_state->profile_dims.empty()) {
+            // The cached profiles take the place of the warm-up
+            ApplyProfileShapesFromShapeRanges(trt_state);
+            trt_profiles = trt_state->profiles;
+            trt_state->traffic_profiles_ready = true;
+          }
           // Decrypt engine
           size_t engine_size = 0;
           if (!trt_state->engine_decryption(engine_cache_path.c_str(), nullptr, &engine_size)) {
@@ -2290,12 +2764,13 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<FusedNodeAnd
           // Deserialize engine
           trt_state->context->reset();
           trt_state->engine->reset();
-          *(trt_state->engine) = std::unique_ptr<nvinfer1::ICudaEngine>(trt_state->runtime->deserializeCudaEngine(engine_buf.get(), engine_size, nullptr));
+          *(trt_state->engine) = DeserializeEngine(runtime_, engine_buf.get(), engine_size);
           if (*(trt_state->engine) == nullptr) {
             return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL,
                                    "TensorRT EP could not deserialize engine from encrypted cache: " + engine_cache_path);
           }
           LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] DeSerialized " + engine_cache_path;
+          ShareEngine(engine_cache_path, device_id_, *(trt_state->engine));
           trt_engine = trt_state->engine->get();
           if (trt_state->context_memory_sharing_enable) {
             *(trt_state->context) = std::unique_ptr<nvinfer1::IExecutionContext>(
@@ -2311,6 +2786,48 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<FusedNodeAnd
         }
       }
 
+      // Count the shape of the run during the warm-up, and cluster the counted shapes into the profiles of the engine
+      // at its end. The warm-up runs use the single profile that follows the input shapes. Once the profiles are
+      // clustered, the run selects the profile of its shape, and widens one if none covers it.
+      int profile_index = 0;
+      if (!trt_state->profile_dims.empty()) {
+        std::vector<int64_t> shape;
+        for (const auto& [input_name, dim] : trt_state->profile_dims) {
+          size_t input_index = 0;
+          const auto iter = input_indexes.find(input_name);
+          if (iter != input_indexes.end()) {
+            input_index = iter->second;
+          }
+          shape.push_back(ctx.GetInput(input_index).GetTensorTypeAndShapeInfo().GetShape()[dim]);
+        }
+        if (!trt_state->traffic_profiles_ready) {
+          ++trt_state->observed_shapes[shape];
+          if (++trt_state->observed_runs >= trt_state->profile_warmup_runs) {
+            auto profiles = ClusterObservedShapes(trt_state->observed_shapes, kMaxTrafficProfiles);
+            for (size_t i = 0; i < trt_state->profile_dims.size(); ++i) {
+              auto& ranges = shape_ranges[trt_state->profile_dims[i].first][trt_state->profile_dims[i].second];
+              ranges.clear();
+              for (const auto& profile : profiles) {
+                ranges.push_back(profile[i]);
+              }
+            }
+            LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] Clustered " << trt_state->observed_shapes.size() << " shapes of "
+                                  << trt_state->observed_runs << " runs into " << profiles.size()
+                                  << " optimization profiles for " << trt_state->trt_node_name_with_precision;
+            trt_state->observed_shapes.clear();
+            trt_state->traffic_profiles_ready = true;
+            engine_update = true;
+          }
+        }
+        if (trt_state->traffic_profiles_ready) {
+          profile_index = SelectTrafficProfile(shape_ranges, trt_state->profile_dims, shape, &engine_update);
+          if (engine_update) {
+            ApplyProfileShapesFromShapeRanges(trt_state);
+            trt_profiles = trt_state->profiles;
+          }
+        }
+      }
+
       // Check and update shape ranges for dynamic shape inputs.
       for (int i = 0, end = num_inputs; i < end; ++i) {
         auto input = trt_state->network->get()->getInput(i);
@@ -2319,7 +2836,7 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<FusedNodeAnd
 
         // If there is any input tensor in shape_ranges, it means this input tensor has dynamic shape and its profile shape values have not yet resolved.
         // TRT EP will help determine the min/max/opt profile values based on current input tensor value.
-        if (shape_ranges.find(input_name) != shape_ranges.end()) {
+        if (!trt_state->traffic_profiles_ready && shape_ranges.find(input_name) != shape_ranges.end()) {
           auto status = ApplyProfileShapesFromInputTensorValue(trt_profiles, ctx, input, shape_ranges, input_indexes, tensor_shape_values, stream, &engine_update);
           if (status != Status::OK()) {
             return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL, "TensorRT EP failed to parse input tensor and generate optimization profiles.");
@@ -2416,57 +2933,24 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<FusedNodeAnd
           }
         }
 
-        // Build engine
-        {
-          auto lock = GetApiLock();
-          std::chrono::steady_clock::time_point engine_build_start;
-          if (detailed_build_log_) {
-            engine_build_start = std::chrono::steady_clock::now();
-          }
-          *(trt_state->engine) = std::unique_ptr<nvinfer1::ICudaEngine>(
-              trt_builder->buildEngineWithConfig(*trt_state->network->get(), *trt_config));
-          if (detailed_build_log_) {
-            auto engine_build_stop = std::chrono::steady_clock::now();
-            LOGS_DEFAULT(INFO) << "TensorRT engine build for " << trt_state->trt_node_name_with_precision << " took: " << std::chrono::duration_cast<std::chrono::milliseconds>(engine_build_stop - engine_build_start).count() << "ms" << std::endl;
-          }
-        }
-        if (*(trt_state->engine) == nullptr) {
-          return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL, "TensorRT EP Failed to Build Engine.");
-        }
-        trt_engine = trt_state->engine->get();
-        if (trt_state->engine_cache_enable) {
-          // Serialize engine profile
-          SerializeProfileV2(profile_cache_path, shape_ranges);
-          LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] Serialized " + profile_cache_path;
-
-          // Serialize engine
-          std::unique_ptr<nvinfer1::IHostMemory> serializedModel(trt_engine->serialize());
-          size_t engine_size = serializedModel->size();
-          if (trt_state->engine_decryption_enable) {
-            // Encrypt engine
-            if (!trt_state->engine_encryption(engine_cache_path.c_str(), reinterpret_cast<char*>(serializedModel->data()), engine_size)) {
-              return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL,
-                                     "TensorRT EP could not call engine encryption function encrypt");
-            }
-          } else {
-            std::ofstream file(engine_cache_path, std::ios::binary | std::ios::out);
-            file.write(reinterpret_cast<char*>(serializedModel->data()), engine_size);
-          }
+        // Build engine in the background and run the subgraph on the CUDA EP until it is built. The builder config
+        // and the timing cache are owned by the build.
+        if (engine_build_state != nullptr) {
+          engine_build_state->build = std::async(
+              std::launch::async,
+              [this, trt_state, engine_build_state, trt_config = std::move(trt_config), timing_cache = std::move(timing_cache),
+               build_shape_ranges = shape_ranges, engine_cache_path, profile_cache_path, timing_cache_path]() mutable {
+                return BuildEngine(trt_state, *trt_config, build_shape_ranges, engine_cache_path, profile_cache_path,
+                                   timing_cache_path, engine_build_state->engine);
+              });
+          LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] Building the engine of " << trt_state->trt_node_name_with_precision << " in the background";
+          return RunFallbackSession(*engine_build_state, ctx, stream, device_id_);
         }
 
-        // serialize and save timing cache
-        if (trt_state->timing_cache_enable) {
-          auto timing_cache = trt_config->getTimingCache();
-          std::unique_ptr<nvinfer1::IHostMemory> timingCacheHostData{timing_cache->serialize()};
-          if (timingCacheHostData == nullptr) {
-            return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL,
-                                   "TensorRT EP could not serialize timing cache: " + timing_cache_path);
-          }
-          saveTimingCacheFile(timing_cache_path, timingCacheHostData.get());
-          if (detailed_build_log_) {
-            LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] Serialized timing cache " + timing_cache_path;
-          }
-        }
+        // Build engine
+        ORT_RETURN_IF_ERROR(BuildEngine(trt_state, *trt_config, shape_ranges, engine_cache_path, profile_cache_path,
+                                        timing_cache_path, *(trt_state->engine)));
+        trt_engine = trt_state->engine->get();
 
         // Build context
         if (trt_state->context_memory_sharing_enable) {
@@ -2482,11 +2966,20 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<FusedNodeAnd
         trt_context = trt_state->context->get();
       }
 
-      // Get input and output binding names
+      // Select the optimization profile of the run. The bindings of a profile follow the bindings of the profiles
+      // before it, and the binding names are those of the first profile.
       int total_bindings = trt_engine->getNbBindings();
+      int bindings_per_profile = total_bindings / trt_engine->getNbOptimizationProfiles();
+      int binding_offset = profile_index * bindings_per_profile;
+      if (trt_context->getOptimizationProfile() != profile_index &&
+          !trt_context->setOptimizationProfileAsync(profile_index, stream)) {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL, "TensorRT EP failed to select optimization profile " + std::to_string(profile_index));
+      }
+
+      // Get input and output binding names
       std::vector<void*> buffers(total_bindings);
       std::vector<std::string> input_binding_names, output_binding_names;
-      for (int i = 0, end = total_bindings; i < end; ++i) {
+      for (int i = 0, end = bindings_per_profile; i < end; ++i) {
         if (trt_engine->bindingIsInput(i)) {
           input_binding_names.push_back(trt_engine->getBindingName(i));
         } else {
@@ -2502,6 +2995,7 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<FusedNodeAnd
         if (binding_index == -1) {
           continue;
         }
+        binding_index += binding_offset;
 
         size_t input_index = 0;
         const auto iter = input_indexes.find(input_name);
@@ -2655,6 +3149,7 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<FusedNodeAnd
         if (binding_index == -1) {
           continue;
         }
+        binding_index += binding_offset;
 
         size_t output_index = 0;
         const auto& index_iter = output_indexes.find(output_name);
@@ -2815,7 +3310,7 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<FusedNodeAnd
       // Cast INT64 input to INT32 because TensorRT doesn't fully support INT64
       for (size_t i = 0, end = output_binding_names.size(); i < end; ++i) {
         const std::string& output_name = output_binding_names[i];
-        size_t binding_index = trt_engine->getBindingIndex(output_name.c_str());
+        size_t binding_index = trt_engine->getBindingIndex(output_name.c_str()) + binding_offset;
         size_t output_type = 0;
         const auto& iter = output_types.find(output_name);
         if (iter != output_types.end()) {
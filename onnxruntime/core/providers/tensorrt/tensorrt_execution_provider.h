@@ -3,6 +3,7 @@
 
 #pragma once
 #include <ctime>
+#include <map>
 #include <cudnn.h>
 #include <cublas_v2.h>
 #include "NvInfer.h"
@@ -44,6 +45,8 @@ static const std::string kProfilesMinShapes = "ORT_TENSORRT_PROFILE_MIN_SHAPES";
 static const std::string kProfilesMaxShapes = "ORT_TENSORRT_PROFILE_MAX_SHAPES";
 static const std::string kProfilesOptShapes = "ORT_TENSORRT_PROFILE_OPT_SHAPES";
 static const std::string kCudaGraphEnable = "ORT_TENSORRT_CUDA_GRAPH_ENABLE";
+static const std::string kAsyncEngineBuildEnable = "ORT_TENSORRT_ASYNC_ENGINE_BUILD_ENABLE";
+static const std::string kProfileWarmupRuns = "ORT_TENSORRT_PROFILE_WARMUP_RUNS";
 // Old env variable for backward compatibility
 static const std::string kEngineCachePath = "ORT_TENSORRT_ENGINE_CACHE_PATH";
 }  // namespace tensorrt_env_vars
@@ -95,13 +98,17 @@ template <typename T>
 using unique_pointer = std::unique_ptr<T, TensorrtInferDeleter>;
 };  // namespace tensorrt_ptr
 
+// Engine build of a fused node running in the background, and the CUDA EP session serving the node meanwhile.
+// Only created with trt_async_engine_build_enable.
+struct TensorrtEngineBuildState;
+
 // Information to construct kernel function state.
 struct TensorrtFuncState {
   AllocateFunc test_allocate_func = nullptr;
   DestroyFunc test_release_func = nullptr;
   AllocatorHandle allocator = nullptr;
   tensorrt_ptr::unique_pointer<nvonnxparser::IParser>* parser = nullptr;
-  std::unique_ptr<nvinfer1::ICudaEngine>* engine = nullptr;
+  std::shared_ptr<nvinfer1::ICudaEngine>* engine = nullptr;
   std::unique_ptr<nvinfer1::IExecutionContext>* context = nullptr;
   std::unique_ptr<nvinfer1::IBuilder>* builder = nullptr;
   std::unique_ptr<nvinfer1::INetworkDefinition>* network = nullptr;
@@ -136,6 +143,15 @@ struct TensorrtFuncState {
   bool filter_tactic_sources = false;
   nvinfer1::TacticSources tactic_sources;
   bool cuda_graph_enable = 0;
+  std::shared_ptr<TensorrtEngineBuildState> engine_build_state;
+
+  // Optimization profiles from the observed traffic, with trt_profile_warmup_runs. The dynamic dimensions of the
+  // inputs are counted during the warm-up runs and then clustered into the profiles of the engine.
+  int profile_warmup_runs = 0;
+  std::vector<std::pair<std::string, size_t>> profile_dims;  // (input name, dimension) of each value of a shape
+  std::map<std::vector<int64_t>, size_t> observed_shapes;    // number of warm-up runs of each shape
+  int observed_runs = 0;
+  bool traffic_profiles_ready = false;
 };
 
 // Logical device representation.
@@ -198,7 +214,7 @@ class TensorrtExecutionProvider : public IExecutionProvider {
   int auxiliary_streams_ = -1;
   std::string tactic_sources_;
   std::string cache_path_, engine_decryption_lib_path_;
-  std::unique_ptr<nvinfer1::IRuntime> runtime_ = nullptr;
+  std::shared_ptr<nvinfer1::IRuntime> runtime_ = nullptr;
   OrtMutex tensorrt_mu_;
   int device_id_;
   bool context_memory_sharing_enable_ = false;
@@ -213,6 +229,8 @@ class TensorrtExecutionProvider : public IExecutionProvider {
   bool force_timing_cache_match_ = false;
   bool detailed_build_log_ = false;
   bool cuda_graph_enable_ = false;
+  bool async_engine_build_enable_ = false;
+  int profile_warmup_runs_ = 0;
 
   std::unique_ptr<CUDAGraph> cuda_graph_;  // ORT TRT only supports CUDA graph when whole model is supported by TRT, so simply maintaining a CUDAGraph pointer is enough (no need to maintain one CUDAGraph pointer per TRT subgraph)
   bool is_graph_captured_ = false;
@@ -221,7 +239,7 @@ class TensorrtExecutionProvider : public IExecutionProvider {
 
   std::unordered_set<std::string> control_flow_op_set_ = {"If", "Loop", "Scan"};
   std::unordered_map<std::string, tensorrt_ptr::unique_pointer<nvonnxparser::IParser>> parsers_;
-  std::unordered_map<std::string, std::unique_ptr<nvinfer1::ICudaEngine>> engines_;
+  std::unordered_map<std::string, std::shared_ptr<nvinfer1::ICudaEngine>> engines_;
   std::unordered_map<std::string, std::unique_ptr<nvinfer1::IExecutionContext>> contexts_;
   std::unordered_map<std::string, std::unique_ptr<nvinfer1::IBuilder>> builders_;
   std::unordered_map<std::string, std::unique_ptr<nvinfer1::INetworkDefinition>> networks_;
@@ -269,6 +287,16 @@ class TensorrtExecutionProvider : public IExecutionProvider {
   /**Check whether all the nodes of subgraph are supported*/
   bool IsSubGraphFullySupported(SubGraphCollection_t supported_nodes_vector, const int number_of_ort_nodes) const;
 
+  /**
+  Build the engine of a fused node with the given builder config, and save it to the engine and timing caches when
+  they are enabled. It is called from a background thread with trt_async_engine_build_enable, so it only reads
+  trt_state, and the shape ranges are then a copy owned by the thread.
+  */
+  Status BuildEngine(TensorrtFuncState* trt_state, nvinfer1::IBuilderConfig& trt_config,
+                     std::unordered_map<std::string, std::unordered_map<size_t, std::vector<std::vector<int64_t>>>>& shape_ranges,
+                     const std::string& engine_cache_path, const std::string& profile_cache_path,
+                     const std::string& timing_cache_path, std::shared_ptr<nvinfer1::ICudaEngine>& engine) const;
+
   bool IsGraphCaptureAllowed() const;
   void CaptureBegin();
   void CaptureEnd();
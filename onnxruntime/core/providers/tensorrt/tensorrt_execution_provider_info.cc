@@ -44,6 +44,8 @@ constexpr const char* kProfilesMinShapes = "trt_profile_min_shapes";
 constexpr const char* kProfilesMaxShapes = "trt_profile_max_shapes";
 constexpr const char* kProfilesOptShapes = "trt_profile_opt_shapes";
 constexpr const char* kCudaGraphEnable = "trt_cuda_graph_enable";
+constexpr const char* kAsyncEngineBuildEnable = "trt_async_engine_build_enable";
+constexpr const char* kProfileWarmupRuns = "trt_profile_warmup_runs";
 }  // namespace provider_option_names
 }  // namespace tensorrt
 
@@ -93,6 +95,8 @@ TensorrtExecutionProviderInfo TensorrtExecutionProviderInfo::FromProviderOptions
           .AddAssignmentToReference(tensorrt::provider_option_names::kProfilesMaxShapes, info.profile_max_shapes)
           .AddAssignmentToReference(tensorrt::provider_option_names::kProfilesOptShapes, info.profile_opt_shapes)
           .AddAssignmentToReference(tensorrt::provider_option_names::kCudaGraphEnable, info.cuda_graph_enable)
+          .AddAssignmentToReference(tensorrt::provider_option_names::kAsyncEngineBuildEnable, info.async_engine_build_enable)
+          .AddAssignmentToReference(tensorrt::provider_option_names::kProfileWarmupRuns, info.profile_warmup_runs)
           .Parse(options));  // add new provider option here.
 
   return info;
@@ -132,6 +136,8 @@ ProviderOptions TensorrtExecutionProviderInfo::ToProviderOptions(const TensorrtE
       {tensorrt::provider_option_names::kProfilesMaxShapes, MakeStringWithClassicLocale(info.profile_max_shapes)},
       {tensorrt::provider_option_names::kProfilesOptShapes, MakeStringWithClassicLocale(info.profile_opt_shapes)},
       {tensorrt::provider_option_names::kCudaGraphEnable, MakeStringWithClassicLocale(info.cuda_graph_enable)},
+      {tensorrt::provider_option_names::kAsyncEngineBuildEnable, MakeStringWithClassicLocale(info.async_engine_build_enable)},
+      {tensorrt::provider_option_names::kProfileWarmupRuns, MakeStringWithClassicLocale(info.profile_warmup_runs)},
   };
   return options;
 }
@@ -179,6 +185,8 @@ ProviderOptions TensorrtExecutionProviderInfo::ToProviderOptions(const OrtTensor
       {tensorrt::provider_option_names::kProfilesMaxShapes, kProfilesMaxShapes_},
       {tensorrt::provider_option_names::kProfilesOptShapes, kProfilesOptShapes_},
       {tensorrt::provider_option_names::kCudaGraphEnable, MakeStringWithClassicLocale(info.trt_cuda_graph_enable)},
+      {tensorrt::provider_option_names::kAsyncEngineBuildEnable, MakeStringWithClassicLocale(info.trt_async_engine_build_enable)},
+      {tensorrt::provider_option_names::kProfileWarmupRuns, MakeStringWithClassicLocale(info.trt_profile_warmup_runs)},
   };
   return options;
 }
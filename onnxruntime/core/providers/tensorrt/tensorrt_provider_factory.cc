@@ -95,6 +95,8 @@ struct Tensorrt_Provider : Provider {
     info.profile_max_shapes = options.trt_profile_max_shapes == nullptr ? "" : options.trt_profile_max_shapes;
     info.profile_opt_shapes = options.trt_profile_opt_shapes == nullptr ? "" : options.trt_profile_opt_shapes;
     info.cuda_graph_enable = options.trt_cuda_graph_enable != 0;
+    info.async_engine_build_enable = options.trt_async_engine_build_enable != 0;
+    info.profile_warmup_runs = options.trt_profile_warmup_runs;
 
     common::Status status = CreateTensorRTCustomOpDomainList(info);
     if (!status.IsOK()) {
@@ -232,6 +234,8 @@ struct Tensorrt_Provider : Provider {
     }
 
     trt_options.trt_cuda_graph_enable = internal_options.cuda_graph_enable;
+    trt_options.trt_async_engine_build_enable = internal_options.async_engine_build_enable;
+    trt_options.trt_profile_warmup_runs = internal_options.profile_warmup_runs;
   }
 
   ProviderOptions GetProviderOptions(const void* provider_options) override {
@@ -20,9 +20,11 @@
 #include "core/providers/xnnpack/nn/max_pool.h"
 #include "core/providers/xnnpack/math/gemm.h"
 #include "core/providers/xnnpack/math/matmul.h"
+#include "core/providers/xnnpack/math/elementwise.h"
 #include "core/providers/xnnpack/nn/average_pool.h"
 #include "core/providers/xnnpack/nn/resize.h"
 #include "core/providers/xnnpack/nn/softmax.h"
+#include "core/providers/xnnpack/tensor/transpose.h"
 
 namespace onnxruntime {
 namespace xnnpack {
@@ -100,6 +102,11 @@ bool NodeSupportChecker::IsNodeSupported(const NodeUnit& nodeunit) {
       {"Resize", Resize::IsOnnxNodeSupported},
       {"Gemm", Gemm::IsOnnxNodeSupported},
       {"MatMul", MatMul::IsOnnxNodeSupported},
+      {"Add", BinaryElementwise::IsOnnxNodeSupported},
+      {"Sub", BinaryElementwise::IsOnnxNodeSupported},
+      {"Mul", BinaryElementwise::IsOnnxNodeSupported},
+      {"Div", BinaryElementwise::IsOnnxNodeSupported},
+      {"Transpose", Transpose::IsOnnxNodeSupported},
   };
 
   bool supported = false;
@@ -0,0 +1,159 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/providers/xnnpack/math/elementwise.h"
+
+#include <algorithm>
+#include <unordered_map>
+
+#include "core/common/inlined_containers.h"
+#include "core/graph/graph_viewer.h"
+
+namespace onnxruntime {
+namespace xnnpack {
+
+namespace {
+using CreateFn = xnn_status (*)(float output_min, float output_max, uint32_t flags, xnn_operator_t* op_out);
+
+struct BinaryOpFns {
+  CreateFn create;
+  xnn_status (*setup)(xnn_operator_t, size_t, const size_t*, size_t, const size_t*,
+                      const float*, const float*, float*, pthreadpool_t);
+};
+
+const BinaryOpFns* GetBinaryOpFns(const std::string& op_type) {
+  static const std::unordered_map<std::string, BinaryOpFns> op_fns{
+      {"Add", {xnn_create_add_nd_f32, xnn_setup_add_nd_f32}},
+      {"Sub", {xnn_create_subtract_nd_f32, xnn_setup_subtract_nd_f32}},
+      {"Mul", {xnn_create_multiply_nd_f32, xnn_setup_multiply_nd_f32}},
+      {"Div", {xnn_create_divide_nd_f32, xnn_setup_divide_nd_f32}},
+  };
+
+  auto it = op_fns.find(op_type);
+  return it == op_fns.end() ? nullptr : &it->second;
+}
+
+// numpy style broadcasting of the two input shapes
+Status ComputeBroadcastShape(const TensorShape& a_shape, const TensorShape& b_shape,
+                             TensorShapeVector& output_dims) {
+  const size_t a_rank = a_shape.NumDimensions();
+  const size_t b_rank = b_shape.NumDimensions();
+  const size_t rank = std::max(a_rank, b_rank);
+  output_dims.resize(rank);
+  for (size_t i = 0; i < rank; ++i) {
+    const int64_t a_dim = i < rank - a_rank ? 1 : a_shape[i - (rank - a_rank)];
+    const int64_t b_dim = i < rank - b_rank ? 1 : b_shape[i - (rank - b_rank)];
+    if (a_dim != b_dim && a_dim != 1 && b_dim != 1) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input shapes ", a_shape, " and ", b_shape,
+                             " can't be broadcast.");
+    }
+    output_dims[i] = a_dim == 1 ? b_dim : a_dim;
+  }
+
+  return Status::OK();
+}
+}  // namespace
+
+bool BinaryElementwise::IsOnnxNodeSupported(const NodeUnit& node_unit, const GraphViewer& /*graph*/) {
+  bool supported = false;
+
+  // use do {} while(false) so it's easier to set a breakpoint on the return
+  do {
+    if (node_unit.UnitType() != NodeUnit::Type::SingleNode || GetBinaryOpFns(node_unit.OpType()) == nullptr) {
+      break;
+    }
+
+    const auto& inputs = node_unit.Inputs();
+    if (inputs.size() != 2) {
+      break;
+    }
+
+    bool inputs_supported = true;
+    for (const auto& input : inputs) {
+      // float only. the rank must be known and within what xnnpack handles, the dims may be dynamic.
+      const auto* type = input.node_arg.TypeAsProto();
+      const auto* shape = input.node_arg.Shape();
+      if (type == nullptr || type->tensor_type().elem_type() != ONNX_NAMESPACE::TensorProto_DataType_FLOAT ||
+          shape == nullptr || shape->dim_size() > XNN_MAX_TENSOR_DIMS) {
+        inputs_supported = false;
+        break;
+      }
+    }
+
+    supported = inputs_supported;
+  } while (false);
+
+  return supported;
+}
+
+BinaryElementwise::BinaryElementwise(const OpKernelInfo& info) : XnnpackKernel(info) {
+  const auto& op_type = info.node().OpType();
+  const BinaryOpFns* fns = GetBinaryOpFns(op_type);
+  ORT_ENFORCE(fns != nullptr, "Unsupported binary elementwise op in XnnpackEP: ", op_type);
+  setup_fn_ = fns->setup;
+
+  struct xnn_operator* p = nullptr;
+  xnn_status xstatus = fns->create(-INFINITY, INFINITY, 0 /*flags*/, &p);
+  ORT_ENFORCE(xstatus == xnn_status_success, "xnn_create for ", op_type, " failed. Status:", xstatus);
+  op0_.reset(p);
+}
+
+Status BinaryElementwise::Compute(OpKernelContext* ctx) const {
+  const Tensor& A = *ctx->Input<Tensor>(0);
+  const Tensor& B = *ctx->Input<Tensor>(1);
+
+  TensorShapeVector output_dims;
+  ORT_RETURN_IF_ERROR(ComputeBroadcastShape(A.Shape(), B.Shape(), output_dims));
+  Tensor* Y = ctx->Output(0, TensorShape(output_dims));
+
+  // edge case. one or more dims with value of 0. nothing to do
+  if (Y->Shape().Size() == 0) {
+    return Status::OK();
+  }
+
+  InlinedVector<size_t> a_dims(A.Shape().GetDims().begin(), A.Shape().GetDims().end());
+  InlinedVector<size_t> b_dims(B.Shape().GetDims().begin(), B.Shape().GetDims().end());
+
+  pthreadpool_t t_pool = GetThreadPool();
+  xnn_status status = setup_fn_(op0_.get(),
+                                a_dims.size(), a_dims.data(),
+                                b_dims.size(), b_dims.data(),
+                                A.Data<float>(), B.Data<float>(), Y->MutableData<float>(),
+                                t_pool);
+  if (status != xnn_status_success) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "xnn_setup for ", Node().OpType(), " returned ", status);
+  }
+
+  status = xnn_run_operator(op0_.get(), t_pool);
+  if (status != xnn_status_success) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "xnn_run_operator returned ", status);
+  }
+
+  return Status::OK();
+}
+
+#define REGISTER_BINARY_OP_VERSIONED(op, since_version, end_version)                                   \
+  ONNX_OPERATOR_VERSIONED_KERNEL_EX(                                                                   \
+      op, kOnnxDomain, since_version, end_version, kXnnpackExecutionProvider,                          \
+      KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()), BinaryElementwise);
+
+#define REGISTER_BINARY_OP(op, since_version)                                                          \
+  ONNX_OPERATOR_KERNEL_EX(                                                                             \
+      op, kOnnxDomain, since_version, kXnnpackExecutionProvider,                                       \
+      KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()), BinaryElementwise);
+
+REGISTER_BINARY_OP_VERSIONED(Add, 7, 12)
+REGISTER_BINARY_OP_VERSIONED(Add, 13, 13)
+REGISTER_BINARY_OP(Add, 14)
+REGISTER_BINARY_OP_VERSIONED(Sub, 7, 12)
+REGISTER_BINARY_OP_VERSIONED(Sub, 13, 13)
+REGISTER_BINARY_OP(Sub, 14)
+REGISTER_BINARY_OP_VERSIONED(Mul, 7, 12)
+REGISTER_BINARY_OP_VERSIONED(Mul, 13, 13)
+REGISTER_BINARY_OP(Mul, 14)
+REGISTER_BINARY_OP_VERSIONED(Div, 7, 12)
+REGISTER_BINARY_OP_VERSIONED(Div, 13, 13)
+REGISTER_BINARY_OP(Div, 14)
+
+}  // namespace xnnpack
+}  // namespace onnxruntime
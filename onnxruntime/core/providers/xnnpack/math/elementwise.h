@@ -0,0 +1,33 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/providers/xnnpack/xnnpack_kernel.h"
+#include "core/providers/xnnpack/detail/utils.h"
+
+namespace onnxruntime {
+class GraphViewer;
+namespace xnnpack {
+
+// Add, Sub, Mul and Div with numpy style broadcasting
+class BinaryElementwise final : public XnnpackKernel {
+ public:
+  BinaryElementwise(const OpKernelInfo& info);
+
+  Status Compute(OpKernelContext* ctx) const override;
+
+  static bool IsOnnxNodeSupported(const NodeUnit& node_unit, const GraphViewer& graph);
+
+ private:
+  using SetupFn = xnn_status (*)(xnn_operator_t op, size_t num_input1_dims, const size_t* input1_shape,
+                                 size_t num_input2_dims, const size_t* input2_shape,
+                                 const float* input1, const float* input2, float* output,
+                                 pthreadpool_t threadpool);
+
+  SetupFn setup_fn_ = nullptr;
+  XnnpackOperator op0_;
+};
+
+}  // namespace xnnpack
+}  // namespace onnxruntime
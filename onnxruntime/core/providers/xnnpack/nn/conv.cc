@@ -38,6 +38,9 @@ Status Conv::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
 
     // we can create the kernel now
     ORT_RETURN_IF_ERROR(CreateKernel());
+
+    // xnnpack packed its own copy of the weights when creating the kernel, so the re-laid-out copy can go
+    packed_w_ = Tensor();
   }
 
   return Status::OK();
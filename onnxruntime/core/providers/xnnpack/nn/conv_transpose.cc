@@ -60,6 +60,9 @@ Status ConvTranspose::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr
     // we can create the kernel now
     auto ret = CreateKernel();
     ORT_RETURN_IF_ERROR(ret);
+
+    // xnnpack packed its own copy of the weights when creating the kernel, so the re-laid-out copy can go
+    packed_w_ = Tensor();
   }
 
   return Status::OK();
@@ -0,0 +1,89 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/providers/xnnpack/tensor/transpose.h"
+
+#include "core/common/inlined_containers.h"
+#include "core/graph/graph_viewer.h"
+
+namespace onnxruntime {
+namespace xnnpack {
+
+bool Transpose::IsOnnxNodeSupported(const NodeUnit& node_unit, const GraphViewer& /*graph*/) {
+  bool supported = false;
+
+  // use do {} while(false) so it's easier to set a breakpoint on the return
+  do {
+    if (node_unit.UnitType() != NodeUnit::Type::SingleNode) {
+      break;
+    }
+
+    // the x32 transpose moves any 32-bit element, we take float to match the rest of the EP.
+    // the rank must be known and within what xnnpack handles, the dims may be dynamic.
+    const auto& x_arg = node_unit.Inputs()[0].node_arg;
+    const auto* x_type = x_arg.TypeAsProto();
+    const auto* x_shape = x_arg.Shape();
+    if (x_type == nullptr || x_type->tensor_type().elem_type() != ONNX_NAMESPACE::TensorProto_DataType_FLOAT ||
+        x_shape == nullptr || x_shape->dim_size() == 0 || x_shape->dim_size() > XNN_MAX_TENSOR_DIMS) {
+      break;
+    }
+
+    supported = true;
+  } while (false);
+
+  return supported;
+}
+
+Transpose::Transpose(const OpKernelInfo& info) : TransposeBase(info), XnnpackKernel(info) {
+  struct xnn_operator* p = nullptr;
+  xnn_status xstatus = xnn_create_transpose_nd_x32(0 /*flags*/, &p);
+  ORT_ENFORCE(xstatus == xnn_status_success, "xnn_create_transpose_nd_x32 failed. Status:", xstatus);
+  op0_.reset(p);
+}
+
+Status Transpose::Compute(OpKernelContext* ctx) const {
+  const Tensor& X = *ctx->Input<Tensor>(0);
+
+  TensorShapeVector output_dims;
+  InlinedVector<size_t> default_perm;
+  const InlinedVector<size_t>* p_perm = nullptr;
+  ORT_RETURN_IF_ERROR(ComputeOutputShape(X, output_dims, default_perm, p_perm));
+  Tensor* Y = ctx->Output(0, TensorShape(output_dims));
+
+  // edge case. one or more dims with value of 0. nothing to do
+  if (Y->Shape().Size() == 0) {
+    return Status::OK();
+  }
+
+  InlinedVector<size_t> x_dims(X.Shape().GetDims().begin(), X.Shape().GetDims().end());
+
+  pthreadpool_t t_pool = GetThreadPool();
+  xnn_status status = xnn_setup_transpose_nd_x32(op0_.get(),
+                                                 X.DataRaw(),
+                                                 Y->MutableDataRaw(),
+                                                 x_dims.size(),
+                                                 x_dims.data(),
+                                                 p_perm->data(),
+                                                 t_pool);
+  if (status != xnn_status_success) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "xnn_setup_transpose_nd_x32 returned ", status);
+  }
+
+  status = xnn_run_operator(op0_.get(), t_pool);
+  if (status != xnn_status_success) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "xnn_run_operator returned ", status);
+  }
+
+  return Status::OK();
+}
+
+ONNX_OPERATOR_VERSIONED_KERNEL_EX(Transpose, kOnnxDomain, 1, 12, kXnnpackExecutionProvider,
+                                  KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+                                  Transpose);
+
+ONNX_OPERATOR_KERNEL_EX(Transpose, kOnnxDomain, 13, kXnnpackExecutionProvider,
+                        KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+                        Transpose);
+
+}  // namespace xnnpack
+}  // namespace onnxruntime
@@ -0,0 +1,27 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/providers/xnnpack/xnnpack_kernel.h"
+#include "core/providers/cpu/tensor/transpose.h"
+#include "core/providers/xnnpack/detail/utils.h"
+
+namespace onnxruntime {
+class GraphViewer;
+namespace xnnpack {
+
+class Transpose final : protected TransposeBase, public XnnpackKernel {
+ public:
+  Transpose(const OpKernelInfo& info);
+
+  Status Compute(OpKernelContext* ctx) const override;
+
+  static bool IsOnnxNodeSupported(const NodeUnit& node_unit, const GraphViewer& graph);
+
+ private:
+  XnnpackOperator op0_;
+};
+
+}  // namespace xnnpack
+}  // namespace onnxruntime
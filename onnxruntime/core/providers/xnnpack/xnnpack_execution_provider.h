@@ -44,13 +44,14 @@ class XnnpackExecutionProvider : public IExecutionProvider {
   bool ConcurrentRunSupported() const override { return false; }
 
   pthreadpool* GetPrivateThreadPool() const {
-    return xnnpack_thread_pool_;
+    return xnnpack_thread_pool_.get();
   }
 
   std::vector<AllocatorPtr> CreatePreferredAllocators() override;
 
  private:
-  pthreadpool* xnnpack_thread_pool_{nullptr};
+  // shared with the other EP instances of the process that use the same number of threads
+  std::shared_ptr<pthreadpool> xnnpack_thread_pool_;
 };
 
 }  // namespace onnxruntime
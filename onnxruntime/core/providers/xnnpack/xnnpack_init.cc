@@ -1,6 +1,9 @@
 
 #include "xnnpack_init.h"
 
+#include <mutex>
+#include <unordered_map>
+
 #include "core/graph/constants.h"
 
 #include "xnnpack.h"
@@ -54,5 +57,20 @@ std::pair<AllocatorPtr&, xnn_allocator*> GetStoredAllocator() {
   return {ort_allocator, &xnn_allocator_wrapper_};
 }
 
+std::shared_ptr<pthreadpool> GetSharedThreadPool(size_t num_threads) {
+  static std::mutex mutex;
+  static std::unordered_map<size_t, std::weak_ptr<pthreadpool>> thread_pools;
+
+  std::lock_guard<std::mutex> lock(mutex);
+  auto& entry = thread_pools[num_threads];
+  std::shared_ptr<pthreadpool> thread_pool = entry.lock();
+  if (!thread_pool) {
+    thread_pool = std::shared_ptr<pthreadpool>(pthreadpool_create(num_threads), pthreadpool_destroy);
+    entry = thread_pool;
+  }
+
+  return thread_pool;
+}
+
 }  // namespace xnnpack
 }  // namespace onnxruntime
@@ -1,11 +1,17 @@
 #include "core/framework/allocator.h"
 
 struct xnn_allocator;
+struct pthreadpool;
 
 namespace onnxruntime {
 namespace xnnpack {
 
 std::pair<AllocatorPtr&, xnn_allocator*> GetStoredAllocator();
 
+// pthreadpool with num_threads threads, shared by all the EP instances of the process that ask for the same size.
+// pthreadpool serializes the parallel calls of its users, so sessions running together don't oversubscribe the cores
+// with one pool each. The pool is destroyed with the last EP instance holding it.
+std::shared_ptr<pthreadpool> GetSharedThreadPool(size_t num_threads);
+
 }  // namespace xnnpack
 }  // namespace onnxruntime
@@ -2,6 +2,9 @@
 // Licensed under the MIT License.
 
 #include "core/session/IOBinding.h"
+
+#include <algorithm>
+
 #include "core/common/logging/logging.h"
 #include "core/framework/session_state.h"
 #include "core/framework/op_kernel.h"
@@ -38,6 +41,14 @@ common::Status IOBinding::BindInput(const std::string& name, const OrtValue& ml_
 
   ORT_ENFORCE(mapped_feed_names_.size() == feed_names_.size(), "Size mismatch:", mapped_feed_names_.size(), "!=", feed_names_.size(), " index=", it.first->second, " it.second=", it.second);
 
+  // a state restarts from the value bound by the user
+  for (auto& state : states_) {
+    if (state.input_name == name) {
+      state.has_output = false;
+      state.input_is_output = false;
+    }
+  }
+
   return Status::OK();
 }
 
@@ -45,6 +56,9 @@ void IOBinding::ClearInputs() {
   mapped_feed_names_.clear();
   feed_names_.clear();
   feeds_.clear();
+  for (auto& state : states_) {
+    state.input_is_output = false;
+  }
 }
 
 static common::Status SyncProviders(const SessionState::NameNodeInfoMapType& node_info_map,
@@ -108,6 +122,69 @@ void IOBinding::ClearOutputs() {
   output_names_.clear();
   outputs_.clear();
   outputs_device_info_.clear();
+  states_.clear();
+}
+
+common::Status IOBinding::BindState(const std::string& output_name, const std::string& input_name, OrtDevice device) {
+  ORT_RETURN_IF_ERROR(BindOutputImpl(output_name, {}, device));
+
+  auto it = std::find_if(states_.begin(), states_.end(),
+                         [&output_name](const State& state) { return state.output_name == output_name; });
+  if (it == states_.end()) {
+    it = states_.insert(states_.end(), State{});
+  }
+  it->output_name = output_name;
+  it->input_name = input_name;
+  it->device = device;
+  it->has_output = false;
+  it->input_is_output = false;
+
+  return Status::OK();
+}
+
+void IOBinding::AdvanceStates() {
+  for (auto& state : states_) {
+    if (!state.has_output) {
+      continue;
+    }
+    state.has_output = false;
+
+    auto output_it = mapped_output_names_.find(state.output_name);
+    if (output_it == mapped_output_names_.end()) {
+      continue;
+    }
+    const size_t output_index = output_it->second;
+    OrtValue value = outputs_[output_index];
+
+    OrtValue previous;
+    auto feed_it = mapped_feed_names_.emplace(state.input_name, feed_names_.size());
+    if (feed_it.second) {
+      feed_names_.push_back(state.input_name);
+      feeds_.push_back(value);
+    } else {
+      previous = feeds_[feed_it.first->second];
+      feeds_[feed_it.first->second] = value;
+    }
+
+    // The buffer of the previous state is not read by anyone any more, so the next state is produced in it.
+    // A buffer bound by the user is never written to, and neither is one of another shape or location.
+    bool reuse = state.input_is_output && previous.IsAllocated() && previous.IsTensor() && value.IsTensor();
+    if (reuse) {
+      const Tensor& previous_tensor = previous.Get<Tensor>();
+      const Tensor& tensor = value.Get<Tensor>();
+      reuse = previous_tensor.Shape() == tensor.Shape() && previous_tensor.DataType() == tensor.DataType() &&
+              previous_tensor.Location().device == tensor.Location().device;
+    }
+    outputs_[output_index] = reuse ? previous : OrtValue();
+    outputs_device_info_[output_index] = state.device;
+    state.input_is_output = true;
+  }
+}
+
+void IOBinding::OnRunCompleted() {
+  for (auto& state : states_) {
+    state.has_output = true;
+  }
 }
 
 const std::vector<std::string>& IOBinding::GetOutputNames() const { return output_names_; }
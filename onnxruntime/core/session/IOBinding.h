@@ -71,6 +71,17 @@ class IOBinding {
    */
   common::Status BindOutput(const std::string& name, OrtDevice device = {});
 
+  /**
+   * Bind an output to an input as a recurrent state, as the hidden state of a streaming model is.
+   * Each Run() after the first feeds the value that the previous Run() produced for the output to the input,
+   * without copying it, and the output is produced in the buffer that the input held, so that the state stays
+   * where it was produced across calls. The first Run() reads the value bound with BindInput().
+   * Binding the input again with BindInput() restarts the state from that value.
+   *
+   * @param device Device to allocate the output on for the first Run(). Default is CPU.
+   */
+  common::Status BindState(const std::string& output_name, const std::string& input_name, OrtDevice device = {});
+
   /**
    * This simply collects the outputs obtained after calling Run() inside the @param outputs.
    */
@@ -90,6 +101,7 @@ class IOBinding {
 
   /**
    * clear inputs or outputs. IOBinding is stateful. There are cases we need to reset its state.
+   * Clearing the outputs also removes the bindings of states.
    */
   void ClearOutputs();
   void ClearInputs();
@@ -107,8 +119,25 @@ class IOBinding {
   std::vector<OrtValue> outputs_;
   std::vector<OrtDevice> outputs_device_info_;
 
+  struct State {
+    std::string output_name;
+    std::string input_name;
+    OrtDevice device;
+    // the output of the last Run() is the next value of the input
+    bool has_output = false;
+    // the input holds a value that a Run() produced, whose buffer can be reused for the output
+    bool input_is_output = false;
+  };
+  std::vector<State> states_;
+
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(IOBinding);
 
+  // Feeds the outputs of the last Run() to the inputs of their states. Called by InferenceSession before a Run().
+  void AdvanceStates();
+
+  // Called by InferenceSession after a successful Run().
+  void OnRunCompleted();
+
   // device info for all outputs. only used by InferenceSession if the output is not pre-allocated.
   const std::vector<OrtDevice>& GetOutputsDeviceInfo() const;
 
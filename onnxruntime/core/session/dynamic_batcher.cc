@@ -0,0 +1,246 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/session/dynamic_batcher.h"
+
+#include <cstring>
+#include <sstream>
+
+#include "core/framework/allocator.h"
+#include "core/framework/tensor.h"
+
+namespace onnxruntime {
+
+namespace {
+bool IsMergeableTensor(const OrtValue& value) {
+  if (!value.IsTensor()) {
+    return false;
+  }
+  const Tensor& tensor = value.Get<Tensor>();
+  return !tensor.IsDataTypeString() &&
+         tensor.Location().device.Type() == OrtDevice::CPU &&
+         tensor.Shape().NumDimensions() > 0;
+}
+}  // namespace
+
+DynamicBatcher::DynamicBatcher(size_t max_batch_size, std::chrono::microseconds max_delay, RunFn run_fn)
+    : max_batch_size_(max_batch_size),
+      max_delay_(max_delay),
+      run_fn_(std::move(run_fn)),
+      cpu_allocator_(std::make_shared<CPUAllocator>()) {
+  ORT_ENFORCE(max_batch_size_ > 1, "Dynamic batching requires a maximum batch size greater than 1");
+}
+
+std::string DynamicBatcher::MakeBatchKey(gsl::span<const std::string> feed_names,
+                                         gsl::span<const OrtValue> feeds,
+                                         gsl::span<const std::string> output_names,
+                                         const std::vector<OrtValue>& fetches,
+                                         int64_t& batch_size) const {
+  batch_size = 0;
+  if (feeds.empty() || feed_names.size() != feeds.size()) {
+    return {};
+  }
+
+  // Pre-allocated outputs are written in place, which a merged run cannot do.
+  for (const auto& fetch : fetches) {
+    if (fetch.IsAllocated()) {
+      return {};
+    }
+  }
+
+  std::ostringstream key;
+  for (size_t i = 0; i < feeds.size(); ++i) {
+    if (!IsMergeableTensor(feeds[i])) {
+      return {};
+    }
+
+    const Tensor& tensor = feeds[i].Get<Tensor>();
+    const auto dims = tensor.Shape().GetDims();
+    if (i == 0) {
+      batch_size = dims[0];
+    } else if (dims[0] != batch_size) {
+      return {};
+    }
+
+    key << feed_names[i] << ':' << tensor.GetElementType() << ':';
+    for (size_t d = 1; d < dims.size(); ++d) {
+      key << dims[d] << ',';
+    }
+    key << ';';
+  }
+
+  if (batch_size <= 0 || static_cast<size_t>(batch_size) >= max_batch_size_) {
+    return {};
+  }
+
+  key << '|';
+  for (const auto& name : output_names) {
+    key << name << ';';
+  }
+
+  return key.str();
+}
+
+void DynamicBatcher::CloseBatch(const std::shared_ptr<Batch>& batch) {
+  batch->closed = true;
+  open_batches_.remove(batch);
+  batch->cv.notify_all();
+}
+
+Status DynamicBatcher::Run(const RunOptions& run_options,
+                           gsl::span<const std::string> feed_names,
+                           gsl::span<const OrtValue> feeds,
+                           gsl::span<const std::string> output_names,
+                           std::vector<OrtValue>* p_fetches) {
+  int64_t batch_size = 0;
+  const std::string key = MakeBatchKey(feed_names, feeds, output_names, *p_fetches, batch_size);
+  if (key.empty()) {
+    return run_fn_(run_options, feed_names, feeds, output_names, p_fetches);
+  }
+
+  Request request{feeds, p_fetches, batch_size, Status::OK()};
+  std::shared_ptr<Batch> batch;
+
+  {
+    std::unique_lock<OrtMutex> lock(mutex_);
+
+    for (const auto& open_batch : open_batches_) {
+      if (open_batch->key == key) {
+        batch = open_batch;
+        break;
+      }
+    }
+
+    if (batch != nullptr && static_cast<size_t>(batch->total_rows + batch_size) > max_batch_size_) {
+      // Let the current batch start and begin a new one with this request.
+      CloseBatch(batch);
+      batch.reset();
+    }
+
+    const bool is_leader = (batch == nullptr);
+    if (is_leader) {
+      batch = std::make_shared<Batch>();
+      batch->key = key;
+      open_batches_.push_back(batch);
+    }
+
+    batch->requests.push_back(&request);
+    batch->total_rows += batch_size;
+    if (static_cast<size_t>(batch->total_rows) >= max_batch_size_) {
+      CloseBatch(batch);
+    }
+
+    if (!is_leader) {
+      while (!batch->done) {
+        batch->cv.wait(lock);
+      }
+      return request.status;
+    }
+
+    const auto deadline = std::chrono::steady_clock::now() + max_delay_;
+    while (!batch->closed) {
+      const auto now = std::chrono::steady_clock::now();
+      if (now >= deadline) {
+        break;
+      }
+      batch->cv.wait_for(lock, deadline - now);
+    }
+
+    if (!batch->closed) {
+      CloseBatch(batch);
+    }
+  }
+
+  // The batch is closed so its request list no longer changes.
+  ORT_TRY {
+    ExecuteBatch(run_options, feed_names, output_names, *batch);
+  }
+  ORT_CATCH(const std::exception& ex) {
+    ORT_HANDLE_EXCEPTION([&]() {
+      for (Request* r : batch->requests) {
+        r->status = ORT_MAKE_STATUS(ONNXRUNTIME, RUNTIME_EXCEPTION, "Dynamic batching failed: ", ex.what());
+      }
+    });
+  }
+
+  {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    batch->done = true;
+  }
+  batch->cv.notify_all();
+
+  return request.status;
+}
+
+void DynamicBatcher::ExecuteBatch(const RunOptions& run_options,
+                                  gsl::span<const std::string> feed_names,
+                                  gsl::span<const std::string> output_names,
+                                  Batch& batch) {
+  auto& requests = batch.requests;
+
+  if (requests.size() == 1) {
+    Request& request = *requests[0];
+    request.status = run_fn_(run_options, feed_names, request.feeds, output_names, request.p_fetches);
+    return;
+  }
+
+  // Concatenate the inputs along the leading dimension.
+  std::vector<OrtValue> merged_feeds(feed_names.size());
+  for (size_t i = 0; i < feed_names.size(); ++i) {
+    const Tensor& first = requests[0]->feeds[i].Get<Tensor>();
+    TensorShape merged_shape(first.Shape());
+    merged_shape[0] = batch.total_rows;
+    Tensor::InitOrtValue(first.DataType(), merged_shape, cpu_allocator_, merged_feeds[i]);
+
+    auto* dst = static_cast<uint8_t*>(merged_feeds[i].GetMutable<Tensor>()->MutableDataRaw());
+    for (const Request* request : requests) {
+      const Tensor& src = request->feeds[i].Get<Tensor>();
+      std::memcpy(dst, src.DataRaw(), src.SizeInBytes());
+      dst += src.SizeInBytes();
+    }
+  }
+
+  std::vector<OrtValue> merged_fetches;
+  Status status = run_fn_(run_options, feed_names, merged_feeds, output_names, &merged_fetches);
+
+  if (status.IsOK()) {
+    for (size_t o = 0; o < merged_fetches.size(); ++o) {
+      if (!IsMergeableTensor(merged_fetches[o]) ||
+          merged_fetches[o].Get<Tensor>().Shape()[0] != batch.total_rows) {
+        status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Dynamic batching requires output '", output_names[o],
+                                 "' to be a CPU tensor whose leading dimension is the batch size");
+        break;
+      }
+    }
+  }
+
+  if (status.IsOK()) {
+    // Split the outputs back along the leading dimension.
+    std::vector<const uint8_t*> src(merged_fetches.size());
+    for (size_t o = 0; o < merged_fetches.size(); ++o) {
+      src[o] = static_cast<const uint8_t*>(merged_fetches[o].Get<Tensor>().DataRaw());
+    }
+
+    for (Request* request : requests) {
+      auto& fetches = *request->p_fetches;
+      fetches.resize(merged_fetches.size());
+      for (size_t o = 0; o < merged_fetches.size(); ++o) {
+        const Tensor& merged = merged_fetches[o].Get<Tensor>();
+        const size_t row_bytes = merged.SizeInBytes() / static_cast<size_t>(batch.total_rows);
+        const size_t bytes = row_bytes * static_cast<size_t>(request->batch_size);
+
+        TensorShape shape(merged.Shape());
+        shape[0] = request->batch_size;
+        Tensor::InitOrtValue(merged.DataType(), shape, cpu_allocator_, fetches[o]);
+        std::memcpy(fetches[o].GetMutable<Tensor>()->MutableDataRaw(), src[o], bytes);
+        src[o] += bytes;
+      }
+    }
+  }
+
+  for (Request* request : requests) {
+    request->status = status;
+  }
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,94 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <list>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/gsl.h"
+#include "core/common/status.h"
+#include "core/framework/allocator.h"
+#include "core/framework/ort_value.h"
+#include "core/framework/run_options.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+
+/**
+ * Merges concurrent Run() calls whose inputs differ only in their leading (batch) dimension into a single
+ * Run() and splits the outputs back along their leading dimension.
+ *
+ * There is no dedicated scheduling thread: the first request of a batch becomes its leader, waits up to
+ * max_delay for compatible requests (or until max_batch_size rows are collected), runs the merged batch on
+ * its own thread and hands the results to the other callers.
+ *
+ * Requests that cannot be merged run directly: non-tensor or string inputs, inputs not in CPU memory,
+ * scalar inputs, inputs with inconsistent batch sizes, pre-allocated outputs, and requests that alone reach
+ * max_batch_size. A merged run uses the run options of its leader.
+ */
+class DynamicBatcher {
+ public:
+  using RunFn = std::function<Status(const RunOptions& run_options,
+                                     gsl::span<const std::string> feed_names,
+                                     gsl::span<const OrtValue> feeds,
+                                     gsl::span<const std::string> output_names,
+                                     std::vector<OrtValue>* p_fetches)>;
+
+  DynamicBatcher(size_t max_batch_size, std::chrono::microseconds max_delay, RunFn run_fn);
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(DynamicBatcher);
+
+  Status Run(const RunOptions& run_options,
+             gsl::span<const std::string> feed_names,
+             gsl::span<const OrtValue> feeds,
+             gsl::span<const std::string> output_names,
+             std::vector<OrtValue>* p_fetches);
+
+ private:
+  struct Request {
+    gsl::span<const OrtValue> feeds;
+    std::vector<OrtValue>* p_fetches;
+    int64_t batch_size;
+    Status status;
+  };
+
+  struct Batch {
+    std::string key;
+    std::vector<Request*> requests;
+    int64_t total_rows = 0;
+    bool closed = false;
+    bool done = false;
+    OrtCondVar cv;
+  };
+
+  // Returns an empty key if the request cannot be merged with others.
+  std::string MakeBatchKey(gsl::span<const std::string> feed_names,
+                           gsl::span<const OrtValue> feeds,
+                           gsl::span<const std::string> output_names,
+                           const std::vector<OrtValue>& fetches,
+                           int64_t& batch_size) const;
+
+  void CloseBatch(const std::shared_ptr<Batch>& batch);
+
+  void ExecuteBatch(const RunOptions& run_options,
+                    gsl::span<const std::string> feed_names,
+                    gsl::span<const std::string> output_names,
+                    Batch& batch);
+
+  const size_t max_batch_size_;
+  const std::chrono::microseconds max_delay_;
+  const RunFn run_fn_;
+  const AllocatorPtr cpu_allocator_;
+
+  OrtMutex mutex_;
+  // Batches that still accept requests. Closed batches are removed from this list.
+  std::list<std::shared_ptr<Batch>> open_batches_;
+};
+
+}  // namespace onnxruntime
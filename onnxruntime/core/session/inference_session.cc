@@ -13,8 +13,10 @@
 
 #include "core/common/denormal.h"
 #include "core/common/logging/logging.h"
+#include "core/common/metrics.h"
 #include "core/common/parse_string.h"
 #include "core/common/path_string.h"
+#include "core/common/string_utils.h"
 #include "core/flatbuffers/flatbuffers_utils.h"
 #include "core/flatbuffers/ort_format_version.h"
 #include "core/framework/bfc_arena.h"
@@ -22,11 +24,15 @@
 #include "core/framework/execution_frame.h"
 #include "core/framework/feeds_fetches_manager.h"
 #include "core/framework/graph_partitioner.h"
+#include "core/framework/partitioning_cost_model.h"
+#include "core/framework/profile_guided_optimization.h"
 #include "core/framework/kernel_def_builder.h"
 #include "core/framework/kernel_registry.h"
 #include "core/framework/kernel_type_str_resolver.h"
 #include "core/framework/kernel_type_str_resolver_utils.h"
 #include "core/framework/mldata_type_utils.h"
+#include "core/framework/node_flops.h"
+#include "core/framework/nvtx_ranges.h"
 #include "core/framework/TensorSeq.h"
 #include "core/framework/tensorprotoutils.h"
 #include "core/framework/tensor_type_and_shape.h"
@@ -54,6 +60,7 @@
 #include "core/providers/dml/DmlExecutionProvider/src/GraphTransformer.h"
 #include "core/providers/dml/dml_session_options_config_keys.h"
 #endif
+#include "core/session/dynamic_batcher.h"
 #include "core/session/environment.h"
 #include "core/session/IOBinding.h"
 #include "core/session/inference_session_utils.h"
@@ -132,7 +139,7 @@ static bool HasMemcpyNodes(const Graph& graph) {
   return false;
 }
 
-static bool AreAllComputeNodesAssignedToCudaEp(const Graph& graph) {
+static bool AreAllComputeNodesAssignedToCudaOrRocmEp(const Graph& graph, ProviderType provider) {
   bool nodes_on_cpu_and_cuda_eps_only = true;
 
   for (const auto& node : graph.Nodes()) {
@@ -140,7 +147,7 @@ static bool AreAllComputeNodesAssignedToCudaEp(const Graph& graph) {
 
     // Empty node provider means CPU EP
     if (!node_provider.empty() &&
-        node_provider != kCudaExecutionProvider &&
+        node_provider != provider &&
         node_provider != kCpuExecutionProvider) {
       nodes_on_cpu_and_cuda_eps_only = false;
       break;
@@ -349,6 +356,8 @@ void InferenceSession::ConstructorCommon(const SessionOptions& session_options,
         // If the thread pool can use all the processors, then
         // we set affinity of each thread to each processor.
         to.allow_spinning = allow_intra_op_spinning;
+        to.adaptive_spinning =
+            session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigAdaptiveIntraOpSpinning, "0") == "1";
         to.dynamic_block_base_ = std::stoi(session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigDynamicBlockBase, "0"));
         LOGS(*session_logger_, INFO) << "Dynamic block base set to " << to.dynamic_block_base_;
 
@@ -362,6 +371,17 @@ void InferenceSession::ConstructorCommon(const SessionOptions& session_options,
         to.auto_set_affinity = to.thread_pool_size == 0 &&
                                session_options_.execution_mode == ExecutionMode::ORT_SEQUENTIAL &&
                                to.affinity_str.empty();
+        to.numa_aware =
+            session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigIntraOpNumaAware, "0") == "1";
+        to.parallel_for_calibration =
+            session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigIntraOpParallelForCalibration,
+                                                               "0") == "1";
+        to.parallel_for_calibration_file = ToPathString(
+            session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigIntraOpParallelForCalibrationFile,
+                                                               ""));
+        to.heterogeneous_scheduling =
+            session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigIntraOpHeterogeneousScheduling,
+                                                               "0") == "1";
 
         if (to.custom_create_thread_fn) {
           ORT_ENFORCE(to.custom_join_thread_fn, "custom join thread function not set for intra op thread pool");
@@ -386,6 +406,8 @@ void InferenceSession::ConstructorCommon(const SessionOptions& session_options,
         to.name = inter_thread_pool_name_.c_str();
         to.set_denormal_as_zero = set_denormal_as_zero;
         to.allow_spinning = allow_inter_op_spinning;
+        to.adaptive_spinning =
+            session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigAdaptiveInterOpSpinning, "0") == "1";
         to.dynamic_block_base_ = std::stoi(session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigDynamicBlockBase, "0"));
 
         // Set custom threading functions
@@ -411,9 +433,61 @@ void InferenceSession::ConstructorCommon(const SessionOptions& session_options,
     ORT_ENFORCE(session_env.EnvCreatedWithGlobalThreadPools(),
                 "When the session is not configured to use per session"
                 " threadpools, the env must be created with the the CreateEnvWithGlobalThreadPools API.");
+
+    const std::string priority =
+        session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigSharedThreadPoolPriority, "normal");
+    if (priority == "interactive") {
+      shared_thread_pool_work_class_.priority = concurrency::ThreadPool::WorkPriority::kInteractive;
+    } else if (priority == "batch") {
+      shared_thread_pool_work_class_.priority = concurrency::ThreadPool::WorkPriority::kBatch;
+    } else {
+      ORT_ENFORCE(priority == "normal", "Invalid value for ", kOrtSessionOptionsConfigSharedThreadPoolPriority, ": ",
+                  priority, ". Valid values are 'interactive', 'normal' and 'batch'.");
+    }
+    shared_thread_pool_work_class_.max_degree_of_parallelism = ParseStringWithClassicLocale<int>(
+        session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigSharedThreadPoolMaxThreads, "0"));
+  }
+
+  const auto dynamic_batching_max_batch_size = ParseStringWithClassicLocale<size_t>(
+      session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigDynamicBatchingMaxBatchSize, "0"));
+  if (dynamic_batching_max_batch_size > 1) {
+    const auto max_delay_us = ParseStringWithClassicLocale<int64_t>(
+        session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigDynamicBatchingMaxDelayUs, "1000"));
+    ORT_ENFORCE(max_delay_us >= 0, "Dynamic batching max delay must not be negative");
+    dynamic_batcher_ = std::make_unique<DynamicBatcher>(
+        dynamic_batching_max_batch_size, std::chrono::microseconds(max_delay_us),
+        [this](const RunOptions& run_options, gsl::span<const std::string> feed_names, gsl::span<const OrtValue> feeds,
+               gsl::span<const std::string> output_names, std::vector<OrtValue>* p_fetches) {
+          return RunImpl(run_options, feed_names, feeds, output_names, p_fetches, nullptr);
+        });
+    LOGS(*session_logger_, INFO) << "Dynamic batching enabled with max batch size " << dynamic_batching_max_batch_size
+                                 << " and max delay " << max_delay_us << "us";
   }
 
   session_profiler_.Initialize(session_logger_);
+  session_profiler_.SetMemoryProfiling(
+      session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigProfileMemory, "0") == "1");
+  session_profiler_.SetThreadPoolTimelineProfiling(
+      session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigProfileThreadPoolTimeline, "0") ==
+      "1");
+  session_profiler_.SetHardwareCounterProfiling(
+      session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigProfileHardwareCounters, "0") ==
+      "1");
+  if (session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigProfileRoofline, "0") == "1") {
+    const std::string peak_gflops =
+        session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigProfilePeakGflops, "");
+    session_profiler_.SetRooflineProfiling(
+        true,
+        peak_gflops.empty()
+            ? profiling::EstimatePeakGflops(concurrency::ThreadPool::DegreeOfParallelism(GetIntraOpThreadPoolToUse()))
+            : ParseStringWithClassicLocale<double>(peak_gflops),
+        ParseStringWithClassicLocale<double>(session_options_.config_options.GetConfigOrDefault(
+            kOrtSessionOptionsConfigProfilePeakMemoryBandwidth, "0")));
+  }
+  if (session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigNvtxRanges, "0") == "1") {
+    profiling::NvtxRanges::Enable();
+    nvtx_ranges_enabled_ = true;
+  }
   if (session_options_.enable_profiling) {
     StartProfiling(session_options_.profile_file_prefix);
   }
@@ -498,6 +572,21 @@ InferenceSession::InferenceSession(const SessionOptions& session_options, const
 #endif  // !defined(ORT_MINIMAL_BUILD)
 
 InferenceSession::~InferenceSession() {
+  if (metrics_callback_id_ != 0) {
+    metrics::MetricsRegistry::Instance().RemoveSampleCallback(metrics_callback_id_);
+  }
+
+  if (nvtx_ranges_enabled_) {
+    profiling::NvtxRanges::Disable();
+  }
+
+  if (!memory_pattern_cache_file_.empty() && is_inited_) {
+    auto status = session_state_->SaveMemoryPatternGroupCache(memory_pattern_cache_file_);
+    if (!status.IsOK()) {
+      LOGS(*session_logger_, WARNING) << "Failed to save memory patterns: " << status.ErrorMessage();
+    }
+  }
+
   if (session_options_.enable_profiling) {
     ORT_TRY {
       EndProfiling();
@@ -671,10 +760,15 @@ common::Status InferenceSession::SaveToOrtFormat(const PathString& filepath) con
   fbs_buffer_size = ((fbs_buffer_size + m_bytes - 1) / m_bytes) * m_bytes;
   flatbuffers::FlatBufferBuilder builder(fbs_buffer_size);
 
+  OrtFormatSaveOptions save_options{};
+  save_options.compress_initializers =
+      session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigCompressOrtFormatInitializers,
+                                                         "0") == "1";
+
   auto ort_model_version = builder.CreateString(std::to_string(kOrtModelVersion));
   flatbuffers::Offset<fbs::Model> fbs_model;
   ORT_RETURN_IF_ERROR(
-      model_->SaveToOrtFormat(builder, fbs_model));
+      model_->SaveToOrtFormat(builder, save_options, fbs_model));
 
   flatbuffers::Offset<fbs::KernelTypeStrResolver> fbs_kernel_type_str_resolver;
   KernelTypeStrResolver kernel_type_str_resolver{};
@@ -713,6 +807,7 @@ common::Status InferenceSession::LoadWithLoader(std::function<common::Status(std
   if (session_profiler_.IsEnabled()) {
     tp = session_profiler_.Start();
   }
+  profiling::NvtxRange nvtx_range(event_name.c_str(), profiling::NvtxColor::kSession);
   ORT_TRY {
     std::lock_guard<onnxruntime::OrtMutex> l(session_mutex_);
     if (is_model_loaded_) {  // already loaded
@@ -964,6 +1059,7 @@ common::Status InferenceSession::TransformGraph(onnxruntime::Graph& graph, bool
   // 4. run level 2+ optimizations. level 2 and 3 optimizations use contrib ops.
   // 5. insert cast nodes (required transformer).
   // 6. insert copy nodes (required transformer).
+  profiling::NvtxRange nvtx_range("InferenceSession::TransformGraph", profiling::NvtxColor::kSession);
 
   auto apply_transformer_once = [](const GraphTransformer& transformer, const logging::Logger& logger,
                                    Graph& graph) {
@@ -1042,10 +1138,26 @@ common::Status InferenceSession::TransformGraph(onnxruntime::Graph& graph, bool
     }
   }
 
+  // Load the cost model for partitioning from the profiles of earlier runs if provided.
+  std::unique_ptr<PartitioningCostModel> partitioning_cost_model;
+  for (const char* profiles_config_key : {kOrtSessionOptionsPartitioningCostProfiles,
+                                          kOrtSessionOptionsProfileGuidedOptimizationProfiles}) {
+    const std::string cost_profiles = session_options_.config_options.GetConfigOrDefault(profiles_config_key, "");
+    for (const auto& cost_profile : utils::SplitString(cost_profiles, ";")) {
+      if (!partitioning_cost_model) {
+        partitioning_cost_model = std::make_unique<PartitioningCostModel>();
+      }
+      ORT_RETURN_IF_ERROR_SESSIONID_(partitioning_cost_model->LoadProfile(ToPathString(std::string(cost_profile))));
+    }
+  }
+
   // Do partitioning based on execution providers' capabilities.
-  GraphPartitioner partitioner(kernel_registry_manager_, execution_providers_);
-  ORT_RETURN_IF_ERROR_SESSIONID_(partitioner.Partition(graph, session_state_->GetMutableFuncMgr(), transform_layout_fn,
-                                                       mode, debug_graph_fn));
+  GraphPartitioner partitioner(kernel_registry_manager_, execution_providers_, partitioning_cost_model.get());
+  {
+    profiling::NvtxRange partition_nvtx_range("GraphPartitioner::Partition", profiling::NvtxColor::kSession);
+    ORT_RETURN_IF_ERROR_SESSIONID_(partitioner.Partition(graph, session_state_->GetMutableFuncMgr(),
+                                                         transform_layout_fn, mode, debug_graph_fn));
+  }
 
   // apply Level2 and higher transformers.
   // we do not run Level 1 again as those transformers assume partitioning will run later to do node assignment.
@@ -1221,6 +1333,7 @@ Status InferenceSession::LoadOrtModelWithLoader(std::function<Status()> load_ort
       load_options.can_use_flatbuffer_for_initializers =
           ort_format_model_bytes_data_holder_.empty() &&
           config_options.GetConfigOrDefault(kOrtSessionOptionsConfigUseORTModelBytesForInitializers, "0") == "1";
+  load_options.thread_pool = GetIntraOpThreadPoolToUse();
 
   // need to go from unique_ptr to shared_ptr when moving into model_
   std::unique_ptr<Model> tmp_model;
@@ -1374,15 +1487,6 @@ Status ApplyOrtFormatModelRuntimeOptimizations(
 #endif  // !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
 }  // namespace
 
-static void ResolveMemoryPatternFlags(SessionState& session_state) {
-  session_state.ResolveMemoryPatternFlag();
-
-  for (const auto& entry : session_state.GetSubgraphSessionStateMap()) {
-    for (const auto& name_to_subgraph_session_state : entry.second) {
-      ResolveMemoryPatternFlags(*name_to_subgraph_session_state.second);
-    }
-  }
-}
 #if defined(_MSC_VER) && !defined(__clang__)
 #pragma warning(push)
 // VC++ reports: "Releasing unheld lock 'l' in function 'onnxruntime::InferenceSession::Initialize'". But I don't see anything wrong.
@@ -1394,6 +1498,7 @@ common::Status InferenceSession::Initialize() {
   if (session_profiler_.IsEnabled()) {
     tp = session_profiler_.Start();
   }
+  profiling::NvtxRange nvtx_range("InferenceSession::Initialize", profiling::NvtxColor::kSession);
 
   ORT_TRY {
     LOGS(*session_logger_, INFO) << "Initializing session.";
@@ -1435,6 +1540,8 @@ common::Status InferenceSession::Initialize() {
     if (!have_cpu_ep) {
       LOGS(*session_logger_, INFO) << "Adding default CPU execution provider.";
       CPUExecutionProviderInfo epi{session_options_.enable_cpu_mem_arena};
+      epi.use_huge_pages = session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigUseHugePages,
+                                                                              "0") == "1";
       auto p_cpu_exec_provider = std::make_unique<CPUExecutionProvider>(epi, true /* delay allocator registration to allow sharing */);
       ORT_RETURN_IF_ERROR_SESSIONID_(RegisterExecutionProvider(std::move(p_cpu_exec_provider)));
       execution_providers_.SetCpuProviderWasImplicitlyAdded(true);
@@ -1455,6 +1562,26 @@ common::Status InferenceSession::Initialize() {
     session_activity_started_ = true;
 #endif
 
+    // The nodes the memory budget optimizer adds are placed by their priority.
+    const std::string memory_budget_bytes_str =
+        session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsMemoryBudgetBytes, "0");
+    size_t memory_budget_bytes = 0;
+    if (!TryParseStringWithClassicLocale(memory_budget_bytes_str, memory_budget_bytes)) {
+      ORT_RETURN_IF_ERROR_SESSIONID_(ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Invalid value '",
+                                                     memory_budget_bytes_str, "' for session option ",
+                                                     kOrtSessionOptionsMemoryBudgetBytes,
+                                                     ". Expected a number of bytes."));
+    }
+    if (memory_budget_bytes > 0 && session_options_.execution_order != ExecutionOrder::PRIORITY_BASED) {
+      LOGS(*session_logger_, INFO) << "Using the priority based execution order for this session "
+                                   << "since it has a memory budget.";
+      session_options_.execution_order = ExecutionOrder::PRIORITY_BASED;
+    }
+
+    const bool share_initializers_by_content =
+        session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigShareInitializersByContent,
+                                                           "0") == "1";
+
     // now that we have all the execution providers, create the session state
     session_state_ = std::make_unique<SessionState>(
         model_->MainGraph(),
@@ -1465,7 +1592,9 @@ common::Status InferenceSession::Initialize() {
         *session_logger_,
         session_profiler_,
         session_options_,
-        prepacked_weights_container_);
+        prepacked_weights_container_,
+        nullptr,
+        share_initializers_by_content ? &environment_.GetSharedInitializerStore() : nullptr);
 
     bool use_env_allocators =
         session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigUseEnvAllocators, "0") == "1";
@@ -1516,6 +1645,20 @@ common::Status InferenceSession::Initialize() {
         return Status::OK();
       };
 
+      // disable the optimizers that did not pay off in the profiles of earlier runs if provided
+      if (const std::string pgo_profiles = session_options_.config_options.GetConfigOrDefault(
+              kOrtSessionOptionsProfileGuidedOptimizationProfiles, "");
+          !pgo_profiles.empty()) {
+        ProfileGuidedOptimization pgo;
+        for (const auto& pgo_profile : utils::SplitString(pgo_profiles, ";")) {
+          ORT_RETURN_IF_ERROR_SESSIONID_(pgo.LoadProfile(ToPathString(std::string(pgo_profile))));
+        }
+        for (const auto& optimizer : pgo.GetOptimizersToDisable()) {
+          LOGS(*session_logger_, INFO) << "Disabling " << optimizer << " based on the profiles of earlier runs.";
+          optimizers_to_disable_.insert(optimizer);
+        }
+      }
+
       // add predefined transformers
       ORT_RETURN_IF_ERROR_SESSIONID_(AddPredefinedTransformers(graph_transformer_mgr_,
                                                                session_options_.graph_optimization_level,
@@ -1532,8 +1675,11 @@ common::Status InferenceSession::Initialize() {
                                         session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigDisableDmlGraphFusion, "0") == "0";
 
         if (dml_graph_fusion_enabled) {
+          const bool dml_graph_compilation_cache_enabled =
+              session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigEnableDmlGraphCompilationCache, "0") == "1";
           std::unique_ptr<onnxruntime::GraphTransformer> dmlGraphFusionTransformer = std::make_unique<Dml::DmlGraphFusionTransformer>("DmlGraphFusionTransformer",
-                                                                                                                                      execution_providers_.Get(kDmlExecutionProvider));
+                                                                                                                                      execution_providers_.Get(kDmlExecutionProvider),
+                                                                                                                                      dml_graph_compilation_cache_enabled);
           if (dmlGraphFusionTransformer == nullptr) {
             return Status(common::ONNXRUNTIME, common::FAIL, "DmlGraphFusionTransformer is nullptr");
           }
@@ -1558,9 +1704,9 @@ common::Status InferenceSession::Initialize() {
       // now that all the transforms are done, call Resolve on the main graph. this will recurse into the subgraphs.
       ORT_RETURN_IF_ERROR_SESSIONID_(graph.Resolve());
 
-      // Currently CUDA graph is only considered by CUDA EP and TRT EP.
+      // Currently CUDA graph is only considered by CUDA EP and TRT EP, and hipGraph by ROCM EP.
       //
-      // Check for CUDA EP:
+      // Check for CUDA EP (or ROCM EP):
       // If the CUDA EP is part of the providers list for this session AND
       // The CUDA EP is configured to do a graph capture AND
       // All the "compute" graph nodes have been assigned to the CUDA EP,
@@ -1571,7 +1717,8 @@ common::Status InferenceSession::Initialize() {
       // The TRT EP is configured to do a graph capture AND
       // All the graph nodes have been assigned to the TRT EP,
       // Then the TRT EP is cached for triggering a ReplayGraph() in Run().
-      std::vector<const char*> cuda_graph_support_ep_list = {onnxruntime::kTensorrtExecutionProvider, onnxruntime::kCudaExecutionProvider};
+      std::vector<const char*> cuda_graph_support_ep_list = {onnxruntime::kTensorrtExecutionProvider, onnxruntime::kCudaExecutionProvider,
+                                                             onnxruntime::kRocmExecutionProvider};
 
       for (auto& it : cuda_graph_support_ep_list) {
         auto* target_ep = execution_providers_.Get(it);
@@ -1588,19 +1735,22 @@ common::Status InferenceSession::Initialize() {
                                 "as the model has control flow nodes which can't be supported by CUDA Graphs."));
           }
 
-          if (strcmp(target_ep->Type().c_str(), onnxruntime::kCudaExecutionProvider) == 0) {
-            // Ensure that all nodes have been partitioned to CUDA or CPU EP && there are no memcpy nodes
+          if (strcmp(target_ep->Type().c_str(), onnxruntime::kCudaExecutionProvider) == 0 ||
+              strcmp(target_ep->Type().c_str(), onnxruntime::kRocmExecutionProvider) == 0) {
+            // Ensure that all nodes have been partitioned to CUDA (or ROCM) or CPU EP && there are no memcpy nodes
             // The reasoning behind this logic is that certain shape nodes will be forced onto CPU
             // and as long as there are no memcpy nodes this is confirmation that no compute nodes have been placed on the CPU EP
             // which is all we care about.
-            if (!AreAllComputeNodesAssignedToCudaEp(graph)) {
+            if (!AreAllComputeNodesAssignedToCudaOrRocmEp(graph, target_ep->Type())) {
               LOGS(*session_logger_, ERROR) << "This session cannot use the CUDA Graph feature as requested by the user "
-                                            << " as all compute graph nodes have not been partitioned to the CUDA EP.";
+                                            << " as all compute graph nodes have not been partitioned to the "
+                                            << target_ep->Type();
 
               ORT_RETURN_IF_ERROR_SESSIONID_(
                   ORT_MAKE_STATUS(ONNXRUNTIME, FAIL,
                                   "This session cannot use the CUDA Graph feature as requested by the user "
-                                  " as all compute graph nodes have not been partitioned to the CUDA EP."));
+                                  " as all compute graph nodes have not been partitioned to the ",
+                                  target_ep->Type()));
             }
 
             // Log a warning for the user to know that there are shape subgraphs that will execute on CPU
@@ -1690,11 +1840,20 @@ common::Status InferenceSession::Initialize() {
 #endif  // !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
     }
 
-    ORT_RETURN_IF_ERROR_SESSIONID_(
-        session_state_->FinalizeSessionState(model_location_, kernel_registry_manager_,
-                                             // need to keep the initializers if saving the optimized model
-                                             !saving_model,
-                                             saving_ort_format));
+    {
+      profiling::NvtxRange finalize_nvtx_range("SessionState::FinalizeSessionState", profiling::NvtxColor::kSession);
+      ORT_RETURN_IF_ERROR_SESSIONID_(
+          session_state_->FinalizeSessionState(model_location_, kernel_registry_manager_,
+                                               // need to keep the initializers if saving the optimized model
+                                               !saving_model,
+                                               saving_ort_format));
+    }
+
+    memory_pattern_cache_file_ = ToPathString(
+        session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigMemoryPatternCacheFile, ""));
+    if (!memory_pattern_cache_file_.empty()) {
+      session_state_->LoadMemoryPatternGroupCache(memory_pattern_cache_file_);
+    }
 
 #if !defined(ORT_MINIMAL_BUILD)
     if (saving_model) {
@@ -1743,11 +1902,24 @@ common::Status InferenceSession::Initialize() {
     }
 #endif  // !defined(ORT_MINIMAL_BUILD)
 
+    const size_t sampling_profiler_interval = ParseStringWithClassicLocale<size_t>(
+        session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigSamplingProfilerInterval, "0"));
+    if (sampling_profiler_interval > 0) {
+      const size_t sampling_profiler_max_runs = ParseStringWithClassicLocale<size_t>(
+          session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigSamplingProfilerMaxRuns, "16"));
+      sampling_profiler_ = std::make_unique<profiling::SamplingProfiler>(
+          sampling_profiler_interval, sampling_profiler_max_runs, session_state_->GetGraphViewer().NumberOfNodes());
+      session_state_->SetSamplingProfiler(sampling_profiler_.get());
+    }
+
     // Resolve memory pattern flags of the main graph and subgraph session states
-    ResolveMemoryPatternFlags(*session_state_);
+    session_state_->ResolveMemoryPatternFlag();
 
     is_inited_ = true;
 
+    metrics_callback_id_ = metrics::MetricsRegistry::Instance().AddSampleCallback(
+        [this](std::vector<metrics::Sample>& samples) { AddMetricsSamples(samples); });
+
     if (!using_ort_model_bytes_for_initializers_) {
       ort_format_model_bytes_ = gsl::span<const uint8_t>();
       std::vector<uint8_t>().swap(ort_format_model_bytes_data_holder_);
@@ -1801,6 +1973,26 @@ common::Status InferenceSession::Initialize() {
 #pragma warning(pop)
 #endif
 
+common::Status InferenceSession::UpdateInitializers(gsl::span<const std::string> names,
+                                                   gsl::span<const OrtValue> values) {
+  // wait for the runs in progress, and hold the runs that start meanwhile until the update completes
+  std::unique_lock<std::shared_mutex> update_lock(initializers_update_mutex_);
+  std::lock_guard<onnxruntime::OrtMutex> l(session_mutex_);
+  if (!is_inited_) {
+    LOGS(*session_logger_, ERROR) << "Session was not initialized";
+    return Status(common::ONNXRUNTIME, common::FAIL, "Session not initialized.");
+  }
+
+  // captured graphs replay the kernels and buffers they were captured with
+  if (cached_execution_provider_for_graph_replay_.IsGraphCaptureEnabled()) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Initializers can not be updated when graph capture is enabled.");
+  }
+
+  ORT_RETURN_IF_ERROR(session_state_->UpdateConstantInitializers(kernel_registry_manager_, names, values));
+  LOGS(*session_logger_, INFO) << "Updated " << names.size() << " initializers.";
+  return Status::OK();
+}
+
 int InferenceSession::GetCurrentNumRuns() const {
   return current_num_runs_.load();
 }
@@ -1873,100 +2065,120 @@ static common::Status CheckTypes(MLDataType actual, MLDataType expected, const s
   return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT, ostr.str());
 }
 
-common::Status InferenceSession::ValidateInputs(gsl::span<const std::string> feed_names,
-                                                gsl::span<const OrtValue> feeds) const {
-  if (feed_names.size() != feeds.size()) {
-    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Size mismatch: feed_names has ", feed_names.size(),
-                           "elements, but feeds has ", feeds.size(), " elements.");
-  }
-
-  for (size_t i = 0; i < feeds.size(); ++i) {
-    const auto& feed_name = feed_names[i];
-
-    auto iter = input_def_map_.find(feed_name);
-    if (input_def_map_.end() == iter) {
-      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Invalid Feed Input Name:", feed_name);
-    }
-
-    auto expected_type = iter->second.ml_data_type;
-    auto& input_ml_value = feeds[i];
-    if (input_ml_value.IsTensor()) {
-      if (!expected_type->IsTensorType()
+common::Status InferenceSession::ValidateInput(const std::string& feed_name, const InputDefMetaData& input_def,
+                                               const OrtValue& input_ml_value) const {
+  auto expected_type = input_def.ml_data_type;
+  if (input_ml_value.IsTensor()) {
+    if (!expected_type->IsTensorType()
 #if !defined(DISABLE_OPTIONAL_TYPE)
-          && !utils::IsOptionalTensor(expected_type)
+        && !utils::IsOptionalTensor(expected_type)
 #endif
-      ) {
-        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input with name: ", feed_name,
-                               " is not expected to be of type tensor.");
-      }
+    ) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input with name: ", feed_name,
+                             " is not expected to be of type tensor.");
+    }
 
-      // check for type
+    // check for type
 #if !defined(DISABLE_OPTIONAL_TYPE)
-      auto expected_element_type = expected_type->IsTensorType()
-                                       ? expected_type
-                                             ->AsTensorType()
-                                             ->GetElementType()
-                                       : utils::GetElementTypeFromOptionalTensor(expected_type);
+    auto expected_element_type = expected_type->IsTensorType()
+                                     ? expected_type
+                                           ->AsTensorType()
+                                           ->GetElementType()
+                                     : utils::GetElementTypeFromOptionalTensor(expected_type);
 #else
-      auto expected_element_type = expected_type->AsTensorType()->GetElementType();
+    auto expected_element_type = expected_type->AsTensorType()->GetElementType();
 #endif
 
-      auto input_element_type = input_ml_value.Get<Tensor>().DataType();
-      ORT_RETURN_IF_ERROR_SESSIONID_(CheckTypes(input_element_type, expected_element_type, "tensor"));
+    auto input_element_type = input_ml_value.Get<Tensor>().DataType();
+    ORT_RETURN_IF_ERROR_SESSIONID_(CheckTypes(input_element_type, expected_element_type, "tensor"));
 
-      // check for shape
-      const auto& expected_shape = iter->second.tensor_shape;
-      if (expected_shape.NumDimensions() > 0) {
-        const auto& input_shape = input_ml_value.Get<Tensor>().Shape();
-        ORT_RETURN_IF_ERROR_SESSIONID_(CheckShapes(feed_name, input_shape, expected_shape));
-      }
-    } else if (input_ml_value.IsSparseTensor()) {
+    // check for shape
+    const auto& expected_shape = input_def.tensor_shape;
+    if (expected_shape.NumDimensions() > 0) {
+      const auto& input_shape = input_ml_value.Get<Tensor>().Shape();
+      ORT_RETURN_IF_ERROR_SESSIONID_(CheckShapes(feed_name, input_shape, expected_shape));
+    }
+  } else if (input_ml_value.IsSparseTensor()) {
 #if !defined(DISABLE_SPARSE_TENSORS)
-      if (!expected_type->IsSparseTensorType()) {
-        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input with name: ", feed_name,
-                               " is not expected to be of type sparse tensor.");
-      }
-      auto expected_element_type = expected_type->AsSparseTensorType()->GetElementType();
-      const SparseTensor& sparse_tensor = input_ml_value.Get<SparseTensor>();
-      auto input_element_type = sparse_tensor.DataType();
-      ORT_RETURN_IF_ERROR_SESSIONID_(CheckTypes(input_element_type, expected_element_type, "sparse_tensor"));
-      // Check shape
-      const auto& expected_shape = iter->second.tensor_shape;
-      if (expected_shape.NumDimensions() > 0) {
-        const auto& input_shape = sparse_tensor.DenseShape();
-        ORT_RETURN_IF_ERROR_SESSIONID_(CheckShapes(feed_name, input_shape, expected_shape));
-      }
+    if (!expected_type->IsSparseTensorType()) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input with name: ", feed_name,
+                             " is not expected to be of type sparse tensor.");
+    }
+    auto expected_element_type = expected_type->AsSparseTensorType()->GetElementType();
+    const SparseTensor& sparse_tensor = input_ml_value.Get<SparseTensor>();
+    auto input_element_type = sparse_tensor.DataType();
+    ORT_RETURN_IF_ERROR_SESSIONID_(CheckTypes(input_element_type, expected_element_type, "sparse_tensor"));
+    // Check shape
+    const auto& expected_shape = input_def.tensor_shape;
+    if (expected_shape.NumDimensions() > 0) {
+      const auto& input_shape = sparse_tensor.DenseShape();
+      ORT_RETURN_IF_ERROR_SESSIONID_(CheckShapes(feed_name, input_shape, expected_shape));
+    }
 #else
-      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input with name ", feed_name,
-                             " is a sparse tensor, which is not supported in this build.");
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input with name ", feed_name,
+                           " is a sparse tensor, which is not supported in this build.");
 #endif
 
-    } else if (input_ml_value.IsTensorSequence()) {
-      if (!expected_type->IsTensorSequenceType()
+  } else if (input_ml_value.IsTensorSequence()) {
+    if (!expected_type->IsTensorSequenceType()
 #if !defined(DISABLE_OPTIONAL_TYPE)
-          && !utils::IsOptionalSeqTensor(expected_type)
+        && !utils::IsOptionalSeqTensor(expected_type)
 #endif
-      ) {
-        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input with name: ", feed_name,
-                               " is not expected to be of type tensor sequence.");
-      }
+    ) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input with name: ", feed_name,
+                             " is not expected to be of type tensor sequence.");
+    }
 
 #if !defined(DISABLE_OPTIONAL_TYPE)
-      auto expected_element_type = expected_type->IsTensorSequenceType()
-                                       ? expected_type
-                                             ->AsSequenceTensorType()
-                                             ->GetElementType()
-                                       : utils::GetElementTypeFromOptionalSeqTensor(expected_type);
+    auto expected_element_type = expected_type->IsTensorSequenceType()
+                                     ? expected_type
+                                           ->AsSequenceTensorType()
+                                           ->GetElementType()
+                                     : utils::GetElementTypeFromOptionalSeqTensor(expected_type);
 #else
-      auto expected_element_type = expected_type->AsSequenceTensorType()->GetElementType();
+    auto expected_element_type = expected_type->AsSequenceTensorType()->GetElementType();
 #endif
 
-      auto input_element_type = input_ml_value.Get<TensorSeq>().DataType();
-      ORT_RETURN_IF_ERROR_SESSIONID_(CheckTypes(input_element_type, expected_element_type, "seq"));
-    } else {
-      auto input_type = input_ml_value.Type();
-      ORT_RETURN_IF_ERROR_SESSIONID_(CheckTypes(input_type, expected_type, ""));
+    auto input_element_type = input_ml_value.Get<TensorSeq>().DataType();
+    ORT_RETURN_IF_ERROR_SESSIONID_(CheckTypes(input_element_type, expected_element_type, "seq"));
+  } else {
+    auto input_type = input_ml_value.Type();
+    ORT_RETURN_IF_ERROR_SESSIONID_(CheckTypes(input_type, expected_type, ""));
+  }
+
+  return Status::OK();
+}
+
+common::Status InferenceSession::ValidateInputs(gsl::span<const std::string> feed_names,
+                                                gsl::span<const OrtValue> feeds) const {
+  if (feed_names.size() != feeds.size()) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Size mismatch: feed_names has ", feed_names.size(),
+                           "elements, but feeds has ", feeds.size(), " elements.");
+  }
+
+  for (size_t i = 0; i < feeds.size(); ++i) {
+    const auto& feed_name = feed_names[i];
+
+    auto iter = input_def_map_.find(feed_name);
+    if (input_def_map_.end() == iter) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Invalid Feed Input Name:", feed_name);
     }
+
+    ORT_RETURN_IF_ERROR_SESSIONID_(ValidateInput(feed_name, iter->second, feeds[i]));
+  }
+
+  return Status::OK();
+}
+
+common::Status InferenceSession::ValidateInputs(const PreparedRun& prepared_run,
+                                                gsl::span<const OrtValue> feeds) const {
+  if (prepared_run.feed_names_.size() != feeds.size()) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Size mismatch: the prepared run has ",
+                           prepared_run.feed_names_.size(), " inputs, but feeds has ", feeds.size(), " elements.");
+  }
+
+  for (size_t i = 0; i < feeds.size(); ++i) {
+    ORT_RETURN_IF_ERROR_SESSIONID_(ValidateInput(prepared_run.feed_names_[i], *prepared_run.input_defs_[i], feeds[i]));
   }
 
   return Status::OK();
@@ -2105,10 +2317,73 @@ Status InferenceSession::Run(const RunOptions& run_options,
                              gsl::span<const std::string> feed_names, gsl::span<const OrtValue> feeds,
                              gsl::span<const std::string> output_names, std::vector<OrtValue>* p_fetches,
                              const std::vector<OrtDevice>* p_fetches_device_info) {
+  if (dynamic_batcher_ != nullptr && p_fetches_device_info == nullptr) {
+    return dynamic_batcher_->Run(run_options, feed_names, feeds, output_names, p_fetches);
+  }
+
+  return RunImpl(run_options, feed_names, feeds, output_names, p_fetches, p_fetches_device_info);
+}
+
+InferenceSession::PreparedRun::~PreparedRun() = default;
+
+Status InferenceSession::PrepareRun(gsl::span<const std::string> feed_names,
+                                    gsl::span<const std::string> output_names,
+                                    std::unique_ptr<PreparedRun>& prepared_run) const {
+  if (!is_inited_) {
+    LOGS(*session_logger_, ERROR) << "Session was not initialized";
+    return Status(common::ONNXRUNTIME, common::FAIL, "Session not initialized.");
+  }
+
+  if (output_names.empty()) {
+    return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT, "At least one output should be requested.");
+  }
+
+  std::unique_ptr<PreparedRun> prepared{new PreparedRun()};
+  prepared->input_defs_.reserve(feed_names.size());
+  for (const auto& feed_name : feed_names) {
+    auto iter = input_def_map_.find(feed_name);
+    if (input_def_map_.end() == iter) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Invalid Feed Input Name:", feed_name);
+    }
+    prepared->input_defs_.push_back(&iter->second);
+  }
+
+  for (const auto& name : output_names) {
+    if (model_output_names_.find(name) == model_output_names_.end()) {
+      return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT, "Invalid Output Name:" + name);
+    }
+  }
+
+  prepared->feed_names_.assign(feed_names.begin(), feed_names.end());
+  prepared->output_names_.assign(output_names.begin(), output_names.end());
+  ORT_RETURN_IF_ERROR(FeedsFetchesManager::Create(prepared->feed_names_, prepared->output_names_,
+                                                  session_state_->GetOrtValueNameIdxMap(),
+                                                  prepared->feeds_fetches_manager_));
+  prepared_run = std::move(prepared);
+  return Status::OK();
+}
+
+Status InferenceSession::Run(const RunOptions& run_options, PreparedRun& prepared_run,
+                             gsl::span<const OrtValue> feeds, std::vector<OrtValue>* p_fetches) {
+  if (dynamic_batcher_ != nullptr) {
+    return dynamic_batcher_->Run(run_options, prepared_run.feed_names_, feeds, prepared_run.output_names_, p_fetches);
+  }
+
+  return RunImpl(run_options, prepared_run.feed_names_, feeds, prepared_run.output_names_, p_fetches, nullptr,
+                 &prepared_run);
+}
+
+Status InferenceSession::RunImpl(const RunOptions& run_options,
+                                 gsl::span<const std::string> feed_names, gsl::span<const OrtValue> feeds,
+                                 gsl::span<const std::string> output_names, std::vector<OrtValue>* p_fetches,
+                                 const std::vector<OrtDevice>* p_fetches_device_info,
+                                 PreparedRun* prepared_run) {
+  const TimePoint run_start = std::chrono::high_resolution_clock::now();
   TimePoint tp;
   if (session_profiler_.IsEnabled()) {
     tp = session_profiler_.Start();
   }
+  profiling::NvtxRange nvtx_range("InferenceSession::Run", profiling::NvtxColor::kSession);
 
 #ifdef ONNXRUNTIME_ENABLE_INSTRUMENT
   TraceLoggingActivity<telemetry_provider_handle> ortrun_activity;
@@ -2118,6 +2393,24 @@ Status InferenceSession::Run(const RunOptions& run_options,
   Status retval = Status::OK();
   const Env& env = Env::Default();
 
+  // the initializers are not updated while the run uses them
+  std::shared_lock<std::shared_mutex> initializers_update_lock(initializers_update_mutex_);
+
+  // Select the captured graph for the shapes of the inputs of this run.
+  if (cached_execution_provider_for_graph_replay_.IsGraphCaptureEnabled()) {
+    InlinedVector<int64_t> graph_capture_key;
+    for (const auto& feed : feeds) {
+      if (feed.IsTensor()) {
+        const auto dims = feed.Get<Tensor>().Shape().GetDims();
+        graph_capture_key.push_back(static_cast<int64_t>(dims.size()));
+        graph_capture_key.insert(graph_capture_key.end(), dims.begin(), dims.end());
+      } else {
+        graph_capture_key.push_back(-1);
+      }
+    }
+    cached_execution_provider_for_graph_replay_.SetGraphCaptureKey(graph_capture_key);
+  }
+
   // Increment/decrement concurrent_num_runs_ and control
   // session threads spinning as configured. Do nothing for graph replay except the counter.
   const bool control_spinning = use_per_session_threads_ &&
@@ -2127,6 +2420,12 @@ Status InferenceSession::Run(const RunOptions& run_options,
   auto* inter_tp = (control_spinning) ? inter_op_thread_pool_.get() : nullptr;
   ThreadPoolSpinningSwitch runs_refcounter_and_tp_spin_control(intra_tp, inter_tp, current_num_runs_);
 
+  // Apply the priority and thread limit of the session to the work it submits to the global thread pools.
+  std::optional<concurrency::ThreadPool::WorkClassScope> work_class_scope;
+  if (!use_per_session_threads_) {
+    work_class_scope.emplace(shared_thread_pool_work_class_);
+  }
+
   // Check if this Run() is simply going to be a CUDA Graph replay.
   if (cached_execution_provider_for_graph_replay_.IsGraphCaptured()) {
     LOGS(*session_logger_, INFO) << "Replaying the captured "
@@ -2148,8 +2447,17 @@ Status InferenceSession::Run(const RunOptions& run_options,
       // log evaluation start to trace logging provider
       env.GetTelemetryProvider().LogEvaluationStart();
 
-      ORT_RETURN_IF_ERROR_SESSIONID_(ValidateInputs(feed_names, feeds));
-      ORT_RETURN_IF_ERROR_SESSIONID_(ValidateOutputs(output_names, p_fetches));
+      if (prepared_run != nullptr) {
+        // the names were validated when the run was prepared
+        ORT_RETURN_IF_ERROR_SESSIONID_(ValidateInputs(*prepared_run, feeds));
+        if (p_fetches == nullptr || (!p_fetches->empty() && p_fetches->size() != output_names.size())) {
+          return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Output vector incorrectly sized for the ",
+                                 output_names.size(), " outputs of the prepared run.");
+        }
+      } else {
+        ORT_RETURN_IF_ERROR_SESSIONID_(ValidateInputs(feed_names, feeds));
+        ORT_RETURN_IF_ERROR_SESSIONID_(ValidateOutputs(output_names, p_fetches));
+      }
 
       // shrink certain default memory arenas if the user has requested for it
       const std::string& shrink_memory_arenas =
@@ -2159,8 +2467,14 @@ Status InferenceSession::Run(const RunOptions& run_options,
         ORT_RETURN_IF_ERROR_SESSIONID_(ValidateAndParseShrinkArenaString(shrink_memory_arenas, arenas_to_shrink));
       }
 
-      FeedsFetchesInfo info(feed_names, output_names, session_state_->GetOrtValueNameIdxMap());
-      FeedsFetchesManager feeds_fetches_manager{std::move(info)};
+      // a prepared run resolved the names to indices once for all of its runs
+      std::optional<FeedsFetchesManager> run_feeds_fetches_manager;
+      if (prepared_run == nullptr) {
+        run_feeds_fetches_manager.emplace(
+            FeedsFetchesInfo(feed_names, output_names, session_state_->GetOrtValueNameIdxMap()));
+      }
+      FeedsFetchesManager& feeds_fetches_manager = prepared_run != nullptr ? *prepared_run->feeds_fetches_manager_
+                                                                           : *run_feeds_fetches_manager;
 
       if (p_fetches_device_info) {
         // populate the target device info. ignored if pre-allocated fetches are provided
@@ -2276,6 +2590,16 @@ Status InferenceSession::Run(const RunOptions& run_options,
     telemetry_.total_run_duration_since_last_ = 0;
   }
 
+  static metrics::Histogram& run_duration_histogram = metrics::MetricsRegistry::Instance().GetHistogram(
+      "onnxruntime_run_duration_seconds", "Duration of the runs of the sessions.", metrics::DurationBucketBounds());
+  static metrics::Counter& run_failures_counter = metrics::MetricsRegistry::Instance().GetCounter(
+      "onnxruntime_run_failures_total", "Runs of the sessions that failed.");
+  run_duration_histogram.Observe(
+      std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - run_start).count());
+  if (!retval.IsOK()) {
+    run_failures_counter.Add();
+  }
+
   // log evaluation stop to trace logging provider
   env.GetTelemetryProvider().LogEvaluationStop();
 
@@ -2321,6 +2645,88 @@ common::Status InferenceSession::Run(const RunOptions& run_options, const NameML
   return Run(run_options, feed_names, feeds, output_names, p_fetches, nullptr);
 }
 
+common::Status InferenceSession::RunAsync(const RunOptions* run_options,
+                                          gsl::span<const std::string> feed_names,
+                                          gsl::span<const OrtValue> feeds,
+                                          gsl::span<const std::string> output_names,
+                                          gsl::span<OrtValue*> fetches,
+                                          RunAsyncCallbackFn callback,
+                                          void* user_data) {
+  ORT_RETURN_IF(callback == nullptr, "RunAsync requires a callback");
+  ORT_RETURN_IF_NOT(output_names.size() == fetches.size(),
+                    "RunAsync: number of output names (", output_names.size(),
+                    ") does not match number of outputs (", fetches.size(), ")");
+
+  // Prefer the inter-op pool so the run does not occupy a worker the run itself would use for intra-op work.
+  auto* tp = GetInterOpThreadPoolToUse();
+  if (tp == nullptr) {
+    tp = GetIntraOpThreadPoolToUse();
+  }
+  ORT_RETURN_IF(concurrency::ThreadPool::DegreeOfParallelism(tp) < 2,
+                "RunAsync requires a session thread pool with at least one worker thread");
+
+  // The caller's buffers only need to outlive this call, except for the output array which is handed back
+  // through the callback.
+  std::vector<std::string> feed_names_copy(feed_names.begin(), feed_names.end());
+  std::vector<OrtValue> feeds_copy(feeds.begin(), feeds.end());
+  std::vector<std::string> output_names_copy(output_names.begin(), output_names.end());
+
+  const auto scheduled_time = std::chrono::steady_clock::now();
+  concurrency::ThreadPool::Schedule(tp, [this, run_options, feed_names_copy = std::move(feed_names_copy),
+                                         feeds_copy = std::move(feeds_copy),
+                                         output_names_copy = std::move(output_names_copy),
+                                         fetches, callback, user_data, scheduled_time]() {
+    static metrics::Histogram& queue_wait_histogram = metrics::MetricsRegistry::Instance().GetHistogram(
+        "onnxruntime_run_queue_wait_seconds", "Time the asynchronous runs waited for a worker thread.",
+        metrics::DurationBucketBounds());
+    queue_wait_histogram.Observe(
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - scheduled_time).count());
+
+    Status status;
+    ORT_TRY {
+      std::vector<OrtValue> fetch_values;
+      fetch_values.reserve(fetches.size());
+      for (OrtValue* fetch : fetches) {
+        if (fetch != nullptr) {
+          fetch_values.push_back(*fetch);
+        } else {
+          fetch_values.emplace_back();
+        }
+      }
+
+      if (run_options != nullptr) {
+        status = Run(*run_options, feed_names_copy, feeds_copy, output_names_copy, &fetch_values, nullptr);
+      } else {
+        status = Run(RunOptions(), feed_names_copy, feeds_copy, output_names_copy, &fetch_values, nullptr);
+      }
+
+      if (status.IsOK()) {
+        for (size_t i = 0; i < fetches.size(); ++i) {
+          if (fetches[i] == nullptr) {
+            fetches[i] = new OrtValue(std::move(fetch_values[i]));
+          }
+        }
+      }
+    }
+    ORT_CATCH(const std::exception& ex) {
+      ORT_HANDLE_EXCEPTION([&]() {
+        status = ORT_MAKE_STATUS(ONNXRUNTIME, RUNTIME_EXCEPTION, ex.what());
+      });
+    }
+    ORT_CATCH(...) {
+      status = ORT_MAKE_STATUS(ONNXRUNTIME, RUNTIME_EXCEPTION, "Unknown exception in RunAsync");
+    }
+
+    if (status.IsOK()) {
+      callback(user_data, fetches.data(), fetches.size(), nullptr);
+    } else {
+      callback(user_data, nullptr, 0, ToOrtStatus(status));
+    }
+  });
+
+  return Status::OK();
+}
+
 std::pair<common::Status, const ModelMetadata*> InferenceSession::GetModelMetadata() const {
   {
     std::lock_guard<onnxruntime::OrtMutex> l(session_mutex_);
@@ -2387,8 +2793,12 @@ common::Status InferenceSession::NewIOBinding(std::unique_ptr<IOBinding>* io_bin
 common::Status InferenceSession::Run(const RunOptions& run_options, IOBinding& io_binding) {
   // TODO should Run() call io_binding.SynchronizeInputs() or should it let the callers do it?
   // io_binding.SynchronizeInputs();
-  return Run(run_options, io_binding.GetInputNames(), io_binding.GetInputs(), io_binding.GetOutputNames(),
-             &io_binding.GetOutputs(), &io_binding.GetOutputsDeviceInfo());
+  io_binding.AdvanceStates();
+  ORT_RETURN_IF_ERROR(Run(run_options, io_binding.GetInputNames(), io_binding.GetInputs(),
+                          io_binding.GetOutputNames(), &io_binding.GetOutputs(),
+                          &io_binding.GetOutputsDeviceInfo()));
+  io_binding.OnRunCompleted();
+  return Status::OK();
 }
 
 common::Status InferenceSession::Run(IOBinding& io_binding) {
@@ -2434,6 +2844,50 @@ const profiling::Profiler& InferenceSession::GetProfiling() const {
   return session_profiler_;
 }
 
+common::Status InferenceSession::GetSampledRuns(std::vector<profiling::SampledRun>& runs) const {
+  if (sampling_profiler_ == nullptr) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "The sampling profiler is not enabled. Set ",
+                           kOrtSessionOptionsConfigSamplingProfilerInterval, " to enable it.");
+  }
+  runs = sampling_profiler_->GetLatestRuns();
+  return Status::OK();
+}
+
+common::Status InferenceSession::GetSampledRuns(std::string& json) const {
+  std::vector<profiling::SampledRun> runs;
+  ORT_RETURN_IF_ERROR(GetSampledRuns(runs));
+
+  const GraphViewer& graph_viewer = session_state_->GetGraphViewer();
+  std::ostringstream ss;
+  ss << "[";
+  bool first = true;
+  for (const auto& run : runs) {
+    const auto run_start_us = run.start_ns / 1000;
+    ss << (first ? "" : ",\n") << "{\"cat\" : \"Session\",\"pid\" :" << run.sample_id
+       << ",\"tid\" :0,\"dur\" :" << run.duration_ns / 1000 << ",\"ts\" :" << run_start_us
+       << ",\"ph\" : \"X\",\"name\" :\"model_run\",\"args\" : {}}";
+    first = false;
+    for (const auto& node_timing : run.nodes) {
+      const Node* node = graph_viewer.GetNode(node_timing.node_index);
+      const std::string node_name = node == nullptr ? std::to_string(node_timing.node_index)
+                                    : node->Name().empty() ? MakeString(node->OpType(), "_", node->Index())
+                                                           : node->Name();
+      ss << ",\n{\"cat\" : \"Node\",\"pid\" :" << run.sample_id << ",\"tid\" :0,\"dur\" :"
+         << node_timing.duration_ns / 1000 << ",\"ts\" :" << run_start_us + node_timing.start_ns / 1000
+         << ",\"ph\" : \"X\",\"name\" :\"" << node_name << "_kernel_time\",\"args\" : {\"op_name\" : \""
+         << (node == nullptr ? "" : node->OpType()) << "\"}}";
+    }
+  }
+  ss << "]\n";
+  json = ss.str();
+  return Status::OK();
+}
+
+concurrency::ThreadPoolSpinStatistics InferenceSession::GetIntraOpThreadPoolSpinStatistics() const {
+  const auto* tp = GetIntraOpThreadPoolToUse();
+  return tp ? tp->GetSpinStatistics() : concurrency::ThreadPoolSpinStatistics{};
+}
+
 #if !defined(ORT_MINIMAL_BUILD)
 std::vector<TuningResults> InferenceSession::GetTuningResults() const {
   std::vector<TuningResults> ret;
@@ -2560,6 +3014,35 @@ void InferenceSession::ShrinkMemoryArenas(gsl::span<const AllocatorPtr> arenas_t
   }
 }
 
+void InferenceSession::AddMetricsSamples(std::vector<metrics::Sample>& samples) const {
+  const std::string session_label = "session_id=\"" + std::to_string(session_id_) + "\"";
+  for (const auto& entry : session_state_->GetAllocators()) {
+    AllocatorStats stats;
+    entry.second->GetStats(&stats);
+    const auto& info = entry.second->Info();
+    const std::string labels = session_label + ",allocator=\"" + info.name + "\",device_id=\"" +
+                               std::to_string(info.id) + "\"";
+    samples.push_back({"onnxruntime_allocator_bytes_in_use", "Bytes in use in the allocator.",
+                       metrics::SampleType::kGauge, labels, static_cast<double>(stats.bytes_in_use)});
+    samples.push_back({"onnxruntime_allocator_bytes_reserved", "Bytes the allocator obtained from the device.",
+                       metrics::SampleType::kGauge, labels, static_cast<double>(stats.total_allocated_bytes)});
+  }
+
+  const auto* tp = GetIntraOpThreadPoolToUse();
+  if (tp != nullptr) {
+    const auto stats = tp->GetSpinStatistics();
+    const std::string labels = session_label + ",pool=\"intra_op\"";
+    samples.push_back({"onnxruntime_threadpool_steals_total", "Tasks taken from the queue of another worker.",
+                       metrics::SampleType::kCounter, labels, static_cast<double>(stats.steals)});
+    samples.push_back({"onnxruntime_threadpool_spin_hits_total", "Idle periods that found work while spinning.",
+                       metrics::SampleType::kCounter, labels, static_cast<double>(stats.spin_hits)});
+    samples.push_back({"onnxruntime_threadpool_spin_misses_total", "Idle periods that spun without finding work.",
+                       metrics::SampleType::kCounter, labels, static_cast<double>(stats.spin_misses)});
+    samples.push_back({"onnxruntime_threadpool_spin_seconds_total", "Time spent spinning by the workers.",
+                       metrics::SampleType::kCounter, labels, static_cast<double>(stats.spin_time_ns) / 1e9});
+  }
+}
+
 #if !defined(ORT_MINIMAL_BUILD)
 // assumes model has already been loaded before
 common::Status InferenceSession::DoPostLoadProcessing(onnxruntime::Model& model) {
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <shared_mutex>
 #include <string>
 #include <unordered_map>
 
@@ -11,6 +12,7 @@
 #include "core/common/logging/logging.h"
 #include "core/common/path_string.h"
 #include "core/common/profiler.h"
+#include "core/common/sampling_profiler.h"
 #include "core/common/status.h"
 #include "core/framework/execution_providers.h"
 #include "core/framework/framework_common.h"
@@ -39,7 +41,9 @@ class ModelProto;
 
 namespace onnxruntime {  // forward declarations
 class CustomRegistry;
+class DynamicBatcher;
 class Environment;
+class FeedsFetchesManager;
 class GraphTransformer;
 class IExecutionProvider;
 class IOBinding;
@@ -55,6 +59,10 @@ namespace logging {
 class LoggingManager;
 }
 
+namespace metrics {
+struct Sample;
+}
+
 /**
  * Pre-defined and custom metadata about the model.
  */
@@ -327,6 +335,48 @@ class InferenceSession {
                                    gsl::span<const std::string> output_names,
                                    std::vector<OrtValue>* p_fetches);
 
+  /**
+   * Queue a Run on a session owned thread pool and return immediately.
+   * The inter-op thread pool is used when the session has one, otherwise the intra-op thread pool.
+   * The names and feeds are copied. The session, run_options (if not null) and the fetches array must stay
+   * valid until the callback is invoked. Null entries in fetches are filled with newly allocated OrtValues
+   * that are owned by the caller.
+   * @param callback invoked on the worker thread with the fetches on success, or with an error status.
+   * @return OK if the run was queued.
+   */
+  [[nodiscard]] common::Status RunAsync(const RunOptions* run_options,
+                                        gsl::span<const std::string> feed_names,
+                                        gsl::span<const OrtValue> feeds,
+                                        gsl::span<const std::string> output_names,
+                                        gsl::span<OrtValue*> fetches,
+                                        RunAsyncCallbackFn callback,
+                                        void* user_data = nullptr);
+
+  /**
+   * Inputs and outputs of runs resolved once, so that a run repeated with the same names takes its feeds
+   * by position and does not look up or validate names. See PrepareRun.
+   */
+  class PreparedRun;
+
+  /**
+   * Resolves the names of the inputs and outputs of runs made with Run(const RunOptions&, PreparedRun&, ...).
+   * A prepared run keeps state updated by every run made with it, so it must not be used by concurrent runs;
+   * prepare one per thread instead. It must not outlive the session.
+   * @return OK if all the names are inputs and outputs of the model.
+   */
+  [[nodiscard]] common::Status PrepareRun(gsl::span<const std::string> feed_names,
+                                          gsl::span<const std::string> output_names,
+                                          std::unique_ptr<PreparedRun>& prepared_run) const;
+
+  /**
+   * Runs with the names resolved by PrepareRun.
+   * @param feeds input values in the order of the feed names of the prepared run.
+   * @param p_fetches output values in the order of the output names of the prepared run. Either empty or
+   *        with one (possibly preallocated) value per output.
+   */
+  [[nodiscard]] common::Status Run(const RunOptions& run_options, PreparedRun& prepared_run,
+                                   gsl::span<const OrtValue> feeds, std::vector<OrtValue>* p_fetches);
+
   /**
    * Creates a new binding object for binding inputs and outputs.
    * @param provider_type specifies the location where the inputs need to be potentially copied.
@@ -390,6 +440,18 @@ class InferenceSession {
    */
   std::pair<common::Status, const OutputDefList*> GetModelOutputs() const;
 
+  /**
+   * Updates the values of constant initializers of an initialized session in place, e.g. to apply new weights of a
+   * fine-tuned model without creating a new session. The values must have the type and shape of the initializers.
+   * Only the kernels of the nodes consuming the initializers are created again and pre-pack the new values, the other
+   * kernels and their pre-packed weights are kept.
+   * The update waits for the Run calls in progress to complete, and the Run calls made meanwhile wait for the
+   * update, so each Run uses either the previous or the new values of all the initializers.
+   * @return OK if the update succeeded. Nothing is changed otherwise.
+   */
+  [[nodiscard]] common::Status UpdateInitializers(gsl::span<const std::string> names,
+                                                  gsl::span<const OrtValue> values);
+
   /**
    * Get the current number of in-progress concurrent Run calls.
    */
@@ -443,6 +505,26 @@ class InferenceSession {
     */
   const profiling::Profiler& GetProfiling() const;
 
+  /**
+    * Get the node timings of the latest runs sampled by the sampling profiler, which is enabled with the
+    * session.sampling_profiler_interval config entry. Can be called while runs are in progress.
+    @param runs the sampled runs, the oldest first
+    @return an error if the sampling profiler is not enabled
+    */
+  common::Status GetSampledRuns(std::vector<profiling::SampledRun>& runs) const;
+
+  /**
+    * Same as GetSampledRuns with the runs written in chrome tracing format, one process per run.
+    */
+  common::Status GetSampledRuns(std::string& json) const;
+
+  /**
+    * Return the spin statistics of the intra-op threadpool used by the session. Shared by all
+    * sessions that use the global threadpools.
+    @return the statistics, all zero if the session runs without an intra-op threadpool
+    */
+  concurrency::ThreadPoolSpinStatistics GetIntraOpThreadPoolSpinStatistics() const;
+
 #if !defined(ORT_MINIMAL_BUILD)
   /**
    * Get the TuningResults of TunableOp for every execution providers.
@@ -611,6 +693,13 @@ class InferenceSession {
   const logging::Logger& CreateLoggerForRun(const RunOptions& run_options,
                                             std::unique_ptr<logging::Logger>& new_run_logger);
 
+  // Executes a single Run. Run() forwards to this directly or through the dynamic batcher.
+  [[nodiscard]] common::Status RunImpl(const RunOptions& run_options, gsl::span<const std::string> feed_names,
+                                       gsl::span<const OrtValue> feeds, gsl::span<const std::string> output_names,
+                                       std::vector<OrtValue>* p_fetches,
+                                       const std::vector<OrtDevice>* p_fetches_device_info,
+                                       PreparedRun* prepared_run = nullptr);
+
   void InitLogger(logging::LoggingManager* logging_manager);
 
   [[nodiscard]] common::Status CheckShapes(const std::string& input_name, const TensorShape& input_shape,
@@ -619,6 +708,8 @@ class InferenceSession {
   [[nodiscard]] common::Status ValidateInputs(gsl::span<const std::string> feed_names,
                                               gsl::span<const OrtValue> feeds) const;
 
+  [[nodiscard]] common::Status ValidateInputs(const PreparedRun& prepared_run, gsl::span<const OrtValue> feeds) const;
+
   [[nodiscard]] common::Status ValidateOutputs(gsl::span<const std::string> output_names,
                                                const std::vector<OrtValue>* p_fetches) const;
 
@@ -643,6 +734,9 @@ class InferenceSession {
    */
   void ShrinkMemoryArenas(gsl::span<const AllocatorPtr> arenas_to_shrink);
 
+  // Adds the statistics of the allocators and of the intra-op thread pool of the session to the exported metrics
+  void AddMetricsSamples(std::vector<metrics::Sample>& samples) const;
+
 #if !defined(ORT_MINIMAL_BUILD)
   virtual common::Status AddPredefinedTransformers(
       GraphTransformerManager& transformer_manager,
@@ -673,6 +767,15 @@ class InferenceSession {
   // Profiler for this session.
   profiling::Profiler session_profiler_;
 
+  // Sampling profiler for this session, if enabled. Used by session_state_.
+  std::unique_ptr<profiling::SamplingProfiler> sampling_profiler_;
+
+  // Id of the callback exporting the allocator and thread pool statistics of this session to the metrics registry
+  uint64_t metrics_callback_id_ = 0;
+
+  // Whether this session enabled the NVTX ranges, see kOrtSessionOptionsConfigNvtxRanges
+  bool nvtx_ranges_enabled_ = false;
+
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
   MemoryProfiler memory_profiler_;
 #endif
@@ -695,6 +798,9 @@ class InferenceSession {
   std::unique_ptr<onnxruntime::concurrency::ThreadPool> thread_pool_;
   std::unique_ptr<onnxruntime::concurrency::ThreadPool> inter_op_thread_pool_;
 
+  // Merges concurrent Run() calls when dynamic batching is enabled in the session options.
+  std::unique_ptr<DynamicBatcher> dynamic_batcher_;
+
   // Global threadpools. These are intialized and used when use_per_session_threads is false *and*
   // the environment is created with create_global_thread_pools = true.
   onnxruntime::concurrency::ThreadPool* intra_op_thread_pool_from_env_{};
@@ -709,6 +815,9 @@ class InferenceSession {
   // If true, use the per session ones, or else the global threadpools.
   bool use_per_session_threads_;
 
+  // Work class of the session in the global threadpools, see kOrtSessionOptionsConfigSharedThreadPoolPriority.
+  concurrency::ThreadPool::WorkClass shared_thread_pool_work_class_;
+
   KernelRegistryManager kernel_registry_manager_;
 
 #if !defined(ORT_MINIMAL_BUILD)
@@ -735,6 +844,9 @@ class InferenceSession {
   };
 
   std::unordered_map<std::string, InputDefMetaData> input_def_map_;
+
+  [[nodiscard]] common::Status ValidateInput(const std::string& feed_name, const InputDefMetaData& input_def,
+                                             const OrtValue& input_ml_value) const;
   OutputDefList output_def_list_;
 
   // Data transfer manager.
@@ -743,6 +855,9 @@ class InferenceSession {
   // Number of concurrently running executors
   std::atomic<int> current_num_runs_ = 0;
 
+  // held shared by Run calls and exclusively by UpdateInitializers, which acquires it before session_mutex_
+  std::shared_mutex initializers_update_mutex_;
+
   mutable onnxruntime::OrtMutex session_mutex_;  // to ensure only one thread can invoke Load/Initialize
   bool is_model_loaded_ = false;                 // GUARDED_BY(session_mutex_)
   bool is_inited_ = false;                       // GUARDED_BY(session_mutex_)
@@ -811,6 +926,10 @@ class InferenceSession {
   // the cache is valid until any session reliant on it is still in scope.
   PrepackedWeightsContainer* prepacked_weights_container_ = nullptr;
 
+  // File the memory patterns of the main graph are loaded from on initialization and saved to on destruction.
+  // Empty unless kOrtSessionOptionsConfigMemoryPatternCacheFile is set.
+  PathString memory_pattern_cache_file_;
+
   // Cache the EP instance if the user has configured the EP to capture a graph
   // for the model and all the necessary criteria for graph capture has been met.
   // At Run() time, if this member is not nullptr and the captured graph is ready
@@ -832,6 +951,12 @@ class InferenceSession {
       return cached_execution_provider_for_graph_replay_ != nullptr && cached_execution_provider_for_graph_replay_->IsGraphCaptured();
     }
 
+    void SetGraphCaptureKey(gsl::span<const int64_t> key) {
+      if (cached_execution_provider_for_graph_replay_ != nullptr) {
+        cached_execution_provider_for_graph_replay_->SetGraphCaptureKey(key);
+      }
+    }
+
     Status ReplayGraph() {
       ORT_ENFORCE(IsGraphCaptured());
       if (cached_execution_provider_for_graph_replay_) {
@@ -850,6 +975,26 @@ class InferenceSession {
   CachedExecutionProviderForGraphReplay cached_execution_provider_for_graph_replay_;
 };
 
+class InferenceSession::PreparedRun {
+ public:
+  ~PreparedRun();
+
+  gsl::span<const std::string> FeedNames() const { return feed_names_; }
+  gsl::span<const std::string> OutputNames() const { return output_names_; }
+
+ private:
+  friend class InferenceSession;
+
+  PreparedRun() = default;
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(PreparedRun);
+
+  std::vector<std::string> feed_names_;
+  std::vector<std::string> output_names_;
+  // definition of the model input of each feed
+  std::vector<const InputDefMetaData*> input_defs_;
+  std::unique_ptr<FeedsFetchesManager> feeds_fetches_manager_;
+};
+
 struct SessionIOBinding {
  public:
   SessionIOBinding(InferenceSession* session);
@@ -17,6 +17,7 @@
 
 #include "core/common/common.h"
 #include "core/common/logging/logging.h"
+#include "core/common/metrics.h"
 #include "core/common/narrow.h"
 #include "core/common/status.h"
 #include "core/common/safeint.h"
@@ -33,6 +34,7 @@
 #include "core/session/inference_session.h"
 #include "core/session/ort_apis.h"
 #include "core/session/ort_env.h"
+#include "core/session/session_pipeline.h"
 #include "core/framework/data_types.h"
 #include "abi_session_options_impl.h"
 #include "core/framework/TensorSeq.h"
@@ -895,6 +897,297 @@ ORT_API_STATUS_IMPL(OrtApis::Run, _Inout_ OrtSession* sess, _In_opt_ const OrtRu
   API_IMPL_END
 }
 
+ORT_API_STATUS_IMPL(OrtApis::RunAsync, _Inout_ OrtSession* sess, _In_opt_ const OrtRunOptions* run_options,
+                    _In_reads_(input_len) const char* const* input_names,
+                    _In_reads_(input_len) const OrtValue* const* input, size_t input_len,
+                    _In_reads_(output_names_len) const char* const* output_names1, size_t output_names_len,
+                    _Inout_updates_all_(output_names_len) OrtValue** output,
+                    _In_ RunAsyncCallbackFn run_async_callback, _In_opt_ void* user_data) {
+  API_IMPL_BEGIN
+  auto session = reinterpret_cast<::onnxruntime::InferenceSession*>(sess);
+
+  if (run_async_callback == nullptr) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "run_async_callback cannot be null");
+  }
+
+  InlinedVector<std::string> feed_names;
+  feed_names.reserve(input_len);
+  InlinedVector<OrtValue> feeds;
+  feeds.reserve(input_len);
+
+  for (size_t i = 0; i != input_len; ++i) {
+    if (input_names[i] == nullptr || input_names[i][0] == '\0') {
+      return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "input name cannot be empty");
+    }
+
+    if (!input[i]) {
+      return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT,
+                                   MakeString("NULL input supplied for input ", input_names[i]).c_str());
+    }
+
+    feed_names.emplace_back(input_names[i]);
+    feeds.emplace_back(*input[i]);
+  }
+
+  InlinedVector<std::string> output_names;
+  output_names.reserve(output_names_len);
+  for (size_t i = 0; i != output_names_len; ++i) {
+    if (output_names1[i] == nullptr || output_names1[i][0] == '\0') {
+      return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "output name cannot be empty");
+    }
+    output_names.emplace_back(output_names1[i]);
+  }
+
+  return ToOrtStatus(session->RunAsync(run_options, feed_names, feeds, output_names,
+                                       gsl::span<OrtValue*>(output, output_names_len),
+                                       run_async_callback, user_data));
+  API_IMPL_END
+}
+
+struct OrtPreparedRun {
+  std::unique_ptr<::onnxruntime::InferenceSession::PreparedRun> prepared_run_;
+  // reused by every run so that they do not allocate
+  std::vector<OrtValue> feeds_;
+  std::vector<OrtValue> fetches_;
+};
+
+ORT_API_STATUS_IMPL(OrtApis::CreatePreparedRun, _In_ const OrtSession* sess,
+                    _In_reads_(input_len) const char* const* input_names, size_t input_len,
+                    _In_reads_(output_names_len) const char* const* output_names1, size_t output_names_len,
+                    _Outptr_ OrtPreparedRun** out) {
+  API_IMPL_BEGIN
+  auto session = reinterpret_cast<const ::onnxruntime::InferenceSession*>(sess);
+
+  InlinedVector<std::string> feed_names;
+  feed_names.reserve(input_len);
+  for (size_t i = 0; i != input_len; ++i) {
+    if (input_names[i] == nullptr || input_names[i][0] == '\0') {
+      return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "input name cannot be empty");
+    }
+    feed_names.emplace_back(input_names[i]);
+  }
+
+  InlinedVector<std::string> output_names;
+  output_names.reserve(output_names_len);
+  for (size_t i = 0; i != output_names_len; ++i) {
+    if (output_names1[i] == nullptr || output_names1[i][0] == '\0') {
+      return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "output name cannot be empty");
+    }
+    output_names.emplace_back(output_names1[i]);
+  }
+
+  auto prepared_run = std::make_unique<OrtPreparedRun>();
+  ORT_API_RETURN_IF_STATUS_NOT_OK(session->PrepareRun(feed_names, output_names, prepared_run->prepared_run_));
+  prepared_run->feeds_.reserve(input_len);
+  prepared_run->fetches_.reserve(output_names_len);
+  *out = prepared_run.release();
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API(void, OrtApis::ReleasePreparedRun, _Frees_ptr_opt_ OrtPreparedRun* prepared_run) {
+  delete prepared_run;
+}
+
+ORT_API_STATUS_IMPL(OrtApis::RunPrepared, _Inout_ OrtSession* sess, _In_opt_ const OrtRunOptions* run_options,
+                    _Inout_ OrtPreparedRun* prepared_run,
+                    _In_reads_(input_len) const OrtValue* const* input, size_t input_len,
+                    _Inout_updates_all_(output_len) OrtValue** output, size_t output_len) {
+  API_IMPL_BEGIN
+  auto session = reinterpret_cast<::onnxruntime::InferenceSession*>(sess);
+  if (output_len != prepared_run->prepared_run_->OutputNames().size()) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT,
+                                 MakeString("Expected ", prepared_run->prepared_run_->OutputNames().size(),
+                                            " outputs but got ", output_len).c_str());
+  }
+
+  auto& feeds = prepared_run->feeds_;
+  auto& fetches = prepared_run->fetches_;
+  // the values are only referenced for the duration of the run
+  auto release_values = gsl::finally([&feeds, &fetches]() {
+    feeds.clear();
+    fetches.clear();
+  });
+
+  for (size_t i = 0; i != input_len; ++i) {
+    if (!input[i]) {
+      return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, MakeString("NULL input supplied for input ", i).c_str());
+    }
+    feeds.emplace_back(*input[i]);
+  }
+
+  for (size_t i = 0; i != output_len; ++i) {
+    if (output[i] != nullptr) {
+      fetches.emplace_back(*output[i]);
+    } else {
+      fetches.emplace_back();
+    }
+  }
+
+  Status status;
+  if (run_options == nullptr) {
+    OrtRunOptions op;
+    status = session->Run(op, *prepared_run->prepared_run_, feeds, &fetches);
+  } else {
+    status = session->Run(*run_options, *prepared_run->prepared_run_, feeds, &fetches);
+  }
+  ORT_API_RETURN_IF_STATUS_NOT_OK(status);
+
+  // We do it in two loops to make sure copy __ctors does not throw
+  InlinedVector<std::unique_ptr<OrtValue>> output_unique_ptrs;
+  output_unique_ptrs.reserve(output_len);
+  for (size_t i = 0; i != output_len; ++i) {
+    if (output[i] == nullptr) {
+      output_unique_ptrs.emplace_back(std::make_unique<OrtValue>(std::move(fetches[i])));
+    } else {
+      output_unique_ptrs.emplace_back();
+    }
+  }
+
+  for (size_t i = 0; i != output_len; ++i) {
+    if (output[i] == nullptr) {
+      output[i] = output_unique_ptrs[i].release();
+    }
+  }
+  return nullptr;
+  API_IMPL_END
+}
+
+struct OrtSessionPipeline {
+  std::unique_ptr<::onnxruntime::SessionPipeline> pipeline_;
+};
+
+ORT_API_STATUS_IMPL(OrtApis::CreateSessionPipeline, _In_reads_(num_sessions) OrtSession* const* sessions,
+                    size_t num_sessions,
+                    _In_reads_(num_links) const size_t* link_src_stages,
+                    _In_reads_(num_links) const char* const* link_src_outputs,
+                    _In_reads_(num_links) const size_t* link_dst_stages,
+                    _In_reads_(num_links) const char* const* link_dst_inputs, size_t num_links,
+                    _Outptr_ OrtSessionPipeline** out) {
+  API_IMPL_BEGIN
+  InlinedVector<::onnxruntime::InferenceSession*> stage_sessions;
+  stage_sessions.reserve(num_sessions);
+  for (size_t i = 0; i != num_sessions; ++i) {
+    stage_sessions.push_back(reinterpret_cast<::onnxruntime::InferenceSession*>(sessions[i]));
+  }
+
+  InlinedVector<::onnxruntime::SessionPipeline::Link> links;
+  links.reserve(num_links);
+  for (size_t i = 0; i != num_links; ++i) {
+    if (link_src_outputs[i] == nullptr || link_src_outputs[i][0] == '\0' ||
+        link_dst_inputs[i] == nullptr || link_dst_inputs[i][0] == '\0') {
+      return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "link names cannot be empty");
+    }
+    links.push_back({link_src_stages[i], link_src_outputs[i], link_dst_stages[i], link_dst_inputs[i]});
+  }
+
+  auto pipeline = std::make_unique<OrtSessionPipeline>();
+  ORT_API_RETURN_IF_STATUS_NOT_OK(::onnxruntime::SessionPipeline::Create(stage_sessions, links,
+                                                                         pipeline->pipeline_));
+  *out = pipeline.release();
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API(void, OrtApis::ReleaseSessionPipeline, _Frees_ptr_opt_ OrtSessionPipeline* pipeline) {
+  delete pipeline;
+}
+
+ORT_API_STATUS_IMPL(OrtApis::RunSessionPipeline, _In_ const OrtSessionPipeline* pipeline,
+                    _In_opt_ const OrtRunOptions* run_options,
+                    _In_reads_(input_len) const char* const* input_names,
+                    _In_reads_(input_len) const OrtValue* const* input, size_t input_len,
+                    _In_reads_(output_names_len) const char* const* output_names1, size_t output_names_len,
+                    _Inout_updates_all_(output_names_len) OrtValue** output) {
+  API_IMPL_BEGIN
+  InlinedVector<std::string> feed_names;
+  feed_names.reserve(input_len);
+  InlinedVector<OrtValue> feeds;
+  feeds.reserve(input_len);
+
+  for (size_t i = 0; i != input_len; ++i) {
+    if (input_names[i] == nullptr || input_names[i][0] == '\0') {
+      return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "input name cannot be empty");
+    }
+
+    if (!input[i]) {
+      return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT,
+                                   MakeString("NULL input supplied for input ", input_names[i]).c_str());
+    }
+
+    feed_names.emplace_back(input_names[i]);
+    feeds.emplace_back(*input[i]);
+  }
+
+  InlinedVector<std::string> output_names;
+  output_names.reserve(output_names_len);
+  std::vector<OrtValue> fetches;
+  fetches.reserve(output_names_len);
+  for (size_t i = 0; i != output_names_len; ++i) {
+    if (output_names1[i] == nullptr || output_names1[i][0] == '\0') {
+      return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "output name cannot be empty");
+    }
+    output_names.emplace_back(output_names1[i]);
+
+    if (output[i] != nullptr) {
+      fetches.emplace_back(*output[i]);
+    } else {
+      fetches.emplace_back();
+    }
+  }
+
+  Status status;
+  if (run_options == nullptr) {
+    OrtRunOptions op;
+    status = pipeline->pipeline_->Run(op, feed_names, feeds, output_names, &fetches);
+  } else {
+    status = pipeline->pipeline_->Run(*run_options, feed_names, feeds, output_names, &fetches);
+  }
+  ORT_API_RETURN_IF_STATUS_NOT_OK(status);
+
+  // We do it in two loops to make sure copy __ctors does not throw
+  InlinedVector<std::unique_ptr<OrtValue>> output_unique_ptrs;
+  output_unique_ptrs.reserve(output_names_len);
+  for (size_t i = 0; i != output_names_len; ++i) {
+    if (output[i] == nullptr) {
+      output_unique_ptrs.emplace_back(std::make_unique<OrtValue>(std::move(fetches[i])));
+    } else {
+      output_unique_ptrs.emplace_back();
+    }
+  }
+
+  for (size_t i = 0; i != output_names_len; ++i) {
+    if (output[i] == nullptr) {
+      output[i] = output_unique_ptrs[i].release();
+    }
+  }
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtApis::UpdateSessionInitializers, _Inout_ OrtSession* sess,
+                    _In_reads_(initializers_len) const char* const* initializer_names,
+                    _In_reads_(initializers_len) const OrtValue* const* initializers, size_t initializers_len) {
+  API_IMPL_BEGIN
+  auto session = reinterpret_cast<::onnxruntime::InferenceSession*>(sess);
+  InlinedVector<std::string> names;
+  std::vector<OrtValue> values;
+  names.reserve(initializers_len);
+  values.reserve(initializers_len);
+  for (size_t i = 0; i != initializers_len; ++i) {
+    if (initializer_names[i] == nullptr || initializers[i] == nullptr) {
+      return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT,
+                                   MakeString("NULL name or value supplied for initializer ", i).c_str());
+    }
+    names.emplace_back(initializer_names[i]);
+    values.emplace_back(*initializers[i]);
+  }
+
+  ORT_API_RETURN_IF_STATUS_NOT_OK(session->UpdateInitializers(names, values));
+  return nullptr;
+  API_IMPL_END
+}
+
 struct OrtIoBinding {
   std::unique_ptr<::onnxruntime::IOBinding> binding_;
   explicit OrtIoBinding(std::unique_ptr<::onnxruntime::IOBinding>&& binding) : binding_(std::move(binding)) {}
@@ -1389,6 +1682,24 @@ ORT_API_STATUS_IMPL(OrtApis::SessionEndProfiling, _In_ OrtSession* sess, _Inout_
   API_IMPL_END
 }
 
+ORT_API_STATUS_IMPL(OrtApis::SessionGetSampledRuns, _In_ const OrtSession* sess, _Inout_ OrtAllocator* allocator,
+                    _Outptr_ char** out) {
+  API_IMPL_BEGIN
+  auto session = reinterpret_cast<const ::onnxruntime::InferenceSession*>(sess);
+  std::string sampled_runs;
+  ORT_API_RETURN_IF_STATUS_NOT_OK(session->GetSampledRuns(sampled_runs));
+  *out = StrDup(sampled_runs, allocator);
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtApis::GetMetrics, _Inout_ OrtAllocator* allocator, _Outptr_ char** out) {
+  API_IMPL_BEGIN
+  *out = StrDup(onnxruntime::metrics::MetricsRegistry::Instance().ToPrometheusText(), allocator);
+  return nullptr;
+  API_IMPL_END
+}
+
 ORT_API_STATUS_IMPL(OrtApis::SessionGetModelMetadata, _In_ const OrtSession* sess,
                     _Outptr_ OrtModelMetadata** out) {
   API_IMPL_BEGIN
@@ -2255,6 +2566,10 @@ ORT_API_STATUS_IMPL(OrtApis::CreateArenaCfgV2, _In_reads_(num_keys) const char*
       cfg->initial_growth_chunk_size_bytes = static_cast<int>(arena_config_values[i]);
     } else if (strcmp(arena_config_keys[i], "max_power_of_two_extend_bytes") == 0) {
       cfg->max_power_of_two_extend_bytes = static_cast<int64_t>(arena_config_values[i]);
+    } else if (strcmp(arena_config_keys[i], "max_thread_cache_bytes") == 0) {
+      cfg->max_thread_cache_bytes = static_cast<int64_t>(arena_config_values[i]);
+    } else if (strcmp(arena_config_keys[i], "trim_window_ms") == 0) {
+      cfg->trim_window_ms = static_cast<int64_t>(arena_config_values[i]);
     } else {
       std::ostringstream oss;
       oss << "Invalid key found: " << arena_config_keys[i];
@@ -2735,6 +3050,16 @@ static constexpr OrtApi ort_api_1_to_16 = {
     &OrtApis::GetROCMProviderOptionsAsString,
     &OrtApis::ReleaseROCMProviderOptions,
     &OrtApis::CreateAndRegisterAllocatorV2,
+    &OrtApis::RunAsync,
+    &OrtApis::CreatePreparedRun,
+    &OrtApis::ReleasePreparedRun,
+    &OrtApis::RunPrepared,
+    &OrtApis::UpdateSessionInitializers,
+    &OrtApis::SessionGetSampledRuns,
+    &OrtApis::GetMetrics,
+    &OrtApis::CreateSessionPipeline,
+    &OrtApis::ReleaseSessionPipeline,
+    &OrtApis::RunSessionPipeline,
 };
 
 // OrtApiBase can never change as there is no way to know what version of OrtApiBase is returned by OrtGetApiBase.
@@ -478,4 +478,44 @@ ORT_API(void, ReleaseROCMProviderOptions, _Frees_ptr_opt_ OrtROCMProviderOptions
 
 ORT_API_STATUS_IMPL(CreateAndRegisterAllocatorV2, _Inout_ OrtEnv* env, _In_ const char* provider_type, _In_ const OrtMemoryInfo* mem_info, _In_ const OrtArenaCfg* arena_cfg,
                     _In_reads_(num_keys) const char* const* provider_options_keys, _In_reads_(num_keys) const char* const* provider_options_values, _In_ size_t num_keys);
+
+ORT_API_STATUS_IMPL(RunAsync, _Inout_ OrtSession* sess, _In_opt_ const OrtRunOptions* run_options,
+                    _In_reads_(input_len) const char* const* input_names,
+                    _In_reads_(input_len) const OrtValue* const* input, size_t input_len,
+                    _In_reads_(output_names_len) const char* const* output_names, size_t output_names_len,
+                    _Inout_updates_all_(output_names_len) OrtValue** output,
+                    _In_ RunAsyncCallbackFn run_async_callback, _In_opt_ void* user_data);
+
+ORT_API_STATUS_IMPL(CreatePreparedRun, _In_ const OrtSession* sess,
+                    _In_reads_(input_len) const char* const* input_names, size_t input_len,
+                    _In_reads_(output_names_len) const char* const* output_names, size_t output_names_len,
+                    _Outptr_ OrtPreparedRun** out);
+
+ORT_API(void, ReleasePreparedRun, _Frees_ptr_opt_ OrtPreparedRun*);
+
+ORT_API_STATUS_IMPL(RunPrepared, _Inout_ OrtSession* sess, _In_opt_ const OrtRunOptions* run_options,
+                    _Inout_ OrtPreparedRun* prepared_run,
+                    _In_reads_(input_len) const OrtValue* const* input, size_t input_len,
+                    _Inout_updates_all_(output_len) OrtValue** output, size_t output_len);
+
+ORT_API_STATUS_IMPL(UpdateSessionInitializers, _Inout_ OrtSession* sess,
+                    _In_reads_(initializers_len) const char* const* initializer_names,
+                    _In_reads_(initializers_len) const OrtValue* const* initializers, size_t initializers_len);
+ORT_API_STATUS_IMPL(SessionGetSampledRuns, _In_ const OrtSession* sess, _Inout_ OrtAllocator* allocator,
+                    _Outptr_ char** out);
+ORT_API_STATUS_IMPL(GetMetrics, _Inout_ OrtAllocator* allocator, _Outptr_ char** out);
+
+ORT_API_STATUS_IMPL(CreateSessionPipeline, _In_reads_(num_sessions) OrtSession* const* sessions, size_t num_sessions,
+                    _In_reads_(num_links) const size_t* link_src_stages,
+                    _In_reads_(num_links) const char* const* link_src_outputs,
+                    _In_reads_(num_links) const size_t* link_dst_stages,
+                    _In_reads_(num_links) const char* const* link_dst_inputs, size_t num_links,
+                    _Outptr_ OrtSessionPipeline** out);
+ORT_API(void, ReleaseSessionPipeline, _Frees_ptr_opt_ OrtSessionPipeline*);
+ORT_API_STATUS_IMPL(RunSessionPipeline, _In_ const OrtSessionPipeline* pipeline,
+                    _In_opt_ const OrtRunOptions* run_options,
+                    _In_reads_(input_len) const char* const* input_names,
+                    _In_reads_(input_len) const OrtValue* const* input, size_t input_len,
+                    _In_reads_(output_names_len) const char* const* output_names, size_t output_names_len,
+                    _Inout_updates_all_(output_names_len) OrtValue** output);
 }  // namespace OrtApis
@@ -10,7 +10,9 @@
 #include "core/session/environment.h"
 #include "core/session/allocator_adapters.h"
 #include "core/common/logging/logging.h"
+#include "core/common/logging/sinks/async_sink.h"
 #include "core/framework/provider_shutdown.h"
+#include "core/platform/env_var_utils.h"
 #include "core/platform/logging/make_platform_default_log_sink.h"
 
 using namespace onnxruntime;
@@ -20,6 +22,26 @@ std::unique_ptr<OrtEnv> OrtEnv::p_instance_;
 int OrtEnv::ref_count_ = 0;
 onnxruntime::OrtMutex OrtEnv::m_;
 
+namespace {
+// Setting the buffer size makes the default logging manager hand messages over to a background thread that writes
+// them, so that logging does not hold up the threads that log. Messages that do not fit in the buffer are dropped.
+// A custom logging function is then called from the background thread.
+constexpr const char* kAsyncLoggingBufferSizeEnvVar = "ORT_ASYNC_LOGGING_BUFFER_SIZE";
+// Number of messages a call site can log per second with async logging. 0 (the default) for no limit.
+constexpr const char* kAsyncLoggingMaxMessagesPerCallSiteEnvVar = "ORT_ASYNC_LOGGING_MAX_MESSAGES_PER_CALL_SITE";
+
+std::unique_ptr<ISink> MakeAsyncSinkIfEnabled(std::unique_ptr<ISink> sink) {
+  const auto buffer_size = ParseEnvironmentVariableWithDefault<size_t>(kAsyncLoggingBufferSizeEnvVar, 0);
+  if (buffer_size == 0) {
+    return sink;
+  }
+
+  const auto max_messages_per_call_site =
+      ParseEnvironmentVariableWithDefault<size_t>(kAsyncLoggingMaxMessagesPerCallSiteEnvVar, 0);
+  return std::make_unique<AsyncSink>(std::move(sink), buffer_size, max_messages_per_call_site);
+}
+}  // namespace
+
 LoggingWrapper::LoggingWrapper(OrtLoggingFunction logging_function, void* logger_param)
     : logging_function_(logging_function), logger_param_(logger_param) {
 }
@@ -52,7 +74,7 @@ OrtEnv* OrtEnv::GetInstance(const OrtEnv::LoggingManagerConstructionInfo& lm_inf
     if (lm_info.logging_function) {
       std::unique_ptr<ISink> logger = std::make_unique<LoggingWrapper>(lm_info.logging_function,
                                                                        lm_info.logger_param);
-      lmgr = std::make_unique<LoggingManager>(std::move(logger),
+      lmgr = std::make_unique<LoggingManager>(MakeAsyncSinkIfEnabled(std::move(logger)),
                                               static_cast<Severity>(lm_info.default_warning_level),
                                               false,
                                               LoggingManager::InstanceType::Default,
@@ -60,7 +82,7 @@ OrtEnv* OrtEnv::GetInstance(const OrtEnv::LoggingManagerConstructionInfo& lm_inf
     } else {
       auto sink = MakePlatformDefaultLogSink();
 
-      lmgr = std::make_unique<LoggingManager>(std::move(sink),
+      lmgr = std::make_unique<LoggingManager>(MakeAsyncSinkIfEnabled(std::move(sink)),
                                               static_cast<Severity>(lm_info.default_warning_level),
                                               false,
                                               LoggingManager::InstanceType::Default,
@@ -29,6 +29,7 @@
 #include "core/framework/sparse_utils.h"
 #include "core/graph/graph_proto_serializer.h"
 #include "core/framework/murmurhash3.h"
+#include "core/framework/nvtx_ranges.h"
 
 #include "core/session/onnxruntime_c_api.h"
 #include "core/common/string_helper.h"
@@ -66,6 +67,7 @@ using IndexedSubGraph_MetaDef = IndexedSubGraph::MetaDef;
 
 #include "core/common/cpuid_info.h"
 #include "core/common/logging/logging.h"
+#include "core/common/metrics.h"
 #include "core/providers/shared_library/provider_interfaces.h"
 
 #include "core/providers/cuda/cuda_provider_factory_creator.h"
@@ -242,6 +244,10 @@ struct ProviderHostImpl : ProviderHost {
 
   std::string GetEnvironmentVar(const std::string& var_name) override { return Env::Default().GetEnvironmentVar(var_name); }
 
+  void AddToMetricsCounter(const std::string& name, const std::string& help, uint64_t value) override {
+    metrics::AddToCounter(name, help, value);
+  }
+
   unsigned int GetThreadId() override { return onnxruntime::logging::GetThreadId(); }
   unsigned int GetProcessId() override { return onnxruntime::logging::GetProcessId(); }
 
@@ -1108,6 +1114,13 @@ struct ProviderHostImpl : ProviderHost {
     MurmurHash3::x86_128(key, len, seed, out);
   }
 
+  // NvtxRanges (direct)
+  bool NvtxRanges__IsEnabled() override { return profiling::NvtxRanges::IsEnabled(); }
+  void NvtxRanges__Push(const char* message, profiling::NvtxColor color) override {
+    profiling::NvtxRanges::Push(message, color);
+  }
+  void NvtxRanges__Pop() override { profiling::NvtxRanges::Pop(); }
+
 #ifdef _WIN32
   std::string ToUTF8String(const std::wstring& s) override { return onnxruntime::ToUTF8String(s); }
   std::wstring ToWideString(const std::string& s) override { return onnxruntime::ToWideString(s); }
@@ -1300,6 +1313,12 @@ OrtCUDAProviderOptionsV2 OrtCUDAProviderOptionsToOrtCUDAProviderOptionsV2(const
   cuda_options_converted.enable_cuda_graph = 0;
   cuda_options_converted.cudnn_conv1d_pad_to_nc1d = 0;
   cuda_options_converted.enable_skip_layer_norm_strict_mode = 0;
+  cuda_options_converted.use_pinned_staging_buffers = 1;
+  cuda_options_converted.use_stream_ordered_allocator = 0;
+  cuda_options_converted.mem_pool_release_threshold = std::numeric_limits<size_t>::max();
+  cuda_options_converted.prefer_nhwc = 0;
+  cuda_options_converted.cuda_graph_max_graphs = 8;
+  cuda_options_converted.embedding_cache_size_in_mb = 0;
 
   return cuda_options_converted;
 }
@@ -1373,6 +1392,8 @@ OrtTensorRTProviderOptionsV2 OrtTensorRTProviderOptionsToOrtTensorRTProviderOpti
   trt_options_converted.trt_profile_max_shapes = "";
   trt_options_converted.trt_profile_opt_shapes = "";
   trt_options_converted.trt_cuda_graph_enable = 0;
+  trt_options_converted.trt_async_engine_build_enable = 0;
+  trt_options_converted.trt_profile_warmup_runs = 0;
 
   return trt_options_converted;
 }
@@ -1744,6 +1765,8 @@ ORT_API_STATUS_IMPL(OrtApis::CreateTensorRTProviderOptions, _Outptr_ OrtTensorRT
   options->trt_profile_max_shapes = nullptr;
   options->trt_profile_opt_shapes = nullptr;
   options->trt_cuda_graph_enable = false;
+  options->trt_async_engine_build_enable = false;
+  options->trt_profile_warmup_runs = 0;
   *out = options.release();
   return nullptr;
 #else
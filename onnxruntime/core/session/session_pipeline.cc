@@ -0,0 +1,234 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/session/session_pipeline.h"
+
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <utility>
+
+#include "core/framework/sequential_execution_plan.h"
+#include "core/framework/session_state.h"
+#include "core/session/inference_session.h"
+
+namespace onnxruntime {
+
+namespace {
+// Device where a session consumes an input, as planned when the session was initialized. Inputs that no node
+// consumes are not in the plan and are left in CPU memory.
+OrtDevice GetInputDevice(const InferenceSession& session, const std::string& input_name) {
+  const SessionState& session_state = session.GetSessionState();
+  int idx = -1;
+  if (!session_state.GetOrtValueNameIdxMap().GetIdx(input_name, idx).IsOK()) {
+    return OrtDevice();
+  }
+  return session_state.GetExecutionPlan()->GetLocation(static_cast<size_t>(idx));
+}
+
+std::vector<std::string> GetNames(const std::vector<const NodeArg*>& defs) {
+  std::vector<std::string> names;
+  names.reserve(defs.size());
+  for (const auto* def : defs) {
+    names.push_back(def->Name());
+  }
+  return names;
+}
+}  // namespace
+
+Status SessionPipeline::Create(gsl::span<InferenceSession* const> sessions, gsl::span<const Link> links,
+                               std::unique_ptr<SessionPipeline>& pipeline) {
+  ORT_RETURN_IF(sessions.empty(), "A session pipeline requires at least one session.");
+
+  std::unique_ptr<SessionPipeline> p(new SessionPipeline());
+  p->stages_.resize(sessions.size());
+
+  std::vector<std::vector<std::string>> stage_inputs(sessions.size());
+  for (size_t s = 0; s < sessions.size(); ++s) {
+    InferenceSession* session = sessions[s];
+    ORT_RETURN_IF(session == nullptr || !session->IsInitialized(),
+                  "The session of stage ", s, " of the pipeline is not initialized.");
+
+    auto inputs = session->GetModelInputs();
+    ORT_RETURN_IF_ERROR(inputs.first);
+    auto outputs = session->GetModelOutputs();
+    ORT_RETURN_IF_ERROR(outputs.first);
+
+    Stage& stage = p->stages_[s];
+    stage.session = session;
+    stage_inputs[s] = GetNames(*inputs.second);
+    for (const auto& name : GetNames(*outputs.second)) {
+      stage.output_names.insert(name);
+    }
+  }
+
+  // validate the links and group them by linked output
+  std::map<std::pair<size_t, std::string>, size_t> input_links;
+  std::map<std::pair<size_t, std::string>, std::vector<size_t>> output_links;
+  for (size_t i = 0; i < links.size(); ++i) {
+    const Link& link = links[i];
+    ORT_RETURN_IF_NOT(link.src_stage < link.dst_stage && link.dst_stage < sessions.size(),
+                      "Invalid link from stage ", link.src_stage, " to stage ", link.dst_stage,
+                      ". Outputs can only be linked to inputs of later stages of the ", sessions.size(),
+                      " stages of the pipeline.");
+    ORT_RETURN_IF(p->stages_[link.src_stage].output_names.count(link.src_output) == 0,
+                  "Invalid link: stage ", link.src_stage, " has no output named '", link.src_output, "'.");
+    const auto& dst_inputs = stage_inputs[link.dst_stage];
+    ORT_RETURN_IF(std::find(dst_inputs.begin(), dst_inputs.end(), link.dst_input) == dst_inputs.end(),
+                  "Invalid link: stage ", link.dst_stage, " has no input named '", link.dst_input, "'.");
+    ORT_RETURN_IF_NOT(input_links.emplace(std::make_pair(link.dst_stage, link.dst_input), i).second,
+                      "Input '", link.dst_input, "' of stage ", link.dst_stage, " is linked more than once.");
+    output_links[{link.src_stage, link.src_output}].push_back(i);
+  }
+
+  // the inputs that are not linked are the inputs of the pipeline
+  InlinedHashMap<std::string, size_t> input_slots;
+  for (size_t s = 0; s < sessions.size(); ++s) {
+    for (const auto& name : stage_inputs[s]) {
+      if (input_links.count({s, name}) == 0 && input_slots.emplace(name, p->input_names_.size()).second) {
+        p->input_names_.push_back(name);
+      }
+    }
+  }
+
+  // the linked outputs follow the inputs
+  std::vector<size_t> link_slots(links.size());
+  size_t slot = p->input_names_.size();
+  for (const auto& [output, link_indices] : output_links) {
+    // fetch the output where its first consumer needs it, the others copy it if they run on another device
+    size_t first_consumer = link_indices.front();
+    size_t last_consumer = link_indices.front();
+    for (size_t i : link_indices) {
+      link_slots[i] = slot;
+      if (links[i].dst_stage < links[first_consumer].dst_stage) {
+        first_consumer = i;
+      }
+      if (links[i].dst_stage > links[last_consumer].dst_stage) {
+        last_consumer = i;
+      }
+    }
+
+    Stage& src_stage = p->stages_[output.first];
+    src_stage.linked_output_names.push_back(output.second);
+    src_stage.linked_output_slots.push_back(slot);
+    src_stage.linked_output_devices.push_back(GetInputDevice(*sessions[links[first_consumer].dst_stage],
+                                                             links[first_consumer].dst_input));
+    p->stages_[links[last_consumer].dst_stage].released_slots.push_back(slot);
+    ++slot;
+  }
+  p->num_slots_ = slot;
+
+  for (size_t s = 0; s < sessions.size(); ++s) {
+    Stage& stage = p->stages_[s];
+    for (const auto& name : stage_inputs[s]) {
+      auto link = input_links.find({s, name});
+      stage.feed_names.push_back(name);
+      stage.feed_slots.push_back(link != input_links.end() ? link_slots[link->second] : input_slots[name]);
+    }
+  }
+
+  pipeline = std::move(p);
+  return Status::OK();
+}
+
+Status SessionPipeline::Run(const RunOptions& run_options,
+                            gsl::span<const std::string> feed_names,
+                            gsl::span<const OrtValue> feeds,
+                            gsl::span<const std::string> output_names,
+                            std::vector<OrtValue>* p_fetches) const {
+  ORT_RETURN_IF_NOT(feed_names.size() == feeds.size(), "The number of feed names ", feed_names.size(),
+                    " does not match the number of feeds ", feeds.size());
+  ORT_RETURN_IF(p_fetches == nullptr, "Output vector pointer is NULL");
+
+  std::vector<OrtValue> values(num_slots_);
+  for (size_t i = 0; i < feed_names.size(); ++i) {
+    auto input = std::find(input_names_.begin(), input_names_.end(), feed_names[i]);
+    ORT_RETURN_IF(input == input_names_.end(), "Invalid input name: ", feed_names[i]);
+    values[static_cast<size_t>(input - input_names_.begin())] = feeds[i];
+  }
+
+  // Outputs that are linked are taken from their slot once all the stages have run, the others are fetched by the
+  // stage that produces them.
+  constexpr size_t kNotLinked = std::numeric_limits<size_t>::max();
+  std::vector<size_t> output_slots(output_names.size(), kNotLinked);
+  std::vector<InlinedVector<size_t>> stage_outputs(stages_.size());
+  InlinedHashSet<size_t> kept_slots;
+  for (size_t i = 0; i < output_names.size(); ++i) {
+    size_t s = stages_.size();
+    while (s > 0 && stages_[s - 1].output_names.count(output_names[i]) == 0) {
+      --s;
+    }
+    ORT_RETURN_IF(s == 0, "Invalid output name: ", output_names[i]);
+
+    const Stage& stage = stages_[s - 1];
+    auto linked = std::find(stage.linked_output_names.begin(), stage.linked_output_names.end(), output_names[i]);
+    if (linked != stage.linked_output_names.end()) {
+      output_slots[i] = stage.linked_output_slots[static_cast<size_t>(linked - stage.linked_output_names.begin())];
+      kept_slots.insert(output_slots[i]);
+    } else {
+      stage_outputs[s - 1].push_back(i);
+    }
+  }
+
+  std::vector<OrtValue>& fetches = *p_fetches;
+  if (fetches.empty()) {
+    fetches.resize(output_names.size());
+  } else {
+    ORT_RETURN_IF_NOT(fetches.size() == output_names.size(), "Output vector incorrectly sized: output_names.size(): ",
+                      output_names.size(), " p_fetches->size(): ", fetches.size());
+  }
+
+  std::vector<std::string> stage_feed_names;
+  std::vector<OrtValue> stage_feeds;
+  std::vector<std::string> stage_output_names;
+  std::vector<OrtDevice> stage_fetch_devices;
+  std::vector<OrtValue> stage_fetches;
+  for (size_t s = 0; s < stages_.size(); ++s) {
+    const Stage& stage = stages_[s];
+
+    stage_feed_names.clear();
+    stage_feeds.clear();
+    for (size_t j = 0; j < stage.feed_names.size(); ++j) {
+      // optional inputs may not be fed
+      const OrtValue& value = values[stage.feed_slots[j]];
+      if (value.IsAllocated()) {
+        stage_feed_names.push_back(stage.feed_names[j]);
+        stage_feeds.push_back(value);
+      }
+    }
+
+    stage_output_names.assign(stage.linked_output_names.begin(), stage.linked_output_names.end());
+    stage_fetch_devices.assign(stage.linked_output_devices.begin(), stage.linked_output_devices.end());
+    stage_fetches.assign(stage.linked_output_names.size(), OrtValue());
+    for (size_t i : stage_outputs[s]) {
+      stage_output_names.push_back(output_names[i]);
+      stage_fetch_devices.push_back(OrtDevice());
+      stage_fetches.push_back(fetches[i]);
+    }
+
+    ORT_RETURN_IF_ERROR(stage.session->Run(run_options, stage_feed_names, stage_feeds, stage_output_names,
+                                           &stage_fetches, &stage_fetch_devices));
+
+    for (size_t k = 0; k < stage.linked_output_slots.size(); ++k) {
+      values[stage.linked_output_slots[k]] = std::move(stage_fetches[k]);
+    }
+    for (size_t k = 0; k < stage_outputs[s].size(); ++k) {
+      fetches[stage_outputs[s][k]] = std::move(stage_fetches[stage.linked_output_slots.size() + k]);
+    }
+    for (size_t released : stage.released_slots) {
+      if (kept_slots.count(released) == 0) {
+        values[released] = OrtValue();
+      }
+    }
+  }
+
+  for (size_t i = 0; i < output_names.size(); ++i) {
+    if (output_slots[i] != kNotLinked) {
+      fetches[i] = values[output_slots[i]];
+    }
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
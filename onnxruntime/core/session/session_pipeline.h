@@ -0,0 +1,87 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/gsl.h"
+#include "core/common/inlined_containers.h"
+#include "core/common/status.h"
+#include "core/framework/ort_value.h"
+#include "core/framework/run_options.h"
+
+namespace onnxruntime {
+
+class InferenceSession;
+
+/**
+ * Runs several sessions in sequence, feeding outputs of earlier stages to inputs of later ones.
+ *
+ * An output that is linked to an input of a later stage is fetched on the device where that stage consumes the
+ * input, so e.g. the output of a CUDA stage consumed by another CUDA stage stays in device memory and is handed
+ * over without being copied. It is released as soon as its last consumer has run.
+ *
+ * The inputs of the stages that are not linked are the inputs of the pipeline, fed by name. Inputs with the same
+ * name in several stages are fed the same value. An output name of the pipeline refers to the output of the last
+ * stage that has an output with that name. Outputs that are not linked are returned in CPU memory, and outputs
+ * that are linked on the device of their first consumer.
+ *
+ * Run is thread-safe like InferenceSession::Run, so concurrent runs of a pipeline progress through different
+ * stages at the same time. The sessions must outlive the pipeline.
+ */
+class SessionPipeline {
+ public:
+  struct Link {
+    size_t src_stage;
+    std::string src_output;
+    size_t dst_stage;
+    std::string dst_input;
+  };
+
+  /**
+   * Creates a pipeline of initialized sessions.
+   * @param links links from outputs of stages to inputs of later stages. An input can only be linked once.
+   */
+  static Status Create(gsl::span<InferenceSession* const> sessions, gsl::span<const Link> links,
+                       std::unique_ptr<SessionPipeline>& pipeline);
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(SessionPipeline);
+
+  Status Run(const RunOptions& run_options,
+             gsl::span<const std::string> feed_names,
+             gsl::span<const OrtValue> feeds,
+             gsl::span<const std::string> output_names,
+             std::vector<OrtValue>* p_fetches) const;
+
+  /** Names of the inputs of the pipeline, which are the inputs of the stages that are not linked. */
+  const std::vector<std::string>& InputNames() const { return input_names_; }
+
+ private:
+  // The values passed between the stages of a run are kept in slots: the inputs of the pipeline first, then the
+  // linked outputs.
+  struct Stage {
+    InferenceSession* session;
+    std::vector<std::string> feed_names;
+    std::vector<size_t> feed_slots;
+    // linked outputs, fetched on the device of their first consumer
+    std::vector<std::string> linked_output_names;
+    std::vector<size_t> linked_output_slots;
+    std::vector<OrtDevice> linked_output_devices;
+    // names of all the outputs, to resolve the outputs of the pipeline
+    InlinedHashSet<std::string> output_names;
+    // linked outputs whose last consumer is this stage
+    std::vector<size_t> released_slots;
+  };
+
+  SessionPipeline() = default;
+
+  std::vector<Stage> stages_;
+  std::vector<std::string> input_names_;
+  size_t num_slots_ = 0;
+};
+
+}  // namespace onnxruntime
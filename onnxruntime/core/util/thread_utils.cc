@@ -71,6 +71,44 @@ static std::vector<LogicalProcessors> ReadThreadAffinityConfig(const std::string
 }
 #endif
 
+// Bind the worker threads to the NUMA nodes and record the node of every affinity.
+// The first affinity is the placeholder of the main thread, which is left untouched.
+static void SetNumaAffinities(const std::vector<LogicalProcessors>& numa_nodes, int thread_pool_size,
+                              ThreadOptions& to) {
+  std::vector<size_t> online_nodes;
+  for (size_t node = 0; node < numa_nodes.size(); ++node) {
+    if (!numa_nodes[node].empty()) {
+      online_nodes.push_back(node);
+    }
+  }
+  if (online_nodes.size() <= 1) {
+    return;
+  }
+
+  if (to.affinities.empty()) {
+    const size_t num_workers = static_cast<size_t>(thread_pool_size) - 1;
+    to.affinities.emplace_back();
+    for (size_t i = 0; i < num_workers; ++i) {
+      to.affinities.push_back(numa_nodes[online_nodes[i * online_nodes.size() / num_workers]]);
+    }
+  }
+
+  to.numa_nodes.clear();
+  for (const auto& affinity : to.affinities) {
+    int affinity_node = -1;
+    for (size_t node = 0; !affinity.empty() && node < numa_nodes.size(); ++node) {
+      const auto& node_processors = numa_nodes[node];
+      if (std::all_of(affinity.begin(), affinity.end(), [&node_processors](int processor) {
+            return std::find(node_processors.begin(), node_processors.end(), processor) != node_processors.end();
+          })) {
+        affinity_node = static_cast<int>(node);
+        break;
+      }
+    }
+    to.numa_nodes.push_back(affinity_node);
+  }
+}
+
 static std::unique_ptr<ThreadPool>
 CreateThreadPoolHelper(Env* env, OrtThreadPoolParams options) {
   ThreadOptions to;
@@ -108,6 +146,15 @@ CreateThreadPoolHelper(Env* env, OrtThreadPoolParams options) {
     to.affinities.insert(to.affinities.begin(), LogicalProcessors{});
 #endif
   }
+  if (options.numa_aware && options.affinity_str.empty()) {
+    SetNumaAffinities(env->GetNumaNodes(), options.thread_pool_size, to);
+  }
+  if (options.heterogeneous_scheduling && to.affinities.empty()) {
+    auto default_affinities = env->GetDefaultThreadAffinities();
+    if (default_affinities.size() == static_cast<size_t>(options.thread_pool_size)) {
+      to.affinities = std::move(default_affinities);
+    }
+  }
 
   to.set_denormal_as_zero = options.set_denormal_as_zero;
   // set custom thread management members
@@ -115,6 +162,10 @@ CreateThreadPoolHelper(Env* env, OrtThreadPoolParams options) {
   to.custom_thread_creation_options = options.custom_thread_creation_options;
   to.custom_join_thread_fn = options.custom_join_thread_fn;
   to.dynamic_block_base_ = options.dynamic_block_base_;
+  to.parallel_for_calibration = options.parallel_for_calibration;
+  to.parallel_for_calibration_file = options.parallel_for_calibration_file;
+  to.heterogeneous_scheduling = options.heterogeneous_scheduling;
+  to.adaptive_spinning = options.adaptive_spinning;
   if (to.custom_create_thread_fn) {
     ORT_ENFORCE(to.custom_join_thread_fn, "custom join thread function not set");
   }
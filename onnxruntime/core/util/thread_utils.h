@@ -21,6 +21,10 @@ struct OrtThreadPoolParams {
   // If it is true, the thread pool will spin a while after the queue became empty.
   bool allow_spinning = true;
 
+  // If true, the spin window of idle threads follows the time between parallel sections,
+  // see ThreadOptions::adaptive_spinning.
+  bool adaptive_spinning = false;
+
   // It it is non-negative, thread pool will split a task by a decreasing block size
   // of remaining_of_total_iterations / (num_of_threads * dynamic_block_base_)
   int dynamic_block_base_ = 0;
@@ -42,6 +46,21 @@ struct OrtThreadPoolParams {
   // Set or unset denormal as zero
   bool set_denormal_as_zero = false;
 
+  // If it is true and affinity_str is empty, bind the threads to the NUMA nodes of the system in contiguous blocks,
+  // so that the tasks of a parallel loop run on the node of the calling thread when possible.
+  // It has no effect on a system with a single NUMA node.
+  bool numa_aware = false;
+
+  // If true, the partitioning of the parallel loops is calibrated from measurements,
+  // see ThreadOptions::parallel_for_calibration.
+  bool parallel_for_calibration = false;
+  std::basic_string<ORTCHAR_T> parallel_for_calibration_file;
+
+  // If true, adapt the parallel loops to CPUs with cores of different performance,
+  // see ThreadOptions::heterogeneous_scheduling. If no affinities are set, the threads are bound
+  // to one physical core each so that the workers on efficiency cores can be told apart.
+  bool heterogeneous_scheduling = false;
+
   // members to manage custom threads
   OrtCustomCreateThreadFn custom_create_thread_fn = nullptr;
   void* custom_thread_creation_options = nullptr;
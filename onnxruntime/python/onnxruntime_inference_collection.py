@@ -198,25 +198,67 @@ class Session:
                 f"Required inputs ({missing_input_names}) are missing from input feed ({feed_input_names})."
             )
 
-    def run(self, output_names, input_feed, run_options=None):
+    def run(self, output_names, input_feed, run_options=None, output_buffers=None):
         """
         Compute the predictions.
 
         :param output_names: name of the outputs
         :param input_feed: dictionary ``{ input_name: input_value }``
         :param run_options: See :class:`onnxruntime.RunOptions`.
+        :param output_buffers: optional dictionary ``{ output_name: buffer }`` of preallocated outputs.
+            Each buffer is a writeable C-contiguous numpy array of the output's type and shape or, in builds
+            with DLPack support, an object implementing ``__dlpack__`` such as a torch tensor on any device.
+            The outputs are written to these buffers, which are returned in place of a copy.
         :return: list of results, every result is either a numpy array,
             a sparse tensor, a list or a dictionary.
 
         ::
 
             sess.run([output_name], {input_name: x})
+            sess.run([output_name], {input_name: x}, output_buffers={output_name: y})
         """
         self._validate_input(list(input_feed.keys()))
         if not output_names:
             output_names = [output.name for output in self._outputs_meta]
-        try:
+
+        def invoke():
+            if output_buffers:
+                return self._sess.run_with_output_buffers(output_names, input_feed, output_buffers, run_options)
             return self._sess.run(output_names, input_feed, run_options)
+
+        try:
+            return invoke()
+        except C.EPFail as err:
+            if self._enable_fallback:
+                print(f"EP Error: {str(err)} using {self._providers}")
+                print(f"Falling back to {self._fallback_providers} and retrying.")
+                self.set_providers(self._fallback_providers)
+                # Fallback only once.
+                self.disable_fallback()
+                return invoke()
+            raise
+
+    def run_batch(self, output_names, input_feeds, run_options=None):
+        """
+        Compute the predictions for several independent requests at once. The runs are executed
+        concurrently on the session thread pool without holding the GIL, which amortizes the cost of
+        a python call over small requests.
+
+        :param output_names: name of the outputs
+        :param input_feeds: list of dictionaries ``{ input_name: input_value }``, one per run
+        :param run_options: See :class:`onnxruntime.RunOptions`.
+        :return: list with the list of results of each run, in the order of the feeds
+
+        ::
+
+            sess.run_batch([output_name], [{input_name: x0}, {input_name: x1}])
+        """
+        for input_feed in input_feeds:
+            self._validate_input(list(input_feed.keys()))
+        if not output_names:
+            output_names = [output.name for output in self._outputs_meta]
+        try:
+            return self._sess.run_batch(output_names, input_feeds, run_options)
         except C.EPFail as err:
             if self._enable_fallback:
                 print(f"EP Error: {str(err)} using {self._providers}")
@@ -224,7 +266,7 @@ class Session:
                 self.set_providers(self._fallback_providers)
                 # Fallback only once.
                 self.disable_fallback()
-                return self._sess.run(output_names, input_feed, run_options)
+                return self._sess.run_batch(output_names, input_feeds, run_options)
             raise
 
     def run_with_ort_values(self, output_names, input_dict_ort_values, run_options=None):
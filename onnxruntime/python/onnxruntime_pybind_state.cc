@@ -8,6 +8,7 @@
 #define NPY_NO_DEPRECATED_API NPY_1_7_API_VERSION
 #define PY_ARRAY_UNIQUE_SYMBOL onnxruntime_python_ARRAY_API
 #include <numpy/arrayobject.h>
+#include "python/numpy_helper.h"
 
 #include "core/common/inlined_containers.h"
 #include "core/common/logging/logging.h"
@@ -17,6 +18,7 @@
 #include "core/framework/arena_extend_strategy.h"
 #include "core/framework/data_transfer_utils.h"
 #include "core/framework/data_types_internal.h"
+#include "core/framework/error_code_helper.h"
 #include "core/framework/provider_options_utils.h"
 #include "core/framework/random_seed.h"
 #include "core/framework/sparse_tensor.h"
@@ -29,6 +31,7 @@
 #include "core/session/IOBinding.h"
 #include "core/session/abi_session_options_impl.h"
 #include "core/session/onnxruntime_session_options_config_keys.h"
+#include "core/session/ort_apis.h"
 #include "core/session/provider_bridge_ort.h"
 
 #ifdef ENABLE_ATEN
@@ -49,7 +52,9 @@ namespace onnxruntime {
 #pragma warning(disable : 4267 4996 4503 4003)
 #endif  // _MSC_VER
 
+#include <condition_variable>
 #include <iterator>
+#include <mutex>
 
 #if defined(_MSC_VER)
 #pragma warning(disable : 4267 4996 4503 4003)
@@ -610,6 +615,20 @@ std::unique_ptr<IExecutionProvider> CreateExecutionProviderInstance(
             } else {
               ORT_THROW("[ERROR] [TensorRT] The value for the key 'trt_cuda_graph_enable' should be 'True' or 'False'. Default value is 'False'.\n");
             }
+          } else if (option.first == "trt_async_engine_build_enable") {
+            if (option.second == "True" || option.second == "true") {
+              params.trt_async_engine_build_enable = true;
+            } else if (option.second == "False" || option.second == "false") {
+              params.trt_async_engine_build_enable = false;
+            } else {
+              ORT_THROW("[ERROR] [TensorRT] The value for the key 'trt_async_engine_build_enable' should be 'True' or 'False'. Default value is 'False'.\n");
+            }
+          } else if (option.first == "trt_profile_warmup_runs") {
+            if (!option.second.empty()) {
+              params.trt_profile_warmup_runs = std::stoi(option.second);
+            } else {
+              ORT_THROW("[ERROR] [TensorRT] The value for the key 'trt_profile_warmup_runs' should be a number i.e. '100'.\n");
+            }
           } else {
             ORT_THROW("Invalid TensorRT EP option: ", option.first);
           }
@@ -980,6 +999,128 @@ bool CheckIfTensor(const std::vector<const NodeArg*>& def_list,
 #if defined(USE_OPENVINO) || \
     defined(USE_CUDA) ||     \
     defined(USE_ROCM)
+// Converts the python feeds of InferenceSession.run to OrtValues
+static NameMLValMap CreateFeedsFromPyObjects(PyInferenceSession* sess, const std::map<std::string, py::object>& pyfeeds) {
+  // the input definitions are looked up once per run rather than once per feed, as that takes the session lock
+  auto px = sess->GetSessionHandle()->GetModelInputs();
+  if (!px.first.IsOK() || !px.second) {
+    throw std::runtime_error("Either failed to get model inputs from the session object or the input def list was null");
+  }
+
+  NameMLValMap feeds;
+  for (const auto& feed : pyfeeds) {
+    // No need to process 'None's sent in by the user
+    // to feed Optional inputs in the graph.
+    // We just won't include anything in the feed and ORT
+    // will handle such implicit 'None's internally.
+    if (!feed.second.is(py::none())) {
+      OrtValue ml_value;
+      CreateGenericMLValue(px.second, GetAllocator(), feed.first, feed.second, &ml_value);
+      ThrowIfPyErrOccured();
+      feeds.insert(std::make_pair(feed.first, ml_value));
+    }
+  }
+  return feeds;
+}
+
+namespace {
+
+// Runs of InferenceSession.run_batch that are still in flight on the session thread pool
+struct BatchRuns {
+  std::mutex mutex;
+  std::condition_variable all_done;
+  size_t pending = 0;
+};
+
+struct BatchRun {
+  BatchRuns* batch = nullptr;
+  std::vector<std::string> feed_names;
+  std::vector<OrtValue> feeds;
+  std::vector<OrtValue*> fetches;
+  Status status;
+};
+
+void OnBatchRunCompleted(void* user_data, OrtValue** /*outputs*/, size_t /*num_outputs*/, OrtStatusPtr status) {
+  auto* run = static_cast<BatchRun*>(user_data);
+  if (status != nullptr) {
+    run->status = ToStatus(status);
+    OrtApis::ReleaseStatus(status);
+  }
+  std::lock_guard<std::mutex> lock(run->batch->mutex);
+  if (--run->batch->pending == 0) {
+    run->batch->all_done.notify_one();
+  }
+}
+
+}  // namespace
+
+// Wraps a buffer preallocated by the caller for an output in an OrtValue that uses its memory
+static OrtValue CreateOutputFromBuffer(PyInferenceSession* sess, const std::string& name, const py::object& buffer) {
+  OrtValue ml_value;
+  if (PyArray_Check(buffer.ptr())) {
+    auto* darray = reinterpret_cast<PyArrayObject*>(buffer.ptr());
+    const int npy_type = PyArray_TYPE(darray);
+    if (!IsNumericNumpyType(npy_type) || !PyArray_ISCARRAY(darray)) {
+      throw std::runtime_error("The buffer of output '" + name +
+                               "' must be a writeable, aligned and C-contiguous numpy array of a numeric type.");
+    }
+    auto p_tensor = std::make_unique<Tensor>(NumpyTypeToOnnxRuntimeTensorType(npy_type),
+                                             GetShape(py::reinterpret_borrow<py::array>(buffer)),
+                                             PyArray_DATA(darray), GetAllocator()->Info());
+    auto ml_tensor = DataTypeImpl::GetType<Tensor>();
+    ml_value.Init(p_tensor.release(), ml_tensor, ml_tensor->GetDeleteFunc());
+    return ml_value;
+  }
+
+#ifdef ENABLE_TRAINING
+  if (py::hasattr(buffer, "__dlpack__")) {
+    auto px = sess->GetSessionHandle()->GetModelOutputs();
+    if (!px.first.IsOK() || !px.second) {
+      throw std::runtime_error("Either failed to get model outputs from the session object or the output def list was null");
+    }
+    // DLPack has no boolean type, so boolean outputs are exchanged as uint8
+    bool is_bool_tensor = false;
+    for (const auto* def : *px.second) {
+      if (def->Name() == name && def->TypeAsProto() != nullptr && def->TypeAsProto()->has_tensor_type()) {
+        is_bool_tensor = def->TypeAsProto()->tensor_type().elem_type() == ONNX_NAMESPACE::TensorProto_DataType_BOOL;
+      }
+    }
+    py::object capsule = buffer.attr("__dlpack__")();
+    return FromDlpack(capsule.ptr(), is_bool_tensor);
+  }
+  throw std::runtime_error("The buffer of output '" + name + "' must be a numpy array or implement __dlpack__.");
+#else
+  ORT_UNUSED_PARAMETER(sess);
+  throw std::runtime_error("The buffer of output '" + name + "' must be a numpy array.");
+#endif
+}
+
+// Converts the fetches of InferenceSession.run to python objects. The outputs written to a buffer of the caller,
+// if bound_buffers is not empty, are returned as that buffer.
+static std::vector<py::object> FetchesToPyObjects(const std::vector<OrtValue>& fetches,
+                                                  const std::vector<py::object>& bound_buffers) {
+  std::vector<py::object> rfetch;
+  rfetch.reserve(fetches.size());
+  size_t pos = 0;
+  for (const auto& fet : fetches) {
+    if (pos < bound_buffers.size() && bound_buffers[pos]) {
+      rfetch.push_back(bound_buffers[pos]);
+    } else if (fet.IsAllocated()) {
+      if (fet.IsTensor()) {
+        rfetch.push_back(AddTensorAsPyObj(fet, nullptr, nullptr));
+      } else if (fet.IsSparseTensor()) {
+        rfetch.push_back(GetPyObjectFromSparseTensor(pos, fet, nullptr));
+      } else {
+        rfetch.push_back(AddNonTensorAsPyObj(fet, nullptr, nullptr));
+      }
+    } else {  // Send back None because the corresponding OrtValue was empty
+      rfetch.push_back(py::none());
+    }
+    ++pos;
+  }
+  return rfetch;
+}
+
 static void LogDeprecationWarning(
     const std::string& deprecated, const optional<std::string>& alternative = nullopt) {
   LOGS_DEFAULT(WARNING) << "This is DEPRECATED and will be removed in the future: " << deprecated;
@@ -1198,6 +1339,10 @@ void addObjectMethods(py::module& m, ExecutionProviderRegistrationFn ep_registra
             ort_arena_cfg->initial_growth_chunk_size_bytes = kvp.second.cast<int>();
           } else if (key == "max_power_of_two_extend_bytes") {
             ort_arena_cfg->max_power_of_two_extend_bytes = kvp.second.cast<int>();
+          } else if (key == "max_thread_cache_bytes") {
+            ort_arena_cfg->max_thread_cache_bytes = kvp.second.cast<int64_t>();
+          } else if (key == "trim_window_ms") {
+            ort_arena_cfg->trim_window_ms = kvp.second.cast<int64_t>();
           } else {
             ORT_THROW("Invalid OrtArenaCfg option: ", key);
           }
@@ -1209,7 +1354,9 @@ void addObjectMethods(py::module& m, ExecutionProviderRegistrationFn ep_registra
       .def_readwrite("initial_chunk_size_bytes", &OrtArenaCfg::initial_chunk_size_bytes)
       .def_readwrite("max_dead_bytes_per_chunk", &OrtArenaCfg::max_dead_bytes_per_chunk)
       .def_readwrite("initial_growth_chunk_size_bytes", &OrtArenaCfg::initial_growth_chunk_size_bytes)
-      .def_readwrite("max_power_of_two_extend_bytes", &OrtArenaCfg::max_power_of_two_extend_bytes);
+      .def_readwrite("max_power_of_two_extend_bytes", &OrtArenaCfg::max_power_of_two_extend_bytes)
+      .def_readwrite("max_thread_cache_bytes", &OrtArenaCfg::max_thread_cache_bytes)
+      .def_readwrite("trim_window_ms", &OrtArenaCfg::trim_window_ms);
 
   py::class_<OrtMemoryInfo> ort_memory_info_binding(m, "OrtMemoryInfo");
   ort_memory_info_binding.def(py::init([](const char* name, OrtAllocatorType type, int id, OrtMemType mem_type) {
@@ -1627,23 +1774,7 @@ including arg name, arg type (contains both type and shape).)pbdoc")
            [](PyInferenceSession* sess, std::vector<std::string> output_names,
               std::map<std::string, py::object> pyfeeds, RunOptions* run_options = nullptr)
                -> std::vector<py::object> {
-             NameMLValMap feeds;
-             for (auto feed : pyfeeds) {
-               // No need to process 'None's sent in by the user
-               // to feed Optional inputs in the graph.
-               // We just won't include anything in the feed and ORT
-               // will handle such implicit 'None's internally.
-               if (!feed.second.is(py::none())) {
-                 OrtValue ml_value;
-                 auto px = sess->GetSessionHandle()->GetModelInputs();
-                 if (!px.first.IsOK() || !px.second) {
-                   throw std::runtime_error("Either failed to get model inputs from the session object or the input def list was null");
-                 }
-                 CreateGenericMLValue(px.second, GetAllocator(), feed.first, feed.second, &ml_value);
-                 ThrowIfPyErrOccured();
-                 feeds.insert(std::make_pair(feed.first, ml_value));
-               }
-             }
+             NameMLValMap feeds = CreateFeedsFromPyObjects(sess, pyfeeds);
 
              std::vector<OrtValue> fetches;
              common::Status status;
@@ -1658,24 +1789,116 @@ including arg name, arg type (contains both type and shape).)pbdoc")
                }
              }
 
-             std::vector<py::object> rfetch;
-             rfetch.reserve(fetches.size());
-             size_t pos = 0;
-             for (auto fet : fetches) {
-               if (fet.IsAllocated()) {
-                 if (fet.IsTensor()) {
-                   rfetch.push_back(AddTensorAsPyObj(fet, nullptr, nullptr));
-                 } else if (fet.IsSparseTensor()) {
-                   rfetch.push_back(GetPyObjectFromSparseTensor(pos, fet, nullptr));
-                 } else {
-                   rfetch.push_back(AddNonTensorAsPyObj(fet, nullptr, nullptr));
+             return FetchesToPyObjects(fetches, {});
+           })
+      /// This method runs the model once for each dictionary of feeds in a list and returns the list of the
+      /// outputs of each run. The runs are executed concurrently on the session thread pool, with the GIL released,
+      /// so that many small requests cost a single call from python.
+      .def("run_batch",
+           [](PyInferenceSession* sess, std::vector<std::string> output_names,
+              std::vector<std::map<std::string, py::object>> pyfeeds_list, RunOptions* run_options = nullptr)
+               -> std::vector<std::vector<py::object>> {
+             BatchRuns batch;
+             std::vector<BatchRun> runs(pyfeeds_list.size());
+             for (size_t r = 0; r < runs.size(); ++r) {
+               NameMLValMap feeds = CreateFeedsFromPyObjects(sess, pyfeeds_list[r]);
+               runs[r].batch = &batch;
+               for (auto& feed : feeds) {
+                 runs[r].feed_names.push_back(feed.first);
+                 runs[r].feeds.push_back(std::move(feed.second));
+               }
+               runs[r].fetches.resize(output_names.size(), nullptr);
+             }
+
+             {
+               // release GIL to allow the runs and other python threads to proceed in parallel.
+               py::gil_scoped_release release;
+               InferenceSession* session = sess->GetSessionHandle();
+
+               // The first run executes on this thread. The others are scheduled on the session thread pool,
+               // or run here too if the session has no worker thread.
+               for (size_t r = 1; r < runs.size(); ++r) {
+                 {
+                   std::lock_guard<std::mutex> lock(batch.mutex);
+                   ++batch.pending;
+                 }
+                 Status status = session->RunAsync(run_options, runs[r].feed_names, runs[r].feeds, output_names,
+                                                   runs[r].fetches, OnBatchRunCompleted, &runs[r]);
+                 if (!status.IsOK()) {
+                   {
+                     std::lock_guard<std::mutex> lock(batch.mutex);
+                     --batch.pending;
+                   }
+                   std::vector<OrtValue> fetches;
+                   runs[r].status = session->Run(run_options != nullptr ? *run_options : RunOptions(),
+                                                 runs[r].feed_names, runs[r].feeds, output_names, &fetches, nullptr);
+                   for (size_t i = 0; i < fetches.size() && runs[r].status.IsOK(); ++i) {
+                     runs[r].fetches[i] = new OrtValue(std::move(fetches[i]));
+                   }
+                 }
+               }
+
+               if (!runs.empty()) {
+                 std::vector<OrtValue> fetches;
+                 runs[0].status = session->Run(run_options != nullptr ? *run_options : RunOptions(),
+                                               runs[0].feed_names, runs[0].feeds, output_names, &fetches, nullptr);
+                 for (size_t i = 0; i < fetches.size() && runs[0].status.IsOK(); ++i) {
+                   runs[0].fetches[i] = new OrtValue(std::move(fetches[i]));
                  }
-               } else {  // Send back None because the corresponding OrtValue was empty
-                 rfetch.push_back(py::none());
                }
-               ++pos;
+
+               std::unique_lock<std::mutex> lock(batch.mutex);
+               batch.all_done.wait(lock, [&batch]() { return batch.pending == 0; });
+             }
+
+             std::vector<std::vector<py::object>> results;
+             results.reserve(runs.size());
+             Status first_error;
+             for (auto& run : runs) {
+               std::vector<OrtValue> fetches;
+               fetches.reserve(run.fetches.size());
+               for (OrtValue*& fetch : run.fetches) {
+                 std::unique_ptr<OrtValue> owned(fetch);
+                 fetches.push_back(owned ? std::move(*owned) : OrtValue());
+                 fetch = nullptr;
+               }
+               if (!run.status.IsOK() && first_error.IsOK()) {
+                 first_error = run.status;
+               }
+               results.push_back(FetchesToPyObjects(fetches, {}));
+             }
+             OrtPybindThrowIfError(first_error);
+             return results;
+           })
+      /// This method runs the model with some of its outputs written to buffers the caller preallocated:
+      /// writeable C-contiguous numpy arrays, or in builds with DLPack support, objects implementing __dlpack__
+      /// such as torch tensors, which may live on a device. These buffers are returned as the outputs, so those
+      /// outputs are not copied.
+      .def("run_with_output_buffers",
+           [](PyInferenceSession* sess, std::vector<std::string> output_names,
+              std::map<std::string, py::object> pyfeeds, std::map<std::string, py::object> output_buffers,
+              RunOptions* run_options = nullptr) -> std::vector<py::object> {
+             NameMLValMap feeds = CreateFeedsFromPyObjects(sess, pyfeeds);
+
+             std::vector<OrtValue> fetches(output_names.size());
+             std::vector<py::object> bound_buffers(output_names.size());
+             for (size_t i = 0; i < output_names.size(); ++i) {
+               auto it = output_buffers.find(output_names[i]);
+               if (it != output_buffers.end() && !it->second.is(py::none())) {
+                 fetches[i] = CreateOutputFromBuffer(sess, output_names[i], it->second);
+                 bound_buffers[i] = it->second;
+               }
              }
-             return rfetch;
+
+             {
+               // release GIL to allow multiple python threads to invoke Run() in parallel.
+               py::gil_scoped_release release;
+               RunOptions default_run_options;
+               OrtPybindThrowIfError(sess->GetSessionHandle()->Run(
+                   run_options != nullptr ? *run_options : default_run_options, feeds, output_names, &fetches));
+             }
+
+             return FetchesToPyObjects(fetches, bound_buffers);
            })
       /// This method accepts a dictionary of feeds (name -> OrtValue) and the list of output_names
       /// and returns a list of python objects representing OrtValues. Each name may represent either
@@ -0,0 +1,325 @@
+# Copyright (c) Microsoft Corporation. All rights reserved.
+# Licensed under the MIT License.
+
+"""
+Pipeline parallel inference of models too large for one GPU.
+
+The model is split into stages of consecutive nodes with about the same size of weights. Each stage runs in its own
+InferenceSession with the CUDA execution provider on its own device. A batch is split into micro batches that flow
+through the stages concurrently, so that all the devices are busy once the pipeline is full. The values passed between
+the stages stay on the devices, and are copied from the device of a stage to the device of the next one by the CUDA
+execution provider, peer to peer when the devices support it.
+
+Split a model into 4 stages:
+    python -m onnxruntime.tools.pipeline_parallel --num_stages 4 model.onnx output_dir
+
+Run the stages on the devices 0 to 3:
+    session = PipelineSession([f"output_dir/stage_{i}.onnx" for i in range(4)], device_ids=[0, 1, 2, 3])
+    outputs = session.run(None, {"input_ids": input_ids}, num_micro_batches=8)
+"""
+
+import argparse
+import json
+import os
+import queue
+import threading
+from typing import Any, Dict, List, Optional, Sequence, Set, Union
+
+import numpy as np
+import onnx
+
+_STAGE_KEY = "pipeline_stage"
+_OUTPUTS_KEY = "pipeline_outputs"
+
+
+def _subgraph_outer_scope_inputs(graph: onnx.GraphProto) -> Set[str]:
+    """Returns the values that the nodes of a subgraph use from the outer scope."""
+    defined = {value.name for value in graph.input} | {tensor.name for tensor in graph.initializer}
+    used = set()
+    for node in graph.node:
+        used.update(_node_inputs(node))
+        defined.update(node.output)
+    return used - defined
+
+
+def _node_inputs(node: onnx.NodeProto) -> Set[str]:
+    """Returns the inputs of a node, including the values used by its subgraphs from the outer scope."""
+    inputs = {name for name in node.input if name}
+    for attr in node.attribute:
+        if attr.type == onnx.AttributeProto.GRAPH:
+            inputs.update(_subgraph_outer_scope_inputs(attr.g))
+        elif attr.type == onnx.AttributeProto.GRAPHS:
+            for graph in attr.graphs:
+                inputs.update(_subgraph_outer_scope_inputs(graph))
+    return inputs
+
+
+def _tensor_size_in_bytes(tensor: onnx.TensorProto) -> int:
+    itemsize = onnx.helper.tensor_dtype_to_np_dtype(tensor.data_type).itemsize
+    return int(np.prod(tensor.dims, dtype=np.int64)) * itemsize
+
+
+class _MissingValueInfoError(ValueError):
+    pass
+
+
+def split_model(model: onnx.ModelProto, num_stages: int) -> List[onnx.ModelProto]:
+    """Splits a model into pipeline stages of consecutive nodes with about the same size of weights.
+
+    The inputs of a stage are the model inputs and the values of the previous stages that it uses, and its outputs
+    are the model outputs and the values used by the next stages that it computes. The initializers used by several
+    stages are copied to each of them.
+    """
+    try:
+        return _split_model(model, num_stages)
+    except _MissingValueInfoError:
+        # infer the types of the values passed between the stages
+        return _split_model(onnx.shape_inference.infer_shapes(model), num_stages)
+
+
+def _split_model(model: onnx.ModelProto, num_stages: int) -> List[onnx.ModelProto]:
+    if num_stages < 1:
+        raise ValueError(f"num_stages must be at least 1, got {num_stages}")
+
+    graph = model.graph
+    nodes = list(graph.node)
+    if len(nodes) < num_stages:
+        raise ValueError(f"The model has {len(nodes)} nodes, which cannot be split into {num_stages} stages")
+
+    initializers = {tensor.name: tensor for tensor in graph.initializer}
+    node_inputs = [_node_inputs(node) for node in nodes]
+
+    # the nodes are assigned to the stages in their topological order, cutting when a stage has its share of weights
+    node_weights = [
+        sum(_tensor_size_in_bytes(initializers[name]) for name in inputs if name in initializers)
+        for inputs in node_inputs
+    ]
+    stage_weights = sum(node_weights) / num_stages
+    stage_of_node = []
+    stage = 0
+    cumulative_weights = 0
+    for i, weights in enumerate(node_weights):
+        # keep at least one node for each of the remaining stages
+        remaining_nodes = len(nodes) - i
+        if stage < num_stages - 1 and (
+            remaining_nodes == num_stages - 1 - stage
+            or (cumulative_weights >= stage_weights * (stage + 1) and stage_of_node and stage_of_node[-1] == stage)
+        ):
+            stage += 1
+        stage_of_node.append(stage)
+        cumulative_weights += weights
+
+    # the types of the values that cross the stages
+    value_infos = {value.name: value for value in graph.value_info}
+    value_infos.update({value.name: value for value in graph.input})
+    value_infos.update({value.name: value for value in graph.output})
+
+    def get_value_info(name: str) -> onnx.ValueInfoProto:
+        if name not in value_infos:
+            raise _MissingValueInfoError(
+                f"{name} is passed between stages but has no type information. "
+                "Run shape inference on the model before splitting it."
+            )
+        return value_infos[name]
+
+    graph_inputs = [value.name for value in graph.input if value.name not in initializers]
+    graph_outputs = [value.name for value in graph.output]
+    last_stage_using = {}
+    for i, inputs in enumerate(node_inputs):
+        for name in inputs:
+            last_stage_using[name] = stage_of_node[i]
+
+    stages = []
+    for stage in range(num_stages):
+        stage_node_indices = [i for i in range(len(nodes)) if stage_of_node[i] == stage]
+        stage_nodes = [nodes[i] for i in stage_node_indices]
+        produced = {name for node in stage_nodes for name in node.output if name}
+        used = set().union(*[node_inputs[i] for i in stage_node_indices])
+
+        inputs = [name for name in graph_inputs if name in used]
+        inputs += sorted(used - produced - set(initializers) - set(graph_inputs))
+        outputs = [name for name in graph_outputs if name in produced]
+        outputs += sorted(
+            name for name in produced if last_stage_using.get(name, -1) > stage and name not in graph_outputs
+        )
+
+        stage_graph = onnx.helper.make_graph(
+            stage_nodes,
+            f"{graph.name}_stage_{stage}",
+            [get_value_info(name) for name in inputs],
+            [get_value_info(name) for name in outputs],
+            [initializers[name] for name in sorted(used & set(initializers))],
+            value_info=[value for name, value in value_infos.items() if name in produced and name not in outputs],
+        )
+        stage_model = onnx.helper.make_model(
+            stage_graph, opset_imports=model.opset_import, producer_name=model.producer_name
+        )
+        stage_model.ir_version = model.ir_version
+        stage_model.functions.extend(model.functions)
+        onnx.helper.set_model_props(stage_model, {_STAGE_KEY: str(stage), _OUTPUTS_KEY: json.dumps(graph_outputs)})
+        stages.append(stage_model)
+
+    return stages
+
+
+class PipelineSession:
+    """Runs the stages of a model split by split_model, one per device, with micro batch pipelining."""
+
+    def __init__(
+        self,
+        stages: Sequence[Union[str, bytes, os.PathLike]],
+        device_ids: Optional[Sequence[int]] = None,
+        sess_options=None,
+        provider_options: Optional[Dict[str, Any]] = None,
+    ):
+        """
+        :param stages: The paths or serialized models of the stages, in order.
+        :param device_ids: The CUDA device of each stage. The default is the device i for the stage i.
+        :param sess_options: The session options of the sessions of the stages.
+        :param provider_options: The CUDA execution provider options of the stages, other than the device id.
+        """
+        import onnxruntime
+
+        self._device_ids = list(device_ids) if device_ids is not None else list(range(len(stages)))
+        if len(self._device_ids) != len(stages):
+            raise ValueError(f"{len(stages)} stages but {len(self._device_ids)} device ids")
+
+        self._sessions = []
+        for stage, device_id in zip(stages, self._device_ids):
+            cuda_options = dict(provider_options or {})
+            cuda_options["device_id"] = device_id
+            self._sessions.append(
+                onnxruntime.InferenceSession(
+                    stage,
+                    sess_options,
+                    providers=[("CUDAExecutionProvider", cuda_options), "CPUExecutionProvider"],
+                )
+            )
+
+        metadata = [session.get_modelmeta().custom_metadata_map for session in self._sessions]
+        if any(int(props.get(_STAGE_KEY, -1)) != i for i, props in enumerate(metadata)):
+            raise ValueError("The stages are not the stages of split_model in order")
+        self._model_outputs = json.loads(metadata[0][_OUTPUTS_KEY])
+
+        # the values computed by the stages or fed to the model that the later stages use
+        self._stage_inputs = [[value.name for value in session.get_inputs()] for session in self._sessions]
+        self._stage_outputs = [[value.name for value in session.get_outputs()] for session in self._sessions]
+
+    def get_outputs(self) -> List[str]:
+        return list(self._model_outputs)
+
+    def run(
+        self,
+        output_names: Optional[Sequence[str]],
+        input_feed: Dict[str, np.ndarray],
+        num_micro_batches: Optional[int] = None,
+        unbatched_inputs: Sequence[str] = (),
+    ) -> List[np.ndarray]:
+        """Runs the model on a batch, split along the first axis into micro batches.
+
+        :param output_names: The names of the outputs to return. The default is all the outputs.
+        :param input_feed: The inputs of the model.
+        :param num_micro_batches: The number of micro batches. The default is the number of stages.
+        :param unbatched_inputs: The inputs without a batch axis, which are fed as is to each micro batch.
+        """
+        output_names = list(output_names) if output_names else self.get_outputs()
+        num_micro_batches = num_micro_batches or len(self._sessions)
+
+        batched = {name: value for name, value in input_feed.items() if name not in unbatched_inputs}
+        batch_sizes = {value.shape[0] for value in batched.values()}
+        if len(batch_sizes) > 1:
+            raise ValueError(f"The batched inputs have different batch sizes: {sorted(batch_sizes)}")
+        batch_size = batch_sizes.pop() if batch_sizes else 1
+        num_micro_batches = max(1, min(num_micro_batches, batch_size))
+
+        micro_batches = [{} for _ in range(num_micro_batches)]
+        for name, value in batched.items():
+            for i, part in enumerate(np.array_split(value, num_micro_batches)):
+                micro_batches[i][name] = part
+        for name in unbatched_inputs:
+            for micro_batch in micro_batches:
+                micro_batch[name] = input_feed[name]
+
+        # a thread per stage, connected by queues of the values of the micro batches; None ends a stage
+        queues = [queue.Queue() for _ in range(len(self._sessions) + 1)]
+        errors = []
+
+        def run_stage(stage: int):
+            session = self._sessions[stage]
+            needed_later = set(output_names).union(*self._stage_inputs[stage + 1 :])
+            try:
+                while True:
+                    values = queues[stage].get()
+                    if values is None:
+                        break
+                    io_binding = session.io_binding()
+                    for name in self._stage_inputs[stage]:
+                        value = values[name]
+                        if isinstance(value, np.ndarray):
+                            io_binding.bind_cpu_input(name, value)
+                        else:
+                            io_binding.bind_ortvalue_input(name, value)
+                    # the outputs stay on the device of the stage until the next stage copies them
+                    for name in self._stage_outputs[stage]:
+                        io_binding.bind_output(name, "cuda", self._device_ids[stage])
+                    session.run_with_iobinding(io_binding)
+                    values.update(zip(self._stage_outputs[stage], io_binding.get_outputs()))
+                    queues[stage + 1].put({name: value for name, value in values.items() if name in needed_later})
+            except Exception as e:
+                errors.append(e)
+                # drain the micro batches of the previous stage so that it does not block
+                while queues[stage].get() is not None:
+                    pass
+            finally:
+                queues[stage + 1].put(None)
+
+        threads = [threading.Thread(target=run_stage, args=(stage,)) for stage in range(len(self._sessions))]
+        for thread in threads:
+            thread.start()
+        for micro_batch in micro_batches:
+            queues[0].put(micro_batch)
+        queues[0].put(None)
+
+        results = []
+        while True:
+            values = queues[-1].get()
+            if values is None:
+                break
+            results.append(values)
+        for thread in threads:
+            thread.join()
+        if errors:
+            raise errors[0]
+
+        def to_numpy(value):
+            return value if isinstance(value, np.ndarray) else value.numpy()
+
+        return [np.concatenate([to_numpy(values[name]) for values in results]) for name in output_names]
+
+
+def parse_args():
+    parser = argparse.ArgumentParser(description="Split a model into pipeline parallel stages.")
+    parser.add_argument("--num_stages", type=int, required=True, help="Number of stages, one per device.")
+    parser.add_argument("input_onnx", help="Path of the model.")
+    parser.add_argument("output_dir", help="Directory of the stages, saved as stage_<i>.onnx.")
+    return parser.parse_args()
+
+
+def main():
+    args = parse_args()
+    stages = split_model(onnx.load_model(args.input_onnx), args.num_stages)
+    os.makedirs(args.output_dir, exist_ok=True)
+    for i, stage in enumerate(stages):
+        # the weights are saved as external data, as a stage can exceed the 2GB limit of protobuf
+        onnx.save_model(
+            stage,
+            os.path.join(args.output_dir, f"stage_{i}.onnx"),
+            save_as_external_data=True,
+            all_tensors_to_one_file=True,
+            location=f"stage_{i}.onnx.data",
+            size_threshold=1024,
+        )
+
+
+if __name__ == "__main__":
+    main()
@@ -3,6 +3,7 @@
 
 #include "core/common/logging/capture.h"
 #include "core/common/logging/logging.h"
+#include "core/common/logging/sinks/async_sink.h"
 #include "core/common/logging/sinks/cerr_sink.h"
 #include "core/common/logging/sinks/clog_sink.h"
 #include "core/common/logging/sinks/composite_sink.h"
@@ -163,3 +164,53 @@ TEST(LoggingTests, TestCompositeSink) {
 
   LOGS_CATEGORY(*logger, WARNING, "ArbitraryCategory") << "Warning";
 }
+
+/// <summary>
+/// Tests that the async sink writes all the messages to the wrapped sink.
+/// </summary>
+TEST(LoggingTests, TestAsyncSink) {
+  const std::string logid{"TestAsyncSink"};
+  const Severity min_log_level = Severity::kWARNING;
+
+  MockSink* sink_ptr = new MockSink();
+  EXPECT_CALL(*sink_ptr,
+              SendImpl(testing::_, logid, testing::Property(&Capture::Message, testing::StartsWith("Warning"))))
+      .Times(3);
+
+  {
+    LoggingManager manager{std::make_unique<AsyncSink>(std::unique_ptr<ISink>{sink_ptr}), min_log_level, false,
+                           InstanceType::Temporal};
+
+    auto logger = manager.CreateLogger(logid);
+
+    for (int i = 0; i < 3; ++i) {
+      LOGS(*logger, WARNING) << "Warning " << i;
+    }
+  }
+}
+
+/// <summary>
+/// Tests that the async sink suppresses the messages of a call site that exceed its rate limit, and reports them.
+/// </summary>
+TEST(LoggingTests, TestAsyncSinkRateLimit) {
+  const std::string logid{"TestAsyncSinkRateLimit"};
+  const Severity min_log_level = Severity::kWARNING;
+
+  MockSink* sink_ptr = new MockSink();
+  EXPECT_CALL(*sink_ptr, SendImpl(testing::_, logid, testing::_)).Times(2);
+  // the suppressed messages are reported once the buffer drains, which may happen more than once
+  EXPECT_CALL(*sink_ptr, SendImpl(testing::_, "AsyncSink",
+                                  testing::Property(&Capture::Message, testing::HasSubstr("exceeded the rate limit"))))
+      .Times(testing::Between(1, 3));
+
+  {
+    LoggingManager manager{std::make_unique<AsyncSink>(std::unique_ptr<ISink>{sink_ptr}, 16, 2, std::chrono::hours(1)),
+                           min_log_level, false, InstanceType::Temporal};
+
+    auto logger = manager.CreateLogger(logid);
+
+    for (int i = 0; i < 5; ++i) {
+      LOGS(*logger, WARNING) << "Warning " << i;
+    }
+  }
+}
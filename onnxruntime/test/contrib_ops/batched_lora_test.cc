@@ -0,0 +1,122 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "test/common/cuda_op_test_utils.h"
+#include "test/common/tensor_op_test_utils.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+#if defined(USE_CUDA)
+
+static void RunBatchedLoRATest(int64_t batch_size, int64_t sequence_length, int64_t input_size, int64_t output_size,
+                               int64_t rank, int64_t num_adapters, const std::vector<int32_t>& adapter_indices,
+                               bool use_float16) {
+  std::vector<float> input(batch_size * sequence_length * input_size);
+  std::vector<float> base_output(batch_size * sequence_length * output_size);
+  std::vector<float> lora_a(num_adapters * rank * input_size);
+  std::vector<float> lora_b(num_adapters * output_size * rank);
+  for (size_t i = 0; i < input.size(); ++i) {
+    input[i] = static_cast<float>(static_cast<int>(i % 13) - 6) * 0.1f;
+  }
+  for (size_t i = 0; i < base_output.size(); ++i) {
+    base_output[i] = static_cast<float>(static_cast<int>(i % 7) - 3) * 0.25f;
+  }
+  for (size_t i = 0; i < lora_a.size(); ++i) {
+    lora_a[i] = static_cast<float>(static_cast<int>((i * 5) % 11) - 5) * 0.05f;
+  }
+  for (size_t i = 0; i < lora_b.size(); ++i) {
+    lora_b[i] = static_cast<float>(static_cast<int>((i * 3) % 17) - 8) * 0.02f;
+  }
+
+  std::vector<float> output(base_output);
+  for (int64_t b = 0; b < batch_size; ++b) {
+    const int64_t adapter = adapter_indices[b];
+    if (adapter < 0 || adapter >= num_adapters) {
+      continue;
+    }
+    for (int64_t s = 0; s < sequence_length; ++s) {
+      const int64_t token = b * sequence_length + s;
+      std::vector<float> shrunk(rank, 0.0f);
+      for (int64_t j = 0; j < rank; ++j) {
+        for (int64_t k = 0; k < input_size; ++k) {
+          shrunk[j] += input[token * input_size + k] * lora_a[(adapter * rank + j) * input_size + k];
+        }
+      }
+      for (int64_t n = 0; n < output_size; ++n) {
+        for (int64_t j = 0; j < rank; ++j) {
+          output[token * output_size + n] += shrunk[j] * lora_b[(adapter * output_size + n) * rank + j];
+        }
+      }
+    }
+  }
+
+  OpTester test("BatchedLoRA", 1, onnxruntime::kMSDomain);
+  if (use_float16) {
+    test.AddInput<MLFloat16>("input", {batch_size, sequence_length, input_size}, ToFloat16(input));
+    test.AddInput<MLFloat16>("base_output", {batch_size, sequence_length, output_size}, ToFloat16(base_output));
+    test.AddInput<MLFloat16>("lora_a", {num_adapters, rank, input_size}, ToFloat16(lora_a));
+    test.AddInput<MLFloat16>("lora_b", {num_adapters, output_size, rank}, ToFloat16(lora_b));
+  } else {
+    test.AddInput<float>("input", {batch_size, sequence_length, input_size}, input);
+    test.AddInput<float>("base_output", {batch_size, sequence_length, output_size}, base_output);
+    test.AddInput<float>("lora_a", {num_adapters, rank, input_size}, lora_a);
+    test.AddInput<float>("lora_b", {num_adapters, output_size, rank}, lora_b);
+  }
+  test.AddInput<int32_t>("adapter_indices", {batch_size}, adapter_indices);
+  if (use_float16) {
+    test.AddOutput<MLFloat16>("output", {batch_size, sequence_length, output_size}, ToFloat16(output));
+    test.SetOutputAbsErr("output", 0.01f);
+  } else {
+    test.AddOutput<float>("output", {batch_size, sequence_length, output_size}, output);
+    test.SetOutputAbsErr("output", 0.0005f);
+  }
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCudaExecutionProvider());
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+
+TEST(BatchedLoRATest, Decoding) {
+  RunBatchedLoRATest(4, 1, 96, 80, 8, 3, {2, 0, 2, 1}, false);
+  RunBatchedLoRATest(4, 1, 96, 80, 16, 3, {1, -1, 0, 1}, true);
+}
+
+TEST(BatchedLoRATest, Prompt) {
+  RunBatchedLoRATest(3, 13, 64, 300, 8, 2, {1, -1, 1}, false);
+  RunBatchedLoRATest(2, 20, 64, 48, 4, 4, {3, 0}, true);
+}
+
+TEST(BatchedLoRATest, NoAdapter) {
+  RunBatchedLoRATest(2, 5, 32, 16, 8, 1, {-1, -1}, false);
+}
+
+TEST(BatchedLoRATest, OutOfRangeIndex) {
+  RunBatchedLoRATest(4, 3, 32, 16, 8, 2, {2, -2, 1, 100}, false);
+  RunBatchedLoRATest(2, 1, 32, 16, 4, 1, {1, 0}, true);
+}
+
+TEST(BatchedLoRATest, RankExceedsSharedMemory) {
+  OpTester test("BatchedLoRA", 1, onnxruntime::kMSDomain);
+  constexpr int64_t rank = 1 << 16;
+  test.AddInput<float>("input", {1, 1, 1}, {1.0f});
+  test.AddInput<float>("base_output", {1, 1, 1}, {0.0f});
+  test.AddInput<float>("lora_a", {1, rank, 1}, std::vector<float>(rank, 0.0f));
+  test.AddInput<float>("lora_b", {1, 1, rank}, std::vector<float>(rank, 0.0f));
+  test.AddInput<int32_t>("adapter_indices", {1}, {0});
+  test.AddOutput<float>("output", {1, 1, 1}, {0.0f});
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCudaExecutionProvider());
+  test.Run(OpTester::ExpectResult::kExpectFailure, "exceeds the shared memory of the device", {}, nullptr,
+           &execution_providers);
+}
+
+#endif
+
+}  // namespace test
+}  // namespace onnxruntime
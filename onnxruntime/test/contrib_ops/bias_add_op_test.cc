@@ -13,7 +13,6 @@ using namespace onnxruntime::test;
 namespace onnxruntime {
 namespace test {
 
-#if defined(USE_CUDA) || defined(USE_ROCM) || defined(USE_DML)
 static std::vector<float> GetExpectedResult(const std::vector<float>& input_data,
                                             const std::vector<float>& bias_data,
                                             const std::vector<float>& skip_data) {
@@ -27,21 +26,22 @@ static std::vector<float> GetExpectedResult(const std::vector<float>& input_data
   return output_data;
 }
 
-static void RunSkipBiasGpuTest(const std::vector<float>& input_data,
-                               const std::vector<float>& bias_data,
-                               const std::vector<float>& skip_data,
-                               const std::vector<float>& output_data,
-                               const std::vector<int64_t>& input_dims,
-                               const std::vector<int64_t>& bias_dims,
-                               const std::vector<int64_t>& skip_dims,
-                               const std::vector<int64_t>& output_dims,
-                               bool use_float16 = false) {
+static void RunSkipBiasOpTest(const std::vector<float>& input_data,
+                              const std::vector<float>& bias_data,
+                              const std::vector<float>& skip_data,
+                              const std::vector<float>& output_data,
+                              const std::vector<int64_t>& input_dims,
+                              const std::vector<int64_t>& bias_dims,
+                              const std::vector<int64_t>& skip_dims,
+                              const std::vector<int64_t>& output_dims,
+                              bool use_float16 = false) {
   int min_cuda_architecture = use_float16 ? 530 : 0;
   bool enable_cuda = HasCudaEnvironment(min_cuda_architecture);
   bool enable_rocm = (nullptr != DefaultRocmExecutionProvider().get());
   bool enable_dml = (nullptr != DefaultDmlExecutionProvider().get());
+  bool enable_cpu = !use_float16;
 
-  if (!enable_cuda && !enable_rocm && !enable_dml) {
+  if (!enable_cuda && !enable_rocm && !enable_dml && !enable_cpu) {
     return;
   }
 
@@ -69,6 +69,9 @@ static void RunSkipBiasGpuTest(const std::vector<float>& input_data,
   if (enable_dml) {
     execution_providers.push_back(DefaultDmlExecutionProvider());
   }
+  if (enable_cpu) {
+    execution_providers.push_back(DefaultCpuExecutionProvider());
+  }
   tester.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
 }
 
@@ -84,7 +87,7 @@ static void RunBiasAddTest(int64_t batch_size, int64_t image_size, int64_t num_c
   std::vector<float> skip_data = random.Gaussian<float>(skip_dims, 0.0f, 0.3f);
   std::vector<float> output_data = GetExpectedResult(input_data, bias_data, skip_data);
 
-  RunSkipBiasGpuTest(input_data, bias_data, skip_data, output_data, input_dims, bias_dims, skip_dims, output_dims);
+  RunSkipBiasOpTest(input_data, bias_data, skip_data, output_data, input_dims, bias_dims, skip_dims, output_dims);
 }
 
 TEST(BiasAddTest, BiasAddTest_HiddenSize_320) {
@@ -107,7 +110,6 @@ TEST(BiasAddTest, BiasAddTest_HiddenSize_1280) {
   constexpr int64_t num_channels = 1280;
   RunBiasAddTest(batch_size, image_size, num_channels);
 }
-#endif
 
 }  // namespace test
 }  // namespace onnxruntime
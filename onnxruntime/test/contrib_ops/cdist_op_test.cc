@@ -1,6 +1,10 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <cmath>
+#include <string>
+#include <vector>
+
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
 
@@ -69,5 +73,44 @@ TEST(CDistOpTest, DoubleEuclidean) {
   test.Run();
 }
 
+// large enough for the norms and the final pass to be split between threads, and in double to cover the GEMM of
+// the platforms without a double GEMM in MLAS
+TEST(CDistOpTest, DoubleLarge) {
+  constexpr int64_t m = 67;
+  constexpr int64_t n = 53;
+  constexpr int64_t k = 31;
+  std::vector<double> a(m * k);
+  std::vector<double> b(n * k);
+  for (size_t i = 0; i < a.size(); ++i) {
+    a[i] = static_cast<double>(static_cast<int64_t>((i * 7) % 23) - 11) * 0.125;
+  }
+  for (size_t i = 0; i < b.size(); ++i) {
+    b[i] = static_cast<double>(static_cast<int64_t>((i * 5) % 19) - 9) * 0.25;
+  }
+
+  std::vector<double> sqeuclidean(m * n);
+  std::vector<double> euclidean(m * n);
+  for (int64_t i = 0; i < m; ++i) {
+    for (int64_t j = 0; j < n; ++j) {
+      double sum = 0.0;
+      for (int64_t l = 0; l < k; ++l) {
+        const double diff = a[i * k + l] - b[j * k + l];
+        sum += diff * diff;
+      }
+      sqeuclidean[i * n + j] = sum;
+      euclidean[i * n + j] = std::sqrt(sum);
+    }
+  }
+
+  for (const char* metric : {"sqeuclidean", "euclidean"}) {
+    OpTester test("CDist", 1, onnxruntime::kMSDomain);
+    test.AddAttribute("metric", metric);
+    test.AddInput<double>("A", {m, k}, a);
+    test.AddInput<double>("B", {n, k}, b);
+    test.AddOutput<double>("y", {m, n}, std::string(metric) == "euclidean" ? euclidean : sqeuclidean);
+    test.Run();
+  }
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -4,6 +4,7 @@
 #include "core/common/span_utils.h"
 #include "core/framework/tensor.h"
 #include "core/session/inference_session.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 #include "test/common/tensor_op_test_utils.h"
 #include "test/framework/test_utils.h"
 #include "test/optimizer/graph_transform_test_builder.h"
@@ -205,5 +206,130 @@ TEST(DynamicQuantizeMatMul, B_PerColumn_ND) {
   test_case({15, 14, 13}, {15, 13, 27}, {15, 1, 27});
 }
 
+TEST(DynamicQuantizeMatMul, PerRowScale) {
+  // rows of very different ranges, which a scale for the whole tensor would quantize coarsely
+  constexpr int64_t M = 4;
+  constexpr int64_t K = 96;
+  constexpr int64_t N = 40;
+  const float row_ranges[M] = {1.0f, 0.01f, 8.0f, 0.25f};
+
+  RandomValueGenerator random{};
+  std::vector<float> A_data = random.Uniform<float>(AsSpan({M, K}), -1.0f, 1.0f);
+  for (int64_t m = 0; m < M; m++) {
+    std::for_each(A_data.begin() + m * K, A_data.begin() + (m + 1) * K, [&](float& v) { v *= row_ranges[m]; });
+  }
+  std::vector<int32_t> tmp_B_data = random.Uniform<int32_t>(AsSpan({K, N}), -64, 63);
+  std::vector<int8_t> B_data(tmp_B_data.begin(), tmp_B_data.end());
+  std::vector<float> B_scale = random.Uniform<float>(AsSpan({N}), 0.01f, 0.1f);
+  std::vector<int8_t> B_zero_point(N, 1);
+  std::vector<float> Bias = random.Uniform<float>(AsSpan({N}), -0.1f, 0.1f);
+
+  // each row is quantized symmetrically with its own scale
+  std::vector<float> Y_data(M * N);
+  for (int64_t m = 0; m < M; m++) {
+    const float* a = A_data.data() + m * K;
+    float max_abs = 0.0f;
+    for (int64_t k = 0; k < K; k++) {
+      max_abs = std::max(max_abs, std::fabs(a[k]));
+    }
+    const float a_scale = max_abs / 127.0f;
+    for (int64_t n = 0; n < N; n++) {
+      int32_t sum = 0;
+      for (int64_t k = 0; k < K; k++) {
+        const int32_t a_quant = static_cast<int32_t>(std::nearbyintf(a[k] / a_scale));
+        sum += a_quant * (B_data[k * N + n] - B_zero_point[n]);
+      }
+      Y_data[m * N + n] = static_cast<float>(sum) * (a_scale * B_scale[n]) + Bias[n];
+    }
+  }
+
+  for (bool is_matrix_b_constant : {false, true}) {
+    OpTester test("DynamicQuantizeMatMul", 1, onnxruntime::kMSDomain);
+    test.AddInput<float>("A", {M, K}, A_data);
+    test.AddInput<int8_t>("B", {K, N}, B_data, is_matrix_b_constant);
+    test.AddInput<float>("b_scale", {N}, B_scale);
+    test.AddInput<int8_t>("b_zero_point", {N}, B_zero_point);
+    test.AddInput<float>("bias", {N}, Bias);
+    test.AddOutput<float>("Y", {M, N}, Y_data);
+    test.SetOutputAbsErr("Y", 1e-4f);
+
+    SessionOptions so;
+    ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsDynamicQuantizeMatMulPerRow, "1"));
+    std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+    execution_providers.push_back(DefaultCpuExecutionProvider());
+    test.Config(so)
+        .ConfigEps(std::move(execution_providers))
+        .RunWithConfig();
+  }
+}
+
+TEST(DynamicQuantizeMatMul, OutlierChannels) {
+  // a few channels with outliers, which would make the per-row scales coarse for the other channels
+  constexpr int64_t M = 5;
+  constexpr int64_t K = 64;
+  constexpr int64_t N = 24;
+  constexpr float outlier_threshold = 6.0f;
+  const int64_t outlier_channels[] = {3, 17, 40};
+
+  RandomValueGenerator random{};
+  std::vector<float> A_data = random.Uniform<float>(AsSpan({M, K}), -1.0f, 1.0f);
+  for (int64_t m = 0; m < M; m++) {
+    for (int64_t k : outlier_channels) {
+      A_data[m * K + k] *= 60.0f;
+    }
+  }
+  std::vector<int32_t> tmp_B_data = random.Uniform<int32_t>(AsSpan({K, N}), -64, 63);
+  std::vector<int8_t> B_data(tmp_B_data.begin(), tmp_B_data.end());
+  std::vector<float> B_scale = random.Uniform<float>(AsSpan({N}), 0.01f, 0.1f);
+  std::vector<int8_t> B_zero_point(N, 1);
+
+  // the outliers are multiplied in float, and each row is quantized without them
+  std::vector<float> Y_data(M * N);
+  for (int64_t m = 0; m < M; m++) {
+    std::vector<float> a(A_data.begin() + m * K, A_data.begin() + (m + 1) * K);
+    std::vector<bool> is_outlier(K);
+    float max_abs = 0.0f;
+    for (int64_t k = 0; k < K; k++) {
+      is_outlier[k] = std::fabs(a[k]) > outlier_threshold;
+      if (!is_outlier[k]) {
+        max_abs = std::max(max_abs, std::fabs(a[k]));
+      }
+    }
+    const float a_scale = max_abs / 127.0f;
+    for (int64_t n = 0; n < N; n++) {
+      int32_t sum = 0;
+      float outlier_sum = 0.0f;
+      for (int64_t k = 0; k < K; k++) {
+        const int32_t b = B_data[k * N + n] - B_zero_point[n];
+        if (is_outlier[k]) {
+          outlier_sum += a[k] * (static_cast<float>(b) * B_scale[n]);
+        } else {
+          sum += static_cast<int32_t>(std::nearbyintf(a[k] / a_scale)) * b;
+        }
+      }
+      Y_data[m * N + n] = static_cast<float>(sum) * (a_scale * B_scale[n]) + outlier_sum;
+    }
+  }
+
+  for (bool is_matrix_b_constant : {false, true}) {
+    OpTester test("DynamicQuantizeMatMul", 1, onnxruntime::kMSDomain);
+    test.AddInput<float>("A", {M, K}, A_data);
+    test.AddInput<int8_t>("B", {K, N}, B_data, is_matrix_b_constant);
+    test.AddInput<float>("b_scale", {N}, B_scale);
+    test.AddInput<int8_t>("b_zero_point", {N}, B_zero_point);
+    test.AddOutput<float>("Y", {M, N}, Y_data);
+    test.SetOutputAbsErr("Y", 1e-3f);
+
+    SessionOptions so;
+    ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsDynamicQuantizeMatMulPerRow, "1"));
+    ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsDynamicQuantizeMatMulOutlierThreshold, "6"));
+    std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+    execution_providers.push_back(DefaultCpuExecutionProvider());
+    test.Config(so)
+        .ConfigEps(std::move(execution_providers))
+        .RunWithConfig();
+  }
+}
+
 }  // namespace test
 }  // namespace onnxruntime
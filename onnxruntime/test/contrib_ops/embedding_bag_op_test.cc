@@ -0,0 +1,134 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "gtest/gtest.h"
+#include "core/providers/cuda/cuda_provider_options.h"
+#include "test/common/tensor_op_test_utils.h"
+#include "test/providers/provider_test_utils.h"
+#include "test/util/include/default_providers.h"
+
+namespace onnxruntime {
+namespace test {
+
+static const std::vector<int64_t> weight_dims = {4, 2};
+static const std::vector<float> weight_data = {1.0f, 2.0f,
+                                               3.0f, 4.0f,
+                                               5.0f, 6.0f,
+                                               7.0f, 8.0f};
+
+TEST(EmbeddingBagTest, SumWithOffsets) {
+  OpTester test("EmbeddingBag", 1, onnxruntime::kMSDomain);
+  test.AddInput<float>("weight", weight_dims, weight_data);
+  // the second bag is empty and the last index counts from the end of the table
+  test.AddInput<int64_t>("indices", {5}, {0, 2, 3, 1, -1});
+  test.AddInput<int64_t>("offsets", {3}, {0, 2, 2});
+  test.AddOutput<float>("output", {3, 2}, {6.0f, 8.0f,
+                                           0.0f, 0.0f,
+                                           17.0f, 20.0f});
+  test.Run();
+}
+
+TEST(EmbeddingBagTest, MeanFixedSizeBags) {
+  OpTester test("EmbeddingBag", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<std::string>("mode", "mean");
+  test.AddInput<float>("weight", weight_dims, weight_data);
+  test.AddInput<int32_t>("indices", {2, 2}, {0, 1, 2, 3});
+  test.AddOutput<float>("output", {2, 2}, {2.0f, 3.0f,
+                                           6.0f, 7.0f});
+  test.Run();
+}
+
+TEST(EmbeddingBagTest, MaxFixedSizeBags) {
+  OpTester test("EmbeddingBag", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<std::string>("mode", "max");
+  test.AddInput<float>("weight", weight_dims, weight_data);
+  test.AddInput<int64_t>("indices", {2, 2}, {0, 3, 2, 1});
+  test.AddOutput<float>("output", {2, 2}, {7.0f, 8.0f,
+                                           5.0f, 6.0f});
+  test.Run();
+}
+
+TEST(EmbeddingBagTest, PerSampleWeights) {
+  OpTester test("EmbeddingBag", 1, onnxruntime::kMSDomain);
+  test.AddInput<float>("weight", weight_dims, weight_data);
+  test.AddInput<int64_t>("indices", {3}, {0, 1, 2});
+  test.AddInput<int64_t>("offsets", {2}, {0, 1});
+  test.AddInput<float>("per_sample_weights", {3}, {2.0f, 0.5f, 1.0f});
+  test.AddOutput<float>("output", {2, 2}, {2.0f, 4.0f,
+                                           6.5f, 8.0f});
+  test.Run();
+}
+
+TEST(EmbeddingBagTest, Float16Table) {
+  OpTester test("EmbeddingBag", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<std::string>("mode", "mean");
+  test.AddInput<MLFloat16>("weight", weight_dims, ToFloat16(weight_data));
+  test.AddInput<int64_t>("indices", {2, 2}, {0, 1, 2, 3});
+  test.AddOutput<float>("output", {2, 2}, {2.0f, 3.0f,
+                                           6.0f, 7.0f});
+  test.Run();
+}
+
+TEST(EmbeddingBagTest, Int8TableWithScales) {
+  OpTester test("EmbeddingBag", 1, onnxruntime::kMSDomain);
+  test.AddInput<int8_t>("weight", {2, 2}, {1, 2, 3, -4});
+  test.AddInput<int64_t>("indices", {1, 2}, {0, 1});
+  test.AddOptionalInputEdge<int64_t>();
+  test.AddOptionalInputEdge<float>();
+  test.AddInput<float>("scales", {2}, {0.5f, 2.0f});
+  test.AddOutput<float>("output", {1, 2}, {6.5f, -7.0f});
+  test.Run();
+}
+
+TEST(EmbeddingBagTest, IndexOutOfBounds) {
+  OpTester test("EmbeddingBag", 1, onnxruntime::kMSDomain);
+  test.AddInput<float>("weight", weight_dims, weight_data);
+  test.AddInput<int64_t>("indices", {1, 2}, {0, 4});
+  test.AddOutput<float>("output", {1, 2}, {0.0f, 0.0f});
+  test.Run(OpTester::ExpectResult::kExpectFailure, "is out of bounds");
+}
+
+#ifdef USE_CUDA
+// A 1 MB cache holds 4 rows of 65536 floats of the 8 row table, so a batch looking up 3 rows is reduced from the
+// cache and a batch looking up 6 rows is staged for the run only.
+static void RunWithRowCache(const std::vector<int64_t>& indices) {
+  constexpr int64_t num_rows = 8;
+  constexpr int64_t dim = 65536;
+  std::vector<float> weight(num_rows * dim);
+  for (int64_t i = 0; i < num_rows * dim; ++i) {
+    weight[i] = static_cast<float>(i % 251) * 0.25f;
+  }
+  std::vector<float> output(dim, 0.0f);
+  for (int64_t index : indices) {
+    for (int64_t j = 0; j < dim; ++j) {
+      output[j] += weight[index * dim + j];
+    }
+  }
+
+  OrtCUDAProviderOptionsV2 cuda_options;
+  cuda_options.embedding_cache_size_in_mb = 1;
+  auto cuda_ep = CudaExecutionProviderWithOptions(&cuda_options);
+  if (cuda_ep == nullptr) {
+    GTEST_SKIP() << "CUDA EP is not available.";
+  }
+
+  OpTester test("EmbeddingBag", 1, onnxruntime::kMSDomain);
+  test.AddInput<float>("weight", {num_rows, dim}, weight);
+  test.AddInput<int64_t>("indices", {1, static_cast<int64_t>(indices.size())}, indices);
+  test.AddOutput<float>("output", {1, dim}, output);
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(std::move(cuda_ep));
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+
+TEST(EmbeddingBagTest, CudaRowCache) {
+  RunWithRowCache({7, 1, 7, 4});
+}
+
+TEST(EmbeddingBagTest, CudaRowCacheOverflow) {
+  RunWithRowCache({0, 1, 2, 3, 4, 5});
+}
+#endif
+
+}  // namespace test
+}  // namespace onnxruntime
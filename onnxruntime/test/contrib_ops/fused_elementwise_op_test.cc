@@ -0,0 +1,104 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <cmath>
+
+#include "gtest/gtest.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+
+std::vector<float> MakeData(size_t size, float scale) {
+  std::vector<float> data(size);
+  for (size_t i = 0; i < size; i++) {
+    data[i] = static_cast<float>(static_cast<int>(i % 13) - 6) * scale;
+  }
+  return data;
+}
+
+}  // namespace
+
+// (x + bias) * scale -> Relu, with bias broadcast along the last axis and a scalar scale.
+TEST(FusedElementwiseOpTest, AddMulRelu) {
+  constexpr int64_t M = 37, N = 65;
+  const auto x = MakeData(M * N, 0.25f);
+  const auto bias = MakeData(N, 0.5f);
+  const float scale = 1.5f;
+
+  std::vector<float> expected(M * N);
+  for (int64_t m = 0; m < M; m++) {
+    for (int64_t n = 0; n < N; n++) {
+      expected[m * N + n] = std::max((x[m * N + n] + bias[n]) * scale, 0.0f);
+    }
+  }
+
+  OpTester test("FusedElementwise", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<std::vector<std::string>>("ops", {"Add", "Mul", "Relu"});
+  test.AddAttribute<std::vector<int64_t>>("operands", {0, 1, 3, 2, 4, -1});
+  test.AddInput<float>("x", {M, N}, x);
+  test.AddInput<float>("bias", {N}, bias);
+  test.AddInput<float>("scale", {}, {scale});
+  test.AddOutput<float>("Y", {M, N}, expected);
+  test.Run();
+}
+
+// Inputs broadcast along different axes, results used by later steps, and steps with an alpha.
+TEST(FusedElementwiseOpTest, BroadcastTree) {
+  constexpr int64_t B = 3, M = 1000, N = 7;
+  const auto a = MakeData(B * N, 0.125f);
+  const auto b = MakeData(M * 1, 0.25f);
+  const auto c = MakeData(B * M * N, 0.0625f);
+
+  // t0 = a - b, t1 = Sigmoid(t0), t2 = t0 * t1, t3 = LeakyRelu(c), t4 = t2 + t3, Y = QuickGelu(t4)
+  std::vector<float> expected(B * M * N);
+  for (int64_t i = 0; i < B; i++) {
+    for (int64_t m = 0; m < M; m++) {
+      for (int64_t n = 0; n < N; n++) {
+        const float t0 = a[i * N + n] - b[m];
+        const float t1 = 1.0f / (1.0f + std::exp(-t0));
+        const float t2 = t0 * t1;
+        const float cv = c[(i * M + m) * N + n];
+        const float t3 = cv >= 0.0f ? cv : cv * 0.1f;
+        const float t4 = t2 + t3;
+        expected[(i * M + m) * N + n] = t4 / (1.0f + std::exp(-1.702f * t4));
+      }
+    }
+  }
+
+  OpTester test("FusedElementwise", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<std::vector<std::string>>("ops", {"Sub", "Sigmoid", "Mul", "LeakyRelu", "Add", "QuickGelu"});
+  test.AddAttribute<std::vector<int64_t>>("operands", {0, 1, 3, -1, 3, 4, 2, -1, 5, 6, 7, -1});
+  test.AddAttribute<std::vector<float>>("alphas", {0.0f, 0.0f, 0.0f, 0.1f, 0.0f, 1.702f});
+  test.AddInput<float>("a", {B, 1, N}, a);
+  test.AddInput<float>("b", {M, 1}, b);
+  test.AddInput<float>("c", {B, M, N}, c);
+  test.AddOutput<float>("Y", {B, M, N}, expected);
+  test.SetOutputAbsErr("Y", 0.0001f);
+  test.Run();
+}
+
+TEST(FusedElementwiseOpTest, UnaryChain) {
+  constexpr int64_t N = 2049;
+  const auto x = MakeData(N, 0.2f);
+
+  std::vector<float> expected(N);
+  for (int64_t i = 0; i < N; i++) {
+    const float v = std::sqrt(std::fabs(x[i]) + 1.0f);
+    expected[i] = 0.5f * v * (1.0f + std::erf(v * 0.70710678f)) - std::tanh(x[i]);
+  }
+
+  OpTester test("FusedElementwise", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<std::vector<std::string>>("ops", {"Abs", "Add", "Sqrt", "Gelu", "Tanh", "Sub"});
+  test.AddAttribute<std::vector<int64_t>>("operands", {0, -1, 2, 1, 3, -1, 4, -1, 0, -1, 5, 6});
+  test.AddInput<float>("x", {N}, x);
+  test.AddInput<float>("one", {1}, {1.0f});
+  test.AddOutput<float>("Y", {N}, expected);
+  test.SetOutputAbsErr("Y", 0.0001f);
+  test.Run();
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -0,0 +1,108 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <cmath>
+#include <functional>
+
+#include "gtest/gtest.h"
+#include "test/providers/provider_test_utils.h"
+#include "test/util/include/default_providers.h"
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+
+// Runs FusedGemm on the CPU EP with C of the given shape and compares with a reference computed here.
+void RunFusedGemmTest(const std::string& activation, const std::function<float(float)>& reference_activation,
+                      const std::vector<int64_t>& c_dims, bool trans_b = false, float alpha = 1.0f,
+                      float beta = 1.0f, float activation_alpha = 0.0f, bool has_activation_alpha = false) {
+  constexpr int64_t M = 5, K = 7, N = 19;
+
+  std::vector<float> a(M * K), b(K * N);
+  for (size_t i = 0; i < a.size(); i++) a[i] = static_cast<float>(static_cast<int>(i % 9) - 4) * 0.25f;
+  for (size_t i = 0; i < b.size(); i++) b[i] = static_cast<float>(static_cast<int>(i % 5) - 2) * 0.5f;
+
+  int64_t c_size = 1;
+  for (auto d : c_dims) c_size *= d;
+  std::vector<float> c(static_cast<size_t>(c_size));
+  for (size_t i = 0; i < c.size(); i++) c[i] = static_cast<float>(static_cast<int>(i % 3) - 1);
+
+  std::vector<float> expected(M * N);
+  for (int64_t m = 0; m < M; m++) {
+    for (int64_t n = 0; n < N; n++) {
+      float sum = 0.0f;
+      for (int64_t k = 0; k < K; k++) {
+        sum += a[m * K + k] * (trans_b ? b[n * K + k] : b[k * N + n]);
+      }
+      float bias;
+      if (c_size == 1) {
+        bias = c[0];
+      } else if (c_dims.size() == 1 || c_dims[0] == 1) {
+        bias = c[n];
+      } else if (c_dims[1] == 1) {
+        bias = c[m];
+      } else {
+        bias = c[m * N + n];
+      }
+      expected[m * N + n] = reference_activation(alpha * sum + beta * bias);
+    }
+  }
+
+  OpTester test("FusedGemm", 1, onnxruntime::kMSDomain);
+  test.AddAttribute("transA", static_cast<int64_t>(0));
+  test.AddAttribute("transB", static_cast<int64_t>(trans_b ? 1 : 0));
+  test.AddAttribute("alpha", alpha);
+  test.AddAttribute("beta", beta);
+  test.AddAttribute("activation", activation);
+  if (has_activation_alpha) {
+    test.AddAttribute("activation_alpha", activation_alpha);
+  }
+
+  test.AddInput<float>("A", {M, K}, a);
+  test.AddInput<float>("B", trans_b ? std::vector<int64_t>{N, K} : std::vector<int64_t>{K, N}, b);
+  test.AddInput<float>("C", c_dims, c);
+  test.AddOutput<float>("Y", {M, N}, expected);
+  test.SetOutputAbsErr("Y", 0.0001f);
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+
+float Relu(float x) { return std::max(x, 0.0f); }
+
+}  // namespace
+
+TEST(FusedGemmOpTest, ReluRowBias) {
+  RunFusedGemmTest("Relu", Relu, {19});
+  RunFusedGemmTest("Relu", Relu, {1, 19}, true);
+}
+
+TEST(FusedGemmOpTest, ReluMatrixBias) {
+  RunFusedGemmTest("Relu", Relu, {5, 19});
+}
+
+TEST(FusedGemmOpTest, ReluBroadcastBias) {
+  RunFusedGemmTest("Relu", Relu, {1});
+  RunFusedGemmTest("Relu", Relu, {5, 1});
+  RunFusedGemmTest("Relu", Relu, {19}, false, 0.5f, 2.0f);
+}
+
+TEST(FusedGemmOpTest, LeakyRelu) {
+  RunFusedGemmTest(
+      "LeakyRelu", [](float x) { return x >= 0.0f ? x : x * 0.1f; }, {19}, false, 1.0f, 1.0f, 0.1f, true);
+  RunFusedGemmTest("LeakyRelu", [](float x) { return x >= 0.0f ? x : x * 0.01f; }, {5, 19});
+}
+
+TEST(FusedGemmOpTest, Sigmoid) {
+  RunFusedGemmTest("Sigmoid", [](float x) { return 1.0f / (1.0f + std::exp(-x)); }, {19});
+}
+
+TEST(FusedGemmOpTest, Softsign) {
+  // Not supported by the MLAS epilogue, so applied in a separate pass.
+  RunFusedGemmTest("Softsign", [](float x) { return x / (1.0f + std::fabs(x)); }, {19});
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -0,0 +1,86 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+
+#include <gtest/gtest.h>
+#include "test/common/cuda_op_test_utils.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+#if defined(USE_CUDA) && !defined(DISABLE_FLOAT8_TYPES)
+
+static void RunGemmFloat8Test(const std::string& activation) {
+  // float 8 tensor cores need sm89 or later
+  if (!HasCudaEnvironment(890)) {
+    return;
+  }
+
+  constexpr int64_t M = 16;
+  constexpr int64_t N = 32;
+  constexpr int64_t K = 32;
+  constexpr float scale_a = 2.0f;
+  constexpr float scale_b = 0.5f;
+
+  // small multiples of 0.25 are exact in float8e4m3fn, and the sums are exact in float
+  std::vector<float> a(M * K);
+  std::vector<float> b(N * K);
+  for (size_t i = 0; i < a.size(); ++i) {
+    a[i] = static_cast<float>(static_cast<int>(i % 9) - 4) * 0.25f;
+  }
+  for (size_t i = 0; i < b.size(); ++i) {
+    b[i] = static_cast<float>(static_cast<int>(i % 7) - 3) * 0.5f;
+  }
+
+  std::vector<float> y(M * N);
+  for (int64_t m = 0; m < M; ++m) {
+    for (int64_t n = 0; n < N; ++n) {
+      float sum = 0.0f;
+      for (int64_t k = 0; k < K; ++k) {
+        sum += a[m * K + k] * b[n * K + k];
+      }
+      sum *= scale_a * scale_b;
+      y[m * N + n] = activation == "RELU" ? std::max(sum, 0.0f) : sum;
+    }
+  }
+
+  std::vector<Float8E4M3FN> a_fp8;
+  std::vector<Float8E4M3FN> b_fp8;
+  for (float value : a) {
+    a_fp8.emplace_back(value, true);
+  }
+  for (float value : b) {
+    b_fp8.emplace_back(value, true);
+  }
+
+  OpTester test("GemmFloat8", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<int64_t>("transA", 0);
+  test.AddAttribute<int64_t>("transB", 1);
+  test.AddAttribute<std::string>("activation", activation);
+  test.AddAttribute<int64_t>("dtype", ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  test.AddInput<Float8E4M3FN>("A", {M, K}, a_fp8);
+  test.AddInput<Float8E4M3FN>("B", {N, K}, b_fp8);
+  test.AddOptionalInputEdge<float>();
+  test.AddInput<float>("scaleA", {}, {scale_a});
+  test.AddInput<float>("scaleB", {}, {scale_b});
+  test.AddOutput<float>("Y", {M, N}, y);
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCudaExecutionProvider());
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+
+TEST(GemmFloat8Test, Float8E4M3FN) {
+  RunGemmFloat8Test("NONE");
+}
+
+TEST(GemmFloat8Test, Float8E4M3FNRelu) {
+  RunGemmFloat8Test("RELU");
+}
+
+#endif
+
+}  // namespace test
+}  // namespace onnxruntime
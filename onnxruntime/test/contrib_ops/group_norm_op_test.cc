@@ -423,9 +423,29 @@ TEST(GroupNormTest, GroupNorm_128) {
     test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
   }
 
+  // Test float32 on CPU, without activation
+  {
+    OpTester test("GroupNorm", 1, onnxruntime::kMSDomain);
+    test.AddAttribute<float>("epsilon", 1e-05f);
+    test.AddAttribute<int64_t>("groups", 32);
+    test.AddAttribute<int64_t>("activation", 0);
+
+    test.AddInput<float>("X", dims, input_data);
+    test.AddInput<float>("gamma", {C}, gamma_data);
+    test.AddInput<float>("beta", {C}, beta_data);
+
+    constexpr float rel_error = 0.0f;
+    constexpr float abs_error = 0.01f;
+    test.AddOutput<float>("Y", dims, norm_data, false, rel_error, abs_error);
+
+    std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+    execution_providers.push_back(DefaultCpuExecutionProvider());
+    test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+  }
+
   // Test float32, with activation
   enable_cuda = HasCudaEnvironment(0);
-  if (enable_cuda || enable_rocm || enable_dml) {
+  {
     OpTester test("GroupNorm", 1, onnxruntime::kMSDomain);
     test.AddAttribute<float>("epsilon", 1e-05f);
     test.AddAttribute<int64_t>("groups", 32);
@@ -449,6 +469,7 @@ TEST(GroupNormTest, GroupNorm_128) {
     if (enable_dml) {
       execution_providers.push_back(DefaultDmlExecutionProvider());
     }
+    execution_providers.push_back(DefaultCpuExecutionProvider());
     test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
   }
 }
@@ -0,0 +1,335 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "test/common/tensor_op_test_utils.h"
+#include "test/providers/provider_test_utils.h"
+#include "test/util/include/default_providers.h"
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+std::vector<float> RandomData(size_t size, unsigned seed) {
+  std::default_random_engine generator(seed);
+  std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+  std::vector<float> data(size);
+  for (auto& v : data) {
+    v = distribution(generator);
+  }
+  return data;
+}
+
+enum class CacheType {
+  kFloat,
+  kInt8,
+  kFloat8E4M3FN,
+};
+
+// Stores value / scale in the cache type, as the kernel writes new tokens to an 8-bit cache.
+template <typename TCache>
+TCache QuantizeCacheValue(float value, float scale);
+
+template <>
+int8_t QuantizeCacheValue<int8_t>(float value, float scale) {
+  return static_cast<int8_t>(std::clamp(std::nearbyint(value / scale), -128.0f, 127.0f));
+}
+
+template <>
+float QuantizeCacheValue<float>(float value, float /*scale*/) {
+  return value;
+}
+
+float DequantizeCacheValue(int8_t value, float scale) { return value * scale; }
+float DequantizeCacheValue(float value, float /*scale*/) { return value; }
+
+#if !defined(DISABLE_FLOAT8_TYPES)
+template <>
+Float8E4M3FN QuantizeCacheValue<Float8E4M3FN>(float value, float scale) {
+  return Float8E4M3FN(value / scale, true);
+}
+
+float DequantizeCacheValue(Float8E4M3FN value, float scale) { return value.ToFloat() * scale; }
+#endif
+}  // namespace
+
+// Naive reference: the cache is (B, N_kv, S*, H) and holds past_seqlens[b] valid tokens before this step.
+// An 8-bit cache holds value / scale of each key/value head, and the reference attends to the dequantized values.
+template <typename TCache = float>
+static void RunGroupQueryAttentionTest(int batch_size, int sequence_length, int num_heads, int kv_num_heads,
+                                       int head_size, int max_sequence_length, const std::vector<int32_t>& past_seqlens,
+                                       bool use_past, bool do_rotary = false) {
+  constexpr bool is_quantized_cache = !std::is_same<TCache, float>::value;
+  const int hidden_size = num_heads * head_size;
+  const int kv_hidden_size = kv_num_heads * head_size;
+  const int capacity = use_past ? max_sequence_length : sequence_length;
+
+  std::vector<float> query = RandomData(static_cast<size_t>(batch_size) * sequence_length * hidden_size, 1);
+  std::vector<float> key = RandomData(static_cast<size_t>(batch_size) * sequence_length * kv_hidden_size, 2);
+  std::vector<float> value = RandomData(static_cast<size_t>(batch_size) * sequence_length * kv_hidden_size, 3);
+
+  const size_t cache_size = static_cast<size_t>(batch_size) * kv_num_heads * capacity * head_size;
+  std::vector<float> past_key = RandomData(cache_size, 4);
+  std::vector<float> past_value = RandomData(cache_size, 5);
+
+  std::vector<float> key_cache_scale(kv_num_heads);
+  std::vector<float> value_cache_scale(kv_num_heads);
+  for (int n = 0; n < kv_num_heads; n++) {
+    key_cache_scale[n] = (std::is_same<TCache, int8_t>::value ? 1.0f / 100.0f : 1.0f / 64.0f) * (1 + n);
+    value_cache_scale[n] = key_cache_scale[n] * 0.75f;
+  }
+  auto cache_scale = [&](const std::vector<float>& scales, size_t index) {
+    return scales[(index / (static_cast<size_t>(capacity) * head_size)) % kv_num_heads];
+  };
+  auto round_trip = [](float value, float scale) {
+    return DequantizeCacheValue(QuantizeCacheValue<TCache>(value, scale), scale);
+  };
+  for (size_t i = 0; i < cache_size; i++) {
+    past_key[i] = round_trip(past_key[i], cache_scale(key_cache_scale, i));
+    past_value[i] = round_trip(past_value[i], cache_scale(value_cache_scale, i));
+  }
+
+  // Rotary caches cover every position of the cache. The reference rotates query and key up front.
+  const int half_head_size = head_size / 2;
+  std::vector<float> cos_cache(static_cast<size_t>(capacity) * half_head_size);
+  std::vector<float> sin_cache(cos_cache.size());
+  for (int p = 0; p < capacity; p++) {
+    for (int i = 0; i < half_head_size; i++) {
+      const float angle = p * std::pow(10000.0f, -2.0f * i / head_size);
+      cos_cache[p * half_head_size + i] = std::cos(angle);
+      sin_cache[p * half_head_size + i] = std::sin(angle);
+    }
+  }
+  std::vector<float> rotated_query = query;
+  std::vector<float> rotated_key = key;
+  if (do_rotary) {
+    auto rotate = [&](float* x, int position) {
+      for (int i = 0; i < half_head_size; i++) {
+        const float c = cos_cache[position * half_head_size + i];
+        const float s = sin_cache[position * half_head_size + i];
+        const float x0 = x[i];
+        const float x1 = x[i + half_head_size];
+        x[i] = x0 * c - x1 * s;
+        x[i + half_head_size] = x1 * c + x0 * s;
+      }
+    };
+    for (int b = 0; b < batch_size; b++) {
+      const int past_length = use_past ? past_seqlens[b] : 0;
+      for (int s = 0; s < sequence_length; s++) {
+        for (int n = 0; n < num_heads; n++) {
+          rotate(rotated_query.data() + (static_cast<size_t>(b) * sequence_length + s) * hidden_size + n * head_size,
+                 past_length + s);
+        }
+        for (int n = 0; n < kv_num_heads; n++) {
+          rotate(rotated_key.data() + (static_cast<size_t>(b) * sequence_length + s) * kv_hidden_size + n * head_size,
+                 past_length + s);
+        }
+      }
+    }
+  }
+
+  // Expected present: past prefix kept, new tokens appended after it, the rest left as in the past buffer.
+  std::vector<float> present_key = use_past ? past_key : std::vector<float>(cache_size, 0.0f);
+  std::vector<float> present_value = use_past ? past_value : std::vector<float>(cache_size, 0.0f);
+  for (int b = 0; b < batch_size; b++) {
+    const int past_length = use_past ? past_seqlens[b] : 0;
+    for (int n = 0; n < kv_num_heads; n++) {
+      for (int s = 0; s < sequence_length; s++) {
+        for (int h = 0; h < head_size; h++) {
+          const size_t src = (static_cast<size_t>(b) * sequence_length + s) * kv_hidden_size + n * head_size + h;
+          const size_t dst = ((static_cast<size_t>(b) * kv_num_heads + n) * capacity + past_length + s) * head_size + h;
+          present_key[dst] = round_trip(rotated_key[src], key_cache_scale[n]);
+          present_value[dst] = round_trip(value[src], value_cache_scale[n]);
+        }
+      }
+    }
+  }
+
+  const float scale = 1.0f / std::sqrt(static_cast<float>(head_size));
+  std::vector<float> output(query.size(), 0.0f);
+  for (int b = 0; b < batch_size; b++) {
+    const int past_length = use_past ? past_seqlens[b] : 0;
+    for (int n = 0; n < num_heads; n++) {
+      const int kv_n = n / (num_heads / kv_num_heads);
+      const float* k = present_key.data() + (static_cast<size_t>(b) * kv_num_heads + kv_n) * capacity * head_size;
+      const float* v = present_value.data() + (static_cast<size_t>(b) * kv_num_heads + kv_n) * capacity * head_size;
+      for (int s = 0; s < sequence_length; s++) {
+        const float* q = rotated_query.data() + (static_cast<size_t>(b) * sequence_length + s) * hidden_size + n * head_size;
+        const int valid_length = past_length + s + 1;
+        std::vector<double> scores(valid_length);
+        double max_score = -INFINITY;
+        for (int t = 0; t < valid_length; t++) {
+          double dot = 0.0;
+          for (int h = 0; h < head_size; h++) {
+            dot += double(q[h]) * double(k[t * head_size + h]);
+          }
+          scores[t] = dot * scale;
+          max_score = std::max(max_score, scores[t]);
+        }
+        double sum = 0.0;
+        for (auto& score : scores) {
+          score = std::exp(score - max_score);
+          sum += score;
+        }
+        float* out = output.data() + (static_cast<size_t>(b) * sequence_length + s) * hidden_size + n * head_size;
+        for (int h = 0; h < head_size; h++) {
+          double acc = 0.0;
+          for (int t = 0; t < valid_length; t++) {
+            acc += scores[t] / sum * double(v[t * head_size + h]);
+          }
+          out[h] = static_cast<float>(acc);
+        }
+      }
+    }
+  }
+
+  const std::vector<int64_t> qkv_dims_q = {batch_size, sequence_length, hidden_size};
+  const std::vector<int64_t> qkv_dims_kv = {batch_size, sequence_length, kv_hidden_size};
+  const std::vector<int64_t> cache_dims = {batch_size, kv_num_heads, capacity, head_size};
+
+  auto quantize_cache = [&](const std::vector<float>& cache, const std::vector<float>& scales) {
+    std::vector<TCache> quantized(cache.size());
+    for (size_t i = 0; i < cache.size(); i++) {
+      quantized[i] = QuantizeCacheValue<TCache>(cache[i], cache_scale(scales, i));
+    }
+    return quantized;
+  };
+
+  OpTester test("GroupQueryAttention", 1, kMSDomain);
+  test.AddAttribute<int64_t>("num_heads", num_heads);
+  test.AddAttribute<int64_t>("kv_num_heads", kv_num_heads);
+  if (do_rotary) {
+    test.AddAttribute<int64_t>("do_rotary", 1);
+  }
+  test.AddInput<float>("query", qkv_dims_q, query);
+  test.AddInput<float>("key", qkv_dims_kv, key);
+  test.AddInput<float>("value", qkv_dims_kv, value);
+  if (use_past) {
+    test.AddInput<TCache>("past_key", cache_dims, quantize_cache(past_key, key_cache_scale));
+    test.AddInput<TCache>("past_value", cache_dims, quantize_cache(past_value, value_cache_scale));
+    test.AddInput<int32_t>("past_seqlens", {batch_size}, past_seqlens);
+  } else {
+    test.AddOptionalInputEdge<float>();
+    test.AddOptionalInputEdge<float>();
+    test.AddOptionalInputEdge<int32_t>();
+  }
+  if (do_rotary) {
+    test.AddInput<float>("cos_cache", {capacity, half_head_size}, cos_cache);
+    test.AddInput<float>("sin_cache", {capacity, half_head_size}, sin_cache);
+  } else if (is_quantized_cache) {
+    test.AddOptionalInputEdge<float>();
+    test.AddOptionalInputEdge<float>();
+  }
+  if (is_quantized_cache) {
+    test.AddInput<float>("key_cache_scale", {kv_num_heads}, key_cache_scale);
+    test.AddInput<float>("value_cache_scale", {kv_num_heads}, value_cache_scale);
+  }
+  test.AddOutput<float>("output", qkv_dims_q, output);
+  test.AddOutput<TCache>("present_key", cache_dims, quantize_cache(present_key, key_cache_scale));
+  test.AddOutput<TCache>("present_value", cache_dims, quantize_cache(present_value, value_cache_scale));
+  test.SetOutputAbsErr("output", 0.0001f);
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+
+TEST(GroupQueryAttentionTest, NoPast) {
+  RunGroupQueryAttentionTest(2, 3, 4, 2, 8, 3, {}, false);
+}
+
+TEST(GroupQueryAttentionTest, PastWithSpareCapacity) {
+  // Decoding one token with caches of different fill levels.
+  RunGroupQueryAttentionTest(2, 1, 4, 2, 8, 16, {5, 0}, true);
+  // Appending several tokens.
+  RunGroupQueryAttentionTest(2, 3, 6, 3, 4, 10, {2, 7}, true);
+}
+
+TEST(GroupQueryAttentionTest, MultiQuery) {
+  RunGroupQueryAttentionTest(1, 2, 4, 1, 16, 8, {3}, true);
+}
+
+TEST(GroupQueryAttentionTest, Rotary) {
+  RunGroupQueryAttentionTest(2, 3, 4, 2, 8, 3, {}, false, true);
+  RunGroupQueryAttentionTest(2, 1, 4, 2, 16, 12, {4, 9}, true, true);
+}
+
+TEST(GroupQueryAttentionTest, Int8Cache) {
+  RunGroupQueryAttentionTest<int8_t>(2, 1, 4, 2, 8, 16, {5, 0}, true);
+  RunGroupQueryAttentionTest<int8_t>(2, 3, 6, 3, 4, 10, {2, 7}, true);
+  RunGroupQueryAttentionTest<int8_t>(2, 1, 4, 2, 16, 12, {4, 9}, true, true);
+}
+
+#if !defined(DISABLE_FLOAT8_TYPES)
+TEST(GroupQueryAttentionTest, Float8Cache) {
+  RunGroupQueryAttentionTest<Float8E4M3FN>(2, 1, 4, 2, 8, 16, {5, 0}, true);
+  RunGroupQueryAttentionTest<Float8E4M3FN>(1, 2, 4, 1, 16, 8, {3}, true, true);
+}
+#endif
+
+TEST(GroupQueryAttentionTest, MissingCacheScale) {
+  OpTester test("GroupQueryAttention", 1, kMSDomain);
+  test.AddAttribute<int64_t>("num_heads", 2);
+  test.AddAttribute<int64_t>("kv_num_heads", 1);
+  test.AddInput<float>("query", {1, 1, 4}, std::vector<float>(4, 0.0f));
+  test.AddInput<float>("key", {1, 1, 2}, std::vector<float>(2, 0.0f));
+  test.AddInput<float>("value", {1, 1, 2}, std::vector<float>(2, 0.0f));
+  test.AddInput<int8_t>("past_key", {1, 1, 4, 2}, std::vector<int8_t>(8, 0));
+  test.AddInput<int8_t>("past_value", {1, 1, 4, 2}, std::vector<int8_t>(8, 0));
+  test.AddInput<int32_t>("past_seqlens", {1}, {1});
+  test.AddOutput<float>("output", {1, 1, 4}, std::vector<float>(4, 0.0f));
+  test.AddOutput<int8_t>("present_key", {1, 1, 4, 2}, std::vector<int8_t>(8, 0));
+  test.AddOutput<int8_t>("present_value", {1, 1, 4, 2}, std::vector<int8_t>(8, 0));
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  test.Run(OpTester::ExpectResult::kExpectFailure, "are required by an 8-bit key/value cache", {}, nullptr,
+           &execution_providers);
+}
+
+TEST(GroupQueryAttentionTest, ExceedsCapacity) {
+  OpTester test("GroupQueryAttention", 1, kMSDomain);
+  test.AddAttribute<int64_t>("num_heads", 2);
+  test.AddAttribute<int64_t>("kv_num_heads", 1);
+  test.AddInput<float>("query", {1, 2, 4}, std::vector<float>(8, 0.0f));
+  test.AddInput<float>("key", {1, 2, 2}, std::vector<float>(4, 0.0f));
+  test.AddInput<float>("value", {1, 2, 2}, std::vector<float>(4, 0.0f));
+  test.AddInput<float>("past_key", {1, 1, 4, 2}, std::vector<float>(8, 0.0f));
+  test.AddInput<float>("past_value", {1, 1, 4, 2}, std::vector<float>(8, 0.0f));
+  test.AddInput<int32_t>("past_seqlens", {1}, {3});
+  test.AddOutput<float>("output", {1, 2, 4}, std::vector<float>(8, 0.0f));
+  test.AddOutput<float>("present_key", {1, 1, 4, 2}, std::vector<float>(8, 0.0f));
+  test.AddOutput<float>("present_value", {1, 1, 4, 2}, std::vector<float>(8, 0.0f));
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  test.Run(OpTester::ExpectResult::kExpectFailure, "exceeds the cache capacity", {}, nullptr, &execution_providers);
+}
+
+TEST(GroupQueryAttentionTest, PastTooSmallWithoutSeqlens) {
+  OpTester test("GroupQueryAttention", 1, kMSDomain);
+  test.AddAttribute<int64_t>("num_heads", 2);
+  test.AddAttribute<int64_t>("kv_num_heads", 1);
+  test.AddInput<float>("query", {1, 2, 4}, std::vector<float>(8, 0.0f));
+  test.AddInput<float>("key", {1, 2, 2}, std::vector<float>(4, 0.0f));
+  test.AddInput<float>("value", {1, 2, 2}, std::vector<float>(4, 0.0f));
+  test.AddInput<float>("past_key", {1, 1, 1, 2}, std::vector<float>(2, 0.0f));
+  test.AddInput<float>("past_value", {1, 1, 1, 2}, std::vector<float>(2, 0.0f));
+  test.AddOutput<float>("output", {1, 2, 4}, std::vector<float>(8, 0.0f));
+  test.AddOutput<float>("present_key", {1, 1, 1, 2}, std::vector<float>(2, 0.0f));
+  test.AddOutput<float>("present_value", {1, 1, 1, 2}, std::vector<float>(2, 0.0f));
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  test.Run(OpTester::ExpectResult::kExpectFailure, "is too small for sequence_length", {}, nullptr,
+           &execution_providers);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
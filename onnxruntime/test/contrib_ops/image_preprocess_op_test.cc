@@ -0,0 +1,51 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "gtest/gtest.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+TEST(ImagePreprocessTest, NormalizeToNCHW) {
+  OpTester test("ImagePreprocess", 1, onnxruntime::kMSDomain);
+  test.AddAttribute("size", std::vector<int64_t>{2, 2});
+  test.AddAttribute("mean", std::vector<float>{1.0f, 2.0f, 3.0f});
+  test.AddAttribute("std", std::vector<float>{1.0f, 2.0f, 4.0f});
+
+  // (1, 2, 2, 3) pixels
+  test.AddInput<uint8_t>("X", {1, 2, 2, 3},
+                         {1, 2, 3, 11, 12, 13,
+                          21, 22, 23, 31, 32, 33});
+  test.AddOutput<float>("Y", {1, 3, 2, 2},
+                        {0.0f, 10.0f, 20.0f, 30.0f,
+                         0.0f, 5.0f, 10.0f, 15.0f,
+                         0.0f, 2.5f, 5.0f, 7.5f});
+  test.Run();
+}
+
+TEST(ImagePreprocessTest, ResizeLinearHalfPixel) {
+  OpTester test("ImagePreprocess", 1, onnxruntime::kMSDomain);
+  test.AddAttribute("size", std::vector<int64_t>{1, 4});
+  test.AddAttribute("scale", 0.5f);
+
+  // the centers of the output pixels are at 0, 0.25, 0.75 and 1 in the input once clamped
+  test.AddInput<uint8_t>("X", {1, 1, 2, 1}, {0, 100});
+  test.AddOutput<float>("Y", {1, 1, 1, 4}, {0.0f, 12.5f, 37.5f, 50.0f});
+  test.Run();
+}
+
+TEST(ImagePreprocessTest, DownscaleBatch) {
+  OpTester test("ImagePreprocess", 1, onnxruntime::kMSDomain);
+  test.AddAttribute("size", std::vector<int64_t>{1, 1});
+  test.AddAttribute("mean", std::vector<float>{5.0f});
+  test.AddAttribute("std", std::vector<float>{2.0f});
+
+  // the center of the output pixel is in the middle of the 4 input pixels
+  test.AddInput<uint8_t>("X", {2, 2, 2, 1}, {0, 10, 20, 30, 40, 40, 40, 40});
+  test.AddOutput<float>("Y", {2, 1, 1, 1}, {5.0f, 17.5f});
+  test.Run();
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -4,6 +4,7 @@
 #include <chrono>
 #include <random>
 #include "core/framework/tensor.h"
+#include "core/mlas/inc/mlas.h"
 #include "core/session/inference_session.h"
 #include "test/common/dnnl_op_test_utils.h"
 #include "test/common/tensor_op_test_utils.h"
@@ -209,6 +210,46 @@ TEST(LayerNormTest, LayerNorm17_double) {
   test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kDnnlExecutionProvider});
 }
 
+#ifdef MLAS_F16VEC_INTRINSICS_SUPPORTED
+TEST(LayerNormTest, LayerNorm17_fp16) {
+  // Use a normalized size with a partial vector tail for the CPU fp16 kernel.
+  constexpr int64_t rows = 2;
+  constexpr int64_t norm_size = 19;
+  std::vector<float> x(rows * norm_size);
+  std::vector<float> gamma(norm_size);
+  std::vector<float> beta(norm_size);
+  for (int64_t i = 0; i < norm_size; i++) {
+    gamma[i] = 0.5f + static_cast<float>(i % 4) * 0.25f;
+    beta[i] = static_cast<float>(i % 3) * 0.125f - 0.125f;
+  }
+  for (size_t i = 0; i < x.size(); i++) {
+    x[i] = static_cast<float>(static_cast<int>(i % 7) - 3) * 0.5f + static_cast<float>(i / norm_size);
+  }
+
+  std::vector<float> y(x.size());
+  for (int64_t r = 0; r < rows; r++) {
+    const float* row = x.data() + r * norm_size;
+    float mean = 0.0f;
+    for (int64_t i = 0; i < norm_size; i++) mean += row[i];
+    mean /= norm_size;
+    float variance = 0.0f;
+    for (int64_t i = 0; i < norm_size; i++) variance += (row[i] - mean) * (row[i] - mean);
+    variance /= norm_size;
+    for (int64_t i = 0; i < norm_size; i++) {
+      y[r * norm_size + i] = (row[i] - mean) / std::sqrt(variance + 1e-05f) * gamma[i] + beta[i];
+    }
+  }
+
+  OpTester test("LayerNormalization", 17);
+  test.AddAttribute<float>("epsilon", 1e-05f);
+  test.AddInput<MLFloat16>("x", {rows, norm_size}, ToFloat16(x));
+  test.AddInput<MLFloat16>("gamma", {norm_size}, ToFloat16(gamma));
+  test.AddInput<MLFloat16>("bias", {norm_size}, ToFloat16(beta));
+  test.AddOutput<MLFloat16>("output", {rows, norm_size}, ToFloat16(y));
+  test.Run();
+}
+#endif  // MLAS_F16VEC_INTRINSICS_SUPPORTED
+
 TEST(LayerNormTest, LayerNorm_InvalidScaleBias) {
   OpTester test("LayerNormalization");
   test.AddAttribute<float>("epsilon", 1e-05f);
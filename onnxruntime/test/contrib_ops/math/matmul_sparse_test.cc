@@ -380,6 +380,69 @@ TEST(SparseToDenseMatMul, TestCoo) {
     tester.Run(OpTester::ExpectResult::kExpectSuccess);
   }
 }
+
+TEST(SparseToDenseMatMul, TestBlockSparse) {
+  constexpr int64_t rows = 9;
+  constexpr int64_t cols = 9;
+  constexpr int64_t block_size = 3;
+  const std::vector<int64_t> A_shape = {rows, cols};
+  const std::vector<float> input_data = {
+      0, 1, 2, 0, 0, 0, 3, 4, 5,
+      6, 7, 8, 0, 0, 0, 9, 10, 11,
+      12, 13, 14, 0, 0, 0, 15, 16, 17,
+      0, 0, 0, 18, 19, 20, 21, 22, 23,
+      0, 0, 0, 24, 25, 26, 27, 28, 29,
+      0, 0, 0, 30, 31, 32, 33, 34, 35,
+      36, 37, 38, 39, 40, 41, 0, 0, 0,
+      42, 43, 44, 45, 46, 47, 0, 0, 0,
+      48, 49, 50, 51, 52, 53, 0, 0, 0};
+
+  // Non-zero blocks in row-major order, block rows followed by block cols
+  const std::vector<int32_t> A_indices = {0, 0, 1, 1, 2, 2,
+                                          0, 2, 1, 2, 0, 1};
+  const int64_t num_blocks = static_cast<int64_t>(A_indices.size()) / 2;
+  std::vector<float> A_values;
+  for (int64_t b = 0; b < num_blocks; ++b) {
+    for (int64_t r = 0; r < block_size; ++r) {
+      for (int64_t c = 0; c < block_size; ++c) {
+        A_values.push_back(input_data[(A_indices[b] * block_size + r) * cols +
+                                      A_indices[num_blocks + b] * block_size + c]);
+      }
+    }
+  }
+  const std::vector<int64_t> A_values_shape = {num_blocks, block_size, block_size};
+
+  const std::vector<int64_t> B_shape = {9, 9};
+  const std::vector<float>& B_data = input_data;
+  const std::vector<int64_t> X_shape = {rows, cols};
+
+  // Reference dense product of op(A) * op(B)
+  auto dense_matmul = [&](bool trans_a, bool trans_b) {
+    std::vector<float> result(rows * cols, 0.f);
+    for (int64_t m = 0; m < rows; ++m) {
+      for (int64_t n = 0; n < cols; ++n) {
+        for (int64_t k = 0; k < cols; ++k) {
+          const float a = trans_a ? input_data[k * cols + m] : input_data[m * cols + k];
+          const float b = trans_b ? B_data[n * cols + k] : B_data[k * cols + n];
+          result[m * cols + n] += a * b;
+        }
+      }
+    }
+    return result;
+  };
+
+  for (int64_t trans_a = 0; trans_a < 2; ++trans_a) {
+    for (int64_t trans_b = 0; trans_b < 2; ++trans_b) {
+      OpTester tester("SparseToDenseMatMul", 1, onnxruntime::kMSDomain);
+      tester.AddAttribute("transA", trans_a);
+      tester.AddAttribute("transB", trans_b);
+      tester.AddSparseBlockSparseInput("A", A_shape, A_values, A_values_shape, A_indices);
+      tester.AddInput("B", B_shape, B_data);
+      tester.AddOutput("X", X_shape, dense_matmul(trans_a != 0, trans_b != 0));
+      tester.Run(OpTester::ExpectResult::kExpectSuccess);
+    }
+  }
+}
 #endif  // !defined(DISABLE_SPARSE_TENSORS)
 
 }  // namespace test
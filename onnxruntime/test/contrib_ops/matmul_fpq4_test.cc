@@ -0,0 +1,90 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/mlas/inc/mlas_q4.h"
+#include "test/common/tensor_op_test_utils.h"
+#include "test/providers/provider_test_utils.h"
+
+#include <random>
+
+#include "gtest/gtest.h"
+
+namespace onnxruntime {
+namespace test {
+
+static void RunMatMulFpQ4Test(MLAS_BLK_QUANT_TYPE qtype, const std::vector<int64_t>& a_dims, int64_t K, int64_t N) {
+  int64_t M = 1;
+  for (size_t i = 0; i + 1 < a_dims.size(); i++) {
+    M *= a_dims[i];
+  }
+  ASSERT_EQ(a_dims.back(), K);
+
+  std::default_random_engine generator(static_cast<unsigned>(M * N * K));
+  std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+
+  std::vector<float> a(static_cast<size_t>(M * K));
+  for (auto& v : a) {
+    v = distribution(generator);
+  }
+  std::vector<float> b(static_cast<size_t>(K * N));
+  for (auto& v : b) {
+    v = distribution(generator);
+  }
+
+  const size_t packed_size = MlasQ4GemmPackBSize(qtype, static_cast<size_t>(N), static_cast<size_t>(K));
+  ASSERT_GT(packed_size, size_t(0));
+  std::vector<uint8_t> packed_b(packed_size);
+  MlasQ4GemmPackB(qtype, packed_b.data(), b.data(), static_cast<size_t>(N), static_cast<size_t>(K),
+                  static_cast<size_t>(N));
+
+  // The expected output uses the dequantized weights so only rounding differences remain.
+  std::vector<float> dequant_b(static_cast<size_t>(K * N));
+  MlasQ4GemmUnPackB(qtype, dequant_b.data(), packed_b.data(), static_cast<size_t>(N), static_cast<size_t>(K),
+                    static_cast<size_t>(N));
+
+  std::vector<float> expected(static_cast<size_t>(M * N));
+  for (int64_t m = 0; m < M; m++) {
+    for (int64_t n = 0; n < N; n++) {
+      double sum = 0.0;
+      for (int64_t k = 0; k < K; k++) {
+        sum += double(a[m * K + k]) * double(dequant_b[k * N + n]);
+      }
+      expected[m * N + n] = static_cast<float>(sum);
+    }
+  }
+
+  std::vector<int64_t> y_dims(a_dims.begin(), a_dims.end() - 1);
+  y_dims.push_back(N);
+
+  OpTester test("MatMulFpQ4", 1, kMSDomain);
+  test.AddAttribute<int64_t>("blk_quant_type", static_cast<int64_t>(qtype));
+  test.AddInput<float>("A", a_dims, a);
+  test.AddInput<uint8_t>("B", {static_cast<int64_t>(packed_size)}, packed_b, true);
+  test.AddInput<int64_t>("B_shape", {2}, {K, N}, true);
+  test.AddOutput<float>("Y", y_dims, expected);
+  test.SetOutputAbsErr("Y", 0.002f);
+  test.Run();
+}
+
+TEST(MatMulFpQ4, SymmetricBlk32) {
+  RunMatMulFpQ4Test(BlkQ4Sym, {1, 64}, 64, 32);
+  RunMatMulFpQ4Test(BlkQ4Sym, {7, 100}, 100, 17);
+}
+
+TEST(MatMulFpQ4, ZeroPointBlk32) {
+  RunMatMulFpQ4Test(BlkQ4Zp8, {1, 64}, 64, 32);
+  RunMatMulFpQ4Test(BlkQ4Zp8, {2, 3, 33}, 33, 40);
+}
+
+TEST(MatMulFpQ4, SymmetricBlk64) {
+  RunMatMulFpQ4Test(BlkQ4Sym64, {4, 128}, 128, 8);
+  RunMatMulFpQ4Test(BlkQ4Sym64, {9, 150}, 150, 50);
+}
+
+TEST(MatMulFpQ4, SymmetricBlk128) {
+  RunMatMulFpQ4Test(BlkQ4Sym128, {1, 256}, 256, 16);
+  RunMatMulFpQ4Test(BlkQ4Sym128, {2, 5, 300}, 300, 33);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -45,5 +45,34 @@ TEST(MatmulInteger16OpTest, MatMulInteger16_3) {
   test.Run();
 }
 
+// large enough to span several column panels and row blocks of the MLAS kernel, with a broadcast B
+TEST(MatmulInteger16OpTest, MatMulInteger16_Batched) {
+  constexpr int64_t batch = 2, M = 9, N = 37, K = 300;
+  std::vector<int16_t> a(batch * M * K);
+  std::vector<int16_t> b(K * N);
+  for (size_t i = 0; i < a.size(); i++) {
+    a[i] = static_cast<int16_t>(static_cast<int>(i * 7919 % 8191) - 4095);
+  }
+  for (size_t i = 0; i < b.size(); i++) {
+    b[i] = static_cast<int16_t>(static_cast<int>(i * 31 % 255) - 127);
+  }
+  std::vector<int32_t> y(batch * M * N);
+  for (int64_t i = 0; i < batch * M; i++) {
+    for (int64_t n = 0; n < N; n++) {
+      int32_t sum = 0;
+      for (int64_t k = 0; k < K; k++) {
+        sum += static_cast<int32_t>(a[i * K + k]) * static_cast<int32_t>(b[k * N + n]);
+      }
+      y[i * N + n] = sum;
+    }
+  }
+
+  OpTester test("MatMulInteger16", 1, onnxruntime::kMSDomain);
+  test.AddInput<int16_t>("T1", {batch, M, K}, a);
+  test.AddInput<int16_t>("T2", {K, N}, b);
+  test.AddOutput<int32_t>("T3", {batch, M, N}, y);
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -0,0 +1,154 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+#include <cmath>
+
+#include <gtest/gtest.h>
+#include "test/common/cuda_op_test_utils.h"
+#include "test/common/tensor_op_test_utils.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+#if defined(USE_CUDA)
+
+// quantizes the N x K matrix b in blocks along K as MatMulNBits expects it, and returns the dequantized values that
+// the kernel multiplies by
+static std::vector<float> QuantizeBlockwise(const std::vector<float>& b, int64_t N, int64_t K, int64_t bits,
+                                            int64_t block_size, bool has_zero_points, std::vector<uint8_t>& packed,
+                                            std::vector<float>& scales, std::vector<uint8_t>& zero_points) {
+  const int64_t blocks_per_col = (K + block_size - 1) / block_size;
+  const int64_t blob_size = block_size * bits / 8;
+  const int max_value = (1 << bits) - 1;
+  packed.assign(N * blocks_per_col * blob_size, 0);
+  scales.assign(N * blocks_per_col, 0.0f);
+  zero_points.assign(has_zero_points ? N * (bits == 4 ? (blocks_per_col + 1) / 2 : blocks_per_col) : 0, 0);
+
+  std::vector<float> dequantized(N * K);
+  for (int64_t n = 0; n < N; ++n) {
+    for (int64_t block = 0; block < blocks_per_col; ++block) {
+      const int64_t k_begin = block * block_size;
+      const int64_t k_end = std::min(K, k_begin + block_size);
+      float min_value = 0.0f;
+      float max_abs = 0.0f;
+      float range_max = 0.0f;
+      for (int64_t k = k_begin; k < k_end; ++k) {
+        min_value = std::min(min_value, b[n * K + k]);
+        range_max = std::max(range_max, b[n * K + k]);
+        max_abs = std::max(max_abs, std::abs(b[n * K + k]));
+      }
+
+      int zero_point = 1 << (bits - 1);
+      float scale;
+      if (has_zero_points) {
+        scale = (range_max - min_value) / max_value;
+        zero_point = static_cast<int>(std::round(-min_value / scale));
+        const int64_t zp_index = bits == 4 ? n * ((blocks_per_col + 1) / 2) + block / 2
+                                           : n * blocks_per_col + block;
+        zero_points[zp_index] |= static_cast<uint8_t>(bits == 4 && (block & 1) ? zero_point << 4 : zero_point);
+      } else {
+        scale = max_abs / (max_value - zero_point);
+      }
+      scales[n * blocks_per_col + block] = scale;
+
+      for (int64_t k = k_begin; k < k_end; ++k) {
+        const int q = std::clamp(static_cast<int>(std::round(b[n * K + k] / scale)) + zero_point, 0, max_value);
+        const int64_t index = n * blocks_per_col * block_size + k;
+        if (bits == 4) {
+          packed[index / 2] |= static_cast<uint8_t>((index & 1) ? q << 4 : q);
+        } else {
+          packed[index] = static_cast<uint8_t>(q);
+        }
+        dequantized[n * K + k] = (q - zero_point) * scale;
+      }
+    }
+  }
+  return dequantized;
+}
+
+static void RunMatMulNBitsTest(int64_t M, int64_t N, int64_t K, int64_t bits, int64_t block_size,
+                               bool has_zero_points, bool use_float16) {
+  std::vector<float> a(M * K);
+  std::vector<float> b(N * K);
+  for (size_t i = 0; i < a.size(); ++i) {
+    a[i] = static_cast<float>(static_cast<int>(i % 11) - 5) * 0.1f;
+  }
+  for (size_t i = 0; i < b.size(); ++i) {
+    b[i] = static_cast<float>(static_cast<int>((i * 7) % 17) - 8) * 0.05f;
+  }
+
+  std::vector<uint8_t> packed;
+  std::vector<float> scales;
+  std::vector<uint8_t> zero_points;
+  const std::vector<float> b_dequantized = QuantizeBlockwise(b, N, K, bits, block_size, has_zero_points,
+                                                             packed, scales, zero_points);
+
+  std::vector<float> y(M * N);
+  for (int64_t m = 0; m < M; ++m) {
+    for (int64_t n = 0; n < N; ++n) {
+      float sum = 0.0f;
+      for (int64_t k = 0; k < K; ++k) {
+        sum += a[m * K + k] * b_dequantized[n * K + k];
+      }
+      y[m * N + n] = sum;
+    }
+  }
+
+  const int64_t blocks_per_col = (K + block_size - 1) / block_size;
+  OpTester test("MatMulNBits", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<int64_t>("K", K);
+  test.AddAttribute<int64_t>("N", N);
+  test.AddAttribute<int64_t>("bits", bits);
+  test.AddAttribute<int64_t>("block_size", block_size);
+  if (use_float16) {
+    test.AddInput<MLFloat16>("A", {M, K}, ToFloat16(a));
+    test.AddInput<uint8_t>("B", {N, blocks_per_col, block_size * bits / 8}, packed, true);
+    test.AddInput<MLFloat16>("scales", {N * blocks_per_col}, ToFloat16(scales), true);
+  } else {
+    test.AddInput<float>("A", {M, K}, a);
+    test.AddInput<uint8_t>("B", {N, blocks_per_col, block_size * bits / 8}, packed, true);
+    test.AddInput<float>("scales", {N * blocks_per_col}, scales, true);
+  }
+  if (has_zero_points) {
+    test.AddInput<uint8_t>("zero_points", {static_cast<int64_t>(zero_points.size())}, zero_points, true);
+  }
+  if (use_float16) {
+    test.AddOutput<MLFloat16>("Y", {M, N}, ToFloat16(y));
+    test.SetOutputAbsErr("Y", 0.05f);
+  } else {
+    test.AddOutput<float>("Y", {M, N}, y);
+    test.SetOutputAbsErr("Y", 0.002f);
+  }
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCudaExecutionProvider());
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+
+TEST(MatMulNBitsTest, Gemv4Bits) {
+  RunMatMulNBitsTest(1, 40, 288, 4, 32, false, false);
+  RunMatMulNBitsTest(3, 40, 288, 4, 32, true, false);
+  RunMatMulNBitsTest(2, 40, 288, 4, 64, true, true);
+}
+
+TEST(MatMulNBitsTest, Gemv8Bits) {
+  RunMatMulNBitsTest(1, 40, 288, 8, 32, false, false);
+  RunMatMulNBitsTest(4, 40, 288, 8, 128, true, true);
+}
+
+TEST(MatMulNBitsTest, PerChannel) {
+  RunMatMulNBitsTest(1, 16, 256, 4, 256, true, false);
+  RunMatMulNBitsTest(1, 16, 256, 8, 256, false, true);
+}
+
+TEST(MatMulNBitsTest, Gemm) {
+  RunMatMulNBitsTest(33, 40, 288, 4, 32, true, false);
+  RunMatMulNBitsTest(17, 40, 288, 8, 64, false, true);
+}
+
+#endif
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -33,8 +33,9 @@ void TestNhwcConvOp(const NhwcConvOpAndTestAttributes& attributes,
   bool enable_cuda = HasCudaEnvironment(min_cuda_architecture);
   bool enable_rocm = (nullptr != DefaultRocmExecutionProvider().get());
   bool enable_dml = (nullptr != DefaultDmlExecutionProvider().get());
+  bool enable_cpu = !use_float16;
 
-  if (enable_cuda || enable_rocm || enable_dml) {
+  if (enable_cuda || enable_rocm || enable_dml || enable_cpu) {
     OpTester test("NhwcConv", 1, onnxruntime::kMSDomain);
     test.AddAttribute("group", attributes.group);
     test.AddAttribute("kernel_shape", attributes.kernel_shape);
@@ -87,6 +88,10 @@ void TestNhwcConvOp(const NhwcConvOpAndTestAttributes& attributes,
       execution_providers.push_back(DefaultDmlExecutionProvider());
     }
 
+    if (enable_cpu) {
+      execution_providers.push_back(DefaultCpuExecutionProvider());
+    }
+
     test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
   }
 }
@@ -280,5 +285,33 @@ TEST(NhwcConvTest, Conv2D_asymmetric_padding2) {
   RunNhwcConv(attrs, {X, W, B}, {X_shape, W_shape, B_shape}, expected_vals, Y_shape);
 }
 
+TEST(NhwcConvTest, Conv2D_Group_Bias) {
+  NhwcConvOpAndTestAttributes attrs = {
+      "",                           // auto_pad
+      vector<int64_t>{1, 1},        // dilations
+      2,                            // group
+      vector<int64_t>{2, 2},        // kernel_shape
+      vector<int64_t>{1, 1, 1, 1},  // pads
+      vector<int64_t>{2, 2},        // strides
+      {}                            // excluded EPs
+  };
+
+  vector<float> X = {-3.0f, 0.0f, 3.0f, -1.0f, 2.0f, -2.0f, 1.0f, -3.0f, 0.0f, 3.0f, -1.0f, 2.0f,
+                     -2.0f, 1.0f, -3.0f, 0.0f, 3.0f, -1.0f, 2.0f, -2.0f, 1.0f, -3.0f, 0.0f, 3.0f,
+                     -1.0f, 2.0f, -2.0f, 1.0f, -3.0f, 0.0f, 3.0f, -1.0f, 2.0f, -2.0f, 1.0f, -3.0f};
+  vector<int64_t> X_shape = {1, 3, 3, 4};
+  vector<float> W = {-4.0f, 1.0f, -3.0f, 2.0f, -2.0f, 3.0f, -1.0f, 4.0f,
+                     0.0f, -4.0f, 1.0f, -3.0f, 2.0f, -2.0f, 3.0f, -1.0f,
+                     4.0f, 0.0f, -4.0f, 1.0f, -3.0f, 2.0f, -2.0f, 3.0f,
+                     -1.0f, 4.0f, 0.0f, -4.0f, 1.0f, -3.0f, 2.0f, -2.0f};
+  vector<int64_t> W_shape = {4, 2, 2, 2};
+  vector<float> B = {1.0f, -1.0f, 2.0f, 0.0f};
+  vector<int64_t> B_shape = {4};
+  vector<int64_t> Y_shape = {1, 2, 2, 4};
+  auto expected_vals = {4.0f, -10.0f, -7.0f, 8.0f, 3.0f, 4.0f, 1.0f, 4.0f,
+                        18.0f, -11.0f, 21.0f, -6.0f, -25.0f, 15.0f, -9.0f, -8.0f};
+  RunNhwcConv(attrs, {X, W, B}, {X_shape, W_shape, B_shape}, expected_vals, Y_shape);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
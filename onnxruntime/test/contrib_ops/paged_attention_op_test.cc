@@ -0,0 +1,151 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "test/common/tensor_op_test_utils.h"
+#include "test/providers/provider_test_utils.h"
+#include "test/util/include/default_providers.h"
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+std::vector<float> RandomData(size_t size, unsigned seed) {
+  std::default_random_engine generator(seed);
+  std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+  std::vector<float> data(size);
+  for (auto& v : data) {
+    v = distribution(generator);
+  }
+  return data;
+}
+}  // namespace
+
+// block_tables is (B, max_blocks_per_sequence). The reference works on the logical (contiguous) view of each
+// sequence and scatters it to the paged cache for the expected outputs.
+static void RunPagedAttentionTest(int batch_size, int sequence_length, int num_heads, int kv_num_heads, int head_size,
+                                  int num_blocks, int block_size, int max_blocks_per_sequence,
+                                  const std::vector<int32_t>& block_tables, const std::vector<int32_t>& past_seqlens) {
+  const int hidden_size = num_heads * head_size;
+  const int kv_hidden_size = kv_num_heads * head_size;
+  const size_t cache_size = static_cast<size_t>(num_blocks) * kv_num_heads * block_size * head_size;
+
+  std::vector<float> query = RandomData(static_cast<size_t>(batch_size) * sequence_length * hidden_size, 1);
+  std::vector<float> key = RandomData(static_cast<size_t>(batch_size) * sequence_length * kv_hidden_size, 2);
+  std::vector<float> value = RandomData(static_cast<size_t>(batch_size) * sequence_length * kv_hidden_size, 3);
+  std::vector<float> key_cache = RandomData(cache_size, 4);
+  std::vector<float> value_cache = RandomData(cache_size, 5);
+
+  auto cache_index = [&](int b, int kvh, int t) {
+    const int32_t block = block_tables[static_cast<size_t>(b) * max_blocks_per_sequence + t / block_size];
+    return ((static_cast<size_t>(block) * kv_num_heads + kvh) * block_size + t % block_size) * head_size;
+  };
+
+  std::vector<float> key_cache_out = key_cache;
+  std::vector<float> value_cache_out = value_cache;
+  for (int b = 0; b < batch_size; b++) {
+    for (int s = 0; s < sequence_length; s++) {
+      for (int kvh = 0; kvh < kv_num_heads; kvh++) {
+        const size_t src = (static_cast<size_t>(b) * sequence_length + s) * kv_hidden_size +
+                           static_cast<size_t>(kvh) * head_size;
+        const size_t dst = cache_index(b, kvh, past_seqlens[b] + s);
+        std::copy_n(key.begin() + src, head_size, key_cache_out.begin() + dst);
+        std::copy_n(value.begin() + src, head_size, value_cache_out.begin() + dst);
+      }
+    }
+  }
+
+  std::vector<float> output(query.size());
+  const float scale = 1.0f / std::sqrt(static_cast<float>(head_size));
+  for (int b = 0; b < batch_size; b++) {
+    for (int n = 0; n < num_heads; n++) {
+      const int kvh = n / (num_heads / kv_num_heads);
+      for (int s = 0; s < sequence_length; s++) {
+        const float* q = query.data() + (static_cast<size_t>(b) * sequence_length + s) * hidden_size + n * head_size;
+        const int length = past_seqlens[b] + s + 1;
+        std::vector<float> scores(length);
+        float max_score = -INFINITY;
+        for (int t = 0; t < length; t++) {
+          const float* k = key_cache_out.data() + cache_index(b, kvh, t);
+          float dot = 0.0f;
+          for (int h = 0; h < head_size; h++) {
+            dot += q[h] * k[h];
+          }
+          scores[t] = dot * scale;
+          max_score = std::max(max_score, scores[t]);
+        }
+        float sum = 0.0f;
+        for (auto& v : scores) {
+          v = std::exp(v - max_score);
+          sum += v;
+        }
+        float* out = output.data() + (static_cast<size_t>(b) * sequence_length + s) * hidden_size + n * head_size;
+        for (int t = 0; t < length; t++) {
+          const float* v = value_cache_out.data() + cache_index(b, kvh, t);
+          for (int h = 0; h < head_size; h++) {
+            out[h] += scores[t] / sum * v[h];
+          }
+        }
+      }
+    }
+  }
+
+  const std::vector<int64_t> cache_dims = {num_blocks, kv_num_heads, block_size, head_size};
+
+  OpTester test("PagedAttention", 1, kMSDomain);
+  test.AddAttribute<int64_t>("num_heads", num_heads);
+  test.AddAttribute<int64_t>("kv_num_heads", kv_num_heads);
+  test.AddInput<float>("query", {batch_size, sequence_length, hidden_size}, query);
+  test.AddInput<float>("key", {batch_size, sequence_length, kv_hidden_size}, key);
+  test.AddInput<float>("value", {batch_size, sequence_length, kv_hidden_size}, value);
+  test.AddInput<float>("key_cache", cache_dims, key_cache);
+  test.AddInput<float>("value_cache", cache_dims, value_cache);
+  test.AddInput<int32_t>("block_tables", {batch_size, max_blocks_per_sequence}, block_tables);
+  test.AddInput<int32_t>("past_seqlens", {batch_size}, past_seqlens);
+  test.AddOutput<float>("output", {batch_size, sequence_length, hidden_size}, output);
+  test.AddOutput<float>("key_cache_out", cache_dims, key_cache_out);
+  test.AddOutput<float>("value_cache_out", cache_dims, value_cache_out);
+  test.SetOutputAbsErr("output", 0.0001f);
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+
+TEST(PagedAttentionTest, Prompt) {
+  // Two sequences with non-contiguous blocks, the second one ends inside a block.
+  RunPagedAttentionTest(2, 6, 4, 2, 8, 8, 4, 2, {5, 1, 2, 7}, {0, 0});
+}
+
+TEST(PagedAttentionTest, Decode) {
+  RunPagedAttentionTest(3, 1, 4, 4, 16, 10, 2, 3, {9, 3, 0, 4, 8, 2, 6, 1, 0}, {5, 2, 3});
+  RunPagedAttentionTest(2, 1, 6, 2, 8, 6, 4, 3, {3, 0, 5, 1, 4, 2}, {11, 4});
+}
+
+TEST(PagedAttentionTest, InvalidBlock) {
+  OpTester test("PagedAttention", 1, kMSDomain);
+  test.AddAttribute<int64_t>("num_heads", 1);
+  test.AddAttribute<int64_t>("kv_num_heads", 1);
+  test.AddInput<float>("query", {1, 1, 2}, {1.0f, 1.0f});
+  test.AddInput<float>("key", {1, 1, 2}, {1.0f, 1.0f});
+  test.AddInput<float>("value", {1, 1, 2}, {1.0f, 1.0f});
+  test.AddInput<float>("key_cache", {2, 1, 2, 2}, std::vector<float>(8, 0.0f));
+  test.AddInput<float>("value_cache", {2, 1, 2, 2}, std::vector<float>(8, 0.0f));
+  test.AddInput<int32_t>("block_tables", {1, 2}, {0, 2});
+  test.AddInput<int32_t>("past_seqlens", {1}, {2});
+  test.AddOutput<float>("output", {1, 1, 2}, {0.0f, 0.0f});
+  test.AddOutput<float>("key_cache_out", {2, 1, 2, 2}, std::vector<float>(8, 0.0f));
+  test.AddOutput<float>("value_cache_out", {2, 1, 2, 2}, std::vector<float>(8, 0.0f));
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  test.Run(OpTester::ExpectResult::kExpectFailure, "is not a valid block", {}, nullptr, &execution_providers);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
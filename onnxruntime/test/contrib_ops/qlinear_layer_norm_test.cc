@@ -0,0 +1,118 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+// dequantizes X, normalizes the rows of norm_size elements and quantizes the result
+template <typename T>
+std::vector<T> QLinearLayerNormReference(const std::vector<T>& x, float x_scale, T x_zero_point,
+                                         const std::vector<float>& scale, const std::vector<float>& bias,
+                                         float y_scale, T y_zero_point, size_t norm_size, float epsilon) {
+  std::vector<T> y(x.size());
+  for (size_t row = 0; row < x.size() / norm_size; row++) {
+    std::vector<float> values(norm_size);
+    float mean = 0.0f;
+    for (size_t i = 0; i < norm_size; i++) {
+      values[i] = (static_cast<int32_t>(x[row * norm_size + i]) - static_cast<int32_t>(x_zero_point)) * x_scale;
+      mean += values[i];
+    }
+    mean /= norm_size;
+    float variance = 0.0f;
+    for (size_t i = 0; i < norm_size; i++) {
+      variance += (values[i] - mean) * (values[i] - mean);
+    }
+    variance /= norm_size;
+    const float inv_std_dev = 1.0f / std::sqrt(variance + epsilon);
+    for (size_t i = 0; i < norm_size; i++) {
+      const float normalized = (values[i] - mean) * inv_std_dev * scale[i] + (bias.empty() ? 0.0f : bias[i]);
+      const float quantized = std::nearbyint(normalized / y_scale) + static_cast<float>(y_zero_point);
+      y[row * norm_size + i] = static_cast<T>(std::clamp(quantized,
+                                                         static_cast<float>(std::numeric_limits<T>::min()),
+                                                         static_cast<float>(std::numeric_limits<T>::max())));
+    }
+  }
+  return y;
+}
+
+template <typename T>
+void RunQLinearLayerNorm(const std::vector<int64_t>& x_shape, int64_t axis, bool use_bias) {
+  constexpr float x_scale = 0.05f;
+  constexpr float y_scale = 0.02f;
+  constexpr float epsilon = 1e-5f;
+  const T x_zero_point = static_cast<T>(std::is_signed_v<T> ? -3 : 125);
+  const T y_zero_point = static_cast<T>(std::is_signed_v<T> ? 2 : 130);
+
+  const size_t rank = x_shape.size();
+  const size_t first_norm_dim = static_cast<size_t>(axis < 0 ? axis + static_cast<int64_t>(rank) : axis);
+  std::vector<int64_t> norm_shape(x_shape.begin() + first_norm_dim, x_shape.end());
+  size_t norm_size = 1;
+  for (int64_t dim : norm_shape) {
+    norm_size *= static_cast<size_t>(dim);
+  }
+  size_t x_size = 1;
+  for (int64_t dim : x_shape) {
+    x_size *= static_cast<size_t>(dim);
+  }
+
+  std::vector<T> x(x_size);
+  for (size_t i = 0; i < x_size; i++) {
+    x[i] = static_cast<T>(std::numeric_limits<T>::min() + static_cast<int>((i * 37) % 256));
+  }
+  std::vector<float> scale(norm_size);
+  std::vector<float> bias;
+  for (size_t i = 0; i < norm_size; i++) {
+    scale[i] = 0.5f + 0.1f * static_cast<float>(i % 7);
+    if (use_bias) {
+      bias.push_back(-0.3f + 0.05f * static_cast<float>(i % 11));
+    }
+  }
+
+  OpTester test("QLinearLayerNormalization", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<int64_t>("axis", axis);
+  test.AddAttribute<float>("epsilon", epsilon);
+  test.AddInput<T>("X", x_shape, x);
+  test.AddInput<float>("X_scale", {}, {x_scale}, true);
+  test.AddInput<T>("X_zero_point", {}, {x_zero_point}, true);
+  test.AddInput<float>("Scale", norm_shape, scale, true);
+  test.AddInput<float>("Y_scale", {}, {y_scale}, true);
+  test.AddInput<T>("Y_zero_point", {}, {y_zero_point}, true);
+  if (use_bias) {
+    test.AddInput<float>("B", norm_shape, bias, true);
+  } else {
+    test.AddOptionalInputEdge<float>();
+  }
+  test.AddOutput<T>("Y", x_shape,
+                    QLinearLayerNormReference<T>(x, x_scale, x_zero_point, scale, bias, y_scale, y_zero_point,
+                                                 norm_size, epsilon));
+  // the vectorized normalization may round a value to the neighboring quantized value
+  test.SetOutputAbsErr("Y", 1.0f);
+  test.Run();
+}
+
+TEST(QLinearLayerNormTest, LastAxis) {
+  RunQLinearLayerNorm<uint8_t>({2, 3, 16}, -1, true);
+  RunQLinearLayerNorm<int8_t>({2, 3, 16}, -1, true);
+}
+
+TEST(QLinearLayerNormTest, LastAxisNoBias) {
+  RunQLinearLayerNorm<uint8_t>({4, 37}, -1, false);
+  RunQLinearLayerNorm<int8_t>({4, 37}, -1, false);
+}
+
+TEST(QLinearLayerNormTest, MultipleNormalizedDims) {
+  RunQLinearLayerNorm<uint8_t>({3, 4, 5}, 1, true);
+  RunQLinearLayerNorm<int8_t>({3, 4, 5}, 1, true);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
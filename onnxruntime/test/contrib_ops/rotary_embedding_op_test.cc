@@ -0,0 +1,111 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "test/common/tensor_op_test_utils.h"
+#include "test/providers/provider_test_utils.h"
+#include "test/util/include/default_providers.h"
+
+namespace onnxruntime {
+namespace test {
+
+// position_ids holds either one start position or one position per token.
+static void RunRotaryEmbeddingTest(int batch_size, int sequence_length, int num_heads, int head_size,
+                                   int max_sequence_length, const std::vector<int64_t>& position_ids,
+                                   bool interleaved, bool transposed) {
+  const int hidden_size = num_heads * head_size;
+  const int half_head_size = head_size / 2;
+
+  std::default_random_engine generator(static_cast<unsigned>(hidden_size * sequence_length));
+  std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+  std::vector<float> input(static_cast<size_t>(batch_size) * sequence_length * hidden_size);
+  for (auto& v : input) {
+    v = distribution(generator);
+  }
+
+  std::vector<float> cos_cache(static_cast<size_t>(max_sequence_length) * half_head_size);
+  std::vector<float> sin_cache(cos_cache.size());
+  for (int p = 0; p < max_sequence_length; p++) {
+    for (int i = 0; i < half_head_size; i++) {
+      const float angle = p * std::pow(10000.0f, -2.0f * i / head_size);
+      cos_cache[p * half_head_size + i] = std::cos(angle);
+      sin_cache[p * half_head_size + i] = std::sin(angle);
+    }
+  }
+
+  std::vector<float> output(input.size());
+  for (int b = 0; b < batch_size; b++) {
+    for (int s = 0; s < sequence_length; s++) {
+      const int64_t position = position_ids.size() == 1 ? position_ids[0] + s
+                                                        : position_ids[static_cast<size_t>(b) * sequence_length + s];
+      const float* c = cos_cache.data() + position * half_head_size;
+      const float* sn = sin_cache.data() + position * half_head_size;
+      for (int n = 0; n < num_heads; n++) {
+        const size_t offset = transposed ? ((static_cast<size_t>(b) * num_heads + n) * sequence_length + s) * head_size
+                                         : ((static_cast<size_t>(b) * sequence_length + s) * num_heads + n) * head_size;
+        for (int i = 0; i < half_head_size; i++) {
+          const size_t i0 = offset + (interleaved ? 2 * i : i);
+          const size_t i1 = offset + (interleaved ? 2 * i + 1 : i + half_head_size);
+          output[i0] = input[i0] * c[i] - input[i1] * sn[i];
+          output[i1] = input[i1] * c[i] + input[i0] * sn[i];
+        }
+      }
+    }
+  }
+
+  std::vector<int64_t> input_dims = transposed
+                                        ? std::vector<int64_t>{batch_size, num_heads, sequence_length, head_size}
+                                        : std::vector<int64_t>{batch_size, sequence_length, hidden_size};
+  std::vector<int64_t> position_ids_dims = position_ids.size() == 1
+                                               ? std::vector<int64_t>{1}
+                                               : std::vector<int64_t>{batch_size, sequence_length};
+
+  OpTester test("RotaryEmbedding", 1, kMSDomain);
+  test.AddAttribute<int64_t>("interleaved", interleaved ? 1 : 0);
+  test.AddInput<float>("input", input_dims, input);
+  test.AddInput<int64_t>("position_ids", position_ids_dims, position_ids);
+  test.AddInput<float>("cos_cache", {max_sequence_length, half_head_size}, cos_cache);
+  test.AddInput<float>("sin_cache", {max_sequence_length, half_head_size}, sin_cache);
+  test.AddOutput<float>("output", input_dims, output);
+  test.SetOutputAbsErr("output", 0.00001f);
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+
+TEST(RotaryEmbeddingTest, PositionPerToken) {
+  RunRotaryEmbeddingTest(2, 3, 2, 16, 8, {0, 1, 2, 5, 6, 7}, false, false);
+  RunRotaryEmbeddingTest(2, 3, 2, 16, 8, {0, 1, 2, 5, 6, 7}, true, false);
+}
+
+TEST(RotaryEmbeddingTest, StartPosition) {
+  // Decoding one token at position 9.
+  RunRotaryEmbeddingTest(1, 1, 4, 64, 16, {9}, false, false);
+  RunRotaryEmbeddingTest(3, 4, 3, 10, 16, {2}, true, false);
+}
+
+TEST(RotaryEmbeddingTest, TransposedInput) {
+  RunRotaryEmbeddingTest(2, 5, 3, 8, 8, {1}, false, true);
+  RunRotaryEmbeddingTest(1, 2, 2, 32, 4, {3, 0}, true, true);
+}
+
+TEST(RotaryEmbeddingTest, PositionOutOfRange) {
+  OpTester test("RotaryEmbedding", 1, kMSDomain);
+  test.AddInput<float>("input", {1, 2, 4}, std::vector<float>(8, 0.0f));
+  test.AddInput<int64_t>("position_ids", {1}, {3});
+  test.AddInput<float>("cos_cache", {4, 2}, std::vector<float>(8, 1.0f));
+  test.AddInput<float>("sin_cache", {4, 2}, std::vector<float>(8, 0.0f));
+  test.AddOutput<float>("output", {1, 2, 4}, std::vector<float>(8, 0.0f));
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  test.Run(OpTester::ExpectResult::kExpectFailure, "out of range", {}, nullptr, &execution_providers);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -1,11 +1,19 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
+#include <cmath>
 #include <memory>
+#include <numeric>
+#include <random>
 #include <vector>
 #include "gtest/gtest.h"
 #include "core/common/gsl.h"
+#include "core/providers/cpu/generator/random.h"
+#include "core/providers/cpu/math/softmax_shared.h"
 #include "core/session/onnxruntime_cxx_api.h"
+#include "contrib_ops/cpu/transformers/generation_shared.h"
+#include "contrib_ops/cpu/transformers/sampling_cpu_helper.h"
 #include "test/common/cuda_op_test_utils.h"
 
 extern std::unique_ptr<Ort::Env> ort_env;
@@ -156,5 +164,61 @@ TEST(SamplingTest, Gpt2Sampling_CPU) {
   ASSERT_TRUE(std::equal(expected_output.cbegin(), expected_output.cend(), result_span.begin(), result_span.end()));
 }
 #endif
+
+// Compares the radix select top-p filter with a filter that sorts the whole vocabulary.
+static void RunTopPFilterTest(float top_p, size_t min_tokens_to_keep, bool custom_sampling) {
+  constexpr size_t vocab_size = 5000;
+  constexpr float filter_value = -10000.0f;
+
+  std::mt19937 generator(static_cast<uint32_t>(vocab_size + min_tokens_to_keep));
+  std::normal_distribution<float> distribution(0.0f, 3.0f);
+  std::vector<float> scores(vocab_size);
+  for (float& score : scores) {
+    score = distribution(generator);
+  }
+
+  const float max_score = *std::max_element(scores.begin(), scores.end());
+  std::vector<float> probs(vocab_size);
+  float sum = 0.0f;
+  for (size_t i = 0; i < vocab_size; i++) {
+    probs[i] = std::exp(scores[i] - max_score);
+    sum += probs[i];
+  }
+  for (float& prob : probs) {
+    prob /= sum;
+  }
+
+  std::vector<size_t> order(vocab_size);
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [&probs](size_t i1, size_t i2) { return probs[i1] > probs[i2]; });
+  std::vector<float> expected(vocab_size, filter_value);
+  float mass_above = 0.0f;
+  for (size_t rank = 0; rank < vocab_size; rank++) {
+    const bool in_nucleus = custom_sampling ? mass_above <= top_p : mass_above < top_p;
+    if (in_nucleus || rank < min_tokens_to_keep) {
+      expected[order[rank]] = scores[order[rank]];
+    }
+    mass_above += probs[order[rank]];
+  }
+
+  contrib::SamplingCpuHelper::top_p_filter_row<float>(gsl::make_span(scores), gsl::make_span(probs), top_p,
+                                                      filter_value, min_tokens_to_keep, custom_sampling);
+
+  // the sums of the two filters may round differently for the token right at the boundary
+  size_t num_mismatches = 0;
+  for (size_t i = 0; i < vocab_size; i++) {
+    num_mismatches += scores[i] != expected[i] ? 1 : 0;
+  }
+  EXPECT_LE(num_mismatches, size_t{1});
+}
+
+TEST(SamplingTest, TopPFilter) {
+  RunTopPFilterTest(0.6f, 0, false);
+  RunTopPFilterTest(0.95f, 1, false);
+  RunTopPFilterTest(0.01f, 20, false);
+  RunTopPFilterTest(0.6f, 1, true);
+  RunTopPFilterTest(1.0f, 1, true);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
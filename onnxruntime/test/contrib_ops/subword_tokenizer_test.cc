@@ -0,0 +1,63 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "gtest/gtest.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+TEST(ContribOpTest, WordPieceTokenizer) {
+  OpTester test("WordPieceTokenizer", 1, onnxruntime::kMSDomain);
+  test.AddAttribute("vocab", std::vector<std::string>{"[PAD]", "[UNK]", "un", "##aff", "##able",
+                                                      "hello", "world", "!", ",", "##s"});
+
+  test.AddInput<std::string>("X", {2}, {"unaffable hello, world!", "hellos  xyz"});
+  test.AddOutput<int64_t>("Y", {2, 7},
+                          {2, 3, 4, 5, 8, 6, 7,
+                           5, 9, 1, 0, 0, 0, 0});
+  test.AddOutput<int64_t>("mask", {2, 7},
+                          {1, 1, 1, 1, 1, 1, 1,
+                           1, 1, 1, 0, 0, 0, 0});
+  test.Run();
+}
+
+TEST(ContribOpTest, WordPieceTokenizer_LongWord) {
+  OpTester test("WordPieceTokenizer", 1, onnxruntime::kMSDomain);
+  test.AddAttribute("vocab", std::vector<std::string>{"[UNK]", "un", "##aff", "##able"});
+  test.AddAttribute("max_input_chars_per_word", int64_t{5});
+
+  test.AddInput<std::string>("X", {1}, {"unaffable un"});
+  test.AddOutput<int64_t>("Y", {1, 2}, {0, 1});
+  test.Run();
+}
+
+TEST(ContribOpTest, BpeTokenizer) {
+  OpTester test("BpeTokenizer", 1, onnxruntime::kMSDomain);
+  test.AddAttribute("vocab", std::vector<std::string>{"<unk>", "l", "o", "w", "e", "r", "lo", "low", "er", "lower"});
+  test.AddAttribute("merges", std::vector<std::string>{"l o", "lo w", "e r", "low er"});
+  test.AddAttribute("unk_token", std::string("<unk>"));
+  test.AddAttribute("pad_id", int64_t{-1});
+
+  // "lowx" merges to "low" and an unknown character
+  test.AddInput<std::string>("X", {2}, {"lower low lowx", "er"});
+  test.AddOutput<int64_t>("Y", {2, 4},
+                          {9, 7, 7, 0,
+                           8, -1, -1, -1});
+  test.Run();
+}
+
+TEST(ContribOpTest, BpeTokenizer_EndOfWordSuffix) {
+  OpTester test("BpeTokenizer", 1, onnxruntime::kMSDomain);
+  test.AddAttribute("vocab", std::vector<std::string>{"a", "b", "b</w>", "ab</w>"});
+  test.AddAttribute("merges", std::vector<std::string>{"a b</w>"});
+  test.AddAttribute("end_of_word_suffix", std::string("</w>"));
+
+  // without unk_token, "a</w>" which is not in vocab is dropped
+  test.AddInput<std::string>("X", {2}, {"ab", "ba"});
+  test.AddOutput<int64_t>("Y", {2, 1}, {3, 1});
+  test.Run();
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -6,6 +6,7 @@
 #include <fstream>
 
 #include "gtest/gtest.h"
+#include "nlohmann/json.hpp"
 
 #include "core/framework/tensorprotoutils.h"
 #include "core/platform/env.h"
@@ -72,5 +73,35 @@ TEST(DebugNodeInputsOutputs, BasicFileOutput) {
   tester.Run();
 }
 
+// The collector is used directly because the node dump options are read from the environment once per process.
+TEST(DebugNodeInputsOutputs, CalibrationCollector) {
+  TemporaryDirectory temp_dir{ORT_TSTR("debug_node_inputs_outputs_calibration_test")};
+  const OrtMemoryInfo cpu_memory_info(CPU, OrtAllocatorType::OrtDeviceAllocator);
+
+  std::vector<float> first{-1.0f, 0.5f, 1.0f};
+  std::vector<float> second{3.0f};
+  Tensor first_tensor(DataTypeImpl::GetType<float>(), TensorShape({3}), first.data(), cpu_memory_info);
+  Tensor second_tensor(DataTypeImpl::GetType<float>(), TensorShape({1}), second.data(), cpu_memory_info);
+
+  utils::CalibrationCollector collector(4);
+  collector.Collect("x", first_tensor, 1);
+  // a tensor is counted once per step
+  collector.Collect("x", first_tensor, 1);
+  // the threshold grows from 1 to 3.5, by 5 bins of width 0.5 on each side
+  collector.Collect("x", second_tensor, 2);
+
+  ASSERT_STATUS_OK(collector.Write(Path::Parse(temp_dir.Path()), ""));
+
+  std::ifstream table_stream{temp_dir.Path() + ORT_TSTR("/calibration.json")};
+  const auto table = nlohmann::json::parse(table_stream);
+  EXPECT_EQ(table["x"], nlohmann::json::parse("[-1.0, 3.0]"));
+
+  std::ifstream histogram_stream{temp_dir.Path() + ORT_TSTR("/calibration_histogram.json")};
+  const auto histograms = nlohmann::json::parse(histogram_stream);
+  EXPECT_EQ(histograms["x"]["threshold"].get<double>(), 3.5);
+  EXPECT_EQ(histograms["x"]["histogram"].get<std::vector<int64_t>>(),
+            (std::vector<int64_t>{0, 0, 0, 0, 0, 1, 0, 0, 2, 0, 0, 0, 0, 1}));
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -371,6 +371,9 @@ class PlannerTest : public ::testing::Test {
   void SetNodePartitionConfigFilePath(const char* config_file_path) {
     ORT_THROW_IF_ERROR(sess_options_->config_options.AddConfigEntry(kNodePartitionConfigFile, config_file_path));
   }
+  void AddConfigEntry(const char* config_key, const char* config_value) {
+    ORT_THROW_IF_ERROR(sess_options_->config_options.AddConfigEntry(config_key, config_value));
+  }
   std::unique_ptr<::onnxruntime::KernelDef>& GetStdKernel() { return std_kernel_; }
 #ifdef USE_CUDA
   void MemcpyToHostInCuda_TransposeInCudaAndCpu(const char* partitionConfigFile = nullptr) {
@@ -500,6 +503,34 @@ TEST_F(PlannerTest, InPlaceTest) {
   CheckFreed(2, {X1});
 }
 
+// BufferReuseStatsTest: Check that the plan counts the in-place reused buffers.
+TEST_F(PlannerTest, BufferReuseStatsTest) {
+  // tensor variables:
+  std::string X1("X1"), X2("X2"), X3("X3"), X4("X4");
+
+  // graph structure:
+  AddNormalNode(X1, X2);   // no in-place operator; X1: input; X2: temporary
+  AddInplaceNode(X2, X3);  // may-in-place operator; X3: temporary
+  AddNormalNode(X3, X4);   // no in-place operator; X4: output
+
+  // simulate shape-inference results:
+  Shape shape1{2, 8};
+  auto shape = &shape1.value;
+  SetShape({{X1, shape}, {X2, shape}, {X3, shape}, {X4, shape}});
+
+  CreatePlan();
+
+  CheckAllocKind(X2, AllocKind::kAllocate);
+  CheckAllocKind(X3, AllocKind::kReuse);
+
+  const auto& stats = GetPlan().buffer_reuse_stats;
+  EXPECT_EQ(stats.num_allocated, 1u);
+  EXPECT_EQ(stats.num_reused, 0u);
+  EXPECT_EQ(stats.num_inplace_reused, 1u);
+  EXPECT_EQ(stats.allocated_bytes, 2 * 8 * sizeof(float));
+  EXPECT_EQ(stats.inplace_reused_bytes, 2 * 8 * sizeof(float));
+}
+
 TEST_F(PlannerTest, ExternalOutputsTest) {
   // tensor variables:
   std::string X1("X1"), X2("X2"), X3("X3"), X4("X4");
@@ -613,6 +644,73 @@ TEST_F(PlannerTest, MayStridedTest3) {
   CheckFreed(1, {X1});
   CheckFreed(2, {});
 }
+
+// MayStridedImplicitInputTest: the output of a Transpose consumed by an If through its subgraphs is not a strided
+// view, as the kernels of the subgraphs are not checked for strided inputs.
+TEST(AllocationPlannerTest, MayStridedImplicitInputTest) {
+  TypeProto float_tensor;
+  float_tensor.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(3);
+
+  TypeProto transposed_tensor;
+  transposed_tensor.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  transposed_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(3);
+  transposed_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+
+  TypeProto bool_scalar;
+  bool_scalar.mutable_tensor_type()->set_elem_type(TensorProto_DataType_BOOL);
+  bool_scalar.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+
+  auto create_if_subgraph = [&transposed_tensor](bool is_then) -> GraphProto {
+    Model model("if_branch_subgraph", true, DefaultLoggingManager().DefaultLogger());
+    auto& graph = model.MainGraph();
+
+    auto& outer_scope = graph.GetOrCreateNodeArg("transpose_out", &transposed_tensor);
+    graph.AddOuterScopeNodeArg("transpose_out");
+
+    auto& if_out = graph.GetOrCreateNodeArg(is_then ? "if_then_out" : "if_else_out", &transposed_tensor);
+    graph.AddNode("if_out", is_then ? "Abs" : "Neg", "branch", {&outer_scope}, {&if_out});
+
+    EXPECT_STATUS_OK(graph.Resolve());
+    return graph.ToGraphProto();
+  };
+
+  onnxruntime::Model model("main_graph", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+                           {{kOnnxDomain, 13}}, {}, DefaultLoggingManager().DefaultLogger());
+  auto& main_graph = model.MainGraph();
+
+  auto& transpose_in = main_graph.GetOrCreateNodeArg("transpose_in", &float_tensor);
+  auto& transpose_out = main_graph.GetOrCreateNodeArg("transpose_out", &transposed_tensor);
+  main_graph.AddNode("transpose", "Transpose", "node transpose", {&transpose_in}, {&transpose_out});
+
+  auto& cond = main_graph.GetOrCreateNodeArg("cond", &bool_scalar);
+  auto& if_out = main_graph.GetOrCreateNodeArg("if_out", &transposed_tensor);
+  auto& if_node = main_graph.AddNode("if", "If", "If with transpose_out as implicit input", {&cond}, {&if_out});
+  if_node.AddAttribute("then_branch", create_if_subgraph(true));
+  if_node.AddAttribute("else_branch", create_if_subgraph(false));
+
+  main_graph.SetInputs({&transpose_in, &cond});
+  main_graph.SetOutputs({&if_out});
+  ASSERT_STATUS_OK(main_graph.Resolve());
+
+  SessionOptions so;
+  so.graph_optimization_level = TransformerLevel::Default;
+  InferenceSession sess{so, GetEnvironment()};
+
+  std::string model_str;
+  ASSERT_TRUE(model.ToProto().SerializeToString(&model_str));
+  std::stringstream model_stream(model_str);
+  ASSERT_STATUS_OK(sess.Load(model_stream));
+  ASSERT_STATUS_OK(sess.Initialize());
+
+  const auto& session_state = sess.GetSessionState();
+  OrtValueIndex transpose_out_index;
+  ASSERT_STATUS_OK(session_state.GetOrtValueNameIdxMap().GetIdx("transpose_out", transpose_out_index));
+  const auto& plan = session_state.GetExecutionPlan()->allocation_plan[transpose_out_index];
+  EXPECT_FALSE(plan.is_strided_tensor);
+  EXPECT_NE(plan.alloc_kind, AllocKind::kReuse);
+}
 #endif
 
 // InPlaceSizeMismatchTest: Check that Inplace reuse is not allowed when sizes don't match.
@@ -681,6 +779,146 @@ TEST_F(PlannerTest, PlanOutputTest) {
   }
 }
 
+// ConcatInPlaceTest: the inputs of a Concat that it is the only consumer of may be placed in its output.
+TEST_F(PlannerTest, ConcatInPlaceTest) {
+  std::unique_ptr<::onnxruntime::KernelDef> concat_kernel =
+      KernelDefBuilder().SetName("Concat").Provider(kCpuExecutionProvider).SinceVersion(4, 10).Build();
+  std::string X1("X1"), X2("X2"), X3("X3"), X4("X4"), X5("X5"), concat_node("concat_node");
+  std::vector<onnxruntime::NodeArg*> concat_inputs{Arg(X2), Arg(X3)}, concat_outputs{Arg(X4)};
+
+  // graph structure:
+  AddNormalNode(X1, X2);  // X2: also consumed by node producing X5
+  AddNormalNode(X1, X3);  // X3: only consumed by the Concat
+  AddNormalNode(X2, X5);
+  AddNode(*concat_kernel, concat_node, concat_inputs, concat_outputs)->AddAttribute("axis", int64_t{1});
+
+  AddConfigEntry(kOrtSessionOptionsConfigConcatInPlace, "1");
+  CreatePlan({}, false);
+
+  const auto& plan = *GetState().GetExecutionPlan();
+  const auto& name_idx_map = GetState().GetOrtValueNameIdxMap();
+  int x2_index, x3_index, x4_index;
+  ASSERT_STATUS_OK(name_idx_map.GetIdx(X2, x2_index));
+  ASSERT_STATUS_OK(name_idx_map.GetIdx(X3, x3_index));
+  ASSERT_STATUS_OK(name_idx_map.GetIdx(X4, x4_index));
+
+  ASSERT_EQ(plan.concats_in_place.size(), 1u);
+  const auto& concat = plan.concats_in_place[0];
+  EXPECT_EQ(concat.output, x4_index);
+  EXPECT_EQ(concat.axis, 1);
+  ASSERT_EQ(concat.inputs.size(), 2u);
+  EXPECT_EQ(concat.inputs[0], x2_index);
+  EXPECT_EQ(concat.inputs[1], x3_index);
+
+  ASSERT_EQ(plan.concat_in_place_inputs.size(), 1u);
+  EXPECT_EQ(plan.concat_in_place_inputs.count(x3_index), 1u);
+  EXPECT_EQ(plan.allocation_plan[x3_index].alloc_kind, AllocKind::kAllocate);
+  EXPECT_EQ(plan.allocation_plan[x4_index].alloc_kind, AllocKind::kAllocateOutput);
+}
+
+// LeanProgramTest: a plan with a single CPU stream is flattened into the nodes and the values released after them.
+TEST_F(PlannerTest, LeanProgramTest) {
+  // tensor variables:
+  std::string X1("X1"), X2("X2"), X3("X3"), X4("X4");
+
+  // graph structure:
+  AddNormalNode(X1, X2);
+  AddNormalNode(X2, X3);
+  AddNormalNode(X3, X4);
+
+  AddConfigEntry(kOrtSessionOptionsConfigLeanExecution, "1");
+  CreatePlan({}, false);
+
+  const auto& plan = *GetState().GetExecutionPlan();
+  ASSERT_TRUE(plan.lean_program.has_value());
+  const auto& program = *plan.lean_program;
+  ASSERT_EQ(program.instructions.size(), 3u);
+
+  const auto& name_idx_map = GetState().GetOrtValueNameIdxMap();
+  int x2_index, x3_index;
+  ASSERT_STATUS_OK(name_idx_map.GetIdx(X2, x2_index));
+  ASSERT_STATUS_OK(name_idx_map.GetIdx(X3, x3_index));
+  const std::vector<std::vector<OrtValueIndex>> expected_released{{}, {x2_index}, {x3_index}};
+  for (size_t i = 0; i < program.instructions.size(); ++i) {
+    const auto& instruction = program.instructions[i];
+    const std::vector<OrtValueIndex> released(program.released_values.begin() + instruction.release_begin,
+                                              program.released_values.begin() + instruction.release_end);
+    EXPECT_EQ(released, expected_released[i]) << "instruction " << i;
+  }
+}
+
+// HostShapeProgramTest: a Shape -> Gather -> Unsqueeze -> Concat chain computing a shape from the shape of a graph
+// input and constant initializers is evaluated on the host, its outputs get buffers of their own.
+TEST_F(PlannerTest, HostShapeProgramTest) {
+  std::unique_ptr<::onnxruntime::KernelDef> shape_kernel =
+      KernelDefBuilder().SetName("Shape").Provider(kCpuExecutionProvider).SinceVersion(1, 12).Build();
+  std::unique_ptr<::onnxruntime::KernelDef> gather_kernel =
+      KernelDefBuilder().SetName("Gather").Provider(kCpuExecutionProvider).SinceVersion(1, 10).Build();
+  std::unique_ptr<::onnxruntime::KernelDef> unsqueeze_kernel =
+      KernelDefBuilder().SetName("Unsqueeze").Provider(kCpuExecutionProvider).SinceVersion(1, 10).Build();
+  std::unique_ptr<::onnxruntime::KernelDef> concat_kernel =
+      KernelDefBuilder().SetName("Concat").Provider(kCpuExecutionProvider).SinceVersion(4, 10).Build();
+
+  TypeProto int64_tensor;
+  int64_tensor.mutable_tensor_type()->set_elem_type(TensorProto_DataType_INT64);
+  auto& graph = GetGraph();
+  std::string X("X"), shape_node("shape_node"), gather_node("gather_node"), unsqueeze_node("unsqueeze_node"),
+      concat_node("concat_node"), Y("Y"), Z("Z");
+  auto* shape = &graph.GetOrCreateNodeArg("S", &int64_tensor);
+  auto* indices = &graph.GetOrCreateNodeArg("I", &int64_tensor);
+  auto* gathered = &graph.GetOrCreateNodeArg("G", &int64_tensor);
+  auto* unsqueezed = &graph.GetOrCreateNodeArg("U", &int64_tensor);
+  auto* constant = &graph.GetOrCreateNodeArg("C", &int64_tensor);
+  graph.GetOrCreateNodeArg(Y, &int64_tensor);
+  graph.GetOrCreateNodeArg(Z, &int64_tensor);
+
+  ONNX_NAMESPACE::TensorProto indices_tensor;
+  indices_tensor.add_int64_data(1);
+  indices_tensor.set_data_type(TensorProto_DataType_INT64);
+  indices_tensor.set_name("I");
+  graph.AddInitializedTensor(indices_tensor);
+  ONNX_NAMESPACE::TensorProto constant_tensor;
+  constant_tensor.add_dims(1);
+  constant_tensor.add_int64_data(-1);
+  constant_tensor.set_data_type(TensorProto_DataType_INT64);
+  constant_tensor.set_name("C");
+  graph.AddInitializedTensor(constant_tensor);
+
+  // graph structure: Y = Concat(Unsqueeze(Gather(Shape(X), I)), C), Z = Transpose(Y)
+  std::vector<onnxruntime::NodeArg*> shape_inputs{Arg(X)}, shape_outputs{shape};
+  std::vector<onnxruntime::NodeArg*> gather_inputs{shape, indices}, gather_outputs{gathered};
+  std::vector<onnxruntime::NodeArg*> unsqueeze_inputs{gathered}, unsqueeze_outputs{unsqueezed};
+  std::vector<onnxruntime::NodeArg*> concat_inputs{unsqueezed, constant}, concat_outputs{Arg(Y)};
+  AddNode(*shape_kernel, shape_node, shape_inputs, shape_outputs);
+  AddNode(*gather_kernel, gather_node, gather_inputs, gather_outputs);
+  AddNode(*unsqueeze_kernel, unsqueeze_node, unsqueeze_inputs, unsqueeze_outputs)
+      ->AddAttribute("axes", std::vector<int64_t>{0});
+  AddNode(*concat_kernel, concat_node, concat_inputs, concat_outputs)->AddAttribute("axis", int64_t{0});
+  AddNormalNode(Y, Z);
+
+  AddConfigEntry(kOrtSessionOptionsConfigHostShapeEvaluation, "1");
+  CreatePlan({}, false);
+
+  const auto& plan = *GetState().GetExecutionPlan();
+  ASSERT_TRUE(plan.host_shape_program.has_value());
+  using HostShapeOp = SequentialExecutionPlan::HostShapeProgram::Op;
+  const auto& instructions = plan.host_shape_program->instructions;
+  ASSERT_EQ(instructions.size(), 4u);
+  EXPECT_EQ(instructions[0].op, HostShapeOp::kShape);
+  EXPECT_EQ(instructions[1].op, HostShapeOp::kGather);
+  EXPECT_EQ(instructions[2].op, HostShapeOp::kUnsqueeze);
+  ASSERT_TRUE(instructions[2].axes.has_value());
+  EXPECT_EQ(instructions[2].axes->size(), 1u);
+  EXPECT_EQ(instructions[3].op, HostShapeOp::kConcat);
+
+  const auto& name_idx_map = GetState().GetOrtValueNameIdxMap();
+  for (const char* name : {"S", "G", "U", "Y"}) {
+    int value_index;
+    ASSERT_STATUS_OK(name_idx_map.GetIdx(name, value_index));
+    EXPECT_EQ(plan.allocation_plan[value_index].alloc_kind, AllocKind::kAllocate) << name;
+  }
+}
+
 #ifdef USE_CUDA
 TEST_F(PlannerTest, LocationPlanningForPassThroughExplicitAndImplicitSubgraphInputs) {
   // Types
@@ -1284,6 +1522,50 @@ TEST_F(PlannerTest, MultiStream1StreamWaitFor2Streams) {
   EXPECT_NE(strstr(typeid(*GetState().GetExecutionPlan()->execution_plan[2]->steps_[4]).name(), "LaunchKernelStep"), nullptr) << "4th step: LaunchKernelStep for node 3";
 }
 
+// Same graph as above without a partition config file: with up to 4 streams per device,
+// node2 starts a stream of its own and node3 continues the stream of node1.
+TEST_F(PlannerTest, MultiStreamAutoPartition) {
+  std::unique_ptr<::onnxruntime::KernelDef> cudaKernel = KernelDefBuilder().SetName("Transpose").Provider(kCudaExecutionProvider).SinceVersion(1, 10).Build();
+  std::unique_ptr<::onnxruntime::KernelDef> cudaKernelAdd = KernelDefBuilder().SetName("Add").Provider(kCudaExecutionProvider).SinceVersion(1, 10).Build();
+  std::string Graph_input("Graph_input"), Arg1("Arg1"), Arg2("Arg2"), Arg3("Arg3"), node1("node1"), node2("node2"), node3("node3");
+  std::vector<onnxruntime::NodeArg*> input1{Arg(Graph_input)}, output1{Arg(Arg1)}, output2{Arg(Arg2)}, input3{Arg(Arg1), Arg(Arg2)}, output3{Arg(Arg3)};
+  AddNode(*cudaKernel, node1, input1, output1);
+  AddNode(*cudaKernel, node2, input1, output2);
+  AddNode(*cudaKernelAdd, node3, input3, output3);
+
+  CUDAExecutionProviderInfo epi;
+  onnxruntime::ProviderInfo_CUDA& ep = onnxruntime::GetProviderInfo_CUDA();
+  auto epFactory = ep.CreateExecutionProviderFactory(epi);
+  std::unique_ptr<IExecutionProvider> execution_provider = epFactory->CreateProvider();
+  ORT_THROW_IF_ERROR(GetExecutionProviders().Add("CUDAExecutionProvider", std::move(execution_provider)));
+
+  AddConfigEntry(kOrtSessionOptionsConfigMaxStreamsPerDevice, "4");
+  CreatePlan({}, false);
+
+  const auto& execution_plan = GetState().GetExecutionPlan()->execution_plan;
+  ASSERT_EQ(execution_plan.size(), 2) << "2 logic streams";
+  EXPECT_EQ(execution_plan[0]->device_.Type(), OrtDevice::GPU);
+  EXPECT_EQ(execution_plan[1]->device_.Type(), OrtDevice::GPU);
+  EXPECT_EQ(execution_plan[0]->steps_.front()->GetNodeIndex(), 0) << "stream 0 starts with node 1";
+  EXPECT_EQ(execution_plan[0]->steps_.back()->GetNodeIndex(), 2) << "stream 0 ends with node 3";
+  EXPECT_EQ(execution_plan[1]->steps_.front()->GetNodeIndex(), 1) << "stream 1 starts with node 2";
+}
+
+// Same graph as below without a partition config file: with memcpy streams,
+// node1 (MemcpyToHost) gets a copy stream apart from node3 on the compute stream of CUDA EP.
+TEST_F(PlannerTest, MultiStreamMemcpyStream) {
+  AddConfigEntry(kOrtSessionOptionsConfigMemcpyStreams, "1");
+  MemcpyToHostInCuda_TransposeInCudaAndCpu();
+  const auto& execution_plan = GetState().GetExecutionPlan()->execution_plan;
+  ASSERT_EQ(execution_plan.size(), 3) << "3 logic streams";
+  EXPECT_EQ(execution_plan[0]->device_.Type(), OrtDevice::GPU) << "stream 0 is the copy stream";
+  EXPECT_EQ(execution_plan[0]->steps_.front()->GetNodeIndex(), 0) << "stream 0 starts with node 1";
+  EXPECT_EQ(execution_plan[1]->device_.Type(), OrtDevice::CPU);
+  EXPECT_EQ(execution_plan[1]->steps_.back()->GetNodeIndex(), 1) << "stream 1 ends with node 2";
+  EXPECT_EQ(execution_plan[2]->device_.Type(), OrtDevice::GPU) << "stream 2 is the compute stream";
+  EXPECT_EQ(execution_plan[2]->steps_.back()->GetNodeIndex(), 2) << "stream 2 ends with node 3";
+}
+
 // Test execution plan for the graph:
 // stream 0: node1 (MemcpyToHost, CUDA EP) -> node3 (Transpose, CUDA EP)
 // stream 1: node2 (CPU EP)
@@ -1961,6 +2243,91 @@ TEST_F(PlannerTest, TestCpuIf) {
     ASSERT_TRUE(exe_plan[1]->steps_[6]->ToString().substr(0, WaitOnEPStep.size()) == WaitOnEPStep);
   }
 }
+
+TEST_F(PlannerTest, ConcurrentSubgraphStreams) {
+  // An `If` node whose branches each have two independent Abs nodes. With the
+  // concurrent subgraph streams option, the CUDA stream of each branch is split in two.
+  TypeProto float_tensor;
+  float_tensor.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_param("dim_param");
+
+  TypeProto bool_scalar;
+  bool_scalar.mutable_tensor_type()->set_elem_type(TensorProto_DataType_BOOL);
+  bool_scalar.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+
+  auto create_model = [&float_tensor, &bool_scalar]() -> Model {
+    auto create_if_subgraph = [&float_tensor](bool is_then) -> GraphProto {
+      Model model("if_branch_subgraph", true, DefaultLoggingManager().DefaultLogger());
+      auto& graph = model.MainGraph();
+
+      auto& outer_scope_0 = graph.GetOrCreateNodeArg("data_0", &float_tensor);
+      graph.AddOuterScopeNodeArg("data_0");
+      auto& outer_scope_1 = graph.GetOrCreateNodeArg("data_1", &float_tensor);
+      graph.AddOuterScopeNodeArg("data_1");
+
+      const std::string prefix = is_then ? "then" : "else";
+      auto& out_0 = graph.GetOrCreateNodeArg(prefix + "_out_0", &float_tensor);
+      auto& out_1 = graph.GetOrCreateNodeArg(prefix + "_out_1", &float_tensor);
+      graph.AddNode(prefix + "_abs_0", "Abs", "abs", {&outer_scope_0}, {&out_0});
+      graph.AddNode(prefix + "_abs_1", "Abs", "abs", {&outer_scope_1}, {&out_1});
+
+      auto status = graph.Resolve();
+      EXPECT_EQ(status, Status::OK());
+
+      return graph.ToGraphProto();
+    };
+
+    onnxruntime::Model model("main_graph", false, ModelMetaData(),
+                             PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+                             {{kOnnxDomain, 12}}, {}, DefaultLoggingManager().DefaultLogger());
+    auto& main_graph = model.MainGraph();
+
+    auto& data_0 = main_graph.GetOrCreateNodeArg("data_0", &float_tensor);
+    auto& data_1 = main_graph.GetOrCreateNodeArg("data_1", &float_tensor);
+    auto& if_in = main_graph.GetOrCreateNodeArg("if_in", &bool_scalar);
+    auto& if_out_0 = main_graph.GetOrCreateNodeArg("if_out_0", &float_tensor);
+    auto& if_out_1 = main_graph.GetOrCreateNodeArg("if_out_1", &float_tensor);
+    auto& node = main_graph.AddNode("if", "If", "If", {&if_in}, {&if_out_0, &if_out_1});
+    node.AddAttribute("then_branch", create_if_subgraph(true));
+    node.AddAttribute("else_branch", create_if_subgraph(false));
+
+    main_graph.SetInputs({&data_0, &data_1, &if_in});
+    main_graph.SetOutputs({&if_out_0, &if_out_1});
+
+    auto status = main_graph.Resolve();
+    EXPECT_EQ(status, Status::OK());
+
+    return model;
+  };
+
+  SessionOptions so;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigConcurrentSubgraphStreams, "1"));
+  InferenceSession sess{so, GetEnvironment()};
+  ASSERT_STATUS_OK(sess.RegisterExecutionProvider(DefaultCudaExecutionProvider()));
+
+  std::string s1;
+  ASSERT_TRUE(create_model().ToProto().SerializeToString(&s1));
+  std::stringstream sstr(s1);
+  ASSERT_STATUS_OK(sess.Load(sstr));
+  ASSERT_STATUS_OK(sess.Initialize());
+
+  const auto& main_graph_session_state = sess.GetSessionState();
+  EXPECT_FALSE(main_graph_session_state.GetExecutionPlan()->concurrent_subgraph_streams);
+
+  const SessionState* then_session_state = main_graph_session_state.GetSubgraphSessionState(0, "then_branch");
+  ASSERT_NE(then_session_state, nullptr);
+  const auto* then_plan = then_session_state->GetExecutionPlan();
+  EXPECT_TRUE(then_plan->concurrent_subgraph_streams);
+
+  size_t gpu_streams = 0;
+  for (const auto& stream : then_plan->execution_plan) {
+    if (stream->device_.Type() == OrtDevice::GPU) {
+      EXPECT_FALSE(stream->steps_.empty());
+      ++gpu_streams;
+    }
+  }
+  EXPECT_EQ(gpu_streams, 2u);
+}
 #endif
 }  // namespace test
 }  // namespace onnxruntime
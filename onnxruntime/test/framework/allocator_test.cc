@@ -31,6 +31,22 @@ TEST(AllocatorTest, CPUAllocatorTest) {
   cpu_arena->Free(bytes);
   // todo: test the used / max api.
 }
+
+TEST(AllocatorTest, CPUAllocatorWithHugePagesTest) {
+  CPUAllocator allocator(OrtMemoryInfo(CPU, OrtAllocatorType::OrtDeviceAllocator), true);
+  for (size_t size : {size_t{1024}, size_t{4 * 1024 * 1024 + 1}}) {
+    auto bytes = allocator.Alloc(size);
+    ASSERT_NE(bytes, nullptr);
+    memset(bytes, -1, size);
+#if defined(__linux__) && !defined(USE_MIMALLOC)
+    // buffers of at least a huge page start at a huge page boundary
+    if (size >= 2 * 1024 * 1024) {
+      EXPECT_EQ(reinterpret_cast<uintptr_t>(bytes) % (2 * 1024 * 1024), 0u);
+    }
+#endif
+    allocator.Free(bytes);
+  }
+}
 #if defined(_MSC_VER) && !defined(__clang__)
 #pragma warning(disable : 26400)
 #endif
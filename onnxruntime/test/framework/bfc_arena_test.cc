@@ -5,7 +5,9 @@
 #include "core/framework/allocator_utils.h"
 #include "gtest/gtest.h"
 #include "gmock/gmock.h"
+#include <chrono>
 #include <cstdlib>
+#include <thread>
 #include "core/framework/stream_handles.h"
 
 namespace onnxruntime {
@@ -303,6 +305,109 @@ TEST(BFCArenaTest, TestShrink) {
   EXPECT_EQ(stats.total_allocated_bytes, 10 * 1024 * 1024) << "Expect 10M bytes but actually " << stats.total_allocated_bytes << " bytes";
 }
 
+TEST(BFCArenaTest, TrimIdleRegions) {
+  constexpr int64_t kTrimWindowMs = 50;
+  AllocatorStats stats;
+  BFCArena a(std::unique_ptr<IAllocator>(new CPUAllocator()), 1 << 30, ArenaExtendStrategy::kSameAsRequested,
+             BFCArena::DEFAULT_INITIAL_CHUNK_SIZE_BYTES, BFCArena::DEFAULT_MAX_DEAD_BYTES_PER_CHUNK,
+             BFCArena::DEFAULT_INITIAL_GROWTH_CHUNK_SIZE_BYTES, BFCArena::DEFAULT_MAX_POWER_OF_TWO_EXTEND_BYTES,
+             BFCArena::DEFAULT_MAX_THREAD_CACHE_BYTES, kTrimWindowMs);
+  void* p1k = a.Alloc(1024);
+  void* p10M = a.Alloc(10 * 1024 * 1024);
+  a.Free(p10M);
+
+  // the window that ended had 10M in use, nothing is trimmed
+  std::this_thread::sleep_for(std::chrono::milliseconds(2 * kTrimWindowMs));
+  a.Free(p1k);
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.num_arena_extensions, 2);
+  EXPECT_EQ(stats.num_arena_shrinkages, 0);
+
+  // the peak of the last window fits in the 1K region
+  std::this_thread::sleep_for(std::chrono::milliseconds(2 * kTrimWindowMs));
+  p1k = a.Alloc(1024);
+  a.Free(p1k);
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.num_arena_extensions, 1);
+  EXPECT_EQ(stats.num_arena_shrinkages, 1);
+  EXPECT_EQ(stats.total_allocated_bytes, 1024);
+}
+
+TEST(BFCArenaTest, ThreadCacheReusesChunks) {
+  BFCArena a(std::unique_ptr<IAllocator>(new CPUAllocator()), 1 << 30, ArenaExtendStrategy::kSameAsRequested,
+             BFCArena::DEFAULT_INITIAL_CHUNK_SIZE_BYTES, BFCArena::DEFAULT_MAX_DEAD_BYTES_PER_CHUNK,
+             BFCArena::DEFAULT_INITIAL_GROWTH_CHUNK_SIZE_BYTES, BFCArena::DEFAULT_MAX_POWER_OF_TWO_EXTEND_BYTES,
+             4096);
+  void* p1 = a.Alloc(1024);
+  void* p2 = a.Alloc(1024);
+  a.Free(p1);
+  CheckStats(&a, 2, 1024, 2048, 1024);
+
+  // same rounded size, served from the cache of this thread
+  void* p3 = a.Alloc(1000);
+  EXPECT_EQ(p3, p1);
+  CheckStats(&a, 3, 2048, 2048, 1024);
+  EXPECT_EQ(a.AllocatedSize(p3), 1024u);
+
+  // larger than the budget of the cache, returned to the bins right away
+  void* large = a.Alloc(8192);
+  a.Free(large);
+  void* p4 = a.Alloc(256);
+  a.Free(p4);
+  a.Free(p3);
+  a.Free(p2);
+  CheckStats(&a, 5, 0, 10240, 8192);
+
+  // the cached chunks are returned before shrinking
+  EXPECT_EQ(a.Shrink(), Status::OK());
+  AllocatorStats stats;
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.total_allocated_bytes, 0);
+  EXPECT_EQ(stats.bytes_in_use, 0);
+}
+
+TEST(BFCArenaTest, ThreadCacheConcurrentAllocations) {
+  BFCArena a(std::unique_ptr<IAllocator>(new CPUAllocator()), 1 << 30, ArenaExtendStrategy::kSameAsRequested,
+             BFCArena::DEFAULT_INITIAL_CHUNK_SIZE_BYTES, BFCArena::DEFAULT_MAX_DEAD_BYTES_PER_CHUNK,
+             BFCArena::DEFAULT_INITIAL_GROWTH_CHUNK_SIZE_BYTES, BFCArena::DEFAULT_MAX_POWER_OF_TWO_EXTEND_BYTES,
+             64 * 1024);
+  constexpr int kNumThreads = 4;
+  constexpr int kNumIterations = 1000;
+  // chunks allocated by one thread are freed by the next one
+  std::vector<std::vector<void*>> ptrs(kNumThreads);
+  for (int t = 0; t < kNumThreads; ++t) {
+    for (int i = 0; i < 16; ++i) {
+      ptrs[t].push_back(a.Alloc(256 * (i + 1)));
+    }
+  }
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kNumThreads; ++t) {
+    threads.emplace_back([&a, &ptrs, t]() {
+      for (auto* p : ptrs[(t + 1) % kNumThreads]) {
+        a.Free(p);
+      }
+      for (int i = 0; i < kNumIterations; ++i) {
+        const size_t size = 256 * (i % 300 + 1);
+        auto* p = static_cast<char*>(a.Alloc(size));
+        ASSERT_NE(p, nullptr);
+        p[0] = p[size - 1] = static_cast<char>(t);
+        a.Free(p);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  AllocatorStats stats;
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.bytes_in_use, 0);
+  EXPECT_EQ(stats.num_allocs, kNumThreads * (16 + kNumIterations));
+  EXPECT_EQ(a.Shrink(), Status::OK());
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.total_allocated_bytes, 0);
+}
+
 class BadAllocator : public IAllocator {
  public:
   BadAllocator() : IAllocator(OrtMemoryInfo(CPU, OrtAllocatorType::OrtDeviceAllocator)) {}
@@ -8,6 +8,7 @@
 #include "core/graph/model.h"
 #include "core/providers/cpu/cpu_execution_provider.h"
 #include "core/session/inference_session.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 #include "test_utils.h"
 #include "test/test_environment.h"
 #include "test/framework/TestAllocatorManager.h"
@@ -330,6 +331,100 @@ TEST_F(ExecutionFrameTest, MemPatternTest) {
   ASSERT_EQ(p->GetBlock(4)->offset_, kAllocAlignment);
 }
 
+TEST_F(ExecutionFrameTest, SymbolicMemoryPlanTest) {
+  auto cpu_xp = CreateCPUExecutionProvider();
+  auto xp_type = cpu_xp->Type();
+  std::unordered_map<std::string, int> domain_to_version;
+  domain_to_version[onnxruntime::kOnnxDomain] = 7;
+  onnxruntime::Model model("test", true, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+                           domain_to_version, {}, DefaultLoggingManager().DefaultLogger());
+  onnxruntime::Graph& graph = model.MainGraph();
+  TypeProto tensor_float;
+  tensor_float.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  TypeProto batch_by_4(tensor_float);
+  batch_by_4.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_param("batch");
+  batch_by_4.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(4);
+  TypeProto four_by_4(tensor_float);
+  four_by_4.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(4);
+  four_by_4.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(4);
+  // the shapes of T1 and T2 are inferred as {batch, 4}
+  onnxruntime::NodeArg x_def("X", &batch_by_4),
+      w_def("W", &four_by_4),
+      t1_def("T1", &tensor_float),
+      t2_def("T2", &tensor_float),
+      y_def("Y", &tensor_float);
+
+  graph.AddNode("node1", "MatMul", "gemm1", ArgMap{&x_def, &w_def}, ArgMap{&t1_def})
+      .SetExecutionProviderType(xp_type);
+  graph.AddNode("node2", "MatMul", "gemm2", ArgMap{&t1_def, &w_def}, ArgMap{&t2_def})
+      .SetExecutionProviderType(xp_type);
+  graph.AddNode("node3", "MatMul", "gemm3", ArgMap{&t2_def, &w_def}, ArgMap{&y_def})
+      .SetExecutionProviderType(xp_type);
+
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  KernelRegistryManager kernel_registry_manager;
+
+  ExecutionProviders execution_providers;
+  ASSERT_STATUS_OK(execution_providers.Add(xp_type, std::move(cpu_xp)));
+  ASSERT_STATUS_OK(kernel_registry_manager.RegisterKernels(execution_providers));
+
+  DataTransferManager dtm;
+  profiling::Profiler profiler;
+
+  SessionOptions sess_options;
+  sess_options.enable_mem_pattern = true;
+  sess_options.execution_mode = ExecutionMode::ORT_SEQUENTIAL;
+  sess_options.use_deterministic_compute = false;
+  sess_options.enable_mem_reuse = true;
+  ASSERT_STATUS_OK(sess_options.config_options.AddConfigEntry(kOrtSessionOptionsConfigSymbolicMemoryPlanning, "1"));
+
+  SessionState state(graph, execution_providers, &tp_, nullptr, dtm,
+                     DefaultLoggingManager().DefaultLogger(), profiler, sess_options);
+
+  ASSERT_STATUS_OK(state.FinalizeSessionState(ORT_TSTR(""), kernel_registry_manager));
+  ASSERT_TRUE(state.GetExecutionPlan()->symbolic_memory_plan.has_value());
+
+  const OrtValueNameIdxMap& mlvalue_name_idx_map(state.GetOrtValueNameIdxMap());
+  int x_idx = -1, w_idx = -1, t1_idx = -1, t2_idx = -1;
+  ASSERT_STATUS_OK(mlvalue_name_idx_map.GetIdx("X", x_idx));
+  ASSERT_STATUS_OK(mlvalue_name_idx_map.GetIdx("W", w_idx));
+  ASSERT_STATUS_OK(mlvalue_name_idx_map.GetIdx("T1", t1_idx));
+  ASSERT_STATUS_OK(mlvalue_name_idx_map.GetIdx("T2", t2_idx));
+
+  auto cpu_allocator = execution_providers.Get(xp_type)->CreatePreferredAllocators()[0];
+  OrtValue w;
+  CreateMLValue<float>(cpu_allocator, std::vector<int64_t>{4, 4}, std::vector<float>(16, 1.0f), &w);
+
+  // the memory patterns are generated without a traced Run for every batch size
+  for (int64_t batch : {3, 100}) {
+    OrtValue x;
+    CreateMLValue<float>(cpu_allocator, std::vector<int64_t>{batch, 4},
+                         std::vector<float>(static_cast<size_t>(batch * 4), 1.0f), &x);
+    std::vector<OrtValue> feeds{x, w};
+    std::shared_ptr<const InlinedHashMap<int, TensorShape>> inferred_shapes;
+    auto mem_patterns = state.GetMemoryPatternGroup(feeds, AsSpan({x_idx, w_idx}), inferred_shapes);
+    ASSERT_NE(mem_patterns, nullptr);
+
+    auto p = mem_patterns->GetPatterns(cpu_allocator->Info().device);
+    ASSERT_NE(p, nullptr);
+    size_t size = 0;
+    ASSERT_TRUE(IAllocator::CalcMemSizeForArrayWithAlignment<kAllocAlignment>(static_cast<size_t>(batch * 4),
+                                                                              sizeof(float), &size));
+    // T1 is still in use when T2 is allocated
+    ASSERT_NE(p->GetBlock(t1_idx), nullptr);
+    ASSERT_NE(p->GetBlock(t2_idx), nullptr);
+    EXPECT_EQ(p->GetBlock(t1_idx)->size_, size);
+    EXPECT_EQ(p->GetBlock(t2_idx)->size_, size);
+    EXPECT_EQ(p->GetBlock(t1_idx)->offset_, 0u);
+    EXPECT_EQ(p->GetBlock(t2_idx)->offset_, size);
+    EXPECT_EQ(p->PeakSize(), 2 * size);
+
+    // the generated patterns are cached
+    EXPECT_EQ(state.GetMemoryPatternGroup(feeds, AsSpan({x_idx, w_idx}), inferred_shapes), mem_patterns);
+  }
+}
+
 #ifdef ENABLE_TRAINING
 TEST_F(ExecutionFrameTest, MemPatternWithExternalOutputsTest) {
   auto cpu_xp = CreateCPUExecutionProvider();
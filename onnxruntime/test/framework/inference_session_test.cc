@@ -13,15 +13,19 @@
 
 #include <google/protobuf/io/zero_copy_stream_impl.h>
 #include "core/common/denormal.h"
+#include "core/common/hardware_counters.h"
 #include "core/common/logging/logging.h"
+#include "core/common/metrics.h"
 #include "core/common/logging/sinks/clog_sink.h"
 #include "core/common/profiler.h"
 #include "core/framework/compute_capability.h"
 #include "core/framework/data_transfer_manager.h"
 #include "core/framework/execution_provider.h"
 #include "core/framework/kernel_registry.h"
+#include "core/framework/nvtx_ranges.h"
 #include "core/framework/op_kernel.h"
 #include "core/framework/session_state.h"
+#include "core/framework/shared_initializer_store.h"
 #include "core/framework/tensorprotoutils.h"
 #include "core/framework/bfc_arena.h"
 #include "core/graph/graph_viewer.h"
@@ -797,6 +801,138 @@ TEST(InferenceSessionTests, CheckRunProfilerStartTime) {
   ASSERT_TRUE(before_start_time <= profiling_start_time && profiling_start_time <= after_start_time);
 }
 
+TEST(InferenceSessionTests, CheckRunProfilerWithMemoryProfiling) {
+  SessionOptions so;
+
+  so.session_logid = "CheckRunProfiler";
+  so.enable_profiling = true;
+  so.profile_file_prefix = ORT_TSTR("onnxprofile_profile_test");
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigProfileMemory, "1"));
+
+  InferenceSession session_object(so, GetEnvironment());
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  RunOptions run_options;
+  run_options.run_tag = "RunTag";
+
+  RunModel(session_object, run_options);
+  std::string profile_file = session_object.EndProfiling();
+
+  std::ifstream profile(profile_file);
+  ASSERT_TRUE(profile);
+  std::string line;
+  bool has_node_memory = false;
+  bool has_live_memory = false;
+  while (std::getline(profile, line)) {
+    if (line.find("_memory\"") != string::npos && line.find("\"allocated_bytes\"") != string::npos &&
+        line.find("\"freed_bytes\"") != string::npos) {
+      has_node_memory = true;
+    }
+    if (line.find("\"live_memory\"") != string::npos) {
+      // counter events with numeric values
+      ASSERT_TRUE(line.find(R"("ph" : "C")") != string::npos);
+      ASSERT_TRUE(line.find(R"("live_bytes" : )") != string::npos);
+      ASSERT_TRUE(line.find(R"("live_bytes" : ")") == string::npos);
+      has_live_memory = true;
+    }
+  }
+  ASSERT_TRUE(has_node_memory);
+  ASSERT_TRUE(has_live_memory);
+}
+
+TEST(InferenceSessionTests, CheckRunProfilerWithHardwareCounters) {
+  SessionOptions so;
+
+  so.session_logid = "CheckRunProfiler";
+  so.enable_profiling = true;
+  so.profile_file_prefix = ORT_TSTR("onnxprofile_profile_test");
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigProfileHardwareCounters, "1"));
+
+  InferenceSession session_object(so, GetEnvironment());
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  RunOptions run_options;
+  run_options.run_tag = "RunTag";
+
+  RunModel(session_object, run_options);
+  std::string profile_file = session_object.EndProfiling();
+
+  // the counters are not available on every machine, e.g. in virtual machines or with perf events not allowed
+  profiling::HardwareCounterValues values;
+  const bool has_counters = profiling::ReadThreadHardwareCounters(values);
+
+  std::ifstream profile(profile_file);
+  ASSERT_TRUE(profile);
+  std::string line;
+  bool has_node_counters = false;
+  while (std::getline(profile, line)) {
+    if (line.find("_hardware_counters\"") != string::npos) {
+      ASSERT_TRUE(line.find("\"instructions_per_cycle\"") != string::npos);
+      ASSERT_TRUE(line.find("\"llc_misses\"") != string::npos);
+      has_node_counters = true;
+    }
+  }
+  ASSERT_EQ(has_node_counters, has_counters);
+}
+
+TEST(InferenceSessionTests, CheckRunProfilerWithRoofline) {
+  SessionOptions so;
+
+  so.session_logid = "CheckRunProfiler";
+  so.enable_profiling = true;
+  so.profile_file_prefix = ORT_TSTR("onnxprofile_profile_test");
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigProfileRoofline, "1"));
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigProfilePeakGflops, "100"));
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigProfilePeakMemoryBandwidth, "10"));
+
+  InferenceSession session_object(so, GetEnvironment());
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  RunOptions run_options;
+  run_options.run_tag = "RunTag";
+
+  RunModel(session_object, run_options);
+  std::string profile_file = session_object.EndProfiling();
+
+  std::ifstream profile(profile_file);
+  ASSERT_TRUE(profile);
+  std::string line;
+  bool has_roofline = false;
+  while (std::getline(profile, line)) {
+    if (line.find("_roofline\"") != string::npos) {
+      // the model multiplies two tensors of 6 elements
+      ASSERT_TRUE(line.find(R"("flops" : "6")") != string::npos);
+      ASSERT_TRUE(line.find(R"("bytes" : "72")") != string::npos);
+      ASSERT_TRUE(line.find("\"peak_gflops_ratio\"") != string::npos);
+      ASSERT_TRUE(line.find("\"peak_gbytes_per_second_ratio\"") != string::npos);
+      has_roofline = true;
+    }
+  }
+  ASSERT_TRUE(has_roofline);
+}
+
+TEST(InferenceSessionTests, NvtxRanges) {
+  SessionOptions so;
+
+  so.session_logid = "InferenceSessionTests.NvtxRanges";
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigNvtxRanges, "1"));
+
+  {
+    InferenceSession session_object(so, GetEnvironment());
+    ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+    ASSERT_STATUS_OK(session_object.Initialize());
+
+    RunOptions run_options;
+    RunModel(session_object, run_options);
+  }
+
+  // the ranges are disabled again once the sessions enabling them are destroyed
+  ASSERT_FALSE(profiling::NvtxRanges::IsEnabled());
+}
+
 TEST(InferenceSessionTests, MultipleSessionsNoTimeout) {
   SessionOptions session_options;
 
@@ -982,6 +1118,76 @@ TEST(InferenceSessionTests, TestBindCpu) {
                  false /* don't preallocate output */);
 }
 
+TEST(InferenceSessionTests, EarlyExit) {
+  // exit_logits = Relu(X), exit_flag = Cast<bool>(exit_logits), deep_out = X * Cast<float>(Not(exit_flag))
+  // deep_out depends on the predicate, so it is always computed after it.
+  onnxruntime::Model model("early_exit", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+                           {{kOnnxDomain, 13}}, {}, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  TypeProto float_tensor;
+  float_tensor.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+  TypeProto bool_tensor;
+  bool_tensor.mutable_tensor_type()->set_elem_type(TensorProto_DataType_BOOL);
+  bool_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+
+  auto& x = graph.GetOrCreateNodeArg("X", &float_tensor);
+  auto& exit_logits = graph.GetOrCreateNodeArg("exit_logits", &float_tensor);
+  auto& exit_flag = graph.GetOrCreateNodeArg("exit_flag", &bool_tensor);
+  auto& not_exit = graph.GetOrCreateNodeArg("not_exit", &bool_tensor);
+  auto& scale = graph.GetOrCreateNodeArg("scale", &float_tensor);
+  auto& deep_out = graph.GetOrCreateNodeArg("deep_out", &float_tensor);
+
+  graph.AddNode("head", "Relu", "exit head", {&x}, {&exit_logits});
+  graph.AddNode("predicate", "Cast", "early exit predicate", {&exit_logits}, {&exit_flag})
+      .AddAttribute("to", int64_t{TensorProto_DataType_BOOL});
+  graph.AddNode("not", "Not", "deep path", {&exit_flag}, {&not_exit});
+  graph.AddNode("cast", "Cast", "deep path", {&not_exit}, {&scale})
+      .AddAttribute("to", int64_t{TensorProto_DataType_FLOAT});
+  graph.AddNode("mul", "Mul", "deep path", {&x, &scale}, {&deep_out});
+  graph.SetOutputs({&exit_logits, &exit_flag, &deep_out});
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  std::string serialized_model;
+  model.ToProto().SerializeToString(&serialized_model);
+  std::stringstream model_stream(serialized_model);
+
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.EarlyExit";
+  InferenceSession session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load(model_stream));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  RunOptions run_options;
+  ASSERT_STATUS_OK(run_options.config_options.AddConfigEntry(kOrtRunOptionsConfigEarlyExitValue, "exit_flag"));
+  std::vector<std::string> output_names{"exit_logits", "exit_flag", "deep_out"};
+
+  // the predicate is true, the deep path is skipped
+  OrtValue x_value;
+  CreateMLValue<float>(TestCPUExecutionProvider()->CreatePreferredAllocators()[0], {1}, {2.f}, &x_value);
+  NameMLValMap feeds{{"X", x_value}};
+  std::vector<OrtValue> fetches;
+  ASSERT_STATUS_OK(session_object.Run(run_options, feeds, output_names, &fetches));
+  VerifyOutputs<float>(fetches[0].Get<Tensor>(), {1}, {2.f});
+  VerifyOutputs<bool>(fetches[1].Get<Tensor>(), {1}, {true});
+  ASSERT_FALSE(fetches[2].IsAllocated());
+
+  // the predicate is false, the run completes
+  CreateMLValue<float>(TestCPUExecutionProvider()->CreatePreferredAllocators()[0], {1}, {-2.f}, &x_value);
+  feeds = {{"X", x_value}};
+  fetches.clear();
+  ASSERT_STATUS_OK(session_object.Run(run_options, feeds, output_names, &fetches));
+  VerifyOutputs<bool>(fetches[1].Get<Tensor>(), {1}, {false});
+  VerifyOutputs<float>(fetches[2].Get<Tensor>(), {1}, {-2.f});
+
+  // the predicate must be produced by a node
+  RunOptions invalid_run_options;
+  ASSERT_STATUS_OK(invalid_run_options.config_options.AddConfigEntry(kOrtRunOptionsConfigEarlyExitValue, "X"));
+  fetches.clear();
+  ASSERT_FALSE(session_object.Run(invalid_run_options, feeds, output_names, &fetches).IsOK());
+}
+
 TEST(InferenceSessionTests, TestIOBindingReuse) {
   SessionOptions so;
   InferenceSession session_object(so, GetEnvironment());
@@ -1020,6 +1226,51 @@ TEST(InferenceSessionTests, TestIOBindingReuse) {
   }
 }
 
+TEST(InferenceSessionTests, TestIOBindingState) {
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.TestIOBindingState";
+  InferenceSession session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  unique_ptr<IOBinding> io_binding;
+  ASSERT_STATUS_OK(session_object.NewIOBinding(&io_binding));
+
+  // Y = X * W with W = {1, 2, ..., 6}, so feeding Y back to X raises W to one more power each run
+  std::vector<float> values_x = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+  OrtValue ml_value_x;
+  CreateMLValue<float>(TestCPUExecutionProvider()->CreatePreferredAllocators()[0], {3, 2}, values_x, &ml_value_x);
+  ASSERT_STATUS_OK(io_binding->BindInput("X", ml_value_x));
+  ASSERT_STATUS_OK(io_binding->BindState("Y", "X"));
+
+  const void* buffers[3];
+  for (int run = 0; run < 3; ++run) {
+    ASSERT_STATUS_OK(session_object.Run(*io_binding));
+    buffers[run] = io_binding->GetOutputs()[0].Get<Tensor>().DataRaw();
+  }
+
+  auto span = io_binding->GetOutputs()[0].Get<Tensor>().DataAsSpan<float>();
+  ASSERT_EQ(static_cast<size_t>(span.size()), values_x.size());
+  for (size_t i = 0; i < values_x.size(); ++i) {
+    const float w = values_x[i];
+    EXPECT_EQ(span[i], w * w * w * w);
+  }
+
+  // the buffer bound by the user is left untouched and the states alternate between two buffers
+  EXPECT_EQ(ml_value_x.Get<Tensor>().Data<float>()[5], 6.0f);
+  EXPECT_NE(buffers[0], buffers[1]);
+  EXPECT_NE(buffers[1], ml_value_x.Get<Tensor>().DataRaw());
+  EXPECT_EQ(buffers[2], buffers[0]);
+
+  // binding the input again restarts the state
+  ASSERT_STATUS_OK(io_binding->BindInput("X", ml_value_x));
+  ASSERT_STATUS_OK(session_object.Run(*io_binding));
+  span = io_binding->GetOutputs()[0].Get<Tensor>().DataAsSpan<float>();
+  for (size_t i = 0; i < values_x.size(); ++i) {
+    EXPECT_EQ(span[i], values_x[i] * values_x[i]);
+  }
+}
+
 TEST(InferenceSessionTests, InvalidInputTypeOfTensorElement) {
   SessionOptions so;
 
@@ -2060,6 +2311,62 @@ TEST(InferenceSessionTests, TestStrictShapeInference) {
              excluded_provider_types);
 }
 
+TEST(InferenceSessionTests, DynamicBatching) {
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.DynamicBatching";
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigDynamicBatchingMaxBatchSize, "8"));
+  // Long enough for all the threads below to join the first batch.
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigDynamicBatchingMaxDelayUs, "200000"));
+
+  InferenceSession session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load(ORT_TSTR("testdata/abs_free_dimensions.onnx")));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  // x has shape [batch, channel, 5] and y = Abs(x).
+  constexpr int num_requests = 4;
+  const std::vector<int64_t> batch_sizes = {1, 2, 1, 3};
+  const std::vector<std::string> feed_names = {"x"};
+  const std::vector<std::string> output_names = {"y"};
+
+  std::vector<Status> statuses(num_requests);
+  std::vector<std::vector<OrtValue>> fetches(num_requests);
+  std::vector<std::vector<float>> inputs(num_requests);
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < num_requests; ++i) {
+    std::vector<int64_t> dims = {batch_sizes[i], 2, 5};
+    inputs[i].resize(static_cast<size_t>(batch_sizes[i] * 2 * 5));
+    for (size_t j = 0; j < inputs[i].size(); ++j) {
+      inputs[i][j] = -static_cast<float>(i * 100 + j);
+    }
+    threads.emplace_back([&, i, dims]() {
+      OrtValue x;
+      CreateMLValue<float>(TestCPUExecutionProvider()->CreatePreferredAllocators()[0], dims, inputs[i], &x);
+      std::vector<OrtValue> feeds = {x};
+      statuses[i] = session_object.Run(RunOptions{}, feed_names, feeds, output_names, &fetches[i]);
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+
+  for (int i = 0; i < num_requests; ++i) {
+    ASSERT_STATUS_OK(statuses[i]);
+    std::vector<float> expected(inputs[i].size());
+    std::transform(inputs[i].begin(), inputs[i].end(), expected.begin(), [](float v) { return std::abs(v); });
+    VerifyOutputs(fetches[i], {batch_sizes[i], 2, 5}, expected);
+  }
+
+  // Requests with a different inner shape are not merged with the others but still succeed.
+  std::vector<float> values(3 * 5, -1.0f);
+  OrtValue x;
+  CreateMLValue<float>(TestCPUExecutionProvider()->CreatePreferredAllocators()[0], {1, 3, 5}, values, &x);
+  std::vector<OrtValue> feeds = {x};
+  std::vector<OrtValue> single_fetches;
+  ASSERT_STATUS_OK(session_object.Run(RunOptions{}, feed_names, feeds, output_names, &single_fetches));
+  VerifyOutputs(single_fetches, {1, 3, 5}, std::vector<float>(3 * 5, 1.0f));
+}
+
 #ifdef USE_CUDA
 // disable it, since we are going to enable parallel execution with cuda ep
 TEST(InferenceSessionTests, DISABLED_TestParallelExecutionWithCudaProvider) {
@@ -2792,6 +3099,189 @@ TEST(InferenceSessionTests, InitializerSharing_EnsureSessionsUseUserAddedInitial
   }
 }
 
+TEST(InferenceSessionTests, InitializerSharing_ByContent) {
+  auto logging_manager = std::make_unique<logging::LoggingManager>(
+      std::unique_ptr<ISink>(new CLogSink()), logging::Severity::kVERBOSE, false,
+      LoggingManager::InstanceType::Temporal);
+
+  std::unique_ptr<Environment> env;
+  ASSERT_STATUS_OK(Environment::Create(std::move(logging_manager), env));
+
+  const char* init_name = "W";
+  auto get_init_buffer = [init_name](const InferenceSessionTestSharingInitializer& sess) {
+    int idx;
+    ORT_THROW_IF_ERROR(sess.GetSessionState().GetOrtValueNameIdxMap().GetIdx(init_name, idx));
+    return sess.GetSessionState().GetInitializedTensors().at(idx).Get<Tensor>().Data<float>();
+  };
+
+  SessionOptions so;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigShareInitializersByContent, "1"));
+  {
+    InferenceSessionTestSharingInitializer sess1(so, *env);
+    ASSERT_STATUS_OK(sess1.Load(MODEL_URI));
+    ASSERT_STATUS_OK(sess1.Initialize());
+
+    InferenceSessionTestSharingInitializer sess2(so, *env);
+    ASSERT_STATUS_OK(sess2.Load(MODEL_URI));
+    ASSERT_STATUS_OK(sess2.Initialize());
+
+    SessionOptions so3;
+    InferenceSessionTestSharingInitializer sess3(so3, *env);
+    ASSERT_STATUS_OK(sess3.Load(MODEL_URI));
+    ASSERT_STATUS_OK(sess3.Initialize());
+
+    // the sessions that enable sharing use a single copy of the initializer
+    ASSERT_EQ(get_init_buffer(sess1), get_init_buffer(sess2));
+    ASSERT_NE(get_init_buffer(sess1), get_init_buffer(sess3));
+    ASSERT_EQ(env->GetSharedInitializerStore().GetNumberOfElements(), static_cast<size_t>(1));
+
+    RunModel(sess2, RunOptions{});
+  }
+
+  // the initializer is released with the last session using it
+  ASSERT_EQ(env->GetSharedInitializerStore().GetNumberOfElements(), static_cast<size_t>(0));
+}
+
+TEST(InferenceSessionTests, InvalidMemoryBudget) {
+  SessionOptions so;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsMemoryBudgetBytes, "1MB"));
+  InferenceSession session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  auto status = session_object.Initialize();
+  ASSERT_EQ(status.Code(), common::INVALID_ARGUMENT);
+  EXPECT_THAT(status.ErrorMessage(), testing::HasSubstr("Expected a number of bytes"));
+}
+
+TEST(InferenceSessionTests, SharedInitializerStoreComparesData) {
+  auto cpu_allocator = TestCPUExecutionProvider()->CreatePreferredAllocators()[0];
+  OrtValue value1, value2, value3;
+  CreateMLValue<float>(cpu_allocator, {2}, {1.0f, 2.0f}, &value1);
+  CreateMLValue<float>(cpu_allocator, {2}, {1.0f, 2.0f}, &value2);
+  CreateMLValue<float>(cpu_allocator, {2}, {1.0f, 3.0f}, &value3);
+
+  SharedInitializerStore store;
+  DataTransferManager data_transfer_mgr;
+  OrtValue shared1, shared2, shared3;
+  ASSERT_STATUS_OK(store.GetOrAdd("key", value1, data_transfer_mgr, shared1));
+  ASSERT_STATUS_OK(store.GetOrAdd("key", value2, data_transfer_mgr, shared2));
+  ASSERT_EQ(shared2.Get<Tensor>().DataRaw(), value1.Get<Tensor>().DataRaw());
+
+  // an initializer of different data under the same key is not shared
+  ASSERT_STATUS_OK(store.GetOrAdd("key", value3, data_transfer_mgr, shared3));
+  ASSERT_FALSE(shared3.IsAllocated());
+  ASSERT_EQ(store.GetNumberOfElements(), static_cast<size_t>(1));
+}
+
+TEST(InferenceSessionTests, UpdateInitializers) {
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.UpdateInitializers";
+  InferenceSession session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+
+  std::vector<std::string> names{"W"};
+  std::vector<OrtValue> values(1);
+  CreateMLValue<float>(TestCPUExecutionProvider()->CreatePreferredAllocators()[0], {3, 2},
+                       {2.0f, 2.0f, 2.0f, 2.0f, 2.0f, 2.0f}, &values[0]);
+
+  // the session must be initialized
+  ASSERT_FALSE(session_object.UpdateInitializers(names, values).IsOK());
+  ASSERT_STATUS_OK(session_object.Initialize());
+  RunModel(session_object, RunOptions{});
+
+  ASSERT_STATUS_OK(session_object.UpdateInitializers(names, values));
+
+  OrtValue x;
+  CreateMLValue<float>(TestCPUExecutionProvider()->CreatePreferredAllocators()[0], {3, 2},
+                       {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f}, &x);
+  NameMLValMap feeds{{"X", x}};
+  std::vector<std::string> output_names{"Y"};
+  std::vector<OrtValue> fetches;
+  ASSERT_STATUS_OK(session_object.Run(RunOptions{}, feeds, output_names, &fetches));
+  VerifyOutputs(fetches, {3, 2}, {2.0f, 4.0f, 6.0f, 8.0f, 10.0f, 12.0f});
+
+  // the values must match the initializers, which are left unchanged otherwise
+  std::vector<OrtValue> wrong_shape(1);
+  CreateMLValue<float>(TestCPUExecutionProvider()->CreatePreferredAllocators()[0], {6}, std::vector<float>(6, 3.0f),
+                       &wrong_shape[0]);
+  ASSERT_FALSE(session_object.UpdateInitializers(names, wrong_shape).IsOK());
+  ASSERT_FALSE(session_object.UpdateInitializers(std::vector<std::string>{"X"}, values).IsOK());
+
+  fetches.clear();
+  ASSERT_STATUS_OK(session_object.Run(RunOptions{}, feeds, output_names, &fetches));
+  VerifyOutputs(fetches, {3, 2}, {2.0f, 4.0f, 6.0f, 8.0f, 10.0f, 12.0f});
+}
+
+TEST(InferenceSessionTests, SamplingProfiler) {
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.SamplingProfiler";
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigSamplingProfilerInterval, "2"));
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigSamplingProfilerMaxRuns, "2"));
+  InferenceSession session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  std::vector<profiling::SampledRun> runs;
+  ASSERT_STATUS_OK(session_object.GetSampledRuns(runs));
+  ASSERT_TRUE(runs.empty());
+
+  // runs 1, 3 and 5 are sampled, and the ring keeps the latest two of them
+  for (int i = 0; i < 5; ++i) {
+    RunModel(session_object, RunOptions{});
+  }
+  ASSERT_STATUS_OK(session_object.GetSampledRuns(runs));
+  ASSERT_EQ(runs.size(), 2u);
+  EXPECT_EQ(runs[0].sample_id, 2u);
+  EXPECT_EQ(runs[1].sample_id, 3u);
+  for (const auto& run : runs) {
+    ASSERT_EQ(run.nodes.size(), 1u);
+    EXPECT_GE(run.nodes[0].start_ns, 0);
+    EXPECT_LE(run.nodes[0].start_ns + run.nodes[0].duration_ns, run.duration_ns);
+  }
+
+  std::string json;
+  ASSERT_STATUS_OK(session_object.GetSampledRuns(json));
+  EXPECT_NE(json.find("_kernel_time"), std::string::npos);
+
+  // not enabled by default
+  SessionOptions so_default;
+  InferenceSession session_default{so_default, GetEnvironment()};
+  ASSERT_STATUS_OK(session_default.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_default.Initialize());
+  ASSERT_FALSE(session_default.GetSampledRuns(runs).IsOK());
+}
+
+TEST(InferenceSessionTests, Metrics) {
+  auto& registry = metrics::MetricsRegistry::Instance();
+  const auto& run_durations = registry.GetHistogram("onnxruntime_run_duration_seconds", "",
+                                                    metrics::DurationBucketBounds());
+  const uint64_t run_count = run_durations.Count();
+
+  const std::string reserved_bytes_sample = "onnxruntime_allocator_bytes_reserved{session_id=\"";
+  std::string session_sample;
+  {
+    SessionOptions so;
+    so.session_logid = "InferenceSessionTests.Metrics";
+    InferenceSession session_object{so, GetEnvironment()};
+    ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+    ASSERT_STATUS_OK(session_object.Initialize());
+    for (int i = 0; i < 3; ++i) {
+      RunModel(session_object, RunOptions{});
+    }
+    EXPECT_EQ(run_durations.Count(), run_count + 3);
+
+    const std::string text = registry.ToPrometheusText();
+    EXPECT_NE(text.find("# TYPE onnxruntime_run_duration_seconds histogram"), std::string::npos);
+    EXPECT_NE(text.find("onnxruntime_run_duration_seconds_bucket{le=\"+Inf\"}"), std::string::npos);
+    // the samples of the latest session, which has the largest id, come last
+    const size_t sample_start = text.rfind(reserved_bytes_sample);
+    ASSERT_NE(sample_start, std::string::npos);
+    session_sample = text.substr(sample_start, text.find(',', sample_start) - sample_start);
+  }
+
+  // the statistics of a session are not exported once it is destroyed
+  EXPECT_EQ(registry.ToPrometheusText().find(session_sample + ","), std::string::npos);
+}
+
 void RunModelWithDenormalAsZero(InferenceSession& session_object,
                                 const RunOptions& run_options,
                                 bool set_denormal_as_zero) {
@@ -1,7 +1,10 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <filesystem>
+
 #include "core/framework/mem_pattern_planner.h"
+#include "core/framework/memory_pattern_cache.h"
 #include "gtest/gtest.h"
 
 namespace onnxruntime {
@@ -35,5 +38,63 @@ TEST(MemPatternPlannerTest, TraceAllocaitonTest) {
   EXPECT_EQ(pattern.GetBlock(5)->offset_, 1024u + 256u + 512u);
   EXPECT_EQ(pattern.GetBlock(6)->offset_, 1024u);
 }
+
+static MemoryPatternGroup CreatePatternGroup(size_t size) {
+  MemPatternPlanner planner{false};
+  planner.TraceAllocation(0, size);
+  planner.TraceAllocation(1, 256);
+  planner.TraceFree(0);
+  planner.TraceAllocation(2, 512);
+
+  MemoryPatternGroup group;
+  group.locations.push_back(OrtDevice());
+  group.patterns.push_back(planner.GenerateMemPattern());
+  return group;
+}
+
+TEST(MemPatternPlannerTest, MemoryPatternCacheEvictsLeastRecentlyUsed) {
+  MemoryPatternCache cache;
+  cache.SetCapacity(2);
+  cache.Insert("1:(1)", CreatePatternGroup(1024));
+  cache.Insert("1:(2)", CreatePatternGroup(2048));
+  ASSERT_NE(cache.Find("1:(1)"), nullptr);
+
+  // an entry in use stays valid after it was evicted
+  auto in_use = cache.Find("1:(2)")->patterns;
+  cache.Find("1:(1)");
+  cache.Insert("1:(3)", CreatePatternGroup(4096));
+  EXPECT_EQ(cache.Size(), 2u);
+  EXPECT_EQ(cache.Find("1:(2)"), nullptr);
+  EXPECT_NE(cache.Find("1:(1)"), nullptr);
+  EXPECT_NE(cache.Find("1:(3)"), nullptr);
+  EXPECT_EQ(in_use->GetPatterns(OrtDevice())->GetBlock(0)->size_, 2048u);
+}
+
+TEST(MemPatternPlannerTest, MemoryPatternCacheSaveLoad) {
+  MemoryPatternCache cache;
+  const auto& entry = cache.Insert("2:(1,128)()", CreatePatternGroup(1024));
+
+  const auto file = std::filesystem::temp_directory_path() / "ort_memory_pattern_cache_test.txt";
+  ASSERT_TRUE(cache.Save(file.native(), "fingerprint").IsOK());
+
+  MemoryPatternCache loaded;
+  EXPECT_EQ(loaded.Load(file.native(), "other fingerprint"), 0u);
+  EXPECT_EQ(loaded.Size(), 0u);
+
+  ASSERT_EQ(loaded.Load(file.native(), "fingerprint"), 1u);
+  const auto* loaded_entry = loaded.Find("2:(1,128)()");
+  ASSERT_NE(loaded_entry, nullptr);
+  const MemoryPattern* pattern = loaded_entry->patterns->GetPatterns(OrtDevice());
+  const MemoryPattern* expected = entry.patterns->GetPatterns(OrtDevice());
+  ASSERT_NE(pattern, nullptr);
+  EXPECT_EQ(pattern->PeakSize(), expected->PeakSize());
+  for (int idx = 0; idx < 3; ++idx) {
+    EXPECT_EQ(pattern->GetBlock(idx)->offset_, expected->GetBlock(idx)->offset_);
+    EXPECT_EQ(pattern->GetBlock(idx)->size_, expected->GetBlock(idx)->size_);
+  }
+
+  std::filesystem::remove(file);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
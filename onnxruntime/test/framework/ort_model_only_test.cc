@@ -211,7 +211,8 @@ static void CompareSessionMetadata(const InferenceSessionWrapper& session_object
 
 static void SaveAndCompareModels(const PathString& orig_file,
                                  const PathString& ort_file,
-                                 TransformerLevel optimization_level = TransformerLevel::Level3) {
+                                 TransformerLevel optimization_level = TransformerLevel::Level3,
+                                 bool compress_initializers = false) {
   SessionOptions so;
   so.session_logid = "SerializeToOrtFormat";
   so.optimized_model_filepath = ort_file;
@@ -219,6 +220,9 @@ static void SaveAndCompareModels(const PathString& orig_file,
 
   // not strictly necessary - type should be inferred from the filename
   ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigSaveModelFormat, "ORT"));
+  if (compress_initializers) {
+    ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigCompressOrtFormatInitializers, "1"));
+  }
   InferenceSessionWrapper session_object{so, GetEnvironment()};
 
   // create .ort file during Initialize due to values in SessionOptions
@@ -344,6 +348,25 @@ TEST(OrtModelOnlyTests, TensorAttributeSerialization) {
   SaveAndCompareModels(ORT_TSTR("testdata/ort_minimal_test_models/tensor_attribute.onnx"), ort_file);
 }
 
+TEST(OrtModelOnlyTests, CompressedInitializerSerialization) {
+  const auto ort_file = ORT_TSTR("testdata/mnist.onnx.compressed_initializers.test_output.ort");
+  // the initializers are compared after loading the ORT format model, which decompresses them
+  SaveAndCompareModels(ORT_TSTR("testdata/mnist.onnx"), ort_file, TransformerLevel::Level3,
+                       /* compress_initializers */ true);
+
+  std::string flatbuffer;
+  ASSERT_TRUE(flatbuffers::LoadFile(ToUTF8String(ort_file).c_str(), true, &flatbuffer));
+  const auto* fbs_session = fbs::GetInferenceSession(flatbuffer.data());
+
+  size_t num_compressed = 0;
+  for (const auto* fbs_tensor : *fbs_session->model()->graph()->initializers()) {
+    if (fbs_tensor->raw_data_compression() != fbs::CompressionType::NONE) {
+      ++num_compressed;
+    }
+  }
+  ASSERT_GT(num_compressed, size_t{0});
+}
+
 TEST(OrtModelOnlyTests, MetadataSerialization) {
   const auto ort_file = ORT_TSTR("testdata/model_with_metadata.onnx.test_output.ort");
   SaveAndCompareModels(ORT_TSTR("testdata/model_with_metadata.onnx"), ort_file);
@@ -3,9 +3,14 @@
 
 #include "core/framework/data_types.h"
 #include "core/framework/op_kernel.h"
+#include "core/framework/session_state.h"
+#include "core/graph/model.h"
 #include "test/providers/provider_test_utils.h"
+#include "test/util/include/asserts.h"
+#include "test/util/include/test_environment.h"
 #include "test_utils.h"
 #include "core/session/inference_session.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 
 #include "gtest/gtest.h"
 
@@ -117,6 +122,94 @@ TEST(ParallelExecutor, TestStatusPropagation) {
   }
 }
 
+// test that the status from TestOp is correctly returned when the nodes are scheduled dynamically
+TEST(ParallelExecutor, TestStatusPropagationWithDynamicScheduling) {
+  auto registry = std::make_shared<CustomRegistry>();
+  std::vector<OpSchema> schemas{TestOp::OpSchema()};
+  ASSERT_STATUS_OK(registry->RegisterOpSet(schemas, TestOp::OpDomain, 10, 11));
+  KernelCreateFn kernel_create_fn = [](FuncManager&, const OpKernelInfo& info, std::unique_ptr<OpKernel>& out) { out = std::make_unique<typename TestOp::OpKernelImpl>(info); return Status::OK(); };
+  auto kernel_def = TestOp::KernelDef();
+  ASSERT_STATUS_OK(registry->RegisterCustomKernel(kernel_def, kernel_create_fn));
+
+  onnxruntime::SessionOptions so;
+  so.session_logid = "TestOp";
+  so.execution_mode = ExecutionMode::ORT_PARALLEL;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigDynamicInterOpScheduling, "1"));
+
+  for (int64_t action : {0, 1, 2}) {
+    OpTester tester{"TestOp", 10, TestOp::OpDomain};
+    tester.AddCustomOpRegistry(registry);
+
+    tester.AddInput<int64_t>("action", {1}, {action});
+    tester.AddOutput<int64_t>("action_out", {1}, {0});
+    const auto expect_result = action == 0 ? OpTester::ExpectResult::kExpectSuccess
+                                           : OpTester::ExpectResult::kExpectFailure;
+    const std::string expected_failure = action == 1 ? "Action was 1" : action == 2 ? "Throwing as action was 2" : "";
+    tester.Run(so, expect_result, expected_failure, {kTensorrtExecutionProvider}, nullptr, nullptr);
+  }
+}
+
+// independent chains of Add nodes joined by a Sum node, so that many nodes are ready at the same time
+TEST(ParallelExecutor, DynamicScheduling) {
+  constexpr int kNumBranches = 8;
+  constexpr int kBranchLength = 4;
+
+  onnxruntime::Model model("DynamicScheduling", false, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+  TypeProto float_tensor;
+  float_tensor.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  auto& x = graph.GetOrCreateNodeArg("X", &float_tensor);
+  std::vector<NodeArg*> branch_outputs;
+  for (int branch = 0; branch < kNumBranches; ++branch) {
+    NodeArg* prev = &x;
+    for (int i = 0; i < kBranchLength; ++i) {
+      const std::string name = MakeString("add_", branch, "_", i);
+      auto& out = graph.GetOrCreateNodeArg(name, &float_tensor);
+      graph.AddNode(name, "Add", "", {prev, &x}, {&out});
+      prev = &out;
+    }
+    branch_outputs.push_back(prev);
+  }
+  auto& y = graph.GetOrCreateNodeArg("Y", &float_tensor);
+  graph.AddNode("sum", "Sum", "", branch_outputs, {&y});
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  std::string model_data;
+  ASSERT_TRUE(model.ToProto().SerializeToString(&model_data));
+
+  SessionOptions so;
+  so.execution_mode = ExecutionMode::ORT_PARALLEL;
+  so.inter_op_param.thread_pool_size = 4;
+  // keep the identical branches apart
+  so.graph_optimization_level = TransformerLevel::Default;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigDynamicInterOpScheduling, "1"));
+  InferenceSession session{so, GetEnvironment()};
+  std::stringstream model_stream(model_data);
+  ASSERT_STATUS_OK(session.Load(model_stream));
+  ASSERT_STATUS_OK(session.Initialize());
+
+  const auto* plan = session.GetSessionState().GetExecutionPlan();
+  ASSERT_TRUE(plan->dynamic_scheduling);
+  EXPECT_EQ(plan->dynamic_schedule_roots.size(), static_cast<size_t>(kNumBranches));
+
+  const std::vector<float> x_values = {1.0f, 2.0f, -3.0f};
+  OrtValue x_value;
+  CreateMLValue<float>(TestCPUExecutionProvider()->CreatePreferredAllocators()[0], {3}, x_values, &x_value);
+  NameMLValMap feeds{{"X", x_value}};
+  std::vector<std::string> output_names{"Y"};
+
+  for (int run = 0; run < 20; ++run) {
+    std::vector<OrtValue> fetches;
+    ASSERT_STATUS_OK(session.Run(RunOptions{}, feeds, output_names, &fetches));
+    ASSERT_EQ(fetches.size(), 1u);
+    auto y_values = fetches[0].Get<Tensor>().DataAsSpan<float>();
+    ASSERT_EQ(y_values.size(), x_values.size());
+    for (size_t i = 0; i < x_values.size(); ++i) {
+      EXPECT_EQ(y_values[i], x_values[i] * (kBranchLength + 1) * kNumBranches);
+    }
+  }
+}
+
 class ParallelExecutorThreadPoolTest : public testing::TestWithParam<int> {
 };
 
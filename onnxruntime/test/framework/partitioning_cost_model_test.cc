@@ -0,0 +1,119 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <cstdio>
+#include <fstream>
+
+#include "core/framework/partitioning_cost_model.h"
+#include "core/graph/model.h"
+#include "gtest/gtest.h"
+#include "test/test_environment.h"
+#include "asserts.h"
+
+using namespace ONNX_NAMESPACE;
+namespace onnxruntime {
+namespace test {
+
+namespace {
+
+constexpr const char* kTestProvider = "TestExecutionProvider";
+
+// Builds X -> Relu (node_0) -> Abs (node_1) -> Y with float tensors of the given shape.
+std::unique_ptr<Model> BuildTestModel(std::initializer_list<int64_t> dims) {
+  std::unordered_map<std::string, int> domain_to_version;
+  domain_to_version[kOnnxDomain] = 13;
+  auto model = std::make_unique<Model>("test", false, ModelMetaData(), PathString(),
+                                       IOnnxRuntimeOpSchemaRegistryList(), domain_to_version,
+                                       std::vector<ONNX_NAMESPACE::FunctionProto>(),
+                                       DefaultLoggingManager().DefaultLogger());
+  Graph& graph = model->MainGraph();
+
+  TypeProto tensor_type;
+  tensor_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  for (int64_t dim : dims) {
+    tensor_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(dim);
+  }
+
+  auto& x = graph.GetOrCreateNodeArg("X", &tensor_type);
+  auto& t = graph.GetOrCreateNodeArg("T", &tensor_type);
+  auto& y = graph.GetOrCreateNodeArg("Y", &tensor_type);
+  graph.AddNode("node_0", "Relu", "", {&x}, {&t});
+  graph.AddNode("node_1", "Abs", "", {&t}, {&y});
+  EXPECT_STATUS_OK(graph.Resolve());
+  return model;
+}
+
+IndexedSubGraph MakeSubGraph(std::initializer_list<NodeIndex> nodes) {
+  IndexedSubGraph sub_graph;
+  sub_graph.nodes = nodes;
+  return sub_graph;
+}
+
+}  // namespace
+
+TEST(PartitioningCostModelTest, GetNodeCost) {
+  auto model = BuildTestModel({2, 2});
+  const Graph& graph = model->MainGraph();
+  const Node& relu = *graph.GetNode(0);
+  const Node& abs = *graph.GetNode(1);
+
+  PartitioningCostModel cost_model;
+  cost_model.AddKernelTime(kTestProvider, "node_0", "Relu", 10.0);
+  cost_model.AddKernelTime(kTestProvider, "node_0", "Relu", 20.0);
+  cost_model.AddKernelTime(kTestProvider, "other_abs", "Abs", 4.0);
+
+  // by node name, then by op type
+  EXPECT_EQ(cost_model.GetNodeCost(relu, kTestProvider), 15.0);
+  EXPECT_EQ(cost_model.GetNodeCost(abs, kTestProvider), 4.0);
+  EXPECT_FALSE(cost_model.GetNodeCost(relu, kCpuExecutionProvider).has_value());
+}
+
+TEST(PartitioningCostModelTest, IsAssignmentProfitable) {
+  PartitioningCostModel cost_model;
+  cost_model.AddKernelTime(kTestProvider, "node_0", "Relu", 100.0);
+  cost_model.AddKernelTime(kCpuExecutionProvider, "node_0", "Relu", 1000.0);
+
+  // the copies of small tensors are cheaper than the time saved
+  {
+    auto model = BuildTestModel({2, 2});
+    const Graph& graph = model->MainGraph();
+    EXPECT_TRUE(cost_model.IsAssignmentProfitable(graph, MakeSubGraph({0}), kTestProvider, {0}));
+  }
+
+  // the copies of X to the device and of T back to the CPU for node_1 are more expensive than the time saved
+  {
+    auto model = BuildTestModel({1024, 1024});
+    const Graph& graph = model->MainGraph();
+    EXPECT_FALSE(cost_model.IsAssignmentProfitable(graph, MakeSubGraph({0}), kTestProvider, {0}));
+
+    // node_1 was not profiled so a sub-graph containing it is assigned as usual
+    EXPECT_TRUE(cost_model.IsAssignmentProfitable(graph, MakeSubGraph({0, 1}), kTestProvider, {0, 1}));
+  }
+}
+
+TEST(PartitioningCostModelTest, LoadProfile) {
+  const PathString profile_path = ORT_TSTR("partitioning_cost_model_test_profile.json");
+  {
+    std::ofstream profile(profile_path);
+    profile << R"([
+{"cat" : "Session", "pid" : 1, "tid" : 1, "dur" : 500, "ts" : 1, "name" : "model_run", "args" : {}},
+{"cat" : "Node", "pid" : 1, "tid" : 1, "dur" : 30, "ts" : 2, "name" : "node_0_kernel_time",
+ "args" : {"op_name" : "Relu", "provider" : "CPUExecutionProvider"}},
+{"cat" : "Node", "pid" : 1, "tid" : 1, "dur" : 7, "ts" : 3, "name" : "node_0_fence_before",
+ "args" : {"op_name" : "Relu"}},
+{"cat" : "Node", "pid" : 1, "tid" : 1, "dur" : 10, "ts" : 40, "name" : "node_0_kernel_time",
+ "args" : {"op_name" : "Relu", "provider" : "CPUExecutionProvider"}}
+])";
+  }
+
+  auto model = BuildTestModel({2, 2});
+  PartitioningCostModel cost_model;
+  ASSERT_STATUS_OK(cost_model.LoadProfile(profile_path));
+  EXPECT_EQ(cost_model.GetNodeCost(*model->MainGraph().GetNode(0), kCpuExecutionProvider), 20.0);
+  std::remove(ToUTF8String(profile_path).c_str());
+
+  EXPECT_FALSE(cost_model.LoadProfile(ORT_TSTR("partitioning_cost_model_test_missing.json")).IsOK());
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -0,0 +1,64 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <cstdio>
+#include <fstream>
+
+#include "core/framework/profile_guided_optimization.h"
+#include "gtest/gtest.h"
+#include "asserts.h"
+
+namespace onnxruntime {
+namespace test {
+
+TEST(ProfileGuidedOptimizationTest, NchwcLayout) {
+  {
+    ProfileGuidedOptimization pgo;
+    pgo.AddRunTime(true, 100.0);
+    EXPECT_TRUE(pgo.GetOptimizersToDisable().empty());
+
+    pgo.AddRunTime(false, 120.0);
+    EXPECT_TRUE(pgo.GetOptimizersToDisable().empty());
+  }
+  {
+    ProfileGuidedOptimization pgo;
+    pgo.AddRunTime(true, 100.0);
+    pgo.AddRunTime(true, 140.0);
+    pgo.AddRunTime(false, 110.0);
+    EXPECT_EQ(pgo.GetOptimizersToDisable().count("NchwcTransformer"), 1u);
+  }
+}
+
+TEST(ProfileGuidedOptimizationTest, LoadProfile) {
+  const PathString nchwc_profile_path = ORT_TSTR("profile_guided_optimization_test_nchwc.json");
+  const PathString other_profile_path = ORT_TSTR("profile_guided_optimization_test_other.json");
+  {
+    std::ofstream profile(nchwc_profile_path);
+    profile << R"([
+{"cat" : "Session", "pid" : 1, "tid" : 1, "dur" : 5000, "ts" : 1, "name" : "model_run", "args" : {}},
+{"cat" : "Node", "pid" : 1, "tid" : 1, "dur" : 30, "ts" : 2, "name" : "ReorderInput_kernel_time",
+ "args" : {"op_name" : "ReorderInput", "provider" : "CPUExecutionProvider"}},
+{"cat" : "Session", "pid" : 1, "tid" : 1, "dur" : 300, "ts" : 6000, "name" : "model_run", "args" : {}}
+])";
+  }
+  {
+    std::ofstream profile(other_profile_path);
+    profile << R"([
+{"cat" : "Session", "pid" : 1, "tid" : 1, "dur" : 250, "ts" : 1, "name" : "model_run", "args" : {}}
+])";
+  }
+
+  // the first run of the NCHWc profile is skipped, so it is slower than the other one
+  ProfileGuidedOptimization pgo;
+  ASSERT_STATUS_OK(pgo.LoadProfile(nchwc_profile_path));
+  ASSERT_STATUS_OK(pgo.LoadProfile(other_profile_path));
+  EXPECT_EQ(pgo.GetOptimizersToDisable().count("NchwcTransformer"), 1u);
+
+  std::remove(ToUTF8String(nchwc_profile_path).c_str());
+  std::remove(ToUTF8String(other_profile_path).c_str());
+
+  EXPECT_FALSE(pgo.LoadProfile(ORT_TSTR("profile_guided_optimization_test_missing.json")).IsOK());
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -1,6 +1,8 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <cstdio>
+#include <fstream>
 #include <iostream>
 
 #include "asserts.h"
@@ -343,6 +345,20 @@ class PrePackingTestOpKernel : public OpKernel {
     return Status::OK();
   }
 
+  Status UsePersistedPrePackedBuffers(const Tensor& tensor, int input_idx,
+                                      std::vector<BufferUniquePtr>& prepacked_buffers,
+                                      const std::vector<size_t>& prepacked_buffer_sizes,
+                                      /*out*/ bool& used_prepacked_buffers) override {
+    ORT_UNUSED_PARAMETER(tensor);
+    ORT_UNUSED_PARAMETER(input_idx);
+    ORT_UNUSED_PARAMETER(prepacked_buffer_sizes);
+
+    weight_packed_ = std::move(prepacked_buffers[0]);
+    used_prepacked_buffers = true;
+    ++use_persisted_pre_packed_weight_calls_count;
+    return Status::OK();
+  }
+
   Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
                  /*out*/ bool& is_packed, /*out*/ PrePackedWeights* prepacked_weights) override {
     ORT_UNUSED_PARAMETER(tensor);
@@ -366,6 +382,7 @@ class PrePackingTestOpKernel : public OpKernel {
 
   int prepack_calls_count = 0;
   int store_pre_packed_weight_calls_count = 0;
+  int use_persisted_pre_packed_weight_calls_count = 0;
   IAllocatorUniquePtr<void> weight_packed_;
 };
 
@@ -501,6 +518,7 @@ static void PlaceAllNodesToCPUEP(Graph& graph) {
 struct PrepackingTestParam {
   bool test_subgraph;
   bool test_prepacking;
+  bool parallel_initialization = false;
 };
 
 class SessionStatePrepackingTest : public testing::TestWithParam<PrepackingTestParam> {};
@@ -541,6 +559,8 @@ TEST_P(SessionStatePrepackingTest, PrePackingTest) {
   sess_options.use_deterministic_compute = false;
   sess_options.enable_mem_reuse = true;
   sess_options.config_options.configurations[kOrtSessionOptionsConfigDisablePrepacking] = test_param.test_prepacking ? "0" : "1";
+  sess_options.config_options.configurations[kOrtSessionOptionsConfigParallelInitialization] =
+      test_param.parallel_initialization ? "1" : "0";
 
   SessionState session_state(model.MainGraph(),
                              execution_providers,
@@ -823,12 +843,194 @@ TEST_F(SessionStateTestSharedInitalizersWithPrePacking, test3) {
   ASSERT_EQ(session_state_2.GetUsedSharedPrePackedWeightCounter(), static_cast<size_t>(1));
 }
 
+// Initializers with external data stay as views over the mapped file and are not pre-packed when
+// kOrtSessionOptionsConfigKeepExternalInitializersMapped is set.
+TEST_F(SessionStateTestSharedInitalizersWithPrePacking, KeepExternalInitializersMapped) {
+  const std::string data_file = "session_state_test_external_initializer.bin";
+  const float data = 3.5f;
+  {
+    std::ofstream out(data_file, std::ios::binary);
+    out.write(reinterpret_cast<const char*>(&data), sizeof(data));
+  }
+
+  for (bool keep_mapped : {false, true}) {
+    SessionOptions sess_options;
+    sess_options.enable_mem_pattern = true;
+    sess_options.execution_mode = ExecutionMode::ORT_SEQUENTIAL;
+    sess_options.use_deterministic_compute = false;
+    sess_options.enable_mem_reuse = true;
+    sess_options.config_options.configurations[kOrtSessionOptionsConfigDisablePrepacking] = "0";
+    sess_options.config_options.configurations[kOrtSessionOptionsConfigKeepExternalInitializersMapped] =
+        keep_mapped ? "1" : "0";
+
+    Model model("graph_main", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+                domain_to_version, std::vector<ONNX_NAMESPACE::FunctionProto>(),
+                DefaultLoggingManager().DefaultLogger());
+    Graph& graph = model.MainGraph();
+    CreateSimpleGraph(graph);
+
+    // point the initializer at the external data file
+    ONNX_NAMESPACE::TensorProto tensor;
+    tensor.add_dims(1);
+    tensor.set_data_type(TensorProto_DataType_FLOAT);
+    tensor.set_name("node_0_input_1");
+    tensor.set_data_location(ONNX_NAMESPACE::TensorProto_DataLocation_EXTERNAL);
+    auto* location = tensor.mutable_external_data()->Add();
+    location->set_key("location");
+    location->set_value(data_file);
+    graph.RemoveInitializedTensor("node_0_input_1");
+    graph.AddInitializedTensor(tensor);
+    ASSERT_STATUS_OK(graph.Resolve());
+    PlaceAllNodesToCPUEP(graph);
+
+    SessionState session_state(graph,
+                               execution_providers,
+                               tp.get(),
+                               nullptr, /*inter_op_thread_pool*/
+                               dtm,
+                               DefaultLoggingManager().DefaultLogger(),
+                               profiler,
+                               sess_options);
+
+    ASSERT_STATUS_OK(session_state.FinalizeSessionState(std::basic_string<PATH_CHAR_TYPE>(),
+                                                        kernel_registry_manager));
+
+    const auto& const_initialized_tensors = session_state.GetConstantInitializedTensors();
+    if (keep_mapped) {
+      ASSERT_EQ(session_state.GetNumberOfPrepacksCounter(), static_cast<size_t>(0));
+      ASSERT_EQ(const_initialized_tensors.size(), static_cast<size_t>(1));
+      const Tensor& weight = const_initialized_tensors.begin()->second.Get<Tensor>();
+      ASSERT_EQ(*weight.Data<float>(), data);
+    } else {
+      // pre-packing releases the initializer
+      ASSERT_EQ(session_state.GetNumberOfPrepacksCounter(), static_cast<size_t>(1));
+      ASSERT_EQ(const_initialized_tensors.size(), static_cast<size_t>(0));
+    }
+  }
+
+  std::remove(data_file.c_str());
+}
+
+// Initializers with external data are read by the thread pool while the session is initialized when
+// kOrtSessionOptionsConfigPrefetchExternalInitializers is set.
+TEST_F(SessionStateTestSharedInitalizersWithPrePacking, PrefetchExternalInitializers) {
+  const std::string data_file = "session_state_test_prefetched_initializer.bin";
+  const float data = 2.5f;
+  {
+    std::ofstream out(data_file, std::ios::binary);
+    out.write(reinterpret_cast<const char*>(&data), sizeof(data));
+  }
+
+  SessionOptions sess_options;
+  sess_options.enable_mem_pattern = true;
+  sess_options.execution_mode = ExecutionMode::ORT_SEQUENTIAL;
+  sess_options.use_deterministic_compute = false;
+  sess_options.enable_mem_reuse = true;
+  sess_options.config_options.configurations[kOrtSessionOptionsConfigKeepExternalInitializersMapped] = "1";
+  sess_options.config_options.configurations[kOrtSessionOptionsConfigParallelInitialization] = "1";
+  sess_options.config_options.configurations[kOrtSessionOptionsConfigPrefetchExternalInitializers] = "1";
+
+  Model model("graph_main", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+              domain_to_version, std::vector<ONNX_NAMESPACE::FunctionProto>(),
+              DefaultLoggingManager().DefaultLogger());
+  Graph& graph = model.MainGraph();
+  CreateSimpleGraph(graph);
+
+  ONNX_NAMESPACE::TensorProto tensor;
+  tensor.add_dims(1);
+  tensor.set_data_type(TensorProto_DataType_FLOAT);
+  tensor.set_name("node_0_input_1");
+  tensor.set_data_location(ONNX_NAMESPACE::TensorProto_DataLocation_EXTERNAL);
+  auto* location = tensor.mutable_external_data()->Add();
+  location->set_key("location");
+  location->set_value(data_file);
+  graph.RemoveInitializedTensor("node_0_input_1");
+  graph.AddInitializedTensor(tensor);
+  ASSERT_STATUS_OK(graph.Resolve());
+  PlaceAllNodesToCPUEP(graph);
+
+  SessionState session_state(graph,
+                             execution_providers,
+                             tp.get(),
+                             nullptr, /*inter_op_thread_pool*/
+                             dtm,
+                             DefaultLoggingManager().DefaultLogger(),
+                             profiler,
+                             sess_options);
+
+  ASSERT_STATUS_OK(session_state.FinalizeSessionState(std::basic_string<PATH_CHAR_TYPE>(),
+                                                      kernel_registry_manager));
+
+  const auto& const_initialized_tensors = session_state.GetConstantInitializedTensors();
+  ASSERT_EQ(const_initialized_tensors.size(), static_cast<size_t>(1));
+  ASSERT_EQ(*const_initialized_tensors.begin()->second.Get<Tensor>().Data<float>(), data);
+
+  std::remove(data_file.c_str());
+}
+
+// Pre-packing enabled + on-disk cache = the second session maps the weight pre-packed by the first one
+TEST_F(SessionStateTestSharedInitalizersWithPrePacking, PrepackedWeightsDiskCache) {
+  const std::string cache_dir = "session_state_test_prepacked_weights_cache";
+  ASSERT_STATUS_OK(Env::Default().CreateFolder(ToPathString(cache_dir)));
+
+  SessionOptions sess_options;
+  sess_options.enable_mem_pattern = true;
+  sess_options.execution_mode = ExecutionMode::ORT_SEQUENTIAL;
+  sess_options.use_deterministic_compute = false;
+  sess_options.enable_mem_reuse = true;
+  sess_options.config_options.configurations[kOrtSessionOptionsConfigDisablePrepacking] = "0";
+  sess_options.config_options.configurations[kOrtSessionOptionsConfigPrepackedWeightsCacheDir] = cache_dir;
+
+  for (int session = 0; session < 2; ++session) {
+    Model model("graph_main", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+                domain_to_version, std::vector<ONNX_NAMESPACE::FunctionProto>(),
+                DefaultLoggingManager().DefaultLogger());
+    CreateSimpleGraph(model.MainGraph());
+    PlaceAllNodesToCPUEP(model.MainGraph());
+    SessionState session_state(model.MainGraph(),
+                               execution_providers,
+                               tp.get(),
+                               nullptr, /*inter_op_thread_pool*/
+                               dtm,
+                               DefaultLoggingManager().DefaultLogger(),
+                               profiler,
+                               sess_options);
+
+    ASSERT_STATUS_OK(session_state.FinalizeSessionState(std::basic_string<PATH_CHAR_TYPE>(),
+                                                        kernel_registry_manager));
+
+    const auto* kernel = reinterpret_cast<const PrePackingTestOpKernel*>(session_state.GetKernel(0));
+    ASSERT_EQ(session_state.GetNumberOfPrepacksCounter(), static_cast<size_t>(1));
+    ASSERT_EQ(kernel->use_persisted_pre_packed_weight_calls_count, 1);
+    ASSERT_EQ(kernel->store_pre_packed_weight_calls_count, 0);
+    if (session == 0) {
+      // packed and persisted
+      ASSERT_EQ(kernel->prepack_calls_count, 1);
+      ASSERT_EQ(session_state.GetUsedPersistedPrePackedWeightCounter(), static_cast<size_t>(0));
+    } else {
+      // restored without calling PrePack()
+      ASSERT_EQ(kernel->prepack_calls_count, 0);
+      ASSERT_EQ(session_state.GetUsedPersistedPrePackedWeightCounter(), static_cast<size_t>(1));
+    }
+
+    const float* weight_packed = reinterpret_cast<const float*>(kernel->weight_packed_.get());
+    ASSERT_EQ(weight_packed[0], 1.2345f);
+    ASSERT_EQ(weight_packed[1], 1.2345f * 2.f);
+    // the initializer is released either way
+    ASSERT_EQ(session_state.GetConstantInitializedTensors().size(), static_cast<size_t>(0));
+  }
+
+  ASSERT_STATUS_OK(Env::Default().DeleteFolder(ToPathString(cache_dir)));
+}
+
 INSTANTIATE_TEST_SUITE_P(SessionStateTests,
                          SessionStatePrepackingTest,
                          testing::Values(PrepackingTestParam{false, false},
                                          PrepackingTestParam{false, true},
                                          PrepackingTestParam{true, false},
-                                         PrepackingTestParam{true, true}));
+                                         PrepackingTestParam{true, true},
+                                         PrepackingTestParam{false, true, true},
+                                         PrepackingTestParam{true, true, true}));
 #endif
 
 }  // namespace test
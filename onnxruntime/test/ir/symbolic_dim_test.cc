@@ -0,0 +1,69 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "gtest/gtest.h"
+#include "core/graph/symbolic_dim.h"
+
+namespace onnxruntime {
+namespace test {
+
+TEST(SymbolicDimTest, ParseAndToString) {
+  EXPECT_EQ(SymbolicDim::Parse("batch").ToString(), "batch");
+  EXPECT_EQ(SymbolicDim::Parse("seq * batch").ToString(), "batch*seq");
+  EXPECT_EQ(SymbolicDim::Parse("1 + 2*seq").ToString(), "2*seq+1");
+  EXPECT_EQ(SymbolicDim::Parse("-seq + seq").ToString(), "0");
+  EXPECT_EQ(SymbolicDim::Parse("seq*seq - 3").ToString(), "seq*seq-3");
+
+  // strings that are not expressions are kept as one symbol
+  EXPECT_EQ(SymbolicDim::Parse("seq/2").ToString(), "seq/2");
+  EXPECT_EQ(SymbolicDim::Parse("seq/2"), SymbolicDim::Symbol("seq/2"));
+
+  EXPECT_TRUE(SymbolicDim::Parse("16").IsConstant());
+  EXPECT_EQ(SymbolicDim::Parse("16").ConstantValue(), 16);
+}
+
+TEST(SymbolicDimTest, Arithmetic) {
+  const auto batch = SymbolicDim::Symbol("batch");
+  const auto seq = SymbolicDim::Symbol("seq");
+
+  EXPECT_EQ(batch * seq, seq * batch);
+  EXPECT_EQ((batch * seq).ToString(), "batch*seq");
+  EXPECT_EQ((seq * SymbolicDim(2) + SymbolicDim(1)).ToString(), "2*seq+1");
+  EXPECT_EQ((batch + seq - batch), seq);
+  EXPECT_TRUE((seq - seq).IsConstant());
+  EXPECT_EQ((seq - seq).ConstantValue(), 0);
+  EXPECT_EQ(((batch + SymbolicDim(1)) * (batch - SymbolicDim(1))).ToString(), "batch*batch-1");
+}
+
+TEST(SymbolicDimTest, Divide) {
+  const auto batch = SymbolicDim::Symbol("batch");
+  const auto seq = SymbolicDim::Symbol("seq");
+
+  EXPECT_EQ((batch * seq * SymbolicDim(12)).Divide(seq * SymbolicDim(3)), batch * SymbolicDim(4));
+  EXPECT_EQ(SymbolicDim(768).Divide(SymbolicDim(12)), SymbolicDim(64));
+  EXPECT_EQ((seq + SymbolicDim(1)).Divide(seq + SymbolicDim(1)), SymbolicDim(1));
+
+  // not exact
+  EXPECT_FALSE((batch * seq).Divide(SymbolicDim(2)).has_value());
+  EXPECT_FALSE((seq + SymbolicDim(1)).Divide(seq).has_value());
+  EXPECT_FALSE(batch.Divide(seq).has_value());
+  EXPECT_FALSE(batch.Divide(SymbolicDim(0)).has_value());
+}
+
+TEST(SymbolicDimTest, Dimension) {
+  ONNX_NAMESPACE::TensorShapeProto_Dimension dim;
+  EXPECT_FALSE(SymbolicDim::FromDimension(dim).has_value());
+
+  dim.set_dim_param("seq*batch");
+  auto value = SymbolicDim::FromDimension(dim);
+  ASSERT_TRUE(value.has_value());
+  value->ToDimension(dim);
+  EXPECT_EQ(dim.dim_param(), "batch*seq");
+
+  (*value - *value).ToDimension(dim);
+  EXPECT_TRUE(dim.has_dim_value());
+  EXPECT_EQ(dim.dim_value(), 0);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
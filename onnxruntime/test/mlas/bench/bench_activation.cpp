@@ -0,0 +1,84 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "mlas.h"
+#include "bench_util.h"
+
+#include <stdexcept>
+
+using UnaryRoutine = void(MLASCALL*)(const float*, float*, size_t);
+
+void UNARY(benchmark::State& state, UnaryRoutine routine) {
+  if (state.range(0) <= 0) throw std::invalid_argument("N must greater than 0!");
+  const size_t N = static_cast<size_t>(state.range(0));
+
+  auto input = RandomVectorUniform(N, -10.0f, 10.0f);
+  std::vector<float> output(N);
+
+  routine(input.data(), output.data(), N);
+
+  for (auto _ : state) {
+    routine(input.data(), output.data(), N);
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+void ACTIVATION(benchmark::State& state, MLAS_ACTIVATION_KIND kind) {
+  if (state.range(0) <= 0) throw std::invalid_argument("M must greater than 0!");
+  if (state.range(1) <= 0) throw std::invalid_argument("N must greater than 0!");
+  const size_t M = static_cast<size_t>(state.range(0));
+  const size_t N = static_cast<size_t>(state.range(1));
+
+  MLAS_ACTIVATION activation;
+  activation.ActivationKind = kind;
+  activation.Parameters.Values[0] = kind == MlasClipActivation ? -1.0f : 0.2f;
+  activation.Parameters.Values[1] = kind == MlasClipActivation ? 1.0f : 0.5f;
+
+  auto buffer = RandomVectorUniform(M * N, -10.0f, 10.0f);
+  auto bias = RandomVectorUniform(M, -1.0f, 1.0f);
+
+  for (auto _ : state) {
+    MlasActivation(&activation, buffer.data(), bias.data(), M, N, N);
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0) * state.range(1));
+}
+
+void FIND_MIN_MAX(benchmark::State& state) {
+  if (state.range(0) <= 0) throw std::invalid_argument("N must greater than 0!");
+  const size_t N = static_cast<size_t>(state.range(0));
+
+  auto input = RandomVectorUniform(N, -10.0f, 10.0f);
+  float min_value;
+  float max_value;
+
+  for (auto _ : state) {
+    MlasFindMinMaxElement(input.data(), &min_value, &max_value, N);
+    benchmark::DoNotOptimize(min_value);
+    benchmark::DoNotOptimize(max_value);
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+static void UnarySizes(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"N"});
+  ArgsProduct(b, {{63, 1024, 16384, 262144}});
+}
+
+static void ActivationSizes(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"M", "N"});
+  ArgsProduct(b, {{1, 64, 512}, {63, 1024}});
+}
+
+BENCHMARK_CAPTURE(UNARY, Exp, MlasComputeExp)->Apply(UnarySizes)->UseRealTime();
+BENCHMARK_CAPTURE(UNARY, Logistic, MlasComputeLogistic)->Apply(UnarySizes)->UseRealTime();
+BENCHMARK_CAPTURE(UNARY, Tanh, MlasComputeTanh)->Apply(UnarySizes)->UseRealTime();
+BENCHMARK_CAPTURE(UNARY, Erf, MlasComputeErf)->Apply(UnarySizes)->UseRealTime();
+
+BENCHMARK_CAPTURE(ACTIVATION, Relu, MlasReluActivation)->Apply(ActivationSizes)->UseRealTime();
+BENCHMARK_CAPTURE(ACTIVATION, LeakyRelu, MlasLeakyReluActivation)->Apply(ActivationSizes)->UseRealTime();
+BENCHMARK_CAPTURE(ACTIVATION, Tanh, MlasTanhActivation)->Apply(ActivationSizes)->UseRealTime();
+BENCHMARK_CAPTURE(ACTIVATION, Logistic, MlasLogisticActivation)->Apply(ActivationSizes)->UseRealTime();
+BENCHMARK_CAPTURE(ACTIVATION, Clip, MlasClipActivation)->Apply(ActivationSizes)->UseRealTime();
+BENCHMARK_CAPTURE(ACTIVATION, HardSigmoid, MlasHardSigmoidActivation)->Apply(ActivationSizes)->UseRealTime();
+
+BENCHMARK(FIND_MIN_MAX)->Apply(UnarySizes)->UseRealTime();
@@ -0,0 +1,76 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "mlas.h"
+#include "bench_util.h"
+
+#include <cmath>
+#include <stdexcept>
+
+static const std::vector<std::string> flash_attention_bench_arg_names = {"Batch", "Heads", "S", "L", "H"};
+
+void FLASH_ATTENTION(benchmark::State& state, bool causal) {
+  for (int i = 0; i < 5; i++) {
+    if (state.range(i) <= 0) throw std::invalid_argument("Attention arguments must greater than 0!");
+  }
+  const size_t B = static_cast<size_t>(state.range(0));
+  const size_t N = static_cast<size_t>(state.range(1));
+  const size_t S = static_cast<size_t>(state.range(2));
+  const size_t L = static_cast<size_t>(state.range(3));
+  const size_t H = static_cast<size_t>(state.range(4));
+
+  auto query = RandomVectorUniform(B * N * S * H, -1.0f, 1.0f);
+  auto key = RandomVectorUniform(B * N * L * H, -1.0f, 1.0f);
+  auto value = RandomVectorUniform(B * N * L * H, -1.0f, 1.0f);
+  std::vector<float> output(B * S * N * H);
+
+  MLAS_FLASH_ATTENTION_PARAMS params;
+  params.BatchSize = B;
+  params.NumHeads = N;
+  params.SequenceLength = S;
+  params.KvSequenceLength = L;
+  params.QkHeadSize = H;
+  params.VHeadSize = H;
+  params.Scale = 1.0f / std::sqrt(static_cast<float>(H));
+  params.Causal = causal;
+  params.Query = query.data();
+  params.Key = key.data();
+  params.Value = value.data();
+  params.Output = output.data();
+
+  MlasFlashAttention(&params, nullptr);
+
+  for (auto _ : state) {
+    MlasFlashAttention(&params, nullptr);
+  }
+}
+
+void ROTARY_EMBEDDING(benchmark::State& state, bool interleaved) {
+  if (state.range(0) <= 0) throw std::invalid_argument("D must greater than 0!");
+  const size_t D = static_cast<size_t>(state.range(0));
+
+  auto input = RandomVectorUniform(D, -1.0f, 1.0f);
+  auto sin_data = RandomVectorUniform(D / 2, -1.0f, 1.0f);
+  auto cos_data = RandomVectorUniform(D / 2, -1.0f, 1.0f);
+  std::vector<float> output(D);
+
+  for (auto _ : state) {
+    MlasRotaryEmbedOneRow(input.data(), sin_data.data(), cos_data.data(), D, interleaved, output.data());
+  }
+}
+
+static void FlashAttentionSizes(benchmark::internal::Benchmark* b) {
+  b->ArgNames(flash_attention_bench_arg_names);
+  ArgsProduct(b, {{1}, {12}, {1, 128, 512}, {128, 512}, {64}});
+}
+
+static void RotaryEmbeddingSizes(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"D"});
+  ArgsProduct(b, {{64, 128, 256}});
+}
+
+BENCHMARK_CAPTURE(FLASH_ATTENTION, NonCausal, false)->Apply(FlashAttentionSizes)->UseRealTime();
+BENCHMARK_CAPTURE(FLASH_ATTENTION, Causal, true)->Apply(FlashAttentionSizes)->UseRealTime();
+
+BENCHMARK_CAPTURE(ROTARY_EMBEDDING, Halves, false)->Apply(RotaryEmbeddingSizes)->UseRealTime();
+BENCHMARK_CAPTURE(ROTARY_EMBEDDING, Interleaved, true)->Apply(RotaryEmbeddingSizes)->UseRealTime();
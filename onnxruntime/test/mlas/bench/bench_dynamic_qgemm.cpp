@@ -0,0 +1,76 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "mlas.h"
+#include "bench_util.h"
+#include "core/util/thread_utils.h"
+
+#include <stdexcept>
+#include <memory>
+
+static const std::vector<std::string> dynamic_qgemm_arg_names = {"M", "N", "K", "Threads", "PerRow"};
+
+void DYNAMIC_QGEMM(benchmark::State& state) {
+  if (state.range(0) <= 0) throw std::invalid_argument("M must greater than 0!");
+  if (state.range(1) <= 0) throw std::invalid_argument("N must greater than 0!");
+  if (state.range(2) <= 0) throw std::invalid_argument("K must greater than 0!");
+  if (state.range(3) <= 0) throw std::invalid_argument("Threads must greater than 0!");
+
+  const size_t M = static_cast<size_t>(state.range(0));
+  const size_t N = static_cast<size_t>(state.range(1));
+  const size_t K = static_cast<size_t>(state.range(2));
+  const size_t threads = static_cast<size_t>(state.range(3));
+  const bool per_row = state.range(4) != 0;
+
+  OrtThreadPoolParams tpo;
+  tpo.thread_pool_size = int(threads);
+  tpo.auto_set_affinity = true;
+  std::unique_ptr<onnxruntime::concurrency::ThreadPool> tp(
+      onnxruntime::concurrency::CreateThreadPool(&onnxruntime::Env::Default(),
+                                                 tpo, onnxruntime::concurrency::ThreadPoolType::INTRA_OP));
+
+  auto A = RandomVectorUniform(M * K, -1.0f, 1.0f);
+  auto B = RandomVectorUniform<uint8_t>(N * K, uint8_t(0), uint8_t(127));
+  std::vector<float> C(M * N);
+
+  const size_t packed_b_size = MlasGemmPackBSize(N, K, false, true);
+  std::vector<uint8_t> PackedB(packed_b_size);
+  if (packed_b_size != 0) {
+    MlasGemmPackB(N, K, B.data(), N, false, true, PackedB.data());
+  }
+
+  MLAS_GEMM_QUANT_SHAPE_PARAMS shape;
+  shape.M = M;
+  shape.N = N;
+  shape.K = K;
+  shape.BIsSigned = true;
+
+  const uint8_t zero_point_b = 0;
+  const float scale_b = 0.01f;
+
+  MLAS_GEMM_DYNAMIC_QUANT_DATA_PARAMS params;
+  params.A = A.data();
+  params.lda = K;
+  params.ScaleA = 2.0f / 255.0f;
+  params.ZeroPointA = 128;
+  params.B = packed_b_size != 0 ? static_cast<const void*>(PackedB.data()) : B.data();
+  params.BIsPacked = packed_b_size != 0;
+  params.ldb = N;
+  params.ZeroPointB = &zero_point_b;
+  params.ScaleB = &scale_b;
+  params.C = C.data();
+  params.ldc = N;
+
+  MlasDynamicQuantizeGemmBatch(shape, &params, 1, per_row, tp.get());
+
+  for (auto _ : state) {
+    MlasDynamicQuantizeGemmBatch(shape, &params, 1, per_row, tp.get());
+  }
+}
+
+static void GemmSizes(benchmark::internal::Benchmark* b) {
+  b->ArgNames(dynamic_qgemm_arg_names);
+  ArgsProduct(b, {{1, 128, 384}, {768, 3072}, {768, 3072}, {1, 4}, {0, 1}});
+}
+
+BENCHMARK(DYNAMIC_QGEMM)->Apply(GemmSizes)->UseRealTime();
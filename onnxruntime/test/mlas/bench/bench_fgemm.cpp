@@ -0,0 +1,86 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "mlas.h"
+#include "bench_util.h"
+
+#include <stdexcept>
+
+static const std::vector<std::string> fgemm_bench_arg_names = {"M", "N", "K"};
+
+void DGEMM(benchmark::State& state, bool trans_a, bool trans_b) {
+  if (state.range(0) <= 0) throw std::invalid_argument("M must greater than 0!");
+  if (state.range(1) <= 0) throw std::invalid_argument("N must greater than 0!");
+  if (state.range(2) <= 0) throw std::invalid_argument("K must greater than 0!");
+  const size_t M = static_cast<size_t>(state.range(0));
+  const size_t N = static_cast<size_t>(state.range(1));
+  const size_t K = static_cast<size_t>(state.range(2));
+
+  auto A = RandomVectorUniform(M * K, -1.0, 1.0);
+  auto B = RandomVectorUniform(N * K, -1.0, 1.0);
+  std::vector<double> C(M * N);
+
+  MLAS_DGEMM_DATA_PARAMS data;
+  data.A = A.data();
+  data.lda = trans_a ? M : K;
+  data.B = B.data();
+  data.ldb = trans_b ? K : N;
+  data.C = C.data();
+  data.ldc = N;
+
+  for (auto _ : state) {
+    MlasGemm(trans_a ? CblasTrans : CblasNoTrans, trans_b ? CblasTrans : CblasNoTrans, M, N, K, data, nullptr);
+  }
+}
+
+void SBGEMM(benchmark::State& state, bool pack_b) {
+  if (state.range(0) <= 0) throw std::invalid_argument("M must greater than 0!");
+  if (state.range(1) <= 0) throw std::invalid_argument("N must greater than 0!");
+  if (state.range(2) <= 0) throw std::invalid_argument("K must greater than 0!");
+  const size_t M = static_cast<size_t>(state.range(0));
+  const size_t N = static_cast<size_t>(state.range(1));
+  const size_t K = static_cast<size_t>(state.range(2));
+
+  if (!MlasBf16AccelerationSupported()) {
+    state.SkipWithError("SBGEMM is not supported on this platform");
+    return;
+  }
+
+  auto A = RandomVectorUniform(M * K, -1.0f, 1.0f);
+  auto B = RandomVectorUniform(N * K, -1.0f, 1.0f);
+  std::vector<float> C(M * N);
+  std::vector<uint8_t> B_packed;
+
+  MLAS_SGEMM_DATA_PARAMS data;
+  data.A = A.data();
+  data.lda = K;
+  data.B = B.data();
+  data.ldb = N;
+  data.C = C.data();
+  data.ldc = N;
+
+  if (pack_b) {
+    B_packed.resize(MlasSBGemmPackBSize(N, K));
+    MlasSBGemmPackB(CblasNoTrans, N, K, B.data(), N, B_packed.data());
+    data.B = reinterpret_cast<const float*>(B_packed.data());
+    data.BIsPacked = true;
+  }
+
+  MlasSBGemmBatch(CblasNoTrans, CblasNoTrans, M, N, K, &data, 1, nullptr);
+
+  for (auto _ : state) {
+    MlasSBGemmBatch(CblasNoTrans, CblasNoTrans, M, N, K, &data, 1, nullptr);
+  }
+}
+
+static void GemmSizeProducts(benchmark::internal::Benchmark* b) {
+  b->ArgNames(fgemm_bench_arg_names);
+  ArgsProduct(b, {{1, 63, 255, 1023}, {63, 255, 1023}, {63, 255, 1023}});
+}
+
+BENCHMARK_CAPTURE(DGEMM, NoTrans, false, false)->Apply(GemmSizeProducts)->UseRealTime();
+BENCHMARK_CAPTURE(DGEMM, TransA, true, false)->Apply(GemmSizeProducts)->UseRealTime();
+BENCHMARK_CAPTURE(DGEMM, TransB, false, true)->Apply(GemmSizeProducts)->UseRealTime();
+
+BENCHMARK_CAPTURE(SBGEMM, NoPackB, false)->Apply(GemmSizeProducts)->UseRealTime();
+BENCHMARK_CAPTURE(SBGEMM, PackB, true)->Apply(GemmSizeProducts)->UseRealTime();
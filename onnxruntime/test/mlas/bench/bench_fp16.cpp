@@ -0,0 +1,171 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "mlas.h"
+#include "bench_util.h"
+#include "core/framework/float16.h"
+
+#include <stdexcept>
+
+static std::vector<MLAS_FP16> RandomHalfVector(size_t N, float min_value, float max_value) {
+  auto values = RandomVectorUniform(N, min_value, max_value);
+  std::vector<MLAS_FP16> half_values(N);
+  for (size_t i = 0; i < N; i++) {
+    half_values[i] = MLAS_FP16(values[i]);
+  }
+  return half_values;
+}
+
+void CONVERT_HALF_TO_FLOAT(benchmark::State& state) {
+  if (state.range(0) <= 0) throw std::invalid_argument("N must greater than 0!");
+  const size_t N = static_cast<size_t>(state.range(0));
+
+  auto input = RandomHalfVector(N, -10.0f, 10.0f);
+  std::vector<float> output(N);
+
+  for (auto _ : state) {
+    MlasConvertHalfToFloatBuffer(reinterpret_cast<const unsigned short*>(input.data()), output.data(), N);
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+void CONVERT_FLOAT_TO_HALF(benchmark::State& state) {
+  if (state.range(0) <= 0) throw std::invalid_argument("N must greater than 0!");
+  const size_t N = static_cast<size_t>(state.range(0));
+
+  auto input = RandomVectorUniform(N, -10.0f, 10.0f);
+  std::vector<unsigned short> output(N);
+
+  for (auto _ : state) {
+    MlasConvertFloatToHalfBuffer(input.data(), output.data(), N);
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+void CONVERT_BFLOAT16(benchmark::State& state, bool to_float) {
+  if (state.range(0) <= 0) throw std::invalid_argument("N must greater than 0!");
+  const size_t N = static_cast<size_t>(state.range(0));
+
+  auto values = RandomVectorUniform(N, -10.0f, 10.0f);
+  std::vector<unsigned short> bfloat16_values(N);
+  MlasConvertFloatToBFloat16Buffer(values.data(), bfloat16_values.data(), N);
+
+  for (auto _ : state) {
+    if (to_float) {
+      MlasConvertBFloat16ToFloatBuffer(bfloat16_values.data(), values.data(), N);
+    } else {
+      MlasConvertFloatToBFloat16Buffer(values.data(), bfloat16_values.data(), N);
+    }
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+void HALFGEMM(benchmark::State& state, bool a_is_fp32, bool b_is_fp32) {
+  if (state.range(0) <= 0) throw std::invalid_argument("M must greater than 0!");
+  if (state.range(1) <= 0) throw std::invalid_argument("N must greater than 0!");
+  if (state.range(2) <= 0) throw std::invalid_argument("K must greater than 0!");
+  const size_t M = static_cast<size_t>(state.range(0));
+  const size_t N = static_cast<size_t>(state.range(1));
+  const size_t K = static_cast<size_t>(state.range(2));
+
+  if (!MlasFp16AccelerationSupported()) {
+    state.SkipWithError("Half precision GEMM is not supported on this platform");
+    return;
+  }
+
+  auto A32 = RandomVectorUniform(M * K, -1.0f, 1.0f);
+  auto B32 = RandomVectorUniform(N * K, -1.0f, 1.0f);
+  auto A16 = RandomHalfVector(M * K, -1.0f, 1.0f);
+  auto B16 = RandomHalfVector(N * K, -1.0f, 1.0f);
+  std::vector<MLAS_FP16> C(M * N);
+
+  MLAS_HALF_GEMM_DATA_PARAMS params;
+  params.A = a_is_fp32 ? static_cast<const void*>(A32.data()) : static_cast<const void*>(A16.data());
+  params.B = b_is_fp32 ? static_cast<const void*>(B32.data()) : static_cast<const void*>(B16.data());
+  params.C = C.data();
+  params.lda = K;
+  params.ldb = N;
+  params.ldc = N;
+  params.AIsfp32 = a_is_fp32;
+  params.BIsfp32 = b_is_fp32;
+
+  MlasHalfGemmBatch(M, N, K, 1, &params, nullptr);
+
+  for (auto _ : state) {
+    MlasHalfGemmBatch(M, N, K, 1, &params, nullptr);
+  }
+}
+
+void FP16_ACTIVATION(benchmark::State& state, MLAS_ACTIVATION_KIND kind) {
+  if (state.range(0) <= 0) throw std::invalid_argument("M must greater than 0!");
+  if (state.range(1) <= 0) throw std::invalid_argument("N must greater than 0!");
+  const size_t M = static_cast<size_t>(state.range(0));
+  const size_t N = static_cast<size_t>(state.range(1));
+
+  if (!MlasFp16AccelerationSupported()) {
+    state.SkipWithError("Half precision activations are not supported on this platform");
+    return;
+  }
+
+  MLAS_ACTIVATION activation;
+  activation.ActivationKind = kind;
+  activation.Parameters.Values[0] = kind == MlasClipActivation ? -1.0f : 0.2f;
+  activation.Parameters.Values[1] = kind == MlasClipActivation ? 1.0f : 0.5f;
+
+  auto buffer = RandomHalfVector(M * N, -10.0f, 10.0f);
+
+  for (auto _ : state) {
+    MlasFp16Activation(&activation, buffer.data(), M, N, N);
+  }
+}
+
+#ifdef MLAS_F16VEC_INTRINSICS_SUPPORTED
+
+void HALF_SOFTMAX(benchmark::State& state, bool log_softmax) {
+  if (state.range(0) <= 0) throw std::invalid_argument("N must greater than 0!");
+  if (state.range(1) <= 0) throw std::invalid_argument("D must greater than 0!");
+  const size_t N = static_cast<size_t>(state.range(0));
+  const size_t D = static_cast<size_t>(state.range(1));
+
+  auto input = RandomHalfVector(N * D, -10.0f, 10.0f);
+  std::vector<MLAS_FP16> output(N * D);
+
+  for (auto _ : state) {
+    MlasComputeHalfSoftmax(input.data(), output.data(), N, D, log_softmax, nullptr);
+  }
+}
+
+#endif
+
+static void ConvertSizes(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"N"});
+  ArgsProduct(b, {{63, 1024, 16384, 262144}});
+}
+
+static void HalfGemmSizes(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"M", "N", "K"});
+  ArgsProduct(b, {{1, 63, 255, 1023}, {63, 255, 1023}, {63, 255, 1023}});
+}
+
+static void RowSizes(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"M", "N"});
+  ArgsProduct(b, {{1, 64, 512}, {63, 1024}});
+}
+
+BENCHMARK(CONVERT_HALF_TO_FLOAT)->Apply(ConvertSizes)->UseRealTime();
+BENCHMARK(CONVERT_FLOAT_TO_HALF)->Apply(ConvertSizes)->UseRealTime();
+BENCHMARK_CAPTURE(CONVERT_BFLOAT16, ToFloat, true)->Apply(ConvertSizes)->UseRealTime();
+BENCHMARK_CAPTURE(CONVERT_BFLOAT16, FromFloat, false)->Apply(ConvertSizes)->UseRealTime();
+
+BENCHMARK_CAPTURE(HALFGEMM, Half, false, false)->Apply(HalfGemmSizes)->UseRealTime();
+BENCHMARK_CAPTURE(HALFGEMM, FloatA, true, false)->Apply(HalfGemmSizes)->UseRealTime();
+BENCHMARK_CAPTURE(HALFGEMM, FloatB, false, true)->Apply(HalfGemmSizes)->UseRealTime();
+
+BENCHMARK_CAPTURE(FP16_ACTIVATION, Relu, MlasReluActivation)->Apply(RowSizes)->UseRealTime();
+BENCHMARK_CAPTURE(FP16_ACTIVATION, Logistic, MlasLogisticActivation)->Apply(RowSizes)->UseRealTime();
+BENCHMARK_CAPTURE(FP16_ACTIVATION, Tanh, MlasTanhActivation)->Apply(RowSizes)->UseRealTime();
+
+#ifdef MLAS_F16VEC_INTRINSICS_SUPPORTED
+BENCHMARK_CAPTURE(HALF_SOFTMAX, Softmax, false)->Apply(RowSizes)->UseRealTime();
+BENCHMARK_CAPTURE(HALF_SOFTMAX, LogSoftmax, true)->Apply(RowSizes)->UseRealTime();
+#endif
@@ -0,0 +1,66 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "mlas.h"
+#include "bench_util.h"
+
+#include <stdexcept>
+
+static const std::vector<std::string> pool_bench_arg_names = {"C", "H", "W", "Kernel", "Stride"};
+
+void POOL(benchmark::State& state, MLAS_POOLING_KIND kind, bool nchwc) {
+  for (int i = 0; i < 5; i++) {
+    if (state.range(i) <= 0) throw std::invalid_argument("Pool arguments must greater than 0!");
+  }
+  const int64_t channels = state.range(0);
+  const int64_t kernel = state.range(3);
+  const int64_t stride = state.range(4);
+
+  // NCHWc pooling works on channels padded to the block size of the kernels
+  const int64_t block_size = static_cast<int64_t>(MlasNchwcGetBlockSize());
+  const int64_t padded_channels = nchwc ? (channels + block_size - 1) / block_size * block_size : channels;
+
+  const int64_t input_shape[] = {1, padded_channels, state.range(1), state.range(2)};
+  const int64_t kernel_shape[] = {kernel, kernel};
+  const int64_t padding[] = {kernel / 2, kernel / 2, kernel / 2, kernel / 2};
+  const int64_t stride_shape[] = {stride, stride};
+  const int64_t output_shape[] = {
+      1,
+      padded_channels,
+      (input_shape[2] + padding[0] + padding[2] - kernel) / stride + 1,
+      (input_shape[3] + padding[1] + padding[3] - kernel) / stride + 1,
+  };
+
+  auto input = RandomVectorUniform(std::vector<int64_t>(input_shape, input_shape + 4), -1.0f, 1.0f);
+  std::vector<float> output(static_cast<size_t>(padded_channels * output_shape[2] * output_shape[3]));
+
+  if (nchwc && block_size <= 1) {
+    state.SkipWithError("NCHWc kernels are not supported on this platform");
+    return;
+  }
+
+  for (auto _ : state) {
+    if (nchwc) {
+      MlasNchwcPool(kind, input_shape, kernel_shape, nullptr, padding, stride_shape, output_shape,
+                    input.data(), output.data(), nullptr);
+    } else {
+      MlasPool(kind, 2, input_shape, kernel_shape, padding, stride_shape, output_shape,
+               input.data(), output.data(), nullptr);
+    }
+  }
+}
+
+static void PoolSizes(benchmark::internal::Benchmark* b) {
+  b->ArgNames(pool_bench_arg_names);
+  ArgsProduct(b, {{16, 64}, {56}, {56}, {3}, {1, 2}});
+  ArgsProduct(b, {{256}, {14}, {14}, {3}, {1, 2}});
+  ArgsProduct(b, {{64}, {112}, {112}, {2}, {2}});
+}
+
+BENCHMARK_CAPTURE(POOL, Maximum, MlasMaximumPooling, false)->Apply(PoolSizes)->UseRealTime();
+BENCHMARK_CAPTURE(POOL, AverageExcludePad, MlasAveragePoolingExcludePad, false)->Apply(PoolSizes)->UseRealTime();
+BENCHMARK_CAPTURE(POOL, AverageIncludePad, MlasAveragePoolingIncludePad, false)->Apply(PoolSizes)->UseRealTime();
+
+BENCHMARK_CAPTURE(POOL, NCHWC_Maximum, MlasMaximumPooling, true)->Apply(PoolSizes)->UseRealTime();
+BENCHMARK_CAPTURE(POOL, NCHWC_AverageExcludePad, MlasAveragePoolingExcludePad, true)->Apply(PoolSizes)->UseRealTime();
+BENCHMARK_CAPTURE(POOL, NCHWC_AverageIncludePad, MlasAveragePoolingIncludePad, true)->Apply(PoolSizes)->UseRealTime();
@@ -0,0 +1,85 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "mlas.h"
+#include "bench_util.h"
+
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+template <typename OutputType>
+void QUANTIZE_LINEAR(benchmark::State& state) {
+  if (state.range(0) <= 0) throw std::invalid_argument("N must greater than 0!");
+  const size_t N = static_cast<size_t>(state.range(0));
+
+  auto input = RandomVectorUniform(N, -10.0f, 10.0f);
+  std::vector<OutputType> output(N);
+  const float scale = 20.0f / 255.0f;
+  const OutputType zero_point = std::is_signed<OutputType>::value ? OutputType(0) : OutputType(128);
+
+  for (auto _ : state) {
+    MlasQuantizeLinear(input.data(), output.data(), N, scale, zero_point);
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+template <typename OutputType, bool PerColumnScale>
+void REQUANTIZE_OUTPUT(benchmark::State& state) {
+  if (state.range(0) <= 0) throw std::invalid_argument("M must greater than 0!");
+  if (state.range(1) <= 0) throw std::invalid_argument("N must greater than 0!");
+  const size_t M = static_cast<size_t>(state.range(0));
+  const size_t N = static_cast<size_t>(state.range(1));
+
+  auto input = RandomVectorUniform<int32_t>(M * N, -100000, 100000);
+  auto bias = RandomVectorUniform<int32_t>(N, -1000, 1000);
+  auto scale = RandomVectorUniform(N, 0.0001f, 0.001f);
+  std::vector<OutputType> output(M * N);
+  const OutputType zero_point = std::is_signed<OutputType>::value ? OutputType(0) : OutputType(128);
+
+  for (auto _ : state) {
+    MlasRequantizeOutput(input.data(), N, output.data(), N, bias.data(), scale.data(), PerColumnScale,
+                         zero_point, 0, 0, M, N);
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0) * state.range(1));
+}
+
+template <typename DataType, bool IsScalarB>
+void QLINEAR_ADD(benchmark::State& state) {
+  if (state.range(0) <= 0) throw std::invalid_argument("N must greater than 0!");
+  const size_t N = static_cast<size_t>(state.range(0));
+
+  auto a = RandomVectorUniform<DataType>(N);
+  auto b = RandomVectorUniform<DataType>(N);
+  std::vector<DataType> c(N);
+  const int32_t zero_point = std::is_signed<DataType>::value ? 0 : 128;
+
+  for (auto _ : state) {
+    MlasQLinearAdd(a.data(), 0.05f, zero_point, b.data(), 0.04f, zero_point, 0.08f, zero_point, c.data(), N,
+                   IsScalarB);
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+static void VectorSizes(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"N"});
+  ArgsProduct(b, {{63, 1024, 16384, 262144}});
+}
+
+static void MatrixSizes(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"M", "N"});
+  ArgsProduct(b, {{1, 64, 512}, {63, 1024}});
+}
+
+BENCHMARK_TEMPLATE(QUANTIZE_LINEAR, uint8_t)->Apply(VectorSizes)->UseRealTime();
+BENCHMARK_TEMPLATE(QUANTIZE_LINEAR, int8_t)->Apply(VectorSizes)->UseRealTime();
+
+BENCHMARK_TEMPLATE(REQUANTIZE_OUTPUT, uint8_t, false)->Apply(MatrixSizes)->UseRealTime();
+BENCHMARK_TEMPLATE(REQUANTIZE_OUTPUT, uint8_t, true)->Apply(MatrixSizes)->UseRealTime();
+BENCHMARK_TEMPLATE(REQUANTIZE_OUTPUT, int8_t, false)->Apply(MatrixSizes)->UseRealTime();
+BENCHMARK_TEMPLATE(REQUANTIZE_OUTPUT, int8_t, true)->Apply(MatrixSizes)->UseRealTime();
+
+BENCHMARK_TEMPLATE(QLINEAR_ADD, uint8_t, false)->Apply(VectorSizes)->UseRealTime();
+BENCHMARK_TEMPLATE(QLINEAR_ADD, uint8_t, true)->Apply(VectorSizes)->UseRealTime();
+BENCHMARK_TEMPLATE(QLINEAR_ADD, int8_t, false)->Apply(VectorSizes)->UseRealTime();
+BENCHMARK_TEMPLATE(QLINEAR_ADD, int8_t, true)->Apply(VectorSizes)->UseRealTime();
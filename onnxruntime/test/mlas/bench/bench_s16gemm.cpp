@@ -0,0 +1,48 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "mlas.h"
+#include "bench_util.h"
+#include "core/util/thread_utils.h"
+
+#include <stdexcept>
+#include <memory>
+
+static const std::vector<std::string> s16gemm_arg_names = {"M", "N", "K", "Threads"};
+
+void S16GEMM(benchmark::State& state) {
+  if (state.range(0) <= 0) throw std::invalid_argument("M must greater than 0!");
+  if (state.range(1) <= 0) throw std::invalid_argument("N must greater than 0!");
+  if (state.range(2) <= 0) throw std::invalid_argument("K must greater than 0!");
+  if (state.range(3) <= 0) throw std::invalid_argument("Threads must greater than 0!");
+
+  const size_t M = static_cast<size_t>(state.range(0));
+  const size_t N = static_cast<size_t>(state.range(1));
+  const size_t K = static_cast<size_t>(state.range(2));
+  const size_t threads = static_cast<size_t>(state.range(3));
+
+  OrtThreadPoolParams tpo;
+  tpo.thread_pool_size = int(threads);
+  tpo.auto_set_affinity = true;
+  std::unique_ptr<onnxruntime::concurrency::ThreadPool> tp(
+      onnxruntime::concurrency::CreateThreadPool(&onnxruntime::Env::Default(),
+                                                 tpo, onnxruntime::concurrency::ThreadPoolType::INTRA_OP));
+
+  // int16 activations and weights in the int8 range
+  auto A = RandomVectorUniform<int16_t>(M * K, int16_t(-4096), int16_t(4096));
+  auto B = RandomVectorUniform<int16_t>(N * K, int16_t(-127), int16_t(127));
+  std::vector<int32_t> C(M * N);
+
+  MlasGemmS16(M, N, K, A.data(), K, B.data(), N, C.data(), N, tp.get());
+
+  for (auto _ : state) {
+    MlasGemmS16(M, N, K, A.data(), K, B.data(), N, C.data(), N, tp.get());
+  }
+}
+
+static void GemmSizes(benchmark::internal::Benchmark* b) {
+  b->ArgNames(s16gemm_arg_names);
+  ArgsProduct(b, {{1, 128, 384}, {768, 3072}, {768, 3072}, {1, 4}});
+}
+
+BENCHMARK(S16GEMM)->Apply(GemmSizes)->UseRealTime();
@@ -0,0 +1,65 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "mlas.h"
+#include "bench_util.h"
+
+#include <stdexcept>
+
+static const std::vector<std::string> softmax_bench_arg_names = {"N", "D"};
+
+void SOFTMAX(benchmark::State& state, bool log_softmax) {
+  if (state.range(0) <= 0) throw std::invalid_argument("N must greater than 0!");
+  if (state.range(1) <= 0) throw std::invalid_argument("D must greater than 0!");
+  const size_t N = static_cast<size_t>(state.range(0));
+  const size_t D = static_cast<size_t>(state.range(1));
+
+  auto input = RandomVectorUniform(N * D, -10.0f, 10.0f);
+  std::vector<float> output(N * D);
+
+  MlasComputeSoftmax(input.data(), output.data(), N, D, log_softmax, nullptr);
+
+  for (auto _ : state) {
+    MlasComputeSoftmax(input.data(), output.data(), N, D, log_softmax, nullptr);
+  }
+}
+
+void LAYER_NORM(benchmark::State& state, bool simplified, bool with_skip) {
+  if (state.range(0) <= 0) throw std::invalid_argument("N must greater than 0!");
+  if (state.range(1) <= 0) throw std::invalid_argument("D must greater than 0!");
+  const size_t N = static_cast<size_t>(state.range(0));
+  const size_t D = static_cast<size_t>(state.range(1));
+
+  auto input = RandomVectorUniform(N * D, -10.0f, 10.0f);
+  auto skip = RandomVectorUniform(N * D, -1.0f, 1.0f);
+  auto scale = RandomVectorUniform(D, 0.5f, 1.5f);
+  auto bias = RandomVectorUniform(D, -1.0f, 1.0f);
+  std::vector<float> output(N * D);
+
+  MLAS_LAYER_NORM_PARAMS params;
+  params.Input = input.data();
+  params.Skip = with_skip ? skip.data() : nullptr;
+  params.Scale = scale.data();
+  params.NormBias = simplified ? nullptr : bias.data();
+  params.Output = output.data();
+  params.Epsilon = 1e-5f;
+  params.Simplified = simplified;
+
+  MlasComputeLayerNorm(&params, N, D, nullptr);
+
+  for (auto _ : state) {
+    MlasComputeLayerNorm(&params, N, D, nullptr);
+  }
+}
+
+static void RowSizes(benchmark::internal::Benchmark* b) {
+  b->ArgNames(softmax_bench_arg_names);
+  ArgsProduct(b, {{1, 64, 512}, {63, 128, 1000, 4096}});
+}
+
+BENCHMARK_CAPTURE(SOFTMAX, Softmax, false)->Apply(RowSizes)->UseRealTime();
+BENCHMARK_CAPTURE(SOFTMAX, LogSoftmax, true)->Apply(RowSizes)->UseRealTime();
+
+BENCHMARK_CAPTURE(LAYER_NORM, LayerNorm, false, false)->Apply(RowSizes)->UseRealTime();
+BENCHMARK_CAPTURE(LAYER_NORM, SkipLayerNorm, false, true)->Apply(RowSizes)->UseRealTime();
+BENCHMARK_CAPTURE(LAYER_NORM, RmsNorm, true, false)->Apply(RowSizes)->UseRealTime();
@@ -2,6 +2,9 @@
 // Licensed under the MIT License.
 
 #include "bench_util.h"
+#include "mlas.h"
+#include <cstring>
+#include <iostream>
 #include <numeric>
 #include <stdexcept>
 
@@ -48,3 +51,37 @@ void ArgsProduct(benchmark::internal::Benchmark* bench,
     } while (indices[arg++] == 0 && arg < arglists.size());
   }
 }
+
+bool ApplyMlasIsaOption(int& argc, char** argv) {
+  static const char option[] = "--mlas_isa=";
+  constexpr size_t option_length = sizeof(option) - 1;
+
+  for (int i = 1; i < argc; i++) {
+    if (strncmp(argv[i], option, option_length) != 0) {
+      continue;
+    }
+    const char* name = argv[i] + option_length;
+    for (int j = i; j < argc - 1; j++) {
+      argv[j] = argv[j + 1];
+    }
+    argc--;
+
+#if defined(MLAS_TARGET_AMD64_IX86)
+    for (int level = 0; level < MlasIsaLevelCount; level++) {
+      if (strcmp(name, MlasGetIsaLevelName(static_cast<MLAS_ISA_LEVEL>(level))) == 0) {
+        MlasSetMaximumIsaLevel(static_cast<MLAS_ISA_LEVEL>(level));
+        return true;
+      }
+    }
+    std::cerr << "Unknown --mlas_isa level '" << name << "', expected one of:";
+    for (int level = 0; level < MlasIsaLevelCount; level++) {
+      std::cerr << " " << MlasGetIsaLevelName(static_cast<MLAS_ISA_LEVEL>(level));
+    }
+    std::cerr << std::endl;
+#else
+    std::cerr << "--mlas_isa=" << name << " is only supported on x86" << std::endl;
+#endif
+    return false;
+  }
+  return true;
+}
@@ -31,3 +31,8 @@ std::vector<ElementType> RandomVectorUniform(
 std::vector<float> RandomVectorUniform(std::vector<int64_t> shape, float min_value, float max_value);
 
 std::vector<int64_t> BenchArgsVector(benchmark::State& state, size_t& start, size_t count);
+
+// Handles --mlas_isa=<level> (for example --mlas_isa=avx2), which caps the instruction set of the MLAS kernels so
+// that the kernels of several levels can be compared on the same machine. The option is removed from argv. Returns
+// false after printing the valid levels if the level is unknown, or if the option is used on other platforms than x86.
+bool ApplyMlasIsaOption(int& argc, char** argv);
@@ -0,0 +1,107 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+#include "mlas_float16.h"
+
+class MlasCastTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferFloat;
+  MatrixGuardBuffer<float> BufferFloatOutput;
+  MatrixGuardBuffer<unsigned short> BufferShort;
+  MatrixGuardBuffer<unsigned short> BufferShortOutput;
+
+  static uint32_t FloatBits(float Value) {
+    uint32_t Bits;
+    std::memcpy(&Bits, &Value, sizeof(Bits));
+    return Bits;
+  }
+
+  static float BitsFloat(uint32_t Bits) {
+    float Value;
+    std::memcpy(&Value, &Bits, sizeof(Value));
+    return Value;
+  }
+
+  static unsigned short ReferenceFloatToBFloat16(float Value) {
+    const uint32_t Bits = FloatBits(Value);
+    if (std::isnan(Value)) {
+      return static_cast<unsigned short>(((Bits >> 16) & 0x8000) | 0x7FC0);
+    }
+    return static_cast<unsigned short>((Bits + 0x7FFF + ((Bits >> 16) & 1)) >> 16);
+  }
+
+  void FillFloats(float* Values, size_t N) {
+    static const float Specials[] = {0.0f, -0.0f, 1.0f, -1.0f, 65504.0f, 65520.0f, -1e6f, 6e-8f, 3e-5f,
+                                     std::numeric_limits<float>::infinity(),
+                                     -std::numeric_limits<float>::infinity(),
+                                     std::numeric_limits<float>::quiet_NaN(),
+                                     BitsFloat(0x3F808000), BitsFloat(0x3F818000), BitsFloat(0x3F807FFF)};
+    std::minstd_rand gen(static_cast<unsigned>(N));
+    std::uniform_real_distribution<float> distrib(-1000.0f, 1000.0f);
+
+    for (size_t i = 0; i < N; i++) {
+      Values[i] = (i % 7 == 3) ? Specials[(i / 7) % std::size(Specials)] : distrib(gen) * ((i % 3 == 0) ? 1e-4f : 1.0f);
+    }
+  }
+
+ public:
+  void Test(size_t N) {
+    float* Float = BufferFloat.GetBuffer(N);
+    float* FloatOutput = BufferFloatOutput.GetBuffer(N);
+    unsigned short* Short = BufferShort.GetBuffer(N);
+    unsigned short* ShortOutput = BufferShortOutput.GetBuffer(N);
+
+    FillFloats(Float, N);
+
+    MlasConvertFloatToHalfBuffer(Float, Short, N);
+    for (size_t i = 0; i < N; i++) {
+      const unsigned short Expected = MLAS_Float2Half(Float[i]);
+      if (std::isnan(Float[i])) {
+        ASSERT_TRUE((Short[i] & 0x7C00) == 0x7C00 && (Short[i] & 0x3FF) != 0) << "N=" << N << " @" << i;
+      } else {
+        ASSERT_EQ(Short[i], Expected) << "float to half N=" << N << " @" << i << " value=" << Float[i];
+      }
+    }
+
+    MlasConvertHalfToFloatBuffer(Short, FloatOutput, N);
+    for (size_t i = 0; i < N; i++) {
+      const float Expected = MLAS_Half2Float(Short[i]);
+      ASSERT_TRUE(FloatBits(FloatOutput[i]) == FloatBits(Expected) || (std::isnan(FloatOutput[i]) && std::isnan(Expected)))
+          << "half to float N=" << N << " @" << i;
+    }
+
+    MlasConvertFloatToBFloat16Buffer(Float, ShortOutput, N);
+    for (size_t i = 0; i < N; i++) {
+      ASSERT_EQ(ShortOutput[i], ReferenceFloatToBFloat16(Float[i]))
+          << "float to bfloat16 N=" << N << " @" << i << " value=" << Float[i];
+    }
+
+    MlasConvertBFloat16ToFloatBuffer(ShortOutput, FloatOutput, N);
+    for (size_t i = 0; i < N; i++) {
+      ASSERT_EQ(FloatBits(FloatOutput[i]), uint32_t(ShortOutput[i]) << 16) << "bfloat16 to float N=" << N << " @" << i;
+    }
+  }
+
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name("Cast");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    for (size_t N : {1, 3, 7, 8, 9, 15, 16, 17, 31, 33, 64, 100, 1027}) {
+      Test(N);
+    }
+  }
+};
+
+template <>
+MlasCastTest* MlasTestFixture<MlasCastTest>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasCastTest>::RegisterShortExecute();
+  }
+  return count;
+});
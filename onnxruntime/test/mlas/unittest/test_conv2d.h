@@ -60,6 +60,9 @@ class MlasConv2DTest : public MlasTestBase {
                     0.0f,
                     threadpool_);
 
+    // The Winograd algorithm rounds differently from the reference GEMM.
+    ApproximateResult_ = (Parameters.Algorithm == MlasConvAlgorithmWinograd);
+
     MlasConv(&Parameters,
              Input,
              Filter,
@@ -156,6 +159,7 @@ class MlasConv2DTest : public MlasTestBase {
   MatrixGuardBuffer<float> BufferIm2Col;
 
   MLAS_THREADPOOL* threadpool_;
+  bool ApproximateResult_ = false;
 
  public:
   static const char* GetTestSuiteName() {
@@ -215,6 +219,8 @@ class MlasConv2DTest : public MlasTestBase {
     float* Output = BufferOutput.GetBuffer(OutputElements);
     float* OutputReference = BufferOutputReference.GetBuffer(OutputElements);
 
+    ApproximateResult_ = false;
+
     MlasConv2D(BatchCount,
                GroupCount,
                InputChannels,
@@ -246,6 +252,18 @@ class MlasConv2DTest : public MlasTestBase {
                     Bias,
                     OutputReference);
 
+    if (ApproximateResult_) {
+      // Bound the error relative to the largest possible sum of products, using
+      // the +/-23 range of values filled by MatrixGuardBuffer.
+      const float Tolerance = float(InputChannels * KernelSize) * 23.0f * 23.0f * 1e-6f;
+      for (size_t i = 0; i < OutputElements; i++) {
+        ASSERT_NEAR(Output[i], OutputReference[i], Tolerance)
+            << "@" << i << " B" << BatchCount << "/G" << GroupCount << "/Cpg" << InputChannels << "/Fpg"
+            << FilterCount << "/H" << InputHeight << "/W" << InputWidth;
+      }
+      return;
+    }
+
     ASSERT_EQ(memcmp(Output, OutputReference, OutputElements * sizeof(float)), 0)
         << "B" << BatchCount << "/"
         << "G" << GroupCount << "/"
@@ -140,6 +140,10 @@ class Conv2dShortExecuteTest : public MlasTestFixture<Conv2dTester> {
       test_registered += RegisterSingleTest(1, 16, 1, i, i, 1, 3, 3, 1, 1, 1, 1, 1, 1, 1, 1);
       test_registered += RegisterSingleTest(1, 16, 1, i, i, 1, 3, 3, 1, 1, 1, 1, 1, 1, 2, 2);
     }
+    // Winograd eligible convolutions with partial output tiles, groups and batches.
+    test_registered += RegisterSingleTest(1, 1, 16, 17, 23, 16, 3, 3, 1, 1, 1, 1, 1, 1, 1, 1);
+    test_registered += RegisterSingleTest(2, 2, 24, 18, 21, 20, 3, 3, 0, 1, 2, 0, 1, 1, 1, 1);
+    test_registered += RegisterSingleTest(1, 1, 64, 56, 56, 64, 3, 3, 1, 1, 1, 1, 1, 1, 1, 1);
     return test_registered;
   }
 
@@ -0,0 +1,219 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+template <bool Threaded>
+class MlasDynamicQgemmTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferA;
+  MatrixGuardBuffer<uint8_t> BufferB;
+  MatrixGuardBuffer<uint8_t> BufferPackedB;
+  MatrixGuardBuffer<uint8_t> BufferZeroPointB;
+  MatrixGuardBuffer<float> BufferScaleB;
+  MatrixGuardBuffer<float> BufferBias;
+  MatrixGuardBuffer<float> BufferC;
+  MatrixGuardBuffer<float> BufferCReference;
+  MLAS_THREADPOOL* threadpool_;
+
+  static void ReferenceQuantize(const float* A, size_t K, float Scale, uint8_t ZeroPoint, int32_t* QuantA) {
+    for (size_t k = 0; k < K; k++) {
+      float Value = std::nearbyintf(A[k] / Scale) + float(ZeroPoint);
+      QuantA[k] = int32_t(std::min(255.0f, std::max(0.0f, Value)));
+    }
+  }
+
+  void ReferenceGemm(size_t M, size_t N, size_t K, const MLAS_GEMM_DYNAMIC_QUANT_DATA_PARAMS& Data,
+                     bool BIsSigned, bool PerRowScaleA, float* C) {
+    std::vector<int32_t> QuantA(K);
+    std::vector<float> RowA(K);
+
+    for (size_t m = 0; m < M; m++) {
+      // outlier columns are quantized as zeros and multiplied in float
+      const float* a = Data.A + m * Data.lda;
+      std::vector<bool> IsOutlier(K);
+      for (size_t k = 0; k < K; k++) {
+        IsOutlier[k] = Data.OutlierThreshold > 0.0f && std::fabs(a[k]) > Data.OutlierThreshold;
+        RowA[k] = IsOutlier[k] ? 0.0f : a[k];
+      }
+      a = RowA.data();
+
+      float ScaleA = Data.ScaleA;
+      uint8_t ZeroPointA = Data.ZeroPointA;
+
+      if (PerRowScaleA) {
+        float MaximumAbs = 0.0f;
+        for (size_t k = 0; k < K; k++) {
+          MaximumAbs = std::max(MaximumAbs, std::fabs(a[k]));
+        }
+        ScaleA = MaximumAbs > 0.0f ? MaximumAbs / 127.0f : 1.0f;
+        ZeroPointA = 128;
+      }
+
+      ReferenceQuantize(a, K, ScaleA, ZeroPointA, QuantA.data());
+
+      for (size_t n = 0; n < N; n++) {
+        const uint8_t* b = static_cast<const uint8_t*>(Data.B) + n;
+        const uint8_t ZeroPointB = Data.PerColumnZeroPoints ? Data.ZeroPointB[n] : Data.ZeroPointB[0];
+        const float ScaleB = Data.PerColumnScaleB ? Data.ScaleB[n] : Data.ScaleB[0];
+        int32_t Sum = 0;
+        float OutlierSum = 0.0f;
+
+        for (size_t k = 0; k < K; k++) {
+          const int32_t BValue = BIsSigned ? int32_t(int8_t(b[k * Data.ldb])) - int32_t(int8_t(ZeroPointB))
+                                           : int32_t(b[k * Data.ldb]) - int32_t(ZeroPointB);
+          Sum += (QuantA[k] - int32_t(ZeroPointA)) * BValue;
+          if (IsOutlier[k]) {
+            OutlierSum += Data.A[m * Data.lda + k] * (float(BValue) * ScaleB);
+          }
+        }
+
+        C[m * Data.ldc + n] = float(Sum) * (ScaleA * ScaleB) + (Data.Bias != nullptr ? Data.Bias[n] : 0.0f) +
+                              OutlierSum;
+      }
+    }
+  }
+
+ public:
+  MlasDynamicQgemmTest() : threadpool_(Threaded ? GetMlasThreadPool() : nullptr) {}
+
+  void Test(size_t BatchSize, size_t M, size_t N, size_t K, bool BIsSigned, bool PerColumn, bool PackB,
+            bool PerRowScaleA, bool WithBias, float OutlierThreshold = 0.0f) {
+    const size_t lda = K + 3;
+    const size_t ldc = N + 1;
+
+    float* A = BufferA.GetBuffer(BatchSize * M * lda);
+    uint8_t* B = BufferB.GetBuffer(K * N);
+    uint8_t* ZeroPointB = BufferZeroPointB.GetBuffer(N);
+    float* ScaleB = BufferScaleB.GetBuffer(N);
+    float* Bias = WithBias ? BufferBias.GetBuffer(N) : nullptr;
+    float* C = BufferC.GetBuffer(BatchSize * M * ldc);
+    float* CReference = BufferCReference.GetBuffer(BatchSize * M * ldc);
+
+    std::default_random_engine generator(static_cast<unsigned>(M * N * K + BatchSize));
+    std::uniform_real_distribution<float> distribution_a(-4.0f, 4.0f);
+    std::uniform_int_distribution<int32_t> distribution_b(0, 255);
+    // keep signed B to 7 bits, as the U8S8 kernels of AVX2 saturate the sums of pairs of products
+    std::uniform_int_distribution<int32_t> distribution_signed_b(-64, 63);
+    std::uniform_real_distribution<float> distribution_scale(0.01f, 0.1f);
+
+    for (size_t i = 0; i < BatchSize * M * lda; i++) {
+      // vary the range of the rows, which the per-row scales adapt to
+      A[i] = distribution_a(generator) * float((i / lda) % 7 + 1);
+      // outliers in the same columns of all the rows, which are larger than the threshold
+      if (OutlierThreshold > 0.0f && (i % lda) % 13 == 5) {
+        A[i] = (A[i] < 0.0f ? -OutlierThreshold : OutlierThreshold) * 2.0f + A[i];
+      }
+    }
+    for (size_t i = 0; i < K * N; i++) {
+      B[i] = static_cast<uint8_t>(BIsSigned ? distribution_signed_b(generator) : distribution_b(generator));
+    }
+    for (size_t n = 0; n < N; n++) {
+      ZeroPointB[n] = static_cast<uint8_t>(distribution_b(generator));
+      ScaleB[n] = distribution_scale(generator);
+      if (Bias != nullptr) {
+        Bias[n] = distribution_a(generator);
+      }
+    }
+
+    const void* PackedB = nullptr;
+    if (PackB) {
+      size_t PackedBSize = MlasGemmPackBSize(N, K, false, BIsSigned);
+      if (PackedBSize != 0) {
+        void* Packed = BufferPackedB.GetBuffer(PackedBSize, true);
+        MlasGemmPackB(N, K, B, N, false, BIsSigned, Packed);
+        PackedB = Packed;
+      }
+    }
+
+    MLAS_GEMM_QUANT_SHAPE_PARAMS Shape;
+    Shape.M = M;
+    Shape.N = N;
+    Shape.K = K;
+    Shape.BIsSigned = BIsSigned;
+
+    std::vector<MLAS_GEMM_DYNAMIC_QUANT_DATA_PARAMS> DataParams(BatchSize);
+    for (size_t batch = 0; batch < BatchSize; batch++) {
+      auto& Data = DataParams[batch];
+      Data.A = A + batch * M * lda;
+      Data.lda = lda;
+      Data.ScaleA = 0.05f;
+      Data.ZeroPointA = 121;
+      Data.B = B;
+      Data.ldb = N;
+      Data.ZeroPointB = ZeroPointB;
+      Data.PerColumnZeroPoints = PerColumn;
+      Data.ScaleB = ScaleB;
+      Data.PerColumnScaleB = PerColumn;
+      Data.Bias = Bias;
+      Data.C = CReference + batch * M * ldc;
+      Data.ldc = ldc;
+      Data.OutlierThreshold = OutlierThreshold;
+
+      ReferenceGemm(M, N, K, Data, BIsSigned, PerRowScaleA, Data.C);
+
+      if (PackedB != nullptr) {
+        Data.B = PackedB;
+        Data.BIsPacked = true;
+      }
+      Data.C = C + batch * M * ldc;
+    }
+
+    MlasDynamicQuantizeGemmBatch(Shape, DataParams.data(), BatchSize, PerRowScaleA, threadpool_);
+
+    // the float products of the outliers are summed in a different order
+    const float AbsoluteError = OutlierThreshold > 0.0f ? 1e-3f : 1e-5f;
+
+    for (size_t batch = 0; batch < BatchSize; batch++) {
+      for (size_t m = 0; m < M; m++) {
+        for (size_t n = 0; n < N; n++) {
+          const size_t i = (batch * M + m) * ldc + n;
+          ASSERT_NEAR(C[i], CReference[i], std::fabs(CReference[i]) * 1e-5f + AbsoluteError)
+              << " @[" << batch << "," << m << "," << n << "], M=" << M << " N=" << N << " K=" << K
+              << " BIsSigned=" << BIsSigned << " PerColumn=" << PerColumn << " PackB=" << PackB
+              << " PerRowScaleA=" << PerRowScaleA << " OutlierThreshold=" << OutlierThreshold;
+        }
+      }
+    }
+  }
+
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name(Threaded ? "DynamicQgemm_Threaded" : "DynamicQgemm_SingleThread");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    for (bool PerRowScaleA : {false, true}) {
+      for (bool BIsSigned : {false, true}) {
+        for (bool PackB : {false, true}) {
+          Test(1, 1, 33, 17, BIsSigned, false, PackB, PerRowScaleA, true);
+          Test(1, 7, 16, 64, BIsSigned, true, PackB, PerRowScaleA, false);
+          Test(3, 19, 35, 129, BIsSigned, true, PackB, PerRowScaleA, true);
+          Test(2, 300, 64, 96, BIsSigned, false, PackB, PerRowScaleA, true);
+          Test(1, 40, 24, 40000, BIsSigned, true, PackB, PerRowScaleA, false);
+        }
+      }
+    }
+    for (bool BIsSigned : {false, true}) {
+      Test(1, 1, 33, 17, BIsSigned, false, false, true, true, 30.0f);
+      Test(3, 19, 35, 129, BIsSigned, true, false, true, true, 30.0f);
+      Test(2, 300, 64, 96, BIsSigned, true, false, true, false, 30.0f);
+    }
+  }
+};
+
+template <>
+MlasDynamicQgemmTest<false>* MlasTestFixture<MlasDynamicQgemmTest<false>>::mlas_tester(nullptr);
+template <>
+MlasDynamicQgemmTest<true>* MlasTestFixture<MlasDynamicQgemmTest<true>>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasDynamicQgemmTest<false>>::RegisterShortExecute();
+    if (GetMlasThreadPool() != nullptr) {
+      count += MlasDirectShortExecuteTests<MlasDynamicQgemmTest<true>>::RegisterShortExecute();
+    }
+  }
+  return count;
+});
@@ -70,6 +70,10 @@ class FgemmShortExecuteTest : public MlasTestFixture<MlasFgemmTest<T, Packed, Th
     test_registered += RegisterTestTransposeABProduct(128, 3072, 768, 1, 1.0f, 0.0f);
     test_registered += RegisterTestTransposeABProduct(128, 768, 3072, 1, 1.0f, 0.0f);
     test_registered += RegisterTestTransposeABProduct(25, 81, 79, 7, 1.0f, 0.0f);
+    test_registered += RegisterTestTransposeABProduct(4, 7, 9, 12, 0.5f, 1.5f);
+    test_registered += RegisterTestTransposeABProduct(8, 8, 8, 33, 1.0f, 0.0f);
+    test_registered += RegisterTestTransposeABProduct(16, 16, 64, 24, 0.125f, 0.0f);
+    test_registered += RegisterTestTransposeABProduct(32, 64, 32, 12, 1.0f, 1.0f);
     return test_registered;
   }
 
@@ -0,0 +1,144 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+template <bool Threaded>
+class MlasFlashAttentionTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferQuery;
+  MatrixGuardBuffer<float> BufferKey;
+  MatrixGuardBuffer<float> BufferValue;
+  MatrixGuardBuffer<float> BufferOutput;
+  MatrixGuardBuffer<float> BufferOutputReference;
+  MLAS_THREADPOOL* threadpool_;
+
+  void ReferenceAttention(const MLAS_FLASH_ATTENTION_PARAMS& Params, float* Output) {
+    const size_t S = Params.SequenceLength;
+    const size_t L = Params.KvSequenceLength;
+    const size_t H = Params.QkHeadSize;
+    const size_t Hv = Params.VHeadSize;
+    std::vector<double> Probs(L);
+
+    for (size_t b = 0; b < Params.BatchSize; b++) {
+      for (size_t n = 0; n < Params.NumHeads; n++) {
+        const size_t bn = b * Params.NumHeads + n;
+        const float* Query = Params.Query + bn * S * H;
+        const float* Key = Params.Key + bn * L * H;
+        const float* Value = Params.Value + bn * L * Hv;
+
+        for (size_t s = 0; s < S; s++) {
+          size_t KeyCount = L;
+          if (Params.Causal) {
+            const ptrdiff_t LastKey = ptrdiff_t(s + L) - ptrdiff_t(S);
+            KeyCount = size_t(std::min(std::max(LastKey + 1, ptrdiff_t(0)), ptrdiff_t(L)));
+          }
+
+          double Maximum = -std::numeric_limits<double>::infinity();
+          for (size_t l = 0; l < KeyCount; l++) {
+            double Sum = 0.0;
+            for (size_t h = 0; h < H; h++) {
+              Sum += double(Query[s * H + h]) * double(Key[l * H + h]);
+            }
+            Probs[l] = Sum * Params.Scale;
+            Maximum = std::max(Maximum, Probs[l]);
+          }
+
+          double Total = 0.0;
+          for (size_t l = 0; l < KeyCount; l++) {
+            Probs[l] = std::exp(Probs[l] - Maximum);
+            Total += Probs[l];
+          }
+
+          float* Out = Output + ((b * S + s) * Params.NumHeads + n) * Hv;
+          for (size_t h = 0; h < Hv; h++) {
+            double Sum = 0.0;
+            for (size_t l = 0; l < KeyCount; l++) {
+              Sum += Probs[l] * double(Value[l * Hv + h]);
+            }
+            Out[h] = (KeyCount == 0) ? 0.0f : float(Sum / Total);
+          }
+        }
+      }
+    }
+  }
+
+ public:
+  MlasFlashAttentionTest() : threadpool_(Threaded ? GetMlasThreadPool() : nullptr) {}
+
+  void Test(size_t B, size_t N, size_t S, size_t L, size_t H, size_t Hv, bool Causal) {
+    MLAS_FLASH_ATTENTION_PARAMS Params;
+    Params.BatchSize = B;
+    Params.NumHeads = N;
+    Params.SequenceLength = S;
+    Params.KvSequenceLength = L;
+    Params.QkHeadSize = H;
+    Params.VHeadSize = Hv;
+    Params.Scale = 1.0f / std::sqrt(float(H));
+    Params.Causal = Causal;
+
+    float* Query = BufferQuery.GetBuffer(B * N * S * H);
+    float* Key = BufferKey.GetBuffer(B * N * L * H);
+    float* Value = BufferValue.GetBuffer(B * N * L * Hv);
+    float* Output = BufferOutput.GetBuffer(B * S * N * Hv);
+    float* OutputReference = BufferOutputReference.GetBuffer(B * S * N * Hv);
+
+    std::default_random_engine generator(static_cast<unsigned>(B * N * S * L * H));
+    std::uniform_real_distribution<float> distribution(-2.0f, 2.0f);
+    for (size_t i = 0; i < B * N * S * H; i++) Query[i] = distribution(generator);
+    for (size_t i = 0; i < B * N * L * H; i++) Key[i] = distribution(generator);
+    for (size_t i = 0; i < B * N * L * Hv; i++) Value[i] = distribution(generator);
+
+    Params.Query = Query;
+    Params.Key = Key;
+    Params.Value = Value;
+    Params.Output = Output;
+
+    MlasFlashAttention(&Params, threadpool_);
+    ReferenceAttention(Params, OutputReference);
+
+    constexpr float AbsoluteTolerance = 1e-4f;
+    constexpr float RelativeTolerance = 1e-4f;
+
+    for (size_t i = 0; i < B * S * N * Hv; i++) {
+      float diff = std::fabs(Output[i] - OutputReference[i]);
+      ASSERT_TRUE(diff <= AbsoluteTolerance || diff <= std::fabs(OutputReference[i]) * RelativeTolerance)
+          << "@" << i << " B=" << B << " N=" << N << " S=" << S << " L=" << L << " H=" << H
+          << " Hv=" << Hv << " Causal=" << Causal
+          << ", got: " << Output[i] << ", expecting: " << OutputReference[i];
+    }
+  }
+
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name(Threaded ? "FlashAttention_Threaded" : "FlashAttention_SingleThread");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    for (bool Causal : {false, true}) {
+      Test(1, 1, 1, 1, 8, 8, Causal);
+      Test(1, 2, 1, 300, 64, 64, Causal);
+      Test(2, 3, 17, 17, 16, 24, Causal);
+      Test(1, 2, 65, 65, 32, 32, Causal);
+      Test(1, 1, 70, 600, 64, 48, Causal);
+      Test(2, 2, 130, 257, 40, 40, Causal);
+      Test(1, 1, 300, 100, 8, 16, Causal);
+    }
+  }
+};
+
+template <>
+MlasFlashAttentionTest<false>* MlasTestFixture<MlasFlashAttentionTest<false>>::mlas_tester(nullptr);
+template <>
+MlasFlashAttentionTest<true>* MlasTestFixture<MlasFlashAttentionTest<true>>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasFlashAttentionTest<false>>::RegisterShortExecute();
+    if (GetMlasThreadPool() != nullptr) {
+      count += MlasDirectShortExecuteTests<MlasFlashAttentionTest<true>>::RegisterShortExecute();
+    }
+  }
+  return count;
+});
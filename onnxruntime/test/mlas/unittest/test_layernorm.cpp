@@ -0,0 +1,156 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+template <bool Threaded>
+class MlasLayerNormTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferInput;
+  MatrixGuardBuffer<float> BufferSkip;
+  MatrixGuardBuffer<float> BufferBias;
+  MatrixGuardBuffer<float> BufferScale;
+  MatrixGuardBuffer<float> BufferNormBias;
+  MatrixGuardBuffer<float> BufferOutput;
+  MatrixGuardBuffer<float> BufferSumOutput;
+  MatrixGuardBuffer<float> BufferOutputReference;
+  MatrixGuardBuffer<float> BufferSumOutputReference;
+  MatrixGuardBuffer<float> BufferStatistics;
+  MatrixGuardBuffer<float> BufferStatisticsReference;
+  MLAS_THREADPOOL* threadpool_;
+
+  void ReferenceLayerNorm(const MLAS_LAYER_NORM_PARAMS& Params, size_t N, size_t D,
+                          float* Output, float* SumOutput, float* Mean, float* InvStdDev) {
+    std::vector<double> Values(D);
+
+    for (size_t n = 0; n < N; n++) {
+      double Sum = 0.0;
+      for (size_t d = 0; d < D; d++) {
+        double Value = Params.Input[n * D + d];
+        if (Params.Skip != nullptr) Value += Params.Skip[n * D + d];
+        if (Params.Bias != nullptr) Value += Params.Bias[d];
+        Values[d] = Value;
+        SumOutput[n * D + d] = float(Value);
+        Sum += Value;
+      }
+
+      const double RowMean = Params.Simplified ? 0.0 : Sum / D;
+      double Variance = 0.0;
+      for (size_t d = 0; d < D; d++) {
+        Variance += (Values[d] - RowMean) * (Values[d] - RowMean);
+      }
+      Variance /= D;
+
+      const double RowInvStdDev = 1.0 / std::sqrt(Variance + Params.Epsilon);
+      Mean[n] = float(RowMean);
+      InvStdDev[n] = float(RowInvStdDev);
+
+      for (size_t d = 0; d < D; d++) {
+        double Value = (Values[d] - RowMean) * RowInvStdDev * Params.Scale[d];
+        if (Params.NormBias != nullptr) Value += Params.NormBias[d];
+        Output[n * D + d] = float(Value);
+      }
+    }
+  }
+
+  static void Check(const float* Output, const float* OutputReference, size_t Count, const char* Name,
+                    size_t N, size_t D, bool Skip, bool Bias, bool NormBias, bool Simplified) {
+    constexpr float AbsoluteTolerance = 1e-4f;
+    constexpr float RelativeTolerance = 1e-4f;
+
+    for (size_t i = 0; i < Count; i++) {
+      float diff = std::fabs(Output[i] - OutputReference[i]);
+      ASSERT_TRUE(diff <= AbsoluteTolerance || diff <= std::fabs(OutputReference[i]) * RelativeTolerance)
+          << Name << " @" << i << " N=" << N << " D=" << D << " Skip=" << Skip << " Bias=" << Bias
+          << " NormBias=" << NormBias << " Simplified=" << Simplified
+          << ", got: " << Output[i] << ", expecting: " << OutputReference[i];
+    }
+  }
+
+ public:
+  MlasLayerNormTest() : threadpool_(Threaded ? GetMlasThreadPool() : nullptr) {}
+
+  void Test(size_t N, size_t D, bool Skip, bool Bias, bool NormBias, bool Simplified) {
+    float* Input = BufferInput.GetBuffer(N * D);
+    float* SkipData = BufferSkip.GetBuffer(N * D);
+    float* BiasData = BufferBias.GetBuffer(D);
+    float* Scale = BufferScale.GetBuffer(D);
+    float* NormBiasData = BufferNormBias.GetBuffer(D);
+    float* Output = BufferOutput.GetBuffer(N * D);
+    float* SumOutput = BufferSumOutput.GetBuffer(N * D);
+    float* OutputReference = BufferOutputReference.GetBuffer(N * D);
+    float* SumOutputReference = BufferSumOutputReference.GetBuffer(N * D);
+    float* Mean = BufferStatistics.GetBuffer(N * 2);
+    float* InvStdDev = Mean + N;
+    float* MeanReference = BufferStatisticsReference.GetBuffer(N * 2);
+    float* InvStdDevReference = MeanReference + N;
+
+    std::default_random_engine generator(static_cast<unsigned>(N * D));
+    std::uniform_real_distribution<float> distribution(-5.0f, 5.0f);
+    for (size_t i = 0; i < N * D; i++) {
+      Input[i] = distribution(generator) + 2.0f;
+      SkipData[i] = distribution(generator);
+    }
+    for (size_t d = 0; d < D; d++) {
+      BiasData[d] = distribution(generator) * 0.1f;
+      Scale[d] = distribution(generator);
+      NormBiasData[d] = distribution(generator);
+    }
+
+    MLAS_LAYER_NORM_PARAMS Params;
+    Params.Input = Input;
+    Params.Skip = Skip ? SkipData : nullptr;
+    Params.Bias = Bias ? BiasData : nullptr;
+    Params.Scale = Scale;
+    Params.NormBias = NormBias ? NormBiasData : nullptr;
+    Params.Output = Output;
+    Params.SumOutput = (Skip || Bias) ? SumOutput : nullptr;
+    Params.Mean = Mean;
+    Params.InvStdDev = InvStdDev;
+    Params.Epsilon = 1e-5f;
+    Params.Simplified = Simplified;
+
+    MlasComputeLayerNorm(&Params, N, D, threadpool_);
+    ReferenceLayerNorm(Params, N, D, OutputReference, SumOutputReference, MeanReference, InvStdDevReference);
+
+    Check(Output, OutputReference, N * D, "Output", N, D, Skip, Bias, NormBias, Simplified);
+    Check(Mean, MeanReference, N, "Mean", N, D, Skip, Bias, NormBias, Simplified);
+    Check(InvStdDev, InvStdDevReference, N, "InvStdDev", N, D, Skip, Bias, NormBias, Simplified);
+    if (Skip || Bias) {
+      Check(SumOutput, SumOutputReference, N * D, "SumOutput", N, D, Skip, Bias, NormBias, Simplified);
+    }
+  }
+
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name(Threaded ? "LayerNorm_Threaded" : "LayerNorm_SingleThread");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    for (size_t D : {1, 3, 4, 7, 8, 15, 16, 17, 31, 32, 33, 64, 100, 768, 1027}) {
+      for (bool Simplified : {false, true}) {
+        Test(5, D, false, false, !Simplified, Simplified);
+        Test(5, D, true, false, !Simplified, Simplified);
+        Test(5, D, true, true, !Simplified, Simplified);
+        Test(5, D, false, true, false, Simplified);
+      }
+    }
+    Test(256, 768, true, true, true, false);
+  }
+};
+
+template <>
+MlasLayerNormTest<false>* MlasTestFixture<MlasLayerNormTest<false>>::mlas_tester(nullptr);
+template <>
+MlasLayerNormTest<true>* MlasTestFixture<MlasLayerNormTest<true>>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasLayerNormTest<false>>::RegisterShortExecute();
+    if (GetMlasThreadPool() != nullptr) {
+      count += MlasDirectShortExecuteTests<MlasLayerNormTest<true>>::RegisterShortExecute();
+    }
+  }
+  return count;
+});
@@ -55,7 +55,47 @@ bool AddTestRegister(TestRegister test_register) {
   return true;
 }
 
+// Handles --mlas_isa=<level>, which caps the instruction set of the kernels under test, for example to test the AVX2
+// kernels on a machine with AVX512. The option is removed from argv.
+static bool ApplyMlasIsaOption(int& argc, char** argv) {
+  static const char option[] = "--mlas_isa=";
+  constexpr size_t option_length = sizeof(option) - 1;
+
+  for (int i = 1; i < argc; i++) {
+    if (strncmp(argv[i], option, option_length) != 0) {
+      continue;
+    }
+    const char* name = argv[i] + option_length;
+    for (int j = i; j < argc - 1; j++) {
+      argv[j] = argv[j + 1];
+    }
+    argc--;
+
+#if defined(MLAS_TARGET_AMD64_IX86)
+    for (int level = 0; level < MlasIsaLevelCount; level++) {
+      if (strcmp(name, MlasGetIsaLevelName(static_cast<MLAS_ISA_LEVEL>(level))) == 0) {
+        MlasSetMaximumIsaLevel(static_cast<MLAS_ISA_LEVEL>(level));
+        std::cout << "----Kernels limited to " << name << "!" << std::endl;
+        return true;
+      }
+    }
+    std::cerr << "Unknown --mlas_isa level '" << name << "', expected one of:";
+    for (int level = 0; level < MlasIsaLevelCount; level++) {
+      std::cerr << " " << MlasGetIsaLevelName(static_cast<MLAS_ISA_LEVEL>(level));
+    }
+    std::cerr << std::endl;
+#else
+    std::cerr << "--mlas_isa=" << name << " is only supported on x86" << std::endl;
+#endif
+    return false;
+  }
+  return true;
+}
+
 int main(int argc, char** argv) {
+  if (!ApplyMlasIsaOption(argc, argv)) {
+    return 1;
+  }
   bool is_short_execute = (argc <= 1 || strcmp("--long", argv[1]) != 0);
   std::cout << "-------------------------------------------------------" << std::endl;
   if (is_short_execute) {
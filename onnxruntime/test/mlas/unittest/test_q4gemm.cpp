@@ -0,0 +1,175 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    test_q4gemm.cpp
+
+Abstract:
+
+    Tests for MLAS GEMM for blockwise int4 quantized weights.
+
+--*/
+
+#include "test_util.h"
+#include "mlas_q4.h"
+
+static const char* GetBlkQuantTypeName(MLAS_BLK_QUANT_TYPE QType) {
+  switch (QType) {
+    case BlkQ4Sym:
+      return "BlkQ4Sym";
+    case BlkQ4Zp8:
+      return "BlkQ4Zp8";
+    case BlkQ4Sym64:
+      return "BlkQ4Sym64";
+    case BlkQ4Sym128:
+      return "BlkQ4Sym128";
+    default:
+      return "Unknown";
+  }
+}
+
+template <MLAS_BLK_QUANT_TYPE QType, bool Threaded>
+class MlasQ4GemmTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferA;
+  MatrixGuardBuffer<float> BufferB;
+  MatrixGuardBuffer<float> BufferUnpackedB;
+  MatrixGuardBuffer<uint8_t> BufferPackedB;
+  MatrixGuardBuffer<float> BufferBias;
+  MatrixGuardBuffer<float> BufferC;
+  MatrixGuardBuffer<float> BufferCReference;
+  MLAS_THREADPOOL* threadpool_;
+
+  void ReferenceGemm(size_t M, size_t N, size_t K,
+                     const float* A, const float* B, const float* Bias, float* C) {
+    for (size_t m = 0; m < M; m++) {
+      for (size_t n = 0; n < N; n++) {
+        double sum = (Bias != nullptr) ? Bias[n] : 0.0;
+        for (size_t k = 0; k < K; k++) {
+          sum += double(A[m * K + k]) * double(B[k * N + n]);
+        }
+        C[m * N + n] = float(sum);
+      }
+    }
+  }
+
+ public:
+  MlasQ4GemmTest() : threadpool_(Threaded ? GetMlasThreadPool() : nullptr) {}
+
+  void Test(size_t M, size_t N, size_t K, bool WithBias) {
+    std::default_random_engine generator(static_cast<unsigned>(M * N * K));
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+    auto fill = [&](float* start, size_t size) {
+      for (size_t i = 0; i < size; i++) {
+        start[i] = distribution(generator);
+      }
+    };
+
+    const float* A = BufferA.GetFilledBuffer(M * K, fill);
+    const float* B = BufferB.GetFilledBuffer(K * N, fill);
+    const float* Bias = WithBias ? BufferBias.GetFilledBuffer(N, fill) : nullptr;
+
+    const size_t PackedBSize = MlasQ4GemmPackBSize(QType, N, K);
+    ASSERT_GT(PackedBSize, size_t(0));
+    uint8_t* PackedB = BufferPackedB.GetBuffer(PackedBSize, true);
+    MlasQ4GemmPackB(QType, PackedB, B, N, K, N);
+
+    //
+    // The reference is computed with the dequantized weights so that only
+    // accumulation order differences remain.
+    //
+
+    float* UnpackedB = BufferUnpackedB.GetBuffer(K * N, true);
+    MlasQ4GemmUnPackB(QType, UnpackedB, PackedB, N, K, N);
+
+    //
+    // With B in [-1, 1], a block scale is at most 1/7.5, so each value must
+    // be within one quantization step of the original.
+    //
+
+    for (size_t i = 0; i < K * N; i++) {
+      ASSERT_LE(std::fabs(UnpackedB[i] - B[i]), 0.14f) << "dequantization error too large @" << i;
+    }
+
+    float* C = BufferC.GetBuffer(M * N, true);
+    float* CReference = BufferCReference.GetBuffer(M * N, true);
+
+    MLAS_Q4_GEMM_DATA_PARAMS params;
+    params.A = A;
+    params.lda = K;
+    params.B = PackedB;
+    params.Bias = Bias;
+    params.C = C;
+    params.ldc = N;
+    MlasQ4GemmBatch(QType, M, N, K, 1, &params, threadpool_);
+
+    ReferenceGemm(M, N, K, A, UnpackedB, Bias, CReference);
+
+    for (size_t m = 0; m < M; m++) {
+      for (size_t n = 0; n < N; n++) {
+        const float ref = CReference[m * N + n];
+        ASSERT_NEAR(C[m * N + n], ref, 1e-3f * (std::fabs(ref) + 1.0f))
+            << "@[" << m << "," << n << "], M=" << M << ", N=" << N << ", K=" << K;
+      }
+    }
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name = std::string("Q4GemmFP") +
+                                          GetBlkQuantTypeName(QType) +
+                                          (Threaded ? "_Threaded" : "_SingleThread");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    for (size_t M : {1, 2, 4, 5, 16}) {
+      for (size_t N : {1, 3, 4, 17, 64}) {
+        for (size_t K : {1, 31, 32, 33, 128, 255, 300}) {
+          Test(M, N, K, (M + N) % 2 == 0);
+        }
+      }
+    }
+    Test(1, 1024, 1024, true);
+    Test(3, 513, 768, false);
+    Test(100, 96, 520, true);
+  }
+};
+
+template <>
+MlasQ4GemmTest<BlkQ4Sym, false>* MlasTestFixture<MlasQ4GemmTest<BlkQ4Sym, false>>::mlas_tester(nullptr);
+template <>
+MlasQ4GemmTest<BlkQ4Zp8, false>* MlasTestFixture<MlasQ4GemmTest<BlkQ4Zp8, false>>::mlas_tester(nullptr);
+template <>
+MlasQ4GemmTest<BlkQ4Sym64, false>* MlasTestFixture<MlasQ4GemmTest<BlkQ4Sym64, false>>::mlas_tester(nullptr);
+template <>
+MlasQ4GemmTest<BlkQ4Sym128, false>* MlasTestFixture<MlasQ4GemmTest<BlkQ4Sym128, false>>::mlas_tester(nullptr);
+template <>
+MlasQ4GemmTest<BlkQ4Sym, true>* MlasTestFixture<MlasQ4GemmTest<BlkQ4Sym, true>>::mlas_tester(nullptr);
+template <>
+MlasQ4GemmTest<BlkQ4Zp8, true>* MlasTestFixture<MlasQ4GemmTest<BlkQ4Zp8, true>>::mlas_tester(nullptr);
+template <>
+MlasQ4GemmTest<BlkQ4Sym64, true>* MlasTestFixture<MlasQ4GemmTest<BlkQ4Sym64, true>>::mlas_tester(nullptr);
+template <>
+MlasQ4GemmTest<BlkQ4Sym128, true>* MlasTestFixture<MlasQ4GemmTest<BlkQ4Sym128, true>>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasQ4GemmTest<BlkQ4Sym, false>>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasQ4GemmTest<BlkQ4Zp8, false>>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasQ4GemmTest<BlkQ4Sym64, false>>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasQ4GemmTest<BlkQ4Sym128, false>>::RegisterShortExecute();
+    if (GetMlasThreadPool() != nullptr) {
+      count += MlasDirectShortExecuteTests<MlasQ4GemmTest<BlkQ4Sym, true>>::RegisterShortExecute();
+      count += MlasDirectShortExecuteTests<MlasQ4GemmTest<BlkQ4Zp8, true>>::RegisterShortExecute();
+      count += MlasDirectShortExecuteTests<MlasQ4GemmTest<BlkQ4Sym64, true>>::RegisterShortExecute();
+      count += MlasDirectShortExecuteTests<MlasQ4GemmTest<BlkQ4Sym128, true>>::RegisterShortExecute();
+    }
+  }
+  return count;
+});
@@ -0,0 +1,81 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+class MlasRoPETest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferInput;
+  MatrixGuardBuffer<float> BufferSin;
+  MatrixGuardBuffer<float> BufferCos;
+  MatrixGuardBuffer<float> BufferOutput;
+  MatrixGuardBuffer<float> BufferOutputReference;
+
+  void Test(size_t RotaryEmbeddingDim, bool Interleaved) {
+    const size_t HalfDim = RotaryEmbeddingDim / 2;
+    float* Input = BufferInput.GetBuffer(RotaryEmbeddingDim);
+    float* SinData = BufferSin.GetBuffer(HalfDim);
+    float* CosData = BufferCos.GetBuffer(HalfDim);
+    float* Output = BufferOutput.GetBuffer(RotaryEmbeddingDim);
+    float* OutputReference = BufferOutputReference.GetBuffer(RotaryEmbeddingDim);
+
+    std::default_random_engine generator(static_cast<unsigned>(RotaryEmbeddingDim));
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+
+    for (size_t i = 0; i < RotaryEmbeddingDim; i++) {
+      Input[i] = distribution(generator);
+    }
+    for (size_t i = 0; i < HalfDim; i++) {
+      const float theta = distribution(generator) * 3.14159f;
+      SinData[i] = std::sin(theta);
+      CosData[i] = std::cos(theta);
+    }
+
+    MlasRotaryEmbedOneRow(Input, SinData, CosData, RotaryEmbeddingDim, Interleaved, Output);
+    ReferenceRoPE(Input, SinData, CosData, RotaryEmbeddingDim, Interleaved, OutputReference);
+
+    constexpr float AbsoluteTolerance = 1e-6f;
+    for (size_t i = 0; i < RotaryEmbeddingDim; i++) {
+      ASSERT_NEAR(Output[i], OutputReference[i], AbsoluteTolerance)
+          << "Interleaved:" << Interleaved << " dim " << RotaryEmbeddingDim << " index " << i;
+    }
+
+    // The rotation may be applied in place.
+    MlasRotaryEmbedOneRow(Input, SinData, CosData, RotaryEmbeddingDim, Interleaved, Input);
+    for (size_t i = 0; i < RotaryEmbeddingDim; i++) {
+      ASSERT_NEAR(Input[i], OutputReference[i], AbsoluteTolerance)
+          << "In place, Interleaved:" << Interleaved << " dim " << RotaryEmbeddingDim << " index " << i;
+    }
+  }
+
+  void ReferenceRoPE(const float* Input, const float* SinData, const float* CosData,
+                     size_t RotaryEmbeddingDim, bool Interleaved, float* Output) {
+    const size_t HalfDim = RotaryEmbeddingDim / 2;
+    for (size_t i = 0; i < HalfDim; i++) {
+      const size_t i0 = Interleaved ? 2 * i : i;
+      const size_t i1 = Interleaved ? 2 * i + 1 : i + HalfDim;
+      Output[i0] = Input[i0] * CosData[i] - Input[i1] * SinData[i];
+      Output[i1] = Input[i1] * CosData[i] + Input[i0] * SinData[i];
+    }
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name("RoPE");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    for (size_t d = 2; d <= 160; d += 2) {
+      Test(d, false);
+      Test(d, true);
+    }
+  }
+};
+
+template <>
+MlasRoPETest* MlasTestFixture<MlasRoPETest>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  return is_short_execute ? MlasDirectShortExecuteTests<MlasRoPETest>::RegisterShortExecute() : 0;
+});
@@ -0,0 +1,99 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+template <bool Threaded>
+class MlasS16GemmTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<int16_t> BufferA;
+  MatrixGuardBuffer<int16_t> BufferB;
+  MatrixGuardBuffer<int32_t> BufferC;
+  MatrixGuardBuffer<int32_t> BufferCReference;
+  MLAS_THREADPOOL* threadpool_;
+
+  static void ReferenceGemm(size_t M, size_t N, size_t K, const int16_t* A, size_t lda,
+                            const int16_t* B, size_t ldb, int32_t* C, size_t ldc) {
+    for (size_t m = 0; m < M; m++) {
+      for (size_t n = 0; n < N; n++) {
+        int32_t Sum = 0;
+        for (size_t k = 0; k < K; k++) {
+          Sum += int32_t(A[m * lda + k]) * int32_t(B[k * ldb + n]);
+        }
+        C[m * ldc + n] = Sum;
+      }
+    }
+  }
+
+ public:
+  MlasS16GemmTest() : threadpool_(Threaded ? GetMlasThreadPool() : nullptr) {}
+
+  void Test(size_t M, size_t N, size_t K, int16_t AMaximum, int16_t BMaximum) {
+    // leave a gap between the rows to test the leading dimensions
+    const size_t lda = K + 3;
+    const size_t ldb = N + 5;
+    const size_t ldc = N + 1;
+
+    int16_t* A = BufferA.GetBuffer(M * lda);
+    int16_t* B = BufferB.GetBuffer(K * ldb);
+    int32_t* C = BufferC.GetBuffer(M * ldc);
+    int32_t* CReference = BufferCReference.GetBuffer(M * ldc);
+
+    std::default_random_engine generator(static_cast<unsigned>(M * N * K));
+    std::uniform_int_distribution<int32_t> distribution_a(-AMaximum, AMaximum);
+    std::uniform_int_distribution<int32_t> distribution_b(-BMaximum, BMaximum);
+    for (size_t i = 0; i < M * lda; i++) {
+      A[i] = static_cast<int16_t>(distribution_a(generator));
+    }
+    for (size_t i = 0; i < K * ldb; i++) {
+      B[i] = static_cast<int16_t>(distribution_b(generator));
+    }
+    std::fill_n(C, M * ldc, -1);
+    std::fill_n(CReference, M * ldc, -1);
+
+    MlasGemmS16(M, N, K, A, lda, B, ldb, C, ldc, threadpool_);
+    ReferenceGemm(M, N, K, A, lda, B, ldb, CReference, ldc);
+
+    for (size_t m = 0; m < M; m++) {
+      for (size_t n = 0; n < ldc; n++) {
+        ASSERT_EQ(C[m * ldc + n], CReference[m * ldc + n])
+            << " @[" << m << "," << n << "], M=" << M << " N=" << N << " K=" << K;
+      }
+    }
+  }
+
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name(Threaded ? "S16Gemm_Threaded" : "S16Gemm_SingleThread");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    // int16 activations with weights in the int8 range, and full range values with a short K
+    for (size_t M : {1, 2, 3, 4, 5, 16}) {
+      for (size_t N : {1, 7, 16, 17, 33, 130}) {
+        for (size_t K : {1, 2, 3, 16, 31, 257}) {
+          Test(M, N, K, 32767, 127);
+        }
+      }
+    }
+    Test(3, 40, 2, 32767, 32767);
+    Test(64, 96, 768, 4096, 127);
+    Test(255, 1024, 64, 4096, 127);
+  }
+};
+
+template <>
+MlasS16GemmTest<false>* MlasTestFixture<MlasS16GemmTest<false>>::mlas_tester(nullptr);
+template <>
+MlasS16GemmTest<true>* MlasTestFixture<MlasS16GemmTest<true>>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasS16GemmTest<false>>::RegisterShortExecute();
+    if (GetMlasThreadPool() != nullptr) {
+      count += MlasDirectShortExecuteTests<MlasS16GemmTest<true>>::RegisterShortExecute();
+    }
+  }
+  return count;
+});
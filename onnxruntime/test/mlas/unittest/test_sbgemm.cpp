@@ -0,0 +1,153 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    test_sbgemm.cpp
+
+Abstract:
+
+    Tests for MLAS single precision GEMM computed with bfloat16 inputs (SBGEMM).
+
+--*/
+
+#include "test_util.h"
+
+template <bool Packed, bool Threaded>
+class MlasSBGemmTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferA;
+  MatrixGuardBuffer<float> BufferB;
+  MatrixGuardBuffer<uint8_t> BufferPackedB;
+  MatrixGuardBuffer<float> BufferC;
+  MatrixGuardBuffer<float> BufferCReference;
+  MatrixGuardBuffer<float> BufferTolerance;
+  MLAS_THREADPOOL* threadpool_;
+
+  //
+  // The inputs are rounded to bfloat16, so the error of each product is
+  // bounded by 2^-7 of its magnitude.
+  //
+
+  void ReferenceGemm(bool TransA, bool TransB, size_t M, size_t N, size_t K, float alpha,
+                     const float* A, size_t lda, const float* B, size_t ldb, float beta,
+                     float* C, size_t ldc, float* Tolerance) {
+    for (size_t m = 0; m < M; m++) {
+      for (size_t n = 0; n < N; n++) {
+        double sum = 0.0;
+        double magnitude = 0.0;
+        for (size_t k = 0; k < K; k++) {
+          const double a = TransA ? A[k * lda + m] : A[m * lda + k];
+          const double b = TransB ? B[n * ldb + k] : B[k * ldb + n];
+          sum += a * b;
+          magnitude += std::fabs(a * b);
+        }
+        C[m * ldc + n] = float(alpha * sum + beta * C[m * ldc + n]);
+        Tolerance[m * ldc + n] = float(std::fabs(alpha) * magnitude / 128.0 + 1e-4);
+      }
+    }
+  }
+
+ public:
+  MlasSBGemmTest() : threadpool_(Threaded ? GetMlasThreadPool() : nullptr) {}
+
+  void Test(bool TransA, bool TransB, size_t M, size_t N, size_t K, float alpha, float beta) {
+    // As with MlasGemmPackBSize, there is no packed form of an empty matrix B.
+    if (Packed && K == 0) {
+      return;
+    }
+
+    const size_t lda = TransA ? M : K;
+    const size_t ldb = TransB ? K : N;
+    const size_t ldc = N + 3;
+
+    const float* A = BufferA.GetBuffer(M * K);
+    const float* B = BufferB.GetBuffer(K * N);
+    float* C = BufferC.GetBuffer(M * ldc);
+    float* CReference = BufferCReference.GetBuffer(M * ldc);
+    float* Tolerance = BufferTolerance.GetBuffer(M * ldc);
+
+    std::copy_n(C, M * ldc, CReference);
+
+    MLAS_SGEMM_DATA_PARAMS params;
+    params.A = A;
+    params.lda = lda;
+    params.B = B;
+    params.ldb = ldb;
+    params.C = C;
+    params.ldc = ldc;
+    params.alpha = alpha;
+    params.beta = beta;
+
+    if (Packed) {
+      const size_t PackedBSize = MlasSBGemmPackBSize(N, K);
+      ASSERT_GT(PackedBSize, size_t(0));
+      uint8_t* PackedB = BufferPackedB.GetBuffer(PackedBSize, true);
+      MlasSBGemmPackB(TransB ? CblasTrans : CblasNoTrans, N, K, B, ldb, PackedB);
+      params.B = reinterpret_cast<const float*>(PackedB);
+      params.BIsPacked = true;
+    }
+
+    MlasSBGemmBatch(TransA ? CblasTrans : CblasNoTrans, TransB ? CblasTrans : CblasNoTrans,
+                    M, N, K, &params, 1, threadpool_);
+
+    ReferenceGemm(TransA, TransB, M, N, K, alpha, A, lda, B, ldb, beta, CReference, ldc, Tolerance);
+
+    for (size_t m = 0; m < M; m++) {
+      for (size_t n = 0; n < N; n++) {
+        const size_t i = m * ldc + n;
+        ASSERT_NEAR(C[i], CReference[i], Tolerance[i])
+            << "@[" << m << "," << n << "], TransA=" << TransA << ", TransB=" << TransB
+            << ", M=" << M << ", N=" << N << ", K=" << K << ", alpha=" << alpha << ", beta=" << beta;
+      }
+    }
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name = std::string("SBGemm") +
+                                          (Packed ? "_PackB" : "_NoPack") +
+                                          (Threaded ? "_Threaded" : "_SingleThread");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    for (size_t M : {1, 2, 5, 16, 17, 33}) {
+      for (size_t N : {1, 15, 16, 17, 33, 129}) {
+        for (size_t K : {0, 1, 2, 31, 32, 33, 257}) {
+          Test(false, false, M, N, K, 1.0f, 0.0f);
+          Test(true, false, M, N, K, 1.0f, 0.0f);
+          Test(false, true, M, N, K, 0.5f, 1.0f);
+          Test(true, true, M, N, K, 1.0f, 0.25f);
+        }
+      }
+    }
+    Test(false, false, 64, 512, 600, 1.0f, 0.0f);
+    Test(false, true, 129, 300, 256, 1.0f, 0.0f);
+  }
+};
+
+template <>
+MlasSBGemmTest<false, false>* MlasTestFixture<MlasSBGemmTest<false, false>>::mlas_tester(nullptr);
+template <>
+MlasSBGemmTest<true, false>* MlasTestFixture<MlasSBGemmTest<true, false>>::mlas_tester(nullptr);
+template <>
+MlasSBGemmTest<false, true>* MlasTestFixture<MlasSBGemmTest<false, true>>::mlas_tester(nullptr);
+template <>
+MlasSBGemmTest<true, true>* MlasTestFixture<MlasSBGemmTest<true, true>>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute && MlasBf16AccelerationSupported()) {
+    count += MlasDirectShortExecuteTests<MlasSBGemmTest<false, false>>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasSBGemmTest<true, false>>::RegisterShortExecute();
+    if (GetMlasThreadPool() != nullptr) {
+      count += MlasDirectShortExecuteTests<MlasSBGemmTest<false, true>>::RegisterShortExecute();
+      count += MlasDirectShortExecuteTests<MlasSBGemmTest<true, true>>::RegisterShortExecute();
+    }
+  }
+  return count;
+});
@@ -0,0 +1,179 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+template <bool Packed, bool Threaded>
+class MlasSgemmEpilogueTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferA;
+  MatrixGuardBuffer<float> BufferB;
+  MatrixGuardBuffer<float> BufferBias;
+  MatrixGuardBuffer<float> BufferResidual;
+  MatrixGuardBuffer<float> BufferC;
+  MatrixGuardBuffer<float> BufferCReference;
+  MatrixGuardBuffer<uint8_t> BufferBPacked;
+  MLAS_THREADPOOL* threadpool_;
+
+  static float ReferenceFunction(const MLAS_SGEMM_EPILOGUE& Epilogue, float Value) {
+    if (Epilogue.Activation != nullptr) {
+      switch (Epilogue.Activation->ActivationKind) {
+        case MlasReluActivation:
+          Value = std::max(Value, 0.0f);
+          break;
+        case MlasLeakyReluActivation:
+          Value = (Value >= 0.0f) ? Value : Value * Epilogue.Activation->Parameters.LeakyRelu.alpha;
+          break;
+        case MlasTanhActivation:
+          Value = std::tanh(Value);
+          break;
+        default:
+          break;
+      }
+    }
+
+    if (Epilogue.Function == MlasSgemmEpilogueGelu) {
+      Value = 0.5f * Value * (1.0f + std::erf(Value * 0.70710678118654752f));
+    } else if (Epilogue.Function == MlasSgemmEpilogueSilu) {
+      Value = Value / (1.0f + std::exp(-Value));
+    }
+
+    return Value;
+  }
+
+ public:
+  MlasSgemmEpilogueTest() : threadpool_(Threaded ? GetMlasThreadPool() : nullptr) {}
+
+  void Test(bool TransA, bool TransB, size_t M, size_t N, size_t K, float beta,
+            bool Bias, bool Residual, const MLAS_ACTIVATION* Activation, MLAS_SGEMM_EPILOGUE_FUNCTION Function) {
+    const float* A = BufferA.GetBuffer(M * K);
+    const float* B = BufferB.GetBuffer(K * N);
+    const float* BiasData = BufferBias.GetBuffer(N);
+    const float* ResidualData = BufferResidual.GetBuffer(M * N);
+    float* C = BufferC.GetBuffer(M * N, true);
+    float* CReference = BufferCReference.GetBuffer(M * N, true);
+
+    const size_t lda = TransA ? M : K;
+    const size_t ldb = TransB ? K : N;
+
+    for (size_t i = 0; i < M * N; i++) {
+      C[i] = float(int(i % 7) - 3);
+    }
+
+    for (size_t m = 0; m < M; m++) {
+      for (size_t n = 0; n < N; n++) {
+        double Sum = 0.0;
+        for (size_t k = 0; k < K; k++) {
+          const float a = TransA ? A[k * lda + m] : A[m * lda + k];
+          const float b = TransB ? B[n * ldb + k] : B[k * ldb + n];
+          Sum += double(a) * double(b);
+        }
+        CReference[m * N + n] = float(Sum) + beta * C[m * N + n];
+      }
+    }
+
+    MLAS_SGEMM_EPILOGUE Epilogue;
+    Epilogue.Bias = Bias ? BiasData : nullptr;
+    Epilogue.Residual = Residual ? ResidualData : nullptr;
+    Epilogue.ldr = N;
+    Epilogue.Activation = Activation;
+    Epilogue.Function = Function;
+
+    for (size_t i = 0; i < M * N; i++) {
+      float Value = CReference[i];
+      if (Bias) Value += BiasData[i % N];
+      if (Residual) Value += ResidualData[i];
+      CReference[i] = ReferenceFunction(Epilogue, Value);
+    }
+
+    MLAS_SGEMM_DATA_PARAMS Data;
+    Data.A = A;
+    Data.lda = lda;
+    Data.C = C;
+    Data.ldc = N;
+    Data.beta = beta;
+    Data.Epilogue = &Epilogue;
+
+    if (Packed) {
+      void* PackedB = BufferBPacked.GetBuffer(MlasGemmPackBSize(N, K), true);
+      MlasGemmPackB(TransB ? CblasTrans : CblasNoTrans, N, K, B, ldb, PackedB);
+      Data.B = static_cast<const float*>(PackedB);
+      Data.BIsPacked = true;
+    } else {
+      Data.B = B;
+      Data.ldb = ldb;
+    }
+
+    MlasGemmBatch(TransA ? CblasTrans : CblasNoTrans, TransB ? CblasTrans : CblasNoTrans,
+                  M, N, K, &Data, 1, threadpool_);
+
+    for (size_t i = 0; i < M * N; i++) {
+      float diff = std::fabs(C[i] - CReference[i]);
+      ASSERT_TRUE(diff <= 1e-3f || diff <= std::fabs(CReference[i]) * 1e-4f)
+          << " @" << i << " M=" << M << " N=" << N << " K=" << K << " TransA=" << TransA
+          << " TransB=" << TransB << " beta=" << beta << " Bias=" << Bias << " Residual=" << Residual
+          << " Function=" << int(Function) << ", got: " << C[i] << ", expecting: " << CReference[i];
+    }
+  }
+
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name = std::string("SgemmEpilogue") +
+                                          (Packed ? "_Packed" : "_NoPack") +
+                                          (Threaded ? "_Threaded" : "_SingleThread");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    MLAS_ACTIVATION Relu;
+    Relu.ActivationKind = MlasReluActivation;
+
+    MLAS_ACTIVATION LeakyRelu;
+    LeakyRelu.ActivationKind = MlasLeakyReluActivation;
+    LeakyRelu.Parameters.LeakyRelu.alpha = 0.1f;
+
+    MLAS_ACTIVATION Tanh;
+    Tanh.ActivationKind = MlasTanhActivation;
+
+    for (bool TransA : {false, true}) {
+      for (bool TransB : {false, true}) {
+        for (size_t M : {1, 3, 16, 67}) {
+          for (size_t N : {1, 5, 32, 161}) {
+            for (size_t K : {0, 1, 9, 300}) {
+              if (Packed && K == 0) {
+                continue;
+              }
+              Test(TransA, TransB, M, N, K, 0.0f, true, false, nullptr, MlasSgemmEpilogueNoFunction);
+              Test(TransA, TransB, M, N, K, 1.0f, true, true, &Relu, MlasSgemmEpilogueNoFunction);
+              Test(TransA, TransB, M, N, K, 0.5f, false, true, nullptr, MlasSgemmEpilogueGelu);
+              Test(TransA, TransB, M, N, K, 0.0f, true, false, &LeakyRelu, MlasSgemmEpilogueSilu);
+              Test(TransA, TransB, M, N, K, 0.0f, false, false, &Tanh, MlasSgemmEpilogueNoFunction);
+            }
+          }
+        }
+      }
+    }
+    Test(false, false, 256, 384, 512, 0.0f, true, true, nullptr, MlasSgemmEpilogueGelu);
+  }
+};
+
+template <>
+MlasSgemmEpilogueTest<false, false>* MlasTestFixture<MlasSgemmEpilogueTest<false, false>>::mlas_tester(nullptr);
+template <>
+MlasSgemmEpilogueTest<false, true>* MlasTestFixture<MlasSgemmEpilogueTest<false, true>>::mlas_tester(nullptr);
+template <>
+MlasSgemmEpilogueTest<true, false>* MlasTestFixture<MlasSgemmEpilogueTest<true, false>>::mlas_tester(nullptr);
+template <>
+MlasSgemmEpilogueTest<true, true>* MlasTestFixture<MlasSgemmEpilogueTest<true, true>>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasSgemmEpilogueTest<false, false>>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasSgemmEpilogueTest<true, false>>::RegisterShortExecute();
+    if (GetMlasThreadPool() != nullptr) {
+      count += MlasDirectShortExecuteTests<MlasSgemmEpilogueTest<false, true>>::RegisterShortExecute();
+      count += MlasDirectShortExecuteTests<MlasSgemmEpilogueTest<true, true>>::RegisterShortExecute();
+    }
+  }
+  return count;
+});
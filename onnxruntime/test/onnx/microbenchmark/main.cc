@@ -18,9 +18,13 @@
 #include <core/session/ort_env.h>
 #include <core/util/thread_utils.h>
 
+#include <cstring>
 #include <iostream>
+#include <string>
 #include <unordered_map>
 
+#include "model_ops.h"
+
 const OrtApi* g_ort = OrtGetApiBase()->GetApi(ORT_API_VERSION);
 OrtEnv* env = nullptr;
 
@@ -74,11 +78,32 @@ BENCHMARK(BM_ResolveGraph);
     }                                                        \
   } while (0);
 
+// Removes the flag `--<name>=<value>` from the arguments and returns its value, or an empty string if absent
+static std::string TakeFlag(int& argc, char** argv, const char* name) {
+  const std::string prefix = std::string("--") + name + "=";
+  std::string value;
+  int kept = 1;
+  for (int i = 1; i < argc; ++i) {
+    if (std::strncmp(argv[i], prefix.c_str(), prefix.size()) == 0) {
+      value = argv[i] + prefix.size();
+    } else {
+      argv[kept++] = argv[i];
+    }
+  }
+  argc = kept;
+  return value;
+}
+
 int main(int argc, char** argv) {
   ::benchmark::Initialize(&argc, argv);
+  const std::string model_ops_path = TakeFlag(argc, argv, "model_ops_path");
+  const std::string model_ops_ep = TakeFlag(argc, argv, "model_ops_ep");
   if (::benchmark::ReportUnrecognizedArguments(argc, argv))
     return -1;
   ORT_ABORT_ON_ERROR(g_ort->CreateEnv(ORT_LOGGING_LEVEL_ERROR, "test", &env));
+  if (!model_ops_path.empty()) {
+    RegisterModelOpBenchmarks(model_ops_path, model_ops_ep.empty() ? "cpu" : model_ops_ep);
+  }
   ::benchmark::RunSpecifiedBenchmarks();
   g_ort->ReleaseEnv(env);
   return 0;
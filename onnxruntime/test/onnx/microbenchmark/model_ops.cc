@@ -0,0 +1,239 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+// Benchmarks of the kernels of a model, each of them alone at the shapes it has in the model.
+//
+// Every distinct (operator, attributes, input types and shapes) tuple of the main graph of the model given with
+// --model_ops_path=<model.onnx> is extracted into a single node model, whose constant inputs remain initializers so
+// that they are pre-packed as in the full model. The benchmark runs that model with zero filled inputs on the
+// execution provider given with --model_ops_ep=<cpu|cuda> (default: cpu), after a few warm-up runs.
+// Use --benchmark_repetitions to get statistics over repeated measurements.
+
+#include "model_ops.h"
+
+#include <benchmark/benchmark.h>
+#include <core/common/path_string.h>
+#include <core/framework/data_types.h>
+#include <core/framework/tensorprotoutils.h>
+#include <core/graph/graph_viewer.h>
+#include <core/graph/model.h>
+#include <core/session/onnxruntime_cxx_api.h>
+#include <core/session/ort_env.h>
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+extern OrtEnv* env;
+
+using namespace onnxruntime;
+
+namespace {
+
+constexpr int kWarmUpRuns = 3;
+
+// The environment created by main()
+struct UnownedEnv : Ort::Env {
+  UnownedEnv() : Ort::Env(env) {}
+  ~UnownedEnv() { release(); }
+};
+
+bool IsSupportedTensor(const NodeArg& arg) {
+  const auto* type = arg.TypeAsProto();
+  const auto* shape = arg.Shape();
+  if (type == nullptr || !type->has_tensor_type() || shape == nullptr ||
+      type->tensor_type().elem_type() == ONNX_NAMESPACE::TensorProto_DataType_STRING) {
+    return false;
+  }
+  return std::all_of(shape->dim().begin(), shape->dim().end(),
+                     [](const ONNX_NAMESPACE::TensorShapeProto_Dimension& dim) { return dim.has_dim_value(); });
+}
+
+std::string ShapeToString(const ONNX_NAMESPACE::TensorShapeProto& shape) {
+  std::ostringstream oss;
+  oss << "[";
+  for (int i = 0; i < shape.dim_size(); ++i) {
+    oss << (i > 0 ? "," : "") << shape.dim(i).dim_value();
+  }
+  oss << "]";
+  return oss.str();
+}
+
+// Returns false if the node can not be benchmarked alone: it has subgraphs, or inputs of unknown shape or of a
+// type the benchmark can not fill
+bool ExtractNodeModel(const Graph& graph, const Node& node, ONNX_NAMESPACE::ModelProto& model_proto,
+                      std::string& key, std::string& name) {
+  if (node.ContainsSubgraph()) {
+    return false;
+  }
+
+  std::ostringstream key_stream;
+  std::ostringstream name_stream;
+  key_stream << node.Domain() << ";" << node.OpType() << ";" << node.SinceVersion() << ";";
+  name_stream << "ModelOp/" << node.OpType();
+
+  std::map<std::string, const ONNX_NAMESPACE::AttributeProto*> attributes;
+  for (const auto& attribute : node.GetAttributes()) {
+    attributes.emplace(attribute.first, &attribute.second);
+  }
+  for (const auto& attribute : attributes) {
+    key_stream << attribute.second->SerializeAsString() << ";";
+  }
+
+  auto* graph_proto = model_proto.mutable_graph();
+  graph_proto->set_name(node.OpType());
+  node.ToProto(*graph_proto->add_node());
+
+  for (const auto* input : node.InputDefs()) {
+    if (!input->Exists()) {
+      key_stream << "-;";
+      continue;
+    }
+    if (!IsSupportedTensor(*input)) {
+      return false;
+    }
+
+    key_stream << input->TypeAsProto()->tensor_type().elem_type() << ShapeToString(*input->Shape()) << ";";
+    name_stream << "/" << ShapeToString(*input->Shape());
+
+    const auto* initializer = graph.GetConstantInitializer(input->Name(), true);
+    if (initializer == nullptr) {
+      *graph_proto->add_input() = input->ToProto();
+      continue;
+    }
+
+    // embed the data of the initializer, which may be stored in a file next to the model
+    std::vector<uint8_t> data;
+    if (!utils::UnpackInitializerData(*initializer, graph.ModelPath(), data).IsOK()) {
+      return false;
+    }
+    auto* tensor_proto = graph_proto->add_initializer();
+    tensor_proto->set_name(initializer->name());
+    tensor_proto->set_data_type(initializer->data_type());
+    *tensor_proto->mutable_dims() = initializer->dims();
+    tensor_proto->set_raw_data(data.data(), data.size());
+  }
+
+  for (const auto* output : node.OutputDefs()) {
+    if (output->Exists()) {
+      *graph_proto->add_output() = output->ToProto();
+    }
+  }
+
+  model_proto.set_ir_version(ONNX_NAMESPACE::Version::IR_VERSION);
+  for (const auto& domain_version : graph.DomainToVersionMap()) {
+    auto* opset = model_proto.add_opset_import();
+    opset->set_domain(domain_version.first);
+    opset->set_version(domain_version.second);
+  }
+
+  key = key_stream.str();
+  name = name_stream.str();
+  return true;
+}
+
+void BM_ModelOp(benchmark::State& state, const std::string& model_data, const std::string& provider) {
+  ORT_TRY {
+    UnownedEnv ort_env;
+    Ort::SessionOptions session_options;
+    if (provider == "cuda") {
+#ifdef USE_CUDA
+      session_options.AppendExecutionProvider_CUDA(OrtCUDAProviderOptions{});
+#else
+      state.SkipWithError("onnxruntime_benchmark was built without CUDA");
+      return;
+#endif
+    } else if (provider != "cpu") {
+      state.SkipWithError(("unknown execution provider " + provider).c_str());
+      return;
+    }
+    Ort::Session session(ort_env, model_data.data(), model_data.size(), session_options);
+
+    Ort::AllocatorWithDefaultOptions allocator;
+    std::vector<Ort::AllocatedStringPtr> input_names;
+    std::vector<const char*> input_name_ptrs;
+    std::vector<Ort::Value> inputs;
+    for (size_t i = 0; i < session.GetInputCount(); ++i) {
+      input_names.push_back(session.GetInputNameAllocated(i, allocator));
+      input_name_ptrs.push_back(input_names.back().get());
+      auto input_type_info = session.GetInputTypeInfo(i);
+      auto type_info = input_type_info.GetTensorTypeAndShapeInfo();
+      const auto shape = type_info.GetShape();
+      inputs.push_back(Ort::Value::CreateTensor(allocator, shape.data(), shape.size(), type_info.GetElementType()));
+      const size_t element_size =
+          DataTypeImpl::TensorTypeFromONNXEnum(type_info.GetElementType())->GetElementType()->Size();
+      std::memset(inputs.back().GetTensorMutableRawData(), 0, element_size * type_info.GetElementCount());
+    }
+
+    std::vector<Ort::AllocatedStringPtr> output_names;
+    std::vector<const char*> output_name_ptrs;
+    for (size_t i = 0; i < session.GetOutputCount(); ++i) {
+      output_names.push_back(session.GetOutputNameAllocated(i, allocator));
+      output_name_ptrs.push_back(output_names.back().get());
+    }
+
+    auto run = [&]() {
+      return session.Run(Ort::RunOptions{nullptr}, input_name_ptrs.data(), inputs.data(), inputs.size(),
+                         output_name_ptrs.data(), output_name_ptrs.size());
+    };
+    for (int i = 0; i < kWarmUpRuns; ++i) {
+      run();
+    }
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(run());
+    }
+  }
+  ORT_CATCH(const std::exception& ex) {
+    ORT_HANDLE_EXCEPTION([&]() {
+      state.SkipWithError(ex.what());
+    });
+  }
+}
+
+}  // namespace
+
+void RegisterModelOpBenchmarks(const std::string& model_path, const std::string& provider) {
+  auto logger = env->GetLoggingManager()->CreateLogger("model_ops");
+  std::shared_ptr<Model> model;
+  auto status = Model::Load(ToPathString(model_path), model, nullptr, *logger);
+  if (!status.IsOK()) {
+    std::cerr << "Failed to load " << model_path << ": " << status.ErrorMessage() << std::endl;
+    return;
+  }
+
+  const Graph& graph = model->MainGraph();
+  GraphViewer graph_viewer(graph);
+  std::map<std::string, std::string> benchmarked;
+  std::map<std::string, int> name_counts;
+  size_t skipped = 0;
+  for (auto node_index : graph_viewer.GetNodesInTopologicalOrder()) {
+    const Node& node = *graph.GetNode(node_index);
+    ONNX_NAMESPACE::ModelProto model_proto;
+    std::string key;
+    std::string name;
+    if (!ExtractNodeModel(graph, node, model_proto, key, name)) {
+      ++skipped;
+      continue;
+    }
+    if (!benchmarked.emplace(key, name).second) {
+      continue;
+    }
+    // nodes differing only by their attributes
+    const int name_count = name_counts[name]++;
+    if (name_count > 0) {
+      name += "/" + std::to_string(name_count);
+    }
+
+    benchmark::RegisterBenchmark(name.c_str(), BM_ModelOp, model_proto.SerializeAsString(), provider)
+        ->Unit(benchmark::TimeUnit::kMicrosecond);
+  }
+
+  if (skipped > 0) {
+    std::cerr << skipped << " nodes of " << model_path
+              << " were not benchmarked because they have subgraphs or inputs of unknown shape" << std::endl;
+  }
+}
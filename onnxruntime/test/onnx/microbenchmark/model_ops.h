@@ -0,0 +1,10 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <string>
+
+// Registers a benchmark of each distinct kernel of the model at `model_path`, run on the execution provider
+// `provider` ("cpu" or "cuda")
+void RegisterModelOpBenchmarks(const std::string& model_path, const std::string& provider);
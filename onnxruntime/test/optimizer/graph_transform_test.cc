@@ -5,6 +5,7 @@
 #pragma warning(disable : 4244)
 #endif
 
+#include <numeric>
 #include <random>
 #include "core/graph/onnx_protobuf.h"
 
@@ -19,13 +20,16 @@
 #include "core/graph/graph_viewer.h"
 #include "core/graph/model.h"
 #include "core/optimizer/attention_fusion.h"
+#include "core/optimizer/auto_mixed_precision.h"
 #include "core/optimizer/bias_dropout_fusion.h"
 #include "core/optimizer/bias_gelu_fusion.h"
 #include "core/optimizer/bias_softmax_fusion.h"
 #include "core/optimizer/cast_elimination.h"
+#include "core/optimizer/cast_fusion.h"
 #include "core/optimizer/common_subexpression_elimination.h"
 #include "core/optimizer/concat_slice_elimination.h"
 #include "core/optimizer/constant_folding.h"
+#include "core/optimizer/constant_if_inlining.h"
 #include "core/optimizer/constant_sharing.h"
 #include "core/optimizer/conv_activation_fusion.h"
 #include "core/optimizer/conv_add_act_fusion.h"
@@ -35,6 +39,8 @@
 #include "core/optimizer/div_mul_fusion.h"
 #include "core/optimizer/dropout_elimination.h"
 #include "core/optimizer/dynamic_quantize_matmul_fusion.h"
+#include "core/optimizer/elementwise_chain_fusion.h"
+#include "core/optimizer/embedding_bag_fusion.h"
 #include "core/optimizer/expand_elimination.h"
 #include "core/optimizer/fast_gelu_fusion.h"
 #include "core/optimizer/gather_fusion.h"
@@ -50,18 +56,24 @@
 #include "core/optimizer/identity_elimination.h"
 #include "core/optimizer/initializer.h"
 #include "core/optimizer/isinf_reducesum_fusion.h"
+#include "core/optimizer/loop_unrolling.h"
 #include "core/optimizer/matmul_add_fusion.h"
 #include "core/optimizer/matmul_integer_to_float.h"
 #include "core/optimizer/matmul_scale_fusion.h"
 #include "core/optimizer/matmul_transpose_fusion.h"
+#include "core/optimizer/memory_budget_optimizer.h"
 #include "core/optimizer/noop_elimination.h"
 #include "core/optimizer/not_where_fusion.h"
 #include "core/optimizer/propagate_cast_ops.h"
+#include "core/optimizer/qlinear_conv_add_fusion.h"
 #include "core/optimizer/quick_gelu_fusion.h"
+#include "core/optimizer/rotary_embedding_fusion.h"
 #include "core/optimizer/relu_clip_fusion.h"
 #include "core/optimizer/reshape_fusion.h"
 #include "core/optimizer/rule_based_graph_transformer.h"
+#include "core/optimizer/scaled_dot_product_attention_fusion.h"
 #include "core/optimizer/slice_elimination.h"
+#include "core/optimizer/tensor_parallel_transformer.h"
 #include "core/optimizer/unsqueeze_elimination.h"
 #include "core/optimizer/utils.h"
 #include "core/platform/env.h"
@@ -664,6 +676,254 @@ TEST_F(GraphTransformationTests, ConstantFoldingSubgraph) {
       << "Constant folding should have been able to remove the Add node in both subgraphs";
 }
 
+TEST_F(GraphTransformationTests, ConstantIfInlining) {
+  TensorProto value_tensor;
+  value_tensor.add_dims(1);
+  value_tensor.add_float_data(1.f);
+  value_tensor.set_data_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+
+  TypeProto float_tensor_type;
+  float_tensor_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  float_tensor_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+
+  // create a branch with a node of op_type that uses a local and a parent graph value
+  auto create_subgraph = [&](GraphProto& graph_proto, const std::string& op_type) {
+    Model model("ConstantIfInliningTest_subgraph", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(), {{kOnnxDomain, 12}}, {}, *logger_);
+    auto& graph = model.MainGraph();
+
+    TensorProto local_constant(value_tensor);
+    local_constant.set_name("local_constant");
+    graph.AddInitializedTensor(local_constant);
+
+    auto& local_constant_arg = graph.GetOrCreateNodeArg("local_constant", &float_tensor_type);
+    auto& parent_value_arg = graph.GetOrCreateNodeArg("parent_value", &float_tensor_type);
+    graph.AddOuterScopeNodeArg("parent_value");
+
+    auto& subgraph_out = graph.GetOrCreateNodeArg("subgraph_out", &float_tensor_type);
+    graph.AddNode("op", op_type, "Op of the branch.", {&parent_value_arg, &local_constant_arg}, {&subgraph_out});
+
+    ASSERT_STATUS_OK(graph.Resolve());
+    graph_proto = graph.ToGraphProto();
+  };
+
+  Model model("ConstantIfInliningTest_main_graph", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(), {{kOnnxDomain, 12}}, {}, *logger_);
+  auto& graph = model.MainGraph();
+
+  // the condition is a constant, as if folded from static dimensions
+  TensorProto cond_tensor;
+  cond_tensor.set_name("if_cond");
+  cond_tensor.add_dims(1);
+  cond_tensor.add_int32_data(1);
+  cond_tensor.set_data_type(ONNX_NAMESPACE::TensorProto_DataType_BOOL);
+  graph.AddInitializedTensor(cond_tensor);
+
+  TypeProto if_cond_type;
+  if_cond_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_BOOL);
+  if_cond_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+  auto& if_cond_input = graph.GetOrCreateNodeArg("if_cond", &if_cond_type);
+  auto& graph_input = graph.GetOrCreateNodeArg("graph_in", &float_tensor_type);
+  auto& parent_value = graph.GetOrCreateNodeArg("parent_value", &float_tensor_type);
+  auto& if_output = graph.GetOrCreateNodeArg("if_out", &float_tensor_type);
+  auto& graph_output = graph.GetOrCreateNodeArg("graph_out", &float_tensor_type);
+
+  graph.AddNode("relu", "Relu", "Produces the value used in the branches.", {&graph_input}, {&parent_value});
+  auto& if_node = graph.AddNode("if", "If", "If node", {&if_cond_input}, {&if_output});
+  graph.AddNode("identity", "Identity", "Consumes the If output.", {&if_output}, {&graph_output});
+
+  GraphProto then_branch;
+  create_subgraph(then_branch, "Add");
+  GraphProto else_branch;
+  create_subgraph(else_branch, "Sub");
+  if_node.AddAttribute("then_branch", then_branch);
+  if_node.AddAttribute("else_branch", else_branch);
+
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  std::map<std::string, int> op_to_count = CountOpsInGraph(graph);
+  ASSERT_EQ(op_to_count["If"], 1);
+  ASSERT_EQ(op_to_count["Add"], 1);
+  ASSERT_EQ(op_to_count["Sub"], 1);
+
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+  ASSERT_STATUS_OK(graph_transformation_mgr.Register(std::make_unique<ConstantIfInlining>(),
+                                                     TransformerLevel::Level1));
+  ASSERT_STATUS_OK(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level1, *logger_));
+
+  op_to_count = CountOpsInGraph(graph);
+  ASSERT_EQ(op_to_count["If"], 0);
+  ASSERT_EQ(op_to_count["Add"], 1);
+  ASSERT_EQ(op_to_count["Sub"], 0);
+
+  // the inlined Add produces the value consumed by the Identity
+  for (const auto& node : graph.Nodes()) {
+    if (node.OpType() == "Add") {
+      ASSERT_EQ(node.InputDefs()[0]->Name(), "parent_value");
+      ASSERT_EQ(node.OutputDefs()[0]->Name(), "if_out");
+      ASSERT_EQ(node.GetOutputEdgesCount(), 1u);
+    }
+  }
+}
+
+TEST_F(GraphTransformationTests, LoopUnrolling) {
+  TypeProto float_tensor_type;
+  float_tensor_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  float_tensor_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+  TypeProto int64_scalar_type;
+  int64_scalar_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_INT64);
+  int64_scalar_type.mutable_tensor_type()->mutable_shape();
+  TypeProto bool_scalar_type;
+  bool_scalar_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_BOOL);
+  bool_scalar_type.mutable_tensor_type()->mutable_shape();
+
+  // the body adds one to the loop carried value, and also outputs it as a scan output
+  GraphProto body_proto;
+  {
+    Model model("LoopUnrollingTest_body", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(), {{kOnnxDomain, 13}}, {}, *logger_);
+    auto& body = model.MainGraph();
+
+    TensorProto one;
+    one.set_name("one");
+    one.add_dims(2);
+    one.add_float_data(1.f);
+    one.add_float_data(1.f);
+    one.set_data_type(TensorProto_DataType_FLOAT);
+    body.AddInitializedTensor(one);
+
+    auto& iteration_num = body.GetOrCreateNodeArg("iteration_num", &int64_scalar_type);
+    auto& cond_in = body.GetOrCreateNodeArg("cond_in", &bool_scalar_type);
+    auto& cond_out = body.GetOrCreateNodeArg("cond_out", &bool_scalar_type);
+    auto& x_in = body.GetOrCreateNodeArg("x_in", &float_tensor_type);
+    auto& one_arg = body.GetOrCreateNodeArg("one", &float_tensor_type);
+    auto& x_out = body.GetOrCreateNodeArg("x_out", &float_tensor_type);
+    auto& scan_out = body.GetOrCreateNodeArg("scan_out", &float_tensor_type);
+
+    body.AddNode("cond", "Identity", "Passes the condition through.", {&cond_in}, {&cond_out});
+    body.AddNode("add", "Add", "Updates the loop carried value.", {&x_in, &one_arg}, {&x_out});
+    body.AddNode("scan", "Identity", "Produces the scan output.", {&x_out}, {&scan_out});
+    body.SetInputs({&iteration_num, &cond_in, &x_in});
+    body.SetOutputs({&cond_out, &x_out, &scan_out});
+
+    ASSERT_STATUS_OK(body.Resolve());
+    body_proto = body.ToGraphProto();
+  }
+
+  Model model("LoopUnrollingTest_main_graph", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(), {{kOnnxDomain, 13}}, {}, *logger_);
+  auto& graph = model.MainGraph();
+
+  TensorProto trip_count;
+  trip_count.set_name("trip_count");
+  trip_count.add_int64_data(3);
+  trip_count.set_data_type(TensorProto_DataType_INT64);
+  graph.AddInitializedTensor(trip_count);
+
+  auto& trip_count_arg = graph.GetOrCreateNodeArg("trip_count", &int64_scalar_type);
+  auto& no_cond = graph.GetOrCreateNodeArg("", nullptr);
+  auto& graph_input = graph.GetOrCreateNodeArg("graph_in", &float_tensor_type);
+  auto& loop_x = graph.GetOrCreateNodeArg("loop_x", nullptr);
+  auto& loop_scan = graph.GetOrCreateNodeArg("loop_scan", nullptr);
+
+  auto& loop_node = graph.AddNode("loop", "Loop", "Loop with a constant trip count.",
+                                  {&trip_count_arg, &no_cond, &graph_input}, {&loop_x, &loop_scan});
+  loop_node.AddAttribute("body", body_proto);
+
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  std::map<std::string, int> op_to_count = CountOpsInGraph(graph);
+  ASSERT_EQ(op_to_count["Loop"], 1);
+  ASSERT_EQ(op_to_count["Add"], 1);
+
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+  ASSERT_STATUS_OK(graph_transformation_mgr.Register(std::make_unique<LoopUnrolling>(), TransformerLevel::Level1));
+  ASSERT_STATUS_OK(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level1, *logger_));
+
+  op_to_count = CountOpsInGraph(graph);
+  ASSERT_EQ(op_to_count["Loop"], 0);
+  ASSERT_EQ(op_to_count["Add"], 3);
+  ASSERT_EQ(op_to_count["Unsqueeze"], 3);
+  ASSERT_EQ(op_to_count["Concat"], 1);
+
+  // the scan output stacks the values of the 3 iterations
+  const auto* loop_scan_shape = graph.GetNodeArg("loop_scan")->Shape();
+  ASSERT_NE(loop_scan_shape, nullptr);
+  ASSERT_EQ(loop_scan_shape->dim_size(), 2);
+  EXPECT_EQ(loop_scan_shape->dim(0).dim_value(), 3);
+  EXPECT_EQ(loop_scan_shape->dim(1).dim_value(), 2);
+}
+
+TEST_F(GraphTransformationTests, LoopUnrollingBatchesScan) {
+  TypeProto slice_type;
+  slice_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  slice_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+  slice_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(3);
+  TypeProto weights_type;
+  weights_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  weights_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(3);
+  weights_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(4);
+  TypeProto input_type;
+  input_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  input_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(5);
+  input_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+  input_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(3);
+
+  // the body multiplies each slice with the weights of the parent graph
+  GraphProto body_proto;
+  {
+    Model model("LoopUnrollingTest_scan_body", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(), {{kOnnxDomain, 13}}, {}, *logger_);
+    auto& body = model.MainGraph();
+
+    auto& slice = body.GetOrCreateNodeArg("slice", &slice_type);
+    auto& weights = body.GetOrCreateNodeArg("weights", &weights_type);
+    body.AddOuterScopeNodeArg("weights");
+    auto& slice_out = body.GetOrCreateNodeArg("slice_out", nullptr);
+
+    body.AddNode("matmul", "MatMul", "MatMul of one slice.", {&slice, &weights}, {&slice_out});
+    body.SetInputs({&slice});
+    body.SetOutputs({&slice_out});
+
+    ASSERT_STATUS_OK(body.Resolve());
+    body_proto = body.ToGraphProto();
+  }
+
+  Model model("LoopUnrollingTest_scan_main_graph", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(), {{kOnnxDomain, 13}}, {}, *logger_);
+  auto& graph = model.MainGraph();
+
+  TensorProto weights;
+  weights.set_name("weights");
+  weights.add_dims(3);
+  weights.add_dims(4);
+  for (int i = 0; i < 12; ++i) {
+    weights.add_float_data(static_cast<float>(i));
+  }
+  weights.set_data_type(TensorProto_DataType_FLOAT);
+  graph.AddInitializedTensor(weights);
+
+  auto& graph_input = graph.GetOrCreateNodeArg("graph_in", &input_type);
+  auto& scan_output = graph.GetOrCreateNodeArg("scan_out", nullptr);
+
+  auto& scan_node = graph.AddNode("scan", "Scan", "Scan over the first axis.", {&graph_input}, {&scan_output});
+  scan_node.AddAttribute("num_scan_inputs", static_cast<int64_t>(1));
+  scan_node.AddAttribute("body", body_proto);
+
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+  ASSERT_STATUS_OK(graph_transformation_mgr.Register(std::make_unique<LoopUnrolling>(), TransformerLevel::Level1));
+  ASSERT_STATUS_OK(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level1, *logger_));
+
+  std::map<std::string, int> op_to_count = CountOpsInGraph(graph);
+  ASSERT_EQ(op_to_count["Scan"], 0);
+  ASSERT_EQ(op_to_count["MatMul"], 1);
+
+  // the batched MatMul is applied to the whole scan input
+  for (const auto& node : graph.Nodes()) {
+    if (node.OpType() == "MatMul") {
+      ASSERT_EQ(node.InputDefs()[0]->Name(), "graph_in");
+      ASSERT_EQ(node.InputDefs()[1]->Name(), "weights");
+      ASSERT_EQ(node.OutputDefs()[0]->Name(), "scan_out");
+    }
+  }
+}
+
 TEST_F(GraphTransformationTests, ConstantFoldingWithShapeToInitializer) {
   constexpr const ORTCHAR_T* model_uri = MODEL_FOLDER "fusion/constant_folding_with_shape_to_initializer.onnx";
   std::shared_ptr<Model> model;
@@ -905,6 +1165,90 @@ TEST_F(GraphTransformationTests, ConstantFoldingAShapeNodeDeepInTheGraph) {
   ASSERT_TRUE(op_to_count.size() == 0);
 }
 
+// Reshape x of shape [batch, seq, 768] to [0, 0, 12, Shape(x)[2] / 12].
+// The Shape node can't be folded as the shape of x is symbolic, but the values selected by Gather are constant.
+TEST_F(GraphTransformationTests, ConstantFoldingShapeValuesWithSymbolicDims) {
+  auto build_test_case = [](ModelTestBuilder& builder) {
+    auto* x_arg = builder.MakeSymbolicInput<float>({"batch", "seq", int64_t{768}});
+    auto* shape_out = builder.MakeIntermediate();
+    auto* gather_out = builder.MakeIntermediate();
+    auto* div_out = builder.MakeIntermediate();
+    auto* unsqueeze_out = builder.MakeIntermediate();
+    auto* concat_out = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+    builder.AddNode("Shape", {x_arg}, {shape_out});
+    builder.AddNode("Gather", {shape_out, builder.MakeScalarInitializer<int64_t>(2)}, {gather_out});
+    builder.AddNode("Div", {gather_out, builder.MakeScalarInitializer<int64_t>(12)}, {div_out});
+    builder.AddNode("Unsqueeze", {div_out, builder.MakeInitializer<int64_t>({1}, {0})}, {unsqueeze_out});
+    builder.AddNode("Concat", {builder.MakeInitializer<int64_t>({3}, {0, 0, 12}), unsqueeze_out}, {concat_out})
+        .AddAttribute("axis", int64_t{0});
+    builder.AddNode("Reshape", {x_arg, concat_out}, {output_arg});
+  };
+
+  auto pre_graph_checker = [](Graph& graph) {
+    for (const auto& node : graph.Nodes()) {
+      const auto* values = node.OutputDefs()[0]->InferredShapeValues();
+      if (node.OpType() == "Shape") {
+        TEST_RETURN_IF_NOT(values != nullptr && values->dim_size() == 3);
+        TEST_RETURN_IF_NOT(values->dim(0).dim_param() == "batch" && values->dim(2).dim_value() == 768);
+      } else if (node.OpType() == "Concat") {
+        TEST_RETURN_IF_NOT(values != nullptr && values->dim_size() == 4);
+        TEST_RETURN_IF_NOT(values->dim(2).dim_value() == 12 && values->dim(3).dim_value() == 64);
+      }
+    }
+    return Status::OK();
+  };
+
+  auto post_graph_checker = [](Graph& graph) {
+    auto op_to_count = CountOpsInGraph(graph);
+    TEST_RETURN_IF_NOT(op_to_count.size() == 1);
+    TEST_RETURN_IF_NOT(op_to_count["Reshape"] == 1);
+    return Status::OK();
+  };
+
+  std::unique_ptr<CPUExecutionProvider> e = std::make_unique<CPUExecutionProvider>(CPUExecutionProviderInfo());
+  std::unique_ptr<GraphTransformer> transformer = std::make_unique<ConstantFolding>(*e.get(),
+                                                                                    false /*skip_dequantize_linear*/);
+  ASSERT_STATUS_OK(TestGraphTransformer(build_test_case, 13, *logger_, std::move(transformer),
+                                        TransformerLevel::Level1, 1, pre_graph_checker, post_graph_checker));
+}
+
+// An Expand of a small initializer to a large output is not folded when the output growth is limited.
+TEST_F(GraphTransformationTests, ConstantFoldingMaxOutputGrowthRatio) {
+  auto build_test_case = [](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({{128, 256}});
+    auto* expand_input = builder.MakeInitializer<float>({1}, {1.0f});
+    auto* expand_shape = builder.MakeInitializer<int64_t>({2}, {128, 256});
+    auto* expand_out = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+    builder.AddNode("Expand", {expand_input, expand_shape}, {expand_out});
+    builder.AddNode("Add", {input_arg, expand_out}, {output_arg});
+  };
+
+  auto expect_expand_count = [](int expected_count) {
+    return [expected_count](Graph& graph) {
+      auto op_to_count = CountOpsInGraph(graph);
+      TEST_RETURN_IF_NOT(op_to_count["Expand"] == expected_count);
+      TEST_RETURN_IF_NOT(op_to_count["Add"] == 1);
+      return Status::OK();
+    };
+  };
+
+  std::unique_ptr<CPUExecutionProvider> e = std::make_unique<CPUExecutionProvider>(CPUExecutionProviderInfo());
+
+  // 128KB output from 20 bytes of constant inputs
+  std::unique_ptr<GraphTransformer> limited_transformer = std::make_unique<ConstantFolding>(
+      *e.get(), false /*skip_dequantize_linear*/, InlinedHashSet<std::string_view>{}, InlinedHashSet<std::string>{},
+      16.0f /*max_output_growth_ratio*/);
+  ASSERT_STATUS_OK(TestGraphTransformer(build_test_case, 13, *logger_, std::move(limited_transformer),
+                                        TransformerLevel::Level1, 1, expect_expand_count(1), expect_expand_count(1)));
+
+  std::unique_ptr<GraphTransformer> transformer = std::make_unique<ConstantFolding>(*e.get(),
+                                                                                    false /*skip_dequantize_linear*/);
+  ASSERT_STATUS_OK(TestGraphTransformer(build_test_case, 13, *logger_, std::move(transformer),
+                                        TransformerLevel::Level1, 1, expect_expand_count(1), expect_expand_count(0)));
+}
+
 // Check transformations in the case of a subgraph with constant inputs.
 TEST_F(GraphTransformationTests, SubgraphWithConstantInputs) {
   constexpr const ORTCHAR_T* model_uri = MODEL_FOLDER "constant-subgraph.onnx";
@@ -3109,6 +3453,59 @@ TEST_F(GraphTransformationTests, ReshapeFusionDistilBertTest) {
   }
 }
 
+// Reshape x of shape [batch, seq, 768] to Concat(Shape(x)[0:2], [12], Shape(x)[2:3] / 12).
+// The two element Slice matches none of the patterns, so the values from graph shape inferencing are used.
+TEST_F(GraphTransformationTests, ReshapeFusionWithInferredShapeValues) {
+  auto build_test_case = [](ModelTestBuilder& builder) {
+    auto* x_arg = builder.MakeSymbolicInput<float>({"batch", "seq", int64_t{768}});
+    auto* shape_out = builder.MakeIntermediate();
+    auto* slice_batch_seq_out = builder.MakeIntermediate();
+    auto* slice_hidden_out = builder.MakeIntermediate();
+    auto* div_out = builder.MakeIntermediate();
+    auto* concat_out = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+    builder.AddNode("Shape", {x_arg}, {shape_out});
+    builder.AddNode("Slice",
+                    {shape_out, builder.MakeInitializer<int64_t>({1}, {0}), builder.MakeInitializer<int64_t>({1}, {2})},
+                    {slice_batch_seq_out});
+    builder.AddNode("Slice",
+                    {shape_out, builder.MakeInitializer<int64_t>({1}, {2}), builder.MakeInitializer<int64_t>({1}, {3})},
+                    {slice_hidden_out});
+    builder.AddNode("Div", {slice_hidden_out, builder.MakeInitializer<int64_t>({1}, {12})}, {div_out});
+    builder.AddNode("Concat", {slice_batch_seq_out, builder.MakeInitializer<int64_t>({1}, {12}), div_out},
+                    {concat_out})
+        .AddAttribute("axis", int64_t{0});
+    builder.AddNode("Reshape", {x_arg, concat_out}, {output_arg});
+  };
+
+  auto pre_graph_checker = [](Graph& graph) {
+    TEST_RETURN_IF_NOT(CountOpsInGraph(graph)["Concat"] == 1);
+    return Status::OK();
+  };
+
+  auto post_graph_checker = [](Graph& graph) {
+    auto op_to_count = CountOpsInGraph(graph);
+    TEST_RETURN_IF_NOT(op_to_count["Slice"] == 0);
+    TEST_RETURN_IF_NOT(op_to_count["Div"] == 0);
+    TEST_RETURN_IF_NOT(op_to_count["Concat"] == 0);
+    TEST_RETURN_IF_NOT(op_to_count["Reshape"] == 1);
+
+    for (const Node& node : graph.Nodes()) {
+      if (node.OpType() == "Reshape") {
+        const auto* tensor_proto = graph_utils::GetConstantInitializer(graph, node.InputDefs()[1]->Name());
+        TEST_RETURN_IF_NOT(tensor_proto != nullptr);
+        Initializer initializer(*tensor_proto, graph.ModelPath());
+        const auto values = initializer.DataAsSpan<int64_t>();
+        TEST_RETURN_IF_NOT(std::vector<int64_t>(values.begin(), values.end()) == std::vector<int64_t>({0, 0, 12, 64}));
+      }
+    }
+    return Status::OK();
+  };
+
+  ASSERT_STATUS_OK(TestGraphTransformer(build_test_case, 13, *logger_, std::make_unique<ReshapeFusion>(),
+                                        TransformerLevel::Level1, 1, pre_graph_checker, post_graph_checker));
+}
+
 // Test eliminating redundant Concat-Slice pattern.
 TEST_F(GraphTransformationTests, ConcatSliceEliminationTest) {
   constexpr const ORTCHAR_T* model_uri = MODEL_FOLDER "concat_slice_basic_test.onnx";
@@ -3533,6 +3930,181 @@ TEST_F(GraphTransformationTests, AttentionFusionDistilBertTest) {
   EXPECT_EQ(op_to_count["Shape"], 0);
 }
 
+// Builds query/key/value (B, S, N*H) -> Reshape -> Transpose -> MatMul -> Div -> Softmax -> MatMul -> Transpose ->
+// Reshape, with 2 heads of size 4. The nodes are assigned to execution_provider.
+template <typename T>
+static void BuildScaledDotProductAttentionTestCase(ModelTestBuilder& builder, const std::vector<int64_t>& heads_shape,
+                                                   const std::string& execution_provider = "") {
+  auto* query = builder.MakeInput<T>(std::optional<std::vector<int64_t>>{{2, 4, 8}});
+  auto* key = builder.MakeInput<T>(std::optional<std::vector<int64_t>>{{2, 6, 8}});
+  auto* value = builder.MakeInput<T>(std::optional<std::vector<int64_t>>{{2, 6, 8}});
+  auto* heads_shape_arg = builder.MakeInitializer<int64_t>({4}, heads_shape);
+  auto* output_shape = builder.MakeInitializer<int64_t>({3}, {0, 0, 8});
+  auto* scale = builder.MakeScalarInitializer<T>(T(2.f));
+  auto* output = builder.MakeOutput();
+
+  std::vector<Node*> nodes;
+  auto add_reshape_transpose = [&](NodeArg* input, const std::vector<int64_t>& perm) {
+    auto* reshape_out = builder.MakeIntermediate();
+    auto* transpose_out = builder.MakeIntermediate();
+    nodes.push_back(&builder.AddNode("Reshape", {input, heads_shape_arg}, {reshape_out}));
+    nodes.push_back(&builder.AddNode("Transpose", {reshape_out}, {transpose_out}));
+    nodes.back()->AddAttribute("perm", perm);
+    return transpose_out;
+  };
+
+  auto* q = add_reshape_transpose(query, {0, 2, 1, 3});
+  auto* k = add_reshape_transpose(key, {0, 2, 3, 1});
+  auto* v = add_reshape_transpose(value, {0, 2, 1, 3});
+  auto* qk_out = builder.MakeIntermediate();
+  auto* div_out = builder.MakeIntermediate();
+  auto* softmax_out = builder.MakeIntermediate();
+  auto* qkv_out = builder.MakeIntermediate();
+  auto* transpose_out = builder.MakeIntermediate();
+
+  nodes.push_back(&builder.AddNode("MatMul", {q, k}, {qk_out}));
+  nodes.push_back(&builder.AddNode("Div", {qk_out, scale}, {div_out}));
+  nodes.push_back(&builder.AddNode("Softmax", {div_out}, {softmax_out}));
+  nodes.back()->AddAttribute("axis", static_cast<int64_t>(-1));
+  nodes.push_back(&builder.AddNode("MatMul", {softmax_out, v}, {qkv_out}));
+  nodes.push_back(&builder.AddNode("Transpose", {qkv_out}, {transpose_out}));
+  nodes.back()->AddAttribute("perm", std::vector<int64_t>{0, 2, 1, 3});
+  nodes.push_back(&builder.AddNode("Reshape", {transpose_out, output_shape}, {output}));
+
+  for (Node* node : nodes) {
+    node->SetExecutionProviderType(execution_provider);
+  }
+}
+
+TEST_F(GraphTransformationTests, ScaledDotProductAttentionFusion) {
+  auto build_test_case = [](ModelTestBuilder& builder) {
+    BuildScaledDotProductAttentionTestCase<float>(builder, {0, 0, 2, 4});
+  };
+
+  auto pre_graph_checker = [](Graph& graph) {
+    TEST_RETURN_IF_NOT(CountOpsInGraph(graph)["Softmax"] == 1);
+    return Status::OK();
+  };
+
+  auto post_graph_checker = [](Graph& graph) {
+    auto op_to_count = CountOpsInGraph(graph);
+    TEST_RETURN_IF_NOT(op_to_count["com.microsoft.MultiHeadAttention"] == 1);
+    TEST_RETURN_IF_NOT(op_to_count["Softmax"] == 0);
+    TEST_RETURN_IF_NOT(op_to_count["MatMul"] == 0);
+    TEST_RETURN_IF_NOT(op_to_count["Transpose"] == 0);
+    TEST_RETURN_IF_NOT(op_to_count["Reshape"] == 0);
+    for (const auto& node : graph.Nodes()) {
+      if (node.OpType() == "MultiHeadAttention") {
+        const auto& attrs = node.GetAttributes();
+        TEST_RETURN_IF_NOT(attrs.at("num_heads").i() == 2);
+        TEST_RETURN_IF_NOT(attrs.at("scale").f() == 0.5f);
+      }
+    }
+    return Status::OK();
+  };
+
+  ASSERT_STATUS_OK(TestGraphTransformer(build_test_case, 13, *logger_,
+                                        std::make_unique<ScaledDotProductAttentionFusion>(),
+                                        TransformerLevel::Level2, 1, pre_graph_checker, post_graph_checker));
+}
+
+// The Reshapes that move the batch and sequence dimensions, or fp16 attention on the CPU EP, are not fused
+TEST_F(GraphTransformationTests, ScaledDotProductAttentionFusionNotApplied) {
+  auto check_not_fused = [](Graph& graph) {
+    auto op_to_count = CountOpsInGraph(graph);
+    TEST_RETURN_IF_NOT(op_to_count["com.microsoft.MultiHeadAttention"] == 0);
+    TEST_RETURN_IF_NOT(op_to_count["Softmax"] == 1);
+    return Status::OK();
+  };
+
+  // the query (2, 4, 8) is reshaped to (4, 2, 2, 4) by both shapes
+  for (const auto& heads_shape : {std::vector<int64_t>{-1, 2, 2, 4}, std::vector<int64_t>{4, -1, 2, 4}}) {
+    auto build_test_case = [&heads_shape](ModelTestBuilder& builder) {
+      BuildScaledDotProductAttentionTestCase<float>(builder, heads_shape);
+    };
+    ASSERT_STATUS_OK(TestGraphTransformer(build_test_case, 13, *logger_,
+                                          std::make_unique<ScaledDotProductAttentionFusion>(),
+                                          TransformerLevel::Level2, 1, nullptr, check_not_fused));
+  }
+
+  auto build_fp16_test_case = [](ModelTestBuilder& builder) {
+    BuildScaledDotProductAttentionTestCase<MLFloat16>(builder, {0, 0, 2, 4}, kCpuExecutionProvider);
+  };
+  ASSERT_STATUS_OK(TestGraphTransformer(build_fp16_test_case, 13, *logger_,
+                                        std::make_unique<ScaledDotProductAttentionFusion>(),
+                                        TransformerLevel::Level2, 1, nullptr, check_not_fused));
+}
+
+#ifdef USE_MPI
+TEST_F(GraphTransformationTests, TensorParallelTransformerMlp) {
+  std::vector<float> weight_data(8 * 16);
+  std::iota(weight_data.begin(), weight_data.end(), 0.f);
+  std::vector<float> bias_data(16);
+  std::iota(bias_data.begin(), bias_data.end(), 0.f);
+
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* input = builder.MakeInput<float>({2, 4, 8}, -1.f, 1.f);
+    auto* weight = builder.MakeInitializer<float>({8, 16}, weight_data);
+    auto* bias = builder.MakeInitializer<float>({16}, bias_data);
+    auto* output_weight = builder.MakeInitializer<float>({16, 8}, weight_data);
+    auto* output_bias = builder.MakeInitializer<float>({8}, -1.f, 1.f);
+    auto* matmul_out = builder.MakeIntermediate();
+    auto* add_out = builder.MakeIntermediate();
+    auto* gelu_out = builder.MakeIntermediate();
+    auto* output_matmul_out = builder.MakeIntermediate();
+    auto* output = builder.MakeOutput();
+
+    builder.AddNode("MatMul", {input, weight}, {matmul_out});
+    builder.AddNode("Add", {matmul_out, bias}, {add_out});
+    builder.AddNode("Gelu", {add_out}, {gelu_out}, kMSDomain);
+    builder.AddNode("MatMul", {gelu_out, output_weight}, {output_matmul_out});
+    builder.AddNode("Add", {output_matmul_out, output_bias}, {output});
+  };
+
+  auto pre_graph_checker = [](Graph& graph) {
+    TEST_RETURN_IF_NOT(CountOpsInGraph(graph)["com.microsoft.AllReduce"] == 0);
+    return Status::OK();
+  };
+
+  // rank 1 of 2 keeps the columns [8, 16) of the first weight and bias, and the rows [8, 16) of the second weight
+  auto post_graph_checker = [](Graph& graph) {
+    TEST_RETURN_IF_NOT(CountOpsInGraph(graph)["com.microsoft.AllReduce"] == 1);
+    for (const auto& node : graph.Nodes()) {
+      if (node.OpType() == "AllReduce") {
+        TEST_RETURN_IF_NOT(node.InputNodesBegin()->OpType() == "MatMul");
+        TEST_RETURN_IF_NOT(node.OutputNodesBegin()->OpType() == "Add");
+        continue;
+      }
+      if (node.OpType() != "MatMul" && node.OpType() != "Add") {
+        continue;
+      }
+      const auto* tensor_proto = graph_utils::GetConstantInitializer(graph, node.InputDefs()[1]->Name());
+      TEST_RETURN_IF_NOT(tensor_proto != nullptr);
+      Initializer weight{*tensor_proto, graph.ModelPath()};
+      const auto dims = weight.dims();
+      if (node.OpType() == "Add") {
+        // the bias of the first Add is sharded, the one after the AllReduce is not
+        TEST_RETURN_IF_NOT(dims.size() == 1 && dims[0] == 8);
+        if (node.InputNodesBegin()->OpType() == "MatMul") {
+          TEST_RETURN_IF_NOT(weight.data<float>()[0] == 8.f);
+        }
+      } else if (node.OutputNodesBegin()->OpType() == "AllReduce") {
+        TEST_RETURN_IF_NOT(dims.size() == 2 && dims[0] == 8 && dims[1] == 8);
+        TEST_RETURN_IF_NOT(weight.data<float>()[0] == 64.f);
+      } else {
+        TEST_RETURN_IF_NOT(dims.size() == 2 && dims[0] == 8 && dims[1] == 8);
+        TEST_RETURN_IF_NOT(weight.data<float>()[0] == 8.f && weight.data<float>()[8] == 24.f);
+      }
+    }
+    return Status::OK();
+  };
+
+  ASSERT_STATUS_OK(TestGraphTransformer(build_test_case, 13, *logger_,
+                                        std::make_unique<TensorParallelTransformer>(2, 1),
+                                        TransformerLevel::Level2, 1, pre_graph_checker, post_graph_checker));
+}
+#endif
+
 TEST_F(GraphTransformationTests, GeluFusionTest) {
   constexpr const ORTCHAR_T* model_uri = MODEL_FOLDER "fusion/gelu.onnx";
   std::shared_ptr<Model> p_model;
@@ -4258,6 +4830,341 @@ TEST_F(GraphTransformationTests, QuickGelu) {
   }
 }
 
+// Rotate-half subgraph of rotary embeddings as exported from PyTorch for Llama style models.
+static void BuildRotaryEmbeddingTestCase(ModelTestBuilder& builder, bool equal_halves) {
+  constexpr int64_t batch_size = 2, num_heads = 4, sequence_length = 3, head_size = 8, max_sequence_length = 16;
+  auto* input_arg = builder.MakeInput<float>({{batch_size, num_heads, sequence_length, head_size}});
+  auto* position_ids_arg = builder.MakeInput<int64_t>({{batch_size, sequence_length}});
+
+  std::vector<float> cos_data(max_sequence_length * head_size);
+  std::vector<float> sin_data(max_sequence_length * head_size);
+  for (int64_t p = 0; p < max_sequence_length; p++) {
+    for (int64_t i = 0; i < head_size / 2; i++) {
+      const float angle = p * std::pow(10000.0f, -2.0f * i / head_size);
+      cos_data[p * head_size + i] = cos_data[p * head_size + head_size / 2 + i] = std::cos(angle);
+      sin_data[p * head_size + i] = sin_data[p * head_size + head_size / 2 + i] = std::sin(angle);
+    }
+  }
+  if (!equal_halves) {
+    cos_data[head_size - 1] += 1.0f;
+  }
+  auto* cos_cache_arg = builder.MakeInitializer<float>({max_sequence_length, head_size}, cos_data);
+  auto* sin_cache_arg = builder.MakeInitializer<float>({max_sequence_length, head_size}, sin_data);
+
+  auto* gather_cos_out = builder.MakeIntermediate();
+  auto* gather_sin_out = builder.MakeIntermediate();
+  auto* unsqueeze_cos_out = builder.MakeIntermediate();
+  auto* unsqueeze_sin_out = builder.MakeIntermediate();
+  builder.AddNode("Gather", {cos_cache_arg, position_ids_arg}, {gather_cos_out});
+  builder.AddNode("Gather", {sin_cache_arg, position_ids_arg}, {gather_sin_out});
+  builder.AddNode("Unsqueeze", {gather_cos_out, builder.Make1DInitializer<int64_t>({1})}, {unsqueeze_cos_out});
+  builder.AddNode("Unsqueeze", {gather_sin_out, builder.Make1DInitializer<int64_t>({1})}, {unsqueeze_sin_out});
+
+  auto* first_half_out = builder.MakeIntermediate();
+  auto* second_half_out = builder.MakeIntermediate();
+  auto* neg_out = builder.MakeIntermediate();
+  auto* concat_out = builder.MakeIntermediate();
+  builder.AddNode("Slice",
+                  {input_arg, builder.Make1DInitializer<int64_t>({0}), builder.Make1DInitializer<int64_t>({head_size / 2}),
+                   builder.Make1DInitializer<int64_t>({-1})},
+                  {first_half_out});
+  builder.AddNode("Slice",
+                  {input_arg, builder.Make1DInitializer<int64_t>({head_size / 2}),
+                   builder.Make1DInitializer<int64_t>({std::numeric_limits<int64_t>::max()}),
+                   builder.Make1DInitializer<int64_t>({-1})},
+                  {second_half_out});
+  builder.AddNode("Neg", {second_half_out}, {neg_out});
+  builder.AddNode("Concat", {neg_out, first_half_out}, {concat_out}).AddAttribute("axis", static_cast<int64_t>(-1));
+
+  auto* mul_cos_out = builder.MakeIntermediate();
+  auto* mul_sin_out = builder.MakeIntermediate();
+  auto* output_arg = builder.MakeOutput();
+  builder.AddNode("Mul", {input_arg, unsqueeze_cos_out}, {mul_cos_out});
+  builder.AddNode("Mul", {concat_out, unsqueeze_sin_out}, {mul_sin_out});
+  builder.AddNode("Add", {mul_cos_out, mul_sin_out}, {output_arg});
+}
+
+TEST_F(GraphTransformationTests, RotaryEmbeddingFusion) {
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    BuildRotaryEmbeddingTestCase(builder, true);
+  };
+
+  auto pre_graph_checker = [&](Graph& graph) {
+    TEST_RETURN_IF_NOT(CountOpsInGraph(graph)["Slice"] == 2);
+    TEST_RETURN_IF_NOT(CountOpsInGraph(graph)["Mul"] == 2);
+    return Status::OK();
+  };
+
+  auto post_graph_checker = [&](Graph& graph) {
+    auto op_to_count = CountOpsInGraph(graph);
+    TEST_RETURN_IF_NOT(op_to_count["com.microsoft.RotaryEmbedding"] == 1);
+    TEST_RETURN_IF_NOT(op_to_count["Slice"] == 0);
+    TEST_RETURN_IF_NOT(op_to_count["Neg"] == 0);
+    TEST_RETURN_IF_NOT(op_to_count["Concat"] == 0);
+    TEST_RETURN_IF_NOT(op_to_count["Mul"] == 0);
+    TEST_RETURN_IF_NOT(op_to_count["Add"] == 0);
+    TEST_RETURN_IF_NOT(op_to_count["Gather"] == 0);
+    TEST_RETURN_IF_NOT(op_to_count["Unsqueeze"] == 0);
+    for (auto& node : graph.Nodes()) {
+      if (node.OpType() == "RotaryEmbedding") {
+        const auto* cos_cache = graph_utils::GetConstantInitializer(graph, node.InputDefs()[2]->Name());
+        TEST_RETURN_IF_NOT(cos_cache != nullptr && cos_cache->dims_size() == 2);
+        TEST_RETURN_IF_NOT(cos_cache->dims(0) == 16 && cos_cache->dims(1) == 4);
+      }
+    }
+    return Status::OK();
+  };
+
+  std::unique_ptr<GraphTransformer> transformer = std::make_unique<RotaryEmbeddingFusion>();
+  ASSERT_STATUS_OK(TestGraphTransformer(build_test_case, 14, *logger_, std::move(transformer), TransformerLevel::Level2, 1,
+                                        pre_graph_checker, post_graph_checker));
+}
+
+// The halves of the cos cache differ, so the subgraph is not a rotary embedding the op can express.
+TEST_F(GraphTransformationTests, RotaryEmbeddingFusion_UnequalCacheHalves) {
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    BuildRotaryEmbeddingTestCase(builder, false);
+  };
+
+  auto pre_graph_checker = [&](Graph& graph) {
+    TEST_RETURN_IF_NOT(CountOpsInGraph(graph)["Add"] == 1);
+    return Status::OK();
+  };
+
+  auto post_graph_checker = [&](Graph& graph) {
+    auto op_to_count = CountOpsInGraph(graph);
+    TEST_RETURN_IF_NOT(op_to_count["com.microsoft.RotaryEmbedding"] == 0);
+    TEST_RETURN_IF_NOT(op_to_count["Add"] == 1);
+    return Status::OK();
+  };
+
+  std::unique_ptr<GraphTransformer> transformer = std::make_unique<RotaryEmbeddingFusion>();
+  ASSERT_STATUS_OK(TestGraphTransformer(build_test_case, 14, *logger_, std::move(transformer), TransformerLevel::Level2, 1,
+                                        pre_graph_checker, post_graph_checker));
+}
+
+// LeakyRelu(Sigmoid((x + bias) * scale) * x - y) with x + bias also consumed by a Tanh.
+static void BuildElementwiseChainTestCase(ModelTestBuilder& builder) {
+  auto* x_arg = builder.MakeInput<float>({2, 3, 16}, -2.0f, 2.0f);
+  auto* y_arg = builder.MakeInput<float>({2, 1, 16}, -2.0f, 2.0f);
+  auto* bias_arg = builder.MakeInitializer<float>({16}, -1.0f, 1.0f);
+  auto* scale_arg = builder.MakeScalarInitializer<float>(0.5f);
+
+  auto* add_out = builder.MakeIntermediate();
+  auto* mul_scale_out = builder.MakeIntermediate();
+  auto* sigmoid_out = builder.MakeIntermediate();
+  auto* mul_x_out = builder.MakeIntermediate();
+  auto* sub_out = builder.MakeIntermediate();
+  auto* output_arg = builder.MakeOutput();
+  auto* tanh_output_arg = builder.MakeOutput();
+  builder.AddNode("Add", {x_arg, bias_arg}, {add_out});
+  builder.AddNode("Mul", {add_out, scale_arg}, {mul_scale_out});
+  builder.AddNode("Sigmoid", {mul_scale_out}, {sigmoid_out});
+  builder.AddNode("Mul", {sigmoid_out, x_arg}, {mul_x_out});
+  builder.AddNode("Sub", {mul_x_out, y_arg}, {sub_out});
+  builder.AddNode("LeakyRelu", {sub_out}, {output_arg}).AddAttribute("alpha", 0.2f);
+  builder.AddNode("Tanh", {add_out}, {tanh_output_arg});
+}
+
+TEST_F(GraphTransformationTests, ElementwiseChainFusion) {
+  auto pre_graph_checker = [&](Graph& graph) {
+    TEST_RETURN_IF_NOT(CountOpsInGraph(graph)["Mul"] == 2);
+    return Status::OK();
+  };
+
+  auto post_graph_checker = [&](Graph& graph) {
+    auto op_to_count = CountOpsInGraph(graph);
+    TEST_RETURN_IF_NOT(op_to_count["com.microsoft.FusedElementwise"] == 1);
+    TEST_RETURN_IF_NOT(op_to_count["Mul"] == 0);
+    TEST_RETURN_IF_NOT(op_to_count["Sigmoid"] == 0);
+    TEST_RETURN_IF_NOT(op_to_count["Sub"] == 0);
+    TEST_RETURN_IF_NOT(op_to_count["LeakyRelu"] == 0);
+    // The Add has two consumers, and the Tanh alone is not a chain.
+    TEST_RETURN_IF_NOT(op_to_count["Add"] == 1);
+    TEST_RETURN_IF_NOT(op_to_count["Tanh"] == 1);
+
+    for (const auto& node : graph.Nodes()) {
+      if (node.OpType() == "FusedElementwise") {
+        TEST_RETURN_IF_NOT(node.InputDefs().size() == 4);
+        const auto& attrs = node.GetAttributes();
+        const auto& ops = attrs.at("ops").strings();
+        const std::vector<std::string> expected_ops{"Mul", "Sigmoid", "Mul", "Sub", "LeakyRelu"};
+        TEST_RETURN_IF_NOT(std::vector<std::string>(ops.begin(), ops.end()) == expected_ops);
+        const auto& operands = attrs.at("operands").ints();
+        const std::vector<int64_t> expected_operands{0, 1, 4, -1, 5, 2, 6, 3, 7, -1};
+        TEST_RETURN_IF_NOT(std::vector<int64_t>(operands.begin(), operands.end()) == expected_operands);
+        TEST_RETURN_IF_NOT(attrs.at("alphas").floats(4) == 0.2f);
+      }
+    }
+    return Status::OK();
+  };
+
+  std::unique_ptr<GraphTransformer> transformer = std::make_unique<ElementwiseChainFusion>();
+  ASSERT_STATUS_OK(TestGraphTransformer(BuildElementwiseChainTestCase, 14, *logger_, std::move(transformer),
+                                        TransformerLevel::Level3, 1, pre_graph_checker, post_graph_checker));
+
+  // the fused chain computes the same outputs
+  auto check_transformed_graph = [](InferenceSessionWrapper& session) {
+    EXPECT_EQ(CountOpsInGraph(session.GetGraph())["com.microsoft.FusedElementwise"], 1);
+  };
+  auto add_session_options = [](SessionOptions& session_options) {
+    ASSERT_STATUS_OK(session_options.config_options.AddConfigEntry(kOrtSessionOptionsEnableElementwiseChainFusion,
+                                                                   "1"));
+  };
+  TransformerTester(BuildElementwiseChainTestCase, check_transformed_graph, TransformerLevel::Level2,
+                    TransformerLevel::Level3, 14, 1e-5, 1e-5, nullptr, add_session_options);
+}
+
+TEST_F(GraphTransformationTests, QLinearConvAddFusion) {
+  auto test_case = [&](bool with_activation, bool sum_first) {
+    auto build_test_case = [&](ModelTestBuilder& builder) {
+      auto* input_arg = builder.MakeInput<uint8_t>({1, 8, 7, 7}, 0, 31);
+      auto* sum_arg = builder.MakeInput<uint8_t>({1, 16, 7, 7}, 0, 255);
+      auto* weight_arg = builder.MakeInitializer<int8_t>({16, 8, 3, 3}, -64, 63);
+      auto* conv_output_arg = builder.MakeIntermediate();
+      auto* add_output_arg = with_activation ? builder.MakeIntermediate() : builder.MakeOutput();
+
+      Node& conv_node = builder.AddQLinearConvNode<int8_t>(input_arg, .01f, 135,
+                                                           weight_arg, .02f, 0,
+                                                           conv_output_arg, .37f, 131);
+      conv_node.AddAttribute("pads", std::vector<int64_t>{1, 1, 1, 1});
+      if (sum_first) {
+        builder.AddQLinearBinaryNode("QLinearAdd",
+                                     sum_arg, .3f, 120,
+                                     conv_output_arg, .37f, 131,
+                                     add_output_arg, .43f, 126);
+      } else {
+        builder.AddQLinearBinaryNode("QLinearAdd",
+                                     conv_output_arg, .37f, 131,
+                                     sum_arg, .3f, 120,
+                                     add_output_arg, .43f, 126);
+      }
+      if (with_activation) {
+        builder.AddQLinearActivationNode("QLinearLeakyRelu",
+                                         add_output_arg, .43f, 126,
+                                         builder.MakeOutput(), .21f, 100);
+      }
+    };
+
+    auto check_graph = [&](InferenceSessionWrapper& session) {
+      auto op_to_count = CountOpsInGraph(session.GetGraph());
+      EXPECT_EQ(op_to_count["com.microsoft.QLinearConv"], 1);
+      EXPECT_EQ(op_to_count["QLinearConv"], 0);
+      EXPECT_EQ(op_to_count["com.microsoft.QLinearAdd"], 0);
+      EXPECT_EQ(op_to_count["com.microsoft.QLinearLeakyRelu"], 0);
+    };
+
+    // The fused epilogue may round differently than the separate kernels by one quantization step.
+    TransformerTester(build_test_case, check_graph, TransformerLevel::Level1, TransformerLevel::Level2, 12,
+                      1.0, 0.0, std::make_unique<QLinearConvAddFusion>());
+  };
+
+  test_case(false, false);
+  test_case(false, true);
+  test_case(true, false);
+  test_case(true, true);
+}
+
+// ReduceSum(Gather(weight, indices), axes=[1], keepdims=0) over 2-D indices is a sum embedding bag.
+static void BuildEmbeddingBagTestCase(ModelTestBuilder& builder) {
+  auto* weight_arg = builder.MakeInitializer<float>({32, 16}, -1.0f, 1.0f);
+  auto* indices_arg = builder.MakeInput<int64_t>({4, 5}, 0, 31);
+  auto* axes_arg = builder.MakeInitializer<int64_t>({1}, {1});
+  auto* gather_out = builder.MakeIntermediate();
+  auto* output_arg = builder.MakeOutput();
+  builder.AddNode("Gather", {weight_arg, indices_arg}, {gather_out});
+  builder.AddNode("ReduceSum", {gather_out, axes_arg}, {output_arg}).AddAttribute("keepdims", static_cast<int64_t>(0));
+}
+
+TEST_F(GraphTransformationTests, EmbeddingBagFusion) {
+  auto pre_graph_checker = [&](Graph& graph) {
+    TEST_RETURN_IF_NOT(CountOpsInGraph(graph)["ReduceSum"] == 1);
+    return Status::OK();
+  };
+
+  auto post_graph_checker = [&](Graph& graph) {
+    auto op_to_count = CountOpsInGraph(graph);
+    TEST_RETURN_IF_NOT(op_to_count["com.microsoft.EmbeddingBag"] == 1);
+    TEST_RETURN_IF_NOT(op_to_count["Gather"] == 0);
+    TEST_RETURN_IF_NOT(op_to_count["ReduceSum"] == 0);
+    for (const auto& node : graph.Nodes()) {
+      if (node.OpType() == "EmbeddingBag") {
+        TEST_RETURN_IF_NOT(node.GetAttributes().at("mode").s() == "sum");
+      }
+    }
+    return Status::OK();
+  };
+
+  std::unique_ptr<GraphTransformer> transformer = std::make_unique<EmbeddingBagFusion>();
+  ASSERT_STATUS_OK(TestGraphTransformer(BuildEmbeddingBagTestCase, 14, *logger_, std::move(transformer),
+                                        TransformerLevel::Level2, 1, pre_graph_checker, post_graph_checker));
+
+  // the fused lookup computes the same output
+  auto check_transformed_graph = [](InferenceSessionWrapper& session) {
+    EXPECT_EQ(CountOpsInGraph(session.GetGraph())["com.microsoft.EmbeddingBag"], 1);
+  };
+  TransformerTester(BuildEmbeddingBagTestCase, check_transformed_graph, TransformerLevel::Level1,
+                    TransformerLevel::Level2, 14, 1e-5, 1e-5);
+}
+
+// Gather and ReduceSum over a float16 table cast to float, along with the Shape of the cast table.
+static void BuildCastEmbeddingBagTestCase(ModelTestBuilder& builder) {
+  auto* weight_arg = builder.MakeInput<MLFloat16>({32, 16}, MLFloat16(-1.0f), MLFloat16(1.0f));
+  auto* indices_arg = builder.MakeInput<int64_t>({4, 5}, 0, 31);
+  auto* axes_arg = builder.MakeInitializer<int64_t>({1}, {1});
+  auto* cast_out = builder.MakeIntermediate();
+  auto* gather_out = builder.MakeIntermediate();
+  auto* output_arg = builder.MakeOutput();
+  auto* shape_out = builder.MakeOutput();
+  builder.AddNode("Cast", {weight_arg}, {cast_out})
+      .AddAttribute("to", static_cast<int64_t>(ONNX_NAMESPACE::TensorProto_DataType_FLOAT));
+  builder.AddNode("Gather", {cast_out, indices_arg}, {gather_out});
+  builder.AddNode("ReduceSum", {gather_out, axes_arg}, {output_arg}).AddAttribute("keepdims", static_cast<int64_t>(0));
+  builder.AddNode("Shape", {cast_out}, {shape_out});
+}
+
+TEST_F(GraphTransformationTests, CastFusion) {
+  auto build_test_case = [](ModelTestBuilder& builder) {
+    auto* weight_arg = builder.MakeInput<MLFloat16>({32, 16}, MLFloat16(-1.0f), MLFloat16(1.0f));
+    auto* indices_arg = builder.MakeInput<int64_t>({4, 5}, 0, 31);
+    auto* cast_out = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+    auto* shape_out = builder.MakeOutput();
+    builder.AddNode("Cast", {weight_arg}, {cast_out})
+        .AddAttribute("to", static_cast<int64_t>(ONNX_NAMESPACE::TensorProto_DataType_FLOAT));
+    builder.AddNode("EmbeddingBag", {cast_out, indices_arg}, {output_arg}, kMSDomain)
+        .AddAttribute("mode", std::string("sum"));
+    builder.AddNode("Shape", {cast_out}, {shape_out});
+  };
+
+  auto pre_graph_checker = [&](Graph& graph) {
+    TEST_RETURN_IF_NOT(CountOpsInGraph(graph)["Cast"] == 1);
+    return Status::OK();
+  };
+
+  auto post_graph_checker = [&](Graph& graph) {
+    TEST_RETURN_IF_NOT(CountOpsInGraph(graph)["Cast"] == 0);
+    for (const auto& node : graph.Nodes()) {
+      TEST_RETURN_IF_NOT(node.InputDefs()[0]->TypeAsProto()->tensor_type().elem_type() ==
+                         ONNX_NAMESPACE::TensorProto_DataType_FLOAT16);
+    }
+    return Status::OK();
+  };
+
+  std::unique_ptr<GraphTransformer> transformer = std::make_unique<CastFusion>();
+  ASSERT_STATUS_OK(TestGraphTransformer(build_test_case, 14, *logger_, std::move(transformer),
+                                        TransformerLevel::Level2, 1, pre_graph_checker, post_graph_checker));
+
+  // the Cast of the table is fused into the EmbeddingBag that replaces Gather and ReduceSum
+  auto check_transformed_graph = [](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.EmbeddingBag"], 1);
+    EXPECT_EQ(op_to_count["Cast"], 0);
+  };
+  TransformerTester(BuildCastEmbeddingBagTestCase, check_transformed_graph, TransformerLevel::Level1,
+                    TransformerLevel::Level2, 14, 1e-5, 1e-5);
+}
+
 struct BiasSoftmaxFusionTester {
   std::shared_ptr<Model> p_model_;
   Status model_load_;
@@ -5286,6 +6193,72 @@ TEST_F(GraphTransformationTests, PropagateCastOpsTests_Softmax) {
 
 #endif
 
+TEST_F(GraphTransformationTests, AutoMixedPrecision) {
+  // MatMul -> Add -> Relu are converted, the Softmax stays in float
+  auto build_test_case = [](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({2, 3}, -1.f, 1.f);
+    auto* weights_arg = builder.MakeInitializer<float>({3, 4}, -1.f, 1.f);
+    auto* bias_arg = builder.MakeInitializer<float>({4}, -1.f, 1.f);
+    auto* matmul_out = builder.MakeIntermediate();
+    auto* add_out = builder.MakeIntermediate();
+    auto* relu_out = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+
+    builder.AddNode("MatMul", {input_arg, weights_arg}, {matmul_out});
+    builder.AddNode("Add", {matmul_out, bias_arg}, {add_out});
+    builder.AddNode("Relu", {add_out}, {relu_out});
+    builder.AddNode("Softmax", {relu_out}, {output_arg});
+  };
+
+  auto pre_graph_checker = [](Graph& graph) {
+    TEST_RETURN_IF_NOT(CountOpsInGraph(graph)["Cast"] == 0);
+    return Status::OK();
+  };
+
+  auto check_elem_type = [](const NodeArg& node_arg, int32_t elem_type) {
+    return node_arg.TypeAsProto() != nullptr && node_arg.TypeAsProto()->tensor_type().elem_type() == elem_type;
+  };
+
+  auto post_graph_checker = [&check_elem_type](Graph& graph) {
+    // one Cast into the converted region, and one out of it
+    TEST_RETURN_IF_NOT(CountOpsInGraph(graph)["Cast"] == 2);
+    for (const auto& node : graph.Nodes()) {
+      if (node.OpType() == "MatMul" || node.OpType() == "Add" || node.OpType() == "Relu") {
+        for (const auto* input_def : node.InputDefs()) {
+          TEST_RETURN_IF_NOT(check_elem_type(*input_def, TensorProto_DataType_FLOAT16));
+        }
+        TEST_RETURN_IF_NOT(check_elem_type(*node.OutputDefs()[0], TensorProto_DataType_FLOAT16));
+      } else if (node.OpType() == "Softmax") {
+        TEST_RETURN_IF_NOT(check_elem_type(*node.InputDefs()[0], TensorProto_DataType_FLOAT));
+      }
+    }
+    return Status::OK();
+  };
+
+  ASSERT_STATUS_OK(TestGraphTransformer(build_test_case, 13, *logger_,
+                                        std::make_unique<AutoMixedPrecision>(TensorProto_DataType_FLOAT16),
+                                        TransformerLevel::Level1, 1, pre_graph_checker, post_graph_checker));
+
+  // with Add denied, the Relu has no converted input to follow
+  auto deny_post_graph_checker = [&check_elem_type](Graph& graph) {
+    TEST_RETURN_IF_NOT(CountOpsInGraph(graph)["Cast"] == 2);
+    for (const auto& node : graph.Nodes()) {
+      if (node.OpType() == "MatMul") {
+        TEST_RETURN_IF_NOT(check_elem_type(*node.OutputDefs()[0], TensorProto_DataType_BFLOAT16));
+      } else if (node.OpType() == "Add" || node.OpType() == "Relu") {
+        TEST_RETURN_IF_NOT(check_elem_type(*node.OutputDefs()[0], TensorProto_DataType_FLOAT));
+      }
+    }
+    return Status::OK();
+  };
+
+  ASSERT_STATUS_OK(TestGraphTransformer(build_test_case, 13, *logger_,
+                                        std::make_unique<AutoMixedPrecision>(TensorProto_DataType_BFLOAT16,
+                                                                             InlinedHashSet<std::string>{},
+                                                                             InlinedHashSet<std::string>{"Add"}),
+                                        TransformerLevel::Level1, 1, pre_graph_checker, deny_post_graph_checker));
+}
+
 /*
 Test graph include multiple equivalent subgraphs as below.
            graph input [1, 1, 256, 256] (int64_t)
@@ -6147,6 +7120,46 @@ TEST_F(GraphTransformationTests, ConstantSharing_ShouldNotShareForGraphOutput) {
   }
 }
 
+// Initializers with more elements than the scalar sharing threshold are shared if their data is identical.
+TEST_F(GraphTransformationTests, ConstantSharing_ShareLargeInitializer) {
+  std::vector<float> weights(64);
+  std::iota(weights.begin(), weights.end(), 0.0f);
+  std::vector<float> other_weights(weights);
+  other_weights.back() = -1.0f;
+
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({{4, 64}});
+    auto* weights_1 = builder.MakeInitializer<float>({64}, weights);
+    auto* weights_2 = builder.MakeInitializer<float>({64}, weights);
+    auto* weights_3 = builder.MakeInitializer<float>({64}, other_weights);
+    auto* mul_out_1 = builder.MakeOutput();
+    auto* mul_out_2 = builder.MakeOutput();
+    auto* mul_out_3 = builder.MakeOutput();
+    builder.AddNode("Mul", {input_arg, weights_1}, {mul_out_1});
+    builder.AddNode("Mul", {input_arg, weights_2}, {mul_out_2});
+    builder.AddNode("Mul", {input_arg, weights_3}, {mul_out_3});
+  };
+
+  auto pre_graph_checker = [](Graph& graph) {
+    TEST_RETURN_IF_NOT(graph.GetAllInitializedTensors().size() == 3U);
+    return Status::OK();
+  };
+
+  auto post_graph_checker = [](Graph& graph) {
+    TEST_RETURN_IF_NOT(graph.GetAllInitializedTensors().size() == 2U);
+    InlinedHashSet<const NodeArg*> mul_initializers;
+    for (auto& node : graph.Nodes()) {
+      mul_initializers.insert(node.InputDefs()[1]);
+    }
+    TEST_RETURN_IF_NOT(mul_initializers.size() == 2U);
+    return Status::OK();
+  };
+
+  std::unique_ptr<GraphTransformer> transformer = std::make_unique<ConstantSharing>();
+  ASSERT_STATUS_OK(TestGraphTransformer(build_test_case, 14, *logger_, std::move(transformer),
+                                        TransformerLevel::Level1, 1, pre_graph_checker, post_graph_checker));
+}
+
 TEST_F(GraphTransformationTests, GatherToSplitFusion) {
   auto build_test_case = [&](ModelTestBuilder& builder) {
     auto* data_arg = builder.MakeInput<float>({{54}});
@@ -6558,5 +7571,64 @@ TEST_F(GraphTransformationTests, GatherToSliceFusion) {
   }
 }
 
+// The intermediate value of the Expand is alive during the Relu chain as the Mul consumes it too. The peak is
+// 3 * 256 * 64 floats: the expanded value and the input and output of a Relu.
+TEST_F(GraphTransformationTests, MemoryBudgetOptimizerRecompute) {
+  auto build_test_case = [](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({1, 64}, -1.0f, 1.0f);
+    auto* other_arg = builder.MakeInput<float>({256, 64}, -1.0f, 1.0f);
+    auto* shape_arg = builder.Make1DInitializer<int64_t>({256, 64});
+    auto* expand_out = builder.MakeIntermediate();
+    auto* add_out = builder.MakeIntermediate();
+    auto* relu1_out = builder.MakeIntermediate();
+    auto* relu2_out = builder.MakeIntermediate();
+    auto* relu3_out = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+
+    builder.AddNode("Expand", {input_arg, shape_arg}, {expand_out});
+    builder.AddNode("Add", {expand_out, other_arg}, {add_out});
+    builder.AddNode("Relu", {add_out}, {relu1_out});
+    builder.AddNode("Relu", {relu1_out}, {relu2_out});
+    builder.AddNode("Relu", {relu2_out}, {relu3_out});
+    builder.AddNode("Mul", {relu3_out, expand_out}, {output_arg});
+  };
+
+  auto pre_graph_checker = [](Graph& graph) {
+    TEST_RETURN_IF_NOT(CountOpsInGraph(graph)["Expand"] == 1);
+    return Status::OK();
+  };
+
+  auto recomputed_checker = [](Graph& graph) {
+    TEST_RETURN_IF_NOT(CountOpsInGraph(graph)["Expand"] == 2);
+    for (const auto& node : graph.Nodes()) {
+      if (node.OpType() == "Mul") {
+        const Node* producer = graph.GetProducerNode(node.InputDefs()[1]->Name());
+        TEST_RETURN_IF_NOT(producer != nullptr && producer->OpType() == "Expand");
+        TEST_RETURN_IF_NOT(producer->Priority() == static_cast<int>(ExecutionPriority::LOCAL_LOW));
+        TEST_RETURN_IF_NOT(graph.GetConsumerNodes(producer->OutputDefs()[0]->Name()).size() == 1);
+      }
+    }
+    return Status::OK();
+  };
+
+  ASSERT_STATUS_OK(TestGraphTransformer(build_test_case, 13, *logger_, std::make_unique<MemoryBudgetOptimizer>(150000),
+                                        TransformerLevel::Level2, 1, pre_graph_checker, recomputed_checker));
+
+  // the budget covers the peak
+  ASSERT_STATUS_OK(TestGraphTransformer(build_test_case, 13, *logger_, std::make_unique<MemoryBudgetOptimizer>(200000),
+                                        TransformerLevel::Level2, 1, pre_graph_checker, pre_graph_checker));
+
+  // the recomputed graph computes the same outputs
+  auto check_transformed_graph = [](InferenceSessionWrapper& session) {
+    EXPECT_EQ(CountOpsInGraph(session.GetGraph())["Expand"], 2);
+    EXPECT_EQ(session.GetSessionOptions().execution_order, ExecutionOrder::PRIORITY_BASED);
+  };
+  auto add_session_options = [](SessionOptions& session_options) {
+    ASSERT_STATUS_OK(session_options.config_options.AddConfigEntry(kOrtSessionOptionsMemoryBudgetBytes, "150000"));
+  };
+  TransformerTester(build_test_case, check_transformed_graph, TransformerLevel::Level1, TransformerLevel::Level2, 13,
+                    0.0, 0.0, nullptr, add_session_options);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -398,6 +398,41 @@ TEST_F(GraphTransformationTests, LayerNormWithCastFusionTest_9) {
                                         1, nullptr, post_graph_checker));
 }
 
+// The per-channel smoothing Mul that follows a LayerNormalization is folded into its scale and bias.
+TEST_F(GraphTransformationTests, LayerNormScaleFusionTest) {
+  auto build_test_case = [](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({2, 3, 16}, -1.0f, 1.0f);
+    auto* scale_arg = builder.MakeInitializer<float>({16}, 0.5f, 1.5f);
+    auto* bias_arg = builder.MakeInitializer<float>({16}, -0.5f, 0.5f);
+    auto* smooth_arg = builder.MakeInitializer<float>({16}, 0.1f, 4.0f);
+    auto* weight_arg = builder.MakeInitializer<float>({16, 8}, -1.0f, 1.0f);
+    auto* norm_out = builder.MakeIntermediate();
+    auto* mul_out = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+
+    builder.AddNode("LayerNormalization", {input_arg, scale_arg, bias_arg}, {norm_out})
+        .AddAttribute("axis", static_cast<int64_t>(-1));
+    builder.AddNode("Mul", {norm_out, smooth_arg}, {mul_out});
+    builder.AddNode("MatMul", {mul_out, weight_arg}, {output_arg});
+  };
+
+  auto check_graph = [](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["LayerNormalization"], 1);
+    EXPECT_EQ(op_to_count["Mul"], 0);
+    EXPECT_EQ(op_to_count["MatMul"], 1);
+  };
+
+  TransformerTester(build_test_case,
+                    check_graph,
+                    TransformerLevel::Level1,
+                    TransformerLevel::Level2,
+                    17 /*opset_version*/,
+                    1e-5 /*per_sample_tolerance*/,
+                    1e-5 /*relative_per_sample_tolerance*/,
+                    std::make_unique<LayerNormScaleFusion>());
+}
+
 TEST_F(GraphTransformationTests, SimplifiedLayerNormFusionTest) {
   constexpr const ORTCHAR_T* model_uri = MODEL_FOLDER "fusion/layer_norm_t5.onnx";
   std::shared_ptr<Model> p_model;
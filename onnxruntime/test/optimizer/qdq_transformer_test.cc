@@ -1049,6 +1049,104 @@ TEST(QDQTransformerTests, Where) {
   test_case({1}, {1}, {1});
 }
 
+TEST(QDQTransformerTests, Attention) {
+  auto test_case = [&](bool use_int8_weight, bool use_mask) {
+    auto build_test_case = [&](ModelTestBuilder& builder) {
+      constexpr int64_t batch_size = 2, sequence_length = 4, hidden_size = 8;
+      auto* input_arg = builder.MakeInput<uint8_t>({batch_size, sequence_length, hidden_size},
+                                                   std::numeric_limits<uint8_t>::min(),
+                                                   std::numeric_limits<uint8_t>::max());
+      auto* output_arg = builder.MakeOutput();
+
+      auto* dq_input_output = builder.MakeIntermediate();
+      builder.AddDequantizeLinearNode<uint8_t>(input_arg, .02f, 128, dq_input_output);
+
+      auto* dq_weight_output = builder.MakeIntermediate();
+      if (use_int8_weight) {
+        auto* weight_arg = builder.MakeInitializer<int8_t>({hidden_size, 3 * hidden_size}, -64, 64);
+        builder.AddDequantizeLinearNode<int8_t>(weight_arg, .01f, 0, dq_weight_output);
+      } else {
+        auto* weight_arg = builder.MakeInitializer<uint8_t>({hidden_size, 3 * hidden_size}, 64, 192);
+        builder.AddDequantizeLinearNode<uint8_t>(weight_arg, .01f, 128, dq_weight_output);
+      }
+
+      auto* bias_arg = builder.MakeInitializer<float>({3 * hidden_size}, -1.f, 1.f);
+      std::vector<NodeArg*> attention_inputs{dq_input_output, dq_weight_output, bias_arg};
+      if (use_mask) {
+        attention_inputs.push_back(builder.MakeInitializer<int32_t>({batch_size}, {3, 4}));
+      }
+      Node& attention_node = builder.AddNode("Attention", attention_inputs, {output_arg}, kMSDomain);
+      attention_node.AddAttribute("num_heads", static_cast<int64_t>(2));
+    };
+
+    auto check_graph = [&](InferenceSessionWrapper& session) {
+      auto op_to_count = CountOpsInGraph(session.GetGraph());
+      EXPECT_EQ(op_to_count["com.microsoft.QAttention"], 1);
+      EXPECT_EQ(op_to_count["com.microsoft.Attention"], 0);
+      EXPECT_EQ(op_to_count["DequantizeLinear"], 0);
+    };
+
+    TransformerTester(build_test_case,
+                      check_graph,
+                      TransformerLevel::Level1,
+                      TransformerLevel::Level2,
+                      12 /*opset_version*/,
+                      0.01 /*per_sample_tolerance*/,
+                      0.01 /*relative_per_sample_tolerance*/);
+  };
+
+  test_case(false, false);
+  test_case(true, false);
+  test_case(false, true);
+}
+
+TEST(QDQTransformerTests, LayerNormalization) {
+  auto test_case = [&](bool use_bias) {
+    constexpr float y_scale = .05f;
+    auto build_test_case = [&](ModelTestBuilder& builder) {
+      constexpr int64_t hidden_size = 16;
+      auto* input_arg = builder.MakeInput<uint8_t>({2, 3, hidden_size},
+                                                   std::numeric_limits<uint8_t>::min(),
+                                                   std::numeric_limits<uint8_t>::max());
+      auto* output_arg = builder.MakeOutput();
+
+      auto* dq_output = builder.MakeIntermediate();
+      builder.AddDequantizeLinearNode<uint8_t>(input_arg, .02f, 128, dq_output);
+
+      std::vector<NodeArg*> layer_norm_inputs{dq_output, builder.MakeInitializer<float>({hidden_size}, .5f, 1.5f)};
+      if (use_bias) {
+        layer_norm_inputs.push_back(builder.MakeInitializer<float>({hidden_size}, -.5f, .5f));
+      }
+      auto* layer_norm_output = builder.MakeIntermediate();
+      Node& layer_norm_node = builder.AddNode("LayerNormalization", layer_norm_inputs, {layer_norm_output});
+      layer_norm_node.AddAttribute("axis", static_cast<int64_t>(-1));
+
+      // the dequantized output is compared, so that a difference of one in the rounding fits the tolerance
+      auto* q_output = builder.MakeIntermediate();
+      builder.AddQuantizeLinearNode<uint8_t>(layer_norm_output, y_scale, 128, q_output);
+      builder.AddDequantizeLinearNode<uint8_t>(q_output, y_scale, 128, output_arg);
+    };
+
+    auto check_graph = [&](InferenceSessionWrapper& session) {
+      auto op_to_count = CountOpsInGraph(session.GetGraph());
+      EXPECT_EQ(op_to_count["com.microsoft.QLinearLayerNormalization"], 1);
+      EXPECT_EQ(op_to_count["LayerNormalization"], 0);
+      EXPECT_EQ(op_to_count["QuantizeLinear"], 0);
+      EXPECT_EQ(op_to_count["DequantizeLinear"], 1);
+    };
+
+    TransformerTester(build_test_case,
+                      check_graph,
+                      TransformerLevel::Level1,
+                      TransformerLevel::Level2,
+                      17 /*opset_version*/,
+                      y_scale * 1.01 /*per_sample_tolerance*/);
+  };
+
+  test_case(true);
+  test_case(false);
+}
+
 TEST(QDQTransformerTests, Transpose) {
   auto test_case = [&](const std::vector<int64_t>& input_shape, const std::vector<int64_t>& perms) {
     auto check_graph = [&](InferenceSessionWrapper& session) {
@@ -125,7 +125,7 @@ TEST(GraphRuntimeOptimizationTest, SaveRuntimeOptimizationToOrtFormat) {
   // write graph to ORT format buffer
   {
     flatbuffers::Offset<fbs::Model> fbs_model_offset;
-    ASSERT_STATUS_OK(model->SaveToOrtFormat(builder, fbs_model_offset));
+    ASSERT_STATUS_OK(model->SaveToOrtFormat(builder, OrtFormatSaveOptions{}, fbs_model_offset));
 
     flatbuffers::Offset<fbs::InferenceSession> fbs_session_offset =
         fbs::CreateInferenceSessionDirect(builder,
@@ -5,6 +5,7 @@
 
 #include <string.h>
 #include <iostream>
+#include <string>
 
 // Windows Specific
 #ifdef _WIN32
@@ -33,6 +34,11 @@ namespace perftest {
       "\t-A: Disable memory arena\n"
       "\t-I: Generate tensor input binding (Free dimensions are treated as 1.)\n"
       "\t-c [parallel runs]: Specifies the (max) number of runs to invoke simultaneously. Default:1.\n"
+      "\t-Q [target_qps]: Sends requests at this rate (per second) whatever their completion, instead of running them back to back.\n"
+      "\t\tThe latency of each request is measured from its scheduled arrival, so that it includes its time in the queue.\n"
+      "\t-a [poisson|constant]: Specifies the distribution of the intervals between the requests sent with -Q. Default:'poisson'.\n"
+      "\t-R [traffic_file]: Runs the test data sets whose ids are listed in the file, one per line, in order and cyclically.\n"
+      "\t\tIds are the positions of the test_data_set_* directories. Replays the mix of input shapes of recorded traffic.\n"
       "\t-e [cpu|cuda|dnnl|tensorrt|openvino|dml|acl|nnapi|coreml|snpe|rocm|migraphx|xnnpack|vitisai]: Specifies the provider 'cpu','cuda','dnnl','tensorrt', "
       "'openvino', 'dml', 'acl', 'nnapi', 'coreml', 'snpe', 'rocm', 'migraphx', 'xnnpack' or 'vitisai'. "
       "Default:'cpu'.\n"
@@ -138,7 +144,7 @@ static bool ParseDimensionOverride(std::basic_string<ORTCHAR_T>& dim_identifier,
 
 /*static*/ bool CommandLineParser::ParseArguments(PerformanceTestConfig& test_config, int argc, ORTCHAR_T* argv[]) {
   int ch;
-  while ((ch = getopt(argc, argv, ORT_TSTR("b:m:e:r:t:p:x:y:c:d:o:u:i:f:F:S:T:AMPIDZvhsqz"))) != -1) {
+  while ((ch = getopt(argc, argv, ORT_TSTR("b:m:e:r:t:p:x:y:c:d:o:u:i:f:F:S:T:Q:a:R:AMPIDZvhsqz"))) != -1) {
     switch (ch) {
       case 'f': {
         std::basic_string<ORTCHAR_T> dim_name;
@@ -263,6 +269,29 @@ static bool ParseDimensionOverride(std::basic_string<ORTCHAR_T>& dim_identifier,
           return false;
         }
         break;
+      case 'Q':
+        ORT_TRY {
+          test_config.run_config.target_qps = std::stod(optarg);
+        }
+        ORT_CATCH(...) {
+          return false;
+        }
+        if (test_config.run_config.target_qps <= 0) {
+          return false;
+        }
+        break;
+      case 'a':
+        if (!CompareCString(optarg, ORT_TSTR("poisson"))) {
+          test_config.run_config.arrival_distribution = ArrivalDistribution::kPoisson;
+        } else if (!CompareCString(optarg, ORT_TSTR("constant"))) {
+          test_config.run_config.arrival_distribution = ArrivalDistribution::kConstant;
+        } else {
+          return false;
+        }
+        break;
+      case 'R':
+        test_config.run_config.traffic_file_path = optarg;
+        break;
       case 'o': {
         int tmp = static_cast<int>(OrtStrtol<PATH_CHAR_TYPE>(optarg, nullptr));
         switch (tmp) {
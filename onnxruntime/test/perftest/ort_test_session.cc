@@ -23,7 +23,11 @@ std::chrono::duration<double> OnnxRuntimeTestSession::Run() {
   // Randomly pick one OrtValueArray from test_inputs_. (NOT ThreadSafe)
   const std::uniform_int_distribution<int>::param_type p(0, static_cast<int>(test_inputs_.size() - 1));
   const size_t id = static_cast<size_t>(dist_(rand_engine_, p));
-  auto& input = test_inputs_.at(id);
+  return RunTestData(id);
+}
+
+std::chrono::duration<double> OnnxRuntimeTestSession::RunTestData(size_t test_data_id) {
+  auto& input = test_inputs_.at(test_data_id);
   auto start = std::chrono::high_resolution_clock::now();
   auto output_values = session_.Run(Ort::RunOptions{nullptr}, input_names_.data(), input.data(), input_names_.size(),
                                     output_names_raw_ptr.data(), output_names_raw_ptr.size());
@@ -134,6 +138,8 @@ OnnxRuntimeTestSession::OnnxRuntimeTestSession(Ort::Env& env, std::random_device
     std::string trt_profile_max_shapes = "";
     std::string trt_profile_opt_shapes = "";
     bool trt_cuda_graph_enable = false;
+    bool trt_async_engine_build_enable = false;
+    int trt_profile_warmup_runs = 0;
 
 #ifdef _MSC_VER
     std::string ov_string = ToUTF8String(performance_test_config.run_config.ep_runtime_config_string);
@@ -371,8 +377,22 @@ OnnxRuntimeTestSession::OnnxRuntimeTestSession(Ort::Env& env, std::random_device
         } else {
           ORT_THROW("[ERROR] [TensorRT] The value for the key 'trt_cuda_graph_enable' should be a boolean i.e. true or false. Default value is false.\n");
         }
+      } else if (key == "trt_async_engine_build_enable") {
+        if (value == "true" || value == "True") {
+          trt_async_engine_build_enable = true;
+        } else if (value == "false" || value == "False") {
+          trt_async_engine_build_enable = false;
+        } else {
+          ORT_THROW("[ERROR] [TensorRT] The value for the key 'trt_async_engine_build_enable' should be a boolean i.e. true or false. Default value is false.\n");
+        }
+      } else if (key == "trt_profile_warmup_runs") {
+        if (!value.empty()) {
+          trt_profile_warmup_runs = std::stoi(value);
+        } else {
+          ORT_THROW("[ERROR] [TensorRT] The value for the key 'trt_profile_warmup_runs' should be a number.\n");
+        }
       } else {
-        ORT_THROW("[ERROR] [TensorRT] wrong key type entered. Choose from the following runtime key options that are available for TensorRT. ['device_id', 'trt_max_partition_iterations', 'trt_min_subgraph_size', 'trt_max_workspace_size', 'trt_fp16_enable', 'trt_int8_enable', 'trt_int8_calibration_table_name', 'trt_int8_use_native_calibration_table', 'trt_dla_enable', 'trt_dla_core', 'trt_dump_subgraphs', 'trt_engine_cache_enable', 'trt_engine_cache_path', 'trt_engine_decryption_enable', 'trt_engine_decryption_lib_path', 'trt_force_sequential_engine_build', 'trt_context_memory_sharing_enable', 'trt_layer_norm_fp32_fallback', 'trt_timing_cache_enable', 'trt_force_timing_cache', 'trt_detailed_build_log', 'trt_build_heuristics_enable', 'trt_sparsity_enable', 'trt_builder_optimization_level', 'trt_auxiliary_streams', 'trt_tactic_sources', 'trt_extra_plugin_lib_paths', 'trt_profile_min_shapes', 'trt_profile_max_shapes', 'trt_profile_opt_shapes', 'trt_cuda_graph_enable'] \n");
+        ORT_THROW("[ERROR] [TensorRT] wrong key type entered. Choose from the following runtime key options that are available for TensorRT. ['device_id', 'trt_max_partition_iterations', 'trt_min_subgraph_size', 'trt_max_workspace_size', 'trt_fp16_enable', 'trt_int8_enable', 'trt_int8_calibration_table_name', 'trt_int8_use_native_calibration_table', 'trt_dla_enable', 'trt_dla_core', 'trt_dump_subgraphs', 'trt_engine_cache_enable', 'trt_engine_cache_path', 'trt_engine_decryption_enable', 'trt_engine_decryption_lib_path', 'trt_force_sequential_engine_build', 'trt_context_memory_sharing_enable', 'trt_layer_norm_fp32_fallback', 'trt_timing_cache_enable', 'trt_force_timing_cache', 'trt_detailed_build_log', 'trt_build_heuristics_enable', 'trt_sparsity_enable', 'trt_builder_optimization_level', 'trt_auxiliary_streams', 'trt_tactic_sources', 'trt_extra_plugin_lib_paths', 'trt_profile_min_shapes', 'trt_profile_max_shapes', 'trt_profile_opt_shapes', 'trt_cuda_graph_enable', 'trt_async_engine_build_enable', 'trt_profile_warmup_runs'] \n");
       }
     }
     OrtTensorRTProviderOptionsV2 tensorrt_options;
@@ -409,6 +429,8 @@ OnnxRuntimeTestSession::OnnxRuntimeTestSession(Ort::Env& env, std::random_device
     tensorrt_options.trt_profile_max_shapes = trt_profile_max_shapes.c_str();
     tensorrt_options.trt_profile_opt_shapes = trt_profile_opt_shapes.c_str();
     tensorrt_options.trt_cuda_graph_enable = trt_cuda_graph_enable;
+    tensorrt_options.trt_async_engine_build_enable = trt_async_engine_build_enable;
+    tensorrt_options.trt_profile_warmup_runs = trt_profile_warmup_runs;
 
     session_options.AppendExecutionProvider_TensorRT_V2(tensorrt_options);
 
@@ -31,6 +31,10 @@ class OnnxRuntimeTestSession : public TestSession {
 
   std::chrono::duration<double> Run() override;
 
+  std::chrono::duration<double> RunTestData(size_t test_data_id) override;
+
+  size_t GetTestDataCount() const override { return test_inputs_.size(); }
+
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(OnnxRuntimeTestSession);
 
  private:
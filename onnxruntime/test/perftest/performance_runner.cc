@@ -8,6 +8,7 @@
 
 #include "performance_runner.h"
 #include <iostream>
+#include <thread>
 
 #include "TestCase.h"
 #include "TFModelInfo.h"
@@ -112,6 +113,7 @@ Status PerformanceRunner::Run() {
   if (!Initialize()) {
     return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "failed to initialize.");
   }
+  ORT_RETURN_IF_ERROR(LoadTraffic());
 
   // warm up
   initial_inference_result_.start = std::chrono::high_resolution_clock::now();
@@ -161,6 +163,10 @@ Status PerformanceRunner::Run() {
 }
 
 Status PerformanceRunner::FixDurationTest() {
+  if (performance_test_config_.run_config.target_qps > 0) {
+    return RunOpenLoop();
+  }
+
   if (performance_test_config_.run_config.concurrent_session_runs <= 1) {
     return RunFixDuration();
   }
@@ -169,6 +175,10 @@ Status PerformanceRunner::FixDurationTest() {
 }
 
 Status PerformanceRunner::RepeatedTimesTest() {
+  if (performance_test_config_.run_config.target_qps > 0) {
+    return RunOpenLoop();
+  }
+
   if (performance_test_config_.run_config.concurrent_session_runs <= 1) {
     return RunRepeatedTimes();
   }
@@ -247,6 +257,106 @@ Status PerformanceRunner::ForkJoinRepeat() {
   return Status::OK();
 }
 
+Status PerformanceRunner::RunOpenLoop() {
+  // Requests are sent at their scheduled arrival time whether the previous ones completed or not, and the time cost
+  // of each of them is measured from its arrival rather than from the start of its run. A request queued behind
+  // slow ones is therefore charged for its wait, which a closed loop would hide by delaying the next requests.
+  const auto& run_config = performance_test_config_.run_config;
+  using Clock = std::chrono::high_resolution_clock;
+
+  // the requests in excess of the concurrent runs wait in the queue of the threadpool
+  auto tpool = std::make_unique<DefaultThreadPoolType>(static_cast<int>(run_config.concurrent_session_runs));
+  std::atomic<int> counter{0};
+  OrtMutex m;
+  OrtCondVar cv;
+
+  std::exponential_distribution<double> poisson_interval(run_config.target_qps);
+  const double constant_interval = 1.0 / run_config.target_qps;
+
+  const auto start = Clock::now();
+  auto arrival = start;
+  const bool fixed_repeats = run_config.test_mode == TestMode::KFixRepeatedTimesMode;
+  for (size_t requests = 0;; ++requests) {
+    std::chrono::duration<double> elapsed = arrival - start;
+    if (fixed_repeats ? requests >= run_config.repeated_times : elapsed.count() >= run_config.duration_in_seconds) {
+      break;
+    }
+
+    std::this_thread::sleep_until(arrival);
+    counter++;
+    tpool->Schedule([this, arrival, &counter, &m, &cv]() {
+      Status status;
+      ORT_TRY {
+        RunSession();
+      }
+      ORT_CATCH(const std::exception& ex) {
+        ORT_HANDLE_EXCEPTION([&]() {
+          status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "PerformanceRunner::RunOpenLoop caught exception: ", ex.what());
+        });
+      }
+      if (status.IsOK()) {
+        AddTimeCost(std::chrono::duration<double>(Clock::now() - arrival).count());
+      } else {
+        std::cerr << status.ErrorMessage();
+      }
+
+      // Simplified version of Eigen::Barrier
+      std::lock_guard<OrtMutex> lg(m);
+      counter--;
+      cv.notify_all();
+    });
+
+    const double interval = run_config.arrival_distribution == ArrivalDistribution::kPoisson
+                                ? poisson_interval(arrival_rand_engine_)
+                                : constant_interval;
+    arrival += std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(interval));
+  }
+
+  // Join
+  std::unique_lock<OrtMutex> lock(m);
+  cv.wait(lock, [&counter]() { return counter == 0; });
+
+  return Status::OK();
+}
+
+Status PerformanceRunner::LoadTraffic() {
+  const auto& path = performance_test_config_.run_config.traffic_file_path;
+  if (path.empty()) {
+    return Status::OK();
+  }
+
+  // one test data set id per line, ids being the positions of the test data sets in the order they are loaded
+  std::ifstream traffic_file(path);
+  if (!traffic_file.good()) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "failed to open traffic file '", ToUTF8String(path), "'");
+  }
+
+  const size_t test_data_count = session_->GetTestDataCount();
+  std::string line;
+  while (std::getline(traffic_file, line)) {
+    if (line.find_first_not_of(" \t\r") == std::string::npos) {
+      continue;
+    }
+    size_t test_data_id = 0;
+    ORT_TRY {
+      test_data_id = static_cast<size_t>(std::stoull(line));
+    }
+    ORT_CATCH(...) {
+      test_data_id = test_data_count;
+    }
+    if (test_data_id >= test_data_count) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "traffic file line '", line,
+                             "' is not the id of one of the ", test_data_count, " test data sets");
+    }
+    traffic_.push_back(test_data_id);
+  }
+
+  if (traffic_.empty()) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "traffic file '", ToUTF8String(path), "' is empty");
+  }
+  return Status::OK();
+}
+
 static std::unique_ptr<TestModelInfo> CreateModelInfo(const PerformanceTestConfig& performance_test_config_) {
   if (CompareCString(performance_test_config_.backend.c_str(), ORT_TSTR("ort")) == 0) {
     const auto& file_path = performance_test_config_.model_info.model_file_path;
@@ -286,7 +396,8 @@ static std::unique_ptr<TestSession> CreateSession(Ort::Env& env, std::random_dev
 
 PerformanceRunner::PerformanceRunner(Ort::Env& env, const PerformanceTestConfig& test_config, std::random_device& rd)
     : performance_test_config_(test_config),
-      test_model_info_(CreateModelInfo(test_config)) {
+      test_model_info_(CreateModelInfo(test_config)),
+      arrival_rand_engine_(rd()) {
   session_create_start_ = std::chrono::high_resolution_clock::now();
   session_ = CreateSession(env, rd, test_config, *test_model_info_);
   session_create_end_ = std::chrono::high_resolution_clock::now();
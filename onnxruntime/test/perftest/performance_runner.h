@@ -10,6 +10,7 @@
 #include <iostream>
 #include <random>
 #include <chrono>
+#include <atomic>
 // onnxruntime dependencies
 #include <core/common/common.h>
 #include <core/common/status.h>
@@ -63,7 +64,7 @@ class PerformanceRunner {
 
     auto status = Status::OK();
     ORT_TRY {
-      duration_seconds = session_->Run();
+      duration_seconds = RunSession();
     }
     ORT_CATCH(const std::exception& ex) {
       ORT_HANDLE_EXCEPTION([&]() {
@@ -73,21 +74,36 @@ class PerformanceRunner {
     ORT_RETURN_IF_ERROR(status);
 
     if (!isWarmup) {
-      std::lock_guard<OrtMutex> guard(results_mutex_);
-      performance_result_.time_costs.emplace_back(duration_seconds.count());
-      performance_result_.total_time_cost += duration_seconds.count();
-      if (performance_test_config_.run_config.f_verbose) {
-        std::cout << "iteration:" << performance_result_.time_costs.size() << ","
-                  << "time_cost:" << performance_result_.time_costs.back() << std::endl;
-      }
+      AddTimeCost(duration_seconds.count());
     }
     return Status::OK();
   }
 
+  // Runs the next test data set of the traffic file if there is one, otherwise a random one
+  std::chrono::duration<double> RunSession() {
+    if (traffic_.empty()) {
+      return session_->Run();
+    }
+    return session_->RunTestData(traffic_[next_request_++ % traffic_.size()]);
+  }
+
+  void AddTimeCost(double time_cost) {
+    std::lock_guard<OrtMutex> guard(results_mutex_);
+    performance_result_.time_costs.emplace_back(time_cost);
+    performance_result_.total_time_cost += time_cost;
+    if (performance_test_config_.run_config.f_verbose) {
+      std::cout << "iteration:" << performance_result_.time_costs.size() << ","
+                << "time_cost:" << performance_result_.time_costs.back() << std::endl;
+    }
+  }
+
+  Status LoadTraffic();
+
   Status FixDurationTest();
   Status RepeatedTimesTest();
   Status ForkJoinRepeat();
   Status RunParallelDuration();
+  Status RunOpenLoop();
 
   inline Status RunFixDuration() {
     while (performance_result_.total_time_cost < performance_test_config_.run_config.duration_in_seconds) {
@@ -113,6 +129,10 @@ class PerformanceRunner {
   std::unique_ptr<TestSession> session_;
   onnxruntime::test::HeapBuffer b_;
   std::unique_ptr<ITestCase> test_case_;
+  // test data set ids of the traffic file
+  std::vector<size_t> traffic_;
+  std::atomic<size_t> next_request_{0};
+  std::mt19937 arrival_rand_engine_;
 
   OrtMutex results_mutex_;
 };
@@ -18,6 +18,12 @@ enum class TestMode : std::uint8_t {
   KFixRepeatedTimesMode
 };
 
+// Distribution of the intervals between the requests of the open-loop mode
+enum class ArrivalDistribution : std::uint8_t {
+  kPoisson = 0,
+  kConstant
+};
+
 enum class Platform : std::uint8_t {
   kWindows = 0,
   kLinux
@@ -41,6 +47,11 @@ struct RunConfig {
   size_t repeated_times{1000};
   size_t duration_in_seconds{600};
   size_t concurrent_session_runs{1};
+  // Requests per second sent regardless of the completion of the previous ones. 0 runs the closed loop instead.
+  double target_qps{0.0};
+  ArrivalDistribution arrival_distribution{ArrivalDistribution::kPoisson};
+  // File of the test data set ids to run, in order, instead of random ones
+  std::basic_string<ORTCHAR_T> traffic_file_path;
   bool f_dump_statistics{false};
   int random_seed_for_input_data{-1};
   bool f_verbose{false};
@@ -11,6 +11,9 @@ namespace perftest {
 class TestSession {
  public:
   virtual std::chrono::duration<double> Run() = 0;
+  // Same as Run() with the inputs of test data set `test_data_id` instead of random ones
+  virtual std::chrono::duration<double> RunTestData(size_t test_data_id) = 0;
+  virtual size_t GetTestDataCount() const = 0;
   // TODO: implement it
   // This function won't return duration, because it may vary largely.
   // Please measure the perf at a higher level.
@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "core/platform/threadpool.h"
+#include "core/common/parallel_for_calibration.h"
 #include "core/platform/EigenNonBlockingThreadPool.h"
 #include "core/platform/ort_mutex.h"
 #include "core/util/thread_utils.h"
@@ -12,8 +13,12 @@
 
 #include "gtest/gtest.h"
 #include <algorithm>
+#include <filesystem>
+#include <fstream>
 #include <memory>
 #include <functional>
+#include <set>
+#include <thread>
 
 #ifdef _WIN32
 #include <Windows.h>
@@ -510,6 +515,32 @@ TEST(ThreadPoolTest, TestStagedMultiLoopSections_4Thread_100Loop) {
   TestStagedMultiLoopSections("TestStagedMultiLoopSections_4Thread_100Loop", 4, 100);
 }
 
+// Workers bound to two NUMA nodes, the first entry is the main thread.
+TEST(ThreadPoolTest, TestParallelForWithNumaNodes) {
+  onnxruntime::ThreadOptions thread_options;
+  thread_options.numa_nodes = {-1, 0, 0, 1, 1, -1};
+  auto tp = std::make_unique<ThreadPool>(&onnxruntime::Env::Default(), thread_options, nullptr, 6, true);
+  for (int rep = 0; rep < 10; rep++) {
+    auto test_data = CreateTestData(1000);
+    ThreadPool::TrySimpleParallelFor(tp.get(), 1000, [&](std::ptrdiff_t i) { IncrementElement(*test_data, i); });
+    ValidateTestData(*test_data);
+  }
+
+  // tasks scheduled from a worker, stolen by the others
+  auto test_data = CreateTestData(100);
+  onnxruntime::Barrier barrier(100);
+  ThreadPool::Schedule(tp.get(), [&]() {
+    for (int i = 0; i < 100; i++) {
+      ThreadPool::ScheduleLocal(tp.get(), [&, i]() {
+        IncrementElement(*test_data, i);
+        barrier.Notify();
+      });
+    }
+  });
+  barrier.Wait();
+  ValidateTestData(*test_data);
+}
+
 #ifdef _WIN32
 #if WINAPI_FAMILY_PARTITION(WINAPI_PARTITION_DESKTOP)
 #pragma warning(push)
@@ -613,6 +644,229 @@ TEST(ThreadPoolTest, TestAffinityStringWellShaped) {
   }
 }
 
+TEST(ThreadPoolTest, TestNumaAware) {
+  OrtThreadPoolParams tp_params;
+  tp_params.thread_pool_size = 4;
+  tp_params.numa_aware = true;
+  auto tp = concurrency::CreateThreadPool(&onnxruntime::Env::Default(),
+                                          tp_params,
+                                          concurrency::ThreadPoolType::INTRA_OP);
+  auto DOP = concurrency::ThreadPool::DegreeOfParallelism(tp.get());
+  ASSERT_TRUE(DOP >= 4 && DOP % 4 == 0);  // for hybrid cpu, dop is a multiple of 4
+
+  auto test_data = CreateTestData(100);
+  ThreadPool::TrySimpleParallelFor(tp.get(), 100, [&](std::ptrdiff_t i) { IncrementElement(*test_data, i); });
+  ValidateTestData(*test_data);
+}
+
+TEST(ThreadPoolTest, TestHeterogeneousScheduling) {
+  OrtThreadPoolParams tp_params;
+  tp_params.thread_pool_size = 4;
+  tp_params.heterogeneous_scheduling = true;
+  auto tp = concurrency::CreateThreadPool(&onnxruntime::Env::Default(), tp_params,
+                                          concurrency::ThreadPoolType::INTRA_OP);
+  for (std::ptrdiff_t total : {1, 7, 100, 1000}) {
+    auto test_data = CreateTestData(static_cast<int>(total));
+    ThreadPool::TryParallelFor(tp.get(), total, TensorOpCost{0, 0, 1000},
+                               [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+                                 for (auto i = first; i < last; ++i) {
+                                   IncrementElement(*test_data, i);
+                                 }
+                               });
+    ValidateTestData(*test_data);
+  }
+}
+
+TEST(ThreadPoolTest, TestAdaptiveSpinning) {
+  OrtThreadPoolParams tp_params;
+  tp_params.thread_pool_size = 4;
+  tp_params.adaptive_spinning = true;
+  auto tp = concurrency::CreateThreadPool(&onnxruntime::Env::Default(), tp_params,
+                                          concurrency::ThreadPoolType::INTRA_OP);
+
+  // back-to-back loops: the spin window covers the gaps between them
+  for (int i = 0; i < 100; ++i) {
+    auto test_data = CreateTestData(100);
+    ThreadPool::TrySimpleParallelFor(tp.get(), 100, [&](std::ptrdiff_t j) { IncrementElement(*test_data, j); });
+    ValidateTestData(*test_data);
+  }
+  constexpr uint64_t max_spin_window_ns = 1000 * 1000;
+  auto stats = tp->GetSpinStatistics();
+  ASSERT_GT(stats.section_interarrival_ns, 0u);
+  ASSERT_LT(stats.section_interarrival_ns, max_spin_window_ns);
+  ASSERT_GT(stats.spin_window_ns, 0u);
+
+  // loops far apart: the workers stop spinning
+  for (int i = 0; i < 30; ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    ThreadPool::TrySimpleParallelFor(tp.get(), 4, [](std::ptrdiff_t) {});
+  }
+  stats = tp->GetSpinStatistics();
+  ASSERT_GT(stats.section_interarrival_ns, max_spin_window_ns);
+  ASSERT_EQ(stats.spin_window_ns, 0u);
+}
+
+#if !defined(ORT_MINIMAL_BUILD)
+TEST(ThreadPoolTest, TestTimelineProfiling) {
+  OrtThreadPoolParams tp_params;
+  tp_params.thread_pool_size = 4;
+  auto tp = concurrency::CreateThreadPool(&onnxruntime::Env::Default(), tp_params,
+                                          concurrency::ThreadPoolType::INTRA_OP);
+
+  ThreadPool::StartTimelineProfiling(tp.get());
+  auto test_data = CreateTestData(100);
+  ThreadPool::TrySimpleParallelFor(tp.get(), 100, [&](std::ptrdiff_t j) { IncrementElement(*test_data, j); });
+  ValidateTestData(*test_data);
+  const auto events = ThreadPool::StopTimelineProfiling(tp.get());
+
+  using Kind = concurrency::ThreadPoolTimelineEvent::Kind;
+  size_t num_loops = 0;
+  size_t num_shards = 0;
+  for (const auto& event : events) {
+    ASSERT_LE(event.start, event.end);
+    if (event.kind == Kind::kParallelLoop) {
+      ++num_loops;
+      EXPECT_GT(event.degree_of_parallelism, 1u);
+      EXPECT_GE(event.imbalance, 1.0);
+    } else if (event.kind == Kind::kShard) {
+      ++num_shards;
+    }
+  }
+  ASSERT_EQ(num_loops, 1u);
+  ASSERT_GE(num_shards, 1u);
+
+  // the loops run while stopped are not recorded
+  ThreadPool::TrySimpleParallelFor(tp.get(), 100, [&](std::ptrdiff_t j) { IncrementElement(*test_data, j); });
+  ThreadPool::StartTimelineProfiling(tp.get());
+  const auto later_events = ThreadPool::StopTimelineProfiling(tp.get());
+  ASSERT_TRUE(std::none_of(later_events.begin(), later_events.end(),
+                           [](const auto& event) { return event.kind == Kind::kParallelLoop; }));
+}
+#endif
+
+TEST(ThreadPoolTest, TestWorkClassMaxDegreeOfParallelism) {
+  auto tp = std::make_unique<ThreadPool>(&onnxruntime::Env::Default(), onnxruntime::ThreadOptions{}, nullptr, 4, true);
+  std::set<std::thread::id> thread_ids;
+  onnxruntime::OrtMutex mutex;
+  {
+    ThreadPool::WorkClassScope scope({ThreadPool::WorkPriority::kNormal, 2});
+    ThreadPool::TrySimpleParallelFor(tp.get(), 100, [&](std::ptrdiff_t) {
+      std::this_thread::sleep_for(std::chrono::microseconds(100));
+      std::lock_guard<onnxruntime::OrtMutex> lock(mutex);
+      thread_ids.insert(std::this_thread::get_id());
+    });
+  }
+  ASSERT_LE(thread_ids.size(), 2u);
+  ASSERT_EQ(ThreadPool::CurrentWorkClass().max_degree_of_parallelism, 0);
+}
+
+TEST(ThreadPoolTest, TestWorkClassBatchYieldsToInteractive) {
+  auto tp = std::make_unique<ThreadPool>(&onnxruntime::Env::Default(), onnxruntime::ThreadOptions{}, nullptr, 2, true);
+  const std::ptrdiff_t dop = ThreadPool::DegreeOfParallelism(tp.get());
+  std::atomic<bool> started{false};
+  std::atomic<bool> release{false};
+
+  // an interactive loop that occupies every thread of the pool until released
+  std::thread interactive([&]() {
+    ThreadPool::WorkClassScope scope({ThreadPool::WorkPriority::kInteractive, 0});
+    ThreadPool::TrySimpleParallelFor(tp.get(), dop, [&](std::ptrdiff_t) {
+      started = true;
+      while (!release) {
+        std::this_thread::yield();
+      }
+    });
+  });
+  while (!started) {
+    std::this_thread::yield();
+  }
+
+  std::set<std::thread::id> thread_ids;
+  onnxruntime::OrtMutex mutex;
+  {
+    ThreadPool::WorkClassScope scope({ThreadPool::WorkPriority::kBatch, 0});
+    ThreadPool::TrySimpleParallelFor(tp.get(), 100, [&](std::ptrdiff_t) {
+      std::lock_guard<onnxruntime::OrtMutex> lock(mutex);
+      thread_ids.insert(std::this_thread::get_id());
+    });
+  }
+  release = true;
+  interactive.join();
+
+  ASSERT_EQ(thread_ids.size(), 1u);
+  ASSERT_EQ(*thread_ids.begin(), std::this_thread::get_id());
+}
+
+TEST(ThreadPoolTest, TestWorkClassPassedToScheduledTasks) {
+  auto tp = std::make_unique<ThreadPool>(&onnxruntime::Env::Default(), onnxruntime::ThreadOptions{}, nullptr, 2, true);
+  std::atomic<int> priority{-1};
+  onnxruntime::Barrier barrier(1);
+  {
+    ThreadPool::WorkClassScope scope({ThreadPool::WorkPriority::kBatch, 0});
+    ThreadPool::Schedule(tp.get(), [&]() {
+      priority = static_cast<int>(ThreadPool::CurrentWorkClass().priority);
+      barrier.Notify();
+    });
+  }
+  barrier.Wait();
+  ASSERT_EQ(priority, static_cast<int>(ThreadPool::WorkPriority::kBatch));
+}
+
+#ifndef ORT_NO_RTTI
+TEST(ThreadPoolTest, TestParallelForCalibrationChoosesFastest) {
+  ParallelForCalibration calibration(ORT_TSTR(""));
+  const std::type_info& site = typeid(int);
+  // every candidate is measured first, 4 shards are the fastest
+  for (int i = 0; i < 100; ++i) {
+    int shards = calibration.ChooseShards(site, 1000, 8);
+    auto elapsed = std::chrono::microseconds(shards == 4 ? 10 : 100);
+    calibration.Record(site, 1000, 8, shards, elapsed);
+  }
+  int chosen = 0;
+  for (int i = 0; i < 10; ++i) {
+    chosen += calibration.ChooseShards(site, 1000, 8) == 4 ? 1 : 0;
+  }
+  ASSERT_GE(chosen, 9);
+  // other loop sizes are measured separately
+  ASSERT_EQ(calibration.ChooseShards(site, 100000, 8), 1);
+}
+
+TEST(ThreadPoolTest, TestParallelForCalibration) {
+  const std::filesystem::path file = "parallel_for_calibration_test.txt";
+  std::filesystem::remove(file);
+
+  auto run = [&]() {
+    OrtThreadPoolParams tp_params;
+    tp_params.thread_pool_size = 4;
+    tp_params.parallel_for_calibration = true;
+    tp_params.parallel_for_calibration_file = file.native();
+    auto tp = concurrency::CreateThreadPool(&onnxruntime::Env::Default(), tp_params,
+                                            concurrency::ThreadPoolType::INTRA_OP);
+    for (int i = 0; i < 50; ++i) {
+      auto test_data = CreateTestData(1000);
+      ThreadPool::TryParallelFor(tp.get(), 1000, TensorOpCost{0, 0, 100},
+                                 [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+                                   for (auto j = first; j < last; ++j) {
+                                     IncrementElement(*test_data, j);
+                                   }
+                                 });
+      ValidateTestData(*test_data);
+    }
+  };
+
+  run();
+  ASSERT_TRUE(std::filesystem::exists(file));
+  std::ifstream saved(file);
+  std::string header;
+  std::string entry;
+  ASSERT_TRUE(std::getline(saved, header) && std::getline(saved, entry));
+  saved.close();
+
+  // the second run starts from the saved measurements
+  run();
+  std::filesystem::remove(file);
+}
+#endif
+
 #ifdef _WIN32
 TEST(ThreadPoolTest, TestDefaultAffinity) {
   test::CpuGroup cpu_group = {{0, 1},
@@ -278,6 +278,31 @@ void BaseTester::AddSparseCsrTensorStrings(std::vector<Data>& data,
   NodeArg node_arg = MakeSparseNodeArg(dtype, name, dims, dim_params);
   AddSparseTensorData(data, std::move(node_arg), std::move(p_tensor), ValidateOutputParams());
 }
+
+void BaseTester::AddSparseBlockSparseTensorData(std::vector<Data>& data,
+                                                MLDataType data_type,
+                                                const char* name,
+                                                gsl::span<const int64_t> dims,
+                                                gsl::span<const gsl::byte> values,
+                                                gsl::span<const int64_t> values_shape,
+                                                gsl::span<const int32_t> indices,
+                                                const ValidateOutputParams& check_params,
+                                                const std::vector<std::string>* dim_params) {
+  const auto dtype = data_type->AsPrimitiveDataType()->GetDataType();
+  ORT_ENFORCE(dims.size() == 2U, "Expecting a 2-D dense shape");
+  const TensorShape values_tensor_shape(values_shape);
+  ORT_ENFORCE(static_cast<size_t>(values_tensor_shape.Size()) * data_type->Size() == values.size_bytes(),
+              "Expecting the values to match values_shape");
+  const TensorShape indices_shape = indices.empty() ? TensorShape{0}
+                                                    : TensorShape{2, static_cast<int64_t>(indices.size() / 2)};
+  auto p_tensor = MakeSparseTensor(data_type, dims);
+  auto mutator = p_tensor->MakeBlockSparseData(values_tensor_shape, indices_shape);
+  CopyDataToTensor(values, mutator.Values());
+  CopyDataToTensor(gsl::as_bytes(indices), mutator.Indices());
+
+  NodeArg node_arg = MakeSparseNodeArg(dtype, name, dims, dim_params);
+  AddSparseTensorData(data, std::move(node_arg), std::move(p_tensor), check_params);
+}
 #endif  // !defined(DISABLE_SPARSE_TENSORS)
 
 template <class SessionType>
@@ -203,6 +203,21 @@ class BaseTester {
                               gsl::make_span(outer_indices),
                               dim_params);
   }
+
+  // values_shape is (num_blocks, block_size, block_size), indices holds the block rows followed by the block columns
+  template <typename T>
+  void AddSparseBlockSparseInput(const char* name, const std::vector<int64_t>& dims,
+                                 const std::vector<T>& values,
+                                 const std::vector<int64_t>& values_shape,
+                                 const std::vector<int32_t>& indices,
+                                 const std::vector<std::string>* dim_params = nullptr) {
+    auto ml_type = DataTypeImpl::GetType<T>();
+    AddSparseBlockSparseTensorData(input_data_, ml_type, name, dims,
+                                   gsl::as_bytes(gsl::make_span(values)),
+                                   gsl::make_span(values_shape),
+                                   gsl::make_span(indices),
+                                   ValidateOutputParams(), dim_params);
+  }
 #endif
 
   // Add other registered types, possibly experimental
@@ -877,6 +892,16 @@ class BaseTester {
                               const ValidateOutputParams& check_params,
                               const std::vector<std::string>* dim_params = nullptr);
 
+  void AddSparseBlockSparseTensorData(std::vector<Data>& data,
+                                      MLDataType data_type,
+                                      const char* name,
+                                      gsl::span<const int64_t> dims,
+                                      gsl::span<const gsl::byte> values,
+                                      gsl::span<const int64_t> values_shape,
+                                      gsl::span<const int32_t> indices,
+                                      const ValidateOutputParams& check_params,
+                                      const std::vector<std::string>* dim_params = nullptr);
+
   void AddSparseCsrTensorStrings(std::vector<Data>& data,
                                  const char* name,
                                  gsl::span<const int64_t> dims,
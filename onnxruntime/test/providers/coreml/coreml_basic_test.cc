@@ -136,6 +136,30 @@ TEST(CoreMLExecutionProviderTest, ArgMaxCastTest) {
 #endif
 }
 
+#if defined(__APPLE__)
+// The first session compiles the model and stores it in the cache, the second one loads the cached compiled model.
+// Both must produce the same outputs as the CPU EP.
+TEST(CoreMLExecutionProviderTest, CompiledModelCacheTest) {
+  const ORTCHAR_T* model_file_name = ORT_TSTR("testdata/coreml_argmax_cast_test.onnx");
+
+  std::vector<int64_t> dims_mul_x = {3, 2, 2};
+  std::vector<float> values_mul_x = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f, 9.0f, 10.0f, 11.0f, 12.0f};
+  OrtValue ml_value_x;
+  AllocatorPtr allocator = std::make_shared<CPUAllocator>();
+  CreateMLValue<float>(allocator, dims_mul_x, values_mul_x, &ml_value_x);
+
+  NameMLValMap feeds;
+  feeds.insert(std::make_pair("X", ml_value_x));
+
+  for (int i = 0; i < 2; i++) {
+    RunAndVerifyOutputsWithEP(model_file_name, "CoreMLExecutionProviderTest.CompiledModelCacheTest",
+                              std::make_unique<CoreMLExecutionProvider>(s_coreml_flags |
+                                                                        COREML_FLAG_ENABLE_COMPILED_MODEL_CACHE),
+                              feeds);
+  }
+}
+#endif  // __APPLE__
+
 #endif  // !(ORT_MINIMAL_BUILD)
 
 TEST(CoreMLExecutionProviderTest, TestOrtFormatModel) {
@@ -135,7 +135,7 @@ TEST_F(ActivationOpTest, Relu) {
 #endif  // MLAS_F16VEC_INTRINSICS_SUPPORTED
 }
 
-#if defined(USE_CUDA) || defined(USE_ROCM)
+#if defined(USE_CUDA) || defined(USE_ROCM) || defined(MLAS_F16VEC_INTRINSICS_SUPPORTED)
 TEST_F(ActivationOpTest, Sigmoid_fp16) {
 #ifdef USE_CUDA
   int min_cuda_architecture = 530;
@@ -429,6 +429,30 @@ TEST_F(ActivationOpTest, LeakyRelu_fp16) {
   test.AddOutput<MLFloat16>("Y", dims, bf_Y);
   test.Run();
 }
+
+TEST_F(ActivationOpTest, HardSigmoid_fp16) {
+  OpTester test("HardSigmoid", 6);
+  float alpha = 0.2f;
+  float beta = 0.5f;
+  auto formula = [alpha, beta](float x) { return std::max(std::min((alpha * x + beta), 1.0f), 0.0f); };
+
+  std::vector<float> X = input_values.front();
+  std::vector<float> Y;
+  for (unsigned i = 0; i < X.size(); i++)
+    Y.push_back(formula(X[i]));
+  std::vector<int64_t> dims{(int64_t)X.size()};
+
+  std::vector<MLFloat16> bf_X(X.size());
+  ConvertFloatToMLFloat16(X.data(), bf_X.data(), (int)X.size());
+  std::vector<MLFloat16> bf_Y(Y.size());
+  ConvertFloatToMLFloat16(Y.data(), bf_Y.data(), (int)Y.size());
+
+  test.AddAttribute("alpha", alpha);
+  test.AddAttribute("beta", beta);
+  test.AddInput<MLFloat16>("X", dims, bf_X);
+  test.AddOutput<MLFloat16>("Y", dims, bf_Y);
+  test.Run();
+}
 #endif  // MLAS_F16VEC_INTRINSICS_SUPPORTED
 
 TEST_F(ActivationOpTest, ThresholdedRelu) {
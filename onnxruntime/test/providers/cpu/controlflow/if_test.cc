@@ -8,7 +8,9 @@
 #include "core/providers/cpu/controlflow/if.h"
 #include "test/providers/provider_test_utils.h"
 #include "core/session/inference_session.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 
+#include "test/util/include/asserts.h"
 #include "test/util/include/default_providers.h"
 
 using namespace ONNX_NAMESPACE;
@@ -22,6 +24,7 @@ struct RunOptions {
   int symbolic_dim_value_in_main_graph = -1;
   bool include_dim_values_in_subgraph = true;
   bool mixed_execution_providers = false;
+  bool lazy_subgraph_initialization = false;
 };
 }  // namespace
 
@@ -253,6 +256,11 @@ void RunTest(bool condition_value,
     execution_providers.push_back(DefaultCpuExecutionProvider());
 
     test.Run(expect_result, failure_message, excluded_providers, nullptr, &execution_providers);
+  } else if (options.lazy_subgraph_initialization) {
+    SessionOptions session_options;
+    ASSERT_STATUS_OK(session_options.config_options.AddConfigEntry(kOrtSessionOptionsConfigLazySubgraphInitialization,
+                                                                   "1"));
+    test.Run(session_options, expect_result, failure_message, excluded_providers);
   } else {
     test.Run(expect_result, failure_message, excluded_providers);
   }
@@ -290,6 +298,20 @@ TEST(If, NoShapeInMainGraph_ShapeInSubgraph_False) {
   RunTest(false, options, false);
 }
 
+TEST(If, LazySubgraphInitialization_True) {
+  RunOptions options{};
+  options.lazy_subgraph_initialization = true;
+
+  RunTest(true, options);
+}
+
+TEST(If, LazySubgraphInitialization_False) {
+  RunOptions options{};
+  options.lazy_subgraph_initialization = true;
+
+  RunTest(false, options);
+}
+
 #ifdef USE_CUDA
 TEST(If, MixedExecutionProviders) {
   RunOptions options{};
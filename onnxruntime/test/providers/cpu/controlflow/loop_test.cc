@@ -1038,6 +1038,74 @@ TEST(Loop, IterationCountAsOutput) {
   test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
 }
 
+// loop carried vars that keep their shape are written to alternating buffers. check the values are correct over
+// several iterations, including for a var whose input is also a scan output and so can't be double buffered.
+TEST(Loop, DoubleBufferedLoopCarriedVars) {
+  auto create_subgraph = []() {
+    Model model("Double buffered loop carried vars", false, DefaultLoggingManager().DefaultLogger());
+    auto& graph = model.MainGraph();
+
+    /* Inputs: iter_num, cond_in, loop carried state variables.
+
+         cond_in    a_in    b_in --------
+            |        |       |          |
+       [Identity]  [Add]   [Add]   [Identity]
+            |        |       |          |
+         cond_out  a_out   b_out      b_seen
+    */
+
+    TypeProto int64_scalar;
+    int64_scalar.mutable_tensor_type()->set_elem_type(TensorProto_DataType_INT64);
+    int64_scalar.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+
+    TypeProto bool_scalar;
+    bool_scalar.mutable_tensor_type()->set_elem_type(TensorProto_DataType_BOOL);
+    bool_scalar.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+
+    TypeProto float_tensor;
+    float_tensor.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+    float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+
+    auto& iter_num_in = graph.GetOrCreateNodeArg("iter_num_in", &int64_scalar);
+    auto& cond_in = graph.GetOrCreateNodeArg("cond_in", &bool_scalar);
+    auto& a_in = graph.GetOrCreateNodeArg("a_in", &float_tensor);
+    auto& b_in = graph.GetOrCreateNodeArg("b_in", &float_tensor);
+
+    auto& cond_out = graph.GetOrCreateNodeArg("cond_out", &bool_scalar);
+    auto& a_out = graph.GetOrCreateNodeArg("a_out", &float_tensor);
+    auto& b_out = graph.GetOrCreateNodeArg("b_out", &float_tensor);
+    auto& b_seen = graph.GetOrCreateNodeArg("b_seen", &float_tensor);
+
+    graph.AddNode("cond_identity", "Identity", "Forward cond_in to cond_out", {&cond_in}, {&cond_out});
+    graph.AddNode("a_add", "Add", "Double a", {&a_in, &a_in}, {&a_out});
+    graph.AddNode("b_add", "Add", "Double b", {&b_in, &b_in}, {&b_out});
+    graph.AddNode("b_identity", "Identity", "Forward b_in to b_seen", {&b_in}, {&b_seen});
+
+    graph.SetInputs({&iter_num_in, &cond_in, &a_in, &b_in});
+    graph.SetOutputs({&cond_out, &a_out, &b_out, &b_seen});
+
+    auto status = graph.Resolve();
+    EXPECT_EQ(status, Status::OK());
+
+    return graph.ToGraphProto();
+  };
+
+  OpTester test("Loop", 11);
+  auto body = create_subgraph();
+  test.AddAttribute<GraphProto>("body", body);
+  test.AddInput<int64_t>("M", {1}, {4});
+  test.AddInput<bool>("cond", {1}, {true});
+  test.AddInput<float>("a", {2}, {1.f, 2.f});
+  test.AddInput<float>("b", {2}, {1.f, 1.f});
+
+  test.AddOutput<float>("a_final", {2}, {16.f, 32.f});
+  test.AddOutput<float>("b_final", {2}, {16.f, 16.f});
+  test.AddOutput<float>("b_seen_final", {4, 2}, {1.f, 1.f, 2.f, 2.f, 4.f, 4.f, 8.f, 8.f});
+
+  // Disable TensorRT on unsupported data type BOOL
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
+}
+
 #ifdef USE_CUDA
 // test that when part of the subgraph run on CUDA it executes successfully
 TEST(Loop, MixedExecutionProviders) {
@@ -6,6 +6,7 @@
 #include "test/common/cuda_op_test_utils.h"
 #include "core/framework/data_types.h"
 #include "core/util/math.h"
+#include "core/providers/cpu/math/einsum_utils/einsum_contraction_planner.h"
 
 namespace onnxruntime {
 namespace test {
@@ -1138,5 +1139,67 @@ TEST(Einsum, EinsumTransposeMatMulThreeInputsTestSuite) {
 
 }  // namespace test
 
+// Theme: Contraction order of more than two operands
+
+TEST(Einsum, ContractionOrderPlanning) {
+  // A matrix-matrix-vector product is cheaper right to left
+  const std::vector<std::vector<int64_t>> dims{{4, 64, 1}, {1, 64, 64}, {1, 1, 64}};
+  const std::vector<bool> in_output{true, false, false};
+  const EinsumOp::ContractionPath path = EinsumOp::PlanContractionOrder(dims, in_output);
+  ASSERT_EQ(path.size(), 2u);
+  EXPECT_EQ(path[0], std::make_pair(size_t{1}, size_t{2}));
+  EXPECT_EQ(path[1], std::make_pair(size_t{0}, size_t{1}));
+
+  // Operands of equal size are contracted left to right
+  const std::vector<std::vector<int64_t>> equal_dims{{2, 2, 1}, {1, 2, 2}, {2, 1, 2}};
+  const EinsumOp::ContractionPath equal_path =
+      EinsumOp::PlanContractionOrder(equal_dims, std::vector<bool>{false, false, false});
+  ASSERT_EQ(equal_path.size(), 2u);
+  EXPECT_EQ(equal_path[0], std::make_pair(size_t{0}, size_t{1}));
+  EXPECT_EQ(equal_path[1], std::make_pair(size_t{0}, size_t{1}));
+}
+
+// Multiplies a chain of matrices with the given dims, which the planner contracts out of order
+static void TestMatrixChain(const std::string& equation, const std::vector<int64_t>& chain_dims) {
+  OpTester test("Einsum", 12, onnxruntime::kOnnxDomain);
+  test.AddAttribute<std::string>("equation", equation);
+
+  std::vector<float> product;
+  for (size_t m = 0; m + 1 < chain_dims.size(); ++m) {
+    const int64_t rows = chain_dims[m];
+    const int64_t cols = chain_dims[m + 1];
+    std::vector<float> matrix(static_cast<size_t>(rows * cols));
+    for (size_t i = 0; i < matrix.size(); ++i) {
+      matrix[i] = static_cast<float>((i + m) % 3) - 1.0f;
+    }
+    test.AddInput<float>(("x" + std::to_string(m)).c_str(), {rows, cols}, matrix);
+
+    if (m == 0) {
+      product = matrix;
+      continue;
+    }
+    std::vector<float> next(static_cast<size_t>(chain_dims[0] * cols), 0.0f);
+    for (int64_t i = 0; i < chain_dims[0]; ++i) {
+      for (int64_t k = 0; k < rows; ++k) {
+        for (int64_t j = 0; j < cols; ++j) {
+          next[i * cols + j] += product[i * rows + k] * matrix[k * cols + j];
+        }
+      }
+    }
+    product = std::move(next);
+  }
+
+  test.AddOutput<float>("o", {chain_dims.front(), chain_dims.back()}, product);
+  test.Run();
+}
+
+TEST(Einsum, ExplicitEinsumAsMatrixChain) {
+  // Searched for the cheapest order
+  TestMatrixChain("ij,jk,kl->il", {3, 40, 40, 1});
+  TestMatrixChain("ab,bc,cd,de->ae", {2, 30, 5, 30, 2});
+  // Contracted greedily
+  TestMatrixChain("ab,bc,cd,de,ef,fg->ag", {2, 5, 30, 4, 2, 30, 3});
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -6,8 +6,11 @@
 #include "test/util/include/default_providers.h"
 #include "test/common/dnnl_op_test_utils.h"
 #include "core/util/math.h"
+#include "core/mlas/inc/mlas.h"
 #include <algorithm>
+#include <functional>
 #include <math.h>
+#include <numeric>
 
 namespace onnxruntime {
 namespace test {
@@ -443,6 +446,44 @@ TEST(MathOpTest, Add_Broadcast_2x1x1_3x4) {
 #endif
 }
 
+// A few large spans, [1, C, H, W] + [1, C, 1, 1], and many small ones, [N, H, 1] + [1, 1, W], whose partitions across
+// threads start and end within spans.
+TEST(MathOpTest, Add_Broadcast_Partitioned_Spans) {
+  auto run = [](const std::vector<int64_t>& a_dims, const std::vector<int64_t>& b_dims,
+                const std::vector<int64_t>& c_dims) {
+    auto size = [](const std::vector<int64_t>& dims) {
+      return static_cast<size_t>(std::accumulate(dims.begin(), dims.end(), int64_t{1}, std::multiplies<int64_t>()));
+    };
+    std::vector<float> a(size(a_dims)), b(size(b_dims)), c(size(c_dims));
+    for (size_t i = 0; i < a.size(); ++i) a[i] = static_cast<float>(i % 97);
+    for (size_t i = 0; i < b.size(); ++i) b[i] = static_cast<float>(1000 * (i + 1));
+
+    // c[i] = a[index of i in a] + b[index of i in b], with broadcast dimensions of size 1 indexed at 0
+    for (size_t i = 0; i < c.size(); ++i) {
+      size_t a_index = 0, b_index = 0, rest = i, c_stride = c.size();
+      for (size_t d = 0; d < c_dims.size(); ++d) {
+        c_stride /= static_cast<size_t>(c_dims[d]);
+        const size_t coord = rest / c_stride;
+        rest %= c_stride;
+        a_index = a_index * static_cast<size_t>(a_dims[d]) + (a_dims[d] == 1 ? 0 : coord);
+        b_index = b_index * static_cast<size_t>(b_dims[d]) + (b_dims[d] == 1 ? 0 : coord);
+      }
+      c[i] = a[a_index] + b[b_index];
+    }
+
+    OpTester test("Add");
+    test.AddInput<float>("A", a_dims, a);
+    test.AddInput<float>("B", b_dims, b);
+    test.AddOutput<float>("C", c_dims, c);
+    test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
+  };
+
+  run({1, 3, 67, 129}, {1, 3, 1, 1}, {1, 3, 67, 129});
+  run({1, 3, 1, 1}, {1, 3, 67, 129}, {1, 3, 67, 129});
+  run({5, 301, 1}, {1, 1, 7}, {5, 301, 7});
+  run({2, 3, 40, 50}, {1, 3, 40, 1}, {2, 3, 40, 50});
+}
+
 // Validate runtime failure has useful error message when ORT_ENFORCE is used
 TEST(MathOpTest, Add_Invalid_Broadcast) {
   OpTester test("Add");
@@ -612,6 +653,62 @@ TEST(MathOpTest, Div) {
 #endif
 }
 
+#ifdef MLAS_F16VEC_INTRINSICS_SUPPORTED
+// The CPU fp16 kernels process 8 and then 4 lanes at a time, so use lengths
+// that leave a partial tail and cover each side being broadcast.
+template <typename Op>
+static void TestFloat16Cpu(const char* op_name, Op op) {
+  constexpr int64_t length = 19;
+  std::vector<float> lhs(length), rhs(length);
+  for (int64_t i = 0; i < length; i++) {
+    lhs[i] = static_cast<float>(i - 9) * 0.5f;
+    rhs[i] = static_cast<float>(i % 5) + 1.0f;
+  }
+  const float scalar = 2.0f;
+
+  auto make_half = [](const std::vector<float>& values) {
+    std::vector<MLFloat16> output(values.size());
+    ConvertFloatToMLFloat16(values.data(), output.data(), values.size());
+    return output;
+  };
+
+  auto run = [&](const std::vector<int64_t>& lhs_dim, const std::vector<float>& lhs_values,
+                 const std::vector<int64_t>& rhs_dim, const std::vector<float>& rhs_values) {
+    const size_t count = std::max(lhs_values.size(), rhs_values.size());
+    std::vector<float> out_values(count);
+    for (size_t i = 0; i < count; i++) {
+      out_values[i] = op(lhs_values[lhs_values.size() == 1 ? 0 : i], rhs_values[rhs_values.size() == 1 ? 0 : i]);
+    }
+
+    OpTester test(op_name, 14);
+    test.AddInput<MLFloat16>("A", lhs_dim, make_half(lhs_values));
+    test.AddInput<MLFloat16>("B", rhs_dim, make_half(rhs_values));
+    test.AddOutput<MLFloat16>("C", {static_cast<int64_t>(count)}, make_half(out_values));
+    test.Run();
+  };
+
+  run({length}, lhs, {length}, rhs);
+  run({1}, {scalar}, {length}, rhs);
+  run({length}, lhs, {1}, {scalar});
+}
+
+TEST(MathOpTest, Add_fp16_Cpu) {
+  TestFloat16Cpu("Add", [](float a, float b) { return a + b; });
+}
+
+TEST(MathOpTest, Sub_fp16_Cpu) {
+  TestFloat16Cpu("Sub", [](float a, float b) { return a - b; });
+}
+
+TEST(MathOpTest, Mul_fp16_Cpu) {
+  TestFloat16Cpu("Mul", [](float a, float b) { return a * b; });
+}
+
+TEST(MathOpTest, Div_fp16_Cpu) {
+  TestFloat16Cpu("Div", [](float a, float b) { return a / b; });
+}
+#endif  // MLAS_F16VEC_INTRINSICS_SUPPORTED
+
 TEST(MathOpTest, Abs) {
   OpTester test("Abs");
   std::vector<int64_t> dims{2, 2};
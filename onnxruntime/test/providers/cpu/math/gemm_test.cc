@@ -4,6 +4,7 @@
 #include "gtest/gtest.h"
 #include "core/mlas/inc/mlas.h"
 #include "core/framework/run_options.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 #include "test/common/cuda_op_test_utils.h"
 #include "test/providers/provider_test_utils.h"
 #include "test/common/dnnl_op_test_utils.h"
@@ -750,6 +751,78 @@ TEST(GemmOpTest, SharedPrepackedWeights) {
               static_cast<size_t>(number_of_shared_pre_packed_weights_counter));
   }
 }
+
+// B values in [-8, 7] are quantized exactly to int4, and with a small error to int8.
+static void RunGemmWeightQuantizationTest(const char* quantization, bool bias_is_vector, float abs_error) {
+  constexpr int64_t M = 5, K = 64, N = 16;
+  constexpr float alpha = 0.5f;
+  const float beta = bias_is_vector ? 1.0f : 2.0f;
+
+  std::vector<float> a_values(M * K);
+  for (size_t i = 0; i < a_values.size(); i++) {
+    a_values[i] = static_cast<float>(static_cast<int64_t>((i / K) * 13 + (i % K) * 7) % 17 - 8) * 0.25f;
+  }
+  // B is transposed, (N, K)
+  std::vector<float> b_values(N * K);
+  for (int64_t n = 0; n < N; n++) {
+    for (int64_t k = 0; k < K; k++) {
+      b_values[n * K + k] = static_cast<float>((k * 7 + n * 3) % 16 - 8);
+    }
+  }
+  std::vector<float> c_values(bias_is_vector ? N : M * N);
+  for (size_t i = 0; i < c_values.size(); i++) {
+    c_values[i] = static_cast<float>(i % 5) - 2.0f;
+  }
+  std::vector<float> y_values(M * N);
+  for (int64_t m = 0; m < M; m++) {
+    for (int64_t n = 0; n < N; n++) {
+      float sum = 0.0f;
+      for (int64_t k = 0; k < K; k++) {
+        sum += a_values[m * K + k] * b_values[n * K + k];
+      }
+      y_values[m * N + n] = alpha * sum + beta * c_values[bias_is_vector ? n : m * N + n];
+    }
+  }
+
+  OpTester test("Gemm", 13);
+  test.AddAttribute("transA", (int64_t)0);
+  test.AddAttribute("transB", (int64_t)1);
+  test.AddAttribute("alpha", alpha);
+  test.AddAttribute("beta", beta);
+  test.AddInput<float>("A", {M, K}, a_values);
+  test.AddInput<float>("B", {N, K}, b_values, true);
+  if (bias_is_vector) {
+    test.AddInput<float>("C", {N}, c_values);
+  } else {
+    test.AddInput<float>("C", {M, N}, c_values);
+  }
+  test.AddOutput<float>("Y", {M, N}, y_values);
+  test.SetOutputAbsErr("Y", abs_error);
+
+  SessionOptions so;
+  ASSERT_EQ(so.config_options.AddConfigEntry(kOrtSessionOptionsMatMulWeightQuantization, quantization), Status::OK());
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+
+  size_t number_of_pre_packed_weights_counter = 0;
+  size_t number_of_shared_pre_packed_weights_counter = 0;
+  test.Config(so)
+      .ConfigEps(std::move(execution_providers))
+      .RunWithConfig(&number_of_pre_packed_weights_counter, &number_of_shared_pre_packed_weights_counter);
+  ASSERT_EQ(number_of_pre_packed_weights_counter, static_cast<size_t>(1));
+}
+
+TEST(GemmOpTest, WeightQuantizationInt8) {
+  RunGemmWeightQuantizationTest("int8", true, 0.5f);
+  RunGemmWeightQuantizationTest("int8", false, 0.5f);
+}
+
+TEST(GemmOpTest, WeightQuantizationInt4) {
+  RunGemmWeightQuantizationTest("int4", true, 1e-3f);
+  RunGemmWeightQuantizationTest("int4", false, 1e-3f);
+}
+
 #endif
 
 }  // namespace test
@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "gtest/gtest.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 #include "test/providers/provider_test_utils.h"
 #include "test/providers/run_options_config_keys.h"
 #include "test/common/dnnl_op_test_utils.h"
@@ -276,7 +277,12 @@ TEST(MathOpTest, MatMul_bfloat16) {
   std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
   test.Config(run_with_tunable_op);
 #ifdef USE_CUDA
-  execution_providers.emplace_back(DefaultCudaExecutionProvider());
+  execution_providers.emplace_back(DefaultCudaExecutionProvider(/*test_tunable_op=*/true));
+  test.ConfigEps(std::move(execution_providers))
+      .RunWithConfig();
+
+  execution_providers.clear();
+  execution_providers.emplace_back(DefaultCudaExecutionProvider(/*test_tunable_op=*/false));
 #elif USE_ROCM
   execution_providers.emplace_back(DefaultRocmExecutionProvider(/*test_tunable_op=*/true));
   test.ConfigEps(std::move(execution_providers))
@@ -370,6 +376,58 @@ TEST(MathOpTest, MatMulSharedPrepackedWeights) {
   }
 }
 
+
+// B values in [-8, 7] are quantized exactly to int4, and with a small error to int8.
+static void RunMatMulWeightQuantizationTest(const char* quantization, float abs_error) {
+  constexpr int64_t batch = 2, M = 3, K = 64, N = 16;
+
+  std::vector<float> a_values(batch * M * K);
+  for (size_t i = 0; i < a_values.size(); i++) {
+    a_values[i] = static_cast<float>(static_cast<int64_t>((i / K) * 13 + (i % K) * 7) % 17 - 8) * 0.25f;
+  }
+  std::vector<float> b_values(K * N);
+  for (int64_t k = 0; k < K; k++) {
+    for (int64_t n = 0; n < N; n++) {
+      b_values[k * N + n] = static_cast<float>((k * 7 + n * 3) % 16 - 8);
+    }
+  }
+  std::vector<float> y_values(batch * M * N, 0.0f);
+  for (int64_t m = 0; m < batch * M; m++) {
+    for (int64_t n = 0; n < N; n++) {
+      for (int64_t k = 0; k < K; k++) {
+        y_values[m * N + n] += a_values[m * K + k] * b_values[k * N + n];
+      }
+    }
+  }
+
+  OpTester test("MatMul", 13);
+  test.AddInput<float>("A", {batch, M, K}, a_values);
+  test.AddInput<float>("B", {K, N}, b_values, true);
+  test.AddOutput<float>("Y", {batch, M, N}, y_values);
+  test.SetOutputAbsErr("Y", abs_error);
+
+  SessionOptions so;
+  ASSERT_EQ(so.config_options.AddConfigEntry(kOrtSessionOptionsMatMulWeightQuantization, quantization), Status::OK());
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+
+  size_t number_of_pre_packed_weights_counter = 0;
+  size_t number_of_shared_pre_packed_weights_counter = 0;
+  test.Config(so)
+      .ConfigEps(std::move(execution_providers))
+      .RunWithConfig(&number_of_pre_packed_weights_counter, &number_of_shared_pre_packed_weights_counter);
+  ASSERT_EQ(number_of_pre_packed_weights_counter, static_cast<size_t>(1));
+}
+
+TEST(MathOpTest, MatMulWeightQuantizationInt8) {
+  RunMatMulWeightQuantizationTest("int8", 0.5f);
+}
+
+TEST(MathOpTest, MatMulWeightQuantizationInt4) {
+  RunMatMulWeightQuantizationTest("int4", 1e-3f);
+}
+
 #endif
 
 }  // namespace test
@@ -6,6 +6,7 @@
 #include "gtest/gtest.h"
 
 #include "core/session/environment.h"
+#include "core/mlas/inc/mlas.h"
 #include "test/providers/provider_test_utils.h"
 #include "test/common/cuda_op_test_utils.h"
 #include "test/common/dnnl_op_test_utils.h"
@@ -49,7 +50,7 @@ TEST(SoftmaxOperator, Simple) {
   RunTest(x_vals, expected_vals, dimensions);
 }
 
-#if defined(USE_CUDA) || defined(USE_ROCM)
+#if defined(USE_CUDA) || defined(USE_ROCM) || defined(MLAS_F16VEC_INTRINSICS_SUPPORTED)
 TEST(SoftmaxOperator, Simple_fp16) {
 #ifdef USE_CUDA
   int min_cuda_architecture = 530;
@@ -78,6 +79,44 @@ TEST(SoftmaxOperator, Simple_fp16) {
 }
 #endif
 
+#ifdef MLAS_F16VEC_INTRINSICS_SUPPORTED
+TEST(SoftmaxOperator, LongRows_fp16) {
+  // Rows longer than the 8 lane vectors so that the CPU fp16 kernel handles a partial tail.
+  constexpr int64_t N = 3;
+  constexpr int64_t D = 21;
+  std::vector<float> X(N * D);
+  for (size_t i = 0; i < X.size(); i++) {
+    X[i] = static_cast<float>(static_cast<int>(i % 11) - 5) * 0.25f;
+  }
+
+  for (bool log_softmax : {false, true}) {
+    std::vector<float> Y(N * D);
+    for (int64_t n = 0; n < N; n++) {
+      const float* x = X.data() + n * D;
+      float* y = Y.data() + n * D;
+      const float max = *std::max_element(x, x + D);
+      float sum = 0.0f;
+      for (int64_t d = 0; d < D; d++) {
+        sum += std::exp(x[d] - max);
+      }
+      for (int64_t d = 0; d < D; d++) {
+        y[d] = log_softmax ? x[d] - max - std::log(sum) : std::exp(x[d] - max) / sum;
+      }
+    }
+
+    OpTester test(log_softmax ? "LogSoftmax" : "Softmax", 13);
+    std::vector<MLFloat16> f_X(X.size());
+    std::vector<MLFloat16> f_Y(Y.size());
+    ConvertFloatToMLFloat16(X.data(), f_X.data(), X.size());
+    ConvertFloatToMLFloat16(Y.data(), f_Y.data(), Y.size());
+
+    test.AddInput<MLFloat16>("X", {N, D}, f_X);
+    test.AddOutput<MLFloat16>("Y", {N, D}, f_Y);
+    test.Run();
+  }
+}
+#endif  // MLAS_F16VEC_INTRINSICS_SUPPORTED
+
 #if defined(USE_CUDA) || defined(USE_ROCM) || defined(USE_DNNL)
 TEST(SoftmaxOperator, Simple_bfloat16) {
 #ifdef USE_CUDA
@@ -861,5 +861,36 @@ TEST(TopKOperator, SelectTopKThreaded) {
   TestThreaded<double>(k, n, batch_size);
 }
 
+// A single row long enough to be split over threads, with many equal values so that the selection across parts
+// must keep the lowest indices of equal values
+static void TestLongRow(int64_t k, int64_t largest) {
+  constexpr int64_t n = 100000;
+  std::vector<float> input_vals(n);
+  for (int64_t i = 0; i < n; ++i) {
+    input_vals[i] = static_cast<float>((i * 7919) % 1000);
+  }
+
+  std::vector<int64_t> order(n);
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&](int64_t a, int64_t b) {
+    return largest ? input_vals[a] > input_vals[b] : input_vals[a] < input_vals[b];
+  });
+
+  std::vector<float> expected_vals(k);
+  std::vector<int64_t> expected_indices(order.begin(), order.begin() + k);
+  for (int64_t l = 0; l < k; ++l) {
+    expected_vals[l] = input_vals[expected_indices[l]];
+  }
+
+  RunTest(11, k, input_vals, {1, n}, expected_vals, expected_indices, {1, k}, false, -1, largest);
+}
+
+TEST(TopKOperator, LongRowThreaded) {
+  TestLongRow(1, 1);
+  TestLongRow(5, 1);
+  TestLongRow(300, 1);
+  TestLongRow(5, 0);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -1,6 +1,9 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
+#include <cmath>
+
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
 
@@ -32,6 +35,65 @@ TEST(MLOpTest, SVMRegressorSVC) {
   test.Run();
 }
 
+// the RBF kernels of several rows come from a GEMM, and those of a single row from the distances. Both match the
+// distances computed in double, including for a row equal to a support vector.
+TEST(MLOpTest, SVMRegressorSVCBatchedRBF) {
+  constexpr int64_t num_rows = 16;
+  constexpr int64_t num_features = 4;
+  constexpr int64_t num_supports = 5;
+  const std::vector<float> coefficients = {0.75f, -1.25f, 0.5f, 1.5f, -0.25f};
+  const std::vector<float> rho = {0.125f};
+  const std::vector<float> kernel_params = {0.05f, 0.f, 3.f};  // gamma, coef0, degree
+
+  std::vector<float> support_vectors(num_supports * num_features);
+  for (size_t i = 0; i < support_vectors.size(); ++i) {
+    support_vectors[i] = static_cast<float>(static_cast<int>((i * 7) % 13) - 6) * 0.5f;
+  }
+  std::vector<float> X(num_rows * num_features);
+  for (size_t i = 0; i < X.size(); ++i) {
+    X[i] = static_cast<float>(static_cast<int>((i * 5) % 17) - 8) * 0.375f;
+  }
+  std::copy_n(support_vectors.begin() + 2 * num_features, num_features, X.begin() + 3 * num_features);
+
+  std::vector<float> predictions(num_rows);
+  for (int64_t row = 0; row < num_rows; ++row) {
+    double prediction = rho[0];
+    for (int64_t support = 0; support < num_supports; ++support) {
+      double distance = 0.0;
+      for (int64_t feature = 0; feature < num_features; ++feature) {
+        const double diff = static_cast<double>(X[row * num_features + feature]) -
+                            static_cast<double>(support_vectors[support * num_features + feature]);
+        distance += diff * diff;
+      }
+      prediction += coefficients[support] * std::exp(-static_cast<double>(kernel_params[0]) * distance);
+    }
+    predictions[row] = static_cast<float>(prediction);
+  }
+
+  auto run_test = [&](int64_t first_row, int64_t rows) {
+    OpTester test("SVMRegressor", 1, onnxruntime::kMLDomain);
+    test.AddAttribute("kernel_type", std::string("RBF"));
+    test.AddAttribute("coefficients", coefficients);
+    test.AddAttribute("support_vectors", support_vectors);
+    test.AddAttribute("rho", rho);
+    test.AddAttribute("kernel_params", kernel_params);
+    test.AddAttribute("n_supports", num_supports);
+
+    test.AddInput<float>("X", {rows, num_features},
+                         std::vector<float>(X.begin() + first_row * num_features,
+                                            X.begin() + (first_row + rows) * num_features));
+    test.AddOutput<float>("Y", {rows, 1},
+                          std::vector<float>(predictions.begin() + first_row, predictions.begin() + first_row + rows));
+    test.SetOutputAbsErr("Y", 1e-4f);
+    test.Run();
+  };
+
+  run_test(0, num_rows);
+  for (int64_t row = 0; row < num_rows; row += 5) {
+    run_test(row, 1);
+  }
+}
+
 TEST(MLOpTest, SVMRegressorNuSVC) {
   OpTester test("SVMRegressor", 1, onnxruntime::kMLDomain);
 
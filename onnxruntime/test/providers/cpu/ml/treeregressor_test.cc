@@ -3,6 +3,8 @@
 
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
+#include "test/util/include/asserts.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 
 namespace onnxruntime {
 namespace test {
@@ -760,5 +762,101 @@ TEST(MLOpTest, TreeRegressorTrueNodeBeforeNode) {
   test.Run();
 }
 
+// Runs 20 complete trees of depth 5 on n_rows rows. A leaf of tree 3 is moved up one level so that the
+// compiled trees have to repeat it.
+static void RunDeepTreesTest(int64_t n_rows, bool compile_trees, int64_t n_trees = 20) {
+  constexpr int64_t depth = 5;
+  constexpr int64_t n_features = 3;
+  constexpr int64_t n_internal = (int64_t{1} << depth) - 1;
+  constexpr int64_t n_nodes = (int64_t{1} << (depth + 1)) - 1;
+
+  // complete binary trees, node k has children 2k+1 (true) and 2k+2 (false)
+  auto feature_of = [](int64_t tree, int64_t node) { return (node + tree) % n_features; };
+  auto threshold_of = [](int64_t tree, int64_t node) { return static_cast<float>((node * 7 + tree * 3) % 10) / 10.f; };
+  auto weight_of = [](int64_t tree, int64_t node) { return static_cast<float>(tree % 7) + 0.5f * (node - n_internal); };
+
+  std::vector<int64_t> nodes_treeids, nodes_nodeids, nodes_featureids, nodes_truenodeids, nodes_falsenodeids;
+  std::vector<std::string> nodes_modes;
+  std::vector<float> nodes_values;
+  std::vector<int64_t> target_treeids, target_nodeids, target_ids;
+  std::vector<float> target_weights;
+  auto is_leaf_of = [](int64_t tree, int64_t node) { return node >= n_internal || (tree == 3 && node == 15); };
+  for (int64_t tree = 0; tree < n_trees; ++tree) {
+    for (int64_t node = 0; node < n_nodes; ++node) {
+      if (tree == 3 && (node == 31 || node == 32)) {
+        continue;  // children of the leaf 15
+      }
+      const bool is_leaf = is_leaf_of(tree, node);
+      nodes_treeids.push_back(tree);
+      nodes_nodeids.push_back(node);
+      nodes_featureids.push_back(is_leaf ? 0 : feature_of(tree, node));
+      nodes_values.push_back(is_leaf ? 0.f : threshold_of(tree, node));
+      nodes_modes.push_back(is_leaf ? "LEAF" : "BRANCH_LEQ");
+      nodes_truenodeids.push_back(is_leaf ? 0 : 2 * node + 1);
+      nodes_falsenodeids.push_back(is_leaf ? 0 : 2 * node + 2);
+      if (is_leaf) {
+        target_treeids.push_back(tree);
+        target_nodeids.push_back(node);
+        target_ids.push_back(0);
+        target_weights.push_back(weight_of(tree, node));
+      }
+    }
+  }
+
+  std::vector<float> X, Y;
+  for (int64_t row = 0; row < n_rows; ++row) {
+    for (int64_t feature = 0; feature < n_features; ++feature) {
+      X.push_back(static_cast<float>((row * 13 + feature * 5) % 11) / 10.f);
+    }
+    float expected = 0.f;
+    for (int64_t tree = 0; tree < n_trees; ++tree) {
+      int64_t node = 0;
+      while (!is_leaf_of(tree, node)) {
+        node = X[row * n_features + feature_of(tree, node)] <= threshold_of(tree, node) ? 2 * node + 1 : 2 * node + 2;
+      }
+      expected += weight_of(tree, node);
+    }
+    Y.push_back(expected);
+  }
+
+  OpTester test("TreeEnsembleRegressor", 3, onnxruntime::kMLDomain);
+  test.AddAttribute("nodes_truenodeids", nodes_truenodeids);
+  test.AddAttribute("nodes_falsenodeids", nodes_falsenodeids);
+  test.AddAttribute("nodes_treeids", nodes_treeids);
+  test.AddAttribute("nodes_nodeids", nodes_nodeids);
+  test.AddAttribute("nodes_featureids", nodes_featureids);
+  test.AddAttribute("nodes_values", nodes_values);
+  test.AddAttribute("nodes_modes", nodes_modes);
+  test.AddAttribute("target_treeids", target_treeids);
+  test.AddAttribute("target_nodeids", target_nodeids);
+  test.AddAttribute("target_ids", target_ids);
+  test.AddAttribute("target_weights", target_weights);
+  test.AddAttribute("n_targets", static_cast<int64_t>(1));
+  test.AddInput<float>("X", {n_rows, n_features}, X);
+  test.AddOutput<float>("Y", {n_rows, 1}, Y);
+
+  SessionOptions so;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsCompileTreeEnsembles,
+                                                    compile_trees ? "1" : "0"));
+  test.Config(so).RunWithConfig();
+}
+
+// Deep trees in large enough number make TreeEnsemble walk blocks of rows through every tree together.
+// The number of rows is not a multiple of the block size so that the last block is partial.
+TEST(MLOpTest, TreeRegressorBatchTraversalDeepTrees) {
+  RunDeepTreesTest(45, false);
+}
+
+TEST(MLOpTest, TreeRegressorCompiledTrees) {
+  RunDeepTreesTest(1, true);
+  RunDeepTreesTest(45, true);
+}
+
+TEST(MLOpTest, TreeRegressorCompactTrees) {
+  // more than 65536 nodes, the ensemble is stored with compact nodes
+  RunDeepTreesTest(1, false, 1100);
+  RunDeepTreesTest(45, false, 1100);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
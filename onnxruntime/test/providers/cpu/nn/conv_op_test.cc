@@ -2,7 +2,9 @@
 // Licensed under the MIT License.
 
 #include "gtest/gtest.h"
+#include "core/providers/cuda/cuda_provider_options.h"
 #include "test/providers/provider_test_utils.h"
+#include "test/util/include/default_providers.h"
 using namespace std;
 namespace onnxruntime {
 namespace test {
@@ -736,5 +738,29 @@ TEST(ConvTest, Conv_AutoPad_with_non_default_strides) {
   TestConvOp(attrs, {X, W}, {X_shape, W_shape}, expected_vals, Y_shape, true);
 }
 
+#if defined(USE_CUDA) && !defined(DISABLE_CONTRIB_OPS)
+// Conv assigned to the CUDA EP with the NHWC layout preferred is run in the internal NHWC domain with the weights
+// transposed when the kernel is created.
+TEST(ConvTest, Conv2D_CudaPreferNhwc) {
+  OpTester test("Conv", 11);
+  test.AddAttribute("kernel_shape", vector<int64_t>{1, 1});
+  test.AddInput<float>("X", {1, 2, 2, 2}, {0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f});
+  test.AddInput<float>("W", {2, 2, 1, 1}, {1.0f, 2.0f, 3.0f, 4.0f}, true);
+  test.AddInput<float>("B", {2}, {0.0f, 1.0f}, true);
+  test.AddOutput<float>("Y", {1, 2, 2, 2}, {8.0f, 11.0f, 14.0f, 17.0f, 17.0f, 24.0f, 31.0f, 38.0f});
+
+  OrtCUDAProviderOptionsV2 cuda_options;
+  cuda_options.prefer_nhwc = 1;
+  auto cuda_ep = CudaExecutionProviderWithOptions(&cuda_options);
+  if (cuda_ep == nullptr) {
+    GTEST_SKIP() << "CUDA EP is not available.";
+  }
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(std::move(cuda_ep));
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+#endif
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -288,6 +288,14 @@ class QLinearConvOpTester {
   int64_t groups_{0};
   float output_scale_{1.0f};
   ActType output_zero_point_{0};
+  QuantizedTensor<ActType> Sum_;
+  float sum_output_scale_{1.0f};
+  ActType sum_output_zero_point_{0};
+  bool has_activation_{false};
+  float activation_alpha_{0.01f};
+  float activation_output_scale_{1.0f};
+  ActType activation_output_zero_point_{0};
+  bool channels_last_{false};
 
   static size_t ShapeSize(const std::vector<int64_t>& shape) {
     return static_cast<size_t>(std::accumulate(shape.cbegin(), shape.cend(), 1LL, std::multiplies<int64_t>()));
@@ -462,14 +470,71 @@ class QLinearConvOpTester {
     }
   }
 
+  // Applies the residual add and the activation of the fused com.microsoft QLinearConv, as the
+  // QLinearAdd and QLinearLeakyRelu kernels compute them.
+  void ComputeExpectedSumAndActivation(std::vector<ActType>& Y_data) {
+    RequantizeValues<ActType> sum_requantize_values(sum_output_zero_point_);
+    for (size_t n = 0; n < Y_data.size(); n++) {
+      const float y = output_scale_ * (static_cast<int32_t>(Y_data[n]) - static_cast<int32_t>(output_zero_point_));
+      const float sum = Sum_.scale_[0] * (static_cast<int32_t>(Sum_.data_[n]) - static_cast<int32_t>(Sum_.zero_point_));
+      float f = (y + sum) / sum_output_scale_;
+      f = std::min(f, sum_requantize_values.max_value_);
+      f = std::max(f, sum_requantize_values.min_value_);
+      Y_data[n] = static_cast<ActType>(RoundHalfToEven(f) + sum_requantize_values.zero_point_);
+
+      if (has_activation_) {
+        float x = sum_output_scale_ * (static_cast<int32_t>(Y_data[n]) - static_cast<int32_t>(sum_output_zero_point_));
+        x = x >= 0.0f ? x : activation_alpha_ * x;
+        MlasQuantizeLinear(&x, &Y_data[n], 1, activation_output_scale_, activation_output_zero_point_);
+      }
+    }
+  }
+
+  // Transposes a channels first tensor to channels last.
+  template <typename T>
+  static std::vector<T> ToChannelsLast(const std::vector<T>& data, std::vector<int64_t>& shape) {
+    const size_t batch_count = static_cast<size_t>(shape[0]);
+    const size_t channels = static_cast<size_t>(shape[1]);
+    const size_t image_size = ShapeSize(shape) / (batch_count * channels);
+    std::vector<T> transposed(data.size());
+    for (size_t n = 0; n < batch_count; n++) {
+      for (size_t c = 0; c < channels; c++) {
+        for (size_t i = 0; i < image_size; i++) {
+          transposed[(n * image_size + i) * channels + c] = data[(n * channels + c) * image_size + i];
+        }
+      }
+    }
+    shape.erase(shape.begin() + 1);
+    shape.push_back(static_cast<int64_t>(channels));
+    return transposed;
+  }
+
   void Run(bool all_input_initializer_except_x) {
-    OpTester test("QLinearConv", 10);
+    const bool has_sum = !Sum_.data_.empty();
+    OpTester test("QLinearConv", has_sum || channels_last_ ? 1 : 10,
+                  has_sum || channels_last_ ? onnxruntime::kMSDomain : onnxruntime::kOnnxDomain);
 
     std::vector<ActType> Y_data;
     std::vector<int64_t> Y_shape;
     ComputeExpectedOutput(Y_data, Y_shape);
+    if (has_sum) {
+      ComputeExpectedSumAndActivation(Y_data);
+    }
+
+    std::vector<int64_t> X_shape = X_.shape_;
+    std::vector<ActType> X_data = X_.data_;
+    std::vector<int64_t> Sum_shape = Y_shape;
+    std::vector<ActType> Sum_data = Sum_.data_;
+    if (channels_last_) {
+      X_data = ToChannelsLast(X_data, X_shape);
+      if (has_sum) {
+        Sum_data = ToChannelsLast(Sum_data, Sum_shape);
+      }
+      Y_data = ToChannelsLast(Y_data, Y_shape);
+      test.AddAttribute("channels_last", static_cast<int64_t>(1));
+    }
 
-    test.AddInput<ActType>("x", X_.shape_, X_.data_);
+    test.AddInput<ActType>("x", X_shape, X_data);
     test.AddInput<float>("x_scale", {}, X_.scale_, all_input_initializer_except_x);
     test.AddInput<ActType>("x_zero_point", {}, {X_.zero_point_}, all_input_initializer_except_x);
 
@@ -484,6 +549,23 @@ class QLinearConvOpTester {
     if (!B_.empty()) {
       const std::vector<int64_t> B_shape{static_cast<int64_t>(B_.size())};
       test.AddInput<int32_t>("b", B_shape, B_, all_input_initializer_except_x);
+    } else if (has_sum) {
+      test.AddOptionalInputEdge<int32_t>();
+    }
+
+    if (has_sum) {
+      test.AddInput<ActType>("sum", Sum_shape, Sum_data);
+      test.AddInput<float>("sum_scale", {}, Sum_.scale_, all_input_initializer_except_x);
+      test.AddInput<ActType>("sum_zero_point", {}, {Sum_.zero_point_}, all_input_initializer_except_x);
+      test.AddInput<float>("sum_y_scale", {}, {sum_output_scale_}, all_input_initializer_except_x);
+      test.AddInput<ActType>("sum_y_zero_point", {}, {sum_output_zero_point_}, all_input_initializer_except_x);
+      if (has_activation_) {
+        test.AddInput<float>("activation_y_scale", {}, {activation_output_scale_}, all_input_initializer_except_x);
+        test.AddInput<ActType>("activation_y_zero_point", {}, {activation_output_zero_point_},
+                               all_input_initializer_except_x);
+        test.AddAttribute("activation", std::string("LeakyRelu"));
+        test.AddAttribute("activation_params", std::vector<float>{activation_alpha_});
+      }
     }
 
     float abs_error = 0.0f;
@@ -502,6 +584,10 @@ class QLinearConvOpTester {
     // TODO: Verify if DML can possibly have a ROUNDING_MODE parameter and conform to the other EPs #41968513
     abs_error = 1.0f;
 #endif
+    // The vectorized QLinearAdd rounds in fixed point.
+    if (has_sum) {
+      abs_error = 1.0f;
+    }
 
     test.AddOutput<ActType>("y", Y_shape, Y_data, false /* sort_output */, 0.0f /* rel_error */, abs_error);
 
@@ -518,6 +604,14 @@ class QLinearConvOpTester {
       test.AddAttribute("group", groups_);
     }
 
+    if (has_sum || channels_last_) {
+      // The fused residual add and the channels last layout are only implemented by the CPU EP.
+      std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+      execution_providers.push_back(DefaultCpuExecutionProvider());
+      test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+      return;
+    }
+
     test.Run(OpTester::ExpectResult::kExpectSuccess, "");
   }
 
@@ -574,6 +668,29 @@ class QLinearConvOpTester {
     output_zero_point_ = output_zero_point;
   }
 
+  // Adds a residual input with the shape of the output, as QLinearConv fused with QLinearAdd does.
+  void GenerateRandomSum(float scale, ActType zero_point, float sum_output_scale, ActType sum_output_zero_point) {
+    std::vector<ActType> Y_data;
+    std::vector<int64_t> Y_shape;
+    ComputeExpectedOutput(Y_data, Y_shape);
+    GenerateRandom(Sum_, Y_shape, scale, zero_point,
+                   std::numeric_limits<ActType>::min(),
+                   std::numeric_limits<ActType>::max());
+    sum_output_scale_ = sum_output_scale;
+    sum_output_zero_point_ = sum_output_zero_point;
+  }
+
+  void SetLeakyReluActivation(float alpha, float output_scale, ActType output_zero_point) {
+    has_activation_ = true;
+    activation_alpha_ = alpha;
+    activation_output_scale_ = output_scale;
+    activation_output_zero_point_ = output_zero_point;
+  }
+
+  void SetChannelsLast() {
+    channels_last_ = true;
+  }
+
   void Run() {
     for (bool all_input_initializer_except_x : std::initializer_list<bool>{false, true}) {
       Run(all_input_initializer_except_x);
@@ -1080,6 +1197,83 @@ TEST(QLinearConvTest, Conv2D_U8S8_Requantize_Bias_PerChannel) {
   }
 }
 
+TEST(QLinearConvTest, Conv2D_U8S8_Sum) {
+  for (bool channels_last : {false, true}) {
+    QLinearConvOpTester<uint8_t, int8_t> test;
+    test.GenerateRandomInput({2, 24, 11, 9}, .05f, 4);
+    test.GenerateRandomWeights({32, 24, 3, 3}, .125f, 0);
+    test.GenerateRandomBias();
+    test.SetPads({1, 1, 1, 1});
+    test.SetOutputScaleAndZeroPoint(.55f, 54);
+    test.GenerateRandomSum(.35f, 120, .6f, 100);
+    if (channels_last) {
+      test.SetChannelsLast();
+    }
+    test.Run();
+  }
+}
+
+TEST(QLinearConvTest, Conv2D_U8S8_Sum_LeakyRelu) {
+  for (bool channels_last : {false, true}) {
+    QLinearConvOpTester<uint8_t, int8_t> test;
+    test.GenerateRandomInput({1, 16, 13, 13}, .05f, 4);
+    test.GenerateRandomWeights({48, 16, 1, 1}, .125f, 0);
+    test.SetOutputScaleAndZeroPoint(.55f, 54);
+    test.GenerateRandomSum(.35f, 120, .6f, 100);
+    test.SetLeakyReluActivation(.1f, .6f, 30);
+    if (channels_last) {
+      test.SetChannelsLast();
+    }
+    test.Run();
+  }
+}
+
+TEST(QLinearConvTest, Conv2D_U8U8_Sum_LeakyRelu) {
+  QLinearConvOpTester<uint8_t, uint8_t> test;
+  test.GenerateRandomInput({1, 8, 9, 9}, .05f, 4);
+  test.GenerateRandomWeights({20, 8, 3, 3}, .10f, 131);
+  test.GenerateRandomBias();
+  test.SetOutputScaleAndZeroPoint(.55f, 54);
+  test.GenerateRandomSum(.25f, 90, .5f, 110);
+  test.SetLeakyReluActivation(.2f, .5f, 40);
+  test.Run();
+}
+
+TEST(QLinearConvTest, Conv2D_U8S8_Depthwise_Sum_LeakyRelu) {
+  for (bool channels_last : {false, true}) {
+    QLinearConvOpTester<uint8_t, int8_t> test;
+    test.GenerateRandomInput({1, 24, 15, 15}, .03f, 12);
+    test.GenerateRandomWeights({24, 1, 3, 3}, .10f, 0);
+    test.GenerateRandomBias();
+    test.SetPads({1, 1, 1, 1});
+    test.SetGroups(24);
+    test.SetOutputScaleAndZeroPoint(.76f, 88);
+    test.GenerateRandomSum(.35f, 120, .8f, 100);
+    test.SetLeakyReluActivation(.1f, .8f, 30);
+    if (channels_last) {
+      test.SetChannelsLast();
+    }
+    test.Run();
+  }
+}
+
+TEST(QLinearConvTest, Conv2D_S8S8_Sum_LeakyRelu) {
+  for (bool channels_last : {false, true}) {
+    QLinearConvOpTester<int8_t, int8_t> test;
+    test.GenerateRandomInput({1, 32, 9, 9}, .05f, 4);
+    test.GenerateRandomWeights({32, 32, 3, 3}, .125f, 0);
+    test.GenerateRandomBias();
+    test.SetPads({1, 1, 1, 1});
+    test.SetOutputScaleAndZeroPoint(.55f, -6);
+    test.GenerateRandomSum(.35f, 10, .6f, -20);
+    test.SetLeakyReluActivation(.1f, .6f, -100);
+    if (channels_last) {
+      test.SetChannelsLast();
+    }
+    test.Run();
+  }
+}
+
 TEST(QLinearConvTest, Conv1D_S8S8) {
   QLinearConvOpTester<int8_t, int8_t> test;
   test.GenerateRandomInput({3, 24, 15}, .05f, 4);
@@ -1,6 +1,10 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
+#include <utility>
+#include <vector>
+
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
 
@@ -383,5 +387,61 @@ TEST(NonMaxSuppressionOpTest, WithIOUThresholdOpset11) {
   test.Run();
 }
 
+// Boxes come in pairs that overlap each other and nothing else, over several batches and classes, so that
+// batches and classes are selected concurrently and each pair keeps its higher scoring box.
+TEST(NonMaxSuppressionOpTest, ManyBatchesAndClasses) {
+  constexpr int64_t num_batches = 3;
+  constexpr int64_t num_classes = 4;
+  constexpr int64_t num_boxes = 64;
+  constexpr int64_t max_output = 20;
+
+  std::vector<float> boxes;
+  for (int64_t b = 0; b < num_batches; ++b) {
+    for (int64_t i = 0; i < num_boxes; ++i) {
+      const float y = static_cast<float>(i / 2) * 10.0f;
+      const float x = (i % 2) * 0.1f;
+      boxes.insert(boxes.end(), {y, x, y + 1.0f, x + 1.0f});
+    }
+  }
+
+  std::vector<float> scores;
+  std::vector<int64_t> expected;
+  int64_t num_selected = 0;
+  for (int64_t b = 0; b < num_batches; ++b) {
+    for (int64_t c = 0; c < num_classes; ++c) {
+      // distinct scores whose order differs from the box order and between classes
+      std::vector<std::pair<float, int64_t>> ranked;
+      for (int64_t i = 0; i < num_boxes; ++i) {
+        const float score = static_cast<float>((i * 37 + c * 11 + b * 5) % num_boxes) / num_boxes;
+        scores.push_back(score);
+        ranked.emplace_back(score, i);
+      }
+      std::sort(ranked.begin(), ranked.end(), [](const auto& lhs, const auto& rhs) { return lhs.first > rhs.first; });
+      std::vector<bool> pair_taken(num_boxes / 2, false);
+      int64_t selected = 0;
+      for (const auto& candidate : ranked) {
+        if (selected == max_output) {
+          break;
+        }
+        if (!pair_taken[candidate.second / 2]) {
+          pair_taken[candidate.second / 2] = true;
+          expected.insert(expected.end(), {b, c, candidate.second});
+          ++selected;
+        }
+      }
+      num_selected += selected;
+    }
+  }
+
+  OpTester test("NonMaxSuppression", 11, kOnnxDomain);
+  test.AddInput<float>("boxes", {num_batches, num_boxes, 4}, boxes);
+  test.AddInput<float>("scores", {num_batches, num_classes, num_boxes}, scores);
+  test.AddInput<int64_t>("max_output_boxes_per_class", {}, {max_output});
+  test.AddInput<float>("iou_threshold", {}, {0.5f});
+  test.AddInput<float>("score_threshold", {}, {0.0f});
+  test.AddOutput<int64_t>("selected_indices", {num_selected, 3}, expected);
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -1,6 +1,7 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
 #include <random>
 #include <cmath>
 #include <type_traits>
@@ -5207,5 +5208,71 @@ TEST(ReductionOpTest, ReduceSum_RKRK_keepdims) {
   test.Run();
 }
 
+// KRKR and RKRKR shapes go through the strided plan, which walks the innermost dimension contiguously
+// whether it is kept or reduced.
+static void TestStridedReduce(const std::string& op, const std::vector<int64_t>& dims, const std::vector<int64_t>& axes) {
+  std::vector<int64_t> strides(dims.size(), 1);
+  for (size_t i = dims.size() - 1; i > 0; --i) {
+    strides[i - 1] = strides[i] * dims[i];
+  }
+  const int64_t size = strides[0] * dims[0];
+  std::vector<float> data(static_cast<size_t>(size));
+  for (int64_t i = 0; i < size; ++i) {
+    data[static_cast<size_t>(i)] = static_cast<float>((i * 37) % 101) - 50.f;
+  }
+
+  std::vector<int64_t> output_dims;
+  for (size_t i = 0; i < dims.size(); ++i) {
+    output_dims.push_back(std::find(axes.begin(), axes.end(), static_cast<int64_t>(i)) == axes.end() ? dims[i] : 1);
+  }
+  int64_t n_reduced = 1;
+  for (auto a : axes) {
+    n_reduced *= dims[static_cast<size_t>(a)];
+  }
+  std::vector<float> expected(static_cast<size_t>(size / n_reduced), op == "ReduceMax" ? -1000.f : (op == "ReduceMin" ? 1000.f : 0.f));
+  for (int64_t i = 0; i < size; ++i) {
+    int64_t o = 0;
+    for (size_t d = 0; d < dims.size(); ++d) {
+      o = o * output_dims[d] + (output_dims[d] == 1 ? 0 : (i / strides[d]) % dims[d]);
+    }
+    float& e = expected[static_cast<size_t>(o)];
+    const float v = data[static_cast<size_t>(i)];
+    e = op == "ReduceMax" ? std::max(e, v) : (op == "ReduceMin" ? std::min(e, v) : e + v);
+  }
+  if (op == "ReduceMean") {
+    for (auto& e : expected) {
+      e /= static_cast<float>(n_reduced);
+    }
+  }
+
+  OpTester test(op.c_str());
+  test.AddAttribute("axes", axes);
+  test.AddAttribute("keepdims", (int64_t)1);
+  test.AddInput<float>("data", dims, data);
+  test.AddOutput<float>("reduced", output_dims, expected);
+  test.Run();
+}
+
+TEST(ReductionOpTest, ReduceStrided_KRKR) {
+  for (const char* op : {"ReduceSum", "ReduceMean", "ReduceMax", "ReduceMin"}) {
+    TestStridedReduce(op, {3, 4, 5, 7}, {1, 3});
+    TestStridedReduce(op, {2, 3, 64, 33}, {1, 3});
+  }
+}
+
+TEST(ReductionOpTest, ReduceStrided_RKRKR) {
+  for (const char* op : {"ReduceSum", "ReduceMean", "ReduceMax", "ReduceMin"}) {
+    TestStridedReduce(op, {2, 3, 4, 5, 6}, {0, 2, 4});
+    TestStridedReduce(op, {3, 17, 2, 40, 3}, {0, 2, 4});
+  }
+}
+
+TEST(ReductionOpTest, ReduceStrided_KRKRK) {
+  for (const char* op : {"ReduceSum", "ReduceMean", "ReduceMax", "ReduceMin"}) {
+    TestStridedReduce(op, {2, 3, 4, 5, 6}, {1, 3});
+    TestStridedReduce(op, {5, 2, 3, 4, 129}, {1, 3});
+  }
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -1,6 +1,7 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <cmath>
 #include <functional>
 #include <vector>
 
@@ -69,6 +70,45 @@ TEST(SignalOpsTest, DFTFloat_radix2) { TestRadix2DFTFloat(false); }
 
 TEST(SignalOpsTest, DFTFloat_radix2_onesided) { TestRadix2DFTFloat(true); }
 
+// Compares batched real DFTs of sizes transformed with the mixed-radix FFT (12, 15, 30, 49) and Bluestein's
+// algorithm (37) with a direct evaluation of the DFT.
+static void TestDFTAgainstReferenceFloat(bool onesided) {
+  constexpr double kPi = 3.14159265358979323846;
+  RandomValueGenerator random(GetTestRandomSeed());
+  constexpr int64_t num_batches = 3;
+  for (int64_t length : {12, 15, 30, 37, 49}) {
+    OpTester test("DFT", kMinOpsetVersion);
+    vector<int64_t> shape = {num_batches, length, 1};
+    vector<float> input = random.Uniform<float>(shape, -1.f, 1.f);
+
+    const int64_t output_length = onesided ? (length >> 1) + 1 : length;
+    vector<float> expected_output;
+    for (int64_t b = 0; b < num_batches; b++) {
+      for (int64_t k = 0; k < output_length; k++) {
+        double real = 0;
+        double imaginary = 0;
+        for (int64_t n = 0; n < length; n++) {
+          const double angle = -2.0 * kPi * static_cast<double>(k * n % length) / static_cast<double>(length);
+          real += input[b * length + n] * std::cos(angle);
+          imaginary += input[b * length + n] * std::sin(angle);
+        }
+        expected_output.push_back(static_cast<float>(real));
+        expected_output.push_back(static_cast<float>(imaginary));
+      }
+    }
+
+    test.AddInput<float>("input", shape, input);
+    test.AddAttribute<int64_t>("onesided", static_cast<int64_t>(onesided));
+    test.AddOutput<float>("output", {num_batches, output_length, 2}, expected_output);
+    test.SetOutputAbsErr("output", 0.0002f);
+    test.Run();
+  }
+}
+
+TEST(SignalOpsTest, DFTFloat_mixed_radix) { TestDFTAgainstReferenceFloat(false); }
+
+TEST(SignalOpsTest, DFTFloat_mixed_radix_onesided) { TestDFTAgainstReferenceFloat(true); }
+
 TEST(SignalOpsTest, DFTFloat_inverse) {
   OpTester test("DFT", kMinOpsetVersion);
 
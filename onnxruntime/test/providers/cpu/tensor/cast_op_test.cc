@@ -1,6 +1,7 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <cstring>
 #include <type_traits>
 
 #include "boost/mp11.hpp"
@@ -212,6 +213,41 @@ TEST(CastOpTest, ToString) {
   TestCastOp(gsl::make_span(int_16_input), gsl::make_span(int_string_data), shape);
 }
 
+TEST(CastOpTest, Float16RoundToNearestEven) {
+  // 37 elements cover the full vectors and the remainder of the bulk conversions.
+  const std::vector<int64_t> shape{37};
+  std::vector<float> float_input(37);
+  for (size_t i = 0; i < float_input.size(); ++i) {
+    float_input[i] = (static_cast<float>(i) - 18.0f) * 0.3377f;
+  }
+  // halfway cases that round to the even bfloat16 value, down for 1.00390625 and up for 1.01171875
+  float_input[0] = 1.00390625f;
+  float_input[1] = 1.01171875f;
+  float_input[2] = 65504.0f;
+  float_input[3] = 1e6f;
+
+  const std::vector<MLFloat16> float16_output = CastedValues<float, MLFloat16>(gsl::make_span(float_input));
+  TestCastOp(gsl::make_span(float_input), gsl::make_span(float16_output), shape);
+
+  std::vector<float> float16_round_trip(float_input.size());
+  for (size_t i = 0; i < float_input.size(); ++i) {
+    float16_round_trip[i] = float16_output[i].ToFloat();
+  }
+  TestCastOp(gsl::make_span(float16_output), gsl::make_span(float16_round_trip), shape);
+
+  std::vector<BFloat16> bfloat16_output(float_input.size());
+  std::vector<float> bfloat16_round_trip(float_input.size());
+  for (size_t i = 0; i < float_input.size(); ++i) {
+    uint32_t bits;
+    std::memcpy(&bits, &float_input[i], sizeof(bits));
+    bits += 0x7FFF + ((bits >> 16) & 1);
+    bfloat16_output[i] = BFloat16(static_cast<uint16_t>(bits >> 16), BFloat16::FromBits());
+    bfloat16_round_trip[i] = bfloat16_output[i].ToFloat();
+  }
+  TestCastOp(gsl::make_span(float_input), gsl::make_span(bfloat16_output), shape);
+  TestCastOp(gsl::make_span(bfloat16_output), gsl::make_span(bfloat16_round_trip), shape);
+}
+
 #if !defined(DISABLE_FLOAT8_TYPES)
 
 template <typename F8>
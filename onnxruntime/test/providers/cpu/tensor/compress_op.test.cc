@@ -148,5 +148,44 @@ TEST(CompressTest, Compress_3dims_neg_axis) {
   test.Run();
 }
 
+// Conditions long enough to be split over threads
+TEST(CompressTest, Compress_long_condition) {
+  constexpr int64_t length = 100000;
+  std::vector<float> input(length * 2);
+  std::unique_ptr<bool[]> condition = std::make_unique<bool[]>(length);
+  std::vector<float> output_default_axis;
+  std::vector<float> output_axis_1;
+  for (int64_t i = 0; i < length; ++i) {
+    input[i] = static_cast<float>(i);
+    input[length + i] = static_cast<float>(-i);
+    condition[i] = i % 3 == 0 || i % 7 == 2;
+  }
+  for (int64_t i = 0; i < length; ++i) {
+    if (condition[i]) {
+      output_default_axis.push_back(input[i]);
+      output_axis_1.push_back(input[i]);
+    }
+  }
+  for (int64_t i = 0; i < length; ++i) {
+    if (condition[i]) {
+      output_axis_1.push_back(input[length + i]);
+    }
+  }
+  const int64_t count = static_cast<int64_t>(output_default_axis.size());
+
+  OpTester test("Compress", 11);
+  test.AddInput<float>("input", {2, length}, input);
+  test.AddInput<bool>("condition", {length}, condition.get(), length);
+  test.AddOutput<float>("output", {count}, output_default_axis);
+  test.Run();
+
+  OpTester axis_test("Compress", 11);
+  axis_test.AddAttribute("axis", int64_t(1));
+  axis_test.AddInput<float>("input", {2, length}, input);
+  axis_test.AddInput<bool>("condition", {length}, condition.get(), length);
+  axis_test.AddOutput<float>("output", {2, count}, output_axis_1);
+  axis_test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
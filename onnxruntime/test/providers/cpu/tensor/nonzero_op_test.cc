@@ -99,5 +99,31 @@ TEST(NonZeroOpTest, EmptyInput) {
   test.Run();
 }
 
+// Large enough to be split over threads, with the non-zero values of the parts written from their own positions
+TEST(NonZeroOpTest, LargeInput) {
+  const std::vector<int64_t> X_dims{7, 130, 97};
+  const int64_t size = X_dims[0] * X_dims[1] * X_dims[2];
+  std::vector<float> X(size);
+  std::vector<int64_t> coordinates[3];
+  for (int64_t i = 0; i < size; ++i) {
+    X[i] = (i % 11 == 0 || i % 13 == 5) ? 1.0f : 0.0f;
+    if (X[i] != 0.0f) {
+      coordinates[0].push_back(i / (X_dims[1] * X_dims[2]));
+      coordinates[1].push_back(i / X_dims[2] % X_dims[1]);
+      coordinates[2].push_back(i % X_dims[2]);
+    }
+  }
+
+  std::vector<int64_t> Y;
+  for (const auto& dim_coordinates : coordinates) {
+    Y.insert(Y.end(), dim_coordinates.begin(), dim_coordinates.end());
+  }
+
+  OpTester test{kOpName, kOpVersion};
+  test.AddInput<float>("X", X_dims, X);
+  test.AddOutput<int64_t>("Y", {3, static_cast<int64_t>(coordinates[0].size())}, Y);
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
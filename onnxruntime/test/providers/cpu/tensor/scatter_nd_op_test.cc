@@ -1,6 +1,8 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
+
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
 
@@ -180,5 +182,44 @@ TEST(ScatterNDOpTest, ScatterND_batched_3tensor_int64) {
   test3.Run();
 }
 
+// Many updates of each output row, so that the updates of a row are split over threads unless they are grouped.
+static void TestScatterNDDuplicateIndices(const std::string& reduction) {
+  constexpr int64_t num_rows = 64;
+  constexpr int64_t row_size = 32;
+  constexpr int64_t num_updates = 4096;
+
+  std::vector<float> data(num_rows * row_size, 1.0f);
+  std::vector<int64_t> indices(num_updates);
+  std::vector<float> updates(num_updates * row_size);
+  std::vector<float> output = data;
+  for (int64_t u = 0; u < num_updates; ++u) {
+    const int64_t row = (u * 7) % num_rows;
+    indices[u] = row;
+    for (int64_t j = 0; j < row_size; ++j) {
+      const float update = static_cast<float>((u + j) % 5) - 2.0f;
+      updates[u * row_size + j] = update;
+      float& out = output[row * row_size + j];
+      if (reduction == "add") {
+        out += update;
+      } else {
+        out = std::max(out, update);
+      }
+    }
+  }
+
+  OpTester test("ScatterND", 16);
+  test.AddAttribute<std::string>("reduction", reduction);
+  test.AddInput<float>("data", {num_rows, row_size}, data);
+  test.AddInput<int64_t>("indices", {num_updates, 1}, indices);
+  test.AddInput<float>("updates", {num_updates, row_size}, updates);
+  test.AddOutput<float>("output", {num_rows, row_size}, output);
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider, kOpenVINOExecutionProvider});
+}
+
+TEST(ScatterNDOpTest, ScatterND_duplicate_indices_reduction) {
+  TestScatterNDDuplicateIndices("add");
+  TestScatterNDDuplicateIndices("max");
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -5,6 +5,9 @@
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
 #include "test/util/include/default_providers.h"
+#ifdef ENABLE_STRIDED_TENSORS
+#include "test/providers/kernel_compute_test_utils.h"
+#endif
 
 namespace onnxruntime {
 namespace test {
@@ -747,5 +750,33 @@ TEST(SliceTest, CoalesceDims) {
   RunSliceTest<float>({1, 1, 1}, {1.f}, {0}, {std::numeric_limits<int64_t>::max()}, {1}, {}, {1, 1, 1}, {1.f}, true);
 }
 
+#ifdef ENABLE_STRIDED_TENSORS
+TEST(SliceTest, Strided) {
+  // Strided output: a view of every other column of the input.
+  {
+    KernelComputeTester test("Slice");
+    test.AddInput<float>("data", {3, 4}, {0.f, 1.f, 2.f, 3.f, 4.f, 5.f, 6.f, 7.f, 8.f, 9.f, 10.f, 11.f});
+    test.AddInput<int64_t>("starts", {1}, {0});
+    test.AddInput<int64_t>("ends", {1}, {4});
+    test.AddInput<int64_t>("axes", {1}, {1});
+    test.AddInput<int64_t>("steps", {1}, {2});
+    test.AddOutput<float>("output", {3, 2}, std::vector<float>(11, 0.f), {4, 2});
+    test.Run({0});
+  }
+
+  // Strided input [[0, 2, 4], [1, 3, 5]] is sliced into the contiguous output.
+  {
+    KernelComputeTester test("Slice");
+    test.AddInput<float>("data", {2, 3}, {0.f, 1.f, 2.f, 3.f, 4.f, 5.f}, {1, 2});
+    test.AddInput<int64_t>("starts", {1}, {1});
+    test.AddInput<int64_t>("ends", {1}, {3});
+    test.AddInput<int64_t>("axes", {1}, {1});
+    test.AddInput<int64_t>("steps", {1}, {1});
+    test.AddOutput<float>("output", {2, 2}, {2.f, 4.f, 3.f, 5.f});
+    test.Run();
+  }
+}
+#endif
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -1,12 +1,20 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
+
 #include "gtest/gtest.h"
 #include "test/common/dnnl_op_test_utils.h"
 #include "test/providers/provider_test_utils.h"
 #include "test/providers/compare_provider_test_utils.h"
+#include "core/framework/allocator.h"
+#include "core/platform/env.h"
+#include "core/platform/threadpool.h"
 #include "core/providers/cpu/tensor/transpose.h"
 #include "test/util/include/default_providers.h"
+#ifdef ENABLE_STRIDED_TENSORS
+#include "test/providers/kernel_compute_test_utils.h"
+#endif
 #include "test/util/include/asserts.h"
 
 namespace onnxruntime {
@@ -683,6 +691,67 @@ TEST(TransposeOpTest, DoTransposeEltWise) {
   }
 }
 
+// Transposes large enough to be split over the threads go through the planned transpose for every permutation,
+// which is compared with the transpose computed element by element.
+template <typename T>
+static void TestDoTransposeWithThreadPool(concurrency::ThreadPool* tp, const std::vector<int64_t>& input_dims,
+                                          const std::vector<size_t>& perm) {
+  AllocatorPtr allocator = std::make_shared<CPUAllocator>();
+  const TensorShape input_shape(input_dims);
+  std::vector<int64_t> output_dims(input_dims.size());
+  for (size_t i = 0; i < perm.size(); ++i) {
+    output_dims[i] = input_dims[perm[i]];
+  }
+  Tensor input(DataTypeImpl::GetType<T>(), input_shape, allocator);
+  Tensor output(DataTypeImpl::GetType<T>(), TensorShape(output_dims), allocator);
+  T* input_data = input.MutableData<T>();
+  for (int64_t i = 0; i < input_shape.Size(); ++i) {
+    input_data[i] = static_cast<T>(i % 251);
+  }
+
+  ASSERT_STATUS_OK(TransposeBase::DoTranspose(perm, input, output, nullptr, tp));
+
+  const size_t rank = input_dims.size();
+  std::vector<int64_t> input_strides(rank);
+  for (size_t axis = 0; axis < rank; ++axis) {
+    input_strides[axis] = input_shape.SizeFromDimension(perm[axis] + 1);
+  }
+  std::vector<int64_t> index(rank, 0);
+  const T* output_data = output.Data<T>();
+  for (int64_t o = 0; o < input_shape.Size(); ++o) {
+    int64_t i = 0;
+    for (size_t axis = 0; axis < rank; ++axis) {
+      i += index[axis] * input_strides[axis];
+    }
+    ASSERT_EQ(output_data[o], input_data[i]) << "at output element " << o;
+    for (size_t axis = rank; axis-- > 0;) {
+      if (++index[axis] < output_dims[axis]) {
+        break;
+      }
+      index[axis] = 0;
+    }
+  }
+}
+
+TEST(TransposeOpTest, DoTransposeWithThreadPool) {
+  OrtThreadPoolParams to;
+  to.thread_pool_size = 4;
+  auto tp = concurrency::CreateThreadPool(&onnxruntime::Env::Default(), to, concurrency::ThreadPoolType::INTRA_OP);
+
+  const std::vector<int64_t> input_dims{2, 67, 4, 33, 5};
+  std::vector<size_t> perm{0, 1, 2, 3, 4};
+  do {
+    TestDoTransposeWithThreadPool<uint8_t>(tp.get(), input_dims, perm);
+    TestDoTransposeWithThreadPool<int16_t>(tp.get(), input_dims, perm);
+    TestDoTransposeWithThreadPool<float>(tp.get(), input_dims, perm);
+    TestDoTransposeWithThreadPool<int64_t>(tp.get(), input_dims, perm);
+  } while (std::next_permutation(perm.begin(), perm.end()));
+
+  // a single transposed matrix, which is split over the threads by rows
+  TestDoTransposeWithThreadPool<float>(tp.get(), {1, 300, 257}, {0, 2, 1});
+  TestDoTransposeWithThreadPool<uint8_t>(tp.get(), {1000, 129}, {1, 0});
+}
+
 #if USE_CUDA
 constexpr const char* kGpuExecutionProvider = kCudaExecutionProvider;
 #elif USE_ROCM
@@ -783,5 +852,25 @@ TEST(TransposeOpTest, TransposeBigMLFloat16) {  // Exercises CanUse_cublasTransp
 }
 #endif
 
+#ifdef ENABLE_STRIDED_TENSORS
+TEST(TransposeOpTest, Strided) {
+  // Strided output: a view of the input with permuted strides.
+  {
+    KernelComputeTester test("Transpose");
+    test.AddInput<float>("X", {2, 3}, {0.f, 1.f, 2.f, 3.f, 4.f, 5.f});
+    test.AddOutput<float>("Y", {3, 2}, {0.f, 1.f, 2.f, 3.f, 4.f, 5.f}, {1, 3});
+    test.Run({0});
+  }
+
+  // Strided input [[0, 2, 4], [1, 3, 5]] is copied into the contiguous output.
+  {
+    KernelComputeTester test("Transpose");
+    test.AddInput<float>("X", {2, 3}, {0.f, 1.f, 2.f, 3.f, 4.f, 5.f}, {1, 2});
+    test.AddOutput<float>("Y", {3, 2}, {0.f, 1.f, 2.f, 3.f, 4.f, 5.f});
+    test.Run();
+  }
+}
+#endif
+
 }  // namespace test
 }  // namespace onnxruntime
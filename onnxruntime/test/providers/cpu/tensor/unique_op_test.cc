@@ -1,6 +1,11 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <numeric>
+
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
 
@@ -375,5 +380,76 @@ TEST(Unique, EmptyInput) {
   test.Run();
 }
 
+// all the NaNs are a single unique value, ordered after the others, and so are both zeros
+TEST(Unique, Flatten_NaN_And_Zeros) {
+  constexpr float nan = std::numeric_limits<float>::quiet_NaN();
+  const std::vector<int64_t> X_dims{6};
+  const std::vector<float> X{nan, -0.f, 1.f, 0.f, nan, -1.f};
+  const std::vector<int64_t> Y_dims{4};
+  const std::vector<int64_t> indices_dims{4};
+  const std::vector<int64_t> inverse_indices_dims{6};
+  const std::vector<int64_t> counts_dims{4};
+
+  RunUniqueTest<float>(X_dims, X, nullptr, false, Y_dims, {nan, -0.f, 1.f, -1.f}, indices_dims, {0, 1, 2, 5},
+                       inverse_indices_dims, {0, 1, 2, 1, 0, 3}, counts_dims, {2, 2, 1, 1});
+  RunUniqueTest<float>(X_dims, X, nullptr, true, Y_dims, {-1.f, -0.f, 1.f, nan}, indices_dims, {5, 1, 2, 0},
+                       inverse_indices_dims, {3, 1, 2, 1, 3, 0}, counts_dims, {1, 2, 1, 2});
+}
+
+// an input large enough to be split in ranges whose unique values are merged
+TEST(Unique, Flatten_Large) {
+  constexpr size_t num_values = 4 * 64 * 1024 + 13;
+  std::vector<int64_t> X(num_values);
+  for (size_t i = 0; i < num_values; ++i) {
+    X[i] = static_cast<int64_t>((i * 7919) % 1009) - 500;
+  }
+
+  for (bool sorted : {false, true}) {
+    // unique values in the order of their first occurrence
+    std::vector<int64_t> Y;
+    std::vector<int64_t> indices;
+    std::vector<int64_t> inverse_indices(num_values);
+    std::vector<int64_t> counts;
+    std::map<int64_t, int64_t> value_to_unique;
+    for (size_t i = 0; i < num_values; ++i) {
+      auto insert_result = value_to_unique.emplace(X[i], static_cast<int64_t>(Y.size()));
+      if (insert_result.second) {
+        Y.push_back(X[i]);
+        indices.push_back(static_cast<int64_t>(i));
+        counts.push_back(0);
+      }
+      inverse_indices[i] = insert_result.first->second;
+      ++counts[static_cast<size_t>(insert_result.first->second)];
+    }
+
+    if (sorted) {
+      std::vector<int64_t> order(Y.size());
+      std::iota(order.begin(), order.end(), int64_t{0});
+      std::sort(order.begin(), order.end(), [&Y](int64_t lhs, int64_t rhs) {
+        return Y[static_cast<size_t>(lhs)] < Y[static_cast<size_t>(rhs)];
+      });
+      std::vector<int64_t> position(order.size());
+      std::vector<int64_t> sorted_Y, sorted_indices, sorted_counts;
+      for (size_t i = 0; i < order.size(); ++i) {
+        const auto unique = static_cast<size_t>(order[i]);
+        position[unique] = static_cast<int64_t>(i);
+        sorted_Y.push_back(Y[unique]);
+        sorted_indices.push_back(indices[unique]);
+        sorted_counts.push_back(counts[unique]);
+      }
+      for (auto& inverse_index : inverse_indices) {
+        inverse_index = position[static_cast<size_t>(inverse_index)];
+      }
+      Y = std::move(sorted_Y);
+      indices = std::move(sorted_indices);
+      counts = std::move(sorted_counts);
+    }
+
+    const std::vector<int64_t> unique_dims{static_cast<int64_t>(Y.size())};
+    RunUniqueTest<int64_t>({static_cast<int64_t>(num_values)}, X, nullptr, sorted, unique_dims, Y, unique_dims,
+                           indices, {static_cast<int64_t>(num_values)}, inverse_indices, unique_dims, counts);
+  }
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -1,12 +1,15 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <vector>
+
 #include "core/framework/allocator_utils.h"
 #include "gtest/gtest.h"
 #include "cuda_runtime.h"
 #include "core/framework/allocator.h"
 #include "core/providers/cuda/cuda_allocator.h"
 #include "core/providers/cuda/cuda_common.h"
+#include "core/framework/stream_handles.h"
 
 namespace onnxruntime {
 namespace test {
@@ -113,5 +116,37 @@ TEST(AllocatorTest, CUDAAllocatorFallbackTest) {
   auto last_error = cudaGetLastError();
   EXPECT_EQ(last_error, cudaSuccess) << "Last error should be cleared if handled gracefully";
 }
+
+TEST(AllocatorTest, CUDAMallocAsyncAllocatorTest) {
+  OrtDevice::DeviceId cuda_device_id = 0;
+  CUDA_CALL_THROW(cudaSetDevice(cuda_device_id));
+
+  // release all freed memory when the stream synchronizes
+  CUDAMallocAsyncAllocator allocator(cuda_device_id, CUDA, 0);
+  EXPECT_STREQ(allocator.Info().name, CUDA);
+  EXPECT_EQ(allocator.Info().alloc_type, OrtDeviceAllocator);
+  EXPECT_TRUE(allocator.IsStreamOrdered());
+
+  cudaStream_t cuda_stream;
+  CUDA_CALL_THROW(cudaStreamCreateWithFlags(&cuda_stream, cudaStreamNonBlocking));
+  Stream stream(cuda_stream, allocator.Info().device);
+
+  size_t size = 1024;
+  void* stream_addr = AllocateBufferWithOptions(allocator, size, false, &stream, nullptr);
+  EXPECT_TRUE(stream_addr);
+  std::vector<int> host_data(size / sizeof(int), 0);
+  CUDA_CALL_THROW(cudaMemsetAsync(stream_addr, -1, size, cuda_stream));
+  CUDA_CALL_THROW(cudaMemcpyAsync(host_data.data(), stream_addr, size, cudaMemcpyDeviceToHost, cuda_stream));
+  allocator.Free(stream_addr);
+  CUDA_CALL_THROW(cudaStreamSynchronize(cuda_stream));
+  EXPECT_EQ(host_data[0], -1);
+
+  // allocations without a stream are synchronous
+  void* addr = allocator.Alloc(size);
+  EXPECT_TRUE(addr);
+  allocator.Free(addr);
+
+  CUDA_CALL_THROW(cudaStreamDestroy(cuda_stream));
+}
 }  // namespace test
 }  // namespace onnxruntime
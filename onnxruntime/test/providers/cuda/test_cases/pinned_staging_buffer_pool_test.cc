@@ -0,0 +1,54 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <numeric>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "cuda_runtime.h"
+#include "core/providers/cuda/cuda_common.h"
+#include "core/providers/cuda/pinned_staging_buffer_pool.h"
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+// copies data to the GPU and back through a pool with chunks of chunk_size bytes
+void TestStagedRoundTrip(size_t chunk_size, size_t num_bytes) {
+  CUDA_CALL_THROW(cudaSetDevice(0));
+  cudaStream_t stream;
+  CUDA_CALL_THROW(cudaStreamCreate(&stream));
+  void* device_buffer = nullptr;
+  CUDA_CALL_THROW(cudaMalloc(&device_buffer, num_bytes));
+
+  std::vector<uint8_t> input(num_bytes);
+  std::iota(input.begin(), input.end(), uint8_t{0});
+  std::vector<uint8_t> output(num_bytes, 0);
+  {
+    PinnedStagingBufferPool pool(chunk_size);
+    ASSERT_TRUE(pool.CopyHostToDevice(device_buffer, input.data(), num_bytes, stream).IsOK());
+    // the host buffer can be reused once the copy returned
+    std::fill(input.begin(), input.end(), uint8_t{0});
+    ASSERT_TRUE(pool.CopyDeviceToHost(output.data(), device_buffer, num_bytes, stream).IsOK());
+  }
+
+  std::vector<uint8_t> expected(num_bytes);
+  std::iota(expected.begin(), expected.end(), uint8_t{0});
+  EXPECT_EQ(output, expected);
+
+  CUDA_CALL_THROW(cudaFree(device_buffer));
+  CUDA_CALL_THROW(cudaStreamDestroy(stream));
+}
+}  // namespace
+
+TEST(PinnedStagingBufferPoolTest, SingleChunk) {
+  TestStagedRoundTrip(1024, 1000);
+}
+
+TEST(PinnedStagingBufferPoolTest, DoubleBufferedChunks) {
+  // an odd number of chunks with a partial last chunk
+  TestStagedRoundTrip(1024, 5 * 1024 + 17);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
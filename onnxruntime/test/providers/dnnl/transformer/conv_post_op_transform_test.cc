@@ -0,0 +1,201 @@
+// Copyright (c) Intel Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "core/framework/session_state.h"
+#include "test/providers/provider_test_utils.h"
+#include "core/session/inference_session.h"
+
+#include "test/util/include/default_providers.h"
+
+/*
+ * The tests validate that if a Conv + post op fusion occurs the expected output
+ * matches the output of the graph if the fusion had not been done.
+ *
+ * As with the MatMul post op tests there is no hook to check that the fusion
+ * occurred other than inspecting the debug logs.
+ *
+ *  // fusion seen in most cnn models
+ *  conv_relu
+ *  // residual connection of resnet, the Add is a sum post op
+ *  conv_add_relu
+ *  // binary post ops broadcasting the other input
+ *  conv_bias_mul_sub
+ *  // element wise function that takes alpha attribute
+ *  conv_add_leakyrelu_mul
+ *
+ * The numbers for the tests were calculated using python.
+ */
+
+namespace onnxruntime {
+namespace test {
+// Although these tests should not fail when run on other EPs there
+// is not much gained by running these on other EPs
+#ifdef USE_DNNL
+static const std::vector<float> conv_x = {-1.5f, -1.0f, -0.5f, 0.0f, 0.5f, 1.0f, 1.5f, 2.0f, 2.5f};
+static const std::vector<float> conv_w = {1.0f, 0.5f, -1.0f, 1.0f};
+
+class Dnnl_Conv_Relu_PostOpTester : public OpTester {
+ public:
+  explicit Dnnl_Conv_Relu_PostOpTester(int opset_version = 11)
+      : OpTester("Conv", opset_version) {
+  }
+
+ protected:
+  void AddNodes(onnxruntime::Graph& graph,
+                std::vector<onnxruntime::NodeArg*>& graph_input_defs,
+                std::vector<onnxruntime::NodeArg*>& graph_output_defs,
+                std::vector<std::function<void(onnxruntime::Node& node)>>& /*add_attribute_funcs*/) override {
+    ASSERT_EQ(graph_input_defs.size(), 2u);
+    ASSERT_EQ(graph_output_defs.size(), 1u);
+
+    NodeArg* x = graph_input_defs[0];
+    NodeArg* w = graph_input_defs[1];
+    NodeArg* y = graph_output_defs[0];
+
+    // internal NodeArgs
+    auto& conv_out = graph.GetOrCreateNodeArg("conv_out", y->TypeAsProto());
+
+    graph.AddNode("conv1", "Conv", "", {x, w}, {&conv_out});
+    graph.AddNode("relu1", "Relu", "", {&conv_out}, {y});
+  }
+};
+
+TEST(DnnlConvFusion, Conv_Relu) {
+  Dnnl_Conv_Relu_PostOpTester test;
+  test.AddInput<float>("x", {1, 1, 3, 3}, conv_x);
+  test.AddInput<float>("w", {1, 1, 2, 2}, conv_w);
+  test.AddOutput<float>("y", {1, 1, 2, 2}, {0.0f, 0.0f, 0.75f, 1.5f});
+
+  test.Run();
+}
+
+class Dnnl_Conv_Add_Relu_PostOpTester : public OpTester {
+ public:
+  explicit Dnnl_Conv_Add_Relu_PostOpTester(int opset_version = 11)
+      : OpTester("Conv", opset_version) {
+  }
+
+ protected:
+  void AddNodes(onnxruntime::Graph& graph,
+                std::vector<onnxruntime::NodeArg*>& graph_input_defs,
+                std::vector<onnxruntime::NodeArg*>& graph_output_defs,
+                std::vector<std::function<void(onnxruntime::Node& node)>>& /*add_attribute_funcs*/) override {
+    ASSERT_EQ(graph_input_defs.size(), 3u);
+    ASSERT_EQ(graph_output_defs.size(), 1u);
+
+    NodeArg* x = graph_input_defs[0];
+    NodeArg* w = graph_input_defs[1];
+    NodeArg* r = graph_input_defs[2];
+    NodeArg* y = graph_output_defs[0];
+
+    // internal NodeArgs
+    auto& conv_out = graph.GetOrCreateNodeArg("conv_out", y->TypeAsProto());
+    auto& add_out = graph.GetOrCreateNodeArg("add_out", y->TypeAsProto());
+
+    graph.AddNode("conv1", "Conv", "", {x, w}, {&conv_out});
+    // the residual is the first input of the Add
+    graph.AddNode("add1", "Add", "", {r, &conv_out}, {&add_out});
+    graph.AddNode("relu1", "Relu", "", {&add_out}, {y});
+  }
+};
+
+TEST(DnnlConvFusion, Conv_Add_Relu) {
+  Dnnl_Conv_Add_Relu_PostOpTester test;
+  test.AddInput<float>("x", {1, 1, 3, 3}, conv_x);
+  test.AddInput<float>("w", {1, 1, 2, 2}, conv_w);
+  test.AddInput<float>("r", {1, 1, 2, 2}, {0.5f, -1.5f, 2.0f, -0.25f});
+  test.AddOutput<float>("y", {1, 1, 2, 2}, {0.0f, 0.0f, 2.75f, 1.25f});
+
+  test.Run();
+}
+
+class Dnnl_Conv_Bias_Mul_Sub_PostOpTester : public OpTester {
+ public:
+  explicit Dnnl_Conv_Bias_Mul_Sub_PostOpTester(int opset_version = 11)
+      : OpTester("Conv", opset_version) {
+  }
+
+ protected:
+  void AddNodes(onnxruntime::Graph& graph,
+                std::vector<onnxruntime::NodeArg*>& graph_input_defs,
+                std::vector<onnxruntime::NodeArg*>& graph_output_defs,
+                std::vector<std::function<void(onnxruntime::Node& node)>>& /*add_attribute_funcs*/) override {
+    ASSERT_EQ(graph_input_defs.size(), 5u);
+    ASSERT_EQ(graph_output_defs.size(), 1u);
+
+    NodeArg* x = graph_input_defs[0];
+    NodeArg* w = graph_input_defs[1];
+    NodeArg* b = graph_input_defs[2];
+    NodeArg* m = graph_input_defs[3];
+    NodeArg* s = graph_input_defs[4];
+    NodeArg* y = graph_output_defs[0];
+
+    // internal NodeArgs
+    auto& conv_out = graph.GetOrCreateNodeArg("conv_out", y->TypeAsProto());
+    auto& mul_out = graph.GetOrCreateNodeArg("mul_out", y->TypeAsProto());
+
+    graph.AddNode("conv1", "Conv", "", {x, w, b}, {&conv_out});
+    graph.AddNode("mul1", "Mul", "", {&conv_out, m}, {&mul_out});
+    graph.AddNode("sub1", "Sub", "", {&mul_out, s}, {y});
+  }
+};
+
+TEST(DnnlConvFusion, Conv_Bias_Mul_Sub) {
+  Dnnl_Conv_Bias_Mul_Sub_PostOpTester test;
+  test.AddInput<float>("x", {1, 1, 3, 3}, conv_x);
+  test.AddInput<float>("w", {1, 1, 2, 2}, conv_w);
+  test.AddInput<float>("b", {1}, {0.25f});
+  test.AddInput<float>("m", {1}, {3.0f});
+  test.AddInput<float>("s", {1}, {1.0f});
+  test.AddOutput<float>("y", {1, 1, 2, 2}, {-4.75f, -2.5f, 2.0f, 4.25f});
+
+  test.Run();
+}
+
+class Dnnl_Conv_Add_LeakyRelu_Mul_PostOpTester : public OpTester {
+ public:
+  explicit Dnnl_Conv_Add_LeakyRelu_Mul_PostOpTester(int opset_version = 11)
+      : OpTester("Conv", opset_version) {
+  }
+
+ protected:
+  void AddNodes(onnxruntime::Graph& graph,
+                std::vector<onnxruntime::NodeArg*>& graph_input_defs,
+                std::vector<onnxruntime::NodeArg*>& graph_output_defs,
+                std::vector<std::function<void(onnxruntime::Node& node)>>& /*add_attribute_funcs*/) override {
+    ASSERT_EQ(graph_input_defs.size(), 4u);
+    ASSERT_EQ(graph_output_defs.size(), 1u);
+
+    NodeArg* x = graph_input_defs[0];
+    NodeArg* w = graph_input_defs[1];
+    NodeArg* r = graph_input_defs[2];
+    NodeArg* m = graph_input_defs[3];
+    NodeArg* y = graph_output_defs[0];
+
+    // internal NodeArgs
+    auto& conv_out = graph.GetOrCreateNodeArg("conv_out", y->TypeAsProto());
+    auto& add_out = graph.GetOrCreateNodeArg("add_out", y->TypeAsProto());
+    auto& leakyrelu_out = graph.GetOrCreateNodeArg("leakyrelu_out", y->TypeAsProto());
+
+    graph.AddNode("conv1", "Conv", "", {x, w}, {&conv_out});
+    graph.AddNode("add1", "Add", "", {&conv_out, r}, {&add_out});
+    graph.AddNode("leakyrelu1", "LeakyRelu", "", {&add_out}, {&leakyrelu_out}).AddAttribute("alpha", 0.1f);
+    graph.AddNode("mul1", "Mul", "", {&leakyrelu_out, m}, {y});
+  }
+};
+
+TEST(DnnlConvFusion, Conv_Add_LeakyRelu_Mul) {
+  Dnnl_Conv_Add_LeakyRelu_Mul_PostOpTester test;
+  test.AddInput<float>("x", {1, 1, 3, 3}, conv_x);
+  test.AddInput<float>("w", {1, 1, 2, 2}, conv_w);
+  test.AddInput<float>("r", {1, 1, 2, 2}, {0.5f, -1.5f, 2.0f, -0.25f});
+  test.AddInput<float>("m", {1}, {2.0f});
+  test.AddOutput<float>("y", {1, 1, 2, 2}, {-0.2f, -0.45f, 5.5f, 2.5f});
+
+  test.Run();
+}
+#endif  // USE_DNNL
+}  // namespace test
+}  // namespace onnxruntime
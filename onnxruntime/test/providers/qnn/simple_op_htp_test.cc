@@ -187,6 +187,68 @@ TEST_F(QnnHTPBackendTests, ContextBinaryCacheTest) {
                   "ContextBinaryCacheTest");
 }
 
+// Creates the graph:
+//    input_u8 -> DQ -> Atan -> Q -> DQ -> Erf -> Q -> DQ -> Atan -> Q -> DQ -> output
+//
+// Erf is not supported by QNN EP, so the graph has 2 QNN partitions around the Erf node that runs on CPU EP.
+static GetQDQTestCaseFn BuildQDQTwoPartitionsTestCase(const std::vector<int64_t>& input_shape) {
+  return [input_shape](ModelTestBuilder& builder) {
+    const uint8_t quant_zero_point = 0;
+    const float quant_scale = 1.0f;
+
+    auto* input = builder.MakeInput<uint8_t>(input_shape, std::numeric_limits<uint8_t>::min(),
+                                             std::numeric_limits<uint8_t>::max());
+    NodeArg* q_input = input;
+    const std::vector<std::string> op_types = {"Atan", "Erf", "Atan"};
+    for (const auto& op_type : op_types) {
+      auto* dq_output = builder.MakeIntermediate();
+      builder.AddDequantizeLinearNode<uint8_t>(q_input, quant_scale, quant_zero_point, dq_output);
+
+      auto* op_output = builder.MakeIntermediate();
+      builder.AddNode(op_type, {dq_output}, {op_output});
+
+      q_input = builder.MakeIntermediate();
+      builder.AddQuantizeLinearNode<uint8_t>(op_output, quant_scale, quant_zero_point, q_input);
+    }
+
+    auto* final_output = builder.MakeOutput();
+    builder.AddDequantizeLinearNode<uint8_t>(q_input, quant_scale, quant_zero_point, final_output);
+  };
+}
+
+// Run a QDQ model with 2 QNN partitions on HTP twice
+// 1st run will compose both partitions into one Qnn context and dump it to the context cache binary file
+// 2nd run will load both graphs from the one Qnn context cache binary file
+TEST_F(QnnHTPBackendTests, ContextBinaryCacheMultiPartitionTest) {
+  ProviderOptions provider_options;
+#if defined(_WIN32)
+  provider_options["backend_path"] = "QnnHtp.dll";
+#else
+  provider_options["backend_path"] = "libQnnHtp.so";
+#endif
+  provider_options["qnn_context_cache_enable"] = "1";
+  const std::string context_binary_file = "./qnn_context_binary_multi_partition_test.bin";
+  std::filesystem::remove(context_binary_file);
+  provider_options["qnn_context_cache_path"] = context_binary_file;
+
+  // 2 fused QNN nodes and the Erf node
+  RunQnnModelTest(BuildQDQTwoPartitionsTestCase({1, 2, 3}),
+                  provider_options,
+                  11,
+                  ExpectedEPNodeAssignment::Some,
+                  3,
+                  "ContextBinaryCacheMultiPartitionTest");
+
+  EXPECT_TRUE(std::filesystem::exists(context_binary_file.c_str()));
+
+  RunQnnModelTest(BuildQDQTwoPartitionsTestCase({1, 2, 3}),
+                  provider_options,
+                  11,
+                  ExpectedEPNodeAssignment::Some,
+                  3,
+                  "ContextBinaryCacheMultiPartitionTest");
+}
+
 TEST_F(QnnHTPBackendTests, TestSub4D_SmallInputs) {
   RunQDQBinaryOpTest<float, uint8_t>("Sub", TestInputDef<float>({1, 3, 8, 8}, false, -1.0f, 1.0f),
                                      TestInputDef<float>({1, 3, 8, 8}, false, -1.0f, 1.0f),
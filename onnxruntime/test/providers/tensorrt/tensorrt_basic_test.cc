@@ -817,6 +817,170 @@ TEST(TensorrtExecutionProviderTest, FunctionTest) {
   VerifyOutputs(fetches, expected_dims_mul_m, expected_values_mul_m);
 }
 
+TEST(TensorrtExecutionProviderTest, AsyncEngineBuildTest) {
+  std::string model_name = "trt_execution_provider_async_engine_build_test.onnx";
+  std::vector<int> dims = {1, -1, -1};
+  CreateBaseModel(model_name, "asyncenginebuildtest", dims);
+
+  SessionOptions so;
+  so.session_logid = "TensorrtExecutionProviderTest.AsyncEngineBuildTest";
+  RunOptions run_options;
+  run_options.run_tag = so.session_logid;
+  InferenceSession session_object{so, GetEnvironment()};
+
+  auto cuda_provider = DefaultCudaExecutionProvider();
+  auto cpu_allocator = cuda_provider->CreatePreferredAllocators()[1];
+  std::vector<int64_t> dims_mul_x = {1, 3, 2};
+  std::vector<float> values_mul_x = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+  OrtValue ml_value_x;
+  CreateMLValue<float>(cpu_allocator, dims_mul_x, values_mul_x, &ml_value_x);
+  OrtValue ml_value_y;
+  CreateMLValue<float>(cpu_allocator, dims_mul_x, values_mul_x, &ml_value_y);
+  OrtValue ml_value_z;
+  CreateMLValue<float>(cpu_allocator, dims_mul_x, values_mul_x, &ml_value_z);
+  NameMLValMap feeds;
+  feeds.insert(std::make_pair("X", ml_value_x));
+  feeds.insert(std::make_pair("Y", ml_value_y));
+  feeds.insert(std::make_pair("Z", ml_value_z));
+
+  std::vector<std::string> output_names;
+  output_names.push_back("M");
+  std::vector<int64_t> expected_dims_mul_m = {1, 3, 2};
+  std::vector<float> expected_values_mul_m = {3.0f, 6.0f, 9.0f, 12.0f, 15.0f, 18.0f};
+
+  OrtTensorRTProviderOptionsV2 params{};
+  params.trt_max_partition_iterations = 1000;
+  params.trt_min_subgraph_size = 1;
+  params.trt_max_workspace_size = 1 << 30;
+  params.trt_builder_optimization_level = 3;
+  params.trt_auxiliary_streams = -1;
+  params.trt_async_engine_build_enable = 1;
+  std::unique_ptr<IExecutionProvider> execution_provider = TensorrtExecutionProviderWithOptions(&params);
+  EXPECT_TRUE(session_object.RegisterExecutionProvider(std::move(execution_provider)).IsOK());
+  auto status = session_object.Load(model_name);
+  ASSERT_TRUE(status.IsOK());
+  status = session_object.Initialize();
+  ASSERT_TRUE(status.IsOK());
+
+  // The first run starts the engine build and is served by the CUDA EP fallback session. The runs switch to the
+  // engine once it is built, and the outputs must be the same on both paths.
+  for (int i = 0; i < 20; ++i) {
+    RunSession(session_object, run_options, feeds, output_names, expected_dims_mul_m, expected_values_mul_m);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  }
+}
+
+TEST(TensorrtExecutionProviderTest, SharedEngineTest) {
+  std::string model_name = "trt_execution_provider_shared_engine_test.onnx";
+  std::vector<int> dims = {1, 3, 2};
+  CreateBaseModel(model_name, "sharedenginetest", dims);
+
+  SessionOptions so;
+  so.session_logid = "TensorrtExecutionProviderTest.SharedEngineTest";
+  RunOptions run_options;
+  run_options.run_tag = so.session_logid;
+
+  auto cuda_provider = DefaultCudaExecutionProvider();
+  auto cpu_allocator = cuda_provider->CreatePreferredAllocators()[1];
+  std::vector<int64_t> dims_mul_x = {1, 3, 2};
+  std::vector<float> values_mul_x = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+  OrtValue ml_value_x;
+  CreateMLValue<float>(cpu_allocator, dims_mul_x, values_mul_x, &ml_value_x);
+  OrtValue ml_value_y;
+  CreateMLValue<float>(cpu_allocator, dims_mul_x, values_mul_x, &ml_value_y);
+  OrtValue ml_value_z;
+  CreateMLValue<float>(cpu_allocator, dims_mul_x, values_mul_x, &ml_value_z);
+  NameMLValMap feeds;
+  feeds.insert(std::make_pair("X", ml_value_x));
+  feeds.insert(std::make_pair("Y", ml_value_y));
+  feeds.insert(std::make_pair("Z", ml_value_z));
+
+  std::vector<std::string> output_names;
+  output_names.push_back("M");
+  std::vector<int64_t> expected_dims_mul_m = {1, 3, 2};
+  std::vector<float> expected_values_mul_m = {3.0f, 6.0f, 9.0f, 12.0f, 15.0f, 18.0f};
+
+  OrtTensorRTProviderOptionsV2 params{};
+  params.trt_max_partition_iterations = 1000;
+  params.trt_min_subgraph_size = 1;
+  params.trt_max_workspace_size = 1 << 30;
+  params.trt_builder_optimization_level = 3;
+  params.trt_auxiliary_streams = -1;
+  params.trt_engine_cache_enable = 1;
+
+  auto create_session = [&]() {
+    auto session_object = std::make_unique<InferenceSession>(so, GetEnvironment());
+    EXPECT_TRUE(session_object->RegisterExecutionProvider(TensorrtExecutionProviderWithOptions(&params)).IsOK());
+    EXPECT_TRUE(session_object->Load(model_name).IsOK());
+    EXPECT_TRUE(session_object->Initialize().IsOK());
+    return session_object;
+  };
+
+  // The second session shares the engine of the first one, which keeps running on its own execution context after
+  // the first session is released.
+  auto first_session = create_session();
+  auto second_session = create_session();
+  RunSession(*first_session, run_options, feeds, output_names, expected_dims_mul_m, expected_values_mul_m);
+  RunSession(*second_session, run_options, feeds, output_names, expected_dims_mul_m, expected_values_mul_m);
+  first_session.reset();
+  RunSession(*second_session, run_options, feeds, output_names, expected_dims_mul_m, expected_values_mul_m);
+}
+
+TEST(TensorrtExecutionProviderTest, ProfileWarmupTest) {
+  std::string model_name = "trt_execution_provider_profile_warmup_test.onnx";
+  std::vector<int> dims = {1, -1, -1};
+  CreateBaseModel(model_name, "profilewarmuptest", dims);
+
+  SessionOptions so;
+  so.session_logid = "TensorrtExecutionProviderTest.ProfileWarmupTest";
+  RunOptions run_options;
+  run_options.run_tag = so.session_logid;
+  InferenceSession session_object{so, GetEnvironment()};
+
+  OrtTensorRTProviderOptionsV2 params{};
+  params.trt_max_partition_iterations = 1000;
+  params.trt_min_subgraph_size = 1;
+  params.trt_max_workspace_size = 1 << 30;
+  params.trt_builder_optimization_level = 3;
+  params.trt_auxiliary_streams = -1;
+  params.trt_profile_warmup_runs = 8;
+  std::unique_ptr<IExecutionProvider> execution_provider = TensorrtExecutionProviderWithOptions(&params);
+  EXPECT_TRUE(session_object.RegisterExecutionProvider(std::move(execution_provider)).IsOK());
+  auto status = session_object.Load(model_name);
+  ASSERT_TRUE(status.IsOK());
+  status = session_object.Initialize();
+  ASSERT_TRUE(status.IsOK());
+
+  auto cuda_provider = DefaultCudaExecutionProvider();
+  auto cpu_allocator = cuda_provider->CreatePreferredAllocators()[1];
+  std::vector<std::string> output_names;
+  output_names.push_back("M");
+
+  // The first 8 runs are the warm-up, whose shapes are clustered into the profiles. The later runs use the profiles,
+  // and the last shape widens one of them.
+  const std::vector<int64_t> sequence_lengths = {2, 3, 2, 64, 60, 3, 62, 2, 3, 64, 2, 61, 128};
+  for (auto sequence_length : sequence_lengths) {
+    std::vector<int64_t> dims_mul_x = {1, sequence_length, 2};
+    std::vector<float> values_mul_x(static_cast<size_t>(sequence_length * 2));
+    std::vector<float> expected_values_mul_m(values_mul_x.size());
+    for (size_t i = 0; i < values_mul_x.size(); ++i) {
+      values_mul_x[i] = static_cast<float>(i % 7);
+      expected_values_mul_m[i] = 3.0f * values_mul_x[i];
+    }
+    OrtValue ml_value_x;
+    CreateMLValue<float>(cpu_allocator, dims_mul_x, values_mul_x, &ml_value_x);
+    OrtValue ml_value_y;
+    CreateMLValue<float>(cpu_allocator, dims_mul_x, values_mul_x, &ml_value_y);
+    OrtValue ml_value_z;
+    CreateMLValue<float>(cpu_allocator, dims_mul_x, values_mul_x, &ml_value_z);
+    NameMLValMap feeds;
+    feeds.insert(std::make_pair("X", ml_value_x));
+    feeds.insert(std::make_pair("Y", ml_value_y));
+    feeds.insert(std::make_pair("Z", ml_value_z));
+    RunSession(session_object, run_options, feeds, output_names, dims_mul_x, expected_values_mul_m);
+  }
+}
+
 TEST(TensorrtExecutionProviderTest, DISABLED_NodeIndexMappingTest) {  //  [W:onnxruntime:TensorrtExecutionProviderTest.NodeIndexMappingTest, model_load_utils.h:58 ValidateOpsetForDomain] ONNX Runtime only *guarantees* support for models stamped with official released onnx opset versions. Opset 19 is under development and support for this is limited. The operator schemas and or other functionality could possibly change before next ONNX release and in this case ONNX Runtime will not guarantee backward compatibility. Current official support for domain ai.onnx is till opset 18.
   onnxruntime::Model model("nodeindexmappingtest", false, DefaultLoggingManager().DefaultLogger());
   auto& graph = model.MainGraph();
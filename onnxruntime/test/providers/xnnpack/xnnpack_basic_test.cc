@@ -123,6 +123,19 @@ TEST(XnnpackEP, TestAllocatorSharing) {
   // TODO(leca): should also check there is only 1 allocator in session1.GetSessionState().GetAllocators() which is used by both xnnpack EP and CPU EP
 }
 
+// EP instances that ask for the same number of threads should share one pthreadpool
+TEST(XnnpackEP, TestThreadPoolSharing) {
+  const ProviderOptions provider_options{{"intra_op_num_threads", "2"}};
+  XnnpackExecutionProvider ep1(XnnpackExecutionProviderInfo{provider_options, nullptr});
+  XnnpackExecutionProvider ep2(XnnpackExecutionProviderInfo{provider_options, nullptr});
+  ASSERT_NE(ep1.GetPrivateThreadPool(), nullptr);
+  ASSERT_EQ(ep1.GetPrivateThreadPool(), ep2.GetPrivateThreadPool());
+
+  const ProviderOptions other_provider_options{{"intra_op_num_threads", "3"}};
+  XnnpackExecutionProvider ep3(XnnpackExecutionProviderInfo{other_provider_options, nullptr});
+  ASSERT_NE(ep1.GetPrivateThreadPool(), ep3.GetPrivateThreadPool());
+}
+
 TEST(XnnpackEP, TestAddEpUsingPublicApi) {
   {
     // C++ API test
@@ -372,6 +385,46 @@ TEST(XnnpackEP, TestSoftMax_axisLast) {
                {ExpectedEPNodeAssignment::All});
 }
 
+TEST(XnnpackEP, TestBinaryElementwise) {
+  // the second input of each op is broadcast
+  auto modelCreater = [](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({1, 3, 4, 5}, -10.f, 10.f);
+    auto* add_arg = builder.MakeInput<float>({5}, -10.f, 10.f);
+    auto* sub_arg = builder.MakeInput<float>({3, 1, 1}, -10.f, 10.f);
+    auto* mul_arg = builder.MakeInput<float>({1, 1, 4, 1}, -10.f, 10.f);
+    auto* div_arg = builder.MakeInput<float>({1, 3, 4, 5}, 1.f, 10.f);
+
+    auto* add_out = builder.MakeIntermediate();
+    auto* sub_out = builder.MakeIntermediate();
+    auto* mul_out = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+
+    builder.AddNode("Add", {input_arg, add_arg}, {add_out});
+    builder.AddNode("Sub", {add_out, sub_arg}, {sub_out});
+    builder.AddNode("Mul", {mul_arg, sub_out}, {mul_out});
+    builder.AddNode("Div", {mul_out, div_arg}, {output_arg});
+  };
+  RunModelTest(modelCreater,
+               "xnnpack_test_graph_binary_elementwise",
+               {ExpectedEPNodeAssignment::All});
+}
+
+TEST(XnnpackEP, TestTranspose) {
+  auto modelCreater = [](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({2, 3, 4, 5}, -10.f, 10.f);
+    auto* transpose_out = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+
+    Node& transpose_node = builder.AddNode("Transpose", {input_arg}, {transpose_out});
+    transpose_node.AddAttribute("perm", std::vector<int64_t>{0, 3, 1, 2});
+    // no perm reverses the dims
+    builder.AddNode("Transpose", {transpose_out}, {output_arg});
+  };
+  RunModelTest(modelCreater,
+               "xnnpack_test_graph_transpose",
+               {ExpectedEPNodeAssignment::All});
+}
+
 TEST(XnnpackEP, TestQDQSoftMax_axisLast) {
   RunModelTest(BuildQDQSoftMaxTestCase<uint8_t, uint8_t>(
                    {1, 2, 3, 5} /* input_shape */,
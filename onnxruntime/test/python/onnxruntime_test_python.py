@@ -538,6 +538,35 @@ class TestInferenceSession(unittest.TestCase):
         output_expected = np.array([[1.0, 4.0], [9.0, 16.0], [25.0, 36.0]], dtype=np.float32)
         np.testing.assert_allclose(output_expected, res[0], rtol=1e-05, atol=1e-08)
 
+    def testRunModelWithOutputBuffers(self):  # noqa: N802
+        sess = onnxrt.InferenceSession(get_name("mul_1.onnx"), providers=["CPUExecutionProvider"])
+        x = np.array([[1.0, 2.0], [3.0, 4.0], [5.0, 6.0]], dtype=np.float32)
+        y = np.zeros((3, 2), dtype=np.float32)
+        res = sess.run(["Y"], {"X": x}, output_buffers={"Y": y})
+        output_expected = np.array([[1.0, 4.0], [9.0, 16.0], [25.0, 36.0]], dtype=np.float32)
+        self.assertIs(res[0], y)
+        np.testing.assert_allclose(output_expected, y, rtol=1e-05, atol=1e-08)
+
+        # a buffer ORT cannot write to in place is rejected
+        with self.assertRaises(RuntimeError):
+            sess.run(["Y"], {"X": x}, output_buffers={"Y": np.zeros((2, 3), dtype=np.float32).T})
+
+    def testRunModelBatch(self):  # noqa: N802
+        so = onnxrt.SessionOptions()
+        so.intra_op_num_threads = 2
+        sess = onnxrt.InferenceSession(get_name("mul_1.onnx"), so, providers=["CPUExecutionProvider"])
+        xs = [np.full((3, 2), i, dtype=np.float32) for i in range(5)]
+        res = sess.run_batch(["Y"], [{"X": x} for x in xs])
+        self.assertEqual(len(res), len(xs))
+        for x, r in zip(xs, res):
+            np.testing.assert_allclose(x * x, r[0], rtol=1e-05, atol=1e-08)
+
+        self.assertEqual(sess.run_batch(["Y"], []), [])
+
+        # an error in any of the runs is raised
+        with self.assertRaises(Exception):
+            sess.run_batch(["Y"], [{"X": xs[0]}, {"X": np.zeros((2, 2), dtype=np.float32)}])
+
     def testRunModelFromBytes(self):  # noqa: N802
         with open(get_name("mul_1.onnx"), "rb") as f:
             content = f.read()
@@ -8,6 +8,7 @@
 #include <sstream>
 #include <atomic>
 #include <mutex>
+#include <condition_variable>
 #include <algorithm>
 #include <thread>
 
@@ -1548,6 +1549,151 @@ TEST(CApiTest, get_allocator_cpu) {
   ASSERT_EQ(1024U, mem_allocation.size());
 }
 
+namespace {
+struct RunAsyncResult {
+  std::mutex mutex;
+  std::condition_variable cv;
+  bool done = false;
+  size_t num_outputs = 0;
+  std::vector<float> values;
+  std::string error;
+};
+
+void RunAsyncCallback(void* user_data, OrtValue** outputs, size_t num_outputs, OrtStatusPtr status) {
+  auto* result = reinterpret_cast<RunAsyncResult*>(user_data);
+  std::lock_guard<std::mutex> lock(result->mutex);
+  if (status != nullptr) {
+    Ort::Status s(status);
+    result->error = s.GetErrorMessage();
+  } else {
+    result->num_outputs = num_outputs;
+    Ort::Value output(outputs[0]);
+    const float* data = output.GetTensorData<float>();
+    result->values.assign(data, data + output.GetTensorTypeAndShapeInfo().GetElementCount());
+    outputs[0] = nullptr;
+  }
+  result->done = true;
+  result->cv.notify_one();
+}
+}  // namespace
+
+TEST(CApiTest, RunAsync) {
+  Ort::SessionOptions session_options;
+  session_options.SetIntraOpNumThreads(2);
+  Ort::Session session(*ort_env, MODEL_URI, session_options);
+
+  std::vector<float> x_values = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+  std::vector<int64_t> x_dims = {3, 2};
+  auto memory_info = Ort::MemoryInfo::CreateCpu(OrtDeviceAllocator, OrtMemTypeCPU);
+  Ort::Value x = Ort::Value::CreateTensor<float>(memory_info, x_values.data(), x_values.size(),
+                                                 x_dims.data(), x_dims.size());
+
+  const char* input_names[] = {"X"};
+  const char* output_names[] = {"Y"};
+  Ort::Value outputs[1] = {Ort::Value{nullptr}};
+
+  RunAsyncResult result;
+  session.RunAsync(Ort::RunOptions{nullptr}, input_names, &x, 1, output_names, outputs, 1,
+                   RunAsyncCallback, &result);
+
+  std::unique_lock<std::mutex> lock(result.mutex);
+  result.cv.wait(lock, [&result]() { return result.done; });
+
+  ASSERT_TRUE(result.error.empty()) << result.error;
+  ASSERT_EQ(result.num_outputs, 1U);
+  ASSERT_THAT(result.values, ::testing::ElementsAre(1.0f, 4.0f, 9.0f, 16.0f, 25.0f, 36.0f));
+}
+
+TEST(CApiTest, RunAsyncRequiresWorkerThread) {
+  Ort::SessionOptions session_options;
+  session_options.SetIntraOpNumThreads(1);
+  Ort::Session session(*ort_env, MODEL_URI, session_options);
+
+  std::vector<float> x_values = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+  std::vector<int64_t> x_dims = {3, 2};
+  auto memory_info = Ort::MemoryInfo::CreateCpu(OrtDeviceAllocator, OrtMemTypeCPU);
+  Ort::Value x = Ort::Value::CreateTensor<float>(memory_info, x_values.data(), x_values.size(),
+                                                 x_dims.data(), x_dims.size());
+
+  const char* input_names[] = {"X"};
+  const char* output_names[] = {"Y"};
+  Ort::Value outputs[1] = {Ort::Value{nullptr}};
+
+  RunAsyncResult result;
+  EXPECT_THROW(session.RunAsync(Ort::RunOptions{nullptr}, input_names, &x, 1, output_names, outputs, 1,
+                                RunAsyncCallback, &result),
+               Ort::Exception);
+}
+
+TEST(CApiTest, RunPrepared) {
+  Ort::Session session(*ort_env, MODEL_URI, Ort::SessionOptions{});
+
+  const char* input_names[] = {"X"};
+  const char* output_names[] = {"Y"};
+  Ort::PreparedRun prepared_run(session, input_names, 1, output_names, 1);
+
+  std::vector<float> x_values = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+  std::vector<int64_t> x_dims = {3, 2};
+  auto memory_info = Ort::MemoryInfo::CreateCpu(OrtDeviceAllocator, OrtMemTypeCPU);
+  Ort::Value x = Ort::Value::CreateTensor<float>(memory_info, x_values.data(), x_values.size(),
+                                                 x_dims.data(), x_dims.size());
+
+  // output allocated by the run
+  Ort::Value outputs[1] = {Ort::Value{nullptr}};
+  session.Run(Ort::RunOptions{nullptr}, prepared_run, &x, 1, outputs, 1);
+  const float* y = outputs[0].GetTensorData<float>();
+  ASSERT_THAT(std::vector<float>(y, y + 6), ::testing::ElementsAre(1.0f, 4.0f, 9.0f, 16.0f, 25.0f, 36.0f));
+
+  // preallocated output, with new input values
+  x_values = {2.0f, 2.0f, 2.0f, 2.0f, 2.0f, 2.0f};
+  std::vector<float> y_values(6);
+  Ort::Value preallocated[1] = {Ort::Value::CreateTensor<float>(memory_info, y_values.data(), y_values.size(),
+                                                                x_dims.data(), x_dims.size())};
+  session.Run(Ort::RunOptions{nullptr}, prepared_run, &x, 1, preallocated, 1);
+  ASSERT_THAT(y_values, ::testing::ElementsAre(4.0f, 4.0f, 4.0f, 4.0f, 4.0f, 4.0f));
+
+  // the number of inputs must match the prepared run
+  EXPECT_THROW(session.Run(Ort::RunOptions{nullptr}, prepared_run, &x, 0, preallocated, 1), Ort::Exception);
+
+  const char* invalid_names[] = {"Z"};
+  EXPECT_THROW(Ort::PreparedRun(session, invalid_names, 1, output_names, 1), Ort::Exception);
+  EXPECT_THROW(Ort::PreparedRun(session, input_names, 1, invalid_names, 1), Ort::Exception);
+}
+
+TEST(CApiTest, RunSessionPipeline) {
+  // each stage squares its input
+  Ort::Session session1(*ort_env, MODEL_URI, Ort::SessionOptions{});
+  Ort::Session session2(*ort_env, MODEL_URI, Ort::SessionOptions{});
+  Ort::Session* sessions[] = {&session1, &session2};
+  Ort::SessionPipeline::Link links[] = {{0, "Y", 1, "X"}};
+  Ort::SessionPipeline pipeline(sessions, 2, links, 1);
+
+  std::vector<float> x_values = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+  std::vector<int64_t> x_dims = {3, 2};
+  auto memory_info = Ort::MemoryInfo::CreateCpu(OrtDeviceAllocator, OrtMemTypeCPU);
+  Ort::Value x = Ort::Value::CreateTensor<float>(memory_info, x_values.data(), x_values.size(),
+                                                 x_dims.data(), x_dims.size());
+
+  // Y is the output of the last stage that has an output with that name
+  const char* input_names[] = {"X"};
+  const char* output_names[] = {"Y"};
+  auto outputs = pipeline.Run(Ort::RunOptions{nullptr}, input_names, &x, 1, output_names, 1);
+  ASSERT_EQ(outputs.size(), 1u);
+  const float* y = outputs[0].GetTensorData<float>();
+  ASSERT_THAT(std::vector<float>(y, y + 6),
+              ::testing::ElementsAre(1.0f, 16.0f, 81.0f, 256.0f, 625.0f, 1296.0f));
+
+  const char* invalid_names[] = {"Z"};
+  EXPECT_THROW(pipeline.Run(Ort::RunOptions{nullptr}, invalid_names, &x, 1, output_names, 1), Ort::Exception);
+  EXPECT_THROW(pipeline.Run(Ort::RunOptions{nullptr}, input_names, &x, 1, invalid_names, 1), Ort::Exception);
+
+  // outputs can only be linked to existing inputs of later stages
+  Ort::SessionPipeline::Link backward_links[] = {{1, "Y", 0, "X"}};
+  EXPECT_THROW(Ort::SessionPipeline(sessions, 2, backward_links, 1), Ort::Exception);
+  Ort::SessionPipeline::Link invalid_links[] = {{0, "Y", 1, "Z"}};
+  EXPECT_THROW(Ort::SessionPipeline(sessions, 2, invalid_links, 1), Ort::Exception);
+}
+
 #ifdef USE_CUDA
 TEST(CApiTest, get_allocator_cuda) {
   Ort::SessionOptions session_options;
@@ -1859,6 +2005,80 @@ TEST(CApiTest, cuda_graph_with_shape_nodes) {
   Ort::Session session(*ort_env, TSTR("testdata/cuda_graph_with_shape_nodes.onnx"), session_options);
 }
 
+TEST(CApiTest, cuda_graph_with_multiple_input_shapes) {
+  const auto& api = Ort::GetApi();
+
+  // With one graph at most, alternating the shapes destroys and captures the graphs again.
+  for (const char* max_graphs : {"1", "2"}) {
+    OrtCUDAProviderOptionsV2* cuda_options = nullptr;
+    ASSERT_TRUE(api.CreateCUDAProviderOptions(&cuda_options) == nullptr);
+    std::unique_ptr<OrtCUDAProviderOptionsV2, decltype(api.ReleaseCUDAProviderOptions)>
+        rel_cuda_options(cuda_options, api.ReleaseCUDAProviderOptions);
+    std::vector<const char*> keys{"enable_cuda_graph", "cuda_graph_max_graphs"};
+    std::vector<const char*> values{"1", max_graphs};
+    ASSERT_TRUE(api.UpdateCUDAProviderOptions(rel_cuda_options.get(), keys.data(), values.data(), keys.size()) ==
+                nullptr);
+
+    Ort::SessionOptions session_options;
+    ASSERT_TRUE(api.SessionOptionsAppendExecutionProvider_CUDA_V2(
+                    static_cast<OrtSessionOptions*>(session_options),
+                    rel_cuda_options.get()) == nullptr);
+
+    // y = Abs(x), x has the shape (Dim1, Dim2, 5)
+    Ort::Session session(*ort_env, TSTR("testdata/abs_free_dimensions.onnx"), session_options);
+    Ort::MemoryInfo info_cuda("Cuda", OrtAllocatorType::OrtArenaAllocator, 0, OrtMemTypeDefault);
+    Ort::Allocator cuda_allocator(session, info_cuda);
+
+    // the bound buffers of each shape must stay at the same addresses for the replays of its graph
+    struct ShapeBinding {
+      std::array<int64_t, 3> shape;
+      size_t size;
+      Ort::MemoryAllocation input_data;
+      Ort::MemoryAllocation output_data;
+      Ort::IoBinding binding;
+    };
+    std::vector<ShapeBinding> bindings;
+    for (const auto& shape : {std::array<int64_t, 3>{1, 2, 5}, std::array<int64_t, 3>{2, 3, 5}}) {
+      const size_t size = static_cast<size_t>(shape[0] * shape[1] * shape[2]);
+      bindings.push_back({shape, size, cuda_allocator.GetAllocation(size * sizeof(float)),
+                          cuda_allocator.GetAllocation(size * sizeof(float)), Ort::IoBinding(session)});
+      auto& shape_binding = bindings.back();
+      shape_binding.binding.BindInput(
+          "x", Ort::Value::CreateTensor(info_cuda, reinterpret_cast<float*>(shape_binding.input_data.get()), size,
+                                        shape.data(), shape.size()));
+      shape_binding.binding.BindOutput(
+          "y", Ort::Value::CreateTensor(info_cuda, reinterpret_cast<float*>(shape_binding.output_data.get()), size,
+                                        shape.data(), shape.size()));
+    }
+
+    for (int iteration = 0; iteration < 3; ++iteration) {
+      for (auto& shape_binding : bindings) {
+        std::vector<float> x_values(shape_binding.size);
+        std::vector<float> expected_y(shape_binding.size);
+        for (size_t i = 0; i < shape_binding.size; ++i) {
+          x_values[i] = -static_cast<float>(i + iteration);
+          expected_y[i] = static_cast<float>(i + iteration);
+        }
+        cudaMemcpy(shape_binding.input_data.get(), x_values.data(), sizeof(float) * x_values.size(),
+                   cudaMemcpyHostToDevice);
+        shape_binding.binding.SynchronizeInputs();
+
+        session.Run(Ort::RunOptions(), shape_binding.binding);
+
+        std::vector<float> y_values(shape_binding.size);
+        cudaMemcpy(y_values.data(), shape_binding.output_data.get(), sizeof(float) * y_values.size(),
+                   cudaMemcpyDeviceToHost);
+        ASSERT_THAT(y_values, ::testing::ContainerEq(expected_y));
+      }
+    }
+
+    for (auto& shape_binding : bindings) {
+      shape_binding.binding.ClearBoundInputs();
+      shape_binding.binding.ClearBoundOutputs();
+    }
+  }
+}
+
 #endif
 
 TEST(CApiTest, create_tensor) {
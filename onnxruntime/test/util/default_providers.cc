@@ -95,13 +95,17 @@ std::unique_ptr<IExecutionProvider> DefaultOpenVINOExecutionProvider() {
 #endif
 }
 
-std::unique_ptr<IExecutionProvider> DefaultCudaExecutionProvider() {
+std::unique_ptr<IExecutionProvider> DefaultCudaExecutionProvider(bool test_tunable_op) {
 #ifdef USE_CUDA
   OrtCUDAProviderOptions provider_options{};
   provider_options.do_copy_in_default_stream = true;
+  provider_options.tunable_op_enable = test_tunable_op ? 1 : 0;
+  provider_options.tunable_op_tuning_enable = test_tunable_op ? 1 : 0;
+  provider_options.tunable_op_max_tuning_duration_ms = 0;
   if (auto factory = CudaProviderFactoryCreator::Create(&provider_options))
     return factory->CreateProvider();
 #endif
+  ORT_UNUSED_PARAMETER(test_tunable_op);
   return nullptr;
 }
 
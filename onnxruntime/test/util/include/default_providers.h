@@ -35,7 +35,7 @@ namespace test {
 
 // unique_ptr providers with default values for session registration
 std::unique_ptr<IExecutionProvider> DefaultCpuExecutionProvider(bool enable_arena = true);
-std::unique_ptr<IExecutionProvider> DefaultCudaExecutionProvider();
+std::unique_ptr<IExecutionProvider> DefaultCudaExecutionProvider(bool test_tunable_op = false);
 std::unique_ptr<IExecutionProvider> CudaExecutionProviderWithOptions(const OrtCUDAProviderOptionsV2* provider_options);
 std::unique_ptr<IExecutionProvider> DefaultDnnlExecutionProvider();
 std::unique_ptr<IExecutionProvider> DnnlExecutionProviderWithOptions(const OrtDnnlProviderOptions* provider_options);
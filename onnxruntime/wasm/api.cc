@@ -63,13 +63,16 @@ OrtErrorCode CheckStatus(OrtStatusPtr status) {
 // unregister the auto release wrapper
 #define UNREGISTER_AUTO_RELEASE(var) auto_release_##var.release()
 
-int OrtInit(int num_threads, int logging_level) {
+int OrtInit(int num_threads, bool allow_spinning, int logging_level) {
   // Assume that a logging level is check and properly set at JavaScript
 #if defined(__EMSCRIPTEN_PTHREADS__)
   OrtThreadingOptions* tp_options = nullptr;
   RETURN_ERROR_CODE_IF_ERROR(CreateThreadingOptions, &tp_options);
   RETURN_ERROR_CODE_IF_ERROR(SetGlobalIntraOpNumThreads, tp_options, num_threads);
   RETURN_ERROR_CODE_IF_ERROR(SetGlobalInterOpNumThreads, tp_options, 1);
+  // The worker threads are Web Workers that share the CPU with the main thread and the rest of the page. Spinning
+  // keeps the latency between parallel sections low, but burns cores that the page could use otherwise.
+  RETURN_ERROR_CODE_IF_ERROR(SetGlobalSpinControl, tp_options, allow_spinning ? 1 : 0);
 
   return CHECK_STATUS(CreateEnvWithGlobalThreadPools,
                       static_cast<OrtLoggingLevel>(logging_level),
@@ -77,6 +80,7 @@ int OrtInit(int num_threads, int logging_level) {
                       tp_options,
                       &g_env);
 #else
+  (void)allow_spinning;
   return CHECK_STATUS(CreateEnv, static_cast<OrtLoggingLevel>(logging_level), "Default", &g_env);
 #endif
 }
@@ -29,10 +29,11 @@ extern "C" {
 /**
  * perform global initialization. should be called only once.
  * @param num_threads number of total threads to use.
+ * @param allow_spinning whether the worker threads spin before they wait for more work.
  * @param logging_level default logging level.
  * @returns ORT error code. If not zero, call OrtGetLastError() to get detailed error message.
  */
-int EMSCRIPTEN_KEEPALIVE OrtInit(int num_threads, int logging_level);
+int EMSCRIPTEN_KEEPALIVE OrtInit(int num_threads, bool allow_spinning, int logging_level);
 
 /**
  * get the last error.
@@ -54,6 +54,7 @@ static std::unordered_map<std::string, std::unordered_set<size_t>>
         {"SparseSoftmaxCrossEntropy", {1, 2}},
         {"SoftmaxCrossEntropyLoss", {1, 2}},
         {"SoftmaxCrossEntropyLossInternal", {1, 2, 3}},
+        {"MatMulSoftmaxCrossEntropyLossInternal", {2, 3, 4}},
         {"ConstantOfShape", {0}},
         {"Scatter", {1}},
         {"ScatterElements", {1}},
@@ -3,6 +3,10 @@
 
 #include "orttraining/core/graph/allreduce_optimizer_graph_builder.h"
 
+#include <algorithm>
+#include <numeric>
+
+#include "core/graph/graph_viewer.h"
 #include "orttraining/core/framework/distributed_run_context.h"
 
 namespace onnxruntime {
@@ -19,7 +23,8 @@ static bool IsNcclAvailable() {
 static Status AddNcclAllReduceForGradients(
     std::vector<ArgDef>& gradient_argdefs,
     std::vector<ArgDef>& input_gradient_argdef,
-    GraphAugmenter::GraphDefs& graph_defs) {
+    GraphAugmenter::GraphDefs& graph_defs,
+    const std::string& node_name = "NcclAllReduce") {
   std::vector<ArgDef> allreduce_outputs(gradient_argdefs.size());
   for (size_t i = 0; i < gradient_argdefs.size(); i++) {
     TypeProto* allreduced_gradient_type_proto = graph_defs.CopyTypeProto(gradient_argdefs[i]);
@@ -35,12 +40,70 @@ static Status AddNcclAllReduceForGradients(
                                   allreduce_outputs,
                                   {ONNX_NAMESPACE::MakeAttribute("group_type",
                                                                  static_cast<int64_t>(WorkerGroupType::DataParallel))},
-                                  "NcclAllReduce")});
+                                  node_name)});
 
   gradient_argdefs = allreduce_outputs;
   return Status::OK();
 }
 
+// Splits the gradients into buckets of at least bucket_size_in_bytes, in the order the backward pass produces
+// them. Returns the indices of the gradients of every bucket.
+static std::vector<std::vector<size_t>> BucketGradients(
+    const Graph& graph,
+    const std::vector<ArgDef>& gradient_argdefs,
+    int64_t bucket_size_in_bytes,
+    int64_t element_size) {
+  std::vector<size_t> node_positions(graph.MaxNodeIndex(), 0);
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+  for (size_t i = 0; i < node_topology_list.size(); ++i) {
+    node_positions[node_topology_list[i]] = i + 1;
+  }
+
+  // Gradients without a producer, like graph inputs, are ready first.
+  std::vector<size_t> gradient_positions(gradient_argdefs.size(), 0);
+  for (size_t i = 0; i < gradient_argdefs.size(); ++i) {
+    const Node* producer = graph.GetProducerNode(gradient_argdefs[i].name);
+    if (producer != nullptr) {
+      gradient_positions[i] = node_positions[producer->Index()];
+    }
+  }
+
+  std::vector<size_t> gradient_order(gradient_argdefs.size());
+  std::iota(gradient_order.begin(), gradient_order.end(), 0);
+  std::stable_sort(gradient_order.begin(), gradient_order.end(), [&gradient_positions](size_t lhs, size_t rhs) {
+    return gradient_positions[lhs] < gradient_positions[rhs];
+  });
+
+  std::vector<std::vector<size_t>> buckets(1);
+  int64_t bucket_size = 0;
+  for (size_t gradient_index : gradient_order) {
+    if (bucket_size >= bucket_size_in_bytes) {
+      buckets.emplace_back();
+      bucket_size = 0;
+    }
+    buckets.back().push_back(gradient_index);
+
+    // A gradient of unknown size fills its bucket.
+    const auto* type_proto = gradient_argdefs[gradient_index].type_proto;
+    if (type_proto == nullptr || !type_proto->tensor_type().has_shape()) {
+      bucket_size = bucket_size_in_bytes;
+      continue;
+    }
+    int64_t gradient_size = element_size;
+    for (const auto& dim : type_proto->tensor_type().shape().dim()) {
+      if (!dim.has_dim_value()) {
+        gradient_size = bucket_size_in_bytes;
+        break;
+      }
+      gradient_size *= dim.dim_value();
+    }
+    bucket_size += gradient_size;
+  }
+
+  return buckets;
+}
+
 AllreduceOptimizerGraphBuilder::AllreduceOptimizerGraphBuilder(
     const OptimizerBuilderRegistry& opt_builder_registry,
     const OptimizerGraphConfig& opt_graph_config,
@@ -80,10 +143,39 @@ Status AllreduceOptimizerGraphBuilder::BuildInternal(
       opt_graph_config_.gradient_accumulation_steps * opt_graph_config_.data_parallel_group_size;
   ORT_RETURN_IF_NOT(total_num_accumulations > 0, "total_num_accumulations <= 0");
   const float scale = 1.0f / total_num_accumulations;
-  ORT_RETURN_IF_ERROR(AddGradientScalingNodes(nodearg_name_generator, scale, gradient_argdefs, output_gradient_argdef, graph_defs,
-                                              opt_graph_config_.AllReduceDataType()));
-
-  ORT_RETURN_IF_ERROR(AddNcclAllReduceForGradients(gradient_argdefs, output_gradient_argdef, graph_defs));
+  if (opt_graph_config_.allreduce_bucket_size_in_bytes > 0) {
+    // One scaling and all-reduce per bucket, so that each all-reduce only waits for the gradients of its bucket
+    // and overlaps with the computation of the other gradients.
+    const int64_t element_size =
+        opt_graph_config_.AllReduceDataType() == ONNX_NAMESPACE::TensorProto_DataType_FLOAT ? 4 : 2;
+    const auto buckets = BucketGradients(graph, gradient_argdefs, opt_graph_config_.allreduce_bucket_size_in_bytes,
+                                         element_size);
+
+    std::vector<ArgDef> allreduced_gradient_argdefs(gradient_argdefs.size());
+    for (const auto& bucket : buckets) {
+      std::vector<ArgDef> bucket_gradient_argdefs;
+      for (size_t gradient_index : bucket) {
+        bucket_gradient_argdefs.push_back(gradient_argdefs[gradient_index]);
+      }
+
+      std::vector<ArgDef> bucket_output_gradient_argdefs;
+      ORT_RETURN_IF_ERROR(AddGradientScalingNodes(nodearg_name_generator, scale, bucket_gradient_argdefs,
+                                                  bucket_output_gradient_argdefs, graph_defs,
+                                                  opt_graph_config_.AllReduceDataType()));
+      ORT_RETURN_IF_ERROR(AddNcclAllReduceForGradients(bucket_gradient_argdefs, bucket_output_gradient_argdefs,
+                                                       graph_defs, graph.GenerateNodeName("NcclAllReduce")));
+
+      for (size_t i = 0; i < bucket.size(); ++i) {
+        allreduced_gradient_argdefs[bucket[i]] = bucket_gradient_argdefs[i];
+      }
+    }
+    gradient_argdefs = std::move(allreduced_gradient_argdefs);
+  } else {
+    ORT_RETURN_IF_ERROR(AddGradientScalingNodes(nodearg_name_generator, scale, gradient_argdefs, output_gradient_argdef,
+                                                graph_defs, opt_graph_config_.AllReduceDataType()));
+
+    ORT_RETURN_IF_ERROR(AddNcclAllReduceForGradients(gradient_argdefs, output_gradient_argdef, graph_defs));
+  }
 
   // check if all gradients are finite
   ArgDef global_grad_norm_argdef;
@@ -1270,6 +1270,22 @@ IMPLEMENT_GRADIENT_BUILDER(GetSoftmaxCrossEntropyLossInternalGradient) {
       NodeDef(OpDef{"SoftmaxCrossEntropyLossInternalGrad", kMSDomain, 1}, input_arg_def, {GI(0)}, attrs)};
 }
 
+IMPLEMENT_GRADIENT_BUILDER(GetMatMulSoftmaxCrossEntropyLossInternalGradient) {
+  // The gradient recomputes the scores from X and W, using the log-sum-exp kept by the forward pass.
+  std::vector<ArgDef> input_arg_def{GO(0), I(0), I(1), O(1), I(2)};
+  for (int i = 3; i < GetSrcNodeInputSize(); i++) {
+    input_arg_def.emplace_back(I(i));
+  }
+
+  std::vector<ArgDef> output_arg_def;
+  for (int i = 0; i < 2; ++i) {
+    output_arg_def.emplace_back(IsGradientRequiredForSrcNodeInput(i) ? GI(i) : ArgDef());
+  }
+
+  return std::vector<NodeDef>{NodeDef(OpDef{"MatMulSoftmaxCrossEntropyLossInternalGrad", kMSDomain, 1},
+                                      input_arg_def, output_arg_def, SrcNodeAttributes())};
+}
+
 IMPLEMENT_GRADIENT_BUILDER(GetGlobalAveragePoolGradient) {
   const ArgDef X = I(0), Y = O(0), dX = GI(0), dY = GO(0);
 
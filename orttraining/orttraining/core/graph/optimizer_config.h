@@ -73,6 +73,9 @@ struct OptimizerGraphConfig {
   std::string loss_scale_input_name{};  // empty string means no loss scaling factor is applied
   AdasumReductionType adasum_reduction_type{AdasumReductionType::None};
   bool enable_grad_norm_clip{true};
+  // Size of the buckets the gradients are all-reduced in, so that the all-reduce of the gradients the
+  // backward pass produces first overlaps with the rest of it. 0 all-reduces all the gradients at once.
+  int64_t allreduce_bucket_size_in_bytes{0};
 
   NameMLValMap shared_optimizer_states{};  // initial states for shared params, eg. 'Step' for lamb
 
@@ -1182,6 +1182,40 @@ void RegisterTrainingOpSchemas() {
           {"tensor(int32)", "tensor(int64)"},
           "Constrain indices to integer types");
 
+  ONNX_CONTRIB_OPERATOR_SCHEMA(GatherSparseGrad)
+      .SetDomain(kMSDomain)
+      .SinceVersion(1)
+      .SetDoc(
+          "The gradient of Gather along axis 0 as the rows of X it touches, instead of a dense tensor of the shape "
+          "of X. The rows are sorted by index and the gradients of repeated indices are summed, so the op also "
+          "coalesces row gradients concatenated from several ranks, e.g. after an all-gather.")
+      .Input(0, "shape", "Shape of the Gather input X.", "I")
+      .Input(1, "indices", "Tensor of int32/int64 indices, of any rank q.", "Tind")
+      .Input(2, "dY", "Gradient of output, of shape indices.shape + X.shape[1:].", "T")
+      .Output(0, "grad_indices", "The distinct indices of the rows of X with a gradient, in increasing order.",
+              "I64")
+      .Output(1, "grad_values", "The gradients of the rows in grad_indices, of shape [R] + X.shape[1:].", "T")
+      .TypeConstraint(
+          "I",
+          {"tensor(int32)", "tensor(int64)"},
+          "Constrain input shape to integer tensors.")
+      .TypeConstraint(
+          "I64",
+          {"tensor(int64)"},
+          "Constrain output indices to 64-bit integer tensors.")
+      .TypeConstraint(
+          "T",
+          {"tensor(float)", "tensor(double)"},
+          "Constrain input and output types to float tensors.")
+      .TypeConstraint(
+          "Tind",
+          {"tensor(int32)", "tensor(int64)"},
+          "Constrain indices to integer types")
+      .TypeAndShapeInferenceFunction([](InferenceContext& ctx) {
+        updateOutputElemType(ctx, 0, ONNX_NAMESPACE::TensorProto::INT64);
+        propagateElemTypeFromInputToOutput(ctx, 2, 1);
+      });
+
   ONNX_CONTRIB_OPERATOR_SCHEMA(GatherElementsGrad)
       .SetDomain(kMSDomain)
       .SinceVersion(1)
@@ -1336,6 +1370,36 @@ void RegisterTrainingOpSchemas() {
         }
       });
 
+  ONNX_CONTRIB_OPERATOR_SCHEMA(SparseSGDOptimizer)
+      .SetDomain(kMSDomain)
+      .SinceVersion(1)
+      .SetDoc("SGDOptimizerV2 for one weight whose gradient is given by rows, as produced by GatherSparseGrad. "
+              "Only the rows with a gradient are read and written.")
+      .Input(0, "lr", "The learning rate.", "T1")
+      .Input(1, "weight", "The weight to optimize.", "T")
+      .Input(2, "grad_indices", "The distinct indices of the rows of the weight with a gradient.", "T_INDEX")
+      .Input(3, "grad_values", "The gradients of the rows in grad_indices.", "T")
+      .Input(4, "update_signal",
+             "This signal indicates if weight needs to be updated, applicable to gradient infinity check"
+             " in mixed precision training. If not provided or its value is True, weights will be updated.",
+             "T_BOOL", OpSchema::Optional)
+      .Output(0, "update_completed", "Whether gradient is applied or not.", "T_BOOL")
+      .Output(1, "updated_weight", "The weight after optimize.", "T", OpSchema::Optional)
+      .TypeConstraint("T1", {"tensor(float)"}, "Constrain learning rate to float")
+      .TypeConstraint("T", {"tensor(float)"}, "Constrain weight and gradient types.")
+      .TypeConstraint("T_INDEX", {"tensor(int64)"}, "Constrain indices to 64-bit integer tensors.")
+      .TypeConstraint("T_BOOL", {"tensor(bool)"}, "Constrain types to boolean tensors.")
+      .TypeAndShapeInferenceFunction([](InferenceContext& ctx) {
+        updateOutputElemType(ctx, 0, ONNX_NAMESPACE::TensorProto::BOOL);
+        updateOutputShape(ctx, 0, ONNX_NAMESPACE::TensorShapeProto());
+        if (ctx.getNumOutputs() == 2) {
+          propagateElemTypeFromInputToOutput(ctx, 1, 1);
+          if (hasInputShape(ctx, 1)) {
+            propagateShapeFromInputToOutput(ctx, 1, 1);
+          }
+        }
+      });
+
   // TODO: This is copied from onnx schemas. When the change is in and we update this can be removed.
   // For Brevity documentation was not copied
   ONNX_CONTRIB_OPERATOR_SCHEMA(AdamOptimizer)
@@ -1617,6 +1681,55 @@ void RegisterTrainingOpSchemas() {
         }
       });
 
+  ONNX_CONTRIB_OPERATOR_SCHEMA(SparseAdamWOptimizer)
+      .SetDomain(kMSDomain)
+      .SinceVersion(1)
+      .SetDoc(
+          "AdamWOptimizer for one weight whose gradient is given by rows, as produced by GatherSparseGrad. "
+          "Only the rows with a gradient are read and written: the momentums and weight decay of the other rows "
+          "are left as they are, as in the lazy (sparse) Adam of recommender models.")
+      .Input(0, "lr", "The learning rate.", "T1")
+      .Input(1, "step", "The update count of weights. It should be a scalar.", "T2")
+      .Input(2, "weight", "The weight to optimize.", "T")
+      .Input(3, "grad_indices", "The distinct indices of the rows of the weight with a gradient.", "T2")
+      .Input(4, "grad_values", "The gradients of the rows in grad_indices.", "T")
+      .Input(5, "momentum_1", "Exponentially averaged historical gradients of the weight.", "T")
+      .Input(6, "momentum_2", "Exponentially averaged historical squared gradients of the weight.", "T")
+      .Input(7, "update_signal",
+             "This signal indicates if weight updates are skipped, applicable to gradient infinity check"
+             " in mixed precision training. ",
+             "T_BOOL", OpSchema::Optional)
+      .Output(0, "updated_flag", "Whether gradient is applied or not.", "T2")
+      .Output(1, "updated_weight", "The weight after optimize.", "T", OpSchema::Optional)
+      .Output(2, "updated_momentum_1", "momentum_1 after optimize.", "T", OpSchema::Optional)
+      .Output(3, "updated_momentum_2", "momentum_2 after optimize.", "T", OpSchema::Optional)
+      .Attr("alpha", "Coefficient of previously accumulated gradient in running average.", AttributeProto::FLOAT,
+            0.9f)
+      .Attr("beta", "Coefficient of previously accumulated squared-gradient in running average.",
+            AttributeProto::FLOAT, 0.999f)
+      .Attr("epsilon", "Small scalar to avoid dividing by zero.", AttributeProto::FLOAT, 1e-8f)
+      .Attr("weight_decay", "weight decay coefficient.", AttributeProto::FLOAT, 1e-2f)
+      .Attr("correct_bias", "Whether or not to correct bias, enabled by default.", AttributeProto::INT,
+            static_cast<int64_t>(1))
+      .Attr("adam_mode", "Modes for applying bias correction and weight decay, as in AdamWOptimizer.",
+            AttributeProto::INT, static_cast<int64_t>(0))
+      .TypeConstraint("T1", {"tensor(float)"}, "Constrain learning rate to float")
+      .TypeConstraint("T2", {"tensor(int64)"}, "Constrain step count and indices to 64-bit integer")
+      .TypeConstraint("T", {"tensor(float)"}, "Constrain weight, gradient and momentum types.")
+      .TypeConstraint("T_BOOL", {"tensor(bool)"}, "Constrain types to boolean tensors.")
+      .TypeAndShapeInferenceFunction([](InferenceContext& ctx) {
+        propagateElemTypeFromInputToOutput(ctx, 1, 0);
+        updateOutputShape(ctx, 0, ONNX_NAMESPACE::TensorShapeProto());
+        const size_t input_indices[] = {2, 5, 6};
+        for (size_t output_index = 1; output_index < ctx.getNumOutputs(); ++output_index) {
+          const size_t input_index = input_indices[output_index - 1];
+          propagateElemTypeFromInputToOutput(ctx, input_index, output_index);
+          if (hasInputShape(ctx, input_index)) {
+            propagateShapeFromInputToOutput(ctx, input_index, output_index);
+          }
+        }
+      });
+
   ONNX_CONTRIB_OPERATOR_SCHEMA(InplaceClipGradNorm)
       .SetDomain(kMSDomain)
       .SinceVersion(1)
@@ -4203,6 +4316,83 @@ Return true if all elements are true and false otherwise.
           })
       .SetDoc(R"DOC(SoftmaxCrossEntropyLossInternalGrad)DOC");
 
+  ONNX_CONTRIB_OPERATOR_SCHEMA(MatMulSoftmaxCrossEntropyLossInternal)
+      .SetDomain(kMSDomain)
+      .SinceVersion(1)
+      .Attr("reduction", reduction_doc, AttributeProto::STRING, std::string("mean"))
+      .Attr("chunk_size", "The number of classes whose logits are computed at a time.", AttributeProto::INT,
+            static_cast<int64_t>(2048))
+      .Input(0, "X", "The input of the MatMul computing the scores, with shape [batch_size, K].", "T")
+      .Input(1, "W", "The weight of the MatMul computing the scores, with shape [K, class_size].", "T")
+      .Input(2, "labels",
+             "The ground truth output tensor, with shape [batch_size]. Labels element value shall be in range of "
+             "[0, C), or have the value ignore_index.",
+             "Tind")
+      .Input(3, "weights",
+             "A manual rescaling weight given to each class. If given, it has to "
+             "be a 1D Tensor assigning weight to each of the classes. Otherwise, "
+             "it is treated as if having all ones.",
+             "T", OpSchema::Optional)
+      .Input(4, "ignore_index",
+             "Scalar tensor to specify a target value that is ignored and does not contribute to the input gradient.",
+             "I", OpSchema::Optional)
+      .Output(0, "output",
+              "Weighted loss float Tensor. If reduction is 'none', this has the shape of [batch_size]. "
+              "Otherwise, it is a scalar.",
+              "T")
+      .Output(1, "log_sum_exp", "The log-sum-exp of the scores of each sample, with shape [batch_size].", "T")
+      .TypeConstraint("T", {"tensor(float)"}, "Constrain input types to float tensors.")
+      .TypeConstraint("Tind", {"tensor(int32)", "tensor(int64)"}, "Constrain target to integer types")
+      .TypeConstraint("I", {"tensor(int64)"}, "Constrain ignore_index tensor to int64")
+      .TypeAndShapeInferenceFunction([](InferenceContext& ctx) {
+        propagateElemTypeFromInputToOutput(ctx, 0, 0);
+        propagateElemTypeFromInputToOutput(ctx, 0, 1);
+
+        std::string reduction = getAttribute(ctx, "reduction", "mean");
+        if (reduction.compare("none") == 0) {
+          if (hasInputShape(ctx, 2)) {
+            propagateShapeFromInputToOutput(ctx, 2, 0);
+          }
+        } else {
+          updateOutputShape(ctx, 0, TensorShapeProto());
+        }
+        if (hasInputShape(ctx, 2)) {
+          propagateShapeFromInputToOutput(ctx, 2, 1);
+        }
+      })
+      .SetDoc(R"DOC(SoftmaxCrossEntropyLossInternal(MatMul(X, W), labels), computing the scores one chunk of
+classes at a time so that the [batch_size, class_size] scores and probabilities are never stored in full.)DOC");
+
+  ONNX_CONTRIB_OPERATOR_SCHEMA(MatMulSoftmaxCrossEntropyLossInternalGrad)
+      .SetDomain(kMSDomain)
+      .SinceVersion(1)
+      .Attr("reduction", reduction_doc, AttributeProto::STRING, std::string("mean"))
+      .Attr("chunk_size", "The number of classes whose logits are computed at a time.", AttributeProto::INT,
+            static_cast<int64_t>(2048))
+      .Input(0, "dY", "gradient of Y", "T")
+      .Input(1, "X", "The input of the MatMul computing the scores, with shape [batch_size, K].", "T")
+      .Input(2, "W", "The weight of the MatMul computing the scores, with shape [K, class_size].", "T")
+      .Input(3, "log_sum_exp", "The log-sum-exp of the scores of each sample, with shape [batch_size].", "T")
+      .Input(4, "label", "The ground truth output tensor, with shape [batch_size].", "Tind")
+      .Input(5, "weight", "weight for each class. The shape is 1-D tensor.", "T", OpSchema::Optional)
+      .Input(6, "ignore_index",
+             "Scalar tensor to specify a target value that is ignored and does not contribute to the input gradient.",
+             "I", OpSchema::Optional)
+      .Output(0, "dX", "gradient of X", "T", OpSchema::Optional)
+      .Output(1, "dW", "gradient of W", "T", OpSchema::Optional)
+      .TypeConstraint("T", {"tensor(float)"}, "Constrain input types to float tensors.")
+      .TypeConstraint("Tind", {"tensor(int32)", "tensor(int64)"}, "Constrain indices to integer types")
+      .TypeConstraint("I", {"tensor(int64)"}, "Constrain ignore_index tensor to int64")
+      .TypeAndShapeInferenceFunction([](InferenceContext& ctx) {
+        propagateElemTypeFromInputToOutput(ctx, 1, 0);
+        propagateShapeFromInputToOutput(ctx, 1, 0);
+        if (ctx.getNumOutputs() > 1) {
+          propagateElemTypeFromInputToOutput(ctx, 2, 1);
+          propagateShapeFromInputToOutput(ctx, 2, 1);
+        }
+      })
+      .SetDoc(R"DOC(MatMulSoftmaxCrossEntropyLossInternalGrad)DOC");
+
   ONNX_CONTRIB_OPERATOR_SCHEMA(NegativeLogLikelihoodLossInternal)
       .SetDomain(kMSDomain)
       .SinceVersion(1)
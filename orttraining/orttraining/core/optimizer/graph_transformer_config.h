@@ -30,6 +30,10 @@ struct TrainingGraphTransformerConfiguration : public GraphTransformerConfigurat
 
   // Enable label sparsity compute optimization for the input names in the below list.
   std::vector<std::string> sparse_label_input_names;
+
+  // Fuse the MatMul computing the scores into SoftmaxCrossEntropyLossInternal, computing the loss and its gradient
+  // in chunks of classes without storing the full scores. The fused kernels are only implemented on CPU.
+  bool enable_chunked_sce_loss{false};
 };
 
 }  // namespace training
@@ -57,6 +57,7 @@
 #include "orttraining/core/optimizer/localized_recompute.h"
 #include "orttraining/core/optimizer/loss_rewriter.h"
 #include "orttraining/core/optimizer/lstm_replacement.h"
+#include "orttraining/core/optimizer/matmul_sce_loss_fusion.h"
 #include "orttraining/core/optimizer/transformer_layer_recompute.h"
 #include "orttraining/core/optimizer/qdq_fusion.h"
 #include "orttraining/core/optimizer/shape_optimizer.h"
@@ -185,6 +186,10 @@ std::vector<std::unique_ptr<GraphTransformer>> GeneratePreTrainingTransformers(
 #endif
       }
 
+      if (config.enable_chunked_sce_loss) {
+        transformers.emplace_back(std::make_unique<MatMulSceLossFusion>(compatible_eps));
+      }
+
     } break;
 
     case TransformerLevel::Level2: {
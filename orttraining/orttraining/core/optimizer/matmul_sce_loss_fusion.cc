@@ -0,0 +1,87 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "orttraining/core/optimizer/matmul_sce_loss_fusion.h"
+
+#include "core/graph/graph_utils.h"
+
+namespace onnxruntime {
+
+namespace {
+
+bool IsFloatMatrix(const NodeArg& node_arg) {
+  const auto* type_proto = node_arg.TypeAsProto();
+  const auto* shape = node_arg.Shape();
+  return type_proto != nullptr && type_proto->has_tensor_type() &&
+         type_proto->tensor_type().elem_type() == ONNX_NAMESPACE::TensorProto_DataType_FLOAT &&
+         shape != nullptr && shape->dim_size() == 2;
+}
+
+}  // namespace
+
+Status MatMulSceLossFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level,
+                                      const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+
+  for (auto node_index : node_topology_list) {
+    auto* node_ptr = graph.GetNode(node_index);
+    if (!node_ptr) continue;  // Node was removed.
+
+    auto& node = *node_ptr;
+    ORT_RETURN_IF_ERROR(Recurse(node, modified, graph_level, logger));
+
+    if (!graph_utils::IsSupportedOptypeVersionAndDomain(node, "SoftmaxCrossEntropyLossInternal", {1}, kMSDomain) ||
+        !graph_utils::IsSupportedProvider(node, GetCompatibleExecutionProviders()) ||
+        graph_utils::GetNodeAttribute(node, "output_type") != nullptr) {
+      continue;
+    }
+
+    // The fused node does not produce the log probabilities.
+    auto& sce_outputs = node.MutableOutputDefs();
+    if (sce_outputs.size() > 1 && sce_outputs[1]->Exists() &&
+        (!graph.GetConsumerNodes(sce_outputs[1]->Name()).empty() || graph.IsOutput(sce_outputs[1]))) {
+      continue;
+    }
+
+    const Node* p_matmul = graph_utils::GetInputNode(node, 0);
+    if (p_matmul == nullptr ||
+        !graph_utils::IsSupportedOptypeVersionAndDomain(*p_matmul, "MatMul", {1, 9, 13}) ||
+        !graph_utils::IsSupportedProvider(*p_matmul, GetCompatibleExecutionProviders()) ||
+        p_matmul->GetOutputEdgesCount() != 1 || graph.NodeProducesGraphOutput(*p_matmul) ||
+        !IsFloatMatrix(*p_matmul->InputDefs()[0]) || !IsFloatMatrix(*p_matmul->InputDefs()[1])) {
+      continue;
+    }
+
+    Node& matmul_node = *graph.GetNode(p_matmul->Index());
+    auto& sce_inputs = node.MutableInputDefs();
+    InlinedVector<NodeArg*> fused_inputs{matmul_node.MutableInputDefs()[0], matmul_node.MutableInputDefs()[1],
+                                         sce_inputs[1]};
+    for (size_t i = 2; i < sce_inputs.size(); ++i) {
+      fused_inputs.push_back(sce_inputs[i]);
+    }
+
+    ONNX_NAMESPACE::TypeProto log_sum_exp_type;
+    log_sum_exp_type.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+    *log_sum_exp_type.mutable_tensor_type()->mutable_shape()->add_dim() =
+        matmul_node.InputDefs()[0]->Shape()->dim(0);
+    InlinedVector<NodeArg*> fused_outputs{
+        sce_outputs[0], &graph.GetOrCreateNodeArg(graph.GenerateNodeArgName("log_sum_exp"), &log_sum_exp_type)};
+
+    Node& fused_node = graph.AddNode(graph.GenerateNodeName("MatMulSoftmaxCrossEntropyLossInternal"),
+                                     "MatMulSoftmaxCrossEntropyLossInternal", "Fused MatMul and SCE loss",
+                                     fused_inputs, fused_outputs, &node.GetAttributes(), kMSDomain);
+    fused_node.SetExecutionProviderType(node.GetExecutionProviderType());
+
+    graph_utils::RemoveNodeOutputEdges(graph, matmul_node);
+    graph.RemoveNode(matmul_node.Index());
+    graph_utils::RemoveNodeOutputEdges(graph, node);
+    graph.RemoveNode(node.Index());
+
+    modified = true;
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
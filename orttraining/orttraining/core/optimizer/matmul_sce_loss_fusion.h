@@ -0,0 +1,28 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class MatMulSceLossFusion
+Fuse MatMul + SoftmaxCrossEntropyLossInternal to MatMulSoftmaxCrossEntropyLossInternal, which computes the loss one
+chunk of classes at a time and keeps only the log-sum-exp of each sample for the backward pass, instead of the
+[batch_size, class_size] scores and log probabilities. Its gradient recomputes the scores in the same chunks.
+
+It must run before the gradient graph is built, and requires 2-D float MatMul inputs whose output is only consumed
+by the loss, and a loss whose log probabilities are not used by the forward graph.
+*/
+class MatMulSceLossFusion : public GraphTransformer {
+ public:
+  explicit MatMulSceLossFusion(const InlinedHashSet<std::string_view>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("MatMulSceLossFusion", compatible_execution_providers) {
+  }
+
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+};
+
+}  // namespace onnxruntime
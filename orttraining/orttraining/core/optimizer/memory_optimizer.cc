@@ -1,6 +1,9 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
+
+#include "core/common/parse_string.h"
 #include "core/framework/random_seed.h"
 #include "core/framework/tensorprotoutils.h"
 #include "core/graph/graph_utils.h"
@@ -70,12 +73,73 @@ float InputOutputSizeRatio(const Node* node) {
   return 1.0f;
 }
 
+// Estimated number of elements of the value, counting symbolic dimensions as 1. Returns 0 for unknown shapes.
+int64_t EstimateElementCount(const NodeArg& node_arg) {
+  const ONNX_NAMESPACE::TensorShapeProto* shape = node_arg.Shape();
+  if (shape == nullptr) {
+    return 0;
+  }
+
+  int64_t element_count = 1;
+  for (const auto& dim : shape->dim()) {
+    if (utils::HasDimValue(dim)) {
+      element_count *= dim.dim_value();
+    }
+  }
+  return element_count;
+}
+
+int64_t EstimateSizeInBytes(const NodeArg& node_arg) {
+  const ONNX_NAMESPACE::TypeProto* type_proto = node_arg.TypeAsProto();
+  if (type_proto == nullptr || !type_proto->has_tensor_type() ||
+      type_proto->tensor_type().elem_type() == ONNX_NAMESPACE::TensorProto_DataType_STRING) {
+    return 0;
+  }
+  return EstimateElementCount(node_arg) * static_cast<int64_t>(GetElementSize(node_arg.Type()));
+}
+
+// Estimated FLOPs to recompute the node.
+double EstimateRecomputeFlops(const Node& node) {
+  if (node.OutputDefs().empty()) {
+    return 0.0;
+  }
+
+  const double output_element_count = static_cast<double>(EstimateElementCount(*node.OutputDefs()[0]));
+  const auto& op_type = node.OpType();
+  if (op_type == "MatMul" || op_type == "FusedMatMul") {
+    // 2 * M * N * K, with K the inner dimension of A.
+    const auto* a_shape = node.InputDefs()[0]->Shape();
+    if (a_shape == nullptr || a_shape->dim_size() == 0) {
+      return output_element_count;
+    }
+    const auto& attributes = node.GetAttributes();
+    const auto trans_a = attributes.find("transA");
+    const bool is_a_transposed = trans_a != attributes.end() && trans_a->second.i() != 0 && a_shape->dim_size() > 1;
+    const auto& k_dim = a_shape->dim(a_shape->dim_size() - (is_a_transposed ? 2 : 1));
+    return 2.0 * output_element_count * (utils::HasDimValue(k_dim) ? static_cast<double>(k_dim.dim_value()) : 1.0);
+  }
+  if (op_type == "Softmax" || op_type == "BiasSoftmax" || op_type == "BiasSoftmaxDropout") {
+    return 5.0 * output_element_count;
+  }
+  if (op_type == "Gelu" || op_type == "FastGelu" || op_type == "BiasGelu") {
+    return 8.0 * output_element_count;
+  }
+  return output_element_count;
+}
+
 }  // namespace
 
 Status MemoryOptimizer::ParseConfigFromString(const std::string& enable_memory_optimizer,
-                                              const std::string& level) {
+                                              const std::string& level,
+                                              const std::string& memory_budget_ratio) {
   optimizer_config_ = enable_memory_optimizer;
-  if (!enable_memory_optimizer.empty()) {
+  if (!memory_budget_ratio.empty()) {
+    // The memory budget picks the subgraphs to recompute, so the user defined subgraphs are not used.
+    memory_budget_ratio_ = ParseStringWithClassicLocale<float>(memory_budget_ratio);
+    ORT_RETURN_IF_NOT(memory_budget_ratio_ >= 0.f && memory_budget_ratio_ <= 1.f,
+                      "Invalid memory budget specified, it should be a ratio between 0 and 1: ", memory_budget_ratio);
+    optimizer_config_ = "memory budget ratio " + memory_budget_ratio;
+  } else if (!enable_memory_optimizer.empty()) {
     const auto user_config_strs = utils::SplitString(enable_memory_optimizer, ",");
     for (const auto& user_config_str : user_config_strs) {
       const auto user_config = utils::SplitString(user_config_str, ":");
@@ -219,7 +283,12 @@ bool MemoryOptimizer::ModifyGraph(Graph& graph,
 
   subgraph_desc.skip_count += 1;
 
-  if (user_config.type != OptimizationType::None && subgraph_desc.skip_count > skip_count) {
+  bool should_apply = user_config.type != OptimizationType::None && subgraph_desc.skip_count > skip_count;
+  if (subgraph_stores.selected_for_memory_budget) {
+    should_apply = subgraph_stores.selected_instances.find(node) != subgraph_stores.selected_instances.end();
+  }
+
+  if (should_apply) {
     subgraph_desc.applied_count += 1;
     Node* replacement_node_ptr = nullptr;
     LOGS(logger, WARNING) << "[Modify Graph] Node " << node->Name() << "(" << node->OpType() << ") is "
@@ -327,6 +396,10 @@ Status MemoryOptimizer::ApplyImpl(Graph& graph, bool& modified, int /*graph_leve
     }
   }
 
+  if (memory_budget_ratio_ >= 0.f) {
+    SelectSubgraphsForMemoryBudget(candidate_output_args_map, recompute_subgraph_stores, logger);
+  }
+
   // The second pass - apply the transformation.
   // Iterate through the nodes in reversed topological order and find the subgraph that can be alleviated.
   // The reason we do reversed topological order is that we want the later layers' recompute nodes can be appended
@@ -707,6 +780,75 @@ void MemoryOptimizer::CheckNodeForRecompute(const Node& node,
   return;
 }
 
+void MemoryOptimizer::SelectSubgraphsForMemoryBudget(const InlinedHashMap<const Node*, InlinedVector<size_t>>&
+                                                         candidate_output_args_map,
+                                                     SubGraphStores& subgraph_stores,
+                                                     const logging::Logger& logger) const {
+  subgraph_stores.selected_for_memory_budget = true;
+
+  int64_t stashed_bytes = 0;
+  for (const auto& [node, output_indices] : candidate_output_args_map) {
+    for (size_t output_index : output_indices) {
+      stashed_bytes += EstimateSizeInBytes(*node->OutputDefs()[output_index]);
+    }
+  }
+
+  struct Candidate {
+    const Node* node;
+    int64_t saved_bytes;
+    double recompute_flops;
+  };
+  InlinedVector<Candidate> candidates;
+  for (const auto& [node, instance_info] : subgraph_stores._optimization_target_graphs_) {
+    Candidate candidate{node, 0, 0.0};
+    for (size_t output_index : candidate_output_args_map.at(node)) {
+      candidate.saved_bytes += EstimateSizeInBytes(*node->OutputDefs()[output_index]);
+    }
+    for (const Node* subgraph_node : instance_info.first) {
+      candidate.recompute_flops += EstimateRecomputeFlops(*subgraph_node);
+    }
+    if (candidate.saved_bytes > 0) {
+      candidates.push_back(candidate);
+    }
+  }
+
+  // Greedy knapsack: take the subgraphs with the least recompute FLOPs per saved byte first. Ties are broken by the
+  // node index to keep the selection deterministic.
+  std::sort(candidates.begin(), candidates.end(), [](const Candidate& lhs, const Candidate& rhs) {
+    const double lhs_cost = lhs.recompute_flops / static_cast<double>(lhs.saved_bytes);
+    const double rhs_cost = rhs.recompute_flops / static_cast<double>(rhs.saved_bytes);
+    return lhs_cost != rhs_cost ? lhs_cost < rhs_cost : lhs.node->Index() < rhs.node->Index();
+  });
+
+  const int64_t budget_bytes = static_cast<int64_t>(static_cast<double>(stashed_bytes) * memory_budget_ratio_);
+  int64_t saved_bytes = 0;
+  double recompute_flops = 0.0;
+  for (const Candidate& candidate : candidates) {
+    if (stashed_bytes - saved_bytes <= budget_bytes) {
+      break;
+    }
+
+    subgraph_stores.selected_instances.insert(candidate.node);
+    saved_bytes += candidate.saved_bytes;
+    recompute_flops += candidate.recompute_flops;
+
+    // Record the picked count as the requested count, for the summary.
+    SubGraphDesc& subgraph_desc = subgraph_stores.GetSubGraphDesc(
+        subgraph_stores.GetSubGraphInstance(candidate.node).second);
+    if (subgraph_desc.user_optimizer_config.type == OptimizationType::None) {
+      subgraph_desc.user_optimizer_config = UserConfig{OptimizationType::Recompute, 0};
+    }
+    subgraph_desc.user_optimizer_config.requested_count += 1;
+  }
+
+  LOGS(logger, WARNING) << "[Memory Budget] Stashed activations of about " << stashed_bytes << " bytes, budget "
+                        << budget_bytes << " bytes. Recomputing " << subgraph_stores.selected_instances.size()
+                        << " of " << candidates.size() << " recomputable subgraphs saves about " << saved_bytes
+                        << " bytes for about " << recompute_flops << " FLOPs per step"
+                        << (stashed_bytes - saved_bytes > budget_bytes ? ", which does not meet the budget." : ".")
+                        << " Symbolic dimensions are counted as 1.";
+}
+
 Status MemoryOptimizer::CreateRecomputeGraph(Graph& graph,
                                              const InlinedVector<const Node*>& nodes_in_topological_order,
                                              Node*& new_output_node_ptr) const {
@@ -12,7 +12,8 @@ namespace onnxruntime {
 /**
 @Class MemoryOptimizer
 
-Find recomputable subgraphs and enable according to user configs.
+Find recomputable subgraphs and enable according to user configs, or pick them automatically to fit the stashed
+activations in a memory budget.
 */
 
 class MemoryOptimizer : public GraphTransformer {
@@ -142,6 +143,11 @@ class MemoryOptimizer : public GraphTransformer {
 
     InlinedHashMap<std::string /*subgraph_representative_str*/, SubGraphDesc> subgraph_descs;
     InlinedHashMap<const Node*, GraphInstanceInfo> _optimization_target_graphs_;
+
+    // With a memory budget, the subgraph instances to apply are picked by SelectSubgraphsForMemoryBudget instead
+    // of the user configs.
+    bool selected_for_memory_budget{false};
+    InlinedHashSet<const Node*> selected_instances;
   };
 
   /**
@@ -153,10 +159,11 @@ class MemoryOptimizer : public GraphTransformer {
   };
 
  public:
-  MemoryOptimizer(const std::string& enable_memory_optimizer, const std::string& level)
+  MemoryOptimizer(const std::string& enable_memory_optimizer, const std::string& level,
+                  const std::string& memory_budget_ratio = "")
       : GraphTransformer("MemoryOptimizer") {
     // Parse user defined configs.
-    ORT_ENFORCE(ParseConfigFromString(enable_memory_optimizer, level).IsOK());
+    ORT_ENFORCE(ParseConfigFromString(enable_memory_optimizer, level, memory_budget_ratio).IsOK());
 
     RegisterAllowedRecomputeOps();
   }
@@ -166,7 +173,8 @@ class MemoryOptimizer : public GraphTransformer {
   bool ShouldOnlyApplyOnce() const override { return true; }
 
  private:
-  Status ParseConfigFromString(const std::string& enable_memory_optimizer, const std::string& level);
+  Status ParseConfigFromString(const std::string& enable_memory_optimizer, const std::string& level,
+                               const std::string& memory_budget_ratio);
 
   /**
    * @brief Prepare info including activation usage, node usage in fw and bw.
@@ -307,6 +315,23 @@ class MemoryOptimizer : public GraphTransformer {
                              bool compromise_stashed_activation,
                              bool& can_compromise_stashed_activation) const;
 
+  /**
+   * @brief Pick the subgraph instances to recompute so that the stashed activations fit in the memory budget.
+   *
+   * The instances saving the most stashed activation memory per recomputed FLOP are picked first, which
+   * approximates the set of instances with the least recompute FLOPs meeting the budget. The expected memory
+   * saving and recompute cost are logged.
+   *
+   * @param candidate_output_args_map A map from node to its candidate activations, which are consumed by both fw and
+   *  bw ops.
+   * @param subgraph_stores A store to maintain all found subgraphs, updated with the picked instances.
+   * @param logger Logger.
+   */
+  void SelectSubgraphsForMemoryBudget(const InlinedHashMap<const Node*, InlinedVector<size_t>>&
+                                          candidate_output_args_map,
+                                      SubGraphStores& subgraph_stores,
+                                      const logging::Logger& logger) const;
+
   /**
    * @brief Duplicate nodes to create a recompute subgraph.
    *
@@ -329,6 +354,8 @@ class MemoryOptimizer : public GraphTransformer {
   InlinedHashMap<std::string, UserConfig> pattern_subgraph_to_user_optimizer_config_map_;
   std::string optimizer_config_;
   ProbeLevel recompute_probe_level_;
+  // Fraction of the stashed activation memory allowed to stay stashed. Negative if there is no memory budget.
+  float memory_budget_ratio_{-1.f};
 };
 
 }  // namespace onnxruntime
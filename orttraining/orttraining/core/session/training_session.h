@@ -192,6 +192,9 @@ class TrainingSession : public InferenceSession {
       AdasumReductionType adasum_reduction_type{AdasumReductionType::None};
       // Whether to enable gradient clipping.
       bool enable_grad_norm_clip{true};
+      // The size of the gradient buckets of the all-reduce, which overlaps the all-reduce with the backward pass.
+      // 0 all-reduces all the gradients at once after the backward pass.
+      int64_t allreduce_bucket_size_in_bytes{0};
     };
     // The optimizer configuration.
     // If not provided, no optimizer is added.
@@ -135,6 +135,7 @@ struct TrainingParameters {
   int num_pipeline_micro_batches = 1;
   int deepspeed_zero_stage = 0;
   bool enable_grad_norm_clip = true;
+  int64_t allreduce_bucket_size_in_bytes = 0;
   bool set_gradients_as_graph_outputs = false;
   bool use_memory_efficient_gradient = false;
 
@@ -316,6 +317,7 @@ TrainingConfigurationResult ConfigureSessionForTraining(
     opt.use_nccl = parameters.allreduce_post_accumulation;
     opt.deepspeed_zero = onnxruntime::training::ZeROConfig(parameters.deepspeed_zero_stage);
     opt.enable_grad_norm_clip = parameters.enable_grad_norm_clip;
+    opt.allreduce_bucket_size_in_bytes = parameters.allreduce_bucket_size_in_bytes;
 
     // TODO reduction types
     if (parameters.enable_adasum) {
@@ -457,6 +459,7 @@ void addObjectMethodsForTraining(py::module& m, ExecutionProviderRegistrationFn
       .def_readwrite("gradient_accumulation_steps", &TrainingParameters::gradient_accumulation_steps)
       .def_readwrite("deepspeed_zero_stage", &TrainingParameters::deepspeed_zero_stage)
       .def_readwrite("enable_grad_norm_clip", &TrainingParameters::enable_grad_norm_clip)
+      .def_readwrite("allreduce_bucket_size_in_bytes", &TrainingParameters::allreduce_bucket_size_in_bytes)
       .def_readwrite("set_gradients_as_graph_outputs", &TrainingParameters::set_gradients_as_graph_outputs)
       .def_readwrite("use_memory_efficient_gradient", &TrainingParameters::use_memory_efficient_gradient)
       .def_readwrite("attn_dropout_recompute", &TrainingParameters::attn_dropout_recompute)
@@ -738,6 +741,7 @@ void addObjectMethodsForTraining(py::module& m, ExecutionProviderRegistrationFn
       .def_readwrite("enable_compute_optimizer", &TrainingGraphTransformerConfiguration::enable_compute_optimizer)
       .def_readwrite("sparse_embedding_input_names", &TrainingGraphTransformerConfiguration::sparse_embedding_input_names)
       .def_readwrite("sparse_label_input_names", &TrainingGraphTransformerConfiguration::sparse_label_input_names)
+      .def_readwrite("enable_chunked_sce_loss", &TrainingGraphTransformerConfiguration::enable_chunked_sce_loss)
       .def_readwrite("propagate_cast_ops_config", &TrainingGraphTransformerConfiguration::GraphTransformerConfiguration::propagate_cast_ops_config);
 
   py::class_<OrtModuleGraphBuilderConfiguration> module_graph_builder_config(
@@ -386,6 +386,7 @@ class GraphExecutionManager(GraphExecutionInterface):
         graph_transformer_config.propagate_cast_ops_config.allow = self._runtime_options.propagate_cast_ops_allow
         graph_transformer_config.propagate_cast_ops_config.strategy = self._runtime_options.propagate_cast_ops_strategy
         graph_transformer_config.enable_compute_optimizer = self._runtime_options.enable_compute_optimizer
+        graph_transformer_config.enable_chunked_sce_loss = self._runtime_options.enable_chunked_sce_loss
         return graph_transformer_config
 
     def _initialize_graph_builder(self):
@@ -217,6 +217,7 @@ class _RuntimeOptions:
         self.label_sparsity_ratio = ""
         self.embed_sparsity_ratio = ""
         self.enable_embedding_sparse_optimizer = False  # TODO(pengwa): remove once validation on more models are done.
+        self.enable_chunked_sce_loss = False
 
         # Configuration for memory optimization.
         self.memory_optimizer_config = ""
@@ -257,6 +258,9 @@ class _RuntimeOptions:
                 self.enable_sparse_optimizer = int(os.getenv("ORTMODULE_ENABLE_SPARSE_OPTIMIZER")) == 1
             self.enable_sparse_optimizer = self.enable_compute_optimizer and self.enable_sparse_optimizer
 
+        if "ORTMODULE_ENABLE_CHUNKED_SCE_LOSS" in os.environ:
+            self.enable_chunked_sce_loss = int(os.getenv("ORTMODULE_ENABLE_CHUNKED_SCE_LOSS")) == 1
+
         # TODO(pengwa): remove once validation on more models are done.
         if "ORTMODULE_ENABLE_EMBEDDING_SPARSE_OPTIMIZER" in os.environ:
             self.enable_embedding_sparse_optimizer = (
@@ -352,6 +352,11 @@ static void TestAllreduceOptimizerGraphBuilder(OptimizerGraphConfig config, Grap
   ASSERT_GT(GetOpCount(op_counts, k_unscale_op_name), 0);
   ASSERT_GT(GetOpCount(op_counts, k_all_reduce_op_name), 0);
 
+  // verify the gradients of each weight, which fill a bucket, are all-reduced on their own
+  if (config.allreduce_bucket_size_in_bytes > 0) {
+    ASSERT_EQ(GetOpCount(op_counts, k_all_reduce_op_name), k_weight_names.size());
+  }
+
   // verify optimizers exist
   ASSERT_EQ(GetOpCount(op_counts, k_adam_optimizer_op_name), k_weight_names.size());
 }
@@ -478,6 +483,16 @@ TEST_F(OptimizerGraphBuilderTest, Allreduce_WithGradientAccumulation_WithMixedPr
   TestAllreduceOptimizerGraphBuilder(config, graph_);
 }
 
+TEST_F(OptimizerGraphBuilderTest, Allreduce_GradientBuckets) {
+  OptimizerGraphConfig config;
+  config.data_parallel_group_size = 4;
+  config.use_nccl = true;
+  config.gradient_accumulation_steps = 1;
+  config.use_mixed_precision = false;
+  config.allreduce_bucket_size_in_bytes = sizeof(float);
+  TestAllreduceOptimizerGraphBuilder(config, graph_);
+}
+
 static void TestZeROOptimizerGraphBuilder(OptimizerGraphConfig config, Graph& graph) {
   std::unordered_map<std::string, std::string> updated_weight_names_map;
   std::unordered_map<std::string, training::TrainingSession::PartitionInfo> weight_partition_info;
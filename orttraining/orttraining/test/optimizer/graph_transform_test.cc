@@ -27,6 +27,7 @@
 #include "orttraining/core/optimizer/loss_rewriter.h"
 #include "orttraining/core/optimizer/bias_softmax_dropout_fusion.h"
 #include "orttraining/core/optimizer/sce_loss_grad_bias_fusion.h"
+#include "orttraining/core/optimizer/matmul_sce_loss_fusion.h"
 #include "orttraining/core/optimizer/qdq_fusion.h"
 #include "orttraining/core/optimizer/lstm_replacement.h"
 
@@ -511,6 +512,57 @@ TEST_F(GraphTransformationTests, SceLossGradBiasFusion_Invalid) {
   }
 }
 
+void RunMatMulSceLossFusionTest(bool log_prob_is_output, const std::string& reduction, const logging::Logger& logger) {
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* x_arg = builder.MakeInput<float>({{8, 4}});
+    auto* w_arg = builder.MakeInitializer<float>({4, 16}, -1.0f, 1.0f);
+    auto* label_arg = builder.MakeInput<int64_t>({{8}});
+    auto* logits_arg = builder.MakeIntermediate();
+    auto* loss_arg = builder.MakeOutput();
+    auto* log_prob_arg = log_prob_is_output ? builder.MakeOutput() : builder.MakeIntermediate();
+
+    builder.AddNode("MatMul", {x_arg, w_arg}, {logits_arg});
+    builder.AddNode("SoftmaxCrossEntropyLossInternal", {logits_arg, label_arg}, {loss_arg, log_prob_arg}, kMSDomain)
+        .AddAttribute("reduction", reduction);
+  };
+
+  auto pre_graph_checker = [&](Graph& graph) {
+    TEST_RETURN_IF_NOT(CountOpsInGraph(graph)["MatMul"] == 1);
+    TEST_RETURN_IF_NOT(CountOpsInGraph(graph)["com.microsoft.SoftmaxCrossEntropyLossInternal"] == 1);
+    return Status::OK();
+  };
+
+  auto post_graph_checker = [&](Graph& graph) {
+    auto op_to_count = CountOpsInGraph(graph);
+    const int expected_fused_count = log_prob_is_output ? 0 : 1;
+    TEST_RETURN_IF_NOT(op_to_count["MatMul"] == 1 - expected_fused_count);
+    TEST_RETURN_IF_NOT(op_to_count["com.microsoft.SoftmaxCrossEntropyLossInternal"] == 1 - expected_fused_count);
+    TEST_RETURN_IF_NOT(op_to_count["com.microsoft.MatMulSoftmaxCrossEntropyLossInternal"] == expected_fused_count);
+    for (auto& node : graph.Nodes()) {
+      if (node.OpType() == "MatMulSoftmaxCrossEntropyLossInternal") {
+        TEST_RETURN_IF_NOT(reduction == node.GetAttributes().at("reduction").s());
+        TEST_RETURN_IF_NOT(3 == static_cast<int>(node.InputDefs().size()));
+        TEST_RETURN_IF_NOT(2 == static_cast<int>(node.OutputDefs().size()));
+      }
+    }
+    return Status::OK();
+  };
+
+  std::unique_ptr<GraphTransformer> transformer = std::make_unique<MatMulSceLossFusion>();
+  ASSERT_STATUS_OK(TestGraphTransformer(build_test_case, 13, logger, std::move(transformer), TransformerLevel::Level1, 1,
+                                        pre_graph_checker, post_graph_checker));
+}
+
+TEST_F(GraphTransformationTests, MatMulSceLossFusion) {
+  RunMatMulSceLossFusionTest(false, "mean", *logger_);
+  RunMatMulSceLossFusionTest(false, "sum", *logger_);
+  RunMatMulSceLossFusionTest(false, "none", *logger_);
+}
+
+TEST_F(GraphTransformationTests, MatMulSceLossFusion_LogProbIsOutput) {
+  RunMatMulSceLossFusionTest(true, "mean", *logger_);
+}
+
 Node* GetNodeByName(Graph& graph, std::string node_name) {
   GraphViewer graph_viewer(graph);
   const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
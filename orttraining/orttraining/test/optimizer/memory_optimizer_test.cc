@@ -90,6 +90,61 @@ TEST(MemoryOptimizerTests, GeluRecompute) {
   ASSERT_EQ(original_gelu_node->Priority(), static_cast<int>(ExecutionPriority::DEFAULT));
 }
 
+TEST(MemoryOptimizerTests, GeluRecomputeWithMemoryBudget) {
+  const logging::Logger* logger = &logging::LoggingManager::DefaultLogger();
+  auto model_uri = MODEL_FOLDER "recompute_gelu.onnx";
+  const std::string alleviation_level("1");
+
+  // A budget of the full stashed activation memory needs no recompute.
+  {
+    std::shared_ptr<Model> model;
+    ASSERT_STATUS_OK(Model::Load(model_uri, model, nullptr, *logger));
+    Graph& graph = model->MainGraph();
+
+    onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+    ASSERT_STATUS_OK(graph_transformation_mgr.Register(
+        std::make_unique<MemoryOptimizer>("", alleviation_level, "1"), TransformerLevel::Level3));
+    ASSERT_STATUS_OK(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level3, *logger));
+
+    std::map<std::string, int> op_to_count = CountOpsInGraph(graph);
+    ASSERT_TRUE(op_to_count["com.microsoft.Gelu"] == 1);
+  }
+
+  // A zero budget recomputes all the recomputable subgraphs, Gelu among them.
+  {
+    std::shared_ptr<Model> model;
+    ASSERT_STATUS_OK(Model::Load(model_uri, model, nullptr, *logger));
+    Graph& graph = model->MainGraph();
+
+    std::string gelu_node_name;
+    for (auto& node : graph.Nodes()) {
+      if (node.OpType().compare("Gelu") == 0) {
+        gelu_node_name = node.Name();
+        break;
+      }
+    }
+
+    onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+    ASSERT_STATUS_OK(graph_transformation_mgr.Register(
+        std::make_unique<MemoryOptimizer>("", alleviation_level, "0"), TransformerLevel::Level3));
+    ASSERT_STATUS_OK(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level3, *logger));
+
+    std::map<std::string, int> op_to_count = CountOpsInGraph(graph);
+    ASSERT_TRUE(op_to_count["com.microsoft.Gelu"] == 2);
+    ASSERT_TRUE(op_to_count["com.microsoft.YieldOp"] == 1);
+    ASSERT_TRUE(op_to_count["com.microsoft.GeluGrad"] == 1);
+
+    Node* recompute_gelu_node{nullptr};
+    for (auto& node : graph.Nodes()) {
+      if (node.OpType().compare("Gelu") == 0 && node.Name() != gelu_node_name) {
+        recompute_gelu_node = &node;
+      }
+    }
+    ASSERT_NE(recompute_gelu_node, nullptr);
+    ASSERT_EQ(recompute_gelu_node->Priority(), static_cast<int>(ExecutionPriority::LOCAL_LOW));
+  }
+}
+
 TEST(MemoryOptimizerTests, TileRecompute) {
   const logging::Logger* logger = &logging::LoggingManager::DefaultLogger();
   auto model_uri = MODEL_FOLDER "recompute_tile.onnx";
@@ -434,4 +434,74 @@ TEST(CheckpointApiTest, SaveCustomPropertyAsCheckpoint_ThenLoad_CPU) {
   std::string restored_s_data = restored_property_bag.GetProperty<std::string>(s_property_name);
   ASSERT_EQ(s_data, restored_s_data);
 }
+
+/**
+ * Save a full checkpoint and a delta checkpoint in the background, with one parameter changed in between,
+ * Then load the delta on top of the full checkpoint, compare with the latest parameter values.
+ */
+TEST(CheckpointApiTest, AsyncSaveDeltaCheckpoint_ThenLoad_CPU) {
+  /// Phase 1 - Test Preparation
+  /// Prepare a checkpoint state with a trainable and a frozen parameter.
+
+  CheckpointState checkpoint_state;
+  auto& named_parameters = checkpoint_state.module_checkpoint_state.named_parameters;
+  OrtValue trainable_value;
+  onnxruntime::test::CreateInputOrtValueOnCPU<float>(std::vector<int64_t>{2, 2}, {1.f, 2.f, 3.f, 4.f},
+                                                     &trainable_value);
+  named_parameters.insert({"weight", std::make_shared<Parameter>("weight", trainable_value, true)});
+  OrtValue frozen_value;
+  onnxruntime::test::CreateInputOrtValueOnCPU<float>(std::vector<int64_t>{3}, {5.f, 6.f, 7.f}, &frozen_value);
+  named_parameters.insert({"embedding", std::make_shared<Parameter>("embedding", frozen_value, false)});
+  checkpoint_state.property_bag.AddProperty(std::string("epoch"), static_cast<int64_t>(1));
+
+  // Remove the temporary directory if it already exists.
+  auto ckpt_test_root_dir = ORT_TSTR("checkpointing_api_test_dir");
+  TemporaryDirectory tmp_dir{ckpt_test_root_dir};
+  PathString checkpoint_path{
+      ConcatPathComponent<PathChar>(tmp_dir.Path(), ORT_TSTR("e2e_ckpt_save_cpu"))};
+  PathString delta_checkpoint_path{
+      ConcatPathComponent<PathChar>(tmp_dir.Path(), ORT_TSTR("e2e_ckpt_save_cpu_delta"))};
+
+  /// Phase 2 - Save a full checkpoint, change the trainable parameter, then save a delta.
+  /// The parameter is changed as soon as Save returns, the checkpoint holds the values of the snapshot.
+
+  AsyncCheckpointWriter writer;
+  ASSERT_STATUS_OK(writer.Save(checkpoint_state, checkpoint_path, false));
+  float* weight_data = trainable_value.GetMutable<Tensor>()->MutableData<float>();
+  weight_data[0] = 10.f;
+  ASSERT_STATUS_OK(writer.Save(checkpoint_state, delta_checkpoint_path, false, true));
+  ASSERT_STATUS_OK(writer.Wait());
+
+  /// Phase 3 - Load the checkpoints.
+  /// The full checkpoint holds the initial values, the delta only the changed parameter.
+
+  CheckpointState full_state;
+  ASSERT_STATUS_OK(LoadCheckpoint(checkpoint_path, full_state));
+  std::vector<float> full_weight;
+  CpuOrtValueToVec(full_state.module_checkpoint_state.named_parameters.at("weight")->Data(), full_weight);
+  ASSERT_EQ(full_weight, std::vector<float>({1.f, 2.f, 3.f, 4.f}));
+
+  CheckpointState delta_state;
+  ASSERT_STATUS_OK(LoadCheckpoint(delta_checkpoint_path, delta_state));
+  ASSERT_EQ(delta_state.module_checkpoint_state.named_parameters.size(), 1);
+  ASSERT_EQ(delta_state.module_checkpoint_state.named_parameters.count("weight"), 1);
+
+  CheckpointState restored_state;
+  const std::vector<PathString> delta_checkpoint_paths{delta_checkpoint_path};
+  ASSERT_STATUS_OK(LoadCheckpointWithDeltas(checkpoint_path, delta_checkpoint_paths, restored_state));
+  const auto& restored_parameters = restored_state.module_checkpoint_state.named_parameters;
+  ASSERT_EQ(restored_parameters.size(), 2);
+
+  std::vector<float> restored_weight;
+  CpuOrtValueToVec(restored_parameters.at("weight")->Data(), restored_weight);
+  ASSERT_EQ(restored_weight, std::vector<float>({10.f, 2.f, 3.f, 4.f}));
+  ASSERT_TRUE(restored_parameters.at("weight")->RequiresGrad());
+
+  std::vector<float> restored_embedding;
+  CpuOrtValueToVec(restored_parameters.at("embedding")->Data(), restored_embedding);
+  ASSERT_EQ(restored_embedding, std::vector<float>({5.f, 6.f, 7.f}));
+  ASSERT_FALSE(restored_parameters.at("embedding")->RequiresGrad());
+
+  ASSERT_EQ(restored_state.property_bag.GetProperty<int64_t>("epoch"), 1);
+}
 }  // namespace onnxruntime::training::test
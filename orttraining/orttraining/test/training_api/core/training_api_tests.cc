@@ -1,6 +1,7 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
 #include <thread>
 
 #include "gtest/gtest.h"
@@ -11,6 +12,7 @@
 #include "orttraining/training_api/utils.h"
 #include "orttraining/training_api/module.h"
 #include "orttraining/training_api/optimizer.h"
+#include "orttraining/training_api/optimizer_sharding.h"
 #include "orttraining/training_api/checkpoint_property.h"
 #include "orttraining/training_api/checkpoint.h"
 #include "orttraining/training_api/lr_scheduler.h"
@@ -423,6 +425,64 @@ TEST(TrainingApiTest, ModuleExportModelForInferencingCPU) {
   TestModuleExport(providers);
 }
 
+TEST(TrainingApiTest, OptimizerShardingPlan) {
+  const std::vector<std::pair<std::string, std::vector<int64_t>>> parameter_shapes{
+      {"fc1.weight", {300}}, {"fc1.bias", {100}}, {"fc2.weight", {10, 10}}, {"fc2.bias", {50}}};
+
+  ModuleCheckpointState module_checkpoint_state;
+  for (const auto& [name, shape] : parameter_shapes) {
+    OrtValue data;
+    GenerateRandomInput(shape, data);
+    module_checkpoint_state.named_parameters.insert({name, std::make_shared<Parameter>(name, data, true)});
+  }
+  OrtValue frozen_data;
+  GenerateRandomInput(std::vector<int64_t>{1000}, frozen_data);
+  module_checkpoint_state.named_parameters.insert(
+      {"frozen.weight", std::make_shared<Parameter>("frozen.weight", frozen_data, false)});
+
+  OptimizerShardingPlan plan;
+  ASSERT_STATUS_OK(CreateOptimizerShardingPlan(module_checkpoint_state, 0, 1, plan));
+  ASSERT_FALSE(plan.IsSharded());
+  ASSERT_TRUE(plan.Owns("fc1.weight"));
+
+  ASSERT_FALSE(CreateOptimizerShardingPlan(module_checkpoint_state, 2, 2, plan).IsOK());
+
+  for (int32_t world_size : {2, 3, 4}) {
+    std::vector<int64_t> rank_sizes(world_size, 0);
+    for (int32_t rank = 0; rank < world_size; ++rank) {
+      ASSERT_STATUS_OK(CreateOptimizerShardingPlan(module_checkpoint_state, rank, world_size, plan));
+      ASSERT_TRUE(plan.IsSharded());
+      ASSERT_EQ(plan.parameter_names.size(), parameter_shapes.size());
+      ASSERT_TRUE(std::is_sorted(plan.parameter_names.begin(), plan.parameter_names.end()));
+      ASSERT_TRUE(std::is_sorted(plan.owners.begin(), plan.owners.end()));
+      ASSERT_FALSE(plan.Owns("frozen.weight"));
+
+      for (size_t i = 0; i < plan.parameter_names.size(); ++i) {
+        ASSERT_EQ(plan.Owns(plan.parameter_names[i]), plan.owners[i] == rank);
+      }
+    }
+
+    for (size_t i = 0; i < plan.parameter_names.size(); ++i) {
+      rank_sizes[plan.owners[i]] +=
+          module_checkpoint_state.named_parameters.at(plan.parameter_names[i])->Data().Get<Tensor>().Shape().Size();
+    }
+
+    // The collective kernels pad the total size of their inputs to equal partitions of a multiple of
+    // 32 elements, with one alignment more if the total size is already a multiple.
+    ASSERT_EQ(plan.partition_size % 32, 0);
+    ASSERT_EQ(plan.padding_sizes.size(), static_cast<size_t>(world_size));
+    int64_t total_size = 0;
+    for (int32_t rank = 0; rank < world_size; ++rank) {
+      ASSERT_GE(plan.padding_sizes[rank], 0);
+      ASSERT_EQ(rank_sizes[rank] + plan.padding_sizes[rank] + (rank + 1 == world_size ? 1 : 0),
+                plan.partition_size);
+      total_size += rank_sizes[rank] + plan.padding_sizes[rank];
+    }
+    const int64_t alignment = 32 * world_size;
+    ASSERT_EQ(total_size + alignment - total_size % alignment, plan.partition_size * world_size);
+  }
+}
+
 #if defined(USE_CUDA)
 
 TEST(TrainingApiTest, ModuleExportModelForInferencingCUDA) {
@@ -0,0 +1,88 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test/util/include/default_providers.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace contrib {
+namespace test {
+
+using namespace onnxruntime::test;
+
+namespace {
+
+// X is [3, 2] and W is [2, 5]. The second sample is ignored, and a chunk size of 2 splits the 5 classes into
+// 3 chunks, the last one partial.
+const std::vector<float> kX{0.5f, -1.0f, 1.5f, 0.25f, -0.75f, 2.0f};
+const std::vector<float> kW{0.1f, -0.2f, 0.3f, 0.4f, -0.5f, 0.6f, 0.7f, -0.8f, 0.9f, 1.0f};
+const std::vector<int64_t> kLabels{4, -1, 2};
+const std::vector<float> kClassWeights{1.0f, 2.0f, 0.5f, 1.0f, 1.5f};
+const std::vector<float> kLogSumExp{1.480485f, 1.857047f, 3.143532f};
+
+void RunMatMulSceLossTest(bool use_class_weights, float expected_loss) {
+  OpTester test("MatMulSoftmaxCrossEntropyLossInternal", 1, kMSDomain);
+  test.AddAttribute("reduction", std::string("mean"));
+  test.AddAttribute("chunk_size", int64_t{2});
+  test.AddInput<float>("X", {3, 2}, kX);
+  test.AddInput<float>("W", {2, 5}, kW);
+  test.AddInput<int64_t>("labels", {3}, kLabels);
+  if (use_class_weights) {
+    test.AddInput<float>("weights", {5}, kClassWeights);
+  }
+  test.AddOutput<float>("output", {}, {expected_loss});
+  test.AddOutput<float>("log_sum_exp", {3}, kLogSumExp);
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.emplace_back(DefaultCpuExecutionProvider());
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+
+void RunMatMulSceLossGradTest(bool use_class_weights, const std::vector<float>& expected_dX,
+                              const std::vector<float>& expected_dW) {
+  OpTester test("MatMulSoftmaxCrossEntropyLossInternalGrad", 1, kMSDomain);
+  test.AddAttribute("reduction", std::string("mean"));
+  test.AddAttribute("chunk_size", int64_t{2});
+  test.AddInput<float>("dY", {}, {2.0f});
+  test.AddInput<float>("X", {3, 2}, kX);
+  test.AddInput<float>("W", {2, 5}, kW);
+  test.AddInput<float>("log_sum_exp", {3}, kLogSumExp);
+  test.AddInput<int64_t>("label", {3}, kLabels);
+  if (use_class_weights) {
+    test.AddInput<float>("weight", {5}, kClassWeights);
+  }
+  test.AddOutput<float>("dX", {3, 2}, expected_dX);
+  test.AddOutput<float>("dW", {2, 5}, expected_dW);
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.emplace_back(DefaultCpuExecutionProvider());
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+
+}  // namespace
+
+TEST(MatMulSoftmaxCrossEntropyLossTest, Mean) {
+  RunMatMulSceLossTest(false, 3.849509f);
+}
+
+TEST(MatMulSoftmaxCrossEntropyLossTest, MeanWithClassWeights) {
+  RunMatMulSceLossTest(true, 3.289997f);
+}
+
+TEST(MatMulSoftmaxCrossEntropyLossTest, GradMean) {
+  RunMatMulSceLossGradTest(false,
+                           {0.681777f, -1.153453f, 0.0f, 0.0f, -0.479799f, 1.654052f},
+                           {-0.034002f, -0.101288f, 1.038945f, -0.088479f, -0.815176f,
+                            0.134429f, 0.304179f, -2.574413f, 0.273606f, 1.862199f});
+}
+
+TEST(MatMulSoftmaxCrossEntropyLossTest, GradMeanWithClassWeights) {
+  RunMatMulSceLossGradTest(true,
+                           {1.022665f, -1.730179f, 0.0f, 0.0f, -0.239899f, 0.827026f},
+                           {0.048635f, 0.000473f, 0.813632f, 0.012254f, -0.874994f,
+                            -0.064057f, 0.049855f, -1.875526f, 0.023816f, 1.865912f});
+}
+
+}  // namespace test
+}  // namespace contrib
+}  // namespace onnxruntime
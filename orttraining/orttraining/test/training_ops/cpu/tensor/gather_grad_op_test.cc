@@ -8,6 +8,7 @@
 #include "test/common/cuda_op_test_utils.h"
 #include "test/common/tensor_op_test_utils.h"
 #include "test/providers/provider_test_utils.h"
+#include "test/util/include/default_providers.h"
 #include "test/util/include/test_random_seed.h"
 
 namespace onnxruntime {
@@ -172,6 +173,35 @@ TEST(GatherGradOpTest, GatherGrad_negative_indices) {
   test.Run();
 }
 
+TEST(GatherSparseGradOpTest, GatherSparseGrad_indices1d_float) {
+  OpTester test("GatherSparseGrad", 1, kMSDomain);
+  test.AddInput<int64_t>("shape", {2}, {4, 3});
+  test.AddInput<int64_t>("indices", {3}, {2LL, 0LL, -2LL});
+  test.AddInput<float>("dY", {3, 3}, {1, 2, 3, 4, 5, 6, 7, 8, 9});
+
+  // Rows 1 and 3 have no gradient; both occurrences of row 2 are summed.
+  test.AddOutput<int64_t>("grad_indices", {2}, {0, 2});
+  test.AddOutput<float>("grad_values", {2, 3}, {4, 5, 6, 8, 10, 12});
+
+  std::vector<std::unique_ptr<IExecutionProvider>> providers;
+  providers.emplace_back(DefaultCpuExecutionProvider());
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &providers);
+}
+
+TEST(GatherSparseGradOpTest, GatherSparseGrad_indices2d_float) {
+  OpTester test("GatherSparseGrad", 1, kMSDomain);
+  test.AddInput<int64_t>("shape", {3}, {3, 1, 2});
+  test.AddInput<int32_t>("indices", {2, 2}, {1, 1, 0, 1});
+  test.AddInput<float>("dY", {2, 2, 1, 2}, {1, 2, 3, 4, 5, 6, 7, 8});
+
+  test.AddOutput<int64_t>("grad_indices", {2}, {0, 1});
+  test.AddOutput<float>("grad_values", {2, 1, 2}, {5, 6, 11, 14});
+
+  std::vector<std::unique_ptr<IExecutionProvider>> providers;
+  providers.emplace_back(DefaultCpuExecutionProvider());
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &providers);
+}
+
 TEST(GatherGradOpTest, Gather_axis1_float_impl2) {
   RunGatherGradTestWithRandomData<float>(1, {3, 4}, {6, 128});
 }
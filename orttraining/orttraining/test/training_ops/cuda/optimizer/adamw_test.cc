@@ -361,6 +361,34 @@ TEST(AdamWTest, HFAdamWMultipleWeightsStrictTest_Loop10Steps) {
   HFAdamWMultipleWeightsTestLoop10Steps(true);
 }
 
+TEST(AdamWTest, TorchSparseAdamWSingleWeightTest_CPU) {
+  OpTester test("SparseAdamWOptimizer", 1, onnxruntime::kMSDomain);
+  test.AddAttribute("alpha", 0.9f);
+  test.AddAttribute("beta", 0.999f);
+  test.AddAttribute("epsilon", 1e-8f);
+  test.AddAttribute("weight_decay", 0.f);
+  test.AddAttribute("adam_mode", static_cast<int64_t>(0));
+  test.AddAttribute("correct_bias", static_cast<int64_t>(1));
+
+  test.AddInput<float>("lr", {}, {0.1f});
+  test.AddInput<int64_t>("step", {}, {1});
+  test.AddInput<float>("weight", {2, 2}, {1.f, 2.f, 3.f, 4.f});
+  test.AddInput<int64_t>("grad_indices", {1}, {1});
+  test.AddInput<float>("grad_values", {1, 2}, {0.5f, -0.5f});
+  test.AddInput<float>("momentum_1", {2, 2}, {0.f, 0.f, 0.f, 0.f});
+  test.AddInput<float>("momentum_2", {2, 2}, {0.f, 0.f, 0.f, 0.f});
+
+  // Only the second row is updated; the moments of the first row stay zero.
+  test.AddOutput<int64_t>("updated_flag", {}, {1});
+  test.AddOutput<float>("updated_weight", {2, 2}, {1.f, 2.f, 2.9f, 4.1f});
+  test.AddOutput<float>("updated_momentum_1", {2, 2}, {0.f, 0.f, 0.05f, -0.05f});
+  test.AddOutput<float>("updated_momentum_2", {2, 2}, {0.f, 0.f, 0.00025f, 0.00025f});
+
+  std::vector<std::unique_ptr<IExecutionProvider>> providers;
+  providers.emplace_back(DefaultCpuExecutionProvider());
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &providers);
+}
+
 }  // namespace
 
 }  // namespace optimizer
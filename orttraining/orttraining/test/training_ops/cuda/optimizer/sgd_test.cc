@@ -296,6 +296,38 @@ TEST(SGDOptimizerV2Test, SGDMultipleWeightsNoUpdateTest_Loop10Steps) {
   SGDMultipleWeightsTestLoop10Steps(true, &update_signal);
 }
 
+TEST(SGDOptimizerV2Test, SparseSGDSingleWeightTest_CPU) {
+  OpTester test("SparseSGDOptimizer", 1, onnxruntime::kMSDomain);
+  test.AddInput<float>("lr", {}, {0.5f});
+  test.AddInput<float>("weight", {3, 2}, {1.f, 2.f, 3.f, 4.f, 5.f, 6.f});
+  test.AddInput<int64_t>("grad_indices", {2}, {0, 2});
+  test.AddInput<float>("grad_values", {2, 2}, {2.f, 2.f, 4.f, 4.f});
+
+  // The second row has no gradient and is left as it is.
+  test.AddOutput<bool>("update_completed", {}, {true});
+  test.AddOutput<float>("updated_weight", {3, 2}, {0.f, 1.f, 3.f, 4.f, 3.f, 4.f});
+
+  std::vector<std::unique_ptr<IExecutionProvider>> providers;
+  providers.emplace_back(DefaultCpuExecutionProvider());
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &providers);
+}
+
+TEST(SGDOptimizerV2Test, SparseSGDSingleWeightNoUpdateTest_CPU) {
+  OpTester test("SparseSGDOptimizer", 1, onnxruntime::kMSDomain);
+  test.AddInput<float>("lr", {}, {0.5f});
+  test.AddInput<float>("weight", {3, 2}, {1.f, 2.f, 3.f, 4.f, 5.f, 6.f});
+  test.AddInput<int64_t>("grad_indices", {2}, {0, 2});
+  test.AddInput<float>("grad_values", {2, 2}, {2.f, 2.f, 4.f, 4.f});
+  test.AddInput<bool>("update_signal", {}, {false});
+
+  test.AddOutput<bool>("update_completed", {}, {false});
+  test.AddOutput<float>("updated_weight", {3, 2}, {1.f, 2.f, 3.f, 4.f, 5.f, 6.f});
+
+  std::vector<std::unique_ptr<IExecutionProvider>> providers;
+  providers.emplace_back(DefaultCpuExecutionProvider());
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &providers);
+}
+
 }  // namespace
 
 }  // namespace optimizer
@@ -3,10 +3,13 @@
 
 #include "orttraining/training_api/checkpoint.h"
 
+#include <string_view>
+
 #include "core/flatbuffers/checkpoint_version.h"
 #include "core/flatbuffers/schema/ort_training_checkpoint.fbs.h"
 #include "core/framework/framework_common.h"
 #include "core/graph/graph_flatbuffers_utils.h"
+#include "core/providers/cpu/tensor/utils.h"
 
 namespace onnxruntime::training::api {
 
@@ -211,7 +214,7 @@ Status FromTensorProtos(
     for (const auto& tensor_proto : tensor_protos) {
       flatbuffers::Offset<fbs::Tensor> fbs_tensor;
       ORT_RETURN_IF_ERROR(
-          fbs::utils::SaveInitializerOrtFormat(builder, tensor_proto, Path(), fbs_tensor));
+          fbs::utils::SaveInitializerOrtFormat(builder, tensor_proto, Path(), OrtFormatSaveOptions{}, fbs_tensor));
       fbs_tensors.push_back(fbs_tensor);
     }
 
@@ -713,8 +716,185 @@ Status ToCheckpointState(gsl::span<const uint8_t> checkpoint_bytes, CheckpointSt
   return Status::OK();
 }
 
+/**
+ * @brief Load a delta checkpoint state on top of a checkpoint state.
+ *
+ * @param delta_state Checkpoint state of the delta, holding the tensors that changed.
+ * @param state Checkpoint state to be updated.
+ * @return Status of the operation.
+ */
+Status ApplyDelta(CheckpointState& delta_state, CheckpointState& state) {
+  auto& named_parameters = state.module_checkpoint_state.named_parameters;
+  for (auto& [name, param] : delta_state.module_checkpoint_state.named_parameters) {
+    named_parameters.insert_or_assign(name, std::move(param));
+  }
+
+  auto& group_named_optimizer_states = state.optimizer_checkpoint_state.group_named_optimizer_states;
+  for (auto& [group_name, delta_group_state] : delta_state.optimizer_checkpoint_state.group_named_optimizer_states) {
+    auto& group_state = group_named_optimizer_states[group_name];
+    if (!group_state) {
+      group_state = std::make_shared<GroupOptimizerState>();
+    }
+
+    group_state->step = delta_group_state->step;
+    group_state->initial_lr = delta_group_state->initial_lr;
+    for (auto& [param_name, delta_param_state] : delta_group_state->param_named_optimizer_states) {
+      auto& param_state = group_state->param_named_optimizer_states[param_name];
+      for (auto& [momentum_name, momentum] : delta_param_state) {
+        param_state.insert_or_assign(momentum_name, std::move(momentum));
+      }
+    }
+  }
+
+  // The properties of the delta replace the properties of the same name.
+  PropertyBag property_bag = delta_state.property_bag;
+  for (const auto& [name, value] : state.property_bag) {
+    if (!property_bag.HasProperty(name)) {
+      property_bag.AddProperty(name, value);
+    }
+  }
+  state.property_bag = std::move(property_bag);
+
+  return Status::OK();
+}
+
 }  // namespace load
 
+namespace snapshot {
+
+/**
+ * @brief Copy an OrtValue tensor to a cpu buffer owned by the snapshot.
+ *
+ * @param ort_value OrtValue to copy.
+ * @param data_transfer_manager Data transfer manager to copy the tensor from a device.
+ * @param snapshot_ort_value OrtValue to be populated.
+ * @return Status of the operation.
+ */
+Status FromOrtValue(const OrtValue& ort_value, const DataTransferManager* data_transfer_manager,
+                    OrtValue& snapshot_ort_value) {
+  ORT_RETURN_IF_NOT(ort_value.IsTensor(), "Only tensor OrtValues can be saved to a checkpoint.");
+  const onnxruntime::Tensor& src_tensor = ort_value.Get<onnxruntime::Tensor>();
+
+  static CPUExecutionProviderInfo info;
+  static CPUExecutionProvider cpu_provider(info);
+  static AllocatorPtr cpu_allocator = cpu_provider.CreatePreferredAllocators()[0];
+
+  onnxruntime::Tensor::InitOrtValue(src_tensor.DataType(), src_tensor.Shape(), cpu_allocator, snapshot_ort_value);
+  onnxruntime::Tensor& dst_tensor = *snapshot_ort_value.GetMutable<onnxruntime::Tensor>();
+  if (src_tensor.Location().device.Type() == OrtDevice::CPU) {
+    CopyCpuTensor(&src_tensor, &dst_tensor);
+  } else {
+    ORT_RETURN_IF_NOT(data_transfer_manager,
+                      "Cannot save OrtValue to a checkpoint. Expected: A valid data transfer manager. ",
+                      "Actual: nullptr.");
+    ORT_RETURN_IF_ERROR(data_transfer_manager->CopyTensor(src_tensor, dst_tensor));
+  }
+
+  return Status::OK();
+}
+
+/**
+ * @brief Copy the training states to cpu buffers, so that they can be saved while training goes on.
+ *
+ * @param state parameter/optimizer and other user defined training states.
+ * @param include_optimizer_state Whether to include optimizer state in the snapshot.
+ * @param snapshot_state Checkpoint state to be populated.
+ * @return Status of the operation.
+ */
+Status FromCheckpointState(const CheckpointState& state, const bool include_optimizer_state,
+                           CheckpointState& snapshot_state) {
+  const ModuleCheckpointState& module_state = state.module_checkpoint_state;
+  snapshot_state.module_checkpoint_state.train_session_data_transfer_mgr = nullptr;
+  for (const auto& [name, param] : module_state.named_parameters) {
+    OrtValue snapshot_value;
+    ORT_RETURN_IF_ERROR(FromOrtValue(param->Data(), module_state.train_session_data_transfer_mgr, snapshot_value));
+    snapshot_state.module_checkpoint_state.named_parameters.insert(
+        {name, std::make_shared<Parameter>(name, snapshot_value, param->RequiresGrad())});
+  }
+
+  const OptimizerCheckpointState& optimizer_state = state.optimizer_checkpoint_state;
+  snapshot_state.optimizer_checkpoint_state.optimizer_session_data_transfer_mgr = nullptr;
+  if (include_optimizer_state) {
+    for (const auto& [group_name, group_state] : optimizer_state.group_named_optimizer_states) {
+      auto snapshot_group_state = std::make_shared<GroupOptimizerState>();
+      snapshot_group_state->step = group_state->step;
+      snapshot_group_state->initial_lr = group_state->initial_lr;
+      snapshot_group_state->learning_rate = group_state->learning_rate;
+      for (const auto& [param_name, param_state] : group_state->param_named_optimizer_states) {
+        auto& snapshot_param_state = snapshot_group_state->param_named_optimizer_states[param_name];
+        for (const auto& [momentum_name, momentum] : param_state) {
+          ORT_RETURN_IF_ERROR(FromOrtValue(momentum, optimizer_state.optimizer_session_data_transfer_mgr,
+                                           snapshot_param_state[momentum_name]));
+        }
+      }
+      snapshot_state.optimizer_checkpoint_state.group_named_optimizer_states.insert(
+          {group_name, std::move(snapshot_group_state)});
+    }
+  }
+
+  snapshot_state.property_bag = state.property_bag;
+
+  return Status::OK();
+}
+
+size_t Fingerprint(const OrtValue& ort_value) {
+  const onnxruntime::Tensor& tensor = ort_value.Get<onnxruntime::Tensor>();
+  return std::hash<std::string_view>{}(
+      std::string_view(static_cast<const char*>(tensor.DataRaw()), tensor.SizeInBytes()));
+}
+
+/**
+ * @brief Fingerprint the tensors of a snapshot and, for a delta, drop the tensors that did not change.
+ *
+ * @param saved_fingerprints Fingerprints of the tensors in the checkpoints written before.
+ * @param save_delta Whether to drop the tensors whose fingerprint is in saved_fingerprints.
+ * @param snapshot_state Checkpoint state of the snapshot.
+ * @param fingerprints Fingerprints of the tensors left in the snapshot.
+ */
+void KeepChangedTensors(const InlinedHashMap<std::string, size_t>& saved_fingerprints, const bool save_delta,
+                        CheckpointState& snapshot_state, InlinedHashMap<std::string, size_t>& fingerprints) {
+  // Returns whether the tensor is kept in the snapshot.
+  const auto keep_tensor = [&](const std::string& key, const OrtValue& ort_value) {
+    const size_t fingerprint = Fingerprint(ort_value);
+    if (save_delta) {
+      const auto it = saved_fingerprints.find(key);
+      if (it != saved_fingerprints.end() && it->second == fingerprint) {
+        return false;
+      }
+    }
+    fingerprints[key] = fingerprint;
+    return true;
+  };
+
+  auto& named_parameters = snapshot_state.module_checkpoint_state.named_parameters;
+  for (auto it = named_parameters.begin(); it != named_parameters.end();) {
+    it = keep_tensor("param/" + it->first, it->second->Data()) ? std::next(it) : named_parameters.erase(it);
+  }
+
+  for (auto& [group_name, group_state] : snapshot_state.optimizer_checkpoint_state.group_named_optimizer_states) {
+    InlinedVector<std::string> unchanged_params;
+    for (auto& [param_name, param_state] : group_state->param_named_optimizer_states) {
+      InlinedVector<std::string> unchanged_momentums;
+      for (const auto& [momentum_name, momentum] : param_state) {
+        if (!keep_tensor("optimizer/" + group_name + "/" + param_name + "/" + momentum_name, momentum)) {
+          unchanged_momentums.push_back(momentum_name);
+        }
+      }
+      for (const auto& momentum_name : unchanged_momentums) {
+        param_state.erase(momentum_name);
+      }
+      if (param_state.empty()) {
+        unchanged_params.push_back(param_name);
+      }
+    }
+    for (const auto& param_name : unchanged_params) {
+      group_state->param_named_optimizer_states.erase(param_name);
+    }
+  }
+}
+
+}  // namespace snapshot
+
 }  // namespace
 
 #if !defined(ORT_MINIMAL_BUILD)
@@ -732,6 +912,60 @@ Status SaveCheckpoint(const CheckpointState& states, const PathString& checkpoin
   return save::FromCheckpointState(states, checkpoint_path, include_optimizer_state);
 }
 
+AsyncCheckpointWriter::~AsyncCheckpointWriter() {
+  const Status status = Wait();
+  if (!status.IsOK()) {
+    LOGS_DEFAULT(WARNING) << "Failed to write the last checkpoint: " << status.ErrorMessage();
+  }
+}
+
+Status AsyncCheckpointWriter::Save(const CheckpointState& state, const PathString& checkpoint_path,
+                                   const bool include_optimizer_state, const bool save_delta) {
+  ORT_RETURN_IF_NOT(FLATBUFFERS_LITTLEENDIAN, "ORT training checkpoint format only supports little-endian machines");
+
+  // The fingerprints of the previous checkpoint must be known before a delta is taken.
+  ORT_RETURN_IF_ERROR(Wait());
+
+  CheckpointState snapshot_state;
+  ORT_RETURN_IF_ERROR(snapshot::FromCheckpointState(state, include_optimizer_state, snapshot_state));
+
+  writer_ = std::thread([this, snapshot_state = std::move(snapshot_state), checkpoint_path,
+                         include_optimizer_state, save_delta]() mutable {
+    ORT_TRY {
+      InlinedHashMap<std::string, size_t> fingerprints;
+      snapshot::KeepChangedTensors(saved_fingerprints_, save_delta, snapshot_state, fingerprints);
+      status_ = save::FromCheckpointState(snapshot_state, checkpoint_path, include_optimizer_state);
+
+      // Later deltas are taken against this checkpoint only once it is written.
+      if (status_.IsOK()) {
+        if (!save_delta) {
+          saved_fingerprints_.clear();
+        }
+        for (const auto& [key, fingerprint] : fingerprints) {
+          saved_fingerprints_[key] = fingerprint;
+        }
+      }
+    }
+    ORT_CATCH(const std::exception& ex) {
+      ORT_HANDLE_EXCEPTION([&]() {
+        status_ = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Failed to write checkpoint: ", ex.what());
+      });
+    }
+  });
+
+  return Status::OK();
+}
+
+Status AsyncCheckpointWriter::Wait() {
+  if (writer_.joinable()) {
+    writer_.join();
+  }
+
+  Status status = status_;
+  status_ = Status::OK();
+  return status;
+}
+
 Status LoadCheckpoint(const PathString& checkpoint_path, CheckpointState& checkpoint_states) {
   ORT_RETURN_IF_NOT(FLATBUFFERS_LITTLEENDIAN, "ORT training checkpoint format only supports little-endian machines");
 
@@ -740,6 +974,20 @@ Status LoadCheckpoint(const PathString& checkpoint_path, CheckpointState& checkp
   return load::ToCheckpointState(checkpoint_bytes, checkpoint_states);
 }
 
+Status LoadCheckpointWithDeltas(const PathString& checkpoint_path,
+                                gsl::span<const PathString> delta_checkpoint_paths,
+                                CheckpointState& checkpoint_state) {
+  ORT_RETURN_IF_ERROR(LoadCheckpoint(checkpoint_path, checkpoint_state));
+
+  for (const auto& delta_checkpoint_path : delta_checkpoint_paths) {
+    CheckpointState delta_state;
+    ORT_RETURN_IF_ERROR(LoadCheckpoint(delta_checkpoint_path, delta_state));
+    ORT_RETURN_IF_ERROR(load::ApplyDelta(delta_state, checkpoint_state));
+  }
+
+  return Status::OK();
+}
+
 Status LoadCheckpointFromBuffer(gsl::span<const uint8_t> checkpoint_bytes, CheckpointState& checkpoint_state) {
   ORT_RETURN_IF_NOT(FLATBUFFERS_LITTLEENDIAN, "ORT training checkpoint format only supports little-endian machines");
 
@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <thread>
+
 #include "core/platform/path_lib.h"
 #include "orttraining/training_api/checkpoint_property.h"
 #include "orttraining/training_api/module.h"
@@ -42,6 +44,51 @@ struct CheckpointState {
 Status SaveCheckpoint(const CheckpointState& state, const PathString& checkpoint_path,
                       const bool include_optimizer_state);
 
+/**
+ * @brief Writes ORT checkpoints in the background.
+ *
+ * Save() only copies the training states to cpu buffers before returning, so training waits for the
+ * snapshot of the states, not for their serialization and the file write, which happen on a separate thread.
+ * One checkpoint is written at a time: Save() first waits for the previous checkpoint to be written.
+ *
+ * A delta checkpoint only holds the parameters and optimizer momentums that changed since the previous
+ * checkpoint of this writer, along with the optimizer steps and the properties. It is loaded on top of the
+ * checkpoints written before it with LoadCheckpointWithDeltas.
+ */
+struct AsyncCheckpointWriter {
+ public:
+  AsyncCheckpointWriter() = default;
+  ~AsyncCheckpointWriter();
+
+  /**
+   * @brief Snapshot the training states, and write them as ORT checkpoint in the background.
+   *
+   * @param state parameter/optimizer and other user defined training states.
+   * @param checkpoint_path file where checkpoint is saved.
+   * @param include_optimizer_state whether to save the optimizer states.
+   * @param save_delta whether to only save the tensors that changed since the previous checkpoint.
+   * @return Status of the snapshot, or the failure to write the previous checkpoint.
+   */
+  Status Save(const CheckpointState& state, const PathString& checkpoint_path,
+              const bool include_optimizer_state, const bool save_delta = false);
+
+  /**
+   * @brief Wait for the checkpoint being written.
+   *
+   * @return Status of writing the checkpoint.
+   */
+  Status Wait();
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(AsyncCheckpointWriter);
+
+  std::thread writer_;
+  Status status_;
+
+  // Fingerprints of the tensors in the checkpoints written so far, to find the tensors that changed.
+  InlinedHashMap<std::string, size_t> saved_fingerprints_;
+};
+
 #if !defined(ORT_MINIMAL_BUILD)
 /**
  * @brief Save ONNX initializers as ORT checkpoint.
@@ -66,6 +113,18 @@ Status SaveCheckpoint(gsl::span<const ONNX_NAMESPACE::TensorProto> trainable_ten
 Status LoadCheckpoint(const PathString& checkpoint_path,
                       CheckpointState& checkpoint_state);
 
+/**
+ * @brief Load training states from ORT checkpoint and the delta checkpoints written after it.
+ *
+ * @param checkpoint_path file where the full checkpoint is stored.
+ * @param delta_checkpoint_paths files where the delta checkpoints are stored, in the order they were written.
+ * @param checkpoint_state parameter/optimizer and other user defined training states.
+ * @return Status
+ */
+Status LoadCheckpointWithDeltas(const PathString& checkpoint_path,
+                                gsl::span<const PathString> delta_checkpoint_paths,
+                                CheckpointState& checkpoint_state);
+
 /**
  * @brief Load training states from ORT checkpoint bytes buffer.
  * @param checkpoint_bytes bytes buffer of the checkpoint.
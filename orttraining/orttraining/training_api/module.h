@@ -49,7 +49,7 @@ struct Parameter {
 struct ModuleCheckpointState {
  public:
   std::unordered_map<std::string, std::shared_ptr<Parameter>> named_parameters;
-  const DataTransferManager* train_session_data_transfer_mgr;
+  const DataTransferManager* train_session_data_transfer_mgr{nullptr};
 };
 
 struct CheckpointState;
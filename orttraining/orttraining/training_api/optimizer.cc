@@ -8,6 +8,7 @@
 #include "core/providers/cpu/cpu_execution_provider.h"
 #include "core/session/inference_session.h"
 #include "core/session/environment.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 
 #include "orttraining/training_api/checkpoint.h"
 #include "orttraining/training_api/utils.h"
@@ -123,7 +124,7 @@ Status Optimizer::GenerateMomentumNamedStates(OptimizerCheckpointState& optimize
   auto& param_named_optimizer_states = optimizer_state_->param_named_optimizer_states;
   auto& optim_sess_state = optim_sess_->GetSessionState();
   for (auto& pair : state_->module_checkpoint_state.named_parameters) {
-    if (pair.second->RequiresGrad()) {
+    if (pair.second->RequiresGrad() && sharding_plan_.Owns(pair.first)) {
       param_named_optimizer_states.insert({pair.first, ParameterOptimizerState()});
       ParameterOptimizerState& cur_param_optimizer_states = param_named_optimizer_states[pair.first];
       for (auto& state_name : optimizer_algo_ptr_->momentum_keys) {
@@ -150,7 +151,7 @@ Status Optimizer::ConstructInputs() {
 
   // Collect all the non-user-defined inputs from the named_parameters_.
   for (auto& [parameter_name, parameter] : state_->module_checkpoint_state.named_parameters) {
-    if (parameter->RequiresGrad()) {
+    if (parameter->RequiresGrad() && sharding_plan_.Owns(parameter_name)) {
       // Collect parameters and prepare for tensorseq creation
       auto* param_tensor = parameter->Data().GetMutable<Tensor>();
       params.emplace_back(
@@ -176,6 +177,11 @@ Status Optimizer::ConstructInputs() {
     }
   }
 
+  // A rank of a sharded optimizer may not own any parameter, and then does not run the optimizer graph.
+  if (params.empty() && sharding_plan_.IsSharded()) {
+    return Status::OK();
+  }
+
   const auto tensorseq_inserter = [](auto& tensors, auto* inputs) {
     ORT_ENFORCE(!tensors.empty(), "Tensors vector cannot be empty while building a tensor sequence.");
 
@@ -209,6 +215,8 @@ Optimizer::Optimizer(const std::string& optim_path_or_bytes,
   Initialize(optim_path_or_bytes, providers);
 
   ORT_ENFORCE(state != nullptr, "Checkpoint state cannot be null.");
+  InitializeSharding(session_options, env, providers);
+
   auto g_it = state_->optimizer_checkpoint_state.group_named_optimizer_states.find(GROUP_ZERO_NAME);
   bool find_group_zero = g_it != state_->optimizer_checkpoint_state.group_named_optimizer_states.end();
   if (!find_group_zero || g_it->second->param_named_optimizer_states.empty()) {
@@ -249,7 +257,35 @@ void Optimizer::Initialize(const std::string& optim_path_or_bytes,
   ORT_THROW_IF_ERROR(GraphInputsAreExpected(input_names_, all_input_names));
 }
 
+void Optimizer::InitializeSharding(const onnxruntime::SessionOptions& session_options,
+                                   const Environment& env,
+                                   const std::vector<std::shared_ptr<IExecutionProvider>>& providers) {
+  if (session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsShardOptimizerState, "0") != "1") {
+    return;
+  }
+
+  int32_t rank = 0;
+  int32_t world_size = 1;
+  ORT_THROW_IF_ERROR(GetOptimizerShardingGroup(rank, world_size));
+  ORT_THROW_IF_ERROR(CreateOptimizerShardingPlan(state_->module_checkpoint_state, rank, world_size, sharding_plan_));
+
+  if (sharding_plan_.IsSharded()) {
+    sharding_collectives_ = std::make_unique<OptimizerShardingCollectives>(
+        sharding_plan_, state_->module_checkpoint_state, session_options, env, providers);
+  }
+}
+
 Status Optimizer::Step() {
+  if (sharding_collectives_) {
+    ORT_RETURN_IF_ERROR(sharding_collectives_->ReduceScatterGradients());
+
+    if (inputs_.empty()) {
+      ORT_RETURN_IF_ERROR(sharding_collectives_->AllGatherParameters());
+      optimizer_state_->step++;
+      return Status::OK();
+    }
+  }
+
   OrtValue learning_rate_input, step_input;
   utils::WrapInOrtValue<float>(optimizer_state_->learning_rate, &learning_rate_input);
   // Use step count + 1 before running optimizer step.
@@ -263,6 +299,10 @@ Status Optimizer::Step() {
   auto status = optim_sess_->Run(RunOptions(), input_names_, feeds, output_names_, &outputs);
   ORT_THROW_IF_ERROR(status);
 
+  if (sharding_collectives_) {
+    ORT_RETURN_IF_ERROR(sharding_collectives_->AllGatherParameters());
+  }
+
   // Extract step output and update
   if (utils::GetScalarFromOrtValue<int64_t>(outputs[0]) == 1LL) {
     optimizer_state_->step++;
@@ -285,7 +325,10 @@ Status Optimizer::LoadStateDict(OptimizerCheckpointState& optimizer_checkpoint_s
   auto& param_named_optimizer_states = optimizer_state_->param_named_optimizer_states;
 
   for (auto& params_iter : state_->module_checkpoint_state.named_parameters) {
-    if (params_iter.second->RequiresGrad()) {
+    if (params_iter.second->RequiresGrad() && !sharding_plan_.Owns(params_iter.first)) {
+      // Another rank updates this parameter, so its states are not needed here.
+      param_named_optimizer_states.erase(params_iter.first);
+    } else if (params_iter.second->RequiresGrad()) {
       bool src_exist = param_named_optimizer_states.find(params_iter.first) !=
                        param_named_optimizer_states.cend();
 
@@ -8,6 +8,7 @@
 #include "core/session/environment.h"
 
 #include "orttraining/training_api/module.h"
+#include "orttraining/training_api/optimizer_sharding.h"
 
 namespace onnxruntime {
 namespace training {
@@ -42,7 +43,7 @@ struct GroupOptimizerState {
 struct OptimizerCheckpointState {
  public:
   InlinedHashMap<std::string, std::shared_ptr<GroupOptimizerState>> group_named_optimizer_states;
-  const DataTransferManager* optimizer_session_data_transfer_mgr;
+  const DataTransferManager* optimizer_session_data_transfer_mgr{nullptr};
 };
 
 struct OptimizerAlgorithmBase {
@@ -86,6 +87,10 @@ struct CheckpointState;
  * > If 'optimizer_checkpoint_states' is not provided in the constructor as part of `CheckpointState`.
  *   The optimizer states are initialized as all zeros on the same device of corresponding parameters.
  *
+ * > If kOrtSessionOptionsShardOptimizerState is set in the session options, every data parallel rank
+ *   keeps the optimizer states of its share of the parameters only (see OptimizerShardingPlan).
+ *   States of other parameters in 'optimizer_checkpoint_states' are released.
+ *
  * Currently, we only support load checkpoints from the constructor;
  * no public API to load state dict after Optimizer instance is created.
  */
@@ -123,6 +128,10 @@ struct Optimizer {
   void Initialize(const std::string& optim_path_or_bytes,
                   const std::vector<std::shared_ptr<IExecutionProvider>>& providers);
 
+  void InitializeSharding(const onnxruntime::SessionOptions& session_options,
+                          const Environment& env,
+                          const std::vector<std::shared_ptr<IExecutionProvider>>& providers);
+
   int64_t GetStep() const {
     return optimizer_state_->step;
   }
@@ -155,6 +164,9 @@ struct Optimizer {
   InlinedVector<OrtValue> inputs_;
 
   int32_t group_count_{0};
+
+  OptimizerShardingPlan sharding_plan_;
+  std::unique_ptr<OptimizerShardingCollectives> sharding_collectives_;
 };
 
 }  // namespace api
@@ -0,0 +1,257 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "orttraining/training_api/optimizer_sharding.h"
+
+#include <algorithm>
+
+#include "core/common/safeint.h"
+#include "core/framework/tensor.h"
+#include "core/graph/model.h"
+
+#if defined(ENABLE_TRAINING) && defined(ORT_USE_NCCL)
+#include "onnx/defs/attr_proto_util.h"
+#include "orttraining/core/framework/distributed_run_context.h"
+#if defined(USE_MPI)
+#include "orttraining/core/framework/communication/mpi/mpi_context.h"
+#endif
+#endif
+
+namespace onnxruntime {
+namespace training {
+namespace api {
+
+namespace {
+
+// The collective kernels pad the partitions of the ranks to multiples of 32 elements.
+constexpr int64_t PartitionAlignment = 32;
+
+#if defined(ENABLE_TRAINING) && defined(ORT_USE_NCCL) && !defined(ORT_MINIMAL_BUILD)
+// Builds a model with a single collective node, which takes the tensors as inputs and
+// returns them in place as outputs.
+Status CreateCollectiveModel(const std::string& op_type,
+                             int32_t element_type,
+                             gsl::span<const std::string> input_names,
+                             gsl::span<const TensorShape> shapes,
+                             gsl::span<const std::string> output_names,
+                             std::string& model_bytes) {
+  Model model(op_type, false, logging::LoggingManager::DefaultLogger());
+  Graph& graph = model.MainGraph();
+
+  std::vector<NodeArg*> inputs;
+  std::vector<NodeArg*> outputs;
+  for (size_t i = 0; i < input_names.size(); ++i) {
+    ONNX_NAMESPACE::TypeProto type_proto;
+    type_proto.mutable_tensor_type()->set_elem_type(element_type);
+    auto* shape_proto = type_proto.mutable_tensor_type()->mutable_shape();
+    for (auto dim : shapes[i].GetDims()) {
+      shape_proto->add_dim()->set_dim_value(dim);
+    }
+
+    inputs.push_back(&graph.GetOrCreateNodeArg(input_names[i], &type_proto));
+    outputs.push_back(&graph.GetOrCreateNodeArg(output_names[i], &type_proto));
+  }
+
+  NodeAttributes attributes;
+  attributes["group_type"] = ONNX_NAMESPACE::MakeAttribute(
+      "group_type", static_cast<int64_t>(WorkerGroupType::DataParallel));
+  graph.AddNode(op_type, op_type, "Optimizer sharding " + op_type, inputs, outputs, &attributes, kMSDomain);
+  ORT_RETURN_IF_ERROR(graph.Resolve());
+
+  model_bytes = model.ToProto().SerializeAsString();
+  return Status::OK();
+}
+#endif
+
+}  // namespace
+
+bool OptimizerShardingPlan::Owns(const std::string& parameter_name) const {
+  if (!IsSharded()) {
+    return true;
+  }
+
+  auto it = std::find(parameter_names.begin(), parameter_names.end(), parameter_name);
+  return it != parameter_names.end() && owners[std::distance(parameter_names.begin(), it)] == rank;
+}
+
+Status CreateOptimizerShardingPlan(const ModuleCheckpointState& module_checkpoint_state,
+                                   int32_t rank, int32_t world_size,
+                                   OptimizerShardingPlan& plan) {
+  ORT_RETURN_IF_NOT(world_size > 0 && rank >= 0 && rank < world_size,
+                    "Invalid rank ", rank, " of a data parallel group of size ", world_size, ".");
+
+  plan = OptimizerShardingPlan();
+  plan.rank = rank;
+  plan.world_size = world_size;
+
+  // The ranks must agree on the order of the parameters, which the hash map does not keep.
+  InlinedVector<std::pair<std::string, int64_t>> parameter_sizes;
+  const DataTypeImpl* element_type = nullptr;
+  for (const auto& [name, parameter] : module_checkpoint_state.named_parameters) {
+    if (!parameter->RequiresGrad()) {
+      continue;
+    }
+
+    const Tensor& tensor = parameter->Data().Get<Tensor>();
+    ORT_RETURN_IF_NOT(element_type == nullptr || element_type == tensor.DataType(),
+                      "Sharding the optimizer states requires trainable parameters of one element type, but ",
+                      name, " differs from the others.");
+    element_type = tensor.DataType();
+    parameter_sizes.emplace_back(name, tensor.Shape().Size());
+  }
+  std::sort(parameter_sizes.begin(), parameter_sizes.end());
+
+  int64_t total_size = 0;
+  for (const auto& parameter_size : parameter_sizes) {
+    total_size += parameter_size.second;
+  }
+
+  // Assign the parameters to the ranks in order, moving on to the next rank once the parameters
+  // of a rank reach an equal share of the elements.
+  InlinedVector<int64_t> rank_sizes(world_size, 0);
+  int32_t owner = 0;
+  int64_t assigned_size = 0;
+  for (const auto& [name, size] : parameter_sizes) {
+    while (owner + 1 < world_size && rank_sizes[owner] > 0 &&
+           assigned_size + size / 2 > SafeInt<int64_t>(total_size) * (owner + 1) / world_size) {
+      owner++;
+    }
+
+    plan.parameter_names.push_back(name);
+    plan.owners.push_back(owner);
+    rank_sizes[owner] += size;
+    assigned_size += size;
+  }
+
+  // The kernels pad the total size to the next multiple of the alignment times the world size, and a
+  // total size that is already a multiple gets a full alignment added. Leaving the last partition one
+  // element short keeps the padded total at exactly the partitions of the plan.
+  const int64_t largest_size = *std::max_element(rank_sizes.begin(), rank_sizes.end());
+  plan.partition_size = (largest_size + PartitionAlignment) / PartitionAlignment * PartitionAlignment;
+  for (int32_t r = 0; r < world_size; ++r) {
+    plan.padding_sizes.push_back(plan.partition_size - rank_sizes[r] - (r + 1 == world_size ? 1 : 0));
+  }
+
+  return Status::OK();
+}
+
+Status GetOptimizerShardingGroup(int32_t& rank, int32_t& world_size) {
+#if defined(ENABLE_TRAINING) && defined(ORT_USE_NCCL)
+#if defined(USE_MPI)
+  // The data parallel group spans all the processes, unless the application created the
+  // distributed run context with other parallel sizes first.
+  const auto& mpi_context = MPIContext::GetInstance();
+  DistributedRunConfig config;
+  config.world_rank = mpi_context.GetWorldRank();
+  config.world_size = mpi_context.GetWorldSize();
+  config.local_rank = mpi_context.GetLocalRank();
+  config.local_size = mpi_context.GetLocalSize();
+  config.data_parallel_size = mpi_context.GetWorldSize();
+  DistributedRunContext::CreateInstance(config);
+#endif
+  rank = DistributedRunContext::RankInGroup(WorkerGroupType::DataParallel);
+  world_size = DistributedRunContext::GroupSize(WorkerGroupType::DataParallel);
+#else
+  rank = 0;
+  world_size = 1;
+#endif
+  return Status::OK();
+}
+
+OptimizerShardingCollectives::OptimizerShardingCollectives(
+    const OptimizerShardingPlan& plan,
+    ModuleCheckpointState& module_checkpoint_state,
+    const onnxruntime::SessionOptions& session_options,
+    const Environment& env,
+    const std::vector<std::shared_ptr<IExecutionProvider>>& providers) {
+#if defined(ENABLE_TRAINING) && defined(ORT_USE_NCCL) && !defined(ORT_MINIMAL_BUILD)
+  ORT_ENFORCE(plan.IsSharded(), "The collectives are only needed by a sharded optimizer.");
+
+  const Tensor& first_parameter =
+      module_checkpoint_state.named_parameters.at(plan.parameter_names.front())->Data().Get<Tensor>();
+
+  InlinedVector<TensorShape> shapes;
+  InlinedVector<size_t> padding_indices;
+  size_t parameter_index = 0;
+  for (int32_t r = 0; r < plan.world_size; ++r) {
+    for (; parameter_index < plan.parameter_names.size() && plan.owners[parameter_index] == r; ++parameter_index) {
+      const auto& name = plan.parameter_names[parameter_index];
+      auto& parameter = module_checkpoint_state.named_parameters.at(name);
+      ORT_ENFORCE(parameter->Gradient().IsAllocated(), "Gradient buffer of parameter ", name, " is not allocated.");
+
+      shapes.push_back(parameter->Data().Get<Tensor>().Shape());
+      reduce_scatter_.input_names.push_back(parameter->GradientName());
+      reduce_scatter_.values.push_back(parameter->Gradient());
+      all_gather_.input_names.push_back(name);
+      all_gather_.values.push_back(parameter->Data());
+    }
+
+    if (plan.padding_sizes[r] > 0) {
+      const std::string padding_name = "optimizer_sharding_padding_" + std::to_string(r);
+      padding_indices.push_back(shapes.size());
+      shapes.push_back(TensorShape({plan.padding_sizes[r]}));
+      reduce_scatter_.input_names.push_back(padding_name);
+      reduce_scatter_.values.emplace_back();
+      all_gather_.input_names.push_back(padding_name);
+      all_gather_.values.emplace_back();
+    }
+  }
+
+  const auto create_session = [&](Collective& collective, const std::string& op_type) {
+    for (const auto& name : collective.input_names) {
+      collective.output_names.push_back(name + "_" + op_type);
+    }
+
+    std::string model_bytes;
+    ORT_THROW_IF_ERROR(CreateCollectiveModel(op_type, first_parameter.GetElementType(), collective.input_names,
+                                             shapes, collective.output_names, model_bytes));
+
+    collective.session = std::make_unique<InferenceSession>(session_options, env);
+    for (const auto& execution_provider : providers) {
+      ORT_THROW_IF_ERROR(collective.session->RegisterExecutionProvider(execution_provider));
+    }
+    ORT_THROW_IF_ERROR(collective.session->Load(model_bytes.data(), static_cast<int>(model_bytes.size())));
+    ORT_THROW_IF_ERROR(collective.session->Initialize());
+  };
+  create_session(reduce_scatter_, "NcclReduceScatter");
+  create_session(all_gather_, "NcclAllGather");
+
+  // The padding tensors are allocated on the device of the parameters, and shared by both
+  // collectives as their contents do not matter.
+  AllocatorPtr allocator =
+      reduce_scatter_.session->GetSessionState().GetAllocator(first_parameter.Location().device);
+  ORT_ENFORCE(allocator != nullptr, "No allocator found for the device of the trainable parameters.");
+  for (size_t index : padding_indices) {
+    OrtValue padding;
+    Tensor::InitOrtValue(first_parameter.DataType(), shapes[index], allocator, padding);
+    reduce_scatter_.values[index] = padding;
+    all_gather_.values[index] = padding;
+  }
+#else
+  ORT_UNUSED_PARAMETER(plan);
+  ORT_UNUSED_PARAMETER(module_checkpoint_state);
+  ORT_UNUSED_PARAMETER(session_options);
+  ORT_UNUSED_PARAMETER(env);
+  ORT_UNUSED_PARAMETER(providers);
+  ORT_THROW("Sharding the optimizer states requires a full training build with NCCL.");
+#endif
+}
+
+Status OptimizerShardingCollectives::ReduceScatterGradients() {
+  return Run(reduce_scatter_);
+}
+
+Status OptimizerShardingCollectives::AllGatherParameters() {
+  return Run(all_gather_);
+}
+
+Status OptimizerShardingCollectives::Run(Collective& collective) {
+  // The outputs are written in place of the inputs.
+  std::vector<OrtValue> outputs(collective.values.begin(), collective.values.end());
+  return collective.session->Run(RunOptions(), collective.input_names, collective.values, collective.output_names,
+                                 &outputs);
+}
+
+}  // namespace api
+}  // namespace training
+}  // namespace onnxruntime
@@ -0,0 +1,96 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/session/inference_session.h"
+#include "core/session/environment.h"
+
+#include "orttraining/training_api/module.h"
+
+namespace onnxruntime {
+namespace training {
+namespace api {
+
+/**
+ * @brief Assignment of the trainable parameters to the data parallel ranks that update them.
+ *
+ * Every rank keeps the optimizer states of the parameters it owns only. A parameter is never split
+ * between ranks: the parameters sorted by name are assigned to the ranks in contiguous runs of about
+ * the same number of elements.
+ *
+ * The gradients are reduce-scattered and the updated parameters are all-gathered with the NcclReduceScatter
+ * and NcclAllGather kernels. These treat the list of their inputs as one buffer cut into equal partitions
+ * of a multiple of 32 elements per rank, so the parameters of each rank are followed by a padding tensor
+ * that fills its partition.
+ */
+struct OptimizerShardingPlan {
+  int32_t rank{0};
+  int32_t world_size{1};
+
+  // Trainable parameter names in the order of the collective inputs and the ranks owning them.
+  InlinedVector<std::string> parameter_names;
+  InlinedVector<int32_t> owners;
+
+  // Number of elements in the partition of every rank and the size of the padding tensor after
+  // the parameters of each rank. A padding size of zero means no padding tensor.
+  int64_t partition_size{0};
+  InlinedVector<int64_t> padding_sizes;
+
+  bool IsSharded() const noexcept { return world_size > 1; }
+
+  // Returns whether the optimizer of this rank updates the named parameter.
+  bool Owns(const std::string& parameter_name) const;
+};
+
+/**
+ * @brief Creates the sharding plan of the trainable parameters.
+ *
+ * All the trainable parameters must have the same element type, as the collectives move them in one buffer.
+ */
+Status CreateOptimizerShardingPlan(const ModuleCheckpointState& module_checkpoint_state,
+                                   int32_t rank, int32_t world_size,
+                                   OptimizerShardingPlan& plan);
+
+/**
+ * @brief Gets the rank and size of the data parallel group the optimizer states are sharded across.
+ */
+Status GetOptimizerShardingGroup(int32_t& rank, int32_t& world_size);
+
+/**
+ * @brief Runs the collectives of a sharded optimizer step.
+ *
+ * Before the update, the gradients are reduce-scattered so that the owner of every parameter holds its
+ * gradient summed over the ranks. After the update, the parameters are all-gathered from their owners.
+ * The collectives run in sessions of their own, with the gradient and parameter buffers of the module
+ * as inputs and outputs.
+ */
+class OptimizerShardingCollectives {
+ public:
+  OptimizerShardingCollectives(const OptimizerShardingPlan& plan,
+                               ModuleCheckpointState& module_checkpoint_state,
+                               const onnxruntime::SessionOptions& session_options,
+                               const Environment& env,
+                               const std::vector<std::shared_ptr<IExecutionProvider>>& providers);
+
+  Status ReduceScatterGradients();
+
+  Status AllGatherParameters();
+
+ private:
+  struct Collective {
+    std::unique_ptr<onnxruntime::InferenceSession> session;
+    std::vector<std::string> input_names;
+    std::vector<std::string> output_names;
+    std::vector<OrtValue> values;
+  };
+
+  Status Run(Collective& collective);
+
+  Collective reduce_scatter_;
+  Collective all_gather_;
+};
+
+}  // namespace api
+}  // namespace training
+}  // namespace onnxruntime
@@ -0,0 +1,266 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "orttraining/training_ops/cpu/loss/matmul_softmax_cross_entropy_loss.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "core/common/gsl.h"
+#include "core/common/safeint.h"
+#include "core/platform/threadpool.h"
+#include "core/util/math.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+#define REGISTER_KERNEL_TYPED(OpName, ClassName, T1, T2)                                              \
+  ONNX_OPERATOR_TWO_TYPED_KERNEL_EX(OpName, kMSDomain, 1, T1, T2, kCpuExecutionProvider,              \
+                                    KernelDefBuilder()                                                \
+                                        .TypeConstraint("T", DataTypeImpl::GetTensorType<T1>())       \
+                                        .TypeConstraint("Tind", DataTypeImpl::GetTensorType<T2>())    \
+                                        .TypeConstraint("I", DataTypeImpl::GetTensorType<int64_t>()), \
+                                    ClassName<T1, T2>);
+
+REGISTER_KERNEL_TYPED(MatMulSoftmaxCrossEntropyLossInternal, MatMulSoftmaxCrossEntropyLoss, float, int32_t)
+REGISTER_KERNEL_TYPED(MatMulSoftmaxCrossEntropyLossInternal, MatMulSoftmaxCrossEntropyLoss, float, int64_t)
+REGISTER_KERNEL_TYPED(MatMulSoftmaxCrossEntropyLossInternalGrad, MatMulSoftmaxCrossEntropyLossGrad, float, int32_t)
+REGISTER_KERNEL_TYPED(MatMulSoftmaxCrossEntropyLossInternalGrad, MatMulSoftmaxCrossEntropyLossGrad, float, int64_t)
+
+namespace {
+
+// Verifies X is [N, K], W is [K, C] and label is [N], returning N, K and C.
+Status GetNKC(const TensorShape& x_shape, const TensorShape& w_shape, const TensorShape& label_shape,
+              const Tensor* p_weight, int64_t& N, int64_t& K, int64_t& C) {
+  ORT_RETURN_IF_NOT(x_shape.NumDimensions() == 2 && w_shape.NumDimensions() == 2 && x_shape[1] == w_shape[0],
+                    "X and W must be 2-D matrices that can be multiplied, got ", x_shape, " and ", w_shape);
+  ORT_RETURN_IF_NOT(label_shape.NumDimensions() == 1 && label_shape[0] == x_shape[0],
+                    "The shape of X and label does not match.");
+  ORT_RETURN_IF_NOT(p_weight == nullptr || p_weight->Shape() == TensorShape({w_shape[1]}),
+                    "Weights tensor must be 1-D with one weight per class.");
+
+  N = x_shape[0];
+  K = x_shape[1];
+  C = w_shape[1];
+  ORT_RETURN_IF_NOT(C > 0, "There must be at least one class.");
+  ORT_RETURN_IF_NOT(K <= std::numeric_limits<int>::max() && C <= std::numeric_limits<int>::max(),
+                    "The matrices are too large.");
+  return Status::OK();
+}
+
+// Computes the weight of each sample, 0 for the ignored ones, and the sum of the weights.
+template <typename T1, typename T2>
+Status GetSampleWeights(int64_t N, int64_t C, const T2* label_data, const Tensor* p_weight, int64_t ignore_index,
+                        std::vector<T1>& sample_weights, double& sum_weight) {
+  const T1* weight_data = p_weight ? p_weight->Data<T1>() : nullptr;
+  sample_weights.resize(N);
+  sum_weight = 0.0;
+  for (int64_t i = 0; i < N; i++) {
+    const int64_t label = static_cast<int64_t>(label_data[i]);
+    if (label == ignore_index) {
+      sample_weights[i] = 0;
+      continue;
+    }
+
+    ORT_RETURN_IF_NOT(label >= 0 && label < C, "Label ", label, " is out of range [0, ", C, ").");
+    sample_weights[i] = weight_data ? weight_data[label] : static_cast<T1>(1);
+    sum_weight += sample_weights[i];
+  }
+
+  return Status::OK();
+}
+
+int64_t GetIgnoreIndex(const Tensor* p_ignore_index) {
+  if (p_ignore_index == nullptr) {
+    return -1;
+  }
+
+  ORT_ENFORCE(p_ignore_index->Shape().IsScalar(), "ignore_index should be a scalar.");
+  return *(p_ignore_index->Data<int64_t>());
+}
+
+}  // namespace
+
+template <typename T1, typename T2>
+Status MatMulSoftmaxCrossEntropyLoss<T1, T2>::Compute(OpKernelContext* context) const {
+  const Tensor& X = *context->Input<Tensor>(0);
+  const Tensor& W = *context->Input<Tensor>(1);
+  const Tensor& label = *context->Input<Tensor>(2);
+  const Tensor* p_weight = context->Input<Tensor>(3);
+  const int64_t ignore_index = GetIgnoreIndex(context->Input<Tensor>(4));
+
+  int64_t N = 0;
+  int64_t K = 0;
+  int64_t C = 0;
+  ORT_RETURN_IF_ERROR(GetNKC(X.Shape(), W.Shape(), label.Shape(), p_weight, N, K, C));
+
+  Tensor* loss = context->Output(0, reduction_ == ReductionType::NONE ? TensorShape({N}) : TensorShape({}));
+  Tensor* log_sum_exp = context->Output(1, TensorShape({N}));
+
+  const T1* x_data = X.Data<T1>();
+  const T1* w_data = W.Data<T1>();
+  const T2* label_data = label.Data<T2>();
+  T1* loss_data = loss->MutableData<T1>();
+  T1* log_sum_exp_data = log_sum_exp->MutableData<T1>();
+
+  std::vector<T1> sample_weights;
+  double sum_weight = 0.0;
+  ORT_RETURN_IF_ERROR(GetSampleWeights<T1, T2>(N, C, label_data, p_weight, ignore_index, sample_weights, sum_weight));
+
+  // Running max and sum of the exponents of each row, as in an online softmax, and the logit of the label.
+  std::vector<T1> row_max(N, -std::numeric_limits<T1>::infinity());
+  std::vector<T1> row_sum(N, static_cast<T1>(0));
+  std::vector<T1> label_logit(N, static_cast<T1>(0));
+
+  const int64_t chunk_size = std::min(chunk_size_, C);
+  std::vector<T1> logits(SafeInt<size_t>(N) * chunk_size);
+  auto* tp = context->GetOperatorThreadPool();
+  for (int64_t chunk_begin = 0; chunk_begin < C; chunk_begin += chunk_size) {
+    const int64_t chunk = std::min(chunk_size, C - chunk_begin);
+    math::GemmEx<T1, concurrency::ThreadPool>(CblasNoTrans, CblasNoTrans, N, chunk, K, static_cast<T1>(1),
+                                              x_data, gsl::narrow<int>(K), w_data + chunk_begin, gsl::narrow<int>(C),
+                                              static_cast<T1>(0), logits.data(), gsl::narrow<int>(chunk), tp);
+
+    concurrency::ThreadPool::TryParallelFor(
+        tp, N, static_cast<double>(chunk) * 4,
+        [&, chunk_begin, chunk](std::ptrdiff_t begin, std::ptrdiff_t end) {
+          for (std::ptrdiff_t i = begin; i != end; ++i) {
+            const T1* row = logits.data() + i * chunk;
+            const T1 new_max = std::max(row_max[i], *std::max_element(row, row + chunk));
+            T1 sum = row_sum[i] * std::exp(row_max[i] - new_max);
+            for (int64_t j = 0; j < chunk; ++j) {
+              sum += std::exp(row[j] - new_max);
+            }
+            row_max[i] = new_max;
+            row_sum[i] = sum;
+
+            const int64_t label_index = static_cast<int64_t>(label_data[i]) - chunk_begin;
+            if (label_index >= 0 && label_index < chunk) {
+              label_logit[i] = row[label_index];
+            }
+          }
+        });
+  }
+
+  double total_loss = 0.0;
+  for (int64_t i = 0; i < N; i++) {
+    log_sum_exp_data[i] = row_max[i] + std::log(row_sum[i]);
+    const T1 sample_loss = sample_weights[i] == 0 ? static_cast<T1>(0)
+                                                  : (log_sum_exp_data[i] - label_logit[i]) * sample_weights[i];
+    if (reduction_ == ReductionType::NONE) {
+      loss_data[i] = sample_loss;
+    } else {
+      total_loss += sample_loss;
+    }
+  }
+
+  if (reduction_ != ReductionType::NONE) {
+    if (reduction_ == ReductionType::MEAN && sum_weight != 0) {
+      total_loss /= sum_weight;
+    }
+    *loss_data = static_cast<T1>(total_loss);
+  }
+
+  return Status::OK();
+}
+
+template <typename T1, typename T2>
+Status MatMulSoftmaxCrossEntropyLossGrad<T1, T2>::Compute(OpKernelContext* context) const {
+  const Tensor& dY = *context->Input<Tensor>(0);
+  const Tensor& X = *context->Input<Tensor>(1);
+  const Tensor& W = *context->Input<Tensor>(2);
+  const Tensor& log_sum_exp = *context->Input<Tensor>(3);
+  const Tensor& label = *context->Input<Tensor>(4);
+  const Tensor* p_weight = context->Input<Tensor>(5);
+  const int64_t ignore_index = GetIgnoreIndex(context->Input<Tensor>(6));
+
+  int64_t N = 0;
+  int64_t K = 0;
+  int64_t C = 0;
+  ORT_RETURN_IF_ERROR(GetNKC(X.Shape(), W.Shape(), label.Shape(), p_weight, N, K, C));
+  ORT_RETURN_IF_NOT(log_sum_exp.Shape() == TensorShape({N}), "The shape of log_sum_exp does not match.");
+
+  Tensor* dX = context->Output(0, X.Shape());
+  Tensor* dW = context->Output(1, W.Shape());
+  if (dX == nullptr && dW == nullptr) {
+    return Status::OK();
+  }
+
+  const T1* dY_data = dY.Data<T1>();
+  const T1* x_data = X.Data<T1>();
+  const T1* w_data = W.Data<T1>();
+  const T1* log_sum_exp_data = log_sum_exp.Data<T1>();
+  const T2* label_data = label.Data<T2>();
+
+  // Fold the incoming gradient and the reduction into the weight of each sample.
+  std::vector<T1> sample_scales;
+  double sum_weight = 0.0;
+  ORT_RETURN_IF_ERROR(GetSampleWeights<T1, T2>(N, C, label_data, p_weight, ignore_index, sample_scales, sum_weight));
+  if (reduction_ == ReductionType::NONE) {
+    ORT_RETURN_IF_NOT(dY.Shape().Size() == N, "The shape of dY does not match.");
+    for (int64_t i = 0; i < N; i++) {
+      sample_scales[i] *= dY_data[i];
+    }
+  } else {
+    T1 dY_scaled = *dY_data;
+    if (reduction_ == ReductionType::MEAN && sum_weight != 0) {
+      dY_scaled = static_cast<T1>(*dY_data / sum_weight);
+    }
+    for (int64_t i = 0; i < N; i++) {
+      sample_scales[i] *= dY_scaled;
+    }
+  }
+
+  const int64_t chunk_size = std::min(chunk_size_, C);
+  std::vector<T1> d_logits(SafeInt<size_t>(N) * chunk_size);
+  auto* tp = context->GetOperatorThreadPool();
+  for (int64_t chunk_begin = 0; chunk_begin < C; chunk_begin += chunk_size) {
+    const int64_t chunk = std::min(chunk_size, C - chunk_begin);
+    math::GemmEx<T1, concurrency::ThreadPool>(CblasNoTrans, CblasNoTrans, N, chunk, K, static_cast<T1>(1),
+                                              x_data, gsl::narrow<int>(K), w_data + chunk_begin, gsl::narrow<int>(C),
+                                              static_cast<T1>(0), d_logits.data(), gsl::narrow<int>(chunk), tp);
+
+    // d_logits = (softmax(logits) - one_hot(label)) * scale, in place of the logits.
+    concurrency::ThreadPool::TryParallelFor(
+        tp, N, static_cast<double>(chunk) * 4,
+        [&, chunk_begin, chunk](std::ptrdiff_t begin, std::ptrdiff_t end) {
+          for (std::ptrdiff_t i = begin; i != end; ++i) {
+            T1* row = d_logits.data() + i * chunk;
+            const T1 scale = sample_scales[i];
+            if (scale == 0) {
+              std::fill_n(row, chunk, static_cast<T1>(0));
+              continue;
+            }
+
+            for (int64_t j = 0; j < chunk; ++j) {
+              row[j] = std::exp(row[j] - log_sum_exp_data[i]) * scale;
+            }
+            const int64_t label_index = static_cast<int64_t>(label_data[i]) - chunk_begin;
+            if (label_index >= 0 && label_index < chunk) {
+              row[label_index] -= scale;
+            }
+          }
+        });
+
+    if (dX != nullptr) {
+      // dX += d_logits * W[:, chunk]^T
+      math::GemmEx<T1, concurrency::ThreadPool>(CblasNoTrans, CblasTrans, N, K, chunk, static_cast<T1>(1),
+                                                d_logits.data(), gsl::narrow<int>(chunk), w_data + chunk_begin,
+                                                gsl::narrow<int>(C), static_cast<T1>(chunk_begin == 0 ? 0 : 1),
+                                                dX->MutableData<T1>(), gsl::narrow<int>(K), tp);
+    }
+    if (dW != nullptr) {
+      // dW[:, chunk] = X^T * d_logits
+      math::GemmEx<T1, concurrency::ThreadPool>(CblasTrans, CblasNoTrans, K, chunk, N, static_cast<T1>(1),
+                                                x_data, gsl::narrow<int>(K), d_logits.data(), gsl::narrow<int>(chunk),
+                                                static_cast<T1>(0), dW->MutableData<T1>() + chunk_begin,
+                                                gsl::narrow<int>(C), tp);
+    }
+  }
+
+  return Status::OK();
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,50 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/framework/op_kernel.h"
+#include "orttraining/training_ops/cpu/loss/cross_entropy.h"
+#include "orttraining/training_ops/cpu/loss/reduction_type.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+// Number of classes whose logits are computed at a time, if the node does not specify it.
+constexpr int64_t kDefaultSceLossChunkSize = 2048;
+
+// Computes SoftmaxCrossEntropyLoss(MatMul(X, W), label) one chunk of classes at a time, keeping the
+// log-sum-exp of each sample instead of the [N, C] log probabilities.
+template <typename T1, typename T2>
+class MatMulSoftmaxCrossEntropyLoss final : public LossBase {
+ public:
+  explicit MatMulSoftmaxCrossEntropyLoss(const OpKernelInfo& info) : LossBase(info) {
+    chunk_size_ = info.GetAttrOrDefault<int64_t>("chunk_size", kDefaultSceLossChunkSize);
+    ORT_ENFORCE(chunk_size_ > 0, "chunk_size must be positive.");
+  }
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  int64_t chunk_size_;
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(MatMulSoftmaxCrossEntropyLoss);
+};
+
+// Computes the gradients of X and W, recomputing the logits one chunk of classes at a time.
+template <typename T1, typename T2>
+class MatMulSoftmaxCrossEntropyLossGrad final : public LossBase {
+ public:
+  explicit MatMulSoftmaxCrossEntropyLossGrad(const OpKernelInfo& info) : LossBase(info) {
+    chunk_size_ = info.GetAttrOrDefault<int64_t>("chunk_size", kDefaultSceLossChunkSize);
+    ORT_ENFORCE(chunk_size_ > 0, "chunk_size must be positive.");
+  }
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  int64_t chunk_size_;
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(MatMulSoftmaxCrossEntropyLossGrad);
+};
+
+}  // namespace contrib
+}  // namespace onnxruntime
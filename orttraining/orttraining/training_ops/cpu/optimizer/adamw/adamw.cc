@@ -89,49 +89,6 @@ ONNX_OPERATOR_KERNEL_EX(
         .TypeConstraint("S_MOMENT", DataTypeImpl::AllFixedSizeSequenceTensorTypes()),
     AdamWOptimizer<float>);
 
-template <typename T>
-Status AdamWOptimizer<T>::AdamWComputeMode0(Tensor& weight, Tensor& gradient, Tensor& momentums_1, Tensor& momentums_2,
-                                            float lr, float alpha_correction, float beta_correction) const {
-  // Perform weight decay.
-  MakeEigenArrayMap<T>(weight) = MakeEigenArrayMap<T>(weight) - (MakeEigenArrayMap<T>(weight) * lr * weight_decay_);
-
-  // Compute exponentially-averaged historical gradient.
-  MakeEigenArrayMap<T>(momentums_1) = alpha_ * MakeEigenArrayMap<T>(momentums_1) +
-                                      (1.f - alpha_) * MakeEigenArrayMap<T>(gradient);
-
-  // Compute exponentially-averaged historical squared gradient.
-  MakeEigenArrayMap<T>(momentums_2) = beta_ * MakeEigenArrayMap<T>(momentums_2) +
-                                      (1.f - beta_) * MakeEigenArrayMap<T>(gradient) * MakeEigenArrayMap<T>(gradient);
-
-  // Compute the new weight.
-  auto denom = (MakeEigenArrayMap<T>(momentums_2) / beta_correction).sqrt() + epsilon_;
-  MakeEigenArrayMap<T>(weight) = MakeEigenArrayMap<T>(weight) -
-                                 (lr * MakeEigenArrayMap<T>(momentums_1)) / (alpha_correction * denom);
-
-  return Status::OK();
-}
-
-template <typename T>
-Status AdamWOptimizer<T>::AdamWComputeMode1(Tensor& weight, Tensor& gradient, Tensor& momentums_1, Tensor& momentums_2,
-                                            float lr, float lr_corrected) const {
-  // Compute exponentially-averaged historical gradient.
-  MakeEigenArrayMap<T>(momentums_1) = alpha_ * MakeEigenArrayMap<T>(momentums_1) +
-                                      (1.f - alpha_) * MakeEigenArrayMap<T>(gradient);
-
-  // Compute exponentially-averaged historical squared gradient.
-  MakeEigenArrayMap<T>(momentums_2) = beta_ * MakeEigenArrayMap<T>(momentums_2) +
-                                      (1.f - beta_) * MakeEigenArrayMap<T>(gradient) * MakeEigenArrayMap<T>(gradient);
-
-  auto denom = MakeEigenArrayMap<T>(momentums_2).sqrt() + epsilon_;
-  MakeEigenArrayMap<T>(weight) = MakeEigenArrayMap<T>(weight) -
-                                 (lr_corrected * MakeEigenArrayMap<T>(momentums_1) / denom);
-
-  // Perform weight decay.
-  MakeEigenArrayMap<T>(weight) = MakeEigenArrayMap<T>(weight) - (lr * weight_decay_ * MakeEigenArrayMap<T>(weight));
-
-  return Status::OK();
-}
-
 template <typename T>
 Status AdamWOptimizer<T>::Compute(OpKernelContext* ctx) const {
   AdamWOptimizerBase::Prepare p;
@@ -144,17 +101,8 @@ Status AdamWOptimizer<T>::Compute(OpKernelContext* ctx) const {
     const float lr = *p.learning_rate->template Data<float>();
     const int64_t step = *p.step->template Data<int64_t>();
 
-    float alpha_correction = 1.f, beta_correction = 1.f;
-    float lr_corrected = lr;
-    if (correct_bias_ == 1) {
-      // Notes:
-      // > there is a minor difference compared with Apex's implementation,
-      //   which uses double storing corrections before casting to float passing to kernels.
-      // > std::pow(float, int) return double since C++11, so we cast back to float.
-      alpha_correction = 1.f - static_cast<float>(std::pow(alpha_, step));
-      beta_correction = 1.f - static_cast<float>(std::pow(beta_, step));
-      lr_corrected *= std::sqrt(beta_correction) / alpha_correction;
-    }
+    float alpha_correction, beta_correction, lr_corrected;
+    ComputeCorrections(lr, step, alpha_correction, beta_correction, lr_corrected);
 
     // Currently two kinds of AdamW supported:
     // Mode 0: Pytorch https://pytorch.org/docs/stable/_modules/torch/optim/adamw.html#AdamW,
@@ -164,23 +112,25 @@ Status AdamWOptimizer<T>::Compute(OpKernelContext* ctx) const {
     //         src/transformers/optimization.py,
     //         bias correction is applied on learning rate, then use lr_corrected for subsequent computations.
     //         weight decay is applied after weight is updated.
-
-    for (size_t weight_index = 0; weight_index < p.num_of_weights; ++weight_index) {
-      Tensor& weight = const_cast<Tensor&>(p.weights->Get(weight_index));
-      Tensor& gradient = const_cast<Tensor&>(p.gradients->Get(weight_index));
-      Tensor& momentums_1 = const_cast<Tensor&>(p.momentums_1->Get(weight_index));
-      Tensor& momentums_2 = const_cast<Tensor&>(p.momentums_2->Get(weight_index));
-
-      if (adam_mode_ == 0) {
-        ORT_RETURN_IF_ERROR(
-            AdamWComputeMode0(weight, gradient, momentums_1, momentums_2, lr, alpha_correction, beta_correction));
-      } else if (adam_mode_ == 1) {
-        ORT_RETURN_IF_ERROR(
-            AdamWComputeMode1(weight, gradient, momentums_1, momentums_2, lr, lr_corrected));
-      } else {
-        ORT_THROW("Unsupported Adamw optimizer mode.");
-      }
-    }
+    //
+    // The weights are updated in one multi-tensor apply, over chunks that stay in cache between
+    // the passes of the update. The constructor checks adam_mode_ is one of the two modes.
+    static constexpr double cost_per_element = 20.0;
+    MultiTensorApply(
+        ctx->GetOperatorThreadPool(), p.grouped_tensor_sizes, cost_per_element,
+        [&](size_t weight_index, std::ptrdiff_t offset, std::ptrdiff_t count) {
+          const auto& pointers = p.grouped_tensor_pointers[weight_index];
+          EigenVectorArrayMap<T> weight(static_cast<T*>(pointers[0]) + offset, count);
+          ConstEigenVectorArrayMap<T> gradient(static_cast<const T*>(pointers[1]) + offset, count);
+          EigenVectorArrayMap<T> momentums_1(static_cast<T*>(pointers[2]) + offset, count);
+          EigenVectorArrayMap<T> momentums_2(static_cast<T*>(pointers[3]) + offset, count);
+
+          if (adam_mode_ == 0) {
+            AdamWComputeMode0<T>(weight, gradient, momentums_1, momentums_2, lr, alpha_correction, beta_correction);
+          } else {
+            AdamWComputeMode1<T>(weight, gradient, momentums_1, momentums_2, lr, lr_corrected);
+          }
+        });
 
     *updated_flag_ptr = 1;
   } else {
@@ -200,5 +150,84 @@ Status AdamWOptimizer<T>::Compute(OpKernelContext* ctx) const {
   return Status::OK();
 }
 
+ONNX_OPERATOR_KERNEL_EX(
+    SparseAdamWOptimizer,
+    kMSDomain,
+    1,
+    kCpuExecutionProvider,
+    (*KernelDefBuilder::Create())
+        .Alias(2, 1) /* Return updated weight in-place */
+        .Alias(5, 2) /* Return updated moment-1 in-place */
+        .Alias(6, 3) /* Return updated moment-2 in-place */
+        .TypeConstraint("T1", DataTypeImpl::GetTensorType<float>())
+        .TypeConstraint("T2", DataTypeImpl::GetTensorType<int64_t>())
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>())
+        .TypeConstraint("T_BOOL", DataTypeImpl::GetTensorType<bool>()),
+    SparseAdamWOptimizer<float>);
+
+template <typename T>
+Status SparseAdamWOptimizer<T>::Compute(OpKernelContext* ctx) const {
+  const Tensor& learning_rate = *ctx->Input<Tensor>(0);
+  const Tensor& step_tensor = *ctx->Input<Tensor>(1);
+  const Tensor& weight = *ctx->Input<Tensor>(2);
+  const Tensor& grad_indices = *ctx->Input<Tensor>(3);
+  const Tensor& grad_values = *ctx->Input<Tensor>(4);
+  const Tensor& momentum_1 = *ctx->Input<Tensor>(5);
+  const Tensor& momentum_2 = *ctx->Input<Tensor>(6);
+
+  int64_t row_size = 0;
+  ORT_RETURN_IF_ERROR(CheckRowGradient(weight, grad_indices, grad_values, row_size));
+  ORT_RETURN_IF_NOT(weight.Shape() == momentum_1.Shape(), "Shape of weight and momentum_1 mismatch.");
+  ORT_RETURN_IF_NOT(weight.Shape() == momentum_2.Shape(), "Shape of weight and momentum_2 mismatch.");
+
+  int64_t* updated_flag_ptr = ctx->Output(0, step_tensor.Shape())->template MutableData<int64_t>();
+
+  const Tensor* update_signal = ctx->Input<Tensor>(7);
+  if (update_signal == nullptr || *update_signal->template Data<bool>()) {
+    const float lr = *learning_rate.template Data<float>();
+    const int64_t step = *step_tensor.template Data<int64_t>();
+
+    float alpha_correction, beta_correction, lr_corrected;
+    ComputeCorrections(lr, step, alpha_correction, beta_correction, lr_corrected);
+
+    // The weight and moments are updated in place, one row of the gradient at a time; the rows are distinct.
+    T* weight_data = const_cast<T*>(weight.template Data<T>());
+    T* momentum_1_data = const_cast<T*>(momentum_1.template Data<T>());
+    T* momentum_2_data = const_cast<T*>(momentum_2.template Data<T>());
+    const int64_t* indices = grad_indices.template Data<int64_t>();
+    const T* values = grad_values.template Data<T>();
+
+    const double cost_per_row = 20.0 * static_cast<double>(row_size);
+    concurrency::ThreadPool::TryParallelFor(
+        ctx->GetOperatorThreadPool(), grad_indices.Shape()[0], cost_per_row,
+        [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+          for (std::ptrdiff_t r = begin; r != end; ++r) {
+            const int64_t offset = indices[r] * row_size;
+            EigenVectorArrayMap<T> weight_row(weight_data + offset, row_size);
+            ConstEigenVectorArrayMap<T> gradient_row(values + r * row_size, row_size);
+            EigenVectorArrayMap<T> momentum_1_row(momentum_1_data + offset, row_size);
+            EigenVectorArrayMap<T> momentum_2_row(momentum_2_data + offset, row_size);
+
+            if (adam_mode_ == 0) {
+              AdamWComputeMode0<T>(weight_row, gradient_row, momentum_1_row, momentum_2_row, lr, alpha_correction,
+                                   beta_correction);
+            } else {
+              AdamWComputeMode1<T>(weight_row, gradient_row, momentum_1_row, momentum_2_row, lr, lr_corrected);
+            }
+          }
+        });
+
+    *updated_flag_ptr = 1;
+  } else {
+    *updated_flag_ptr = 0;
+  }
+
+  CopyIfNotSameCPUBuffer(weight, ctx->Output(1, weight.Shape()));
+  CopyIfNotSameCPUBuffer(momentum_1, ctx->Output(2, momentum_1.Shape()));
+  CopyIfNotSameCPUBuffer(momentum_2, ctx->Output(3, momentum_2.Shape()));
+
+  return Status::OK();
+}
+
 }  // namespace contrib
 }  // namespace onnxruntime
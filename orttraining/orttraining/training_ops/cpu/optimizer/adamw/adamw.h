@@ -3,29 +3,96 @@
 
 #pragma once
 
+#include <cmath>
+
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
 #include "core/providers/cpu/tensor/utils.h"
+#include "core/util/math_cpuonly.h"
 #include "orttraining/training_ops/cpu/optimizer/adamw/adamwbase.h"
 
 namespace onnxruntime {
 namespace contrib {
 
+// The AdamW update of a span of a weight, shared by the CPU kernels.
+class AdamWCPUOptimizerBase : public AdamWOptimizerBase {
+ public:
+  AdamWCPUOptimizerBase(const OpKernelInfo& info) : AdamWOptimizerBase(info) {}
+
+ protected:
+  // Computes the bias corrections of the moments, and the learning rate corrected by them, at the given step.
+  void ComputeCorrections(float lr, int64_t step, float& alpha_correction, float& beta_correction,
+                          float& lr_corrected) const {
+    alpha_correction = 1.f;
+    beta_correction = 1.f;
+    lr_corrected = lr;
+    if (correct_bias_ == 1) {
+      // Notes:
+      // > there is a minor difference compared with Apex's implementation,
+      //   which uses double storing corrections before casting to float passing to kernels.
+      // > std::pow(float, int) return double since C++11, so we cast back to float.
+      alpha_correction = 1.f - static_cast<float>(std::pow(alpha_, step));
+      beta_correction = 1.f - static_cast<float>(std::pow(beta_, step));
+      lr_corrected *= std::sqrt(beta_correction) / alpha_correction;
+    }
+  }
+
+  template <typename T>
+  void AdamWComputeMode0(EigenVectorArrayMap<T> weight, ConstEigenVectorArrayMap<T> gradient,
+                         EigenVectorArrayMap<T> momentums_1, EigenVectorArrayMap<T> momentums_2, float lr,
+                         float alpha_correction, float beta_correction) const {
+    // Perform weight decay.
+    weight = weight - (weight * lr * weight_decay_);
+
+    // Compute exponentially-averaged historical gradient.
+    momentums_1 = alpha_ * momentums_1 + (1.f - alpha_) * gradient;
+
+    // Compute exponentially-averaged historical squared gradient.
+    momentums_2 = beta_ * momentums_2 + (1.f - beta_) * gradient * gradient;
+
+    // Compute the new weight.
+    auto denom = (momentums_2 / beta_correction).sqrt() + epsilon_;
+    weight = weight - (lr * momentums_1) / (alpha_correction * denom);
+  }
+
+  template <typename T>
+  void AdamWComputeMode1(EigenVectorArrayMap<T> weight, ConstEigenVectorArrayMap<T> gradient,
+                         EigenVectorArrayMap<T> momentums_1, EigenVectorArrayMap<T> momentums_2, float lr,
+                         float lr_corrected) const {
+    // Compute exponentially-averaged historical gradient.
+    momentums_1 = alpha_ * momentums_1 + (1.f - alpha_) * gradient;
+
+    // Compute exponentially-averaged historical squared gradient.
+    momentums_2 = beta_ * momentums_2 + (1.f - beta_) * gradient * gradient;
+
+    auto denom = momentums_2.sqrt() + epsilon_;
+    weight = weight - (lr_corrected * momentums_1 / denom);
+
+    // Perform weight decay.
+    weight = weight - (lr * weight_decay_ * weight);
+  }
+};
+
 template <typename T>
-class AdamWOptimizer final : public OpKernel, public AdamWOptimizerBase {
+class AdamWOptimizer final : public OpKernel, public AdamWCPUOptimizerBase {
  public:
   AdamWOptimizer(const OpKernelInfo& info)
-      : OpKernel(info), AdamWOptimizerBase(info) {
+      : OpKernel(info), AdamWCPUOptimizerBase(info) {
   }
 
   Status Compute(OpKernelContext* context) const override;
+};
 
- private:
-  Status AdamWComputeMode0(Tensor& weight, Tensor& gradient, Tensor& momentums_1, Tensor& momentums_2, float lr,
-                           float alpha_correction,
-                           float beta_correction) const;
-  Status AdamWComputeMode1(Tensor& weight, Tensor& gradient, Tensor& momentums_1, Tensor& momentums_2, float lr,
-                           float lr_corrected) const;
+// Lazy AdamW of a single weight whose gradient is given by rows (SparseAdamWOptimizer): only the rows in the
+// gradient have their weight and moments updated, the moments of the other rows are left as they are.
+template <typename T>
+class SparseAdamWOptimizer final : public OpKernel, public AdamWCPUOptimizerBase {
+ public:
+  SparseAdamWOptimizer(const OpKernelInfo& info)
+      : OpKernel(info), AdamWCPUOptimizerBase(info) {
+  }
+
+  Status Compute(OpKernelContext* context) const override;
 };
 
 }  // namespace contrib
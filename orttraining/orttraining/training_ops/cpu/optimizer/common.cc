@@ -1,7 +1,10 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
+
 #include "core/common/common.h"
+#include "core/common/inlined_containers.h"
 #include "core/framework/op_kernel.h"
 #include "core/framework/TensorSeq.h"
 #include "core/providers/cpu/tensor/utils.h"
@@ -29,5 +32,54 @@ Status CopyIfNotSameCPUBuffer(OpKernelContext* ctx, size_t number_of_values,
   return Status::OK();
 }
 
+void CopyIfNotSameCPUBuffer(const Tensor& src_value, Tensor* dest_value) {
+  if (dest_value != nullptr && dest_value->DataRaw() != src_value.DataRaw()) {
+    CopyCpuTensor(&src_value, dest_value);
+  }
+}
+
+Status CheckRowGradient(const Tensor& weight, const Tensor& grad_indices, const Tensor& grad_values,
+                        int64_t& row_size) {
+  const TensorShape& weight_shape = weight.Shape();
+  ORT_RETURN_IF_NOT(weight_shape.NumDimensions() >= 1, "A weight with row gradients must have rank 1 or more.");
+  ORT_RETURN_IF_NOT(grad_indices.Shape().NumDimensions() == 1, "The gradient indices must be 1-D.");
+
+  const int64_t num_rows = grad_indices.Shape()[0];
+  TensorShapeVector values_dims = weight_shape.AsShapeVector();
+  values_dims[0] = num_rows;
+  ORT_RETURN_IF_NOT(grad_values.Shape() == TensorShape(values_dims), "The shape of the gradient values ",
+                    grad_values.Shape(), " does not match the weight ", weight_shape, " and ", num_rows, " rows.");
+
+  // The rows are updated in parallel, so they must be distinct.
+  const int64_t* indices = grad_indices.Data<int64_t>();
+  for (int64_t r = 0; r < num_rows; ++r) {
+    ORT_RETURN_IF_NOT(indices[r] >= 0 && indices[r] < weight_shape[0] && (r == 0 || indices[r] > indices[r - 1]),
+                      "The gradient indices must be increasing rows of the weight, got ", indices[r], " at ", r);
+  }
+
+  row_size = weight_shape.SizeFromDimension(1);
+  return Status::OK();
+}
+
+void MultiTensorApply(concurrency::ThreadPool* tp, gsl::span<const int> tensor_sizes, double cost_per_element,
+                      const std::function<void(size_t, std::ptrdiff_t, std::ptrdiff_t)>& fn) {
+  // Tensor index and offset of every chunk.
+  InlinedVector<std::pair<size_t, std::ptrdiff_t>> chunks;
+  for (size_t tensor_index = 0; tensor_index < tensor_sizes.size(); ++tensor_index) {
+    for (std::ptrdiff_t offset = 0; offset < tensor_sizes[tensor_index]; offset += kMultiTensorChunkSize) {
+      chunks.emplace_back(tensor_index, offset);
+    }
+  }
+
+  concurrency::ThreadPool::TryParallelFor(
+      tp, static_cast<std::ptrdiff_t>(chunks.size()), cost_per_element * kMultiTensorChunkSize,
+      [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+        for (std::ptrdiff_t chunk = begin; chunk != end; ++chunk) {
+          const auto [tensor_index, offset] = chunks[chunk];
+          fn(tensor_index, offset, std::min<std::ptrdiff_t>(kMultiTensorChunkSize, tensor_sizes[tensor_index] - offset));
+        }
+      });
+}
+
 }  // namespace contrib
 }  // namespace onnxruntime
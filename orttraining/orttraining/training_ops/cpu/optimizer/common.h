@@ -5,7 +5,9 @@
 
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
+#include "core/platform/threadpool.h"
 #include <cmath>
+#include <functional>
 
 namespace onnxruntime {
 namespace contrib {
@@ -22,5 +24,34 @@ TC compute_bias_correction_coefficient(const TC momentum_update_coefficient, con
 Status CopyIfNotSameCPUBuffer(OpKernelContext* ctx, size_t number_of_values, const TensorSeq* src_values,
                               TensorSeq* dest_values);
 
+// Copies the updated tensor to its output, if the output is requested and not already the same buffer.
+void CopyIfNotSameCPUBuffer(const Tensor& src_value, Tensor* dest_value);
+
+/**
+ * Checks a gradient given by rows, as produced by GatherSparseGrad, against its weight: the indices must be
+ * increasing rows of the weight, and the values must hold one row of the weight per index.
+ *
+ * @param row_size Returns the number of elements of a row.
+ */
+Status CheckRowGradient(const Tensor& weight, const Tensor& grad_indices, const Tensor& grad_values,
+                        int64_t& row_size);
+
+// Number of elements the multi-tensor optimizers update at once. The chunks of the weights, gradients
+// and momentums stay in the L2 cache while the update makes its passes over them.
+constexpr std::ptrdiff_t kMultiTensorChunkSize = 4096;
+
+/**
+ * Applies fn to the elements of a group of tensors, as the CUDA multi-tensor-apply does: the tensors are
+ * viewed as one flattened buffer cut into chunks of at most kMultiTensorChunkSize elements, and the
+ * chunks are processed in parallel.
+ *
+ * @param tp The thread pool to run the chunks on.
+ * @param tensor_sizes The number of elements of the tensors.
+ * @param cost_per_element The cost of updating one element, in cycles.
+ * @param fn Called with the tensor index, the offset of the chunk in the tensor and the chunk size.
+ */
+void MultiTensorApply(concurrency::ThreadPool* tp, gsl::span<const int> tensor_sizes, double cost_per_element,
+                      const std::function<void(size_t, std::ptrdiff_t, std::ptrdiff_t)>& fn);
+
 }  // namespace contrib
 }  // namespace onnxruntime
@@ -5,6 +5,7 @@
 #include "orttraining/training_ops/cpu/optimizer/common.h"
 #include "core/framework/op_kernel.h"
 #include "core/framework/TensorSeq.h"
+#include "core/platform/threadpool.h"
 #include "core/providers/common.h"
 #include "core/providers/cpu/math/element_wise_ops.h"
 
@@ -64,14 +65,17 @@ Status SGDOptimizerV2<T>::Compute(OpKernelContext* ctx) const {
   if (update_signal == nullptr || *update_signal->template Data<bool>()) {
     const float lr = *p.learning_rate->template Data<float>();
 
-    for (size_t weight_index = 0; weight_index < p.num_of_weights; ++weight_index) {
-      Tensor& weight = const_cast<Tensor&>(p.weights->Get(weight_index));
-      Tensor& gradient = const_cast<Tensor&>(p.gradients->Get(weight_index));
+    static constexpr double cost_per_element = 2.0;
+    MultiTensorApply(
+        ctx->GetOperatorThreadPool(), p.grouped_tensor_sizes, cost_per_element,
+        [&](size_t weight_index, std::ptrdiff_t offset, std::ptrdiff_t count) {
+          const auto& pointers = p.grouped_tensor_pointers[weight_index];
+          EigenVectorArrayMap<T> weight(static_cast<T*>(pointers[0]) + offset, count);
+          ConstEigenVectorArrayMap<T> gradient(static_cast<const T*>(pointers[1]) + offset, count);
 
-      // new_weight = weight - lr * gradient
-      const auto& delta = -lr * MakeEigenArrayMap<T>(gradient);
-      MakeEigenArrayMap<T>(weight) = MakeEigenArrayMap<T>(weight) + delta;
-    }
+          // new_weight = weight - lr * gradient
+          weight = weight + (-lr * gradient);
+        });
 
     *updated_flag_ptr = true;
   } else {
@@ -98,5 +102,61 @@ ONNX_OPERATOR_KERNEL_EX(
         .TypeConstraint("S_GRAD", DataTypeImpl::AllFixedSizeSequenceTensorTypes()),
     SGDOptimizerV2<float>);
 
+template <typename T>
+Status SparseSGDOptimizer<T>::Compute(OpKernelContext* ctx) const {
+  const Tensor& learning_rate = *ctx->Input<Tensor>(0);
+  const Tensor& weight = *ctx->Input<Tensor>(1);
+  const Tensor& grad_indices = *ctx->Input<Tensor>(2);
+  const Tensor& grad_values = *ctx->Input<Tensor>(3);
+
+  int64_t row_size = 0;
+  ORT_RETURN_IF_ERROR(CheckRowGradient(weight, grad_indices, grad_values, row_size));
+
+  bool* updated_flag_ptr = ctx->Output(0, learning_rate.Shape())->template MutableData<bool>();
+  const Tensor* update_signal = ctx->Input<Tensor>(4);
+  if (update_signal == nullptr || *update_signal->template Data<bool>()) {
+    const float lr = *learning_rate.template Data<float>();
+
+    // The weight is updated in place, one row of the gradient at a time; the rows are distinct.
+    T* weight_data = const_cast<T*>(weight.template Data<T>());
+    const int64_t* indices = grad_indices.template Data<int64_t>();
+    const T* values = grad_values.template Data<T>();
+
+    const double cost_per_row = 2.0 * static_cast<double>(row_size);
+    concurrency::ThreadPool::TryParallelFor(
+        ctx->GetOperatorThreadPool(), grad_indices.Shape()[0], cost_per_row,
+        [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+          for (std::ptrdiff_t r = begin; r != end; ++r) {
+            EigenVectorArrayMap<T> weight_row(weight_data + indices[r] * row_size, row_size);
+            ConstEigenVectorArrayMap<T> gradient_row(values + r * row_size, row_size);
+
+            // new_weight = weight - lr * gradient
+            weight_row = weight_row + (-lr * gradient_row);
+          }
+        });
+
+    *updated_flag_ptr = true;
+  } else {
+    *updated_flag_ptr = false;
+  }
+
+  CopyIfNotSameCPUBuffer(weight, ctx->Output(1, weight.Shape()));
+
+  return Status::OK();
+}
+
+ONNX_OPERATOR_KERNEL_EX(
+    SparseSGDOptimizer,
+    kMSDomain,
+    1,
+    kCpuExecutionProvider,
+    KernelDefBuilder()
+        .Alias(1, 1)  // Update weight in-place
+        .TypeConstraint("T1", DataTypeImpl::GetTensorType<float>())
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>())
+        .TypeConstraint("T_INDEX", DataTypeImpl::GetTensorType<int64_t>())
+        .TypeConstraint("T_BOOL", DataTypeImpl::GetTensorType<bool>()),
+    SparseSGDOptimizer<float>);
+
 }  // namespace contrib
 }  // namespace onnxruntime
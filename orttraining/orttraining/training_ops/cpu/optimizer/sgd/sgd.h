@@ -19,5 +19,15 @@ class SGDOptimizerV2 final : public OpKernel, public SGDOptimizerV2Base {
   Status Compute(OpKernelContext* context) const override;
 };
 
+// SGD of a single weight whose gradient is given by rows (SparseSGDOptimizer): only the rows in the gradient
+// are updated.
+template <typename T>
+class SparseSGDOptimizer final : public OpKernel {
+ public:
+  SparseSGDOptimizer(const OpKernelInfo& info) : OpKernel(info) {}
+
+  Status Compute(OpKernelContext* context) const override;
+};
+
 }  // namespace contrib
 }  // namespace onnxruntime
@@ -2,8 +2,12 @@
 // Licensed under the MIT License.
 
 #include "orttraining/training_ops/cpu/tensor/gather_grad.h"
+
+#include <algorithm>
+
 #include "core/common/common.h"
 #include "core/platform/threadpool.h"
+#include "core/util/math_cpuonly.h"
 
 namespace onnxruntime {
 namespace contrib {
@@ -99,5 +103,101 @@ Status GatherGrad::ComputeImpl(const TensorShape& data_shape, const Tensor& indi
   return Status::OK();
 }
 
+ONNX_OPERATOR_KERNEL_EX(
+    GatherSparseGrad,
+    kMSDomain,
+    1,
+    kCpuExecutionProvider,
+    KernelDefBuilder()
+        .TypeConstraint("I", DataTypeImpl::GetTensorType<int64_t>())
+        .TypeConstraint("I64", DataTypeImpl::GetTensorType<int64_t>())
+        .TypeConstraint("T", {DataTypeImpl::GetTensorType<float>(),
+                              DataTypeImpl::GetTensorType<double>()})
+        .TypeConstraint("Tind", std::vector<MLDataType>{
+                                    DataTypeImpl::GetTensorType<int32_t>(),
+                                    DataTypeImpl::GetTensorType<int64_t>()}),
+    GatherSparseGrad);
+
+#define TYPED_SPARSE_GRAD_FUNCTION_CALL(T)                                \
+  if (T_type == DataTypeImpl::GetType<T>()) {                             \
+    if (Tind_type == DataTypeImpl::GetType<int32_t>()) {                  \
+      return ComputeImpl<T, int32_t>(data_shape, indices, grad, context); \
+    }                                                                     \
+    if (Tind_type == DataTypeImpl::GetType<int64_t>()) {                  \
+      return ComputeImpl<T, int64_t>(data_shape, indices, grad, context); \
+    }                                                                     \
+  }
+
+Status GatherSparseGrad::Compute(OpKernelContext* context) const {
+  const Tensor& shape = *context->Input<Tensor>(0);
+  const Tensor& indices = *context->Input<Tensor>(1);
+  const Tensor& grad = *context->Input<Tensor>(2);
+
+  const TensorShape data_shape(shape.template Data<int64_t>(), shape.Shape().Size());
+  ORT_RETURN_IF_NOT(data_shape.NumDimensions() >= 1, "GatherSparseGrad requires an input of rank 1 or more.");
+
+  MLDataType T_type = grad.DataType();
+  MLDataType Tind_type = indices.DataType();
+  TYPED_SPARSE_GRAD_FUNCTION_CALL(float);
+  TYPED_SPARSE_GRAD_FUNCTION_CALL(double);
+
+  return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED, "Type for T or Tind not supported yet in GatherSparseGrad.");
+}
+
+template <typename T, typename Tind>
+Status GatherSparseGrad::ComputeImpl(const TensorShape& data_shape, const Tensor& indices, const Tensor& grad,
+                                     OpKernelContext* context) const {
+  const Tind* indices_data = indices.template Data<Tind>();
+  const T* grad_data = grad.template Data<T>();
+
+  const int64_t indices_max = data_shape[0];
+  const int64_t row_size = data_shape.SizeFromDimension(1);
+  const int64_t N = indices.Shape().Size();
+  ORT_RETURN_IF_NOT(grad.Shape().Size() == N * row_size, "The shape of dY does not match the indices and shape.");
+
+  // Sort the positions of the indices by row. Repeated rows keep the order of their positions, so that their
+  // gradients are summed in a deterministic order.
+  std::vector<std::pair<int64_t, int64_t>> rows(N);
+  for (int64_t i = 0; i < N; i++) {
+    int64_t idx = static_cast<int64_t>(indices_data[i]);
+    if (idx < -indices_max || idx >= indices_max) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "indices element out of data bounds, idx=", idx,
+                             " data_dim=", indices_max);
+    }
+    rows[i] = {idx < 0 ? idx + indices_max : idx, i};
+  }
+  std::sort(rows.begin(), rows.end());
+
+  std::vector<int64_t> row_starts;
+  for (int64_t i = 0; i < N; i++) {
+    if (i == 0 || rows[i].first != rows[i - 1].first) {
+      row_starts.push_back(i);
+    }
+  }
+  const int64_t num_rows = static_cast<int64_t>(row_starts.size());
+  row_starts.push_back(N);
+
+  TensorShapeVector values_dims = data_shape.AsShapeVector();
+  values_dims[0] = num_rows;
+  int64_t* grad_indices_data = context->Output(0, TensorShape({num_rows}))->template MutableData<int64_t>();
+  T* grad_values_data = context->Output(1, TensorShape(values_dims))->template MutableData<T>();
+
+  const double cost_per_row = static_cast<double>(row_size) * static_cast<double>(N) / std::max<int64_t>(num_rows, 1);
+  concurrency::ThreadPool::TryParallelFor(
+      context->GetOperatorThreadPool(), num_rows, cost_per_row,
+      [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+        for (std::ptrdiff_t r = begin; r != end; ++r) {
+          grad_indices_data[r] = rows[row_starts[r]].first;
+          EigenVectorArrayMap<T> values(grad_values_data + r * row_size, row_size);
+          values = ConstEigenVectorArrayMap<T>(grad_data + rows[row_starts[r]].second * row_size, row_size);
+          for (int64_t i = row_starts[r] + 1; i < row_starts[r + 1]; i++) {
+            values += ConstEigenVectorArrayMap<T>(grad_data + rows[i].second * row_size, row_size);
+          }
+        }
+      });
+
+  return Status::OK();
+}
+
 }  // namespace contrib
 }  // namespace onnxruntime
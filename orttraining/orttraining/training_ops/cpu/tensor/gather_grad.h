@@ -26,5 +26,17 @@ class GatherGrad final : public OpKernel {
   int64_t axis_;
 };
 
+class GatherSparseGrad final : public OpKernel {
+ public:
+  GatherSparseGrad(const OpKernelInfo& info) : OpKernel(info) {}
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  template <typename T, typename Tind>
+  Status ComputeImpl(const TensorShape& data_shape, const Tensor& indices, const Tensor& grad,
+                     OpKernelContext* context) const;
+};
+
 }  // namespace contrib
 }  // namespace onnxruntime
@@ -407,6 +407,11 @@ def parse_arguments():
     parser.add_argument("--emsdk_version", default="3.1.37", help="Specify version of emsdk")
 
     parser.add_argument("--enable_wasm_simd", action="store_true", help="Enable WebAssembly SIMD")
+    parser.add_argument(
+        "--enable_wasm_relaxed_simd",
+        action="store_true",
+        help="Enable WebAssembly relaxed SIMD. The output requires a runtime that supports relaxed SIMD.",
+    )
     parser.add_argument("--enable_wasm_threads", action="store_true", help="Enable WebAssembly multi-threads support")
 
     parser.add_argument(
@@ -709,6 +714,9 @@ def parse_arguments():
     if not args.disable_wasm_exception_catching or args.enable_wasm_api_exception_catching:
         # doesn't make sense to catch if no one throws
         args.enable_wasm_exception_throwing_override = True
+    if args.enable_wasm_relaxed_simd:
+        # relaxed SIMD extends the fixed-width SIMD instruction set
+        args.enable_wasm_simd = True
 
     if args.cmake_generator is None and is_windows():
         args.cmake_generator = "Ninja" if args.build_wasm else "Visual Studio 17 2022"
@@ -1028,6 +1036,9 @@ def generate_build_tree(
         cmake_args.append("-Donnxruntime_DNNL_OPENCL_ROOT=" + args.dnnl_opencl_root)
     if args.build_wasm:
         cmake_args.append("-Donnxruntime_ENABLE_WEBASSEMBLY_SIMD=" + ("ON" if args.enable_wasm_simd else "OFF"))
+        cmake_args.append(
+            "-Donnxruntime_ENABLE_WEBASSEMBLY_RELAXED_SIMD=" + ("ON" if args.enable_wasm_relaxed_simd else "OFF")
+        )
     if args.use_migraphx:
         cmake_args.append("-Donnxruntime_MIGRAPHX_HOME=" + migraphx_home)
     if args.use_cuda:
@@ -101,7 +101,7 @@ def convert_and_save(metadata, header_file, out_dir, out_obj_file):
 
         # convert constants
         constants = []
-        for k, v in m["constants"].items():
+        for k, v in m.get("constants", {}).items():
             constants.append(f'{{ "{k}", {str(v)}}}')
         meta_ele.append(f"{{ { ', '.join(constants) } }}")
 
@@ -0,0 +1,211 @@
+#!/usr/bin/env python3
+# Copyright (c) Microsoft Corporation. All rights reserved.
+# Licensed under the MIT License.
+
+"""
+Runs a pinned set of reference models with onnxruntime_perf_test on each execution provider and thread
+configuration, and writes the results to a JSON file together with the build information and the CPU ISA,
+so that results can be tracked across releases.
+
+The reference models are listed in reference_benchmark_models.json. Models missing from the models directory,
+or whose sha256 does not match the pinned one, are reported as such instead of being run.
+
+Example:
+    python run_reference_benchmarks.py --perf_test build/Linux/Release/onnxruntime_perf_test \
+        --models_dir /data/reference_models --providers cpu cuda --output results.json
+"""
+
+import argparse
+import datetime
+import hashlib
+import json
+import os
+import platform
+import re
+import subprocess
+import sys
+
+SCRIPT_DIR = os.path.dirname(os.path.realpath(__file__))
+REPO_DIR = os.path.normpath(os.path.join(SCRIPT_DIR, "..", ".."))
+
+# the ISA extensions MLAS dispatches on
+CPU_ISA_FLAGS = [
+    "sse4_1",
+    "avx",
+    "avx2",
+    "fma",
+    "f16c",
+    "avx512f",
+    "avx512bw",
+    "avx512vl",
+    "avx512_vnni",
+    "avx_vnni",
+    "avx512_bf16",
+    "amx_tile",
+    "amx_int8",
+    "amx_bf16",
+    "asimd",
+    "asimddp",
+    "fphp",
+    "i8mm",
+    "bf16",
+    "sve",
+]
+
+# result lines of onnxruntime_perf_test and the JSON keys they are stored under
+PERF_TEST_RESULTS = {
+    "Session creation time cost": "session_creation_s",
+    "First inference time cost": "first_inference_ms",
+    "Total inference requests": "requests",
+    "Average inference time cost": "average_ms",
+    "Number of inferences per second": "inferences_per_second",
+    "Peak working set size": "peak_working_set_bytes",
+    "Min Latency": "min_s",
+    "Max Latency": "max_s",
+    "P50 Latency": "p50_s",
+    "P90 Latency": "p90_s",
+    "P95 Latency": "p95_s",
+    "P99 Latency": "p99_s",
+    "P999 Latency": "p999_s",
+}
+
+
+def parse_arguments():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--perf_test", required=True, help="Path of the onnxruntime_perf_test executable.")
+    parser.add_argument(
+        "--models_dir", required=True, help="Directory the paths of the reference models are relative to."
+    )
+    parser.add_argument(
+        "--manifest",
+        default=os.path.join(SCRIPT_DIR, "reference_benchmark_models.json"),
+        help="JSON file listing the reference models.",
+    )
+    parser.add_argument("--providers", nargs="+", default=["cpu"], choices=["cpu", "cuda"], help="Execution providers.")
+    parser.add_argument(
+        "--intra_op_threads",
+        nargs="+",
+        type=int,
+        default=[1, 4],
+        help="Numbers of intra-op threads the CPU execution provider is run with. GPU providers are run with 1.",
+    )
+    parser.add_argument("--repeats", type=int, default=200, help="Number of inferences per model and configuration.")
+    parser.add_argument("--version", default="", help="ONNX Runtime version.")
+    parser.add_argument("--build_info", default="", help="Build information, as ORT_BUILD_INFO of the build.")
+    parser.add_argument("--output", required=True, help="Path of the JSON file to write.")
+    return parser.parse_args()
+
+
+def get_cpu_info():
+    info = {"machine": platform.machine(), "processor": platform.processor(), "cpu_count": os.cpu_count()}
+    if sys.platform.startswith("linux"):
+        flags = set()
+        with open("/proc/cpuinfo") as cpuinfo:
+            for line in cpuinfo:
+                key, _, value = line.partition(":")
+                key = key.strip()
+                if key == "model name" and "model_name" not in info:
+                    info["model_name"] = value.strip()
+                elif key in ("flags", "Features"):
+                    flags.update(value.split())
+        info["isa"] = [flag for flag in CPU_ISA_FLAGS if flag in flags]
+    return info
+
+
+def get_gpu_info(providers):
+    if "cuda" not in providers:
+        return None
+
+    sys.path.append(os.path.join(REPO_DIR, "onnxruntime", "python"))
+    from onnxruntime_collect_build_info import find_cudart_versions, find_cudnn_supported_cuda_versions
+
+    info = {
+        "cudart_versions": find_cudart_versions(),
+        "cudnn_supported_cuda_versions": find_cudnn_supported_cuda_versions(),
+    }
+    try:
+        output = subprocess.run(
+            ["nvidia-smi", "--query-gpu=name,driver_version", "--format=csv,noheader"],
+            capture_output=True,
+            text=True,
+            check=True,
+        ).stdout
+        info["gpus"] = [line.strip() for line in output.splitlines() if line.strip()]
+    except (OSError, subprocess.CalledProcessError):
+        pass
+    return info
+
+
+def sha256_of(path):
+    sha256 = hashlib.sha256()
+    with open(path, "rb") as model_file:
+        for chunk in iter(lambda: model_file.read(1 << 20), b""):
+            sha256.update(chunk)
+    return sha256.hexdigest()
+
+
+def run_perf_test(args, model, model_path, provider, intra_op_threads):
+    command = [args.perf_test, "-I", "-m", "times", "-r", str(args.repeats), "-e", provider]
+    command += ["-x", str(intra_op_threads), "-y", "1"]
+    for name, value in model.get("free_dim_overrides", {}).items():
+        command += ["-f", f"{name}:{value}"]
+    command.append(model_path)
+
+    completed = subprocess.run(command, capture_output=True, text=True, check=False)
+    result = {"command": " ".join(command)}
+    if completed.returncode != 0:
+        result["error"] = (completed.stderr or completed.stdout).strip()[-2000:]
+        return result
+
+    for line in completed.stdout.splitlines():
+        match = re.match(r"^([^:]+):\s*([-+0-9.eE]+)", line)
+        if match and match.group(1) in PERF_TEST_RESULTS:
+            result[PERF_TEST_RESULTS[match.group(1)]] = float(match.group(2))
+    return result
+
+
+def main():
+    args = parse_arguments()
+    with open(args.manifest) as manifest_file:
+        manifest = json.load(manifest_file)
+
+    report = {
+        "timestamp": datetime.datetime.now(datetime.timezone.utc).isoformat(),
+        "version": args.version,
+        "build_info": args.build_info,
+        "platform": platform.platform(),
+        "cpu": get_cpu_info(),
+        "gpu": get_gpu_info(args.providers),
+        "repeats": args.repeats,
+        "results": [],
+    }
+
+    for model in manifest["models"]:
+        model_path = os.path.join(args.models_dir, model["path"])
+        entry = {"model": model["name"], "path": model["path"]}
+        if not os.path.isfile(model_path):
+            entry["error"] = "model not found"
+            report["results"].append(entry)
+            continue
+        entry["sha256"] = sha256_of(model_path)
+        if model.get("sha256") and model["sha256"] != entry["sha256"]:
+            entry["error"] = "sha256 does not match the pinned " + model["sha256"]
+            report["results"].append(entry)
+            continue
+
+        for provider in args.providers:
+            for intra_op_threads in args.intra_op_threads if provider == "cpu" else [1]:
+                print(f"{model['name']}: {provider}, {intra_op_threads} intra-op threads", flush=True)
+                run = dict(entry, provider=provider, intra_op_threads=intra_op_threads)
+                run.update(run_perf_test(args, model, model_path, provider, intra_op_threads))
+                report["results"].append(run)
+
+    with open(args.output, "w") as output_file:
+        json.dump(report, output_file, indent=2)
+    print(f"Results written to {args.output}")
+
+    return 1 if any("error" in result for result in report["results"]) else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -240,6 +240,13 @@ def parse_args():
         help="Whether to proceed after encountering model conversion failures.",
     )
 
+    parser.add_argument(
+        "--compress_initializers",
+        action="store_true",
+        help="Compress the larger initializers of the ORT format model. This reduces the model size at the cost of "
+        "decompressing the initializers when the model is loaded.",
+    )
+
     parser.add_argument(
         "--target_platform",
         type=str,
@@ -273,6 +280,7 @@ def convert_onnx_models_to_ort(
     save_optimized_onnx_model: bool = False,
     allow_conversion_failures: bool = False,
     enable_type_reduction: bool = False,
+    compress_initializers: bool = False,
 ):
     if output_dir is not None:
         if not output_dir.is_dir():
@@ -300,6 +308,9 @@ def convert_onnx_models_to_ort(
     else:
         session_options_config_entries["session.qdqisint8allowed"] = "0"
 
+    if compress_initializers:
+        session_options_config_entries["session.ort_format_compress_initializers"] = "1"
+
     for optimization_style in optimization_styles:
         print(
             "Converting models with optimization style '{}' and level '{}'".format(
@@ -378,4 +389,5 @@ if __name__ == "__main__":
         save_optimized_onnx_model=args.save_optimized_onnx_model,
         allow_conversion_failures=args.allow_conversion_failures,
         enable_type_reduction=args.enable_type_reduction,
+        compress_initializers=args.compress_initializers,
     )